@@ -72,10 +72,35 @@ SET(cppDefineClauseList
     JucePlugin_Vst3Category=§Fx§
     JucePlugin_VSTNumMidiInputs=16
     JucePlugin_VSTNumMidiOutputs=16
-    JucePlugin_WantsMidiInput=0
+    JucePlugin_WantsMidiInput=1
     PRIMITIVE_TYPES_ARE_INLINED
     UNICODE)
 
+# --- SIMD kernels for audio processing (scalar fallback when off) ---
+OPTION(AUDIO_USES_SIMD "use SIMD kernels in audio processing" ON)
+
+IF(AUDIO_USES_SIMD)
+    SET(cppDefineClauseList
+        ${cppDefineClauseList}
+        AUDIO_USES_SIMD)
+ENDIF(AUDIO_USES_SIMD)
+
+# --- float storage for reverb and phaser delay lines ---
+OPTION(AUDIO_USES_FLOAT_DELAY_LINES
+       "store reverb and phaser delay line samples as float" OFF)
+
+IF(AUDIO_USES_FLOAT_DELAY_LINES)
+    SET(cppDefineClauseList
+        ${cppDefineClauseList}
+        AUDIO_USES_FLOAT_DELAY_LINES)
+ENDIF(AUDIO_USES_FLOAT_DELAY_LINES)
+
+# --- detection of allocations and locks on the audio thread (only
+#     in debug builds, see SoXRealtimeGuard) ---
+OPTION(REALTIME_CHECK_IS_ACTIVE
+       "count allocations and locks on the audio thread in debug builds"
+       ON)
+
 # --- add specific settings per platform ---
 IF(WINDOWS)
     SET(cppDefineClauseList
@@ -181,6 +206,10 @@ IF(MSVC)
            /Zi           # debug information in database
            /fp:fast      # fast floating point calculation
     )
+
+    IF(REALTIME_CHECK_IS_ACTIVE)
+        STRING(APPEND cppFlagsDebug " /DREALTIME_CHECK_IS_ACTIVE")
+    ENDIF(REALTIME_CHECK_IS_ACTIVE)
 ELSE()
     STRING(JOIN " " cppFlagsCommon
            -ffast-math             # fast floating point calculation
@@ -225,6 +254,10 @@ ELSE()
            -Og                  # debugging compatible optimization
            -g                   # debug information in object files
     )
+
+    IF(REALTIME_CHECK_IS_ACTIVE)
+        STRING(APPEND cppFlagsDebug " -DREALTIME_CHECK_IS_ACTIVE")
+    ENDIF(REALTIME_CHECK_IS_ACTIVE)
 ENDIF()
 
 SET(CMAKE_CXX_FLAGS ${cppFlagsCommon} CACHE STRING "" FORCE)
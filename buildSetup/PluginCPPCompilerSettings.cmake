@@ -36,5 +36,5 @@ LIST(APPEND cppDefinitions_common
      JucePlugin_VSTCategory=kPlugCategEffect
      JucePlugin_VSTNumMidiInputs=16
      JucePlugin_VSTNumMidiOutputs=16
-     JucePlugin_WantsMidiInput=0
+     JucePlugin_WantsMidiInput=1
 )
@@ -32,6 +32,27 @@ namespace Audio {
      */
     typedef Real AudioSample;
 
+    /* audio samples are stored exactly like doubles, so double
+       sample arrays from a host may be used in place */
+    static_assert(AudioSample::hasElementaryLayout(),
+                  "audio sample must have the layout of a double");
+
+    /*--------------------*/
+
+    /**
+     * A <C>DelayLineSample</C> is an audio sample as stored in the
+     * long delay lines of the reverb and the phaser; all arithmetic
+     * on those samples is done in double precision.  When
+     * <C>AUDIO_USES_FLOAT_DELAY_LINES</C> is defined, they are
+     * stored as 32bit floats, which halves the memory traffic of the
+     * delay lines at the cost of precision
+     */
+    #if defined(AUDIO_USES_FLOAT_DELAY_LINES)
+        typedef float DelayLineSample;
+    #else
+        typedef double DelayLineSample;
+    #endif
+
     /*--------------------*/
 
     /**
@@ -16,12 +16,14 @@
 /* IMPORTS */
 /*=========*/
 
+#include "AlignedAllocator.h"
 #include "GenericList.h"
 #include "AudioSample.h"
 
 /*--------------------*/
 
 using Audio::AudioSample;
+using BaseTypes::GenericTypes::AlignedAllocator;
 using BaseTypes::GenericTypes::GenericList;
 
 /*====================*/
@@ -41,12 +43,15 @@ namespace Audio {
      * An <C>AudioSampleList</C> object is a list of audio
      * samples with arbitrary indexed access to positions in the
      * list.  Indexing starts at zero and is consecutive.  Lists
-     * also allow duplicate elements.
+     * also allow duplicate elements.  The sample storage is aligned
+     * to and padded to a multiple of 64 bytes, such that kernels may
+     * use aligned vector loads without scalar tail loops.
      */
     struct AudioSampleList
         : public GenericList<AudioSample,
                              AudioSample::toString,
-                             _audioSampleListTypeName >
+                             _audioSampleListTypeName,
+                             AlignedAllocator<AudioSample>>
     {
 
         /*--------------------*/
@@ -99,6 +104,111 @@ namespace Audio {
                IN Integer firstPosition = 0,
                IN Integer lastPosition = Integer::maximumValue());
 
+        /*--------------------*/
+        /* arithmetic         */
+        /*--------------------*/
+
+        /* the following operations use the SIMD kernels in
+           <C>Kernels::current()</C>; binary operations only cover
+           the positions present in both lists */
+
+        /**
+         * Multiplies all samples in list by <C>factor</C>.
+         *
+         * @param[in] factor  the factor for each sample
+         */
+        void scale (IN Real factor);
+
+        /*--------------------*/
+
+        /**
+         * Adds the samples in <C>other</C> to the samples in list.
+         *
+         * @param[in] other  list of samples to be added
+         */
+        void add (IN AudioSampleList& other);
+
+        /*--------------------*/
+
+        /**
+         * Adds the samples in <C>other</C> multiplied by
+         * <C>factor</C> to the samples in list.
+         *
+         * @param[in] other   list of samples to be added
+         * @param[in] factor  the factor for each sample in other
+         */
+        void multiplyAdd (IN AudioSampleList& other,
+                          IN Real factor);
+
+        /*--------------------*/
+
+        /**
+         * Fades the samples in list linearly towards those in
+         * <C>other</C>: the weight of <C>other</C> goes from
+         * <C>startWeight</C> (before the first sample) to
+         * <C>endWeight</C> (at the last sample).
+         *
+         * @param[in] other        list of samples faded to
+         * @param[in] startWeight  the weight of other before the
+         *                         first sample
+         * @param[in] endWeight    the weight of other at the last
+         *                         sample
+         */
+        void crossfade (IN AudioSampleList& other,
+                        IN Real startWeight,
+                        IN Real endWeight);
+
+        /*--------------------*/
+
+        /**
+         * Sets the samples in list to the samples in
+         * <C>listA</C> multiplied by <C>factorA</C> plus those in
+         * <C>listB</C> multiplied by <C>factorB</C>; either list may
+         * be the current list.
+         *
+         * @param[in] listA    first list of samples to be mixed
+         * @param[in] factorA  the factor for samples in first list
+         * @param[in] listB    second list of samples to be mixed
+         * @param[in] factorB  the factor for samples in second list
+         */
+        void mix (IN AudioSampleList& listA,
+                  IN Real factorA,
+                  IN AudioSampleList& listB,
+                  IN Real factorB);
+
+        /*--------------------*/
+
+        /**
+         * Limits all samples in list to the interval from
+         * <C>lowerLimit</C> to <C>upperLimit</C>.
+         *
+         * @param[in] lowerLimit  the minimum sample value
+         * @param[in] upperLimit  the maximum sample value
+         */
+        void clamp (IN Real lowerLimit,
+                    IN Real upperLimit);
+
+        /*--------------------*/
+        /* measurement        */
+        /*--------------------*/
+
+        /**
+         * Returns the maximum magnitude of the samples in list
+         * (zero for an empty list).
+         *
+         * @return  maximum absolute sample value
+         */
+        Real absoluteMaximum () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the sum of the squares of the samples in list.
+         *
+         * @return  sum of squared samples
+         */
+        Real sumOfSquares () const;
+
     };
 
 }
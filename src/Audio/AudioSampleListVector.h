@@ -31,6 +31,10 @@ namespace Audio {
      */
     struct AudioSampleListVector : public GenericList<AudioSampleList> {
 
+        using GenericList<AudioSampleList>::append;
+
+        /*--------------------*/
+
         /**
          * Returns printable representation of buffer.
          *
@@ -66,6 +70,45 @@ namespace Audio {
 
         /*--------------------*/
 
+        /**
+         * Sets number of channels to <C>channelCount</C> and number
+         * of frames in each channel to <C>frameCount</C>; sample
+         * lists of remaining channels keep their storage, hence
+         * this does not allocate when the buffer has been that large
+         * before.
+         *
+         * @param[in] channelCount  new number of channels
+         * @param[in] frameCount    new number of frames in sample
+         *                          lists
+         */
+        void resizeChannels (IN Natural channelCount,
+                             IN Natural frameCount);
+
+        /*--------------------*/
+
+        /**
+         * Appends <C>sampleList</C> as a new last channel by taking
+         * over its samples without copying; <C>sampleList</C> is
+         * empty afterwards.
+         *
+         * @param[inout] sampleList  sample list to be moved into
+         *                           buffer
+         */
+        void append (INOUT AudioSampleList&& sampleList);
+
+        /*--------------------*/
+
+        /**
+         * Appends a new last channel with <C>frameCount</C> samples
+         * constructed in place and returns it.
+         *
+         * @param[in] frameCount  number of samples in new channel
+         * @return  reference to the new sample list
+         */
+        AudioSampleList& emplaceChannel (IN Natural frameCount);
+
+        /*--------------------*/
+
         /**
          * Sets all entries in sample buffer to zero starting at
          * <C>position</C> with a count of <C>count</C>.
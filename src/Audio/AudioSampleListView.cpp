@@ -0,0 +1,22 @@
+/**
+ * @file
+ * The <C>AudioSampleListView</C> body implements non-owning views
+ * onto audio samples held in external memory <I>(this is the formal
+ * CPP file used when not doing inlining in production code)</I>.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-01
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "AudioSampleListView.h"
+
+/*====================*/
+
+#ifdef DEBUG
+    /* module implementation contains functions */
+    #include "AudioSampleListView.cpp-inc"
+#endif
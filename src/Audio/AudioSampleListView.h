@@ -0,0 +1,301 @@
+/**
+ * @file
+ * The <C>AudioSampleListView</C> specification defines non-owning
+ * views onto audio samples held in external memory (e.g. in host
+ * buffers); a channel view is a strided sequence of samples and a
+ * list view is a vector of channel views.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-01
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "AudioSampleListVector.h"
+
+/*====================*/
+
+namespace Audio {
+
+    /**
+     * An <C>AudioSampleChannelView</C> object refers to the samples
+     * of a single channel in external memory by a pointer to the
+     * first sample, a length and a stride between consecutive
+     * samples; it does not own the samples.
+     */
+    struct AudioSampleChannelView {
+
+        /**
+         * Makes empty channel view.
+         */
+        AudioSampleChannelView ();
+
+        /*--------------------*/
+
+        /**
+         * Makes channel view of <C>length</C> samples starting at
+         * <C>sampleArray</C> where consecutive samples are
+         * <C>stride</C> positions apart.
+         *
+         * @param[in] sampleArray  pointer to first sample of channel
+         * @param[in] length       number of samples in channel
+         * @param[in] stride       distance between consecutive
+         *                         samples in memory
+         */
+        AudioSampleChannelView (INOUT AudioSample* sampleArray,
+                                IN Natural length,
+                                IN Natural stride = 1);
+
+        /*--------------------*/
+        /* property queries   */
+        /*--------------------*/
+
+        /**
+         * Returns number of samples in view.
+         *
+         * @return  number of samples
+         */
+        Natural length () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns distance between consecutive samples in memory.
+         *
+         * @return  sample stride
+         */
+        Natural stride () const;
+
+        /*--------------------*/
+
+        /**
+         * Tells whether samples are adjacent in memory.
+         *
+         * @return  information whether stride is one
+         */
+        Boolean isContiguous () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns pointer to first sample of view.
+         *
+         * @return  pointer to first sample
+         */
+        AudioSample* asArray () const;
+
+        /*--------------------*/
+        /* element access     */
+        /*--------------------*/
+
+        /**
+         * Returns reference to sample at <C>position</C>.
+         *
+         * @param[in] position  zero-based index of sample in view
+         * @return  reference to sample
+         */
+        AudioSample& operator [] (IN Natural position) const;
+
+        /*--------------------*/
+        /* data change        */
+        /*--------------------*/
+
+        /**
+         * Copies samples of view into <C>list</C> adapting its
+         * length.
+         *
+         * @param[out] list  target sample list
+         */
+        void copyTo (OUT AudioSampleList& list) const;
+
+        /*--------------------*/
+
+        /**
+         * Copies samples from <C>list</C> into view; at most
+         * <C>length()</C> samples are copied.
+         *
+         * @param[in] list  source sample list
+         */
+        void copyFrom (IN AudioSampleList& list) const;
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the pointer to the first sample */
+            AudioSample* _sampleArray;
+
+            /** the number of samples in view */
+            Natural _length;
+
+            /** the distance between consecutive samples */
+            Natural _stride;
+
+    };
+
+    /*--------------------*/
+    /*--------------------*/
+
+    /**
+     * An <C>AudioSampleListView</C> object refers to several
+     * channels of audio samples in external memory without owning
+     * them.  The channels are either given by an array of channel
+     * pointers (as delivered by audio hosts) or by a single sample
+     * block with a channel stride and a sample stride (covering
+     * planar and interleaved layouts).
+     */
+    struct AudioSampleListView {
+
+        /**
+         * Makes empty list view.
+         */
+        AudioSampleListView ();
+
+        /*--------------------*/
+
+        /**
+         * Makes list view from <C>channelArray</C> containing
+         * <C>channelCount</C> pointers to contiguous channels with
+         * <C>frameCount</C> samples each.
+         *
+         * @param[in] channelArray  array of pointers to channels;
+         *                          must outlive the view
+         * @param[in] channelCount  number of channels
+         * @param[in] frameCount    number of samples per channel
+         */
+        AudioSampleListView (INOUT AudioSample* const* channelArray,
+                             IN Natural channelCount,
+                             IN Natural frameCount);
+
+        /*--------------------*/
+
+        /**
+         * Makes list view onto sample block <C>sampleArray</C> with
+         * <C>channelCount</C> channels of <C>frameCount</C> samples
+         * each; channel <I>c</I> starts at position <I>c *
+         * channelStride</I> and its samples are
+         * <C>sampleStride</C> positions apart.
+         *
+         * @param[in] sampleArray    pointer to first sample of block
+         * @param[in] channelCount   number of channels
+         * @param[in] frameCount     number of samples per channel
+         * @param[in] channelStride  distance between the starts of
+         *                           adjacent channels
+         * @param[in] sampleStride   distance between consecutive
+         *                           samples of a channel
+         */
+        AudioSampleListView (INOUT AudioSample* sampleArray,
+                             IN Natural channelCount,
+                             IN Natural frameCount,
+                             IN Natural channelStride,
+                             IN Natural sampleStride = 1);
+
+        /*--------------------*/
+        /* property queries   */
+        /*--------------------*/
+
+        /**
+         * Returns number of channels in view.
+         *
+         * @return  number of channels
+         */
+        Natural channelCount () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns number of frames (the samples in each channel).
+         *
+         * @return  number of frames
+         */
+        Natural frameCount () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns array of channel pointers when view has been made
+         * from one, otherwise <C>nullptr</C>.
+         *
+         * @return  array of pointers to contiguous channels or
+         *          nullptr
+         */
+        AudioSample* const* channelArray () const;
+
+        /*--------------------*/
+        /* element access     */
+        /*--------------------*/
+
+        /**
+         * Returns view onto channel <C>channel</C>.
+         *
+         * @param[in] channel  zero-based index of channel
+         * @return  channel view
+         */
+        AudioSampleChannelView operator [] (IN Natural channel) const;
+
+        /*--------------------*/
+        /* data change        */
+        /*--------------------*/
+
+        /**
+         * Copies samples of view into <C>buffer</C> adapting its
+         * channel and frame count.
+         *
+         * @param[out] buffer  target sample buffer
+         */
+        void copyTo (OUT AudioSampleListVector& buffer) const;
+
+        /*--------------------*/
+
+        /**
+         * Copies samples from <C>buffer</C> into view; at most
+         * <C>channelCount()</C> channels with <C>frameCount()</C>
+         * samples each are copied.
+         *
+         * @param[in] buffer  source sample buffer
+         */
+        void copyFrom (IN AudioSampleListVector& buffer) const;
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the array of channel pointers (if any) */
+            AudioSample* const* _channelArray;
+
+            /** the sample block when no channel pointers are
+             * given */
+            AudioSample* _sampleArray;
+
+            /** the number of channels */
+            Natural _channelCount;
+
+            /** the number of samples per channel */
+            Natural _frameCount;
+
+            /** the distance between the starts of adjacent
+             * channels in sample block */
+            Natural _channelStride;
+
+            /** the distance between consecutive samples of a
+             * channel in sample block */
+            Natural _sampleStride;
+
+    };
+
+}
+
+/*============================================================*/
+
+#ifndef DEBUG
+    /* production code is inlined */
+    #include "AudioSampleListView.cpp-inc"
+#endif
@@ -0,0 +1,219 @@
+/**
+ * @file
+ * The <C>AudioSamplePlanarBuffer</C> body implements a multichannel
+ * sample buffer with planar storage in a single aligned allocation.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "AudioSamplePlanarBuffer.h"
+
+#include <cstring>
+#include <new>
+#include "Logging.h"
+#include "MyArray.h"
+
+/*--------------------*/
+
+using Audio::AudioSample;
+using Audio::AudioSamplePlanarBuffer;
+using BaseTypes::Containers::copyArray;
+
+/*====================*/
+
+const Natural AudioSamplePlanarBuffer::alignment = 64;
+
+/*--------------------*/
+
+/** the distance of memory addresses mapped to the same sets of a
+ * first level cache; channels with a stride of a multiple of that
+ * would compete for the same cache lines */
+static const size_t _cacheAliasingDistance = 4096;
+
+/*--------------------*/
+
+/**
+ * Returns <C>byteCount</C> rounded up to a multiple of the
+ * alignment.
+ *
+ * @param[in] byteCount  number of bytes
+ * @return  aligned number of bytes
+ */
+static size_t _alignedByteCount (IN size_t byteCount)
+{
+    const size_t alignment = (size_t) AudioSamplePlanarBuffer::alignment;
+    return (byteCount + alignment - 1) / alignment * alignment;
+}
+
+/*--------------------*/
+
+/**
+ * Returns the channel stride in samples for <C>frameCapacity</C>
+ * frames: the frames are padded to whole cache lines and by another
+ * cache line when the channels would otherwise start at a multiple
+ * of the cache aliasing distance (as for the typical power of two
+ * block sizes).
+ *
+ * @param[in] frameCapacity  number of frames per channel
+ * @return  channel stride in samples
+ */
+static Natural _channelStrideForCapacity (IN Natural frameCapacity)
+{
+    const size_t alignment = (size_t) AudioSamplePlanarBuffer::alignment;
+    size_t byteCount =
+        _alignedByteCount((size_t) frameCapacity * sizeof(AudioSample));
+
+    if (byteCount > 0 && byteCount % _cacheAliasingDistance == 0) {
+        byteCount += alignment;
+    }
+
+    return Natural{byteCount / sizeof(AudioSample)};
+}
+
+/*====================*/
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+AudioSamplePlanarBuffer::AudioSamplePlanarBuffer ()
+    : _memory{nullptr},
+      _byteCount{0},
+      _channelArray{nullptr},
+      _channelCount{0},
+      _frameCount{0},
+      _channelCapacity{0},
+      _frameCapacity{0},
+      _channelStride{0}
+{
+}
+
+/*--------------------*/
+
+AudioSamplePlanarBuffer::~AudioSamplePlanarBuffer ()
+{
+    if (_memory != nullptr) {
+        ::operator delete(_memory, std::align_val_t{(size_t) alignment});
+    }
+}
+
+/*--------------------*/
+/* size change        */
+/*--------------------*/
+
+void AudioSamplePlanarBuffer::reserve (IN Natural channelCount,
+                                       IN Natural frameCount)
+{
+    const Natural newChannelCapacity =
+        Natural::maximum(channelCount, _channelCapacity);
+    const Natural newFrameCapacity =
+        Natural::maximum(frameCount, _frameCapacity);
+
+    if (newChannelCapacity > _channelCapacity
+        || newFrameCapacity > _frameCapacity) {
+        Logging_trace2(">>: channelCount = %1, frameCount = %2",
+                       TOSTRING(newChannelCapacity),
+                       TOSTRING(newFrameCapacity));
+
+        const Natural newChannelStride =
+            _channelStrideForCapacity(newFrameCapacity);
+        const size_t pointerByteCount =
+            _alignedByteCount((size_t) newChannelCapacity
+                              * sizeof(AudioSample*));
+        const size_t byteCount =
+            (pointerByteCount
+             + ((size_t) newChannelCapacity * (size_t) newChannelStride
+                * sizeof(AudioSample)));
+        void* memory =
+            ::operator new(byteCount,
+                           std::align_val_t{(size_t) alignment});
+        std::memset(memory, 0, byteCount);
+
+        AudioSample** channelArray = (AudioSample**) memory;
+        AudioSample* sampleArray =
+            (AudioSample*) ((char*) memory + pointerByteCount);
+
+        for (Natural channel = 0;  channel < newChannelCapacity;
+             channel++) {
+            channelArray[(size_t) channel] =
+                sampleArray + (size_t) (channel * newChannelStride);
+        }
+
+        /* the samples of all channels are kept */
+        for (Natural channel = 0;  channel < _channelCapacity;
+             channel++) {
+            AudioSample* targetPtr = channelArray[(size_t) channel];
+            const AudioSample* sourcePtr = _channelArray[(size_t) channel];
+            copyArray(targetPtr, sourcePtr, _frameCapacity);
+        }
+
+        if (_memory != nullptr) {
+            ::operator delete(_memory,
+                              std::align_val_t{(size_t) alignment});
+        }
+
+        _memory          = memory;
+        _byteCount       = byteCount;
+        _channelArray    = channelArray;
+        _channelCapacity = newChannelCapacity;
+        _frameCapacity   = newFrameCapacity;
+        _channelStride   = newChannelStride;
+
+        Logging_trace1("<<: byteCount = %1", TOSTRING(Natural{byteCount}));
+    }
+}
+
+/*--------------------*/
+/* data change        */
+/*--------------------*/
+
+void AudioSamplePlanarBuffer::setToZero ()
+{
+    /* the channels are adjacent, hence a single clear covers all of
+       them (including the padding) */
+    if (_channelCount > 0) {
+        const size_t sampleCount =
+            (size_t) ((_channelCount - 1) * _channelStride + _frameCount);
+        std::memset((void*) _channelArray[0], 0,
+                    sampleCount * sizeof(AudioSample));
+    }
+}
+
+/*--------------------*/
+
+void AudioSamplePlanarBuffer::copyFrom (IN AudioSampleListVector& buffer)
+{
+    resize(buffer.size(), buffer.frameCount());
+
+    for (Natural channel = 0;  channel < _channelCount;  channel++) {
+        AudioSample* targetPtr = _channelArray[(size_t) channel];
+        const AudioSample* sourcePtr = buffer[channel].asArray();
+        copyArray(targetPtr, sourcePtr, _frameCount);
+    }
+}
+
+/*--------------------*/
+
+void AudioSamplePlanarBuffer::copyTo (OUT AudioSampleListVector& buffer)
+    const
+{
+    buffer.resizeChannels(_channelCount, _frameCount);
+
+    for (Natural channel = 0;  channel < _channelCount;  channel++) {
+        AudioSample* targetPtr = buffer[channel].asArray();
+        const AudioSample* sourcePtr = _channelArray[(size_t) channel];
+        copyArray(targetPtr, sourcePtr, _frameCount);
+    }
+}
+
+/*====================*/
+
+#ifdef DEBUG
+    /* module implementation contains functions */
+    #include "AudioSamplePlanarBuffer.cpp-inc"
+#endif
@@ -0,0 +1,264 @@
+/**
+ * @file
+ * The <C>AudioSamplePlanarBuffer</C> specification defines a
+ * multichannel sample buffer with planar storage in a single aligned
+ * allocation.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "AudioSampleListView.h"
+
+/*====================*/
+
+namespace Audio {
+
+    /**
+     * An <C>AudioSamplePlanarBuffer</C> object holds several
+     * channels of audio samples in a single aligned memory block:
+     * the channels follow each other with a fixed channel stride,
+     * which is the frame capacity padded to whole cache lines, and
+     * the block starts with the array of channel pointers.  Hence
+     * a channel is found by a single multiplication, the channel
+     * pointers can be handed to <C>processDoubleBlock</C> or
+     * wrapped by an <C>AudioSampleListView</C> without copying, and
+     * a change of channel or frame count within the capacity only
+     * updates two counts.
+     *
+     * An <C>AudioSampleListVector</C> allocates each channel
+     * separately and is kept for the effect interfaces working on
+     * sample lists; samples are exchanged with it by
+     * <C>copyFrom</C> and <C>copyTo</C>.
+     */
+    struct AudioSamplePlanarBuffer {
+
+        /** the alignment of the memory block and of each channel in
+         * bytes (a cache line) */
+        static const Natural alignment;
+
+        /*--------------------*/
+        /* con-/destruction   */
+        /*--------------------*/
+
+        /**
+         * Makes an empty buffer without memory.
+         */
+        AudioSamplePlanarBuffer ();
+
+        /*--------------------*/
+
+        /**
+         * Destroys buffer and frees its memory.
+         */
+        ~AudioSamplePlanarBuffer ();
+
+        /*--------------------*/
+
+        AudioSamplePlanarBuffer (IN AudioSamplePlanarBuffer&) = delete;
+
+        /*--------------------*/
+        /* property queries   */
+        /*--------------------*/
+
+        /**
+         * Returns number of channels.
+         *
+         * @return  number of channels
+         */
+        Natural channelCount () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns number of frames (the samples in each channel).
+         *
+         * @return  number of frames
+         */
+        Natural frameCount () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the maximum number of channels without a new
+         * allocation.
+         *
+         * @return  channel capacity
+         */
+        Natural channelCapacity () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the maximum number of frames without a new
+         * allocation.
+         *
+         * @return  frame capacity
+         */
+        Natural frameCapacity () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the distance between the starts of adjacent
+         * channels in samples.
+         *
+         * @return  channel stride
+         */
+        Natural channelStride () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of bytes allocated by buffer.
+         *
+         * @return  size of memory block
+         */
+        Natural byteCount () const;
+
+        /*--------------------*/
+        /* element access     */
+        /*--------------------*/
+
+        /**
+         * Returns pointer to first sample of channel
+         * <C>channel</C>.
+         *
+         * @param[in] channel  zero-based index of channel
+         * @return  pointer to samples of channel
+         * @pre channel < channelCount()
+         */
+        AudioSample* operator [] (IN Natural channel) const;
+
+        /*--------------------*/
+
+        /**
+         * Returns array of <C>channelCount()</C> pointers to the
+         * channels; the array is valid until the next allocation.
+         *
+         * @return  array of channel pointers
+         */
+        AudioSample* const* channelArray () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns a view onto all channels and frames of buffer
+         * made from the channel pointers (such that effects process
+         * it in place); the view is valid until the next
+         * allocation.
+         *
+         * @return  view onto buffer
+         */
+        AudioSampleListView asView () const;
+
+        /*--------------------*/
+        /* size change        */
+        /*--------------------*/
+
+        /**
+         * Ensures that buffer can hold <C>channelCount</C> channels
+         * with <C>frameCount</C> frames each without allocation;
+         * when the memory block grows, all samples are kept and the
+         * new ones are zero.
+         *
+         * @param[in] channelCount  number of channels
+         * @param[in] frameCount    number of frames per channel
+         */
+        void reserve (IN Natural channelCount,
+                      IN Natural frameCount);
+
+        /*--------------------*/
+
+        /**
+         * Sets number of channels to <C>channelCount</C> and number
+         * of frames to <C>frameCount</C>; within the capacity this
+         * only adapts the counts (and hence may be done on the audio
+         * thread), otherwise the memory block is reallocated like in
+         * <C>reserve</C>.  Samples at positions covered before keep
+         * their values.
+         *
+         * @param[in] channelCount  new number of channels
+         * @param[in] frameCount    new number of frames per channel
+         */
+        void resize (IN Natural channelCount,
+                     IN Natural frameCount);
+
+        /*--------------------*/
+        /* data change        */
+        /*--------------------*/
+
+        /**
+         * Sets all samples of all channels to zero.
+         */
+        void setToZero ();
+
+        /*--------------------*/
+
+        /**
+         * Copies samples from <C>buffer</C> into this buffer
+         * adapting its channel and frame count.
+         *
+         * @param[in] buffer  source sample buffer
+         */
+        void copyFrom (IN AudioSampleListVector& buffer);
+
+        /*--------------------*/
+
+        /**
+         * Copies samples of this buffer into <C>buffer</C> adapting
+         * its channel and frame count.
+         *
+         * @param[out] buffer  target sample buffer
+         */
+        void copyTo (OUT AudioSampleListVector& buffer) const;
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the memory block with the channel pointers followed
+             * by the channels */
+            void* _memory;
+
+            /** the number of bytes in memory block */
+            size_t _byteCount;
+
+            /** the channel pointers at the start of the memory
+             * block */
+            AudioSample** _channelArray;
+
+            /** the number of channels */
+            Natural _channelCount;
+
+            /** the number of frames */
+            Natural _frameCount;
+
+            /** the number of channels in memory block */
+            Natural _channelCapacity;
+
+            /** the number of frames per channel in memory block */
+            Natural _frameCapacity;
+
+            /** the distance between channel starts in samples */
+            Natural _channelStride;
+
+    };
+
+}
+
+/*============================================================*/
+
+#ifndef DEBUG
+    /* production code is inlined */
+    #include "AudioSamplePlanarBuffer.cpp-inc"
+#endif
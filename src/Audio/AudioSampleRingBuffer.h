@@ -17,6 +17,7 @@
 /*=========*/
 
 #include "AudioSampleList.h"
+#include "DspStateStream.h"
 
 /*--------------------*/
 
@@ -42,11 +43,28 @@ namespace Audio {
 
         /**
          * Defines new ring buffer with arbitrary length and given
-         * initial length.
+         * initial length; if <C>hasMaskedIndexing</C> is set, the
+         * capacity is rounded up to a power of two and indexing is
+         * done by a bit mask instead of a modulus calculation
          *
-         * @param[in] length  initial length of ring buffer
+         * @param[in] length             initial length of ring buffer
+         * @param[in] hasMaskedIndexing  tells whether capacity is a
+         *                               power of two with masked
+         *                               indexing
          */
-        AudioSampleRingBuffer (IN Natural length);
+        AudioSampleRingBuffer (IN Natural length,
+                               IN Boolean hasMaskedIndexing = false);
+
+        /*--------------------*/
+
+        /**
+         * Defines new ring buffer as a copy of <C>otherRingBuffer</C>;
+         * the copy always owns its sample storage, even when the
+         * original uses external storage
+         *
+         * @param[in] otherRingBuffer  ring buffer to be copied
+         */
+        AudioSampleRingBuffer (IN AudioSampleRingBuffer& otherRingBuffer);
 
         /*--------------------*/
 
@@ -57,6 +75,34 @@ namespace Audio {
 
         /*--------------------*/
 
+        /**
+         * Assigns length, indexing mode and contents of
+         * <C>otherRingBuffer</C> to current ring buffer; the storage
+         * of the current ring buffer is kept
+         *
+         * @param[in] otherRingBuffer  ring buffer to be copied
+         * @return  reference to current ring buffer
+         */
+        AudioSampleRingBuffer&
+        operator= (IN AudioSampleRingBuffer& otherRingBuffer);
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of sample slots a ring buffer with
+         * <C>length</C> requires for the indexing mode given by
+         * <C>hasMaskedIndexing</C>.
+         *
+         * @param[in] length             the ring buffer length
+         * @param[in] hasMaskedIndexing  tells whether masked indexing
+         *                               is used
+         * @return  required capacity in samples
+         */
+        static Natural requiredCapacity (IN Natural length,
+                                         IN Boolean hasMaskedIndexing);
+
+        /*--------------------*/
+
         /**
          * Returns string representation of sample ring buffer.
          *
@@ -83,6 +129,38 @@ namespace Audio {
 
         /*--------------------*/
 
+        /**
+         * Sets indexing mode of ring buffer: when
+         * <C>hasMaskedIndexing</C> is set, the capacity of the buffer
+         * is rounded up to the next power of two and all accesses
+         * use a bit mask instead of a modulus calculation; the
+         * logical length is unchanged, but the buffer is cleared
+         *
+         * @param[in] hasMaskedIndexing  tells whether masked indexing
+         *                               is used
+         */
+        void setMaskedIndexing (IN Boolean hasMaskedIndexing);
+
+        /*--------------------*/
+
+        /**
+         * Makes the ring buffer use the external array
+         * <C>sampleArray</C> with <C>capacity</C> sample slots
+         * instead of its own storage (e.g.\ a segment of an arena
+         * shared by several ring buffers); the current contents are
+         * copied into the new array.  Assumes that <C>capacity</C>
+         * suffices for the current length and that the array
+         * outlives the usage in this ring buffer.
+         *
+         * @param[in] sampleArray  external storage for samples
+         * @param[in] capacity     count of sample slots in
+         *                         <C>sampleArray</C>
+         */
+        void setStorage (INOUT AudioSample* sampleArray,
+                         IN Natural capacity);
+
+        /*--------------------*/
+
         /**
          * Returns length of ring buffer
          *
@@ -92,6 +170,27 @@ namespace Audio {
 
         /*--------------------*/
 
+        /**
+         * Returns number of sample slots used by ring buffer (which
+         * is its length rounded up to a power of two for masked
+         * indexing)
+         *
+         * @return  used capacity in samples
+         */
+        Natural capacity () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of bytes allocated on the heap by ring
+         * buffer (zero for external storage)
+         *
+         * @return  count of owned bytes
+         */
+        Natural byteCount () const;
+
+        /*--------------------*/
+
         /**
          * Gets sample in ring buffer at <C>position</C> (where position
          * starts at 0)
@@ -211,6 +310,53 @@ namespace Audio {
 
         /*--------------------*/
 
+        /**
+         * Appends the <C>count</C> samples in <C>sampleArray</C> to
+         * the end of the ring buffer dropping the same number of
+         * samples from its front; this is equivalent to
+         * <C>count</C> left shifts, but done by at most two block
+         * copies around the wrap point.  Assumes that <C>count</C>
+         * does not exceed the length of the ring buffer.
+         *
+         * @param[in] sampleArray  array of samples to be appended
+         * @param[in] count        number of samples to be appended
+         */
+        void writeBlock (IN AudioSample* sampleArray,
+                         IN Natural count);
+
+        /*--------------------*/
+
+        /**
+         * Copies <C>count</C> samples starting at <C>position</C> in
+         * ring buffer into <C>sampleArray</C> by at most two block
+         * copies; for a delay line with the oldest sample first, a
+         * position of 0 returns the next <C>count</C> delayed
+         * samples.  Assumes that <C>position + count</C> does not
+         * exceed the length of the ring buffer.
+         *
+         * @param[in]  position     start position in ring buffer
+         * @param[out] sampleArray  array of samples read
+         * @param[in]  count        number of samples to be read
+         */
+        void readBlock (IN Natural position,
+                        OUT AudioSample* sampleArray,
+                        IN Natural count) const;
+
+        /*--------------------*/
+
+        /**
+         * Returns pointer to sample at <C>position</C> in ring buffer
+         * and sets <C>spanLength</C> to the number of logically
+         * following samples that are stored contiguously from there
+         * (i.e.\ up to the wrap point or the end of the buffer).
+         *
+         * @param[in]  position    start position in ring buffer
+         * @param[out] spanLength  count of contiguous samples
+         * @return  pointer to first sample of span
+         */
+        const AudioSample* contiguousSpan (IN Natural position,
+                                           OUT Natural& spanLength) const;
+
         /**
          * Gets all elements in ring buffer in ordered form into
          * <C>elementArray</C>.  Assumes that capacity of target is
@@ -220,12 +366,36 @@ namespace Audio {
          */
         void toArray (OUT AudioSample* elementArray) const;
 
+        /*--------------------*/
+        /* state transfer     */
+        /*--------------------*/
+
+        /**
+         * Appends the samples of ring buffer in logical order to
+         * <C>stream</C>.
+         *
+         * @param[inout] stream  state stream to be written
+         */
+        void saveState (INOUT DspStateStream& stream) const;
+
+        /*--------------------*/
+
+        /**
+         * Reads the samples of ring buffer from <C>stream</C>; the
+         * stream becomes invalid when the stored length differs
+         * from the current length.
+         *
+         * @param[inout] stream  state stream to be read
+         */
+        void restoreState (INOUT DspStateStream& stream);
+
         /*--------------------*/
         /*--------------------*/
 
         private:
 
-            /** the allocated length of the ring buffer */
+            /** the allocated length of the ring buffer (either in
+             * <C>_data</C> or in external storage) */
             Natural _allocatedLength;
 
             /** the effective length of the ring buffer */
@@ -235,8 +405,25 @@ namespace Audio {
              * buffer */
             Natural _firstIndex;
 
-            /** the elements of the ring buffer as a vector */
-            GenericList<AudioSample> _data;
+            /** tells whether the capacity is a power of two and
+             * indexing is done by a bit mask */
+            Boolean _hasMaskedIndexing;
+
+            /** the bit mask for indexing (capacity - 1) when
+             * <C>_hasMaskedIndexing</C> is set */
+            Natural _indexMask;
+
+            /** tells whether the samples are held in external
+             * storage instead of <C>_data</C> */
+            Boolean _hasExternalStorage;
+
+            /** the effective storage of the samples: either the
+             * array of <C>_data</C> or some external array */
+            AudioSample* _sampleArray;
+
+            /** the owned elements of the ring buffer as an aligned
+             * list (unused for external storage) */
+            AudioSampleList _data;
 
     };
 }
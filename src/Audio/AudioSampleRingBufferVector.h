@@ -1,7 +1,8 @@
 /**
  * @file
  * The <C>AudioSampleRingBufferVector</C> specification defines a
- * two-dimensional list of ring buffers for audio samples.
+ * two-dimensional list of ring buffers for audio samples with a
+ * common sample storage.
  *
  * @author Dr. Thomas Tensi
  * @date   2020-08
@@ -31,6 +32,12 @@ namespace Audio {
      * A <C>AudioSampleRingBufferVector</C> object is a list of ring
      * buffers for audio samples with selection by index and left or
      * right rotation on the individual buffers.
+     *
+     * All ring buffers share a single cache-line aligned sample
+     * arena where buffer <C>i</C> occupies a fixed segment at offset
+     * <C>i * stride</C>; the buffers of a channel are adjacent, so
+     * walking them for one sample touches consecutive cache lines
+     * instead of scattered heap blocks.
      */
     struct AudioSampleRingBufferVector {
 
@@ -57,6 +64,29 @@ namespace Audio {
 
         /*--------------------*/
 
+        /**
+         * Makes a copy of <C>otherVector</C> with its own sample
+         * arena.
+         *
+         * @param[in] otherVector  ring buffer vector to be copied
+         */
+        AudioSampleRingBufferVector
+            (IN AudioSampleRingBufferVector& otherVector);
+
+        /*--------------------*/
+
+        /**
+         * Assigns <C>otherVector</C> to current vector copying all
+         * ring buffers into the own sample arena.
+         *
+         * @param[in] otherVector  ring buffer vector to be copied
+         * @return  reference to current vector
+         */
+        AudioSampleRingBufferVector&
+        operator= (IN AudioSampleRingBufferVector& otherVector);
+
+        /*--------------------*/
+
         /**
          * Returns string representation of sample ring buffer list;;
          * if <C>audioFrameCount</C> is set, only that number of audio
@@ -98,6 +128,16 @@ namespace Audio {
 
         /*--------------------*/
 
+        /**
+         * Returns the number of bytes allocated on the heap by the
+         * vector: the sample arena and the ring buffer list.
+         *
+         * @return  count of owned bytes
+         */
+        Natural byteCount () const;
+
+        /*--------------------*/
+
         /**
          * Sets count of all ring buffers to <C>count</C>
          *
@@ -107,6 +147,23 @@ namespace Audio {
 
         /*--------------------*/
 
+        /**
+         * Sets the shape of vector to <C>channelCount</C> channels
+         * with <C>ringBufferCountPerChannel</C> ring buffers in each
+         * channel; the ring buffer length is kept, but all buffers
+         * are set to zero.  References to ring buffers from before
+         * the call become invalid.
+         *
+         * @param[in] channelCount               the new number of
+         *                                       channels
+         * @param[in] ringBufferCountPerChannel  the new number of ring
+         *                                       buffers per channel
+         */
+        void resize (IN Natural channelCount,
+                     IN Natural ringBufferCountPerChannel);
+
+        /*--------------------*/
+
         /**
          * Sets length of all ring buffers to <C>length</C>
          *
@@ -117,6 +174,18 @@ namespace Audio {
 
         /*--------------------*/
 
+        /**
+         * Sets indexing mode of all ring buffers to masked indexing
+         * with a power of two capacity when <C>hasMaskedIndexing</C>
+         * is set (see <C>AudioSampleRingBuffer::setMaskedIndexing</C>)
+         *
+         * @param[in] hasMaskedIndexing  tells whether masked indexing
+         *                               is used
+         */
+        void setMaskedIndexing (IN Boolean hasMaskedIndexing);
+
+        /*--------------------*/
+
         /**
          * Removes all sample ring buffers
          */
@@ -134,14 +203,13 @@ namespace Audio {
 
         /**
          * Returns reference to sample ring buffer for channel with
-         * <C>channelIndex</C> and <C>position</C> (where this may
-         * be 0 or 1 when <C>_hasTwoRingBuffersPerChannel</C> has been
-         * set
+         * <C>channelIndex</C> and <C>position</C> (where this is
+         * less than the count of ring buffers per channel)
          *
          * @param[in] channelIndex  number of channel to be selected
          *                          (starting at zero)
-         * @param[in] position      if channel has two ring buffers, an
-         *                          additional selection parameter
+         * @param[in] position      if channel has several ring buffers,
+         *                          an additional selection parameter
          * @return reference to appropriate ring buffer in vector
          */
         AudioSampleRingBuffer& at (IN Natural channelIndex,
@@ -151,8 +219,8 @@ namespace Audio {
 
         /**
          * Returns reference to sample ringBuffer for channel with
-         * <C>channelIndex</C>; is only allowed when
-         * <C>_hasTwoRingBuffersPerChannel</C> is not set
+         * <C>channelIndex</C>; is only allowed when there is a
+         * single ring buffer per channel
          *
          * @param[in] channelIndex  number of channel to be
          *                          selected (starting at zero)
@@ -164,8 +232,8 @@ namespace Audio {
 
         /**
          * Returns reference to sample ring buffer for channel with
-         * <C>channelIndex</C>; is only allowed when
-         * <C>_hasTwoRingBuffersPerChannel</C> is not set
+         * <C>channelIndex</C>; is only allowed when there is a
+         * single ring buffer per channel
          *
          * @param[in] channelIndex  number of channel to be
          *                          selected (starting at zero)
@@ -176,7 +244,9 @@ namespace Audio {
         /*--------------------*/
 
         /**
-         * Appends <C>sampleRingBuffer</C> as last element.
+         * Appends a copy of <C>sampleRingBuffer</C> as last element;
+         * the sample arena is rebuilt and references to ring buffers
+         * from before the call become invalid.
          *
          * @param[in] sampleRingBuffer  ring buffer to be appended as
          *                              last element of matrix
@@ -192,14 +262,73 @@ namespace Audio {
          */
         AudioSampleRingBuffer& last ();
 
+        /*--------------------*/
+        /* state transfer     */
+        /*--------------------*/
+
+        /**
+         * Appends the samples of all ring buffers to
+         * <C>stream</C>.
+         *
+         * @param[inout] stream  state stream to be written
+         */
+        void saveState (INOUT DspStateStream& stream) const;
+
+        /*--------------------*/
+
+        /**
+         * Reads the samples of all ring buffers from
+         * <C>stream</C>; the stream becomes invalid when the stored
+         * count or lengths of the ring buffers differ from the
+         * current ones.
+         *
+         * @param[inout] stream  state stream to be read
+         */
+        void restoreState (INOUT DspStateStream& stream);
+
         /*--------------------*/
         /*--------------------*/
 
         private:
 
-            /** flag to tell whether one or two ring buffers per
-             * channel are used in matrix */
-            Boolean _hasTwoRingBuffersPerChannel;
+            /**
+             * Reallocates the sample arena with a segment of at least
+             * <C>capacity</C> samples per ring buffer (and at least
+             * the capacity of each ring buffer) and moves all ring
+             * buffers into it.
+             *
+             * @param[in] capacity  minimum sample capacity per ring
+             *                      buffer
+             */
+            void _rebuildArena (IN Natural capacity);
+
+            /*--------------------*/
+
+            /**
+             * Sets count of ring buffers to <C>count</C> with length
+             * <C>length</C> and the current indexing mode and moves
+             * them into a fresh sample arena; all ring buffers are
+             * set to zero.
+             *
+             * @param[in] count   the new count of ring buffers
+             * @param[in] length  the new length of each ring buffer
+             */
+            void _reshape (IN Natural count, IN Natural length);
+
+            /*--------------------*/
+
+            /** the number of ring buffers per channel */
+            Natural _ringBufferCountPerChannel;
+
+            /** tells whether all ring buffers use masked indexing */
+            Boolean _hasMaskedIndexing;
+
+            /** the distance of ring buffer segments in the arena (in
+             * samples, a multiple of the cache line size) */
+            Natural _stride;
+
+            /** the common sample storage of all ring buffers */
+            AudioSampleList _arena;
 
             /** the list of sample ring buffers */
             GenericList<AudioSampleRingBuffer> _data;
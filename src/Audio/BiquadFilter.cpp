@@ -0,0 +1,23 @@
+/**
+ * @file
+ * The <C>BiquadFilter</C> body implements a second order infinite
+ * impulse response filter in transposed direct form II <I>(this is
+ * the formal CPP file used when not doing inlining in production
+ * code)</I>.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-01
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "BiquadFilter.h"
+
+/*====================*/
+
+#ifdef DEBUG
+    /* module implementation contains functions */
+    #include "BiquadFilter.cpp-inc"
+#endif
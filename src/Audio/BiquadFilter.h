@@ -0,0 +1,407 @@
+/**
+ * @file
+ * The <C>BiquadFilter</C> specification defines a second order
+ * infinite impulse response filter in transposed direct form II.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-01
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "AudioSample.h"
+#include "Natural.h"
+
+/*====================*/
+
+using Audio::AudioSample;
+using BaseTypes::Primitives::Natural;
+
+/*====================*/
+
+namespace Audio {
+
+    /**
+     * A <C>BiquadFilterState</C> object holds the two state variables
+     * of a biquad filter in transposed direct form II for a single
+     * channel.
+     */
+    struct BiquadFilterState {
+
+        /** the first state variable (delayed by one sample) */
+        AudioSample z1;
+
+        /** the second state variable (delayed by two samples) */
+        AudioSample z2;
+
+        /*--------------------*/
+
+        /**
+         * Creates a cleared filter state
+         */
+        BiquadFilterState ();
+
+        /*--------------------*/
+
+        /**
+         * Returns string representation of filter state.
+         *
+         * @return string representation
+         */
+        String toString() const;
+
+        /*--------------------*/
+
+        /**
+         * Resets both state variables to zero
+         */
+        void clear ();
+
+    };
+
+    /*--------------------*/
+
+    /**
+     * A <C>BiquadFilterShape</C> tells which structural properties
+     * of its coefficients a biquad filter kernel may rely on; a
+     * shape is kept when coefficients of the same shape are
+     * interpolated or scaled.
+     */
+    enum class BiquadFilterShape {
+        /** arbitrary coefficients */
+        general,
+        /** single pole filter with <C>b2 = a2 = 0</C> */
+        singlePole,
+        /** all-pole filter with <C>b1 = b2 = 0</C> */
+        zeroFree,
+        /** symmetric numerator with <C>b2 = b0</C> */
+        symmetric,
+        /** antisymmetric numerator with <C>b1 = 0</C> and
+         * <C>b2 = -b0</C> */
+        antisymmetric
+    };
+
+    /*--------------------*/
+
+    /**
+     * A <C>BiquadFilter</C> object is an IIR filter of fixed order 3
+     * (in SoX terminology: three coefficients each for numerator and
+     * denominator) realized in transposed direct form II; the filter
+     * only holds the coefficients, the history is kept separately
+     * per channel in a <C>BiquadFilterState</C>.
+     */
+    struct BiquadFilter {
+
+        /** a block filtering function for audio samples with the
+         * signature of <C>applyBlock</C> */
+        using BlockKernel = void (*)(IN BiquadFilter& filter,
+                                     IN AudioSample* inputArray,
+                                     OUT AudioSample* outputArray,
+                                     IN Natural count,
+                                     INOUT BiquadFilterState& state);
+
+        /** a block filtering function for float samples with the
+         * signature of <C>applyBlock</C> */
+        using FloatBlockKernel = void (*)(IN BiquadFilter& filter,
+                                          IN float* inputArray,
+                                          OUT float* outputArray,
+                                          IN Natural count,
+                                          INOUT BiquadFilterState& state);
+
+        /*--------------------*/
+
+        /**
+         * Creates a biquad filter as a null filter
+         */
+        BiquadFilter ();
+
+        /*--------------------*/
+
+        /**
+         * Returns string representation of filter.
+         *
+         * @return string representation
+         */
+        String toString() const;
+
+        /*--------------------*/
+
+        /**
+         * Resets filter to a null filter
+         */
+        void clear ();
+
+        /*--------------------*/
+
+        /**
+         * Sets filter with all zeros except for the <C>b0</C>
+         * value; b0 = 1 is an identity filter, b0 = 0 a null filter
+         *
+         * @param[in] b0  the b0 value of the biquad filter
+         */
+        void set (IN Real b0);
+
+        /*--------------------*/
+
+        /**
+         * Sets the coefficients of the biquad filter; they are
+         * normalized by <C>a0</C>
+         *
+         * @param[in] b0  the b0 value of the biquad filter
+         * @param[in] b1  the b1 value of the biquad filter
+         * @param[in] b2  the b2 value of the biquad filter
+         * @param[in] a0  the a0 value of the biquad filter
+         * @param[in] a1  the a1 value of the biquad filter
+         * @param[in] a2  the a2 value of the biquad filter
+         */
+        void set (IN Real b0, IN Real b1, IN Real b2,
+                  IN Real a0, IN Real a1, IN Real a2);
+
+        /*--------------------*/
+
+        /**
+         * Multiplies the numerator coefficients by <C>factor</C>,
+         * i.e. folds a constant gain applied after the filter into
+         * the filter itself
+         *
+         * @param[in] factor  the gain factor to be folded in
+         */
+        void scale (IN Real factor);
+
+        /*--------------------*/
+
+        /**
+         * Applies biquad filter to single sample <C>inputSample</C>
+         * with history in <C>state</C> and returns filtered sample
+         *
+         * @param[in]    inputSample  the sample to be filtered
+         * @param[inout] state        the filter history for the channel
+         * @return  filtered sample
+         */
+        AudioSample apply (IN AudioSample inputSample,
+                           INOUT BiquadFilterState& state) const;
+
+        /*--------------------*/
+
+        /**
+         * Applies biquad filter to <C>count</C> samples in
+         * <C>inputArray</C> and writes the results into
+         * <C>outputArray</C> with history in <C>state</C>; input
+         * and output array may be identical for an in-place
+         * operation
+         *
+         * @param[in]    inputArray   the array with the input samples
+         * @param[out]   outputArray  the array for the output samples
+         * @param[in]    count        the number of samples to process
+         * @param[inout] state        the filter history for the channel
+         */
+        void applyBlock (IN AudioSample* inputArray,
+                         OUT AudioSample* outputArray,
+                         IN Natural count,
+                         INOUT BiquadFilterState& state) const;
+
+        /*--------------------*/
+
+        /**
+         * Applies biquad filter to <C>count</C> float samples in
+         * <C>inputArray</C> and writes the results into
+         * <C>outputArray</C> with history in <C>state</C>; the
+         * recursion is calculated in audio samples for precision, so
+         * only the sample storage is in float; input and output
+         * array may be identical for an in-place operation
+         *
+         * @param[in]    inputArray   the array with the input samples
+         * @param[out]   outputArray  the array for the output samples
+         * @param[in]    count        the number of samples to process
+         * @param[inout] state        the filter history for the channel
+         */
+        void applyBlock (IN float* inputArray,
+                         OUT float* outputArray,
+                         IN Natural count,
+                         INOUT BiquadFilterState& state) const;
+
+        /*--------------------*/
+
+        /**
+         * Applies this biquad filter followed by
+         * <C>nextFilter</C> to <C>count</C> samples in
+         * <C>inputArray</C> in a single pass and writes the results
+         * into <C>outputArray</C> with histories in <C>state</C>
+         * and <C>nextState</C>; this is equivalent to two
+         * consecutive calls of <C>applyBlock</C> without the
+         * intermediate memory pass; input and output array may be
+         * identical for an in-place operation
+         *
+         * @param[in]    nextFilter   the filter applied second
+         * @param[in]    inputArray   the array with the input samples
+         * @param[out]   outputArray  the array for the output samples
+         * @param[in]    count        the number of samples to process
+         * @param[inout] state        the filter history for the channel
+         * @param[inout] nextState    the history of the second filter
+         *                            for the channel
+         */
+        void applyBlockCascaded (IN BiquadFilter& nextFilter,
+                                 IN AudioSample* inputArray,
+                                 OUT AudioSample* outputArray,
+                                 IN Natural count,
+                                 INOUT BiquadFilterState& state,
+                                 INOUT BiquadFilterState& nextState) const;
+
+        /*--------------------*/
+
+        /**
+         * Applies this biquad filter followed by
+         * <C>nextFilter</C> to <C>count</C> float samples in
+         * <C>inputArray</C> in a single pass and writes the results
+         * into <C>outputArray</C> with histories in <C>state</C>
+         * and <C>nextState</C>; the intermediate signal is kept in
+         * audio samples, so the result is the one of a cascade in
+         * full precision
+         *
+         * @param[in]    nextFilter   the filter applied second
+         * @param[in]    inputArray   the array with the input samples
+         * @param[out]   outputArray  the array for the output samples
+         * @param[in]    count        the number of samples to process
+         * @param[inout] state        the filter history for the channel
+         * @param[inout] nextState    the history of the second filter
+         *                            for the channel
+         */
+        void applyBlockCascaded (IN BiquadFilter& nextFilter,
+                                 IN float* inputArray,
+                                 OUT float* outputArray,
+                                 IN Natural count,
+                                 INOUT BiquadFilterState& state,
+                                 INOUT BiquadFilterState& nextState) const;
+
+        /*--------------------*/
+
+        /**
+         * Applies biquad filter to <C>count</C> samples of two
+         * channels in parallel: samples from <C>inputArrayA</C> and
+         * <C>inputArrayB</C> are filtered into <C>outputArrayA</C>
+         * and <C>outputArrayB</C> with independent histories in
+         * <C>stateA</C> and <C>stateB</C>; both channels are
+         * processed in a single vector register by the kernel for
+         * the processor (see <C>Kernels</C>), otherwise a scalar
+         * fallback is used; input and output arrays may be
+         * identical
+         *
+         * @param[in]    inputArrayA   the input samples of first channel
+         * @param[in]    inputArrayB   the input samples of second channel
+         * @param[out]   outputArrayA  the output samples of first channel
+         * @param[out]   outputArrayB  the output samples of second channel
+         * @param[in]    count         the number of samples per channel
+         * @param[inout] stateA        the filter history of first channel
+         * @param[inout] stateB        the filter history of second channel
+         */
+        void applyBlockStereo (IN AudioSample* inputArrayA,
+                               IN AudioSample* inputArrayB,
+                               OUT AudioSample* outputArrayA,
+                               OUT AudioSample* outputArrayB,
+                               IN Natural count,
+                               INOUT BiquadFilterState& stateA,
+                               INOUT BiquadFilterState& stateB) const;
+
+        /*--------------------*/
+
+        /**
+         * Applies biquad filter in place to <C>count</C> samples of
+         * four channels in parallel: the sample arrays are the first
+         * four entries of <C>channelArray</C> with independent
+         * histories in the first four entries of
+         * <C>stateArray</C>; on processors with AVX2 all channels
+         * are processed in a single vector register (see
+         * <C>Kernels</C>), otherwise they are processed as two
+         * stereo pairs
+         *
+         * @param[inout] channelArray  the sample arrays of the four
+         *                             channels
+         * @param[in]    count         the number of samples per channel
+         * @param[inout] stateArray    the filter histories of the four
+         *                             channels
+         */
+        void applyBlockQuad (INOUT AudioSample* const* channelArray,
+                             IN Natural count,
+                             INOUT BiquadFilterState* const* stateArray)
+            const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the block kernel for audio samples specialized for
+         * coefficients of <C>shape</C>: it only does the arithmetic
+         * needed for that shape and gives the same results as
+         * <C>applyBlock</C> for such coefficients; the kernel may be
+         * selected once when the shape of a filter is known
+         *
+         * @param[in] shape  the shape of the filter coefficients
+         * @return  kernel for filtering a block of audio samples
+         */
+        static BlockKernel blockKernel (IN BiquadFilterShape shape);
+
+        /*--------------------*/
+
+        /**
+         * Returns the block kernel for float samples specialized for
+         * coefficients of <C>shape</C> (see <C>blockKernel</C>)
+         *
+         * @param[in] shape  the shape of the filter coefficients
+         * @return  kernel for filtering a block of float samples
+         */
+        static FloatBlockKernel floatBlockKernel
+                                    (IN BiquadFilterShape shape);
+
+        /*--------------------*/
+        /*--------------------*/
+
+        protected:
+
+            /**
+             * Applies <C>filter</C> with coefficients of shape
+             * <C>shape</C> to <C>count</C> samples in
+             * <C>inputArray</C> and writes the results into
+             * <C>outputArray</C> with history in <C>state</C>.
+             *
+             * @tparam       shape        the shape of the coefficients
+             * @tparam       SampleType   type of samples in arrays
+             * @param[in]    filter       the filter to be applied
+             * @param[in]    inputArray   the array with the input
+             *                            samples
+             * @param[out]   outputArray  the array for the output
+             *                            samples
+             * @param[in]    count        the number of samples to
+             *                            process
+             * @param[inout] state        the filter history for the
+             *                            channel
+             */
+            template <BiquadFilterShape shape, typename SampleType>
+            static void _applyShapedBlock (IN BiquadFilter& filter,
+                                           IN SampleType* inputArray,
+                                           OUT SampleType* outputArray,
+                                           IN Natural count,
+                                           INOUT BiquadFilterState& state);
+
+            /*--------------------*/
+
+            Real _b0; /**< normalized filter coefficient b0 */
+            Real _b1; /**< normalized filter coefficient b1 */
+            Real _b2; /**< normalized filter coefficient b2 */
+            Real _a1; /**< normalized filter coefficient a1 */
+            Real _a2; /**< normalized filter coefficient a2 */
+
+    };
+
+}
+
+//============================================================
+
+#ifndef DEBUG
+    //production code is inlined
+    #include "BiquadFilter.cpp-inc"
+#endif
@@ -0,0 +1,152 @@
+/**
+ * @file
+ * The <C>DenormalGuard</C> specification and body provides a scoped
+ * switch of the floating point unit into flush-to-zero mode and a
+ * deterministic flushing of tiny values for platforms without such
+ * a mode.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-02
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include <cstdint>
+#include "AudioSample.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <xmmintrin.h>
+    #define DenormalGuard_usesMXCSR
+    #define DenormalGuard_flushesToZero
+#elif defined(__aarch64__) && !defined(_MSC_VER)
+    #define DenormalGuard_usesFPCR
+    #define DenormalGuard_flushesToZero
+#endif
+
+/*====================*/
+
+namespace Audio {
+
+    /**
+     * A <C>DenormalGuard</C> object switches the floating point unit
+     * of the current thread into flush-to-zero mode (on x86 also
+     * denormals-are-zero) during its lifetime and restores the
+     * previous mode on destruction; this keeps decaying recursive
+     * filters from running into the slow denormal arithmetic.
+     *
+     * On platforms without such a mode the guard does nothing;
+     * there the recursive kernels flush their state via
+     * <C>flushed</C>, which is a no-op otherwise.
+     */
+    struct DenormalGuard {
+
+        /**
+         * Switches current thread into flush-to-zero mode.
+         */
+        DenormalGuard ()
+        {
+            #if defined(DenormalGuard_usesMXCSR)
+                _previousMode = _mm_getcsr();
+                _mm_setcsr(_previousMode | _mxcsrFlushBits);
+            #elif defined(DenormalGuard_usesFPCR)
+                std::uint64_t mode;
+                __asm__ __volatile__("mrs %0, fpcr" : "=r" (mode));
+                _previousMode = mode;
+                mode |= _fpcrFlushBit;
+                __asm__ __volatile__("msr fpcr, %0" : : "r" (mode));
+            #endif
+        }
+
+        /*--------------------*/
+
+        /**
+         * Restores floating point mode of current thread.
+         */
+        ~DenormalGuard ()
+        {
+            #if defined(DenormalGuard_usesMXCSR)
+                _mm_setcsr(_previousMode);
+            #elif defined(DenormalGuard_usesFPCR)
+                const std::uint64_t mode = _previousMode;
+                __asm__ __volatile__("msr fpcr, %0" : : "r" (mode));
+            #endif
+        }
+
+        /*--------------------*/
+
+        DenormalGuard (IN DenormalGuard&) = delete;
+
+        /*--------------------*/
+
+        /**
+         * Returns <C>x</C> with magnitudes far below the audible
+         * range (about 1E-46) flushed to zero on platforms without a
+         * flush-to-zero mode by adding and subtracting a tiny
+         * offset; this introduces no DC and is deterministic.  On
+         * all other platforms <C>x</C> is returned unchanged.
+         *
+         * @param[in] x  value written back into a recursion
+         * @return  value with tiny magnitudes flushed to zero
+         */
+        static inline AudioSample flushed (IN AudioSample x)
+        {
+            #if defined(DenormalGuard_flushesToZero)
+                return x;
+            #else
+                const Real offset{_antiDenormalOffset};
+                return (x + offset) - offset;
+            #endif
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns <C>x</C> with magnitudes far below the audible
+         * range flushed to zero on platforms without a flush-to-zero
+         * mode; variant of <C>flushed</C> for recursions kept in
+         * plain double registers.
+         *
+         * @param[in] x  value written back into a recursion
+         * @return  value with tiny magnitudes flushed to zero
+         */
+        static inline double flushed (IN double x)
+        {
+            #if defined(DenormalGuard_flushesToZero)
+                return x;
+            #else
+                return (x + _antiDenormalOffset) - _antiDenormalOffset;
+            #endif
+        }
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the offset used for flushing tiny values */
+            static constexpr double _antiDenormalOffset = 1E-30;
+
+            #if defined(DenormalGuard_usesMXCSR)
+                /** the flush-to-zero and denormals-are-zero bits
+                 * of the MXCSR register */
+                static const unsigned int _mxcsrFlushBits = 0x8040;
+
+                /** the MXCSR register before construction */
+                unsigned int _previousMode;
+            #elif defined(DenormalGuard_usesFPCR)
+                /** the flush-to-zero bit of the FPCR register */
+                static const std::uint64_t _fpcrFlushBit = 1ull << 24;
+
+                /** the FPCR register before construction */
+                std::uint64_t _previousMode;
+            #endif
+
+    };
+
+}
@@ -0,0 +1,127 @@
+/**
+ * @file
+ * The <C>DspStateStream</C> body implements a binary stream for
+ * saving and restoring the internal state of signal processing
+ * components (like delay lines or filter histories).
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "DspStateStream.h"
+
+#include <cstring>
+#include "Logging.h"
+
+/*--------------------*/
+
+using Audio::DspStateStream;
+
+/*====================*/
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+DspStateStream::DspStateStream ()
+    : _byteList{},
+      _position{0},
+      _isOkay{true}
+{
+}
+
+/*--------------------*/
+
+DspStateStream::DspStateStream (IN ByteList& byteList)
+    : _byteList{byteList},
+      _position{0},
+      _isOkay{true}
+{
+}
+
+/*--------------------*/
+/* queries            */
+/*--------------------*/
+
+const ByteList& DspStateStream::byteList () const
+{
+    return _byteList;
+}
+
+/*--------------------*/
+
+Boolean DspStateStream::isOkay () const
+{
+    return _isOkay;
+}
+
+/*--------------------*/
+
+Boolean DspStateStream::isAtEnd () const
+{
+    return (_position == _byteList.size());
+}
+
+/*--------------------*/
+
+void DspStateStream::invalidate ()
+{
+    Logging_trace1("--: invalid at position %1",
+                   TOSTRING(Natural{_position}));
+    _isOkay = false;
+}
+
+/*--------------------*/
+/* raw access         */
+/*--------------------*/
+
+void DspStateStream::writeBytes (IN void* source,
+                                 IN Natural byteCount)
+{
+    const size_t count = (size_t) byteCount;
+    const size_t position = _byteList.size();
+    _byteList.resize(position + count);
+
+    if (count > 0) {
+        std::memcpy(_byteList.data() + position, source, count);
+    }
+}
+
+/*--------------------*/
+
+void DspStateStream::readBytes (OUT void* target,
+                                IN Natural byteCount)
+{
+    const size_t count = (size_t) byteCount;
+
+    if (_position + count > _byteList.size()) {
+        invalidate();
+    }
+
+    if (_isOkay && count > 0) {
+        std::memcpy(target, _byteList.data() + _position, count);
+        _position += count;
+    }
+}
+
+/*--------------------*/
+/* typed access       */
+/*--------------------*/
+
+void DspStateStream::writeString (IN String& st)
+{
+    writeArray(st.data(), Natural{st.size()});
+}
+
+/*--------------------*/
+
+void DspStateStream::readString (OUT String& st)
+{
+    String result;
+    readList(result);
+    st = result;
+}
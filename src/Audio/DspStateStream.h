@@ -0,0 +1,298 @@
+/**
+ * @file
+ * The <C>DspStateStream</C> specification defines a binary stream
+ * for saving and restoring the internal state of signal processing
+ * components (like delay lines or filter histories).
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include <type_traits>
+#include "ByteList.h"
+#include "MyString.h"
+#include "Natural.h"
+
+/*--------------------*/
+
+using BaseTypes::Containers::ByteList;
+using BaseTypes::Primitives::Boolean;
+using BaseTypes::Primitives::Natural;
+using BaseTypes::Primitives::String;
+
+/*====================*/
+
+namespace Audio {
+
+    /**
+     * A <C>DspStateStream</C> object collects the state of signal
+     * processing components as a compact binary blob in a byte list
+     * or reads it back from such a blob.  Values are stored in their
+     * raw memory layout, hence a blob can only be restored on the
+     * same platform and into components with the same configuration
+     * (like sample rate, channel count or delay lengths); the
+     * floating point values are restored bit by bit.
+     *
+     * Arrays are stored with their element count and reading checks
+     * it against the capacity of the target; any mismatch or a read
+     * beyond the end marks the stream as invalid, all later reads
+     * are then ignored.  Hence a component simply reads its state
+     * and the caller checks the validity at the end.
+     */
+    struct DspStateStream {
+
+        /**
+         * Makes an empty stream for writing.
+         */
+        DspStateStream ();
+
+        /*--------------------*/
+
+        /**
+         * Makes a stream for reading the blob <C>byteList</C>.
+         *
+         * @param[in] byteList  blob with state data
+         */
+        DspStateStream (IN ByteList& byteList);
+
+        /*--------------------*/
+        /* queries            */
+        /*--------------------*/
+
+        /**
+         * Returns the blob written so far (or the blob read).
+         *
+         * @return  byte list with state data
+         */
+        const ByteList& byteList () const;
+
+        /*--------------------*/
+
+        /**
+         * Tells whether all reads have been consistent with the
+         * blob so far.
+         *
+         * @return  information whether stream is valid
+         */
+        Boolean isOkay () const;
+
+        /*--------------------*/
+
+        /**
+         * Tells whether all data of the blob has been read.
+         *
+         * @return  information whether read position is at end
+         */
+        Boolean isAtEnd () const;
+
+        /*--------------------*/
+
+        /**
+         * Marks the stream as invalid; used by a component when the
+         * state read does not fit its configuration.
+         */
+        void invalidate ();
+
+        /*--------------------*/
+        /* raw access         */
+        /*--------------------*/
+
+        /**
+         * Appends the <C>byteCount</C> bytes at <C>source</C> to the
+         * blob.
+         *
+         * @param[in] source     start of bytes to be written
+         * @param[in] byteCount  number of bytes
+         */
+        void writeBytes (IN void* source,
+                         IN Natural byteCount);
+
+        /*--------------------*/
+
+        /**
+         * Reads the next <C>byteCount</C> bytes of the blob into
+         * <C>target</C>; when the blob has not enough bytes left or
+         * the stream is invalid, the target is left unchanged and
+         * the stream becomes invalid.
+         *
+         * @param[out] target     start of bytes to be read
+         * @param[in]  byteCount  number of bytes
+         */
+        void readBytes (OUT void* target,
+                        IN Natural byteCount);
+
+        /*--------------------*/
+        /* typed access       */
+        /*--------------------*/
+
+        /**
+         * Appends the raw representation of <C>value</C> to the
+         * blob.
+         *
+         * @tparam T  trivially copyable type of value
+         * @param[in] value  value to be written
+         */
+        template<typename T>
+        void write (IN T& value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value,
+                          "state values must be trivially copyable");
+            writeBytes(&value, Natural{sizeof(T)});
+        }
+
+        /*--------------------*/
+
+        /**
+         * Reads <C>value</C> from its raw representation in the
+         * blob.
+         *
+         * @tparam T  trivially copyable type of value
+         * @param[out] value  value to be read
+         */
+        template<typename T>
+        void read (OUT T& value)
+        {
+            static_assert(std::is_trivially_copyable<T>::value,
+                          "state values must be trivially copyable");
+            readBytes(&value, Natural{sizeof(T)});
+        }
+
+        /*--------------------*/
+
+        /**
+         * Appends the element count <C>count</C> and the raw
+         * representation of the elements of <C>array</C> to the
+         * blob.
+         *
+         * @tparam T  trivially copyable type of elements
+         * @param[in] array  array of elements to be written
+         * @param[in] count  number of elements
+         */
+        template<typename T>
+        void writeArray (IN T* array, IN Natural count)
+        {
+            static_assert(std::is_trivially_copyable<T>::value,
+                          "state values must be trivially copyable");
+            write(count);
+            writeBytes(array, count * Natural{sizeof(T)});
+        }
+
+        /*--------------------*/
+
+        /**
+         * Reads <C>count</C> elements into <C>array</C> from the
+         * blob; when the stored element count differs, the array is
+         * left unchanged and the stream becomes invalid.
+         *
+         * @tparam T  trivially copyable type of elements
+         * @param[out] array  array of elements to be read
+         * @param[in]  count  number of elements expected
+         */
+        template<typename T>
+        void readArray (OUT T* array, IN Natural count)
+        {
+            static_assert(std::is_trivially_copyable<T>::value,
+                          "state values must be trivially copyable");
+            Natural storedCount = 0;
+            read(storedCount);
+
+            if (storedCount != count) {
+                invalidate();
+            }
+
+            readBytes(array, count * Natural{sizeof(T)});
+        }
+
+        /*--------------------*/
+
+        /**
+         * Appends the length and the elements of <C>list</C> (a
+         * list with contiguous elements like a
+         * <C>GenericList</C>) to the blob.
+         *
+         * @tparam L  list type with trivially copyable elements
+         * @param[in] list  list to be written
+         */
+        template<typename L>
+        void writeList (IN L& list)
+        {
+            writeArray(list.data(), Natural{list.size()});
+        }
+
+        /*--------------------*/
+
+        /**
+         * Reads the elements of <C>list</C> from the blob and
+         * adjusts its length to the stored length before (hence
+         * this may allocate); a stored length exceeding the rest of
+         * the blob makes the stream invalid.
+         *
+         * @tparam L  list type with trivially copyable elements
+         * @param[inout] list  list to be read
+         */
+        template<typename L>
+        void readList (INOUT L& list)
+        {
+            using T = typename L::value_type;
+            const size_t position = _position;
+            Natural storedCount = 0;
+            read(storedCount);
+            const size_t remainingCount =
+                (_byteList.size() - _position) / sizeof(T);
+            _position = position;
+
+            if ((size_t) storedCount > remainingCount) {
+                invalidate();
+            }
+
+            if (_isOkay) {
+                list.resize((size_t) storedCount);
+            }
+
+            readArray(list.data(), Natural{list.size()});
+        }
+
+        /*--------------------*/
+
+        /**
+         * Appends the length and the characters of <C>st</C> to the
+         * blob.
+         *
+         * @param[in] st  string to be written
+         */
+        void writeString (IN String& st);
+
+        /*--------------------*/
+
+        /**
+         * Reads <C>st</C> from the blob.
+         *
+         * @param[out] st  string to be read
+         */
+        void readString (OUT String& st);
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the blob with the state data */
+            ByteList _byteList;
+
+            /** the read position in blob */
+            size_t _position;
+
+            /** tells whether all reads have been consistent */
+            Boolean _isOkay;
+
+    };
+
+}
@@ -0,0 +1,790 @@
+/**
+ * @file
+ * The <C>HalfBandOversampler</C> body implements an up- and
+ * downsampler by a power of two built from cascaded polyphase
+ * half-band FIR stages.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-02
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "HalfBandOversampler.h"
+
+#include <cmath>
+#include "AudioSampleList.h"
+#include "GenericTuple.h"
+#include "Logging.h"
+#include "ScratchArena.h"
+
+#if defined(AUDIO_USES_SIMD)
+    #if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+        #include <emmintrin.h>
+        /** SSE2 is used for calculating two outputs at once */
+        #define HalfBandOversampler_usesSSE2
+    #elif defined(__aarch64__) || defined(_M_ARM64)
+        #include <arm_neon.h>
+        /** NEON is used for calculating two outputs at once */
+        #define HalfBandOversampler_usesNEON
+    #endif
+#endif
+
+/*--------------------*/
+
+using Audio::AudioSampleList;
+using Audio::HalfBandOversampler;
+using Audio::ScratchArena;
+using BaseTypes::GenericTypes::GenericTuple;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
+
+/*====================*/
+
+const Natural HalfBandOversampler::maximumFactor = 8;
+const Natural HalfBandOversampler::maximumBlockLength = 256;
+
+/*====================*/
+
+namespace Audio {
+
+    /** the number of half-band stages for the maximum factor */
+    static const size_t _maximumStageCount = 3;
+
+    /** the half lengths <C>m</C> of the stage filters with
+     * <C>4m+3</C> taps each; the first stage needs the sharpest
+     * transition, the later ones only have to suppress images far
+     * above the original band */
+    static const size_t _stageHalfLengthList[_maximumStageCount] =
+        { 11, 4, 2 };
+
+    /** the shape parameter of the Kaiser window for the filter
+     * design (giving a stopband attenuation of about 80dB) */
+    static const double _kaiserBeta = 8.0;
+
+    /*--------------------*/
+
+    /**
+     * Returns the modified Bessel function of the first kind and
+     * order zero at <C>x</C> by its power series.
+     *
+     * @param[in] x  argument of Bessel function
+     * @return  value of I0(x)
+     */
+    static double _besselI0 (IN double x)
+    {
+        const double quarterXSquared = x * x / 4.0;
+        double term = 1.0;
+        double result = 1.0;
+
+        for (int k = 1;  k < 50;  k++) {
+            term *= quarterXSquared / (double) (k * k);
+            result += term;
+        }
+
+        return result;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Calculates the outputs of a symmetric FIR filter with
+     * <C>2m+2</C> taps given by their first half in
+     * <C>coefficientArray</C>: output <C>n</C> (written at
+     * <C>n * outputStride</C>) is the sum of coefficient <C>i</C>
+     * times the sum of <C>workArray[c+n-i]</C> and
+     * <C>workArray[n+i]</C> for <C>i</C> from 0 to <C>m</C>, where
+     * <C>c = 2m+1</C>; the work array starts with <C>c</C> history
+     * samples.
+     *
+     * @param[in]  coefficientArray  the first half of the coefficients
+     * @param[in]  m                 the index of the last coefficient
+     * @param[in]  workArray         history and input samples
+     * @param[out] outputArray       array for the outputs
+     * @param[in]  outputStride      distance of outputs in array
+     * @param[in]  count             number of outputs
+     */
+    static void _applyFoldedFilter (IN double* coefficientArray,
+                                    IN size_t m,
+                                    IN double* workArray,
+                                    OUT double* outputArray,
+                                    IN size_t outputStride,
+                                    IN size_t count)
+    {
+        const size_t c = 2 * m + 1;
+        size_t n = 0;
+
+        #if defined(HalfBandOversampler_usesSSE2)
+            /* two consecutive outputs at once */
+            double result[2];
+
+            for (;  n + 1 < count;  n += 2) {
+                __m128d sum = _mm_setzero_pd();
+
+                for (size_t i = 0;  i <= m;  i++) {
+                    const __m128d coefficient =
+                        _mm_set1_pd(coefficientArray[i]);
+                    const __m128d pairSum =
+                        _mm_add_pd(_mm_loadu_pd(workArray + c + n - i),
+                                   _mm_loadu_pd(workArray + n + i));
+                    sum = _mm_add_pd(sum, _mm_mul_pd(coefficient, pairSum));
+                }
+
+                _mm_storeu_pd(result, sum);
+                outputArray[n * outputStride]       = result[0];
+                outputArray[(n + 1) * outputStride] = result[1];
+            }
+        #elif defined(HalfBandOversampler_usesNEON)
+            /* two consecutive outputs at once */
+            double result[2];
+
+            for (;  n + 1 < count;  n += 2) {
+                float64x2_t sum = vdupq_n_f64(0.0);
+
+                for (size_t i = 0;  i <= m;  i++) {
+                    const float64x2_t coefficient =
+                        vdupq_n_f64(coefficientArray[i]);
+                    const float64x2_t pairSum =
+                        vaddq_f64(vld1q_f64(workArray + c + n - i),
+                                  vld1q_f64(workArray + n + i));
+                    sum = vaddq_f64(sum, vmulq_f64(coefficient, pairSum));
+                }
+
+                vst1q_f64(result, sum);
+                outputArray[n * outputStride]       = result[0];
+                outputArray[(n + 1) * outputStride] = result[1];
+            }
+        #endif
+
+        /* scalar fallback and remainder */
+        for (;  n < count;  n++) {
+            double sum = 0.0;
+
+            for (size_t i = 0;  i <= m;  i++) {
+                sum += (coefficientArray[i]
+                        * (workArray[c + n - i] + workArray[n + i]));
+            }
+
+            outputArray[n * outputStride] = sum;
+        }
+    }
+
+    /*============================================================*/
+
+    /**
+     * A <C>_HalfBandStage</C> object is a single factor-two stage of
+     * the oversampler with a half-band filter of <C>4m+3</C> taps
+     * and separate histories for up- and downsampling.  The center
+     * tap of the filter is 1/2, all other taps at an even distance
+     * from the center vanish; the remaining taps at an odd distance
+     * are stored folded (doubled for the upsampling gain).
+     */
+    struct _HalfBandStage {
+
+        /** the half length <C>m</C> of the filter */
+        size_t m;
+
+        /** the folded nonzero filter coefficients (scaled by two) */
+        AudioSampleList coefficientList;
+
+        /** the history (first <C>2m+1</C> entries) and new samples
+         * for upsampling */
+        AudioSampleList upsamplingWorkList;
+
+        /** the history (first <C>2m+1</C> entries) and new even
+         * samples for downsampling */
+        AudioSampleList evenWorkList;
+
+        /** the history (first <C>2m+1</C> entries) and new odd
+         * samples for downsampling */
+        AudioSampleList oddWorkList;
+
+        /*--------------------*/
+
+        /**
+         * Returns string representation of stage.
+         *
+         * @return string representation
+         */
+        String toString () const
+        {
+            return STR::expand("_HalfBandStage(m = %1, coefficients = %2)",
+                               TOSTRING(Natural{m}),
+                               coefficientList.toString());
+        }
+
+        /*--------------------*/
+
+        /**
+         * Designs the filter with half length <C>halfLength</C> by
+         * a Kaiser-windowed sinc and allocates the histories for
+         * at most <C>maximumLowRateCount</C> samples at the lower
+         * rate of the stage.
+         *
+         * @param[in] halfLength           the half length m of the
+         *                                 filter
+         * @param[in] maximumLowRateCount  maximum number of samples
+         *                                 at the lower rate
+         */
+        void setup (IN size_t halfLength,
+                    IN Natural maximumLowRateCount)
+        {
+            m = halfLength;
+            const size_t c = 2 * m + 1;
+            const Natural workLength = Natural{c} + maximumLowRateCount;
+            coefficientList.setLength(Natural{m + 1});
+            upsamplingWorkList.setLength(workLength);
+            evenWorkList.setLength(workLength);
+            oddWorkList.setLength(workLength);
+
+            /* the tap at odd distance k from the center is
+               sin(pi*k/2)/(pi*k) times the window; coefficient i
+               belongs to distance c - 2i */
+            const double pi = (double) Real::pi;
+            const double windowNorm = _besselI0(_kaiserBeta);
+            double sum = 0.0;
+
+            for (size_t i = 0;  i <= m;  i++) {
+                const double k = (double) (c - 2 * i);
+                const double relativePosition = k / (double) c;
+                const double window =
+                    _besselI0(_kaiserBeta
+                              * std::sqrt(1.0 - relativePosition
+                                          * relativePosition))
+                    / windowNorm;
+                const double sign = ((m - i) % 2 == 0 ? 1.0 : -1.0);
+                const double tap = sign / (pi * k) * window;
+                coefficientList[Natural{i}] = tap;
+                sum += tap;
+            }
+
+            /* normalize for unity gain at DC: the taps of one side
+               add up to 1/4, hence the doubled ones to 1/2 */
+            const Real normalizationFactor{0.5 / sum};
+
+            for (size_t i = 0;  i <= m;  i++) {
+                coefficientList[Natural{i}] =
+                    coefficientList[Natural{i}] * normalizationFactor;
+            }
+
+            reset();
+        }
+
+        /*--------------------*/
+
+        /**
+         * Clears the histories.
+         */
+        void reset ()
+        {
+            upsamplingWorkList.setToZero();
+            evenWorkList.setToZero();
+            oddWorkList.setToZero();
+        }
+
+        /*--------------------*/
+
+        /**
+         * Upsamples <C>count</C> samples in <C>inputArray</C> into
+         * <C>2 * count</C> samples in <C>outputArray</C>.
+         *
+         * @param[in]  inputArray   the input samples
+         * @param[in]  count        the number of input samples
+         * @param[out] outputArray  the output samples
+         */
+        void upsample (IN double* inputArray,
+                       IN size_t count,
+                       OUT double* outputArray)
+        {
+            const size_t c = 2 * m + 1;
+            double* workArray = (double*) upsamplingWorkList.asArray();
+
+            for (size_t n = 0;  n < count;  n++) {
+                workArray[c + n] = inputArray[n];
+            }
+
+            /* the even outputs are filtered, the odd ones are the
+               center tap only, i.e. a delayed input */
+            _applyFoldedFilter((const double*) coefficientList.asArray(),
+                               m, workArray, outputArray, 2, count);
+
+            for (size_t n = 0;  n < count;  n++) {
+                outputArray[2 * n + 1] = workArray[c + n - m];
+            }
+
+            _keepHistory(workArray, c, count);
+        }
+
+        /*--------------------*/
+
+        /**
+         * Downsamples <C>2 * count</C> samples in <C>inputArray</C>
+         * into <C>count</C> samples in <C>outputArray</C>.
+         *
+         * @param[in]  inputArray   the input samples
+         * @param[in]  count        the number of output samples
+         * @param[out] outputArray  the output samples
+         */
+        void downsample (IN double* inputArray,
+                         IN size_t count,
+                         OUT double* outputArray)
+        {
+            const size_t c = 2 * m + 1;
+            double* evenArray = (double*) evenWorkList.asArray();
+            double* oddArray  = (double*) oddWorkList.asArray();
+
+            for (size_t n = 0;  n < count;  n++) {
+                evenArray[c + n] = inputArray[2 * n];
+                oddArray[c + n]  = inputArray[2 * n + 1];
+            }
+
+            /* the even samples are filtered, the odd ones only meet
+               the center tap; the doubled coefficients are
+               compensated by the final halving */
+            _applyFoldedFilter((const double*) coefficientList.asArray(),
+                               m, evenArray, outputArray, 1, count);
+
+            for (size_t n = 0;  n < count;  n++) {
+                outputArray[n] =
+                    (outputArray[n] + oddArray[c + n - m - 1]) * 0.5;
+            }
+
+            _keepHistory(evenArray, c, count);
+            _keepHistory(oddArray, c, count);
+        }
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /**
+             * Moves the last <C>historyLength</C> samples of the
+             * <C>count</C> new samples in <C>workArray</C> to its
+             * start.
+             *
+             * @param[inout] workArray      history and new samples
+             * @param[in]    historyLength  length of history
+             * @param[in]    count          number of new samples
+             */
+            static void _keepHistory (INOUT double* workArray,
+                                      IN size_t historyLength,
+                                      IN size_t count)
+            {
+                for (size_t j = 0;  j < historyLength;  j++) {
+                    workArray[j] = workArray[count + j];
+                }
+            }
+
+    };
+
+    /*============================================================*/
+
+    /**
+     * A <C>_OversamplerDescriptor</C> object holds the stages and
+     * buffers of an oversampler.
+     */
+    struct _OversamplerDescriptor {
+
+        /** the oversampling factor */
+        Natural factor;
+
+        /** the number of active stages (binary logarithm of
+         * factor) */
+        size_t stageCount;
+
+        /** the latency of up- and downsampling in samples at the
+         * original rate */
+        Natural latency;
+
+        /** the delay at the raised rate padding the latency to an
+         * integral number of samples at the original rate */
+        size_t alignmentDelay;
+
+        /** the stages for all factors of two */
+        GenericTuple<_HalfBandStage, _maximumStageCount> stageList;
+
+        /** the history (first <C>alignmentDelay</C> entries) and new
+         * samples at the raised rate before downsampling */
+        AudioSampleList alignmentWorkList;
+
+        /** the history (first <C>latency</C> entries) and new
+         * samples for delaying a bypassing signal */
+        AudioSampleList delayWorkList;
+
+        /*--------------------*/
+
+        /**
+         * Returns string representation of descriptor.
+         *
+         * @return string representation
+         */
+        String toString () const
+        {
+            String stageListAsString;
+
+            for (size_t s = 0;  s < stageCount;  s++) {
+                stageListAsString += (s == 0 ? "" : ", ");
+                stageListAsString += stageList[s].toString();
+            }
+
+            return STR::expand("factor = %1, latency = %2,"
+                               " alignmentDelay = %3, stageList = (%4)",
+                               TOSTRING(factor), TOSTRING(latency),
+                               TOSTRING(Natural{alignmentDelay}),
+                               stageListAsString);
+        }
+
+    };
+
+}
+
+/*============================================================*/
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+HalfBandOversampler::HalfBandOversampler ()
+{
+    Logging_trace(">>");
+
+    _OversamplerDescriptor* descriptor = new _OversamplerDescriptor();
+    _descriptor = descriptor;
+    const Natural highRateLength = maximumFactor * maximumBlockLength;
+    Natural lowRateCount = maximumBlockLength;
+
+    for (size_t s = 0;  s < _maximumStageCount;  s++) {
+        descriptor->stageList[s].setup(_stageHalfLengthList[s],
+                                       lowRateCount);
+        lowRateCount *= 2;
+    }
+
+    descriptor->alignmentWorkList.setLength(highRateLength
+                                            + maximumFactor);
+    descriptor->delayWorkList.setLength(maximumBlockLength
+                                        + maximumBlockLength);
+    ScratchArena::announceCapacity(scratchByteCount());
+    setFactor(1);
+
+    Logging_trace1("<<: %1", toString());
+}
+
+/*--------------------*/
+
+HalfBandOversampler::~HalfBandOversampler ()
+{
+    Logging_trace(">>");
+    delete (_OversamplerDescriptor*) _descriptor;
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* class methods      */
+/*--------------------*/
+
+Natural HalfBandOversampler::scratchByteCount ()
+{
+    const Natural highRateLength = maximumFactor * maximumBlockLength;
+    return Natural{2} * ScratchArena::footprint<double>(highRateLength);
+}
+
+/*-----------------------*/
+/* string representation */
+/*-----------------------*/
+
+String HalfBandOversampler::toString () const
+{
+    _OversamplerDescriptor& descriptor =
+        TOREFERENCE<_OversamplerDescriptor>(_descriptor);
+    return STR::expand("HalfBandOversampler(%1)", descriptor.toString());
+}
+
+/*--------------------*/
+/* property access    */
+/*--------------------*/
+
+Natural HalfBandOversampler::factor () const
+{
+    _OversamplerDescriptor& descriptor =
+        TOREFERENCE<_OversamplerDescriptor>(_descriptor);
+    return descriptor.factor;
+}
+
+/*--------------------*/
+
+Natural HalfBandOversampler::byteCount () const
+{
+    _OversamplerDescriptor& descriptor =
+        TOREFERENCE<_OversamplerDescriptor>(_descriptor);
+    size_t sampleCount = (descriptor.alignmentWorkList.capacity()
+                          + descriptor.delayWorkList.capacity());
+
+    for (const _HalfBandStage& stage : descriptor.stageList) {
+        sampleCount += (stage.coefficientList.capacity()
+                        + stage.upsamplingWorkList.capacity()
+                        + stage.evenWorkList.capacity()
+                        + stage.oddWorkList.capacity());
+    }
+
+    return Natural{sizeof(_OversamplerDescriptor)
+                   + sampleCount * sizeof(AudioSample)};
+}
+
+/*--------------------*/
+
+void HalfBandOversampler::setFactor (IN Natural factor)
+{
+    Logging_trace1(">>: %1", TOSTRING(factor));
+
+    _OversamplerDescriptor& descriptor =
+        TOREFERENCE<_OversamplerDescriptor>(_descriptor);
+    const size_t requestedFactor = (size_t) factor;
+    size_t stageCount = 0;
+
+    while (stageCount < _maximumStageCount
+           && ((size_t) 2 << stageCount) <= requestedFactor) {
+        stageCount++;
+    }
+
+    /* the latency at the raised rate: stage s delays by its center
+       index at rate 2^(s+1) in both directions */
+    const size_t effectiveFactor = (size_t) 1 << stageCount;
+    size_t highRateLatency = 0;
+
+    for (size_t s = 0;  s < stageCount;  s++) {
+        const size_t c = 2 * _stageHalfLengthList[s] + 1;
+        highRateLatency += c * (effectiveFactor >> s);
+    }
+
+    const size_t latency =
+        (highRateLatency + effectiveFactor - 1) / effectiveFactor;
+    descriptor.factor         = Natural{effectiveFactor};
+    descriptor.stageCount     = stageCount;
+    descriptor.latency        = Natural{latency};
+    descriptor.alignmentDelay = latency * effectiveFactor - highRateLatency;
+    reset();
+
+    Logging_trace1("<<: %1", toString());
+}
+
+/*--------------------*/
+
+Natural HalfBandOversampler::latency () const
+{
+    _OversamplerDescriptor& descriptor =
+        TOREFERENCE<_OversamplerDescriptor>(_descriptor);
+    return descriptor.latency;
+}
+
+/*--------------------*/
+/* processing         */
+/*--------------------*/
+
+void HalfBandOversampler::reset ()
+{
+    _OversamplerDescriptor& descriptor =
+        TOREFERENCE<_OversamplerDescriptor>(_descriptor);
+
+    for (_HalfBandStage& stage : descriptor.stageList) {
+        stage.reset();
+    }
+
+    descriptor.alignmentWorkList.setToZero();
+    descriptor.delayWorkList.setToZero();
+}
+
+/*--------------------*/
+
+void HalfBandOversampler::copyStateFrom (IN HalfBandOversampler& other)
+{
+    _OversamplerDescriptor& descriptor =
+        TOREFERENCE<_OversamplerDescriptor>(_descriptor);
+    const _OversamplerDescriptor& otherDescriptor =
+        TOREFERENCE<_OversamplerDescriptor>(other._descriptor);
+
+    /* all work lists have their maximum length from construction,
+       hence the assignment reuses the existing storage */
+    descriptor = otherDescriptor;
+}
+
+/*--------------------*/
+
+void HalfBandOversampler::upsample (IN AudioSample* inputArray,
+                                    IN Natural count,
+                                    OUT AudioSample* outputArray)
+{
+    _OversamplerDescriptor& descriptor =
+        TOREFERENCE<_OversamplerDescriptor>(_descriptor);
+    const size_t stageCount = descriptor.stageCount;
+    const double* sourceArray = (const double*) inputArray;
+    size_t sampleCount = (size_t) count;
+
+    if (stageCount == 0) {
+        for (size_t n = 0;  n < sampleCount;  n++) {
+            outputArray[n] = inputArray[n];
+        }
+    } else {
+        /* alternate between the intermediate arrays, the last stage
+           writes to the output */
+        ScratchArena::Scope scratchScope;
+        const size_t highRateCount = sampleCount << stageCount;
+        double* intermediateArray[2] = {
+            scratchScope.allocate<double>(Natural{highRateCount}),
+            scratchScope.allocate<double>(Natural{highRateCount})
+        };
+
+        for (size_t s = 0;  s < stageCount;  s++) {
+            double* targetArray = (s + 1 == stageCount
+                                   ? (double*) outputArray
+                                   : intermediateArray[s % 2]);
+            descriptor.stageList[s].upsample(sourceArray, sampleCount,
+                                             targetArray);
+            sourceArray = targetArray;
+            sampleCount *= 2;
+        }
+    }
+}
+
+/*--------------------*/
+
+void HalfBandOversampler::downsample (IN AudioSample* inputArray,
+                                      IN Natural count,
+                                      OUT AudioSample* outputArray)
+{
+    _OversamplerDescriptor& descriptor =
+        TOREFERENCE<_OversamplerDescriptor>(_descriptor);
+    const size_t stageCount = descriptor.stageCount;
+    const size_t alignmentDelay = descriptor.alignmentDelay;
+    size_t sampleCount = (size_t) count << stageCount;
+    const double* sourceArray = (const double*) inputArray;
+
+    if (alignmentDelay > 0) {
+        /* pad the latency by a short delay at the raised rate */
+        double* workArray = (double*) descriptor.alignmentWorkList.asArray();
+
+        for (size_t n = 0;  n < sampleCount;  n++) {
+            workArray[alignmentDelay + n] = sourceArray[n];
+        }
+
+        sourceArray = workArray;
+    }
+
+    if (stageCount == 0) {
+        for (size_t n = 0;  n < sampleCount;  n++) {
+            outputArray[n] = sourceArray[n];
+        }
+    } else {
+        ScratchArena::Scope scratchScope;
+        double* intermediateArray[2] = {
+            scratchScope.allocate<double>(Natural{sampleCount}),
+            scratchScope.allocate<double>(Natural{sampleCount})
+        };
+
+        for (size_t s = stageCount;  s > 0;  s--) {
+            sampleCount /= 2;
+            double* targetArray = (s == 1
+                                   ? (double*) outputArray
+                                   : intermediateArray[s % 2]);
+            descriptor.stageList[s - 1].downsample(sourceArray,
+                                                   sampleCount,
+                                                   targetArray);
+            sourceArray = targetArray;
+        }
+    }
+
+    if (alignmentDelay > 0) {
+        double* workArray = (double*) descriptor.alignmentWorkList.asArray();
+        const size_t highRateCount = (size_t) count << stageCount;
+
+        for (size_t j = 0;  j < alignmentDelay;  j++) {
+            workArray[j] = workArray[highRateCount + j];
+        }
+    }
+}
+
+/*--------------------*/
+
+void HalfBandOversampler::delay (INOUT AudioSample* sampleArray,
+                                 IN Natural count)
+{
+    _OversamplerDescriptor& descriptor =
+        TOREFERENCE<_OversamplerDescriptor>(_descriptor);
+    const size_t latency = (size_t) descriptor.latency;
+    const size_t sampleCount = (size_t) count;
+
+    if (latency > 0) {
+        AudioSample* workArray = descriptor.delayWorkList.asArray();
+
+        for (size_t n = 0;  n < sampleCount;  n++) {
+            workArray[latency + n] = sampleArray[n];
+        }
+
+        for (size_t n = 0;  n < sampleCount;  n++) {
+            sampleArray[n] = workArray[n];
+        }
+
+        for (size_t j = 0;  j < latency;  j++) {
+            workArray[j] = workArray[sampleCount + j];
+        }
+    }
+}
+
+/*--------------------*/
+/* state transfer     */
+/*--------------------*/
+
+void HalfBandOversampler::saveState (INOUT DspStateStream& stream) const
+{
+    const _OversamplerDescriptor& descriptor =
+        TOREFERENCE<_OversamplerDescriptor>(_descriptor);
+
+    /* only the histories at the start of the work lists survive a
+       block */
+    stream.write(descriptor.factor);
+
+    for (size_t s = 0;  s < descriptor.stageCount;  s++) {
+        const _HalfBandStage& stage = descriptor.stageList[s];
+        const Natural historyLength{2 * stage.m + 1};
+        stream.writeArray(stage.upsamplingWorkList.asArray(),
+                          historyLength);
+        stream.writeArray(stage.evenWorkList.asArray(), historyLength);
+        stream.writeArray(stage.oddWorkList.asArray(), historyLength);
+    }
+
+    stream.writeArray(descriptor.alignmentWorkList.asArray(),
+                      Natural{descriptor.alignmentDelay});
+    stream.writeArray(descriptor.delayWorkList.asArray(),
+                      descriptor.latency);
+}
+
+/*--------------------*/
+
+void HalfBandOversampler::restoreState (INOUT DspStateStream& stream)
+{
+    _OversamplerDescriptor& descriptor =
+        TOREFERENCE<_OversamplerDescriptor>(_descriptor);
+    Natural factor = 0;
+    stream.read(factor);
+
+    if (factor != descriptor.factor) {
+        stream.invalidate();
+    }
+
+    for (size_t s = 0;  s < descriptor.stageCount;  s++) {
+        _HalfBandStage& stage = descriptor.stageList[s];
+        const Natural historyLength{2 * stage.m + 1};
+        stream.readArray(stage.upsamplingWorkList.asArray(),
+                         historyLength);
+        stream.readArray(stage.evenWorkList.asArray(), historyLength);
+        stream.readArray(stage.oddWorkList.asArray(), historyLength);
+    }
+
+    stream.readArray(descriptor.alignmentWorkList.asArray(),
+                     Natural{descriptor.alignmentDelay});
+    stream.readArray(descriptor.delayWorkList.asArray(),
+                     descriptor.latency);
+}
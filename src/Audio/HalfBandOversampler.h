@@ -0,0 +1,254 @@
+/**
+ * @file
+ * The <C>HalfBandOversampler</C> specification defines an up- and
+ * downsampler by a power of two built from cascaded polyphase
+ * half-band FIR stages.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-02
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "AudioSample.h"
+#include "DspStateStream.h"
+#include "MyString.h"
+#include "Natural.h"
+#include "Object.h"
+
+/*--------------------*/
+
+using Audio::AudioSample;
+using BaseTypes::Primitives::Natural;
+using BaseTypes::Primitives::Object;
+using BaseTypes::Primitives::String;
+
+/*====================*/
+
+namespace Audio {
+
+    /**
+     * A <C>HalfBandOversampler</C> object raises the sample rate of
+     * a single channel by a factor of 2, 4 or 8 for some nonlinear
+     * processing and lowers it back afterwards.  Each factor of two
+     * is a linear-phase half-band FIR stage evaluated in polyphase
+     * form: when upsampling, every other output is a plain delay of
+     * the input; when downsampling, only the even input samples are
+     * filtered.  Additionally the symmetry of the coefficients is
+     * used, hence a stage with <C>4m+3</C> taps only needs
+     * <C>m+1</C> multiplications per low-rate sample.  The first
+     * stage has the sharpest transition, the following stages are
+     * shorter.
+     *
+     * The combined latency of up- and downsampling is padded to an
+     * integral number of samples at the original rate, such that a
+     * parallel dry signal can be aligned by <C>delay</C>.
+     *
+     * All state buffers are allocated on construction, the
+     * intermediate samples between stages are taken from the
+     * scratch arena of the processing thread; blocks are processed
+     * with at most <C>maximumBlockLength</C> samples at the original
+     * rate.
+     */
+    struct HalfBandOversampler {
+
+        /** the maximum oversampling factor */
+        static const Natural maximumFactor;
+
+        /** the maximum number of samples at the original rate in a
+         * single call */
+        static const Natural maximumBlockLength;
+
+        /*--------------------*/
+        /* con-/destruction   */
+        /*--------------------*/
+
+        /**
+         * Makes oversampler with factor one (a plain copy of the
+         * samples without latency).
+         */
+        HalfBandOversampler ();
+
+        /*--------------------*/
+
+        /**
+         * Destroys oversampler.
+         */
+        ~HalfBandOversampler ();
+
+        /*--------------------*/
+
+        HalfBandOversampler (IN HalfBandOversampler&) = delete;
+
+        /*--------------------*/
+        /* class methods      */
+        /*--------------------*/
+
+        /**
+         * Returns the number of bytes taken from the scratch arena
+         * during an up- or downsampling of a maximum length block.
+         *
+         * @return  scratch arena requirement in bytes
+         */
+        static Natural scratchByteCount ();
+
+        /*-----------------------*/
+        /* string representation */
+        /*-----------------------*/
+
+        /**
+         * Returns string representation of oversampler
+         *
+         * @return string representation
+         */
+        String toString () const;
+
+        /*--------------------*/
+        /* property access    */
+        /*--------------------*/
+
+        /**
+         * Returns the oversampling factor.
+         *
+         * @return  oversampling factor (1, 2, 4 or 8)
+         */
+        Natural factor () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of bytes allocated on the heap by the
+         * oversampler for its stages and histories (including its
+         * descriptor).
+         *
+         * @return  count of owned bytes
+         */
+        Natural byteCount () const;
+
+        /*--------------------*/
+
+        /**
+         * Sets the oversampling factor to <C>factor</C> (rounded down
+         * to a power of two and at most <C>maximumFactor</C>) and
+         * clears the filter histories; does not allocate.
+         *
+         * @param[in] factor  new oversampling factor
+         */
+        void setFactor (IN Natural factor);
+
+        /*--------------------*/
+
+        /**
+         * Returns the latency of an upsampling followed by a
+         * downsampling in samples at the original rate.
+         *
+         * @return  latency in samples
+         */
+        Natural latency () const;
+
+        /*--------------------*/
+        /* processing         */
+        /*--------------------*/
+
+        /**
+         * Clears all filter histories.
+         */
+        void reset ();
+
+        /*--------------------*/
+
+        /**
+         * Copies factor and filter histories of <C>other</C> into
+         * this oversampler; does not allocate.
+         *
+         * @param[in] other  oversampler to take the state from
+         */
+        void copyStateFrom (IN HalfBandOversampler& other);
+
+        /*--------------------*/
+
+        /**
+         * Upsamples <C>count</C> samples from <C>inputArray</C> and
+         * writes <C>count * factor()</C> samples into
+         * <C>outputArray</C>.
+         *
+         * @param[in]  inputArray   the samples at the original rate
+         * @param[in]  count        the number of input samples (at
+         *                          most <C>maximumBlockLength</C>)
+         * @param[out] outputArray  the samples at the raised rate
+         */
+        void upsample (IN AudioSample* inputArray,
+                       IN Natural count,
+                       OUT AudioSample* outputArray);
+
+        /*--------------------*/
+
+        /**
+         * Downsamples <C>count * factor()</C> samples from
+         * <C>inputArray</C> and writes <C>count</C> samples into
+         * <C>outputArray</C>.
+         *
+         * @param[in]  inputArray   the samples at the raised rate
+         * @param[in]  count        the number of output samples (at
+         *                          most <C>maximumBlockLength</C>)
+         * @param[out] outputArray  the samples at the original rate
+         */
+        void downsample (IN AudioSample* inputArray,
+                         IN Natural count,
+                         OUT AudioSample* outputArray);
+
+        /*--------------------*/
+
+        /**
+         * Delays <C>count</C> samples in <C>sampleArray</C> in place
+         * by <C>latency()</C> samples, such that a signal bypassing
+         * the oversampling stays aligned.
+         *
+         * @param[inout] sampleArray  the samples at the original rate
+         * @param[in]    count        the number of samples (at most
+         *                            <C>maximumBlockLength</C>)
+         */
+        void delay (INOUT AudioSample* sampleArray,
+                    IN Natural count);
+
+        /*--------------------*/
+        /* state transfer     */
+        /*--------------------*/
+
+        /**
+         * Appends the factor and the filter histories to
+         * <C>stream</C>.
+         *
+         * @param[inout] stream  state stream to be written
+         */
+        void saveState (INOUT DspStateStream& stream) const;
+
+        /*--------------------*/
+
+        /**
+         * Reads the filter histories from <C>stream</C>; the stream
+         * becomes invalid when the stored factor differs from the
+         * current one.
+         *
+         * @param[inout] stream  state stream to be read
+         */
+        void restoreState (INOUT DspStateStream& stream);
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the internal data of the oversampler (private
+             * type) */
+            Object _descriptor;
+
+    };
+
+}
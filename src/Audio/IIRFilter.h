@@ -17,6 +17,7 @@
 
 #include "RealList.h"
 #include "AudioSampleRingBuffer.h"
+#include "IIRFilterN.h"
 
 /*====================*/
 
@@ -29,7 +30,9 @@ namespace Audio {
 
     /**
      * A <C>IIRFilter</C> object is an infinite impulse response
-     * filter.
+     * filter with an order given at runtime; for block processing
+     * the common orders 3 and 5 are delegated to the kernels of
+     * <C>IIRFilterN</C>.
     */
     struct IIRFilter {
 
@@ -124,6 +127,82 @@ namespace Audio {
         void apply (IN AudioSampleRingBuffer& inputBuffer,
                     INOUT AudioSampleRingBuffer& outputBuffer) const;
 
+        /*--------------------*/
+
+        /**
+         * Applies IIR filter to <C>count</C> samples in
+         * <C>inputArray</C> and writes the results into
+         * <C>outputArray</C>; the filter history is taken from and
+         * written back to <C>state</C>, but is kept in local
+         * variables while processing the block; input and output
+         * array may be identical for an in-place operation
+         *
+         * @param[in]    inputArray   the array with the input samples
+         * @param[out]   outputArray  the array for the output samples
+         * @param[in]    count        the number of samples to process
+         * @param[inout] state        the filter history for the channel
+         */
+        void applyBlock (IN AudioSample* inputArray,
+                         OUT AudioSample* outputArray,
+                         IN Natural count,
+                         INOUT IIRFilterState& state) const;
+
+        /*--------------------*/
+
+        /**
+         * Calculates the frequency response of the filter at the
+         * frequencies in <C>frequencyList</C> (given relative to the
+         * sample rate, i.e. from zero to one half) and returns the
+         * linear magnitudes in <C>magnitudeList</C> and the phases
+         * in radians (from -pi to pi) in <C>phaseList</C>; this is
+         * meant for displays and allocates, so it must not be done
+         * on the audio thread
+         *
+         * @param[in]  frequencyList  the frequencies relative to the
+         *                            sample rate
+         * @param[out] magnitudeList  the linear magnitudes of the
+         *                            response
+         * @param[out] phaseList      the phases of the response in
+         *                            radians
+         */
+        void frequencyResponse (IN RealList& frequencyList,
+                                OUT RealList& magnitudeList,
+                                OUT RealList& phaseList) const;
+
+        /*--------------------*/
+
+        /**
+         * Evaluates the response of the IIR filter of
+         * <C>order</C> with coefficients in
+         * <C>coefficientArray</C> (first the b's, then the a's) at
+         * the <C>count</C> relative frequencies in
+         * <C>frequencyArray</C> and multiplies its magnitudes into
+         * <C>magnitudeArray</C> and adds its phases to
+         * <C>phaseArray</C>; hence the response of a cascade of
+         * filters is accumulated by calls for each filter, the
+         * phases are not wrapped.  The frequencies are processed in
+         * chunks where each step is a loop over the chunk without
+         * dependencies, such that the compiler vectorizes the
+         * polynomial evaluation.
+         *
+         * @param[in]    coefficientArray  the filter coefficients
+         * @param[in]    order             the order of the filter
+         * @param[in]    frequencyArray    the frequencies relative
+         *                                 to the sample rate
+         * @param[in]    count             the number of frequencies
+         * @param[inout] magnitudeArray    the magnitudes to be
+         *                                 multiplied by the response
+         * @param[inout] phaseArray        the phases to be
+         *                                 incremented by the response
+         */
+        static void
+        accumulateFrequencyResponse (IN Real* coefficientArray,
+                                     IN Natural order,
+                                     IN Real* frequencyArray,
+                                     IN Natural count,
+                                     INOUT Real* magnitudeArray,
+                                     INOUT Real* phaseArray);
+
         /*--------------------*/
         /*--------------------*/
 
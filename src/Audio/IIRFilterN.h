@@ -0,0 +1,336 @@
+/**
+ * @file
+ * The <C>IIRFilterN</C> specification and body defines an infinite
+ * impulse response filter with an order fixed at compile time and
+ * the state type for block processing of IIR filters.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-01
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include <array>
+
+#include "AudioSampleRingBuffer.h"
+#include "DenormalGuard.h"
+#include "StringUtil.h"
+
+/*--------------------*/
+
+using std::array;
+using Audio::AudioSample;
+using Audio::AudioSampleRingBuffer;
+using Audio::DenormalGuard;
+
+/*====================*/
+
+namespace Audio {
+
+    /**
+     * An <C>IIRFilterState</C> object holds the history of an IIR
+     * filter for a single channel as plain variables: the previous
+     * input and output samples with the most recent one first.
+     */
+    struct IIRFilterState {
+
+        /** the maximum number of samples kept in each history */
+        static constexpr size_t maximumHistoryLength = 4;
+
+        /** the previous input samples (most recent first) */
+        AudioSample inputHistory[maximumHistoryLength];
+
+        /** the previous output samples (most recent first) */
+        AudioSample outputHistory[maximumHistoryLength];
+
+        /*--------------------*/
+
+        /**
+         * Creates a cleared filter state
+         */
+        IIRFilterState ()
+        {
+            clear();
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns string representation of filter state.
+         *
+         * @return string representation
+         */
+        String toString() const
+        {
+            String inputHistoryString;
+            String outputHistoryString;
+
+            for (size_t i = 0;  i < maximumHistoryLength;  i++) {
+                const String separator = (i == 0 ? "" : ", ");
+                inputHistoryString  += separator + TOSTRING(inputHistory[i]);
+                outputHistoryString += separator + TOSTRING(outputHistory[i]);
+            }
+
+            String result = "IIRFilterState(";
+            result += "inputHistory = (" + inputHistoryString + ")";
+            result += ", outputHistory = (" + outputHistoryString + ")";
+            result += ")";
+
+            return result;
+        }
+
+        /*--------------------*/
+
+        /**
+         * Resets all history samples to zero
+         */
+        void clear ()
+        {
+            for (size_t i = 0;  i < maximumHistoryLength;  i++) {
+                inputHistory[i]  = 0.0;
+                outputHistory[i] = 0.0;
+            }
+        }
+
+    };
+
+    /*--------------------*/
+
+    /**
+     * An <C>IIRFilterN</C> object is an infinite impulse response
+     * filter with <C>order</C> fixed at compile time; the
+     * coefficients (first the b's, then the a's normalized by a0)
+     * are held in a fixed size array, hence all loops in the filter
+     * kernel have constant bounds and can be completely unrolled by
+     * the compiler.
+     *
+     * @tparam order  the order of the filter (in SoX terminology the
+     *                count of coefficients in numerator and
+     *                denominator)
+     */
+    template <size_t order>
+    struct IIRFilterN {
+
+        static_assert(order >= 1
+                      && order <= IIRFilterState::maximumHistoryLength + 1,
+                      "filter order must be between 1 and 5");
+
+        /** the count of coefficients in the filter */
+        static constexpr size_t coefficientCount = 2 * order;
+
+        /** the coefficient array type of the filter */
+        using CoefficientArray = array<Real, coefficientCount>;
+
+        /*--------------------*/
+        /*--------------------*/
+
+        /**
+         * Creates an IIR filter as a null filter
+         */
+        IIRFilterN ()
+        {
+            clear();
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns string representation of filter.
+         *
+         * @return string representation
+         */
+        String toString() const
+        {
+            String result = "IIRFilterN(";
+            result += "order = " + std::to_string(order);
+            result += ", _data = (";
+
+            for (size_t i = 0;  i < coefficientCount;  i++) {
+                result += (i == 0 ? "" : ", ") + TOSTRING(_data[i]);
+            }
+
+            result += "))";
+            return result;
+        }
+
+        /*--------------------*/
+
+        /**
+         * Resets filter to a null filter
+         */
+        void clear ()
+        {
+            _data.fill(0.0);
+        }
+
+        /*--------------------*/
+
+        /**
+         * Sets IIR filter with all zeros except for the <C>b0</C>
+         * value; b0 = 1 is an identity filter, b0 = 0 a null
+         * filter
+         *
+         * @param[in] b0  the b0 value of the IIR filter
+         */
+        void set (IN Real b0)
+        {
+            clear();
+            _data[0]     = b0;
+            _data[order] = 1.0;
+        }
+
+        /*--------------------*/
+
+        /**
+         * Sets all coefficients of IIR filter from
+         * <C>coefficientArray</C> (first the b's, then the a's) and
+         * normalizes them by a0
+         *
+         * @param[in] coefficientArray  the filter coefficients
+         */
+        void set (IN CoefficientArray& coefficientArray)
+        {
+            _data = coefficientArray;
+            const Real referenceValue = _data[order];
+
+            if (referenceValue != 0.0) {
+                for (Real& coefficient : _data) {
+                    coefficient /= referenceValue;
+                }
+            }
+        }
+
+        /*--------------------*/
+
+        /**
+         * Applies IIR filter to <C>inputBuffer</C> and
+         * <C>outputBuffer</C>; assumes that first entry in input
+         * buffer is current sample and writes result sample into top
+         * of output buffer
+         *
+         * @param[in] inputBuffer     the buffer (of correct length)
+         *                            with the input samples
+         * @param[inout] outputBuffer the buffer (of correct length)
+         *                            with the output samples
+         */
+        void apply (IN AudioSampleRingBuffer& inputBuffer,
+                    INOUT AudioSampleRingBuffer& outputBuffer) const
+        {
+            AudioSample x[order];
+            AudioSample y[order];
+            inputBuffer.toArray(x);
+            outputBuffer.toArray(y);
+
+            AudioSample outputValue = _data[0] * x[0];
+
+            for (size_t i = 1;  i < order;  i++) {
+                outputValue += (_data[i] * x[i]
+                                - _data[i + order] * y[i]);
+            }
+
+            outputBuffer.setFirst(DenormalGuard::flushed(outputValue));
+        }
+
+        /*--------------------*/
+
+        /**
+         * Applies IIR filter to <C>count</C> samples in
+         * <C>inputArray</C> and writes the results into
+         * <C>outputArray</C> with history in <C>state</C>; input
+         * and output array may be identical for an in-place
+         * operation
+         *
+         * @param[in]    inputArray   the array with the input samples
+         * @param[out]   outputArray  the array for the output samples
+         * @param[in]    count        the number of samples to process
+         * @param[inout] state        the filter history for the channel
+         */
+        void applyBlock (IN AudioSample* inputArray,
+                         OUT AudioSample* outputArray,
+                         IN Natural count,
+                         INOUT IIRFilterState& state) const
+        {
+            applyKernel(_data.data(), inputArray, outputArray,
+                        count, state);
+        }
+
+        /*--------------------*/
+
+        /**
+         * Applies an IIR filter with <C>coefficients</C> (an array
+         * with 2*order normalized entries: first the b's, then the
+         * a's) to <C>count</C> samples in <C>inputArray</C> and
+         * writes the results into <C>outputArray</C> with history in
+         * <C>state</C>; the history and the coefficients are kept in
+         * local (register) variables during the block
+         *
+         * @param[in]    coefficients  the normalized filter coefficients
+         * @param[in]    inputArray    the array with the input samples
+         * @param[out]   outputArray   the array for the output samples
+         * @param[in]    count         the number of samples to process
+         * @param[inout] state         the filter history for the channel
+         */
+        static void applyKernel (IN Real* coefficients,
+                                 IN AudioSample* inputArray,
+                                 OUT AudioSample* outputArray,
+                                 IN Natural count,
+                                 INOUT IIRFilterState& state)
+        {
+            AudioSample b[order];
+            AudioSample a[order];
+            AudioSample x[order];
+            AudioSample y[order];
+
+            for (size_t j = 0;  j < order;  j++) {
+                b[j] = coefficients[j];
+                a[j] = coefficients[j + order];
+            }
+
+            for (size_t j = 1;  j < order;  j++) {
+                x[j] = state.inputHistory[j - 1];
+                y[j] = state.outputHistory[j - 1];
+            }
+
+            const AudioSample* inputPtr = inputArray;
+            AudioSample* outputPtr = outputArray;
+
+            for (Natural i = 0;  i < count;  i++) {
+                x[0] = *inputPtr++;
+                AudioSample outputValue = b[0] * x[0];
+
+                for (size_t j = 1;  j < order;  j++) {
+                    outputValue += (b[j] * x[j] - a[j] * y[j]);
+                }
+
+                *outputPtr++ = outputValue;
+                y[0] = DenormalGuard::flushed(outputValue);
+
+                for (size_t j = order - 1;  j > 0;  j--) {
+                    x[j] = x[j - 1];
+                    y[j] = y[j - 1];
+                }
+            }
+
+            for (size_t j = 1;  j < order;  j++) {
+                state.inputHistory[j - 1]  = x[j];
+                state.outputHistory[j - 1] = y[j];
+            }
+        }
+
+        /*--------------------*/
+        /*--------------------*/
+
+        protected:
+
+            /** the filter coefficients: first b's, then a's */
+            CoefficientArray _data;
+
+    };
+
+}
@@ -0,0 +1,3065 @@
+/**
+ * @file
+ * The <C>Kernels</C> body implements the SIMD processing kernels for
+ * audio samples for each instruction set of the target architecture
+ * and selects the kernel table for the executing processor.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "Kernels.h"
+
+#include <atomic>
+#include <type_traits>
+#include "Assertion.h"
+#include "DenormalGuard.h"
+#include "Logging.h"
+
+#if defined(AUDIO_USES_SIMD)
+    #if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+        #include <immintrin.h>
+        /** SSE2 kernels are the baseline, AVX2 and AVX-512 kernels
+         * are selected by CPUID */
+        #define Kernels_usesX86
+
+        #if defined(_MSC_VER)
+            #include <intrin.h>
+        #else
+            #include <cpuid.h>
+        #endif
+    #elif defined(__aarch64__) || defined(_M_ARM64)
+        #include <arm_neon.h>
+        /** NEON kernels are used (selected by HWCAP on Linux) */
+        #define Kernels_usesNEON
+
+        #if defined(__linux__)
+            #include <asm/hwcap.h>
+            #include <sys/auxv.h>
+        #endif
+    #endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+    /** compiles a function for instruction set <C>isa</C>
+     * independent of the compiler flags */
+    #define Kernels_target(isa)  __attribute__((target(isa)))
+#else
+    /** MSVC accepts all intrinsics without flags */
+    #define Kernels_target(isa)
+#endif
+
+/* the AVX-512 target implies FMA; contracting multiplications and
+   additions only there would make results depend on the processor */
+#if defined(__clang__)
+    #pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+    #pragma GCC optimize ("fp-contract=off")
+#endif
+
+/*--------------------*/
+
+using Audio::DelayLineSample;
+using Audio::DenormalGuard;
+using Audio::KernelInstructionSet;
+using Audio::Kernels;
+
+/*====================*/
+
+/** the type of a stereo biquad kernel */
+typedef void (*_BiquadStereoProc) (IN double*, IN double*,
+                                   OUT double*, OUT double*,
+                                   IN size_t, IN double*,
+                                   INOUT double*);
+
+/** tells whether delay line samples are stored as floats */
+static constexpr bool _delayLineHasFloats =
+    std::is_same<DelayLineSample, float>::value;
+
+/*====================*/
+/* SCALAR KERNELS     */
+/*====================*/
+
+/**
+ * Applies biquad filter with coefficients <C>c</C> to the
+ * <C>count</C> samples in <C>inputArray</C> with state <C>z1</C>
+ * and <C>z2</C> and stores results in <C>outputArray</C>.
+ *
+ * @param[in]    inputArray   the input samples
+ * @param[out]   outputArray  the output samples
+ * @param[in]    count        the number of samples
+ * @param[in]    c            b0, b1, b2, a1 and a2
+ * @param[inout] z1           first state variable
+ * @param[inout] z2           second state variable
+ */
+static void _biquadScalar (IN double* inputArray,
+                           OUT double* outputArray,
+                           IN size_t count,
+                           IN double* c,
+                           INOUT double& z1,
+                           INOUT double& z2)
+{
+    const double b0 = c[0], b1 = c[1], b2 = c[2];
+    const double a1 = c[3], a2 = c[4];
+    double u1 = z1;
+    double u2 = z2;
+
+    for (size_t i = 0;  i < count;  i++) {
+        const double x = inputArray[i];
+        const double y = b0 * x + u1;
+        u1 = DenormalGuard::flushed(b1 * x - a1 * y + u2);
+        u2 = DenormalGuard::flushed(b2 * x - a2 * y);
+        outputArray[i] = y;
+    }
+
+    z1 = u1;
+    z2 = u2;
+}
+
+/*--------------------*/
+
+static void _biquadStereoScalar (IN double* inputArrayA,
+                                 IN double* inputArrayB,
+                                 OUT double* outputArrayA,
+                                 OUT double* outputArrayB,
+                                 IN size_t count,
+                                 IN double* coefficientArray,
+                                 INOUT double* stateArray)
+{
+    _biquadScalar(inputArrayA, outputArrayA, count, coefficientArray,
+                  stateArray[0], stateArray[2]);
+    _biquadScalar(inputArrayB, outputArrayB, count, coefficientArray,
+                  stateArray[1], stateArray[3]);
+}
+
+/*--------------------*/
+
+/**
+ * Applies biquad filter to four channels as two stereo pairs with
+ * stereo kernel <C>stereoProc</C>.
+ *
+ * @tparam       stereoProc        stereo biquad kernel
+ * @param[inout] channelArray      the four channels
+ * @param[in]    count             the number of samples
+ * @param[in]    coefficientArray  b0, b1, b2, a1 and a2
+ * @param[inout] stateArray        z1 and then z2 of all channels
+ */
+template<_BiquadStereoProc stereoProc>
+static void _biquadQuadByPairs (INOUT double* const* channelArray,
+                                IN size_t count,
+                                IN double* coefficientArray,
+                                INOUT double* stateArray)
+{
+    for (size_t channel = 0;  channel < 4;  channel += 2) {
+        double* sampleArrayA = channelArray[channel];
+        double* sampleArrayB = channelArray[channel + 1];
+        double pairStateArray[4] = {
+            stateArray[channel],     stateArray[channel + 1],
+            stateArray[channel + 4], stateArray[channel + 5]
+        };
+
+        stereoProc(sampleArrayA, sampleArrayB,
+                   sampleArrayA, sampleArrayB,
+                   count, coefficientArray, pairStateArray);
+
+        stateArray[channel]     = pairStateArray[0];
+        stateArray[channel + 1] = pairStateArray[1];
+        stateArray[channel + 4] = pairStateArray[2];
+        stateArray[channel + 5] = pairStateArray[3];
+    }
+}
+
+/*--------------------*/
+
+/**
+ * Applies gain ramp to the float samples in <C>sampleArray</C>
+ * from <C>startIndex</C> to <C>count</C>.
+ *
+ * @param[inout] sampleArray    the samples
+ * @param[in]    startIndex     the index of first sample processed
+ * @param[in]    count          the number of samples in array
+ * @param[in]    startGain      the gain before the first sample
+ * @param[in]    gainIncrement  the per-sample increment of gain
+ */
+static void _gainRampFloatTail (INOUT float* sampleArray,
+                                IN size_t startIndex,
+                                IN size_t count,
+                                IN float startGain,
+                                IN float gainIncrement)
+{
+    for (size_t i = startIndex;  i < count;  i++) {
+        const float gain = startGain + gainIncrement * (float) (i + 1);
+        sampleArray[i] = sampleArray[i] * gain;
+    }
+}
+
+/*--------------------*/
+
+/**
+ * Applies gain ramp to the double samples in <C>sampleArray</C>
+ * from <C>startIndex</C> to <C>count</C>.
+ *
+ * @param[inout] sampleArray    the samples
+ * @param[in]    startIndex     the index of first sample processed
+ * @param[in]    count          the number of samples in array
+ * @param[in]    startGain      the gain before the first sample
+ * @param[in]    gainIncrement  the per-sample increment of gain
+ */
+static void _gainRampDoubleTail (INOUT double* sampleArray,
+                                 IN size_t startIndex,
+                                 IN size_t count,
+                                 IN double startGain,
+                                 IN double gainIncrement)
+{
+    for (size_t i = startIndex;  i < count;  i++) {
+        const double gain = startGain + gainIncrement * (double) (i + 1);
+        sampleArray[i] = sampleArray[i] * gain;
+    }
+}
+
+/*--------------------*/
+
+static void _gainRampFloatScalar (INOUT float* sampleArray,
+                                  IN size_t count,
+                                  IN float startGain,
+                                  IN float gainIncrement)
+{
+    _gainRampFloatTail(sampleArray, 0, count, startGain, gainIncrement);
+}
+
+/*--------------------*/
+
+static void _gainRampDoubleScalar (INOUT double* sampleArray,
+                                   IN size_t count,
+                                   IN double startGain,
+                                   IN double gainIncrement)
+{
+    _gainRampDoubleTail(sampleArray, 0, count, startGain, gainIncrement);
+}
+
+/*--------------------*/
+
+/**
+ * Processes the comb filter lanes from <C>startLane</C> to
+ * <C>laneCount</C> one by one; see <C>Kernels::combFilterBank</C>.
+ */
+static void _combFilterBankTail (INOUT DelayLineSample* data,
+                                 IN size_t* slotIndexArray,
+                                 INOUT double* storedSampleArray,
+                                 OUT double* outputSampleArray,
+                                 IN size_t startLane,
+                                 IN size_t laneCount,
+                                 IN double inputSample,
+                                 IN double feedback,
+                                 IN double hfDamping)
+{
+    for (size_t k = startLane;  k < laneCount;  k++) {
+        DelayLineSample& slot = data[slotIndexArray[k]];
+        const double outputSample = (double) slot;
+        const double storedSample =
+            DenormalGuard::flushed(outputSample
+                                   + ((storedSampleArray[k] - outputSample)
+                                      * hfDamping));
+        storedSampleArray[k] = storedSample;
+        slot = (DelayLineSample)
+            DenormalGuard::flushed(inputSample + storedSample * feedback);
+        outputSampleArray[k] = outputSample;
+    }
+}
+
+/*--------------------*/
+
+static void _combFilterBankScalar (INOUT DelayLineSample* data,
+                                   IN size_t* slotIndexArray,
+                                   INOUT double* storedSampleArray,
+                                   OUT double* outputSampleArray,
+                                   IN size_t laneCount,
+                                   IN double inputSample,
+                                   IN double feedback,
+                                   IN double hfDamping)
+{
+    _combFilterBankTail(data, slotIndexArray, storedSampleArray,
+                        outputSampleArray, 0, laneCount,
+                        inputSample, feedback, hfDamping);
+}
+
+/*--------------------*/
+
+static void _waveshapeFloatScalar (IN float* inputArray,
+                                   OUT double* outputArray,
+                                   IN size_t count,
+                                   IN float gain,
+                                   IN float colour)
+{
+    for (size_t i = 0;  i < count;  i++) {
+        float value = inputArray[i] * gain + colour;
+        value = (value < -1.0f ? -1.0f : (value > 1.0f ? 1.0f : value));
+        value = value - (value * value * value) / 3.0f;
+        outputArray[i] = (double) value;
+    }
+}
+
+/*--------------------*/
+
+static void _waveshapeDoubleScalar (IN double* inputArray,
+                                    OUT double* outputArray,
+                                    IN size_t count,
+                                    IN double gain,
+                                    IN double colour)
+{
+    for (size_t i = 0;  i < count;  i++) {
+        double value = inputArray[i] * gain + colour;
+        value = (value < -1.0 ? -1.0 : (value > 1.0 ? 1.0 : value));
+        value = value - (value * value * value) / 3.0;
+        outputArray[i] = value;
+    }
+}
+
+/*--------------------*/
+
+static void _waveshapeTableScalar (IN double* inputArray,
+                                   OUT double* outputArray,
+                                   IN size_t count,
+                                   IN double gain,
+                                   IN double colour,
+                                   IN double* tableArray,
+                                   IN size_t intervalCount)
+{
+    const double positionFactor = (double) intervalCount / 2.0;
+
+    for (size_t i = 0;  i < count;  i++) {
+        /* the comparisons also map NaN into the table range */
+        double value = inputArray[i] * gain + colour;
+        value = (value >= -1.0 ? value : -1.0);
+        value = (value <= 1.0 ? value : 1.0);
+        const double position = (value + 1.0) * positionFactor;
+        const size_t index = (size_t) position;
+        const double fraction = position - (double) index;
+        const double lowerValue = tableArray[index];
+        outputArray[i] =
+            lowerValue + (tableArray[index + 1] - lowerValue) * fraction;
+    }
+}
+
+/*--------------------*/
+
+static void _floatToDoubleScalar (OUT double* targetArray,
+                                  IN float* sourceArray,
+                                  IN size_t count)
+{
+    for (size_t i = 0;  i < count;  i++) {
+        targetArray[i] = (double) sourceArray[i];
+    }
+}
+
+/*--------------------*/
+
+static void _doubleToFloatScalar (OUT float* targetArray,
+                                  IN double* sourceArray,
+                                  IN size_t count)
+{
+    for (size_t i = 0;  i < count;  i++) {
+        targetArray[i] = (float) sourceArray[i];
+    }
+}
+
+/*--------------------*/
+
+/**
+ * Multiplies the double samples in <C>sampleArray</C> from
+ * <C>startIndex</C> to <C>count</C> by <C>factor</C>.
+ *
+ * @param[inout] sampleArray  the samples
+ * @param[in]    startIndex   the index of first sample processed
+ * @param[in]    count        the number of samples in array
+ * @param[in]    factor       the factor for each sample
+ */
+static void _scaleDoubleTail (INOUT double* sampleArray,
+                              IN size_t startIndex,
+                              IN size_t count,
+                              IN double factor)
+{
+    for (size_t i = startIndex;  i < count;  i++) {
+        sampleArray[i] = sampleArray[i] * factor;
+    }
+}
+
+/*--------------------*/
+
+/**
+ * Adds the double samples in <C>sourceArray</C> multiplied by
+ * <C>factor</C> to those in <C>targetArray</C> from
+ * <C>startIndex</C> to <C>count</C>; for <C>hasFactor</C> unset
+ * the factor is ignored and the samples are added unscaled.
+ *
+ * @param[inout] targetArray  the samples to be changed
+ * @param[in]    sourceArray  the samples to be added
+ * @param[in]    startIndex   the index of first sample processed
+ * @param[in]    count        the number of samples in arrays
+ * @param[in]    hasFactor    tells whether source is scaled
+ * @param[in]    factor       the factor for each source sample
+ */
+static void _multiplyAddDoubleTail (INOUT double* targetArray,
+                                    IN double* sourceArray,
+                                    IN size_t startIndex,
+                                    IN size_t count,
+                                    IN bool hasFactor,
+                                    IN double factor)
+{
+    for (size_t i = startIndex;  i < count;  i++) {
+        const double value =
+            (hasFactor ? sourceArray[i] * factor : sourceArray[i]);
+        targetArray[i] = targetArray[i] + value;
+    }
+}
+
+/*--------------------*/
+
+/**
+ * Fades the double samples in <C>targetArray</C> towards those in
+ * <C>sourceArray</C> from <C>startIndex</C> to <C>count</C>; see
+ * <C>Kernels::crossfadeDouble</C>.
+ *
+ * @param[inout] targetArray      the samples to be faded
+ * @param[in]    sourceArray      the samples faded to
+ * @param[in]    startIndex       the index of first sample processed
+ * @param[in]    count            the number of samples in arrays
+ * @param[in]    startWeight      the weight before the first sample
+ * @param[in]    weightIncrement  the per-sample increment of weight
+ */
+static void _crossfadeDoubleTail (INOUT double* targetArray,
+                                  IN double* sourceArray,
+                                  IN size_t startIndex,
+                                  IN size_t count,
+                                  IN double startWeight,
+                                  IN double weightIncrement)
+{
+    for (size_t i = startIndex;  i < count;  i++) {
+        const double weight =
+            startWeight + weightIncrement * (double) (i + 1);
+        const double value = targetArray[i];
+        targetArray[i] = value + (sourceArray[i] - value) * weight;
+    }
+}
+
+/*--------------------*/
+
+/**
+ * Mixes the double samples in <C>sourceArrayA</C> and
+ * <C>sourceArrayB</C> with <C>factorA</C> and <C>factorB</C> into
+ * <C>targetArray</C> from <C>startIndex</C> to <C>count</C>.
+ *
+ * @param[out] targetArray   the mixed samples
+ * @param[in]  sourceArrayA  the first samples to be mixed
+ * @param[in]  sourceArrayB  the second samples to be mixed
+ * @param[in]  startIndex    the index of first sample processed
+ * @param[in]  count         the number of samples in arrays
+ * @param[in]  factorA       the factor for the first samples
+ * @param[in]  factorB       the factor for the second samples
+ */
+static void _mixDoubleTail (OUT double* targetArray,
+                            IN double* sourceArrayA,
+                            IN double* sourceArrayB,
+                            IN size_t startIndex,
+                            IN size_t count,
+                            IN double factorA,
+                            IN double factorB)
+{
+    for (size_t i = startIndex;  i < count;  i++) {
+        targetArray[i] = (sourceArrayA[i] * factorA
+                          + sourceArrayB[i] * factorB);
+    }
+}
+
+/*--------------------*/
+
+/**
+ * Limits the double samples in <C>sampleArray</C> from
+ * <C>startIndex</C> to <C>count</C> to the interval from
+ * <C>lowerLimit</C> to <C>upperLimit</C>; the comparisons are
+ * those of the vector maximum and minimum instructions, hence a
+ * NaN becomes the lower limit in all variants.
+ *
+ * @param[inout] sampleArray  the samples
+ * @param[in]    startIndex   the index of first sample processed
+ * @param[in]    count        the number of samples in array
+ * @param[in]    lowerLimit   the minimum sample value
+ * @param[in]    upperLimit   the maximum sample value
+ */
+static void _clampDoubleTail (INOUT double* sampleArray,
+                              IN size_t startIndex,
+                              IN size_t count,
+                              IN double lowerLimit,
+                              IN double upperLimit)
+{
+    for (size_t i = startIndex;  i < count;  i++) {
+        const double value = sampleArray[i];
+        const double limitedValue =
+            (value > lowerLimit ? value : lowerLimit);
+        sampleArray[i] =
+            (limitedValue < upperLimit ? limitedValue : upperLimit);
+    }
+}
+
+/*--------------------*/
+
+static void _scaleDoubleScalar (INOUT double* sampleArray,
+                                IN size_t count,
+                                IN double factor)
+{
+    _scaleDoubleTail(sampleArray, 0, count, factor);
+}
+
+/*--------------------*/
+
+static void _addDoubleScalar (INOUT double* targetArray,
+                              IN double* sourceArray,
+                              IN size_t count)
+{
+    _multiplyAddDoubleTail(targetArray, sourceArray, 0, count,
+                           false, 1.0);
+}
+
+/*--------------------*/
+
+static void _multiplyAddDoubleScalar (INOUT double* targetArray,
+                                      IN double* sourceArray,
+                                      IN size_t count,
+                                      IN double factor)
+{
+    _multiplyAddDoubleTail(targetArray, sourceArray, 0, count,
+                           true, factor);
+}
+
+/*--------------------*/
+
+static void _crossfadeDoubleScalar (INOUT double* targetArray,
+                                    IN double* sourceArray,
+                                    IN size_t count,
+                                    IN double startWeight,
+                                    IN double weightIncrement)
+{
+    _crossfadeDoubleTail(targetArray, sourceArray, 0, count,
+                         startWeight, weightIncrement);
+}
+
+/*--------------------*/
+
+static void _mixDoubleScalar (OUT double* targetArray,
+                              IN double* sourceArrayA,
+                              IN double* sourceArrayB,
+                              IN size_t count,
+                              IN double factorA,
+                              IN double factorB)
+{
+    _mixDoubleTail(targetArray, sourceArrayA, sourceArrayB, 0, count,
+                   factorA, factorB);
+}
+
+/*--------------------*/
+
+static void _clampDoubleScalar (INOUT double* sampleArray,
+                                IN size_t count,
+                                IN double lowerLimit,
+                                IN double upperLimit)
+{
+    _clampDoubleTail(sampleArray, 0, count, lowerLimit, upperLimit);
+}
+
+/*--------------------*/
+
+/**
+ * Continues the level measurement of the <C>count</C> float samples
+ * in <C>sampleArray</C> from <C>startIndex</C> on with maximum
+ * magnitude <C>peak</C> and the eight interleaved partial sums of
+ * squares in <C>partialSumArray</C> (sample <C>i</C> goes to sum
+ * <C>i % 8</C>) and stores the peak and the combined sum of squares
+ * in <C>resultArray</C>; the partial sums are combined in the order
+ * of the vector kernels.
+ *
+ * @param[in]    sampleArray      the samples to be measured
+ * @param[in]    startIndex       the index of the first sample not
+ *                                yet measured
+ * @param[in]    count            the number of samples
+ * @param[in]    peak             the maximum magnitude so far
+ * @param[inout] partialSumArray  the eight partial sums of squares
+ * @param[out]   resultArray      the peak and the sum of squares
+ */
+static void _levelFloatTail (IN float* sampleArray,
+                             IN size_t startIndex,
+                             IN size_t count,
+                             IN float peak,
+                             INOUT float* partialSumArray,
+                             OUT double* resultArray)
+{
+    float maximum = peak;
+
+    for (size_t i = startIndex;  i < count;  i++) {
+        const float value = sampleArray[i];
+        const float magnitude = (value < 0.0f ? -value : value);
+        maximum = (magnitude > maximum ? magnitude : maximum);
+        partialSumArray[i % 8] += value * value;
+    }
+
+    const float sum0 = partialSumArray[0] + partialSumArray[4];
+    const float sum1 = partialSumArray[1] + partialSumArray[5];
+    const float sum2 = partialSumArray[2] + partialSumArray[6];
+    const float sum3 = partialSumArray[3] + partialSumArray[7];
+    resultArray[0] = (double) maximum;
+    resultArray[1] = (double) ((sum0 + sum2) + (sum1 + sum3));
+}
+
+/*--------------------*/
+
+/**
+ * Continues the level measurement of the <C>count</C> double
+ * samples in <C>sampleArray</C> from <C>startIndex</C> on with
+ * maximum magnitude <C>peak</C> and the four interleaved partial
+ * sums of squares in <C>partialSumArray</C> (sample <C>i</C> goes
+ * to sum <C>i % 4</C>) and stores the peak and the combined sum of
+ * squares in <C>resultArray</C>; the partial sums are combined in
+ * the order of the vector kernels.
+ *
+ * @param[in]    sampleArray      the samples to be measured
+ * @param[in]    startIndex       the index of the first sample not
+ *                                yet measured
+ * @param[in]    count            the number of samples
+ * @param[in]    peak             the maximum magnitude so far
+ * @param[inout] partialSumArray  the four partial sums of squares
+ * @param[out]   resultArray      the peak and the sum of squares
+ */
+static void _levelDoubleTail (IN double* sampleArray,
+                              IN size_t startIndex,
+                              IN size_t count,
+                              IN double peak,
+                              INOUT double* partialSumArray,
+                              OUT double* resultArray)
+{
+    double maximum = peak;
+
+    for (size_t i = startIndex;  i < count;  i++) {
+        const double value = sampleArray[i];
+        const double magnitude = (value < 0.0 ? -value : value);
+        maximum = (magnitude > maximum ? magnitude : maximum);
+        partialSumArray[i % 4] += value * value;
+    }
+
+    resultArray[0] = maximum;
+    resultArray[1] = ((partialSumArray[0] + partialSumArray[2])
+                      + (partialSumArray[1] + partialSumArray[3]));
+}
+
+/*--------------------*/
+
+/**
+ * Returns the maximum of <C>peak</C> and the magnitudes of the
+ * double samples in <C>sampleArray</C> from <C>startIndex</C> up to
+ * <C>count</C>.
+ *
+ * @param[in] sampleArray  the samples to be measured
+ * @param[in] startIndex   the index of the first sample not yet
+ *                         measured
+ * @param[in] count        the number of samples
+ * @param[in] peak         the maximum magnitude so far
+ * @return  maximum magnitude
+ */
+static double _peakDoubleTail (IN double* sampleArray,
+                               IN size_t startIndex,
+                               IN size_t count,
+                               IN double peak)
+{
+    double maximum = peak;
+
+    for (size_t i = startIndex;  i < count;  i++) {
+        const double value = sampleArray[i];
+        const double magnitude = (value < 0.0 ? -value : value);
+        maximum = (magnitude > maximum ? magnitude : maximum);
+    }
+
+    return maximum;
+}
+
+/*--------------------*/
+
+/**
+ * Tells whether <C>partialSum</C> and the differences <C>x - x</C>
+ * of the float samples in <C>sampleArray</C> from
+ * <C>startIndex</C> up to <C>count</C> add up to zero, i.e. whether
+ * all those samples are finite.
+ *
+ * @param[in] sampleArray  the samples to be checked
+ * @param[in] startIndex   the index of the first sample not yet
+ *                         checked
+ * @param[in] count        the number of samples
+ * @param[in] partialSum   the sum of the differences so far
+ * @return  information whether all samples are finite
+ */
+static bool _isFiniteFloatTail (IN float* sampleArray,
+                                IN size_t startIndex,
+                                IN size_t count,
+                                IN float partialSum)
+{
+    float sum = partialSum;
+
+    for (size_t i = startIndex;  i < count;  i++) {
+        const float value = sampleArray[i];
+        sum += value - value;
+    }
+
+    return (sum == 0.0f);
+}
+
+/*--------------------*/
+
+/**
+ * Tells whether <C>partialSum</C> and the differences <C>x - x</C>
+ * of the double samples in <C>sampleArray</C> from
+ * <C>startIndex</C> up to <C>count</C> add up to zero, i.e. whether
+ * all those samples are finite.
+ *
+ * @param[in] sampleArray  the samples to be checked
+ * @param[in] startIndex   the index of the first sample not yet
+ *                         checked
+ * @param[in] count        the number of samples
+ * @param[in] partialSum   the sum of the differences so far
+ * @return  information whether all samples are finite
+ */
+static bool _isFiniteDoubleTail (IN double* sampleArray,
+                                 IN size_t startIndex,
+                                 IN size_t count,
+                                 IN double partialSum)
+{
+    double sum = partialSum;
+
+    for (size_t i = startIndex;  i < count;  i++) {
+        const double value = sampleArray[i];
+        sum += value - value;
+    }
+
+    return (sum == 0.0);
+}
+
+/*--------------------*/
+
+static void _levelFloatScalar (IN float* sampleArray,
+                               IN size_t count,
+                               OUT double* resultArray)
+{
+    float partialSumArray[8] = {};
+    _levelFloatTail(sampleArray, 0, count, 0.0f, partialSumArray,
+                    resultArray);
+}
+
+/*--------------------*/
+
+static void _levelDoubleScalar (IN double* sampleArray,
+                                IN size_t count,
+                                OUT double* resultArray)
+{
+    double partialSumArray[4] = {};
+    _levelDoubleTail(sampleArray, 0, count, 0.0, partialSumArray,
+                     resultArray);
+}
+
+/*--------------------*/
+
+static double _peakDoubleScalar (IN double* sampleArray,
+                                 IN size_t count)
+{
+    return _peakDoubleTail(sampleArray, 0, count, 0.0);
+}
+
+/*--------------------*/
+
+static bool _isFiniteFloatScalar (IN float* sampleArray,
+                                  IN size_t count)
+{
+    return _isFiniteFloatTail(sampleArray, 0, count, 0.0f);
+}
+
+/*--------------------*/
+
+static bool _isFiniteDoubleScalar (IN double* sampleArray,
+                                   IN size_t count)
+{
+    return _isFiniteDoubleTail(sampleArray, 0, count, 0.0);
+}
+
+/*--------------------*/
+
+/** the portable kernels */
+static const Kernels _scalarKernels = {
+    KernelInstructionSet::scalar,
+    _biquadStereoScalar,
+    _biquadQuadByPairs<_biquadStereoScalar>,
+    _gainRampFloatScalar,
+    _gainRampDoubleScalar,
+    _combFilterBankScalar,
+    _waveshapeFloatScalar,
+    _waveshapeDoubleScalar,
+    _waveshapeTableScalar,
+    _floatToDoubleScalar,
+    _doubleToFloatScalar,
+    _scaleDoubleScalar,
+    _addDoubleScalar,
+    _multiplyAddDoubleScalar,
+    _crossfadeDoubleScalar,
+    _mixDoubleScalar,
+    _clampDoubleScalar,
+    _levelFloatScalar,
+    _levelDoubleScalar,
+    _peakDoubleScalar,
+    _isFiniteFloatScalar,
+    _isFiniteDoubleScalar
+};
+
+/*====================*/
+/* SSE2 KERNELS       */
+/*====================*/
+
+#if defined(Kernels_usesX86)
+
+    static void _biquadStereoSSE2 (IN double* inputArrayA,
+                                   IN double* inputArrayB,
+                                   OUT double* outputArrayA,
+                                   OUT double* outputArrayB,
+                                   IN size_t count,
+                                   IN double* coefficientArray,
+                                   INOUT double* stateArray)
+    {
+        /* lane 0 holds channel A, lane 1 holds channel B */
+        const __m128d b0 = _mm_set1_pd(coefficientArray[0]);
+        const __m128d b1 = _mm_set1_pd(coefficientArray[1]);
+        const __m128d b2 = _mm_set1_pd(coefficientArray[2]);
+        const __m128d a1 = _mm_set1_pd(coefficientArray[3]);
+        const __m128d a2 = _mm_set1_pd(coefficientArray[4]);
+        __m128d z1 = _mm_loadu_pd(stateArray);
+        __m128d z2 = _mm_loadu_pd(stateArray + 2);
+        double result[2];
+
+        for (size_t i = 0;  i < count;  i++) {
+            const __m128d x = _mm_set_pd(inputArrayB[i], inputArrayA[i]);
+            const __m128d y = _mm_add_pd(_mm_mul_pd(b0, x), z1);
+            z1 = _mm_add_pd(_mm_sub_pd(_mm_mul_pd(b1, x),
+                                       _mm_mul_pd(a1, y)),
+                            z2);
+            z2 = _mm_sub_pd(_mm_mul_pd(b2, x), _mm_mul_pd(a2, y));
+            _mm_storeu_pd(result, y);
+            outputArrayA[i] = result[0];
+            outputArrayB[i] = result[1];
+        }
+
+        _mm_storeu_pd(stateArray, z1);
+        _mm_storeu_pd(stateArray + 2, z2);
+    }
+
+    /*--------------------*/
+
+    static void _gainRampFloatSSE2 (INOUT float* sampleArray,
+                                    IN size_t count,
+                                    IN float startGain,
+                                    IN float gainIncrement)
+    {
+        const __m128 startVector     = _mm_set1_ps(startGain);
+        const __m128 incrementVector = _mm_set1_ps(gainIncrement);
+        const __m128 four            = _mm_set1_ps(4.0f);
+        __m128 index = _mm_setr_ps(1.0f, 2.0f, 3.0f, 4.0f);
+        size_t i = 0;
+
+        for (;  i + 4 <= count;  i += 4) {
+            const __m128 gain =
+                _mm_add_ps(startVector, _mm_mul_ps(incrementVector, index));
+            _mm_storeu_ps(sampleArray + i,
+                          _mm_mul_ps(_mm_loadu_ps(sampleArray + i), gain));
+            index = _mm_add_ps(index, four);
+        }
+
+        _gainRampFloatTail(sampleArray, i, count, startGain, gainIncrement);
+    }
+
+    /*--------------------*/
+
+    static void _gainRampDoubleSSE2 (INOUT double* sampleArray,
+                                     IN size_t count,
+                                     IN double startGain,
+                                     IN double gainIncrement)
+    {
+        const __m128d startVector     = _mm_set1_pd(startGain);
+        const __m128d incrementVector = _mm_set1_pd(gainIncrement);
+        const __m128d two             = _mm_set1_pd(2.0);
+        __m128d index = _mm_setr_pd(1.0, 2.0);
+        size_t i = 0;
+
+        for (;  i + 2 <= count;  i += 2) {
+            const __m128d gain =
+                _mm_add_pd(startVector, _mm_mul_pd(incrementVector, index));
+            _mm_storeu_pd(sampleArray + i,
+                          _mm_mul_pd(_mm_loadu_pd(sampleArray + i), gain));
+            index = _mm_add_pd(index, two);
+        }
+
+        _gainRampDoubleTail(sampleArray, i, count, startGain, gainIncrement);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Processes the comb filter lanes from <C>startLane</C> to
+     * <C>laneCount</C> in pairs; see <C>Kernels::combFilterBank</C>.
+     */
+    static void _combFilterBankSSE2Tail (INOUT DelayLineSample* data,
+                                         IN size_t* slotIndexArray,
+                                         INOUT double* storedSampleArray,
+                                         OUT double* outputSampleArray,
+                                         IN size_t startLane,
+                                         IN size_t laneCount,
+                                         IN double inputSample,
+                                         IN double feedback,
+                                         IN double hfDamping)
+    {
+        /* lanes k and k + 1 are processed together */
+        const __m128d input          = _mm_set1_pd(inputSample);
+        const __m128d feedbackFactor = _mm_set1_pd(feedback);
+        const __m128d dampingFactor  = _mm_set1_pd(hfDamping);
+        double result[2];
+
+        for (size_t k = startLane;  k < laneCount;  k += 2) {
+            DelayLineSample& slotA = data[slotIndexArray[k]];
+            DelayLineSample& slotB = data[slotIndexArray[k + 1]];
+            const __m128d output =
+                _mm_set_pd((double) slotB, (double) slotA);
+            __m128d stored = _mm_loadu_pd(storedSampleArray + k);
+            stored = _mm_add_pd(output,
+                                _mm_mul_pd(_mm_sub_pd(stored, output),
+                                           dampingFactor));
+            const __m128d newSample =
+                _mm_add_pd(input, _mm_mul_pd(stored, feedbackFactor));
+
+            _mm_storeu_pd(result, newSample);
+            slotA = (DelayLineSample) result[0];
+            slotB = (DelayLineSample) result[1];
+            _mm_storeu_pd(storedSampleArray + k, stored);
+            _mm_storeu_pd(outputSampleArray + k, output);
+        }
+    }
+
+    /*--------------------*/
+
+    static void _combFilterBankSSE2 (INOUT DelayLineSample* data,
+                                     IN size_t* slotIndexArray,
+                                     INOUT double* storedSampleArray,
+                                     OUT double* outputSampleArray,
+                                     IN size_t laneCount,
+                                     IN double inputSample,
+                                     IN double feedback,
+                                     IN double hfDamping)
+    {
+        _combFilterBankSSE2Tail(data, slotIndexArray, storedSampleArray,
+                                outputSampleArray, 0, laneCount,
+                                inputSample, feedback, hfDamping);
+    }
+
+    /*--------------------*/
+
+    static void _waveshapeFloatSSE2 (IN float* inputArray,
+                                     OUT double* outputArray,
+                                     IN size_t count,
+                                     IN float gain,
+                                     IN float colour)
+    {
+        const __m128 gainVector   = _mm_set1_ps(gain);
+        const __m128 colourVector = _mm_set1_ps(colour);
+        const __m128 lowerLimit   = _mm_set1_ps(-1.0f);
+        const __m128 upperLimit   = _mm_set1_ps(1.0f);
+        const __m128 three        = _mm_set1_ps(3.0f);
+        size_t i = 0;
+
+        for (;  i + 4 <= count;  i += 4) {
+            const __m128 input = _mm_loadu_ps(inputArray + i);
+            __m128 value = _mm_add_ps(_mm_mul_ps(input, gainVector),
+                                      colourVector);
+            value = _mm_max_ps(lowerLimit, _mm_min_ps(upperLimit, value));
+            const __m128 cube = _mm_mul_ps(_mm_mul_ps(value, value), value);
+            value = _mm_sub_ps(value, _mm_div_ps(cube, three));
+            _mm_storeu_pd(outputArray + i, _mm_cvtps_pd(value));
+            _mm_storeu_pd(outputArray + i + 2,
+                          _mm_cvtps_pd(_mm_movehl_ps(value, value)));
+        }
+
+        _waveshapeFloatScalar(inputArray + i, outputArray + i, count - i,
+                              gain, colour);
+    }
+
+    /*--------------------*/
+
+    static void _waveshapeDoubleSSE2 (IN double* inputArray,
+                                      OUT double* outputArray,
+                                      IN size_t count,
+                                      IN double gain,
+                                      IN double colour)
+    {
+        const __m128d gainVector   = _mm_set1_pd(gain);
+        const __m128d colourVector = _mm_set1_pd(colour);
+        const __m128d lowerLimit   = _mm_set1_pd(-1.0);
+        const __m128d upperLimit   = _mm_set1_pd(1.0);
+        const __m128d three        = _mm_set1_pd(3.0);
+        size_t i = 0;
+
+        for (;  i + 2 <= count;  i += 2) {
+            const __m128d input = _mm_loadu_pd(inputArray + i);
+            __m128d value = _mm_add_pd(_mm_mul_pd(input, gainVector),
+                                       colourVector);
+            value = _mm_max_pd(lowerLimit, _mm_min_pd(upperLimit, value));
+            const __m128d cube = _mm_mul_pd(_mm_mul_pd(value, value), value);
+            value = _mm_sub_pd(value, _mm_div_pd(cube, three));
+            _mm_storeu_pd(outputArray + i, value);
+        }
+
+        _waveshapeDoubleScalar(inputArray + i, outputArray + i, count - i,
+                               gain, colour);
+    }
+
+    /*--------------------*/
+
+    static void _floatToDoubleSSE2 (OUT double* targetArray,
+                                    IN float* sourceArray,
+                                    IN size_t count)
+    {
+        size_t i = 0;
+
+        for (;  i + 4 <= count;  i += 4) {
+            const __m128 value = _mm_loadu_ps(sourceArray + i);
+            _mm_storeu_pd(targetArray + i, _mm_cvtps_pd(value));
+            _mm_storeu_pd(targetArray + i + 2,
+                          _mm_cvtps_pd(_mm_movehl_ps(value, value)));
+        }
+
+        _floatToDoubleScalar(targetArray + i, sourceArray + i, count - i);
+    }
+
+    /*--------------------*/
+
+    static void _doubleToFloatSSE2 (OUT float* targetArray,
+                                    IN double* sourceArray,
+                                    IN size_t count)
+    {
+        size_t i = 0;
+
+        for (;  i + 4 <= count;  i += 4) {
+            const __m128 valueA =
+                _mm_cvtpd_ps(_mm_loadu_pd(sourceArray + i));
+            const __m128 valueB =
+                _mm_cvtpd_ps(_mm_loadu_pd(sourceArray + i + 2));
+            _mm_storeu_ps(targetArray + i, _mm_movelh_ps(valueA, valueB));
+        }
+
+        _doubleToFloatScalar(targetArray + i, sourceArray + i, count - i);
+    }
+
+    /*--------------------*/
+
+    static void _scaleDoubleSSE2 (INOUT double* sampleArray,
+                                  IN size_t count,
+                                  IN double factor)
+    {
+        const __m128d factorVector = _mm_set1_pd(factor);
+        size_t i = 0;
+
+        for (;  i + 2 <= count;  i += 2) {
+            _mm_storeu_pd(sampleArray + i,
+                          _mm_mul_pd(_mm_loadu_pd(sampleArray + i),
+                                     factorVector));
+        }
+
+        _scaleDoubleTail(sampleArray, i, count, factor);
+    }
+
+    /*--------------------*/
+
+    static void _addDoubleSSE2 (INOUT double* targetArray,
+                                IN double* sourceArray,
+                                IN size_t count)
+    {
+        size_t i = 0;
+
+        for (;  i + 2 <= count;  i += 2) {
+            _mm_storeu_pd(targetArray + i,
+                          _mm_add_pd(_mm_loadu_pd(targetArray + i),
+                                     _mm_loadu_pd(sourceArray + i)));
+        }
+
+        _multiplyAddDoubleTail(targetArray, sourceArray, i, count,
+                               false, 1.0);
+    }
+
+    /*--------------------*/
+
+    static void _multiplyAddDoubleSSE2 (INOUT double* targetArray,
+                                        IN double* sourceArray,
+                                        IN size_t count,
+                                        IN double factor)
+    {
+        const __m128d factorVector = _mm_set1_pd(factor);
+        size_t i = 0;
+
+        for (;  i + 2 <= count;  i += 2) {
+            const __m128d value =
+                _mm_mul_pd(_mm_loadu_pd(sourceArray + i), factorVector);
+            _mm_storeu_pd(targetArray + i,
+                          _mm_add_pd(_mm_loadu_pd(targetArray + i),
+                                     value));
+        }
+
+        _multiplyAddDoubleTail(targetArray, sourceArray, i, count,
+                               true, factor);
+    }
+
+    /*--------------------*/
+
+    static void _crossfadeDoubleSSE2 (INOUT double* targetArray,
+                                      IN double* sourceArray,
+                                      IN size_t count,
+                                      IN double startWeight,
+                                      IN double weightIncrement)
+    {
+        const __m128d startVector     = _mm_set1_pd(startWeight);
+        const __m128d incrementVector = _mm_set1_pd(weightIncrement);
+        const __m128d two             = _mm_set1_pd(2.0);
+        __m128d index = _mm_setr_pd(1.0, 2.0);
+        size_t i = 0;
+
+        for (;  i + 2 <= count;  i += 2) {
+            const __m128d weight =
+                _mm_add_pd(startVector, _mm_mul_pd(incrementVector, index));
+            const __m128d value = _mm_loadu_pd(targetArray + i);
+            const __m128d difference =
+                _mm_sub_pd(_mm_loadu_pd(sourceArray + i), value);
+            _mm_storeu_pd(targetArray + i,
+                          _mm_add_pd(value, _mm_mul_pd(difference, weight)));
+            index = _mm_add_pd(index, two);
+        }
+
+        _crossfadeDoubleTail(targetArray, sourceArray, i, count,
+                             startWeight, weightIncrement);
+    }
+
+    /*--------------------*/
+
+    static void _mixDoubleSSE2 (OUT double* targetArray,
+                                IN double* sourceArrayA,
+                                IN double* sourceArrayB,
+                                IN size_t count,
+                                IN double factorA,
+                                IN double factorB)
+    {
+        const __m128d factorVectorA = _mm_set1_pd(factorA);
+        const __m128d factorVectorB = _mm_set1_pd(factorB);
+        size_t i = 0;
+
+        for (;  i + 2 <= count;  i += 2) {
+            const __m128d valueA =
+                _mm_mul_pd(_mm_loadu_pd(sourceArrayA + i), factorVectorA);
+            const __m128d valueB =
+                _mm_mul_pd(_mm_loadu_pd(sourceArrayB + i), factorVectorB);
+            _mm_storeu_pd(targetArray + i, _mm_add_pd(valueA, valueB));
+        }
+
+        _mixDoubleTail(targetArray, sourceArrayA, sourceArrayB, i, count,
+                       factorA, factorB);
+    }
+
+    /*--------------------*/
+
+    static void _clampDoubleSSE2 (INOUT double* sampleArray,
+                                  IN size_t count,
+                                  IN double lowerLimit,
+                                  IN double upperLimit)
+    {
+        const __m128d lowerVector = _mm_set1_pd(lowerLimit);
+        const __m128d upperVector = _mm_set1_pd(upperLimit);
+        size_t i = 0;
+
+        for (;  i + 2 <= count;  i += 2) {
+            const __m128d value = _mm_loadu_pd(sampleArray + i);
+            _mm_storeu_pd(sampleArray + i,
+                          _mm_min_pd(_mm_max_pd(value, lowerVector),
+                                     upperVector));
+        }
+
+        _clampDoubleTail(sampleArray, i, count, lowerLimit, upperLimit);
+    }
+
+    /*--------------------*/
+
+    static void _levelFloatSSE2 (IN float* sampleArray,
+                                 IN size_t count,
+                                 OUT double* resultArray)
+    {
+        /* the two vectors hold the partial sums 0-3 and 4-7 */
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        __m128 peakVector = _mm_setzero_ps();
+        __m128 sumA = _mm_setzero_ps();
+        __m128 sumB = _mm_setzero_ps();
+        size_t i = 0;
+
+        for (;  i + 8 <= count;  i += 8) {
+            const __m128 valueA = _mm_loadu_ps(sampleArray + i);
+            const __m128 valueB = _mm_loadu_ps(sampleArray + i + 4);
+            peakVector =
+                _mm_max_ps(peakVector,
+                           _mm_max_ps(_mm_andnot_ps(signMask, valueA),
+                                      _mm_andnot_ps(signMask, valueB)));
+            sumA = _mm_add_ps(sumA, _mm_mul_ps(valueA, valueA));
+            sumB = _mm_add_ps(sumB, _mm_mul_ps(valueB, valueB));
+        }
+
+        float peakArray[4];
+        float partialSumArray[8];
+        _mm_storeu_ps(peakArray, peakVector);
+        _mm_storeu_ps(partialSumArray, sumA);
+        _mm_storeu_ps(partialSumArray + 4, sumB);
+        const float peakA = (peakArray[0] > peakArray[1]
+                             ? peakArray[0] : peakArray[1]);
+        const float peakB = (peakArray[2] > peakArray[3]
+                             ? peakArray[2] : peakArray[3]);
+        _levelFloatTail(sampleArray, i, count,
+                        (peakA > peakB ? peakA : peakB),
+                        partialSumArray, resultArray);
+    }
+
+    /*--------------------*/
+
+    static void _levelDoubleSSE2 (IN double* sampleArray,
+                                  IN size_t count,
+                                  OUT double* resultArray)
+    {
+        /* the two vectors hold the partial sums 0-1 and 2-3 */
+        const __m128d signMask = _mm_set1_pd(-0.0);
+        __m128d peakVector = _mm_setzero_pd();
+        __m128d sumA = _mm_setzero_pd();
+        __m128d sumB = _mm_setzero_pd();
+        size_t i = 0;
+
+        for (;  i + 4 <= count;  i += 4) {
+            const __m128d valueA = _mm_loadu_pd(sampleArray + i);
+            const __m128d valueB = _mm_loadu_pd(sampleArray + i + 2);
+            peakVector =
+                _mm_max_pd(peakVector,
+                           _mm_max_pd(_mm_andnot_pd(signMask, valueA),
+                                      _mm_andnot_pd(signMask, valueB)));
+            sumA = _mm_add_pd(sumA, _mm_mul_pd(valueA, valueA));
+            sumB = _mm_add_pd(sumB, _mm_mul_pd(valueB, valueB));
+        }
+
+        double peakArray[2];
+        double partialSumArray[4];
+        _mm_storeu_pd(peakArray, peakVector);
+        _mm_storeu_pd(partialSumArray, sumA);
+        _mm_storeu_pd(partialSumArray + 2, sumB);
+        _levelDoubleTail(sampleArray, i, count,
+                         (peakArray[0] > peakArray[1]
+                          ? peakArray[0] : peakArray[1]),
+                         partialSumArray, resultArray);
+    }
+
+    /*--------------------*/
+
+    static double _peakDoubleSSE2 (IN double* sampleArray,
+                                   IN size_t count)
+    {
+        const __m128d signMask = _mm_set1_pd(-0.0);
+        __m128d peakA = _mm_setzero_pd();
+        __m128d peakB = _mm_setzero_pd();
+        size_t i = 0;
+
+        for (;  i + 4 <= count;  i += 4) {
+            peakA = _mm_max_pd(peakA,
+                               _mm_andnot_pd(signMask,
+                                             _mm_loadu_pd(sampleArray
+                                                          + i)));
+            peakB = _mm_max_pd(peakB,
+                               _mm_andnot_pd(signMask,
+                                             _mm_loadu_pd(sampleArray
+                                                          + i + 2)));
+        }
+
+        double peakArray[2];
+        _mm_storeu_pd(peakArray, _mm_max_pd(peakA, peakB));
+        return _peakDoubleTail(sampleArray, i, count,
+                               (peakArray[0] > peakArray[1]
+                                ? peakArray[0] : peakArray[1]));
+    }
+
+    /*--------------------*/
+
+    static bool _isFiniteFloatSSE2 (IN float* sampleArray,
+                                    IN size_t count)
+    {
+        __m128 sum = _mm_setzero_ps();
+        size_t i = 0;
+
+        for (;  i + 4 <= count;  i += 4) {
+            const __m128 value = _mm_loadu_ps(sampleArray + i);
+            sum = _mm_add_ps(sum, _mm_sub_ps(value, value));
+        }
+
+        float partialSumArray[4];
+        _mm_storeu_ps(partialSumArray, sum);
+        return _isFiniteFloatTail(sampleArray, i, count,
+                                  ((partialSumArray[0]
+                                    + partialSumArray[1])
+                                   + (partialSumArray[2]
+                                      + partialSumArray[3])));
+    }
+
+    /*--------------------*/
+
+    static bool _isFiniteDoubleSSE2 (IN double* sampleArray,
+                                     IN size_t count)
+    {
+        __m128d sum = _mm_setzero_pd();
+        size_t i = 0;
+
+        for (;  i + 2 <= count;  i += 2) {
+            const __m128d value = _mm_loadu_pd(sampleArray + i);
+            sum = _mm_add_pd(sum, _mm_sub_pd(value, value));
+        }
+
+        double partialSumArray[2];
+        _mm_storeu_pd(partialSumArray, sum);
+        return _isFiniteDoubleTail(sampleArray, i, count,
+                                   partialSumArray[0]
+                                   + partialSumArray[1]);
+    }
+
+    /*--------------------*/
+
+    /** the SSE2 kernels (the table waveshaper stays scalar for lack
+     * of a gather instruction) */
+    static const Kernels _sse2Kernels = {
+        KernelInstructionSet::sse2,
+        _biquadStereoSSE2,
+        _biquadQuadByPairs<_biquadStereoSSE2>,
+        _gainRampFloatSSE2,
+        _gainRampDoubleSSE2,
+        _combFilterBankSSE2,
+        _waveshapeFloatSSE2,
+        _waveshapeDoubleSSE2,
+        _waveshapeTableScalar,
+        _floatToDoubleSSE2,
+        _doubleToFloatSSE2,
+        _scaleDoubleSSE2,
+        _addDoubleSSE2,
+        _multiplyAddDoubleSSE2,
+        _crossfadeDoubleSSE2,
+        _mixDoubleSSE2,
+        _clampDoubleSSE2,
+        _levelFloatSSE2,
+        _levelDoubleSSE2,
+        _peakDoubleSSE2,
+        _isFiniteFloatSSE2,
+        _isFiniteDoubleSSE2
+    };
+
+    /*====================*/
+    /* AVX2 KERNELS       */
+    /*====================*/
+
+    Kernels_target("avx2")
+    static void _biquadQuadAVX2 (INOUT double* const* channelArray,
+                                 IN size_t count,
+                                 IN double* coefficientArray,
+                                 INOUT double* stateArray)
+    {
+        /* lane i holds channel i */
+        const __m256d b0 = _mm256_set1_pd(coefficientArray[0]);
+        const __m256d b1 = _mm256_set1_pd(coefficientArray[1]);
+        const __m256d b2 = _mm256_set1_pd(coefficientArray[2]);
+        const __m256d a1 = _mm256_set1_pd(coefficientArray[3]);
+        const __m256d a2 = _mm256_set1_pd(coefficientArray[4]);
+        double* sampleArrayA = channelArray[0];
+        double* sampleArrayB = channelArray[1];
+        double* sampleArrayC = channelArray[2];
+        double* sampleArrayD = channelArray[3];
+        __m256d z1 = _mm256_loadu_pd(stateArray);
+        __m256d z2 = _mm256_loadu_pd(stateArray + 4);
+        double result[4];
+
+        for (size_t i = 0;  i < count;  i++) {
+            const __m256d x = _mm256_set_pd(sampleArrayD[i], sampleArrayC[i],
+                                            sampleArrayB[i], sampleArrayA[i]);
+            const __m256d y = _mm256_add_pd(_mm256_mul_pd(b0, x), z1);
+            z1 = _mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(b1, x),
+                                             _mm256_mul_pd(a1, y)),
+                               z2);
+            z2 = _mm256_sub_pd(_mm256_mul_pd(b2, x), _mm256_mul_pd(a2, y));
+            _mm256_storeu_pd(result, y);
+            sampleArrayA[i] = result[0];
+            sampleArrayB[i] = result[1];
+            sampleArrayC[i] = result[2];
+            sampleArrayD[i] = result[3];
+        }
+
+        _mm256_storeu_pd(stateArray, z1);
+        _mm256_storeu_pd(stateArray + 4, z2);
+    }
+
+    /*--------------------*/
+
+    Kernels_target("avx2")
+    static void _gainRampFloatAVX2 (INOUT float* sampleArray,
+                                    IN size_t count,
+                                    IN float startGain,
+                                    IN float gainIncrement)
+    {
+        const __m256 startVector     = _mm256_set1_ps(startGain);
+        const __m256 incrementVector = _mm256_set1_ps(gainIncrement);
+        const __m256 eight           = _mm256_set1_ps(8.0f);
+        __m256 index = _mm256_setr_ps(1.0f, 2.0f, 3.0f, 4.0f,
+                                      5.0f, 6.0f, 7.0f, 8.0f);
+        size_t i = 0;
+
+        for (;  i + 8 <= count;  i += 8) {
+            const __m256 gain =
+                _mm256_add_ps(startVector,
+                              _mm256_mul_ps(incrementVector, index));
+            _mm256_storeu_ps(sampleArray + i,
+                             _mm256_mul_ps(_mm256_loadu_ps(sampleArray + i),
+                                           gain));
+            index = _mm256_add_ps(index, eight);
+        }
+
+        _gainRampFloatTail(sampleArray, i, count, startGain, gainIncrement);
+    }
+
+    /*--------------------*/
+
+    Kernels_target("avx2")
+    static void _gainRampDoubleAVX2 (INOUT double* sampleArray,
+                                     IN size_t count,
+                                     IN double startGain,
+                                     IN double gainIncrement)
+    {
+        const __m256d startVector     = _mm256_set1_pd(startGain);
+        const __m256d incrementVector = _mm256_set1_pd(gainIncrement);
+        const __m256d four            = _mm256_set1_pd(4.0);
+        __m256d index = _mm256_setr_pd(1.0, 2.0, 3.0, 4.0);
+        size_t i = 0;
+
+        for (;  i + 4 <= count;  i += 4) {
+            const __m256d gain =
+                _mm256_add_pd(startVector,
+                              _mm256_mul_pd(incrementVector, index));
+            _mm256_storeu_pd(sampleArray + i,
+                             _mm256_mul_pd(_mm256_loadu_pd(sampleArray + i),
+                                           gain));
+            index = _mm256_add_pd(index, four);
+        }
+
+        _gainRampDoubleTail(sampleArray, i, count, startGain, gainIncrement);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Processes the comb filter lanes from <C>startLane</C> to
+     * <C>laneCount</C> in groups of four with gathered loads and
+     * the remaining pair with SSE2; see
+     * <C>Kernels::combFilterBank</C>.
+     */
+    Kernels_target("avx2")
+    static void _combFilterBankAVX2Tail (INOUT DelayLineSample* data,
+                                         IN size_t* slotIndexArray,
+                                         INOUT double* storedSampleArray,
+                                         OUT double* outputSampleArray,
+                                         IN size_t startLane,
+                                         IN size_t laneCount,
+                                         IN double inputSample,
+                                         IN double feedback,
+                                         IN double hfDamping)
+    {
+        const __m256d input          = _mm256_set1_pd(inputSample);
+        const __m256d feedbackFactor = _mm256_set1_pd(feedback);
+        const __m256d dampingFactor  = _mm256_set1_pd(hfDamping);
+        double result[4];
+        size_t k = startLane;
+
+        for (;  k + 4 <= laneCount;  k += 4) {
+            const __m256i slotIndex =
+                _mm256_loadu_si256((const __m256i*) (slotIndexArray + k));
+            __m256d output;
+
+            if constexpr (_delayLineHasFloats) {
+                output =
+                    _mm256_cvtps_pd(_mm256_i64gather_ps((const float*) data,
+                                                        slotIndex, 4));
+            } else {
+                output = _mm256_i64gather_pd((const double*) data,
+                                             slotIndex, 8);
+            }
+
+            __m256d stored = _mm256_loadu_pd(storedSampleArray + k);
+            stored = _mm256_add_pd(output,
+                                   _mm256_mul_pd(_mm256_sub_pd(stored, output),
+                                                 dampingFactor));
+            const __m256d newSample =
+                _mm256_add_pd(input, _mm256_mul_pd(stored, feedbackFactor));
+
+            _mm256_storeu_pd(result, newSample);
+
+            for (size_t j = 0;  j < 4;  j++) {
+                data[slotIndexArray[k + j]] = (DelayLineSample) result[j];
+            }
+
+            _mm256_storeu_pd(storedSampleArray + k, stored);
+            _mm256_storeu_pd(outputSampleArray + k, output);
+        }
+
+        _combFilterBankSSE2Tail(data, slotIndexArray, storedSampleArray,
+                                outputSampleArray, k, laneCount,
+                                inputSample, feedback, hfDamping);
+    }
+
+    /*--------------------*/
+
+    Kernels_target("avx2")
+    static void _combFilterBankAVX2 (INOUT DelayLineSample* data,
+                                     IN size_t* slotIndexArray,
+                                     INOUT double* storedSampleArray,
+                                     OUT double* outputSampleArray,
+                                     IN size_t laneCount,
+                                     IN double inputSample,
+                                     IN double feedback,
+                                     IN double hfDamping)
+    {
+        _combFilterBankAVX2Tail(data, slotIndexArray, storedSampleArray,
+                                outputSampleArray, 0, laneCount,
+                                inputSample, feedback, hfDamping);
+    }
+
+    /*--------------------*/
+
+    Kernels_target("avx2")
+    static void _waveshapeFloatAVX2 (IN float* inputArray,
+                                     OUT double* outputArray,
+                                     IN size_t count,
+                                     IN float gain,
+                                     IN float colour)
+    {
+        const __m256 gainVector   = _mm256_set1_ps(gain);
+        const __m256 colourVector = _mm256_set1_ps(colour);
+        const __m256 lowerLimit   = _mm256_set1_ps(-1.0f);
+        const __m256 upperLimit   = _mm256_set1_ps(1.0f);
+        const __m256 three        = _mm256_set1_ps(3.0f);
+        size_t i = 0;
+
+        for (;  i + 8 <= count;  i += 8) {
+            const __m256 input = _mm256_loadu_ps(inputArray + i);
+            __m256 value = _mm256_add_ps(_mm256_mul_ps(input, gainVector),
+                                         colourVector);
+            value = _mm256_max_ps(lowerLimit,
+                                  _mm256_min_ps(upperLimit, value));
+            const __m256 cube =
+                _mm256_mul_ps(_mm256_mul_ps(value, value), value);
+            value = _mm256_sub_ps(value, _mm256_div_ps(cube, three));
+            _mm256_storeu_pd(outputArray + i,
+                             _mm256_cvtps_pd(_mm256_castps256_ps128(value)));
+            _mm256_storeu_pd(outputArray + i + 4,
+                             _mm256_cvtps_pd(_mm256_extractf128_ps(value,
+                                                                   1)));
+        }
+
+        _waveshapeFloatSSE2(inputArray + i, outputArray + i, count - i,
+                            gain, colour);
+    }
+
+    /*--------------------*/
+
+    Kernels_target("avx2")
+    static void _waveshapeDoubleAVX2 (IN double* inputArray,
+                                      OUT double* outputArray,
+                                      IN size_t count,
+                                      IN double gain,
+                                      IN double colour)
+    {
+        const __m256d gainVector   = _mm256_set1_pd(gain);
+        const __m256d colourVector = _mm256_set1_pd(colour);
+        const __m256d lowerLimit   = _mm256_set1_pd(-1.0);
+        const __m256d upperLimit   = _mm256_set1_pd(1.0);
+        const __m256d three        = _mm256_set1_pd(3.0);
+        size_t i = 0;
+
+        for (;  i + 4 <= count;  i += 4) {
+            const __m256d input = _mm256_loadu_pd(inputArray + i);
+            __m256d value = _mm256_add_pd(_mm256_mul_pd(input, gainVector),
+                                          colourVector);
+            value = _mm256_max_pd(lowerLimit,
+                                  _mm256_min_pd(upperLimit, value));
+            const __m256d cube =
+                _mm256_mul_pd(_mm256_mul_pd(value, value), value);
+            value = _mm256_sub_pd(value, _mm256_div_pd(cube, three));
+            _mm256_storeu_pd(outputArray + i, value);
+        }
+
+        _waveshapeDoubleSSE2(inputArray + i, outputArray + i, count - i,
+                             gain, colour);
+    }
+
+    /*--------------------*/
+
+    Kernels_target("avx2")
+    static void _waveshapeTableAVX2 (IN double* inputArray,
+                                     OUT double* outputArray,
+                                     IN size_t count,
+                                     IN double gain,
+                                     IN double colour,
+                                     IN double* tableArray,
+                                     IN size_t intervalCount)
+    {
+        const __m256d gainVector   = _mm256_set1_pd(gain);
+        const __m256d colourVector = _mm256_set1_pd(colour);
+        const __m256d lowerLimit   = _mm256_set1_pd(-1.0);
+        const __m256d upperLimit   = _mm256_set1_pd(1.0);
+        const __m256d positionFactor =
+            _mm256_set1_pd((double) intervalCount / 2.0);
+        size_t i = 0;
+
+        for (;  i + 4 <= count;  i += 4) {
+            /* the operand order maps NaN to the lower limit like the
+               scalar code */
+            const __m256d input = _mm256_loadu_pd(inputArray + i);
+            __m256d value = _mm256_add_pd(_mm256_mul_pd(input, gainVector),
+                                          colourVector);
+            value = _mm256_min_pd(_mm256_max_pd(value, lowerLimit),
+                                  upperLimit);
+            const __m256d position =
+                _mm256_mul_pd(_mm256_add_pd(value, upperLimit),
+                              positionFactor);
+            const __m128i index = _mm256_cvttpd_epi32(position);
+            const __m256d fraction =
+                _mm256_sub_pd(position, _mm256_cvtepi32_pd(index));
+            const __m256d lowerValue =
+                _mm256_i32gather_pd(tableArray, index, 8);
+            const __m256d upperValue =
+                _mm256_i32gather_pd(tableArray + 1, index, 8);
+            value = _mm256_add_pd(lowerValue,
+                                  _mm256_mul_pd(_mm256_sub_pd(upperValue,
+                                                              lowerValue),
+                                                fraction));
+            _mm256_storeu_pd(outputArray + i, value);
+        }
+
+        _waveshapeTableScalar(inputArray + i, outputArray + i, count - i,
+                              gain, colour, tableArray, intervalCount);
+    }
+
+    /*--------------------*/
+
+    Kernels_target("avx2")
+    static void _floatToDoubleAVX2 (OUT double* targetArray,
+                                    IN float* sourceArray,
+                                    IN size_t count)
+    {
+        size_t i = 0;
+
+        for (;  i + 8 <= count;  i += 8) {
+            _mm256_storeu_pd(targetArray + i,
+                             _mm256_cvtps_pd(_mm_loadu_ps(sourceArray + i)));
+            _mm256_storeu_pd(targetArray + i + 4,
+                             _mm256_cvtps_pd(_mm_loadu_ps(sourceArray
+                                                          + i + 4)));
+        }
+
+        _floatToDoubleSSE2(targetArray + i, sourceArray + i, count - i);
+    }
+
+    /*--------------------*/
+
+    Kernels_target("avx2")
+    static void _doubleToFloatAVX2 (OUT float* targetArray,
+                                    IN double* sourceArray,
+                                    IN size_t count)
+    {
+        size_t i = 0;
+
+        for (;  i + 8 <= count;  i += 8) {
+            _mm_storeu_ps(targetArray + i,
+                          _mm256_cvtpd_ps(_mm256_loadu_pd(sourceArray + i)));
+            _mm_storeu_ps(targetArray + i + 4,
+                          _mm256_cvtpd_ps(_mm256_loadu_pd(sourceArray
+                                                          + i + 4)));
+        }
+
+        _doubleToFloatSSE2(targetArray + i, sourceArray + i, count - i);
+    }
+
+    /*--------------------*/
+
+    Kernels_target("avx2")
+    static void _scaleDoubleAVX2 (INOUT double* sampleArray,
+                                  IN size_t count,
+                                  IN double factor)
+    {
+        const __m256d factorVector = _mm256_set1_pd(factor);
+        size_t i = 0;
+
+        for (;  i + 4 <= count;  i += 4) {
+            _mm256_storeu_pd(sampleArray + i,
+                             _mm256_mul_pd(_mm256_loadu_pd(sampleArray + i),
+                                           factorVector));
+        }
+
+        _scaleDoubleTail(sampleArray, i, count, factor);
+    }
+
+    /*--------------------*/
+
+    Kernels_target("avx2")
+    static void _addDoubleAVX2 (INOUT double* targetArray,
+                                IN double* sourceArray,
+                                IN size_t count)
+    {
+        size_t i = 0;
+
+        for (;  i + 4 <= count;  i += 4) {
+            _mm256_storeu_pd(targetArray + i,
+                             _mm256_add_pd(_mm256_loadu_pd(targetArray + i),
+                                           _mm256_loadu_pd(sourceArray
+                                                           + i)));
+        }
+
+        _multiplyAddDoubleTail(targetArray, sourceArray, i, count,
+                               false, 1.0);
+    }
+
+    /*--------------------*/
+
+    Kernels_target("avx2")
+    static void _multiplyAddDoubleAVX2 (INOUT double* targetArray,
+                                        IN double* sourceArray,
+                                        IN size_t count,
+                                        IN double factor)
+    {
+        const __m256d factorVector = _mm256_set1_pd(factor);
+        size_t i = 0;
+
+        for (;  i + 4 <= count;  i += 4) {
+            const __m256d value =
+                _mm256_mul_pd(_mm256_loadu_pd(sourceArray + i),
+                              factorVector);
+            _mm256_storeu_pd(targetArray + i,
+                             _mm256_add_pd(_mm256_loadu_pd(targetArray + i),
+                                           value));
+        }
+
+        _multiplyAddDoubleTail(targetArray, sourceArray, i, count,
+                               true, factor);
+    }
+
+    /*--------------------*/
+
+    Kernels_target("avx2")
+    static void _crossfadeDoubleAVX2 (INOUT double* targetArray,
+                                      IN double* sourceArray,
+                                      IN size_t count,
+                                      IN double startWeight,
+                                      IN double weightIncrement)
+    {
+        const __m256d startVector     = _mm256_set1_pd(startWeight);
+        const __m256d incrementVector = _mm256_set1_pd(weightIncrement);
+        const __m256d four            = _mm256_set1_pd(4.0);
+        __m256d index = _mm256_setr_pd(1.0, 2.0, 3.0, 4.0);
+        size_t i = 0;
+
+        for (;  i + 4 <= count;  i += 4) {
+            const __m256d weight =
+                _mm256_add_pd(startVector,
+                              _mm256_mul_pd(incrementVector, index));
+            const __m256d value = _mm256_loadu_pd(targetArray + i);
+            const __m256d difference =
+                _mm256_sub_pd(_mm256_loadu_pd(sourceArray + i), value);
+            _mm256_storeu_pd(targetArray + i,
+                             _mm256_add_pd(value,
+                                           _mm256_mul_pd(difference,
+                                                         weight)));
+            index = _mm256_add_pd(index, four);
+        }
+
+        _crossfadeDoubleTail(targetArray, sourceArray, i, count,
+                             startWeight, weightIncrement);
+    }
+
+    /*--------------------*/
+
+    Kernels_target("avx2")
+    static void _mixDoubleAVX2 (OUT double* targetArray,
+                                IN double* sourceArrayA,
+                                IN double* sourceArrayB,
+                                IN size_t count,
+                                IN double factorA,
+                                IN double factorB)
+    {
+        const __m256d factorVectorA = _mm256_set1_pd(factorA);
+        const __m256d factorVectorB = _mm256_set1_pd(factorB);
+        size_t i = 0;
+
+        for (;  i + 4 <= count;  i += 4) {
+            const __m256d valueA =
+                _mm256_mul_pd(_mm256_loadu_pd(sourceArrayA + i),
+                              factorVectorA);
+            const __m256d valueB =
+                _mm256_mul_pd(_mm256_loadu_pd(sourceArrayB + i),
+                              factorVectorB);
+            _mm256_storeu_pd(targetArray + i,
+                             _mm256_add_pd(valueA, valueB));
+        }
+
+        _mixDoubleTail(targetArray, sourceArrayA, sourceArrayB, i, count,
+                       factorA, factorB);
+    }
+
+    /*--------------------*/
+
+    Kernels_target("avx2")
+    static void _clampDoubleAVX2 (INOUT double* sampleArray,
+                                  IN size_t count,
+                                  IN double lowerLimit,
+                                  IN double upperLimit)
+    {
+        const __m256d lowerVector = _mm256_set1_pd(lowerLimit);
+        const __m256d upperVector = _mm256_set1_pd(upperLimit);
+        size_t i = 0;
+
+        for (;  i + 4 <= count;  i += 4) {
+            const __m256d value = _mm256_loadu_pd(sampleArray + i);
+            _mm256_storeu_pd(sampleArray + i,
+                             _mm256_min_pd(_mm256_max_pd(value,
+                                                         lowerVector),
+                                           upperVector));
+        }
+
+        _clampDoubleTail(sampleArray, i, count, lowerLimit, upperLimit);
+    }
+
+    /*--------------------*/
+
+    Kernels_target("avx2")
+    static void _levelFloatAVX2 (IN float* sampleArray,
+                                 IN size_t count,
+                                 OUT double* resultArray)
+    {
+        const __m256 signMask = _mm256_set1_ps(-0.0f);
+        __m256 peakVector = _mm256_setzero_ps();
+        __m256 sum = _mm256_setzero_ps();
+        size_t i = 0;
+
+        for (;  i + 8 <= count;  i += 8) {
+            const __m256 value = _mm256_loadu_ps(sampleArray + i);
+            peakVector = _mm256_max_ps(peakVector,
+                                       _mm256_andnot_ps(signMask, value));
+            sum = _mm256_add_ps(sum, _mm256_mul_ps(value, value));
+        }
+
+        float peakArray[8];
+        float partialSumArray[8];
+        _mm256_storeu_ps(peakArray, peakVector);
+        _mm256_storeu_ps(partialSumArray, sum);
+        float peak = 0.0f;
+
+        for (size_t k = 0;  k < 8;  k++) {
+            peak = (peakArray[k] > peak ? peakArray[k] : peak);
+        }
+
+        _levelFloatTail(sampleArray, i, count, peak, partialSumArray,
+                        resultArray);
+    }
+
+    /*--------------------*/
+
+    Kernels_target("avx2")
+    static void _levelDoubleAVX2 (IN double* sampleArray,
+                                  IN size_t count,
+                                  OUT double* resultArray)
+    {
+        const __m256d signMask = _mm256_set1_pd(-0.0);
+        __m256d peakVector = _mm256_setzero_pd();
+        __m256d sum = _mm256_setzero_pd();
+        size_t i = 0;
+
+        for (;  i + 4 <= count;  i += 4) {
+            const __m256d value = _mm256_loadu_pd(sampleArray + i);
+            peakVector = _mm256_max_pd(peakVector,
+                                       _mm256_andnot_pd(signMask, value));
+            sum = _mm256_add_pd(sum, _mm256_mul_pd(value, value));
+        }
+
+        double peakArray[4];
+        double partialSumArray[4];
+        _mm256_storeu_pd(peakArray, peakVector);
+        _mm256_storeu_pd(partialSumArray, sum);
+        const double peakA = (peakArray[0] > peakArray[1]
+                              ? peakArray[0] : peakArray[1]);
+        const double peakB = (peakArray[2] > peakArray[3]
+                              ? peakArray[2] : peakArray[3]);
+        _levelDoubleTail(sampleArray, i, count,
+                         (peakA > peakB ? peakA : peakB),
+                         partialSumArray, resultArray);
+    }
+
+    /*--------------------*/
+
+    Kernels_target("avx2")
+    static double _peakDoubleAVX2 (IN double* sampleArray,
+                                   IN size_t count)
+    {
+        const __m256d signMask = _mm256_set1_pd(-0.0);
+        __m256d peakA = _mm256_setzero_pd();
+        __m256d peakB = _mm256_setzero_pd();
+        size_t i = 0;
+
+        for (;  i + 8 <= count;  i += 8) {
+            peakA = _mm256_max_pd(peakA,
+                                  _mm256_andnot_pd(signMask,
+                                                   _mm256_loadu_pd(
+                                                       sampleArray + i)));
+            peakB = _mm256_max_pd(peakB,
+                                  _mm256_andnot_pd(signMask,
+                                                   _mm256_loadu_pd(
+                                                       sampleArray
+                                                       + i + 4)));
+        }
+
+        double peakArray[4];
+        _mm256_storeu_pd(peakArray, _mm256_max_pd(peakA, peakB));
+        double peak = 0.0;
+
+        for (size_t k = 0;  k < 4;  k++) {
+            peak = (peakArray[k] > peak ? peakArray[k] : peak);
+        }
+
+        return _peakDoubleTail(sampleArray, i, count, peak);
+    }
+
+    /*--------------------*/
+
+    Kernels_target("avx2")
+    static bool _isFiniteFloatAVX2 (IN float* sampleArray,
+                                    IN size_t count)
+    {
+        __m256 sum = _mm256_setzero_ps();
+        size_t i = 0;
+
+        for (;  i + 8 <= count;  i += 8) {
+            const __m256 value = _mm256_loadu_ps(sampleArray + i);
+            sum = _mm256_add_ps(sum, _mm256_sub_ps(value, value));
+        }
+
+        float partialSumArray[8];
+        _mm256_storeu_ps(partialSumArray, sum);
+        float partialSum = 0.0f;
+
+        for (size_t k = 0;  k < 8;  k++) {
+            partialSum += partialSumArray[k];
+        }
+
+        return _isFiniteFloatTail(sampleArray, i, count, partialSum);
+    }
+
+    /*--------------------*/
+
+    Kernels_target("avx2")
+    static bool _isFiniteDoubleAVX2 (IN double* sampleArray,
+                                     IN size_t count)
+    {
+        __m256d sum = _mm256_setzero_pd();
+        size_t i = 0;
+
+        for (;  i + 4 <= count;  i += 4) {
+            const __m256d value = _mm256_loadu_pd(sampleArray + i);
+            sum = _mm256_add_pd(sum, _mm256_sub_pd(value, value));
+        }
+
+        double partialSumArray[4];
+        _mm256_storeu_pd(partialSumArray, sum);
+        return _isFiniteDoubleTail(sampleArray, i, count,
+                                   ((partialSumArray[0]
+                                     + partialSumArray[1])
+                                    + (partialSumArray[2]
+                                       + partialSumArray[3])));
+    }
+
+    /*--------------------*/
+
+    /** the AVX2 kernels (the stereo biquad stays SSE2) */
+    static const Kernels _avx2Kernels = {
+        KernelInstructionSet::avx2,
+        _biquadStereoSSE2,
+        _biquadQuadAVX2,
+        _gainRampFloatAVX2,
+        _gainRampDoubleAVX2,
+        _combFilterBankAVX2,
+        _waveshapeFloatAVX2,
+        _waveshapeDoubleAVX2,
+        _waveshapeTableAVX2,
+        _floatToDoubleAVX2,
+        _doubleToFloatAVX2,
+        _scaleDoubleAVX2,
+        _addDoubleAVX2,
+        _multiplyAddDoubleAVX2,
+        _crossfadeDoubleAVX2,
+        _mixDoubleAVX2,
+        _clampDoubleAVX2,
+        _levelFloatAVX2,
+        _levelDoubleAVX2,
+        _peakDoubleAVX2,
+        _isFiniteFloatAVX2,
+        _isFiniteDoubleAVX2
+    };
+
+    /*====================*/
+    /* AVX-512 KERNELS    */
+    /*====================*/
+
+    #if defined(__GNUC__) && !defined(__clang__)
+        /* GCC misreports the undefined pass-through operands inside
+           the AVX-512 intrinsics as uninitialized */
+        #pragma GCC diagnostic push
+        #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    #endif
+
+    Kernels_target("avx512f")
+    static void _gainRampFloatAVX512 (INOUT float* sampleArray,
+                                      IN size_t count,
+                                      IN float startGain,
+                                      IN float gainIncrement)
+    {
+        const __m512 startVector     = _mm512_set1_ps(startGain);
+        const __m512 incrementVector = _mm512_set1_ps(gainIncrement);
+        const __m512 sixteen         = _mm512_set1_ps(16.0f);
+        __m512 index = _mm512_setr_ps(1.0f,  2.0f,  3.0f,  4.0f,
+                                      5.0f,  6.0f,  7.0f,  8.0f,
+                                      9.0f,  10.0f, 11.0f, 12.0f,
+                                      13.0f, 14.0f, 15.0f, 16.0f);
+        size_t i = 0;
+
+        for (;  i + 16 <= count;  i += 16) {
+            const __m512 gain =
+                _mm512_add_ps(startVector,
+                              _mm512_mul_ps(incrementVector, index));
+            _mm512_storeu_ps(sampleArray + i,
+                             _mm512_mul_ps(_mm512_loadu_ps(sampleArray + i),
+                                           gain));
+            index = _mm512_add_ps(index, sixteen);
+        }
+
+        _gainRampFloatTail(sampleArray, i, count, startGain, gainIncrement);
+    }
+
+    /*--------------------*/
+
+    Kernels_target("avx512f")
+    static void _gainRampDoubleAVX512 (INOUT double* sampleArray,
+                                       IN size_t count,
+                                       IN double startGain,
+                                       IN double gainIncrement)
+    {
+        const __m512d startVector     = _mm512_set1_pd(startGain);
+        const __m512d incrementVector = _mm512_set1_pd(gainIncrement);
+        const __m512d eight           = _mm512_set1_pd(8.0);
+        __m512d index = _mm512_setr_pd(1.0, 2.0, 3.0, 4.0,
+                                       5.0, 6.0, 7.0, 8.0);
+        size_t i = 0;
+
+        for (;  i + 8 <= count;  i += 8) {
+            const __m512d gain =
+                _mm512_add_pd(startVector,
+                              _mm512_mul_pd(incrementVector, index));
+            _mm512_storeu_pd(sampleArray + i,
+                             _mm512_mul_pd(_mm512_loadu_pd(sampleArray + i),
+                                           gain));
+            index = _mm512_add_pd(index, eight);
+        }
+
+        _gainRampDoubleTail(sampleArray, i, count, startGain, gainIncrement);
+    }
+
+    /*--------------------*/
+
+    Kernels_target("avx512f")
+    static void _combFilterBankAVX512 (INOUT DelayLineSample* data,
+                                       IN size_t* slotIndexArray,
+                                       INOUT double* storedSampleArray,
+                                       OUT double* outputSampleArray,
+                                       IN size_t laneCount,
+                                       IN double inputSample,
+                                       IN double feedback,
+                                       IN double hfDamping)
+    {
+        /* eight lanes are processed with gathered loads and
+           scattered stores */
+        const __m512d input          = _mm512_set1_pd(inputSample);
+        const __m512d feedbackFactor = _mm512_set1_pd(feedback);
+        const __m512d dampingFactor  = _mm512_set1_pd(hfDamping);
+        size_t k = 0;
+
+        for (;  k + 8 <= laneCount;  k += 8) {
+            const __m512i slotIndex = _mm512_loadu_si512(slotIndexArray + k);
+            __m512d output;
+
+            if constexpr (_delayLineHasFloats) {
+                output = _mm512_cvtps_pd(_mm512_i64gather_ps(slotIndex,
+                                                             data, 4));
+            } else {
+                output = _mm512_i64gather_pd(slotIndex, data, 8);
+            }
+
+            __m512d stored = _mm512_loadu_pd(storedSampleArray + k);
+            stored = _mm512_add_pd(output,
+                                   _mm512_mul_pd(_mm512_sub_pd(stored, output),
+                                                 dampingFactor));
+            const __m512d newSample =
+                _mm512_add_pd(input, _mm512_mul_pd(stored, feedbackFactor));
+
+            if constexpr (_delayLineHasFloats) {
+                _mm512_i64scatter_ps(data, slotIndex,
+                                     _mm512_cvtpd_ps(newSample), 4);
+            } else {
+                _mm512_i64scatter_pd(data, slotIndex, newSample, 8);
+            }
+
+            _mm512_storeu_pd(storedSampleArray + k, stored);
+            _mm512_storeu_pd(outputSampleArray + k, output);
+        }
+
+        _combFilterBankAVX2Tail(data, slotIndexArray, storedSampleArray,
+                                outputSampleArray, k, laneCount,
+                                inputSample, feedback, hfDamping);
+    }
+
+    /*--------------------*/
+
+    Kernels_target("avx512f")
+    static void _waveshapeFloatAVX512 (IN float* inputArray,
+                                       OUT double* outputArray,
+                                       IN size_t count,
+                                       IN float gain,
+                                       IN float colour)
+    {
+        const __m512 gainVector   = _mm512_set1_ps(gain);
+        const __m512 colourVector = _mm512_set1_ps(colour);
+        const __m512 lowerLimit   = _mm512_set1_ps(-1.0f);
+        const __m512 upperLimit   = _mm512_set1_ps(1.0f);
+        const __m512 three        = _mm512_set1_ps(3.0f);
+        size_t i = 0;
+
+        for (;  i + 16 <= count;  i += 16) {
+            const __m512 input = _mm512_loadu_ps(inputArray + i);
+            __m512 value = _mm512_add_ps(_mm512_mul_ps(input, gainVector),
+                                         colourVector);
+            value = _mm512_max_ps(lowerLimit,
+                                  _mm512_min_ps(upperLimit, value));
+            const __m512 cube =
+                _mm512_mul_ps(_mm512_mul_ps(value, value), value);
+            value = _mm512_sub_ps(value, _mm512_div_ps(cube, three));
+            const __m256 upperHalf =
+                _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(value),
+                                                        1));
+            _mm512_storeu_pd(outputArray + i,
+                             _mm512_cvtps_pd(_mm512_castps512_ps256(value)));
+            _mm512_storeu_pd(outputArray + i + 8,
+                             _mm512_cvtps_pd(upperHalf));
+        }
+
+        _waveshapeFloatAVX2(inputArray + i, outputArray + i, count - i,
+                            gain, colour);
+    }
+
+    /*--------------------*/
+
+    Kernels_target("avx512f")
+    static void _waveshapeDoubleAVX512 (IN double* inputArray,
+                                        OUT double* outputArray,
+                                        IN size_t count,
+                                        IN double gain,
+                                        IN double colour)
+    {
+        const __m512d gainVector   = _mm512_set1_pd(gain);
+        const __m512d colourVector = _mm512_set1_pd(colour);
+        const __m512d lowerLimit   = _mm512_set1_pd(-1.0);
+        const __m512d upperLimit   = _mm512_set1_pd(1.0);
+        const __m512d three        = _mm512_set1_pd(3.0);
+        size_t i = 0;
+
+        for (;  i + 8 <= count;  i += 8) {
+            const __m512d input = _mm512_loadu_pd(inputArray + i);
+            __m512d value = _mm512_add_pd(_mm512_mul_pd(input, gainVector),
+                                          colourVector);
+            value = _mm512_max_pd(lowerLimit,
+                                  _mm512_min_pd(upperLimit, value));
+            const __m512d cube =
+                _mm512_mul_pd(_mm512_mul_pd(value, value), value);
+            value = _mm512_sub_pd(value, _mm512_div_pd(cube, three));
+            _mm512_storeu_pd(outputArray + i, value);
+        }
+
+        _waveshapeDoubleAVX2(inputArray + i, outputArray + i, count - i,
+                             gain, colour);
+    }
+
+    /*--------------------*/
+
+    Kernels_target("avx512f")
+    static void _floatToDoubleAVX512 (OUT double* targetArray,
+                                      IN float* sourceArray,
+                                      IN size_t count)
+    {
+        size_t i = 0;
+
+        for (;  i + 8 <= count;  i += 8) {
+            _mm512_storeu_pd(targetArray + i,
+                             _mm512_cvtps_pd(_mm256_loadu_ps(sourceArray
+                                                             + i)));
+        }
+
+        _floatToDoubleSSE2(targetArray + i, sourceArray + i, count - i);
+    }
+
+    /*--------------------*/
+
+    Kernels_target("avx512f")
+    static void _doubleToFloatAVX512 (OUT float* targetArray,
+                                      IN double* sourceArray,
+                                      IN size_t count)
+    {
+        size_t i = 0;
+
+        for (;  i + 8 <= count;  i += 8) {
+            _mm256_storeu_ps(targetArray + i,
+                             _mm512_cvtpd_ps(_mm512_loadu_pd(sourceArray
+                                                             + i)));
+        }
+
+        _doubleToFloatSSE2(targetArray + i, sourceArray + i, count - i);
+    }
+
+    /*--------------------*/
+
+    Kernels_target("avx512f")
+    static double _peakDoubleAVX512 (IN double* sampleArray,
+                                     IN size_t count)
+    {
+        __m512d peakVector = _mm512_setzero_pd();
+        size_t i = 0;
+
+        for (;  i + 8 <= count;  i += 8) {
+            peakVector =
+                _mm512_max_pd(peakVector,
+                              _mm512_abs_pd(_mm512_loadu_pd(sampleArray
+                                                            + i)));
+        }
+
+        return _peakDoubleTail(sampleArray, i, count,
+                               _mm512_reduce_max_pd(peakVector));
+    }
+
+    /*--------------------*/
+
+    #if defined(__GNUC__) && !defined(__clang__)
+        #pragma GCC diagnostic pop
+    #endif
+
+    /*--------------------*/
+
+    /** the AVX-512 kernels (the biquads and the level measurement
+     * stay SSE2 and AVX2: wider partial sums would change the
+     * results; the finiteness check, the vector arithmetic and the
+     * table waveshaper are bound by memory anyway) */
+    static const Kernels _avx512Kernels = {
+        KernelInstructionSet::avx512,
+        _biquadStereoSSE2,
+        _biquadQuadAVX2,
+        _gainRampFloatAVX512,
+        _gainRampDoubleAVX512,
+        _combFilterBankAVX512,
+        _waveshapeFloatAVX512,
+        _waveshapeDoubleAVX512,
+        _waveshapeTableAVX2,
+        _floatToDoubleAVX512,
+        _doubleToFloatAVX512,
+        _scaleDoubleAVX2,
+        _addDoubleAVX2,
+        _multiplyAddDoubleAVX2,
+        _crossfadeDoubleAVX2,
+        _mixDoubleAVX2,
+        _clampDoubleAVX2,
+        _levelFloatAVX2,
+        _levelDoubleAVX2,
+        _peakDoubleAVX512,
+        _isFiniteFloatAVX2,
+        _isFiniteDoubleAVX2
+    };
+
+#endif
+
+/*====================*/
+/* NEON KERNELS       */
+/*====================*/
+
+#if defined(Kernels_usesNEON)
+
+    static void _biquadStereoNEON (IN double* inputArrayA,
+                                   IN double* inputArrayB,
+                                   OUT double* outputArrayA,
+                                   OUT double* outputArrayB,
+                                   IN size_t count,
+                                   IN double* coefficientArray,
+                                   INOUT double* stateArray)
+    {
+        /* lane 0 holds channel A, lane 1 holds channel B */
+        const float64x2_t b0 = vdupq_n_f64(coefficientArray[0]);
+        const float64x2_t b1 = vdupq_n_f64(coefficientArray[1]);
+        const float64x2_t b2 = vdupq_n_f64(coefficientArray[2]);
+        const float64x2_t a1 = vdupq_n_f64(coefficientArray[3]);
+        const float64x2_t a2 = vdupq_n_f64(coefficientArray[4]);
+        float64x2_t z1 = vld1q_f64(stateArray);
+        float64x2_t z2 = vld1q_f64(stateArray + 2);
+        double buffer[2];
+
+        for (size_t i = 0;  i < count;  i++) {
+            buffer[0] = inputArrayA[i];
+            buffer[1] = inputArrayB[i];
+            const float64x2_t x = vld1q_f64(buffer);
+            const float64x2_t y = vaddq_f64(vmulq_f64(b0, x), z1);
+            z1 = vaddq_f64(vsubq_f64(vmulq_f64(b1, x), vmulq_f64(a1, y)),
+                           z2);
+            z2 = vsubq_f64(vmulq_f64(b2, x), vmulq_f64(a2, y));
+            vst1q_f64(buffer, y);
+            outputArrayA[i] = buffer[0];
+            outputArrayB[i] = buffer[1];
+        }
+
+        vst1q_f64(stateArray, z1);
+        vst1q_f64(stateArray + 2, z2);
+    }
+
+    /*--------------------*/
+
+    static void _gainRampFloatNEON (INOUT float* sampleArray,
+                                    IN size_t count,
+                                    IN float startGain,
+                                    IN float gainIncrement)
+    {
+        static const float indexList[4] = { 1.0f, 2.0f, 3.0f, 4.0f };
+        const float32x4_t startVector     = vdupq_n_f32(startGain);
+        const float32x4_t incrementVector = vdupq_n_f32(gainIncrement);
+        const float32x4_t four            = vdupq_n_f32(4.0f);
+        float32x4_t index = vld1q_f32(indexList);
+        size_t i = 0;
+
+        for (;  i + 4 <= count;  i += 4) {
+            const float32x4_t gain =
+                vaddq_f32(startVector, vmulq_f32(incrementVector, index));
+            vst1q_f32(sampleArray + i,
+                      vmulq_f32(vld1q_f32(sampleArray + i), gain));
+            index = vaddq_f32(index, four);
+        }
+
+        _gainRampFloatTail(sampleArray, i, count, startGain, gainIncrement);
+    }
+
+    /*--------------------*/
+
+    static void _gainRampDoubleNEON (INOUT double* sampleArray,
+                                     IN size_t count,
+                                     IN double startGain,
+                                     IN double gainIncrement)
+    {
+        static const double indexList[2] = { 1.0, 2.0 };
+        const float64x2_t startVector     = vdupq_n_f64(startGain);
+        const float64x2_t incrementVector = vdupq_n_f64(gainIncrement);
+        const float64x2_t two             = vdupq_n_f64(2.0);
+        float64x2_t index = vld1q_f64(indexList);
+        size_t i = 0;
+
+        for (;  i + 2 <= count;  i += 2) {
+            const float64x2_t gain =
+                vaddq_f64(startVector, vmulq_f64(incrementVector, index));
+            vst1q_f64(sampleArray + i,
+                      vmulq_f64(vld1q_f64(sampleArray + i), gain));
+            index = vaddq_f64(index, two);
+        }
+
+        _gainRampDoubleTail(sampleArray, i, count, startGain, gainIncrement);
+    }
+
+    /*--------------------*/
+
+    static void _combFilterBankNEON (INOUT DelayLineSample* data,
+                                     IN size_t* slotIndexArray,
+                                     INOUT double* storedSampleArray,
+                                     OUT double* outputSampleArray,
+                                     IN size_t laneCount,
+                                     IN double inputSample,
+                                     IN double feedback,
+                                     IN double hfDamping)
+    {
+        /* lanes k and k + 1 are processed together */
+        const float64x2_t input          = vdupq_n_f64(inputSample);
+        const float64x2_t feedbackFactor = vdupq_n_f64(feedback);
+        const float64x2_t dampingFactor  = vdupq_n_f64(hfDamping);
+        double buffer[2];
+
+        for (size_t k = 0;  k < laneCount;  k += 2) {
+            DelayLineSample& slotA = data[slotIndexArray[k]];
+            DelayLineSample& slotB = data[slotIndexArray[k + 1]];
+            buffer[0] = (double) slotA;  buffer[1] = (double) slotB;
+            const float64x2_t output = vld1q_f64(buffer);
+            float64x2_t stored = vld1q_f64(storedSampleArray + k);
+            stored = vaddq_f64(output,
+                               vmulq_f64(vsubq_f64(stored, output),
+                                         dampingFactor));
+            const float64x2_t newSample =
+                vaddq_f64(input, vmulq_f64(stored, feedbackFactor));
+
+            vst1q_f64(buffer, newSample);
+            slotA = (DelayLineSample) buffer[0];
+            slotB = (DelayLineSample) buffer[1];
+            vst1q_f64(storedSampleArray + k, stored);
+            vst1q_f64(outputSampleArray + k, output);
+        }
+    }
+
+    /*--------------------*/
+
+    static void _waveshapeFloatNEON (IN float* inputArray,
+                                     OUT double* outputArray,
+                                     IN size_t count,
+                                     IN float gain,
+                                     IN float colour)
+    {
+        const float32x4_t gainVector   = vdupq_n_f32(gain);
+        const float32x4_t colourVector = vdupq_n_f32(colour);
+        const float32x4_t lowerLimit   = vdupq_n_f32(-1.0f);
+        const float32x4_t upperLimit   = vdupq_n_f32(1.0f);
+        const float32x4_t three        = vdupq_n_f32(3.0f);
+        size_t i = 0;
+
+        for (;  i + 4 <= count;  i += 4) {
+            float32x4_t value =
+                vaddq_f32(vmulq_f32(vld1q_f32(inputArray + i), gainVector),
+                          colourVector);
+            value = vmaxq_f32(lowerLimit, vminq_f32(upperLimit, value));
+            const float32x4_t cube =
+                vmulq_f32(vmulq_f32(value, value), value);
+            value = vsubq_f32(value, vdivq_f32(cube, three));
+            vst1q_f64(outputArray + i, vcvt_f64_f32(vget_low_f32(value)));
+            vst1q_f64(outputArray + i + 2, vcvt_high_f64_f32(value));
+        }
+
+        _waveshapeFloatScalar(inputArray + i, outputArray + i, count - i,
+                              gain, colour);
+    }
+
+    /*--------------------*/
+
+    static void _waveshapeDoubleNEON (IN double* inputArray,
+                                      OUT double* outputArray,
+                                      IN size_t count,
+                                      IN double gain,
+                                      IN double colour)
+    {
+        const float64x2_t gainVector   = vdupq_n_f64(gain);
+        const float64x2_t colourVector = vdupq_n_f64(colour);
+        const float64x2_t lowerLimit   = vdupq_n_f64(-1.0);
+        const float64x2_t upperLimit   = vdupq_n_f64(1.0);
+        const float64x2_t three        = vdupq_n_f64(3.0);
+        size_t i = 0;
+
+        for (;  i + 2 <= count;  i += 2) {
+            float64x2_t value =
+                vaddq_f64(vmulq_f64(vld1q_f64(inputArray + i), gainVector),
+                          colourVector);
+            value = vmaxq_f64(lowerLimit, vminq_f64(upperLimit, value));
+            const float64x2_t cube =
+                vmulq_f64(vmulq_f64(value, value), value);
+            value = vsubq_f64(value, vdivq_f64(cube, three));
+            vst1q_f64(outputArray + i, value);
+        }
+
+        _waveshapeDoubleScalar(inputArray + i, outputArray + i, count - i,
+                               gain, colour);
+    }
+
+    /*--------------------*/
+
+    static void _floatToDoubleNEON (OUT double* targetArray,
+                                    IN float* sourceArray,
+                                    IN size_t count)
+    {
+        size_t i = 0;
+
+        for (;  i + 4 <= count;  i += 4) {
+            const float32x4_t value = vld1q_f32(sourceArray + i);
+            vst1q_f64(targetArray + i, vcvt_f64_f32(vget_low_f32(value)));
+            vst1q_f64(targetArray + i + 2, vcvt_high_f64_f32(value));
+        }
+
+        _floatToDoubleScalar(targetArray + i, sourceArray + i, count - i);
+    }
+
+    /*--------------------*/
+
+    static void _doubleToFloatNEON (OUT float* targetArray,
+                                    IN double* sourceArray,
+                                    IN size_t count)
+    {
+        size_t i = 0;
+
+        for (;  i + 4 <= count;  i += 4) {
+            const float32x2_t valueA = vcvt_f32_f64(vld1q_f64(sourceArray + i));
+            vst1q_f32(targetArray + i,
+                      vcvt_high_f32_f64(valueA,
+                                        vld1q_f64(sourceArray + i + 2)));
+        }
+
+        _doubleToFloatScalar(targetArray + i, sourceArray + i, count - i);
+    }
+
+    /*--------------------*/
+
+    static void _scaleDoubleNEON (INOUT double* sampleArray,
+                                  IN size_t count,
+                                  IN double factor)
+    {
+        const float64x2_t factorVector = vdupq_n_f64(factor);
+        size_t i = 0;
+
+        for (;  i + 2 <= count;  i += 2) {
+            vst1q_f64(sampleArray + i,
+                      vmulq_f64(vld1q_f64(sampleArray + i), factorVector));
+        }
+
+        _scaleDoubleTail(sampleArray, i, count, factor);
+    }
+
+    /*--------------------*/
+
+    static void _addDoubleNEON (INOUT double* targetArray,
+                                IN double* sourceArray,
+                                IN size_t count)
+    {
+        size_t i = 0;
+
+        for (;  i + 2 <= count;  i += 2) {
+            vst1q_f64(targetArray + i,
+                      vaddq_f64(vld1q_f64(targetArray + i),
+                                vld1q_f64(sourceArray + i)));
+        }
+
+        _multiplyAddDoubleTail(targetArray, sourceArray, i, count,
+                               false, 1.0);
+    }
+
+    /*--------------------*/
+
+    static void _multiplyAddDoubleNEON (INOUT double* targetArray,
+                                        IN double* sourceArray,
+                                        IN size_t count,
+                                        IN double factor)
+    {
+        const float64x2_t factorVector = vdupq_n_f64(factor);
+        size_t i = 0;
+
+        /* no fused multiply-add: the scalar variant rounds twice */
+        for (;  i + 2 <= count;  i += 2) {
+            const float64x2_t value =
+                vmulq_f64(vld1q_f64(sourceArray + i), factorVector);
+            vst1q_f64(targetArray + i,
+                      vaddq_f64(vld1q_f64(targetArray + i), value));
+        }
+
+        _multiplyAddDoubleTail(targetArray, sourceArray, i, count,
+                               true, factor);
+    }
+
+    /*--------------------*/
+
+    static void _crossfadeDoubleNEON (INOUT double* targetArray,
+                                      IN double* sourceArray,
+                                      IN size_t count,
+                                      IN double startWeight,
+                                      IN double weightIncrement)
+    {
+        static const double indexList[2] = { 1.0, 2.0 };
+        const float64x2_t startVector     = vdupq_n_f64(startWeight);
+        const float64x2_t incrementVector = vdupq_n_f64(weightIncrement);
+        const float64x2_t two             = vdupq_n_f64(2.0);
+        float64x2_t index = vld1q_f64(indexList);
+        size_t i = 0;
+
+        for (;  i + 2 <= count;  i += 2) {
+            const float64x2_t weight =
+                vaddq_f64(startVector, vmulq_f64(incrementVector, index));
+            const float64x2_t value = vld1q_f64(targetArray + i);
+            const float64x2_t difference =
+                vsubq_f64(vld1q_f64(sourceArray + i), value);
+            vst1q_f64(targetArray + i,
+                      vaddq_f64(value, vmulq_f64(difference, weight)));
+            index = vaddq_f64(index, two);
+        }
+
+        _crossfadeDoubleTail(targetArray, sourceArray, i, count,
+                             startWeight, weightIncrement);
+    }
+
+    /*--------------------*/
+
+    static void _mixDoubleNEON (OUT double* targetArray,
+                                IN double* sourceArrayA,
+                                IN double* sourceArrayB,
+                                IN size_t count,
+                                IN double factorA,
+                                IN double factorB)
+    {
+        const float64x2_t factorVectorA = vdupq_n_f64(factorA);
+        const float64x2_t factorVectorB = vdupq_n_f64(factorB);
+        size_t i = 0;
+
+        for (;  i + 2 <= count;  i += 2) {
+            const float64x2_t valueA =
+                vmulq_f64(vld1q_f64(sourceArrayA + i), factorVectorA);
+            const float64x2_t valueB =
+                vmulq_f64(vld1q_f64(sourceArrayB + i), factorVectorB);
+            vst1q_f64(targetArray + i, vaddq_f64(valueA, valueB));
+        }
+
+        _mixDoubleTail(targetArray, sourceArrayA, sourceArrayB, i, count,
+                       factorA, factorB);
+    }
+
+    /*--------------------*/
+
+    static void _clampDoubleNEON (INOUT double* sampleArray,
+                                  IN size_t count,
+                                  IN double lowerLimit,
+                                  IN double upperLimit)
+    {
+        const float64x2_t lowerVector = vdupq_n_f64(lowerLimit);
+        const float64x2_t upperVector = vdupq_n_f64(upperLimit);
+        size_t i = 0;
+
+        /* selects by comparison instead of vmaxq and vminq, which
+           would propagate a NaN unlike the other variants */
+        for (;  i + 2 <= count;  i += 2) {
+            const float64x2_t value = vld1q_f64(sampleArray + i);
+            const float64x2_t limitedValue =
+                vbslq_f64(vcgtq_f64(value, lowerVector),
+                          value, lowerVector);
+            vst1q_f64(sampleArray + i,
+                      vbslq_f64(vcltq_f64(limitedValue, upperVector),
+                                limitedValue, upperVector));
+        }
+
+        _clampDoubleTail(sampleArray, i, count, lowerLimit, upperLimit);
+    }
+
+    /*--------------------*/
+
+    static void _levelFloatNEON (IN float* sampleArray,
+                                 IN size_t count,
+                                 OUT double* resultArray)
+    {
+        /* the two vectors hold the partial sums 0-3 and 4-7 */
+        float32x4_t peakVector = vdupq_n_f32(0.0f);
+        float32x4_t sumA = vdupq_n_f32(0.0f);
+        float32x4_t sumB = vdupq_n_f32(0.0f);
+        size_t i = 0;
+
+        for (;  i + 8 <= count;  i += 8) {
+            const float32x4_t valueA = vld1q_f32(sampleArray + i);
+            const float32x4_t valueB = vld1q_f32(sampleArray + i + 4);
+            peakVector = vmaxq_f32(peakVector,
+                                   vmaxq_f32(vabsq_f32(valueA),
+                                             vabsq_f32(valueB)));
+            sumA = vaddq_f32(sumA, vmulq_f32(valueA, valueA));
+            sumB = vaddq_f32(sumB, vmulq_f32(valueB, valueB));
+        }
+
+        float partialSumArray[8];
+        vst1q_f32(partialSumArray, sumA);
+        vst1q_f32(partialSumArray + 4, sumB);
+        _levelFloatTail(sampleArray, i, count, vmaxvq_f32(peakVector),
+                        partialSumArray, resultArray);
+    }
+
+    /*--------------------*/
+
+    static void _levelDoubleNEON (IN double* sampleArray,
+                                  IN size_t count,
+                                  OUT double* resultArray)
+    {
+        /* the two vectors hold the partial sums 0-1 and 2-3 */
+        float64x2_t peakVector = vdupq_n_f64(0.0);
+        float64x2_t sumA = vdupq_n_f64(0.0);
+        float64x2_t sumB = vdupq_n_f64(0.0);
+        size_t i = 0;
+
+        for (;  i + 4 <= count;  i += 4) {
+            const float64x2_t valueA = vld1q_f64(sampleArray + i);
+            const float64x2_t valueB = vld1q_f64(sampleArray + i + 2);
+            peakVector = vmaxq_f64(peakVector,
+                                   vmaxq_f64(vabsq_f64(valueA),
+                                             vabsq_f64(valueB)));
+            sumA = vaddq_f64(sumA, vmulq_f64(valueA, valueA));
+            sumB = vaddq_f64(sumB, vmulq_f64(valueB, valueB));
+        }
+
+        double partialSumArray[4];
+        vst1q_f64(partialSumArray, sumA);
+        vst1q_f64(partialSumArray + 2, sumB);
+        _levelDoubleTail(sampleArray, i, count, vmaxvq_f64(peakVector),
+                         partialSumArray, resultArray);
+    }
+
+    /*--------------------*/
+
+    static double _peakDoubleNEON (IN double* sampleArray,
+                                   IN size_t count)
+    {
+        float64x2_t peakA = vdupq_n_f64(0.0);
+        float64x2_t peakB = vdupq_n_f64(0.0);
+        size_t i = 0;
+
+        for (;  i + 4 <= count;  i += 4) {
+            peakA = vmaxq_f64(peakA, vabsq_f64(vld1q_f64(sampleArray + i)));
+            peakB = vmaxq_f64(peakB,
+                              vabsq_f64(vld1q_f64(sampleArray + i + 2)));
+        }
+
+        return _peakDoubleTail(sampleArray, i, count,
+                               vmaxvq_f64(vmaxq_f64(peakA, peakB)));
+    }
+
+    /*--------------------*/
+
+    static bool _isFiniteFloatNEON (IN float* sampleArray,
+                                    IN size_t count)
+    {
+        float32x4_t sum = vdupq_n_f32(0.0f);
+        size_t i = 0;
+
+        for (;  i + 4 <= count;  i += 4) {
+            const float32x4_t value = vld1q_f32(sampleArray + i);
+            sum = vaddq_f32(sum, vsubq_f32(value, value));
+        }
+
+        return _isFiniteFloatTail(sampleArray, i, count,
+                                  vaddvq_f32(sum));
+    }
+
+    /*--------------------*/
+
+    static bool _isFiniteDoubleNEON (IN double* sampleArray,
+                                     IN size_t count)
+    {
+        float64x2_t sum = vdupq_n_f64(0.0);
+        size_t i = 0;
+
+        for (;  i + 2 <= count;  i += 2) {
+            const float64x2_t value = vld1q_f64(sampleArray + i);
+            sum = vaddq_f64(sum, vsubq_f64(value, value));
+        }
+
+        return _isFiniteDoubleTail(sampleArray, i, count,
+                                   vaddvq_f64(sum));
+    }
+
+    /*--------------------*/
+
+    /** the NEON kernels (the table waveshaper stays scalar for lack
+     * of a gather instruction) */
+    static const Kernels _neonKernels = {
+        KernelInstructionSet::neon,
+        _biquadStereoNEON,
+        _biquadQuadByPairs<_biquadStereoNEON>,
+        _gainRampFloatNEON,
+        _gainRampDoubleNEON,
+        _combFilterBankNEON,
+        _waveshapeFloatNEON,
+        _waveshapeDoubleNEON,
+        _waveshapeTableScalar,
+        _floatToDoubleNEON,
+        _doubleToFloatNEON,
+        _scaleDoubleNEON,
+        _addDoubleNEON,
+        _multiplyAddDoubleNEON,
+        _crossfadeDoubleNEON,
+        _mixDoubleNEON,
+        _clampDoubleNEON,
+        _levelFloatNEON,
+        _levelDoubleNEON,
+        _peakDoubleNEON,
+        _isFiniteFloatNEON,
+        _isFiniteDoubleNEON
+    };
+
+#endif
+
+/*====================*/
+/* PROCESSOR FEATURES */
+/*====================*/
+
+#if defined(Kernels_usesX86)
+
+    /**
+     * Returns the registers <C>eax</C> to <C>edx</C> of CPUID for
+     * <C>leaf</C> and <C>subleaf</C> in <C>registerArray</C>.
+     *
+     * @param[out] registerArray  eax, ebx, ecx and edx
+     * @param[in]  leaf           CPUID function
+     * @param[in]  subleaf        CPUID subfunction
+     */
+    static void _cpuid (OUT unsigned int* registerArray,
+                        IN unsigned int leaf,
+                        IN unsigned int subleaf)
+    {
+        #if defined(_MSC_VER)
+            int info[4];
+            __cpuidex(info, (int) leaf, (int) subleaf);
+
+            for (size_t i = 0;  i < 4;  i++) {
+                registerArray[i] = (unsigned int) info[i];
+            }
+        #else
+            __cpuid_count(leaf, subleaf,
+                          registerArray[0], registerArray[1],
+                          registerArray[2], registerArray[3]);
+        #endif
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the register state components enabled by the
+     * operating system (XCR0); must only be called when OSXSAVE is
+     * set.
+     *
+     * @return  contents of XCR0
+     */
+    static unsigned long long _enabledRegisterStates ()
+    {
+        #if defined(_MSC_VER)
+            return _xgetbv(0);
+        #else
+            unsigned int eax, edx;
+            __asm__ __volatile__ ("xgetbv" : "=a" (eax), "=d" (edx)
+                                  : "c" (0));
+            return ((unsigned long long) edx << 32) | eax;
+        #endif
+    }
+
+#endif
+
+/*--------------------*/
+
+/**
+ * Returns the widest instruction set supported by the executing
+ * processor and operating system for which the binary contains
+ * kernels.
+ *
+ * @return  instruction set to be used
+ */
+static KernelInstructionSet _detectInstructionSet ()
+{
+    KernelInstructionSet result = KernelInstructionSet::scalar;
+
+    #if defined(Kernels_usesX86)
+        /* the YMM (AVX) and additionally the opmask and ZMM state
+           (AVX-512) must be enabled by the operating system */
+        const unsigned long long avxStateMask    = 0x06;
+        const unsigned long long avx512StateMask = 0xE6;
+        unsigned int registerArray[4];
+
+        result = KernelInstructionSet::sse2;
+        _cpuid(registerArray, 0, 0);
+        const unsigned int maximumLeaf = registerArray[0];
+        _cpuid(registerArray, 1, 0);
+        const bool hasOSXSave = (registerArray[2] >> 27) & 1;
+        const bool hasAVX     = (registerArray[2] >> 28) & 1;
+
+        if (maximumLeaf >= 7 && hasOSXSave && hasAVX) {
+            const unsigned long long enabledStates =
+                _enabledRegisterStates();
+            _cpuid(registerArray, 7, 0);
+            const bool hasAVX2    = (registerArray[1] >> 5) & 1;
+            const bool hasAVX512F = (registerArray[1] >> 16) & 1;
+
+            if (hasAVX2 && (enabledStates & avxStateMask) == avxStateMask) {
+                result = KernelInstructionSet::avx2;
+
+                if (hasAVX512F
+                    && ((enabledStates & avx512StateMask)
+                        == avx512StateMask)) {
+                    result = KernelInstructionSet::avx512;
+                }
+            }
+        }
+    #elif defined(Kernels_usesNEON)
+        /* NEON is mandatory on AArch64, only Linux tells about it
+           explicitly */
+        result = KernelInstructionSet::neon;
+
+        #if defined(__linux__)
+            if ((getauxval(AT_HWCAP) & HWCAP_ASIMD) == 0) {
+                result = KernelInstructionSet::scalar;
+            }
+        #endif
+    #endif
+
+    return result;
+}
+
+/*--------------------*/
+
+/**
+ * Returns the widest instruction set usable on the executing
+ * processor (detected on the first call only).
+ *
+ * @return  instruction set to be used
+ */
+static KernelInstructionSet _widestInstructionSet ()
+{
+    static const KernelInstructionSet result = _detectInstructionSet();
+    return result;
+}
+
+/*============================================================*/
+
+/*--------------------*/
+/* class methods      */
+/*--------------------*/
+
+/**
+ * Returns the kernel table chosen by the first call of
+ * <C>current()</C> or by <C>select</C> (initially none).
+ *
+ * @return  reference to process-wide selected table
+ */
+static std::atomic<const Kernels*>& _selectedKernels ()
+{
+    static std::atomic<const Kernels*> selectedKernels{nullptr};
+    return selectedKernels;
+}
+
+/*--------------------*/
+
+const Kernels& Kernels::current ()
+{
+    const Kernels* result =
+        _selectedKernels().load(std::memory_order_acquire);
+
+    if (result == nullptr) {
+        const KernelInstructionSet instructionSet =
+            _widestInstructionSet();
+        Logging_trace1("--: using %1 kernels",
+                       instructionSetName(instructionSet));
+        const Kernels* kernels = &forInstructionSet(instructionSet);
+
+        /* a concurrent selection takes precedence */
+        result = (_selectedKernels().compare_exchange_strong(result,
+                                                             kernels)
+                  ? kernels : result);
+    }
+
+    return *result;
+}
+
+/*--------------------*/
+
+void Kernels::select (IN KernelInstructionSet instructionSet)
+{
+    Logging_trace1(">>: %1", instructionSetName(instructionSet));
+    Assertion_pre(isSupported(instructionSet),
+                  "instruction set must be supported");
+    _selectedKernels().store(&forInstructionSet(instructionSet),
+                             std::memory_order_release);
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+const Kernels&
+Kernels::forInstructionSet (IN KernelInstructionSet instructionSet)
+{
+    Assertion_pre(isSupported(instructionSet),
+                  "instruction set must be supported");
+    const Kernels* result = &_scalarKernels;
+
+    #if defined(Kernels_usesX86)
+        if (instructionSet == KernelInstructionSet::sse2) {
+            result = &_sse2Kernels;
+        } else if (instructionSet == KernelInstructionSet::avx2) {
+            result = &_avx2Kernels;
+        } else if (instructionSet == KernelInstructionSet::avx512) {
+            result = &_avx512Kernels;
+        }
+    #elif defined(Kernels_usesNEON)
+        if (instructionSet == KernelInstructionSet::neon) {
+            result = &_neonKernels;
+        }
+    #endif
+
+    return *result;
+}
+
+/*--------------------*/
+
+Boolean Kernels::isSupported (IN KernelInstructionSet instructionSet)
+{
+    const KernelInstructionSet widestInstructionSet =
+        _widestInstructionSet();
+    Boolean result;
+
+    if (instructionSet == KernelInstructionSet::scalar) {
+        result = true;
+    } else if (instructionSet == KernelInstructionSet::neon
+               || widestInstructionSet == KernelInstructionSet::neon) {
+        result = (instructionSet == widestInstructionSet);
+    } else {
+        /* the x86 instruction sets are ordered by width */
+        result = ((int) instructionSet <= (int) widestInstructionSet);
+    }
+
+    return result;
+}
+
+/*--------------------*/
+
+String
+Kernels::instructionSetName (IN KernelInstructionSet instructionSet)
+{
+    String result;
+
+    switch (instructionSet) {
+        case KernelInstructionSet::sse2:
+            result = "SSE2";
+            break;
+        case KernelInstructionSet::avx2:
+            result = "AVX2";
+            break;
+        case KernelInstructionSet::avx512:
+            result = "AVX-512";
+            break;
+        case KernelInstructionSet::neon:
+            result = "NEON";
+            break;
+        default:
+            result = "scalar";
+    }
+
+    return result;
+}
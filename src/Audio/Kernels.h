@@ -0,0 +1,408 @@
+/**
+ * @file
+ * The <C>Kernels</C> specification defines a table of the SIMD
+ * processing kernels for audio samples, which is resolved once for
+ * the instruction set of the executing processor.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include <cstddef>
+#include "AudioSample.h"
+#include "Boolean.h"
+#include "MyString.h"
+
+/*--------------------*/
+
+using BaseTypes::Primitives::Boolean;
+using BaseTypes::Primitives::String;
+
+/*====================*/
+
+namespace Audio {
+
+    /**
+     * The <C>KernelInstructionSet</C> is an enumeration type for the
+     * instruction sets kernels are available for: portable scalar
+     * code, SSE2, AVX2 and AVX-512 on x86 processors and NEON on ARM
+     * processors.
+     */
+    enum class KernelInstructionSet {
+        scalar, sse2, avx2, avx512, neon
+    };
+
+    /*--------------------*/
+
+    /**
+     * A <C>Kernels</C> object is a table of function pointers to the
+     * inner loops of audio processing for a single instruction set.
+     * The binary contains a table for each instruction set of the
+     * target architecture (when <C>AUDIO_USES_SIMD</C> is defined,
+     * otherwise only the scalar one); <C>current()</C> selects the
+     * table for the widest instruction set supported by the
+     * processor and operating system once on its first call, hence
+     * it should be called when a plugin is loaded.  Because the
+     * widest set is not always the fastest one (e.g. when wide
+     * vector units lower the clock), <C>select</C> may replace the
+     * table by a narrower one found faster by a benchmark.
+     *
+     * All variants of a kernel execute the same floating point
+     * operations per sample (only more samples at once), so the
+     * instruction set does not change the results (unless fast
+     * floating point math lets the compiler rewrite the scalar
+     * code).  Kernels without a useful wider variant share the
+     * narrower one.
+     */
+    struct Kernels {
+
+        /** the instruction set of the kernels in this table */
+        KernelInstructionSet instructionSet;
+
+        /*--------------------*/
+        /* biquad filters     */
+        /*--------------------*/
+
+        /**
+         * Applies a biquad filter in transposed direct form II with
+         * <C>coefficientArray</C> (b0, b1, b2, a1 and a2) to the
+         * <C>count</C> samples of two channels A and B in
+         * <C>inputArrayA</C> and <C>inputArrayB</C> and stores the
+         * results in <C>outputArrayA</C> and <C>outputArrayB</C>;
+         * <C>stateArray</C> holds z1 of A and B followed by z2 of A
+         * and B.  Input and output arrays may coincide.
+         */
+        void (*biquadStereo) (IN double* inputArrayA,
+                              IN double* inputArrayB,
+                              OUT double* outputArrayA,
+                              OUT double* outputArrayB,
+                              IN size_t count,
+                              IN double* coefficientArray,
+                              INOUT double* stateArray);
+
+        /**
+         * Applies a biquad filter in transposed direct form II with
+         * <C>coefficientArray</C> (b0, b1, b2, a1 and a2) in place
+         * to the <C>count</C> samples of the four channels in
+         * <C>channelArray</C>; <C>stateArray</C> holds z1 of all
+         * four channels followed by z2 of all four channels.
+         */
+        void (*biquadQuad) (INOUT double* const* channelArray,
+                            IN size_t count,
+                            IN double* coefficientArray,
+                            INOUT double* stateArray);
+
+        /*--------------------*/
+        /* gain               */
+        /*--------------------*/
+
+        /**
+         * Multiplies the <C>count</C> float samples in
+         * <C>sampleArray</C> in place by a linear gain ramp: sample
+         * <C>i</C> gets the factor <C>startGain + gainIncrement *
+         * (i + 1)</C>.
+         */
+        void (*gainRampFloat) (INOUT float* sampleArray,
+                               IN size_t count,
+                               IN float startGain,
+                               IN float gainIncrement);
+
+        /**
+         * Multiplies the <C>count</C> double samples in
+         * <C>sampleArray</C> in place by a linear gain ramp: sample
+         * <C>i</C> gets the factor <C>startGain + gainIncrement *
+         * (i + 1)</C>.
+         */
+        void (*gainRampDouble) (INOUT double* sampleArray,
+                                IN size_t count,
+                                IN double startGain,
+                                IN double gainIncrement);
+
+        /*--------------------*/
+        /* comb filter bank   */
+        /*--------------------*/
+
+        /**
+         * Feeds <C>inputSample</C> into <C>laneCount</C> (an even
+         * number) parallel damped comb filters with
+         * <C>feedback</C> and <C>hfDamping</C>: for each lane
+         * <C>k</C> the delay line slot
+         * <C>data[slotIndexArray[k]]</C> is read into
+         * <C>outputSampleArray[k]</C>, the damping state
+         * <C>storedSampleArray[k]</C> is updated and the slot is
+         * overwritten by the new delay line sample.
+         */
+        void (*combFilterBank) (INOUT DelayLineSample* data,
+                                IN size_t* slotIndexArray,
+                                INOUT double* storedSampleArray,
+                                OUT double* outputSampleArray,
+                                IN size_t laneCount,
+                                IN double inputSample,
+                                IN double feedback,
+                                IN double hfDamping);
+
+        /*--------------------*/
+        /* waveshaper         */
+        /*--------------------*/
+
+        /**
+         * Applies the overdrive waveshaper (gain, DC offset
+         * <C>colour</C>, clipping to [-1, 1] and cubic shaping
+         * <C>x - x^3/3</C>) in float precision to the <C>count</C>
+         * samples in <C>inputArray</C> and stores the results as
+         * doubles in <C>outputArray</C>.
+         */
+        void (*waveshapeFloat) (IN float* inputArray,
+                                OUT double* outputArray,
+                                IN size_t count,
+                                IN float gain,
+                                IN float colour);
+
+        /**
+         * Applies the overdrive waveshaper (gain, DC offset
+         * <C>colour</C>, clipping to [-1, 1] and cubic shaping
+         * <C>x - x^3/3</C>) to the <C>count</C> samples in
+         * <C>inputArray</C> and stores the results in
+         * <C>outputArray</C>; both arrays may coincide.
+         */
+        void (*waveshapeDouble) (IN double* inputArray,
+                                 OUT double* outputArray,
+                                 IN size_t count,
+                                 IN double gain,
+                                 IN double colour);
+
+        /**
+         * Applies gain, DC offset <C>colour</C> and clipping to [-1,
+         * 1] to the <C>count</C> samples in <C>inputArray</C> and
+         * shapes them by linear interpolation in
+         * <C>tableArray</C>, which holds a curve sampled at
+         * <C>intervalCount + 1</C> equidistant points from -1 to 1
+         * followed by a copy of its last entry as a guard; the
+         * results are stored in <C>outputArray</C> (both arrays may
+         * coincide).
+         */
+        void (*waveshapeTable) (IN double* inputArray,
+                                OUT double* outputArray,
+                                IN size_t count,
+                                IN double gain,
+                                IN double colour,
+                                IN double* tableArray,
+                                IN size_t intervalCount);
+
+        /*--------------------*/
+        /* format conversion  */
+        /*--------------------*/
+
+        /**
+         * Converts the <C>count</C> float samples in
+         * <C>sourceArray</C> to doubles in <C>targetArray</C>.
+         */
+        void (*floatToDouble) (OUT double* targetArray,
+                               IN float* sourceArray,
+                               IN size_t count);
+
+        /**
+         * Converts the <C>count</C> double samples in
+         * <C>sourceArray</C> to floats in <C>targetArray</C>.
+         */
+        void (*doubleToFloat) (OUT float* targetArray,
+                               IN double* sourceArray,
+                               IN size_t count);
+
+        /*--------------------*/
+        /* vector arithmetic  */
+        /*--------------------*/
+
+        /**
+         * Multiplies the <C>count</C> double samples in
+         * <C>sampleArray</C> in place by <C>factor</C>.
+         */
+        void (*scaleDouble) (INOUT double* sampleArray,
+                             IN size_t count,
+                             IN double factor);
+
+        /**
+         * Adds the <C>count</C> double samples in
+         * <C>sourceArray</C> to those in <C>targetArray</C>.
+         */
+        void (*addDouble) (INOUT double* targetArray,
+                           IN double* sourceArray,
+                           IN size_t count);
+
+        /**
+         * Adds the <C>count</C> double samples in
+         * <C>sourceArray</C> multiplied by <C>factor</C> to those in
+         * <C>targetArray</C>; multiplication and addition are
+         * rounded separately.
+         */
+        void (*multiplyAddDouble) (INOUT double* targetArray,
+                                   IN double* sourceArray,
+                                   IN size_t count,
+                                   IN double factor);
+
+        /**
+         * Fades the <C>count</C> double samples in
+         * <C>targetArray</C> towards those in <C>sourceArray</C>
+         * with a linear weight ramp: sample <C>i</C> becomes
+         * <C>t + (s - t) * w</C> with weight <C>w = startWeight +
+         * weightIncrement * (i + 1)</C>.
+         */
+        void (*crossfadeDouble) (INOUT double* targetArray,
+                                 IN double* sourceArray,
+                                 IN size_t count,
+                                 IN double startWeight,
+                                 IN double weightIncrement);
+
+        /**
+         * Stores the sum of the <C>count</C> double samples in
+         * <C>sourceArrayA</C> multiplied by <C>factorA</C> and those
+         * in <C>sourceArrayB</C> multiplied by <C>factorB</C> in
+         * <C>targetArray</C>; the target may coincide with either
+         * source.
+         */
+        void (*mixDouble) (OUT double* targetArray,
+                           IN double* sourceArrayA,
+                           IN double* sourceArrayB,
+                           IN size_t count,
+                           IN double factorA,
+                           IN double factorB);
+
+        /**
+         * Limits the <C>count</C> double samples in
+         * <C>sampleArray</C> in place to the interval from
+         * <C>lowerLimit</C> to <C>upperLimit</C>.
+         */
+        void (*clampDouble) (INOUT double* sampleArray,
+                             IN size_t count,
+                             IN double lowerLimit,
+                             IN double upperLimit);
+
+        /*--------------------*/
+        /* level measurement  */
+        /*--------------------*/
+
+        /**
+         * Stores the maximum magnitude of the <C>count</C> float
+         * samples in <C>sampleArray</C> in <C>resultArray[0]</C>
+         * and the sum of their squares in <C>resultArray[1]</C>;
+         * the squares are summed in eight interleaved partial sums
+         * in float precision.
+         */
+        void (*levelFloat) (IN float* sampleArray,
+                            IN size_t count,
+                            OUT double* resultArray);
+
+        /**
+         * Stores the maximum magnitude of the <C>count</C> double
+         * samples in <C>sampleArray</C> in <C>resultArray[0]</C>
+         * and the sum of their squares in <C>resultArray[1]</C>;
+         * the squares are summed in four interleaved partial sums.
+         */
+        void (*levelDouble) (IN double* sampleArray,
+                             IN size_t count,
+                             OUT double* resultArray);
+
+        /**
+         * Returns the maximum magnitude of the <C>count</C> double
+         * samples in <C>sampleArray</C> (zero for no samples).
+         */
+        double (*peakDouble) (IN double* sampleArray,
+                              IN size_t count);
+
+        /*--------------------*/
+        /* finiteness check   */
+        /*--------------------*/
+
+        /**
+         * Tells whether all <C>count</C> float samples in
+         * <C>sampleArray</C> are finite (neither NaN nor infinite);
+         * the differences <C>x - x</C> are summed, which stays zero
+         * for finite samples only.
+         */
+        bool (*isFiniteFloat) (IN float* sampleArray,
+                               IN size_t count);
+
+        /**
+         * Tells whether all <C>count</C> double samples in
+         * <C>sampleArray</C> are finite (neither NaN nor infinite);
+         * the differences <C>x - x</C> are summed, which stays zero
+         * for finite samples only.
+         */
+        bool (*isFiniteDouble) (IN double* sampleArray,
+                                IN size_t count);
+
+        /*--------------------*/
+        /* class methods      */
+        /*--------------------*/
+
+        /**
+         * Returns the kernel table in use: either the one set by
+         * <C>select</C> or the one for the widest instruction set
+         * supported by the executing processor; the processor is
+         * inspected on the first call only.
+         *
+         * @return  kernel table in use
+         */
+        static const Kernels& current ();
+
+        /*--------------------*/
+
+        /**
+         * Sets the kernel table returned by <C>current()</C> to the
+         * one for <C>instructionSet</C>; since all tables give the
+         * same results, this may be done while other threads are
+         * processing.
+         *
+         * @param[in] instructionSet  instruction set of kernels
+         * @pre isSupported(instructionSet)
+         */
+        static void select (IN KernelInstructionSet instructionSet);
+
+        /*--------------------*/
+
+        /**
+         * Returns the kernel table for <C>instructionSet</C> (e.g.
+         * for comparing variants).
+         *
+         * @param[in] instructionSet  instruction set of kernels
+         * @return  kernel table for instruction set
+         * @pre isSupported(instructionSet)
+         */
+        static const Kernels&
+        forInstructionSet (IN KernelInstructionSet instructionSet);
+
+        /*--------------------*/
+
+        /**
+         * Tells whether the binary contains kernels for
+         * <C>instructionSet</C> and the executing processor
+         * supports them.
+         *
+         * @param[in] instructionSet  instruction set to be checked
+         * @return  information whether kernels may be used
+         */
+        static Boolean
+        isSupported (IN KernelInstructionSet instructionSet);
+
+        /*--------------------*/
+
+        /**
+         * Returns the name of <C>instructionSet</C>.
+         *
+         * @param[in] instructionSet  instruction set of kernels
+         * @return  name of instruction set
+         */
+        static String
+        instructionSetName (IN KernelInstructionSet instructionSet);
+
+    };
+
+}
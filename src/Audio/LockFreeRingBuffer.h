@@ -0,0 +1,412 @@
+/**
+ * @file
+ * The <C>LockFreeRingBuffer</C> specification defines a wait-free
+ * single-producer/single-consumer ring buffer for the transport of
+ * samples or events between two threads.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include <algorithm>
+#include <atomic>
+#include "GenericList.h"
+#include "MyString.h"
+#include "Natural.h"
+#include "StringUtil.h"
+
+/*--------------------*/
+
+using BaseTypes::GenericTypes::GenericList;
+using BaseTypes::Primitives::Boolean;
+using BaseTypes::Primitives::Natural;
+using BaseTypes::Primitives::String;
+
+/*====================*/
+
+namespace Audio {
+
+    /**
+     * A <C>LockFreeRingBuffer</C> object transports elements of type
+     * <C>T</C> (e.g. audio samples or events) from a single producer
+     * thread to a single consumer thread.  No operation ever waits or
+     * allocates: a push into a full buffer or a pop from an empty
+     * buffer simply transfers fewer elements and tells so.
+     *
+     * The capacity is a power of two; both sides advance free-running
+     * counters (published with release and read with acquire
+     * semantics), such that an index is the counter masked by the
+     * capacity and the fill level is the counter difference.  Each
+     * counter lies on a cache line of its own together with a cached
+     * copy of the counter of the other side, hence the other side's
+     * cache line is only touched when the cached value does not
+     * suffice.
+     *
+     * The capacity is set before the buffer is used by both threads;
+     * <C>setCapacity</C> and <C>clear</C> must not be called
+     * concurrently with pushing or popping.
+     *
+     * @tparam T  type of elements (must be default-constructible and
+     *            assignable)
+     */
+    template<typename T>
+    struct LockFreeRingBuffer {
+
+        /**
+         * Makes ring buffer with capacity for at least
+         * <C>capacity</C> elements (rounded up to a power of two).
+         *
+         * @param[in] capacity  minimum number of elements held
+         */
+        LockFreeRingBuffer (IN Natural capacity = 0)
+            : _elementList{},
+              _indexMask{0},
+              _producerState{},
+              _consumerState{}
+        {
+            setCapacity(capacity);
+        }
+
+        /*--------------------*/
+
+        LockFreeRingBuffer (IN LockFreeRingBuffer&) = delete;
+
+        /*--------------------*/
+
+        LockFreeRingBuffer& operator= (IN LockFreeRingBuffer&) = delete;
+
+        /*--------------------*/
+
+        /**
+         * Returns string representation of ring buffer.
+         *
+         * @return  string representation
+         */
+        String toString () const
+        {
+            using STR = BaseModules::StringUtil;
+            const String st =
+                STR::expand("capacity = %1, writeCounter = %2,"
+                            " readCounter = %3",
+                            TOSTRING(capacity()),
+                            TOSTRING(Natural{_producerState.counter
+                                             .load()}),
+                            TOSTRING(Natural{_consumerState.counter
+                                             .load()}));
+            return STR::expand("LockFreeRingBuffer(%1)", st);
+        }
+
+        /*--------------------*/
+        /* configuration      */
+        /*--------------------*/
+
+        /**
+         * Sets the capacity of the ring buffer to at least
+         * <C>capacity</C> elements (rounded up to a power of two) and
+         * empties it; must not be called while another thread uses
+         * the buffer.
+         *
+         * @param[in] capacity  minimum number of elements held
+         */
+        void setCapacity (IN Natural capacity)
+        {
+            size_t effectiveCapacity = 1;
+
+            while (effectiveCapacity < (size_t) capacity) {
+                effectiveCapacity *= 2;
+            }
+
+            _elementList.setLength(Natural{effectiveCapacity});
+            _indexMask = effectiveCapacity - 1;
+            clear();
+        }
+
+        /*--------------------*/
+
+        /**
+         * Empties the ring buffer; must not be called while another
+         * thread uses the buffer.
+         */
+        void clear ()
+        {
+            _producerState.counter.store(0);
+            _producerState.cachedCounter = 0;
+            _consumerState.counter.store(0);
+            _consumerState.cachedCounter = 0;
+        }
+
+        /*--------------------*/
+        /* queries            */
+        /*--------------------*/
+
+        /**
+         * Returns the number of elements the ring buffer can hold.
+         *
+         * @return  capacity of ring buffer
+         */
+        Natural capacity () const
+        {
+            return Natural{_indexMask + 1};
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of elements currently in the ring
+         * buffer; this is only a snapshot when called while the
+         * other thread is active.
+         *
+         * @return  fill level of ring buffer
+         */
+        Natural length () const
+        {
+            const size_t writeCounter =
+                _producerState.counter.load(std::memory_order_acquire);
+            const size_t readCounter =
+                _consumerState.counter.load(std::memory_order_acquire);
+            return Natural{writeCounter - readCounter};
+        }
+
+        /*--------------------*/
+        /* producer side      */
+        /*--------------------*/
+
+        /**
+         * Returns the number of elements that can be pushed without
+         * loss; for the producer this is a lower bound.
+         *
+         * @return  number of free slots
+         */
+        Natural writableCount ()
+        {
+            const size_t writeCounter =
+                _producerState.counter.load(std::memory_order_relaxed);
+            _producerState.cachedCounter =
+                _consumerState.counter.load(std::memory_order_acquire);
+            return Natural{_indexMask + 1
+                           - (writeCounter
+                              - _producerState.cachedCounter)};
+        }
+
+        /*--------------------*/
+
+        /**
+         * Appends <C>element</C> to the ring buffer and tells whether
+         * there has been space for it.
+         *
+         * @param[in] element  element to be appended
+         * @return  information whether element has been appended
+         */
+        Boolean push (IN T& element)
+        {
+            return (push(&element, 1) == 1);
+        }
+
+        /*--------------------*/
+
+        /**
+         * Appends up to <C>count</C> elements from
+         * <C>elementArray</C> to the ring buffer (by at most two
+         * block copies around the wrap point) and returns the number
+         * of elements appended, which is less than <C>count</C> only
+         * when the buffer is full.
+         *
+         * @param[in] elementArray  array of elements to be appended
+         * @param[in] count         number of elements in array
+         * @return  number of elements appended
+         */
+        Natural push (IN T* elementArray, IN Natural count)
+        {
+            const size_t capacity = _indexMask + 1;
+            const size_t writeCounter =
+                _producerState.counter.load(std::memory_order_relaxed);
+            size_t freeCount =
+                capacity - (writeCounter - _producerState.cachedCounter);
+
+            /* the consumer counter is only read when the cached value
+               does not suffice */
+            if (freeCount < (size_t) count) {
+                _producerState.cachedCounter =
+                    _consumerState.counter
+                        .load(std::memory_order_acquire);
+                freeCount = (capacity
+                             - (writeCounter
+                                - _producerState.cachedCounter));
+            }
+
+            const size_t transferCount =
+                std::min(freeCount, (size_t) count);
+            const size_t startIndex = writeCounter & _indexMask;
+            const size_t firstPartCount =
+                std::min(transferCount, capacity - startIndex);
+            T* slotArray = _elementList.asArray();
+            std::copy(elementArray, elementArray + firstPartCount,
+                      slotArray + startIndex);
+            std::copy(elementArray + firstPartCount,
+                      elementArray + transferCount, slotArray);
+            _producerState.counter.store(writeCounter + transferCount,
+                                         std::memory_order_release);
+            return Natural{transferCount};
+        }
+
+        /*--------------------*/
+        /* consumer side      */
+        /*--------------------*/
+
+        /**
+         * Returns the number of elements available for popping; for
+         * the consumer this is a lower bound.
+         *
+         * @return  number of readable elements
+         */
+        Natural readableCount ()
+        {
+            const size_t readCounter =
+                _consumerState.counter.load(std::memory_order_relaxed);
+            _consumerState.cachedCounter =
+                _producerState.counter.load(std::memory_order_acquire);
+            return Natural{_consumerState.cachedCounter - readCounter};
+        }
+
+        /*--------------------*/
+
+        /**
+         * Removes the first element of the ring buffer into
+         * <C>element</C> and tells whether there has been one.
+         *
+         * @param[out] element  element removed
+         * @return  information whether an element has been removed
+         */
+        Boolean pop (OUT T& element)
+        {
+            return (pop(&element, 1) == 1);
+        }
+
+        /*--------------------*/
+
+        /**
+         * Removes up to <C>count</C> elements from the front of the
+         * ring buffer into <C>elementArray</C> (by at most two block
+         * copies around the wrap point) and returns the number of
+         * elements removed, which is less than <C>count</C> only when
+         * the buffer has become empty.
+         *
+         * @param[out] elementArray  array of elements removed
+         * @param[in]  count         maximum number of elements
+         * @return  number of elements removed
+         */
+        Natural pop (OUT T* elementArray, IN Natural count)
+        {
+            const size_t capacity = _indexMask + 1;
+            const size_t readCounter =
+                _consumerState.counter.load(std::memory_order_relaxed);
+            size_t availableCount =
+                _consumerState.cachedCounter - readCounter;
+
+            /* the producer counter is only read when the cached value
+               does not suffice */
+            if (availableCount < (size_t) count) {
+                _consumerState.cachedCounter =
+                    _producerState.counter
+                        .load(std::memory_order_acquire);
+                availableCount =
+                    _consumerState.cachedCounter - readCounter;
+            }
+
+            const size_t transferCount =
+                std::min(availableCount, (size_t) count);
+            const size_t startIndex = readCounter & _indexMask;
+            const size_t firstPartCount =
+                std::min(transferCount, capacity - startIndex);
+            const T* slotArray = _elementList.asArray();
+            std::copy(slotArray + startIndex,
+                      slotArray + startIndex + firstPartCount,
+                      elementArray);
+            std::copy(slotArray, slotArray + transferCount - firstPartCount,
+                      elementArray + firstPartCount);
+            _consumerState.counter.store(readCounter + transferCount,
+                                         std::memory_order_release);
+            return Natural{transferCount};
+        }
+
+        /*--------------------*/
+
+        /**
+         * Removes up to <C>count</C> elements from the front of the
+         * ring buffer without copying them and returns the number of
+         * elements removed.
+         *
+         * @param[in] count  maximum number of elements
+         * @return  number of elements removed
+         */
+        Natural skip (IN Natural count)
+        {
+            const size_t readCounter =
+                _consumerState.counter.load(std::memory_order_relaxed);
+            const size_t transferCount =
+                std::min((size_t) readableCount(), (size_t) count);
+            _consumerState.counter.store(readCounter + transferCount,
+                                         std::memory_order_release);
+            return Natural{transferCount};
+        }
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /**
+             * The counter of one side on a separate cache line
+             * together with the last value read from the counter of
+             * the other side
+             */
+            struct alignas(64) _SideState {
+
+                /** the number of elements transferred by this side
+                 * (free-running, published to the other side) */
+                std::atomic<size_t> counter;
+
+                /** the last value read from the counter of the other
+                 * side (only used by this side) */
+                size_t cachedCounter;
+
+                /*--------------------*/
+
+                /**
+                 * Makes side state with zero counters.
+                 */
+                _SideState ()
+                    : counter{0},
+                      cachedCounter{0}
+                {
+                }
+
+            };
+
+            /*--------------------*/
+
+            /** the element slots (a power of two) */
+            GenericList<T> _elementList;
+
+            /** the mask for the slot index (capacity minus one) */
+            size_t _indexMask;
+
+            /** the write counter and cached read counter owned by
+             * the producer */
+            _SideState _producerState;
+
+            /** the read counter and cached write counter owned by
+             * the consumer */
+            _SideState _consumerState;
+
+    };
+
+}
@@ -0,0 +1,250 @@
+/**
+ * @file
+ * The <C>ModulatedDelayLine</C> body implements a delay line for a
+ * single channel with a time-varying, fractional delay as used by
+ * modulation effects.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-02
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "ModulatedDelayLine.h"
+
+#include "AlignedAllocator.h"
+#include "Assertion.h"
+#include "AudioSample.h"
+#include "DenormalGuard.h"
+#include "GenericList.h"
+#include "Logging.h"
+
+/*--------------------*/
+
+using Audio::DelayLineSample;
+using Audio::DenormalGuard;
+using Audio::ModulatedDelayLine;
+using BaseTypes::GenericTypes::AlignedAllocator;
+using BaseTypes::GenericTypes::GenericList;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
+
+/*====================*/
+
+namespace Audio {
+
+    /**
+     * A <C>_DelayLineDescriptor</C> object holds the samples of a
+     * delay line in an array with a power of two capacity and the
+     * position of the next sample to be written.
+     */
+    struct _DelayLineDescriptor {
+
+        /** the stored samples (aligned to a cache line) */
+        GenericList<DelayLineSample, nullptr, nullptr,
+                    AlignedAllocator<DelayLineSample>> sampleList;
+
+        /** the bit mask for wrapping positions (capacity minus
+         * one) */
+        size_t indexMask;
+
+        /** the position of the next sample to be written */
+        size_t writeIndex;
+
+        /** the maximum delay in samples */
+        Natural maximumDelay;
+
+        /*--------------------*/
+
+        /**
+         * Returns descriptor string representation.
+         *
+         * @return  string representation of descriptor
+         */
+        String toString () const
+        {
+            return STR::expand("capacity = %1, writeIndex = %2,"
+                               " maximumDelay = %3",
+                               TOSTRING(Natural{indexMask + 1}),
+                               TOSTRING(Natural{writeIndex}),
+                               TOSTRING(maximumDelay));
+        }
+
+    };
+
+}
+
+/*============================================================*/
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+ModulatedDelayLine::ModulatedDelayLine ()
+{
+    Logging_trace(">>");
+
+    _DelayLineDescriptor* descriptor = new _DelayLineDescriptor();
+    _descriptor = descriptor;
+    descriptor->indexMask    = 0;
+    descriptor->writeIndex   = 0;
+    descriptor->maximumDelay = 0;
+    setMaximumDelay(1);
+
+    Logging_trace1("<<: %1", toString());
+}
+
+/*--------------------*/
+
+ModulatedDelayLine::~ModulatedDelayLine ()
+{
+    Logging_trace(">>");
+    delete (_DelayLineDescriptor*) _descriptor;
+    Logging_trace("<<");
+}
+
+/*-----------------------*/
+/* string representation */
+/*-----------------------*/
+
+String ModulatedDelayLine::toString () const
+{
+    _DelayLineDescriptor& descriptor =
+        TOREFERENCE<_DelayLineDescriptor>(_descriptor);
+    return STR::expand("ModulatedDelayLine(%1)", descriptor.toString());
+}
+
+/*--------------------*/
+/* property access    */
+/*--------------------*/
+
+Natural ModulatedDelayLine::maximumDelay () const
+{
+    _DelayLineDescriptor& descriptor =
+        TOREFERENCE<_DelayLineDescriptor>(_descriptor);
+    return descriptor.maximumDelay;
+}
+
+/*--------------------*/
+
+Natural ModulatedDelayLine::byteCount () const
+{
+    _DelayLineDescriptor& descriptor =
+        TOREFERENCE<_DelayLineDescriptor>(_descriptor);
+    return Natural{sizeof(_DelayLineDescriptor)
+                   + (descriptor.sampleList.capacity()
+                      * sizeof(DelayLineSample))};
+}
+
+/*--------------------*/
+
+void ModulatedDelayLine::setMaximumDelay (IN Natural sampleCount)
+{
+    Logging_trace1(">>: %1", TOSTRING(sampleCount));
+    Assertion_pre(sampleCount > 0, "maximum delay must be positive");
+
+    _DelayLineDescriptor& descriptor =
+        TOREFERENCE<_DelayLineDescriptor>(_descriptor);
+
+    /* an interpolated read at the maximum delay also touches the
+       sample before, hence the capacity must exceed the delay */
+    size_t capacity = 1;
+
+    while (capacity <= (size_t) sampleCount) {
+        capacity *= 2;
+    }
+
+    if (capacity > descriptor.indexMask + 1) {
+        descriptor.sampleList.setLength(capacity);
+        descriptor.indexMask = capacity - 1;
+    }
+
+    descriptor.maximumDelay = sampleCount;
+    clear();
+
+    Logging_trace1("<<: %1", toString());
+}
+
+/*--------------------*/
+/* processing         */
+/*--------------------*/
+
+void ModulatedDelayLine::clear ()
+{
+    _DelayLineDescriptor& descriptor =
+        TOREFERENCE<_DelayLineDescriptor>(_descriptor);
+    DelayLineSample* sampleArray = descriptor.sampleList.asArray();
+    const size_t capacity = descriptor.indexMask + 1;
+
+    for (size_t i = 0;  i < capacity;  i++) {
+        sampleArray[i] = 0;
+    }
+
+    descriptor.writeIndex = 0;
+}
+
+/*--------------------*/
+
+void ModulatedDelayLine::applyFeedbackComb (INOUT double* sampleArray,
+                                            IN double* delayArray,
+                                            IN Natural count,
+                                            IN double feedback)
+{
+    _DelayLineDescriptor& descriptor =
+        TOREFERENCE<_DelayLineDescriptor>(_descriptor);
+    DelayLineSample* lineArray = descriptor.sampleList.asArray();
+    const size_t indexMask = descriptor.indexMask;
+    size_t writeIndex = descriptor.writeIndex;
+
+    for (size_t i = 0;  i < (size_t) count;  i++) {
+        /* the sample written k steps ago is at writeIndex - k, a
+           fractional part interpolates towards the older one */
+        const double delay = delayArray[i];
+        const size_t k = (size_t) delay;
+        const double fPart = delay - (double) k;
+        const size_t indexA = (writeIndex - k) & indexMask;
+        const size_t indexB = (indexA - 1) & indexMask;
+        const double delayedSample =
+            ((double) lineArray[indexA] * (1.0 - fPart)
+             + (double) lineArray[indexB] * fPart);
+        const double result = sampleArray[i] + delayedSample * feedback;
+        lineArray[writeIndex] =
+            (DelayLineSample) DenormalGuard::flushed(result);
+        sampleArray[i] = result;
+        writeIndex = (writeIndex + 1) & indexMask;
+    }
+
+    descriptor.writeIndex = writeIndex;
+}
+
+/*--------------------*/
+/* state transfer     */
+/*--------------------*/
+
+void ModulatedDelayLine::saveState (INOUT DspStateStream& stream) const
+{
+    const _DelayLineDescriptor& descriptor =
+        TOREFERENCE<_DelayLineDescriptor>(_descriptor);
+    stream.write(descriptor.writeIndex);
+    stream.writeArray(descriptor.sampleList.asArray(),
+                      Natural{descriptor.indexMask + 1});
+}
+
+/*--------------------*/
+
+void ModulatedDelayLine::restoreState (INOUT DspStateStream& stream)
+{
+    _DelayLineDescriptor& descriptor =
+        TOREFERENCE<_DelayLineDescriptor>(_descriptor);
+    size_t writeIndex = 0;
+    stream.read(writeIndex);
+    stream.readArray(descriptor.sampleList.asArray(),
+                     Natural{descriptor.indexMask + 1});
+
+    if (stream.isOkay()) {
+        descriptor.writeIndex = writeIndex & descriptor.indexMask;
+    }
+}
@@ -0,0 +1,176 @@
+/**
+ * @file
+ * The <C>ModulatedDelayLine</C> specification defines a delay line
+ * for a single channel with a time-varying, fractional delay as
+ * used by modulation effects.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-02
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "DspStateStream.h"
+#include "MyString.h"
+#include "Natural.h"
+#include "Object.h"
+
+/*--------------------*/
+
+using BaseTypes::Primitives::Natural;
+using BaseTypes::Primitives::Object;
+using BaseTypes::Primitives::String;
+
+/*====================*/
+
+namespace Audio {
+
+    /**
+     * A <C>ModulatedDelayLine</C> object stores the recent samples
+     * of a single channel and reads them back with a delay given
+     * per sample in samples, where fractional delays are linearly
+     * interpolated between the neighbouring samples.  An integral
+     * delay returns the stored sample exactly.
+     *
+     * The storage capacity is a power of two, hence positions are
+     * wrapped by a bit mask instead of a modulus calculation; the
+     * samples are processed in blocks on plain double arrays, but
+     * stored as <C>DelayLineSample</C> (possibly a float).
+     */
+    struct ModulatedDelayLine {
+
+        /*--------------------*/
+        /* con-/destruction   */
+        /*--------------------*/
+
+        /**
+         * Makes delay line with a maximum delay of one sample.
+         */
+        ModulatedDelayLine ();
+
+        /*--------------------*/
+
+        /**
+         * Destroys delay line.
+         */
+        ~ModulatedDelayLine ();
+
+        /*--------------------*/
+
+        ModulatedDelayLine (IN ModulatedDelayLine&) = delete;
+
+        /*-----------------------*/
+        /* string representation */
+        /*-----------------------*/
+
+        /**
+         * Returns string representation of delay line
+         *
+         * @return string representation
+         */
+        String toString () const;
+
+        /*--------------------*/
+        /* property access    */
+        /*--------------------*/
+
+        /**
+         * Returns the maximum delay in samples.
+         *
+         * @return  maximum delay
+         */
+        Natural maximumDelay () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of bytes allocated on the heap by the
+         * delay line (including its descriptor).
+         *
+         * @return  count of owned bytes
+         */
+        Natural byteCount () const;
+
+        /*--------------------*/
+
+        /**
+         * Sets the maximum delay to <C>sampleCount</C> samples and
+         * clears the line; the storage is only reallocated when its
+         * capacity does not suffice, hence this does not allocate
+         * for a maximum delay not exceeding an earlier one.
+         *
+         * @param[in] sampleCount  new maximum delay in samples (at
+         *                         least one)
+         */
+        void setMaximumDelay (IN Natural sampleCount);
+
+        /*--------------------*/
+        /* processing         */
+        /*--------------------*/
+
+        /**
+         * Sets all stored samples to zero.
+         */
+        void clear ();
+
+        /*--------------------*/
+
+        /**
+         * Runs a feedback comb on the <C>count</C> samples in
+         * <C>sampleArray</C>: each sample is replaced by itself plus
+         * <C>feedback</C> times the result from <C>delayArray[i]</C>
+         * samples ago and this result is stored in the line; the
+         * delays must lie in [1, <C>maximumDelay()</C>].
+         *
+         * @param[inout] sampleArray  the samples to be processed
+         * @param[in]    delayArray   the delays in samples per sample
+         * @param[in]    count        the number of samples
+         * @param[in]    feedback     the factor for the delayed
+         *                            result
+         */
+        void applyFeedbackComb (INOUT double* sampleArray,
+                                IN double* delayArray,
+                                IN Natural count,
+                                IN double feedback);
+
+        /*--------------------*/
+        /* state transfer     */
+        /*--------------------*/
+
+        /**
+         * Appends the stored samples and the write position to
+         * <C>stream</C>.
+         *
+         * @param[inout] stream  state stream to be written
+         */
+        void saveState (INOUT DspStateStream& stream) const;
+
+        /*--------------------*/
+
+        /**
+         * Reads the stored samples and the write position from
+         * <C>stream</C>; the stream becomes invalid when the stored
+         * capacity differs from the current one.
+         *
+         * @param[inout] stream  state stream to be read
+         */
+        void restoreState (INOUT DspStateStream& stream);
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the internal data of the delay line (private
+             * type) */
+            Object _descriptor;
+
+    };
+
+}
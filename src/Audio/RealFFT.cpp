@@ -0,0 +1,342 @@
+/**
+ * @file
+ * The <C>RealFFT</C> body implements a fast Fourier transform of real
+ * sample sequences with a power of two length.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "RealFFT.h"
+
+#include <cmath>
+#include "GenericList.h"
+#include "Logging.h"
+#include "Real.h"
+
+/*--------------------*/
+
+using Audio::RealFFT;
+using BaseTypes::GenericTypes::GenericList;
+using BaseTypes::Primitives::Real;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
+
+/*====================*/
+
+namespace Audio {
+
+    /**
+     * A <C>_FFTDescriptor</C> object holds the tables and the work
+     * buffer of a real transform of length <C>n</C> done by a
+     * complex transform of length <C>m = n/2</C>.
+     */
+    struct _FFTDescriptor {
+
+        /** the length of the real sequences */
+        size_t length;
+
+        /** the length of the complex transform (half of length) */
+        size_t halfLength;
+
+        /** the cosines of <C>2 pi k / n</C> for <C>k</C> from 0 to
+         * <C>m</C> */
+        GenericList<double> cosineList;
+
+        /** the sines of <C>2 pi k / n</C> for <C>k</C> from 0 to
+         * <C>m</C> */
+        GenericList<double> sineList;
+
+        /** the bit reversed index for each complex index */
+        GenericList<size_t> bitReversalList;
+
+        /** the complex sequence of half length with interleaved
+         * real and imaginary parts */
+        GenericList<double> workList;
+
+        /*--------------------*/
+
+        /**
+         * Returns string representation of descriptor.
+         *
+         * @return string representation
+         */
+        String toString () const
+        {
+            return STR::expand("length = %1",
+                               TOSTRING(Natural{length}));
+        }
+
+        /*--------------------*/
+
+        /**
+         * Sets up the tables for real sequences of
+         * <C>newLength</C> samples.
+         *
+         * @param[in] newLength  the sequence length (a power of two
+         *                       and at least 4)
+         */
+        void setup (IN size_t newLength)
+        {
+            length     = newLength;
+            halfLength = newLength / 2;
+            const double angleFactor =
+                2.0 * (double) Real::pi / (double) length;
+            cosineList.setLength(Natural{halfLength + 1});
+            sineList.setLength(Natural{halfLength + 1});
+
+            for (size_t k = 0;  k <= halfLength;  k++) {
+                const double angle = angleFactor * (double) k;
+                cosineList[Natural{k}] = std::cos(angle);
+                sineList[Natural{k}]   = std::sin(angle);
+            }
+
+            size_t bitCount = 0;
+
+            while (((size_t) 1 << bitCount) < halfLength) {
+                bitCount++;
+            }
+
+            bitReversalList.setLength(Natural{halfLength});
+
+            for (size_t i = 0;  i < halfLength;  i++) {
+                size_t reversedIndex = 0;
+
+                for (size_t bit = 0;  bit < bitCount;  bit++) {
+                    reversedIndex |= ((i >> bit) & 1) << (bitCount - 1 - bit);
+                }
+
+                bitReversalList[Natural{i}] = reversedIndex;
+            }
+
+            workList.setLength(Natural{length});
+        }
+
+        /*--------------------*/
+
+        /**
+         * Transforms the complex sequence in the work buffer in
+         * place (forward with negative exponent when
+         * <C>isInverse</C> is not set, otherwise unscaled with
+         * positive exponent).
+         *
+         * @param[in] isInverse  tells whether the exponent is
+         *                       positive
+         */
+        void transform (IN bool isInverse)
+        {
+            double* data = workList.asArray();
+            const size_t* bitReversalArray = bitReversalList.asArray();
+            const double* cosineArray = cosineList.asArray();
+            const double* sineArray   = sineList.asArray();
+            const double sineSign = (isInverse ? 1.0 : -1.0);
+
+            for (size_t i = 0;  i < halfLength;  i++) {
+                const size_t j = bitReversalArray[i];
+
+                if (i < j) {
+                    std::swap(data[2 * i], data[2 * j]);
+                    std::swap(data[2 * i + 1], data[2 * j + 1]);
+                }
+            }
+
+            /* the twiddle factors of the complex transform of length
+               m are every other entry of the tables for length n */
+            for (size_t stageLength = 2;  stageLength <= halfLength;
+                 stageLength *= 2) {
+                const size_t halfStage = stageLength / 2;
+                const size_t tableStride = length / stageLength;
+
+                for (size_t start = 0;  start < halfLength;
+                     start += stageLength) {
+                    for (size_t j = 0;  j < halfStage;  j++) {
+                        const double wr = cosineArray[j * tableStride];
+                        const double wi =
+                            sineSign * sineArray[j * tableStride];
+                        double* a = data + 2 * (start + j);
+                        double* b = a + 2 * halfStage;
+                        const double vr = b[0] * wr - b[1] * wi;
+                        const double vi = b[0] * wi + b[1] * wr;
+                        b[0] = a[0] - vr;
+                        b[1] = a[1] - vi;
+                        a[0] += vr;
+                        a[1] += vi;
+                    }
+                }
+            }
+        }
+
+    };
+
+}
+
+/*============================================================*/
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+RealFFT::RealFFT (IN Natural length)
+{
+    Logging_trace1(">>: %1", TOSTRING(length));
+
+    _FFTDescriptor* descriptor = new _FFTDescriptor();
+    _descriptor = descriptor;
+    descriptor->setup((size_t) length);
+
+    Logging_trace1("<<: %1", toString());
+}
+
+/*--------------------*/
+
+RealFFT::~RealFFT ()
+{
+    Logging_trace(">>");
+    delete (_FFTDescriptor*) _descriptor;
+    Logging_trace("<<");
+}
+
+/*-----------------------*/
+/* string representation */
+/*-----------------------*/
+
+String RealFFT::toString () const
+{
+    _FFTDescriptor& descriptor =
+        TOREFERENCE<_FFTDescriptor>(_descriptor);
+    return STR::expand("RealFFT(%1)", descriptor.toString());
+}
+
+/*--------------------*/
+/* property access    */
+/*--------------------*/
+
+Natural RealFFT::length () const
+{
+    _FFTDescriptor& descriptor =
+        TOREFERENCE<_FFTDescriptor>(_descriptor);
+    return Natural{descriptor.length};
+}
+
+/*--------------------*/
+
+void RealFFT::setLength (IN Natural length)
+{
+    Logging_trace1(">>: %1", TOSTRING(length));
+
+    _FFTDescriptor& descriptor =
+        TOREFERENCE<_FFTDescriptor>(_descriptor);
+    descriptor.setup((size_t) length);
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+Natural RealFFT::byteCount () const
+{
+    const _FFTDescriptor& descriptor =
+        TOREFERENCE<_FFTDescriptor>(_descriptor);
+    return Natural{sizeof(_FFTDescriptor)
+                   + ((descriptor.cosineList.capacity()
+                       + descriptor.sineList.capacity()
+                       + descriptor.workList.capacity())
+                      * sizeof(double))
+                   + (descriptor.bitReversalList.capacity()
+                      * sizeof(size_t))};
+}
+
+/*--------------------*/
+/* transformation     */
+/*--------------------*/
+
+void RealFFT::forward (IN double* timeArray,
+                       OUT double* spectrumArray)
+{
+    _FFTDescriptor& descriptor =
+        TOREFERENCE<_FFTDescriptor>(_descriptor);
+    const size_t m = descriptor.halfLength;
+    double* z = descriptor.workList.asArray();
+    const double* cosineArray = descriptor.cosineList.asArray();
+    const double* sineArray   = descriptor.sineList.asArray();
+
+    /* the even and odd samples are the real and imaginary parts
+       of the complex sequence */
+    for (size_t i = 0;  i < descriptor.length;  i++) {
+        z[i] = timeArray[i];
+    }
+
+    descriptor.transform(false);
+
+    /* split Z into the transforms E and O of the even and odd
+       samples: E[k] = (Z[k] + conj(Z[m-k])) / 2 and
+       O[k] = (Z[k] - conj(Z[m-k])) / 2i, then
+       X[k] = E[k] + exp(-2 pi i k / n) O[k] */
+    spectrumArray[0]         = z[0] + z[1];
+    spectrumArray[1]         = 0.0;
+    spectrumArray[2 * m]     = z[0] - z[1];
+    spectrumArray[2 * m + 1] = 0.0;
+
+    for (size_t k = 1;  k < m;  k++) {
+        const double ar = z[2 * k];
+        const double ai = z[2 * k + 1];
+        const double br = z[2 * (m - k)];
+        const double bi = -z[2 * (m - k) + 1];
+        const double evenRe = 0.5 * (ar + br);
+        const double evenIm = 0.5 * (ai + bi);
+        const double oddRe = 0.5 * (ai - bi);
+        const double oddIm = -0.5 * (ar - br);
+        const double wr = cosineArray[k];
+        const double wi = -sineArray[k];
+        spectrumArray[2 * k]     = evenRe + (oddRe * wr - oddIm * wi);
+        spectrumArray[2 * k + 1] = evenIm + (oddRe * wi + oddIm * wr);
+    }
+}
+
+/*--------------------*/
+
+void RealFFT::inverse (IN double* spectrumArray,
+                       OUT double* timeArray)
+{
+    _FFTDescriptor& descriptor =
+        TOREFERENCE<_FFTDescriptor>(_descriptor);
+    const size_t m = descriptor.halfLength;
+    double* z = descriptor.workList.asArray();
+    const double* cosineArray = descriptor.cosineList.asArray();
+    const double* sineArray   = descriptor.sineList.asArray();
+
+    /* combine the transforms of even and odd samples
+       E[k] = (X[k] + conj(X[m-k])) / 2 and
+       O[k] = (X[k] - conj(X[m-k])) / 2 * exp(2 pi i k / n) into
+       Z[k] = E[k] + i O[k] */
+    for (size_t k = 0;  k < m;  k++) {
+        const double ar = spectrumArray[2 * k];
+        const double ai = (k == 0 ? 0.0 : spectrumArray[2 * k + 1]);
+        const double br = spectrumArray[2 * (m - k)];
+        const double bi =
+            (k == 0 ? 0.0 : -spectrumArray[2 * (m - k) + 1]);
+        const double evenRe = 0.5 * (ar + br);
+        const double evenIm = 0.5 * (ai + bi);
+        const double dr = 0.5 * (ar - br);
+        const double di = 0.5 * (ai - bi);
+        const double wr = cosineArray[k];
+        const double wi = sineArray[k];
+        const double oddRe = dr * wr - di * wi;
+        const double oddIm = dr * wi + di * wr;
+        z[2 * k]     = evenRe - oddIm;
+        z[2 * k + 1] = evenIm + oddRe;
+    }
+
+    descriptor.transform(true);
+
+    const double scaleFactor = 1.0 / (double) m;
+
+    for (size_t i = 0;  i < descriptor.length;  i++) {
+        timeArray[i] = z[i] * scaleFactor;
+    }
+}
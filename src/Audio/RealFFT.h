@@ -0,0 +1,158 @@
+/**
+ * @file
+ * The <C>RealFFT</C> specification defines a fast Fourier transform
+ * of real sample sequences with a power of two length.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "MyString.h"
+#include "Natural.h"
+#include "Object.h"
+
+/*--------------------*/
+
+using BaseTypes::Primitives::Natural;
+using BaseTypes::Primitives::Object;
+using BaseTypes::Primitives::String;
+
+/*====================*/
+
+namespace Audio {
+
+    /**
+     * A <C>RealFFT</C> object transforms real sequences of a fixed
+     * power of two length <C>n</C> into their spectra and back.
+     * The real sequence is transformed as a complex sequence of
+     * half length (even samples as real and odd samples as
+     * imaginary parts) by an iterative radix-2 transform, which is
+     * then split into the spectrum of the real sequence.
+     *
+     * A spectrum consists of the <C>n/2 + 1</C> nonredundant
+     * complex bins from zero to the Nyquist frequency stored as
+     * interleaved real and imaginary parts, hence it takes
+     * <C>n + 2</C> doubles.  The forward transform is unscaled, the
+     * inverse transform scales by <C>1/n</C>, such that both
+     * together give the original sequence.
+     *
+     * All tables and the work buffer are allocated on construction,
+     * the transforms do not allocate; because of the work buffer an
+     * object must not be used by several threads at once.
+     */
+    struct RealFFT {
+
+        /*--------------------*/
+        /* con-/destruction   */
+        /*--------------------*/
+
+        /**
+         * Makes a transform for sequences of <C>length</C> samples.
+         *
+         * @param[in] length  the sequence length (a power of two
+         *                    and at least 4)
+         */
+        RealFFT (IN Natural length = 4);
+
+        /*--------------------*/
+
+        /**
+         * Destroys transform.
+         */
+        ~RealFFT ();
+
+        /*--------------------*/
+
+        RealFFT (IN RealFFT&) = delete;
+
+        /*-----------------------*/
+        /* string representation */
+        /*-----------------------*/
+
+        /**
+         * Returns string representation of transform.
+         *
+         * @return string representation
+         */
+        String toString () const;
+
+        /*--------------------*/
+        /* property access    */
+        /*--------------------*/
+
+        /**
+         * Returns the sequence length of the transform.
+         *
+         * @return  length of real sequences
+         */
+        Natural length () const;
+
+        /*--------------------*/
+
+        /**
+         * Sets the sequence length of the transform to
+         * <C>length</C>; this allocates the tables.
+         *
+         * @param[in] length  the sequence length (a power of two
+         *                    and at least 4)
+         */
+        void setLength (IN Natural length);
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of bytes allocated on the heap by the
+         * transform (including its descriptor).
+         *
+         * @return  count of owned bytes
+         */
+        Natural byteCount () const;
+
+        /*--------------------*/
+        /* transformation     */
+        /*--------------------*/
+
+        /**
+         * Transforms the <C>length()</C> samples in
+         * <C>timeArray</C> into the <C>length() + 2</C> doubles of
+         * their spectrum in <C>spectrumArray</C>.
+         *
+         * @param[in]  timeArray      the real sequence
+         * @param[out] spectrumArray  the spectrum of the sequence
+         */
+        void forward (IN double* timeArray,
+                      OUT double* spectrumArray);
+
+        /*--------------------*/
+
+        /**
+         * Transforms the spectrum in <C>spectrumArray</C> back into
+         * the <C>length()</C> samples of the real sequence in
+         * <C>timeArray</C>; the imaginary parts of the bins at zero
+         * and at the Nyquist frequency are ignored.
+         *
+         * @param[in]  spectrumArray  the spectrum of a sequence
+         * @param[out] timeArray      the real sequence
+         */
+        void inverse (IN double* spectrumArray,
+                      OUT double* timeArray);
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the internal data of the transform (private type) */
+            Object _descriptor;
+
+    };
+
+}
@@ -0,0 +1,196 @@
+/**
+ * @file
+ * The <C>SampleRateContext</C> body implements an immutable context
+ * per sample rate shared by all effect instances of a process with
+ * lazily created tables depending only on that rate.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SampleRateContext.h"
+
+#include "Assertion.h"
+#include "GenericList.h"
+#include "Logging.h"
+
+/*--------------------*/
+
+using Audio::SampleRateContext;
+using Audio::SampleRateContextPtr;
+using Audio::SampleRateTableKind;
+using BaseTypes::GenericTypes::GenericList;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
+
+/** a weak reference to a context in the registry */
+using _SampleRateContextReference = std::weak_ptr<const SampleRateContext>;
+
+/*====================*/
+
+/** the mutex serializing the access to the registry */
+static std::mutex _registryMutex;
+
+/** the registry of all contexts made so far; a context destroyed
+ * in the meantime leaves an expired entry, which is removed on the
+ * next request */
+static GenericList<_SampleRateContextReference> _registry;
+
+/*============================================================*/
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+SampleRateContext::SampleRateContext (IN Real sampleRate)
+    : _sampleRate{sampleRate}
+{
+    Logging_trace1(">>: %1", TOSTRING(sampleRate));
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+SampleRateContext::~SampleRateContext ()
+{
+    Logging_trace1(">>: %1", toString());
+
+    for (_TableSlot& slot : _tableSlotList) {
+        const SampleRateTableKind* kind =
+            slot.kind.load(std::memory_order_acquire);
+
+        if (kind != nullptr) {
+            kind->destroyTable(slot.table.load(std::memory_order_relaxed));
+        }
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+SampleRateContextPtr SampleRateContext::forSampleRate (IN Real sampleRate)
+{
+    Logging_trace1(">>: %1", TOSTRING(sampleRate));
+
+    const std::lock_guard<std::mutex> lock{_registryMutex};
+    SampleRateContextPtr result;
+    GenericList<_SampleRateContextReference> liveContextList;
+
+    /* the expired entries are dropped while searching */
+    for (const _SampleRateContextReference& reference : _registry) {
+        SampleRateContextPtr context = reference.lock();
+
+        if (context != nullptr) {
+            liveContextList.append(reference);
+
+            if (context->_sampleRate == sampleRate) {
+                result = context;
+            }
+        }
+    }
+
+    if (result == nullptr) {
+        result = SampleRateContextPtr{new SampleRateContext{sampleRate}};
+        liveContextList.append(result);
+    }
+
+    _registry.swap(liveContextList);
+
+    Logging_trace1("<<: %1", result->toString());
+    return result;
+}
+
+/*-----------------------*/
+/* string representation */
+/*-----------------------*/
+
+String SampleRateContext::toString () const
+{
+    Natural tableCount = 0;
+
+    for (const _TableSlot& slot : _tableSlotList) {
+        if (slot.kind.load(std::memory_order_acquire) != nullptr) {
+            tableCount++;
+        }
+    }
+
+    return STR::expand("SampleRateContext(sampleRate = %1,"
+                       " tableCount = %2)",
+                       TOSTRING(_sampleRate), TOSTRING(tableCount));
+}
+
+/*--------------------*/
+/* queries            */
+/*--------------------*/
+
+Real SampleRateContext::sampleRate () const
+{
+    return _sampleRate;
+}
+
+/*--------------------*/
+
+Object SampleRateContext::table (IN SampleRateTableKind& kind) const
+{
+    Object result = nullptr;
+
+    /* the fast path only reads the published slots */
+    for (const _TableSlot& slot : _tableSlotList) {
+        if (result == nullptr
+            && slot.kind.load(std::memory_order_acquire) == &kind) {
+            result = slot.table.load(std::memory_order_relaxed);
+        }
+    }
+
+    if (result == nullptr) {
+        const std::lock_guard<std::mutex> lock{_tableMutex};
+        _TableSlot* freeSlot = nullptr;
+
+        /* another thread may have made the table in the
+           meantime */
+        for (_TableSlot& slot : _tableSlotList) {
+            const SampleRateTableKind* slotKind =
+                slot.kind.load(std::memory_order_acquire);
+
+            if (slotKind == &kind) {
+                result = slot.table.load(std::memory_order_relaxed);
+            } else if (slotKind == nullptr && freeSlot == nullptr) {
+                freeSlot = &slot;
+            }
+        }
+
+        if (result == nullptr) {
+            Assertion_check(freeSlot != nullptr,
+                            "too many table kinds in sample rate context");
+            Logging_trace2("--: making table %1 for %2",
+                           String{kind.name}, TOSTRING(_sampleRate));
+            result = kind.makeTable(_sampleRate);
+            freeSlot->table.store(result, std::memory_order_relaxed);
+            freeSlot->kind.store(&kind, std::memory_order_release);
+        }
+    }
+
+    return result;
+}
+
+/*--------------------*/
+
+Natural SampleRateContext::count ()
+{
+    const std::lock_guard<std::mutex> lock{_registryMutex};
+    Natural result = 0;
+
+    for (const _SampleRateContextReference& reference : _registry) {
+        if (!reference.expired()) {
+            result++;
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,219 @@
+/**
+ * @file
+ * The <C>SampleRateContext</C> specification defines an immutable
+ * context per sample rate shared by all effect instances of a
+ * process with lazily created tables depending only on that rate.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include "MyString.h"
+#include "Natural.h"
+#include "Object.h"
+#include "Real.h"
+
+/*--------------------*/
+
+using BaseTypes::Primitives::Natural;
+using BaseTypes::Primitives::Object;
+using BaseTypes::Primitives::Real;
+using BaseTypes::Primitives::String;
+
+/*====================*/
+
+namespace Audio {
+
+    struct SampleRateContext;
+
+    /**
+     * A <C>SampleRateContextPtr</C> is a counted reference to a
+     * shared sample rate context; the context lives as long as
+     * some instance refers to it.
+     */
+    using SampleRateContextPtr = std::shared_ptr<const SampleRateContext>;
+
+    /*--------------------*/
+
+    /**
+     * A <C>SampleRateTableKind</C> describes a kind of table
+     * depending only on the sample rate: how such a table is made
+     * for a sample rate and how it is destroyed.  A table kind is
+     * identified by its address, hence it must be a static object.
+     */
+    struct SampleRateTableKind {
+
+        /**
+         * A factory makes the table of this kind for
+         * <C>sampleRate</C> on the heap.
+         */
+        using Factory = Object (*) (IN Real sampleRate);
+
+        /*--------------------*/
+
+        /**
+         * A destructor destroys <C>table</C> made by the factory.
+         */
+        using Destructor = void (*) (INOUT Object table);
+
+        /*--------------------*/
+
+        /** the name of the table kind (for logging) */
+        const char* name;
+
+        /** the factory of tables of this kind */
+        Factory makeTable;
+
+        /** the destructor of tables of this kind */
+        Destructor destroyTable;
+
+    };
+
+    /*--------------------*/
+
+    /**
+     * A <C>SampleRateContext</C> object holds the data of a single
+     * sample rate shared by all effect instances in a process
+     * running at that rate: there is at most one context per
+     * distinct rate, it is made on first request and destroyed when
+     * the last instance has let go of it.  A context is immutable
+     * apart from its tables, which are made once on their first
+     * request; later requests of a table neither lock nor allocate,
+     * hence they may be done on the audio thread.  An instance
+     * should therefore request its tables once when it is prepared.
+     */
+    struct SampleRateContext {
+
+        /*--------------------*/
+        /* con-/destruction   */
+        /*--------------------*/
+
+        /**
+         * Returns the context for <C>sampleRate</C> shared by all
+         * instances of the process; makes it when there is none
+         * yet.  Locks the registry of contexts, hence must not be
+         * called on the audio thread.
+         *
+         * @param[in] sampleRate  the sample rate of the context
+         * @return  counted reference to shared context
+         */
+        static SampleRateContextPtr forSampleRate (IN Real sampleRate);
+
+        /*--------------------*/
+
+        /**
+         * Destroys context together with all its tables.
+         */
+        ~SampleRateContext ();
+
+        /*--------------------*/
+
+        SampleRateContext (IN SampleRateContext&) = delete;
+
+        /*--------------------*/
+
+        SampleRateContext& operator= (IN SampleRateContext&) = delete;
+
+        /*-----------------------*/
+        /* string representation */
+        /*-----------------------*/
+
+        /**
+         * Returns string representation of context.
+         *
+         * @return string representation
+         */
+        String toString () const;
+
+        /*--------------------*/
+        /* queries            */
+        /*--------------------*/
+
+        /**
+         * Returns the sample rate of context.
+         *
+         * @return  sample rate
+         */
+        Real sampleRate () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the table of <C>kind</C> for the sample rate of
+         * the context; it is made on the first request (locking the
+         * context), later requests only read an atomic pointer.
+         *
+         * @param[in] kind  the kind of table (a static object)
+         * @return  table of that kind
+         */
+        Object table (IN SampleRateTableKind& kind) const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of contexts currently alive in the
+         * process.
+         *
+         * @return  count of sample rate contexts
+         */
+        static Natural count ();
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the number of table slots per context (the maximum
+             * number of table kinds) */
+            static constexpr size_t _tableSlotCount = 8;
+
+            /*--------------------*/
+
+            /**
+             * A table slot holds a table together with its kind; the
+             * kind is published after the table.
+             */
+            struct _TableSlot {
+
+                /** the kind of the table (null for a free slot) */
+                std::atomic<const SampleRateTableKind*> kind{nullptr};
+
+                /** the table itself */
+                std::atomic<Object> table{nullptr};
+
+            };
+
+            /*--------------------*/
+
+            /**
+             * Makes context for <C>sampleRate</C> without any table.
+             *
+             * @param[in] sampleRate  the sample rate of the context
+             */
+            SampleRateContext (IN Real sampleRate);
+
+            /*--------------------*/
+
+            /** the sample rate of context */
+            const Real _sampleRate;
+
+            /** the mutex serializing the creation of tables */
+            mutable std::mutex _tableMutex;
+
+            /** the tables made so far */
+            mutable _TableSlot _tableSlotList[_tableSlotCount];
+
+    };
+
+}
@@ -0,0 +1,215 @@
+/**
+ * @file
+ * The <C>ScratchArena</C> body implements a per-thread preallocated
+ * memory area for temporary sample buffers of processing kernels
+ * with scoped mark and release.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "ScratchArena.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include "Assertion.h"
+#include "Logging.h"
+
+/*--------------------*/
+
+using Audio::ScratchArena;
+
+/*====================*/
+
+/** the maximum capacity in bytes announced by any component */
+static std::atomic<size_t> _announcedCapacity{0};
+
+/*--------------------*/
+
+/**
+ * Returns the first address in heap memory block <C>block</C>
+ * aligned to <C>ScratchArena::alignment</C>; the block must have
+ * that many additional bytes.
+ *
+ * @param[in] block  heap memory block
+ * @return  aligned start within block
+ */
+static std::byte* _alignedStart (IN std::byte* block)
+{
+    const uintptr_t alignment =
+        (uintptr_t) (size_t) ScratchArena::alignment;
+    const uintptr_t address = (uintptr_t) block;
+    const uintptr_t alignedAddress =
+        (address + alignment - 1) & ~(alignment - 1);
+    return (std::byte*) block + (alignedAddress - address);
+}
+
+/*============================================================*/
+
+const Natural ScratchArena::alignment = 64;
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+ScratchArena::ScratchArena ()
+    : _memory{},
+      _data{nullptr},
+      _capacity{0},
+      _position{0},
+      _maximumPosition{0},
+      _scopeDepth{0},
+      _overflowBufferList{}
+{
+}
+
+/*--------------------*/
+
+ScratchArena::~ScratchArena ()
+{
+    for (std::byte* block : _overflowBufferList) {
+        delete[] block;
+    }
+}
+
+/*--------------------*/
+/* class methods      */
+/*--------------------*/
+
+ScratchArena& ScratchArena::current ()
+{
+    static thread_local ScratchArena arena;
+    return arena;
+}
+
+/*--------------------*/
+
+void ScratchArena::announceCapacity (IN Natural byteCount)
+{
+    Logging_trace1(">>: %1", TOSTRING(byteCount));
+
+    const size_t requestedCapacity = (size_t) byteCount;
+    size_t capacity = _announcedCapacity.load();
+
+    while (capacity < requestedCapacity
+           && !_announcedCapacity.compare_exchange_weak(capacity,
+                                                        requestedCapacity)) {
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+size_t ScratchArena::_alignedByteCount (IN size_t byteCount)
+{
+    const size_t alignment = (size_t) ScratchArena::alignment;
+    return (byteCount + alignment - 1) / alignment * alignment;
+}
+
+/*--------------------*/
+/* property queries   */
+/*--------------------*/
+
+Natural ScratchArena::capacity () const
+{
+    return Natural{_capacity};
+}
+
+/*--------------------*/
+/* buffer handling    */
+/*--------------------*/
+
+Natural ScratchArena::mark () const
+{
+    return Natural{_position};
+}
+
+/*--------------------*/
+
+void ScratchArena::release (IN Natural mark)
+{
+    Assertion_pre((size_t) mark <= _position,
+                  "mark must not be after current position");
+    _position = (size_t) mark;
+}
+
+/*--------------------*/
+
+void* ScratchArena::allocateBytes (IN size_t byteCount)
+{
+    const size_t alignedByteCount = _alignedByteCount(byteCount);
+    const size_t newPosition = _position + alignedByteCount;
+    std::byte* result;
+
+    if (newPosition <= _capacity) {
+        result = _data + _position;
+    } else {
+        /* arena is exhausted: serve buffer from heap and remember
+           requirement for the next adjustment */
+        std::byte* block = new std::byte[alignedByteCount
+                                         + (size_t) alignment];
+        _overflowBufferList.append(block);
+        result = _alignedStart(block);
+    }
+
+    _position = newPosition;
+    _maximumPosition = std::max(_maximumPosition, newPosition);
+    return result;
+}
+
+/*--------------------*/
+
+void ScratchArena::_adjustCapacity ()
+{
+    const size_t requiredCapacity =
+        std::max(_announcedCapacity.load(std::memory_order_relaxed),
+                 _maximumPosition);
+
+    if (requiredCapacity > _capacity) {
+        _memory.reset(new std::byte[requiredCapacity
+                                    + (size_t) alignment]);
+        _data = _alignedStart(_memory.get());
+        _capacity = requiredCapacity;
+    }
+}
+
+/*============================================================*/
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+ScratchArena::Scope::Scope ()
+    : _arena{ScratchArena::current()},
+      _mark{0}
+{
+    if (_arena._scopeDepth == 0) {
+        _arena._adjustCapacity();
+    }
+
+    _arena._scopeDepth++;
+    _mark = _arena._position;
+}
+
+/*--------------------*/
+
+ScratchArena::Scope::~Scope ()
+{
+    _arena._position = _mark;
+    _arena._scopeDepth--;
+
+    if (_arena._scopeDepth == 0
+        && !_arena._overflowBufferList.isEmpty()) {
+        for (std::byte* block : _arena._overflowBufferList) {
+            delete[] block;
+        }
+
+        _arena._overflowBufferList.clear();
+    }
+}
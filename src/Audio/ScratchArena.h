@@ -0,0 +1,276 @@
+/**
+ * @file
+ * The <C>ScratchArena</C> specification defines a per-thread
+ * preallocated memory area for temporary sample buffers of
+ * processing kernels with scoped mark and release.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include <cstddef>
+#include <memory>
+#include "GenericList.h"
+#include "Natural.h"
+
+/*--------------------*/
+
+using BaseTypes::GenericTypes::GenericList;
+using BaseTypes::Primitives::Natural;
+
+/*====================*/
+
+namespace Audio {
+
+    /**
+     * A <C>ScratchArena</C> object is a contiguous memory area of a
+     * single thread from which processing kernels take temporary
+     * buffers by simply advancing a position; all buffers start at
+     * a multiple of <C>alignment</C> bytes (suitable for SIMD
+     * access).  Buffers are given back in bulk by resetting the
+     * position to a mark, typically via a <C>Scope</C> object around
+     * the processing of a chunk; scopes may be nested.
+     *
+     * Components announce their maximum requirement via
+     * <C>announceCapacity</C> when they are set up; the arena of a
+     * thread grows to the announced capacity on entry of its
+     * outermost scope, hence normally only once before the first
+     * processed block.  A requirement exceeding the capacity is
+     * served from the heap and remembered, so that the arena grows
+     * accordingly on the next entry of the outermost scope.
+     */
+    struct ScratchArena {
+
+        /** the alignment of all buffers in bytes */
+        static const Natural alignment;
+
+        /*--------------------*/
+
+        /**
+         * A <C>Scope</C> object marks the arena of the current
+         * thread on construction and releases all buffers taken
+         * afterwards on destruction.
+         */
+        struct Scope {
+
+            /**
+             * Marks arena of current thread; when this is the
+             * outermost scope, the arena is grown to the announced
+             * capacity before.
+             */
+            Scope ();
+
+            /*--------------------*/
+
+            /**
+             * Releases all buffers taken from the arena since
+             * construction.
+             */
+            ~Scope ();
+
+            /*--------------------*/
+
+            Scope (IN Scope&) = delete;
+
+            /*--------------------*/
+
+            /**
+             * Returns an uninitialized buffer for <C>count</C>
+             * elements of <C>ElementType</C> from the arena valid
+             * until the end of this scope.
+             *
+             * @tparam    ElementType  type of element
+             * @param[in] count        count of elements
+             * @return  aligned array for <C>count</C> elements
+             */
+            template<typename ElementType>
+            ElementType* allocate (IN Natural count)
+            {
+                const size_t byteCount =
+                    (size_t) count * sizeof(ElementType);
+                return (ElementType*) _arena.allocateBytes(byteCount);
+            }
+
+            /*--------------------*/
+            /*--------------------*/
+
+            private:
+
+                /** the arena of the current thread */
+                ScratchArena& _arena;
+
+                /** the position of the arena on construction */
+                size_t _mark;
+
+        };
+
+        /*--------------------*/
+        /* con-/destruction   */
+        /*--------------------*/
+
+        /**
+         * Makes an empty arena.
+         */
+        ScratchArena ();
+
+        /*--------------------*/
+
+        /**
+         * Destroys arena.
+         */
+        ~ScratchArena ();
+
+        /*--------------------*/
+
+        ScratchArena (IN ScratchArena&) = delete;
+
+        /*--------------------*/
+        /* class methods      */
+        /*--------------------*/
+
+        /**
+         * Returns the arena of the current thread.
+         *
+         * @return  arena of thread
+         */
+        static ScratchArena& current ();
+
+        /*--------------------*/
+
+        /**
+         * Announces that some component needs up to
+         * <C>byteCount</C> bytes of buffers (as given by
+         * <C>footprint</C>) at the same time; the arenas of all
+         * threads are sized by the maximum of all announcements.
+         * Should be called during setup and not on the audio thread.
+         *
+         * @param[in] byteCount  number of bytes needed
+         */
+        static void announceCapacity (IN Natural byteCount);
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of bytes occupied in an arena by a
+         * buffer for <C>count</C> elements of <C>ElementType</C>
+         * (including alignment padding).
+         *
+         * @tparam    ElementType  type of element
+         * @param[in] count        count of elements
+         * @return  number of bytes in arena
+         */
+        template<typename ElementType>
+        static Natural footprint (IN Natural count)
+        {
+            return _alignedByteCount((size_t) count * sizeof(ElementType));
+        }
+
+        /*--------------------*/
+        /* property queries   */
+        /*--------------------*/
+
+        /**
+         * Returns the current capacity of arena in bytes.
+         *
+         * @return  capacity of arena
+         */
+        Natural capacity () const;
+
+        /*--------------------*/
+        /* buffer handling    */
+        /*--------------------*/
+
+        /**
+         * Returns the current position in arena to be used for a
+         * later <C>release</C>.
+         *
+         * @return  mark of current position
+         */
+        Natural mark () const;
+
+        /*--------------------*/
+
+        /**
+         * Releases all buffers taken since <C>mark</C> has been
+         * returned by <C>mark()</C>.
+         *
+         * @param[in] mark  position in arena to be returned to
+         */
+        void release (IN Natural mark);
+
+        /*--------------------*/
+
+        /**
+         * Returns an uninitialized buffer with <C>byteCount</C>
+         * bytes aligned to <C>alignment</C>; it is valid until the
+         * next <C>release</C> before that buffer.
+         *
+         * @param[in] byteCount  number of bytes
+         * @return  aligned buffer
+         */
+        void* allocateBytes (IN size_t byteCount);
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the memory of the arena (with additional space for
+             * aligning its start) */
+            std::unique_ptr<std::byte[]> _memory;
+
+            /** the aligned start of the arena within memory */
+            std::byte* _data;
+
+            /** the usable length of the arena in bytes */
+            size_t _capacity;
+
+            /** the current position in the arena */
+            size_t _position;
+
+            /** the maximum position reached (including buffers
+             * served from the heap) */
+            size_t _maximumPosition;
+
+            /** the number of currently active scopes */
+            size_t _scopeDepth;
+
+            /** the buffers served from the heap because the arena
+             * was exhausted; freed when the outermost scope ends */
+            GenericList<std::byte*> _overflowBufferList;
+
+            /*--------------------*/
+
+            /**
+             * Returns <C>byteCount</C> rounded up to a multiple of
+             * the alignment.
+             *
+             * @param[in] byteCount  number of bytes
+             * @return  aligned number of bytes
+             */
+            static size_t _alignedByteCount (IN size_t byteCount);
+
+            /*--------------------*/
+
+            /**
+             * Grows arena to the announced capacity or the maximum
+             * position reached so far (when larger); must only be
+             * called when no buffer is in use.
+             */
+            void _adjustCapacity ();
+
+            /*--------------------*/
+
+            friend struct Scope;
+
+    };
+
+}
@@ -0,0 +1,266 @@
+/**
+ * @file
+ * The <C>StateVariableFilter</C> body implements a second order
+ * state variable filter in topology-preserving transform form.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "StateVariableFilter.h"
+
+#include <cmath>
+#include "DenormalGuard.h"
+#include "Logging.h"
+#include "SharedTableFile.h"
+
+/*--------------------*/
+
+using Audio::DenormalGuard;
+using Audio::StateVariableFilter;
+using Audio::StateVariableFilterState;
+using BaseModules::SharedTableFile;
+
+/*====================*/
+
+namespace Audio {
+
+    /** the number of table intervals from zero to the Nyquist
+     * frequency */
+    static const size_t _tangentTableLength = 4096;
+
+    /** the largest relative frequency accepted for the prewarping
+     * (the tangent has a pole at the Nyquist frequency) */
+    static const double _maximumRelativeFrequency = 0.49;
+
+    /** the version of the tangent table contents (to be increased
+     * when its calculation changes, because it may be shared via a
+     * file) */
+    static const Natural _tangentTableVersion = 1;
+
+    /*--------------------*/
+
+    /**
+     * Fills <C>data</C> with the table of <C>tan(pi * x)</C> for
+     * <C>x</C> from zero to one half in equidistant steps.
+     *
+     * @param[out] data  storage for the table
+     */
+    static void _fillTangentTable (OUT Object data)
+    {
+        double* table = (double*) data;
+        const double pi = (double) Real::pi;
+
+        for (size_t i = 0;  i < _tangentTableLength;  i++) {
+            const double x =
+                0.5 * (double) i / (double) _tangentTableLength;
+            table[i] = std::tan(pi * x);
+        }
+
+        /* the pole is never interpolated */
+        table[_tangentTableLength] = table[_tangentTableLength - 1];
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the table of tangents (see <C>_fillTangentTable</C>);
+     * it is calculated or mapped from a shared table file on the
+     * first call.
+     *
+     * @return  table of tangents
+     */
+    static const double* _tangentTable ()
+    {
+        alignas(64) static double localTable[_tangentTableLength + 1];
+        static const double* table =
+            (const double*) SharedTableFile::table("svfTangent",
+                                                   _tangentTableVersion,
+                                                   sizeof(localTable),
+                                                   _fillTangentTable,
+                                                   localTable);
+        return table;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies the filter with integrator coefficients <C>a1</C>,
+     * <C>a2</C> and <C>a3</C> and output mix <C>m0</C>, <C>m1</C>
+     * and <C>m2</C> to <C>count</C> samples in <C>inputArray</C>
+     * and writes the results into <C>outputArray</C> with
+     * integrator states in <C>state</C>.
+     *
+     * @tparam       SampleType   type of samples in arrays
+     * @param[in]    a1           integrator coefficient a1
+     * @param[in]    a2           integrator coefficient a2
+     * @param[in]    a3           integrator coefficient a3
+     * @param[in]    m0           factor of input in output
+     * @param[in]    m1           factor of bandpass in output
+     * @param[in]    m2           factor of lowpass in output
+     * @param[in]    inputArray   the array with the input samples
+     * @param[out]   outputArray  the array for the output samples
+     * @param[in]    count        the number of samples to process
+     * @param[inout] state        the filter state for the channel
+     */
+    template <typename SampleType>
+    static void _applyBlock (IN AudioSample a1,
+                             IN AudioSample a2,
+                             IN AudioSample a3,
+                             IN AudioSample m0,
+                             IN AudioSample m1,
+                             IN AudioSample m2,
+                             IN SampleType* inputArray,
+                             OUT SampleType* outputArray,
+                             IN Natural count,
+                             INOUT StateVariableFilterState& state)
+    {
+        const AudioSample two{2.0};
+        AudioSample ic1 = state.ic1;
+        AudioSample ic2 = state.ic2;
+        const SampleType* inputPtr = inputArray;
+        SampleType* outputPtr = outputArray;
+
+        for (Natural i = 0;  i < count;  i++) {
+            const AudioSample v0{*inputPtr++};
+            const AudioSample v3 = v0 - ic2;
+            const AudioSample v1 = a1 * ic1 + a2 * v3;
+            const AudioSample v2 = ic2 + a2 * ic1 + a3 * v3;
+            ic1 = DenormalGuard::flushed(two * v1 - ic1);
+            ic2 = DenormalGuard::flushed(two * v2 - ic2);
+            *outputPtr++ = (SampleType) (m0 * v0 + m1 * v1 + m2 * v2);
+        }
+
+        state.ic1 = ic1;
+        state.ic2 = ic2;
+    }
+
+}
+
+/*====================*/
+
+StateVariableFilterState::StateVariableFilterState ()
+    : ic1{0.0},
+      ic2{0.0}
+{
+}
+
+/*--------------------*/
+
+String StateVariableFilterState::toString() const
+{
+    String result = "StateVariableFilterState(";
+    result += "ic1 = " + TOSTRING(ic1);
+    result += ", ic2 = " + TOSTRING(ic2);
+    result += ")";
+
+    return result;
+}
+
+/*--------------------*/
+
+void StateVariableFilterState::clear ()
+{
+    ic1 = 0.0;
+    ic2 = 0.0;
+}
+
+/*====================*/
+
+StateVariableFilter::StateVariableFilter ()
+    : _a1{1.0},
+      _a2{0.0},
+      _a3{0.0},
+      _m0{0.0},
+      _m1{0.0},
+      _m2{0.0}
+{
+}
+
+/*--------------------*/
+
+String StateVariableFilter::toString() const
+{
+    String result = "StateVariableFilter(";
+    result += "a1 = " + TOSTRING(_a1);
+    result += ", a2 = " + TOSTRING(_a2);
+    result += ", a3 = " + TOSTRING(_a3);
+    result += ", m0 = " + TOSTRING(_m0);
+    result += ", m1 = " + TOSTRING(_m1);
+    result += ", m2 = " + TOSTRING(_m2);
+    result += ")";
+
+    return result;
+}
+
+/*--------------------*/
+
+Real StateVariableFilter::prewarpedFrequency (IN Real relativeFrequency)
+{
+    const double* table = _tangentTable();
+    double x = (double) relativeFrequency;
+    x = (x < 0.0 ? 0.0
+         : (x > _maximumRelativeFrequency ? _maximumRelativeFrequency
+            : x));
+
+    const double position = x * 2.0 * (double) _tangentTableLength;
+    const size_t index = (size_t) position;
+    const double fraction = position - (double) index;
+    return table[index] + fraction * (table[index + 1] - table[index]);
+}
+
+/*--------------------*/
+
+void StateVariableFilter::set (IN Real g, IN Real k,
+                               IN Real m0, IN Real m1, IN Real m2)
+{
+    Logging_traceHot2(">>: g = %1, k = %2", TOSTRING(g), TOSTRING(k));
+
+    _a1 = Real{1.0} / (Real{1.0} + g * (g + k));
+    _a2 = g * _a1;
+    _a3 = g * _a2;
+    _m0 = m0;
+    _m1 = m1;
+    _m2 = m2;
+
+    Logging_traceHot("<<");
+}
+
+/*--------------------*/
+
+void StateVariableFilter::scale (IN Real factor)
+{
+    Logging_trace1(">>: %1", TOSTRING(factor));
+    _m0 *= factor;
+    _m1 *= factor;
+    _m2 *= factor;
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void StateVariableFilter::applyBlock (IN AudioSample* inputArray,
+                                      OUT AudioSample* outputArray,
+                                      IN Natural count,
+                                      INOUT StateVariableFilterState& state)
+    const
+{
+    _applyBlock(_a1, _a2, _a3, _m0, _m1, _m2,
+                inputArray, outputArray, count, state);
+}
+
+/*--------------------*/
+
+void StateVariableFilter::applyBlock (IN float* inputArray,
+                                      OUT float* outputArray,
+                                      IN Natural count,
+                                      INOUT StateVariableFilterState& state)
+    const
+{
+    _applyBlock(_a1, _a2, _a3, _m0, _m1, _m2,
+                inputArray, outputArray, count, state);
+}
@@ -0,0 +1,202 @@
+/**
+ * @file
+ * The <C>StateVariableFilter</C> specification defines a second
+ * order state variable filter in topology-preserving transform
+ * form, which stays well-behaved under fast coefficient changes.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "AudioSample.h"
+#include "Natural.h"
+
+/*====================*/
+
+using Audio::AudioSample;
+using BaseTypes::Primitives::Natural;
+
+/*====================*/
+
+namespace Audio {
+
+    /**
+     * A <C>StateVariableFilterState</C> object holds the two
+     * integrator states of a state variable filter for a single
+     * channel.
+     */
+    struct StateVariableFilterState {
+
+        /** the state of the first (bandpass) integrator */
+        AudioSample ic1;
+
+        /** the state of the second (lowpass) integrator */
+        AudioSample ic2;
+
+        /*--------------------*/
+
+        /**
+         * Creates a cleared filter state
+         */
+        StateVariableFilterState ();
+
+        /*--------------------*/
+
+        /**
+         * Returns string representation of filter state.
+         *
+         * @return string representation
+         */
+        String toString() const;
+
+        /*--------------------*/
+
+        /**
+         * Resets both integrator states to zero
+         */
+        void clear ();
+
+    };
+
+    /*--------------------*/
+
+    /**
+     * A <C>StateVariableFilter</C> object is a second order filter
+     * built from two trapezoidal integrators (the topology-preserving
+     * transform of the analog state variable filter).  It is tuned
+     * by the prewarped cutoff <C>g = tan(pi * f / fs)</C> and the
+     * damping <C>k = 1/Q</C>; the output is a mix <C>m0 * input +
+     * m1 * bandpass + m2 * lowpass</C>, which gives all the RBJ
+     * filter kinds (lowpass, highpass, bandpass, notch, allpass,
+     * peaking and shelving) with identical responses.
+     *
+     * Unlike a biquad in direct form the state variables are
+     * physical quantities of the filter, hence the coefficients may
+     * change at any sample without instabilities or transients;
+     * and they are cheap to calculate from <C>g</C> and <C>k</C>
+     * (one division), where <C>prewarpedFrequency</C> provides
+     * <C>g</C> by a table lookup.  The filter only holds the
+     * coefficients, the integrator states are kept separately per
+     * channel in a <C>StateVariableFilterState</C>.
+     */
+    struct StateVariableFilter {
+
+        /**
+         * Creates a state variable filter as a null filter
+         */
+        StateVariableFilter ();
+
+        /*--------------------*/
+
+        /**
+         * Returns string representation of filter.
+         *
+         * @return string representation
+         */
+        String toString() const;
+
+        /*--------------------*/
+
+        /**
+         * Returns <C>tan(pi * relativeFrequency)</C> by linear
+         * interpolation in a table (with a relative error below
+         * 1E-4); <C>relativeFrequency</C> is the cutoff frequency
+         * divided by the sample rate and it is limited to the range
+         * from zero to slightly below the Nyquist frequency.
+         *
+         * @param[in] relativeFrequency  the cutoff frequency relative
+         *                               to the sample rate
+         * @return  the prewarped cutoff of the integrators
+         */
+        static Real prewarpedFrequency (IN Real relativeFrequency);
+
+        /*--------------------*/
+
+        /**
+         * Sets the coefficients of the filter for the prewarped
+         * cutoff <C>g</C>, the damping <C>k</C> and the output mix
+         * <C>m0</C>, <C>m1</C> and <C>m2</C> of input, bandpass and
+         * lowpass.
+         *
+         * @param[in] g   the prewarped cutoff of the integrators
+         * @param[in] k   the damping (inverse quality)
+         * @param[in] m0  the factor of the input in the output
+         * @param[in] m1  the factor of the bandpass in the output
+         * @param[in] m2  the factor of the lowpass in the output
+         */
+        void set (IN Real g, IN Real k,
+                  IN Real m0, IN Real m1, IN Real m2);
+
+        /*--------------------*/
+
+        /**
+         * Multiplies the output mix by <C>factor</C>, i.e. folds a
+         * constant gain applied after the filter into the filter
+         * itself
+         *
+         * @param[in] factor  the gain factor to be folded in
+         */
+        void scale (IN Real factor);
+
+        /*--------------------*/
+
+        /**
+         * Applies filter to <C>count</C> samples in
+         * <C>inputArray</C> and writes the results into
+         * <C>outputArray</C> with integrator states in
+         * <C>state</C>; input and output array may be identical for
+         * an in-place operation
+         *
+         * @param[in]    inputArray   the array with the input samples
+         * @param[out]   outputArray  the array for the output samples
+         * @param[in]    count        the number of samples to process
+         * @param[inout] state        the filter state for the channel
+         */
+        void applyBlock (IN AudioSample* inputArray,
+                         OUT AudioSample* outputArray,
+                         IN Natural count,
+                         INOUT StateVariableFilterState& state) const;
+
+        /*--------------------*/
+
+        /**
+         * Applies filter to <C>count</C> float samples in
+         * <C>inputArray</C> and writes the results into
+         * <C>outputArray</C> with integrator states in
+         * <C>state</C>; the filter is calculated in audio samples,
+         * only the sample storage is in float; input and output
+         * array may be identical for an in-place operation
+         *
+         * @param[in]    inputArray   the array with the input samples
+         * @param[out]   outputArray  the array for the output samples
+         * @param[in]    count        the number of samples to process
+         * @param[inout] state        the filter state for the channel
+         */
+        void applyBlock (IN float* inputArray,
+                         OUT float* outputArray,
+                         IN Natural count,
+                         INOUT StateVariableFilterState& state) const;
+
+        /*--------------------*/
+        /*--------------------*/
+
+        protected:
+
+            Real _a1; /**< integrator coefficient 1 / (1 + g(g + k)) */
+            Real _a2; /**< integrator coefficient g * a1 */
+            Real _a3; /**< integrator coefficient g * a2 */
+            Real _m0; /**< factor of the input in the output */
+            Real _m1; /**< factor of the bandpass in the output */
+            Real _m2; /**< factor of the lowpass in the output */
+
+    };
+
+}
@@ -17,23 +17,38 @@
 #include <cmath>
 #include "Assertion.h"
 #include "Logging.h"
+#include "SharedTableFile.h"
 
 /*--------------------*/
 
 using Audio::WaveForm;
+using Audio::WaveFormGenerator;
 using Audio::WaveFormIteratorState;
 using Audio::WaveFormKind;
+using BaseModules::SharedTableFile;
 
 /*============================================================*/
 
 namespace Audio {
 
-    /** <C>_WaveTable</C> is a local alias name for a real list */
-    using  _WaveTable = RealList;
+    /** the count of base points in the sine wave table */
+    static const size_t _sineWaveTableLength = 10000;
 
-    static Boolean _isInitialized = false;
-    static _WaveTable _sineWaveTable;
-    static _WaveTable _triangleWaveTable;
+    /** the count of base points in the triangle wave table: for a
+     * triangle wave with linear interpolation four equidistant
+     * sampling points are enough */
+    static const size_t _triangleWaveTableLength = 4;
+
+    /** the version of the sine wave table contents (to be increased
+     * when its calculation changes, because it may be shared via a
+     * file) */
+    static const Natural _sineWaveTableVersion = 1;
+
+    /** the number of rotator steps between renormalizations of the
+     * rotator length: the rounding errors of a step change the
+     * length by about 1E-16, hence this keeps it exact to machine
+     * precision */
+    static const size_t _rotatorNormalizationInterval = 64;
 
     /*--------------------*/
 
@@ -73,8 +88,15 @@ namespace Audio {
         /** the count of points in the waveform */
         Natural waveTableLength;
 
-        /** the data buffer for the waveform */
-        _WaveTable* buffer;
+        /** the shared read-only wave table for the waveform */
+        const double* waveTable;
+
+        /** the number of samples between exact evaluations when
+         * rendering (values up to one mean every sample) */
+        Natural controlInterval;
+
+        /** the generator of a sine wave form when rendering */
+        WaveFormGenerator generator;
     };
 
     /*--------------------*/
@@ -96,23 +118,24 @@ namespace Audio {
     /*--------------------*/
 
     /**
-     * Finds value in <C>waveTable</C> at real <C>position</C> by a linear
-     * interpolation
+     * Finds value in <C>waveTable</C> with <C>waveTableLength</C>
+     * entries at real <C>position</C> by a linear interpolation
      *
-     * @param[in] waveTable  the list of samples in wave form
-     * @param[in] position   the position in the wave form
+     * @param[in] waveTable        the samples in wave form
+     * @param[in] waveTableLength  the count of samples in wave form
+     * @param[in] position         the position in the wave form
      */
-    static Real _getWavetableValueAtPosition (IN _WaveTable* waveTable,
+    static Real _getWavetableValueAtPosition (IN double* waveTable,
+                                              IN Natural waveTableLength,
                                               IN Real position)
     {
-        const Natural waveTableLength = waveTable->length();
         Assertion_pre(position >= 0.0, "position must be non-negative");
         Assertion_pre(waveTableLength > 0, "wave table must be non-empty");
 
         const Natural indexA = (Natural) position % waveTableLength;
         const Natural indexB = (indexA + 1) % waveTableLength;
-        const Real valueA = waveTable->at(indexA);
-        const Real valueB = waveTable->at(indexB);
+        const Real valueA{waveTable[(size_t) indexA]};
+        const Real valueB{waveTable[(size_t) indexB]};
         const Real fPart = position.fractionalPart();
         const Real value = valueA * (Real{1.0} - fPart) + valueB * fPart;
         return value;
@@ -120,22 +143,35 @@ namespace Audio {
 
     /*--------------------*/
 
+    /**
+     * Returns string representation of <C>generator</C>.
+     *
+     * @param[in] generator  wave form generator
+     * @return string representation of generator
+     */
+    static String _waveFormGenerator (IN WaveFormGenerator generator)
+    {
+        return String(generator == WaveFormGenerator::table
+                      ? "table" : "rotator");
+    }
+
+    /*--------------------*/
+
     /**
      * Initializes <C>waveTable</C> to be of <C>kind</C> having
      * <C>length</C> base points, the range is [0, +1] for all wave forms
      *
-     * @param[inout] waveTable  the list of samples in wave form
-     * @param[in] kind          the wave form kind
-     * @param[in] length        the number of sampling points
+     * @param[out] waveTable  the array of samples in wave form
+     * @param[in]  kind       the wave form kind
+     * @param[in]  length     the number of sampling points
      */
-    static void _initializeWaveTable (INOUT _WaveTable& waveTable,
+    static void _initializeWaveTable (OUT double* waveTable,
                                       IN WaveFormKind kind,
                                       IN Natural length)
     {
         Logging_trace2(">>: kind = %1, length = %2",
                        _waveFormKind(kind), TOSTRING(length));
 
-        waveTable.setLength(length);
         const Real delta = Real::twoPi / (Real) length;
         const Real one{1.0};
         const Real two{2.0};
@@ -154,12 +190,104 @@ namespace Audio {
                      : (quadrant == 3 ? y - 1.5 : Real{1.5} - y));
             }
 
-            waveTable[i] = y;
+            waveTable[(size_t) i] = (double) y;
         }
+
+        Logging_trace("<<");
+    }
+
+    /*--------------------*/
+
+    /**
+     * Fills <C>data</C> with the base points of the sine wave.
+     *
+     * @param[out] data  storage for the sine wave table
+     */
+    static void _fillSineWaveTable (OUT Object data)
+    {
+        _initializeWaveTable((double*) data, WaveFormKind::sine,
+                             _sineWaveTableLength);
     }
 
     /*--------------------*/
 
+    /**
+     * A <C>_WaveTableRegistry</C> object holds the read-only wave
+     * tables for all wave form kinds in cache-aligned arrays; there
+     * is a single registry shared by all plugin instances in the
+     * process, which is filled once on first use.  The sine wave
+     * table may instead be mapped from a table file shared by all
+     * processes (see <C>SharedTableFile</C>); the tiny triangle
+     * table is always local.
+     */
+    struct _WaveTableRegistry {
+
+        /** the base points of the sine wave when not shared */
+        alignas(64) double localSineWaveTable[_sineWaveTableLength];
+
+        /** the base points of the triangle wave */
+        alignas(64) double triangleWaveTable[_triangleWaveTableLength];
+
+        /** the base points of the sine wave (either local or
+         * shared) */
+        const double* sineWaveTable;
+
+        /*--------------------*/
+
+        /**
+         * Fills or maps all wave tables.
+         */
+        _WaveTableRegistry ()
+        {
+            sineWaveTable =
+                (const double*)
+                SharedTableFile::table("sineWave", _sineWaveTableVersion,
+                                       sizeof(localSineWaveTable),
+                                       _fillSineWaveTable,
+                                       localSineWaveTable);
+            _initializeWaveTable(triangleWaveTable,
+                                 WaveFormKind::triangle,
+                                 _triangleWaveTableLength);
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns the registry of the process; the initialization
+         * of the local static is thread-safe, hence concurrently
+         * created waveforms see completely filled tables.
+         *
+         * @return  process-wide wave table registry
+         */
+        static const _WaveTableRegistry& instance ()
+        {
+            static const _WaveTableRegistry registry;
+            return registry;
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns the wave table for <C>kind</C> and sets
+         * <C>length</C> to its count of base points.
+         *
+         * @param[in]  kind    the wave form kind
+         * @param[out] length  the count of base points in table
+         * @return  read-only wave table
+         */
+        const double* waveTable (IN WaveFormKind kind,
+                                 OUT Natural& length) const
+        {
+            const Boolean isSine = (kind == WaveFormKind::sine);
+            length = (isSine ? _sineWaveTableLength
+                      : _triangleWaveTableLength);
+            return (isSine ? sineWaveTable : triangleWaveTable);
+        }
+
+    };
+
+    /*--------------------*/
+
     /**
      * Calculates position from settings in <C>descriptor</C>.
      *
@@ -172,6 +300,153 @@ namespace Audio {
         return Real::mod(p, Real{descriptor->waveTableLength});
     }
 
+    /*--------------------*/
+
+    /**
+     * Returns the scaled but unrounded value of the wave form in
+     * <C>descriptor</C> after <C>stepCount</C> steps calculated in
+     * plain doubles.
+     *
+     * @param[in] descriptor  the descriptor for the wave form
+     * @param[in] stepCount   the number of steps from the start
+     * @return  value of wave form at step
+     */
+    static double _valueAtStep (IN _WaveFormDescriptor* descriptor,
+                                IN size_t stepCount)
+    {
+        const size_t waveTableLength =
+            (size_t) descriptor->waveTableLength;
+        const double* waveTable = descriptor->waveTable;
+        const double length = (double) waveTableLength;
+        double position =
+            std::fmod((double) descriptor->firstPosition
+                      + (double) stepCount
+                        * (double) descriptor->increment,
+                      length);
+        position = (position < 0.0 ? position + length : position);
+
+        const size_t indexA = (size_t) position % waveTableLength;
+        const size_t indexB = (indexA + 1) % waveTableLength;
+        const double fPart = position - std::floor(position);
+        const double value = (waveTable[indexA] * (1.0 - fPart)
+                              + waveTable[indexB] * fPart);
+        const double minimumValue = (double) descriptor->minimumValue;
+        return (minimumValue
+                + value * (double) (descriptor->maximumValue
+                                    - descriptor->minimumValue));
+    }
+
+    /*--------------------*/
+
+    /**
+     * Writes the <C>count</C> values of the wave form in
+     * <C>descriptor</C> starting at its current step into
+     * <C>resultArray</C>, where the wave form is only evaluated
+     * exactly at multiples of the control interval and linearly
+     * interpolated in between; the anchors are aligned to the step
+     * count, hence the result does not depend on the block
+     * boundaries.
+     *
+     * @param[in]  descriptor   the descriptor for the wave form
+     * @param[out] resultArray  array for the wave form values
+     * @param[in]  count        number of values to be rendered
+     */
+    static void _renderAtControlRate (IN _WaveFormDescriptor* descriptor,
+                                      OUT double* resultArray,
+                                      IN size_t count)
+    {
+        const size_t controlInterval =
+            (size_t) descriptor->controlInterval;
+        const Boolean hasIntegerValues = descriptor->hasIntegerValues;
+        size_t stepCount = (size_t) descriptor->stepCount;
+        size_t anchorStep = stepCount - stepCount % controlInterval;
+        double nextValue = _valueAtStep(descriptor, anchorStep);
+        size_t i = 0;
+
+        while (i < count) {
+            const double anchorValue = nextValue;
+            nextValue = _valueAtStep(descriptor,
+                                     anchorStep + controlInterval);
+            const double slope = ((nextValue - anchorValue)
+                                  / (double) controlInterval);
+            size_t segmentEnd =
+                i + (anchorStep + controlInterval - stepCount);
+            segmentEnd = (segmentEnd > count ? count : segmentEnd);
+
+            for (;  i < segmentEnd;  i++) {
+                double value = (anchorValue
+                                + slope * (double) (stepCount
+                                                    - anchorStep));
+                value = (!hasIntegerValues ? value
+                         : (value >= 0 ? std::floor(value + 0.5)
+                            : std::ceil(value - 0.5)));
+                resultArray[i] = value;
+                stepCount++;
+            }
+
+            anchorStep += controlInterval;
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Writes the <C>count</C> values of the sine wave form in
+     * <C>descriptor</C> starting at its current position into
+     * <C>resultArray</C> by a rotator: the unit vector (x, y) at
+     * the current phase angle is rotated by the phase increment per
+     * sample and its y-coordinate is the sine; the vector length is
+     * renormalized periodically by a Newton step, because the
+     * rounding errors of the rotation otherwise let it drift.
+     *
+     * @param[in]  descriptor   the descriptor for the wave form
+     * @param[out] resultArray  array for the wave form values
+     * @param[in]  count        number of values to be rendered
+     */
+    static void _renderByRotator (IN _WaveFormDescriptor* descriptor,
+                                  OUT double* resultArray,
+                                  IN size_t count)
+    {
+        const double angleFactor =
+            ((double) Real::twoPi
+             / (double) descriptor->waveTableLength);
+        const double startAngle =
+            (double) descriptor->position * angleFactor;
+        const double deltaAngle =
+            (double) descriptor->increment * angleFactor;
+        const double cosDelta = std::cos(deltaAngle);
+        const double sinDelta = std::sin(deltaAngle);
+        const double halfRange =
+            (double) (descriptor->maximumValue
+                      - descriptor->minimumValue) * 0.5;
+        const double midValue =
+            (double) descriptor->minimumValue + halfRange;
+        const Boolean hasIntegerValues = descriptor->hasIntegerValues;
+        double x = std::cos(startAngle);
+        double y = std::sin(startAngle);
+        size_t normalizationCountdown = _rotatorNormalizationInterval;
+
+        for (size_t i = 0;  i < count;  i++) {
+            double value = midValue + y * halfRange;
+            value = (!hasIntegerValues ? value
+                     : (value >= 0 ? std::floor(value + 0.5)
+                        : std::ceil(value - 0.5)));
+            resultArray[i] = value;
+
+            const double nextX = x * cosDelta - y * sinDelta;
+            y = y * cosDelta + x * sinDelta;
+            x = nextX;
+            normalizationCountdown--;
+
+            if (normalizationCountdown == 0) {
+                const double correction = 1.5 - 0.5 * (x * x + y * y);
+                x *= correction;
+                y *= correction;
+                normalizationCountdown = _rotatorNormalizationInterval;
+            }
+        }
+    }
+
 }
 
 /*============================================================*/
@@ -184,23 +459,6 @@ WaveForm::WaveForm ()
 {
     Logging_trace(">>");
 
-    if (!_isInitialized) {
-        /* inititalize static variables */
-
-        /* for a triangle wave with linear interpolation four
-           equidistant sampling points are enough */
-        const Natural _sineWaveTableLength     = 10000;
-        const Natural _triangleWaveTableLength = 4;
-
-        _initializeWaveTable(_sineWaveTable,
-                             WaveFormKind::sine,
-                             _sineWaveTableLength);
-        _initializeWaveTable(_triangleWaveTable,
-                             WaveFormKind::triangle,
-                             _triangleWaveTableLength);
-        _isInitialized = true;
-    }
-
     _WaveFormDescriptor* descriptor = new _WaveFormDescriptor{};
     _internalData = descriptor;
     set(1000.0, WaveFormKind::sine, 0.0, 1.0, 0.0, false);
@@ -237,7 +495,10 @@ String WaveForm::toString() const {
                + TOSTRING(descriptor->hasIntegerValues));
     result += (", waveTableLength = "
                + TOSTRING(descriptor->waveTableLength));
-    result += ", buffer = " + descriptor->buffer->toString();
+    result += (", controlInterval = "
+               + TOSTRING(descriptor->controlInterval));
+    result += (", generator = "
+               + _waveFormGenerator(descriptor->generator));
     result += ")";
 
     return result;
@@ -260,10 +521,9 @@ void WaveForm::set (Real length, WaveFormKind kind,
     _WaveFormDescriptor* descriptor =
         static_cast<_WaveFormDescriptor*>(_internalData);
 
-    _WaveTable* buffer = (kind == WaveFormKind::sine
-                          ? &_sineWaveTable
-                          : &_triangleWaveTable);
-    const Natural waveTableLength = buffer->length();
+    Natural waveTableLength;
+    const double* waveTable =
+        _WaveTableRegistry::instance().waveTable(kind, waveTableLength);
     const Real firstPosition =
         Real::mod((Real) waveTableLength * phase / Real::twoPi,
                   (Real) waveTableLength);
@@ -277,7 +537,7 @@ void WaveForm::set (Real length, WaveFormKind kind,
     descriptor->maximumValue     = maximumValue;
     descriptor->hasIntegerValues = hasIntegerValues;
     descriptor->waveTableLength  = waveTableLength;
-    descriptor->buffer           = buffer;
+    descriptor->waveTable        = waveTable;
 
     Logging_trace1("<<: %1", toString());
 }
@@ -293,7 +553,8 @@ Real WaveForm::current () const
     const Real minimumValue = descriptor->minimumValue;
     const Boolean hasIntegerValues = descriptor->hasIntegerValues;
     const Real scalingFactor = descriptor->maximumValue - minimumValue;
-    Real value = _getWavetableValueAtPosition(descriptor->buffer,
+    Real value = _getWavetableValueAtPosition(descriptor->waveTable,
+                                              descriptor->waveTableLength,
                                               descriptor->position);
     value = minimumValue + value * scalingFactor;
 
@@ -338,6 +599,25 @@ void WaveForm::setState (WaveFormIteratorState state)
 
 /*--------------------*/
 
+void WaveForm::setPhase (IN Radians phase)
+{
+    Logging_trace1(">>: %1", TOSTRING(phase));
+
+    _WaveFormDescriptor* descriptor =
+        static_cast<_WaveFormDescriptor*>(_internalData);
+    const Real waveTableLength = (Real) descriptor->waveTableLength;
+    const Real firstPosition =
+        Real::mod(waveTableLength * phase / Real::twoPi,
+                  waveTableLength);
+    descriptor->firstPosition = firstPosition;
+    descriptor->stepCount     = 0;
+    descriptor->position      = firstPosition;
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
 void WaveForm::advance ()
 {
     _WaveFormDescriptor* descriptor =
@@ -346,6 +626,113 @@ void WaveForm::advance ()
     descriptor->position = _position(descriptor);
 }
 
+/*--------------------*/
+
+void WaveForm::render (OUT Real* outputArray, IN Natural count)
+{
+    _WaveFormDescriptor* descriptor =
+        static_cast<_WaveFormDescriptor*>(_internalData);
+    const size_t waveTableLength = (size_t) descriptor->waveTableLength;
+    const double* waveTable = descriptor->waveTable;
+    const double length       = (double) waveTableLength;
+    const double increment    = (double) descriptor->increment;
+    const double startPosition = (double) descriptor->position;
+    const double minimumValue = (double) descriptor->minimumValue;
+    const double scalingFactor =
+        (double) (descriptor->maximumValue - descriptor->minimumValue);
+    const Boolean hasIntegerValues = descriptor->hasIntegerValues;
+    double* resultArray = (double*) outputArray;
+
+    if (descriptor->controlInterval > 1) {
+        _renderAtControlRate(descriptor, resultArray, (size_t) count);
+    } else if (descriptor->kind == WaveFormKind::sine
+               && descriptor->generator == WaveFormGenerator::rotator) {
+        _renderByRotator(descriptor, resultArray, (size_t) count);
+    } else {
+        /* the position is calculated from the start of the block (and
+           not accumulated) and wrapped around the table end by an
+           offset updated on each crossing */
+        double wrapOffset = 0.0;
+
+        for (size_t i = 0;  i < (size_t) count;  i++) {
+            double position =
+                startPosition + (double) i * increment - wrapOffset;
+
+            while (position >= length) {
+                wrapOffset += length;
+                position   -= length;
+            }
+
+            const size_t indexA = (size_t) position;
+            const size_t indexB =
+                (indexA + 1 == waveTableLength ? 0 : indexA + 1);
+            const double fPart = position - (double) indexA;
+            double value = (waveTable[indexA] * (1.0 - fPart)
+                            + waveTable[indexB] * fPart);
+            value = minimumValue + value * scalingFactor;
+            value = (!hasIntegerValues ? value
+                     : (value >= 0 ? std::floor(value + 0.5)
+                        : std::ceil(value - 0.5)));
+            resultArray[i] = value;
+        }
+    }
+
+    descriptor->stepCount += count;
+    descriptor->position = _position(descriptor);
+}
+
+/*--------------------*/
+
+void WaveForm::setControlInterval (IN Natural sampleCount)
+{
+    Logging_trace1(">>: %1", TOSTRING(sampleCount));
+    _WaveFormDescriptor* descriptor =
+        static_cast<_WaveFormDescriptor*>(_internalData);
+    descriptor->controlInterval = sampleCount;
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void WaveForm::setGenerator (IN WaveFormGenerator generator)
+{
+    Logging_trace1(">>: %1", _waveFormGenerator(generator));
+    _WaveFormDescriptor* descriptor =
+        static_cast<_WaveFormDescriptor*>(_internalData);
+    descriptor->generator = generator;
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* state transfer     */
+/*--------------------*/
+
+void WaveForm::saveState (INOUT DspStateStream& stream) const
+{
+    const _WaveFormDescriptor* descriptor =
+        static_cast<_WaveFormDescriptor*>(_internalData);
+    stream.write(descriptor->firstPosition);
+    stream.write(descriptor->stepCount);
+}
+
+/*--------------------*/
+
+void WaveForm::restoreState (INOUT DspStateStream& stream)
+{
+    _WaveFormDescriptor* descriptor =
+        static_cast<_WaveFormDescriptor*>(_internalData);
+    Real firstPosition;
+    Natural stepCount;
+    stream.read(firstPosition);
+    stream.read(stepCount);
+
+    if (stream.isOkay()) {
+        descriptor->firstPosition = firstPosition;
+        descriptor->stepCount     = stepCount;
+        descriptor->position      = _position(descriptor);
+    }
+}
+
 /*--------------------*/
 /* time lock service  */
 /*--------------------*/
@@ -16,6 +16,7 @@
 /*=========*/
 
 #include "Boolean.h"
+#include "DspStateStream.h"
 #include "Natural.h"
 #include "Object.h"
 #include "Radians.h"
@@ -49,6 +50,15 @@ namespace Audio {
 
     /*--------------------*/
 
+    /**
+     * The <C>WaveFormGenerator</C> is an enumeration type for the
+     * ways a sine wave form is rendered: by interpolation in the
+     * sine wave table or by a recursive rotator.
+     */
+    enum class WaveFormGenerator { table, rotator };
+
+    /*--------------------*/
+
     /**
      * A <C>WaveForm</C> object provides common services for (LFO)
      * wave forms.
@@ -140,11 +150,100 @@ namespace Audio {
 
         /*--------------------*/
 
+        /**
+         * Restarts the wave form at <C>phase</C> keeping its length,
+         * kind and bounds; this is equivalent to a <C>set</C> with
+         * the previous parameters and the new phase, but only
+         * repositions the phase accumulator and takes constant
+         * time.
+         *
+         * @param[in] phase  the new initial phase (in radians)
+         */
+        void setPhase (IN Radians phase);
+
+        /*--------------------*/
+
         /**
          * Advances access to wave form to next sample position
          */
         void advance ();
 
+        /*--------------------*/
+
+        /**
+         * Writes the <C>count</C> values of the wave form starting
+         * at the current position into <C>outputArray</C> and
+         * advances the wave form by that number of samples; the
+         * values are identical to alternating calls of
+         * <C>current</C> and <C>advance</C> up to rounding, but are
+         * calculated by a phase accumulator with a linear
+         * interpolation in the wave table and without a modulus per
+         * sample.
+         *
+         * @param[out] outputArray  array for the wave form values
+         * @param[in]  count        number of values to be rendered
+         */
+        void render (OUT Real* outputArray, IN Natural count);
+
+        /*--------------------*/
+
+        /**
+         * Sets the number of samples between exact evaluations of
+         * the wave form in <C>render</C> to <C>sampleCount</C>; for
+         * a count greater than one the wave form is only evaluated
+         * at multiples of <C>sampleCount</C> steps and linearly
+         * interpolated (and rounded afterwards for integer values) in
+         * between, otherwise it is evaluated for every sample (the
+         * default); does not change the iteration state.
+         *
+         * @param[in] sampleCount  number of samples between exact
+         *                         evaluations of the wave form
+         */
+        void setControlInterval (IN Natural sampleCount);
+
+        /*--------------------*/
+
+        /**
+         * Sets the generator of a sine wave form in <C>render</C>
+         * to <C>generator</C>.  The default table generator
+         * interpolates in the sine wave table; the rotator
+         * generator instead rotates a unit vector by the phase
+         * increment per sample (with a periodic renormalization of
+         * its length) and reads the sine from it, hence it needs no
+         * table accesses and is exact up to rounding.  The rotator
+         * is started from the exact phase at each call, such that
+         * no phase error accumulates across blocks.  Has no effect
+         * for other wave form kinds, for <C>current</C> or for a
+         * control interval greater than one.
+         *
+         * @param[in] generator  the generator for sine wave forms
+         */
+        void setGenerator (IN WaveFormGenerator generator);
+
+        /*--------------------*/
+        /* state transfer     */
+        /*--------------------*/
+
+        /**
+         * Appends the phase and the iteration state of the wave form
+         * to <C>stream</C>.
+         *
+         * @param[inout] stream  state stream to be written
+         */
+        void saveState (INOUT DspStateStream& stream) const;
+
+        /*--------------------*/
+
+        /**
+         * Reads the phase and the iteration state written by
+         * <C>saveState</C> from <C>stream</C>; the wave form must
+         * already have been set up with the same length, kind and
+         * bounds.
+         *
+         * @param[inout] stream  state stream to be read
+         */
+        void restoreState (INOUT DspStateStream& stream);
+
         /*--------------------*/
         /* time lock service  */
         /*--------------------*/
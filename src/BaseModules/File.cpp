@@ -12,12 +12,38 @@
 /* IMPORTS */
 /*=========*/
 
-#include <cstring>
+/* byte positions in files are 64 bit even on 32 bit POSIX
+   platforms */
+#ifndef _FILE_OFFSET_BITS
+    #define _FILE_OFFSET_BITS 64
+#endif
+
 #include <stdio.h>
+
+#ifdef _WIN32
+    /** qualified 64 bit version of fseek from stdio */
+    #define StdIO_fseeko  _fseeki64
+    /** qualified 64 bit version of ftell from stdio */
+    #define StdIO_ftello  _ftelli64
+    /** the type of a 64 bit file position */
+    typedef __int64 StdIO_off_t;
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    /** qualified 64 bit version of fseek from stdio */
+    #define StdIO_fseeko  fseeko
+    /** qualified 64 bit version of ftell from stdio */
+    #define StdIO_ftello  ftello
+    /** the type of a 64 bit file position */
+    typedef off_t StdIO_off_t;
+#endif
+
     /** qualified version of FILE from stdio */
     #define StdIO_FILE    FILE
     /** qualified version of fclose from stdio */
     #define StdIO_fclose  fclose
+    /** qualified version of fflush from stdio */
+    #define StdIO_fflush  fflush
     /** qualified version of fopen from stdio */
     #define StdIO_fopen   fopen
     /** qualified version of fputs from stdio */
@@ -25,10 +51,6 @@
     /** qualified version of fread from stdio */
     #define StdIO_fread(ptr, tSize, count, stream) \
             fread(ptr, (size_t) tSize, (size_t) count, stream)
-    /** qualified version of fseek from stdio */
-    #define StdIO_fseek   fseek
-    /** qualified version of ftell from stdio */
-    #define StdIO_ftell   ftell
     /** qualified version of fwrite from stdio */
     #define StdIO_fwrite  fwrite
 
@@ -71,7 +93,7 @@ File::~File ()
 Boolean File::open (IN String& fileName, IN String& mode)
 {
     Assertion_pre((mode == "a" || mode == "ab"
-                   || mode == "r" || mode == "rb"
+                   || mode == "r" || mode == "rb" || mode == "r+b"
                    || mode == "w" || mode == "wb"),
                   STR::expand("file mode must be known - %1", mode));
     FilePointer file = StdIO_fopen(fileName.c_str(), mode.c_str());
@@ -101,33 +123,76 @@ Natural File::read (INOUT ByteList& byteList,
 {
     Assertion_pre(isOpen(), "file must be open for reading");
     FilePointer file = (FilePointer) _descriptor;
-    char charArray[512];
-    const Natural chunkSize = sizeof(charArray);
+    const Natural chunkSize = 65536;
+    const Natural originalLength = byteList.length();
     Natural totalBytesRead = 0;
+    Boolean isDone = (count == 0);
 
-    for (;;) {
-        Natural listSize = byteList.length();
-        Natural bytesToRead =
+    /* the data goes directly into the list, which is extended
+       chunkwise for an unknown count and finally trimmed to the
+       bytes read */
+    while (!isDone) {
+        const Natural bytesToRead =
             Natural::minimum(chunkSize, count - totalBytesRead);
-        Natural bytesRead =
-            Natural{StdIO_fread(charArray, sizeof(char),
-                                bytesToRead, file)};
+        const Natural endPosition =
+            position + totalBytesRead + bytesToRead;
 
-        if (listSize < position + totalBytesRead + bytesRead) {
-            /* extend list to take another bytesRead bytes */
-            byteList.setLength(listSize + bytesRead);
-        }
-        
-        if (bytesRead == 0) {
-            break;
-        } else {
-            char* ptr = (char*) byteList.asArray();
-            ptr += (size_t)(position + totalBytesRead);
-            std::memcpy(ptr, charArray, (size_t) bytesRead);
-            totalBytesRead += bytesRead;
+        if (byteList.length() < endPosition) {
+            byteList.setLength(endPosition);
         }
+
+        char* ptr = (char*) byteList.asArray();
+        ptr += (size_t) (position + totalBytesRead);
+        const Natural bytesRead =
+            Natural{StdIO_fread(ptr, sizeof(char), bytesToRead, file)};
+        totalBytesRead += bytesRead;
+        isDone = (bytesRead < bytesToRead || totalBytesRead == count);
     }
 
+    byteList.setLength(Natural::maximum(originalLength,
+                                        position + totalBytesRead));
+    return totalBytesRead;
+}
+
+/*--------------------*/
+
+Natural File::readInto (OUT void* destination,
+                        IN Natural offset,
+                        IN Natural count)
+{
+    Assertion_pre(isOpen(), "file must be open for reading");
+    FilePointer file = (FilePointer) _descriptor;
+    char* ptr = (char*) destination;
+    Natural totalBytesRead = 0;
+
+    #ifdef _WIN32
+        /* there is no positional read in stdio: go to the offset
+           and restore the stream position afterwards */
+        const StdIO_off_t streamPosition = StdIO_ftello(file);
+
+        if (StdIO_fseeko(file, (StdIO_off_t) (size_t) offset,
+                         SEEK_SET) == 0) {
+            totalBytesRead =
+                Natural{StdIO_fread(ptr, sizeof(char), count, file)};
+        }
+
+        StdIO_fseeko(file, streamPosition, SEEK_SET);
+    #else
+        /* the system call may deliver less than requested (e.g. when
+           interrupted), so it is repeated until end of file */
+        const int descriptor = fileno(file);
+        Boolean isDone = (count == 0);
+
+        while (!isDone) {
+            const ssize_t bytesRead =
+                pread(descriptor, ptr + (size_t) totalBytesRead,
+                      (size_t) (count - totalBytesRead),
+                      (StdIO_off_t) (size_t) (offset + totalBytesRead));
+            totalBytesRead += (bytesRead > 0 ? (size_t) bytesRead : 0);
+            isDone = (bytesRead <= 0 || totalBytesRead == count);
+        }
+    #endif
+
     return totalBytesRead;
 }
 
@@ -170,6 +235,56 @@ void File::writeString (IN String& st)
     StdIO_fputs(st.c_str(), file);
 }
 
+/*--------------------*/
+
+Boolean File::flush ()
+{
+    Assertion_pre(isOpen(), "file must be open for flushing");
+    FilePointer file = (FilePointer) _descriptor;
+    return (StdIO_fflush(file) == 0);
+}
+
+/*--------------------*/
+/* positioning        */
+/*--------------------*/
+
+Natural File::position ()
+{
+    Assertion_pre(isOpen(), "file must be open for positioning");
+    FilePointer file = (FilePointer) _descriptor;
+    const StdIO_off_t result = StdIO_ftello(file);
+    return (result < 0 ? Natural{0} : Natural{(size_t) result});
+}
+
+/*--------------------*/
+
+Boolean File::setPosition (IN Natural position)
+{
+    Assertion_pre(isOpen(), "file must be open for positioning");
+    FilePointer file = (FilePointer) _descriptor;
+    return (StdIO_fseeko(file, (StdIO_off_t) (size_t) position,
+                         SEEK_SET) == 0);
+}
+
+/*--------------------*/
+/* access hints       */
+/*--------------------*/
+
+void File::prefetch (IN Natural offset, IN Natural count)
+{
+    Assertion_pre(isOpen(), "file must be open for prefetching");
+
+    #if defined(_WIN32) || defined(__APPLE__)
+        /* no read-ahead hint available */
+        (void) offset;
+        (void) count;
+    #else
+        FilePointer file = (FilePointer) _descriptor;
+        posix_fadvise(fileno(file), (StdIO_off_t) (size_t) offset,
+                      (StdIO_off_t) (size_t) count, POSIX_FADV_WILLNEED);
+    #endif
+}
+
 /*--------------------*/
 /* measurement        */
 /*--------------------*/
@@ -177,12 +292,41 @@ void File::writeString (IN String& st)
 Natural File::length (IN String& fileName)
 {
     FilePointer file = StdIO_fopen(fileName.c_str(), "rb");
-    StdIO_fseek(file, 0, SEEK_END);
-    Natural result = (size_t) StdIO_ftell(file);
-    StdIO_fclose(file);
+    Natural result = 0;
+
+    if (file != NULL) {
+        StdIO_fseeko(file, 0, SEEK_END);
+        const StdIO_off_t length = StdIO_ftello(file);
+        result = (length < 0 ? 0 : (size_t) length);
+        StdIO_fclose(file);
+    }
+
     return result;
 }
 
+/*--------------------*/
+/* file management    */
+/*--------------------*/
+
+Boolean File::remove (IN String& fileName)
+{
+    return (::remove(fileName.c_str()) == 0);
+}
+
+/*--------------------*/
+
+Boolean File::rename (IN String& fileName,
+                      IN String& newFileName)
+{
+    #ifdef _WIN32
+        /* the C library of Windows does not replace an existing
+           target */
+        ::remove(newFileName.c_str());
+    #endif
+
+    return (::rename(fileName.c_str(), newFileName.c_str()) == 0);
+}
+
 /*--------------------*/
 /* queries            */
 /*--------------------*/
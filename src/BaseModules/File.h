@@ -35,6 +35,15 @@ namespace BaseModules {
      * A <C>File</C> object provided methods for simple file handling
      * based on C stdio.  Note that this module does no logging
      * because it is used by the logging module itself.
+     *
+     * All byte positions are 64 bit values, hence files larger than
+     * 4GB can be positioned and read.  Besides the stream oriented
+     * access there is a positional read <C>readInto</C> into a
+     * caller buffer (without any intermediate byte list) together
+     * with a <C>prefetch</C> hint, so that a streaming reader may
+     * let the system fetch the next region while it processes the
+     * current one; a complete memory mapped view of a file is
+     * provided by <C>MappedFile</C>.
      */
     struct File {
 
@@ -85,8 +94,9 @@ namespace BaseModules {
          * <C>mode</C>.
          *
          * @param[in]  fileName  name of file to open
-         * @param[in]  mode      C open mode ("r", "w", "rb", "wb", "a"
-                                 and "ab")
+         * @param[in]  mode      C open mode ("r", "w", "rb", "wb", "a",
+                                 "ab" and "r+b" for updating an
+                                 existing file)
          * @return  information whether operation has been successful
          */
         Boolean open (IN String& fileName, IN String& mode);
@@ -119,6 +129,29 @@ namespace BaseModules {
 
         /*--------------------*/
 
+        /**
+         * Reads at most <C>count</C> bytes at byte <C>offset</C> of
+         * the file directly into <C>destination</C> and returns the
+         * number of bytes read (which is only smaller than
+         * <C>count</C> at the end of file or on an error).  The
+         * current stream position is not used and not changed (like
+         * POSIX <C>pread</C>), hence the file should have been
+         * opened for reading only.
+         *
+         * @param[out] destination  buffer with at least <C>count</C>
+         *                          bytes for the data read
+         * @param[in]  offset       byte position in file of first
+         *                          byte to be read
+         * @param[in]  count        number of bytes to be read at
+         *                          most
+         * @return  number of bytes read actually
+         */
+        Natural readInto (OUT void* destination,
+                          IN Natural offset,
+                          IN Natural count);
+
+        /*--------------------*/
+
         /**
          * Reads all lines from text file into a string list.  The
          * eol-convention is automatically detected.
@@ -152,6 +185,54 @@ namespace BaseModules {
          */
         void writeString (IN String& st);
 
+        /*--------------------*/
+
+        /**
+         * Hands all buffered data of file over to the operating
+         * system and tells whether this has been successful.
+         *
+         * @return  information whether operation has been successful
+         */
+        Boolean flush ();
+
+        /*--------------------*/
+        /* positioning        */
+        /*--------------------*/
+
+        /**
+         * Returns the current byte position in file.
+         *
+         * @return  byte position from start of file
+         */
+        Natural position ();
+
+        /*--------------------*/
+
+        /**
+         * Sets the current byte position in file to
+         * <C>position</C> bytes from its start and tells whether
+         * this has been successful.
+         *
+         * @param[in] position  new byte position from start of file
+         * @return  information whether operation has been successful
+         */
+        Boolean setPosition (IN Natural position);
+
+        /*--------------------*/
+        /* access hints       */
+        /*--------------------*/
+
+        /**
+         * Tells the operating system that the <C>count</C> bytes at
+         * <C>offset</C> of the file will be read soon, so that it
+         * may fetch them asynchronously into its cache; the call
+         * returns immediately and is ignored where not supported.
+         *
+         * @param[in] offset  byte position of region in file
+         * @param[in] count   number of bytes in region
+         */
+        void prefetch (IN Natural offset, IN Natural count);
+
         /*--------------------*/
         /* measurement        */
         /*--------------------*/
@@ -165,6 +246,35 @@ namespace BaseModules {
          */
         static Natural length (IN String& fileName);
 
+        /*--------------------*/
+        /* file management    */
+        /*--------------------*/
+
+        /**
+         * Deletes the file named <C>fileName</C> and tells whether
+         * this has been successful.  Note that the file may not be
+         * currently open.
+         *
+         * @param[in] fileName  name of file to be deleted
+         * @return  information whether file has been deleted
+         */
+        static Boolean remove (IN String& fileName);
+
+        /*--------------------*/
+
+        /**
+         * Renames the file named <C>fileName</C> to
+         * <C>newFileName</C> (replacing an existing file of that
+         * name) and tells whether this has been successful.  Note
+         * that the file may not be currently open.
+         *
+         * @param[in] fileName     name of file to be renamed
+         * @param[in] newFileName  new name of file
+         * @return  information whether file has been renamed
+         */
+        static Boolean rename (IN String& fileName,
+                               IN String& newFileName);
+
         /*--------------------*/
         /* queries            */
         /*--------------------*/
@@ -4,7 +4,15 @@
  * and intermediate logging of functions into a file; this file
  * provides a conditional facade that expands all logging functions to
  * empty for production code and expands to concrete logging
- * implementations for debugging code.
+ * implementations for debugging code.  Traces are graded by levels
+ * and only those up to the compile-time level <C>LOGGING_LEVEL</C>
+ * are compiled in; the traces in audio hot paths have their own
+ * level above the ordinary ones and are only enabled for profiling.
+ * Independent of the level, processing spans can be recorded at
+ * runtime and exported as a timeline in the Chrome trace format.
+ * Each trace call site may be rate limited at runtime by sampling
+ * and by a maximum number of calls per second; the suppressed calls
+ * of a site are summarized in the log.
  *
  * @author Dr. Thomas Tensi
  * @date   2021-02
@@ -40,6 +48,26 @@ using BaseModules::StringUtil;
 
 /*--------------------*/
 
+/** the logging level with error traces only */
+#define Logging_levelError  1
+
+/** the logging level with error traces and the ordinary entry, exit
+ * and intermediate traces */
+#define Logging_levelTrace  2
+
+/** the logging level additionally with the traces in the hot paths
+ * of audio processing (per block, band or channel); only intended
+ * for profiling builds */
+#define Logging_levelHot    3
+
+#ifndef LOGGING_LEVEL
+    /** the most verbose logging level compiled in when logging is
+     * active; all traces above this level expand to empty */
+    #define LOGGING_LEVEL Logging_levelTrace
+#endif
+
+/*--------------------*/
+
 #ifdef LOGGING_IS_ACTIVE
     /* for active logging routines are redirected to corresponding
      * routines in logging class */
@@ -68,6 +96,10 @@ using BaseModules::StringUtil;
     /** Sets logging to active or inactive */
     #define Logging_setActive(isActive)  Logging::setActive(isActive)
 
+    /** Sets logging to asynchronous or synchronous mode */
+    #define Logging_setAsynchronous(isAsynchronous)  \
+                Logging::setAsynchronous(isAsynchronous)
+
     /**
      * Sets the name of the logging callback function (if applicable)
      */
@@ -96,17 +128,92 @@ using BaseModules::StringUtil;
                 Logging::setTracingWithTime(timeIsLogged, \
                                             fractionalDigitCount)
 
+    /** Starts or stops the recording of processing spans */
+    #define Logging_setSpanTracing(isEnabled) \
+                Logging::setSpanTracing(isEnabled)
+
     /**
-     * Writes a message to log file
+     * Limits each trace call site to every
+     * <C>samplingPeriod</C>-th call and to
+     * <C>maximumCallsPerSecond</C> calls per second (zero for no
+     * limit)
      */
-    #define _Logging_trace(message) \
-                Logging::trace(signatureOfFunction, message)
+    #define Logging_setRateLimit(samplingPeriod, maximumCallsPerSecond) \
+                Logging::setRateLimit(samplingPeriod, \
+                                      maximumCallsPerSecond)
+
+    /** Writes the recorded spans as Chrome trace to a file */
+    #define Logging_writeSpanTrace(fileName) \
+                Logging::writeSpanTrace(fileName)
+
+    /**
+     * Records a span named by string literal <C>name</C> for object
+     * <C>instance</C> until the end of the enclosing scope
+     */
+    #define Logging_span(name, instance) \
+                const BaseModules::LoggingSpan _loggingSpan{name, instance}
+
+    /** Records the begin of a span for an object */
+    #define Logging_beginSpan(name, instance) \
+                Logging::beginSpan(name, instance)
+
+    /** Records the end of a span for an object */
+    #define Logging_endSpan(name, instance) \
+                Logging::endSpan(name, instance)
 
     /**
-     * Writes an error message to log file
+     * Writes a message via <C>traceFunction</C> when the call site
+     * admits it with respect to the rate limits; the message is only
+     * constructed when admitted
      */
-    #define _Logging_traceError(message) \
-                Logging::traceError(signatureOfFunction, message)
+    #define _Logging_traceLimited(traceFunction, message) \
+                do { \
+                    static BaseModules::LoggingCallSite _loggingCallSite{}; \
+                    if (_loggingCallSite.admits(signatureOfFunction)) { \
+                        traceFunction(signatureOfFunction, message); \
+                    } \
+                } while (false)
+
+    #if LOGGING_LEVEL >= Logging_levelTrace
+        /**
+         * Writes a message to log file
+         */
+        #define _Logging_trace(message) \
+                    _Logging_traceLimited(Logging::trace, message)
+    #else
+        /**
+         * Writes a message to log file (empty below trace level)
+         */
+        #define _Logging_trace(message)
+    #endif
+
+    #if LOGGING_LEVEL >= Logging_levelError
+        /**
+         * Writes an error message to log file
+         */
+        #define _Logging_traceError(message) \
+                    _Logging_traceLimited(Logging::traceError, message)
+    #else
+        /**
+         * Writes an error message to log file (empty below error
+         * level)
+         */
+        #define _Logging_traceError(message)
+    #endif
+
+    #if LOGGING_LEVEL >= Logging_levelHot
+        /**
+         * Writes a message from an audio hot path to log file
+         */
+        #define _Logging_traceHot(message) \
+                    _Logging_traceLimited(Logging::trace, message)
+    #else
+        /**
+         * Writes a message from an audio hot path to log file
+         * (empty below hot level)
+         */
+        #define _Logging_traceHot(message)
+    #endif
 
 #else
     /* for inactive logging routines are simply empty */
@@ -133,6 +240,9 @@ using BaseModules::StringUtil;
     /** Sets logging to active or inactive */
     #define Logging_setActive(isActive) 
 
+    /** Sets logging to asynchronous or synchronous mode (empty) */
+    #define Logging_setAsynchronous(isAsynchronous)
+
     /**
      * Sets the name of the logging callback function (if applicable)
      */
@@ -157,6 +267,24 @@ using BaseModules::StringUtil;
     #define Logging_setTracingWithTime(timeIsLogged, \
                                        fractionalDigitCount)
 
+    /** Starts or stops the recording of processing spans (empty) */
+    #define Logging_setSpanTracing(isEnabled)
+
+    /** Limits the rate of each trace call site (empty) */
+    #define Logging_setRateLimit(samplingPeriod, maximumCallsPerSecond)
+
+    /** Writes the recorded spans as Chrome trace to a file (empty) */
+    #define Logging_writeSpanTrace(fileName)
+
+    /** Records a span until the end of the scope (empty) */
+    #define Logging_span(name, instance)
+
+    /** Records the begin of a span for an object (empty) */
+    #define Logging_beginSpan(name, instance)
+
+    /** Records the end of a span for an object (empty) */
+    #define Logging_endSpan(name, instance)
+
     /**
      * Writes a message to log file (empty)
      */
@@ -167,6 +295,11 @@ using BaseModules::StringUtil;
      */
     #define _Logging_traceError(message)
 
+    /**
+     * Writes a message from an audio hot path to log file (empty)
+     */
+    #define _Logging_traceHot(message)
+
 #endif
 
 /*--------------------*/
@@ -260,6 +393,28 @@ using BaseModules::StringUtil;
                                    st1, st2, st3, st4, st5,     \
                                    st6, st7, st8, st9, st10))
 
+/**
+ * Writes hot path trace message with formatting template only
+ */
+#define Logging_traceHot(formattingTemplate)   \
+            _Logging_traceHot(formattingTemplate)
+
+/**
+ * Writes hot path trace message with formatting template and one
+ * parameter
+ */
+#define Logging_traceHot1(formattingTemplate, st1) \
+            _Logging_traceHot(_expand(formattingTemplate, \
+                                      st1))
+
+/**
+ * Writes hot path trace message with formatting template and two
+ * parameters
+ */
+#define Logging_traceHot2(formattingTemplate, st1, st2) \
+            _Logging_traceHot(_expand(formattingTemplate, \
+                                      st1, st2))
+
 /**
  * Writes trace error message with formatting template only
  */
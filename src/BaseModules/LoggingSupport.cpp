@@ -15,9 +15,15 @@
 /* IMPORTS */
 /*=========*/
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
 #include <stdlib.h>
+#include <thread>
     /** qualified version of atexit from stdlib */
     #define StdLib_atexit atexit
 
@@ -62,6 +68,47 @@ static const Natural _dstOffsetInMilliseconds{3600000};
 /** dictionary from already known signatures */
 static Dictionary _signatureToFunctionNameMap;
 
+/*--------------------*/
+
+/** the number of slots in the ring for asynchronous logging */
+static const size_t _asyncRingLength = 1024;
+
+/*--------------------*/
+
+/** the capacity for the function signature in an asynchronous
+ * logging slot (including the terminating zero) */
+static const size_t _asyncSignatureCapacity = 256;
+
+/*--------------------*/
+
+/** the capacity for the message in an asynchronous logging slot
+ * (including the terminating zero) */
+static const size_t _asyncMessageCapacity = 512;
+
+/*--------------------*/
+
+/** the time in milliseconds the asynchronous writer sleeps when the
+ * ring is empty */
+static const int _asyncWriterSleepTime = 5;
+
+/*--------------------*/
+
+/** the number of events in the buffer for span tracing */
+static const size_t _spanBufferLength = 65536;
+
+/** the time in seconds between two summaries of suppressed calls
+ * by the asynchronous writer */
+static const int _suppressionSummaryInterval = 1;
+
+/** the name of the environment variable with the initial sampling
+ * period of trace call sites */
+static const char* _samplingPeriodVariableName =
+    "LOGGING_SAMPLING_PERIOD";
+
+/** the name of the environment variable with the initial maximum
+ * calls per second of trace call sites */
+static const char* _maximumRateVariableName = "LOGGING_MAXIMUM_RATE";
+
 /*====================*/
 /* PROTOTYPES         */
 /*====================*/
@@ -93,6 +140,63 @@ namespace BaseModules {
 
     /*====================*/
 
+    /**
+     * A <C>_AsyncLoggingSlot</C> object is a preallocated entry in
+     * the ring for asynchronous logging with fixed capacity texts
+     * and a sequence number telling whether the slot is free or
+     * filled for the current ring position.
+     */
+    struct _AsyncLoggingSlot {
+
+        /** the sequence number of the slot */
+        std::atomic<size_t> sequenceNumber;
+
+        /** the timestamp for this logging entry */
+        Timestamp systemTime;
+
+        /** the function signature for this logging entry
+         * (possibly truncated) */
+        char functionSignature[_asyncSignatureCapacity];
+
+        /** the associated message this logging entry (possibly
+         * truncated) */
+        char message[_asyncMessageCapacity];
+
+    };
+
+    /*====================*/
+
+    /**
+     * A <C>_SpanEvent</C> object is a preallocated entry in the
+     * buffer for span tracing; the completion flag tells whether
+     * the other fields have been written.
+     */
+    struct _SpanEvent {
+
+        /** tells whether the event has been completely written */
+        std::atomic<bool> isComplete;
+
+        /** the kind of event ('B' for begin and 'E' for end) */
+        char phase;
+
+        /** the name of the span (a string literal) */
+        const char* name;
+
+        /** the address of the object doing the work */
+        const void* instance;
+
+        /** the hash of the identification of the recording
+         * thread */
+        size_t threadHash;
+
+        /** the time since the start of span tracing in
+         * nanoseconds */
+        std::int64_t timestamp;
+
+    };
+
+    /*====================*/
+
     /**
      * The <C>_LoggingState</C> gives the state of the logger
      */
@@ -371,6 +475,105 @@ static _LoggingState _loggingState{_LoggingState::inLimbo};
 /** the current logging time handler */
 static _LoggingTime _loggingTime = _LoggingTime();
 
+/*--------------------*/
+
+/** the mutex serializing the asynchronous writer with the
+ * configuration routines (never locked by a logging caller) */
+static std::mutex _loggingMutex;
+
+/*--------------------*/
+
+/** flag to tell whether entries are handed over to the asynchronous
+ * writer */
+static std::atomic<bool> _isAsynchronous{false};
+
+/*--------------------*/
+
+/** the ring of slots for asynchronous logging (allocated once when
+ * asynchronous logging is started first) */
+static BaseModules::_AsyncLoggingSlot* _asyncRing = nullptr;
+
+/*--------------------*/
+
+/** the next ring position to be claimed by a logging caller */
+static std::atomic<size_t> _asyncEnqueuePosition{0};
+
+/*--------------------*/
+
+/** the next ring position to be read by the asynchronous writer */
+static size_t _asyncDequeuePosition = 0;
+
+/*--------------------*/
+
+/** the number of entries dropped because the ring was full */
+static std::atomic<size_t> _droppedEntryCount{0};
+
+/*--------------------*/
+
+/** the number of dropped entries already reported in the log */
+static size_t _reportedDroppedEntryCount = 0;
+
+/*--------------------*/
+
+/** flag to tell the asynchronous writer to terminate */
+static std::atomic<bool> _asyncWriterIsStopped{false};
+
+/*--------------------*/
+
+/** the thread of the asynchronous writer */
+static std::thread _asyncWriterThread;
+
+/*--------------------*/
+
+/** flag to tell whether processing spans are recorded */
+static std::atomic<bool> _spanTracingIsActive{false};
+
+/*--------------------*/
+
+/** the buffer of span events (allocated once when span tracing is
+ * started first) */
+static BaseModules::_SpanEvent* _spanBuffer = nullptr;
+
+/*--------------------*/
+
+/** the number of span events claimed since the start of span
+ * tracing (may exceed the buffer length) */
+static std::atomic<size_t> _spanEventCount{0};
+
+/*--------------------*/
+
+/** the time of the start of span tracing */
+static steady_clock::time_point _spanStartTime;
+
+/*--------------------*/
+
+/** flag to tell whether some rate limit for call sites is set */
+static std::atomic<bool> _isRateLimited{false};
+
+/*--------------------*/
+
+/** the distance of logged calls of a call site (0 or 1 for all
+ * calls) */
+static std::atomic<std::uint64_t> _samplingPeriod{0};
+
+/*--------------------*/
+
+/** the maximum number of logged calls per second of a call site (0
+ * for unlimited) */
+static std::atomic<std::uint64_t> _maximumCallsPerSecond{0};
+
+/*--------------------*/
+
+/** the number of calls suppressed by the rate limits in all call
+ * sites */
+static std::atomic<std::uint64_t> _totalSuppressedCallCount{0};
+
+/*--------------------*/
+
+/** the first call site in the registry of limited call sites */
+static std::atomic<BaseModules::LoggingCallSite*> _callSiteListHead{
+    nullptr};
+
 /*--------------------*/
 /* Prototypes         */
 /*--------------------*/
@@ -383,9 +586,296 @@ static String _functionNameFromSignature (IN String& functionSignature,
 /*--------------------*/
 /*--------------------*/
 
+/**
+ * Returns the current time of the steady clock in whole seconds.
+ *
+ * @return  current second
+ */
+static std::uint64_t _currentSecond ()
+{
+    const auto duration = steady_clock::now().time_since_epoch();
+    return (std::uint64_t) duration_cast<seconds>(duration).count();
+}
+
+/*--------------------*/
+
+/**
+ * Returns the natural number in environment variable
+ * <C>variableName</C> (zero when it is not set or not a number).
+ *
+ * @param[in] variableName  name of environment variable
+ * @return  value of variable
+ */
+static Natural _naturalFromEnvironment (IN char* variableName)
+{
+    const char* value = getenv(variableName);
+    return Natural{value == nullptr ? 0
+                   : (size_t) strtoull(value, nullptr, 10)};
+}
+
+/*--------------------*/
+
+/**
+ * Hands <C>bufferEntry</C> to the callback function or adds it to
+ * buffer (and writes it through to the file when applicable).
+ *
+ * @param[inout] bufferEntry  logging buffer entry to be processed
+ */
+static void _processEntry (INOUT _LoggingBufferEntry& bufferEntry)
+{
+    if (_callbackFunction != NULL) {
+        String st = _bufferEntryToString(bufferEntry);
+        _callbackFunction(st);
+    } else {
+        _buffer.append(bufferEntry);
+
+        if (_loggingState == _LoggingState::inWriteThroughMode) {
+            _writeBufferToFile();
+        }
+    }
+}
+
+/*--------------------*/
+
+/**
+ * Copies at most <C>capacity</C> - 1 characters of <C>st</C> into
+ * <C>target</C> and terminates it by a zero.
+ *
+ * @param[out] target    the character array to be filled
+ * @param[in]  st        the string to be copied
+ * @param[in]  capacity  the capacity of the target array
+ */
+static void _copyText (OUT char* target,
+                       IN String& st,
+                       IN size_t capacity)
+{
+    const size_t length = (st.size() < capacity ? st.size()
+                           : capacity - 1);
+    std::memcpy(target, st.c_str(), length);
+    target[length] = 0;
+}
+
+/*--------------------*/
+
+/**
+ * Puts an entry consisting of <C>functionSignature</C>,
+ * <C>time</C> and <C>message</C> into the next free slot of the
+ * asynchronous ring; several callers may do this concurrently
+ * without locking by claiming a ring position via a
+ * compare-and-swap; when the ring is full, the entry is dropped and
+ * counted.
+ *
+ * @param[in] functionSignature  signature of current function
+ * @param[in] time               time of entry
+ * @param[in] message            the logging message
+ */
+static void _pushAsynchronousEntry (IN String& functionSignature,
+                                    IN Timestamp time,
+                                    IN String& message)
+{
+    BaseModules::_AsyncLoggingSlot* slot = nullptr;
+    size_t position =
+        _asyncEnqueuePosition.load(std::memory_order_relaxed);
+    Boolean isDone = false;
+
+    while (!isDone) {
+        BaseModules::_AsyncLoggingSlot& candidate =
+            _asyncRing[position % _asyncRingLength];
+        const size_t sequenceNumber =
+            candidate.sequenceNumber.load(std::memory_order_acquire);
+
+        if (sequenceNumber == position) {
+            /* slot is free for this position: try to claim it */
+            if (_asyncEnqueuePosition.compare_exchange_weak(
+                    position, position + 1,
+                    std::memory_order_relaxed)) {
+                slot = &candidate;
+                isDone = true;
+            }
+        } else if (sequenceNumber < position) {
+            /* slot still holds an entry from the previous round:
+               ring is full */
+            _droppedEntryCount.fetch_add(1, std::memory_order_relaxed);
+            isDone = true;
+        } else {
+            /* another caller has claimed the position */
+            position =
+                _asyncEnqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    if (slot != nullptr) {
+        slot->systemTime = time;
+        _copyText(slot->functionSignature, functionSignature,
+                  _asyncSignatureCapacity);
+        _copyText(slot->message, message, _asyncMessageCapacity);
+        slot->sequenceNumber.store(position + 1,
+                                   std::memory_order_release);
+    }
+}
+
+/*--------------------*/
+
+/**
+ * Takes the oldest filled slot from the asynchronous ring into
+ * <C>bufferEntry</C> and tells whether there was one; must only be
+ * called by the asynchronous writer.
+ *
+ * @param[out] bufferEntry  logging buffer entry to be filled
+ * @return  information whether an entry has been taken
+ */
+static Boolean _popAsynchronousEntry (OUT _LoggingBufferEntry& bufferEntry)
+{
+    BaseModules::_AsyncLoggingSlot& slot =
+        _asyncRing[_asyncDequeuePosition % _asyncRingLength];
+    const size_t sequenceNumber =
+        slot.sequenceNumber.load(std::memory_order_acquire);
+    const Boolean isFilled = (sequenceNumber == _asyncDequeuePosition + 1);
+
+    if (isFilled) {
+        bufferEntry.functionSignature = slot.functionSignature;
+        bufferEntry.systemTime        = slot.systemTime;
+        bufferEntry.message           = slot.message;
+        slot.sequenceNumber.store(_asyncDequeuePosition + _asyncRingLength,
+                                  std::memory_order_release);
+        _asyncDequeuePosition++;
+    }
+
+    return isFilled;
+}
+
+/*--------------------*/
+
+/**
+ * Processes all entries in the asynchronous ring and reports newly
+ * dropped entries.
+ */
+static void _drainAsynchronousEntries ()
+{
+    std::lock_guard<std::mutex> lock{_loggingMutex};
+    _LoggingBufferEntry bufferEntry;
+
+    while (_popAsynchronousEntry(bufferEntry)) {
+        _processEntry(bufferEntry);
+    }
+
+    const size_t droppedEntryCount =
+        _droppedEntryCount.load(std::memory_order_relaxed);
+
+    if (droppedEntryCount != _reportedDroppedEntryCount) {
+        const Natural count{droppedEntryCount
+                            - _reportedDroppedEntryCount};
+        _LoggingBufferEntry overflowEntry =
+            {"", 0, STR::expand("LOGGING OVERFLOW: %1 entries dropped",
+                                TOSTRING(count))};
+        _processEntry(overflowEntry);
+        _reportedDroppedEntryCount = droppedEntryCount;
+    }
+}
+
+/*--------------------*/
+
+/**
+ * Runs the loop of the asynchronous writer thread: formats and
+ * writes the entries from the ring and sleeps when it is empty;
+ * the ring is drained once more after a stop request.  Once per
+ * second the calls suppressed by the rate limits are summarized.
+ */
+static void _runAsynchronousWriter ()
+{
+    Boolean isStopped = false;
+    steady_clock::time_point summaryTime = steady_clock::now();
+
+    while (!isStopped) {
+        isStopped = _asyncWriterIsStopped.load(std::memory_order_acquire);
+
+        if (steady_clock::now() - summaryTime
+            >= seconds(_suppressionSummaryInterval)) {
+            summaryTime = steady_clock::now();
+            Logging::writeSuppressionSummary();
+        }
+
+        _drainAsynchronousEntries();
+
+        if (!isStopped) {
+            std::this_thread::sleep_for(
+                std::chrono::milliseconds(_asyncWriterSleepTime));
+        }
+    }
+}
+
+/*--------------------*/
+
+/**
+ * Records a span event of kind <C>phase</C> for span <C>name</C>
+ * and object <C>instance</C> when span tracing is active; the slot
+ * is claimed by an atomic increment, events beyond the buffer
+ * length are dropped.
+ *
+ * @param[in] phase     kind of event ('B' or 'E')
+ * @param[in] name      name of span
+ * @param[in] instance  address of object doing the work
+ */
+static void _recordSpanEvent (IN char phase,
+                              IN char* name,
+                              IN void* instance)
+{
+    if (_spanTracingIsActive.load(std::memory_order_acquire)) {
+        const steady_clock::duration d =
+            steady_clock::now() - _spanStartTime;
+        const size_t position =
+            _spanEventCount.fetch_add(1, std::memory_order_relaxed);
+
+        if (position < _spanBufferLength) {
+            BaseModules::_SpanEvent& event = _spanBuffer[position];
+            event.phase      = phase;
+            event.name       = name;
+            event.instance   = instance;
+            event.threadHash =
+                std::hash<std::thread::id>{}(std::this_thread::get_id());
+            event.timestamp  =
+                (std::int64_t) duration_cast<nanoseconds>(d).count();
+            event.isComplete.store(true, std::memory_order_release);
+        }
+    }
+}
+
+/*--------------------*/
+
+/**
+ * Returns the JSON trace line for span event <C>event</C> with
+ * thread number <C>threadIndex</C>.
+ *
+ * @param[in] event        span event to be converted
+ * @param[in] threadIndex  number of thread in trace
+ * @return  JSON object for event
+ */
+static String _spanEventToString (IN BaseModules::_SpanEvent& event,
+                                  IN Natural threadIndex)
+{
+    /* the trace format expects microseconds */
+    const Natural timestamp{(size_t) event.timestamp};
+    const String timeString =
+        STR::expand("%1.%2",
+                    TOSTRING(timestamp / 1000),
+                    TOSTRING(timestamp % 1000, 3));
+    const String instanceString =
+        STR::toStringWithBase(Natural{(size_t) event.instance}, 16);
+    return STR::expand("{\"name\": \"%1\", \"cat\": \"SoX\","
+                       " \"ph\": \"%2\", \"ts\": %3, \"pid\": 1,"
+                       " \"tid\": %4,"
+                       " \"args\": {\"instance\": \"0x%5\"}}",
+                       String{event.name}, String(1, event.phase),
+                       timeString, TOSTRING(threadIndex),
+                       instanceString);
+}
+
+/*--------------------*/
+
 /**
  * Adds a new entry consisting of <C>functionSignature</C>,
- * <C>time</C> and <C>message</C> to buffer.
+ * <C>time</C> and <C>message</C> to buffer; in asynchronous mode
+ * the entry is only put into the ring for the writer thread.
  *
  * @param[in] functionSignature  signature of current function
  * @param[in] time               time of entry (0 signifies an entry
@@ -398,17 +888,12 @@ void _appendEntryToBuffer (IN String& functionSignature,
                            IN String& message)
 {
     if (_isActive) {
-        _LoggingBufferEntry bufferEntry = {functionSignature, time, message};
-
-        if (_callbackFunction != NULL) {
-            String st = _bufferEntryToString(bufferEntry);
-            _callbackFunction(st);
+        if (_isAsynchronous.load(std::memory_order_acquire)) {
+            _pushAsynchronousEntry(functionSignature, time, message);
         } else {
-            _buffer.append(bufferEntry);
-            
-            if (_loggingState == _LoggingState::inWriteThroughMode) {
-                _writeBufferToFile();
-            }
+            _LoggingBufferEntry bufferEntry =
+                {functionSignature, time, message};
+            _processEntry(bufferEntry);
         }
     }
 }
@@ -556,6 +1041,8 @@ void Logging::initialize ()
     _buffer.clear();
     _isActive = true;
     _appendEntryToBuffer("", 0, "START LOGGING -*- coding: utf-8 -*-");
+    setRateLimit(_naturalFromEnvironment(_samplingPeriodVariableName),
+                 _naturalFromEnvironment(_maximumRateVariableName));
 }
 
 /*--------------------*/
@@ -580,6 +1067,9 @@ Logging::initializeWithDefaults (IN String& fileNameStem,
 
 void Logging::finalize ()
 {
+    setAsynchronous(false);
+    writeSuppressionSummary();
+
     if (_loggingState != _LoggingState::isDone) {
         _appendEntryToBuffer("", 0, "END LOGGING");
 
@@ -610,9 +1100,48 @@ void Logging::setActive (IN Boolean isActive)
 
 /*--------------------*/
 
+void Logging::setAsynchronous (IN Boolean isAsynchronous)
+{
+    if (isAsynchronous != _isAsynchronous.load()) {
+        if (isAsynchronous) {
+            if (_asyncRing == nullptr) {
+                _asyncRing =
+                    new BaseModules::_AsyncLoggingSlot[_asyncRingLength];
+            }
+
+            for (size_t i = 0;  i < _asyncRingLength;  i++) {
+                _asyncRing[i].sequenceNumber.store(i);
+            }
+
+            _asyncEnqueuePosition.store(0);
+            _asyncDequeuePosition = 0;
+            _asyncWriterIsStopped.store(false);
+            _asyncWriterThread = std::thread(_runAsynchronousWriter);
+            _isAsynchronous.store(true, std::memory_order_release);
+        } else {
+            /* the ring is kept, since some caller might still be
+               putting an entry into it */
+            _isAsynchronous.store(false, std::memory_order_release);
+            _asyncWriterIsStopped.store(true, std::memory_order_release);
+            _asyncWriterThread.join();
+            _drainAsynchronousEntries();
+        }
+    }
+}
+
+/*--------------------*/
+
+Natural Logging::droppedEntryCount ()
+{
+    return Natural{_droppedEntryCount.load()};
+}
+
+/*--------------------*/
+
 void
 Logging::setCallbackFunction (IN LoggingCallbackFunction callbackFunction)
 {
+    std::lock_guard<std::mutex> lock{_loggingMutex};
     _callbackFunction = callbackFunction;
 }
 
@@ -621,6 +1150,8 @@ Logging::setCallbackFunction (IN LoggingCallbackFunction callbackFunction)
 void Logging::setFileName (IN String& fileName,
                            IN Boolean writeThroughIsActive)
 {
+    std::lock_guard<std::mutex> lock{_loggingMutex};
+
     if (_fileName == fileName) {
         const String message =
             STR::expand("logging file %1 already open => skip", fileName);
@@ -651,6 +1182,7 @@ void Logging::setFileName (IN String& fileName,
 
 void Logging::setIgnoredFunctionNamePrefix (IN String& namePrefix)
 {
+    std::lock_guard<std::mutex> lock{_loggingMutex};
     _ignoredFunctionNamePrefix = namePrefix;
 }
 
@@ -659,6 +1191,7 @@ void Logging::setIgnoredFunctionNamePrefix (IN String& namePrefix)
 void Logging::setTracingWithTime (IN Boolean timeIsLogged,
                                   IN Natural fractionalDigitCount)
 {
+    std::lock_guard<std::mutex> lock{_loggingMutex};
     _timeIsLogged = timeIsLogged;
     _loggingTime.setFractionalDigitCount(fractionalDigitCount);
 }
@@ -680,3 +1213,219 @@ void Logging::traceError (IN String& functionSignature,
 {
     trace(functionSignature, "--: ERROR - " + message);
 }
+
+/*--------------------*/
+/* rate limiting      */
+/*--------------------*/
+
+void Logging::setRateLimit (IN Natural samplingPeriod,
+                            IN Natural maximumCallsPerSecond)
+{
+    writeSuppressionSummary();
+    _samplingPeriod.store((std::uint64_t) samplingPeriod,
+                          std::memory_order_relaxed);
+    _maximumCallsPerSecond.store((std::uint64_t) maximumCallsPerSecond,
+                                 std::memory_order_relaxed);
+    _isRateLimited.store(samplingPeriod > 1 || maximumCallsPerSecond > 0,
+                         std::memory_order_relaxed);
+}
+
+/*--------------------*/
+
+Boolean Logging::isRateLimited ()
+{
+    return _isRateLimited.load(std::memory_order_relaxed);
+}
+
+/*--------------------*/
+
+Natural Logging::suppressedCallCount ()
+{
+    return Natural{_totalSuppressedCallCount
+                   .load(std::memory_order_relaxed)};
+}
+
+/*--------------------*/
+
+void Logging::writeSuppressionSummary ()
+{
+    for (BaseModules::LoggingCallSite* callSite =
+             _callSiteListHead.load(std::memory_order_acquire);
+         callSite != nullptr;  callSite = callSite->nextCallSite()) {
+        callSite->writeSuppressionSummary();
+    }
+}
+
+/*--------------------*/
+/* span tracing       */
+/*--------------------*/
+
+void Logging::setSpanTracing (IN Boolean isEnabled)
+{
+    if (isEnabled != _spanTracingIsActive.load()) {
+        if (isEnabled) {
+            if (_spanBuffer == nullptr) {
+                _spanBuffer =
+                    new BaseModules::_SpanEvent[_spanBufferLength];
+            }
+
+            for (size_t i = 0;  i < _spanBufferLength;  i++) {
+                _spanBuffer[i].isComplete.store(false);
+            }
+
+            _spanEventCount.store(0);
+            _spanStartTime = steady_clock::now();
+        }
+
+        _spanTracingIsActive.store(isEnabled, std::memory_order_release);
+    }
+}
+
+/*--------------------*/
+
+void Logging::beginSpan (IN char* name, IN void* instance)
+{
+    _recordSpanEvent('B', name, instance);
+}
+
+/*--------------------*/
+
+void Logging::endSpan (IN char* name, IN void* instance)
+{
+    _recordSpanEvent('E', name, instance);
+}
+
+/*--------------------*/
+
+Natural Logging::droppedSpanCount ()
+{
+    const size_t eventCount = _spanEventCount.load();
+    return Natural{eventCount > _spanBufferLength
+                   ? eventCount - _spanBufferLength : 0};
+}
+
+/*--------------------*/
+
+Boolean Logging::writeSpanTrace (IN String& fileName)
+{
+    File file;
+    const Boolean isOkay = file.open(fileName, "w");
+
+    if (isOkay) {
+        const size_t eventCount =
+            std::min(_spanEventCount.load(std::memory_order_acquire),
+                     _spanBuffer == nullptr ? 0 : _spanBufferLength);
+        GenericList<size_t> threadHashList;
+        String separator = "\n";
+        file.writeString("{\"traceEvents\": [");
+
+        for (size_t i = 0;  i < eventCount;  i++) {
+            const BaseModules::_SpanEvent& event = _spanBuffer[i];
+
+            if (event.isComplete.load(std::memory_order_acquire)) {
+                const Integer position =
+                    threadHashList.position(event.threadHash);
+                const Natural threadIndex =
+                    (position < 0 ? Natural{threadHashList.size()}
+                     : (Natural) position);
+
+                if (position < 0) {
+                    threadHashList.append(event.threadHash);
+                }
+
+                file.writeString(separator
+                                 + _spanEventToString(event,
+                                                      threadIndex + 1));
+                separator = ",\n";
+            }
+        }
+
+        file.writeString("\n],\n\"displayTimeUnit\": \"ns\"}\n");
+        file.close();
+    }
+
+    return isOkay;
+}
+
+/*====================*/
+
+using BaseModules::LoggingCallSite;
+
+/*--------------------*/
+
+Boolean LoggingCallSite::admits (IN char* functionSignature)
+{
+    Boolean isAdmitted = true;
+
+    if (_isRateLimited.load(std::memory_order_relaxed)) {
+        if (!_isRegistered.load(std::memory_order_relaxed)
+            && !_isRegistered.exchange(true)) {
+            /* the site is published with its signature by a
+               lock-free push onto the registry */
+            _functionSignature = functionSignature;
+            _nextCallSite = _callSiteListHead.load();
+
+            while (!_callSiteListHead.compare_exchange_weak(
+                        _nextCallSite, this,
+                        std::memory_order_release)) {
+            }
+        }
+
+        const std::uint64_t samplingPeriod =
+            _samplingPeriod.load(std::memory_order_relaxed);
+        const std::uint64_t maximumCallCount =
+            _maximumCallsPerSecond.load(std::memory_order_relaxed);
+        const std::uint64_t callNumber =
+            _callCount.fetch_add(1, std::memory_order_relaxed);
+        isAdmitted = (samplingPeriod <= 1
+                      || callNumber % samplingPeriod == 0);
+
+        if (isAdmitted && maximumCallCount > 0) {
+            /* the first call in a new second restarts the window */
+            const std::uint64_t second = _currentSecond();
+            std::uint64_t windowStartTime =
+                _windowStartTime.load(std::memory_order_relaxed);
+
+            if (second != windowStartTime
+                && _windowStartTime.compare_exchange_strong(
+                       windowStartTime, second,
+                       std::memory_order_relaxed)) {
+                _windowCallCount.store(0, std::memory_order_relaxed);
+            }
+
+            isAdmitted =
+                (_windowCallCount.fetch_add(1, std::memory_order_relaxed)
+                 < maximumCallCount);
+        }
+
+        if (isAdmitted) {
+            writeSuppressionSummary();
+        } else {
+            _suppressedCallCount.fetch_add(1, std::memory_order_relaxed);
+            _totalSuppressedCallCount.fetch_add(1,
+                                                std::memory_order_relaxed);
+        }
+    }
+
+    return isAdmitted;
+}
+
+/*--------------------*/
+
+void LoggingCallSite::writeSuppressionSummary ()
+{
+    if (_suppressedCallCount.load(std::memory_order_relaxed) > 0) {
+        const std::uint64_t count =
+            _suppressedCallCount.exchange(0, std::memory_order_relaxed);
+        Logging::trace(_functionSignature,
+                       STR::expand("--: %1 calls suppressed by rate"
+                                   " limit", TOSTRING(Natural{count})));
+    }
+}
+
+/*--------------------*/
+
+LoggingCallSite* LoggingCallSite::nextCallSite () const
+{
+    return _nextCallSite;
+}
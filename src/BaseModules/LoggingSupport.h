@@ -5,7 +5,10 @@
  * this logging relies on trace calls at the beginning or end of a
  * function with prefices ">>" and "<<" as well as intermediate log
  * lines with prefix "--"; the name of the function is also logged to
- * give a fully bracketed log.
+ * give a fully bracketed log; additionally begin and end events of
+ * processing spans may be recorded into a lock-free buffer and
+ * exported as a Chrome trace; each trace call site may be rate
+ * limited.
  *
  * @author Dr. Thomas Tensi
  * @date   2021-02
@@ -19,6 +22,8 @@
 /* IMPORTS */
 /*=========*/
 
+#include <atomic>
+#include <cstdint>
 #include "Boolean.h"
 #include "Natural.h"
 
@@ -101,6 +106,34 @@ namespace BaseModules {
 
         /*--------------------*/
 
+        /**
+         * Sets logging to asynchronous or synchronous mode due to
+         * <C>isAsynchronous</C>.  In asynchronous mode a logging
+         * call only copies its signature and message into a
+         * preallocated slot of a lock-free ring and a background
+         * thread formats the entries and hands them to the file or
+         * callback; when the ring is full, entries are dropped and
+         * counted instead of blocking the caller.  Switching the
+         * mode starts or stops the background thread, hence must
+         * not be done on an audio thread.
+         *
+         * @param[in] isAsynchronous  tells whether logging shall be
+         *                            done by a background thread
+         */
+        static void setAsynchronous (IN Boolean isAsynchronous);
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of entries dropped in asynchronous
+         * mode because the ring was full.
+         *
+         * @return  count of dropped logging entries
+         */
+        static Natural droppedEntryCount ();
+
+        /*--------------------*/
+
         /**
          * Sets callback function for logging to <C>callback
          * function</C>. Using NULL resets the callback mechanism.
@@ -177,6 +210,289 @@ namespace BaseModules {
         static void traceError (IN String& functionSignature,
                                 IN String& message);
 
+        /*--------------------*/
+        /* rate limiting      */
+        /*--------------------*/
+
+        /**
+         * Limits the traces of each call site: only every
+         * <C>samplingPeriod</C>-th call of a site is logged and of
+         * those at most <C>maximumCallsPerSecond</C> per second (a
+         * zero value switches the respective limit off, both zero
+         * log all calls, which is the default).  The calls
+         * suppressed at a site are summarized in a single entry
+         * when it logs its next call and periodically by
+         * <C>writeSuppressionSummary</C>.  Pending summaries are
+         * written before the limits change.
+         *
+         * The initial limits are taken from the environment
+         * variables <C>LOGGING_SAMPLING_PERIOD</C> and
+         * <C>LOGGING_MAXIMUM_RATE</C> (in calls per second and site)
+         * by <C>initialize</C>.
+         *
+         * @param[in] samplingPeriod         the distance of logged
+         *                                   calls of a site
+         * @param[in] maximumCallsPerSecond  the maximum number of
+         *                                   logged calls per second
+         *                                   of a site
+         */
+        static void setRateLimit (IN Natural samplingPeriod,
+                                  IN Natural maximumCallsPerSecond);
+
+        /*--------------------*/
+
+        /**
+         * Tells whether some rate limit is set.
+         *
+         * @return  information whether trace calls are limited
+         */
+        static Boolean isRateLimited ();
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of trace calls suppressed by the rate
+         * limits so far.
+         *
+         * @return  count of suppressed trace calls
+         */
+        static Natural suppressedCallCount ();
+
+        /*--------------------*/
+
+        /**
+         * Writes an entry for each call site with calls suppressed
+         * since its last summary; the asynchronous writer does this
+         * once per second and <C>finalize</C> at the end.
+         */
+        static void writeSuppressionSummary ();
+
+        /*--------------------*/
+        /* span tracing       */
+        /*--------------------*/
+
+        /**
+         * Starts or stops the recording of processing spans due to
+         * <C>isEnabled</C>.  Starting empties the span buffer
+         * (allocated on first use) and restarts the trace clock;
+         * hence it must not be done on an audio thread or while
+         * some other thread still records a span.
+         *
+         * @param[in] isEnabled  tells whether spans are recorded
+         */
+        static void setSpanTracing (IN Boolean isEnabled);
+
+        /*--------------------*/
+
+        /**
+         * Records the begin of a span named <C>name</C> for the
+         * object <C>instance</C> on the current thread.  This call
+         * neither waits nor allocates: it claims the next slot of a
+         * preallocated buffer by an atomic increment; when the
+         * buffer is full, the event is dropped and counted.
+         *
+         * @param[in] name      name of span (a string literal
+         *                      without quotes or backslashes)
+         * @param[in] instance  address of object doing the work
+         */
+        static void beginSpan (IN char* name, IN void* instance);
+
+        /*--------------------*/
+
+        /**
+         * Records the end of a span named <C>name</C> for the object
+         * <C>instance</C> on the current thread (like
+         * <C>beginSpan</C>).
+         *
+         * @param[in] name      name of span (a string literal
+         *                      without quotes or backslashes)
+         * @param[in] instance  address of object doing the work
+         */
+        static void endSpan (IN char* name, IN void* instance);
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of span events dropped since the start
+         * of span tracing because the span buffer was full.
+         *
+         * @return  count of dropped span events
+         */
+        static Natural droppedSpanCount ();
+
+        /*--------------------*/
+
+        /**
+         * Writes all span events recorded since the start of span
+         * tracing to file <C>fileName</C> in the JSON trace event
+         * format of Chrome (readable by chrome://tracing and the
+         * Perfetto UI) and tells whether the file could be written;
+         * the threads are numbered in the order of their first
+         * event and the instance addresses are given as arguments.
+         * Should only be called while span tracing is stopped or
+         * from a thread not recording spans.
+         *
+         * @param[in] fileName  name of trace file
+         * @return  information whether trace file has been written
+         */
+        static Boolean writeSpanTrace (IN String& fileName);
+
+    };
+
+    /*====================*/
+
+    /**
+     * A <C>LoggingCallSite</C> object is the state of a single trace
+     * call site for rate limiting (see <C>Logging::setRateLimit</C>);
+     * the trace macros put one into a function-local static.  It is
+     * constant initialized, hence such a static costs no guard, and
+     * all counters are relaxed atomics, such that concurrent calls
+     * of a site neither lock nor allocate (the limits are only kept
+     * approximately under contention).  A site registers itself in a
+     * lock-free process-wide list on its first limited call, such
+     * that its suppressed calls can be summarized later.
+     */
+    struct LoggingCallSite {
+
+        /**
+         * Makes a call site without calls.
+         */
+        constexpr LoggingCallSite ()
+            : _callCount{0},
+              _windowStartTime{0},
+              _windowCallCount{0},
+              _suppressedCallCount{0},
+              _isRegistered{false},
+              _functionSignature{nullptr},
+              _nextCallSite{nullptr}
+        {
+        }
+
+        /*--------------------*/
+
+        LoggingCallSite (IN LoggingCallSite&) = delete;
+
+        /*--------------------*/
+
+        LoggingCallSite& operator= (IN LoggingCallSite&) = delete;
+
+        /*--------------------*/
+
+        /**
+         * Counts a call of the site in function
+         * <C>functionSignature</C> and tells whether it shall be
+         * logged according to the rate limits; before an admitted
+         * call the calls suppressed since the last summary are
+         * summarized.
+         *
+         * @param[in] functionSignature  signature of enclosing
+         *                               function
+         * @return  information whether call is logged
+         */
+        Boolean admits (IN char* functionSignature);
+
+        /*--------------------*/
+
+        /**
+         * Writes an entry with the number of calls suppressed since
+         * the last summary (if any).
+         */
+        void writeSuppressionSummary ();
+
+        /*--------------------*/
+
+        /**
+         * Returns the next registered call site (or null for the
+         * last one).
+         *
+         * @return  next call site in registry
+         */
+        LoggingCallSite* nextCallSite () const;
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the number of limited calls of the site */
+            std::atomic<std::uint64_t> _callCount;
+
+            /** the second of the steady clock of the current rate
+             * window */
+            std::atomic<std::uint64_t> _windowStartTime;
+
+            /** the number of logged calls in the current rate
+             * window */
+            std::atomic<std::uint64_t> _windowCallCount;
+
+            /** the number of calls suppressed since the last
+             * summary */
+            std::atomic<std::uint64_t> _suppressedCallCount;
+
+            /** tells whether the site is in the registry */
+            std::atomic<bool> _isRegistered;
+
+            /** the signature of the enclosing function (set on
+             * registration) */
+            const char* _functionSignature;
+
+            /** the next site in the registry */
+            LoggingCallSite* _nextCallSite;
+
+    };
+
+    /*====================*/
+
+    /**
+     * A <C>LoggingSpan</C> object records a processing span from its
+     * construction to its destruction, i.e. for the enclosing scope
+     * (see <C>Logging::beginSpan</C>).
+     */
+    struct LoggingSpan {
+
+        /**
+         * Records the begin of span <C>name</C> for
+         * <C>instance</C>.
+         *
+         * @param[in] name      name of span (a string literal)
+         * @param[in] instance  address of object doing the work
+         */
+        LoggingSpan (IN char* name, IN void* instance)
+            : _name{name},
+              _instance{instance}
+        {
+            Logging::beginSpan(name, instance);
+        }
+
+        /*--------------------*/
+
+        /**
+         * Records the end of the span.
+         */
+        ~LoggingSpan ()
+        {
+            Logging::endSpan(_name, _instance);
+        }
+
+        /*--------------------*/
+
+        LoggingSpan (IN LoggingSpan&) = delete;
+
+        /*--------------------*/
+
+        LoggingSpan& operator= (IN LoggingSpan&) = delete;
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the name of the span */
+            const char* _name;
+
+            /** the address of the object doing the work */
+            const void* _instance;
+
     };
 
 }
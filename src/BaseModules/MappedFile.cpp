@@ -0,0 +1,232 @@
+/**
+ * @file
+ * The <C>MappedFile</C> body implements a class for read-only memory
+ * mapped files with access hints for sequential scans.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "MappedFile.h"
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+/*--------------------*/
+
+using BaseModules::MappedFile;
+
+/*====================*/
+
+#ifdef _WIN32
+
+    /* mapping is not supported, the readers use buffered I/O */
+
+#else
+
+    /**
+     * Returns the system page size.
+     *
+     * @return  page size in bytes
+     */
+    static size_t _pageSize ()
+    {
+        static const size_t pageSize = (size_t) sysconf(_SC_PAGESIZE);
+        return pageSize;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies <C>advice</C> to the complete pages of the mapping
+     * at <C>data</C> within the <C>count</C> bytes at
+     * <C>position</C>; when <C>isWidened</C> is set, the range is
+     * widened to complete pages instead.
+     *
+     * @param[in] data       start address of mapping
+     * @param[in] length     length of mapping
+     * @param[in] position   byte position of range
+     * @param[in] count      number of bytes in range
+     * @param[in] advice     madvise advice code
+     * @param[in] isWidened  information whether partial pages are
+     *                       included
+     */
+    static void _advise (IN std::uint8_t* data,
+                         IN size_t length,
+                         IN size_t position,
+                         IN size_t count,
+                         IN int advice,
+                         IN bool isWidened)
+    {
+        const size_t pageSize = _pageSize();
+        const size_t endPosition =
+            (position + count < length ? position + count : length);
+        const size_t startPage =
+            (isWidened ? position / pageSize
+             : (position + pageSize - 1) / pageSize) * pageSize;
+        const size_t endPage =
+            (isWidened ? (endPosition + pageSize - 1) / pageSize
+             : endPosition / pageSize) * pageSize;
+
+        if (startPage < endPage) {
+            madvise((void*) (data + startPage), endPage - startPage,
+                    advice);
+        }
+    }
+
+#endif
+
+/*====================*/
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+MappedFile::MappedFile ()
+    : _data{nullptr},
+      _length{0}
+{
+}
+
+/*--------------------*/
+
+MappedFile::~MappedFile ()
+{
+    close();
+}
+
+/*--------------------*/
+/* status change      */
+/*--------------------*/
+
+Boolean MappedFile::open (IN String& fileName)
+{
+    close();
+    Boolean isOkay = false;
+
+    #ifndef _WIN32
+        const int descriptor = ::open(fileName.c_str(), O_RDONLY);
+        struct stat status;
+
+        if (descriptor >= 0) {
+            if (fstat(descriptor, &status) == 0 && status.st_size > 0) {
+                const size_t length = (size_t) status.st_size;
+                void* address = mmap(nullptr, length, PROT_READ,
+                                     MAP_PRIVATE, descriptor, 0);
+
+                if (address != MAP_FAILED) {
+                    _data = (std::uint8_t*) address;
+                    _length = length;
+                    isOkay = true;
+                }
+            }
+
+            /* the mapping stays valid after the descriptor is
+               closed */
+            ::close(descriptor);
+        }
+    #endif
+
+    return isOkay;
+}
+
+/*--------------------*/
+
+void MappedFile::close ()
+{
+    if (_data != nullptr) {
+        #ifndef _WIN32
+            munmap((void*) _data, (size_t) _length);
+        #endif
+
+        _data = nullptr;
+        _length = 0;
+    }
+}
+
+/*--------------------*/
+/* access             */
+/*--------------------*/
+
+const std::uint8_t* MappedFile::data () const
+{
+    return _data;
+}
+
+/*--------------------*/
+
+Natural MappedFile::length () const
+{
+    return _length;
+}
+
+/*--------------------*/
+/* access hints       */
+/*--------------------*/
+
+void MappedFile::adviseSequentialAccess ()
+{
+    #ifndef _WIN32
+        if (_data != nullptr) {
+            madvise((void*) _data, (size_t) _length, MADV_SEQUENTIAL);
+        }
+    #endif
+}
+
+/*--------------------*/
+
+void MappedFile::prefetch (IN Natural position, IN Natural count)
+{
+    #ifndef _WIN32
+        if (_data != nullptr) {
+            _advise(_data, (size_t) _length, (size_t) position,
+                    (size_t) count, MADV_WILLNEED, true);
+        }
+    #else
+        (void) position;
+        (void) count;
+    #endif
+}
+
+/*--------------------*/
+
+void MappedFile::release (IN Natural position, IN Natural count)
+{
+    #ifndef _WIN32
+        if (_data != nullptr) {
+            _advise(_data, (size_t) _length, (size_t) position,
+                    (size_t) count, MADV_DONTNEED, false);
+        }
+    #else
+        (void) position;
+        (void) count;
+    #endif
+}
+
+/*--------------------*/
+/* queries            */
+/*--------------------*/
+
+Boolean MappedFile::isOpen () const
+{
+    return _data != nullptr;
+}
+
+/*--------------------*/
+
+Boolean MappedFile::isAvailable ()
+{
+    #ifdef _WIN32
+        return false;
+    #else
+        return true;
+    #endif
+}
@@ -0,0 +1,179 @@
+/**
+ * @file
+ * The <C>MappedFile</C> specification defines a class for read-only
+ * memory mapped files with access hints for sequential scans.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include <cstdint>
+#include "Boolean.h"
+#include "MyString.h"
+#include "Natural.h"
+
+/*--------------------*/
+
+using BaseTypes::Primitives::Boolean;
+using BaseTypes::Primitives::Natural;
+using BaseTypes::Primitives::String;
+
+/*====================*/
+
+namespace BaseModules {
+
+    /**
+     * A <C>MappedFile</C> object maps a complete file read-only into
+     * the address space.  Pages are only loaded on access, hence
+     * scanning a huge file through the mapping needs only memory for
+     * the pages currently touched, when consumed ranges are released
+     * again.  Mapping is only available on POSIX platforms; elsewhere
+     * <C>open</C> fails and callers have to fall back to buffered
+     * I/O via <C>File</C>.
+     */
+    struct MappedFile {
+
+        /*--------------------*/
+        /* con-/destruction   */
+        /*--------------------*/
+
+        /**
+         * Defines new mapped file object (without mapping a file)
+         */
+        MappedFile ();
+
+        /*--------------------*/
+
+        /**
+         * Constructs new mapped file from <C>otherFile</C>
+         * (NOT AVAILABLE!)
+         *
+         * @param[in] otherFile  file to be copied
+         */
+        MappedFile (IN MappedFile& otherFile) = delete;
+
+        /*--------------------*/
+
+        /**
+         * Destroys mapped file (and unmaps it before).
+         */
+        ~MappedFile ();
+
+        /*--------------------*/
+        /* status change      */
+        /*--------------------*/
+
+        /**
+         * Maps file given by <C>fileName</C> read-only and returns
+         * whether this has been successful.
+         *
+         * @param[in]  fileName  name of file to be mapped
+         * @return  information whether mapping has been successful
+         */
+        Boolean open (IN String& fileName);
+
+        /*--------------------*/
+
+        /**
+         * Unmaps file if still mapped.
+         */
+        void close ();
+
+        /*--------------------*/
+        /* access             */
+        /*--------------------*/
+
+        /**
+         * Returns the address of the first byte of the mapped file.
+         *
+         * @return  pointer to file data (nullptr when not mapped)
+         */
+        const std::uint8_t* data () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the length of the mapped file in bytes.
+         *
+         * @return  length of mapped file
+         */
+        Natural length () const;
+
+        /*--------------------*/
+        /* access hints       */
+        /*--------------------*/
+
+        /**
+         * Tells the operating system that the mapped file will be
+         * read sequentially (so that it reads ahead aggressively and
+         * drops pages behind).
+         */
+        void adviseSequentialAccess ();
+
+        /*--------------------*/
+
+        /**
+         * Tells the operating system that the <C>count</C> bytes at
+         * <C>position</C> will be needed soon.
+         *
+         * @param[in] position  byte position of range in file
+         * @param[in] count     number of bytes in range
+         */
+        void prefetch (IN Natural position, IN Natural count);
+
+        /*--------------------*/
+
+        /**
+         * Tells the operating system that the <C>count</C> bytes at
+         * <C>position</C> are not needed anymore, so that their
+         * pages can be dropped from memory; only complete pages
+         * within the range are released.
+         *
+         * @param[in] position  byte position of range in file
+         * @param[in] count     number of bytes in range
+         */
+        void release (IN Natural position, IN Natural count);
+
+        /*--------------------*/
+        /* queries            */
+        /*--------------------*/
+
+        /**
+         * Tells whether file is mapped (or not).
+         *
+         * @return  information whether file is mapped
+         */
+        Boolean isOpen () const;
+
+        /*--------------------*/
+
+        /**
+         * Tells whether memory mapping is supported on this
+         * platform.
+         *
+         * @return  information whether mapping is available
+         */
+        static Boolean isAvailable ();
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the start address of the mapping */
+            std::uint8_t* _data;
+
+            /** the length of the mapping in bytes */
+            Natural _length;
+
+    };
+
+}
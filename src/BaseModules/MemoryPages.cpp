@@ -0,0 +1,234 @@
+/**
+ * @file
+ * The <C>MemoryPages</C> body implements a class for the page
+ * handling of memory areas: prefaulting, locking in physical memory
+ * and allocation with large pages.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "MemoryPages.h"
+
+#include "Logging.h"
+#include "Natural.h"
+
+#ifdef _WIN32
+    #include "MyWindows.h"
+#else
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+/*--------------------*/
+
+using BaseModules::MemoryPages;
+using BaseTypes::Primitives::Natural;
+
+/*====================*/
+
+/** the size of a large page where the system does not tell (the
+ * huge page size of x86 and ARM processors) */
+static const size_t _defaultLargePageSize = 2 * 1024 * 1024;
+
+/*--------------------*/
+
+/**
+ * Returns <C>value</C> rounded up to a multiple of
+ * <C>granularity</C>.
+ *
+ * @param[in] value        value to be rounded
+ * @param[in] granularity  a power of two
+ * @return  rounded value
+ */
+static size_t _roundedUp (IN size_t value, IN size_t granularity)
+{
+    return (value + granularity - 1) & ~(granularity - 1);
+}
+
+/*--------------------*/
+
+/**
+ * Returns the length of the area really allocated for a request of
+ * <C>byteCount</C> bytes and tells in <C>isLarge</C> whether large
+ * pages are tried for it.
+ *
+ * @param[in]  byteCount  number of bytes requested
+ * @param[out] isLarge    information whether area gets large pages
+ * @return  length of allocated area
+ */
+static size_t _allocationLength (IN size_t byteCount,
+                                 OUT Boolean& isLarge)
+{
+    const size_t largePageSize = MemoryPages::largePageSize();
+    isLarge = (byteCount >= largePageSize);
+    return _roundedUp(byteCount,
+                      (isLarge ? largePageSize : MemoryPages::pageSize()));
+}
+
+/*====================*/
+
+size_t MemoryPages::pageSize ()
+{
+    #ifdef _WIN32
+        static const size_t result = 4096;
+    #else
+        static const size_t result = (size_t) sysconf(_SC_PAGESIZE);
+    #endif
+
+    return result;
+}
+
+/*--------------------*/
+
+size_t MemoryPages::largePageSize ()
+{
+    #ifdef _WIN32
+        static const size_t systemSize =
+            (size_t) Windows::GetLargePageMinimum();
+        static const size_t result =
+            (systemSize == 0 ? _defaultLargePageSize : systemSize);
+    #else
+        static const size_t result = _defaultLargePageSize;
+    #endif
+
+    return result;
+}
+
+/*--------------------*/
+
+void MemoryPages::prefault (INOUT void* address, IN size_t byteCount)
+{
+    Logging_trace1(">>: %1", TOSTRING(Natural{byteCount}));
+
+    /* a read alone could map a shared zero page, hence every page
+       gets a write of its own value */
+    volatile char* data = (volatile char*) address;
+    const size_t stepSize = pageSize();
+
+    for (size_t position = 0;  position < byteCount;
+         position += stepSize) {
+        data[position] = data[position];
+    }
+
+    if (byteCount > 0) {
+        data[byteCount - 1] = data[byteCount - 1];
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+Boolean MemoryPages::lock (IN void* address, IN size_t byteCount)
+{
+    Logging_trace1(">>: %1", TOSTRING(Natural{byteCount}));
+
+    #ifdef _WIN32
+        const Boolean isOkay =
+            (Windows::VirtualLock((Windows::LPVOID) address,
+                                  (Windows::SIZE_T) byteCount) != 0);
+    #else
+        const Boolean isOkay = (mlock(address, byteCount) == 0);
+    #endif
+
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+
+void MemoryPages::unlock (IN void* address, IN size_t byteCount)
+{
+    Logging_trace1(">>: %1", TOSTRING(Natural{byteCount}));
+
+    #ifdef _WIN32
+        Windows::VirtualUnlock((Windows::LPVOID) address,
+                               (Windows::SIZE_T) byteCount);
+    #else
+        munlock(address, byteCount);
+    #endif
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void* MemoryPages::allocateLarge (IN size_t byteCount)
+{
+    Logging_trace1(">>: %1", TOSTRING(Natural{byteCount}));
+
+    Boolean isLarge;
+    const size_t length = _allocationLength(byteCount, isLarge);
+    void* result = nullptr;
+
+    #ifdef _WIN32
+        /* large pages need the privilege to lock memory, otherwise
+           the allocation falls back to normal pages */
+        const Windows::DWORD allocationType = MEM_RESERVE | MEM_COMMIT;
+
+        if (isLarge) {
+            result = Windows::VirtualAlloc(nullptr,
+                                           (Windows::SIZE_T) length,
+                                           (allocationType
+                                            | MEM_LARGE_PAGES),
+                                           PAGE_READWRITE);
+        }
+
+        if (result == nullptr) {
+            result = Windows::VirtualAlloc(nullptr,
+                                           (Windows::SIZE_T) length,
+                                           allocationType,
+                                           PAGE_READWRITE);
+        }
+    #else
+        const int protection = PROT_READ | PROT_WRITE;
+        const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+        void* address = MAP_FAILED;
+
+        #ifdef MAP_HUGETLB
+            /* explicit huge pages are only available when the
+               administrator has reserved some */
+            if (isLarge) {
+                address = mmap(nullptr, length, protection,
+                               flags | MAP_HUGETLB, -1, 0);
+            }
+        #endif
+
+        if (address == MAP_FAILED) {
+            address = mmap(nullptr, length, protection, flags, -1, 0);
+
+            #ifdef MADV_HUGEPAGE
+                if (isLarge && address != MAP_FAILED) {
+                    madvise(address, length, MADV_HUGEPAGE);
+                }
+            #endif
+        }
+
+        result = (address == MAP_FAILED ? nullptr : address);
+    #endif
+
+    Logging_trace1("<<: %1", TOSTRING(Boolean{result != nullptr}));
+    return result;
+}
+
+/*--------------------*/
+
+void MemoryPages::freeLarge (IN void* address, IN size_t byteCount)
+{
+    Logging_trace1(">>: %1", TOSTRING(Natural{byteCount}));
+
+    #ifdef _WIN32
+        (void) byteCount;
+        Windows::VirtualFree((Windows::LPVOID) address, 0, MEM_RELEASE);
+    #else
+        Boolean isLarge;
+        munmap((void*) address, _allocationLength(byteCount, isLarge));
+    #endif
+
+    Logging_trace("<<");
+}
@@ -0,0 +1,134 @@
+/**
+ * @file
+ * The <C>MemoryPages</C> specification defines a class for the page
+ * handling of memory areas: prefaulting, locking in physical memory
+ * and allocation with large pages.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include <cstddef>
+#include "Boolean.h"
+
+/*--------------------*/
+
+using BaseTypes::Primitives::Boolean;
+
+/*====================*/
+
+namespace BaseModules {
+
+    /**
+     * The <C>MemoryPages</C> class provides routines for the pages
+     * of memory areas.  A freshly allocated area is normally only
+     * backed by physical memory on its first write, hence the first
+     * access of every page causes a page fault; on the audio thread
+     * such faults right after the start of playback may lead to
+     * dropouts.  Prefaulting an area moves those faults to the
+     * setup, locking an area additionally prevents that its pages
+     * are swapped out later.
+     *
+     * Large areas may also be allocated with large pages (explicit
+     * huge pages where the system provides some, otherwise
+     * transparent ones where supported) to reduce the misses of the
+     * translation lookaside buffer.  All routines fail gracefully:
+     * when a feature is not available, the area simply behaves like
+     * an ordinary one.
+     */
+    struct MemoryPages {
+
+        /**
+         * Returns the size of a normal memory page.
+         *
+         * @return  page size in bytes
+         */
+        static size_t pageSize ();
+
+        /*--------------------*/
+
+        /**
+         * Returns the size of a large memory page (the size used
+         * for rounding large page allocations).
+         *
+         * @return  large page size in bytes
+         */
+        static size_t largePageSize ();
+
+        /*--------------------*/
+
+        /**
+         * Touches every page of the <C>byteCount</C> bytes at
+         * <C>address</C> by rewriting one byte per page, such that
+         * all pages are backed by physical memory afterwards; the
+         * contents of the area are unchanged.  Must not be called
+         * while another thread writes to the area.
+         *
+         * @param[inout] address    start of area
+         * @param[in]    byteCount  length of area in bytes
+         */
+        static void prefault (INOUT void* address, IN size_t byteCount);
+
+        /*--------------------*/
+
+        /**
+         * Locks the pages of the <C>byteCount</C> bytes at
+         * <C>address</C> in physical memory and tells whether this
+         * has been permitted (the number of lockable pages is
+         * normally limited per process).
+         *
+         * @param[in] address    start of area
+         * @param[in] byteCount  length of area in bytes
+         * @return  information whether area has been locked
+         */
+        static Boolean lock (IN void* address, IN size_t byteCount);
+
+        /*--------------------*/
+
+        /**
+         * Unlocks the pages of the <C>byteCount</C> bytes at
+         * <C>address</C> previously locked by <C>lock</C>.
+         *
+         * @param[in] address    start of area
+         * @param[in] byteCount  length of area in bytes
+         */
+        static void unlock (IN void* address, IN size_t byteCount);
+
+        /*--------------------*/
+
+        /**
+         * Returns a zeroed area of at least <C>byteCount</C> bytes
+         * aligned to a page directly from the operating system;
+         * areas of at least a large page are backed by large pages
+         * where possible.  Returns nullptr when no memory is
+         * available.
+         *
+         * @param[in] byteCount  length of area in bytes
+         * @return  start of area or nullptr
+         */
+        static void* allocateLarge (IN size_t byteCount);
+
+        /*--------------------*/
+
+        /**
+         * Returns the area at <C>address</C> with <C>byteCount</C>
+         * bytes (as requested on allocation) to the operating
+         * system.
+         *
+         * @param[in] address    start of area from
+         *                       <C>allocateLarge</C>
+         * @param[in] byteCount  length of area in bytes
+         */
+        static void freeLarge (IN void* address, IN size_t byteCount);
+
+    };
+
+}
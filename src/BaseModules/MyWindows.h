@@ -20,6 +20,9 @@ namespace Windows {
     /* maximum path length */
     #define MAX_PATH 1000
 
+    /* maximum length of a computer name */
+    #define MAX_COMPUTERNAME_LENGTH 15
+
     /* constants for dynamic loading of libraries */
     #define LOAD_LIBRARY_SEARCH_DLL_LOAD_DIR     0x00000100
     #define LOAD_LIBRARY_SEARCH_APPLICATION_DIR  0x00000200
@@ -70,6 +73,16 @@ namespace Windows {
     /* logical font face size */
     #define LF_FACESIZE    32
 
+    /* virtual memory constants */
+    #define MEM_COMMIT      0x00001000
+    #define MEM_RESERVE     0x00002000
+    #define MEM_RELEASE     0x00008000
+    #define MEM_LARGE_PAGES 0x20000000
+    #define PAGE_READWRITE  0x04
+
+    /* thread priority constants */
+    #define THREAD_PRIORITY_TIME_CRITICAL  15
+
     /* raster operations for bitmap blitting */
     #define HALFTONE 4
     #define SRCCOPY 13369376
@@ -101,11 +114,14 @@ namespace Windows {
     #if defined(_WIN64)
        typedef __int64 LONG_PTR;
        typedef unsigned __int64 UINT_PTR;
+       typedef unsigned __int64 DWORD_PTR;
     #else
        typedef long LONG_PTR;
        typedef unsigned int UINT_PTR;
+       typedef unsigned long DWORD_PTR;
     #endif
 
+    typedef UINT_PTR SIZE_T;
     typedef WORD ATOM;
     typedef DWORD COLORREF;    
     typedef HANDLE HBITMAP;
@@ -294,10 +310,19 @@ namespace Windows {
 
     extern "C" DLLImport BOOL GetClientRect (HWND hWnd, LPRECT lpRect);
     
+    extern "C" DLLImport BOOL GetComputerNameA (char* lpBuffer,
+                                                DWORD* nSize);
+
+    extern "C" DLLImport HANDLE GetCurrentProcess ();
+
+    extern "C" DLLImport HANDLE GetCurrentThread ();
+
     extern "C" DLLImport HDC GetDC (HWND hWnd);
 
     extern "C" DLLImport DWORD GetLastError ();
 
+    extern "C" DLLImport SIZE_T GetLargePageMinimum ();
+
     extern "C" DLLImport BOOL GetMessageW (LPMSG lpMsg,
                                            HWND  hWnd,
                                            UINT  wMsgFilterMin,
@@ -319,6 +344,11 @@ namespace Windows {
     extern "C" DLLImport FARPROC STDCALL GetProcAddress (HMODULE hModule,
                                                          LPCSTR lpProcName);
 
+    extern "C" DLLImport BOOL GetProcessAffinityMask (
+                                        HANDLE     hProcess,
+                                        DWORD_PTR* lpProcessAffinityMask,
+                                        DWORD_PTR* lpSystemAffinityMask);
+
     extern "C" DLLImport BOOL InvalidateRect (HWND hWnd,
                                               const RECT *lpRect,
                                               BOOL bErase);
@@ -366,6 +396,13 @@ namespace Windows {
 
     extern "C" DLLImport COLORREF SetTextColor (HDC hdc, COLORREF color);
 
+    extern "C" DLLImport DWORD_PTR SetThreadAffinityMask (
+                                        HANDLE    hThread,
+                                        DWORD_PTR dwThreadAffinityMask);
+
+    extern "C" DLLImport BOOL SetThreadPriority (HANDLE hThread,
+                                                 int nPriority);
+
     extern "C" DLLImport void Sleep (DWORD dwMilliseconds);
 
     extern "C" DLLImport int StretchDIBits (HDC hdc,
@@ -390,6 +427,21 @@ namespace Windows {
     extern "C" DLLImport BOOL ValidateRect (HWND hWnd,
                                             const RECT *lpRect);
 
+    extern "C" DLLImport LPVOID VirtualAlloc (LPVOID lpAddress,
+                                              SIZE_T dwSize,
+                                              DWORD  flAllocationType,
+                                              DWORD  flProtect);
+
+    extern "C" DLLImport BOOL VirtualFree (LPVOID lpAddress,
+                                           SIZE_T dwSize,
+                                           DWORD  dwFreeType);
+
+    extern "C" DLLImport BOOL VirtualLock (LPVOID lpAddress,
+                                           SIZE_T dwSize);
+
+    extern "C" DLLImport BOOL VirtualUnlock (LPVOID lpAddress,
+                                             SIZE_T dwSize);
+
 }
 
 /*--------------------*/
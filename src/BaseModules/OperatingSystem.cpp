@@ -12,8 +12,11 @@
 /* IMPORTS */
 /*=========*/
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <filesystem>
+#include <thread>
 
 #include <stdio.h>
     /** qualified version of fprintf from stdio */
@@ -32,6 +35,8 @@
 #else
     #include <unistd.h>
     #include <dlfcn.h>
+    #include <pthread.h>
+    #include <sched.h>
 #endif
 
 /*--------------------*/
@@ -48,6 +53,22 @@ using STR = BaseModules::StringUtil;
 
 #ifdef _WIN32
 
+    /**
+     * Returns path of the directory for per-user configuration
+     * files (the roaming application data) or an empty string when
+     * unknown.
+     *
+     * @return  path of configuration directory
+     */
+    String _configurationDirectoryPath ()
+    {
+        const char* environmentPath = std::getenv("APPDATA");
+        return (environmentPath == NULL ? String{}
+                : String{environmentPath});
+    }
+
+    /*--------------------*/
+
     /**
      * Returns path of directory of current library or executable
      * file.
@@ -78,12 +99,135 @@ using STR = BaseModules::StringUtil;
         return result;
     }
 
+    /*--------------------*/
+
+    /**
+     * Returns the network name of the computer or an empty string
+     * when unknown.
+     *
+     * @return  name of computer
+     */
+    String _hostName ()
+    {
+        char name[MAX_COMPUTERNAME_LENGTH + 1];
+        Windows::DWORD length = MAX_COMPUTERNAME_LENGTH + 1;
+        const Boolean isOkay =
+            (Windows::GetComputerNameA(name, &length) != 0);
+        return (isOkay ? String{name, (size_t) length} : String{});
+    }
+
+    /*--------------------*/
+
+    /**
+     * Raises the priority of the calling thread to the time-critical
+     * priority and tells whether this has been permitted.
+     *
+     * @return  information whether the priority has been raised
+     */
+    Boolean _pinThreadToProcessor (IN Natural processorIndex)
+    {
+        const size_t maskBitCount = 8 * sizeof(Windows::DWORD_PTR);
+        const Windows::DWORD_PTR mask =
+            (Windows::DWORD_PTR) 1 << ((size_t) processorIndex
+                                       % maskBitCount);
+        return ((size_t) processorIndex < maskBitCount
+                && (Windows::SetThreadAffinityMask(
+                        Windows::GetCurrentThread(), mask) != 0));
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the indices of the processors in the affinity mask of
+     * the current process (only the first processor group).
+     *
+     * @return  list of processor indices
+     */
+    NaturalList _processorList ()
+    {
+        Windows::DWORD_PTR processMask = 0;
+        Windows::DWORD_PTR systemMask = 0;
+        Windows::GetProcessAffinityMask(Windows::GetCurrentProcess(),
+                                        &processMask, &systemMask);
+        NaturalList result;
+
+        for (size_t i = 0;  i < 8 * sizeof(processMask);  i++) {
+            if ((processMask >> i) & 1) {
+                result.append(Natural{i});
+            }
+        }
+
+        return result;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the package index of processor with
+     * <C>processorIndex</C>; the package topology is not queried on
+     * Windows, hence all processors are in package zero.
+     *
+     * @param[in] processorIndex  index of logical processor
+     * @return  index of package
+     */
+    Natural _processorPackageIndex (IN Natural processorIndex)
+    {
+        return 0;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Raises the priority of the calling thread to the time-critical
+     * priority and tells whether this has been permitted.
+     *
+     * @return  information whether the priority has been raised
+     */
+    Boolean _raiseThreadPriority ()
+    {
+        return (Windows::SetThreadPriority(Windows::GetCurrentThread(),
+                                           THREAD_PRIORITY_TIME_CRITICAL)
+                != 0);
+    }
+
 #else
 
     /*========================*/
     /* UNIX/MACOS DEFINITIONS */
     /*========================*/
 
+    /**
+     * Returns path of the directory for per-user configuration
+     * files (the application support folder on MacOS, the XDG
+     * configuration directory otherwise) or an empty string when
+     * unknown.
+     *
+     * @return  path of configuration directory
+     */
+    String _configurationDirectoryPath ()
+    {
+        const char* homePath = std::getenv("HOME");
+        String result;
+
+        #ifdef __APPLE__
+            if (homePath != NULL) {
+                result = String{homePath} + "/Library/Application Support";
+            }
+        #else
+            const char* environmentPath = std::getenv("XDG_CONFIG_HOME");
+
+            if (environmentPath != NULL && environmentPath[0] != '\0') {
+                result = String{environmentPath};
+            } else if (homePath != NULL) {
+                result = String{homePath} + "/.config";
+            }
+        #endif
+
+        return result;
+    }
+
+    /*--------------------*/
+
     /**
      * Returns path of directory of current library or executable
      * file.
@@ -117,6 +261,145 @@ using STR = BaseModules::StringUtil;
         return result;
     }
 
+    /*--------------------*/
+
+    /**
+     * Returns the network name of the computer or an empty string
+     * when unknown.
+     *
+     * @return  name of computer
+     */
+    String _hostName ()
+    {
+        constexpr size_t length = 256;
+        char name[length];
+        const Boolean isOkay = (gethostname(name, length) == 0);
+        name[length - 1] = '\0';
+        return (isOkay ? String{name} : String{});
+    }
+
+    /*--------------------*/
+
+    /**
+     * Restricts the calling thread to processor with
+     * <C>processorIndex</C> and tells whether this has been
+     * successful; MacOS has no processor affinity, hence it always
+     * fails there.
+     *
+     * @param[in] processorIndex  index of logical processor
+     * @return  information whether the thread has been pinned
+     */
+    Boolean _pinThreadToProcessor (IN Natural processorIndex)
+    {
+        Boolean isOkay = false;
+
+        #ifdef __linux__
+            if ((size_t) processorIndex < CPU_SETSIZE) {
+                cpu_set_t processorSet;
+                CPU_ZERO(&processorSet);
+                CPU_SET((size_t) processorIndex, &processorSet);
+                isOkay = (pthread_setaffinity_np(pthread_self(),
+                                                 sizeof(processorSet),
+                                                 &processorSet) == 0);
+            }
+        #endif
+
+        return isOkay;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the indices of the processors in the affinity mask of
+     * the current process; without processor affinity (on MacOS)
+     * these are all hardware threads.
+     *
+     * @return  list of processor indices
+     */
+    NaturalList _processorList ()
+    {
+        NaturalList result;
+
+        #ifdef __linux__
+            cpu_set_t processorSet;
+            CPU_ZERO(&processorSet);
+
+            if (sched_getaffinity(0, sizeof(processorSet),
+                                  &processorSet) == 0) {
+                for (size_t i = 0;  i < CPU_SETSIZE;  i++) {
+                    if (CPU_ISSET(i, &processorSet)) {
+                        result.append(Natural{i});
+                    }
+                }
+            }
+        #endif
+
+        if (result.size() == 0) {
+            const size_t processorCount =
+                std::max(1u, std::thread::hardware_concurrency());
+
+            for (size_t i = 0;  i < processorCount;  i++) {
+                result.append(Natural{i});
+            }
+        }
+
+        return result;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the package index of processor with
+     * <C>processorIndex</C> from the topology in the Linux sysfs;
+     * zero when not available.
+     *
+     * @param[in] processorIndex  index of logical processor
+     * @return  index of package
+     */
+    Natural _processorPackageIndex (IN Natural processorIndex)
+    {
+        Natural result = 0;
+
+        #ifdef __linux__
+            const String fileName =
+                STR::expand("/sys/devices/system/cpu/cpu%1/topology/"
+                            "physical_package_id",
+                            TOSTRING(processorIndex));
+            File file;
+
+            if (file.open(fileName, "r")) {
+                const StringList lineList = file.readLines();
+                file.close();
+                result = (lineList.size() == 0 ? Natural{0}
+                          : STR::toNatural(STR::strip(lineList[0]), 0));
+            }
+        #endif
+
+        return result;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Sets the calling thread to the FIFO real-time scheduling
+     * policy and tells whether this has been permitted (usually it
+     * requires a privilege or a real-time limit for the user).
+     *
+     * @return  information whether the priority has been raised
+     */
+    Boolean _raiseThreadPriority ()
+    {
+        /* a priority in the lower half of the range stays below the
+           audio threads of typical hosts */
+        const int lowPriority = sched_get_priority_min(SCHED_FIFO);
+        const int highPriority = sched_get_priority_max(SCHED_FIFO);
+        sched_param parameters{};
+        parameters.sched_priority =
+            lowPriority + (highPriority - lowPriority) / 4;
+        return (pthread_setschedparam(pthread_self(), SCHED_FIFO,
+                                      &parameters) == 0);
+    }
+
 #endif  
 
 /*====================*/
@@ -164,6 +447,53 @@ StringList OperatingSystem::fileNameList (IN String& directoryName,
 
 /*--------------------*/
 
+Boolean OperatingSystem::makeDirectory (IN String& directoryName)
+{
+    Logging_trace1(">>: %1", directoryName);
+    std::error_code errorCode;
+    FileSystem::create_directories(directoryName, errorCode);
+    Boolean result = FileSystem::is_directory(directoryName);
+    Logging_trace1("<<: %1", TOSTRING(result));
+    return result;
+}
+
+/*--------------------*/
+
+Real OperatingSystem::fileAge (IN String& fileName)
+{
+    Logging_trace1(">>: %1", fileName);
+
+    std::error_code errorCode;
+    const FileSystem::file_time_type modificationTime =
+        FileSystem::last_write_time(fileName, errorCode);
+    Real result = 0.0;
+
+    if (!errorCode) {
+        const std::chrono::duration<double> age =
+            FileSystem::file_time_type::clock::now() - modificationTime;
+        result = std::max(0.0, age.count());
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(result));
+    return result;
+}
+
+/*--------------------*/
+
+Boolean OperatingSystem::touchFile (IN String& fileName)
+{
+    Logging_trace1(">>: %1", fileName);
+    std::error_code errorCode;
+    FileSystem::last_write_time(fileName,
+                                FileSystem::file_time_type::clock::now(),
+                                errorCode);
+    Boolean result = !errorCode;
+    Logging_trace1("<<: %1", TOSTRING(result));
+    return result;
+}
+
+/*--------------------*/
+
 String OperatingSystem::basename (IN String& fileName)
 {
     Logging_trace1(">>: %1", fileName);
@@ -216,6 +546,21 @@ String OperatingSystem::dirname (IN String& fileName)
 
 /*--------------------*/
 
+String OperatingSystem::configurationDirectoryPath ()
+{
+    Logging_trace(">>");
+    String result = _configurationDirectoryPath();
+
+    if (result == "") {
+        result = temporaryDirectoryPath();
+    }
+
+    Logging_trace1("<<: %1", result);
+    return result;
+}
+
+/*--------------------*/
+
 String OperatingSystem::executableDirectoryPath (IN Boolean isExecutable)
 {
     Logging_trace(">>");
@@ -226,6 +571,56 @@ String OperatingSystem::executableDirectoryPath (IN Boolean isExecutable)
 
 /*--------------------*/
 
+String OperatingSystem::hostName ()
+{
+    Logging_trace(">>");
+    const String result = _hostName();
+    Logging_trace1("<<: %1", result);
+    return result;
+}
+
+/*--------------------*/
+
+Boolean OperatingSystem::pinThreadToProcessor (IN Natural processorIndex)
+{
+    Logging_trace1(">>: %1", TOSTRING(processorIndex));
+    const Boolean result = _pinThreadToProcessor(processorIndex);
+    Logging_trace1("<<: %1", TOSTRING(result));
+    return result;
+}
+
+/*--------------------*/
+
+NaturalList OperatingSystem::processorList ()
+{
+    Logging_trace(">>");
+    const NaturalList result = _processorList();
+    Logging_trace1("<<: %1", result.toString());
+    return result;
+}
+
+/*--------------------*/
+
+Natural OperatingSystem::processorPackageIndex (IN Natural processorIndex)
+{
+    Logging_trace1(">>: %1", TOSTRING(processorIndex));
+    const Natural result = _processorPackageIndex(processorIndex);
+    Logging_trace1("<<: %1", TOSTRING(result));
+    return result;
+}
+
+/*--------------------*/
+
+Boolean OperatingSystem::raiseThreadPriority ()
+{
+    Logging_trace(">>");
+    const Boolean result = _raiseThreadPriority();
+    Logging_trace1("<<: %1", TOSTRING(result));
+    return result;
+}
+
+/*--------------------*/
+
 String OperatingSystem::temporaryDirectoryPath ()
 {
     Logging_trace(">>");
@@ -19,12 +19,16 @@
 #include "Boolean.h"
 #include "Dictionary.h"
 #include "Natural.h"
+#include "NaturalList.h"
+#include "Real.h"
 
 /*--------------------*/
 
 using BaseTypes::Containers::Dictionary;
+using BaseTypes::Containers::NaturalList;
 using BaseTypes::Primitives::Boolean;
 using BaseTypes::Primitives::Natural;
+using BaseTypes::Primitives::Real;
 using BaseTypes::Primitives::String;
 
 /*====================*/
@@ -77,6 +81,42 @@ namespace BaseModules {
 
         /*--------------------*/
 
+        /**
+         * Creates directory named <C>directoryName</C> together with
+         * missing parent directories and tells whether the
+         * directory exists afterwards.
+         *
+         * @param[in] directoryName  name of directory to be created
+         * @return  information whether directory exists
+         */
+        static Boolean makeDirectory (IN String& directoryName);
+
+        /*--------------------*/
+
+        /**
+         * Returns the time in seconds since the last modification
+         * of file named <C>fileName</C> (zero when the file does not
+         * exist).
+         *
+         * @param[in] fileName  name of file
+         * @return  age of file in seconds
+         */
+        static Real fileAge (IN String& fileName);
+
+        /*--------------------*/
+
+        /**
+         * Sets the modification time of the existing file named
+         * <C>fileName</C> to the current time and tells whether this
+         * has been successful.
+         *
+         * @param[in] fileName  name of file
+         * @return  information whether file has been touched
+         */
+        static Boolean touchFile (IN String& fileName);
+
+        /*--------------------*/
+
         /**
          * Returns the base name of file or directory name
          * <C>fileName</C>.
@@ -101,6 +141,17 @@ namespace BaseModules {
 
         /*--------------------*/
 
+        /**
+         * Returns path of the directory for per-user configuration
+         * files of the operating system (the temporary directory
+         * when unknown).
+         *
+         * @return  path of configuration directory
+         */
+        static String configurationDirectoryPath ();
+
+        /*--------------------*/
+
         /**
          * Returns path of directory of current library or executable
          * file.
@@ -113,6 +164,63 @@ namespace BaseModules {
 
         /*--------------------*/
 
+        /**
+         * Returns the network name of the computer (an empty string
+         * when unknown).
+         *
+         * @return  name of computer
+         */
+        static String hostName ();
+
+        /*--------------------*/
+
+        /**
+         * Restricts the calling thread to the processor with
+         * <C>processorIndex</C> and tells whether this is
+         * supported; when not, the thread may run on any processor.
+         *
+         * @param[in] processorIndex  index of logical processor
+         * @return  information whether the thread has been pinned
+         */
+        static Boolean pinThreadToProcessor (IN Natural processorIndex);
+
+        /*--------------------*/
+
+        /**
+         * Returns the indices of the logical processors the current
+         * process may run on in ascending order.
+         *
+         * @return  list of processor indices
+         */
+        static NaturalList processorList ();
+
+        /*--------------------*/
+
+        /**
+         * Returns the index of the processor package (the socket
+         * and hence normally the memory node) of the logical
+         * processor with <C>processorIndex</C>; zero when the
+         * topology is not known.
+         *
+         * @param[in] processorIndex  index of logical processor
+         * @return  index of package
+         */
+        static Natural processorPackageIndex (IN Natural processorIndex);
+
+        /*--------------------*/
+
+        /**
+         * Raises the scheduling priority of the calling thread to a
+         * real-time priority and tells whether this is permitted;
+         * when not, the priority stays unchanged.
+         *
+         * @return  information whether the thread has real-time
+         *          priority
+         */
+        static Boolean raiseThreadPriority ();
+
+        /*--------------------*/
+
         /**
          * Returns path of temporary directory as string.
          *
@@ -0,0 +1,288 @@
+/**
+ * @file
+ * The <C>SharedTableFile</C> body implements an opt-in backing of
+ * immutable process-wide tables by versioned memory mapped files,
+ * such that processes running the plugins side by side share the
+ * same physical pages.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SharedTableFile.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include "ByteList.h"
+#include "File.h"
+#include "GenericList.h"
+#include "Logging.h"
+#include "MappedFile.h"
+#include "OperatingSystem.h"
+
+#ifndef _WIN32
+    #include <unistd.h>
+#endif
+
+/*--------------------*/
+
+using BaseModules::File;
+using BaseModules::MappedFile;
+using BaseModules::OperatingSystem;
+using BaseModules::SharedTableFile;
+using BaseModules::SharedTableFileHeader;
+using BaseTypes::Containers::ByteList;
+using BaseTypes::GenericTypes::GenericList;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
+
+/*====================*/
+
+static_assert(sizeof(SharedTableFileHeader)
+              == SharedTableFileHeader::headerByteCount,
+              "the table file header must have the documented size");
+
+/** the name of the environment variable switching on the sharing
+ * of tables */
+static const char* _enablingVariableName = "SOXPLUGINS_SHARED_TABLES";
+
+/** the mutex serializing the requests for tables */
+static std::mutex _tableMutex;
+
+/** the table files mapped so far; they are deliberately never
+ * unmapped, because the tables are used until the end of the
+ * process (also by static objects) */
+static GenericList<MappedFile*> _mappedFileList;
+
+/*--------------------*/
+/* auxiliary routines */
+/*--------------------*/
+
+/**
+ * Tells whether the environment switches on the sharing of tables.
+ *
+ * @return  information whether tables are shared
+ */
+static Boolean _isEnabledByEnvironment ()
+{
+    const char* value = std::getenv(_enablingVariableName);
+    return (value != nullptr && value[0] != '\0'
+            && String{value} != "0");
+}
+
+/*--------------------*/
+
+/**
+ * Returns the id of the current process.
+ *
+ * @return  process id
+ */
+static std::uint64_t _processId ()
+{
+    #ifdef _WIN32
+        return 0;
+    #else
+        return (std::uint64_t) getpid();
+    #endif
+}
+
+/*--------------------*/
+
+/**
+ * Returns the FNV-1a checksum of the <C>byteCount</C> bytes at
+ * <C>data</C>.
+ *
+ * @param[in] data       start address of data
+ * @param[in] byteCount  number of bytes in data
+ * @return  64-bit checksum
+ */
+static std::uint64_t _checksum (IN std::uint8_t* data,
+                                IN size_t byteCount)
+{
+    std::uint64_t result = 0xCBF29CE484222325ull;
+
+    for (size_t i = 0;  i < byteCount;  i++) {
+        result = (result ^ data[i]) * 0x100000001B3ull;
+    }
+
+    return result;
+}
+
+/*--------------------*/
+
+/**
+ * Tells whether the table file mapped in <C>mappedFile</C> has the
+ * current format, <C>version</C>, <C>byteCount</C> bytes of table
+ * data and a correct checksum.
+ *
+ * @param[in] mappedFile  mapped table file
+ * @param[in] version     expected version of table contents
+ * @param[in] byteCount   expected number of bytes of table
+ * @return  information whether file is usable
+ */
+static Boolean _isValid (IN MappedFile& mappedFile,
+                         IN Natural version,
+                         IN size_t byteCount)
+{
+    const size_t headerByteCount = SharedTableFileHeader::headerByteCount;
+    Boolean result =
+        (mappedFile.isOpen()
+         && (size_t) mappedFile.length() == headerByteCount + byteCount);
+
+    if (result) {
+        const std::uint8_t* data = mappedFile.data();
+        SharedTableFileHeader header;
+        std::memcpy(&header, data, headerByteCount);
+        result = (header.magic == SharedTableFileHeader::magicNumber
+                  && (header.formatVersion
+                      == SharedTableFileHeader::currentFormatVersion)
+                  && header.tableVersion == (std::uint32_t) (size_t) version
+                  && header.byteCount == (std::uint64_t) byteCount
+                  && (header.checksum
+                      == _checksum(data + headerByteCount, byteCount)));
+    }
+
+    return result;
+}
+
+/*--------------------*/
+
+/**
+ * Calculates the table with <C>version</C> and <C>byteCount</C>
+ * bytes by <C>filler</C> and writes it into the table file at
+ * <C>filePath</C>; the file is first written under a name unique
+ * to this process and then renamed, such that other processes
+ * never see an incomplete file.  Tells whether this has been
+ * successful.
+ *
+ * @param[in] filePath   path of table file
+ * @param[in] version    version of table contents
+ * @param[in] byteCount  number of bytes of table
+ * @param[in] filler     calculation of the table
+ * @return  information whether table file has been written
+ */
+static Boolean _writeTableFile (IN String& filePath,
+                                IN Natural version,
+                                IN size_t byteCount,
+                                IN SharedTableFile::Filler filler)
+{
+    Logging_trace2(">>: filePath = %1, byteCount = %2",
+                   filePath, TOSTRING(Natural{byteCount}));
+
+    const size_t headerByteCount = SharedTableFileHeader::headerByteCount;
+    const Natural fileByteCount{headerByteCount + byteCount};
+    ByteList byteList{};
+    byteList.setLength(fileByteCount);
+    std::uint8_t* data = (std::uint8_t*) byteList.asArray();
+    filler(data + headerByteCount);
+
+    SharedTableFileHeader header{};
+    header.magic         = SharedTableFileHeader::magicNumber;
+    header.formatVersion = SharedTableFileHeader::currentFormatVersion;
+    header.tableVersion  = (std::uint32_t) (size_t) version;
+    header.byteCount     = (std::uint64_t) byteCount;
+    header.checksum      = _checksum(data + headerByteCount, byteCount);
+    std::memcpy(data, &header, headerByteCount);
+
+    const String temporaryPath =
+        STR::expand("%1.%2.tmp",
+                    filePath, TOSTRING(Natural{_processId()}));
+    File file;
+    Boolean isOkay = file.open(temporaryPath, "wb");
+
+    if (isOkay) {
+        isOkay = (file.write(byteList, 0, fileByteCount) == fileByteCount
+                  && file.flush());
+        file.close();
+        isOkay = isOkay && File::rename(temporaryPath, filePath);
+
+        if (!isOkay) {
+            File::remove(temporaryPath);
+        }
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*====================*/
+
+/*--------------------*/
+/* queries            */
+/*--------------------*/
+
+Boolean SharedTableFile::isEnabled ()
+{
+    static const Boolean result =
+        (MappedFile::isAvailable() && _isEnabledByEnvironment());
+    return result;
+}
+
+/*--------------------*/
+
+String SharedTableFile::path (IN String& name, IN Natural version)
+{
+    return STR::expand("%1/SoXPlugins-table-%2-v%3.bin",
+                       OperatingSystem::temporaryDirectoryPath(),
+                       name, TOSTRING(version));
+}
+
+/*--------------------*/
+/* access             */
+/*--------------------*/
+
+const void* SharedTableFile::table (IN String& name,
+                                    IN Natural version,
+                                    IN size_t byteCount,
+                                    IN Filler filler,
+                                    OUT Object localStorage)
+{
+    Logging_trace3(">>: name = %1, version = %2, byteCount = %3",
+                   name, TOSTRING(version),
+                   TOSTRING(Natural{byteCount}));
+
+    const void* result = nullptr;
+
+    if (isEnabled()) {
+        const std::lock_guard<std::mutex> lock{_tableMutex};
+        const String filePath = path(name, version);
+        MappedFile* mappedFile = new MappedFile();
+        mappedFile->open(filePath);
+
+        if (!_isValid(*mappedFile, version, byteCount)) {
+            /* the file is missing or outdated: make a new one and
+               map that */
+            Logging_trace1("--: making table file %1", filePath);
+            mappedFile->close();
+
+            if (_writeTableFile(filePath, version, byteCount, filler)) {
+                mappedFile->open(filePath);
+            }
+        }
+
+        if (_isValid(*mappedFile, version, byteCount)) {
+            result =
+                mappedFile->data() + SharedTableFileHeader::headerByteCount;
+            _mappedFileList.append(mappedFile);
+        } else {
+            Logging_traceError("table file not usable, fallback to"
+                               " local table");
+            delete mappedFile;
+        }
+    }
+
+    if (result == nullptr) {
+        filler(localStorage);
+        result = localStorage;
+    }
+
+    Logging_trace1("<<: isShared = %1",
+                   TOSTRING(Boolean{result != localStorage}));
+    return result;
+}
@@ -0,0 +1,170 @@
+/**
+ * @file
+ * The <C>SharedTableFile</C> specification defines an opt-in
+ * backing of immutable process-wide tables by versioned memory
+ * mapped files, such that processes running the plugins side by
+ * side share the same physical pages.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include <cstdint>
+#include "Boolean.h"
+#include "MyString.h"
+#include "Natural.h"
+#include "Object.h"
+
+/*--------------------*/
+
+using BaseTypes::Primitives::Boolean;
+using BaseTypes::Primitives::Natural;
+using BaseTypes::Primitives::Object;
+using BaseTypes::Primitives::String;
+
+/*====================*/
+
+namespace BaseModules {
+
+    /**
+     * A <C>SharedTableFileHeader</C> is the start of a table file;
+     * the table data follows at offset <C>headerByteCount</C>.  All
+     * numbers are in the byte order of the machine, hence a file
+     * from a machine with another byte order fails the magic number
+     * check.
+     */
+    struct SharedTableFileHeader {
+
+        /** the magic number of a table file ("SOXTABLE" in
+         * memory) */
+        static constexpr std::uint64_t magicNumber =
+            0x454C424154584F53ull;
+
+        /** the current version of the file format */
+        static constexpr std::uint32_t currentFormatVersion = 1;
+
+        /** the number of bytes of the header */
+        static constexpr std::uint32_t headerByteCount = 64;
+
+        /*--------------------*/
+
+        /** the magic number identifying a table file */
+        std::uint64_t magic;
+
+        /** the version of the file format */
+        std::uint32_t formatVersion;
+
+        /** the version of the table contents given by its owner */
+        std::uint32_t tableVersion;
+
+        /** the number of bytes of the table data */
+        std::uint64_t byteCount;
+
+        /** the FNV-1a checksum of the table data */
+        std::uint64_t checksum;
+
+        /** reserved for later versions (zero) */
+        std::uint64_t reserved[4];
+
+    };
+
+    /*--------------------*/
+
+    /**
+     * A <C>SharedTableFile</C> provides immutable tables (like wave
+     * tables) either from a memory mapped file in the temporary
+     * directory shared by all processes or, as a fallback, from
+     * storage local to the process.  This helps sandboxed hosts
+     * running each plugin instance in a process of its own: the
+     * first process calculates the table and writes the file, all
+     * later ones only map it, hence they neither calculate the
+     * table nor need private memory for it.
+     *
+     * The table file is named
+     * <C>SoXPlugins-table-NAME-vVERSION.bin</C>, where the version
+     * must be increased whenever the calculation of the table
+     * changes.  A file is only used when its header matches the
+     * expected format, version and size and its checksum is
+     * correct; otherwise it is replaced atomically by a new one.
+     * The checksum only protects against incomplete or corrupted
+     * files, not against deliberate manipulation in the temporary
+     * directory.
+     *
+     * Sharing is off by default; its setting is taken once per
+     * process from the environment variable
+     * <C>SOXPLUGINS_SHARED_TABLES</C> (set to a nonempty value
+     * other than "0").  It is only available on POSIX systems (like
+     * <C>MappedFile</C>).  Tables are requested when setting up
+     * an effect and never on the audio thread; a mapping is kept
+     * until the end of the process.
+     */
+    struct SharedTableFile {
+
+        /**
+         * A filler writes the contents of a table into
+         * <C>data</C> (with the byte count of the table).
+         */
+        using Filler = void (*) (OUT Object data);
+
+        /*--------------------*/
+        /* queries            */
+        /*--------------------*/
+
+        /**
+         * Tells whether sharing of tables is switched on in this
+         * process.
+         *
+         * @return  information whether tables are shared via files
+         */
+        static Boolean isEnabled ();
+
+        /*--------------------*/
+
+        /**
+         * Returns the path of the table file for the table named
+         * <C>name</C> with version <C>version</C>.
+         *
+         * @param[in] name     name of table
+         * @param[in] version  version of table contents
+         * @return  path of table file
+         */
+        static String path (IN String& name, IN Natural version);
+
+        /*--------------------*/
+        /* access             */
+        /*--------------------*/
+
+        /**
+         * Returns the table named <C>name</C> with version
+         * <C>version</C> and <C>byteCount</C> bytes calculated by
+         * <C>filler</C>: when sharing is enabled, this is the
+         * mapped table file (made when necessary), otherwise or on
+         * failure <C>localStorage</C> filled by <C>filler</C>.  The
+         * result is aligned at least to 64 bytes when
+         * <C>localStorage</C> is.
+         *
+         * @param[in]  name          name of table
+         * @param[in]  version       version of table contents
+         * @param[in]  byteCount     number of bytes of table
+         * @param[in]  filler        calculation of the table
+         * @param[out] localStorage  storage of the process used when
+         *                           the table is not shared
+         * @return  read-only table data
+         */
+        static const void* table (IN String& name,
+                                  IN Natural version,
+                                  IN size_t byteCount,
+                                  IN Filler filler,
+                                  OUT Object localStorage);
+
+    };
+
+}
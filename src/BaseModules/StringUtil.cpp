@@ -13,8 +13,10 @@
 /*=========*/
 
 #include <cctype>
+#include <charconv>
 #include <cstdarg>
 #include <cwchar>
+#include <limits>
 
 #include "Assertion.h"
 #include "StringUtil.h"
@@ -46,6 +48,16 @@ static const Character _decimalPointCharacter{'.'};
 /** list of all digit characters */
 static const String _digitCharacterList = "0123456789";
 
+/** the number of fractional digits in the default string
+ *  representation of a real (as in <C>std::to_string</C>) */
+static const int _realFractionalDigitCount = 6;
+
+/** the buffer length sufficient for the default string
+ *  representation of any real (sign, all integral digits, decimal
+ *  point and fractional digits) */
+static const size_t _realBufferLength =
+    std::numeric_limits<double>::max_exponent10 + 16;
+
 /** list of all lowercase alpha digit characters */
 static const String _lcAlphaDigitCharacterList =
     "abcdefghijklmnopqrstuvwxyz";
@@ -648,7 +660,29 @@ Real StringUtil::toReal (IN String& st)
 
 Real StringUtil::toReal (IN String& st, IN Real defaultValue)
 {
-    return (isReal(st) ? Real(std::stod(st)) : defaultValue);
+    Real result = defaultValue;
+
+    if (isReal(st)) {
+        #if defined(__cpp_lib_to_chars)
+            /* a locale-independent conversion without allocation;
+               it does neither accept a leading blank nor a plus sign
+               (which are allowed by isReal) */
+            const char* first = st.data();
+            const char* last = first + st.size();
+            first += (*first == '+' || *first == ' ' ? 1 : 0);
+            double value;
+            const std::from_chars_result conversionResult =
+                std::from_chars(first, last, value);
+
+            if (conversionResult.ec == std::errc{}) {
+                result = value;
+            }
+        #else
+            result = Real(std::stod(st));
+        #endif
+    }
+
+    return result;
 }
 
 /*--------------------*/
@@ -718,7 +752,18 @@ String StringUtil::toStringWithBase (IN Natural n,
 
 String StringUtil::toString (IN Real r)
 {
-    return std::to_string((double) r);
+    #if defined(__cpp_lib_to_chars)
+        /* same format as std::to_string, but without the locale
+           dependent formatting via printf */
+        char buffer[_realBufferLength];
+        const std::to_chars_result conversionResult =
+            std::to_chars(buffer, buffer + _realBufferLength, (double) r,
+                          std::chars_format::fixed,
+                          _realFractionalDigitCount);
+        return String{buffer, conversionResult.ptr};
+    #else
+        return std::to_string((double) r);
+    #endif
 }
 
 /*--------------------*/
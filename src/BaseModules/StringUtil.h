@@ -510,7 +510,8 @@ namespace BaseModules {
 
         /**
          * Converts <C>st</C> to a real value; if conversion fails,
-         * <C>defaultValue</C> is returned
+         * <C>defaultValue</C> is returned; the conversion does not
+         * depend on the locale and does not allocate memory
          *
          * @param[in] st            the string to be converted to real
          * @param[in] defaultValue  the value to be used for bad conversion
@@ -618,7 +619,9 @@ namespace BaseModules {
         /*--------------------*/
 
         /**
-         * Converts real value <C>r</C> to string.
+         * Converts real value <C>r</C> to string in fixed notation
+         * with six fractional digits (like <C>std::to_string</C>,
+         * but independent of the locale).
          *
          * @param[in] r  real value to be converted
          * @return  string representation of real
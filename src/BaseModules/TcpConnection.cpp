@@ -0,0 +1,444 @@
+/**
+ * @file
+ * The <C>TcpConnection</C> body implements classes for blocking TCP
+ * connections exchanging length-prefixed messages and for listeners
+ * accepting them.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "TcpConnection.h"
+
+#include <cstdint>
+#include "Logging.h"
+
+#ifndef _WIN32
+    #include <netdb.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <sys/socket.h>
+    #include <sys/time.h>
+    #include <unistd.h>
+#endif
+
+/*--------------------*/
+
+using BaseModules::TcpConnection;
+using BaseModules::TcpListener;
+
+/*====================*/
+
+/** the number of bytes of the length prefix of a message */
+static const size_t _lengthPrefixByteCount = 8;
+
+/** the maximum number of pending connections of a listener */
+static const int _backlogLength = 16;
+
+/*====================*/
+
+#ifdef _WIN32
+
+    /* sockets are not supported, all connections fail */
+
+#else
+
+    /** the flags for sending without a signal on a broken
+     * connection (where the platform supports that) */
+    #ifdef MSG_NOSIGNAL
+        static const int _sendFlags = MSG_NOSIGNAL;
+    #else
+        static const int _sendFlags = 0;
+    #endif
+
+    /*--------------------*/
+
+    /**
+     * Prepares the socket <C>descriptor</C> for message transfer:
+     * switches off the delay of small packets, suppresses the
+     * signal for broken connections where this is a socket option
+     * and sets the send and receive timeouts to <C>timeout</C>
+     * seconds (zero for none).
+     *
+     * @param[in] descriptor  socket descriptor
+     * @param[in] timeout     maximum time for a transfer in seconds
+     */
+    static void _configureSocket (IN int descriptor, IN double timeout)
+    {
+        int flag = 1;
+        setsockopt(descriptor, IPPROTO_TCP, TCP_NODELAY,
+                   &flag, sizeof(flag));
+
+        #ifdef SO_NOSIGPIPE
+            setsockopt(descriptor, SOL_SOCKET, SO_NOSIGPIPE,
+                       &flag, sizeof(flag));
+        #endif
+
+        struct timeval timeValue;
+        timeValue.tv_sec  = (time_t) timeout;
+        timeValue.tv_usec =
+            (suseconds_t) ((timeout - (double) timeValue.tv_sec) * 1E6);
+        setsockopt(descriptor, SOL_SOCKET, SO_RCVTIMEO,
+                   &timeValue, sizeof(timeValue));
+        setsockopt(descriptor, SOL_SOCKET, SO_SNDTIMEO,
+                   &timeValue, sizeof(timeValue));
+    }
+
+    /*--------------------*/
+
+    /**
+     * Sends all <C>count</C> bytes at <C>data</C> via the socket
+     * <C>descriptor</C> and tells whether this has been successful.
+     *
+     * @param[in] descriptor  socket descriptor
+     * @param[in] data        bytes to be sent
+     * @param[in] count       number of bytes
+     * @return  information whether all bytes have been sent
+     */
+    static Boolean _sendAll (IN int descriptor,
+                             IN std::uint8_t* data,
+                             IN size_t count)
+    {
+        size_t position = 0;
+        Boolean isOkay = true;
+
+        while (isOkay && position < count) {
+            const ssize_t sentCount =
+                ::send(descriptor, data + position, count - position,
+                       _sendFlags);
+            isOkay = (sentCount > 0);
+            position += (isOkay ? (size_t) sentCount : 0);
+        }
+
+        return isOkay;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Receives exactly <C>count</C> bytes into <C>data</C> via the
+     * socket <C>descriptor</C> and tells whether this has been
+     * successful.
+     *
+     * @param[in]  descriptor  socket descriptor
+     * @param[out] data        buffer for received bytes
+     * @param[in]  count       number of bytes
+     * @return  information whether all bytes have been received
+     */
+    static Boolean _receiveAll (IN int descriptor,
+                                OUT std::uint8_t* data,
+                                IN size_t count)
+    {
+        size_t position = 0;
+        Boolean isOkay = true;
+
+        while (isOkay && position < count) {
+            const ssize_t receivedCount =
+                ::recv(descriptor, data + position, count - position, 0);
+            isOkay = (receivedCount > 0);
+            position += (isOkay ? (size_t) receivedCount : 0);
+        }
+
+        return isOkay;
+    }
+
+#endif
+
+/*====================*/
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+TcpConnection::TcpConnection ()
+    : _descriptor{-1},
+      _timeout{0.0}
+{
+}
+
+/*--------------------*/
+
+TcpConnection::~TcpConnection ()
+{
+    close();
+}
+
+/*--------------------*/
+/* status change      */
+/*--------------------*/
+
+Boolean TcpConnection::open (IN String& hostName, IN Natural port)
+{
+    Logging_trace2(">>: host = %1, port = %2",
+                   hostName, TOSTRING(port));
+
+    close();
+
+    #ifndef _WIN32
+        struct addrinfo hints{};
+        struct addrinfo* addressList = nullptr;
+        hints.ai_family   = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        const String portName = TOSTRING(port);
+
+        if (getaddrinfo(hostName.c_str(), portName.c_str(),
+                        &hints, &addressList) == 0) {
+            /* the addresses are tried in the order given by the
+               resolver until a connect succeeds */
+            for (struct addrinfo* address = addressList;
+                 address != nullptr && _descriptor < 0;
+                 address = address->ai_next) {
+                const int descriptor =
+                    socket(address->ai_family, address->ai_socktype,
+                           address->ai_protocol);
+
+                if (descriptor >= 0) {
+                    _configureSocket(descriptor, (double) _timeout);
+
+                    if (connect(descriptor, address->ai_addr,
+                                address->ai_addrlen) == 0) {
+                        _descriptor = descriptor;
+                    } else {
+                        ::close(descriptor);
+                    }
+                }
+            }
+
+            freeaddrinfo(addressList);
+        }
+    #endif
+
+    const Boolean isOkay = isOpen();
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+
+void TcpConnection::close ()
+{
+    #ifndef _WIN32
+        if (_descriptor >= 0) {
+            ::close(_descriptor);
+        }
+    #endif
+
+    _descriptor = -1;
+}
+
+/*--------------------*/
+
+void TcpConnection::setTimeout (IN Real timeout)
+{
+    _timeout = timeout;
+
+    #ifndef _WIN32
+        if (_descriptor >= 0) {
+            _configureSocket(_descriptor, (double) _timeout);
+        }
+    #endif
+}
+
+/*--------------------*/
+/* transfer           */
+/*--------------------*/
+
+Boolean TcpConnection::send (IN ByteList& message)
+{
+    Logging_trace1(">>: %1", TOSTRING(message.length()));
+
+    Boolean isOkay = isOpen();
+
+    #ifndef _WIN32
+        if (isOkay) {
+            const std::uint64_t length = (std::uint64_t) message.length();
+            std::uint8_t prefix[_lengthPrefixByteCount];
+
+            for (size_t i = 0;  i < _lengthPrefixByteCount;  i++) {
+                prefix[i] = (std::uint8_t) (length >> (8 * i));
+            }
+
+            isOkay = (_sendAll(_descriptor, prefix, _lengthPrefixByteCount)
+                      && _sendAll(_descriptor,
+                                  (const std::uint8_t*) message.asArray(),
+                                  (size_t) message.length()));
+        }
+    #endif
+
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+
+Boolean TcpConnection::receive (OUT ByteList& message,
+                                IN Natural maximumLength)
+{
+    Logging_trace1(">>: maximumLength = %1", TOSTRING(maximumLength));
+
+    Boolean isOkay = isOpen();
+    message.clear();
+
+    #ifndef _WIN32
+        std::uint8_t prefix[_lengthPrefixByteCount];
+        isOkay = (isOkay
+                  && _receiveAll(_descriptor, prefix,
+                                 _lengthPrefixByteCount));
+        std::uint64_t length = 0;
+
+        for (size_t i = 0;  isOkay && i < _lengthPrefixByteCount;  i++) {
+            length |= (std::uint64_t) prefix[i] << (8 * i);
+        }
+
+        isOkay = (isOkay && length <= (std::uint64_t) maximumLength);
+
+        if (isOkay) {
+            message.setLength(Natural{(size_t) length});
+            isOkay = _receiveAll(_descriptor,
+                                 (std::uint8_t*) message.asArray(),
+                                 (size_t) length);
+        }
+    #endif
+
+    Logging_trace2("<<: isOkay = %1, length = %2",
+                   TOSTRING(isOkay), TOSTRING(message.length()));
+    return isOkay;
+}
+
+/*--------------------*/
+/* queries            */
+/*--------------------*/
+
+Boolean TcpConnection::isOpen () const
+{
+    return _descriptor >= 0;
+}
+
+/*--------------------*/
+
+Boolean TcpConnection::isAvailable ()
+{
+    #ifdef _WIN32
+        return false;
+    #else
+        return true;
+    #endif
+}
+
+/*============================================================*/
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+TcpListener::TcpListener ()
+    : _descriptor{-1},
+      _port{0}
+{
+}
+
+/*--------------------*/
+
+TcpListener::~TcpListener ()
+{
+    close();
+}
+
+/*--------------------*/
+/* status change      */
+/*--------------------*/
+
+Boolean TcpListener::open (IN Natural port)
+{
+    Logging_trace1(">>: %1", TOSTRING(port));
+
+    close();
+
+    #ifndef _WIN32
+        const int descriptor = socket(AF_INET6, SOCK_STREAM, 0);
+
+        if (descriptor >= 0) {
+            /* the port may be reused directly after a restart and
+               also accepts IPv4 connections */
+            int flag = 1;
+            setsockopt(descriptor, SOL_SOCKET, SO_REUSEADDR,
+                       &flag, sizeof(flag));
+            flag = 0;
+            setsockopt(descriptor, IPPROTO_IPV6, IPV6_V6ONLY,
+                       &flag, sizeof(flag));
+
+            struct sockaddr_in6 address{};
+            address.sin6_family = AF_INET6;
+            address.sin6_addr   = in6addr_any;
+            address.sin6_port   = htons((std::uint16_t) (size_t) port);
+            socklen_t addressLength = sizeof(address);
+
+            if (bind(descriptor, (struct sockaddr*) &address,
+                     addressLength) == 0
+                && listen(descriptor, _backlogLength) == 0
+                && getsockname(descriptor, (struct sockaddr*) &address,
+                               &addressLength) == 0) {
+                _descriptor = descriptor;
+                _port = Natural{(size_t) ntohs(address.sin6_port)};
+            } else {
+                ::close(descriptor);
+            }
+        }
+    #endif
+
+    const Boolean isOkay = (_descriptor >= 0);
+    Logging_trace2("<<: isOkay = %1, port = %2",
+                   TOSTRING(isOkay), TOSTRING(_port));
+    return isOkay;
+}
+
+/*--------------------*/
+
+void TcpListener::close ()
+{
+    #ifndef _WIN32
+        if (_descriptor >= 0) {
+            ::close(_descriptor);
+        }
+    #endif
+
+    _descriptor = -1;
+    _port = 0;
+}
+
+/*--------------------*/
+
+Boolean TcpListener::accept (OUT TcpConnection& connection)
+{
+    Logging_trace(">>");
+
+    connection.close();
+
+    #ifndef _WIN32
+        if (_descriptor >= 0) {
+            const int descriptor = ::accept(_descriptor, nullptr, nullptr);
+
+            if (descriptor >= 0) {
+                _configureSocket(descriptor, (double) connection._timeout);
+                connection._descriptor = descriptor;
+            }
+        }
+    #endif
+
+    const Boolean isOkay = connection.isOpen();
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+/* queries            */
+/*--------------------*/
+
+Natural TcpListener::port () const
+{
+    return _port;
+}
@@ -0,0 +1,263 @@
+/**
+ * @file
+ * The <C>TcpConnection</C> specification defines classes for
+ * blocking TCP connections exchanging length-prefixed messages and
+ * for listeners accepting them.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "Boolean.h"
+#include "ByteList.h"
+#include "MyString.h"
+#include "Natural.h"
+#include "Real.h"
+
+/*--------------------*/
+
+using BaseTypes::Containers::ByteList;
+using BaseTypes::Primitives::Boolean;
+using BaseTypes::Primitives::Natural;
+using BaseTypes::Primitives::Real;
+using BaseTypes::Primitives::String;
+
+/*====================*/
+
+namespace BaseModules {
+
+    /**
+     * A <C>TcpConnection</C> object is one end of a TCP connection
+     * transporting messages: each message is a byte list preceded
+     * by its length as an unsigned 64-bit little-endian number.
+     * All operations block; a timeout bounds the wait for a single
+     * send or receive, such that a dead peer is detected.  TCP is
+     * only available on POSIX platforms; elsewhere all connects
+     * fail.
+     */
+    struct TcpConnection {
+
+        /*--------------------*/
+        /* con-/destruction   */
+        /*--------------------*/
+
+        /**
+         * Defines new connection object (without connecting it)
+         */
+        TcpConnection ();
+
+        /*--------------------*/
+
+        /**
+         * Constructs new connection from <C>otherConnection</C>
+         * (NOT AVAILABLE!)
+         *
+         * @param[in] otherConnection  connection to be copied
+         */
+        TcpConnection (IN TcpConnection& otherConnection) = delete;
+
+        /*--------------------*/
+
+        /**
+         * Destroys connection (and closes it before).
+         */
+        ~TcpConnection ();
+
+        /*--------------------*/
+        /* status change      */
+        /*--------------------*/
+
+        /**
+         * Connects to the TCP server at <C>hostName</C> and
+         * <C>port</C> and returns whether this has been successful.
+         *
+         * @param[in] hostName  name or numeric address of host
+         * @param[in] port      TCP port of server
+         * @return  information whether connection has been made
+         */
+        Boolean open (IN String& hostName, IN Natural port);
+
+        /*--------------------*/
+
+        /**
+         * Closes connection if still open.
+         */
+        void close ();
+
+        /*--------------------*/
+
+        /**
+         * Sets the maximum time for a single send or receive to
+         * <C>timeout</C> seconds (zero waits forever, the default);
+         * the setting is kept when the connection is reopened.
+         *
+         * @param[in] timeout  maximum waiting time in seconds
+         */
+        void setTimeout (IN Real timeout);
+
+        /*--------------------*/
+        /* transfer           */
+        /*--------------------*/
+
+        /**
+         * Sends <C>message</C> to the peer and returns whether this
+         * has been successful.
+         *
+         * @param[in] message  bytes to be sent as one message
+         * @return  information whether message has been sent
+         */
+        Boolean send (IN ByteList& message);
+
+        /*--------------------*/
+
+        /**
+         * Receives the next message from the peer into
+         * <C>message</C> and returns whether this has been
+         * successful; fails when the peer has closed the
+         * connection, the timeout has expired or the message is
+         * longer than <C>maximumLength</C>.
+         *
+         * @param[out] message        bytes of the message received
+         * @param[in]  maximumLength  maximum accepted message
+         *                            length in bytes
+         * @return  information whether message has been received
+         */
+        Boolean receive (OUT ByteList& message,
+                         IN Natural maximumLength);
+
+        /*--------------------*/
+        /* queries            */
+        /*--------------------*/
+
+        /**
+         * Tells whether connection is open (or not).
+         *
+         * @return  information whether connection is open
+         */
+        Boolean isOpen () const;
+
+        /*--------------------*/
+
+        /**
+         * Tells whether TCP connections are supported on this
+         * platform.
+         *
+         * @return  information whether TCP is available
+         */
+        static Boolean isAvailable ();
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            friend struct TcpListener;
+
+            /** the socket descriptor (negative when closed) */
+            int _descriptor;
+
+            /** the maximum time for a send or receive in seconds
+             * (zero for no limit) */
+            Real _timeout;
+
+    };
+
+    /*====================*/
+
+    /**
+     * A <C>TcpListener</C> object accepts TCP connections on a port
+     * of all network interfaces.
+     */
+    struct TcpListener {
+
+        /*--------------------*/
+        /* con-/destruction   */
+        /*--------------------*/
+
+        /**
+         * Defines new listener object (without listening)
+         */
+        TcpListener ();
+
+        /*--------------------*/
+
+        /**
+         * Constructs new listener from <C>otherListener</C>
+         * (NOT AVAILABLE!)
+         *
+         * @param[in] otherListener  listener to be copied
+         */
+        TcpListener (IN TcpListener& otherListener) = delete;
+
+        /*--------------------*/
+
+        /**
+         * Destroys listener (and closes it before).
+         */
+        ~TcpListener ();
+
+        /*--------------------*/
+        /* status change      */
+        /*--------------------*/
+
+        /**
+         * Starts listening on <C>port</C> (zero selects a free
+         * port) and returns whether this has been successful.
+         *
+         * @param[in] port  TCP port to listen on
+         * @return  information whether listening has started
+         */
+        Boolean open (IN Natural port);
+
+        /*--------------------*/
+
+        /**
+         * Stops listening if still listening.
+         */
+        void close ();
+
+        /*--------------------*/
+
+        /**
+         * Waits for the next incoming connection, connects
+         * <C>connection</C> to it and returns whether this has been
+         * successful.
+         *
+         * @param[out] connection  connection to the new peer
+         * @return  information whether a connection was accepted
+         */
+        Boolean accept (OUT TcpConnection& connection);
+
+        /*--------------------*/
+        /* queries            */
+        /*--------------------*/
+
+        /**
+         * Returns the port listened on (zero when not listening).
+         *
+         * @return  TCP port
+         */
+        Natural port () const;
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the socket descriptor (negative when closed) */
+            int _descriptor;
+
+            /** the port listened on */
+            Natural _port;
+
+    };
+
+}
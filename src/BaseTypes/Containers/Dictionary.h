@@ -15,11 +15,11 @@
 /* IMPORTS */
 /*=========*/
 
-#include "GenericMap.h"
+#include "GenericStringHashMap.h"
 
 /*--------------------*/
 
-using BaseTypes::GenericTypes::GenericMap;
+using BaseTypes::GenericTypes::GenericStringHashMap;
 
 /*====================*/
 
@@ -37,13 +37,14 @@ namespace BaseTypes::Containers {
     /**
      * A <C>Dictionary</C> object maps string keys to string values.
      * Every key is associated with at most one value, where the key
-     * identity is defined by standard string comparison.
+     * identity is defined by standard string comparison.  Lookup
+     * is done by hashing and iteration follows the order of key
+     * insertion.
      */
     struct Dictionary
-        : public GenericMap < String, String,
-                              StringUtil::toPrintableString,
-                              StringUtil::toPrintableString,
-                              _dictionaryTypeName > {
+        : public GenericStringHashMap < String,
+                                        StringUtil::toPrintableString,
+                                        _dictionaryTypeName > {
 
         /*--------------------*/
         /* constructors       */
@@ -1,8 +1,7 @@
 /**
  * @file
- * The <C>MyArray</C> specification and body defines a
- * generic array type for stack allocated arrays represented
- * by a pointer to the first element.
+ * The <C>MyArray</C> specification and body defines services for
+ * generic arrays represented by a pointer to the first element.
  *
  * @author Dr. Thomas Tensi
  * @date   2021-07
@@ -30,19 +29,6 @@ using BaseTypes::Primitives::Natural;
 
 namespace BaseTypes::Containers {
 
-    /**
-     * Allocates an array of <C>count</C> elements of type
-     * <C>ElementType</C> on the stack.
-     *
-     * @tparam    ElementType  type of element
-     * @param[in] count        count of elements to be allocated
-     * @return array with <C>count</C> entries of type <C>ElementType</C>
-     */
-    #define makeLocalArray(ElementType, count) \
-        (ElementType*) alloca((int) (count) * sizeof(ElementType))
-
-    /*--------------------*/
-
     /**
      * Sets all elements in <C>array</C> of <C>count</C> elements of
      * type <C>ElementType</C> to zero.
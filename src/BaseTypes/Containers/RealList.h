@@ -17,12 +17,14 @@
 /*=========*/
 
 #include <initializer_list>
+#include "AlignedAllocator.h"
 #include "GenericList.h"
 #include "Real.h"
 
 /*--------------------*/
 
 using std::initializer_list;
+using BaseTypes::GenericTypes::AlignedAllocator;
 using BaseTypes::GenericTypes::GenericList;
 using BaseTypes::Primitives::Real;
 
@@ -43,12 +45,14 @@ namespace BaseTypes::Containers {
      * A <C>RealList</C> object is a list of real values with
      * arbitrary indexed access to positions in the list.
      * Indexing starts at zero and is consecutive.  Lists also allow
-     * duplicate elements.
+     * duplicate elements.  As for sample lists the storage is
+     * aligned to and padded to a multiple of 64 bytes.
      */
     struct RealList
         : public GenericList<Real,
                              Real::toString,
-                             _realListTypeName > {
+                             _realListTypeName,
+                             AlignedAllocator<Real>> {
 
         /*--------------------*/
         /* constructors       */
@@ -0,0 +1,157 @@
+/**
+ * @file
+ * The <C>AlignedAllocator</C> specification and body defines a
+ * standard library allocator returning storage aligned to (and
+ * padded to a multiple of) some power of two byte count.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include <cstddef>
+#include <new>
+#include "GlobalMacros.h"
+#include "StateArena.h"
+
+/*====================*/
+
+namespace BaseTypes::GenericTypes {
+
+    /**
+     * An <C>AlignedAllocator</C> is an allocator for standard
+     * containers where every storage block starts at a multiple of
+     * <C>alignment</C> bytes and its length is rounded up to a
+     * multiple of <C>alignment</C> bytes.  Hence a kernel may
+     * process the elements of a container in whole vector registers
+     * with aligned loads: the padding after the last element is
+     * addressable (but its contents are unspecified).
+     *
+     * The default alignment of 64 bytes is a cache line and the
+     * widest SIMD register (AVX-512) on current platforms.
+     *
+     * While a <C>StateArena</C> is active on the current thread, the
+     * storage is taken from that arena instead of the heap.
+     */
+    template <typename ElementType, size_t alignment = 64>
+    struct AlignedAllocator {
+
+        static_assert((alignment & (alignment - 1)) == 0,
+                      "alignment must be a power of two");
+
+        static_assert(alignment >= alignof(void*),
+                      "alignment must hold a pointer");
+
+        /** the type of the elements allocated */
+        typedef ElementType value_type;
+
+        /** the same allocator for another element type */
+        template <typename OtherElementType>
+        struct rebind {
+            typedef AlignedAllocator<OtherElementType, alignment> other;
+        };
+
+        /*--------------------*/
+        /* con-/destruction   */
+        /*--------------------*/
+
+        /**
+         * Makes an allocator.
+         */
+        AlignedAllocator () noexcept
+        {
+        }
+
+        /*--------------------*/
+
+        /**
+         * Makes an allocator from one for another element type.
+         *
+         * @param[in] other  allocator for other element type
+         */
+        template <typename OtherElementType>
+        AlignedAllocator
+            (IN AlignedAllocator<OtherElementType, alignment>&) noexcept
+        {
+        }
+
+        /*--------------------*/
+        /* allocation         */
+        /*--------------------*/
+
+        /**
+         * Returns aligned and padded storage for <C>count</C>
+         * elements.
+         *
+         * @param[in] count  number of elements
+         * @return  storage for elements
+         */
+        ElementType* allocate (IN size_t count)
+        {
+            const size_t byteCount =
+                ((count * sizeof(ElementType) + alignment - 1)
+                 & ~(alignment - 1));
+            return (ElementType*)
+                StateArena::allocateBytes(byteCount, alignment);
+        }
+
+        /*--------------------*/
+
+        /**
+         * Frees storage <C>ptr</C> for <C>count</C> elements
+         * previously returned by <C>allocate</C>.
+         *
+         * @param[in] ptr    storage to be freed
+         * @param[in] count  number of elements
+         */
+        void deallocate (INOUT ElementType* ptr, IN size_t) noexcept
+        {
+            StateArena::deallocateBytes(ptr, alignment);
+        }
+
+        /*--------------------*/
+        /* comparison         */
+        /*--------------------*/
+
+        /**
+         * Tells whether storage of <C>other</C> may be freed by
+         * current allocator (which is always true).
+         *
+         * @param[in] other  other allocator
+         * @return  information whether allocators are equivalent
+         */
+        template <typename OtherElementType>
+        bool operator ==
+            (IN AlignedAllocator<OtherElementType, alignment>&)
+            const noexcept
+        {
+            return true;
+        }
+
+        /*--------------------*/
+
+        /**
+         * Tells whether storage of <C>other</C> may not be freed by
+         * current allocator (which is always false).
+         *
+         * @param[in] other  other allocator
+         * @return  information whether allocators differ
+         */
+        template <typename OtherElementType>
+        bool operator !=
+            (IN AlignedAllocator<OtherElementType, alignment>&)
+            const noexcept
+        {
+            return false;
+        }
+
+    };
+
+}
@@ -16,8 +16,10 @@
 /* IMPORTS */
 /*=========*/
 
+#include <memory>
 #include <vector>
 
+#include "Assertion.h"
 #include "Boolean.h"
 #include "ElementToStringProc.h"
 #include "Integer.h"
@@ -42,16 +44,18 @@ namespace BaseTypes::GenericTypes {
      * Indexing starts at zero and is consecutive.  Lists also allow
      * duplicate elements..  Also a mapping may be supplied that
      * defines how to convert each element to a string for printing
-     * out the list.
+     * out the list and an allocator for the element storage (for
+     * example an <C>AlignedAllocator</C> for sample data).
      */
     template <typename ElementType,
               ElementToStringProc<ElementType> elementToString = nullptr,
-              StringProc nameOfType = nullptr>
-    struct GenericList : public vector<ElementType>
+              StringProc nameOfType = nullptr,
+              typename Allocator = std::allocator<ElementType>>
+    struct GenericList : public vector<ElementType, Allocator>
     {
 
         /** an abbreviation for the underlying vector type */
-        typedef vector<ElementType> _ElementTypeVector;
+        typedef vector<ElementType, Allocator> _ElementTypeVector;
         
         /*--------------------*/
         /* con-/destruction   */
@@ -93,6 +97,43 @@ namespace BaseTypes::GenericTypes {
 
         /*--------------------*/
 
+        /**
+         * Initializes list by taking over the elements of
+         * <C>otherList</C> without copying; <C>otherList</C> is
+         * empty afterwards.
+         *
+         * @param[inout] otherList  list to be moved into current
+         */
+        GenericList (INOUT GenericList&& otherList) noexcept
+            : _ElementTypeVector(std::move(otherList))
+        {
+        }
+
+        /*--------------------*/
+
+        /**
+         * Assigns <C>otherList</C> to current list by copying all
+         * elements.
+         *
+         * @param[in] otherList  list to be copied
+         * @return  reference to current list
+         */
+        GenericList& operator= (IN GenericList& otherList) = default;
+
+        /*--------------------*/
+
+        /**
+         * Assigns <C>otherList</C> to current list by taking over
+         * its elements without copying.
+         *
+         * @param[inout] otherList  list to be moved
+         * @return  reference to current list
+         */
+        GenericList& operator= (INOUT GenericList&& otherList)
+            noexcept = default;
+
+        /*--------------------*/
+
         /**
          * Initializes list by data from <C>elementArray</C> with
          * <C>elementCount</C> entries.
@@ -177,27 +218,42 @@ namespace BaseTypes::GenericTypes {
         /*--------------------*/
 
         /**
-         * Returns value reference to list at <C>position</C>.
+         * Returns value reference to list at <C>position</C>; the
+         * position is only checked in DEBUG mode, such that indexed
+         * access in sample loops has no exception path and may be
+         * vectorized (use <C>at</C> for checked access).
          *
          * @param[in] position  index position
          * @return  list value reference at index position
          */
         ElementType& operator [] (IN Natural position)
         {
-            return _ElementTypeVector::at((size_t) position);
+            #ifdef DEBUG
+                Assertion_pre(position < length(),
+                              "list position must be in range");
+            #endif
+
+            return _ElementTypeVector::operator[]((size_t) position);
         }
 
         /*--------------------*/
 
         /**
-         * Returns value in list at <C>position</C>.
+         * Returns value in list at <C>position</C>; the position is
+         * only checked in DEBUG mode (use <C>at</C> for checked
+         * access).
          *
          * @param[in] position  index position
          * @return  list value at index position
          */
         const ElementType& operator [] (IN Natural position) const
         {
-            return _ElementTypeVector::at((size_t) position);
+            #ifdef DEBUG
+                Assertion_pre(position < length(),
+                              "list position must be in range");
+            #endif
+
+            return _ElementTypeVector::operator[]((size_t) position);
         }
 
         /*--------------------*/
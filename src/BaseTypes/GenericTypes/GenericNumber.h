@@ -25,6 +25,7 @@
 /*=========*/
 
 #include <limits>
+#include <type_traits>
 #include "Boolean.h"
 
 using BaseTypes::Primitives::Boolean;
@@ -44,11 +45,86 @@ namespace BaseTypes::GenericTypes {
      * class.
      *
      * Very important is that the wrapper type abstraction does not
-     * impose a runtime penalty.
+     * impose a runtime penalty: all operations are constexpr and
+     * defined inline, and a derived type is expected to have exactly
+     * the layout of the elementary type (see
+     * <C>hasElementaryLayout</C>), such that arrays of wrapped values
+     * may be passed to raw (e.g. SIMD) code via <C>rawArray</C>.
      */
     template <typename Type, typename ElementaryType>
     struct GenericNumber {
 
+        /*--------------------*/
+        /* layout             */
+        /*--------------------*/
+
+        /**
+         * Tells whether <C>Type</C> is standard-layout and trivially
+         * copyable with the size and alignment of
+         * <C>ElementaryType</C>, hence whether objects and arrays of
+         * that type may be copied by <C>memcpy</C> and accessed as
+         * elementary values.
+         *
+         * @return  information whether the layout of type is that
+         *          of the elementary type
+         */
+        static constexpr Boolean hasElementaryLayout ()
+        {
+            return (std::is_standard_layout<Type>::value
+                    && std::is_trivially_copyable<Type>::value
+                    && sizeof(Type) == sizeof(ElementaryType)
+                    && alignof(Type) == alignof(ElementaryType));
+        }
+
+        /*--------------------*/
+        /* raw access         */
+        /*--------------------*/
+
+        /**
+         * Returns the current value as an elementary value without
+         * any conversion.
+         *
+         * @return  current value as elementary value
+         */
+        constexpr ElementaryType raw () const
+        {
+            return _value;
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns <C>array</C> of wrapped values as an array of
+         * elementary values (for raw or SIMD code).
+         *
+         * @param[in] array  array of wrapped values
+         * @return  the same array as elementary values
+         */
+        static ElementaryType* rawArray (INOUT Type* array)
+        {
+            static_assert(hasElementaryLayout(),
+                          "type must have the layout of its"
+                          " elementary type");
+            return reinterpret_cast<ElementaryType*>(array);
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns read-only <C>array</C> of wrapped values as an
+         * array of elementary values (for raw or SIMD code).
+         *
+         * @param[in] array  array of wrapped values
+         * @return  the same array as elementary values
+         */
+        static const ElementaryType* rawArray (IN Type* array)
+        {
+            static_assert(hasElementaryLayout(),
+                          "type must have the layout of its"
+                          " elementary type");
+            return reinterpret_cast<const ElementaryType*>(array);
+        }
+
         /*--------------------*/
         /* type conversions   */
         /*--------------------*/
@@ -59,7 +135,7 @@ namespace BaseTypes::GenericTypes {
          *
          * @return current value
          */
-        explicit operator ElementaryType () const
+        explicit constexpr operator ElementaryType () const
         {
             return _value;
         }
@@ -73,7 +149,7 @@ namespace BaseTypes::GenericTypes {
          *
          * @return negation of current value
          */
-        Type operator - () const
+        constexpr Type operator - () const
         {
             return Type{-_value};
         }
@@ -86,7 +162,7 @@ namespace BaseTypes::GenericTypes {
          * @param[in] other   value to be added
          * @return  sum of current value and other
          */
-         Type operator + (IN Type other) const
+        constexpr Type operator + (IN Type other) const
         {
             return Type{_value + other._value};
         }
@@ -99,7 +175,7 @@ namespace BaseTypes::GenericTypes {
          * @param[in] other   value to be subtracted
          * @return  difference of current value and other
          */
-        Type operator - (IN Type other) const
+        constexpr Type operator - (IN Type other) const
         {
             return Type{_value - other._value};
         }
@@ -112,7 +188,7 @@ namespace BaseTypes::GenericTypes {
          * @param[in] other   value to be multiplied
          * @return  product of current value and other
          */
-        Type operator * (IN Type other) const
+        constexpr Type operator * (IN Type other) const
         {
             return Type{_value * other._value};
         }
@@ -125,7 +201,7 @@ namespace BaseTypes::GenericTypes {
          * @param[in] other   value to be divided by
          * @return  quotient of current value and other
          */
-        Type operator / (IN Type other) const
+        constexpr Type operator / (IN Type other) const
         {
             return Type{_value / other._value};
         }
@@ -138,7 +214,7 @@ namespace BaseTypes::GenericTypes {
          * @param[in] other   value to be combined with
          * @return  bitwise-and of current value and other
          */
-        Type operator & (IN Type other) const
+        constexpr Type operator & (IN Type other) const
         {
             return Type{_value & other._value};
         }
@@ -151,7 +227,7 @@ namespace BaseTypes::GenericTypes {
          * @param[in] other   value to be combined with
          * @return  bitwise-or of current value and other
          */
-        Type operator | (IN Type other) const
+        constexpr Type operator | (IN Type other) const
         {
             return Type{_value | other._value};
         }
@@ -166,7 +242,7 @@ namespace BaseTypes::GenericTypes {
          *
          * @param[in] other   value to be added
          */
-        void operator += (IN Type other)
+        constexpr void operator += (IN Type other)
         {
             _value += other._value;
         }
@@ -179,7 +255,7 @@ namespace BaseTypes::GenericTypes {
          *
          * @param[in] other   value to be subtracted
          */
-        void operator -= (IN Type other)
+        constexpr void operator -= (IN Type other)
         {
             _value -= other._value;
         }
@@ -192,7 +268,7 @@ namespace BaseTypes::GenericTypes {
          *
          * @param[in] other   value to be multiplied
          */
-        void operator *= (IN Type other)
+        constexpr void operator *= (IN Type other)
         {
             _value *= other._value;
         }
@@ -205,7 +281,7 @@ namespace BaseTypes::GenericTypes {
          *
          * @param[in] other   value to be divided by
          */
-        void operator /= (IN Type other)
+        constexpr void operator /= (IN Type other)
         {
             _value /= other._value;
         }
@@ -221,7 +297,7 @@ namespace BaseTypes::GenericTypes {
          * @param[in] other  second value to be compared
          * @result  returns equality of <C>self</C> and <C>other</C>
          */
-        friend Boolean operator == (IN Type self, IN Type other)
+        friend constexpr Boolean operator == (IN Type self, IN Type other)
         {
             return (self._value == other._value);
         }
@@ -235,7 +311,7 @@ namespace BaseTypes::GenericTypes {
          * @param[in] other  second value to be compared
          * @result  returns inequality of <C>self</C> and <C>other</C>
          */
-        friend Boolean operator != (IN Type self, IN Type other)
+        friend constexpr Boolean operator != (IN Type self, IN Type other)
         {
             return (self._value != other._value);
         }
@@ -250,7 +326,7 @@ namespace BaseTypes::GenericTypes {
          * @result  returns information whether <C>self</C> is less
          *          than <C>other</C>
          */
-        friend Boolean operator < (IN Type self, IN Type other)
+        friend constexpr Boolean operator < (IN Type self, IN Type other)
         {
             return (self._value < other._value);
         }
@@ -266,7 +342,7 @@ namespace BaseTypes::GenericTypes {
          * @result  returns information whether <C>self</C> is not
          *          greater than <C>other</C>
          */
-        friend Boolean operator <= (IN Type self, IN Type other)
+        friend constexpr Boolean operator <= (IN Type self, IN Type other)
         {
             return (self._value <= other._value);
         }
@@ -281,7 +357,7 @@ namespace BaseTypes::GenericTypes {
          * @result  returns information whether <C>self</C> is greater
          *          than <C>other</C>
          */
-        friend Boolean operator > (IN Type self, IN Type other)
+        friend constexpr Boolean operator > (IN Type self, IN Type other)
         {
             return (self._value > other._value);
         }
@@ -297,7 +373,7 @@ namespace BaseTypes::GenericTypes {
          * @result  returns information whether <C>self</C> is not
          *          less than <C>other</C>
          */
-        friend Boolean operator >= (IN Type self, IN Type other)
+        friend constexpr Boolean operator >= (IN Type self, IN Type other)
         {
             return (self._value >= other._value);
         }
@@ -315,7 +391,7 @@ namespace BaseTypes::GenericTypes {
          * @return  information whether current value is between lowerEndPoint
          *          and upperEndPoint with both values included
          */
-        Boolean
+        constexpr Boolean
         isInInterval (IN Type lowerEndPoint, IN Type upperEndPoint) const
         {
             return (lowerEndPoint._value <= _value
@@ -332,7 +408,7 @@ namespace BaseTypes::GenericTypes {
          * @param[in] y  some value
          * @return  the maximum of both values
          */
-        static Type maximum (IN Type x, IN Type y)
+        static constexpr Type maximum (IN Type x, IN Type y)
         {
             return (x > y ? x : y);
         }
@@ -346,7 +422,7 @@ namespace BaseTypes::GenericTypes {
          * @param[in] y  some value
          * @return  the minimum of both values
          */
-        static Type minimum (IN Type x, IN Type y)
+        static constexpr Type minimum (IN Type x, IN Type y)
         {
             return (x < y ? x : y);
         }
@@ -358,7 +434,7 @@ namespace BaseTypes::GenericTypes {
          *
          * @return maximum value of Type
          */
-        static Type maximumValue ()
+        static constexpr Type maximumValue ()
         {
             return Type{std::numeric_limits<ElementaryType>::max()};
         }
@@ -371,6 +447,25 @@ namespace BaseTypes::GenericTypes {
             /** the internal representation */
             ElementaryType _value;
 
+            /*--------------------*/
+
+            /**
+             * Initializes number to an unspecified value.
+             */
+            GenericNumber () = default;
+
+            /*--------------------*/
+
+            /**
+             * Initializes number from elementary <C>value</C>.
+             *
+             * @param[in] value  elementary value
+             */
+            constexpr GenericNumber (IN ElementaryType value)
+                : _value{value}
+            {
+            }
+
     };
 
 }
@@ -0,0 +1,512 @@
+/**
+ * @file
+ * The <C>GenericStringHashMap</C> specification and body defines
+ * hash maps from string keys to arbitrary values with contiguous
+ * storage.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "Assertion.h"
+#include "ElementToStringProc.h"
+#include "GenericList.h"
+#include "StringProc.h"
+#include "StringUtil.h"
+
+/*--------------------*/
+
+using BaseModules::StringUtil;
+using BaseTypes::GenericTypes::ElementToStringProc;
+using BaseTypes::GenericTypes::StringProc;
+
+/*====================*/
+
+namespace BaseTypes::GenericTypes {
+
+    /**
+     * A <C>GenericStringHashMap</C> object maps string keys to
+     * values.  Every key is associated with at most one value, where
+     * the key identity is defined by standard string comparison.
+     *
+     * The entries are stored contiguously in order of their
+     * insertion together with the precomputed hash of their key; a
+     * separate open-addressing table with linear probing maps hashes
+     * to entry positions, such that a lookup hashes the key once and
+     * compares full strings only for matching hashes.  Apart from
+     * the growth of those two arrays no heap allocation is done per
+     * entry.  Iteration yields key-value pairs in insertion order.
+     * Additionally a mapping may be supplied that defines how to
+     * convert values to a string for printing out the map.
+     */
+    template <typename ValueType,
+              ElementToStringProc<ValueType> valueToString = nullptr,
+              StringProc nameOfType = nullptr>
+    struct GenericStringHashMap {
+
+        /** the type of an entry in the map */
+        typedef std::pair<String, ValueType> _Entry;
+
+        /** an abbreviation for a list of keys */
+        typedef GenericList<String> _KeyList;
+
+        /** an abbreviation for a list of values */
+        typedef GenericList<ValueType> _ValueList;
+
+        /** the iterator type over the entries */
+        typedef typename std::vector<_Entry>::const_iterator
+            const_iterator;
+
+        /*--------------------*/
+        /* con-/destructor    */
+        /*--------------------*/
+
+        /**
+         * Makes an empty map.
+         */
+        GenericStringHashMap ()
+            : _entryList{},
+              _hashList{},
+              _slotList{}
+        {
+        }
+
+        /*--------------------*/
+
+        /**
+         * Destroys current map.
+         */
+        virtual ~GenericStringHashMap ()
+        {
+        }
+
+        /*--------------------*/
+        /* type conversion    */
+        /*--------------------*/
+
+        /**
+         * Converts map to linear string representation prefixed by
+         * <C>nameOfType</C> template parameter; when the string
+         * conversion function <C>valueToString</C> is not defined,
+         * some surrogate function is used
+         *
+         * @return  single string representation of map
+         */
+        String toString () const
+        {
+            String result = "";
+            const String keyValueSeparator = " -> ";
+
+            for (size_t i = 0;  i < _entryList.size();  i++) {
+                const _Entry& entry = _entryList[i];
+                const String iAsString = TOSTRING(Natural{i});
+                result += (i == 0 ? "" : ", ");
+                result +=
+                    (StringUtil::toPrintableString(entry.first)
+                     + keyValueSeparator
+                     + (valueToString == nullptr
+                        ? StringUtil::expand("v%1", iAsString)
+                        : (*valueToString)(entry.second)));
+            }
+
+            String typeName = (nameOfType == nullptr ? "Map"
+                               : (*nameOfType)());
+            result = StringUtil::expand("%1(%2)", typeName, result);
+            return result;
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns string representation of map.
+         *
+         * @param[in] map  map to be converted to a string
+         * @return  string representation
+         */
+        static String toString (IN GenericStringHashMap& map)
+        {
+            return map.toString();
+        }
+
+        /*--------------------*/
+        /* data access        */
+        /*--------------------*/
+
+        /**
+         * Returns entry for <C>key</C>.
+         *
+         * @param[in] key  key within map
+         * @return entry for <C>key</C> in map
+         * @pre contains(key)
+         */
+        ValueType at (IN String& key) const
+        {
+            const size_t position = _find(key, _hash(key));
+            Assertion_pre(position != _notFound,
+                          "key must be contained in map");
+            return _entryList[position].second;
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns entry for <C>key</C> or otherwise
+         * <C>defaultValue</C>.
+         *
+         * @param[in] key           key within map
+         * @param[in] defaultValue  value to use when key is not found
+         * @return entry for <C>key</C> in map
+         */
+        ValueType atWithDefault (IN String& key,
+                                 IN ValueType& defaultValue) const
+        {
+            const size_t position = _find(key, _hash(key));
+            return (position == _notFound ? defaultValue
+                    : _entryList[position].second);
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns reference to the entry for <C>key</C>; when
+         * <C>key</C> is not in map, it is added with a default
+         * value.
+         *
+         * @param[in] key  key within map
+         * @return reference to entry for <C>key</C> in map
+         */
+        ValueType& operator [] (IN String& key)
+        {
+            const size_t hash = _hash(key);
+            size_t position = _find(key, hash);
+
+            if (position == _notFound) {
+                position = _append(key, hash, ValueType{});
+            }
+
+            return _entryList[position].second;
+        }
+
+        /*--------------------*/
+        /* measurement        */
+        /*--------------------*/
+
+        /**
+         * Tells whether map has entry for <C>key</C>.
+         *
+         * @param[in] key  key to be tested for existence within map
+         * @return information whether <C>key</C> is in map
+         */
+        Boolean contains (IN String& key) const
+        {
+            return (_find(key, _hash(key)) != _notFound);
+        }
+
+        /*--------------------*/
+
+        /**
+         * Tells whether map is empty.
+         *
+         * @return information whether map is empty
+         */
+        Boolean isEmpty () const
+        {
+            return _entryList.empty();
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of entries in map.
+         *
+         * @return  count of keys
+         */
+        Natural size () const
+        {
+            return Natural{_entryList.size()};
+        }
+
+        /*-----------------------*/
+        /* aggregate data access */
+        /*-----------------------*/
+
+        /**
+         * Returns list of key elements in order of insertion.
+         *
+         * @return  list of keys
+         */
+        _KeyList keyList () const
+        {
+            _KeyList result;
+
+            for (const _Entry& entry : _entryList) {
+                result.append(entry.first);
+            }
+
+            return result;
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns list of value elements in order of insertion of
+         * their keys.
+         *
+         * @return  list of values
+         */
+        _ValueList valueList () const
+        {
+            _ValueList result;
+
+            for (const _Entry& entry : _entryList) {
+                result.append(entry.second);
+            }
+
+            return result;
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns iterator to first entry.
+         *
+         * @return  iterator at start of entries
+         */
+        const_iterator begin () const
+        {
+            return _entryList.cbegin();
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns iterator after last entry.
+         *
+         * @return  iterator at end of entries
+         */
+        const_iterator end () const
+        {
+            return _entryList.cend();
+        }
+
+        /*--------------------*/
+        /* change             */
+        /*--------------------*/
+
+        /**
+         * Removes all entries from map (keeping the storage).
+         */
+        void clear ()
+        {
+            _entryList.clear();
+            _hashList.clear();
+            std::fill(_slotList.begin(), _slotList.end(), _emptySlot);
+        }
+
+        /*--------------------*/
+
+        /**
+         * Removes entry for <C>key</C>; the last entry takes its
+         * position.
+         *
+         * @param[in] key    key within map
+         */
+        void remove (IN String& key)
+        {
+            const size_t position = _find(key, _hash(key));
+
+            if (position != _notFound) {
+                const size_t lastPosition = _entryList.size() - 1;
+
+                if (position != lastPosition) {
+                    _entryList[position] = std::move(_entryList.back());
+                    _hashList[position]  = _hashList.back();
+                }
+
+                _entryList.pop_back();
+                _hashList.pop_back();
+                _rebuildSlotList(_slotList.size());
+            }
+        }
+
+        /*--------------------*/
+
+        /**
+         * Sets entry for <C>key</C> to <C>value</C>.
+         *
+         * @param[in] key    key within map
+         * @param[in] value  new associated value for key
+         */
+        void set (IN String& key, IN ValueType& value)
+        {
+            const size_t hash = _hash(key);
+            const size_t position = _find(key, hash);
+
+            if (position == _notFound) {
+                _append(key, hash, value);
+            } else {
+                _entryList[position].second = value;
+            }
+        }
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the marker for an empty slot in the slot list */
+            static constexpr std::uint32_t _emptySlot = 0;
+
+            /** the position returned for a key not in map */
+            static constexpr size_t _notFound = SIZE_MAX;
+
+            /** the minimum number of slots in the slot list */
+            static constexpr size_t _minimumSlotCount = 16;
+
+            /** the entries in order of insertion */
+            std::vector<_Entry> _entryList;
+
+            /** the hashes of the entry keys (by position) */
+            std::vector<size_t> _hashList;
+
+            /** the open-addressing table with entry position plus
+             * one per slot (zero for an empty slot); its length is a
+             * power of two and at least twice the entry count */
+            std::vector<std::uint32_t> _slotList;
+
+            /*--------------------*/
+
+            /**
+             * Returns the hash of <C>key</C> (FNV-1a).
+             *
+             * @param[in] key  string to be hashed
+             * @return  hash value
+             */
+            static size_t _hash (IN String& key)
+            {
+                std::uint64_t result = 14695981039346656037ull;
+
+                for (const char ch : key) {
+                    result ^= (std::uint64_t) (unsigned char) ch;
+                    result *= 1099511628211ull;
+                }
+
+                return (size_t) result;
+            }
+
+            /*--------------------*/
+
+            /**
+             * Returns the entry position of <C>key</C> with hash
+             * <C>hash</C> or <C>_notFound</C>.
+             *
+             * @param[in] key   key to be searched
+             * @param[in] hash  hash of key
+             * @return  position in entry list
+             */
+            size_t _find (IN String& key, IN size_t hash) const
+            {
+                size_t result = _notFound;
+                const size_t slotCount = _slotList.size();
+
+                if (slotCount > 0) {
+                    const size_t mask = slotCount - 1;
+
+                    for (size_t i = hash & mask;
+                         _slotList[i] != _emptySlot;
+                         i = (i + 1) & mask) {
+                        const size_t position = _slotList[i] - 1;
+
+                        if (_hashList[position] == hash
+                            && _entryList[position].first == key) {
+                            result = position;
+                            break;
+                        }
+                    }
+                }
+
+                return result;
+            }
+
+            /*--------------------*/
+
+            /**
+             * Appends entry for <C>key</C> with <C>hash</C> and
+             * <C>value</C> and returns its position.
+             *
+             * @param[in] key    new key
+             * @param[in] hash   hash of key
+             * @param[in] value  value for key
+             * @return  position of new entry
+             */
+            size_t _append (IN String& key,
+                            IN size_t hash,
+                            IN ValueType& value)
+            {
+                const size_t result = _entryList.size();
+                _entryList.emplace_back(key, value);
+                _hashList.push_back(hash);
+
+                if (2 * _entryList.size() > _slotList.size()) {
+                    _rebuildSlotList(std::max(_minimumSlotCount,
+                                              2 * _slotList.size()));
+                } else {
+                    _insertSlot(result);
+                }
+
+                return result;
+            }
+
+            /*--------------------*/
+
+            /**
+             * Enters entry at <C>position</C> into the slot list.
+             *
+             * @param[in] position  position in entry list
+             */
+            void _insertSlot (IN size_t position)
+            {
+                const size_t mask = _slotList.size() - 1;
+                size_t i = _hashList[position] & mask;
+
+                while (_slotList[i] != _emptySlot) {
+                    i = (i + 1) & mask;
+                }
+
+                _slotList[i] = (std::uint32_t) (position + 1);
+            }
+
+            /*--------------------*/
+
+            /**
+             * Rebuilds the slot list with <C>slotCount</C> slots
+             * from the entry list.
+             *
+             * @param[in] slotCount  new number of slots (a power of
+             *                       two)
+             */
+            void _rebuildSlotList (IN size_t slotCount)
+            {
+                _slotList.assign(slotCount, _emptySlot);
+
+                for (size_t position = 0;  position < _entryList.size();
+                     position++) {
+                    _insertSlot(position);
+                }
+            }
+
+    };
+
+}
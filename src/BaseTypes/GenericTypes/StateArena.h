@@ -0,0 +1,450 @@
+/**
+ * @file
+ * The <C>StateArena</C> specification and body defines a
+ * contiguous memory area per plugin instance from which the storage
+ * of aligned containers is taken while the instance is being set
+ * up.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include "GlobalMacros.h"
+#include "MemoryPages.h"
+
+/*--------------------*/
+
+using BaseModules::MemoryPages;
+
+/*====================*/
+
+namespace BaseTypes::GenericTypes {
+
+    /**
+     * A <C>StateArena</C> object is a contiguous memory area owned
+     * by a single plugin instance.  While a <C>Scope</C> for the
+     * arena is active on some thread, every storage block requested
+     * by an <C>AlignedAllocator</C> on that thread is taken from the
+     * arena by simply advancing a position; hence the state built
+     * during the setup of an instance lies contiguously in the order
+     * of construction (normally the processing order) instead of
+     * being scattered over the heap.  Requests exceeding the
+     * remaining capacity are served from the heap and counted, such
+     * that the next <C>reserve</C> may take them into account.
+     *
+     * Storage from an arena is never freed individually: a retired
+     * arena area (after <C>release</C> or a new <C>reserve</C>) is
+     * returned to the heap when the last container still using it
+     * has given back its storage, so containers surviving a release
+     * stay valid.
+     *
+     * An area may be prefaulted and locked in physical memory after
+     * the setup, such that the first accesses on the audio thread
+     * cause no page faults; large areas (like those for batch
+     * rendering) may be allocated with large pages.
+     */
+    struct StateArena {
+
+        /**
+         * A <C>Scope</C> object makes an arena the source of aligned
+         * container storage for the current thread from
+         * construction to destruction; scopes may be nested, the
+         * innermost one wins.
+         */
+        struct Scope {
+
+            /**
+             * Activates <C>arena</C> for the current thread.
+             *
+             * @param[inout] arena  arena to be used for allocations
+             */
+            Scope (INOUT StateArena& arena)
+                : _previousArena{_currentArena}
+            {
+                _currentArena = &arena;
+            }
+
+            /*--------------------*/
+
+            /**
+             * Reactivates the arena active before construction.
+             */
+            ~Scope ()
+            {
+                _currentArena = _previousArena;
+            }
+
+            /*--------------------*/
+
+            Scope (IN Scope&) = delete;
+
+            /*--------------------*/
+            /*--------------------*/
+
+            private:
+
+                /** the arena active before this scope */
+                StateArena* _previousArena;
+
+        };
+
+        /*--------------------*/
+        /* con-/destruction   */
+        /*--------------------*/
+
+        /**
+         * Makes an empty arena.
+         */
+        StateArena ()
+            : _area{nullptr},
+              _overflowByteCount{0}
+        {
+        }
+
+        /*--------------------*/
+
+        /**
+         * Retires the area of arena.
+         */
+        ~StateArena ()
+        {
+            release();
+        }
+
+        /*--------------------*/
+
+        StateArena (IN StateArena&) = delete;
+
+        /*--------------------*/
+        /* property queries   */
+        /*--------------------*/
+
+        /**
+         * Returns the capacity of the current area in bytes (zero
+         * when released).
+         *
+         * @return  capacity of arena
+         */
+        size_t capacity () const
+        {
+            return (_area == nullptr ? 0 : _area->capacity);
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of bytes taken from the current area
+         * (including headers and alignment padding).
+         *
+         * @return  used bytes in arena
+         */
+        size_t usedByteCount () const
+        {
+            return (_area == nullptr ? 0 : _area->position);
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of bytes requested since the last
+         * <C>reserve</C> which did not fit into the arena and have
+         * been taken from the heap.
+         *
+         * @return  overflow bytes
+         */
+        size_t overflowByteCount () const
+        {
+            return _overflowByteCount;
+        }
+
+        /*--------------------*/
+        /* area handling      */
+        /*--------------------*/
+
+        /**
+         * Retires the current area and sets up a new one with
+         * <C>byteCount</C> bytes (none for zero); when
+         * <C>hasLargePages</C> is set, the area is taken directly
+         * from the operating system with large pages where
+         * possible.  Must not be called on the audio thread.
+         *
+         * @param[in] byteCount      capacity of new area
+         * @param[in] hasLargePages  information whether large pages
+         *                           are requested
+         */
+        void reserve (IN size_t byteCount,
+                      IN Boolean hasLargePages = false)
+        {
+            release();
+            _overflowByteCount = 0;
+
+            if (byteCount > 0) {
+                char* memory = nullptr;
+
+                if (hasLargePages) {
+                    memory = (char*) MemoryPages::allocateLarge(byteCount);
+                }
+
+                _area = new _Area();
+                _area->isMapped = (memory != nullptr);
+
+                if (!_area->isMapped) {
+                    memory =
+                        (char*) ::operator new(byteCount,
+                                               std::align_val_t{_alignment});
+                }
+
+                _area->memory = memory;
+                _area->capacity = byteCount;
+                _area->position = 0;
+                _area->isLocked = false;
+                _area->referenceCount = 1;
+            }
+        }
+
+        /*--------------------*/
+
+        /**
+         * Touches all pages of the current area, such that they are
+         * backed by physical memory and their first access causes no
+         * page fault; when <C>isLocked</C> is set, the pages are
+         * also locked in physical memory until the area is freed.
+         * Tells whether the requested locking has been permitted.
+         * Must be called when no other thread accesses the area.
+         *
+         * @param[in] isLocked  information whether area shall be
+         *                      locked in memory
+         * @return  information whether locking (if requested) has
+         *          been successful
+         */
+        Boolean prefault (IN Boolean isLocked)
+        {
+            Boolean isOkay = true;
+
+            if (_area != nullptr) {
+                MemoryPages::prefault(_area->memory, _area->capacity);
+
+                if (isLocked && !_area->isLocked) {
+                    _area->isLocked =
+                        MemoryPages::lock(_area->memory, _area->capacity);
+                    isOkay = _area->isLocked;
+                }
+            }
+
+            return isOkay;
+        }
+
+        /*--------------------*/
+
+        /**
+         * Retires the current area: no further storage is taken
+         * from it and it is freed as soon as no container uses it
+         * any longer.
+         */
+        void release ()
+        {
+            if (_area != nullptr) {
+                _releaseArea(_area);
+                _area = nullptr;
+            }
+        }
+
+        /*--------------------*/
+        /* allocation         */
+        /*--------------------*/
+
+        /**
+         * Returns storage for <C>byteCount</C> bytes aligned to
+         * <C>alignment</C> from the arena active on the current
+         * thread or from the heap when there is none or it is
+         * exhausted.
+         *
+         * @param[in] byteCount  number of bytes requested
+         * @param[in] alignment  alignment of storage (a power of two)
+         * @return  storage for the bytes
+         */
+        static void* allocateBytes (IN size_t byteCount,
+                                    IN size_t alignment)
+        {
+            const size_t headerLength = _headerLength(alignment);
+            StateArena* arena = _currentArena;
+            _Area* area = (arena == nullptr ? nullptr : arena->_area);
+            char* result = nullptr;
+
+            if (area != nullptr) {
+                /* the header precedes the aligned storage */
+                const size_t position =
+                    _roundedUp(area->position + headerLength, alignment);
+
+                if (alignment <= _alignment
+                    && position + byteCount <= area->capacity) {
+                    area->position = position + byteCount;
+                    area->referenceCount++;
+                    result = area->memory + position;
+                } else {
+                    arena->_overflowByteCount += byteCount;
+                    area = nullptr;
+                }
+            }
+
+            if (result == nullptr) {
+                char* memory =
+                    (char*) ::operator new(headerLength + byteCount,
+                                           std::align_val_t{alignment});
+                result = memory + headerLength;
+            }
+
+            std::memcpy(result - sizeof(_Area*), &area, sizeof(_Area*));
+            return result;
+        }
+
+        /*--------------------*/
+
+        /**
+         * Frees storage <C>ptr</C> with <C>alignment</C> previously
+         * returned by <C>allocateBytes</C>.
+         *
+         * @param[in] ptr        storage to be freed
+         * @param[in] alignment  alignment of storage
+         */
+        static void deallocateBytes (INOUT void* ptr,
+                                     IN size_t alignment) noexcept
+        {
+            _Area* area;
+            std::memcpy(&area, (char*) ptr - sizeof(_Area*),
+                        sizeof(_Area*));
+
+            if (area != nullptr) {
+                _releaseArea(area);
+            } else {
+                char* memory = (char*) ptr - _headerLength(alignment);
+                ::operator delete(memory, std::align_val_t{alignment});
+            }
+        }
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /**
+             * An <C>_Area</C> object is a memory block of an arena
+             * together with the number of its users (the arena
+             * itself and each storage block taken from it).
+             */
+            struct _Area {
+
+                /** the aligned memory of the area */
+                char* memory;
+
+                /** the size of the memory in bytes */
+                size_t capacity;
+
+                /** the first free position in memory */
+                size_t position;
+
+                /** tells whether memory comes directly from the
+                 * operating system (with large pages) */
+                Boolean isMapped;
+
+                /** tells whether memory is locked in physical
+                 * memory */
+                Boolean isLocked;
+
+                /** the number of users of the area */
+                std::atomic<size_t> referenceCount;
+
+            };
+
+            /*--------------------*/
+
+            /** the alignment of areas (a cache line) */
+            static constexpr size_t _alignment = 64;
+
+            /** the arena active on the current thread (if any) */
+            static inline thread_local StateArena* _currentArena =
+                nullptr;
+
+            /*--------------------*/
+
+            /** the current area (nullptr when released) */
+            _Area* _area;
+
+            /** the number of requested bytes taken from the heap
+             * since the last reservation */
+            size_t _overflowByteCount;
+
+            /*--------------------*/
+            /*--------------------*/
+
+            /**
+             * Returns the length of the header in front of a
+             * storage block with <C>alignment</C> holding the
+             * pointer to its area.
+             *
+             * @param[in] alignment  alignment of storage
+             * @return  header length in bytes
+             */
+            static size_t _headerLength (IN size_t alignment)
+            {
+                return _roundedUp(sizeof(_Area*), alignment);
+            }
+
+            /*--------------------*/
+
+            /**
+             * Drops one user of <C>area</C> and frees the area when
+             * it was the last one.
+             *
+             * @param[inout] area  area to be released
+             */
+            static void _releaseArea (INOUT _Area* area) noexcept
+            {
+                if (area->referenceCount.fetch_sub(1) == 1) {
+                    if (area->isLocked) {
+                        MemoryPages::unlock(area->memory, area->capacity);
+                    }
+
+                    if (area->isMapped) {
+                        MemoryPages::freeLarge(area->memory,
+                                               area->capacity);
+                    } else {
+                        ::operator delete(area->memory,
+                                          std::align_val_t{_alignment});
+                    }
+
+                    delete area;
+                }
+            }
+
+            /*--------------------*/
+
+            /**
+             * Returns <C>value</C> rounded up to a multiple of
+             * <C>alignment</C>.
+             *
+             * @param[in] value      value to be rounded
+             * @param[in] alignment  a power of two
+             * @return  rounded value
+             */
+            static size_t _roundedUp (IN size_t value,
+                                      IN size_t alignment)
+            {
+                return (value + alignment - 1) & ~(alignment - 1);
+            }
+
+    };
+
+}
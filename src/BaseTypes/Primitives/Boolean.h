@@ -34,9 +34,9 @@ namespace BaseTypes::Primitives {
         /**
          * Initializes boolean to an unspecified value.
          */
-        Boolean ()
+        constexpr Boolean ()
+            : _value{false}
         {
-            _value = false;
         }
 
         /*--------------------*/
@@ -46,9 +46,9 @@ namespace BaseTypes::Primitives {
          *
          * @param[in] b  bool value
          */
-        Boolean (IN bool b)
+        constexpr Boolean (IN bool b)
+            : _value{b}
         {
-            _value = b;
         }
 
         /*--------------------*/
@@ -73,7 +73,7 @@ namespace BaseTypes::Primitives {
          *
          * @return current value as a bool value
          */
-        operator bool () const
+        constexpr operator bool () const
         {
             return _value;
         }
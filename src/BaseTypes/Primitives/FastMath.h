@@ -0,0 +1,218 @@
+/**
+ * @file
+ * The <C>FastMath</C> specification and body provides fast
+ * approximations with bounded error for binary logarithm and
+ * exponential and the decibel conversions based on them.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-02
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include <cstdint>
+#include <cstring>
+#include "Real.h"
+
+/*====================*/
+
+namespace BaseTypes::Primitives {
+
+    /**
+     * The <C>FastMath</C> package provides approximations of
+     * logarithm and exponential functions for use in inner audio
+     * loops.  They only use bit manipulation of the IEEE-754 double
+     * representation, additions, multiplications and a single
+     * division (no library calls and no branches besides clamping),
+     * hence loops over them can be vectorized by the compiler.
+     *
+     * Error bounds (verified by dense sampling of the argument
+     * ranges):
+     *   - <C>fastLog2</C>: absolute error at most 5E-8 for positive
+     *     normal arguments,
+     *   - <C>fastExp2</C>: relative error at most 1E-8 for
+     *     arguments in [-1022, 1023],
+     *   - <C>fastDbToLinear</C> and <C>fastLinearToDb</C>: deviation
+     *     at most 1E-6dB from the exact conversion.
+     */
+    struct FastMath {
+
+        /** the maximum absolute error of <C>fastLog2</C> */
+        static constexpr double log2ErrorBound = 5E-8;
+
+        /** the maximum relative error of <C>fastExp2</C> */
+        static constexpr double exp2ErrorBound = 1E-8;
+
+        /** the maximum deviation in decibels of the decibel
+         * conversions */
+        static constexpr double dBErrorBound = 1E-6;
+
+        /*--------------------*/
+
+        /**
+         * Returns an approximation of the binary logarithm of
+         * <C>x</C>; <C>x</C> must be positive and normal.
+         *
+         * @param[in] x  positive value
+         * @return  approximation of log2(x)
+         */
+        static inline double fastLog2 (IN double x)
+        {
+            /* split x into exponent and mantissa m in
+               [sqrt(1/2), sqrt(2)) */
+            std::uint64_t bits;
+            std::memcpy(&bits, &x, sizeof(bits));
+            const std::uint64_t mantissaBits = bits & _mantissaMask;
+            const std::uint64_t isUpperHalf =
+                (mantissaBits >= _sqrt2MantissaBits ? 1 : 0);
+            const std::int64_t exponent =
+                (std::int64_t) (bits >> 52) - 1023
+                + (std::int64_t) isUpperHalf;
+            bits = mantissaBits | ((1023 - isUpperHalf) << 52);
+            double m;
+            std::memcpy(&m, &bits, sizeof(m));
+
+            /* log2(m) = 2/ln2 * atanh(s) with s = (m-1)/(m+1) and
+               |s| < 0.1716 */
+            const double s  = (m - 1.0) / (m + 1.0);
+            const double s2 = s * s;
+            const double series =
+                s * (1.0 + s2 * (1.0 / 3.0
+                                 + s2 * (1.0 / 5.0
+                                         + s2 * (1.0 / 7.0))));
+            return (double) exponent + _twoByLn2 * series;
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns an approximation of two to the <C>x</C> power;
+         * <C>x</C> is clamped to [-1022, 1023].
+         *
+         * @param[in] x  exponent
+         * @return  approximation of 2^x
+         */
+        static inline double fastExp2 (IN double x)
+        {
+            const double clampedX =
+                (x < -1022.0 ? -1022.0 : (x > 1023.0 ? 1023.0 : x));
+
+            /* split into integer n and fraction f in [-0.5, 0.5] */
+            const double roundedX = clampedX + _roundingConstant;
+            const double n = roundedX - _roundingConstant;
+            const double f = clampedX - n;
+
+            /* 2^f = e^(f*ln2) by Taylor polynomial of degree 7 */
+            const double t = f * _ln2;
+            const double p =
+                1.0 + t * (1.0 + t * (1.0 / 2.0 + t * (1.0 / 6.0
+                + t * (1.0 / 24.0 + t * (1.0 / 120.0
+                + t * (1.0 / 720.0 + t * (1.0 / 5040.0)))))));
+
+            /* scale by 2^n via the exponent bits */
+            const std::uint64_t scaleBits =
+                (std::uint64_t) ((std::int64_t) n + 1023) << 52;
+            double scale;
+            std::memcpy(&scale, &scaleBits, sizeof(scale));
+            return p * scale;
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns an approximation of the linear factor for
+         * <C>dBValue</C> with given <C>quotient</C> (20 for
+         * amplitudes, 10 for powers).
+         *
+         * @param[in] dBValue   the decibel value to be converted
+         * @param[in] quotient  the factor to be applied to log value
+         * @return  approximation of linear factor
+         */
+        static inline double fastDbToLinear (IN double dBValue,
+                                             IN double quotient = 20.0)
+        {
+            return fastExp2(dBValue * _log2Of10 / quotient);
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns an approximation of the decibel value for linear
+         * factor <C>value</C> with given <C>quotient</C> (20 for
+         * amplitudes, 10 for powers); <C>value</C> must be positive
+         * and normal.
+         *
+         * @param[in] value     the positive linear factor
+         * @param[in] quotient  the factor to be applied to log value
+         * @return  approximation of decibel value
+         */
+        static inline double fastLinearToDb (IN double value,
+                                             IN double quotient = 20.0)
+        {
+            return fastLog2(value) * quotient / _log2Of10;
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns an approximation of the natural logarithm of
+         * <C>x</C> (absolute error at most 4E-8); <C>x</C> must be
+         * positive and normal.
+         *
+         * @param[in] x  positive value
+         * @return  approximation of ln(x)
+         */
+        static inline Real fastLog (IN Real x)
+        {
+            return Real{fastLog2((double) x) * _ln2};
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns an approximation of e to the <C>x</C> power
+         * (relative error at most 1E-8).
+         *
+         * @param[in] x  exponent
+         * @return  approximation of e^x
+         */
+        static inline Real fastExp (IN Real x)
+        {
+            return Real{fastExp2((double) x / _ln2)};
+        }
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** ln(2) */
+            static constexpr double _ln2 = 0.69314718055994530942;
+
+            /** 2 / ln(2) */
+            static constexpr double _twoByLn2 = 2.88539008177792681472;
+
+            /** log2(10) */
+            static constexpr double _log2Of10 = 3.32192809488736234787;
+
+            /** the constant 1.5 * 2^52 for rounding to the nearest
+             * integer by addition */
+            static constexpr double _roundingConstant = 6755399441055744.0;
+
+            /** the mask of the mantissa bits of a double */
+            static constexpr std::uint64_t _mantissaMask =
+                0x000FFFFFFFFFFFFFull;
+
+            /** the mantissa bits of sqrt(2) */
+            static constexpr std::uint64_t _sqrt2MantissaBits =
+                0x0006A09E667F3BCDull;
+
+    };
+
+}
@@ -41,9 +41,7 @@ namespace BaseTypes::Primitives {
         /**
          * Initializes integer to an unspecified value.
          */
-        Integer ()
-        {
-        }
+        Integer () = default;
 
         /*--------------------*/
 
@@ -52,9 +50,9 @@ namespace BaseTypes::Primitives {
          *
          * @param[in] i  int value
          */
-        Integer (IN int i)
+        constexpr Integer (IN int i)
+            : GenericNumber{i}
         {
-            _value = i;
         }
 
         /*--------------------*/
@@ -64,9 +62,9 @@ namespace BaseTypes::Primitives {
          *
          * @param[in] n  natural value
          */
-        Integer (IN Natural n)
+        constexpr Integer (IN Natural n)
+            : GenericNumber{(int) (size_t) n}
         {
-            _value = (int) (size_t) n;
         }
 
         /*--------------------*/
@@ -105,7 +103,7 @@ namespace BaseTypes::Primitives {
          *
          * @return current value as a floating point value
          */
-        explicit operator float () const
+        explicit constexpr operator float () const
         {
             return (float) _value;
         }
@@ -118,7 +116,7 @@ namespace BaseTypes::Primitives {
          *
          * @return current value as a floating point value
          */
-        explicit operator double () const
+        explicit constexpr operator double () const
         {
             return (double) _value;
         }
@@ -131,7 +129,7 @@ namespace BaseTypes::Primitives {
          *
          * @return current value as a size_t value
          */
-        explicit operator size_t () const
+        explicit constexpr operator size_t () const
         {
             return (size_t) _value;
         }
@@ -144,7 +142,7 @@ namespace BaseTypes::Primitives {
          *
          * @return current value as a natural value
          */
-        explicit operator Natural () const
+        explicit constexpr operator Natural () const
         {
             return Natural{(int) _value};
         }
@@ -193,7 +191,7 @@ namespace BaseTypes::Primitives {
          *                   divisor
          * @return  modulus of current and <C>other</C>.
          */
-        Integer operator % (IN Integer other) const
+        constexpr Integer operator % (IN Integer other) const
         {
             return Integer{_value % other._value};
         }
@@ -205,7 +203,7 @@ namespace BaseTypes::Primitives {
          *
          * @return  previous value of integer
          */
-        Integer operator ++ (int)
+        constexpr Integer operator ++ (int)
         {
             return Integer{_value++};
         }
@@ -217,7 +215,7 @@ namespace BaseTypes::Primitives {
          *
          * @return  current value of integer
          */
-        Integer operator ++ ()
+        constexpr Integer operator ++ ()
         {
             return Integer{--_value};
         }
@@ -229,7 +227,7 @@ namespace BaseTypes::Primitives {
          *
          * @return  previous value of integer
          */
-        Integer operator -- (int)
+        constexpr Integer operator -- (int)
         {
             return Integer{_value--};
         }
@@ -241,7 +239,7 @@ namespace BaseTypes::Primitives {
          *
          * @return  current value of integer
          */
-        Integer operator -- ()
+        constexpr Integer operator -- ()
         {
             return Integer{--_value};
         }
@@ -379,4 +377,11 @@ namespace BaseTypes::Primitives {
 
     };
 
+    /*--------------------*/
+
+    /* integers are stored exactly like ints, hence arrays of
+       integers may be handed to raw code as int arrays */
+    static_assert(Integer::hasElementaryLayout(),
+                  "integer must have the layout of an int");
+
 }
@@ -46,9 +46,7 @@ namespace BaseTypes::Primitives {
         /**
          * Initializes natural to an unspecified value.
          */
-        Natural ()
-        {
-        }
+        Natural () = default;
 
         /*--------------------*/
 
@@ -57,9 +55,9 @@ namespace BaseTypes::Primitives {
          *
          * @param[in] i  integer value
          */
-        Natural (IN int i)
+        constexpr Natural (IN int i)
+            : GenericNumber{(size_t) i}
         {
-            _value = i;
         }
 
         /*--------------------*/
@@ -69,9 +67,9 @@ namespace BaseTypes::Primitives {
          *
          * @param[in] n  unsigned value
          */
-        Natural (IN size_t n)
+        constexpr Natural (IN size_t n)
+            : GenericNumber{n}
         {
-            _value = n;
         }
 
         /*--------------------*/
@@ -141,7 +139,7 @@ namespace BaseTypes::Primitives {
          *
          * @return current value as a floating point value
          */
-        explicit operator float () const
+        explicit constexpr operator float () const
         {
             return (float) _value;
         }
@@ -154,7 +152,7 @@ namespace BaseTypes::Primitives {
          *
          * @return current value as a floating point value
          */
-        explicit operator double () const
+        explicit constexpr operator double () const
         {
             return (double) _value;
         }
@@ -167,7 +165,7 @@ namespace BaseTypes::Primitives {
          *
          * @return current value as an integer value
          */
-        explicit operator int () const
+        explicit constexpr operator int () const
         {
             return (int) _value;
         }
@@ -183,7 +181,7 @@ namespace BaseTypes::Primitives {
          *                   divisor
          * @return  modulus of current and <C>other</C>.
          */
-        Natural operator % (IN Natural other) const
+        constexpr Natural operator % (IN Natural other) const
         {
             return Natural{_value % other._value};
         }
@@ -196,7 +194,7 @@ namespace BaseTypes::Primitives {
          * @param[in] other  other natural value to be used as
          *                   divisor
          */
-        void operator %= (IN Natural other)
+        constexpr void operator %= (IN Natural other)
         {
             _value = _value % other._value;
         }
@@ -208,7 +206,7 @@ namespace BaseTypes::Primitives {
          *
          * @return  previous value of natural
          */
-        Natural operator ++ (int)
+        constexpr Natural operator ++ (int)
         {
             return Natural{_value++};
         }
@@ -220,7 +218,7 @@ namespace BaseTypes::Primitives {
          *
          * @return  current value of natural
          */
-        Natural operator ++ ()
+        constexpr Natural operator ++ ()
         {
             return Natural{++_value};
         }
@@ -232,7 +230,7 @@ namespace BaseTypes::Primitives {
          *
          * @return  previous value of natural
          */
-        Natural operator -- (int)
+        constexpr Natural operator -- (int)
         {
             return Natural{_value--};
         }
@@ -244,7 +242,7 @@ namespace BaseTypes::Primitives {
          *
          * @return  current value of natural
          */
-        Natural operator -- ()
+        constexpr Natural operator -- ()
         {
             return Natural{--_value};
         }
@@ -391,4 +389,11 @@ namespace BaseTypes::Primitives {
 
     };
 
+    /*--------------------*/
+
+    /* naturals are stored exactly like size_t values, hence arrays
+       of naturals may be handed to raw code as size_t arrays */
+    static_assert(Natural::hasElementaryLayout(),
+                  "natural must have the layout of a size_t");
+
 }
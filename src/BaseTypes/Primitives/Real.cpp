@@ -131,42 +131,6 @@ Boolean Real::hasDoublePrecision ()
     return true;
 }
 
-/*--------------------*/
-/* constructors       */
-/*--------------------*/
-
-Real::Real ()
-{
-}
-
-/*--------------------*/
-
-Real::Real (IN double d)
-{
-    _value = d;
-}
-
-/*--------------------*/
-
-Real::Real (IN float f)
-{
-    _value = f;
-}
-
-/*--------------------*/
-
-Real::Real (IN Integer i)
-{
-    _value = (int) i;
-}
-
-/*--------------------*/
-
-Real::Real (IN Natural n)
-{
-    _value = (size_t) n;
-}
-
 /*--------------------*/
 /* type conversions   */
 /*--------------------*/
@@ -247,41 +211,6 @@ String Real::toString (IN Natural precision,
     return result;
 }
 
-/*--------------------*/
-
-Real::operator double () const
-{
-    return (double) _value;
-}
-
-/*--------------------*/
-
-Real::operator float () const
-{
-    return (float) _value;
-}
-
-/*--------------------*/
-
-Real::operator int () const
-{
-    return (int) _value;
-}
-
-/*--------------------*/
-
-Real::operator Integer () const
-{
-    return Integer{(int) _value};
-}
-
-/*--------------------*/
-
-Real::operator Natural () const
-{
-    return Natural{(size_t) _value};
-}
-
 /*-----------------------------*/
 /* advanced functions (static) */
 /*-----------------------------*/
@@ -51,7 +51,7 @@ namespace BaseTypes::Primitives {
         /**
          * Initializes real to an unspecified value.
          */
-        Real ();
+        Real () = default;
 
         /*--------------------*/
 
@@ -60,7 +60,10 @@ namespace BaseTypes::Primitives {
          *
          * @param[in] d  double precision floating point value
          */
-        Real (IN double d);
+        constexpr Real (IN double d)
+            : GenericNumber{d}
+        {
+        }
 
         /*--------------------*/
 
@@ -69,7 +72,10 @@ namespace BaseTypes::Primitives {
          *
          * @param[in] f  single precision floating point value
          */
-        Real (IN float f);
+        constexpr Real (IN float f)
+            : GenericNumber{(double) f}
+        {
+        }
 
         /*--------------------*/
 
@@ -78,7 +84,10 @@ namespace BaseTypes::Primitives {
          *
          * @param[in] i  integer value
          */
-        Real (IN Integer i);
+        constexpr Real (IN Integer i)
+            : GenericNumber{(double) (int) i}
+        {
+        }
 
         /*--------------------*/
 
@@ -87,7 +96,10 @@ namespace BaseTypes::Primitives {
          *
          * @param[in] n  natural value
          */
-        Real (IN Natural n);
+        constexpr Real (IN Natural n)
+            : GenericNumber{(double) (size_t) n}
+        {
+        }
 
         /*--------------------*/
         /* type conversions   */
@@ -122,7 +134,10 @@ namespace BaseTypes::Primitives {
          *
          * @return current value as double
          */
-        explicit operator double () const;
+        explicit constexpr operator double () const
+        {
+            return _value;
+        }
 
         /*--------------------*/
 
@@ -132,7 +147,10 @@ namespace BaseTypes::Primitives {
          *
          * @return current value as float
          */
-        explicit operator float () const;
+        explicit constexpr operator float () const
+        {
+            return (float) _value;
+        }
 
         /*--------------------*/
 
@@ -142,7 +160,10 @@ namespace BaseTypes::Primitives {
          *
          * @return current value as int
          */
-        explicit operator int () const;
+        explicit constexpr operator int () const
+        {
+            return (int) _value;
+        }
 
         /*--------------------*/
 
@@ -152,7 +173,10 @@ namespace BaseTypes::Primitives {
          *
          * @return current value as integer
          */
-        explicit operator Integer () const;
+        explicit constexpr operator Integer () const
+        {
+            return Integer{(int) _value};
+        }
 
         /*--------------------*/
 
@@ -162,7 +186,10 @@ namespace BaseTypes::Primitives {
          *
          * @return current value as natural
          */
-        explicit operator Natural () const;
+        explicit constexpr operator Natural () const
+        {
+            return Natural{(size_t) _value};
+        }
 
         /*-----------------------------*/
         /* advanced functions (static) */
@@ -542,4 +569,12 @@ namespace BaseTypes::Primitives {
 
     };
 
+    /*--------------------*/
+
+    /* reals are stored exactly like doubles, hence arrays of reals
+       (like audio sample lists) may be handed to raw and SIMD code
+       as double arrays */
+    static_assert(Real::hasElementaryLayout(),
+                  "real must have the layout of a double");
+
 }
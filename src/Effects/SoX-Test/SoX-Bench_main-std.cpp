@@ -0,0 +1,886 @@
+/**
+ * @file
+ * The <C>SoX-Bench</C> module implements a command-line
+ * microbenchmark for the building blocks of the SoX effects: ring
+ * buffer access, IIR filters, wave forms, the reverb filter bank,
+ * the compander transfer function, array conversion and the stage
+ * dispatch of effect chains.  Each case
+ * is measured repeatedly on fixed input data and reported with
+ * simple statistics, such that the results of different commits
+ * can be compared.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+#include "AudioSampleListVector.h"
+#include "AudioSamplePlanarBuffer.h"
+#include "AudioSampleRingBuffer.h"
+#include "DenormalGuard.h"
+#include "IIRFilter.h"
+#include "Logging.h"
+#include "MyArray.h"
+#include "OperatingSystem.h"
+#include "SoXCompanderSupport.h"
+#include "SoXEffectChain_AudioEffect.h"
+#include "SoXGain_AudioEffect.h"
+#include "SoXOverdrive_AudioEffect.h"
+#include "SoXPhaserAndTremolo_AudioEffect.h"
+#include "SoXReverbSupport.h"
+#include "SoXSidechainView.h"
+#include "SoXStaticEffectChain.h"
+#include "WaveForm.h"
+
+#ifdef _WIN32
+    #include "MyWindows.h"
+#elif defined(__linux__)
+    #include <sched.h>
+#endif
+
+/*--------------------*/
+
+using std::cout;
+
+using Audio::AudioSample;
+using Audio::AudioSampleListVector;
+using Audio::AudioSampleListView;
+using Audio::AudioSamplePlanarBuffer;
+using Audio::AudioSampleRingBuffer;
+using Audio::DenormalGuard;
+using Audio::IIRFilter;
+using Audio::IIRFilterState;
+using Audio::WaveForm;
+using Audio::WaveFormGenerator;
+using Audio::WaveFormKind;
+using BaseModules::OperatingSystem;
+using BaseTypes::Containers::convertArray;
+using BaseTypes::Primitives::Boolean;
+using BaseTypes::Primitives::Natural;
+using BaseTypes::Primitives::Real;
+using BaseTypes::Primitives::String;
+using SoXPlugins::Effects::SoXCompander::SoXMultibandCompander;
+using SoXPlugins::Effects::SoXEffectChain::SoXEffectChain_AudioEffect;
+using SoXPlugins::Effects::SoXEffectChain::SoXStaticEffectChain;
+using SoXPlugins::Effects::SoXGain::SoXGain_AudioEffect;
+using SoXPlugins::Effects::SoXOverdrive::SoXOverdrive_AudioEffect;
+using SoXPlugins::Effects::SoXPhaserAndTremolo
+          ::SoXPhaserAndTremolo_AudioEffect;
+using SoXPlugins::Effects::SoXReverb::_SoXReverb;
+using SoXPlugins::Helpers::SoXSidechainView;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
+
+/*====================*/
+
+/*-----------*/
+/* CONSTANTS */
+/*-----------*/
+
+/* number of samples processed by a single call of a case */
+constexpr size_t _blockLength = 256;
+
+/* number of samples per block processed by the effect chains (a
+   small host block, such that the stage dispatch matters) */
+constexpr size_t _chainBlockLength = 16;
+
+/* number of channels for the filter banks */
+const Natural _channelCount = 2;
+
+/* sample rate for all cases */
+const Real _sampleRate = 44100.0;
+
+/* minimum duration of a single measurement in seconds; the number
+   of calls per measurement is doubled until it is reached */
+const Real _minimumMeasurementDuration = 0.002;
+
+/* duration of the busy loop before the measurements in seconds
+   (lets the CPU leave its power saving states) */
+const Real _warmupDuration = 0.5;
+
+/* sink for results of the cases, such that they are not optimized
+   away */
+volatile double _sink = 0.0;
+
+/*---------*/
+/* TYPES */
+/*---------*/
+
+/**
+ * A <_BenchmarkData> object holds the fixed input data and the
+ * primitives measured by the cases
+ */
+struct _BenchmarkData {
+
+    /** pseudo random input samples */
+    AudioSample inputArray[_blockLength];
+
+    /** output samples */
+    AudioSample outputArray[_blockLength];
+
+    /** output samples in single precision */
+    float floatArray[_blockLength];
+
+    /** a ring buffer as used for delay lines */
+    AudioSampleRingBuffer ringBuffer;
+
+    /** the input and output histories of the third-order filter */
+    AudioSampleRingBuffer inputBuffer3;
+    AudioSampleRingBuffer outputBuffer3;
+
+    /** the input and output histories of the fifth-order filter */
+    AudioSampleRingBuffer inputBuffer5;
+    AudioSampleRingBuffer outputBuffer5;
+
+    /** a third-order and a fifth-order IIR filter */
+    IIRFilter filter3;
+    IIRFilter filter5;
+
+    /** the block states of the filters */
+    IIRFilterState state3;
+    IIRFilterState state5;
+
+    /** a sine wave form with one hertz */
+    WaveForm waveForm;
+
+    /** a sine wave form with one hertz rendered by a rotator */
+    WaveForm rotatorWaveForm;
+
+    /** a reverb with comb and allpass filters */
+    _SoXReverb reverb;
+
+    /** a single band compander with exact transfer function */
+    SoXMultibandCompander compander;
+
+    /** a single band compander with tabulated transfer function */
+    SoXMultibandCompander tableCompander;
+
+    /** a single band compander with a decimated detector */
+    SoXMultibandCompander decimatedCompander;
+
+    /** a single band compander with an automatic gain interval */
+    SoXMultibandCompander controlRateCompander;
+
+    /** an empty sidechain */
+    SoXSidechainView sidechain;
+
+    /** the stereo buffer for the filter banks */
+    AudioSampleListVector buffer;
+
+    /** a chain of gain, overdrive and phaser configured at runtime
+     * (with virtual stage dispatch) */
+    SoXEffectChain_AudioEffect dynamicChain;
+
+    /** the same chain configured at compile time (with static stage
+     * dispatch) */
+    SoXStaticEffectChain<SoXGain_AudioEffect, SoXOverdrive_AudioEffect,
+                         SoXPhaserAndTremolo_AudioEffect> staticChain;
+
+    /** the time positions of the next blocks of the chains */
+    Real dynamicChainTimePosition;
+    Real staticChainTimePosition;
+
+    /** the stereo buffer for the small blocks of the chains */
+    AudioSampleListVector chainBuffer;
+
+    /** the static chain once more working on a planar buffer */
+    SoXStaticEffectChain<SoXGain_AudioEffect, SoXOverdrive_AudioEffect,
+                         SoXPhaserAndTremolo_AudioEffect> planarChain;
+    Real planarChainTimePosition;
+    AudioSamplePlanarBuffer planarChainBuffer;
+
+    /** an overdrive with the cubic curve evaluated directly */
+    SoXStaticEffectChain<SoXOverdrive_AudioEffect> cubicOverdrive;
+
+    /** an overdrive with the tanh curve interpolated in a table */
+    SoXStaticEffectChain<SoXOverdrive_AudioEffect> tanhOverdrive;
+
+    /** the time positions of the next blocks of the overdrives */
+    Real cubicOverdriveTimePosition;
+    Real tanhOverdriveTimePosition;
+
+    /*--------------------*/
+
+    /**
+     * Sets up all primitives with typical parameters
+     */
+    _BenchmarkData ()
+        : ringBuffer{16},
+          inputBuffer3{3},
+          outputBuffer3{3},
+          inputBuffer5{5},
+          outputBuffer5{5},
+          filter3{3},
+          filter5{5}
+    {
+        std::uint32_t randomState = 12345;
+
+        for (size_t i = 0;  i < _blockLength;  i++) {
+            randomState = randomState * 1664525 + 1013904223;
+            inputArray[i] = (double) randomState / 4294967296.0 - 0.5;
+            outputArray[i] = 0.0;
+        }
+
+        filter3.set(0.2, 0.4, 0.2, 1.0, -0.5, 0.3);
+        filter5.set(0.1, 0.2, 0.3, 0.2, 0.1,
+                    1.0, -0.2, 0.1, -0.05, 0.02);
+        waveForm.set(_sampleRate, WaveFormKind::sine, -1.0, 1.0,
+                     0.0, false);
+        rotatorWaveForm.set(_sampleRate, WaveFormKind::sine, -1.0, 1.0,
+                            0.0, false);
+        rotatorWaveForm.setGenerator(WaveFormGenerator::rotator);
+
+        reverb.setParameters(false, 50.0, 50.0, 100.0, 100.0, 0.0, 0.0);
+        reverb.resize(_sampleRate, _channelCount);
+
+        for (SoXMultibandCompander* companderPtr
+                 : {&compander, &tableCompander, &decimatedCompander,
+                    &controlRateCompander}) {
+            companderPtr->resize(1, _channelCount);
+            companderPtr->reserve(1);
+            companderPtr->setEffectiveSize(1);
+        }
+
+        tableCompander.setTransferFunctionTable(64, false);
+        decimatedCompander.setDetectorDecimation(16);
+        controlRateCompander.setGainInterval(0);
+
+        for (SoXMultibandCompander* companderPtr
+                 : {&compander, &tableCompander, &decimatedCompander,
+                    &controlRateCompander}) {
+            companderPtr->setCompanderBandData(0, _sampleRate, 0.03, 0.15,
+                                               6.0, -18.0, 4.0, 2.0,
+                                               25000.0);
+        }
+
+        buffer.setLength(_channelCount);
+        buffer.setFrameCount(_blockLength);
+
+        dynamicChain.appendEffect(new SoXGain_AudioEffect{});
+        dynamicChain.appendEffect(new SoXOverdrive_AudioEffect{});
+        dynamicChain.appendEffect(new SoXPhaserAndTremolo_AudioEffect{});
+        dynamicChain.setDefaultValues();
+        dynamicChain.setParameterValidity(true);
+        dynamicChain.prepareToPlay(_sampleRate);
+        staticChain.setDefaultValues();
+        staticChain.prepareToPlay(_sampleRate);
+        dynamicChainTimePosition = 0.0;
+        staticChainTimePosition  = 0.0;
+        chainBuffer.setLength(_channelCount);
+        chainBuffer.setFrameCount(_chainBlockLength);
+        planarChain.setDefaultValues();
+        planarChain.prepareToPlay(_sampleRate);
+        planarChainTimePosition = 0.0;
+        planarChainBuffer.resize(_channelCount, _chainBlockLength);
+
+        cubicOverdrive.setDefaultValues();
+        cubicOverdrive.prepareToPlay(_sampleRate);
+        tanhOverdrive.setDefaultValues();
+        tanhOverdrive.effect<0>().setValue("Curve", "Tanh");
+        tanhOverdrive.prepareToPlay(_sampleRate);
+        cubicOverdriveTimePosition = 0.0;
+        tanhOverdriveTimePosition  = 0.0;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Copies the input samples into all channels of the stereo
+     * buffer
+     */
+    void fillBuffer ()
+    {
+        for (Natural channel = 0;  channel < _channelCount;  channel++) {
+            std::copy(inputArray, inputArray + _blockLength,
+                      buffer[channel].asArray());
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Copies the input samples from <position> on into all channels
+     * of the chain buffer
+     */
+    void fillChainBuffer (IN size_t position)
+    {
+        for (Natural channel = 0;  channel < _channelCount;  channel++) {
+            std::copy(inputArray + position,
+                      inputArray + position + _chainBlockLength,
+                      chainBuffer[channel].asArray());
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Copies the input samples from <position> on into all channels
+     * of the planar chain buffer
+     */
+    void fillPlanarChainBuffer (IN size_t position)
+    {
+        for (Natural channel = 0;  channel < _channelCount;  channel++) {
+            std::copy(inputArray + position,
+                      inputArray + position + _chainBlockLength,
+                      planarChainBuffer[channel]);
+        }
+    }
+
+};
+
+/*--------------------*/
+
+/** a case processes <_blockLength> samples on the benchmark data */
+using _CaseFunction = void (*) (INOUT _BenchmarkData& data);
+
+/*--------------------*/
+
+/**
+ * A <_BenchmarkCase> is a named case of the microbenchmark
+ */
+struct _BenchmarkCase {
+
+    /** the name of the case */
+    const char* name;
+
+    /** the function processing a block */
+    _CaseFunction function;
+
+};
+
+/*=========*/
+/* CASES   */
+/*=========*/
+
+/**
+ * Shifts the input samples into a ring buffer
+ */
+void _ringBufferShiftRight (INOUT _BenchmarkData& data) {
+    for (size_t i = 0;  i < _blockLength;  i++) {
+        data.ringBuffer.shiftRight(data.inputArray[i]);
+    }
+
+    _sink = _sink + (double) data.ringBuffer.first();
+}
+
+/*--------------------*/
+
+/**
+ * Reads four taps of a ring buffer per sample
+ */
+void _ringBufferAt (INOUT _BenchmarkData& data) {
+    AudioSampleRingBuffer& ringBuffer = data.ringBuffer;
+    AudioSample sum = 0.0;
+
+    for (size_t i = 0;  i < _blockLength;  i++) {
+        sum += (ringBuffer.at(1) + ringBuffer.at(5)
+                + ringBuffer.at(9) + ringBuffer.at(15));
+        ringBuffer.setFirst(data.inputArray[i]);
+    }
+
+    _sink = _sink + (double) sum;
+}
+
+/*--------------------*/
+
+/**
+ * Copies a ring buffer into an array per sample
+ */
+void _ringBufferToArray (INOUT _BenchmarkData& data) {
+    AudioSample array[16];
+
+    for (size_t i = 0;  i < _blockLength;  i++) {
+        data.ringBuffer.setFirst(data.inputArray[i]);
+        data.ringBuffer.toArray(array);
+        data.outputArray[i] = array[7];
+    }
+
+    _sink = _sink + (double) data.outputArray[0];
+}
+
+/*--------------------*/
+
+/**
+ * Applies <filter> per sample with the ring buffer histories
+ * <inputBuffer> and <outputBuffer> to the input samples
+ */
+void _applyFilterPerSample (IN IIRFilter& filter,
+                            INOUT AudioSampleRingBuffer& inputBuffer,
+                            INOUT AudioSampleRingBuffer& outputBuffer,
+                            INOUT _BenchmarkData& data) {
+    for (size_t i = 0;  i < _blockLength;  i++) {
+        inputBuffer.shiftRight(data.inputArray[i]);
+        outputBuffer.shiftRight(0.0);
+        filter.apply(inputBuffer, outputBuffer);
+        data.outputArray[i] = outputBuffer.first();
+    }
+
+    _sink = _sink + (double) data.outputArray[0];
+}
+
+/*--------------------*/
+
+/**
+ * Applies the third-order filter per sample
+ */
+void _iirFilter3Apply (INOUT _BenchmarkData& data) {
+    _applyFilterPerSample(data.filter3, data.inputBuffer3,
+                          data.outputBuffer3, data);
+}
+
+/*--------------------*/
+
+/**
+ * Applies the fifth-order filter per sample
+ */
+void _iirFilter5Apply (INOUT _BenchmarkData& data) {
+    _applyFilterPerSample(data.filter5, data.inputBuffer5,
+                          data.outputBuffer5, data);
+}
+
+/*--------------------*/
+
+/**
+ * Applies the third-order filter to a block
+ */
+void _iirFilter3ApplyBlock (INOUT _BenchmarkData& data) {
+    data.filter3.applyBlock(data.inputArray, data.outputArray,
+                            _blockLength, data.state3);
+    _sink = _sink + (double) data.outputArray[0];
+}
+
+/*--------------------*/
+
+/**
+ * Applies the fifth-order filter to a block
+ */
+void _iirFilter5ApplyBlock (INOUT _BenchmarkData& data) {
+    data.filter5.applyBlock(data.inputArray, data.outputArray,
+                            _blockLength, data.state5);
+    _sink = _sink + (double) data.outputArray[0];
+}
+
+/*--------------------*/
+
+/**
+ * Reads and advances the wave form per sample
+ */
+void _waveFormCurrentAdvance (INOUT _BenchmarkData& data) {
+    for (size_t i = 0;  i < _blockLength;  i++) {
+        data.outputArray[i] = data.waveForm.current();
+        data.waveForm.advance();
+    }
+
+    _sink = _sink + (double) data.outputArray[0];
+}
+
+/*--------------------*/
+
+/**
+ * Renders a block of the wave form
+ */
+void _waveFormRender (INOUT _BenchmarkData& data) {
+    data.waveForm.render(data.outputArray, _blockLength);
+    _sink = _sink + (double) data.outputArray[0];
+}
+
+/*--------------------*/
+
+/**
+ * Renders a block of the wave form by a rotator
+ */
+void _waveFormRenderRotator (INOUT _BenchmarkData& data) {
+    data.rotatorWaveForm.render(data.outputArray, _blockLength);
+    _sink = _sink + (double) data.outputArray[0];
+}
+
+/*--------------------*/
+
+/**
+ * Applies the comb and allpass filters of the reverb to a stereo
+ * block (there is no separate access to the filters, they are
+ * internal to the reverb)
+ */
+void _reverbFilterBank (INOUT _BenchmarkData& data) {
+    data.fillBuffer();
+    data.reverb.apply(data.buffer);
+    _sink = _sink + (double) data.buffer[0][0];
+}
+
+/*--------------------*/
+
+/**
+ * Applies a single compander band with the exact transfer function
+ * to a stereo block (the transfer function is internal to the
+ * compander)
+ */
+void _companderTransferFunction (INOUT _BenchmarkData& data) {
+    data.fillBuffer();
+    data.compander.apply(data.buffer, data.sidechain);
+    _sink = _sink + (double) data.buffer[0][0];
+}
+
+/*--------------------*/
+
+/**
+ * Applies a single compander band with the tabulated transfer
+ * function to a stereo block
+ */
+void _companderTransferTable (INOUT _BenchmarkData& data) {
+    data.fillBuffer();
+    data.tableCompander.apply(data.buffer, data.sidechain);
+    _sink = _sink + (double) data.buffer[0][0];
+}
+
+/*--------------------*/
+
+/**
+ * Applies a single compander band with a detector decimated by 16
+ * to a stereo block
+ */
+void _companderDecimatedDetector (INOUT _BenchmarkData& data) {
+    data.fillBuffer();
+    data.decimatedCompander.apply(data.buffer, data.sidechain);
+    _sink = _sink + (double) data.buffer[0][0];
+}
+
+/*--------------------*/
+
+/**
+ * Applies a single compander band with a gain computed once per
+ * automatic interval to a stereo block
+ */
+void _companderControlRate (INOUT _BenchmarkData& data) {
+    data.fillBuffer();
+    data.controlRateCompander.apply(data.buffer, data.sidechain);
+    _sink = _sink + (double) data.buffer[0][0];
+}
+
+/*--------------------*/
+
+/**
+ * Converts a block of samples to single precision and back
+ */
+void _convertArray (INOUT _BenchmarkData& data) {
+    convertArray(data.floatArray, data.inputArray, _blockLength);
+    convertArray(data.outputArray, data.floatArray, _blockLength);
+    _sink = _sink + (double) data.outputArray[0];
+}
+
+/*--------------------*/
+
+/**
+ * Applies an overdrive with the cubic curve to a stereo block
+ */
+void _overdriveCubic (INOUT _BenchmarkData& data) {
+    data.fillBuffer();
+    data.cubicOverdrive.process(data.cubicOverdriveTimePosition,
+                                data.buffer);
+    data.cubicOverdriveTimePosition +=
+        Real{(double) _blockLength} / _sampleRate;
+    _sink = _sink + (double) data.buffer[0][0];
+}
+
+/*--------------------*/
+
+/**
+ * Applies an overdrive with the tabulated tanh curve to a stereo
+ * block
+ */
+void _overdriveTanhTable (INOUT _BenchmarkData& data) {
+    data.fillBuffer();
+    data.tanhOverdrive.process(data.tanhOverdriveTimePosition,
+                               data.buffer);
+    data.tanhOverdriveTimePosition +=
+        Real{(double) _blockLength} / _sampleRate;
+    _sink = _sink + (double) data.buffer[0][0];
+}
+
+/*--------------------*/
+
+/**
+ * Processes the input samples in small blocks by the chain
+ * configured at runtime, whose stages are called virtually
+ */
+void _effectChainDynamic (INOUT _BenchmarkData& data) {
+    const Real blockDuration = Real{(double) _chainBlockLength} / _sampleRate;
+
+    for (size_t position = 0;  position < _blockLength;
+         position += _chainBlockLength) {
+        data.fillChainBuffer(position);
+        data.dynamicChain.processBlock(data.dynamicChainTimePosition,
+                                       data.chainBuffer);
+        data.dynamicChainTimePosition += blockDuration;
+    }
+
+    _sink = _sink + (double) data.chainBuffer[0][0];
+}
+
+/*--------------------*/
+
+/**
+ * Processes the input samples in small blocks by the chain
+ * configured at compile time, whose stages are called statically
+ */
+void _effectChainStatic (INOUT _BenchmarkData& data) {
+    const Real blockDuration = Real{(double) _chainBlockLength} / _sampleRate;
+
+    for (size_t position = 0;  position < _blockLength;
+         position += _chainBlockLength) {
+        data.fillChainBuffer(position);
+        data.staticChain.process(data.staticChainTimePosition,
+                                 data.chainBuffer);
+        data.staticChainTimePosition += blockDuration;
+    }
+
+    _sink = _sink + (double) data.chainBuffer[0][0];
+}
+
+/*--------------------*/
+
+/**
+ * Processes the input samples in small blocks by the static chain
+ * on a planar buffer viewed in place
+ */
+void _effectChainStaticPlanar (INOUT _BenchmarkData& data) {
+    const Real blockDuration = Real{(double) _chainBlockLength} / _sampleRate;
+    AudioSampleListView view = data.planarChainBuffer.asView();
+
+    for (size_t position = 0;  position < _blockLength;
+         position += _chainBlockLength) {
+        data.fillPlanarChainBuffer(position);
+        data.planarChain.process(data.planarChainTimePosition, view);
+        data.planarChainTimePosition += blockDuration;
+    }
+
+    _sink = _sink + (double) data.planarChainBuffer[0][0];
+}
+
+/*--------------------*/
+
+/** the list of all cases */
+const _BenchmarkCase _caseList[] = {
+    { "AudioSampleRingBuffer.shiftRight", _ringBufferShiftRight },
+    { "AudioSampleRingBuffer.at",         _ringBufferAt },
+    { "AudioSampleRingBuffer.toArray",    _ringBufferToArray },
+    { "IIRFilter.apply/3",                _iirFilter3Apply },
+    { "IIRFilter.apply/5",                _iirFilter5Apply },
+    { "IIRFilter.applyBlock/3",           _iirFilter3ApplyBlock },
+    { "IIRFilter.applyBlock/5",           _iirFilter5ApplyBlock },
+    { "WaveForm.current+advance",         _waveFormCurrentAdvance },
+    { "WaveForm.render",                  _waveFormRender },
+    { "WaveForm.render/rotator",          _waveFormRenderRotator },
+    { "_SoXReverb.apply",                 _reverbFilterBank },
+    { "SoXMultibandCompander.apply",      _companderTransferFunction },
+    { "SoXMultibandCompander.apply/table", _companderTransferTable },
+    { "SoXMultibandCompander.apply/decimated",
+      _companderDecimatedDetector },
+    { "SoXMultibandCompander.apply/controlRate",
+      _companderControlRate },
+    { "convertArray",                     _convertArray },
+    { "SoXOverdrive.processBlock",        _overdriveCubic },
+    { "SoXOverdrive.processBlock/tanh",   _overdriveTanhTable },
+    { "SoXEffectChain.processBlock/16",   _effectChainDynamic },
+    { "SoXStaticEffectChain.process/16",  _effectChainStatic },
+    { "SoXStaticEffectChain.process/16/planar",
+      _effectChainStaticPlanar }
+};
+
+/*====================*/
+
+/**
+ * Binds the current thread to the processor with <processorIndex>
+ * and tells whether this has been successful (not supported on
+ * MacOS)
+ */
+Boolean _pinToProcessor (IN Natural processorIndex) {
+    Boolean isOkay = false;
+
+    #ifdef _WIN32
+        const DWORD_PTR mask = (DWORD_PTR) 1 << (size_t) processorIndex;
+        isOkay = (SetThreadAffinityMask(GetCurrentThread(), mask) != 0);
+    #elif defined(__linux__)
+        cpu_set_t processorSet;
+        CPU_ZERO(&processorSet);
+        CPU_SET((size_t) processorIndex, &processorSet);
+        isOkay = (sched_setaffinity(0, sizeof(processorSet),
+                                    &processorSet) == 0);
+    #endif
+
+    return isOkay;
+}
+
+/*--------------------*/
+
+/**
+ * Keeps the processor busy for <duration> seconds
+ */
+void _spin (IN Real duration) {
+    const auto startTime = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsedTime{0.0};
+    double value = 1.0;
+
+    while (elapsedTime.count() < (double) duration) {
+        for (Natural i = 0;  i < 1000;  i++) {
+            value = value * 1.000001 + 1.0E-9;
+        }
+
+        elapsedTime = std::chrono::steady_clock::now() - startTime;
+    }
+
+    _sink = _sink + value;
+}
+
+/*--------------------*/
+
+/**
+ * Returns the time in seconds for <iterationCount> calls of
+ * <function> on <data>
+ */
+Real _measure (IN _CaseFunction function,
+               INOUT _BenchmarkData& data,
+               IN Natural iterationCount) {
+    const auto startTime = std::chrono::steady_clock::now();
+
+    for (Natural i = 0;  i < iterationCount;  i++) {
+        function(data);
+    }
+
+    const std::chrono::duration<double> duration =
+        std::chrono::steady_clock::now() - startTime;
+    return Real{duration.count()};
+}
+
+/*--------------------*/
+
+/**
+ * Runs the microbenchmark for all cases whose name contains
+ * <namePart>: the number of calls per measurement is calibrated to
+ * take at least <_minimumMeasurementDuration>, then
+ * <measurementCount> measurements are done; one line per case is
+ * written to standard output as comma separated values with the
+ * minimum, median, mean and standard deviation of the time per
+ * sample (in nanoseconds)
+ */
+void _runMicrobenchmark (IN String& namePart,
+                         IN Natural measurementCount) {
+    Logging_trace2(">>: namePart = %1, measurementCount = %2",
+                   namePart, TOSTRING(measurementCount));
+
+    const DenormalGuard denormalGuard{};
+    _BenchmarkData* data = new _BenchmarkData();
+    Real* timeArray = new Real[(size_t) measurementCount];
+
+    cout << "case,iterationCount,measurementCount,minimumNsPerSample,"
+         << "medianNsPerSample,meanNsPerSample,deviationNsPerSample\n";
+
+    for (const _BenchmarkCase& benchmarkCase : _caseList) {
+        const String caseName{benchmarkCase.name};
+
+        if (STR::contains(caseName, namePart)) {
+            /* calibrate the number of calls (also warms up caches
+               and branch predictors) */
+            Natural iterationCount = 1;
+
+            while (_measure(benchmarkCase.function, *data, iterationCount)
+                   < _minimumMeasurementDuration) {
+                iterationCount *= 2;
+            }
+
+            Real timeSum = 0.0;
+
+            for (Natural i = 0;  i < measurementCount;  i++) {
+                const Real time =
+                    _measure(benchmarkCase.function, *data, iterationCount);
+                timeArray[(size_t) i] = time;
+                timeSum += time;
+            }
+
+            std::sort(timeArray, timeArray + (size_t) measurementCount);
+            const Real sampleFactor =
+                Real{1.0E9} / (Real{iterationCount}
+                               * Real{(double) _blockLength});
+            const Real meanTime = timeSum / Real{measurementCount};
+            Real squaredDeviationSum = 0.0;
+
+            for (Natural i = 0;  i < measurementCount;  i++) {
+                const Real deviation = timeArray[(size_t) i] - meanTime;
+                squaredDeviationSum += deviation * deviation;
+            }
+
+            const Real deviation =
+                Real::sqrt(squaredDeviationSum / Real{measurementCount});
+            const String line =
+                STR::expand("%1,%2,%3,", caseName,
+                            TOSTRING(iterationCount),
+                            TOSTRING(measurementCount))
+                + STR::expand("%1,%2,%3,%4",
+                              TOSTRING(timeArray[0] * sampleFactor),
+                              TOSTRING(timeArray[(size_t) measurementCount
+                                                 / 2]
+                                       * sampleFactor),
+                              TOSTRING(meanTime * sampleFactor),
+                              TOSTRING(deviation * sampleFactor));
+            Logging_trace1("--: %1", line);
+            cout << line << "\n" << std::flush;
+        }
+    }
+
+    delete[] timeArray;
+    delete data;
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/*--------------------*/
+
+int main (int argc, char* argv[]) {
+    Logging_initialize();
+    const String temporaryDirectoryPath =
+        OperatingSystem::temporaryDirectoryPath();
+    Logging_setFileName(temporaryDirectoryPath + "/SoXBench.log", false);
+    Logging_setIgnoredFunctionNamePrefix("SoXPlugins.");
+    Logging_trace(">>");
+
+    /* optional arguments: the index of the processor to run on
+       ("-" for none), the number of measurements per case and a
+       part of the names of the cases to run */
+    const String processorString = (argc < 2 ? "-" : argv[1]);
+    const Natural measurementCount =
+        (argc < 3 ? Natural{31}
+         : Natural::maximum(STR::toNatural(argv[2], 31), 1));
+    const String namePart = (argc < 4 ? "" : argv[3]);
+    int exitCode = 0;
+
+    if (processorString != "-") {
+        const Natural processorIndex = STR::toNatural(processorString);
+
+        if (!_pinToProcessor(processorIndex)) {
+            std::cerr << "cannot pin to processor "
+                      << processorString << "\n";
+            exitCode = 1;
+        }
+    }
+
+    if (exitCode == 0) {
+        /* the processor frequency cannot be fixed from here, hence
+           the processor is kept busy for a while before measuring;
+           for stable results the frequency scaling should be
+           disabled in the operating system */
+        _spin(_warmupDuration);
+        _runMicrobenchmark(namePart, measurementCount);
+    }
+
+    Logging_trace("<<");
+    Logging_finalize();
+    return exitCode;
+}
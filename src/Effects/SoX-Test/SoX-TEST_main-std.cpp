@@ -4,7 +4,24 @@
  * program for the more complex SoX effects <B>reverb</B>,
  * <B>phaser/tremolo</B> and <B>compander</C>; there is no GUI
  * involved, only the engines are checked with standardized
- * parameters.
+ * parameters.  Additionally it provides a benchmark for the
+ * processing cost of the recursive effects during the decay into
+ * silence, a throughput benchmark for all effects with
+ * configurable block sizes, sample rates and channel counts (with a
+ * variant for small blocks dominated by the per-call overhead), a
+ * session benchmark with many instances processed by several
+ * threads like in a host, a benchmark for the conversions between
+ * reals and strings, a check for allocations and locks within
+ * the block processing, a replay of captured automation traces
+ * with their original block pattern, a search for the parameter
+ * configurations with the highest processing cost and a comparison
+ * of the throughput with a previous benchmark as a regression
+ * check, a tuning of the processing settings for the executing
+ * machine, a headless conformance check of the effects against
+ * reference files rendered by SoX, a check of the deviations of
+ * the precision profiles against their tolerances and a stress test
+ * of the parameter handoff to the audio thread under concurrent
+ * changes from several threads.
  *
  * @author Dr. Thomas Tensi
  * @date   2020-10
@@ -14,27 +31,87 @@
 /* IMPORTS */
 /*=========*/
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <iostream>
 #include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
 
+#include "DenormalGuard.h"
+#include "Kernels.h"
 #include "Logging.h"
+#include "NaturalList.h"
 #include "OperatingSystem.h"
+#include "SoXAudioFile.h"
+#include "SoXAutomationTrace.h"
 #include "SoXCompander_AudioEffect.h"
 #include "SoXFilter_AudioEffect.h"
+#include "SoXGain_AudioEffect.h"
+#include "SoXKernelTuning.h"
+#include "SoXOfflineRenderer.h"
+#include "SoXOverdrive_AudioEffect.h"
+#include "SoXParameterChangeSet.h"
+#include "SoXParameterEventQueue.h"
+#include "SoXParameterSlotExchange.h"
 #include "SoXPhaserAndTremolo_AudioEffect.h"
+#include "SoXRealtimeGuard.h"
+#include "SoXWorkerPool.h"
+
+#ifdef __linux__
+    #include <cstring>
+    #include <linux/perf_event.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
 #include "SoXReverb_AudioEffect.h"
 
 /*--------------------*/
 
+using std::cerr;
 using std::cout;
 
 using Audio::AudioSample;
+using Audio::DenormalGuard;
+using Audio::Kernels;
 using BaseModules::OperatingSystem;
+using BaseTypes::Containers::NaturalList;
 using SoXPlugins::Effects::SoXCompander::SoXCompander_AudioEffect;
 using SoXPlugins::Effects::SoXFilter::SoXFilter_AudioEffect;
+using SoXPlugins::Effects::SoXGain::SoXGain_AudioEffect;
+using SoXPlugins::Effects::SoXOverdrive::SoXOverdrive_AudioEffect;
 using SoXPlugins::Effects::SoXPhaserAndTremolo
          ::SoXPhaserAndTremolo_AudioEffect;
 using SoXPlugins::Effects::SoXReverb::SoXReverb_AudioEffect;
+using SoXPlugins::Helpers::SoXAutomationTrace;
+using SoXPlugins::Helpers::SoXAutomationTraceEntry;
+using SoXPlugins::Helpers::SoXAutomationTraceEntryKind;
+using SoXPlugins::Helpers::SoXEffectParameterKind;
+using SoXPlugins::Helpers::SoXKernelTuning;
+using SoXPlugins::Helpers::SoXParameterChangeSet;
+using SoXPlugins::Helpers::SoXParameterEvent;
+using SoXPlugins::Helpers::SoXParameterEventQueue;
+using SoXPlugins::Helpers::SoXParameterSlotExchange;
+using SoXPlugins::Helpers::SoXParameterValueChangeKind;
+using SoXPlugins::Helpers::SoXPrecisionProfile;
+using SoXPlugins::Helpers::precisionProfileTolerance;
+using SoXPlugins::Helpers::precisionProfileToString;
+using SoXPlugins::Helpers::SoXRealtimeGuard;
+using SoXPlugins::Helpers::SoXWorkerPool;
+using SoXPlugins::Helpers::SoXWorkerPoolStatistics;
+using SoXPlugins::Renderer::SoXAudioFileFormat;
+using SoXPlugins::Renderer::SoXAudioFileKind;
+using SoXPlugins::Renderer::SoXAudioFileReader;
+using SoXPlugins::Renderer::SoXAudioFileWriter;
+using SoXPlugins::Renderer::SoXOfflineRenderer;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
 
 /*====================*/
 
@@ -45,9 +122,59 @@ using SoXPlugins::Effects::SoXReverb::SoXReverb_AudioEffect;
 const Natural _blocksPerSecond = 100;
 const Natural _channelCount    = 2;
 
+/* number of seconds of silence in the decay benchmark */
+const Natural _silentSecondCount = 20;
+
+/* number of seconds processed before measuring in the throughput
+   benchmark */
+const Natural _warmupSecondCount = 1;
+
+/* maximum number of bands of the compander in the throughput
+   benchmark */
+const Natural _maximumBenchmarkBandCount = 10;
+
+/* number of different values in the string conversion benchmark */
+const Natural _conversionValueCount = 1000;
+
+/* number of seconds of signal (followed by the same time of
+   silence) in the regression check */
+const Natural _regressionSignalSecondCount = 2;
+
+/* number of samples per block in the regression check */
+const Natural _regressionBlockSize = 512;
+
+/* number of seconds of signal (padded by a second of silence on
+   both sides) in the conformance check */
+const Natural _conformanceSignalSecondCount = 16;
+
+/* number of entries per case in the list of conformance cases */
+const Natural _conformanceCaseFieldCount = 4;
+
+/* the RMS error level reported for identical renders (in dB) */
+const Real _minimumRmsErrorInDb = -400.0;
+
+/* number of values per parameter set by the producers in the update
+   stress test */
+const Natural _stressValueCount = 8;
+
+/* number of pending editor changes in the update stress test (like
+   in the audio processor) */
+const Natural _stressEventQueueCapacity = 256;
+
+/* rate of the change notification in the update stress test (like
+   in the audio editor, in Hz) */
+const Natural _stressNotificationRate = 30;
+
+/* maximum number of latencies recorded per effect in the update
+   stress test */
+const Natural _stressLatencyCapacity = 1000000;
+
 /* effect names */
 const String _effectName_compander = "COMPANDER";
 const String _effectName_filter    = "FILTER";
+const String _effectName_gain      = "GAIN";
+const String _effectName_overdrive = "OVERDRIVE";
+const String _effectName_phaser    = "PHASER";
 const String _effectName_reverb    = "REVERB";
 const String _effectName_tremolo   = "TREMOLO";
 
@@ -58,6 +185,203 @@ std::ofstream _outputFile;
 /* TYPES */
 /*---------*/
 
+/**
+ * A <_PerformanceCounters> object reads the hardware performance
+ * counters for cycles, instructions, L1 data cache read misses,
+ * last level cache misses and branch misses of the current thread
+ * in user mode; counting is switched on and off around the measured
+ * calls and accumulates until cleared.  The counters are only
+ * available on Linux via <perf_event_open> (and only if the kernel
+ * and the processor allow it); a counter not supported stays
+ * unavailable.
+ */
+struct _PerformanceCounters {
+
+    /** the number of counters */
+    static constexpr size_t counterCount = 5;
+
+    /** the index of each counter */
+    enum { cycles, instructions, l1Misses, llcMisses, branchMisses };
+
+    /*--------------------*/
+
+    /**
+     * Opens all counters (the cycle counter as group leader)
+     */
+    _PerformanceCounters ()
+    {
+        for (size_t i = 0;  i < counterCount;  i++) {
+            _fileDescriptorList[i] = -1;
+        }
+
+        #ifdef __linux__
+            const std::uint64_t l1MissConfig =
+                (PERF_COUNT_HW_CACHE_L1D
+                 | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                 | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+            const std::uint32_t typeList[counterCount] = {
+                PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE,
+                PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE
+            };
+            const std::uint64_t configList[counterCount] = {
+                PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                l1MissConfig, PERF_COUNT_HW_CACHE_MISSES,
+                PERF_COUNT_HW_BRANCH_MISSES
+            };
+
+            for (size_t i = 0;  i < counterCount;  i++) {
+                const int groupFileDescriptor = _fileDescriptorList[0];
+
+                if (i == 0 || groupFileDescriptor >= 0) {
+                    perf_event_attr attributes;
+                    std::memset(&attributes, 0, sizeof(attributes));
+                    attributes.size           = sizeof(attributes);
+                    attributes.type           = typeList[i];
+                    attributes.config         = configList[i];
+                    attributes.disabled       = (i == 0 ? 1 : 0);
+                    attributes.exclude_kernel = 1;
+                    attributes.exclude_hv     = 1;
+                    _fileDescriptorList[i] =
+                        (int) syscall(__NR_perf_event_open, &attributes,
+                                      0, -1, groupFileDescriptor, 0);
+                }
+            }
+        #endif
+
+        clear();
+    }
+
+    /*--------------------*/
+
+    /**
+     * Closes all counters
+     */
+    ~_PerformanceCounters ()
+    {
+        #ifdef __linux__
+            for (size_t i = counterCount;  i > 0;  i--) {
+                if (_fileDescriptorList[i - 1] >= 0) {
+                    close(_fileDescriptorList[i - 1]);
+                }
+            }
+        #endif
+    }
+
+    /*--------------------*/
+
+    /**
+     * Tells whether the counter with <index> is available
+     */
+    Boolean isAvailable (IN size_t index = cycles) const
+    {
+        return (_fileDescriptorList[index] >= 0);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Resets all counters to zero
+     */
+    void clear ()
+    {
+        #ifdef __linux__
+            if (isAvailable()) {
+                ioctl(_fileDescriptorList[0], PERF_EVENT_IOC_RESET,
+                      PERF_IOC_FLAG_GROUP);
+            }
+        #endif
+    }
+
+    /*--------------------*/
+
+    /**
+     * Starts counting
+     */
+    void start ()
+    {
+        #ifdef __linux__
+            if (isAvailable()) {
+                ioctl(_fileDescriptorList[0], PERF_EVENT_IOC_ENABLE,
+                      PERF_IOC_FLAG_GROUP);
+            }
+        #endif
+    }
+
+    /*--------------------*/
+
+    /**
+     * Stops counting
+     */
+    void stop ()
+    {
+        #ifdef __linux__
+            if (isAvailable()) {
+                ioctl(_fileDescriptorList[0], PERF_EVENT_IOC_DISABLE,
+                      PERF_IOC_FLAG_GROUP);
+            }
+        #endif
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the count of the counter with <index> (zero when not
+     * available)
+     */
+    Real value (IN size_t index) const
+    {
+        std::uint64_t result = 0;
+
+        #ifdef __linux__
+            if (isAvailable(index)) {
+                const ssize_t byteCount =
+                    read(_fileDescriptorList[index], &result,
+                         sizeof(result));
+                result = (byteCount == sizeof(result) ? result : 0);
+            }
+        #endif
+
+        return Real{(double) result};
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the counts as comma separated values normalized by
+     * <sampleCount>: cycles per sample, instructions per cycle and
+     * the L1 data cache, last level cache and branch misses per
+     * sample; unavailable counters are empty
+     */
+    String toCSVString (IN Real sampleCount) const
+    {
+        const Real cycleCount = value(cycles);
+        String result =
+            (!isAvailable(cycles) ? ","
+             : TOSTRING(cycleCount / sampleCount) + ",");
+        result += (!isAvailable(instructions) || cycleCount == Real::zero
+                   ? "" : TOSTRING(value(instructions) / cycleCount));
+
+        for (const size_t index : {l1Misses, llcMisses, branchMisses}) {
+            result += ",";
+            result += (!isAvailable(index) ? ""
+                       : TOSTRING(value(index) / sampleCount));
+        }
+
+        return result;
+    }
+
+    /*--------------------*/
+
+    private:
+
+        /** the file descriptors of the counters (negative when
+         * unavailable) */
+        int _fileDescriptorList[counterCount];
+
+};
+
+/*--------------------*/
+
 void _writeToOutputFile (String title,
                          SoXAudioEffect& audioEffect)
 {
@@ -100,13 +424,11 @@ void _copyBuffer (IN AudioSampleListVector& srcBuffer,
     for (Natural channel = 0;  channel < channelCount;
          channel++) {
         const AudioSampleList& srcList = srcBuffer[channel];
-        AudioSampleList destList{sampleCount};
+        AudioSampleList& destList = destBuffer.emplaceChannel(sampleCount);
 
         for (Natural i = 0;  i < sampleCount;  i++) {
             destList[i] = srcList[i];
         }
-
-        destBuffer.append(destList);
     }
 
 }
@@ -133,7 +455,7 @@ void _fillBuffer (OUT AudioSampleListVector& buffer,
             inputList[i] = s;
         }
 
-        buffer.append(inputList);
+        buffer.append(std::move(inputList));
     }
 
     Logging_trace("<<");
@@ -146,8 +468,8 @@ void _initializeEffect (IN String audioEffectKind,
     Logging_trace1(">>: %1", audioEffectKind);
 
     if (audioEffectKind == _effectName_compander) {
-        audioEffect->setValue("0#BANDCOUNT", "4", true);
-        audioEffect->setValue("-1#BANDINDEX", "1", true);
+        audioEffect->setValue("-2#Band Count", "4", true);
+        audioEffect->setValue("-1#Band Index", "1", true);
         audioEffect->setValue("1#Attack [s]", "0.03", true);
         audioEffect->setValue("1#Decay [s]", "0.15", true);
         audioEffect->setValue("1#Knee [dB]", "6.0", true);
@@ -183,17 +505,25 @@ void _initializeEffect (IN String audioEffectKind,
         audioEffect->setValue("Bandwidth Unit", "Octave(s)", true);
         audioEffect->setValue("Eq. Gain [dB]", "5", false);
     } else if (audioEffectKind == _effectName_reverb) {
-        audioEffect->setValue("isWetOnly?", "false", true);
+        audioEffect->setValue("Is Wet Only?", "false", true);
         audioEffect->setValue("Reverberance [%]", "50", true);
         audioEffect->setValue("HF Damping [%]", "50", true);
         audioEffect->setValue("Room Scale [%]", "100", true);
         audioEffect->setValue("Stereo Depth [%]", "100", true);
-        audioEffect->setValue("Pre Delay [ms]", "0", true);
+        audioEffect->setValue("Predelay [ms]", "0", true);
         audioEffect->setValue("Wet Gain [dB]", "0", false);
     } else if (audioEffectKind == _effectName_tremolo) {
         audioEffect->setValue("Effect Kind", "Tremolo", true);
         audioEffect->setValue("Depth [%]", "50", true);
         audioEffect->setValue("Modulation [Hz]", "1", false);
+    } else if (audioEffectKind == _effectName_phaser) {
+        audioEffect->setValue("Effect Kind", "Phaser", true);
+        audioEffect->setDefaultValues();
+    } else if (audioEffectKind == _effectName_overdrive) {
+        audioEffect->setValue("Gain [dB]", "20", true);
+        audioEffect->setValue("Colour", "20", false);
+    } else if (audioEffectKind == _effectName_gain) {
+        audioEffect->setValue("Gain [dB]", "-6", false);
     }
 
     Logging_trace("<<");
@@ -211,11 +541,16 @@ SoXAudioEffect* _makeNewEffect (IN String& audioEffectKind,
     
     if (audioEffectKind == _effectName_filter) {
         audioEffect = new SoXFilter_AudioEffect{};
+    } else if (audioEffectKind == _effectName_gain) {
+        audioEffect = new SoXGain_AudioEffect{};
     } else if (audioEffectKind == _effectName_reverb) {
         testLengthInSeconds = 50;
         audioEffect = new SoXReverb_AudioEffect{};
-    } else if (audioEffectKind == _effectName_tremolo) {
+    } else if (audioEffectKind == _effectName_tremolo
+               || audioEffectKind == _effectName_phaser) {
         audioEffect = new SoXPhaserAndTremolo_AudioEffect{};
+    } else if (audioEffectKind == _effectName_overdrive) {
+        audioEffect = new SoXOverdrive_AudioEffect{};
     } else {
         audioEffect = new SoXCompander_AudioEffect{};
     }
@@ -257,12 +592,25 @@ void _runForEffect (IN String& audioEffectKind,
     _writeToOutputFile("EFFECT AFTER PREPARATION", *audioEffect);
     Logging_trace("--: AFTER PREPARATION");
 
+    /* the engine works on the raw channels via a view */
+    const Natural channelCount = buffer.length();
+    AudioSample** channelArray = new AudioSample*[(size_t) channelCount];
+
+    for (Natural channel = 0;  channel < channelCount;  channel++) {
+        channelArray[(size_t) channel] = buffer[channel].asArray();
+    }
+
+    AudioSampleListView bufferView{channelArray, channelCount,
+                                   buffer.frameCount()};
+
     const Natural repetitionCount = testLengthInSeconds * _blocksPerSecond;
     for (Natural i = 0;  i < repetitionCount;  i++) {
-        audioEffect->processBlock(timePosition, buffer);
+        audioEffect->processBlock(timePosition, bufferView);
         timePosition += increment;
     }
 
+    delete[] channelArray;
+
     _writeToOutputFile("EFFECT AFTER PROCESSING", *audioEffect);
     delete audioEffect;
 
@@ -270,39 +618,3498 @@ void _runForEffect (IN String& audioEffectKind,
 }
 
 /*--------------------*/
+
+/**
+ * Processes <secondCount> seconds of blocks with samples from
+ * <waveFormBuffer> (or of silence when <isSilent> is set) by
+ * <audioEffect> starting at <timePosition> and returns the
+ * processing time in seconds
+ */
+Real _measureProcessing (INOUT SoXAudioEffect& audioEffect,
+                         IN AudioSampleListVector& waveFormBuffer,
+                         INOUT AudioSampleListVector& buffer,
+                         IN Natural secondCount,
+                         IN Boolean isSilent,
+                         INOUT Real& timePosition) {
+    const Natural channelCount = buffer.length();
+    const Natural sampleCount = buffer.frameCount();
+    const Real increment = Real{1.0} / Real{_blocksPerSecond};
+    const Natural repetitionCount = secondCount * _blocksPerSecond;
+    Real result = 0.0;
+
+    for (Natural i = 0;  i < repetitionCount;  i++) {
+        /* the buffer is processed in place, hence it is refilled
+           for each block */
+        for (Natural channel = 0;  channel < channelCount;  channel++) {
+            const AudioSampleList& srcList = waveFormBuffer[channel];
+            AudioSampleList& destList = buffer[channel];
+
+            for (Natural j = 0;  j < sampleCount;  j++) {
+                destList[j] = (isSilent ? AudioSample{0.0} : srcList[j]);
+            }
+        }
+
+        const auto startTime = std::chrono::steady_clock::now();
+        audioEffect.processBlock(timePosition, buffer);
+        const std::chrono::duration<double> duration =
+            std::chrono::steady_clock::now() - startTime;
+        result += Real{duration.count()};
+        timePosition += increment;
+    }
+
+    return result;
+}
+
 /*--------------------*/
 
-int main (int argc, char* argv[]) {
-    Logging_initialize();
-    String temporaryDirectoryPath =
-        OperatingSystem::temporaryDirectoryPath();
-    Logging_setFileName(temporaryDirectoryPath + "/SoXTest.log", false);
-    Logging_setIgnoredFunctionNamePrefix("SoXPlugins.");
-    Logging_setTracingWithTime(true, 2);
+/**
+ * Runs a benchmark for the recursive effects: each effect processes
+ * one second of the sine wave in <waveFormBuffer> and afterwards
+ * several seconds of silence with a sample rate of <sampleRate>; the
+ * maximum processing time of a silent second relative to the time of
+ * the signal second is reported, this stays about one as long as the
+ * decaying effect states do not run into denormals
+ */
+void _runDecayBenchmark (IN AudioSampleListVector& waveFormBuffer,
+                         IN Integer sampleRate) {
     Logging_trace(">>");
-    _outputFile.open(temporaryDirectoryPath + "/SoXTest.txt");
 
-    const Integer sampleRate = 44100;
-    String effectName;
-    AudioSampleListVector waveFormBuffer{};
-    const Character effectCharacter = (argc < 2 ? ' ' : argv[1][0]);
+    /* the same floating point mode as in the audio processor */
+    const DenormalGuard denormalGuard{};
+    const String effectNameList[] = {
+        _effectName_filter, _effectName_overdrive,
+        _effectName_phaser, _effectName_reverb, _effectName_compander
+    };
 
-    if (effectCharacter  == 'C') {
-        effectName = _effectName_compander;
-    } else if (effectCharacter == 'F') {
-        effectName = _effectName_filter;
-    } else if (effectCharacter == 'T') {
-        effectName = _effectName_tremolo;
+    for (const String& effectName : effectNameList) {
+        Natural testLengthInSeconds;
+        SoXAudioEffect* audioEffect =
+            _makeNewEffect(effectName, testLengthInSeconds);
+        AudioSampleListVector buffer{};
+        _copyBuffer(waveFormBuffer, buffer);
+        audioEffect->prepareToPlay(sampleRate);
+
+        Real timePosition = 0.0;
+        const Real signalTime =
+            _measureProcessing(*audioEffect, waveFormBuffer, buffer,
+                               1, false, timePosition);
+        Real maximumSilenceTime = 0.0;
+
+        for (Natural second = 0;  second < _silentSecondCount;  second++) {
+            const Real silenceTime =
+                _measureProcessing(*audioEffect, waveFormBuffer, buffer,
+                                   1, true, timePosition);
+            maximumSilenceTime = (silenceTime > maximumSilenceTime
+                                  ? silenceTime : maximumSilenceTime);
+        }
+
+        const String line =
+            STR::expand("%1: signal = %2s, maximum silence = %3s,"
+                        " ratio = %4",
+                        effectName, TOSTRING(signalTime),
+                        TOSTRING(maximumSilenceTime),
+                        TOSTRING(maximumSilenceTime / signalTime));
+        Logging_trace1("--: %1", line);
+        cout << line << "\n";
+        delete audioEffect;
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+/**
+ * Sets up <audioEffect> of kind <audioEffectKind> for the
+ * throughput benchmark variant <variant>: for the filter this is
+ * the filter kind, for the compander the band count
+ */
+void _initializeBenchmarkVariant (IN String& audioEffectKind,
+                                  IN String& variant,
+                                  INOUT SoXAudioEffect* audioEffect) {
+    Logging_trace2(">>: kind = %1, variant = %2",
+                   audioEffectKind, variant);
+
+    if (audioEffectKind == _effectName_filter) {
+        audioEffect->setValue("Filter Kind", variant, true);
+
+        if (variant == "Biquad") {
+            audioEffect->setValue("b0", "0.5", true);
+            audioEffect->setValue("b1", "0.3", true);
+            audioEffect->setValue("b2", "0.1", true);
+            audioEffect->setValue("a0", "1.0", true);
+            audioEffect->setValue("a1", "-0.2", true);
+            audioEffect->setValue("a2", "0.1", false);
+        } else {
+            audioEffect->setValue("Frequency [Hz]", "1000", true);
+            audioEffect->setValue("Bandwidth", "1", true);
+            audioEffect->setValue("Bandwidth Unit", "Octave(s)", true);
+            audioEffect->setValue("Gain [dB]", "5", true);
+            audioEffect->setValue("Eq. Gain [dB]", "5", false);
+        }
+    } else if (audioEffectKind == _effectName_compander) {
+        const Natural bandCount = STR::toNatural(variant);
+        audioEffect->setValue("-2#Band Count", variant, true);
+
+        /* the band limits are spread logarithmically between 50Hz
+           and 20kHz */
+        for (Natural band = 1;  band <= bandCount;  band++) {
+            const String prefix = TOSTRING(band) + "#";
+            const Real topFrequency =
+                Real{50.0} * Real::power(400.0,
+                                         Real{band} / Real{bandCount});
+            audioEffect->setValue(prefix + "Attack [s]", "0.03", true);
+            audioEffect->setValue(prefix + "Decay [s]", "0.15", true);
+            audioEffect->setValue(prefix + "Knee [dB]", "6.0", true);
+            audioEffect->setValue(prefix + "Threshold [dB]", "-18.0", true);
+            audioEffect->setValue(prefix + "Ratio", "4", true);
+            audioEffect->setValue(prefix + "Gain [dB]", "2", true);
+            audioEffect->setValue(prefix + "Top Frequency [Hz]",
+                                  TOSTRING(Real::round(topFrequency)),
+                                  false);
+        }
+    }
+
+    audioEffect->recalculateSettings();
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+/**
+ * Returns the list of effect cases for the benchmark and the
+ * regression check as a flat list of pairs of effect name and
+ * variant (see <_initializeBenchmarkVariant>)
+ */
+StringList _effectCaseList () {
+    StringList result;
+    const String filterKindList[] = {
+        "Allpass", "Band", "BandPass", "BandReject", "Bass", "Biquad",
+        "Equalizer", "HighPass", "LowPass", "Treble"
+    };
+
+    result.append(_effectName_gain);      result.append("-");
+    result.append(_effectName_overdrive); result.append("-");
+
+    for (const String& filterKind : filterKindList) {
+        result.append(_effectName_filter);
+        result.append(filterKind);
+    }
+
+    result.append(_effectName_phaser);    result.append("-");
+    result.append(_effectName_tremolo);   result.append("-");
+    result.append(_effectName_reverb);    result.append("-");
+
+    for (Natural bandCount = 1;  bandCount <= _maximumBenchmarkBandCount;
+         bandCount++) {
+        result.append(_effectName_compander);
+        result.append(TOSTRING(bandCount));
+    }
+
+    return result;
+}
+
+/*--------------------*/
+
+/**
+ * Returns the minimum time in seconds of an empty measurement by
+ * the steady clock; it is determined once and subtracted per block,
+ * such that small blocks are not dominated by the clock access
+ */
+Real _clockOverhead () {
+    static Real result = Real::infinity;
+
+    if (result == Real::infinity) {
+        for (Natural i = 0;  i < 1000;  i++) {
+            const auto startTime = std::chrono::steady_clock::now();
+            const std::chrono::duration<double> duration =
+                std::chrono::steady_clock::now() - startTime;
+            result = Real::minimum(result, Real{duration.count()});
+        }
+    }
+
+    return result;
+}
+
+/*--------------------*/
+
+/**
+ * Processes <sampleCount> samples of <sourceBuffer> in blocks of
+ * <buffer> length by <audioEffect> starting at <timePosition> and
+ * returns the processing time in seconds; the source is read
+ * cyclically and only the processing calls are measured (also by
+ * <counters> when given) without the overhead of the clock
+ */
+Real _measureBlocks (INOUT SoXAudioEffect& audioEffect,
+                     IN AudioSampleListVector& sourceBuffer,
+                     INOUT AudioSampleListVector& buffer,
+                     IN Real sampleRate,
+                     IN Natural sampleCount,
+                     INOUT Real& timePosition,
+                     INOUT _PerformanceCounters* counters = NULL) {
+    const Natural channelCount = buffer.length();
+    const Natural blockSize = buffer.frameCount();
+    const Natural sourceLength = sourceBuffer.frameCount();
+    const Real increment = Real{blockSize} / sampleRate;
+    const Real clockOverhead = _clockOverhead();
+    Natural sourcePosition = 0;
+    Real result = 0.0;
+
+    for (Natural position = 0;  position < sampleCount;
+         position += blockSize) {
+        for (Natural channel = 0;  channel < channelCount;  channel++) {
+            const AudioSampleList& srcList = sourceBuffer[channel];
+            AudioSampleList& destList = buffer[channel];
+            Natural j = sourcePosition;
+
+            for (Natural i = 0;  i < blockSize;  i++) {
+                destList[i] = srcList[j];
+                j = (j + 1 < sourceLength ? j + 1 : Natural{0});
+            }
+        }
+
+        sourcePosition = (sourcePosition + blockSize) % sourceLength;
+
+        if (counters != NULL) {
+            counters->start();
+        }
+
+        const auto startTime = std::chrono::steady_clock::now();
+        audioEffect.processBlock(timePosition, buffer);
+        const std::chrono::duration<double> duration =
+            std::chrono::steady_clock::now() - startTime;
+
+        if (counters != NULL) {
+            counters->stop();
+        }
+
+        result += Real::maximum(0.0, Real{duration.count()}
+                                     - clockOverhead);
+        timePosition += increment;
+    }
+
+    return result;
+}
+
+/*--------------------*/
+
+/**
+ * Sets <sourceBuffer> to one second of a 100Hz sine with
+ * <channelCount> channels for <sampleRate>
+ */
+void _fillSineBuffer (OUT AudioSampleListVector& sourceBuffer,
+                      IN Natural sampleRate,
+                      IN Natural channelCount) {
+    sourceBuffer.setLength(channelCount);
+    sourceBuffer.setFrameCount(sampleRate);
+
+    for (Natural channel = 0;  channel < channelCount;  channel++) {
+        AudioSampleList& sourceList = sourceBuffer[channel];
+
+        for (Natural j = 0;  j < sampleRate;  j++) {
+            sourceList[j] = Real::sin(Real::twoPi * Real{j} * 100.0
+                                      / Real{sampleRate}) * 0.5;
+        }
+    }
+}
+
+/*--------------------*/
+
+/**
+ * Compares the reals pointed to by <a> and <b> for sorting
+ */
+int _compareReals (const void* a, const void* b) {
+    const Real x = *((const Real*) a);
+    const Real y = *((const Real*) b);
+    return (x < y ? -1 : (x > y ? 1 : 0));
+}
+
+/*--------------------*/
+
+/**
+ * Returns the median of <valueList> in <median> and the bounds of
+ * its distribution-free confidence interval of about 95% in
+ * <lowBound> and <highBound>; the bounds are the order statistics
+ * at n/2 -/+ 0.98 sqrt(n) (by the normal approximation of the
+ * binomial distribution), hence for up to six values the interval
+ * spans all values
+ */
+void _medianStatistics (IN GenericList<Real>& valueList,
+                        OUT Real& median,
+                        OUT Real& lowBound,
+                        OUT Real& highBound) {
+    GenericList<Real> sortedList = valueList;
+    sortedList.sort(_compareReals);
+    const Natural count = sortedList.length();
+    median = 0.0;
+    lowBound = 0.0;
+    highBound = 0.0;
+
+    if (count > 0) {
+        const Natural middle = count / 2;
+        median = (count % 2 == 1 ? sortedList[middle]
+                  : (sortedList[middle - 1] + sortedList[middle]) / 2.0);
+        const Real halfWidth = Real{0.98} * Real::sqrt(Real{count});
+        const Real lowRank =
+            Real::maximum(Real::round(Real{count} / 2.0 - halfWidth), 1.0);
+        const Real highRank =
+            Real::minimum(Real::round(Real{count} / 2.0 + 1.0
+                                      + halfWidth),
+                          Real{count});
+        lowBound = sortedList[(Natural) lowRank - 1];
+        highBound = sortedList[(Natural) highRank - 1];
+    }
+}
+
+/*--------------------*/
+
+/**
+ * Measures the effect case given by <effectName> and <variant> in
+ * blocks of <blockSize> samples: after a warmup the effect processes
+ * <secondCount> seconds of <sourceBuffer> (one second of signal at
+ * <sampleRate>) <repetitionCount> times; returns the time per
+ * channel sample (in nanoseconds) of each run in <nsPerSampleList>
+ * and the number of frames per run (rounded up to full blocks);
+ * the runs are also measured by <counters> when given
+ */
+Natural _measureThroughputCase (IN String& effectName,
+                                IN String& variant,
+                                IN AudioSampleListVector& sourceBuffer,
+                                IN Natural sampleRate,
+                                IN Natural blockSize,
+                                IN Natural secondCount,
+                                IN Natural repetitionCount,
+                                OUT GenericList<Real>& nsPerSampleList,
+                                INOUT _PerformanceCounters* counters
+                                    = NULL) {
+    const Natural channelCount = sourceBuffer.length();
+    Natural testLengthInSeconds;
+    SoXAudioEffect* audioEffect =
+        _makeNewEffect(effectName, testLengthInSeconds);
+    _initializeBenchmarkVariant(effectName, variant, audioEffect);
+    audioEffect->prepareToPlay(Real{sampleRate});
+
+    AudioSampleListVector buffer{};
+    buffer.setLength(channelCount);
+    buffer.setFrameCount(blockSize);
+    Real timePosition = 0.0;
+    _measureBlocks(*audioEffect, sourceBuffer, buffer, Real{sampleRate},
+                   _warmupSecondCount * sampleRate, timePosition);
+
+    const Natural sampleCount = secondCount * sampleRate;
+    const Natural processedCount =
+        (sampleCount + blockSize - 1) / blockSize * blockSize;
+    const Real channelSampleCount =
+        Real{processedCount} * Real{channelCount};
+    nsPerSampleList.clear();
+
+    for (Natural run = 0;  run < repetitionCount;  run++) {
+        const Real time =
+            _measureBlocks(*audioEffect, sourceBuffer, buffer,
+                           Real{sampleRate}, sampleCount, timePosition,
+                           counters);
+        nsPerSampleList.append(time * 1.0E9 / channelSampleCount);
+    }
+
+    delete audioEffect;
+    return processedCount;
+}
+
+/*--------------------*/
+
+/**
+ * Runs the throughput benchmark for all effects and their
+ * variants for each combination from <blockSizeList>,
+ * <sampleRateList> and <channelCountList>: after a warmup each
+ * effect processes <secondCount> seconds of a sine wave
+ * <repetitionCount> times; one line per combination is written to
+ * standard output as comma separated values with the best and the
+ * mean time per sample (in nanoseconds), the realtime multiple of
+ * the best run and the median time per sample with its confidence
+ * interval (see <_medianStatistics>); when <countersAreUsed> is
+ * set, the hardware performance counters over all measured runs
+ * are appended per channel sample (empty when not available on
+ * this platform)
+ */
+void _runThroughputBenchmark (IN NaturalList& blockSizeList,
+                              IN NaturalList& sampleRateList,
+                              IN NaturalList& channelCountList,
+                              IN Natural secondCount,
+                              IN Natural repetitionCount,
+                              IN Boolean countersAreUsed) {
+    Logging_trace1(">>: countersAreUsed = %1", TOSTRING(countersAreUsed));
+
+    /* the same floating point mode as in the audio processor */
+    const DenormalGuard denormalGuard{};
+
+    _PerformanceCounters counters{};
+    _PerformanceCounters* effectiveCounters =
+        (countersAreUsed ? &counters : NULL);
+
+    if (countersAreUsed && !counters.isAvailable()) {
+        std::cerr << "hardware performance counters not available\n";
+    }
+
+    const StringList caseList = _effectCaseList();
+    cout << "effect,variant,sampleRate,channelCount,blockSize,"
+         << "sampleCount,bestNsPerSample,meanNsPerSample,"
+         << "realtimeFactor,medianNsPerSample,medianLowNsPerSample,"
+         << "medianHighNsPerSample"
+         << (!countersAreUsed ? ""
+             : (",cyclesPerSample,instructionsPerCycle,"
+                "l1dMissesPerSample,llcMissesPerSample,"
+                "branchMissesPerSample"))
+         << "\n";
+
+    for (Natural i = 0;  i < caseList.length();  i += 2) {
+        const String& effectName = caseList[i];
+        const String& variant = caseList[i + 1];
+
+        for (const Natural sampleRate : sampleRateList) {
+            for (const Natural channelCount : channelCountList) {
+                AudioSampleListVector sourceBuffer{};
+                _fillSineBuffer(sourceBuffer, sampleRate, channelCount);
+
+                for (const Natural blockSize : blockSizeList) {
+                    GenericList<Real> nsPerSampleList;
+                    counters.clear();
+                    const Natural processedCount =
+                        _measureThroughputCase(effectName, variant,
+                                               sourceBuffer, sampleRate,
+                                               blockSize, secondCount,
+                                               repetitionCount,
+                                               nsPerSampleList,
+                                               effectiveCounters);
+
+                    Real bestNsPerSample = Real::infinity;
+                    Real totalNsPerSample = 0.0;
+
+                    for (const Real nsPerSample : nsPerSampleList) {
+                        bestNsPerSample =
+                            Real::minimum(nsPerSample, bestNsPerSample);
+                        totalNsPerSample += nsPerSample;
+                    }
+
+                    Real medianNsPerSample;
+                    Real medianLowNsPerSample;
+                    Real medianHighNsPerSample;
+                    _medianStatistics(nsPerSampleList, medianNsPerSample,
+                                      medianLowNsPerSample,
+                                      medianHighNsPerSample);
+
+                    const Real channelSampleCount =
+                        Real{processedCount} * Real{channelCount};
+                    const Real meanNsPerSample =
+                        totalNsPerSample / Real{repetitionCount};
+                    const Real realtimeFactor =
+                        Real{1.0E9} / Real{sampleRate}
+                        / (bestNsPerSample * Real{channelCount});
+
+                    const String line =
+                        STR::expand("%1,%2,%3,%4,%5,%6,",
+                                    effectName, variant,
+                                    TOSTRING(sampleRate),
+                                    TOSTRING(channelCount),
+                                    TOSTRING(blockSize),
+                                    TOSTRING(processedCount))
+                        + STR::expand("%1,%2,%3,%4,%5,%6",
+                                      TOSTRING(bestNsPerSample),
+                                      TOSTRING(meanNsPerSample),
+                                      TOSTRING(realtimeFactor),
+                                      TOSTRING(medianNsPerSample),
+                                      TOSTRING(medianLowNsPerSample),
+                                      TOSTRING(medianHighNsPerSample))
+                        + (!countersAreUsed ? ""
+                           : ("," + counters.toCSVString(
+                                  channelSampleCount
+                                  * Real{repetitionCount})));
+                    Logging_trace1("--: %1", line);
+                    cout << line << "\n" << std::flush;
+                }
+            }
+        }
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+/**
+ * Compares the throughput with the baseline in file <fileName> (the
+ * output of a previous throughput benchmark): each case of the
+ * baseline is measured again with <repetitionCount> runs of
+ * <secondCount> seconds and its median time per sample is compared
+ * with the baseline median; a case is a regression when even the
+ * low bound of the current confidence interval exceeds the high
+ * bound of the baseline interval (or the baseline best time for
+ * older files without median columns) by more than
+ * <thresholdPercent>; one line per case is written to standard
+ * output as comma separated values; returns the number of
+ * regressions (or one when the baseline cannot be read)
+ */
+Natural _runBaselineComparison (IN String& fileName,
+                                IN Real thresholdPercent,
+                                IN Natural secondCount,
+                                IN Natural repetitionCount) {
+    Logging_trace4(">>: fileName = %1, threshold = %2%%,"
+                   " secondCount = %3, repetitionCount = %4",
+                   fileName, TOSTRING(thresholdPercent),
+                   TOSTRING(secondCount), TOSTRING(repetitionCount));
+
+    /* the same floating point mode as in the audio processor */
+    const DenormalGuard denormalGuard{};
+
+    std::ifstream file{fileName};
+    std::string line;
+    StringList columnNameList;
+
+    if (std::getline(file, line)) {
+        columnNameList = StringList::makeBySplit(STR::strip(line), ",");
+    }
+
+    const Integer effectColumn = columnNameList.position("effect");
+    const Integer variantColumn = columnNameList.position("variant");
+    const Integer sampleRateColumn =
+        columnNameList.position("sampleRate");
+    const Integer channelCountColumn =
+        columnNameList.position("channelCount");
+    const Integer blockSizeColumn = columnNameList.position("blockSize");
+    const Integer medianColumn =
+        columnNameList.position("medianNsPerSample");
+    const Integer highColumn =
+        columnNameList.position("medianHighNsPerSample");
+    const Integer bestColumn =
+        columnNameList.position("bestNsPerSample");
+    const Integer baselineColumn =
+        (medianColumn >= 0 ? medianColumn : bestColumn);
+    const Integer baselineHighColumn =
+        (highColumn >= 0 ? highColumn : bestColumn);
+    const Boolean isReadable =
+        (effectColumn >= 0 && variantColumn >= 0
+         && sampleRateColumn >= 0 && channelCountColumn >= 0
+         && blockSizeColumn >= 0 && baselineColumn >= 0);
+    Natural regressionCount = 0;
+
+    if (!isReadable) {
+        std::cerr << "no benchmark baseline in " << fileName << "\n";
+        regressionCount = 1;
     } else {
-        effectName = _effectName_reverb;
+        cout << "effect,variant,sampleRate,channelCount,blockSize,"
+             << "baselineNsPerSample,medianNsPerSample,"
+             << "medianLowNsPerSample,medianHighNsPerSample,"
+             << "changePercent,status\n";
+
+        const Real limitFactor = Real{1.0} + thresholdPercent / 100.0;
+        Natural caseCount = 0;
+
+        while (std::getline(file, line)) {
+            const StringList valueList =
+                StringList::makeBySplit(STR::strip(line), ",");
+
+            if (valueList.length() == columnNameList.length()) {
+                const String& effectName = valueList[(Natural) effectColumn];
+                const String& variant = valueList[(Natural) variantColumn];
+                const Natural sampleRate =
+                    STR::toNatural(valueList[(Natural) sampleRateColumn]);
+                const Natural channelCount =
+                    STR::toNatural(valueList[(Natural) channelCountColumn]);
+                const Natural blockSize =
+                    STR::toNatural(valueList[(Natural) blockSizeColumn]);
+                const Real baselineNsPerSample =
+                    STR::toReal(valueList[(Natural) baselineColumn]);
+                const Real baselineHighNsPerSample =
+                    STR::toReal(valueList[(Natural) baselineHighColumn]);
+
+                AudioSampleListVector sourceBuffer{};
+                _fillSineBuffer(sourceBuffer, sampleRate, channelCount);
+                GenericList<Real> nsPerSampleList;
+                _measureThroughputCase(effectName, variant, sourceBuffer,
+                                       sampleRate, blockSize,
+                                       secondCount, repetitionCount,
+                                       nsPerSampleList);
+                Real medianNsPerSample;
+                Real medianLowNsPerSample;
+                Real medianHighNsPerSample;
+                _medianStatistics(nsPerSampleList, medianNsPerSample,
+                                  medianLowNsPerSample,
+                                  medianHighNsPerSample);
+
+                const Real changePercent =
+                    (medianNsPerSample / baselineNsPerSample - 1.0)
+                    * 100.0;
+                const Boolean isRegression =
+                    (medianLowNsPerSample
+                     > baselineHighNsPerSample * limitFactor);
+                regressionCount += (isRegression ? 1 : 0);
+                caseCount++;
+
+                const String resultLine =
+                    STR::expand("%1,%2,%3,%4,%5,",
+                                effectName, variant,
+                                TOSTRING(sampleRate),
+                                TOSTRING(channelCount),
+                                TOSTRING(blockSize))
+                    + STR::expand("%1,%2,%3,%4,%5,%6",
+                                  TOSTRING(baselineNsPerSample),
+                                  TOSTRING(medianNsPerSample),
+                                  TOSTRING(medianLowNsPerSample),
+                                  TOSTRING(medianHighNsPerSample),
+                                  TOSTRING(changePercent),
+                                  (isRegression ? "REGRESSION" : "OK"));
+                Logging_trace1("--: %1", resultLine);
+                cout << resultLine << "\n" << std::flush;
+            }
+        }
+
+        std::cerr << TOSTRING(regressionCount) << " regression(s) in "
+                  << TOSTRING(caseCount) << " case(s)\n";
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(regressionCount));
+    return regressionCount;
+}
+
+/*--------------------*/
+
+/**
+ * Measures the processing settings for the executing machine (see
+ * <SoXKernelTuning>): the instruction set of the kernels, the
+ * minimum block length for parallel band processing and the block
+ * length of the multiband compander, where each candidate processes
+ * a compander with four bands <repetitionCount> times; one line per
+ * measurement is written to standard output as comma separated
+ * values, the settings are written to <fileName> and made current;
+ * returns the number of failures (one when the file cannot be
+ * written)
+ */
+Natural _runKernelTuning (IN String& fileName,
+                          IN Natural repetitionCount) {
+    Logging_trace2(">>: fileName = %1, repetitionCount = %2",
+                   fileName, TOSTRING(repetitionCount));
+
+    /* the same floating point mode as in the audio processor */
+    const DenormalGuard denormalGuard{};
+    const Natural sampleRate = 44100;
+    const Natural blockSize = 512;
+    const String bandCount = "4";
+    SoXKernelTuning tuning{};
+
+    tuning.measureInstructionSet();
+    SoXKernelTuning::setCurrent(tuning);
+    cout << "instructionSet,"
+         << Kernels::instructionSetName(tuning.instructionSet) << "\n";
+
+    tuning.measureParallelBlockLength();
+    cout << "parallelBlockLength,"
+         << TOSTRING(tuning.parallelBlockLength) << "\n" << std::flush;
+
+    AudioSampleListVector sourceBuffer{};
+    _fillSineBuffer(sourceBuffer, sampleRate, 2);
+    Natural bestBlockLength = tuning.companderBlockLength;
+    Real bestNsPerSample = 0.0;
+
+    for (const Natural blockLength
+             : SoXKernelTuning::companderBlockLengthList) {
+        tuning.companderBlockLength = blockLength;
+        SoXKernelTuning::setCurrent(tuning);
+        GenericList<Real> nsPerSampleList;
+        Real median;
+        Real lowBound;
+        Real highBound;
+        _measureThroughputCase(_effectName_compander, bandCount,
+                               sourceBuffer, sampleRate, blockSize, 1,
+                               repetitionCount, nsPerSampleList);
+        _medianStatistics(nsPerSampleList, median, lowBound, highBound);
+        const String line =
+            STR::expand("companderBlockLength,%1,%2",
+                        TOSTRING(blockLength), TOSTRING(median));
+        Logging_trace1("--: %1", line);
+        cout << line << "\n" << std::flush;
+
+        if (bestNsPerSample == 0.0 || median < bestNsPerSample) {
+            bestBlockLength = blockLength;
+            bestNsPerSample = median;
+        }
+    }
+
+    tuning.companderBlockLength = bestBlockLength;
+    SoXKernelTuning::setCurrent(tuning);
+    const Boolean isOkay = tuning.writeToFile(fileName);
+    std::cerr << tuning.toString() << "\n"
+              << (isOkay ? "written to " : "cannot write ")
+              << fileName << "\n";
+
+    const Natural failureCount = (isOkay ? 0 : 1);
+    Logging_trace1("<<: %1", TOSTRING(failureCount));
+    return failureCount;
+}
+
+/*--------------------*/
+
+/**
+ * Advances the linear congruential generator in <randomState> and
+ * returns a random value in [0, 1[
+ */
+Real _nextRandomValue (INOUT std::uint32_t& randomState) {
+    randomState = randomState * 1664525 + 1013904223;
+    return Real{(double) randomState / 4294967296.0};
+}
+
+/*--------------------*/
+
+/**
+ * Sets all parameters of <audioEffect> except for the page
+ * selectors and the raw biquad coefficients to random values from
+ * their declared ranges (uniformly distributed and quantized to
+ * the parameter step) using the generator state <randomState>;
+ * the raw coefficients are excluded because arbitrary values give
+ * unstable filters
+ */
+void _setRandomConfiguration (INOUT SoXAudioEffect* audioEffect,
+                              INOUT std::uint32_t& randomState) {
+    Logging_trace(">>");
+
+    const SoXEffectParameterMap& parameterMap =
+        audioEffect->effectParameterMap();
+    const StringList parameterNameList =
+        parameterMap.parameterNameList();
+    const StringList coefficientNameList =
+        StringList::makeBySplit("a0,a1,a2,b0,b1,b2", ",");
+
+    for (const String& parameterName : parameterNameList) {
+        String effectiveParameterName;
+        Natural pageIndex;
+        SoXEffectParameterMap::splitParameterName(parameterName,
+                                                  effectiveParameterName,
+                                                  pageIndex);
+        const Boolean isVaried =
+            (!SoXEffectParameterMap::isPageSelector(parameterName)
+             && !coefficientNameList.contains(effectiveParameterName));
+
+        if (isVaried) {
+            const SoXEffectParameterKind kind =
+                parameterMap.kind(parameterName);
+            const Real randomValue = _nextRandomValue(randomState);
+            String value;
+
+            if (kind == SoXEffectParameterKind::realKind) {
+                Real lowValue;
+                Real highValue;
+                Real delta;
+                parameterMap.valueRangeReal(parameterName,
+                                            lowValue, highValue, delta);
+                const Real range = highValue - lowValue;
+                Real realValue = lowValue + randomValue * range;
+
+                if (delta > 0.0) {
+                    const Real stepCount = Real::floor(range / delta);
+                    realValue =
+                        lowValue + delta * Real::floor(randomValue
+                                                       * (stepCount
+                                                          + 1.0));
+                    realValue = Real::minimum(realValue, highValue);
+                }
+
+                value = TOSTRING(realValue);
+            } else if (kind == SoXEffectParameterKind::intKind) {
+                Integer lowValue;
+                Integer highValue;
+                Integer delta;
+                parameterMap.valueRangeInt(parameterName,
+                                           lowValue, highValue, delta);
+                const Real valueCount =
+                    Real{highValue} - Real{lowValue} + 1.0;
+                value = TOSTRING(lowValue
+                                 + Integer{(int) Real::floor(randomValue
+                                                             * valueCount)});
+            } else if (kind == SoXEffectParameterKind::enumKind) {
+                StringList valueList;
+                parameterMap.valueRangeEnum(parameterName, valueList);
+                const Real valueCount{Natural{valueList.size()}};
+                const Natural index =
+                    (Natural) Real::floor(randomValue * valueCount);
+                value = valueList[index];
+            }
+
+            audioEffect->setValue(parameterName, value, true);
+        }
+    }
+
+    audioEffect->recalculateSettings();
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+/**
+ * Returns the active parameters of <audioEffect> (without the page
+ * selectors) with their values as a list of "name=value" entries
+ * separated by semicolons
+ */
+String _configurationString (IN SoXAudioEffect* audioEffect) {
+    const SoXEffectParameterMap& parameterMap =
+        audioEffect->effectParameterMap();
+    StringList entryList;
+
+    for (const String& parameterName : parameterMap.parameterNameList()) {
+        if (parameterMap.isActive(parameterName)
+            && !SoXEffectParameterMap::isPageSelector(parameterName)) {
+            entryList.append(parameterName + "="
+                             + parameterMap.value(parameterName));
+        }
+    }
+
+    return entryList.join("; ");
+}
+
+/*--------------------*/
+
+/**
+ * Returns the processing time of <audioEffect> in nanoseconds per
+ * channel sample for a stereo sine at 44.1kHz in blocks of 512
+ * samples as the best of two runs of <secondCount> seconds each
+ * after a warmup
+ */
+Real _nanosecondsPerSample (INOUT SoXAudioEffect* audioEffect,
+                            IN AudioSampleListVector& sourceBuffer,
+                            IN Natural secondCount) {
+    const Natural sampleRate = sourceBuffer.frameCount();
+    const Natural blockSize = 512;
+    const Natural repetitionCount = 2;
+    audioEffect->prepareToPlay(Real{sampleRate});
+
+    AudioSampleListVector buffer{};
+    buffer.setLength(sourceBuffer.length());
+    buffer.setFrameCount(blockSize);
+    Real timePosition = 0.0;
+    _measureBlocks(*audioEffect, sourceBuffer, buffer, Real{sampleRate},
+                   _warmupSecondCount * sampleRate, timePosition);
+
+    const Natural sampleCount = secondCount * sampleRate;
+    Real bestTime = Real::infinity;
+
+    for (Natural run = 0;  run < repetitionCount;  run++) {
+        const Real time =
+            _measureBlocks(*audioEffect, sourceBuffer, buffer,
+                           Real{sampleRate}, sampleCount, timePosition);
+        bestTime = Real::minimum(time, bestTime);
+    }
+
+    /* the sample count is rounded up to full blocks */
+    const Natural processedCount =
+        (sampleCount + blockSize - 1) / blockSize * blockSize;
+    return (bestTime * 1.0E9
+            / (Real{processedCount} * Real{sourceBuffer.length()}));
+}
+
+/*--------------------*/
+
+/**
+ * Runs the worst case search: for each effect <trialCount> random
+ * configurations from the declared parameter ranges (see
+ * <_setRandomConfiguration>) are measured with <secondCount>
+ * seconds of a sine wave each; the <reportCount> slowest
+ * configurations are written to standard output as comma
+ * separated values with their time per sample (in nanoseconds),
+ * their cost relative to the default configuration (reported with
+ * rank 0) and the active parameter values; <seed> initializes the
+ * random generator such that a search is reproducible
+ */
+void _runWorstCaseSearch (IN Natural trialCount,
+                          IN Natural reportCount,
+                          IN Natural secondCount,
+                          IN Natural seed) {
+    Logging_trace4(">>: trialCount = %1, reportCount = %2,"
+                   " secondCount = %3, seed = %4",
+                   TOSTRING(trialCount), TOSTRING(reportCount),
+                   TOSTRING(secondCount), TOSTRING(seed));
+
+    /* the same floating point mode as in the audio processor */
+    const DenormalGuard denormalGuard{};
+
+    /* the phaser effect also covers the tremolo */
+    const String effectNameList[] = {
+        _effectName_gain, _effectName_overdrive, _effectName_filter,
+        _effectName_phaser, _effectName_reverb, _effectName_compander
+    };
+
+    /* one second of a 100Hz sine as the source signal */
+    AudioSampleListVector sourceBuffer{};
+    _fillSineBuffer(sourceBuffer, 44100, _channelCount);
+
+    std::uint32_t randomState = (std::uint32_t) (size_t) seed;
+    cout << "effect,rank,nsPerSample,relativeCost,configuration\n";
+
+    for (const String& effectName : effectNameList) {
+        Natural testLengthInSeconds;
+        SoXAudioEffect* audioEffect =
+            _makeNewEffect(effectName, testLengthInSeconds);
+        const Real defaultTime =
+            _nanosecondsPerSample(audioEffect, sourceBuffer,
+                                  secondCount);
+        cout << STR::expand("%1,0,%2,1.0,\"%3\"",
+                            effectName, TOSTRING(defaultTime),
+                            _configurationString(audioEffect))
+             << "\n" << std::flush;
+        delete audioEffect;
+
+        /* the slowest configurations sorted by descending time */
+        GenericList<Real> timeList;
+        StringList configurationList;
+
+        for (Natural trial = 0;  trial < trialCount;  trial++) {
+            audioEffect = _makeNewEffect(effectName, testLengthInSeconds);
+            _setRandomConfiguration(audioEffect, randomState);
+            const Real time =
+                _nanosecondsPerSample(audioEffect, sourceBuffer,
+                                      secondCount);
+            const String configuration =
+                _configurationString(audioEffect);
+            delete audioEffect;
+            Logging_trace2("--: time = %1, configuration = %2",
+                           TOSTRING(time), configuration);
+
+            /* insertion into the sorted lists */
+            timeList.append(time);
+            configurationList.append(configuration);
+            Natural position = timeList.length() - 1;
+
+            while (position > 0 && timeList[position - 1] < time) {
+                timeList[position] = timeList[position - 1];
+                configurationList[position] =
+                    configurationList[position - 1];
+                position--;
+            }
+
+            timeList[position] = time;
+            configurationList[position] = configuration;
+            timeList.setLength(Natural::minimum(timeList.length(),
+                                                reportCount));
+            configurationList.setLength(timeList.length());
+        }
+
+        for (Natural rank = 0;  rank < timeList.length();  rank++) {
+            const Real time = timeList[rank];
+            cout << STR::expand("%1,%2,%3,%4,\"%5\"",
+                                effectName, TOSTRING(rank + 1),
+                                TOSTRING(time),
+                                TOSTRING(time / defaultTime),
+                                configurationList[rank])
+                 << "\n" << std::flush;
+        }
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+/**
+ * Runs the benchmark for the conversions between reals and strings:
+ * each conversion of <StringUtil> and the equivalent standard
+ * library conversion it replaces (<std::stod> after a syntax check
+ * and <std::to_string>) processes the same list of values
+ * <repetitionCount> times; one line per conversion and path is
+ * written to standard output as comma separated values with the
+ * mean time per call (in nanoseconds) and the number of results
+ * differing from the standard library
+ */
+void _runStringConversionBenchmark (IN Natural repetitionCount) {
+    Logging_trace(">>");
+
+    /* a deterministic mix of parameter-like values in both string
+       representations */
+    GenericList<Real> valueList;
+    StringList valueStringList;
+
+    for (Natural i = 0;  i < _conversionValueCount;  i++) {
+        const Real value =
+            ((double) ((size_t) i * 7919 % 20001) - 10000.0) / 37.0;
+        valueList.append(value);
+        valueStringList.append(std::to_string((double) value));
+    }
+
+    const Real nanosecondsPerSecond = 1.0E9;
+    const Real callCount =
+        Real{_conversionValueCount} * Real{repetitionCount};
+    cout << "conversion,path,callCount,nsPerCall,differenceCount\n";
+
+    const auto writeLine =
+        [&] (IN String& conversion, IN String& path,
+             IN Real time, IN Natural differenceCount) {
+            const String line =
+                STR::expand("%1,%2,%3,%4,%5",
+                            conversion, path,
+                            TOSTRING(Natural{(size_t) (double) callCount}),
+                            TOSTRING(time * nanosecondsPerSecond
+                                     / callCount),
+                            TOSTRING(differenceCount));
+            Logging_trace1("--: %1", line);
+            cout << line << "\n" << std::flush;
+        };
+
+    /* parsing */
+    for (Natural pathIndex = 0;  pathIndex < 2;  pathIndex++) {
+        const Boolean isStandardPath = (pathIndex == 0);
+        Natural differenceCount = 0;
+        Real checkSum = 0.0;
+        const auto startTime = std::chrono::steady_clock::now();
+
+        for (Natural run = 0;  run < repetitionCount;  run++) {
+            for (const String& st : valueStringList) {
+                const Real value =
+                    (!isStandardPath ? STR::toReal(st)
+                     : (STR::isReal(st) ? Real{std::stod(st)}
+                        : Real::maximumValue()));
+                checkSum += value;
+            }
+        }
+
+        const std::chrono::duration<double> duration =
+            std::chrono::steady_clock::now() - startTime;
+
+        for (const String& st : valueStringList) {
+            differenceCount +=
+                (STR::toReal(st) != Real{std::stod(st)} ? 1 : 0);
+        }
+
+        Logging_trace1("--: checkSum = %1", TOSTRING(checkSum));
+        writeLine("toReal", (isStandardPath ? "stod" : "StringUtil"),
+                  Real{duration.count()}, differenceCount);
+    }
+
+    /* formatting */
+    for (Natural pathIndex = 0;  pathIndex < 2;  pathIndex++) {
+        const Boolean isStandardPath = (pathIndex == 0);
+        Natural differenceCount = 0;
+        Natural checkSum = 0;
+        const auto startTime = std::chrono::steady_clock::now();
+
+        for (Natural run = 0;  run < repetitionCount;  run++) {
+            for (const Real value : valueList) {
+                const String st =
+                    (isStandardPath ? std::to_string((double) value)
+                     : TOSTRING(value));
+                checkSum += st.length();
+            }
+        }
+
+        const std::chrono::duration<double> duration =
+            std::chrono::steady_clock::now() - startTime;
+
+        for (const Real value : valueList) {
+            differenceCount +=
+                (TOSTRING(value) != std::to_string((double) value)
+                 ? 1 : 0);
+        }
+
+        Logging_trace1("--: checkSum = %1", TOSTRING(checkSum));
+        writeLine("toString", (isStandardPath ? "to_string" : "StringUtil"),
+                  Real{duration.count()}, differenceCount);
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+/**
+ * Fills <buffer> with the deterministic regression signal for
+ * <sampleRate>: <_regressionSignalSecondCount> seconds of a sine
+ * sweep mixed with pseudo random noise from a fixed seed (slightly
+ * different per channel), followed by the same time of silence for
+ * the decay of the effects
+ */
+void _fillRegressionBuffer (OUT AudioSampleListVector& buffer,
+                            IN Natural sampleRate) {
+    Logging_trace1(">>: sampleRate = %1", TOSTRING(sampleRate));
+
+    const Natural signalLength = _regressionSignalSecondCount * sampleRate;
+    buffer.setLength(_channelCount);
+    buffer.setFrameCount(signalLength * 2);
+
+    for (Natural channel = 0;  channel < _channelCount;  channel++) {
+        AudioSampleList& sampleList = buffer[channel];
+        std::uint32_t randomState = 12345 + (std::uint32_t) (int) channel;
+        Real phase = 0.0;
+
+        for (Natural i = 0;  i < signalLength * 2;  i++) {
+            AudioSample sample = 0.0;
+
+            if (i < signalLength) {
+                /* exponential sweep from 50Hz to 10kHz */
+                const Real frequency =
+                    Real{50.0} * Real::power(200.0, Real{i}
+                                                    / Real{signalLength});
+                phase = Real::mod(phase + Real::twoPi * frequency
+                                          / Real{sampleRate},
+                                  Real::twoPi);
+                randomState = randomState * 1664525 + 1013904223;
+                const Real noise =
+                    Real{(double) randomState / 4294967296.0} - 0.5;
+                sample = Real::sin(phase) * 0.5 + noise * 0.2;
+            }
+
+            sampleList[i] = sample;
+        }
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+/**
+ * Returns <value> in scientific notation with four fractional
+ * digits (for small error values)
+ */
+String _toScientificString (IN Real value) {
+    std::ostringstream stream;
+    stream << std::scientific << std::setprecision(4) << (double) value;
+    return stream.str();
+}
+
+/*--------------------*/
+
+/**
+ * Renders the regression signal for <sampleRate> through a new
+ * effect of kind <effectName> with <variant> and precision profile
+ * <profile> in blocks of <_regressionBlockSize> samples and returns
+ * the result in <buffer>
+ */
+void _renderRegressionCase (IN String& effectName,
+                            IN String& variant,
+                            IN SoXPrecisionProfile profile,
+                            IN Natural sampleRate,
+                            OUT AudioSampleListVector& buffer) {
+    Logging_trace3(">>: effect = %1, variant = %2, profile = %3",
+                   effectName, variant, precisionProfileToString(profile));
+
+    AudioSampleListVector sourceBuffer{};
+    _fillRegressionBuffer(sourceBuffer, sampleRate);
+    const Natural sampleCount = sourceBuffer.frameCount();
+
+    Natural testLengthInSeconds;
+    SoXAudioEffect* audioEffect =
+        _makeNewEffect(effectName, testLengthInSeconds);
+    _initializeBenchmarkVariant(effectName, variant, audioEffect);
+    audioEffect->setPrecisionProfile(profile);
+    audioEffect->prepareToPlay(Real{sampleRate});
+
+    AudioSampleListVector blockBuffer{};
+    blockBuffer.setLength(_channelCount);
+    buffer.setLength(_channelCount);
+    buffer.setFrameCount(sampleCount);
+    Real timePosition = 0.0;
+
+    for (Natural position = 0;  position < sampleCount;
+         position += _regressionBlockSize) {
+        const Natural blockSize =
+            Natural::minimum(_regressionBlockSize, sampleCount - position);
+        blockBuffer.setFrameCount(blockSize);
+
+        for (Natural channel = 0;  channel < _channelCount;  channel++) {
+            for (Natural i = 0;  i < blockSize;  i++) {
+                blockBuffer[channel][i] = sourceBuffer[channel][position + i];
+            }
+        }
+
+        audioEffect->processBlock(timePosition, blockBuffer);
+        timePosition += Real{blockSize} / Real{sampleRate};
+
+        for (Natural channel = 0;  channel < _channelCount;  channel++) {
+            for (Natural i = 0;  i < blockSize;  i++) {
+                buffer[channel][position + i] = blockBuffer[channel][i];
+            }
+        }
+    }
+
+    delete audioEffect;
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+/**
+ * Returns the name of the reference render file for <effectName>
+ * with <variant> in <directoryPath>
+ */
+String _referenceFileName (IN String& directoryPath,
+                           IN String& effectName,
+                           IN String& variant) {
+    return STR::expand("%1/%2-%3.raw", directoryPath, effectName, variant);
+}
+
+/*--------------------*/
+
+/**
+ * Writes the samples in <buffer> as interleaved little-endian 64 bit
+ * reals into file <fileName>; returns whether this was successful
+ */
+Boolean _writeReferenceFile (IN String& fileName,
+                             IN AudioSampleListVector& buffer) {
+    std::ofstream file{fileName, std::ios::binary};
+    const Natural sampleCount = buffer.frameCount();
+
+    for (Natural i = 0;  file && i < sampleCount;  i++) {
+        for (Natural channel = 0;  channel < buffer.length();  channel++) {
+            const double sample = (double) buffer[channel][i];
+            file.write((const char*) &sample, sizeof(double));
+        }
+    }
+
+    return (Boolean) (bool) file;
+}
+
+/*--------------------*/
+
+/**
+ * Reads interleaved 64 bit reals from file <fileName> into <buffer>
+ * with <channelCount> channels; returns whether this was successful
+ */
+Boolean _readReferenceFile (IN String& fileName,
+                            IN Natural channelCount,
+                            OUT AudioSampleListVector& buffer) {
+    std::ifstream file{fileName, std::ios::binary | std::ios::ate};
+    Boolean isOkay = (Boolean) (bool) file;
+
+    if (isOkay) {
+        const size_t byteCount = (size_t) file.tellg();
+        const Natural sampleCount =
+            byteCount / (sizeof(double) * (size_t) channelCount);
+        file.seekg(0);
+        buffer.setLength(channelCount);
+        buffer.setFrameCount(sampleCount);
+
+        for (Natural i = 0;  file && i < sampleCount;  i++) {
+            for (Natural channel = 0;  channel < channelCount;  channel++) {
+                double sample;
+                file.read((char*) &sample, sizeof(double));
+                buffer[channel][i] = sample;
+            }
+        }
+
+        isOkay = (Boolean) (bool) file;
+    }
+
+    return isOkay;
+}
+
+/*--------------------*/
+
+/**
+ * Compares the samples of all channels in <buffer> with those in
+ * <referenceBuffer> of the same size and returns the maximum
+ * absolute sample error in <maximumError> and the RMS error (in dB
+ * relative to full scale) in <rmsErrorInDb>
+ */
+void _measureDeviation (IN AudioSampleListVector& buffer,
+                        IN AudioSampleListVector& referenceBuffer,
+                        OUT Real& maximumError,
+                        OUT Real& rmsErrorInDb) {
+    const Natural channelCount = buffer.length();
+    const Natural sampleCount = buffer.frameCount();
+    Real squaredErrorSum = 0.0;
+    maximumError = 0.0;
+
+    for (Natural channel = 0;  channel < channelCount;  channel++) {
+        for (Natural j = 0;  j < sampleCount;  j++) {
+            const Real error =
+                Real::abs(buffer[channel][j] - referenceBuffer[channel][j]);
+            maximumError = (error > maximumError ? error : maximumError);
+            squaredErrorSum += error * error;
+        }
+    }
+
+    const Natural totalCount =
+        Natural::maximum(sampleCount * channelCount, 1);
+    const Real rmsError =
+        Real::sqrt(squaredErrorSum / Real{totalCount});
+    /* an exact match is reported with the lowest level of the error
+       measure */
+    rmsErrorInDb =
+        (rmsError > Real::zero
+         ? Real{20.0} * Real::log(rmsError) / Real::log(10.0)
+         : _minimumRmsErrorInDb);
+}
+
+/*--------------------*/
+
+/**
+ * Renders the regression signal through all effect cases and
+ * either stores the results as reference renders in
+ * <directoryPath> (when <isRecording> is set) or compares them with
+ * the stored reference renders: a case fails when the maximum
+ * absolute sample error exceeds <maximumAbsoluteError> or the RMS
+ * error (in dB relative to full scale) exceeds <maximumRmsErrorInDb>;
+ * one line per case is written to standard output as comma separated
+ * values; returns the number of failed cases
+ */
+Natural _runRegression (IN String& directoryPath,
+                        IN Boolean isRecording,
+                        IN Real maximumAbsoluteError,
+                        IN Real maximumRmsErrorInDb) {
+    Logging_trace4(">>: directory = %1, isRecording = %2,"
+                   " maxAbsError = %3, maxRmsErrorDb = %4",
+                   directoryPath, TOSTRING(isRecording),
+                   TOSTRING(maximumAbsoluteError),
+                   TOSTRING(maximumRmsErrorInDb));
+
+    /* the same floating point mode as in the audio processor */
+    const DenormalGuard denormalGuard{};
+    const StringList caseList = _effectCaseList();
+    const Natural sampleRate = 44100;
+    Natural failureCount = 0;
+
+    cout << "effect,variant,maxAbsError,rmsErrorDb,status\n";
+
+    for (Natural i = 0;  i < caseList.length();  i += 2) {
+        const String& effectName = caseList[i];
+        const String& variant = caseList[i + 1];
+        const String fileName =
+            _referenceFileName(directoryPath, effectName, variant);
+        AudioSampleListVector buffer{};
+        _renderRegressionCase(effectName, variant,
+                              SoXPrecisionProfile::soxExact,
+                              sampleRate, buffer);
+        String line;
+
+        if (isRecording) {
+            const Boolean isOkay = _writeReferenceFile(fileName, buffer);
+            failureCount += (isOkay ? 0 : 1);
+            line = STR::expand("%1,%2,,,%3", effectName, variant,
+                               (isOkay ? "RECORDED" : "WRITE ERROR"));
+        } else {
+            AudioSampleListVector referenceBuffer{};
+            const Boolean isReadable =
+                _readReferenceFile(fileName, _channelCount,
+                                   referenceBuffer);
+
+            if (!isReadable
+                || referenceBuffer.frameCount() != buffer.frameCount()) {
+                failureCount++;
+                line = STR::expand("%1,%2,,,MISSING REFERENCE",
+                                   effectName, variant);
+            } else {
+                Real maximumError;
+                Real rmsErrorInDb;
+                _measureDeviation(buffer, referenceBuffer,
+                                  maximumError, rmsErrorInDb);
+                const Boolean isOkay =
+                    (maximumError <= maximumAbsoluteError
+                     && rmsErrorInDb <= maximumRmsErrorInDb);
+                failureCount += (isOkay ? 0 : 1);
+                line = STR::expand("%1,%2,%3,%4,%5",
+                                   effectName, variant,
+                                   _toScientificString(maximumError),
+                                   _toScientificString(rmsErrorInDb),
+                                   (isOkay ? "OK" : "FAILED"));
+            }
+        }
+
+        Logging_trace1("--: %1", line);
+        cout << line << "\n" << std::flush;
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(failureCount));
+    return failureCount;
+}
+
+/*--------------------*/
+
+/**
+ * Renders the regression signal through all effect cases in all
+ * precision profiles and compares each rendering with the
+ * rendering in the SoX-exact profile: a case fails when the
+ * deviation exceeds the tolerances of its profile (see
+ * <precisionProfileTolerance>); one line per case and profile is
+ * written to standard output as comma separated values; returns
+ * the number of failed cases
+ */
+Natural _runPrecisionProfileCheck () {
+    Logging_trace(">>");
+
+    const DenormalGuard denormalGuard{};
+    const StringList caseList = _effectCaseList();
+    /* the SoX-exact rendering is repeated to show that it is
+       deterministic */
+    const SoXPrecisionProfile profileList[] = {
+        SoXPrecisionProfile::soxExact, SoXPrecisionProfile::highQuality,
+        SoXPrecisionProfile::fast
+    };
+    const Natural sampleRate = 44100;
+    Natural failureCount = 0;
+
+    cout << "effect,variant,profile,maxAbsError,rmsErrorDb,status\n";
+
+    for (Natural i = 0;  i < caseList.length();  i += 2) {
+        const String& effectName = caseList[i];
+        const String& variant = caseList[i + 1];
+        AudioSampleListVector referenceBuffer{};
+        _renderRegressionCase(effectName, variant,
+                              SoXPrecisionProfile::soxExact,
+                              sampleRate, referenceBuffer);
+
+        for (const SoXPrecisionProfile profile : profileList) {
+            AudioSampleListVector buffer{};
+            _renderRegressionCase(effectName, variant, profile,
+                                  sampleRate, buffer);
+            Real maximumAbsoluteError;
+            Real maximumRmsErrorInDb;
+            precisionProfileTolerance(profile, maximumAbsoluteError,
+                                      maximumRmsErrorInDb);
+            Real maximumError;
+            Real rmsErrorInDb;
+            _measureDeviation(buffer, referenceBuffer,
+                              maximumError, rmsErrorInDb);
+            const Boolean isOkay =
+                (maximumError <= maximumAbsoluteError
+                 && rmsErrorInDb <= maximumRmsErrorInDb);
+            failureCount += (isOkay ? 0 : 1);
+            const String line =
+                STR::expand("%1,%2,%3,%4,%5,%6",
+                            effectName, variant,
+                            precisionProfileToString(profile),
+                            _toScientificString(maximumError),
+                            _toScientificString(rmsErrorInDb),
+                            (isOkay ? "OK" : "FAILED"));
+            Logging_trace1("--: %1", line);
+            cout << line << "\n" << std::flush;
+        }
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(failureCount));
+    return failureCount;
+}
+
+/*--------------------*/
+
+/**
+ * Returns the list of conformance cases as a flat list of
+ * quadruples of test category, name of source signal, SoX effect
+ * command and parameter text; the cases are those of
+ * "test/makeTestFiles.sh" producing the SoX references, the
+ * parameter text is only given for commands not translated by the
+ * command parser of the renderer
+ */
+StringList _conformanceCaseList () {
+    /* the translation of compand approximates the transfer function
+       by its last segment, but the plugin knee is nonnegative, hence
+       the magnitude of the SoX knee is taken; mcompand is translated
+       band-wise */
+    const String companderText =
+        ("SoXCompander\n"
+         "-2#Band Count = \"1\"\n"
+         "1#Attack [s] = \"0.02\"\n"
+         "1#Decay [s] = \"0.15\"\n"
+         "1#Knee [dB] = \"4\"\n"
+         "1#Threshold [dB] = \"-60\"\n"
+         "1#Ratio = \"1.5\"\n"
+         "1#Gain [dB] = \"4.5\"");
+    const String mcompanderText =
+        ("SoXCompander\n"
+         "-2#Band Count = \"2\"\n"
+         "1#Attack [s] = \"0.02\"\n"
+         "1#Decay [s] = \"0.15\"\n"
+         "1#Knee [dB] = \"4\"\n"
+         "1#Threshold [dB] = \"-60\"\n"
+         "1#Ratio = \"1.5\"\n"
+         "1#Gain [dB] = \"4.5\"\n"
+         "1#Top Frequency [Hz] = \"1000\"\n"
+         "2#Attack [s] = \"0.15\"\n"
+         "2#Decay [s] = \"0.4\"\n"
+         "2#Knee [dB] = \"0.01\"\n"
+         "2#Threshold [dB] = \"-20\"\n"
+         "2#Ratio = \"2\"\n"
+         "2#Gain [dB] = \"-2\"");
+    const String caseArray[] = {
+        "allpass",    "noise",      "allpass 1050 3q",              "",
+        "band",       "noise",      "band 1222 2.3q",               "",
+        "bandpass",   "noise",      "bandpass -c 520 2o",           "",
+        "bandreject", "noise",      "bandreject 1531 1q",           "",
+        "bass",       "sine-sweep", "bass -1.23 536 2q",            "",
+        "biquad",     "noise",      "biquad 0.3 -0.5 0.3 2 -0.4 0.1", "",
+        "compander",  "noise",
+            "compand 0.02,0.15 -4:-60,0,-20 +4.5",       companderText,
+        "equalizer",  "sine-sweep", "equalizer 520 2o -3",          "",
+        "gain",       "noise",      "gain -7.5",                    "",
+        "highpass",   "sine-sweep", "highpass -1 2750",             "",
+        "lowpass",    "noise",      "lowpass -2 250 2o",            "",
+        "overdrive",  "noise",      "overdrive 3 40",               "",
+        "mcompander", "noise",
+            ("mcompand \"0.02,0.15 4:-60,0,-20 +4.5\" 1000"
+             " \"0.15,0.4 -20,0,-10 -2\""),             mcompanderText,
+        "phaser",     "noise",      "phaser 0.6 0.66 3 0.6 0.5 -t", "",
+        "reverb",     "noise",      "reverb 60 22 87.5 34.88 20 -3", "",
+        "treble",     "noise",      "treble +2.75 5200 2o",         "",
+        "tremolo",    "sine-sweep", "tremolo 0.395 94.67",          ""
+    };
+
+    StringList result;
+
+    for (const String& st : caseArray) {
+        result.append(st);
+    }
+
+    return result;
+}
+
+/*--------------------*/
+
+/**
+ * Fills <buffer> with the conformance test signal <signalName> for
+ * <sampleRate> modelled on the signals of "test/makeTestFiles.sh":
+ * "noise" has pseudo random pink noise from a fixed seed in the
+ * left and a 135Hz sine in the right channel, both in four bursts
+ * alternating between 20% and 60% level, "sine-sweep" is an
+ * exponential sweep from 100Hz to 5kHz at -6dB and "sine-500Hz" a
+ * full scale sine of 500Hz; each signal lasts
+ * <_conformanceSignalSecondCount> seconds with a fade in and out of
+ * a tenth of a second and is padded with a second of silence on
+ * both sides
+ */
+void _fillConformanceSignal (IN String& signalName,
+                             IN Natural sampleRate,
+                             OUT AudioSampleListVector& buffer) {
+    Logging_trace2(">>: signal = %1, sampleRate = %2",
+                   signalName, TOSTRING(sampleRate));
+
+    const Natural signalLength =
+        _conformanceSignalSecondCount * sampleRate;
+    const Natural fadeLength = sampleRate / 10;
+    const Natural burstLength = signalLength / 4;
+    const Real sweepFrequencyRatio = 50.0;
+    buffer.setLength(_channelCount);
+    buffer.setFrameCount(signalLength + sampleRate * 2);
+
+    std::uint32_t randomState = 4711;
+    Real pinkStateA = 0.0;
+    Real pinkStateB = 0.0;
+    Real pinkStateC = 0.0;
+    Real phase = 0.0;
+
+    for (Natural i = 0;  i < buffer.frameCount();  i++) {
+        AudioSample leftSample = 0.0;
+        AudioSample rightSample = 0.0;
+
+        if (i >= sampleRate && i < sampleRate + signalLength) {
+            const Natural j = i - sampleRate;
+            const Real envelope =
+                Real::minimum(Real{1.0},
+                              Real::minimum(Real{j} / Real{fadeLength},
+                                            Real{signalLength - j}
+                                            / Real{fadeLength}));
+
+            if (signalName == "noise") {
+                /* pink noise by the economy filter of Paul Kellet
+                   applied to white noise */
+                randomState = randomState * 1664525 + 1013904223;
+                const Real white =
+                    Real{(double) randomState / 2147483648.0} - 1.0;
+                pinkStateA = pinkStateA * 0.99765 + white * 0.0990460;
+                pinkStateB = pinkStateB * 0.96300 + white * 0.2965164;
+                pinkStateC = pinkStateC * 0.57000 + white * 1.0526913;
+                const Real pink =
+                    (pinkStateA + pinkStateB + pinkStateC
+                     + white * 0.1848) * 0.25;
+                phase = Real::mod(phase + Real::twoPi * Real{135.0}
+                                          / Real{sampleRate},
+                                  Real::twoPi);
+                const Boolean isLoudBurst = ((j / burstLength) % 2 == 1);
+                const Real clippedPink =
+                    Real::maximum(Real{-1.0}, Real::minimum(Real{1.0}, pink));
+                leftSample  = clippedPink * (isLoudBurst ? 0.6 : 0.2);
+                rightSample = Real::sin(phase) * (isLoudBurst ? 0.2 : 0.6);
+            } else if (signalName == "sine-sweep") {
+                const Real frequency =
+                    Real{100.0} * Real::power(sweepFrequencyRatio,
+                                              Real{j}
+                                              / Real{signalLength});
+                phase = Real::mod(phase + Real::twoPi * frequency
+                                          / Real{sampleRate},
+                                  Real::twoPi);
+                leftSample  = Real::sin(phase) * 0.5;
+                rightSample = leftSample;
+            } else {
+                phase = Real::mod(phase + Real::twoPi * Real{500.0}
+                                          / Real{sampleRate},
+                                  Real::twoPi);
+                leftSample  = Real::sin(phase);
+                rightSample = leftSample;
+            }
+
+            leftSample  = leftSample * envelope;
+            rightSample = rightSample * envelope;
+        }
+
+        buffer[0][i] = leftSample;
+        buffer[1][i] = rightSample;
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+/**
+ * Reads all frames of the audio file <fileName> into <buffer>;
+ * returns whether this was successful
+ */
+Boolean _readAudioFile (IN String& fileName,
+                        OUT AudioSampleListVector& buffer) {
+    SoXAudioFileReader reader{};
+    Boolean isOkay = reader.open(fileName, false);
+
+    if (isOkay) {
+        const Natural frameCount = reader.frameCount();
+        isOkay = (reader.read(buffer, frameCount) == frameCount);
+        reader.close();
+    }
+
+    return isOkay;
+}
+
+/*--------------------*/
+
+/**
+ * Writes the conformance test signals for <sampleRate> missing in
+ * <directoryPath> as stereo WAV files with 32 bit float samples
+ * (the sources of the SoX references); returns whether all
+ * signals are available afterwards
+ */
+Boolean _writeConformanceSignals (IN String& directoryPath,
+                                  IN Natural sampleRate) {
+    Logging_trace2(">>: directory = %1, sampleRate = %2",
+                   directoryPath, TOSTRING(sampleRate));
+
+    const StringList signalNameList =
+        StringList::makeBySplit("noise/sine-sweep/sine-500Hz", "/");
+    Boolean isOkay = (OperatingSystem::directoryExists(directoryPath)
+                      || OperatingSystem::makeDirectory(directoryPath));
+
+    SoXAudioFileFormat format{};
+    format.kind          = SoXAudioFileKind::wav;
+    format.channelCount  = _channelCount;
+    format.sampleRate    = sampleRate;
+    format.bitsPerSample = 32;
+    format.isFloat       = true;
+
+    for (const String& signalName : signalNameList) {
+        const String fileName =
+            STR::expand("%1/%2.wav", directoryPath, signalName);
+
+        if (isOkay && !OperatingSystem::fileExists(fileName)) {
+            AudioSampleListVector buffer{};
+            _fillConformanceSignal(signalName, sampleRate, buffer);
+            SoXAudioFileWriter writer{};
+            isOkay = (writer.open(fileName, format)
+                      && writer.write(buffer, buffer.frameCount()));
+            writer.close();
+        }
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+
+/**
+ * A <_ConformanceContext> object holds the data of the conformance
+ * check shared by the tasks rendering the cases on the worker pool.
+ */
+struct _ConformanceContext {
+
+    /** the directory with signals, references and renders */
+    String directoryPath;
+
+    /** the flat list of cases (see <_conformanceCaseList>) */
+    StringList caseList;
+
+    /** the maximum absolute sample error of a passed case */
+    Real maximumAbsoluteError;
+
+    /** the maximum RMS error in dB of a passed case */
+    Real maximumRmsErrorInDb;
+
+    /** the result line per case */
+    String* lineArray;
+
+    /** the information per case whether it has passed */
+    Boolean* isOkayArray;
+
+};
+
+/*--------------------*/
+
+/**
+ * Renders the source signal of conformance case <caseIndex> in
+ * <context> by a fresh offline renderer into the file
+ * "<signal>-<category>render.wav" and compares it with the SoX
+ * reference "<signal>-<category>test.wav" (as task function of the
+ * worker pool)
+ */
+void _runConformanceCase (INOUT void* context,
+                          IN Natural caseIndex) {
+    _ConformanceContext& conformanceContext =
+        *((_ConformanceContext*) context);
+    const String& directoryPath = conformanceContext.directoryPath;
+    const StringList& caseList = conformanceContext.caseList;
+    const Natural i = caseIndex * _conformanceCaseFieldCount;
+    const String& category      = caseList[i];
+    const String& signalName    = caseList[i + 1];
+    const String& command       = caseList[i + 2];
+    const String& parameterText = caseList[i + 3];
+    Logging_trace2(">>: category = %1, command = %2", category, command);
+
+    const String inputFileName =
+        STR::expand("%1/%2.wav", directoryPath, signalName);
+    const String referenceFileName =
+        STR::expand("%1/%2-%3test.wav", directoryPath, signalName,
+                    category);
+    const String outputFileName =
+        STR::expand("%1/%2-%3render.wav", directoryPath, signalName,
+                    category);
+    SoXOfflineRenderer renderer{};
+    AudioSampleListVector referenceBuffer{};
+    AudioSampleListVector buffer{};
+    Boolean isOkay = false;
+    String status;
+    Real maximumError = 0.0;
+    Real rmsErrorInDb = 0.0;
+
+    if (!(parameterText == "" ? renderer.setEffectCommand(command)
+          : renderer.setParameterText(parameterText))) {
+        status = "BAD EFFECT";
+    } else if (!_readAudioFile(referenceFileName, referenceBuffer)) {
+        status = "MISSING REFERENCE";
+    } else if (!renderer.render(inputFileName, outputFileName)
+               || !_readAudioFile(outputFileName, buffer)) {
+        status = "RENDER ERROR";
+    } else if (buffer.length() != referenceBuffer.length()
+               || buffer.frameCount() != referenceBuffer.frameCount()) {
+        status = "LENGTH MISMATCH";
+    } else {
+        _measureDeviation(buffer, referenceBuffer,
+                          maximumError, rmsErrorInDb);
+        isOkay = (maximumError <= conformanceContext.maximumAbsoluteError
+                  && (rmsErrorInDb
+                      <= conformanceContext.maximumRmsErrorInDb));
+        status = (isOkay ? "OK" : "FAILED");
+    }
+
+    const Boolean isCompared = (isOkay || status == "FAILED");
+    conformanceContext.isOkayArray[(size_t) caseIndex] = isOkay;
+    conformanceContext.lineArray[(size_t) caseIndex] =
+        STR::expand("%1,%2,%3,%4,%5", category, signalName,
+                    (isCompared ? _toScientificString(maximumError) : ""),
+                    (isCompared ? _toScientificString(rmsErrorInDb) : ""),
+                    status);
+
+    Logging_trace1("<<: %1", status);
+}
+
+/*--------------------*/
+
+/**
+ * Runs the headless conformance check of the effects against SoX:
+ * writes the test signals missing in <directoryPath>, renders them
+ * for all cases of "test/makeTestFiles.sh" in parallel on
+ * <threadCount> threads (zero selects the number of hardware
+ * threads) and compares each render with the reference made by
+ * SoX from the same signal; a case fails when its reference is
+ * missing, the maximum absolute sample error exceeds
+ * <maximumAbsoluteError> or the RMS error (in dB relative to full
+ * scale) exceeds <maximumRmsErrorInDb>; one line per case is
+ * written to standard output as comma separated values in the
+ * order of the cases; returns the number of failed cases
+ */
+Natural _runConformanceCheck (IN String& directoryPath,
+                              IN Natural threadCount,
+                              IN Real maximumAbsoluteError,
+                              IN Real maximumRmsErrorInDb) {
+    Logging_trace4(">>: directory = %1, threadCount = %2,"
+                   " maxAbsError = %3, maxRmsErrorDb = %4",
+                   directoryPath, TOSTRING(threadCount),
+                   TOSTRING(maximumAbsoluteError),
+                   TOSTRING(maximumRmsErrorInDb));
+
+    const Natural sampleRate = 44100;
+    const Natural effectiveThreadCount =
+        (threadCount > 0 ? threadCount
+          : Natural::maximum(1, (size_t)
+                            std::thread::hardware_concurrency()));
+    _ConformanceContext context;
+    context.directoryPath        = directoryPath;
+    context.caseList             = _conformanceCaseList();
+    context.maximumAbsoluteError = maximumAbsoluteError;
+    context.maximumRmsErrorInDb  = maximumRmsErrorInDb;
+    const Natural caseCount =
+        context.caseList.length() / _conformanceCaseFieldCount;
+    context.lineArray   = new String[(size_t) caseCount];
+    context.isOkayArray = new Boolean[(size_t) caseCount];
+    Natural failureCount = 0;
+
+    if (!_writeConformanceSignals(directoryPath, sampleRate)) {
+        cerr << "cannot write test signals to " << directoryPath << "\n";
+    }
+
+    /* the calling thread is the first thread of the check; each
+       case is a task with a block length enabling the pool */
+    SoXWorkerPool& workerPool = SoXWorkerPool::instance();
+    workerPool.configure(effectiveThreadCount - 1, 1);
+    workerPool.run(_runConformanceCase, &context, caseCount, 1);
+
+    cout << "category,signal,maxAbsError,rmsErrorDb,status\n";
+
+    for (Natural i = 0;  i < caseCount;  i++) {
+        const String& line = context.lineArray[(size_t) i];
+        failureCount += (context.isOkayArray[(size_t) i] ? 0 : 1);
+        Logging_trace1("--: %1", line);
+        cout << line << "\n";
+    }
+
+    cout << std::flush;
+    delete[] context.lineArray;
+    delete[] context.isOkayArray;
+
+    Logging_trace1("<<: %1", TOSTRING(failureCount));
+    return failureCount;
+}
+
+/*--------------------*/
+
+/**
+ * Renders the regression signal for all effect cases in blocks of
+ * <_regressionBlockSize> samples with the processing calls marked
+ * as real-time scope and counts the allocations and blocking locks
+ * therein; one line per case is written to standard output as
+ * comma separated values; returns the number of cases with
+ * violations (always zero when the check is not compiled in)
+ */
+Natural _runRealtimeCheck () {
+    Logging_trace(">>");
+
+    /* the same floating point mode as in the audio processor */
+    const DenormalGuard denormalGuard{};
+    const StringList caseList = _effectCaseList();
+    const Natural sampleRate = 44100;
+    const Boolean isActive = SoXRealtimeGuard::isActive();
+    AudioSampleListVector sourceBuffer{};
+    _fillRegressionBuffer(sourceBuffer, sampleRate);
+    const Natural sampleCount = sourceBuffer.frameCount();
+    Natural failureCount = 0;
+
+    cout << "effect,variant,violationCount,status\n";
+
+    for (Natural i = 0;  i < caseList.length();  i += 2) {
+        const String& effectName = caseList[i];
+        const String& variant = caseList[i + 1];
+        Natural testLengthInSeconds;
+        SoXAudioEffect* audioEffect =
+            _makeNewEffect(effectName, testLengthInSeconds);
+        _initializeBenchmarkVariant(effectName, variant, audioEffect);
+        audioEffect->prepareToPlay(Real{sampleRate});
+
+        AudioSampleListVector blockBuffer{};
+        blockBuffer.setLength(_channelCount);
+        blockBuffer.setFrameCount(_regressionBlockSize);
+        const Real increment = Real{_regressionBlockSize} / Real{sampleRate};
+        Real timePosition = 0.0;
+        SoXRealtimeGuard::resetViolationCount();
+
+        for (Natural position = 0;
+             position + _regressionBlockSize <= sampleCount;
+             position += _regressionBlockSize) {
+            for (Natural channel = 0;  channel < _channelCount;
+                 channel++) {
+                for (Natural j = 0;  j < _regressionBlockSize;  j++) {
+                    blockBuffer[channel][j] =
+                        sourceBuffer[channel][position + j];
+                }
+            }
+
+            {
+                const SoXRealtimeGuard guard{"SoX-Test.processBlock"};
+                audioEffect->processBlock(timePosition, blockBuffer);
+            }
+
+            timePosition += increment;
+        }
+
+        const Natural violationCount = SoXRealtimeGuard::violationCount();
+        failureCount += (violationCount > 0 ? 1 : 0);
+        const String line =
+            STR::expand("%1,%2,%3,%4", effectName, variant,
+                        TOSTRING(violationCount),
+                        (!isActive ? "INACTIVE"
+                         : violationCount > 0 ? "FAILED" : "OK"));
+        delete audioEffect;
+
+        Logging_trace1("--: %1", line);
+        cout << line << "\n" << std::flush;
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(failureCount));
+    return failureCount;
+}
+
+/*--------------------*/
+
+/**
+ * A <_SessionInstance> is a single effect instance of the session
+ * benchmark together with its own block buffer and its processing
+ * time statistics
+ */
+struct _SessionInstance {
+
+    /** the effect instance */
+    SoXAudioEffect* audioEffect;
+
+    /** the block buffer of the instance */
+    AudioSampleListVector buffer;
+
+    /** the offset of the instance into the source signal */
+    Natural sourceOffset;
+
+    /** the total processing time in seconds */
+    Real totalTime;
+
+    /** the maximum processing time of a single block in seconds */
+    Real maximumTime;
+
+};
+
+/*--------------------*/
+
+/**
+ * A <_SessionContext> is the data of a single host callback in the
+ * session benchmark shared by all tasks
+ */
+struct _SessionContext {
+
+    /** the instances of the session */
+    _SessionInstance* instanceArray;
+
+    /** the source signal cycled through by all instances */
+    const AudioSampleListVector* sourceBuffer;
+
+    /** the position of the current block in the source signal */
+    Natural sourcePosition;
+
+    /** the time position of the current block */
+    Real timePosition;
+
+    /** tells whether the processing times are recorded */
+    Boolean isMeasured;
+
+};
+
+/*--------------------*/
+
+/**
+ * Processes the current block of the instance with <instanceIndex>
+ * in the session <context> (as task function of the worker pool)
+ */
+void _processSessionInstance (INOUT void* context,
+                              IN Natural instanceIndex) {
+    _SessionContext& sessionContext = *((_SessionContext*) context);
+    _SessionInstance& instance =
+        sessionContext.instanceArray[(size_t) instanceIndex];
+    const AudioSampleListVector& sourceBuffer =
+        *sessionContext.sourceBuffer;
+    const Natural sourceLength = sourceBuffer.frameCount();
+    const Natural blockSize = instance.buffer.frameCount();
+    const Natural startPosition =
+        (sessionContext.sourcePosition + instance.sourceOffset)
+        % sourceLength;
+
+    /* like a host each instance gets its own input */
+    for (Natural channel = 0;  channel < instance.buffer.length();
+         channel++) {
+        const AudioSampleList& srcList = sourceBuffer[channel];
+        AudioSampleList& destList = instance.buffer[channel];
+        Natural j = startPosition;
+
+        for (Natural i = 0;  i < blockSize;  i++) {
+            destList[i] = srcList[j];
+            j = (j + 1 < sourceLength ? j + 1 : Natural{0});
+        }
+    }
+
+    /* worker threads keep their floating point mode, hence it is
+       set per task */
+    const DenormalGuard denormalGuard{};
+    const auto startTime = std::chrono::steady_clock::now();
+    instance.audioEffect->processBlock(sessionContext.timePosition,
+                                       instance.buffer);
+    const std::chrono::duration<double> duration =
+        std::chrono::steady_clock::now() - startTime;
+
+    if (sessionContext.isMeasured) {
+        const Real time{duration.count()};
+        instance.totalTime += time;
+        instance.maximumTime = Real::maximum(instance.maximumTime, time);
+    }
+}
+
+/*--------------------*/
+
+/**
+ * Runs the session benchmark simulating a host with many plugin
+ * instances: for each combination from <blockSizeList>,
+ * <threadCountList> and <instanceCountList> a session with that
+ * many instances cycling through all effect cases (hence with
+ * varied parameters) processes <secondCount> seconds after a
+ * warmup; in each host callback all instances process a block and
+ * are spread across the calling thread and the worker pool like in
+ * a parallel plugin graph; one line per combination is written to
+ * standard output as comma separated values with the DSP load (the
+ * callback time relative to the real time of the blocks), the mean
+ * and maximum cost of an instance per block (in microseconds), the
+ * cost per sample of an instance (in nanoseconds) together with its
+ * ratio to the smallest session of the same block size and thread
+ * count (which exposes cache effects), the worst callback time
+ * (in microseconds and relative to the block duration) and the
+ * memory footprint of the session after processing (the mean bytes
+ * of an instance per kind of storage and the total bytes of all
+ * effects in the process) followed by the tasks stolen between
+ * the pool threads and the idle share of the workers
+ */
+void _runSessionBenchmark (IN NaturalList& instanceCountList,
+                           IN NaturalList& blockSizeList,
+                           IN NaturalList& threadCountList,
+                           IN Natural secondCount) {
+    Logging_trace(">>");
+
+    /* the same floating point mode as in the audio processor */
+    const DenormalGuard denormalGuard{};
+    const StringList caseList = _effectCaseList();
+    const Natural caseCount = caseList.length() / 2;
+    const Natural sampleRate = 44100;
+    const Real microsecondsPerSecond = 1.0E6;
+    SoXWorkerPool& workerPool = SoXWorkerPool::instance();
+
+    /* one second of the regression signal as the source signal */
+    AudioSampleListVector sourceBuffer{};
+    _fillRegressionBuffer(sourceBuffer, sampleRate);
+    sourceBuffer.setFrameCount(sampleRate);
+
+    cout << "instanceCount,blockSize,threadCount,blockCount,"
+         << "dspLoadPercent,meanInstanceUs,maximumInstanceUs,"
+         << "nsPerSample,relativeCost,worstCallbackUs,"
+         << "worstCallbackPercent,delayLineBytes,ringBufferBytes,"
+         << "parameterMapBytes,descriptorBytes,totalBytes,"
+         << "stealCount,workerIdlePercent\n";
+
+    for (const Natural blockSize : blockSizeList) {
+        for (const Natural threadCount : threadCountList) {
+            /* the calling thread is the first thread of the host */
+            workerPool.configure(Natural::maximum(threadCount, 1) - 1, 1);
+            Real referenceNsPerSample = 0.0;
+
+            for (const Natural instanceCount : instanceCountList) {
+                _SessionInstance* instanceArray =
+                    new _SessionInstance[(size_t) instanceCount];
+
+                for (Natural i = 0;  i < instanceCount;  i++) {
+                    _SessionInstance& instance = instanceArray[(size_t) i];
+                    const Natural caseIndex = (i % caseCount) * 2;
+                    const String& effectName = caseList[caseIndex];
+                    const String& variant = caseList[caseIndex + 1];
+                    Natural testLengthInSeconds;
+                    instance.audioEffect =
+                        _makeNewEffect(effectName, testLengthInSeconds);
+                    _initializeBenchmarkVariant(effectName, variant,
+                                                instance.audioEffect);
+                    instance.audioEffect->prepareToPlay(Real{sampleRate});
+                    instance.buffer.setLength(_channelCount);
+                    instance.buffer.setFrameCount(blockSize);
+                    instance.sourceOffset = (i * 7919) % sampleRate;
+                    instance.totalTime   = 0.0;
+                    instance.maximumTime = 0.0;
+                }
+
+                _SessionContext context;
+                context.instanceArray  = instanceArray;
+                context.sourceBuffer   = &sourceBuffer;
+                context.sourcePosition = 0;
+                context.timePosition   = 0.0;
+
+                const Natural warmupBlockCount =
+                    _warmupSecondCount * sampleRate / blockSize;
+                const Natural blockCount =
+                    Natural::maximum(secondCount * sampleRate / blockSize,
+                                     1);
+                const Real blockDuration =
+                    Real{blockSize} / Real{sampleRate};
+                Real totalCallbackTime = 0.0;
+                Real worstCallbackTime = 0.0;
+                auto measurementStartTime =
+                    std::chrono::steady_clock::now();
+
+                for (Natural block = 0;
+                     block < warmupBlockCount + blockCount;  block++) {
+                    context.isMeasured = (block >= warmupBlockCount);
+
+                    if (block == warmupBlockCount) {
+                        workerPool.resetStatistics();
+                        measurementStartTime =
+                            std::chrono::steady_clock::now();
+                    }
+
+                    const auto startTime = std::chrono::steady_clock::now();
+                    workerPool.run(_processSessionInstance, &context,
+                                   instanceCount, blockSize);
+                    const std::chrono::duration<double> duration =
+                        std::chrono::steady_clock::now() - startTime;
+
+                    if (context.isMeasured) {
+                        const Real time{duration.count()};
+                        totalCallbackTime += time;
+                        worstCallbackTime =
+                            Real::maximum(worstCallbackTime, time);
+                    }
+
+                    context.sourcePosition =
+                        (context.sourcePosition + blockSize) % sampleRate;
+                    context.timePosition += blockDuration;
+                }
+
+                const std::chrono::duration<double> measurementDuration =
+                    std::chrono::steady_clock::now() - measurementStartTime;
+                const SoXWorkerPoolStatistics poolStatistics =
+                    workerPool.statistics();
+                Real totalInstanceTime = 0.0;
+                Real maximumInstanceTime = 0.0;
+
+                /* the buffers may have grown during processing */
+                for (Natural i = 0;  i < instanceCount;  i++) {
+                    instanceArray[(size_t) i].audioEffect
+                        ->publishMemoryFootprint();
+                }
+
+                Natural effectCount;
+                const SoXMemoryFootprint footprint =
+                    SoXAudioEffect::totalMemoryFootprint(effectCount);
+                effectCount = Natural::maximum(effectCount, 1);
+
+                for (Natural i = 0;  i < instanceCount;  i++) {
+                    _SessionInstance& instance = instanceArray[(size_t) i];
+                    totalInstanceTime += instance.totalTime;
+                    maximumInstanceTime =
+                        Real::maximum(maximumInstanceTime,
+                                      instance.maximumTime);
+                    delete instance.audioEffect;
+                }
+
+                delete[] instanceArray;
+
+                const Real instanceBlockCount =
+                    Real{instanceCount} * Real{blockCount};
+                const Real dspLoad =
+                    totalCallbackTime
+                    / (Real{blockCount} * blockDuration) * 100.0;
+                const Real meanInstanceTime =
+                    totalInstanceTime / instanceBlockCount;
+                const Real nsPerSample =
+                    meanInstanceTime * 1.0E9
+                    / Real{blockSize * _channelCount};
+                referenceNsPerSample =
+                    (referenceNsPerSample == Real::zero ? nsPerSample
+                     : referenceNsPerSample);
+                const Real workerTime =
+                    Real{measurementDuration.count()}
+                    * Real{workerPool.threadCount()};
+                const Real workerIdlePercent =
+                    (workerTime == Real::zero ? Real::zero
+                     : poolStatistics.idleTime / workerTime * 100.0);
+
+                const String line =
+                    STR::expand("%1,%2,%3,%4,%5,%6,",
+                                TOSTRING(instanceCount),
+                                TOSTRING(blockSize),
+                                TOSTRING(threadCount),
+                                TOSTRING(blockCount),
+                                TOSTRING(dspLoad),
+                                TOSTRING(meanInstanceTime
+                                         * microsecondsPerSecond))
+                    + STR::expand("%1,%2,%3,%4,%5",
+                                  TOSTRING(maximumInstanceTime
+                                           * microsecondsPerSecond),
+                                  TOSTRING(nsPerSample),
+                                  TOSTRING(nsPerSample
+                                           / referenceNsPerSample),
+                                  TOSTRING(worstCallbackTime
+                                           * microsecondsPerSecond),
+                                  TOSTRING(worstCallbackTime
+                                           / blockDuration * 100.0))
+                    + STR::expand(",%1,%2,%3,%4,%5",
+                                  TOSTRING(footprint.delayLineByteCount
+                                           / effectCount),
+                                  TOSTRING(footprint.ringBufferByteCount
+                                           / effectCount),
+                                  TOSTRING(footprint.parameterMapByteCount
+                                           / effectCount),
+                                  TOSTRING(footprint.descriptorByteCount
+                                           / effectCount),
+                                  TOSTRING(footprint.totalByteCount()))
+                    + STR::expand(",%1,%2",
+                                  TOSTRING(poolStatistics.stealCount),
+                                  TOSTRING(workerIdlePercent));
+                Logging_trace1("--: %1", line);
+                cout << line << "\n" << std::flush;
+            }
+        }
+    }
+
+    workerPool.configure(0, 128);
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+/**
+ * Returns the effect kind of the test program for the effect named
+ * <effectName> in an automation trace or an empty string when
+ * there is none
+ */
+String _effectKindForTraceName (IN String& effectName) {
+    String result = "";
+
+    if (effectName == "SoXCompander") {
+        result = _effectName_compander;
+    } else if (effectName == "SoXFilter") {
+        result = _effectName_filter;
+    } else if (effectName == "SoXGain") {
+        result = _effectName_gain;
+    } else if (effectName == "SoXOverdrive") {
+        result = _effectName_overdrive;
+    } else if (effectName == "SoXPhaserAndTremolo") {
+        result = _effectName_phaser;
+    } else if (effectName == "SoXReverb") {
+        result = _effectName_reverb;
+    }
+
+    return result;
+}
+
+/*--------------------*/
+
+/**
+ * Replays the automation trace in file <fileName> <repetitionCount>
+ * times against a new effect of kind <audioEffectKind> (or the kind
+ * of the traced effect when empty): the effect starts with the
+ * parameter values of the trace, gets its parameter changes in the
+ * original order and processes blocks of a sine wave with the
+ * original block sizes; reports the processing time of the blocks
+ * per run and returns the number of failures
+ */
+Natural _runAutomationReplay (IN String& fileName,
+                              IN String& audioEffectKind,
+                              IN Natural repetitionCount) {
+    Logging_trace3(">>: fileName = %1, kind = %2, repetitions = %3",
+                   fileName, audioEffectKind, TOSTRING(repetitionCount));
+
+    SoXAutomationTrace trace;
+    const Boolean isReadable = trace.readFromFile(fileName);
+    const String effectKind =
+        (audioEffectKind > "" ? audioEffectKind
+         : _effectKindForTraceName(trace.effectName));
+    Natural failureCount = 0;
+
+    if (!isReadable || effectKind == "") {
+        cout << "cannot replay trace " << fileName << "\n";
+        failureCount = 1;
+    } else {
+        /* the same floating point mode as in the audio processor */
+        const DenormalGuard denormalGuard{};
+        const Natural channelCount = Natural::maximum(1, trace.channelCount);
+        const Natural parameterCount = trace.parameterNameList.length();
+        Natural maximumBlockSize = 1;
+
+        for (const SoXAutomationTraceEntry& entry : trace.entryList) {
+            maximumBlockSize =
+                Natural::maximum(maximumBlockSize, entry.sampleCount);
+        }
+
+        AudioSampleListVector waveFormBuffer{};
+        _fillBuffer(waveFormBuffer, (Integer) Real::round(trace.sampleRate));
+        const Natural waveFormLength = waveFormBuffer.frameCount();
+        AudioSampleListVector buffer{};
+        buffer.resizeChannels(channelCount, maximumBlockSize);
+        AudioSample** channelArray =
+            new AudioSample*[(size_t) channelCount];
+
+        for (Natural channel = 0;  channel < channelCount;  channel++) {
+            channelArray[(size_t) channel] = buffer[channel].asArray();
+        }
+
+        cout << "replaying " << fileName << " (" << trace.effectName
+             << ", " << TOSTRING(trace.entryList.length())
+             << " entries) as " << effectKind << "\n";
+
+        for (Natural run = 0;  run < repetitionCount;  run++) {
+            Natural testLengthInSeconds;
+            SoXAudioEffect* audioEffect =
+                _makeNewEffect(effectKind, testLengthInSeconds);
+            const SoXEffectParameterMap& parameterMap =
+                audioEffect->effectParameterMap();
+
+            for (Natural i = 0;  i < parameterCount;  i++) {
+                const String& parameterName = trace.parameterNameList[i];
+
+                if (parameterMap.contains(parameterName)) {
+                    audioEffect->setValue(parameterName,
+                                          trace.initialValueList[i],
+                                          false);
+                }
+            }
+
+            audioEffect->recalculateSettings();
+            audioEffect->prepareToPlay(trace.sampleRate);
+
+            Real timePosition = 0.0;
+            Natural wavePosition = 0;
+            Natural blockCount = 0;
+            Natural sampleCount = 0;
+            Real totalTime = 0.0;
+            Real maximumTime = 0.0;
+
+            for (const SoXAutomationTraceEntry& entry : trace.entryList) {
+                if (entry.kind == SoXAutomationTraceEntryKind::block) {
+                    const Natural blockSize = entry.sampleCount;
+
+                    for (Natural channel = 0;  channel < channelCount;
+                         channel++) {
+                        const AudioSampleList& srcList =
+                            waveFormBuffer[channel % _channelCount];
+                        AudioSample* destArray =
+                            channelArray[(size_t) channel];
+
+                        for (Natural j = 0;  j < blockSize;  j++) {
+                            destArray[(size_t) j] =
+                                srcList[(wavePosition + j)
+                                        % waveFormLength];
+                        }
+                    }
+
+                    AudioSampleListView bufferView{channelArray,
+                                                   channelCount,
+                                                   blockSize};
+                    const auto startTime =
+                        std::chrono::steady_clock::now();
+                    audioEffect->processBlock(timePosition, bufferView);
+                    const std::chrono::duration<double> duration =
+                        std::chrono::steady_clock::now() - startTime;
+                    const Real time{duration.count()};
+                    totalTime += time;
+                    maximumTime = Real::maximum(maximumTime, time);
+                    blockCount++;
+                    sampleCount += blockSize;
+                    wavePosition = (wavePosition + blockSize)
+                                   % waveFormLength;
+                    timePosition += Real{blockSize} / trace.sampleRate;
+                } else if (entry.parameterId < parameterCount) {
+                    const String& parameterName =
+                        trace.parameterNameList[entry.parameterId];
+
+                    if (!parameterMap.contains(parameterName)) {
+                        Logging_traceError1("unknown parameter - %1",
+                                            parameterName);
+                    } else if (entry.kind
+                               == SoXAutomationTraceEntryKind
+                                  ::stringValue) {
+                        audioEffect->setValue(parameterName, entry.value,
+                                              entry.recalculationIsForced);
+                    } else {
+                        audioEffect->setNumericValue(
+                            parameterMap.parameterId(parameterName),
+                            entry.numericValue,
+                            entry.recalculationIsForced);
+                    }
+                }
+            }
+
+            const Real audioTime = Real{sampleCount} / trace.sampleRate;
+            const Real meanTime =
+                (blockCount == 0 ? Real{0.0}
+                 : totalTime / Real{blockCount});
+            const String line =
+                STR::expand("run %1: blocks = %2, audio = %3s,"
+                            " processing = %4s, mean block = %5us,"
+                            " max block = %6us, load = %7%",
+                            TOSTRING(run + 1), TOSTRING(blockCount),
+                            TOSTRING(audioTime), TOSTRING(totalTime),
+                            TOSTRING(meanTime * Real{1.0E6}),
+                            TOSTRING(maximumTime * Real{1.0E6}),
+                            TOSTRING(audioTime > Real{0.0}
+                                     ? totalTime / audioTime
+                                       * Real{100.0}
+                                     : Real{0.0}));
+            Logging_trace1("--: %1", line);
+            cout << line << "\n";
+            delete audioEffect;
+        }
+
+        delete[] channelArray;
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(failureCount));
+    return failureCount;
+}
+
+/*--------------------*/
+
+/**
+ * A <_StressParameter> is a parameter varied by the producer threads
+ * of the update stress test together with the values they may set
+ */
+struct _StressParameter {
+
+    /** the identification of the parameter in the parameter map */
+    Natural parameterId;
+
+    /** the name of the parameter */
+    String parameterName;
+
+    /** the minimum difference of a host value to be applied */
+    Real delta;
+
+    /** the value before the test (which a snapshot may still
+     * show) */
+    Real initialValue;
+
+    /** the values set by the producers in string form */
+    StringList valueList;
+
+    /** the numeric forms of the strings in <valueList>, such that
+     * host and editor changes lead to identical values */
+    GenericList<Real> numericValueList;
+
+};
+
+/*--------------------*/
+
+/**
+ * A <_StressContext> is the data shared by the audio thread and the
+ * producer and consumer threads of the update stress test; the
+ * parameter changes are handed over like in the audio processor:
+ * host values via a slot exchange, editor values via the event
+ * queue and the applied changes are coalesced in a change set for
+ * the notification
+ */
+struct _StressContext {
+
+    /** the effect processed by the audio thread */
+    SoXAudioEffect* audioEffect;
+
+    /** the parameters varied by the producers */
+    GenericList<_StressParameter> parameterList;
+
+    /** the host values still to be applied, indexed by position in
+     * <parameterList> */
+    SoXParameterSlotExchange<Real> hostValueExchange;
+
+    /** the editor changes still to be applied */
+    SoXParameterEventQueue eventQueue{_stressEventQueueCapacity};
+
+    /** the event slot of the audio thread for the event queue */
+    SoXParameterEvent event;
+
+    /** the change kinds applied and not yet notified, indexed by
+     * parameter identification */
+    SoXParameterChangeSet changeSet;
+
+    /** the times of the latest host and editor changes (in
+     * nanoseconds since <startTime>), indexed by parameter
+     * identification */
+    std::unique_ptr<std::atomic<std::int64_t>[]> hostSetTimeArray;
+    std::unique_ptr<std::atomic<std::int64_t>[]> eventSetTimeArray;
+
+    /** the serialization of the editor threads like by the message
+     * thread of a plugin */
+    std::mutex messageThreadMutex;
+
+    /** the start of the test */
+    std::chrono::steady_clock::time_point startTime;
+
+    /** the number of changes per second of each producer thread
+     * (zero for unthrottled) */
+    Natural updateRate;
+
+    /** tells that the producers and consumers shall stop */
+    std::atomic<bool> isStopped;
+
+    /** the numbers of host values and editor events handed over
+     * and the events rejected by a full queue */
+    std::atomic<size_t> hostSetCount;
+    std::atomic<size_t> eventPushCount;
+    std::atomic<size_t> eventRejectCount;
+
+    /** the numbers of value snapshots, coalesced notifications and
+     * values neither set by a producer nor initial */
+    std::atomic<size_t> snapshotCount;
+    std::atomic<size_t> notificationCount;
+    std::atomic<size_t> tornValueCount;
+
+};
+
+/*--------------------*/
+
+/**
+ * Returns the nanoseconds elapsed since the start of the stress
+ * test in <context>
+ */
+std::int64_t _stressElapsedTime (IN _StressContext& context) {
+    const auto duration =
+        std::chrono::steady_clock::now() - context.startTime;
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration)
+               .count();
+}
+
+/*--------------------*/
+
+/**
+ * Waits until the producer in stress <context> started at
+ * <startTime> may do its next change after <updateCount> changes
+ */
+void _waitForStressUpdate (IN _StressContext& context,
+                           IN std::chrono::steady_clock::time_point
+                               startTime,
+                           IN Natural updateCount) {
+    if (context.updateRate > 0) {
+        const std::chrono::duration<double> offset{
+            (double) updateCount / (double) context.updateRate
+        };
+        const auto dueTime =
+            startTime
+            + std::chrono::duration_cast<std::chrono::nanoseconds>(offset);
+
+        if (std::chrono::steady_clock::now() < dueTime) {
+            std::this_thread::sleep_until(dueTime);
+        }
+    }
+}
+
+/*--------------------*/
+
+/**
+ * Tells whether <value> might have been set for <parameter> by
+ * the stress test or is its initial value
+ */
+Boolean _isValidStressValue (IN _StressParameter& parameter,
+                             IN Real value) {
+    return (value == parameter.initialValue
+            || parameter.numericValueList.contains(value));
+}
+
+/*--------------------*/
+
+/**
+ * Takes a snapshot of the parameter values of the effect in stress
+ * <context> into <numericValueList> and <valueIsKnownList> and
+ * counts the values of the varied parameters that are torn, that
+ * is, neither initial nor set by a producer
+ */
+void _checkStressSnapshot (INOUT _StressContext& context,
+                           INOUT GenericList<Real>& numericValueList,
+                           INOUT GenericList<Boolean>& valueIsKnownList) {
+    const SoXEffectParameterMap& parameterMap =
+        context.audioEffect->effectParameterMap();
+    parameterMap.readValueSnapshot(numericValueList, valueIsKnownList);
+    Natural tornValueCount = 0;
+
+    for (const _StressParameter& parameter : context.parameterList) {
+        const Natural id = parameter.parameterId;
+
+        if (!_isValidStressValue(parameter, numericValueList[id])) {
+            tornValueCount++;
+        }
+    }
+
+    context.snapshotCount++;
+    context.tornValueCount += (size_t) tornValueCount;
+}
+
+/*--------------------*/
+
+/**
+ * Sets random values of random varied parameters in stress
+ * <context> like a host automation on some thread until the test
+ * is stopped; the generator starts with <seed>
+ */
+void _runStressHostProducer (INOUT _StressContext& context,
+                             IN std::uint32_t seed) {
+    std::uint32_t randomState = seed;
+    const Natural parameterCount = context.parameterList.length();
+    const auto startTime = std::chrono::steady_clock::now();
+    Natural updateCount = 0;
+
+    while (!context.isStopped.load(std::memory_order_relaxed)) {
+        const Natural index =
+            (Natural) (_nextRandomValue(randomState)
+                       * Real{parameterCount});
+        const _StressParameter& parameter = context.parameterList[index];
+        const Natural valueIndex =
+            (Natural) (_nextRandomValue(randomState)
+                       * Real{parameter.numericValueList.length()});
+        context.hostSetTimeArray[(size_t) parameter.parameterId]
+            .store(_stressElapsedTime(context), std::memory_order_relaxed);
+        context.hostValueExchange.set(index,
+                                      parameter.numericValueList[valueIndex]);
+        updateCount++;
+        _waitForStressUpdate(context, startTime, updateCount);
+    }
+
+    context.hostSetCount += (size_t) updateCount;
+}
+
+/*--------------------*/
+
+/**
+ * Sets random values of random varied parameters in stress
+ * <context> like an editor (with the allocations in advance done
+ * under the message thread lock) and takes a value snapshot after
+ * each change like a state saving of the host until the test is
+ * stopped; the generator starts with <seed>
+ */
+void _runStressEditorProducer (INOUT _StressContext& context,
+                               IN std::uint32_t seed) {
+    std::uint32_t randomState = seed;
+    const Natural parameterCount = context.parameterList.length();
+    const auto startTime = std::chrono::steady_clock::now();
+    SoXParameterEvent event{};
+    GenericList<Real> numericValueList;
+    GenericList<Boolean> valueIsKnownList;
+    Natural updateCount = 0;
+    Natural rejectCount = 0;
+
+    while (!context.isStopped.load(std::memory_order_relaxed)) {
+        const Natural index =
+            (Natural) (_nextRandomValue(randomState)
+                       * Real{parameterCount});
+        const _StressParameter& parameter = context.parameterList[index];
+        const Natural valueIndex =
+            (Natural) (_nextRandomValue(randomState)
+                       * Real{parameter.valueList.length()});
+        event.timePosition          = -Real::infinity;
+        event.parameterName         = parameter.parameterName;
+        event.value                 = parameter.valueList[valueIndex];
+        event.recalculationIsForced = true;
+
+        {
+            std::lock_guard<std::mutex> lock{context.messageThreadMutex};
+            context.audioEffect->reserveForValue(event.parameterName,
+                                                 event.value);
+        }
+
+        context.eventSetTimeArray[(size_t) parameter.parameterId]
+            .store(_stressElapsedTime(context), std::memory_order_relaxed);
+
+        if (!context.eventQueue.push(event)) {
+            rejectCount++;
+        }
+
+        _checkStressSnapshot(context, numericValueList, valueIsKnownList);
+        updateCount++;
+        _waitForStressUpdate(context, startTime, updateCount);
+    }
+
+    context.eventPushCount += (size_t) updateCount;
+    context.eventRejectCount += (size_t) rejectCount;
+}
+
+/*--------------------*/
+
+/**
+ * Takes the coalesced changes in stress <context> and a value
+ * snapshot at the notification rate of the editor until the test
+ * is stopped
+ */
+void _runStressNotifier (INOUT _StressContext& context) {
+    const Natural parameterCount = context.changeSet.length();
+    const std::chrono::milliseconds period{
+        (std::int64_t) (size_t) (Natural{1000} / _stressNotificationRate)
+    };
+    GenericList<Real> numericValueList;
+    GenericList<Boolean> valueIsKnownList;
+    Natural notificationCount = 0;
+
+    while (!context.isStopped.load(std::memory_order_relaxed)) {
+        std::this_thread::sleep_for(period);
+
+        if (context.changeSet.takeChangeIndication()) {
+            for (Natural id = 0;  id < parameterCount;  id++) {
+                notificationCount +=
+                    (context.changeSet.take(id) != 0 ? 1 : 0);
+            }
+        }
+
+        _checkStressSnapshot(context, numericValueList, valueIsKnownList);
+    }
+
+    context.notificationCount += (size_t) notificationCount;
+}
+
+/*--------------------*/
+
+/**
+ * Appends the time in <setTime> to <timeList> at position <count>
+ * (which is updated) as long as there is room; the editor threads
+ * may refill the event queue while it is emptied, hence a block
+ * might apply more changes than the list holds
+ */
+void _appendStressTime (INOUT GenericList<Real>& timeList,
+                        INOUT Natural& count,
+                        IN std::atomic<std::int64_t>& setTime) {
+    if (count < timeList.length()) {
+        timeList[count++] =
+            Real{(double) setTime.load(std::memory_order_relaxed)};
+    }
+}
+
+/*--------------------*/
+
+/**
+ * Applies the pending host values and editor events in stress
+ * <context> to its effect like the audio processor at block start
+ * and appends the times of the applied changes to
+ * <pendingTimeList> (from position <pendingCount> on, which is
+ * updated, see <_appendStressTime>); returns the number of applied
+ * changes
+ */
+Natural _applyStressChanges (INOUT _StressContext& context,
+                             INOUT GenericList<Real>& pendingTimeList,
+                             INOUT Natural& pendingCount) {
+    SoXAudioEffect* audioEffect = context.audioEffect;
+    const SoXEffectParameterMap& parameterMap =
+        audioEffect->effectParameterMap();
+    SoXParameterSlotExchange<Real>& hostValueExchange =
+        context.hostValueExchange;
+    SoXParameterEvent& event = context.event;
+    Natural appliedCount = 0;
+
+    if (hostValueExchange.takeChangeIndication()) {
+        const Natural parameterCount = hostValueExchange.length();
+        Real value;
+
+        for (Natural index = 0;  index < parameterCount;  index++) {
+            if (hostValueExchange.tryTake(index, value)) {
+                const _StressParameter& parameter =
+                    context.parameterList[index];
+                const Natural id = parameter.parameterId;
+
+                if (!_isValidStressValue(parameter, value)) {
+                    context.tornValueCount++;
+                } else if (Real::abs(value - parameterMap.numericValue(id))
+                           >= parameter.delta) {
+                    const SoXParameterValueChangeKind changeKind =
+                        audioEffect->setNumericValue(id, value, false);
+                    context.changeSet.mark(id, changeKind);
+                    _appendStressTime(pendingTimeList, pendingCount,
+                                      context.hostSetTimeArray[(size_t) id]);
+                    appliedCount++;
+                }
+            }
+        }
+    }
+
+    while (context.eventQueue.tryPop(Real::infinity, event)) {
+        const String& parameterName = event.parameterName;
+
+        if (parameterMap.valueIsDifferent(parameterName, event.value)) {
+            const Natural id = parameterMap.parameterId(parameterName);
+            const SoXParameterValueChangeKind changeKind =
+                audioEffect->setValue(parameterName, event.value,
+                                      event.recalculationIsForced);
+            context.changeSet.mark(id, changeKind);
+            _appendStressTime(pendingTimeList, pendingCount,
+                              context.eventSetTimeArray[(size_t) id]);
+            appliedCount++;
+        }
+    }
+
+    return appliedCount;
+}
+
+/*--------------------*/
+
+/**
+ * Lets the audio thread of stress <context> process <blockCount>
+ * blocks of <buffer> from <sourceBuffer> at <sampleRate> paced in
+ * real time (starting at <timePosition> and <sourcePosition>, which
+ * are updated): each block first applies the pending parameter
+ * changes; the processing time of each block (including the
+ * application) is stored in <blockTimeList> and the time from a
+ * change until the end of the block it became audible in is
+ * appended to <latencyList> at position <latencyCount> as long as
+ * there is room (both in seconds); all lists are preallocated, such
+ * that the audio thread does not allocate for them; returns the
+ * number of applied changes
+ */
+Natural _processStressBlocks (INOUT _StressContext& context,
+                              IN AudioSampleListVector& sourceBuffer,
+                              INOUT AudioSampleListVector& buffer,
+                              IN Natural sampleRate,
+                              IN Natural blockCount,
+                              INOUT Real& timePosition,
+                              INOUT Natural& sourcePosition,
+                              OUT GenericList<Real>& blockTimeList,
+                              INOUT GenericList<Real>& latencyList,
+                              INOUT Natural& latencyCount,
+                              INOUT GenericList<Real>& pendingTimeList) {
+    const Natural blockSize = buffer.frameCount();
+    const Natural sourceLength = sourceBuffer.frameCount();
+    const std::chrono::duration<double> blockDuration{
+        (double) blockSize / (double) sampleRate
+    };
+    const auto startTime = std::chrono::steady_clock::now();
+    Natural appliedCount = 0;
+
+    for (Natural block = 0;  block < blockCount;  block++) {
+        for (Natural channel = 0;  channel < buffer.length();  channel++) {
+            const AudioSampleList& sourceList = sourceBuffer[channel];
+            AudioSampleList& list = buffer[channel];
+            Natural j = sourcePosition;
+
+            for (Natural i = 0;  i < blockSize;  i++) {
+                list[i] = sourceList[j];
+                j = (j + 1 < sourceLength ? j + 1 : Natural{0});
+            }
+        }
+
+        sourcePosition = (sourcePosition + blockSize) % sourceLength;
+
+        /* like a host callback the block starts at its deadline */
+        std::this_thread::sleep_until(
+            startTime
+            + std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  blockDuration * (double) block));
+
+        const auto blockStartTime = std::chrono::steady_clock::now();
+        Natural pendingCount = 0;
+        appliedCount +=
+            _applyStressChanges(context, pendingTimeList, pendingCount);
+
+        {
+            const SoXRealtimeGuard guard{"SoX-Test.processBlock"};
+            context.audioEffect->processBlock(timePosition, buffer);
+        }
+
+        const std::chrono::duration<double> blockTime =
+            std::chrono::steady_clock::now() - blockStartTime;
+        const Real blockEndTime =
+            Real{(double) _stressElapsedTime(context)};
+        blockTimeList[block] = Real{blockTime.count()};
+        timePosition += Real{blockDuration.count()};
+
+        for (Natural i = 0;  i < pendingCount;  i++) {
+            if (latencyCount < latencyList.length()) {
+                latencyList[latencyCount++] =
+                    (blockEndTime - pendingTimeList[i]) * 1.0E-9;
+            }
+        }
+    }
+
+    return appliedCount;
+}
+
+/*--------------------*/
+
+/**
+ * Returns the median, the 99th percentile and the maximum of the
+ * first <count> values of <valueList> in <median>, <percentile99>
+ * and <maximum> (all zero for no values)
+ */
+void _distributionStatistics (IN GenericList<Real>& valueList,
+                              IN Natural count,
+                              OUT Real& median,
+                              OUT Real& percentile99,
+                              OUT Real& maximum) {
+    GenericList<Real> sortedList = valueList;
+    sortedList.setLength(count);
+    sortedList.sort(_compareReals);
+    median       = 0.0;
+    percentile99 = 0.0;
+    maximum      = 0.0;
+
+    if (count > 0) {
+        median       = sortedList[count / 2];
+        percentile99 = sortedList[count * 99 / 100];
+        maximum      = sortedList[count - 1];
+    }
+}
+
+/*--------------------*/
+
+/**
+ * Collects the real and integer parameters of <audioEffect> except
+ * for the page selectors and the raw biquad coefficients (which
+ * give unstable filters) into <parameterList> each with
+ * <_stressValueCount> values evenly spread over its range and
+ * quantized to its step
+ */
+void _collectStressParameters (IN SoXAudioEffect* audioEffect,
+                               OUT GenericList<_StressParameter>&
+                                   parameterList) {
+    const SoXEffectParameterMap& parameterMap =
+        audioEffect->effectParameterMap();
+    const StringList coefficientNameList =
+        StringList::makeBySplit("a0,a1,a2,b0,b1,b2", ",");
+    parameterList.clear();
+
+    for (const String& parameterName : parameterMap.parameterNameList()) {
+        String effectiveParameterName;
+        Natural pageIndex;
+        SoXEffectParameterMap::splitParameterName(parameterName,
+                                                  effectiveParameterName,
+                                                  pageIndex);
+        const SoXEffectParameterKind kind = parameterMap.kind(parameterName);
+        const Boolean isVaried =
+            (!SoXEffectParameterMap::isPageSelector(parameterName)
+             && !coefficientNameList.contains(effectiveParameterName)
+             && (kind == SoXEffectParameterKind::realKind
+                 || kind == SoXEffectParameterKind::intKind));
+
+        if (isVaried) {
+            _StressParameter parameter;
+            parameter.parameterId = parameterMap.parameterId(parameterName);
+            parameter.parameterName = parameterName;
+            parameter.initialValue =
+                parameterMap.numericValue(parameter.parameterId);
+            Real lowValue;
+            Real highValue;
+
+            if (kind == SoXEffectParameterKind::realKind) {
+                parameterMap.valueRangeReal(parameterName, lowValue,
+                                            highValue, parameter.delta);
+            } else {
+                Integer lowInteger;
+                Integer highInteger;
+                Integer deltaInteger;
+                parameterMap.valueRangeInt(parameterName, lowInteger,
+                                           highInteger, deltaInteger);
+                lowValue = Real{lowInteger};
+                highValue = Real{highInteger};
+                parameter.delta = Real{deltaInteger};
+            }
+
+            for (Natural i = 0;  i < _stressValueCount;  i++) {
+                const Real fraction =
+                    Real{i} / Real{_stressValueCount - 1};
+                Real value = lowValue + fraction * (highValue - lowValue);
+
+                if (parameter.delta > 0.0) {
+                    value = (lowValue
+                             + parameter.delta
+                               * Real::round((value - lowValue)
+                                             / parameter.delta));
+                }
+
+                const String valueString =
+                    parameterMap.valueFromNumericValue(parameter.parameterId,
+                                                       value);
+                parameter.valueList.append(valueString);
+                parameter.numericValueList.append(STR::toReal(valueString));
+            }
+
+            parameterList.append(parameter);
+        }
+    }
+}
+
+/*--------------------*/
+
+/**
+ * Runs the parameter update stress test for the last variant of
+ * each effect in blocks of <blockSize> samples: the audio thread
+ * processes <secondCount> seconds paced in real time without
+ * parameter changes and then another <secondCount> seconds while
+ * <hostThreadCount> threads set host values and <editorThreadCount>
+ * threads send editor changes and take value snapshots (each with
+ * <updateRate> changes per second, zero for unthrottled) and a
+ * notifier takes the coalesced changes at the editor rate; the
+ * changes are handed over like in the audio processor.  One line
+ * per effect is written to standard output as comma separated
+ * values with the median, 99th percentile and maximum block time
+ * (in microseconds) without and with changes, the blocks exceeding
+ * their real time with changes, the counts of changes handed over,
+ * rejected by a full queue, applied and notified, the count of
+ * snapshots and of torn values (neither initial nor set by a
+ * producer, found in snapshots or in the host handoff), the
+ * median, 99th percentile and maximum latency from a change until
+ * the end of the block it becomes audible in (in milliseconds) and
+ * the allocations or locks within the block processing; returns
+ * the number of effects with torn values or such violations
+ */
+Natural _runUpdateStressTest (IN Natural secondCount,
+                              IN Natural hostThreadCount,
+                              IN Natural editorThreadCount,
+                              IN Natural updateRate,
+                              IN Natural blockSize) {
+    Logging_trace5(">>: seconds = %1, hostThreads = %2,"
+                   " editorThreads = %3, rate = %4, blockSize = %5",
+                   TOSTRING(secondCount), TOSTRING(hostThreadCount),
+                   TOSTRING(editorThreadCount), TOSTRING(updateRate),
+                   TOSTRING(blockSize));
+
+    /* the same floating point mode as in the audio processor */
+    const DenormalGuard denormalGuard{};
+    const StringList caseList = _effectCaseList();
+    const Natural sampleRate = 44100;
+    const Boolean isActive = SoXRealtimeGuard::isActive();
+    const Natural blockCount =
+        Natural::maximum(secondCount * sampleRate / blockSize, 1);
+    const Real blockDuration = Real{blockSize} / Real{sampleRate};
+    AudioSampleListVector sourceBuffer{};
+    _fillRegressionBuffer(sourceBuffer, sampleRate);
+    Natural failureCount = 0;
+
+    cout << ("effect,variant,parameterCount,"
+             "quietMedianUs,quietP99Us,quietMaximumUs,"
+             "stressMedianUs,stressP99Us,stressMaximumUs,overrunCount,"
+             "hostSetCount,eventPushCount,eventRejectCount,appliedCount,"
+             "notificationCount,snapshotCount,tornValueCount,"
+             "latencyMedianMs,latencyP99Ms,latencyMaximumMs,"
+             "violationCount,status\n");
+
+    for (Natural i = 0;  i < caseList.length();  i += 2) {
+        const String& effectName = caseList[i];
+        const String& variant = caseList[i + 1];
+        const Boolean isLastVariant =
+            (i + 2 >= caseList.length() || caseList[i + 2] != effectName);
+
+        if (isLastVariant) {
+            Natural testLengthInSeconds;
+            _StressContext context;
+            context.audioEffect =
+                _makeNewEffect(effectName, testLengthInSeconds);
+            _initializeBenchmarkVariant(effectName, variant,
+                                        context.audioEffect);
+            context.audioEffect->prepareToPlay(Real{sampleRate});
+            _collectStressParameters(context.audioEffect,
+                                     context.parameterList);
+
+            const Natural mapParameterCount =
+                context.audioEffect->effectParameterMap()
+                    .parameterNameList().length();
+            const Natural parameterCount = context.parameterList.length();
+            context.hostValueExchange.setLength(parameterCount);
+            context.changeSet.setLength(mapParameterCount);
+            context.hostSetTimeArray.reset(
+                new std::atomic<std::int64_t>[(size_t) mapParameterCount]);
+            context.eventSetTimeArray.reset(
+                new std::atomic<std::int64_t>[(size_t) mapParameterCount]);
+
+            for (Natural id = 0;  id < mapParameterCount;  id++) {
+                context.hostSetTimeArray[(size_t) id] = 0;
+                context.eventSetTimeArray[(size_t) id] = 0;
+            }
+
+            context.startTime         = std::chrono::steady_clock::now();
+            context.updateRate        = updateRate;
+            context.isStopped         = false;
+            context.hostSetCount      = 0;
+            context.eventPushCount    = 0;
+            context.eventRejectCount  = 0;
+            context.snapshotCount     = 0;
+            context.notificationCount = 0;
+            context.tornValueCount    = 0;
+
+            AudioSampleListVector buffer{};
+            buffer.setLength(_channelCount);
+            buffer.setFrameCount(blockSize);
+            GenericList<Real> quietTimeList;
+            quietTimeList.setLength(blockCount);
+            GenericList<Real> stressTimeList;
+            stressTimeList.setLength(blockCount);
+            GenericList<Real> latencyList;
+            latencyList.setLength(_stressLatencyCapacity);
+            GenericList<Real> pendingTimeList;
+            pendingTimeList.setLength(parameterCount
+                                      + _stressEventQueueCapacity);
+            Natural latencyCount = 0;
+            Real timePosition = 0.0;
+            Natural sourcePosition = 0;
+
+            /* the same blocks without any parameter change as a
+               reference */
+            _processStressBlocks(context, sourceBuffer, buffer, sampleRate,
+                                 blockCount, timePosition, sourcePosition,
+                                 quietTimeList, latencyList, latencyCount,
+                                 pendingTimeList);
+
+            SoXRealtimeGuard::resetViolationCount();
+            std::thread notifierThread{_runStressNotifier,
+                                       std::ref(context)};
+            std::thread* producerThreadArray =
+                new std::thread[(size_t) (hostThreadCount
+                                          + editorThreadCount)];
+
+            for (Natural j = 0;  j < hostThreadCount + editorThreadCount;
+                 j++) {
+                const std::uint32_t seed = (std::uint32_t) (size_t) (j + 1);
+                producerThreadArray[(size_t) j] =
+                    (j < hostThreadCount
+                     ? std::thread{_runStressHostProducer,
+                                   std::ref(context), seed}
+                     : std::thread{_runStressEditorProducer,
+                                   std::ref(context), seed});
+            }
+
+            const Natural appliedCount =
+                _processStressBlocks(context, sourceBuffer, buffer,
+                                     sampleRate, blockCount, timePosition,
+                                     sourcePosition, stressTimeList,
+                                     latencyList, latencyCount,
+                                     pendingTimeList);
+            const Natural violationCount =
+                SoXRealtimeGuard::violationCount();
+            context.isStopped = true;
+
+            for (Natural j = 0;  j < hostThreadCount + editorThreadCount;
+                 j++) {
+                producerThreadArray[(size_t) j].join();
+            }
+
+            notifierThread.join();
+            delete[] producerThreadArray;
+
+            Natural overrunCount = 0;
+
+            for (const Real& blockTime : stressTimeList) {
+                overrunCount += (blockTime > blockDuration ? 1 : 0);
+            }
+
+            Real quietMedian, quietPercentile99, quietMaximum;
+            _distributionStatistics(quietTimeList, blockCount,
+                                    quietMedian, quietPercentile99,
+                                    quietMaximum);
+            Real stressMedian, stressPercentile99, stressMaximum;
+            _distributionStatistics(stressTimeList, blockCount,
+                                    stressMedian, stressPercentile99,
+                                    stressMaximum);
+            Real latencyMedian, latencyPercentile99, latencyMaximum;
+            _distributionStatistics(latencyList, latencyCount,
+                                    latencyMedian, latencyPercentile99,
+                                    latencyMaximum);
+
+            const Natural hostSetCount{context.hostSetCount.load()};
+            const Natural eventPushCount{context.eventPushCount.load()};
+            const Natural eventRejectCount{context.eventRejectCount.load()};
+            const Natural notificationCount{
+                context.notificationCount.load()
+            };
+            const Natural snapshotCount{context.snapshotCount.load()};
+            const Natural tornValueCount{context.tornValueCount.load()};
+            const Boolean isFailed =
+                (tornValueCount > 0 || violationCount > 0);
+            failureCount += (isFailed ? 1 : 0);
+            const Real us = 1.0E6;
+            const Real ms = 1.0E3;
+            const String line =
+                STR::expand("%1,%2,%3,%4,%5,%6,%7,%8,%9,%A,",
+                            effectName, variant, TOSTRING(parameterCount),
+                            TOSTRING(quietMedian * us),
+                            TOSTRING(quietPercentile99 * us),
+                            TOSTRING(quietMaximum * us),
+                            TOSTRING(stressMedian * us),
+                            TOSTRING(stressPercentile99 * us),
+                            TOSTRING(stressMaximum * us),
+                            TOSTRING(overrunCount))
+                + STR::expand("%1,%2,%3,%4,%5,%6,%7,",
+                              TOSTRING(hostSetCount),
+                              TOSTRING(eventPushCount),
+                              TOSTRING(eventRejectCount),
+                              TOSTRING(appliedCount),
+                              TOSTRING(notificationCount),
+                              TOSTRING(snapshotCount),
+                              TOSTRING(tornValueCount))
+                + STR::expand("%1,%2,%3,%4,%5",
+                              TOSTRING(latencyMedian * ms),
+                              TOSTRING(latencyPercentile99 * ms),
+                              TOSTRING(latencyMaximum * ms),
+                              TOSTRING(violationCount),
+                              (isFailed ? "FAILED"
+                               : !isActive ? "OK (no realtime check)"
+                               : "OK"));
+            delete context.audioEffect;
+
+            Logging_trace1("--: %1", line);
+            cout << line << "\n" << std::flush;
+        }
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(failureCount));
+    return failureCount;
+}
+
+/*--------------------*/
+
+/**
+ * Returns the list of naturals given as comma separated string
+ * <st>; returns <defaultList> when <st> is empty or contains no
+ * positive number
+ */
+NaturalList _toNaturalList (IN String& st,
+                            IN NaturalList& defaultList) {
+    NaturalList result;
+
+    if (st != "") {
+        const StringList partList = StringList::makeBySplit(st, ",");
+
+        for (const String& part : partList) {
+            const Natural value = STR::toNatural(STR::strip(part), 0);
+
+            if (value > 0) {
+                result.append(value);
+            }
+        }
+    }
+
+    return (result.length() == 0 ? defaultList : result);
+}
+
+/*--------------------*/
+/*--------------------*/
+
+int main (int argc, char* argv[]) {
+    Logging_initialize();
+    String temporaryDirectoryPath =
+        OperatingSystem::temporaryDirectoryPath();
+    Logging_setFileName(temporaryDirectoryPath + "/SoXTest.log", false);
+    Logging_setIgnoredFunctionNamePrefix("SoXPlugins.");
+    Logging_setTracingWithTime(true, 2);
+    Logging_trace(">>");
+    _outputFile.open(temporaryDirectoryPath + "/SoXTest.txt");
+
+    const Integer sampleRate = 44100;
+    String effectName;
+    AudioSampleListVector waveFormBuffer{};
+    const Character effectCharacter = (argc < 2 ? ' ' : argv[1][0]);
+
+    if (effectCharacter  == 'C') {
+        effectName = _effectName_compander;
+    } else if (effectCharacter == 'F') {
+        effectName = _effectName_filter;
+    } else if (effectCharacter == 'T') {
+        effectName = _effectName_tremolo;
+    } else if (effectCharacter == 'D') {
+        effectName = "DECAY BENCHMARK";
+    } else if (effectCharacter == 'B') {
+        effectName = "THROUGHPUT BENCHMARK";
+    } else if (effectCharacter == 'L') {
+        effectName = "SMALL BLOCK BENCHMARK";
+    } else if (effectCharacter == 'S') {
+        effectName = "STRING CONVERSION BENCHMARK";
+    } else if (effectCharacter == 'G' || effectCharacter == 'V') {
+        effectName = "REGRESSION CHECK";
+    } else if (effectCharacter == 'R') {
+        effectName = "REALTIME CHECK";
+    } else if (effectCharacter == 'M') {
+        effectName = "SESSION BENCHMARK";
+    } else if (effectCharacter == 'A') {
+        effectName = "AUTOMATION REPLAY";
+    } else if (effectCharacter == 'W') {
+        effectName = "WORST CASE SEARCH";
+    } else if (effectCharacter == 'P') {
+        effectName = "BASELINE COMPARISON";
+    } else if (effectCharacter == 'K') {
+        effectName = "KERNEL TUNING";
+    } else if (effectCharacter == 'X') {
+        effectName = "CONFORMANCE CHECK";
+    } else if (effectCharacter == 'Q') {
+        effectName = "PRECISION PROFILE CHECK";
+    } else if (effectCharacter == 'U') {
+        effectName = "UPDATE STRESS TEST";
+    } else {
+        effectName = _effectName_reverb;
+    }
+
+    Logging_trace1("--: effectName = %1", effectName);
+    _fillBuffer(waveFormBuffer, sampleRate);
+    int exitCode = 0;
+
+    if (effectCharacter == 'D') {
+        _runDecayBenchmark(waveFormBuffer, sampleRate);
+    } else if (effectCharacter == 'B' || effectCharacter == 'L') {
+        /* optional arguments: comma separated lists of block
+           sizes, sample rates and channel counts, the seconds per
+           run, the number of runs and "1" for hardware performance
+           counters; the small block variant defaults to the block
+           sizes of hosts with a low latency, where the overhead per
+           block call dominates */
+        const NaturalList defaultBlockSizeList =
+            (effectCharacter == 'L'
+             ? NaturalList::fromList({1, 8, 16, 32})
+             : NaturalList::fromList({64, 256, 1024}));
+        const NaturalList blockSizeList =
+            _toNaturalList(argc < 3 ? "" : argv[2], defaultBlockSizeList);
+        const NaturalList sampleRateList =
+            _toNaturalList(argc < 4 ? "" : argv[3],
+                           NaturalList::fromList({44100, 96000}));
+        const NaturalList channelCountList =
+            _toNaturalList(argc < 5 ? "" : argv[4],
+                           NaturalList::fromList({2}));
+        const Natural secondCount =
+            (argc < 6 ? Natural{5} : STR::toNatural(argv[5], 5));
+        const Natural repetitionCount =
+            (argc < 7 ? Natural{5} : STR::toNatural(argv[6], 5));
+        const Boolean countersAreUsed =
+            (argc >= 8 && String{argv[7]} == "1");
+        _runThroughputBenchmark(blockSizeList, sampleRateList,
+                                channelCountList, secondCount,
+                                repetitionCount, countersAreUsed);
+    } else if (effectCharacter == 'M') {
+        /* optional arguments: comma separated lists of instance
+           counts, block sizes and thread counts and the seconds per
+           run */
+        const NaturalList instanceCountList =
+            _toNaturalList(argc < 3 ? "" : argv[2],
+                           NaturalList::fromList({25, 100, 200, 400}));
+        const NaturalList blockSizeList =
+            _toNaturalList(argc < 4 ? "" : argv[3],
+                           NaturalList::fromList({32, 128, 512, 1024}));
+        const NaturalList threadCountList =
+            _toNaturalList(argc < 5 ? "" : argv[4],
+                           NaturalList::fromList({1, 4}));
+        const Natural secondCount =
+            (argc < 6 ? Natural{5} : STR::toNatural(argv[5], 5));
+        _runSessionBenchmark(instanceCountList, blockSizeList,
+                             threadCountList, secondCount);
+    } else if (effectCharacter == 'S') {
+        /* optional argument: the number of runs */
+        const Natural repetitionCount =
+            (argc < 3 ? Natural{1000} : STR::toNatural(argv[2], 1000));
+        _runStringConversionBenchmark(repetitionCount);
+    } else if (effectCharacter == 'G' || effectCharacter == 'V') {
+        /* 'G' records the golden renders, 'V' verifies against
+           them; optional arguments: the directory of the renders,
+           the maximum absolute error and the maximum RMS error in
+           dB */
+        const String directoryPath =
+            (argc < 3 ? temporaryDirectoryPath + "/SoXGolden"
+             : String{argv[2]});
+        const Real maximumAbsoluteError =
+            (argc < 4 ? Real{1.0E-6} : STR::toReal(argv[3], 1.0E-6));
+        const Real maximumRmsErrorInDb =
+            (argc < 5 ? Real{-120.0} : STR::toReal(argv[4], -120.0));
+        const Natural failureCount =
+            _runRegression(directoryPath, effectCharacter == 'G',
+                           maximumAbsoluteError, maximumRmsErrorInDb);
+        exitCode = (failureCount > 0 ? 1 : 0);
+    } else if (effectCharacter == 'A') {
+        /* arguments: the trace file and optionally the effect kind
+           (like "COMPANDER", default: the traced effect) and the
+           number of runs */
+        const String fileName = (argc < 3 ? "" : String{argv[2]});
+        const String audioEffectKind =
+            (argc < 4 ? "" : String{argv[3]});
+        const Natural repetitionCount =
+            (argc < 5 ? Natural{3} : STR::toNatural(argv[4], 3));
+        const Natural failureCount =
+            _runAutomationReplay(fileName, audioEffectKind,
+                                 repetitionCount);
+        exitCode = (failureCount > 0 ? 1 : 0);
+    } else if (effectCharacter == 'W') {
+        /* optional arguments: the number of random configurations
+           per effect, the number of slowest configurations reported,
+           the seconds per run and the seed of the random generator */
+        const Natural trialCount =
+            (argc < 3 ? Natural{50} : STR::toNatural(argv[2], 50));
+        const Natural reportCount =
+            (argc < 4 ? Natural{5} : STR::toNatural(argv[3], 5));
+        const Natural secondCount =
+            (argc < 5 ? Natural{1} : STR::toNatural(argv[4], 1));
+        const Natural seed =
+            (argc < 6 ? Natural{1} : STR::toNatural(argv[5], 1));
+        _runWorstCaseSearch(trialCount, reportCount, secondCount, seed);
+    } else if (effectCharacter == 'P') {
+        /* arguments: the result file of a previous throughput
+           benchmark and optionally the allowed slowdown in percent,
+           the seconds per run and the number of runs */
+        const String fileName = (argc < 3 ? "" : String{argv[2]});
+        const Real thresholdPercent =
+            (argc < 4 ? Real{5.0} : STR::toReal(argv[3], 5.0));
+        const Natural secondCount =
+            (argc < 5 ? Natural{5} : STR::toNatural(argv[4], 5));
+        const Natural repetitionCount =
+            (argc < 6 ? Natural{7} : STR::toNatural(argv[5], 7));
+        const Natural regressionCount =
+            _runBaselineComparison(fileName, thresholdPercent,
+                                   secondCount, repetitionCount);
+        exitCode = (regressionCount > 0 ? 1 : 0);
+    } else if (effectCharacter == 'K') {
+        /* optional arguments: the configuration file (default: the
+           one of this machine) and the number of runs per compander
+           block length */
+        const String fileName =
+            (argc < 3 ? SoXKernelTuning::defaultFileName()
+             : String{argv[2]});
+        const Natural repetitionCount =
+            (argc < 4 ? Natural{5} : STR::toNatural(argv[3], 5));
+        const Natural failureCount =
+            _runKernelTuning(fileName, repetitionCount);
+        exitCode = (failureCount > 0 ? 1 : 0);
+    } else if (effectCharacter == 'X') {
+        /* optional arguments: the directory of test signals and SoX
+           references (made by "makeTestFiles.sh --wav" there), the
+           number of threads (default: all hardware threads), the
+           maximum absolute error and the maximum RMS error in dB */
+        const String directoryPath =
+            (argc < 3 ? temporaryDirectoryPath + "/SoXConformance"
+             : String{argv[2]});
+        const Natural threadCount =
+            (argc < 4 ? Natural{0} : STR::toNatural(argv[3], 0));
+        const Real maximumAbsoluteError =
+            (argc < 5 ? Real{1.0E-2} : STR::toReal(argv[4], 1.0E-2));
+        const Real maximumRmsErrorInDb =
+            (argc < 6 ? Real{-60.0} : STR::toReal(argv[5], -60.0));
+        const Natural failureCount =
+            _runConformanceCheck(directoryPath, threadCount,
+                                 maximumAbsoluteError,
+                                 maximumRmsErrorInDb);
+        exitCode = (failureCount > 0 ? 1 : 0);
+    } else if (effectCharacter == 'Q') {
+        /* fails when some profile deviates from the SoX-exact
+           rendering by more than its tolerances */
+        const Natural failureCount = _runPrecisionProfileCheck();
+        exitCode = (failureCount > 0 ? 1 : 0);
+    } else if (effectCharacter == 'U') {
+        /* optional arguments: the seconds per phase, the numbers of
+           host and editor threads, the changes per second of each
+           thread (zero for unthrottled) and the block size; fails
+           when some value is torn or an effect allocates or locks
+           while processing */
+        const Natural secondCount =
+            (argc < 3 ? Natural{2} : STR::toNatural(argv[2], 2));
+        const Natural hostThreadCount =
+            (argc < 4 ? Natural{2} : STR::toNatural(argv[3], 2));
+        const Natural editorThreadCount =
+            (argc < 5 ? Natural{2} : STR::toNatural(argv[4], 2));
+        const Natural updateRate =
+            (argc < 6 ? Natural{10000} : STR::toNatural(argv[5], 10000));
+        const Natural blockSize =
+            (argc < 7 ? Natural{256} : STR::toNatural(argv[6], 256));
+        const Natural failureCount =
+            _runUpdateStressTest(secondCount, hostThreadCount,
+                                 editorThreadCount, updateRate,
+                                 Natural::maximum(blockSize, 1));
+        exitCode = (failureCount > 0 ? 1 : 0);
+    } else if (effectCharacter == 'R') {
+        /* fails when any effect allocates or locks while
+           processing (only in builds with the check compiled in) */
+        const Natural failureCount = _runRealtimeCheck();
+        exitCode = (failureCount > 0 ? 1 : 0);
+    } else {
+        _runForEffect(effectName, waveFormBuffer, sampleRate);
     }
 
-    Logging_trace1("--: effectName = %1", effectName);
-    _fillBuffer(waveFormBuffer, sampleRate);
-    _runForEffect(effectName, waveFormBuffer, sampleRate);
     _outputFile.close();
 
     Logging_trace("<<");
     Logging_finalize();
-    return 0;
+    return exitCode;
 }
@@ -12,29 +12,83 @@
 /*=========*/
 
 #include "SoXAudioEffect.h"
+
+#include <mutex>
+#include "GenericSet.h"
+#include "Kernels.h"
 #include "Logging.h"
+#include "MyArray.h"
 
 /*--------------------*/
 
+using Audio::Kernels;
+using BaseTypes::Containers::clearArray;
+using BaseTypes::Containers::copyArray;
+using BaseTypes::GenericTypes::GenericSet;
 using SoXPlugins::Effects::SoXAudioEffect;
 
 /*====================*/
 
+/** a set of effect pointers */
+typedef GenericSet<SoXAudioEffect*> _SoXAudioEffectPtrSet;
+
+/*--------------------*/
+
+/**
+ * Returns the mutex protecting the effect registry and the
+ * published footprints; it is never locked on the audio thread.
+ *
+ * @return  reference to registry mutex
+ */
+static std::mutex& _registryMutex ()
+{
+    static std::mutex mutex{};
+    return mutex;
+}
+
+/*--------------------*/
+
+/**
+ * Returns the set of all registered effects.
+ *
+ * @return  reference to process-wide effect set
+ */
+static _SoXAudioEffectPtrSet& _registry ()
+{
+    static _SoXAudioEffectPtrSet registry{};
+    return registry;
+}
+
+/*====================*/
+
 /*--------------------*/
 /* setup              */
 /*--------------------*/
 
 SoXAudioEffect::SoXAudioEffect ()
      : _sampleRate{100.0},
+       _sampleDuration{1.0 / 100.0},
        _channelCount{0},
+       _sidechain{},
        _effectParameterMap{},
        _effectDescriptor{},
        _currentTimePosition{Real::infinity},
        _expectedNextTimePosition{Real::infinity},
        _timePositionHasMoved{true},
-       _parametersAreValid{false}
+       _timePositionIsNeeded{true},
+       _parametersAreValid{false},
+       _parameterBatchIsActive{false},
+       _parameterBatchHasChanges{false},
+       _publishedMemoryFootprint{},
+       _nonFiniteResetCount{0}
 {
     Logging_trace(">>");
+
+    {
+        std::lock_guard<std::mutex> guard{_registryMutex()};
+        _registry().add(this);
+    }
+
     Logging_trace("<<");
 }
 
@@ -43,6 +97,12 @@ SoXAudioEffect::SoXAudioEffect ()
 SoXAudioEffect::~SoXAudioEffect ()
 {
     Logging_trace1(">>: %1", toString());
+
+    {
+        std::lock_guard<std::mutex> guard{_registryMutex()};
+        _registry().remove(this);
+    }
+
     Logging_trace("<<");
 }
 
@@ -73,6 +133,8 @@ String SoXAudioEffect::_asRawString () const
     st += (", _timePositionHasMoved = "
            + TOSTRING(_timePositionHasMoved));
     st += ", _parametersAreValid = " + TOSTRING(_parametersAreValid);
+    st += (", _parameterBatchIsActive = "
+           + TOSTRING(_parameterBatchIsActive));
     st += ", _effectParameterMap = " + _effectParameterMap.toString();
     st += ", _effectDescriptor = " + _effectDescriptorToString();
 
@@ -95,6 +157,320 @@ String SoXAudioEffect::name () const
     return "???";
 }
 
+/*--------------------*/
+
+Real SoXAudioEffect::tailLength () const
+{
+    return 0.0;
+}
+
+/*--------------------*/
+
+Natural SoXAudioEffect::latency () const
+{
+    return 0;
+}
+
+/*--------------------*/
+
+Real SoXAudioEffect::warmupLength () const
+{
+    return tailLength() + Real{latency()} / _sampleRate;
+}
+
+/*--------------------*/
+
+Boolean SoXAudioEffect::hasConstantGain (OUT Real& gain) const
+{
+    gain = 1.0;
+    return false;
+}
+
+/*--------------------*/
+/* memory footprint   */
+/*--------------------*/
+
+SoXMemoryFootprint SoXAudioEffect::memoryFootprint () const
+{
+    SoXMemoryFootprint result{};
+    result.parameterMapByteCount = _effectParameterMap.byteCount();
+    return result;
+}
+
+/*--------------------*/
+
+SoXMemoryFootprint SoXAudioEffect::publishMemoryFootprint ()
+{
+    Logging_trace(">>");
+
+    const SoXMemoryFootprint result = memoryFootprint();
+
+    {
+        std::lock_guard<std::mutex> guard{_registryMutex()};
+        _publishedMemoryFootprint = result;
+    }
+
+    Logging_trace1("<<: %1", result.toString());
+    return result;
+}
+
+/*--------------------*/
+
+SoXMemoryFootprint
+SoXAudioEffect::totalMemoryFootprint (OUT Natural& effectCount)
+{
+    Logging_trace(">>");
+
+    SoXMemoryFootprint result{};
+
+    {
+        std::lock_guard<std::mutex> guard{_registryMutex()};
+        effectCount = _registry().size();
+
+        for (const SoXAudioEffect* effect : _registry()) {
+            result += effect->_publishedMemoryFootprint;
+        }
+    }
+
+    Logging_trace2("<<: effectCount = %1, result = %2",
+                   TOSTRING(effectCount), result.toString());
+    return result;
+}
+
+/*--------------------*/
+
+void SoXAudioEffect::_markAsNested (INOUT SoXAudioEffect* effect)
+{
+    Logging_trace1(">>: %1", effect->name());
+
+    {
+        std::lock_guard<std::mutex> guard{_registryMutex()};
+        _registry().remove(effect);
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* stage fusion       */
+/*--------------------*/
+
+Boolean SoXAudioEffect::absorbSuccessor (INOUT SoXAudioEffect* effect)
+{
+    (void) effect;
+    return false;
+}
+
+/*--------------------*/
+/* sidechain          */
+/*--------------------*/
+
+Boolean SoXAudioEffect::hasSidechainInput () const
+{
+    return false;
+}
+
+/*--------------------*/
+
+void SoXAudioEffect::setSidechainInput (IN SoXSidechainView& sidechain)
+{
+    _sidechain = sidechain;
+}
+
+/*--------------------*/
+/* mono processing    */
+/*--------------------*/
+
+Boolean SoXAudioEffect::hasMonoProcessing () const
+{
+    return false;
+}
+
+/*--------------------*/
+
+void SoXAudioEffect::copyFirstChannelState (IN Natural channelCount)
+{
+    (void) channelCount;
+}
+
+/*--------------------*/
+
+Boolean SoXAudioEffect::hasIndependentChannels () const
+{
+    return false;
+}
+
+/*--------------------*/
+/* frequency response */
+/*--------------------*/
+
+Natural SoXAudioEffect::responseCurveCount () const
+{
+    return 0;
+}
+
+/*--------------------*/
+
+Boolean SoXAudioEffect::frequencyResponse (IN Natural curveIndex,
+                                           IN RealList& frequencyList,
+                                           OUT RealList& magnitudeList,
+                                           OUT RealList& phaseList) const
+{
+    Logging_trace1(">>: curveIndex = %1", TOSTRING(curveIndex));
+    const Boolean result = false;
+    Logging_trace1("<<: %1", TOSTRING(result));
+    return result;
+}
+
+/*--------------------*/
+/* metering           */
+/*--------------------*/
+
+Natural SoXAudioEffect::gainReductionCount () const
+{
+    return 0;
+}
+
+/*--------------------*/
+
+Real SoXAudioEffect::takeGainReduction (IN Natural)
+{
+    return 0.0;
+}
+
+/*--------------------*/
+/* quality level      */
+/*--------------------*/
+
+Natural SoXAudioEffect::qualityLevelCount () const
+{
+    return 1;
+}
+
+/*--------------------*/
+
+void SoXAudioEffect::setQualityLevel (IN Natural)
+{
+}
+
+/*--------------------*/
+/* precision profile  */
+/*--------------------*/
+
+void SoXAudioEffect::setPrecisionProfile (IN SoXPrecisionProfile)
+{
+}
+
+/*--------------------*/
+/* DSP state          */
+/*--------------------*/
+
+Boolean SoXAudioEffect::hasDspStateSupport () const
+{
+    return false;
+}
+
+/*--------------------*/
+
+Boolean SoXAudioEffect::saveDspState (OUT ByteList& stateData) const
+{
+    Logging_trace(">>");
+
+    const Boolean isOkay = hasDspStateSupport();
+    stateData.clear();
+
+    if (isOkay) {
+        /* the effect name guards against restoring into another
+           effect, the time positions keep the playhead detection
+           consistent */
+        DspStateStream stream{};
+        stream.writeString(name());
+        stream.write(_sampleRate);
+        stream.write(_channelCount);
+        stream.write(_currentTimePosition);
+        stream.write(_expectedNextTimePosition);
+        stream.write(_timePositionHasMoved);
+        _saveDspState(stream);
+        stateData = stream.byteList();
+    }
+
+    Logging_trace2("<<: isOkay = %1, byteCount = %2",
+                   TOSTRING(isOkay), TOSTRING(stateData.length()));
+    return isOkay;
+}
+
+/*--------------------*/
+
+Boolean SoXAudioEffect::restoreDspState (IN ByteList& stateData)
+{
+    Logging_trace1(">>: byteCount = %1", TOSTRING(stateData.length()));
+
+    DspStateStream stream{stateData};
+    String effectName;
+    Real sampleRate;
+    stream.readString(effectName);
+    stream.read(sampleRate);
+
+    if (!hasDspStateSupport() || effectName != name()
+        || sampleRate != _sampleRate) {
+        stream.invalidate();
+    }
+
+    stream.read(_channelCount);
+    stream.read(_currentTimePosition);
+    stream.read(_expectedNextTimePosition);
+    stream.read(_timePositionHasMoved);
+
+    if (stream.isOkay()) {
+        _restoreDspState(stream);
+    }
+
+    const Boolean isOkay = (stream.isOkay() && stream.isAtEnd());
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+
+Boolean
+SoXAudioEffect::processWithState (IN ByteList& inputState,
+                                  IN Real timePosition,
+                                  INOUT AudioSampleListVector& buffer,
+                                  OUT ByteList& outputState)
+{
+    Logging_trace2(">>: byteCount = %1, timePosition = %2",
+                   TOSTRING(inputState.length()),
+                   TOSTRING(timePosition));
+
+    Boolean isOkay = hasDspStateSupport();
+    outputState.clear();
+
+    if (isOkay && inputState.length() > 0) {
+        isOkay = restoreDspState(inputState);
+    }
+
+    if (isOkay) {
+        processBlock(timePosition, buffer);
+        isOkay = saveDspState(outputState);
+    }
+
+    Logging_trace2("<<: isOkay = %1, byteCount = %2",
+                   TOSTRING(isOkay), TOSTRING(outputState.length()));
+    return isOkay;
+}
+
+/*--------------------*/
+
+void SoXAudioEffect::_saveDspState (INOUT DspStateStream&) const
+{
+}
+
+/*--------------------*/
+
+void SoXAudioEffect::_restoreDspState (INOUT DspStateStream&)
+{
+}
+
 /*--------------------*/
 /* parameter map      */
 /*--------------------*/
@@ -127,8 +503,53 @@ SoXAudioEffect::setValue (IN String& parameterName,
         /* do not store a bad value */
     } else {
         _effectParameterMap.setValue(parameterName, value);
-        result = _setValueInternal(parameterName, value,
-                                   recalculationIsForced);
+        const Natural parameterId =
+            _effectParameterMap.parameterId(parameterName);
+        /* within a batch the recalculation is deferred to the
+           commit */
+        Logging_span("SoXAudioEffect.setValue", this);
+        result = _setValueInternal(parameterId, parameterName, value,
+                                   (recalculationIsForced
+                                    && !_parameterBatchIsActive));
+        _parameterBatchHasChanges = true;
+    }
+
+    Logging_trace1("<<: %1", SoXParameterValueChangeKind_toString(result));
+    return result;
+}
+
+/*--------------------*/
+
+SoXParameterValueChangeKind
+SoXAudioEffect::setNumericValue (IN Natural parameterId,
+                                 IN Real value,
+                                 IN Boolean recalculationIsForced)
+{
+    Logging_trace3(">>: parameterId = %1, value = %2,"
+                   " recalcIsForced = %3",
+                   TOSTRING(parameterId), TOSTRING(value),
+                   TOSTRING(recalculationIsForced));
+
+    SoXParameterValueChangeKind result =
+        SoXParameterValueChangeKind::parameterChange;
+
+    if (_effectParameterMap.numericValue(parameterId) == value) {
+        /* break cycles: if value is already known, ignore this
+           request */
+    } else {
+        _effectParameterMap.setNumericValue(parameterId, value);
+        const String& parameterName =
+            _effectParameterMap.parameterName(parameterId);
+        const String& stringValue =
+            _effectParameterMap.enumValue(parameterId);
+        /* within a batch the recalculation is deferred to the
+           commit */
+        Logging_span("SoXAudioEffect.setValue", this);
+        result = _setValueInternal(parameterId, parameterName,
+                                   stringValue,
+                                   (recalculationIsForced
+                                    && !_parameterBatchIsActive));
+        _parameterBatchHasChanges = true;
     }
 
     Logging_trace1("<<: %1", SoXParameterValueChangeKind_toString(result));
@@ -137,6 +558,61 @@ SoXAudioEffect::setValue (IN String& parameterName,
 
 /*--------------------*/
 
+void SoXAudioEffect::reserveForValue (IN String& parameterName,
+                                      IN String& value)
+{
+    Logging_trace2(">>: parameterName = %1, value = %2",
+                   parameterName, value);
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXAudioEffect::recalculateSettings ()
+{
+    Logging_trace(">>");
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXAudioEffect::beginParameterBatch ()
+{
+    Logging_trace(">>");
+    _parameterBatchIsActive   = true;
+    _parameterBatchHasChanges = false;
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXAudioEffect::commitParameterBatch ()
+{
+    Logging_trace1(">>: hasChanges = %1",
+                   TOSTRING(_parameterBatchHasChanges));
+
+    if (_parameterBatchIsActive && _parameterBatchHasChanges) {
+        _recalculateChangedSettings();
+    }
+
+    _parameterBatchIsActive   = false;
+    _parameterBatchHasChanges = false;
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXAudioEffect::_recalculateChangedSettings ()
+{
+    Logging_trace(">>");
+    Logging_span("SoXAudioEffect.recalculateSettings", this);
+    recalculateSettings();
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
 Boolean SoXAudioEffect::hasValidParameters () const
 {
     Logging_trace(">>");
@@ -154,6 +630,104 @@ void SoXAudioEffect::setParameterValidity (IN Boolean isValid)
     Logging_trace("<<");
 }
 
+/*--------------------*/
+/* non-finite guard   */
+/*--------------------*/
+
+Natural SoXAudioEffect::nonFiniteResetCount () const
+{
+    return Natural{_nonFiniteResetCount.load(std::memory_order_relaxed)};
+}
+
+/*--------------------*/
+
+void SoXAudioEffect::_resetDspState ()
+{
+}
+
+/*--------------------*/
+
+void SoXAudioEffect::_guardFiniteness (INOUT float* const* channelArray,
+                                       IN Natural channelCount,
+                                       IN Natural sampleCount)
+{
+    const Kernels& kernels = Kernels::current();
+    Boolean isFinite = true;
+
+    for (Natural channel = 0;  channel < channelCount;  channel++) {
+        isFinite = (isFinite
+                    && kernels.isFiniteFloat(channelArray[(size_t) channel],
+                                             (size_t) sampleCount));
+    }
+
+    if (!isFinite) {
+        Logging_trace("--: non-finite output, state is reset");
+
+        for (Natural channel = 0;  channel < channelCount;  channel++) {
+            clearArray(channelArray[(size_t) channel], sampleCount, 0.0f);
+        }
+
+        _resetDspState();
+        _nonFiniteResetCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/*--------------------*/
+
+void SoXAudioEffect::_guardFiniteness (INOUT double* const* channelArray,
+                                       IN Natural channelCount,
+                                       IN Natural sampleCount)
+{
+    const Kernels& kernels = Kernels::current();
+    Boolean isFinite = true;
+
+    for (Natural channel = 0;  channel < channelCount;  channel++) {
+        isFinite = (isFinite
+                    && kernels.isFiniteDouble(channelArray[(size_t) channel],
+                                              (size_t) sampleCount));
+    }
+
+    if (!isFinite) {
+        Logging_trace("--: non-finite output, state is reset");
+
+        for (Natural channel = 0;  channel < channelCount;  channel++) {
+            clearArray(channelArray[(size_t) channel], sampleCount, 0.0);
+        }
+
+        _resetDspState();
+        _nonFiniteResetCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/*--------------------*/
+
+void SoXAudioEffect::_guardFiniteness (INOUT AudioSampleListVector& buffer)
+{
+    const Kernels& kernels = Kernels::current();
+    const Natural channelCount = buffer.size();
+    Boolean isFinite = true;
+
+    for (Natural channel = 0;  channel < channelCount;  channel++) {
+        AudioSampleList& sampleList = buffer[channel];
+        isFinite = (isFinite
+                    && kernels.isFiniteDouble((double*) sampleList.asArray(),
+                                              (size_t) sampleList.size()));
+    }
+
+    if (!isFinite) {
+        Logging_trace("--: non-finite output, state is reset");
+
+        for (Natural channel = 0;  channel < channelCount;  channel++) {
+            AudioSampleList& sampleList = buffer[channel];
+            clearArray((double*) sampleList.asArray(), sampleList.size(),
+                       0.0);
+        }
+
+        _resetDspState();
+        _nonFiniteResetCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
 /*--------------------*/
 /* event handling     */
 /*--------------------*/
@@ -163,6 +737,8 @@ void SoXAudioEffect::prepareToPlay (IN Real sampleRate)
     Logging_trace1(">>: sampleRate = %1", TOSTRING(sampleRate));
     _expectedNextTimePosition = Real::infinity;
     _sampleRate           = sampleRate;
+    _sampleDuration       = Real{1.0} / sampleRate;
+    _timePositionIsNeeded = needsTimePosition();
     Logging_trace("<<");
 }
 
@@ -180,19 +756,139 @@ void SoXAudioEffect::releaseResources ()
 void SoXAudioEffect::processBlock (IN Real timePosition,
                                    INOUT AudioSampleListVector& buffer)
 {
-    Logging_trace1(">>: timePosition = %1", TOSTRING(timePosition));
+    Logging_traceHot1(">>: timePosition = %1", TOSTRING(timePosition));
+    _startBlock(timePosition, buffer.size(), buffer[0].size());
+    Logging_traceHot("<<");
+}
 
-    _currentTimePosition = timePosition;
-    _channelCount        = buffer.size();
+/*--------------------*/
 
-    /* check whether timing has changed significantly */
-    const Real absoluteDifference =
-        Real::abs(_currentTimePosition - _expectedNextTimePosition);
-    _timePositionHasMoved = (absoluteDifference > 1E-3);
+void SoXAudioEffect::processBlock (IN Real timePosition,
+                                   INOUT AudioSampleListView& buffer)
+{
+    Logging_traceHot1(">>: timePosition = %1", TOSTRING(timePosition));
 
-    const Natural sampleCount = buffer[0].size();
-    _expectedNextTimePosition = (timePosition
-                                 + Real(sampleCount) / _sampleRate);
+    AudioSample* const* channelArray = buffer.channelArray();
 
-    Logging_trace("<<");
+    if (channelArray != nullptr) {
+        /* audio samples have the layout of doubles */
+        processDoubleBlock(timePosition, (double* const*) channelArray,
+                           buffer.channelCount(), buffer.frameCount());
+    } else {
+        AudioSampleListVector sampleBuffer{};
+        buffer.copyTo(sampleBuffer);
+        processBlock(timePosition, sampleBuffer);
+        buffer.copyFrom(sampleBuffer);
+    }
+
+    Logging_traceHot("<<");
+}
+
+/*--------------------*/
+
+Boolean SoXAudioEffect::hasFloatProcessing () const
+{
+    return false;
+}
+
+/*--------------------*/
+
+void SoXAudioEffect::processFloatBlock (IN Real timePosition,
+                                        INOUT float* const* channelArray,
+                                        IN Natural channelCount,
+                                        IN Natural sampleCount)
+{
+    Logging_traceHot1(">>: timePosition = %1", TOSTRING(timePosition));
+
+    /* fallback: route through an audio sample buffer */
+    AudioSampleListVector buffer{};
+    buffer.setLength(channelCount);
+    buffer.setFrameCount(sampleCount);
+
+    const Kernels& kernels = Kernels::current();
+
+    for (Natural channel = 0;  channel < channelCount;  channel++) {
+        kernels.floatToDouble((double*) buffer[channel].asArray(),
+                              channelArray[(size_t) channel],
+                              (size_t) sampleCount);
+    }
+
+    processBlock(timePosition, buffer);
+
+    for (Natural channel = 0;  channel < channelCount;  channel++) {
+        kernels.doubleToFloat(channelArray[(size_t) channel],
+                              (const double*) buffer[channel].asArray(),
+                              (size_t) sampleCount);
+    }
+
+    Logging_traceHot("<<");
+}
+
+/*--------------------*/
+
+Boolean SoXAudioEffect::hasDoubleProcessing () const
+{
+    return false;
+}
+
+/*--------------------*/
+
+void SoXAudioEffect::processDoubleBlock (IN Real timePosition,
+                                         INOUT double* const* channelArray,
+                                         IN Natural channelCount,
+                                         IN Natural sampleCount)
+{
+    Logging_traceHot1(">>: timePosition = %1", TOSTRING(timePosition));
+
+    /* fallback: route through an audio sample buffer */
+    AudioSampleListVector buffer{};
+    buffer.setLength(channelCount);
+    buffer.setFrameCount(sampleCount);
+
+    /* audio samples have the layout of doubles, hence channels are
+       copied as blocks */
+    for (Natural channel = 0;  channel < channelCount;  channel++) {
+        double* targetPtr = (double*) buffer[channel].asArray();
+        const double* sourcePtr = channelArray[(size_t) channel];
+        copyArray(targetPtr, sourcePtr, sampleCount);
+    }
+
+    processBlock(timePosition, buffer);
+
+    for (Natural channel = 0;  channel < channelCount;  channel++) {
+        double* targetPtr = channelArray[(size_t) channel];
+        const double* sourcePtr =
+            (const double*) buffer[channel].asArray();
+        copyArray(targetPtr, sourcePtr, sampleCount);
+    }
+
+    Logging_traceHot("<<");
+}
+
+/*--------------------*/
+
+Boolean SoXAudioEffect::needsTimePosition () const
+{
+    return false;
+}
+
+/*--------------------*/
+
+void SoXAudioEffect::_startBlock (IN Real timePosition,
+                                  IN Natural channelCount,
+                                  IN Natural sampleCount)
+{
+    _currentTimePosition = timePosition;
+    _channelCount        = channelCount;
+
+    /* check whether timing has changed significantly; an effect not
+       depending on the time position skips this (which matters for
+       small blocks) */
+    if (_timePositionIsNeeded) {
+        const Real absoluteDifference =
+            Real::abs(_currentTimePosition - _expectedNextTimePosition);
+        _timePositionHasMoved = (absoluteDifference > 1E-3);
+        _expectedNextTimePosition =
+            timePosition + Real(sampleCount) * _sampleDuration;
+    }
 }
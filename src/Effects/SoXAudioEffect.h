@@ -15,39 +15,70 @@
 /* IMPORTS */
 /*=========*/
 
+#include <atomic>
+#include <cstdint>
 #include "Object.h"
 #include "AudioSampleListVector.h"
+#include "AudioSampleListView.h"
+#include "DspStateStream.h"
+#include "RealList.h"
 #include "SoXEffectParameterMap.h"
+#include "SoXMemoryFootprint.h"
 #include "SoXParameterValueChangeKind.h"
+#include "SoXPrecisionProfile.h"
+#include "SoXSidechainView.h"
 
 /*--------------------*/
 
 using Audio::AudioSampleList;
 using Audio::AudioSampleListVector;
+using Audio::AudioSampleListView;
+using Audio::DspStateStream;
+using BaseTypes::Containers::ByteList;
+using BaseTypes::Containers::RealList;
 using BaseTypes::Primitives::Object;
 using BaseTypes::Primitives::String;
 using SoXPlugins::Helpers::SoXEffectParameterMap;
+using SoXPlugins::Helpers::SoXMemoryFootprint;
 using SoXPlugins::Helpers::SoXParameterValueChangeKind;
+using SoXPlugins::Helpers::SoXPrecisionProfile;
+using SoXPlugins::Helpers::SoXSidechainView;
 
 /*====================*/
 
 namespace SoXPlugins::Effects {
 
     /**
-     * A <C>SoXAudioEffect</C> object is a generic stereo audio effect
-     * from SoX encapsulating the common services of such an effect.
+     * A <C>SoXAudioEffect</C> object is a generic audio effect from
+     * SoX encapsulating the common services of such an effect.
+     *
+     * An effect processes an arbitrary number of channels (like
+     * stereo, 7.1.4 or higher order ambisonics) with independent
+     * state per channel; the samples are passed channel-major with
+     * one contiguous sample array per channel.  The channel count is
+     * taken from each block, per-channel state is extended when the
+     * count grows.
+     *
+     * All effects are registered in a process-wide registry with
+     * the memory footprint they have published last, such that the
+     * memory of all instances in a session can be reported without
+     * touching the effects themselves; an effect owned by another
+     * effect (like a stage in a chain) is only accounted for by its
+     * owner.
      */
     struct SoXAudioEffect {
 
         /**
-         * Makes empty audio effect.
+         * Makes empty audio effect and registers it in the
+         * process-wide registry.
          */
         SoXAudioEffect ();
 
         /*--------------------*/
 
         /**
-         * The destructor of an audio effect.
+         * The destructor of an audio effect; unregisters it from the
+         * process-wide registry.
          */
         virtual ~SoXAudioEffect ();
 
@@ -73,6 +104,389 @@ namespace SoXPlugins::Effects {
          */
         virtual String name () const;
 
+        /*--------------------*/
+
+        /**
+         * Returns the time in seconds the output of this effect needs
+         * to decay below the silence threshold once its input has
+         * become silent (the tail); zero for effects without internal
+         * state (the default) and infinity for effects whose state
+         * does not decay.
+         *
+         * @return  tail length in seconds
+         */
+        virtual Real tailLength () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the delay in samples of the output of this effect
+         * with respect to its input to be compensated by the host
+         * (the default is zero).
+         *
+         * @return  latency in samples
+         */
+        virtual Natural latency () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the time in seconds this effect has to process
+         * input before its output no longer depends on the state it
+         * started with (up to the silence threshold); this is the
+         * pre-roll needed when a signal is rendered in independent
+         * segments.  The default is the tail length plus the
+         * latency; infinity tells that the effect cannot be rendered
+         * in segments.
+         *
+         * @return  warm-up length in seconds
+         */
+        virtual Real warmupLength () const;
+
+        /*--------------------*/
+
+        /**
+         * Tells whether this effect currently just multiplies its
+         * input by a constant factor and returns this factor in
+         * <C>gain</C>; such an effect can be absorbed by a
+         * preceding linear effect in a chain (the default is
+         * false).
+         *
+         * @param[out] gain  constant linear gain factor of effect
+         * @return  information whether effect is a constant gain
+         */
+        virtual Boolean hasConstantGain (OUT Real& gain) const;
+
+        /*--------------------*/
+        /* memory footprint   */
+        /*--------------------*/
+
+        /**
+         * Returns the number of bytes this effect occupies on the
+         * heap broken down by delay lines, ring buffers, parameter
+         * map and descriptor; the default implementation counts the
+         * parameter map, effects add their descriptor data.  The sizes are read without
+         * synchronization with the audio thread, hence this must
+         * not be called on the audio thread and may be slightly
+         * outdated while the effect grows its buffers.
+         *
+         * @return  memory footprint of effect
+         */
+        virtual SoXMemoryFootprint memoryFootprint () const;
+
+        /*--------------------*/
+
+        /**
+         * Calculates the current memory footprint of this effect
+         * and publishes it in the process-wide registry; must not
+         * be called on the audio thread (but may be called
+         * concurrently with it).
+         *
+         * @return  memory footprint of effect
+         */
+        SoXMemoryFootprint publishMemoryFootprint ();
+
+        /*--------------------*/
+
+        /**
+         * Returns the sum of the memory footprints last published
+         * by all effects in the process (without effects owned by
+         * other effects) and their count in <C>effectCount</C>;
+         * must not be called on the audio thread.
+         *
+         * @param[out] effectCount  number of effects accounted for
+         * @return  memory footprint of all effects
+         */
+        static SoXMemoryFootprint totalMemoryFootprint
+                                      (OUT Natural& effectCount);
+
+        /*--------------------*/
+        /* stage fusion       */
+        /*--------------------*/
+
+        /**
+         * Tries to take over the processing of <C>effect</C>
+         * directly following this effect in a chain for the next
+         * processed block only; when this returns true, the next
+         * call of a processing method of this effect also applies
+         * <C>effect</C> (without its own memory pass) and
+         * <C>effect</C> must not be processed for that block.  The
+         * default implementation absorbs nothing.
+         *
+         * @param[inout] effect  effect following this effect
+         * @return  information whether effect has been absorbed
+         */
+        virtual Boolean absorbSuccessor (INOUT SoXAudioEffect* effect);
+
+        /*--------------------*/
+        /* sidechain          */
+        /*--------------------*/
+
+        /**
+         * Tells whether this effect evaluates an external sidechain
+         * input (the default is false).
+         *
+         * @return  information whether a sidechain is used
+         */
+        virtual Boolean hasSidechainInput () const;
+
+        /*--------------------*/
+
+        /**
+         * Sets the sidechain for the next processed block to
+         * <C>sidechain</C> (an empty view when no sidechain is
+         * connected); the view refers to host memory and must have
+         * the sample count of the block.
+         *
+         * @param[in] sidechain  read-only view onto sidechain
+         *                       channels of next block
+         */
+        virtual void setSidechainInput (IN SoXSidechainView& sidechain);
+
+        /*--------------------*/
+        /* mono processing    */
+        /*--------------------*/
+
+        /**
+         * Tells whether this effect produces identical channels for
+         * identical input channels as long as the states of all its
+         * channels are equal; then the caller may process only the
+         * first channel of such a block (passing a channel count of
+         * one) and copy the result to the other channels.  In that
+         * case the effect must keep the state of the other channels
+         * untouched.  The default is false.
+         *
+         * @return  information whether mono processing is supported
+         */
+        virtual Boolean hasMonoProcessing () const;
+
+        /*--------------------*/
+
+        /**
+         * Copies the state of the first channel to the other
+         * channels up to <C>channelCount</C>; called when the caller
+         * returns from mono processing to processing all channels.
+         * Must only be called on the audio thread; like the
+         * processing it only allocates when the channel count grows
+         * beyond all previous counts.  The default implementation
+         * does nothing.
+         *
+         * @param[in] channelCount  number of channels to be set
+         */
+        virtual void copyFirstChannelState (IN Natural channelCount);
+
+        /*--------------------*/
+
+        /**
+         * Tells whether this effect processes each channel
+         * independently of all other channels, such that the output
+         * of a channel only depends on its own input and the
+         * settings.  Then the channels of several files rendered
+         * with identical settings may be processed side by side by
+         * a single instance, each file occupying its own channels.
+         * The default is false.
+         *
+         * @return  information whether channels are independent
+         */
+        virtual Boolean hasIndependentChannels () const;
+
+        /*--------------------*/
+        /* frequency response */
+        /*--------------------*/
+
+        /**
+         * Returns the number of frequency response curves this
+         * effect provides for a display (like the response of a
+         * filter or of the bands of a crossover); the default is
+         * none.
+         *
+         * @return  count of response curves
+         */
+        virtual Natural responseCurveCount () const;
+
+        /*--------------------*/
+
+        /**
+         * Calculates the response curve with <C>curveIndex</C> for
+         * the current settings at the frequencies in Hz in
+         * <C>frequencyList</C> and returns the linear magnitudes in
+         * <C>magnitudeList</C> and the phases in radians in
+         * <C>phaseList</C>; returns false when there is no such
+         * curve (the default).  The results are cached until the
+         * settings change; the calculation may be done on any
+         * thread except the audio thread, preferably on a
+         * background thread instead of the message thread.
+         *
+         * @param[in]  curveIndex     the index of the curve
+         * @param[in]  frequencyList  the frequencies in Hz
+         * @param[out] magnitudeList  the linear magnitudes of the
+         *                            response
+         * @param[out] phaseList      the phases of the response in
+         *                            radians
+         * @return  information whether curve exists
+         */
+        virtual Boolean frequencyResponse (IN Natural curveIndex,
+                                           IN RealList& frequencyList,
+                                           OUT RealList& magnitudeList,
+                                           OUT RealList& phaseList)
+            const;
+
+        /*--------------------*/
+        /* metering           */
+        /*--------------------*/
+
+        /**
+         * Returns the number of gain reduction values this effect
+         * provides for a level meter (like one per compander band);
+         * the default is none.  Must only be called on the audio
+         * thread.
+         *
+         * @return  count of gain reduction values
+         */
+        virtual Natural gainReductionCount () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the maximum gain reduction in decibels with
+         * <C>index</C> since the last call and restarts its
+         * measurement (the default is zero); must only be called on
+         * the audio thread, it neither allocates nor blocks.
+         *
+         * @param[in] index  the index of the gain reduction value
+         * @return  gain reduction in decibels
+         */
+        virtual Real takeGainReduction (IN Natural index);
+
+        /*--------------------*/
+        /* quality level      */
+        /*--------------------*/
+
+        /**
+         * Returns the number of quality levels of this effect for a
+         * processing load governor; level zero is the full quality
+         * and each higher level trades some accuracy for a lower
+         * processing load.  The default is a single level.
+         *
+         * @return  count of quality levels
+         */
+        virtual Natural qualityLevelCount () const;
+
+        /*--------------------*/
+
+        /**
+         * Sets the quality level to <C>level</C> (clipped to the
+         * levels available); the change is applied without audible
+         * discontinuities (by interpolation or a crossfade) and
+         * overlays the quality chosen by the parameters.  Must only
+         * be called on the audio thread between blocks, it neither
+         * allocates nor blocks; the default does nothing.
+         *
+         * @param[in] level  new quality level
+         */
+        virtual void setQualityLevel (IN Natural level);
+
+        /*--------------------*/
+        /* precision profile  */
+        /*--------------------*/
+
+        /**
+         * Sets the precision profile of the effect to
+         * <C>profile</C> (see <C>SoXPrecisionProfile</C>; default:
+         * SoX-exact); the quality level is applied on top of it.
+         * May allocate, hence must not be called on the audio
+         * thread; the default does nothing (for effects without
+         * approximations).
+         *
+         * @param[in] profile  new precision profile
+         */
+        virtual void setPrecisionProfile (IN SoXPrecisionProfile profile);
+
+        /*--------------------*/
+        /* DSP state          */
+        /*--------------------*/
+
+        /**
+         * Tells whether this effect can save and restore its
+         * processing state via <C>saveDspState</C> and
+         * <C>restoreDspState</C> (the default is no).
+         *
+         * @return  information whether DSP state can be transferred
+         */
+        virtual Boolean hasDspStateSupport () const;
+
+        /*--------------------*/
+
+        /**
+         * Writes the complete processing state of the effect (like
+         * delay lines, filter histories and oscillator phases, but
+         * not the parameters) as a compact binary blob to
+         * <C>stateData</C> and tells whether the effect supports
+         * this; must not be called concurrently with the
+         * processing.
+         *
+         * @param[out] stateData  blob with processing state
+         * @return  information whether state has been saved
+         */
+        Boolean saveDspState (OUT ByteList& stateData) const;
+
+        /*--------------------*/
+
+        /**
+         * Restores the processing state from <C>stateData</C>
+         * written by <C>saveDspState</C> of an effect of the same
+         * kind and tells whether this has been successful; the
+         * effect must have the same parameters and must have been
+         * prepared with the same sample rate, then the following
+         * blocks are processed bit-identically to those following
+         * the save.  After a failure the state is undefined and the
+         * effect must be prepared again.
+         *
+         * @param[in] stateData  blob with processing state
+         * @return  information whether state has been restored
+         */
+        Boolean restoreDspState (IN ByteList& stateData);
+
+        /*--------------------*/
+
+        /**
+         * Processes <C>buffer</C> in place for position
+         * <C>timePosition</C> as a function of the processing
+         * state: the effect takes over <C>inputState</C> (written by
+         * <C>saveDspState</C> or a previous call of this routine,
+         * possibly on another machine), processes the block and
+         * returns its state afterwards in <C>outputState</C>; an
+         * empty input state continues from the current state (like
+         * the one after <C>prepareToPlay</C> at the start of a
+         * timeline).  Hence a timeline may be split into parts
+         * processed one after another on different nodes by
+         * effects with equal parameters and sample rate, where
+         * each part starts with the output state of its
+         * predecessor; the stitched result is bit-identical to
+         * processing in one go with the same block boundaries.
+         *
+         * Returns false with an empty output state and an
+         * unprocessed buffer when the effect has no DSP state
+         * support or the input state does not fit; such an effect
+         * has to be rendered in segments each preceded by a
+         * pre-roll of <C>warmupLength</C>.  Must not be called
+         * concurrently with other processing.
+         *
+         * @param[in]    inputState    blob with processing state
+         *                             before block (or empty)
+         * @param[in]    timePosition  position where processing
+         *                             starts
+         * @param[inout] buffer        buffer of input and output
+         *                             audio samples
+         * @param[out]   outputState   blob with processing state
+         *                             after block
+         * @return  information whether block has been processed
+         */
+        Boolean processWithState (IN ByteList& inputState,
+                                  IN Real timePosition,
+                                  INOUT AudioSampleListVector& buffer,
+                                  OUT ByteList& outputState);
+
         /*--------------------*/
         /* parameter map      */
         /*--------------------*/
@@ -92,7 +506,8 @@ namespace SoXPlugins::Effects {
          * If value has wrong kind, it is ignored; if
          * <C>recalculationIsForced</C> is set, the recalculation of
          * dependent internal settings is forced (otherwise it is
-         * suppressed); returns change kind of value to be reported to
+         * suppressed, within a parameter batch it is deferred to the
+         * commit); returns change kind of value to be reported to
          * observers
          *
          * @param[in] parameterName          name of parameter to
@@ -111,6 +526,82 @@ namespace SoXPlugins::Effects {
 
         /*--------------------*/
 
+        /**
+         * Sets parameter with identification <C>parameterId</C> to
+         * numeric value <C>value</C> (the value itself for a real
+         * or integer parameter, the index in the value list for an
+         * enumeration parameter) like <C>setValue</C>, but without
+         * formatting or parsing strings; hence this is the path for
+         * host automation on the audio thread.  The value must be
+         * within the parameter range; the effect gets the
+         * enumeration value or an empty string as string value.
+         *
+         * @param[in] parameterId            identification of
+         *                                   parameter in parameter
+         *                                   map
+         * @param[in] value                  new numeric value of
+         *                                   parameter
+         * @param[in] recalculationIsForced  flag to tell whether
+         *                                   complex recalculations
+         *                                   should be done
+         * @return  change kind of value (e.g. parameter change)
+         */
+        SoXParameterValueChangeKind
+        setNumericValue (IN Natural parameterId,
+                         IN Real value,
+                         IN Boolean recalculationIsForced = true);
+
+        /*--------------------*/
+
+        /**
+         * Allocates in advance what a later <C>setValue</C> of
+         * parameter named <C>parameterName</C> to <C>value</C> will
+         * need, such that setting that value on the audio thread
+         * does not allocate; called outside of the audio thread
+         * before a value is handed over to it.  The parameter
+         * itself is not changed and the effect must still process
+         * its current parameters concurrently (the default
+         * implementation does nothing).
+         *
+         * @param[in] parameterName  name of parameter to be set
+         *                           later
+         * @param[in] value          associated value of parameter
+         */
+        virtual void reserveForValue (IN String& parameterName,
+                                      IN String& value);
+
+        /*--------------------*/
+
+        /**
+         * Recalculates all internal settings depending on the
+         * parameter values; used after a sequence of
+         * <C>setValue</C> calls with suppressed recalculation (the
+         * default implementation does nothing).
+         */
+        virtual void recalculateSettings ();
+
+        /*--------------------*/
+
+        /**
+         * Starts a batch of parameter changes: until
+         * <C>commitParameterBatch</C> all calls of <C>setValue</C>
+         * only store their values and mark the affected internal
+         * settings as changed, but do no recalculation.
+         */
+        void beginParameterBatch ();
+
+        /*--------------------*/
+
+        /**
+         * Ends a batch of parameter changes started by
+         * <C>beginParameterBatch</C> and recalculates exactly once
+         * those internal settings affected by the changes in the
+         * batch.
+         */
+        void commitParameterBatch ();
+
+        /*--------------------*/
+
         /**
          * Sets parameters to effect default values.
          */
@@ -127,6 +618,21 @@ namespace SoXPlugins::Effects {
 
         /*--------------------*/
 
+        /*--------------------*/
+        /* non-finite guard   */
+        /*--------------------*/
+
+        /**
+         * Returns the number of blocks whose output contained NaN or
+         * infinite samples and hence caused a reset of the
+         * processing state; may be called from any thread.
+         *
+         * @return  count of state resets by non-finite output
+         */
+        Natural nonFiniteResetCount () const;
+
+        /*--------------------*/
+
         /**
          * Sets parameters collectively to valid or invalid depending
          * on <C>isValid</C>.
@@ -169,6 +675,104 @@ namespace SoXPlugins::Effects {
         virtual void processBlock (IN Real timePosition,
                                    INOUT AudioSampleListVector& buffer);
 
+        /*--------------------*/
+
+        /**
+         * Processes the audio samples referenced by view
+         * <C>buffer</C> in place for position <C>timePosition</C>.
+         * Views made from channel pointers are handed to
+         * <C>processDoubleBlock</C> without copying, other views are
+         * routed through an audio sample buffer.
+         *
+         * @param[in]    timePosition  position where processing starts
+         * @param[inout] buffer        view onto input and output audio
+         *                             samples to be processed
+         */
+        void processBlock (IN Real timePosition,
+                           INOUT AudioSampleListView& buffer);
+
+        /*--------------------*/
+
+        /**
+         * Tells whether effect can process blocks of float samples
+         * directly via <C>processFloatBlock</C> without a conversion
+         * into audio samples.
+         *
+         * @return  information whether native float processing is
+         *          supported (default: false)
+         */
+        virtual Boolean hasFloatProcessing () const;
+
+        /*--------------------*/
+
+        /**
+         * Processes a block of float samples in place for position
+         * <C>timePosition</C>; <C>channelArray</C> contains
+         * <C>channelCount</C> pointers to <C>sampleCount</C> samples
+         * each.  The default implementation converts into audio
+         * samples and calls <C>processBlock</C>; effects supporting
+         * native float processing override it.
+         *
+         * @param[in]    timePosition  position where processing starts
+         * @param[inout] channelArray  array of pointers to the input
+         *                             and output samples per channel
+         * @param[in]    channelCount  number of channels
+         * @param[in]    sampleCount   number of samples per channel
+         */
+        virtual void processFloatBlock (IN Real timePosition,
+                                        INOUT float* const* channelArray,
+                                        IN Natural channelCount,
+                                        IN Natural sampleCount);
+
+        /*--------------------*/
+
+        /**
+         * Tells whether effect can process blocks of double samples
+         * in place via <C>processDoubleBlock</C> without copying
+         * them into an audio sample buffer.
+         *
+         * @return  information whether in-place double processing is
+         *          supported (default: false)
+         */
+        virtual Boolean hasDoubleProcessing () const;
+
+        /*--------------------*/
+
+        /**
+         * Processes a block of double samples in place for position
+         * <C>timePosition</C>; <C>channelArray</C> contains
+         * <C>channelCount</C> pointers to <C>sampleCount</C> samples
+         * each.  The default implementation copies into audio
+         * samples and calls <C>processBlock</C>; effects supporting
+         * in-place double processing override it.
+         *
+         * @param[in]    timePosition  position where processing starts
+         * @param[inout] channelArray  array of pointers to the input
+         *                             and output samples per channel
+         * @param[in]    channelCount  number of channels
+         * @param[in]    sampleCount   number of samples per channel
+         */
+        virtual void processDoubleBlock (IN Real timePosition,
+                                         INOUT double* const* channelArray,
+                                         IN Natural channelCount,
+                                         IN Natural sampleCount);
+
+        /*--------------------*/
+
+        /**
+         * Tells whether effect depends on the time position passed
+         * to the block processing (e.g. for synchronizing a
+         * modulation with the playhead).  When not, the caller may
+         * skip querying the playhead and pass an arbitrary position
+         * instead.  The result must not change between
+         * <C>prepareToPlay</C> and <C>releaseResources</C>, except
+         * for containers of other effects.
+         *
+         * @return  information whether time position is used
+         *          (default: false)
+         */
+        virtual Boolean needsTimePosition () const;
+
         /*--------------------*/
         /*--------------------*/
 
@@ -196,13 +800,39 @@ namespace SoXPlugins::Effects {
             /*--------------------*/
 
             /**
-             * Sets parameter named <C>parameterName</C> to
-             * <C>value</C>.  If value has wrong kind, it is ignored;
-             * if <C>recalculationIsForced</C> is set, the
-             * recalculation of dependent internal settings is forced
-             * (otherwise it it suppressed); returns kind of value
-             * change to be reported to observers
+             * Does the common bookkeeping at the start of a block
+             * of <C>channelCount</C> channels with <C>sampleCount</C>
+             * samples each at <C>timePosition</C>: sets channel count
+             * and current time position and checks whether the
+             * playhead has moved (the latter only when the effect
+             * needs the time position).
              *
+             * @param[in] timePosition  position where processing starts
+             * @param[in] channelCount  number of channels in block
+             * @param[in] sampleCount   number of samples per channel
+             */
+            void _startBlock (IN Real timePosition,
+                              IN Natural channelCount,
+                              IN Natural sampleCount);
+
+            /*--------------------*/
+
+            /**
+             * Sets parameter named <C>parameterName</C> with
+             * identification <C>parameterId</C> in the parameter map
+             * to <C>value</C>; the value has already been stored in
+             * the parameter map and can be read from there in numeric
+             * form.  When set via <C>setNumericValue</C>, a real or
+             * integer <C>value</C> is empty, hence those must be read
+             * numerically.  If value has wrong kind, it is ignored; if
+             * <C>recalculationIsForced</C> is set, the recalculation
+             * of dependent internal settings is forced (otherwise it
+             * it suppressed); returns kind of value change to be
+             * reported to observers
+             *
+             * @param[in] parameterId            identification of
+             *                                   parameter in parameter
+             *                                   map
              * @param[in] parameterName          name of parameter to
              *                                   be set
              * @param[in] value                  associated value of
@@ -213,18 +843,134 @@ namespace SoXPlugins::Effects {
              * @return  value change kind to be reported to observers
              */
             virtual SoXParameterValueChangeKind
-            _setValueInternal (IN String& parameterName,
+            _setValueInternal (IN Natural parameterId,
+                               IN String& parameterName,
                                IN String& value,
                                IN Boolean recalculationIsForced) = 0;
 
             /*--------------------*/
 
+            /**
+             * Recalculates the internal settings affected by the
+             * parameter changes of a batch on its commit; the
+             * default implementation recalculates all settings via
+             * <C>recalculateSettings</C>, effects with independent
+             * sections (like bands) only update the changed ones.
+             */
+            virtual void _recalculateChangedSettings ();
+
+            /*--------------------*/
+
+            /**
+             * Marks <C>effect</C> as owned by another effect: it is
+             * removed from the process-wide registry, since its
+             * owner accounts for its memory footprint.
+             *
+             * @param[inout] effect  effect owned by the calling
+             *                       effect
+             */
+            static void _markAsNested (INOUT SoXAudioEffect* effect);
+
+            /*--------------------*/
+
+            /**
+             * Appends the effect specific processing state to
+             * <C>stream</C>; only called when the effect has DSP
+             * state support (the default implementation does
+             * nothing).
+             *
+             * @param[inout] stream  state stream to be written
+             */
+            virtual void _saveDspState (INOUT DspStateStream& stream)
+                const;
+
+            /*--------------------*/
+
+            /**
+             * Reads the effect specific processing state from
+             * <C>stream</C> in the order written by
+             * <C>_saveDspState</C>; a mismatch with the current
+             * configuration invalidates the stream (the default
+             * implementation does nothing).
+             *
+             * @param[inout] stream  state stream to be read
+             */
+            virtual void _restoreDspState (INOUT DspStateStream& stream);
+
+            /*--------------------*/
+
+            /**
+             * Clears the processing state of the effect (like delay
+             * lines, filter histories and envelopes, but not the
+             * parameters) after non-finite output; must neither
+             * allocate nor block, since it is called on the audio
+             * thread (the default implementation does nothing).
+             */
+            virtual void _resetDspState ();
+
+            /*--------------------*/
+
+            /**
+             * Checks the <C>sampleCount</C> output samples of the
+             * <C>channelCount</C> channels in <C>channelArray</C>
+             * for NaN or infinite values; when there are some (which
+             * would persist in a recursive effect forever), the
+             * block is silenced, the processing state is reset via
+             * <C>_resetDspState</C> and the event is counted.
+             *
+             * @param[inout] channelArray  array of pointers to the
+             *                             output samples per channel
+             * @param[in]    channelCount  number of channels
+             * @param[in]    sampleCount   number of samples per channel
+             */
+            void _guardFiniteness (INOUT float* const* channelArray,
+                                   IN Natural channelCount,
+                                   IN Natural sampleCount);
+
+            /*--------------------*/
+
+            /**
+             * Checks the <C>sampleCount</C> output samples of the
+             * <C>channelCount</C> channels in <C>channelArray</C>
+             * for NaN or infinite values and resets the effect
+             * when there are some (for double precision samples).
+             *
+             * @param[inout] channelArray  array of pointers to the
+             *                             output samples per channel
+             * @param[in]    channelCount  number of channels
+             * @param[in]    sampleCount   number of samples per channel
+             */
+            void _guardFiniteness (INOUT double* const* channelArray,
+                                   IN Natural channelCount,
+                                   IN Natural sampleCount);
+
+            /*--------------------*/
+
+            /**
+             * Checks the output samples in <C>buffer</C> for NaN or
+             * infinite values and resets the effect when there are
+             * some (for an audio sample buffer).
+             *
+             * @param[inout] buffer  buffer of output audio samples
+             */
+            void _guardFiniteness (INOUT AudioSampleListVector& buffer);
+
+            /*--------------------*/
+
             /** the audio sample rate to be used in this effect */
             Real _sampleRate;
 
+            /** the duration of a sample in seconds (the reciprocal of
+             * the sample rate, cached per preparation) */
+            Real _sampleDuration;
+
             /** the count of channels in this effect */
             Natural _channelCount;
 
+            /** during processing: the sidechain of the current block
+             * (empty when not connected) */
+            SoXSidechainView _sidechain;
+
             /** the map of effect parameters */
             SoXEffectParameterMap _effectParameterMap;
 
@@ -244,10 +990,32 @@ namespace SoXPlugins::Effects {
              *  current and previous processing */
             Boolean _timePositionHasMoved;
 
+            /** tells whether the time position bookkeeping is done
+             * at all (cached from <C>needsTimePosition</C> per
+             * preparation) */
+            Boolean _timePositionIsNeeded;
+
             /** tells whether effect parameters have a significant
              * value */
             Boolean _parametersAreValid;
 
+            /** tells whether a batch of parameter changes is in
+             * progress; then recalculations are deferred to its
+             * commit */
+            Boolean _parameterBatchIsActive;
+
+            /** tells whether some parameter has been changed in the
+             * current batch */
+            Boolean _parameterBatchHasChanges;
+
+            /** the memory footprint published last (protected by
+             * the registry lock) */
+            SoXMemoryFootprint _publishedMemoryFootprint;
+
+            /** the number of state resets caused by non-finite
+             * output */
+            std::atomic<std::uint64_t> _nonFiniteResetCount;
+
     };
 
 }
@@ -22,19 +22,43 @@
 
 /*====================*/
 
+#include <algorithm>
 #include <array>
-
-#include "IIRFilter.h"
+#include <cmath>
+
+#include "AudioSampleRingBufferVector.h"
+#include "DenormalGuard.h"
+#include "FastMath.h"
+#include "HalfBandOversampler.h"
+#include "IIRFilterN.h"
+#include "Kernels.h"
 #include "Logging.h"
+#include "NaturalList.h"
+#include "RealFFT.h"
+#include "RealList.h"
 #include "SoXCompanderSupport.h"
+#include "SoXKernelTuning.h"
+#include "SoXWorkerPool.h"
 
 /*====================*/
 
 using std::array;
 
-using Audio::IIRFilter;
+using Audio::AudioSampleRingBuffer;
+using Audio::AudioSampleRingBufferVector;
+using Audio::DenormalGuard;
+using Audio::HalfBandOversampler;
+using Audio::IIRFilterN;
+using Audio::Kernels;
+using Audio::RealFFT;
+using BaseTypes::Primitives::FastMath;
+using BaseTypes::Containers::NaturalList;
+using BaseTypes::Containers::RealList;
 using BaseTypes::GenericTypes::GenericList;
 using SoXPlugins::Effects::SoXCompander::SoXMultibandCompander;
+using SoXPlugins::Helpers::SoXKernelTuning;
+using SoXPlugins::Helpers::SoXMemoryFootprint;
+using SoXPlugins::Helpers::SoXWorkerPool;
 
 /** abbreviation for StringUtil */
 using STR = BaseModules::StringUtil;
@@ -46,6 +70,181 @@ namespace SoXPlugins::Effects::SoXCompander {
     /** the maximum number of channels supported */
     const Natural _maximumChannelCount = 10;
 
+    /** the maximum number of frames per gain interval chosen
+     * automatically from the attack time */
+    const Natural _maximumAutomaticGainInterval = 32;
+
+    /*--------------------*/
+
+    /**
+     * Returns the number of bytes of the channel lists in
+     * <C>buffer</C> together with the list of those lists on the
+     * heap.
+     *
+     * @param[in] buffer  the buffer to be measured
+     * @return  count of owned bytes
+     */
+    static Natural _bufferByteCount (IN AudioSampleListVector& buffer)
+    {
+        Natural result = SoXMemoryFootprint::listByteCount(buffer);
+
+        for (const AudioSampleList& sampleList : buffer) {
+            result += SoXMemoryFootprint::listByteCount(sampleList);
+        }
+
+        return result;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Copies the first <C>sectionLength</C> elements of
+     * <C>list</C> to all following sections of that length (like
+     * the state of the first channel to the other channels) without
+     * reallocation.
+     *
+     * @tparam       ListType       type of list
+     * @param[inout] list           the list to be changed
+     * @param[in]    sectionLength  the number of elements per section
+     */
+    template <typename ListType>
+    static void _copyFirstSection (INOUT ListType& list,
+                                   IN Natural sectionLength)
+    {
+        const size_t count  = (size_t) list.length();
+        const size_t length = (size_t) sectionLength;
+
+        if (length > 0 && count > length) {
+            auto* elementArray = list.asArray();
+
+            for (size_t i = length;  i < count;  i++) {
+                elementArray[i] = elementArray[i % length];
+            }
+        }
+    }
+
+    /*--------------------*/
+    /* multirate bands    */
+    /*--------------------*/
+
+    /** the ratio between the sample rate of a decimated band and its
+     * top frequency; the band then ends two octaves below the
+     * Nyquist frequency of its reduced rate, where the crossover
+     * slope has already attenuated it by about 48dB */
+    const Real _decimationHeadroom = 8.0;
+
+    /*--------------------*/
+
+    /**
+     * Returns the factor by which a band with <C>topFrequency</C>
+     * at <C>sampleRate</C> may be decimated: the largest power of
+     * two (up to the maximum oversampling factor) keeping the
+     * headroom of the band.
+     *
+     * @param[in] topFrequency  the top crossover frequency of band
+     * @param[in] sampleRate    the sample rate of the band signal
+     * @return  decimation factor (one for processing at full rate)
+     */
+    static Natural _decimationFactor (IN Real topFrequency,
+                                      IN Real sampleRate)
+    {
+        Natural result = 1;
+
+        while (result < HalfBandOversampler::maximumFactor
+               && (topFrequency * _decimationHeadroom
+                   * Real{Natural{2} * result}) <= sampleRate) {
+            result *= 2;
+        }
+
+        return result;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the delay in samples at the full rate of a decimation
+     * by <C>factor</C> followed by an interpolation with the
+     * half-band filters; the delays of all factors are determined
+     * once by a resampler.
+     *
+     * @param[in] factor  the decimation factor (a power of two)
+     * @return  delay of filters in samples
+     */
+    static Natural _resamplingLatency (IN Natural factor)
+    {
+        static const NaturalList latencyList =
+            [] () {
+                NaturalList result;
+                HalfBandOversampler resampler;
+
+                for (Natural f = 1;  f <= HalfBandOversampler::maximumFactor;
+                     f *= 2) {
+                    resampler.setFactor(f);
+                    result.append(resampler.latency() * f);
+                }
+
+                return result;
+            }();
+
+        Natural index = 0;
+
+        for (Natural f = 2;  f <= factor;  f *= 2) {
+            index++;
+        }
+
+        return latencyList[index];
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the delay of a band decimated by <C>factor</C>
+     * relative to a band at full rate, both with a lookahead of
+     * <C>lookahead</C> samples: the decimated band buffers
+     * <C>factor - 1</C> samples for complete groups, adds the
+     * delay of the half-band filters and rounds the lookahead up
+     * to whole samples at its reduced rate.
+     *
+     * @param[in] factor     the decimation factor (a power of two)
+     * @param[in] lookahead  the lookahead in samples at full rate
+     * @return  additional delay of decimated band in samples
+     */
+    static Natural _multirateLatency (IN Natural factor,
+                                      IN Natural lookahead)
+    {
+        Natural result = 0;
+
+        if (factor > 1) {
+            const Natural roundedLookahead =
+                (lookahead + factor - 1) / factor * factor;
+            result = (factor - 1 + _resamplingLatency(factor)
+                      + roundedLookahead - lookahead);
+        }
+
+        return result;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the maximum delay of a decimated band relative to a
+     * band at full rate for all factors and lookaheads.
+     *
+     * @return  maximum additional delay in samples
+     */
+    static Natural _maximumMultirateLatency ()
+    {
+        Natural result = 0;
+
+        for (Natural factor = 2;
+             factor <= HalfBandOversampler::maximumFactor;  factor *= 2) {
+            result = Natural::maximum(result,
+                                      _multirateLatency(factor, 1));
+        }
+
+        return result;
+    }
+
     /*===============================*/
     /* Point in twodimensional space */
     /*===============================*/
@@ -279,13 +478,112 @@ namespace SoXPlugins::Effects::SoXCompander {
         /*--------------------*/
 
         /**
-         * Applies transfer function to <value>
+         * Applies transfer function to <value>; uses the lookup
+         * table when set, otherwise evaluates the segments
          *
          * @param[in] value   value to be adapted by function
          * @return associated function result
          */
         Real apply (IN Real value) const;
 
+        /*--------------------*/
+
+        /**
+         * Applies transfer function in place to the <C>count</C>
+         * values in <C>valueArray</C> (typically envelope values of
+         * a block); this is a separate pass without dependencies
+         * between samples, equivalent to <C>apply</C> per value.
+         *
+         * @param[inout] valueArray  values to be adapted by function
+         * @param[in]    count       number of values
+         */
+        void applyBlock (INOUT AudioSample* valueArray,
+                         IN Natural count) const;
+
+        /*--------------------*/
+
+        /**
+         * Tells whether the transfer function is the identity, i.e.
+         * the gain is one for all values (for a ratio of one and no
+         * out gain).
+         *
+         * @return  information whether function is the identity
+         */
+        Boolean isIdentity () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the upper limit of the linear region: for all
+         * values up to this limit the function returns the constant
+         * <C>linearRegionGain()</C> (exactly, also via the table).
+         *
+         * @return  maximum value within linear region
+         */
+        Real linearRegionLimit () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the constant result of the function for all values
+         * in the linear region.
+         *
+         * @return  gain within linear region
+         */
+        Real linearRegionGain () const;
+
+        /*--------------------*/
+
+        /**
+         * Sets up a lookup table for the transfer function with
+         * <C>entriesPerOctave</C> entries per octave of the input
+         * value (zero disables the table); if <C>isValidated</C> is
+         * set, each rebuild of the table compares it against the
+         * exact segment evaluation.  Allocates the table, so this
+         * must not be called on the audio thread.
+         *
+         * @param[in] entriesPerOctave  the table resolution
+         * @param[in] isValidated       tells whether table is
+         *                              checked against exact
+         *                              evaluation
+         */
+        void setTable (IN Natural entriesPerOctave,
+                       IN Boolean isValidated);
+
+        /*--------------------*/
+
+        /**
+         * Returns the maximum deviation in decibels of the lookup
+         * table from the exact evaluation found by the last
+         * validation (zero without validation).
+         *
+         * @return  maximum table deviation in decibels
+         */
+        Real tableDeviation () const;
+
+        /*--------------------*/
+
+        /**
+         * Tells whether the segment evaluation uses the fast
+         * logarithm and exponential approximations instead of the
+         * exact functions (see <C>FastMath</C> for the error
+         * bounds).
+         *
+         * @param[in] isEnabled  tells whether fast math is used
+         */
+        void setFastMath (IN Boolean isEnabled);
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of bytes of the segment list and the
+         * lookup table on the heap (without the transfer function
+         * object itself).
+         *
+         * @return  count of owned bytes
+         */
+        Natural byteCount () const;
+
         /*====================*/
 
         private:
@@ -307,6 +605,9 @@ namespace SoXPlugins::Effects::SoXCompander {
               * function */
             Real _dBKnee;
 
+            /** tells whether the function is the identity */
+            Boolean _isIdentity;
+
             /*--------------------*/
 
             /** Adapts curve segments in current transfer function by the
@@ -339,10 +640,64 @@ namespace SoXPlugins::Effects::SoXCompander {
 
             /*--------------------*/
 
+            /** Applies transfer function to <C>value</C> by
+              * evaluating the segments */
+            Real _applyExactly (IN Real value) const;
+
+            /*--------------------*/
+
+            /** Returns the input value for fractional table
+              * <C>position</C> */
+            Real _tableInputValue (IN Real position) const;
+
+            /*--------------------*/
+
+            /** Recalculates the lookup table (if any) from the
+              * segments and validates it when requested */
+            void _updateTable ();
+
+            /*--------------------*/
+
+            /** the lookup table of function results; the entries
+             * are equidistant within each octave of the input value
+             * from the octave of the minimum input value up to 1 */
+            RealList _table;
+
+            /** the number of table entries per octave (zero when
+             * there is no table) */
+            Natural _entriesPerOctave;
+
+            /** the number of table entries in use */
+            Natural _tableLength;
+
+            /** the binary exponent of the first table octave */
+            Integer _minimumExponent;
+
+            /** tells whether the table is checked against the exact
+             * evaluation on each rebuild */
+            Boolean _tableIsValidated;
+
+            /** the maximum table deviation in decibels found by the
+             * last validation */
+            Real _tableDeviation;
+
+            /** tells whether the segment evaluation uses fast
+             * approximations of logarithm and exponential */
+            Boolean _usesFastMath;
+
+            /*--------------------*/
+
             /** initial offset of first segment relative to threshold
              * point */
             static const Real _leftDbOffset;
 
+            /** the maximum number of octaves covered by the lookup
+             * table */
+            static const Natural _maximumOctaveCount;
+
+            /** the maximum number of table entries per octave */
+            static const Natural _maximumEntriesPerOctave;
+
     };
 
     /*=============================*/
@@ -403,247 +758,667 @@ namespace SoXPlugins::Effects::SoXCompander {
         /*--------------------*/
 
         /**
-         * Applies compander to all channels based on samples from
-         * <C>inputSampleList</C> and returns them in
-         * <C>outputSampleList</C>; if <C>outputValuesAreSummed</C> is
-         * set, the output samples are summed up into
-         * <C>outputSampleList</C>.
+         * Applies compander in place to the first <C>count</C>
+         * samples of the first <C>channelCount</C> channels in
+         * <C>buffer</C>; the volume integration runs sample by
+         * sample in local variables.  For linked channels a single
+         * envelope follows the maximum absolute sample of each
+         * frame and its gain is multiplied onto all channels, hence
+         * the envelope and gain cost do not depend on the channel
+         * count.  When <C>keyArray</C> is set, the envelopes follow
+         * its values instead of the samples in <C>buffer</C>.  With
+         * a lookahead the gains are derived from the undelayed
+         * samples, but applied to the samples delayed by the
+         * lookahead.
+         *
+         * Two cases skip work: for an identity transfer function
+         * the samples are only delayed by the lookahead (the
+         * envelope is not followed, but it restarts anyway from
+         * its initial volume on the next <C>adapt</C>); when all
+         * envelope values of a block lie in the linear region of
+         * the transfer function, its evaluation is replaced by the
+         * constant gain of that region (and the multiplication is
+         * dropped for a unit gain).  Both give the same samples as
+         * the full evaluation.
          *
-         * @param[in]  inputSampleList       the list of samples for all
-         *                                   input channels
-         * @param[out] outputSampleList      the list of samples for all
-         *                                   output channels
-         * @param[in] outputValuesAreSummed  tells whether old values
-         *                                   are kept in output sample
-         *                                   list
+         * @param[inout] buffer        the samples for all channels
+         * @param[in]    channelCount  the number of channels
+         * @param[in]    count         the number of samples per channel
+         * @param[in]    keyArray      the external detector values
+         *                             per frame (or nullptr)
          */
-        void apply (IN AudioSampleList& inputSampleList,
-                    OUT AudioSampleList& outputSampleList,
-                    IN bool outputValuesAreSummed);
+        void applyBlock (INOUT AudioSampleListVector& buffer,
+                         IN Natural channelCount,
+                         IN Natural count,
+                         IN AudioSample* keyArray);
 
         /*--------------------*/
 
         /**
-         * Sets number of channels to <C>channelCount</C>.
+         * Sets number of channels to <C>channelCount</C> and the
+         * maximum number of samples per block to
+         * <C>blockLength</C>.
          *
          * @param[in] channelCount  the new channel count for compander
+         * @param[in] blockLength   the maximum number of samples per
+         *                          channel in <C>applyBlock</C>
          */
-        void setLength (IN Natural channelCount);
-
-        /*====================*/
-
-        private:
-
-            /** the transfer function to be applied */
-            _TransferFunction _transferFunction;
-
-            /** tells whether all channels are combined for compression */
-            Boolean _channelsAreAggregated;
+        void setLength (IN Natural channelCount,
+                        IN Natural blockLength);
 
-            /** list of attack times for all channels */
-            RealList _attackTimeList;
-
-            /** list of release times for all channels */
-            RealList _releaseTimeList;
-
-            /** list of volumes for all channels */
-            RealList _volumeList;
-
-            /*--------------------*/
-            /*--------------------*/
-
-            /**
-             * Adapts envelope time <C>t</C> in seconds into a delta
-             * value relative to <C>sampleRate</C>.
-             *
-             * @param[in] t           envelope time in seconds
-             * @param[in] sampleRate  sample rate of effect
-             * @return  delta value relative to sample rate
-             */
-            static Real _adaptEnvelopeTime (IN Real t,
-                                            IN Real sampleRate);
-
-            /*--------------------*/
-
-            /**
-             * Adapts current volume of compander for <C>channel</C>
-             * within attack-release curve from <C>inputVolume</C> by
-             * some integration.
-             *
-             * @param[in] channel      compander channel to be
-             *                         integrated
-             * @param[in] inputVolume  current input volume
-             */
-            void _integrateVolume (IN Natural channel,
-                                   IN Real inputVolume);
-
-            /*--------------------*/
+        /*--------------------*/
 
-            /**
-             * Finds and returns maximum absolute sample among all
-             * samples in <C>sampleList</C>.
-             *
-             * @param[in] sampleList  audio sample list to be scanned
-             * @return  maximum absolute sample value
-             */
-            static AudioSample _maximumAbsoluteSample (
-                IN AudioSampleList& sampleList);
+        /**
+         * Copies the envelope volume and the lookahead delay line
+         * of the first channel to all other channels.
+         */
+        void copyFirstChannelState ();
 
-    };
+        /*--------------------*/
 
-    /*=======================*/
-    /* Linkwitz-Riley Filter */
-    /*=======================*/
+        /**
+         * Resets the envelope volumes and gains of all channels to
+         * their initial values and clears the lookahead delay
+         * lines.
+         */
+        void clear ();
 
-    /**
-     * A <C>_LRFilter</C> object is a Linkwitz-Riley filter of order
-     * 5.
-     */
-    struct _LRFilter : IIRFilter {
+        /*--------------------*/
 
-        /** the order of the filter */
-        static const Natural order;
+        /**
+         * Sets the lookahead of the compander to
+         * <C>sampleCount</C> samples: the signal path is delayed by
+         * this count while the envelope follows the undelayed
+         * signal; the delay lines are cleared.
+         *
+         * @param[in] sampleCount  the lookahead in samples
+         */
+        void setLookahead (IN Natural sampleCount);
 
-        /*--------------------*/
         /*--------------------*/
 
         /**
-         * Constructs a 4th order Linkwitz-Riley filter as an IIR
-         * filter
+         * Sets up a lookup table for the transfer function with
+         * <C>entriesPerOctave</C> entries per octave (zero disables
+         * the table) validated against the exact evaluation when
+         * <C>isValidated</C> is set.
+         *
+         * @param[in] entriesPerOctave  the table resolution
+         * @param[in] isValidated       tells whether table is
+         *                              checked against exact
+         *                              evaluation
          */
-        _LRFilter ();
+        void setTransferFunctionTable (IN Natural entriesPerOctave,
+                                       IN Boolean isValidated);
 
         /*--------------------*/
 
         /**
-         * Sets up Linkwitz-Riley filter by using plain coefficients
-         * from <C>coefficientListA</C> and <C>coefficientListB</C>.
+         * Returns the maximum deviation in decibels of the transfer
+         * function table from the exact evaluation.
          *
-         * @param[in] coefficientListA  first LR coefficient list
-         * @param[in] coefficientListB  second LR coefficient list
+         * @return  maximum table deviation in decibels
          */
-        void adapt (IN RealList& coefficientListA,
-                    IN RealList& coefficientListB);
+        Real transferFunctionTableDeviation () const;
 
-    };
+        /*--------------------*/
 
-    /*===============================================*/
-    /* Crossover Filter (Linkwitz - Riley 4th order) */
-    /*===============================================*/
+        /**
+         * Tells whether the transfer function uses fast logarithm
+         * and exponential approximations.
+         *
+         * @param[in] isEnabled  tells whether fast math is used
+         */
+        void setFastMath (IN Boolean isEnabled);
 
-    /**
-     * A <C>_LRCrossoverFilter</C> object is a crossover filter
-     * consisting of two Linkwitz-Riley filters with the same
-     * frequency; one is a lowpass, another one is a highpass.
-     */
-    struct _LRCrossoverFilter {
+        /*--------------------*/
 
         /**
-         * Makes a Linkwitz-Riley 4th order crossover filter
+         * Sets the decimation of the detector to <C>factor</C>
+         * (one for a detector at full sample rate): the detector
+         * values are reduced to their maximum over windows of
+         * <C>factor</C> frames, envelope and transfer function are
+         * evaluated once per window and the gains are linearly
+         * interpolated back to the sample rate.
+         *
+         * @param[in] factor  the number of frames per detector
+         *                    window
          */
-        _LRCrossoverFilter ();
+        void setDetectorDecimation (IN Natural factor);
 
         /*--------------------*/
 
         /**
-         * Returns the string representation of current
-         * Linkwitz-Riley crossover filter.
+         * Sets the control rate of the gain to one gain computation
+         * per <C>sampleCount</C> frames (one for a gain per frame,
+         * zero for an interval derived from the attack time): the
+         * detector and the envelope still run at full sample rate,
+         * but the transfer function is only evaluated for the last
+         * frame of each interval and the gain is ramped linearly in
+         * between.  A decimated detector takes precedence.
          *
-         * @return  string representation
+         * @param[in] sampleCount  the number of frames per gain
+         *                         computation
          */
-        String toString () const;
+        void setGainInterval (IN Natural sampleCount);
 
         /*--------------------*/
 
         /**
-         * Initializes a Linkwitz-Riley 4th order crossover filter at
-         * <C>frequency</C> consisting of a lowpass, highpass and allpass
-         * into current filter using <C>sampleRate</C>.
+         * Returns the maximum gain reduction in decibels (relative
+         * to the out gain) of all blocks since the last call and
+         * restarts the measurement; zero when no block has been
+         * processed since.
          *
-         * @param[in] frequency   the crossover frequency of the filter
-         * @param[in] sampleRate  the sample rate in the filter
+         * @return  gain reduction in decibels
          */
-        void adapt (IN Real frequency, IN Real sampleRate);
+        Real takeGainReduction ();
 
         /*--------------------*/
 
         /**
-         * Applies current LR4 crossover filter to <C>inputBuffer</C>
-         * and <C>outputBufferLow</C> and <C>outputBufferHigh</C>;
-         * assumes that first entry in input buffer is current sample
-         * and writes results sample into top of output buffers.
+         * Returns the number of bytes of the compander lists and
+         * its lookahead buffers on the heap (without the compander
+         * object itself).
          *
-         * @param[in]  inputBuffer       input sample buffer
-         * @param[out] outputBufferLow   sample buffer for low filter output
-         * @param[out] outputBufferHigh  sample buffer for high filter output
+         * @return  count of owned bytes
          */
-        void apply (IN AudioSampleRingBuffer& inputBuffer,
-                    OUT AudioSampleRingBuffer& outputBufferLow,
-                    OUT AudioSampleRingBuffer& outputBufferHigh);
+        Natural byteCount () const;
 
         /*--------------------*/
 
         /**
-         * Sets crossover filter to identity lowpass and rejecting
-         * highpass
+         * Returns the number of bytes of the lookahead buffers of
+         * the compander on the heap.
+         *
+         * @return  count of bytes in lookahead buffers
          */
-        void setToIdentity ();
+        Natural lookaheadByteCount () const;
 
         /*====================*/
 
         private:
 
-            /** the lowpass filter for this crossover */
-            _LRFilter _lowpassFilter;
+            /** the transfer function to be applied */
+            _TransferFunction _transferFunction;
+
+            /** the linear out gain of the transfer function */
+            Real _outGainFactor;
+
+            /** the minimum gain applied to a frame since the last
+             * gain reduction query (infinity for none) */
+            Real _minimumGain;
+
+            /** tells whether all channels are combined for compression */
+            Boolean _channelsAreAggregated;
+
+            /** list of attack times for all channels */
+            RealList _attackTimeList;
+
+            /** list of release times for all channels */
+            RealList _releaseTimeList;
+
+            /** list of volumes for all channels */
+            RealList _volumeList;
 
+            /** the gain per frame of a block (holding the detector
+             * values and then the envelope before) */
+            AudioSampleList _gainList;
+
+            /** the delay line per channel on the signal path for a
+             * lookahead (with length zero for none) */
+            AudioSampleRingBufferVector _delayLineVector;
+
+            /** the delayed samples of a channel for a block */
+            AudioSampleList _delayedList;
+
+            /** the number of frames per detector window (one for
+             * full sample rate) */
+            Natural _decimationFactor;
+
+            /** the number of frames per gain computation (one for
+             * a gain per frame, zero for automatic) */
+            Natural _gainInterval;
+
+            /** the detector values, envelopes and gains per detector
+             * window or gain interval of a block */
+            AudioSampleList _windowList;
+
+            /** list of the last gains of a block for all channels
+             * (the start of the gain interpolation in the next
+             * block) */
+            RealList _previousGainList;
+
+            /*--------------------*/
             /*--------------------*/
 
-            /** the highpass filter for this crossover */
-            _LRFilter _highpassFilter;
+            /**
+             * Replaces the <C>count</C> detector values in
+             * <C>gainArray</C> by the gains per frame, either at
+             * full sample rate or decimated, depending on the
+             * detector decimation; <C>volume</C> and
+             * <C>previousGain</C> are the envelope value and the
+             * gain before the block and are updated to those after
+             * the block.  When all envelope values lie in the linear
+             * region of the transfer function, <C>gainArray</C> is
+             * left unchanged and true is returned.
+             *
+             * @param[inout] gainArray     the detector values
+             *                             replaced by gains per
+             *                             frame
+             * @param[in]    count         the number of values
+             * @param[inout] volume        envelope value before and
+             *                             after the block
+             * @param[inout] previousGain  gain before and after the
+             *                             block
+             * @param[in]    attackTime    delta value for rising
+             *                             volume per frame
+             * @param[in]    releaseTime   delta value for falling
+             *                             volume per frame
+             * @return  information whether the gain is constant for
+             *          the block
+             */
+            Boolean _envelopeGains (INOUT AudioSample* gainArray,
+                                    IN Natural count,
+                                    INOUT Real& volume,
+                                    INOUT Real& previousGain,
+                                    IN Real attackTime,
+                                    IN Real releaseTime);
+
+            /*--------------------*/
+
+            /**
+             * Replaces the <C>count</C> detector values in
+             * <C>gainArray</C> by gains calculated from a decimated
+             * detector: the maximum detector value per window is
+             * followed by the envelope with the deltas for a
+             * complete window, the transfer function is applied per
+             * window and the gains are linearly interpolated from
+             * <C>previousGain</C> to the gain at the end of each
+             * window.  A final window shorter than the decimation
+             * factor uses the deltas for its length.
+             *
+             * @param[inout] gainArray     the detector values
+             *                             replaced by gains per
+             *                             frame
+             * @param[in]    count         the number of values
+             * @param[inout] volume        envelope value before and
+             *                             after the block
+             * @param[inout] previousGain  gain before and after the
+             *                             block
+             * @param[in]    attackTime    delta value for rising
+             *                             volume per frame
+             * @param[in]    releaseTime   delta value for falling
+             *                             volume per frame
+             * @return  information whether the gain is constant for
+             *          the block
+             */
+            Boolean _decimatedGains (INOUT AudioSample* gainArray,
+                                     IN Natural count,
+                                     INOUT Real& volume,
+                                     INOUT Real& previousGain,
+                                     IN Real attackTime,
+                                     IN Real releaseTime);
+
+            /*--------------------*/
+
+            /**
+             * Returns the number of frames per gain computation for
+             * envelope delta <C>attackTime</C>: one for a decimated
+             * detector, otherwise the gain interval or, when that is
+             * automatic, an eighth of the attack time constant in
+             * frames (at most
+             * <C>_maximumAutomaticGainInterval</C>).
+             *
+             * @param[in] attackTime  delta value for rising volume
+             *                        per frame
+             * @return  number of frames per gain computation
+             */
+            Natural _effectiveGainInterval (IN Real attackTime) const;
+
+            /*--------------------*/
+
+            /**
+             * Replaces the <C>count</C> detector values in
+             * <C>gainArray</C> by their envelope and stores the gains
+             * of the transfer function for the last frame of each
+             * interval of <C>interval</C> frames in the window list
+             * (the final interval may be shorter); <C>volume</C> and
+             * <C>previousGain</C> are the envelope value and the gain
+             * before the block and are updated to those after the
+             * block.  When all those envelope values lie in the
+             * linear region of the transfer function, true is
+             * returned.
+             *
+             * @param[inout] gainArray     the detector values
+             *                             replaced by envelope
+             *                             values
+             * @param[in]    count         the number of values
+             * @param[inout] volume        envelope value before and
+             *                             after the block
+             * @param[inout] previousGain  gain before and after the
+             *                             block
+             * @param[in]    attackTime    delta value for rising
+             *                             volume per frame
+             * @param[in]    releaseTime   delta value for falling
+             *                             volume per frame
+             * @param[in]    interval      the number of frames per
+             *                             gain computation
+             * @return  information whether the gain is constant for
+             *          the block
+             */
+            Boolean _controlRateGains (INOUT AudioSample* gainArray,
+                                       IN Natural count,
+                                       INOUT Real& volume,
+                                       INOUT Real& previousGain,
+                                       IN Real attackTime,
+                                       IN Real releaseTime,
+                                       IN Natural interval);
+
+            /*--------------------*/
+
+            /**
+             * Sets the first <C>count</C> samples in
+             * <C>sampleArray</C> to the samples in
+             * <C>delayedArray</C> multiplied by a gain ramp per
+             * interval of <C>interval</C> frames: the ramp of an
+             * interval starts at the gain at the end of the previous
+             * interval (<C>startGain</C> for the first one) and ends
+             * at the gain for the interval in the window list.
+             *
+             * @param[out] sampleArray   the resulting samples
+             * @param[in]  delayedArray  the (delayed) input samples
+             * @param[in]  count         the number of samples
+             * @param[in]  startGain     the gain before the block
+             * @param[in]  interval      the number of frames per
+             *                           gain computation
+             */
+            void _applyGainRamps (OUT AudioSample* sampleArray,
+                                  IN AudioSample* delayedArray,
+                                  IN Natural count,
+                                  IN Real startGain,
+                                  IN Natural interval) const;
+
+            /*--------------------*/
+
+            /**
+             * Returns the envelope delta for <C>frameCount</C>
+             * frames derived from the delta <C>time</C> for a
+             * single frame.
+             *
+             * @param[in] time        delta value for a single frame
+             * @param[in] frameCount  the number of frames
+             * @return  delta value for all frames together
+             */
+            static Real _windowEnvelopeTime (IN Real time,
+                                             IN Natural frameCount);
+
+            /**
+             * Replaces the <C>count</C> envelope values in
+             * <C>gainArray</C> by the gains of the transfer function
+             * and lowers the minimum gain accordingly; when all
+             * envelope values lie in the linear region of the
+             * transfer function, <C>gainArray</C> is left unchanged
+             * and true is returned, because the gain is the constant
+             * gain of that region.
+             *
+             * @param[inout] gainArray  the envelope values replaced
+             *                          by gains per frame
+             * @param[in]    count      the number of values
+             * @return  information whether the gain is constant for
+             *          the block
+             */
+            Boolean _calculateGains (INOUT AudioSample* gainArray,
+                                     IN Natural count);
+
+            /*--------------------*/
+
+            /**
+             * Sets the first <C>count</C> samples in
+             * <C>sampleArray</C> to the samples in
+             * <C>delayedArray</C> multiplied by the gains in
+             * <C>gainArray</C> or by the constant gain of the
+             * linear region of the transfer function when
+             * <C>gainIsConstant</C> is set.
+             *
+             * @param[out] sampleArray     the resulting samples
+             * @param[in]  delayedArray    the (delayed) input samples
+             * @param[in]  gainArray       the gains per frame
+             * @param[in]  count           the number of samples
+             * @param[in]  gainIsConstant  information whether the
+             *                             linear region gain applies
+             */
+            void _applyGains (OUT AudioSample* sampleArray,
+                              IN AudioSample* delayedArray,
+                              IN AudioSample* gainArray,
+                              IN Natural count,
+                              IN Boolean gainIsConstant) const;
+
+            /*--------------------*/
+
+            /**
+             * Lowers the minimum gain by the first <C>count</C>
+             * gains in <C>gainArray</C>.
+             *
+             * @param[in] gainArray  the gains per frame
+             * @param[in] count      the number of gains
+             */
+            void _trackMinimumGain (IN AudioSample* gainArray,
+                                    IN Natural count);
+
+            /*--------------------*/
+
+            /**
+             * Adapts envelope time <C>t</C> in seconds into a delta
+             * value relative to <C>sampleRate</C>.
+             *
+             * @param[in] t           envelope time in seconds
+             * @param[in] sampleRate  sample rate of effect
+             * @return  delta value relative to sample rate
+             */
+            static Real _adaptEnvelopeTime (IN Real t,
+                                            IN Real sampleRate);
+
+            /*--------------------*/
+
+            /**
+             * Returns the first <C>count</C> samples of
+             * <C>sampleArray</C> for <C>channel</C> delayed by the
+             * lookahead and updates the delay line of the channel;
+             * without lookahead <C>sampleArray</C> itself is
+             * returned.
+             *
+             * @param[in] channel      the channel of the samples
+             * @param[in] sampleArray  the undelayed samples
+             * @param[in] count        the number of samples
+             * @return  array of delayed samples
+             */
+            const AudioSample* _delayedSamples (IN Natural channel,
+                                                IN AudioSample* sampleArray,
+                                                IN Natural count);
+
+            /*--------------------*/
+
+            /**
+             * Replaces the <C>count</C> detector values in
+             * <C>valueArray</C> by the envelope following them:
+             * starting at <C>volume</C>, each value integrates the
+             * envelope within the attack-release curve with deltas
+             * <C>attackTime</C> and <C>releaseTime</C>;
+             * <C>volume</C> is set to the final envelope value.
+             * The recursion is kept in plain double registers and
+             * selects the delta without a branch.
+             *
+             * @param[inout] valueArray   detector values replaced by
+             *                            envelope values
+             * @param[in]    count        number of values
+             * @param[inout] volume       envelope value before and
+             *                            after the block
+             * @param[in]    attackTime   delta value for rising
+             *                            volume
+             * @param[in]    releaseTime  delta value for falling
+             *                            volume
+             */
+            static void _followEnvelope (INOUT AudioSample* valueArray,
+                                         IN Natural count,
+                                         INOUT Real& volume,
+                                         IN Real attackTime,
+                                         IN Real releaseTime);
+
+            /*--------------------*/
+
+            /**
+             * Sets the first <C>count</C> entries of
+             * <C>maximumArray</C> to the maximum absolute sample over
+             * the first <C>channelCount</C> channels of
+             * <C>buffer</C> in each frame; the channels are scanned
+             * one after the other on contiguous samples.
+             *
+             * @param[in]  buffer        the samples for all channels
+             * @param[in]  channelCount  the number of channels
+             * @param[in]  count         the number of samples per
+             *                           channel
+             * @param[out] maximumArray  the maximum absolute sample
+             *                           per frame
+             */
+            static void
+            _maximumAbsoluteSample (IN AudioSampleListVector& buffer,
+                                    IN Natural channelCount,
+                                    IN Natural count,
+                                    OUT AudioSample* maximumArray);
 
     };
 
     /*=======================*/
-    /* _CompanderStreamKind */
+    /* Linkwitz-Riley Filter */
     /*=======================*/
 
     /**
-     * The <C>_CompanderStreamKind</C> type is an enumeration for the
-     * kind of audio sample streams relevant for a compander band:
-     * input, lowOutput and highOutput as input for the next band
-    */
-    typedef size_t _CompanderStreamKind;
-    static _CompanderStreamKind _kindInputStream      = 0;
-    static _CompanderStreamKind _kindLowOutputStream  = 1;
-    static _CompanderStreamKind _kindHighOutputStream = 2;
+     * A <C>_LRFilter</C> object is a Linkwitz-Riley filter of order
+     * 5.
+     */
+    struct _LRFilter : IIRFilterN<5> {
+
+        /** the order of the filter */
+        static const Natural order;
 
-    /** the count of stream kinds */
-    constexpr size_t _companderStreamKindCount = 3;
+        /** the coefficients of a biquad polynomial (fixed size,
+         * hence a coefficient update does not allocate) */
+        using BiquadCoefficientList = array<Real, 3>;
 
-    /** a map from stream kind to string */
-    String _streamKindAsString[] = { "input", "lowOutput", "highOutput" };
+        /*--------------------*/
+        /*--------------------*/
 
-    /*========================*/
-    /* _CompanderSampleBuffer */
-    /*========================*/
+        /**
+         * Constructs a 4th order Linkwitz-Riley filter as an IIR
+         * filter
+         */
+        _LRFilter ();
 
-    /**
-     * A <C>_CompanderSampleBufferElement</C> object contains pointers
-     * to a buffer for input, low and high output samples; it is the
-     * element type in a <B>_CompanderSampleBuffer</B>.
-     */
-    using _CompanderSampleBufferElement =
-        array<AudioSampleRingBuffer*, _companderStreamKindCount>;
+        /*--------------------*/
+
+        /**
+         * Sets up Linkwitz-Riley filter by using plain coefficients
+         * from <C>coefficientListA</C> and <C>coefficientListB</C>
+         * (the numerator and denominator of the biquad squared by
+         * the filter).
+         *
+         * @param[in] coefficientListA  first LR coefficient list
+         * @param[in] coefficientListB  second LR coefficient list
+         */
+        void adapt (IN BiquadCoefficientList& coefficientListA,
+                    IN BiquadCoefficientList& coefficientListB);
+
+        /*--------------------*/
+
+        /**
+         * Returns the normalized coefficient with <C>index</C> (first
+         * the b's, then the a's).
+         *
+         * @param[in] index  the index of the coefficient
+         * @return  coefficient value
+         */
+        Real coefficient (IN Natural index) const;
+
+    };
+
+    /*===============================================*/
+    /* Crossover Filter (Linkwitz - Riley 4th order) */
+    /*===============================================*/
 
     /**
-     * A <C>_CompanderSampleBuffer</C> object contains pointers to the
-     * buffers for input, low and high output samples for each channel
-     * in a crossover band; the input buffer of the first band contain
-     * the input samples, the following bands use the high output of
-     * the previous crossover band
+     * A <C>_LRCrossoverFilter</C> object is a crossover filter
+     * consisting of two Linkwitz-Riley filters with the same
+     * frequency; one is a lowpass, another one is a highpass.
      */
-    using _CompanderSampleBuffer =
-        GenericList<_CompanderSampleBufferElement>;
+    struct _LRCrossoverFilter {
+
+        /**
+         * Makes a Linkwitz-Riley 4th order crossover filter
+         */
+        _LRCrossoverFilter ();
+
+        /*--------------------*/
+
+        /**
+         * Returns the string representation of current
+         * Linkwitz-Riley crossover filter.
+         *
+         * @return  string representation
+         */
+        String toString () const;
+
+        /*--------------------*/
+
+        /**
+         * Initializes a Linkwitz-Riley 4th order crossover filter at
+         * <C>frequency</C> consisting of a lowpass, highpass and allpass
+         * into current filter using <C>sampleRate</C>.
+         *
+         * @param[in] frequency   the crossover frequency of the filter
+         * @param[in] sampleRate  the sample rate in the filter
+         */
+        void adapt (IN Real frequency, IN Real sampleRate);
+
+        /*--------------------*/
+
+        /**
+         * Returns the lowpass filter of the crossover.
+         *
+         * @return  lowpass filter
+         */
+        const _LRFilter& lowpassFilter () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the highpass filter of the crossover.
+         *
+         * @return  highpass filter
+         */
+        const _LRFilter& highpassFilter () const;
+
+        /*--------------------*/
+
+        /**
+         * Sets crossover filter to identity lowpass and rejecting
+         * highpass
+         */
+        void setToIdentity ();
+
+        /*====================*/
+
+        private:
+
+            /** the lowpass filter for this crossover */
+            _LRFilter _lowpassFilter;
+
+            /*--------------------*/
+
+            /** the highpass filter for this crossover */
+            _LRFilter _highpassFilter;
+
+    };
 
     /*=================*/
     /* _MCompanderBand */
@@ -651,12 +1426,21 @@ namespace SoXPlugins::Effects::SoXCompander {
 
     /**
      * A <C>_MCompanderBand</C> object is a single band in a multiband
-     * compander consisting of a compander and sample buffers for the
-     * crossover filter.
+     * compander consisting of a compander, a crossover filter and a
+     * sample buffer for a block of the band signal.
+     *
+     * For each channel the crossover bank of the multiband compander
+     * splits a block of the input signal into the low output (kept
+     * in the band buffer) and the high output (the input for the
+     * next band); companding is then done on the band buffer only
      *
-     * For each channel the crossover calculation is done on an input
-     * buffer resulting in low output and high output (for the next
-     * band), companding is done on the input buffer only
+     * A band with a low top frequency may be companded at a reduced
+     * rate: the band signal is decimated by half-band filters, the
+     * compander runs at the reduced rate and its output is
+     * interpolated back into the band buffer.  Samples not forming a
+     * complete group of the decimation are kept for the next block,
+     * hence any block length works with a constant delay.  A
+     * compensation delay aligns the band with the others.
      */
     struct _MCompanderBand {
 
@@ -668,35 +1452,37 @@ namespace SoXPlugins::Effects::SoXCompander {
         /*--------------------*/
 
         /**
-         * Returns the string representation of current compander band.
-         *
-         * @return  string representation
+         * Destroys the multiband compander band
          */
-        String toString () const;
+        ~_MCompanderBand ();
+
+        /*--------------------*/
+
+        _MCompanderBand (IN _MCompanderBand&) = delete;
 
         /*--------------------*/
 
         /**
-         * Sets channel count for compander band to
-         * <C>channelCount</C>.
+         * Returns the string representation of current compander band.
          *
-         * @param[in] channelCount  the new channel count for band
+         * @return  string representation
          */
-        void setChannelCount (IN Natural channelCount);
+        String toString () const;
 
         /*--------------------*/
 
         /**
-         * Sets stream buffer for compander band for <C>channel</C> and
-         * <C>stream</C> to <C>buffer</C>.
+         * Sets channel count for compander band to
+         * <C>channelCount</C> with a band buffer of
+         * <C>blockLength</C> samples per channel; the state for the
+         * reduced rate is resized when reserved before.
          *
-         * @param[in] channel  channel of band to be changed
-         * @param[in] stream   stream of band to be changed
-         * @param[in] buffer    buffer to be assigned to this position
+         * @param[in] channelCount  the new channel count for band
+         * @param[in] blockLength   the maximum number of samples in
+         *                          a block
          */
-        void setBuffer (IN Natural channel,
-                       IN _CompanderStreamKind stream,
-                       AudioSampleRingBuffer* buffer);
+        void setChannelCount (IN Natural channelCount,
+                              IN Natural blockLength);
 
         /*--------------------*/
 
@@ -740,1044 +1526,4491 @@ namespace SoXPlugins::Effects::SoXCompander {
         /*--------------------*/
 
         /**
-         * Applies band compander to internal input stream and updates
-         * <C>outputSampleList</C> (by adding resulting values per
-         * channel).
+         * Returns the crossover filter separating this band from the
+         * higher bands.
          *
-         * @param[out] outputSampleList  the sample list to be written
-         *                               to
+         * @return  crossover filter of band
          */
-        void apply (OUT AudioSampleList& outputSampleList);
+        const _LRCrossoverFilter& crossoverFilter () const;
 
         /*--------------------*/
 
         /**
-         * Processes samples from input for band compander; updates
-         * associated sample buffers for low and high output of this
-         * band
+         * Returns the top crossover frequency of this band.
+         *
+         * @return  top frequency of band in Hz
          */
-        void calculateCrossover ();
+        Real topFrequency () const;
 
-        /*--------------------*/
         /*--------------------*/
 
-        /** the maximum top frequency allowed for a band */
-        static const Real maxTopFrequency;
+        /**
+         * Returns the samples of the band buffer for
+         * <C>channel</C>.
+         *
+         * @param[in] channel  the channel of the band buffer
+         * @return  array of samples in band buffer
+         */
+        AudioSample* bufferArray (IN Natural channel);
 
-        /*====================*/
+        /*--------------------*/
 
-        private:
+        /**
+         * Applies band compander to the first <C>count</C> samples
+         * of the first <C>channelCount</C> channels in the band
+         * buffer; when <C>keyArray</C> is set, the envelope follows
+         * its values instead of the band signal.
+         *
+         * @param[in] channelCount  the number of channels processed
+         * @param[in] count         the number of samples per channel
+         * @param[in] keyArray      the external detector values per
+         *                          frame (or nullptr)
+         */
+        void apply (IN Natural channelCount,
+                    IN Natural count,
+                    IN AudioSample* keyArray);
 
-            /** the number of channels in this compander band */
-            Natural _channelCount;
+        /*--------------------*/
 
-            /** the compander associated with this compander band */
-            _Compander _compander;
+        /**
+         * Adds the first <C>count</C> samples of the first
+         * <C>channelCount</C> channels of the band buffer to
+         * <C>outputBuffer</C> starting at <C>position</C>.
+         *
+         * @param[inout] outputBuffer  the buffer to be added to
+         * @param[in]    channelCount  the number of channels added
+         * @param[in]    position      the start position in output
+         *                             buffer
+         * @param[in]    count         the number of samples per
+         *                             channel
+         */
+        void addTo (INOUT AudioSampleListVector& outputBuffer,
+                    IN Natural channelCount,
+                    IN Natural position,
+                    IN Natural count) const;
 
-            /** the top frequency of this compander band */
-            Real _topFrequency;
+        /*--------------------*/
 
-            /** the top separation filter for this compander (for a
-             * multiband compander) */
-            _LRCrossoverFilter _crossoverFilter;
+        /**
+         * Copies the compander state of the first channel to all
+         * other channels.
+         */
+        void copyFirstChannelState ();
 
-            /** the sample list for the separation filter (for a
-             * multiband compander) */
-            _CompanderSampleBuffer _buffer;
+        /*--------------------*/
 
-            /** a temporary input sample list only used in the apply
-             * method*/
-            AudioSampleList _inputSampleList;
-    };
+        /**
+         * Resets the compander state and the state for the reduced
+         * rate of all channels.
+         */
+        void clear ();
+
+        /*--------------------*/
+
+        /**
+         * Sets up a lookup table for the transfer function of the
+         * band compander with <C>entriesPerOctave</C> entries per
+         * octave (zero disables the table) validated against the
+         * exact evaluation when <C>isValidated</C> is set.
+         *
+         * @param[in] entriesPerOctave  the table resolution
+         * @param[in] isValidated       tells whether table is
+         *                              checked against exact
+         *                              evaluation
+         */
+        void setTransferFunctionTable (IN Natural entriesPerOctave,
+                                       IN Boolean isValidated);
+
+        /*--------------------*/
+
+        /**
+         * Returns the maximum deviation in decibels of the transfer
+         * function table of the band compander from the exact
+         * evaluation.
+         *
+         * @return  maximum table deviation in decibels
+         */
+        Real transferFunctionTableDeviation () const;
+
+        /*--------------------*/
+
+        /**
+         * Tells whether the band compander uses fast logarithm and
+         * exponential approximations.
+         *
+         * @param[in] isEnabled  tells whether fast math is used
+         */
+        void setFastMath (IN Boolean isEnabled);
+
+        /*--------------------*/
+
+        /**
+         * Sets the detector decimation of the band compander to
+         * <C>factor</C> frames per detector window.
+         *
+         * @param[in] factor  the number of frames per detector
+         *                    window
+         */
+        void setDetectorDecimation (IN Natural factor);
+
+        /*--------------------*/
+
+        /**
+         * Sets the gain interval of the band compander to
+         * <C>sampleCount</C> frames per gain computation (zero for
+         * automatic).
+         *
+         * @param[in] sampleCount  the number of frames per gain
+         *                         computation
+         */
+        void setGainInterval (IN Natural sampleCount);
+
+        /*--------------------*/
+
+        /**
+         * Returns the maximum gain reduction in decibels of the
+         * band compander since the last call and restarts the
+         * measurement.
+         *
+         * @return  gain reduction in decibels
+         */
+        Real takeGainReduction ();
+
+        /*--------------------*/
+
+        /**
+         * Sets the lookahead of the band compander to
+         * <C>sampleCount</C> samples.
+         *
+         * @param[in] sampleCount  the lookahead in samples
+         */
+        void setLookahead (IN Natural sampleCount);
+
+        /*--------------------*/
+
+        /**
+         * Makes sure that the state for companding at a reduced rate
+         * (resamplers, group buffers and compensation delay lines)
+         * is allocated for the current channel count and block
+         * length; this allocates on the first call only.
+         */
+        void reserveMultirate ();
+
+        /*--------------------*/
+
+        /**
+         * Sets the factor by which the band signal is decimated for
+         * the compander to <C>factor</C> (one for the full rate);
+         * on a change the resamplers and the compander restart from
+         * silence.  A factor above one requires a prior
+         * <C>reserveMultirate</C>, then this does not allocate.
+         *
+         * @param[in] factor  the decimation factor (a power of two)
+         */
+        void setDecimationFactor (IN Natural factor);
+
+        /*--------------------*/
+
+        /**
+         * Returns the delay of this band relative to a band at full
+         * rate caused by its decimation.
+         *
+         * @return  additional delay in samples
+         */
+        Natural multirateLatency () const;
+
+        /*--------------------*/
+
+        /**
+         * Sets the delay appended to the band signal for aligning it
+         * with the other bands to <C>sampleCount</C> samples (at
+         * most <C>_maximumMultirateLatency()</C>) and clears the
+         * delay lines on a change; a nonzero delay requires a prior
+         * <C>reserveMultirate</C>.
+         *
+         * @param[in] sampleCount  the compensation delay in samples
+         */
+        void setLatencyCompensation (IN Natural sampleCount);
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of bytes allocated on the heap by the
+         * compander band (including the band object itself).
+         *
+         * @return  count of owned bytes
+         */
+        Natural byteCount () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of bytes of the lookahead buffers of
+         * the band compander on the heap.
+         *
+         * @return  count of bytes in lookahead buffers
+         */
+        Natural lookaheadByteCount () const;
+
+        /*--------------------*/
+        /*--------------------*/
+
+        /** the maximum top frequency allowed for a band */
+        static const Real maxTopFrequency;
+
+        /*====================*/
+
+        private:
+
+            /**
+             * Adapts the compander to the settings of the last
+             * <C>adapt</C> at the rate reduced by the decimation
+             * factor.
+             */
+            void _adaptCompander ();
+
+            /*--------------------*/
+
+            /**
+             * Sizes the state for companding at a reduced rate to
+             * the channel count and block length of the band.
+             */
+            void _allocateMultirateState ();
+
+            /*--------------------*/
+
+            /**
+             * Decimates the first <C>count</C> samples of the first
+             * <C>channelCount</C> channels in the band buffer
+             * (together with the pending samples of the last
+             * block), applies the compander at the reduced rate and
+             * replaces the band samples by the interpolated output;
+             * the detector values in <C>keyArray</C> (if set) are
+             * reduced to their maximum per group.
+             *
+             * @param[in] channelCount  the number of channels processed
+             * @param[in] count         the number of samples per channel
+             * @param[in] keyArray      the external detector values per
+             *                          frame (or nullptr)
+             */
+            void _applyDecimated (IN Natural channelCount,
+                                  IN Natural count,
+                                  IN AudioSample* keyArray);
+
+            /*--------------------*/
+
+            /**
+             * Delays the first <C>count</C> samples of the first
+             * <C>channelCount</C> channels in the band buffer by the
+             * compensation delay.
+             *
+             * @param[in] channelCount  the number of channels processed
+             * @param[in] count         the number of samples per channel
+             */
+            void _applyCompensation (IN Natural channelCount,
+                                     IN Natural count);
+
+            /*--------------------*/
+
+            /** the number of channels in this compander band */
+            Natural _channelCount;
+
+            /** the compander associated with this compander band */
+            _Compander _compander;
+
+            /** the top frequency of this compander band */
+            Real _topFrequency;
+
+            /** the top separation filter for this compander (for a
+             * multiband compander) */
+            _LRCrossoverFilter _crossoverFilter;
+
+            /** the band signal (low output of the crossover filter)
+             * for a block per channel */
+            AudioSampleListVector _buffer;
+
+            /** the sample rate of the band signal */
+            Real _sampleRate;
+
+            /** the compander settings of the last adaptation (attack,
+             * release, knee, threshold, ratio and gain), kept for an
+             * adaptation to another rate */
+            RealList _settingList;
+
+            /** the lookahead of the band in samples at full rate */
+            Natural _lookaheadSampleCount;
+
+            /** the factor by which the band signal is decimated for
+             * the compander (one for the full rate) */
+            Natural _decimationFactor;
+
+            /** tells whether the state for a reduced rate has been
+             * reserved */
+            Boolean _multirateIsReserved;
+
+            /** the resampler per channel between full and reduced
+             * rate */
+            GenericList<HalfBandOversampler*> _resamplerList;
+
+            /** the band samples per channel not yet forming a
+             * complete group for the decimation */
+            AudioSampleListVector _pendingBuffer;
+
+            /** the detector values of the pending samples */
+            AudioSampleList _pendingKeyList;
+
+            /** the number of pending samples per channel */
+            Natural _pendingSampleCount;
+
+            /** the band signal at the reduced rate for a block per
+             * channel */
+            AudioSampleListVector _reducedBuffer;
+
+            /** the detector values at the reduced rate for a
+             * block */
+            AudioSampleList _reducedKeyList;
+
+            /** the interpolated samples per channel not yet output;
+             * together with the pending samples these are always
+             * one group less one sample */
+            AudioSampleListVector _queueBuffer;
+
+            /** the number of queued samples per channel */
+            Natural _queuedSampleCount;
+
+            /** the delay lines per channel aligning the band (history
+             * first, then the samples of the current block) */
+            AudioSampleListVector _compensationBuffer;
+
+            /** the compensation delay in samples */
+            Natural _compensationSampleCount;
+    };
+
+    /*=====================*/
+    /* _MCompanderBandList */
+    /*=====================*/
+
+    /**
+     * A <C>_MCompanderBandList</C> is a pool of compander bands with
+     * a slot per possible band; a band is only allocated when it is
+     * reserved for the first time (otherwise its slot is
+     * <C>nullptr</C>) and kept afterwards, such that the slots never
+     * move and a band count change does not reallocate.
+     */
+    using _MCompanderBandList = GenericList<_MCompanderBand*>;
+
+    /*========================*/
+    /* Crossover Filter Bank */
+    /*========================*/
+
+    /**
+     * A <C>_LRCrossoverBank</C> object evaluates the crossover
+     * filters of all bands of a multiband compander together.  The
+     * coefficients and filter histories are held as a structure of
+     * arrays with the bands as innermost index ("lanes"), such that
+     * the lowpass and highpass sections of all bands are computed
+     * by one loop over the lanes which the compiler can vectorize.
+     *
+     * Because each band filters the highpass output of the previous
+     * band, the bands are evaluated as a wavefront: in step
+     * <C>t</C> lane <C>k</C> processes sample <C>t - k</C> whose
+     * input has been produced by lane <C>k - 1</C> in the step
+     * before.  The highpass output of the last band is never used,
+     * hence only the first <C>m - 1</C> of <C>m</C> bands take part
+     * in the wavefront and pass their final highpass output
+     * directly into the buffer of the last band; that one is then
+     * lowpass filtered in place (or left alone for an identity
+     * filter, the usual case for the unbounded last band).  A block
+     * of <C>n</C> samples hence takes <C>n + m - 2</C> steps plus
+     * one pass for the last band and yields exactly the results of
+     * the band-by-band evaluation.
+     */
+    struct _LRCrossoverBank {
+
+        /**
+         * Makes an empty crossover bank.
+         */
+        _LRCrossoverBank ();
+
+        /*--------------------*/
+
+        /**
+         * Returns the string representation of crossover bank.
+         *
+         * @return  string representation
+         */
+        String toString () const;
+
+        /*--------------------*/
+
+        /**
+         * Sets up crossover bank for <C>laneCount</C> bands and
+         * <C>channelCount</C> channels and clears all filter
+         * histories.
+         *
+         * @param[in] laneCount     the number of bands
+         * @param[in] channelCount  the number of channels
+         */
+        void resize (IN Natural laneCount,
+                     IN Natural channelCount);
+
+        /*--------------------*/
+
+        /**
+         * Sets coefficients of lane <C>laneIndex</C> from crossover
+         * filter <C>filter</C>.
+         *
+         * @param[in] laneIndex  the index of the band
+         * @param[in] filter     the crossover filter of the band
+         */
+        void setLane (IN Natural laneIndex,
+                      IN _LRCrossoverFilter& filter);
+
+        /*--------------------*/
+
+        /**
+         * Clears the filter histories of lane <C>laneIndex</C> for
+         * all channels (e.g. when its band becomes effective).
+         *
+         * @param[in] laneIndex  the index of the band
+         */
+        void clearLane (IN Natural laneIndex);
+
+        /*--------------------*/
+
+        /**
+         * Clears the filter histories of all lanes and channels.
+         */
+        void clear ();
+
+        /*--------------------*/
+
+        /**
+         * Copies the filter histories of the first channel to all
+         * other channels.
+         */
+        void copyFirstChannelState ();
+
+        /*--------------------*/
+
+        /**
+         * Splits the first <C>count</C> samples in
+         * <C>inputArray</C> for <C>channel</C> by the crossover
+         * filters of the first <C>bandCount</C> bands in
+         * <C>bandList</C>; the lowpass output of each band goes to
+         * the band buffer, the highpass output is the input of the
+         * next band.
+         *
+         * @param[in]    channel     the channel to be processed
+         * @param[in]    inputArray  the input signal of the first band
+         * @param[in]    count       the number of samples
+         * @param[inout] bandList    the list of compander bands
+         * @param[in]    bandCount   the number of effective bands
+         *                           (all reserved in band list)
+         */
+        void apply (IN Natural channel,
+                    IN AudioSample* inputArray,
+                    IN Natural count,
+                    INOUT _MCompanderBandList& bandList,
+                    IN Natural bandCount);
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of bytes allocated on the heap by the
+         * bank (including the bank object itself).
+         *
+         * @return  count of owned bytes
+         */
+        Natural byteCount () const;
+
+        /*====================*/
+
+        private:
+
+            /** the number of lanes (bands) in the bank */
+            Natural _laneCount;
+
+            /** the lowpass coefficients with index
+             * (coefficientIndex * laneCount + lane) */
+            AudioSampleList _lowpassCoefficientList;
+
+            /** the highpass coefficients with index
+             * (coefficientIndex * laneCount + lane) */
+            AudioSampleList _highpassCoefficientList;
+
+            /** the previous input samples of all lanes with index
+             * ((channel * historyLength + j) * laneCount + lane) */
+            AudioSampleList _inputHistoryList;
+
+            /** the previous lowpass output samples of all lanes with
+             * same index scheme as input history */
+            AudioSampleList _lowpassHistoryList;
+
+            /** the previous highpass output samples of all lanes with
+             * same index scheme as input history */
+            AudioSampleList _highpassHistoryList;
+
+            /** the inputs of all lanes in the current and the next
+             * wavefront step (2 * (laneCount + 1) entries) */
+            AudioSampleList _laneInputList;
+
+            /** the lowpass outputs of all lanes in the current
+             * wavefront step */
+            AudioSampleList _laneOutputList;
+
+            /** the band buffers of all lanes for the current
+             * channel */
+            GenericList<AudioSample*> _bandArrayList;
+
+            /** the number of previous samples kept per filter */
+            static const size_t _historyLength = 4;
+
+            /*--------------------*/
+
+            /**
+             * Filters the first <C>sampleCount</C> samples in
+             * <C>array</C> for <C>channel</C> in place by the lowpass
+             * of lane <C>laneIndex</C> only; an identity lowpass just
+             * updates the filter histories.
+             *
+             * @param[in]    channel      the channel to be processed
+             * @param[in]    laneIndex    the index of the band
+             * @param[inout] array        the samples to be filtered
+             * @param[in]    sampleCount  the number of samples
+             */
+            void _applyLowpassInPlace (IN Natural channel,
+                                       IN size_t laneIndex,
+                                       INOUT AudioSample* array,
+                                       IN size_t sampleCount);
+
+    };
+
+    /*==================================*/
+    /* Linear Phase FIR Crossover Bank */
+    /*==================================*/
+
+    /**
+     * A <C>_FIRCrossoverBank</C> object splits the signal into the
+     * bands of a multiband compander by linear-phase FIR filters
+     * evaluated as a uniformly partitioned FFT convolution
+     * (overlap-save).  The filter of a band is the difference of two
+     * windowed-sinc lowpasses at its bottom and top frequency, hence
+     * all bands add up to a pure delay of the input and have the
+     * same constant group delay.
+     *
+     * The input is collected in blocks of <C>partitionLength</C>
+     * samples; each block is transformed once per channel and kept
+     * in a frequency domain delay line, each band then multiplies
+     * the spectra of the last blocks with the spectra of its filter
+     * partitions and needs a single inverse transform.  Hence the
+     * cost per band is a complex multiply-add per bin and partition
+     * plus an inverse transform, independent of the crossover
+     * steepness.  The latency is a block plus half the filter
+     * length.
+     */
+    struct _FIRCrossoverBank {
+
+        /** the number of samples in a block and filter partition */
+        static const Natural partitionLength;
+
+        /** the number of filter taps on each side of the center tap
+         * (the group delay of the filters) */
+        static const Natural halfFilterLength;
+
+        /*--------------------*/
+
+        /**
+         * Makes an empty crossover bank.
+         */
+        _FIRCrossoverBank ();
+
+        /*--------------------*/
+
+        /**
+         * Returns the string representation of crossover bank.
+         *
+         * @return  string representation
+         */
+        String toString () const;
+
+        /*--------------------*/
+
+        /**
+         * Sets up crossover bank for <C>laneCount</C> bands and
+         * <C>channelCount</C> channels and clears all filters and
+         * signal histories; this allocates.
+         *
+         * @param[in] laneCount     the number of bands
+         * @param[in] channelCount  the number of channels
+         */
+        void resize (IN Natural laneCount,
+                     IN Natural channelCount);
+
+        /*--------------------*/
+
+        /**
+         * Tells whether the bank has been set up for some bands.
+         *
+         * @return  information whether bank has lanes
+         */
+        Boolean isAllocated () const;
+
+        /*--------------------*/
+
+        /**
+         * Sets the top frequency of lane <C>laneIndex</C> to
+         * <C>topFrequency</C> at <C>sampleRate</C>; the filters are
+         * only recalculated by <C>updateFilters</C>.
+         *
+         * @param[in] laneIndex     the index of the band
+         * @param[in] topFrequency  the top crossover frequency of the
+         *                          band
+         * @param[in] sampleRate    the sample rate
+         */
+        void setTopFrequency (IN Natural laneIndex,
+                              IN Real topFrequency,
+                              IN Real sampleRate);
+
+        /*--------------------*/
+
+        /**
+         * Recalculates the filters of all lanes whose band limits
+         * have changed by the top frequencies set (the bottom
+         * frequency of a lane is the maximum top frequency of the
+         * lanes below); does not allocate.
+         */
+        void updateFilters ();
+
+        /*--------------------*/
+
+        /**
+         * Clears all signal histories and pending outputs.
+         */
+        void clear ();
+
+        /*--------------------*/
+
+        /**
+         * Clears the pending output of lane <C>laneIndex</C> for all
+         * channels (e.g. when its band becomes effective).
+         *
+         * @param[in] laneIndex  the index of the band
+         */
+        void clearLane (IN Natural laneIndex);
+
+        /*--------------------*/
+
+        /**
+         * Copies the input spectra and the input and output blocks
+         * of the first channel to all other channels.
+         */
+        void copyFirstChannelState ();
+
+        /*--------------------*/
+
+        /**
+         * Returns the delay of the bank output against its input.
+         *
+         * @return  latency in samples
+         */
+        Natural latency () const;
+
+        /*--------------------*/
+
+        /**
+         * Splits the first <C>count</C> samples in
+         * <C>inputArray</C> for <C>channel</C> into the band buffers
+         * of the first <C>bandCount</C> bands in <C>bandList</C>.
+         *
+         * @param[in]    channel     the channel to be processed
+         * @param[in]    inputArray  the input signal
+         * @param[in]    count       the number of samples
+         * @param[inout] bandList    the list of compander bands
+         * @param[in]    bandCount   the number of effective bands
+         *                           (all reserved in band list)
+         */
+        void apply (IN Natural channel,
+                    IN AudioSample* inputArray,
+                    IN Natural count,
+                    INOUT _MCompanderBandList& bandList,
+                    IN Natural bandCount);
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of bytes allocated on the heap by the
+         * bank (including the bank object itself).
+         *
+         * @return  count of owned bytes
+         */
+        Natural byteCount () const;
+
+        /*====================*/
+
+        private:
+
+            /**
+             * Calculates the filter of lane <C>laneIndex</C> as
+             * difference of the lowpasses at relative frequencies
+             * <C>bottomFrequency</C> and <C>topFrequency</C> and
+             * stores the spectra of its partitions.
+             *
+             * @param[in] laneIndex        the index of the band
+             * @param[in] bottomFrequency  the bottom frequency
+             *                             relative to sample rate
+             * @param[in] topFrequency     the top frequency relative
+             *                             to sample rate
+             */
+            void _calculateLane (IN Natural laneIndex,
+                                 IN Real bottomFrequency,
+                                 IN Real topFrequency);
+
+            /*--------------------*/
+
+            /**
+             * Transforms the completed input block of
+             * <C>channel</C> into the frequency domain delay line
+             * and calculates the next output blocks of the first
+             * <C>bandCount</C> lanes.
+             *
+             * @param[in] channel    the channel to be processed
+             * @param[in] bandCount  the number of effective bands
+             */
+            void _processBlock (IN Natural channel,
+                                IN Natural bandCount);
+
+            /*--------------------*/
+
+            /** the number of lanes (bands) in the bank */
+            Natural _laneCount;
+
+            /** the number of channels in the bank */
+            Natural _channelCount;
+
+            /** the number of partitions of each filter */
+            Natural _partitionCount;
+
+            /** the transform for two blocks of samples */
+            RealFFT _fft;
+
+            /** the window for the filter design with
+             * <C>2 * halfFilterLength + 1</C> entries */
+            GenericList<double> _windowList;
+
+            /** the top frequency of each lane relative to the sample
+             * rate as set */
+            AudioSampleList _topFrequencyList;
+
+            /** the bottom and top frequency of each lane relative to
+             * the sample rate as used for its filter (index
+             * <C>2 * lane</C> and <C>2 * lane + 1</C>) */
+            AudioSampleList _bandLimitList;
+
+            /** the spectra of the filter partitions with index
+             * <C>(lane * partitionCount + partition) *
+             * spectrumLength</C> */
+            GenericList<double> _filterSpectrumList;
+
+            /** the spectra of the last input blocks per channel (the
+             * frequency domain delay line) with index
+             * <C>(channel * partitionCount + slot) *
+             * spectrumLength</C> */
+            GenericList<double> _inputSpectrumList;
+
+            /** the slot of the newest input spectrum per channel */
+            GenericList<size_t> _newestSlotList;
+
+            /** the previous and the current input block per channel
+             * (<C>2 * partitionLength</C> samples each) */
+            GenericList<double> _inputBlockList;
+
+            /** the position of the next sample in the current
+             * block per channel */
+            GenericList<size_t> _blockPositionList;
+
+            /** the pending output blocks with index
+             * <C>(channel * laneCount + lane) * partitionLength</C> */
+            GenericList<double> _outputBlockList;
+
+            /** the accumulated spectrum of a band */
+            GenericList<double> _spectrumSumList;
+
+            /** a time domain sequence of two blocks */
+            GenericList<double> _timeList;
+
+    };
+
+    /*============================================================*/
+    /*============================================================*/
+
+    _Point2D::_Point2D ()
+        : x{0.0},
+          y{0.0}
+    {
+    }
+
+    /*--------------------*/
+
+    _Point2D::_Point2D (IN Real newX, IN Real newY)
+        : x{newX},
+          y{newY}
+    {
+    }
+
+    /*--------------------*/
+
+    String _Point2D::toString () const {
+        String st =
+            STR::expand("_Point2D(%1, %2)",
+                        TOSTRING(x), TOSTRING(y));
+        return st;
+    }
+
+    /*--------------------*/
+
+    void _Point2D::add (IN _Point2D otherPoint) {
+        x += otherPoint.x;
+        y += otherPoint.y;
+    }
+
+    /*--------------------*/
+
+    void _Point2D::clear () {
+        x = 0.0;
+        y = 0.0;
+    }
+
+    /*--------------------*/
+
+
+    Real _Point2D::distance (IN _Point2D otherPoint) const {
+        return Real::sqrt((x - otherPoint.x).sqr()
+                           + (y - otherPoint.y).sqr());
+    }
+
+    /*--------------------*/
+
+    void _Point2D::scale (IN Real factor) {
+        x *= factor;
+        y *= factor;
+    }
+
+    /*--------------------*/
+
+    void _Point2D::subtract (IN _Point2D otherPoint) {
+        x -= otherPoint.x;
+        y -= otherPoint.y;
+    }
+
+    /*============================================================*/
+
+    String _TfSegment::toString () const {
+        String st =
+            STR::expand("_TfSegment("
+                        "isLine = %1, start = %2, end = %3,"
+                        " a2 = %4, a1 = %5)",
+                        TOSTRING(isStraightLine),
+                        startPoint.toString(),
+                        endPoint.toString(),
+                        TOSTRING(a2),
+                        TOSTRING(a1));
+
+        return st;
+    }
+
+    /*--------------------*/
+
+    bool _TfSegment::domainContains (IN Real x) const {
+        return startPoint.x <= x && x <= endPoint.x;
+    }
+
+    /*--------------------*/
+
+    Real _TfSegment::gradient () const {
+        return ((endPoint.y - startPoint.y)
+                / (endPoint.x - startPoint.x));
+    }
+
+    /*--------------------*/
+
+    Real _TfSegment::length () const {
+        return startPoint.distance(endPoint);
+    }
+
+    /*--------------------*/
+
+    void _TfSegment::adaptCoefficients (IN _Point2D point) {
+        Logging_trace1(">>: %1", point.toString());
+
+        if (length() == 0.0) {
+            a1 = 0.0;
+            a2 = 0.0;
+        } else {
+            const Real inA  = point.x - startPoint.x;
+            const Real outA = point.y - startPoint.y;
+            const Real inB  = endPoint.x - startPoint.x;
+            const Real outB = endPoint.y - startPoint.y;
+            a2 = (outB / inB - outA / inA) / (inB - inA);
+            a1 = outA / inA - a2 * inA;
+        }
+
+        Logging_trace1("<<: %1", toString());
+    }
+
+    /*--------------------*/
+
+    _Point2D _TfSegment::interpolate (IN Real position) const {
+        Logging_trace1(">>: %1", TOSTRING(position));
+
+        const Real segmentLength = length();
+        Real relativePosition;
+
+        if (segmentLength == 0.0) {
+            relativePosition = 0.0;
+        } else {
+            relativePosition = position / segmentLength;
+        }
+
+        _Point2D result = endPoint;
+        result.subtract(startPoint);
+        result.scale(relativePosition);
+        result.add(startPoint);
+
+        Logging_trace1("<<: %1", result.toString());
+        return result;
+    }
+
+    /*============================================================*/
+
+    const Real _TransferFunction::_leftDbOffset = 10.0;
+    const Natural _TransferFunction::_maximumOctaveCount = 40;
+    const Natural _TransferFunction::_maximumEntriesPerOctave = 1024;
+
+    /*--------------------*/
+
+    void _TransferFunction::_adaptCurvesInSegmentList () {
+        Logging_trace(">>");
+
+        const Real radius = _dBKnee * log(10) / 20.0;
+        const Natural segmentCount = _segmentList.size();
+
+        if (segmentCount >= 2) {
+            _TfSegment* segment = nullptr;
+            _TfSegment* nextSegment = &_segmentList[0];
+
+            for (Natural i = 0;  i < segmentCount;  i++) {
+                _TfSegment* previousSegment = segment;
+                segment = nextSegment;
+                nextSegment++;
+
+                if (!segment->isStraightLine) {
+                    const _Point2D originalNextSegmentStartPoint =
+                        nextSegment->startPoint;
+                    _Point2D& segmentStartPoint = segment->startPoint;
+                    _Point2D& segmentEndPoint = segment->endPoint;
+
+                    /* adapt curve segment to the left */
+                    Real length = previousSegment->length();
+                    Real position = Real::maximum(0.0, length - radius);
+                    segmentStartPoint = previousSegment->interpolate(position);
+                    previousSegment->endPoint = segmentStartPoint;
+
+                    /* adapt curve segment to the right */
+                    length = nextSegment->length();
+                    position = Real::minimum(radius, length / 2.0);
+                    segmentEndPoint = nextSegment->interpolate(position);
+                    nextSegment->startPoint = segmentEndPoint;
+
+                    /* find some intermediate point */
+                    _Point2D intermediatePoint = segmentStartPoint;
+                    intermediatePoint.add(segmentEndPoint);
+                    intermediatePoint.add(originalNextSegmentStartPoint);
+                    intermediatePoint.scale(1/3.0);
+
+                    /* set coefficients of curve */
+                    segment->adaptCoefficients(intermediatePoint);
+                }
+            }
+        }
+
+        Logging_trace1("<<: %1", toString());
+    }
+
+    /*--------------------*/
+
+    void _TransferFunction::_shiftScaleSegmentList ()
+    {
+        Logging_trace(">>");
+
+        Real factor = log(10) / 20;
+
+        for (_TfSegment& segment : _segmentList) {
+            segment.startPoint.y += _dBGain;
+            segment.endPoint.y   += _dBGain;
+            segment.startPoint.scale(factor);
+            segment.endPoint.scale(factor);
+
+            if (segment.isStraightLine) {
+                segment.a2 = 0.0;
+                segment.a1 = segment.gradient();
+            }
+        }
+
+        Logging_trace1("<<: %1", toString());
+    }
+
+    /*--------------------*/
+
+    void _TransferFunction::_updateSegmentListEnds ()
+    {
+        Logging_trace(">>");
+
+        Natural segmentCount = _segmentList.size();
+
+        for (Natural i = 0;  i < segmentCount - 1;  i++) {
+            _TfSegment& segment = _segmentList[i];
+            const _TfSegment& nextSegment = _segmentList[i+1];
+            segment.endPoint = nextSegment.startPoint;
+        }
+
+        Logging_trace1("<<: %1", toString());
+    }
+
+    /*--------------------*/
+
+    void _TransferFunction::_updateSegmentListKinds () {
+        Logging_trace(">>");
+
+        Natural segmentCount = _segmentList.size();
+
+        if (segmentCount >= 2) {
+            bool isLastSegment = true;
+            for (Natural i = segmentCount;  i-- > 0;) {
+                _TfSegment& segment = _segmentList[i];
+                const bool isStraightLine = ((i % 2) == 0);
+                segment.isStraightLine = isStraightLine;
+
+                if (!isStraightLine && !isLastSegment) {
+                    const _TfSegment& nextSegment =
+                        _segmentList[i + 1];
+                    segment.startPoint = nextSegment.startPoint;
+                }
+
+                isLastSegment = false;
+            }
+        }
+
+        Logging_trace1("<<: %1", toString());
+    }
+
+    /*--------------------*/
+
+    void _TransferFunction::_updateSegmentList () {
+        Logging_trace(">>");
+        /* pass 1: fill all segments with kind and start values */
+        _updateSegmentListKinds();
+
+        /* pass 2: fill all segments with end values and gradient
+                   for the straight lines */
+        _updateSegmentListEnds();
+
+        /* pass 3: adapt transfer function by output gain and make
+                   values natural logarithms */
+        _shiftScaleSegmentList();
+
+        /* pass 4: adapt transfer function knees */
+        _adaptCurvesInSegmentList();
+
+        Logging_trace1("<<: %1", toString());
+    }
+
+    /*--------------------*/
+
+    _TransferFunction::_TransferFunction ()
+        : _segmentList{3},
+          _minimumLinearInValue{1.0},
+          _minimumLinearOutValue{1.0},
+          _dBGain{0.0},
+          _dBKnee{0.01},
+          _isIdentity{false},
+          _table{},
+          _entriesPerOctave{0},
+          _tableLength{0},
+          _minimumExponent{0},
+          _tableIsValidated{false},
+          _tableDeviation{0.0},
+          _usesFastMath{false}
+    {
+        Logging_trace(">>");
+        Logging_trace1("<<: %1", toString());
+    }
+
+    /*--------------------*/
+
+    String _TransferFunction::toString () const {
+        String st;
+        bool isFirst = true;
+
+        for (const _TfSegment& segment : _segmentList) {
+            st += (isFirst ? "" : ", ");
+            st += segment.toString();
+            isFirst = false;
+        }
+
+        st = STR::expand("TransferFct("
+                         "minLin = %1, minOut = %2, dBGain = %3dB,"
+                         " dBKnee = %4dB, segments = (%5),"
+                         " entriesPerOctave = %6, tableLength = %7,"
+                         " tableDeviation = %8dB, usesFastMath = %9)",
+                         TOSTRING(_minimumLinearInValue),
+                         TOSTRING(_minimumLinearOutValue),
+                         TOSTRING(_dBGain), TOSTRING(_dBKnee),
+                         st, TOSTRING(_entriesPerOctave),
+                         TOSTRING(_tableLength),
+                         TOSTRING(_tableDeviation),
+                         TOSTRING(_usesFastMath));
+        return st;
+    }
+
+    /*--------------------*/
+
+    void _TransferFunction::adapt (IN Real dBKnee,
+                                   IN Real cDBThreshold,
+                                   IN Real cRatio,
+                                   IN Real dBGain) {
+        Logging_trace4(">>: dBKnee = %1, dBThreshold = %2,"
+                       " ratio = %3, dBGain = %4",
+                       TOSTRING(dBKnee), TOSTRING(cDBThreshold),
+                       TOSTRING(cRatio), TOSTRING(dBGain));
+
+        const Real ratio = Real::maximum(1.0, cRatio);
+        const Real dBThreshold = Real::minimum(0.0, cDBThreshold);
+        _dBKnee = Real::maximum(0.0, dBKnee);
+        _dBGain = dBGain;
+        _isIdentity = (ratio == 1.0 && dBGain == 0.0);
+
+        /* set data for the straight segments */
+        _Point2D& segmentStart = _segmentList[0].startPoint;
+        segmentStart = _Point2D(dBThreshold - _leftDbOffset, 0.0);
+
+        _TfSegment& segment = _segmentList[2];
+        segment.startPoint = _Point2D(dBThreshold, 0.0);
+        segment.endPoint   = _Point2D(0.0, (ratio - 1.0) * dBThreshold / ratio);
+
+        _updateSegmentList();
+
+        const _Point2D& firstSegmentStart = _segmentList[1].startPoint;
+        _minimumLinearInValue  = firstSegmentStart.x.exp();
+        _minimumLinearOutValue = firstSegmentStart.y.exp();
+        _updateTable();
+
+        Logging_trace1("<<: %1", toString());
+    }
+
+    /*--------------------*/
+
+    Real _TransferFunction::apply (IN Real cValue) const {
+        Real result;
+
+        if (_tableLength == 0 || cValue <= _minimumLinearInValue) {
+            result = _applyExactly(cValue);
+        } else if (cValue >= 1.0) {
+            result = _table[_tableLength - 1];
+        } else {
+            /* split value into octave and mantissa in [0.5, 1) */
+            int exponent;
+            const double mantissa = std::frexp((double) cValue, &exponent);
+            const Integer octave = exponent - (int) _minimumExponent;
+
+            if (octave < 0) {
+                /* below the table range */
+                result = _applyExactly(cValue);
+            } else {
+                const size_t entriesPerOctave = (size_t) _entriesPerOctave;
+                const double position =
+                    (mantissa - 0.5) * 2.0 * (double) entriesPerOctave;
+                const size_t j = (size_t) position;
+                const size_t index =
+                    (size_t) (int) octave * entriesPerOctave + j;
+                const Real fraction{position - (double) j};
+                const Real lowerValue = _table[index];
+                result = (lowerValue
+                          + fraction * (_table[index + 1] - lowerValue));
+            }
+        }
+
+        return result;
+    }
+
+    /*--------------------*/
+
+    void _TransferFunction::applyBlock (INOUT AudioSample* valueArray,
+                                        IN Natural count) const {
+        const size_t sampleCount = (size_t) count;
+
+        if (_tableLength == 0) {
+            for (size_t j = 0;  j < sampleCount;  j++) {
+                valueArray[j] = _applyExactly(valueArray[j]);
+            }
+        } else {
+            /* keep the table parameters in local variables, the
+               lookup of each value is independent of the others */
+            const double* table = (const double*) _table.asArray();
+            const double minimumInValue = (double) _minimumLinearInValue;
+            const double lastValue = table[(size_t) _tableLength - 1];
+            const size_t entriesPerOctave = (size_t) _entriesPerOctave;
+            const double scaleFactor = 2.0 * (double) entriesPerOctave;
+            const int minimumExponent = (int) _minimumExponent;
+
+            for (size_t j = 0;  j < sampleCount;  j++) {
+                const double value = (double) valueArray[j];
+                int exponent;
+                const double mantissa = std::frexp(value, &exponent);
+                const int octave = exponent - minimumExponent;
+
+                if (value <= minimumInValue || octave < 0) {
+                    valueArray[j] = _applyExactly(valueArray[j]);
+                } else if (value >= 1.0) {
+                    valueArray[j] = lastValue;
+                } else {
+                    const double position = (mantissa - 0.5) * scaleFactor;
+                    const size_t k = (size_t) position;
+                    const size_t index =
+                        (size_t) octave * entriesPerOctave + k;
+                    const double fraction = position - (double) k;
+                    const double lowerValue = table[index];
+                    valueArray[j] =
+                        lowerValue
+                        + fraction * (table[index + 1] - lowerValue);
+                }
+            }
+        }
+    }
+
+    /*--------------------*/
+
+    Boolean _TransferFunction::isIdentity () const {
+        return _isIdentity;
+    }
+
+    /*--------------------*/
+
+    Real _TransferFunction::linearRegionLimit () const {
+        return _minimumLinearInValue;
+    }
+
+    /*--------------------*/
+
+    Real _TransferFunction::linearRegionGain () const {
+        return _minimumLinearOutValue;
+    }
+
+    /*--------------------*/
+
+    Real _TransferFunction::_applyExactly (IN Real cValue) const {
+        Real result;
+
+        if (cValue <= _minimumLinearInValue) {
+            result = _minimumLinearOutValue;
+        } else {
+            const Real value = Real::minimum(cValue, 1.0);
+            Real lnValue = (_usesFastMath
+                            ? FastMath::fastLog(value)
+                            : value.log());
+            result = value;
+
+            for (const _TfSegment& segment : _segmentList) {
+                if (segment.domainContains(lnValue)) {
+                    lnValue -= segment.startPoint.x;
+                    const Real a1 = segment.a1;
+                    const Real a2 = segment.a2;
+                    const Real y  = segment.startPoint.y;
+                    const Real lnResult = y + lnValue * (a2 * lnValue + a1);
+                    result = (_usesFastMath
+                              ? FastMath::fastExp(lnResult)
+                              : lnResult.exp());
+                    break;
+                }
+            }
+        }
+
+        return result;
+    }
+
+    /*--------------------*/
+
+    void _TransferFunction::setTable (IN Natural entriesPerOctave,
+                                      IN Boolean isValidated)
+    {
+        Logging_trace2(">>: entriesPerOctave = %1, isValidated = %2",
+                       TOSTRING(entriesPerOctave),
+                       TOSTRING(isValidated));
+
+        _entriesPerOctave =
+            Natural::minimum(entriesPerOctave, _maximumEntriesPerOctave);
+        _tableIsValidated = isValidated;
+        _table.setLength(_entriesPerOctave == 0
+                         ? 0
+                         : _maximumOctaveCount * _entriesPerOctave + 1);
+        _updateTable();
+
+        Logging_trace1("<<: %1", toString());
+    }
+
+    /*--------------------*/
+
+    Real _TransferFunction::tableDeviation () const {
+        return _tableDeviation;
+    }
+
+    /*--------------------*/
+
+    void _TransferFunction::setFastMath (IN Boolean isEnabled) {
+        Logging_trace1(">>: %1", TOSTRING(isEnabled));
+        _usesFastMath = isEnabled;
+        _updateTable();
+        Logging_trace("<<");
+    }
+
+    /*--------------------*/
+
+    Natural _TransferFunction::byteCount () const {
+        return (SoXMemoryFootprint::listByteCount(_segmentList)
+                + SoXMemoryFootprint::listByteCount(_table));
+    }
+
+    /*--------------------*/
+
+    Real _TransferFunction::_tableInputValue (IN Real position) const {
+        const double entriesPerOctave = (double) (size_t) _entriesPerOctave;
+        const double octave = std::floor((double) position
+                                         / entriesPerOctave);
+        const double j = (double) position - octave * entriesPerOctave;
+        const double mantissa = 0.5 + j / (2.0 * entriesPerOctave);
+        return Real{std::ldexp(mantissa,
+                               (int) _minimumExponent + (int) octave)};
+    }
+
+    /*--------------------*/
+
+    void _TransferFunction::_updateTable () {
+        Logging_trace(">>");
+
+        _tableLength    = 0;
+        _tableDeviation = 0.0;
+
+        if (_entriesPerOctave > 0) {
+            /* the table starts with the octave of the minimum input
+               value */
+            int exponent;
+            std::frexp((double) _minimumLinearInValue, &exponent);
+            _minimumExponent =
+                Integer::maximum(exponent,
+                                 1 - (int) _maximumOctaveCount);
+            const Natural octaveCount =
+                (Natural) (1 - (int) _minimumExponent);
+            const Natural tableLength =
+                octaveCount * _entriesPerOctave + 1;
+
+            for (Natural i = 0;  i < tableLength;  i++) {
+                _table[i] = _applyExactly(_tableInputValue(Real{(double) i}));
+            }
+
+            _tableLength = tableLength;
+
+            if (_tableIsValidated) {
+                /* the interpolation error is largest between the
+                   entries */
+                const Real dBFactor = Real{20.0} / Real{10.0}.log();
+
+                for (Natural i = 0;  i + 1 < tableLength;  i++) {
+                    const Real value =
+                        _tableInputValue(Real{(double) i + 0.5});
+                    const Real deviation =
+                        (dBFactor
+                         * (apply(value) / _applyExactly(value)).log());
+                    _tableDeviation =
+                        Real::maximum(_tableDeviation, deviation.abs());
+                }
+
+                Logging_trace1("--: table deviation = %1dB",
+                               TOSTRING(_tableDeviation));
+            }
+        }
+
+        Logging_trace1("<<: tableLength = %1", TOSTRING(_tableLength));
+    }
+
+    /*============================================================*/
+
+    Real _Compander::_adaptEnvelopeTime (IN Real t,
+                                         IN Real sampleRate) {
+        const Real one{1.0};
+        return Real::minimum(one,
+                             one - (-one / (sampleRate * t)).exp());
+    }
+
+    /*--------------------*/
+
+    _Compander::_Compander ()
+        : _transferFunction{},
+          _outGainFactor{1.0},
+          _minimumGain{Real::infinity},
+          _channelsAreAggregated{true},
+          _attackTimeList{},
+          _releaseTimeList{},
+          _volumeList{},
+          _gainList{},
+          _delayLineVector{},
+          _delayedList{},
+          _decimationFactor{1},
+          _gainInterval{1},
+          _windowList{},
+          _previousGainList{}
+    {
+        Logging_trace(">>");
+        _volumeList.setLength(_maximumChannelCount);
+        _attackTimeList.setLength(_maximumChannelCount);
+        _releaseTimeList.setLength(_maximumChannelCount);
+        _previousGainList.setLength(_maximumChannelCount);
+        _previousGainList.fill(1.0);
+        Logging_trace1("<<: %1", toString());
+    }
+
+    /*--------------------*/
+
+    String _Compander::toString () const {
+        String st =
+            STR::expand("_Compander("
+                        "transferFunction = %1, _channelsAreAggregated = %2,"
+                        " _attackTimeList = %3, _releaseTimeList = %4,"
+                        " _volumeList = %5",
+                        _transferFunction.toString(),
+                        TOSTRING(_channelsAreAggregated),
+                        _attackTimeList.toString(),
+                        _releaseTimeList.toString(),
+                        _volumeList.toString());
+
+        return st;
+    }
+
+    /*--------------------*/
+
+    void _Compander::adapt (IN Real sampleRate,
+                            IN Real attack,
+                            IN Real release,
+                            IN Real dBKnee,
+                            IN Real dBThreshold,
+                            IN Real ratio,
+                            IN Real dBGain)
+    {
+        Logging_trace7(">>: sampleRate = %1, attack = %2, release = %3,"
+                       " dBKnee = %4, dBThreshold = %5, ratio = %6,"
+                       " dBGain = %7",
+                       TOSTRING(sampleRate), TOSTRING(attack),
+                       TOSTRING(release), TOSTRING(dBKnee),
+                       TOSTRING(dBThreshold), TOSTRING(ratio),
+                       TOSTRING(dBGain));
+
+        Real time;
+        _transferFunction.adapt(dBKnee, dBThreshold, ratio, dBGain);
+        _outGainFactor = Real::power(10.0, dBGain / 20.0);
+        _channelsAreAggregated = true;
+        _volumeList.fill(1.0);
+        time = _adaptEnvelopeTime(attack, sampleRate);
+        _attackTimeList.fill(time);
+        time = _adaptEnvelopeTime(release, sampleRate);
+        _releaseTimeList.fill(time);
+        _previousGainList.fill(_transferFunction.apply(1.0));
+
+        Logging_trace1("<<: %1", toString());
+    }
+
+    /*--------------------*/
+
+    void _Compander::applyBlock (INOUT AudioSampleListVector& buffer,
+                                 IN Natural channelCount,
+                                 IN Natural count,
+                                 IN AudioSample* keyArray)
+    {
+        Logging_traceHot2(">>: channelCount = %1, count = %2",
+                          TOSTRING(channelCount), TOSTRING(count));
+
+        if (_transferFunction.isIdentity()) {
+            /* the samples only pass the lookahead delay */
+            for (Natural channel = 0;  channel < channelCount;
+                 channel++) {
+                AudioSample* sampleArray = buffer[channel].asArray();
+                const AudioSample* delayedArray =
+                    _delayedSamples(channel, sampleArray, count);
+                _applyGains(sampleArray, delayedArray, nullptr,
+                            count, true);
+            }
+        } else if (_channelsAreAggregated) {
+            /* use settings of first channel to represent all
+               channels */
+            Real volume = _volumeList[0];
+            const Real attackTime  = _attackTimeList[0];
+            const Real releaseTime = _releaseTimeList[0];
+            _gainList.ensureLength(count);
+            AudioSample* gainArray = _gainList.asArray();
+
+            /* one detector value, envelope step and gain lookup per
+               frame */
+            if (keyArray == nullptr) {
+                _maximumAbsoluteSample(buffer, channelCount, count,
+                                       gainArray);
+            } else {
+                for (size_t j = 0;  j < (size_t) count;  j++) {
+                    gainArray[j] = keyArray[j];
+                }
+            }
+
+            Real previousGain = _previousGainList[0];
+            const Real startGain = previousGain;
+            const Natural gainInterval =
+                _effectiveGainInterval(attackTime);
+            const Boolean gainIsConstant =
+                (gainInterval > 1
+                 ? _controlRateGains(gainArray, count, volume,
+                                     previousGain, attackTime,
+                                     releaseTime, gainInterval)
+                 : _envelopeGains(gainArray, count, volume,
+                                  previousGain, attackTime,
+                                  releaseTime));
+
+            /* the gain of a frame is applied to all channels (on
+               the delayed samples for a lookahead) */
+            for (Natural channel = 0;  channel < channelCount;
+                 channel++) {
+                AudioSample* sampleArray = buffer[channel].asArray();
+                const AudioSample* delayedArray =
+                    _delayedSamples(channel, sampleArray, count);
+
+                if (gainInterval > 1 && !gainIsConstant) {
+                    _applyGainRamps(sampleArray, delayedArray, count,
+                                    startGain, gainInterval);
+                } else {
+                    _applyGains(sampleArray, delayedArray, gainArray,
+                                count, gainIsConstant);
+                }
+            }
+
+            /* volume and gain represent all channels */
+            _volumeList.fill(volume);
+            _previousGainList.fill(previousGain);
+        } else {
+            _gainList.ensureLength(count);
+            AudioSample* gainArray = _gainList.asArray();
+
+            for (Natural channel = 0;  channel < channelCount;  channel++) {
+                AudioSample* sampleArray = buffer[channel].asArray();
+                Real volume = _volumeList[channel];
+                const Real attackTime  = _attackTimeList[channel];
+                const Real releaseTime = _releaseTimeList[channel];
+
+                for (size_t j = 0;  j < (size_t) count;  j++) {
+                    gainArray[j] = (keyArray == nullptr
+                                    ? sampleArray[j].abs() : keyArray[j]);
+                }
+
+                Real& previousGain = _previousGainList[channel];
+                const Real startGain = previousGain;
+                const Natural gainInterval =
+                    _effectiveGainInterval(attackTime);
+                const Boolean gainIsConstant =
+                    (gainInterval > 1
+                     ? _controlRateGains(gainArray, count, volume,
+                                         previousGain, attackTime,
+                                         releaseTime, gainInterval)
+                     : _envelopeGains(gainArray, count, volume,
+                                      previousGain, attackTime,
+                                      releaseTime));
+
+                const AudioSample* delayedArray =
+                    _delayedSamples(channel, sampleArray, count);
+
+                if (gainInterval > 1 && !gainIsConstant) {
+                    _applyGainRamps(sampleArray, delayedArray, count,
+                                    startGain, gainInterval);
+                } else {
+                    _applyGains(sampleArray, delayedArray, gainArray,
+                                count, gainIsConstant);
+                }
+
+                _volumeList[channel] = volume;
+            }
+        }
+
+        Logging_traceHot("<<");
+    }
+
+    /*--------------------*/
+
+    void _Compander::_applyGains (OUT AudioSample* sampleArray,
+                                  IN AudioSample* delayedArray,
+                                  IN AudioSample* gainArray,
+                                  IN Natural count,
+                                  IN Boolean gainIsConstant) const
+    {
+        const size_t sampleCount = (size_t) count;
+
+        if (!gainIsConstant) {
+            for (size_t j = 0;  j < sampleCount;  j++) {
+                sampleArray[j] = delayedArray[j] * gainArray[j];
+            }
+        } else {
+            const AudioSample gain{_transferFunction.isIdentity()
+                                   ? 1.0
+                                   : _transferFunction.linearRegionGain()};
+
+            if (gain != 1.0) {
+                for (size_t j = 0;  j < sampleCount;  j++) {
+                    sampleArray[j] = delayedArray[j] * gain;
+                }
+            } else if (delayedArray != sampleArray) {
+                for (size_t j = 0;  j < sampleCount;  j++) {
+                    sampleArray[j] = delayedArray[j];
+                }
+            }
+        }
+    }
+
+    /*--------------------*/
+
+    void _Compander::_applyGainRamps (OUT AudioSample* sampleArray,
+                                      IN AudioSample* delayedArray,
+                                      IN Natural count,
+                                      IN Real startGain,
+                                      IN Natural interval) const
+    {
+        const size_t sampleCount = (size_t) count;
+        const size_t factor = (size_t) interval;
+        const size_t windowCount = (sampleCount + factor - 1) / factor;
+        const double* windowArray =
+            (const double*) _windowList.asArray();
+        double* outputArray = (double*) sampleArray;
+        const Kernels& kernels = Kernels::current();
+
+        if (delayedArray != sampleArray) {
+            for (size_t j = 0;  j < sampleCount;  j++) {
+                sampleArray[j] = delayedArray[j];
+            }
+        }
+
+        /* the gain of an interval is reached at its last frame */
+        double gain = (double) startGain;
+
+        for (size_t w = 0;  w < windowCount;  w++) {
+            const size_t firstPosition = w * factor;
+            const size_t length =
+                std::min(factor, sampleCount - firstPosition);
+            const double endGain = windowArray[w];
+            kernels.gainRampDouble(&outputArray[firstPosition], length,
+                                   gain,
+                                   (endGain - gain) / (double) length);
+            gain = endGain;
+        }
+    }
+
+    /*--------------------*/
+
+    Boolean _Compander::_calculateGains (INOUT AudioSample* gainArray,
+                                         IN Natural count)
+    {
+        /* the envelope is a running mix of the detector values,
+           hence its maximum is checked after the envelope pass */
+        const double limit = (double) _transferFunction.linearRegionLimit();
+        const double* envelopeArray = (const double*) gainArray;
+        double maximumEnvelope = 0.0;
+
+        for (size_t j = 0;  j < (size_t) count;  j++) {
+            maximumEnvelope = (envelopeArray[j] > maximumEnvelope
+                               ? envelopeArray[j] : maximumEnvelope);
+        }
+
+        const Boolean gainIsConstant = (maximumEnvelope <= limit);
+
+        if (gainIsConstant) {
+            _minimumGain =
+                Real::minimum(_minimumGain,
+                              _transferFunction.linearRegionGain());
+        } else {
+            _transferFunction.applyBlock(gainArray, count);
+            _trackMinimumGain(gainArray, count);
+        }
+
+        return gainIsConstant;
+    }
+
+    /*--------------------*/
+
+    const AudioSample*
+    _Compander::_delayedSamples (IN Natural channel,
+                                 IN AudioSample* sampleArray,
+                                 IN Natural count)
+    {
+        AudioSampleRingBuffer& delayLine = _delayLineVector.at(channel);
+        const Natural delayLength = delayLine.length();
+        const AudioSample* result = sampleArray;
+
+        if (delayLength > 0) {
+            AudioSample* delayedArray = _delayedList.asArray();
+
+            if (count <= delayLength) {
+                delayLine.readBlock(0, delayedArray, count);
+                delayLine.writeBlock(sampleArray, count);
+            } else {
+                /* the delayed block is the complete delay line
+                   followed by the start of the input block, the
+                   delay line afterwards holds the end of the input
+                   block */
+                const Natural remainingCount = count - delayLength;
+                delayLine.readBlock(0, delayedArray, delayLength);
+
+                for (Natural i = 0;  i < remainingCount;  i++) {
+                    delayedArray[(size_t) (delayLength + i)] =
+                        sampleArray[(size_t) i];
+                }
+
+                delayLine.writeBlock(&sampleArray[(size_t) remainingCount],
+                                     delayLength);
+            }
+
+            result = delayedArray;
+        }
+
+        return result;
+    }
+
+    /*--------------------*/
+
+    Boolean _Compander::_envelopeGains (INOUT AudioSample* gainArray,
+                                        IN Natural count,
+                                        INOUT Real& volume,
+                                        INOUT Real& previousGain,
+                                        IN Real attackTime,
+                                        IN Real releaseTime)
+    {
+        Boolean gainIsConstant;
+
+        if (_decimationFactor > 1) {
+            gainIsConstant =
+                _decimatedGains(gainArray, count, volume, previousGain,
+                                attackTime, releaseTime);
+        } else {
+            _followEnvelope(gainArray, count, volume,
+                            attackTime, releaseTime);
+            gainIsConstant = _calculateGains(gainArray, count);
+
+            /* keep the last gain for a later switch to a decimated
+               detector */
+            if (gainIsConstant) {
+                previousGain = _transferFunction.linearRegionGain();
+            } else if (count > 0) {
+                previousGain = gainArray[(size_t) count - 1];
+            }
+        }
+
+        return gainIsConstant;
+    }
+
+    /*--------------------*/
+
+    Boolean _Compander::_decimatedGains (INOUT AudioSample* gainArray,
+                                         IN Natural count,
+                                         INOUT Real& volume,
+                                         INOUT Real& previousGain,
+                                         IN Real attackTime,
+                                         IN Real releaseTime)
+    {
+        const size_t factor = (size_t) _decimationFactor;
+        const size_t sampleCount = (size_t) count;
+        const size_t windowCount = (sampleCount + factor - 1) / factor;
+        const size_t fullWindowCount = sampleCount / factor;
+        AudioSample* windowArray = _windowList.asArray();
+
+        /* the maximum per window does not miss any peak */
+        for (size_t w = 0;  w < windowCount;  w++) {
+            const size_t firstPosition = w * factor;
+            const size_t lastPosition =
+                std::min(firstPosition + factor, sampleCount);
+            AudioSample maximumValue = gainArray[firstPosition];
+
+            for (size_t j = firstPosition + 1;  j < lastPosition;  j++) {
+                maximumValue = (gainArray[j] > maximumValue
+                                ? gainArray[j] : maximumValue);
+            }
+
+            windowArray[w] = maximumValue;
+        }
+
+        _followEnvelope(windowArray, Natural{fullWindowCount}, volume,
+                        _windowEnvelopeTime(attackTime, factor),
+                        _windowEnvelopeTime(releaseTime, factor));
+
+        if (windowCount > fullWindowCount) {
+            const Natural remainingCount =
+                Natural{sampleCount - fullWindowCount * factor};
+            _followEnvelope(&windowArray[fullWindowCount], 1, volume,
+                            _windowEnvelopeTime(attackTime,
+                                                remainingCount),
+                            _windowEnvelopeTime(releaseTime,
+                                                remainingCount));
+        }
+
+        const Boolean gainIsConstant =
+            _calculateGains(windowArray, Natural{windowCount});
+
+        if (gainIsConstant) {
+            previousGain = _transferFunction.linearRegionGain();
+        } else {
+            /* the gain of a window is reached at its last frame */
+            double startGain = (double) previousGain;
+
+            for (size_t w = 0;  w < windowCount;  w++) {
+                const size_t firstPosition = w * factor;
+                const size_t length =
+                    std::min(factor, sampleCount - firstPosition);
+                const double endGain = (double) windowArray[w];
+                const double step =
+                    (endGain - startGain) / (double) length;
+
+                for (size_t j = 0;  j < length;  j++) {
+                    gainArray[firstPosition + j] =
+                        startGain + step * (double) (j + 1);
+                }
+
+                startGain = endGain;
+            }
+
+            previousGain = startGain;
+        }
+
+        return gainIsConstant;
+    }
+
+    /*--------------------*/
+
+    Natural _Compander::_effectiveGainInterval (IN Real attackTime) const
+    {
+        Natural result = _gainInterval;
+
+        if (_decimationFactor > 1) {
+            result = 1;
+        } else if (_gainInterval == 0) {
+            /* the attack time constant is about the inverse of its
+               delta in frames */
+            const Real maximumCount{_maximumAutomaticGainInterval};
+            const Real frameCount =
+                Real::floor(Real{0.125} / Real::maximum(attackTime, 1E-6));
+            result = Natural::maximum(1,
+                                      (Natural) Real::minimum(maximumCount,
+                                                              frameCount));
+        }
+
+        return result;
+    }
+
+    /*--------------------*/
+
+    Boolean _Compander::_controlRateGains (INOUT AudioSample* gainArray,
+                                           IN Natural count,
+                                           INOUT Real& volume,
+                                           INOUT Real& previousGain,
+                                           IN Real attackTime,
+                                           IN Real releaseTime,
+                                           IN Natural interval)
+    {
+        const size_t factor = (size_t) interval;
+        const size_t sampleCount = (size_t) count;
+        const size_t windowCount = (sampleCount + factor - 1) / factor;
+        AudioSample* windowArray = _windowList.asArray();
+
+        /* the envelope runs at full rate and is sampled at the
+           last frame of each interval */
+        _followEnvelope(gainArray, count, volume,
+                        attackTime, releaseTime);
+
+        for (size_t w = 0;  w < windowCount;  w++) {
+            const size_t lastPosition =
+                std::min((w + 1) * factor, sampleCount) - 1;
+            windowArray[w] = gainArray[lastPosition];
+        }
+
+        const Boolean gainIsConstant =
+            _calculateGains(windowArray, Natural{windowCount});
+
+        if (gainIsConstant) {
+            previousGain = _transferFunction.linearRegionGain();
+        } else if (windowCount > 0) {
+            previousGain = windowArray[windowCount - 1];
+        }
+
+        return gainIsConstant;
+    }
+
+    /*--------------------*/
+
+    Real _Compander::_windowEnvelopeTime (IN Real time,
+                                          IN Natural frameCount)
+    {
+        /* the envelope approaches its target by the factor
+           (1 - time) per frame */
+        const Real one{1.0};
+        return one - Real::power(one - time, Real{frameCount});
+    }
+
+    /*--------------------*/
+
+    void _Compander::_followEnvelope (INOUT AudioSample* valueArray,
+                                      IN Natural count,
+                                      INOUT Real& volume,
+                                      IN Real attackTime,
+                                      IN Real releaseTime)
+    {
+        const double attackDelta  = (double) attackTime;
+        const double releaseDelta = (double) releaseTime;
+        double envelope = (double) volume;
+        double* envelopeArray = (double*) valueArray;
+
+        for (size_t j = 0;  j < (size_t) count;  j++) {
+            const double delta = envelopeArray[j] - envelope;
+            const double increment =
+                (delta > 0.0 ? attackDelta : releaseDelta);
+            envelope = DenormalGuard::flushed(envelope + delta * increment);
+            envelopeArray[j] = envelope;
+        }
+
+        volume = envelope;
+    }
+
+    /*--------------------*/
+
+    void
+    _Compander::_maximumAbsoluteSample (IN AudioSampleListVector& buffer,
+                                        IN Natural channelCount,
+                                        IN Natural count,
+                                        OUT AudioSample* maximumArray)
+    {
+        for (size_t j = 0;  j < (size_t) count;  j++) {
+            maximumArray[j] = 0.0;
+        }
+
+        for (Natural channel = 0;  channel < channelCount;  channel++) {
+            const AudioSample* sampleArray = buffer[channel].asArray();
+
+            for (size_t j = 0;  j < (size_t) count;  j++) {
+                maximumArray[j] = Real::maximum(maximumArray[j],
+                                                sampleArray[j].abs());
+            }
+        }
+    }
+
+    /*--------------------*/
+
+    void _Compander::setLength (IN Natural channelCount,
+                                IN Natural blockLength) {
+        Logging_trace2(">>: channelCount = %1, blockLength = %2",
+                       TOSTRING(channelCount), TOSTRING(blockLength));
+
+        _volumeList.setLength(channelCount);
+        _attackTimeList.setLength(channelCount);
+        _releaseTimeList.setLength(channelCount);
+        _gainList.setLength(blockLength);
+        _delayLineVector.resize(channelCount, 1);
+        _delayedList.setLength(blockLength);
+        _previousGainList.setLength(channelCount);
+        _previousGainList.fill(_transferFunction.apply(1.0));
+
+        /* a window has at least one frame, hence there are at most
+           as many windows as frames */
+        _windowList.setLength(blockLength);
+
+        Logging_trace1("<<: %1", toString());
+    }
+
+    /*--------------------*/
+
+    void _Compander::copyFirstChannelState ()
+    {
+        const Natural channelCount = _volumeList.length();
+
+        for (Natural channel = 1;  channel < channelCount;  channel++) {
+            _volumeList[channel] = _volumeList[0];
+            _previousGainList[channel] = _previousGainList[0];
+            _delayLineVector.at(channel) = _delayLineVector.at(0);
+        }
+    }
+
+    /*--------------------*/
+
+    void _Compander::clear ()
+    {
+        _volumeList.fill(1.0);
+        _previousGainList.fill(_transferFunction.apply(1.0));
+        _delayLineVector.setToZero();
+    }
+
+    /*--------------------*/
+
+    void _Compander::setLookahead (IN Natural sampleCount)
+    {
+        Logging_trace1(">>: %1", TOSTRING(sampleCount));
+        _delayLineVector.setRingBufferLength(sampleCount);
+        _delayLineVector.setToZero();
+        Logging_trace("<<");
+    }
+
+    /*--------------------*/
+
+    void
+    _Compander::setTransferFunctionTable (IN Natural entriesPerOctave,
+                                          IN Boolean isValidated)
+    {
+        Logging_trace2(">>: entriesPerOctave = %1, isValidated = %2",
+                       TOSTRING(entriesPerOctave),
+                       TOSTRING(isValidated));
+        _transferFunction.setTable(entriesPerOctave, isValidated);
+        Logging_trace("<<");
+    }
+
+    /*--------------------*/
+
+    Real _Compander::transferFunctionTableDeviation () const
+    {
+        return _transferFunction.tableDeviation();
+    }
+
+    /*--------------------*/
+
+    void _Compander::setFastMath (IN Boolean isEnabled)
+    {
+        Logging_trace1(">>: %1", TOSTRING(isEnabled));
+        _transferFunction.setFastMath(isEnabled);
+        Logging_trace("<<");
+    }
+
+    /*--------------------*/
+
+    void _Compander::setDetectorDecimation (IN Natural factor)
+    {
+        Logging_trace1(">>: %1", TOSTRING(factor));
+        _decimationFactor = Natural::maximum(1, factor);
+        Logging_trace("<<");
+    }
+
+    /*--------------------*/
+
+    void _Compander::setGainInterval (IN Natural sampleCount)
+    {
+        Logging_trace1(">>: %1", TOSTRING(sampleCount));
+        _gainInterval = sampleCount;
+        Logging_trace("<<");
+    }
+
+    /*--------------------*/
+
+    Real _Compander::takeGainReduction ()
+    {
+        Real result{0.0};
+
+        if (_minimumGain != Real::infinity) {
+            /* a zero gain is reported as a very large reduction */
+            const Real relativeGain =
+                Real::maximum(_minimumGain / _outGainFactor, 1E-10);
+            result = Real::maximum(0.0, (-20.0
+                                         * std::log10((double)
+                                                      relativeGain)));
+            _minimumGain = Real::infinity;
+        }
+
+        return result;
+    }
+
+    /*--------------------*/
+
+    Natural _Compander::byteCount () const
+    {
+        return (_transferFunction.byteCount()
+                + SoXMemoryFootprint::listByteCount(_attackTimeList)
+                + SoXMemoryFootprint::listByteCount(_releaseTimeList)
+                + SoXMemoryFootprint::listByteCount(_volumeList)
+                + SoXMemoryFootprint::listByteCount(_gainList)
+                + SoXMemoryFootprint::listByteCount(_delayedList)
+                + SoXMemoryFootprint::listByteCount(_windowList)
+                + SoXMemoryFootprint::listByteCount(_previousGainList)
+                + lookaheadByteCount());
+    }
+
+    /*--------------------*/
+
+    Natural _Compander::lookaheadByteCount () const
+    {
+        return _delayLineVector.byteCount();
+    }
+
+    /*--------------------*/
+
+    void _Compander::_trackMinimumGain (IN AudioSample* gainArray,
+                                        IN Natural count)
+    {
+        AudioSample minimumGain{_minimumGain};
+
+        for (size_t j = 0;  j < (size_t) count;  j++) {
+            minimumGain = (gainArray[j] < minimumGain ? gainArray[j]
+                           : minimumGain);
+        }
+
+        _minimumGain = minimumGain;
+    }
+
+    /*============================================================*/
+
+    const Natural _LRFilter::order{5};
+
+    /*--------------------*/
+
+    _LRFilter::_LRFilter ()
+            : IIRFilterN<5>()
+    {
+        Logging_trace1(">>: %1", TOSTRING(order));
+        Logging_trace1("<<: %1", toString());
+    }
+
+    /*--------------------*/
+
+    void
+    _LRFilter::adapt (IN BiquadCoefficientList& coefficientListA,
+                      IN BiquadCoefficientList& coefficientListB) {
+        Logging_trace(">>");
+
+        size_t i = 0;
+
+        for (Natural j = 0;  j < 2;  j++) {
+            const BiquadCoefficientList& coefficientList =
+                (j == 0
+                 ? coefficientListA
+                 : coefficientListB);
+            _data[i + 0] = coefficientList[0].sqr();
+            _data[i + 1] = Real{2.0} * coefficientList[0] * coefficientList[1];
+            _data[i + 2] = (Real{2.0} * coefficientList[0] * coefficientList[2]
+                            + coefficientList[1].sqr());
+            _data[i + 3] = Real{2.0} * coefficientList[1] * coefficientList[2];
+            _data[i + 4] = coefficientList[2].sqr();
+            i += (size_t) order;
+        }
+
+        Logging_trace1("<<: %1", toString());
+    }
+
+    /*--------------------*/
+
+    Real _LRFilter::coefficient (IN Natural index) const
+    {
+        return _data[(size_t) index];
+    }
+
+    /*============================================================*/
+
+    _LRCrossoverFilter::_LRCrossoverFilter ()
+        : _lowpassFilter{},
+          _highpassFilter{}
+    {
+        Logging_trace(">>");
+        _lowpassFilter.set(1.0);
+        _highpassFilter.set(0.0);
+        Logging_trace1("<<: %1", toString());
+    }
+
+    /*--------------------*/
+
+    String _LRCrossoverFilter::toString () const
+    {
+        String st = ("_LRCrossoverFilter("
+                     "lowpass = " + _lowpassFilter.toString()
+                     + ", highpass = " + _highpassFilter.toString()
+                     + ")");
+        return st;
+    }
+
+    /*--------------------*/
+
+    void _LRCrossoverFilter::adapt (IN Real frequency,
+                                    IN Real sampleRate) {
+        Logging_trace2(">>: frequency = %1, sampleRate = %2",
+                       TOSTRING(frequency), TOSTRING(sampleRate));
+
+        if (frequency >= sampleRate / 2.0) {
+            _lowpassFilter.set(1.0);
+            _highpassFilter.set(0.0);
+        } else {
+            const Real w0 = Real::twoPi * frequency / sampleRate;
+            const Real filterQuality = sqrt(0.5);
+            const Real alpha = w0.sin() / (Real{2.0} * filterQuality);
+            const Real cosW0 = w0.cos();
+            _LRFilter::BiquadCoefficientList coefficientListA;
+            _LRFilter::BiquadCoefficientList coefficientListB;
+            _LRFilter::BiquadCoefficientList coefficientListC;
+
+            /* biquad lowpass filter numerator */
+            coefficientListA[0] = (Real{1.0} - cosW0) / Real{2.0};
+            coefficientListA[1] = Real{1.0} - cosW0;
+            coefficientListA[2] = coefficientListA[0];
+
+            /* biquad highpass filter numerator */
+            coefficientListB[0] = (Real{1.0} + cosW0) / Real{2.0};
+            coefficientListB[1] = -Real{1.0} - cosW0;
+            coefficientListB[2] = coefficientListB[0];
+
+            /* biquad LP/HP filter denominator */
+            coefficientListC[0] = Real{1.0} + alpha;
+            coefficientListC[1] = -Real{2.0} *cosW0;
+            coefficientListC[2] = Real{1.0} - alpha;
+
+            /* normalize coefficients */
+            const Real referenceValue = Real{1.0} / coefficientListC[0];
+
+            for (size_t i = 0;  i < 3;  i++) {
+                coefficientListA[i] *= referenceValue;
+                coefficientListB[i] *= referenceValue;
+                coefficientListC[i] *= referenceValue;
+            }
+
+            _lowpassFilter.adapt(coefficientListA,
+                                 coefficientListC);
+            _highpassFilter.adapt(coefficientListB,
+                                  coefficientListC);
+        }
+
+        Logging_trace1("<<: %1", toString());
+    }
+
+    /*--------------------*/
+
+    const _LRFilter& _LRCrossoverFilter::lowpassFilter () const
+    {
+        return _lowpassFilter;
+    }
+
+    /*--------------------*/
+
+    const _LRFilter& _LRCrossoverFilter::highpassFilter () const
+    {
+        return _highpassFilter;
+    }
+
+    /*--------------------*/
+
+    void _LRCrossoverFilter::setToIdentity () {
+        Logging_trace(">>");
+        _lowpassFilter.set(1.0);
+        _highpassFilter.set(0.0);
+        Logging_trace1("<<: %1", toString());
+    }
+
+    /*============================================================*/
+
+    const Real _MCompanderBand::maxTopFrequency = 1E9;
+
+    /*--------------------*/
+
+    _MCompanderBand::_MCompanderBand ()
+        : _channelCount{0},
+          _compander{},
+          _topFrequency{maxTopFrequency},
+          _crossoverFilter{},
+          _buffer{},
+          _sampleRate{44100.0},
+          _settingList{},
+          _lookaheadSampleCount{0},
+          _decimationFactor{1},
+          _multirateIsReserved{false},
+          _resamplerList{},
+          _pendingBuffer{},
+          _pendingKeyList{},
+          _pendingSampleCount{0},
+          _reducedBuffer{},
+          _reducedKeyList{},
+          _queueBuffer{},
+          _queuedSampleCount{0},
+          _compensationBuffer{},
+          _compensationSampleCount{0}
+    {
+        Logging_trace(">>");
+        Logging_trace1("<<: %1", toString());
+    }
+
+    /*--------------------*/
+
+    _MCompanderBand::~_MCompanderBand ()
+    {
+        Logging_trace(">>");
+
+        for (HalfBandOversampler* resampler : _resamplerList) {
+            delete resampler;
+        }
+
+        Logging_trace("<<");
+    }
+
+    /*--------------------*/
+
+    String _MCompanderBand::toString () const
+    {
+        String st =
+            STR::expand("_MCompanderBand("
+                        "_channelCount = %1, _topFrequency = %2Hz,"
+                        " _crossoverFilter = %3, _compander = %4,"
+                        " _blockLength = %5, _decimationFactor = %6,"
+                        " _compensationSampleCount = %7)",
+                        TOSTRING(_channelCount), TOSTRING(_topFrequency),
+                        _crossoverFilter.toString(), _compander.toString(),
+                        TOSTRING(_buffer.frameCount()),
+                        TOSTRING(_decimationFactor),
+                        TOSTRING(_compensationSampleCount));
+
+        return st;
+    }
+
+    /*--------------------*/
+
+    void _MCompanderBand::adapt (IN Real sampleRate,
+                                 IN Real attack,
+                                 IN Real release,
+                                 IN Real dBKnee,
+                                 IN Real dBThreshold,
+                                 IN Real ratio,
+                                 IN Real dBGain,
+                                 IN Real topFrequency)
+    {
+        Logging_trace8(">>: sampleRate = %1, attack = %2, release = %3,"
+                       " dBKnee = %4, dBThreshold = %5, ratio = %6,"
+                       " dBGain = %7, topFrequency = %8",
+                       TOSTRING(sampleRate), TOSTRING(attack),
+                       TOSTRING(release), TOSTRING(dBKnee),
+                       TOSTRING(dBThreshold), TOSTRING(ratio),
+                       TOSTRING(dBGain), TOSTRING(topFrequency));
+
+        _sampleRate  = sampleRate;
+        _settingList = RealList::fromList({attack, release, dBKnee,
+                                           dBThreshold, ratio, dBGain});
+        _adaptCompander();
+        _crossoverFilter.adapt(topFrequency, sampleRate);
+        _topFrequency = topFrequency;
+
+        Logging_trace1("<<: %1", toString());
+    }
+
+    /*--------------------*/
+
+    void _MCompanderBand::setChannelCount (IN Natural channelCount,
+                                           IN Natural blockLength)
+    {
+        Logging_trace2(">>: channelCount = %1, blockLength = %2",
+                       TOSTRING(channelCount), TOSTRING(blockLength));
+
+        _channelCount = channelCount;
+        _compander.setLength(channelCount, blockLength);
+        _buffer.setLength(channelCount);
+        _buffer.setFrameCount(blockLength);
+
+        if (_multirateIsReserved) {
+            _allocateMultirateState();
+        }
+
+        Logging_trace("<<");
+    }
+
+    /*--------------------*/
+
+    const _LRCrossoverFilter& _MCompanderBand::crossoverFilter () const
+    {
+        return _crossoverFilter;
+    }
+
+    /*--------------------*/
+
+    Real _MCompanderBand::topFrequency () const
+    {
+        return _topFrequency;
+    }
+
+    /*--------------------*/
+
+    AudioSample* _MCompanderBand::bufferArray (IN Natural channel)
+    {
+        return _buffer[channel].asArray();
+    }
+
+    /*--------------------*/
+
+    void _MCompanderBand::apply (IN Natural channelCount,
+                                 IN Natural count,
+                                 IN AudioSample* keyArray)
+    {
+        Logging_traceHot2(">>: channelCount = %1, count = %2",
+                          TOSTRING(channelCount), TOSTRING(count));
+
+        if (_decimationFactor == 1) {
+            _compander.applyBlock(_buffer, channelCount, count, keyArray);
+        } else {
+            _applyDecimated(channelCount, count, keyArray);
+        }
+
+        if (_compensationSampleCount > 0) {
+            _applyCompensation(channelCount, count);
+        }
+
+        Logging_traceHot("<<");
+    }
+
+    /*--------------------*/
+
+    void _MCompanderBand::addTo (INOUT AudioSampleListVector& outputBuffer,
+                                 IN Natural channelCount,
+                                 IN Natural position,
+                                 IN Natural count) const
+    {
+        Logging_trace3(">>: channelCount = %1, position = %2, count = %3",
+                       TOSTRING(channelCount), TOSTRING(position),
+                       TOSTRING(count));
+
+        for (Natural channel = 0;  channel < channelCount;  channel++) {
+            const AudioSample* bandArray = _buffer[channel].asArray();
+            AudioSample* outputArray =
+                outputBuffer[channel].asArray(position);
+
+            for (Natural i = 0;  i < count;  i++) {
+                outputArray[(size_t) i] += bandArray[(size_t) i];
+            }
+        }
+
+        Logging_trace("<<");
+    }
+
+    /*--------------------*/
+
+    void _MCompanderBand::copyFirstChannelState ()
+    {
+        _compander.copyFirstChannelState();
+
+        if (_multirateIsReserved) {
+            for (Natural channel = 1;  channel < _channelCount;
+                 channel++) {
+                _resamplerList[channel]->copyStateFrom(*_resamplerList[0]);
+                _pendingBuffer[channel]      = _pendingBuffer[0];
+                _queueBuffer[channel]        = _queueBuffer[0];
+                _compensationBuffer[channel] = _compensationBuffer[0];
+            }
+        }
+    }
+
+    /*--------------------*/
+
+    void _MCompanderBand::clear ()
+    {
+        _compander.clear();
+
+        if (_multirateIsReserved) {
+            for (HalfBandOversampler* resampler : _resamplerList) {
+                resampler->reset();
+            }
+
+            /* the queue starts with a group less one sample of
+               silence like after a change of the decimation */
+            for (AudioSampleList& queueList : _queueBuffer) {
+                queueList.setToZero();
+            }
+
+            for (AudioSampleList& delayList : _compensationBuffer) {
+                delayList.setToZero();
+            }
+
+            _pendingSampleCount = 0;
+            _queuedSampleCount  = _decimationFactor - 1;
+        }
+    }
+
+    /*--------------------*/
+
+    void
+    _MCompanderBand::setTransferFunctionTable (IN Natural entriesPerOctave,
+                                               IN Boolean isValidated)
+    {
+        Logging_trace2(">>: entriesPerOctave = %1, isValidated = %2",
+                       TOSTRING(entriesPerOctave),
+                       TOSTRING(isValidated));
+        _compander.setTransferFunctionTable(entriesPerOctave, isValidated);
+        Logging_trace("<<");
+    }
+
+    /*--------------------*/
+
+    Real _MCompanderBand::transferFunctionTableDeviation () const
+    {
+        return _compander.transferFunctionTableDeviation();
+    }
+
+    /*--------------------*/
+
+    void _MCompanderBand::setFastMath (IN Boolean isEnabled)
+    {
+        Logging_trace1(">>: %1", TOSTRING(isEnabled));
+        _compander.setFastMath(isEnabled);
+        Logging_trace("<<");
+    }
+
+    /*--------------------*/
+
+    void _MCompanderBand::setDetectorDecimation (IN Natural factor)
+    {
+        Logging_trace1(">>: %1", TOSTRING(factor));
+        _compander.setDetectorDecimation(factor);
+        Logging_trace("<<");
+    }
+
+    /*--------------------*/
+
+    void _MCompanderBand::setGainInterval (IN Natural sampleCount)
+    {
+        Logging_trace1(">>: %1", TOSTRING(sampleCount));
+        _compander.setGainInterval(sampleCount);
+        Logging_trace("<<");
+    }
+
+    /*--------------------*/
+
+    Real _MCompanderBand::takeGainReduction ()
+    {
+        return _compander.takeGainReduction();
+    }
+
+    /*--------------------*/
+
+    void _MCompanderBand::setLookahead (IN Natural sampleCount)
+    {
+        Logging_trace1(">>: %1", TOSTRING(sampleCount));
+
+        /* a decimated compander rounds the lookahead up to whole
+           samples at its rate; its delay lines first grow to the
+           full rate lookahead, such that a later return to the full
+           rate does not allocate */
+        _lookaheadSampleCount = sampleCount;
+        _compander.setLookahead(sampleCount);
+
+        if (_decimationFactor > 1) {
+            _compander.setLookahead((sampleCount + _decimationFactor - 1)
+                                    / _decimationFactor);
+        }
+
+        Logging_trace("<<");
+    }
+
+    /*--------------------*/
+
+    void _MCompanderBand::reserveMultirate ()
+    {
+        Logging_trace(">>");
+
+        if (!_multirateIsReserved) {
+            _multirateIsReserved = true;
+            _allocateMultirateState();
+        }
+
+        Logging_trace("<<");
+    }
+
+    /*--------------------*/
+
+    void _MCompanderBand::setDecimationFactor (IN Natural factor)
+    {
+        Logging_trace1(">>: %1", TOSTRING(factor));
+
+        if (factor != _decimationFactor) {
+            _decimationFactor = factor;
+
+            for (HalfBandOversampler* resampler : _resamplerList) {
+                resampler->setFactor(factor);
+            }
+
+            /* the queue starts with a group less one sample of
+               silence, such that each block finds enough samples */
+            for (AudioSampleList& queueList : _queueBuffer) {
+                queueList.setToZero();
+            }
+
+            _pendingSampleCount = 0;
+            _queuedSampleCount  = factor - 1;
+            _adaptCompander();
+            setLookahead(_lookaheadSampleCount);
+        }
+
+        Logging_trace("<<");
+    }
+
+    /*--------------------*/
+
+    Natural _MCompanderBand::multirateLatency () const
+    {
+        return _multirateLatency(_decimationFactor, _lookaheadSampleCount);
+    }
 
-    /*=====================*/
-    /* _MCompanderBandList */
-    /*=====================*/
+    /*--------------------*/
 
-    /**
-     * A <C>_MCompanderBandList</C> is a list of compander bands.
-     */
-    using _MCompanderBandList = GenericList<_MCompanderBand>;
+    void _MCompanderBand::setLatencyCompensation (IN Natural sampleCount)
+    {
+        Logging_trace1(">>: %1", TOSTRING(sampleCount));
 
-    /*============================================================*/
-    /*============================================================*/
+        if (sampleCount != _compensationSampleCount) {
+            _compensationSampleCount = sampleCount;
 
-    _Point2D::_Point2D ()
-        : x{0.0},
-          y{0.0}
+            for (AudioSampleList& delayList : _compensationBuffer) {
+                delayList.setToZero();
+            }
+        }
+
+        Logging_trace("<<");
+    }
+
+    /*--------------------*/
+
+    Natural _MCompanderBand::byteCount () const
     {
+        Natural result = (Natural{sizeof(_MCompanderBand)}
+                          + _compander.byteCount()
+                          + _bufferByteCount(_buffer)
+                          + SoXMemoryFootprint::listByteCount(_settingList)
+                          + SoXMemoryFootprint::listByteCount(_resamplerList)
+                          + _bufferByteCount(_pendingBuffer)
+                          + SoXMemoryFootprint::listByteCount(_pendingKeyList)
+                          + _bufferByteCount(_reducedBuffer)
+                          + SoXMemoryFootprint::listByteCount(_reducedKeyList)
+                          + _bufferByteCount(_queueBuffer)
+                          + _bufferByteCount(_compensationBuffer));
+
+        for (const HalfBandOversampler* resampler : _resamplerList) {
+            result += resampler->byteCount();
+        }
+
+        return result;
     }
 
     /*--------------------*/
 
-    _Point2D::_Point2D (IN Real newX, IN Real newY)
-        : x{newX},
-          y{newY}
+    Natural _MCompanderBand::lookaheadByteCount () const
     {
+        return _compander.lookaheadByteCount();
     }
 
     /*--------------------*/
 
-    String _Point2D::toString () const {
+    void _MCompanderBand::_adaptCompander ()
+    {
+        Logging_trace(">>");
+
+        /* the settings are only missing before the first
+           adaptation */
+        if (_settingList.length() > 0) {
+            const RealList& settingList = _settingList;
+            _compander.adapt(_sampleRate / Real{_decimationFactor},
+                             settingList[0], settingList[1],
+                             settingList[2], settingList[3],
+                             settingList[4], settingList[5]);
+        }
+
+        Logging_trace("<<");
+    }
+
+    /*--------------------*/
+
+    void _MCompanderBand::_allocateMultirateState ()
+    {
+        Logging_trace(">>");
+
+        const Natural blockLength = _buffer.frameCount();
+        const Natural maximumFactor = HalfBandOversampler::maximumFactor;
+
+        for (Natural channel = _channelCount;
+             channel < _resamplerList.length();  channel++) {
+            delete _resamplerList[channel];
+        }
+
+        const Natural oldChannelCount =
+            Natural::minimum(_resamplerList.length(), _channelCount);
+        _resamplerList.setLength(_channelCount, nullptr);
+
+        for (Natural channel = oldChannelCount;  channel < _channelCount;
+             channel++) {
+            _resamplerList[channel] = new HalfBandOversampler();
+        }
+
+        for (HalfBandOversampler* resampler : _resamplerList) {
+            resampler->setFactor(_decimationFactor);
+        }
+
+        /* the pending samples are less than a group, the queue
+           additionally takes the interpolated groups of a block */
+        _pendingBuffer.setLength(_channelCount);
+        _pendingBuffer.setFrameCount(blockLength + maximumFactor);
+        _pendingKeyList.setLength(blockLength + maximumFactor);
+        _reducedBuffer.setLength(_channelCount);
+        _reducedBuffer.setFrameCount(blockLength);
+        _reducedKeyList.setLength(blockLength);
+        _queueBuffer.setLength(_channelCount);
+        _queueBuffer.setFrameCount(blockLength
+                                   + Natural{2} * maximumFactor);
+        _compensationBuffer.setLength(_channelCount);
+        _compensationBuffer.setFrameCount(blockLength
+                                          + _maximumMultirateLatency());
+
+        for (AudioSampleList& queueList : _queueBuffer) {
+            queueList.setToZero();
+        }
+
+        for (AudioSampleList& delayList : _compensationBuffer) {
+            delayList.setToZero();
+        }
+
+        _pendingSampleCount = 0;
+        _queuedSampleCount  = _decimationFactor - 1;
+
+        Logging_trace("<<");
+    }
+
+    /*--------------------*/
+
+    void _MCompanderBand::_applyDecimated (IN Natural channelCount,
+                                           IN Natural count,
+                                           IN AudioSample* keyArray)
+    {
+        Logging_traceHot2(">>: channelCount = %1, count = %2",
+                          TOSTRING(channelCount), TOSTRING(count));
+
+        const size_t factor = (size_t) _decimationFactor;
+        const size_t chunkLength =
+            (size_t) HalfBandOversampler::maximumBlockLength;
+        const size_t sampleCount  = (size_t) count;
+        const size_t pendingCount = (size_t) _pendingSampleCount;
+        const size_t queuedCount  = (size_t) _queuedSampleCount;
+        const size_t totalCount   = pendingCount + sampleCount;
+        const size_t reducedCount = totalCount / factor;
+        const size_t groupedCount = reducedCount * factor;
+        const size_t newQueuedCount = queuedCount + groupedCount - sampleCount;
+
+        /* decimate all complete groups, the remaining samples are
+           kept for the next block */
+        for (Natural channel = 0;  channel < channelCount;  channel++) {
+            const AudioSample* bandArray = _buffer[channel].asArray();
+            AudioSample* pendingArray = _pendingBuffer[channel].asArray();
+            AudioSample* reducedArray = _reducedBuffer[channel].asArray();
+            HalfBandOversampler& resampler = *_resamplerList[channel];
+
+            for (size_t i = 0;  i < sampleCount;  i++) {
+                pendingArray[pendingCount + i] = bandArray[i];
+            }
+
+            for (size_t position = 0;  position < reducedCount;
+                 position += chunkLength) {
+                const size_t chunkCount =
+                    std::min(chunkLength, reducedCount - position);
+                resampler.downsample(&pendingArray[position * factor],
+                                     Natural{chunkCount},
+                                     &reducedArray[position]);
+            }
+
+            for (size_t i = groupedCount;  i < totalCount;  i++) {
+                pendingArray[i - groupedCount] = pendingArray[i];
+            }
+        }
+
+        /* the detector value of a group is its maximum */
+        const AudioSample* reducedKeyArray = nullptr;
+
+        if (keyArray != nullptr) {
+            AudioSample* pendingKeyArray = _pendingKeyList.asArray();
+            AudioSample* groupKeyArray = _reducedKeyList.asArray();
+
+            for (size_t i = 0;  i < sampleCount;  i++) {
+                pendingKeyArray[pendingCount + i] = keyArray[i];
+            }
+
+            for (size_t j = 0;  j < reducedCount;  j++) {
+                const AudioSample* groupArray =
+                    &pendingKeyArray[j * factor];
+                AudioSample value = groupArray[0];
+
+                for (size_t i = 1;  i < factor;  i++) {
+                    value = std::max(value, groupArray[i]);
+                }
+
+                groupKeyArray[j] = value;
+            }
+
+            for (size_t i = groupedCount;  i < totalCount;  i++) {
+                pendingKeyArray[i - groupedCount] = pendingKeyArray[i];
+            }
+
+            reducedKeyArray = groupKeyArray;
+        }
+
+        if (reducedCount > 0) {
+            _compander.applyBlock(_reducedBuffer, channelCount,
+                                  Natural{reducedCount}, reducedKeyArray);
+        }
+
+        /* interpolate the companded groups behind the queued
+           samples and output the head of the queue */
+        for (Natural channel = 0;  channel < channelCount;  channel++) {
+            AudioSample* bandArray = _buffer[channel].asArray();
+            AudioSample* queueArray = _queueBuffer[channel].asArray();
+            const AudioSample* reducedArray =
+                _reducedBuffer[channel].asArray();
+            HalfBandOversampler& resampler = *_resamplerList[channel];
+
+            for (size_t position = 0;  position < reducedCount;
+                 position += chunkLength) {
+                const size_t chunkCount =
+                    std::min(chunkLength, reducedCount - position);
+                resampler.upsample(&reducedArray[position],
+                                   Natural{chunkCount},
+                                   &queueArray[queuedCount
+                                               + position * factor]);
+            }
+
+            for (size_t i = 0;  i < sampleCount;  i++) {
+                bandArray[i] = queueArray[i];
+            }
+
+            for (size_t i = 0;  i < newQueuedCount;  i++) {
+                queueArray[i] = queueArray[sampleCount + i];
+            }
+        }
+
+        _pendingSampleCount = Natural{totalCount - groupedCount};
+        _queuedSampleCount  = Natural{newQueuedCount};
+
+        Logging_traceHot("<<");
+    }
+
+    /*--------------------*/
+
+    void _MCompanderBand::_applyCompensation (IN Natural channelCount,
+                                              IN Natural count)
+    {
+        Logging_traceHot2(">>: channelCount = %1, count = %2",
+                          TOSTRING(channelCount), TOSTRING(count));
+
+        const size_t delay = (size_t) _compensationSampleCount;
+        const size_t sampleCount = (size_t) count;
+
+        for (Natural channel = 0;  channel < channelCount;  channel++) {
+            AudioSample* bandArray = _buffer[channel].asArray();
+            AudioSample* delayArray = _compensationBuffer[channel].asArray();
+
+            for (size_t i = 0;  i < sampleCount;  i++) {
+                delayArray[delay + i] = bandArray[i];
+            }
+
+            for (size_t i = 0;  i < sampleCount;  i++) {
+                bandArray[i] = delayArray[i];
+            }
+
+            for (size_t i = 0;  i < delay;  i++) {
+                delayArray[i] = delayArray[sampleCount + i];
+            }
+        }
+
+        Logging_traceHot("<<");
+    }
+
+    /*============================================================*/
+
+    _LRCrossoverBank::_LRCrossoverBank ()
+        : _laneCount{0},
+          _lowpassCoefficientList{},
+          _highpassCoefficientList{},
+          _inputHistoryList{},
+          _lowpassHistoryList{},
+          _highpassHistoryList{},
+          _laneInputList{},
+          _laneOutputList{},
+          _bandArrayList{}
+    {
+        Logging_trace(">>");
+        Logging_trace1("<<: %1", toString());
+    }
+
+    /*--------------------*/
+
+    String _LRCrossoverBank::toString () const
+    {
         String st =
-            STR::expand("_Point2D(%1, %2)",
-                        TOSTRING(x), TOSTRING(y));
+            STR::expand("_LRCrossoverBank(laneCount = %1,"
+                        " lowpassCoefficients = %2,"
+                        " highpassCoefficients = %3)",
+                        TOSTRING(_laneCount),
+                        _lowpassCoefficientList.toString(),
+                        _highpassCoefficientList.toString());
         return st;
     }
 
     /*--------------------*/
 
-    void _Point2D::add (IN _Point2D otherPoint) {
-        x += otherPoint.x;
-        y += otherPoint.y;
+    void _LRCrossoverBank::resize (IN Natural laneCount,
+                                   IN Natural channelCount)
+    {
+        Logging_trace2(">>: laneCount = %1, channelCount = %2",
+                       TOSTRING(laneCount), TOSTRING(channelCount));
+
+        const Natural coefficientCount = _LRFilter::order * 2;
+        const Natural historyCount =
+            channelCount * Natural{_historyLength} * laneCount;
+        _laneCount = laneCount;
+        _lowpassCoefficientList.setLength(coefficientCount * laneCount);
+        _highpassCoefficientList.setLength(coefficientCount * laneCount);
+        _inputHistoryList.setLength(historyCount);
+        _lowpassHistoryList.setLength(historyCount);
+        _highpassHistoryList.setLength(historyCount);
+        _laneInputList.setLength(Natural{2} * (laneCount + 1));
+        _laneOutputList.setLength(laneCount);
+        _bandArrayList.setLength(laneCount);
+
+        /* filter histories start from silence */
+        _inputHistoryList.setToZero();
+        _lowpassHistoryList.setToZero();
+        _highpassHistoryList.setToZero();
+
+        Logging_trace("<<");
     }
 
     /*--------------------*/
 
-    void _Point2D::clear () {
-        x = 0.0;
-        y = 0.0;
+    void _LRCrossoverBank::setLane (IN Natural laneIndex,
+                                    IN _LRCrossoverFilter& filter)
+    {
+        Logging_trace1(">>: laneIndex = %1", TOSTRING(laneIndex));
+
+        const Natural coefficientCount = _LRFilter::order * 2;
+        const _LRFilter& lowpassFilter  = filter.lowpassFilter();
+        const _LRFilter& highpassFilter = filter.highpassFilter();
+
+        for (Natural i = 0;  i < coefficientCount;  i++) {
+            const Natural index = i * _laneCount + laneIndex;
+            _lowpassCoefficientList[index]  = lowpassFilter.coefficient(i);
+            _highpassCoefficientList[index] = highpassFilter.coefficient(i);
+        }
+
+        Logging_trace("<<");
     }
 
     /*--------------------*/
 
+    void _LRCrossoverBank::clearLane (IN Natural laneIndex)
+    {
+        Logging_trace1(">>: laneIndex = %1", TOSTRING(laneIndex));
 
-    Real _Point2D::distance (IN _Point2D otherPoint) const {
-        return Real::sqrt((x - otherPoint.x).sqr()
-                           + (y - otherPoint.y).sqr());
+        const Natural historyCount = _inputHistoryList.length();
+
+        for (Natural i = laneIndex;  i < historyCount;  i += _laneCount) {
+            _inputHistoryList[i]   = 0.0;
+            _lowpassHistoryList[i] = 0.0;
+            _highpassHistoryList[i] = 0.0;
+        }
+
+        Logging_trace("<<");
     }
 
     /*--------------------*/
 
-    void _Point2D::scale (IN Real factor) {
-        x *= factor;
-        y *= factor;
+    void _LRCrossoverBank::clear ()
+    {
+        _inputHistoryList.setToZero();
+        _lowpassHistoryList.setToZero();
+        _highpassHistoryList.setToZero();
     }
 
     /*--------------------*/
 
-    void _Point2D::subtract (IN _Point2D otherPoint) {
-        x -= otherPoint.x;
-        y -= otherPoint.y;
+    void _LRCrossoverBank::copyFirstChannelState ()
+    {
+        const Natural sectionLength = Natural{_historyLength} * _laneCount;
+        _copyFirstSection(_inputHistoryList, sectionLength);
+        _copyFirstSection(_lowpassHistoryList, sectionLength);
+        _copyFirstSection(_highpassHistoryList, sectionLength);
+    }
+
+    /*--------------------*/
+
+    void _LRCrossoverBank::apply (IN Natural channel,
+                                  IN AudioSample* inputArray,
+                                  IN Natural count,
+                                  INOUT _MCompanderBandList& bandList,
+                                  IN Natural bandCount)
+    {
+        Logging_traceHot2(">>: channel = %1, count = %2",
+                          TOSTRING(channel), TOSTRING(count));
+
+        const size_t order = (size_t) _LRFilter::order;
+        const size_t laneCount   = (size_t) _laneCount;
+        const size_t sampleCount = (size_t) count;
+        const size_t activeCount = (size_t) bandCount;
+        const size_t historyIndex =
+            (size_t) channel * _historyLength * laneCount;
+
+        /* the highpass output of the last band is not used, hence
+           only the other bands form the split tree evaluated as a
+           wavefront; the last band filters the final highpass
+           output in its band buffer afterwards */
+        const size_t treeLaneCount = activeCount - 1;
+
+        const AudioSample* lowB = _lowpassCoefficientList.asArray();
+        const AudioSample* lowA = lowB + order * laneCount;
+        const AudioSample* highB = _highpassCoefficientList.asArray();
+        const AudioSample* highA = highB + order * laneCount;
+        AudioSample* x     = _inputHistoryList.asArray(historyIndex);
+        AudioSample* yLow  = _lowpassHistoryList.asArray(historyIndex);
+        AudioSample* yHigh = _highpassHistoryList.asArray(historyIndex);
+        AudioSample* laneOutput = _laneOutputList.asArray();
+        AudioSample* currentInput = _laneInputList.asArray();
+        AudioSample* nextInput = currentInput + laneCount + 1;
+        AudioSample** bandArray = _bandArrayList.asArray();
+
+        for (size_t k = 0;  k < activeCount;  k++) {
+            bandArray[k] = bandList[k]->bufferArray(channel);
+        }
+
+        AudioSample* lastBandArray = bandArray[treeLaneCount];
+
+        if (treeLaneCount == 0) {
+            for (size_t t = 0;  t < sampleCount;  t++) {
+                lastBandArray[t] = inputArray[t];
+            }
+        } else if (sampleCount > 0) {
+            const size_t stepCount = sampleCount + treeLaneCount - 1;
+            const size_t finalLane = treeLaneCount - 1;
+
+            for (size_t t = 0;  t < stepCount;  t++) {
+                /* lane k is active when sample t - k is in block */
+                const size_t firstLane =
+                    (t < sampleCount ? 0 : t - sampleCount + 1);
+                const size_t lastLane =
+                    (t < treeLaneCount ? t : finalLane);
+
+                if (t < sampleCount) {
+                    currentInput[0] = inputArray[t];
+                }
+
+                for (size_t k = firstLane;  k <= lastLane;  k++) {
+                    const AudioSample x0 = currentInput[k];
+                    AudioSample lowValue  = lowB[k] * x0;
+                    AudioSample highValue = highB[k] * x0;
+
+                    for (size_t j = 1;  j < order;  j++) {
+                        const size_t c = j * laneCount + k;
+                        const size_t h = (j - 1) * laneCount + k;
+                        lowValue  += (lowB[c] * x[h] - lowA[c] * yLow[h]);
+                        highValue += (highB[c] * x[h]
+                                      - highA[c] * yHigh[h]);
+                    }
+
+                    for (size_t j = order - 2;  j > 0;  j--) {
+                        const size_t h = j * laneCount + k;
+                        x[h]     = x[h - laneCount];
+                        yLow[h]  = yLow[h - laneCount];
+                        yHigh[h] = yHigh[h - laneCount];
+                    }
+
+                    x[k]     = x0;
+                    yLow[k]  = DenormalGuard::flushed(lowValue);
+                    yHigh[k] = DenormalGuard::flushed(highValue);
+                    laneOutput[k]   = lowValue;
+                    nextInput[k + 1] = highValue;
+                }
+
+                for (size_t k = firstLane;  k <= lastLane;  k++) {
+                    bandArray[k][t - k] = laneOutput[k];
+                }
+
+                if (lastLane == finalLane) {
+                    lastBandArray[t - finalLane] = nextInput[treeLaneCount];
+                }
+
+                std::swap(currentInput, nextInput);
+            }
+        }
+
+        _applyLowpassInPlace(channel, treeLaneCount, lastBandArray,
+                             sampleCount);
+        Logging_traceHot("<<");
+    }
+
+    /*--------------------*/
+
+    void _LRCrossoverBank::_applyLowpassInPlace (IN Natural channel,
+                                                 IN size_t laneIndex,
+                                                 INOUT AudioSample* array,
+                                                 IN size_t sampleCount)
+    {
+        const size_t order = (size_t) _LRFilter::order;
+        const size_t laneCount = (size_t) _laneCount;
+        const size_t k = laneIndex;
+        const size_t historyIndex =
+            (size_t) channel * _historyLength * laneCount;
+
+        const AudioSample* lowB = _lowpassCoefficientList.asArray();
+        const AudioSample* lowA = lowB + order * laneCount;
+        AudioSample* x    = _inputHistoryList.asArray(historyIndex);
+        AudioSample* yLow = _lowpassHistoryList.asArray(historyIndex);
+
+        /* an identity lowpass (the usual case for the unbounded last
+           band) leaves the samples as they are */
+        Boolean isIdentity = (lowB[k] == 1.0);
+
+        for (size_t j = 1;  j < order;  j++) {
+            const size_t c = j * laneCount + k;
+            isIdentity = (isIdentity && lowB[c] == 0.0 && lowA[c] == 0.0);
+        }
+
+        /* for an identity only the final samples must go to the
+           histories */
+        const size_t firstPosition =
+            (!isIdentity || sampleCount < _historyLength ? 0
+             : sampleCount - _historyLength);
+
+        for (size_t t = firstPosition;  t < sampleCount;  t++) {
+            const AudioSample x0 = array[t];
+            AudioSample lowValue = x0;
+
+            if (!isIdentity) {
+                lowValue = lowB[k] * x0;
+
+                for (size_t j = 1;  j < order;  j++) {
+                    const size_t c = j * laneCount + k;
+                    const size_t h = (j - 1) * laneCount + k;
+                    lowValue += (lowB[c] * x[h] - lowA[c] * yLow[h]);
+                }
+            }
+
+            for (size_t j = order - 2;  j > 0;  j--) {
+                const size_t h = j * laneCount + k;
+                x[h]    = x[h - laneCount];
+                yLow[h] = yLow[h - laneCount];
+            }
+
+            x[k]    = x0;
+            yLow[k] = DenormalGuard::flushed(lowValue);
+            array[t] = lowValue;
+        }
+    }
+
+    /*--------------------*/
+
+    Natural _LRCrossoverBank::byteCount () const
+    {
+        using FP = SoXMemoryFootprint;
+        return (Natural{sizeof(_LRCrossoverBank)}
+                + FP::listByteCount(_lowpassCoefficientList)
+                + FP::listByteCount(_highpassCoefficientList)
+                + FP::listByteCount(_inputHistoryList)
+                + FP::listByteCount(_lowpassHistoryList)
+                + FP::listByteCount(_highpassHistoryList)
+                + FP::listByteCount(_laneInputList)
+                + FP::listByteCount(_laneOutputList)
+                + FP::listByteCount(_bandArrayList));
     }
 
     /*============================================================*/
 
-    String _TfSegment::toString () const {
-        String st =
-            STR::expand("_TfSegment("
-                        "isLine = %1, start = %2, end = %3,"
-                        " a2 = %4, a1 = %5)",
-                        TOSTRING(isStraightLine),
-                        startPoint.toString(),
-                        endPoint.toString(),
-                        TOSTRING(a2),
-                        TOSTRING(a1));
+    /**
+     * Sets all elements of <C>list</C> to <C>value</C> without
+     * reallocation.
+     *
+     * @param[inout] list   the list to be filled
+     * @param[in]    value  the value for all elements
+     */
+    template <typename ElementType>
+    static void _setToValue (INOUT GenericList<ElementType>& list,
+                             IN ElementType value)
+    {
+        ElementType* elementArray = list.asArray();
+        const size_t count = (size_t) list.length();
 
-        return st;
+        for (size_t i = 0;  i < count;  i++) {
+            elementArray[i] = value;
+        }
     }
 
     /*--------------------*/
 
-    bool _TfSegment::domainContains (IN Real x) const {
-        return startPoint.x <= x && x <= endPoint.x;
+    const Natural _FIRCrossoverBank::partitionLength = 256;
+    const Natural _FIRCrossoverBank::halfFilterLength = 1024;
+
+    /*--------------------*/
+
+    _FIRCrossoverBank::_FIRCrossoverBank ()
+        : _laneCount{0},
+          _channelCount{0},
+          _partitionCount{0},
+          _fft{Natural{2} * partitionLength},
+          _windowList{},
+          _topFrequencyList{},
+          _bandLimitList{},
+          _filterSpectrumList{},
+          _inputSpectrumList{},
+          _newestSlotList{},
+          _inputBlockList{},
+          _blockPositionList{},
+          _outputBlockList{},
+          _spectrumSumList{},
+          _timeList{}
+    {
+        Logging_trace(">>");
+
+        /* a Blackman window gives a stopband attenuation of about
+           74dB with a transition width of 5.5 / filterLength times
+           the sample rate */
+        const Natural filterLength = Natural{2} * halfFilterLength + 1;
+        const double pi = (double) Real::pi;
+        _windowList.setLength(filterLength);
+
+        for (Natural n = 0;  n < filterLength;  n++) {
+            const double phase =
+                2.0 * pi * (double) n / (double) (filterLength - 1);
+            _windowList[n] =
+                0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+        }
+
+        _partitionCount =
+            (filterLength + partitionLength - 1) / partitionLength;
+
+        Logging_trace1("<<: %1", toString());
     }
 
     /*--------------------*/
 
-    Real _TfSegment::gradient () const {
-        return ((endPoint.y - startPoint.y)
-                / (endPoint.x - startPoint.x));
+    String _FIRCrossoverBank::toString () const
+    {
+        String st =
+            STR::expand("_FIRCrossoverBank(laneCount = %1,"
+                        " channelCount = %2, partitionCount = %3,"
+                        " bandLimits = %4)",
+                        TOSTRING(_laneCount), TOSTRING(_channelCount),
+                        TOSTRING(_partitionCount),
+                        _bandLimitList.toString());
+        return st;
     }
 
     /*--------------------*/
 
-    Real _TfSegment::length () const {
-        return startPoint.distance(endPoint);
+    void _FIRCrossoverBank::resize (IN Natural laneCount,
+                                    IN Natural channelCount)
+    {
+        Logging_trace2(">>: laneCount = %1, channelCount = %2",
+                       TOSTRING(laneCount), TOSTRING(channelCount));
+
+        const Natural spectrumLength = Natural{2} * partitionLength + 2;
+        const Natural blockPairLength = Natural{2} * partitionLength;
+        _laneCount    = laneCount;
+        _channelCount = channelCount;
+
+        /* all lanes start with the full band, the band limits are
+           marked as invalid for a recalculation */
+        _topFrequencyList.clear();
+        _topFrequencyList.setLength(laneCount, 0.5);
+        _bandLimitList.clear();
+        _bandLimitList.setLength(Natural{2} * laneCount, -1.0);
+        _filterSpectrumList.setLength(laneCount * _partitionCount
+                                      * spectrumLength);
+        _inputSpectrumList.setLength(channelCount * _partitionCount
+                                     * spectrumLength);
+        _newestSlotList.setLength(channelCount);
+        _inputBlockList.setLength(channelCount * blockPairLength);
+        _blockPositionList.setLength(channelCount);
+        _outputBlockList.setLength(channelCount * laneCount
+                                   * partitionLength);
+        _spectrumSumList.setLength(spectrumLength);
+        _timeList.setLength(blockPairLength);
+        clear();
+
+        Logging_trace("<<");
     }
 
     /*--------------------*/
 
-    void _TfSegment::adaptCoefficients (IN _Point2D point) {
-        Logging_trace1(">>: %1", point.toString());
+    Boolean _FIRCrossoverBank::isAllocated () const
+    {
+        return (_laneCount > 0);
+    }
 
-        if (length() == 0.0) {
-            a1 = 0.0;
-            a2 = 0.0;
-        } else {
-            const Real inA  = point.x - startPoint.x;
-            const Real outA = point.y - startPoint.y;
-            const Real inB  = endPoint.x - startPoint.x;
-            const Real outB = endPoint.y - startPoint.y;
-            a2 = (outB / inB - outA / inA) / (inB - inA);
-            a1 = outA / inA - a2 * inA;
-        }
+    /*--------------------*/
+
+    void _FIRCrossoverBank::setTopFrequency (IN Natural laneIndex,
+                                             IN Real topFrequency,
+                                             IN Real sampleRate)
+    {
+        Logging_trace3(">>: laneIndex = %1, topFrequency = %2,"
+                       " sampleRate = %3",
+                       TOSTRING(laneIndex), TOSTRING(topFrequency),
+                       TOSTRING(sampleRate));
+
+        /* frequencies at or above the Nyquist frequency make the
+           lowpass a pure delay */
+        const Real relativeFrequency = topFrequency / sampleRate;
+        _topFrequencyList[laneIndex] =
+            (relativeFrequency < 0.5 ? relativeFrequency : Real{0.5});
 
-        Logging_trace1("<<: %1", toString());
+        Logging_trace("<<");
     }
 
     /*--------------------*/
 
-    _Point2D _TfSegment::interpolate (IN Real position) const {
-        Logging_trace1(">>: %1", TOSTRING(position));
-
-        const Real segmentLength = length();
-        Real relativePosition;
+    void _FIRCrossoverBank::updateFilters ()
+    {
+        Logging_trace(">>");
 
-        if (segmentLength == 0.0) {
-            relativePosition = 0.0;
-        } else {
-            relativePosition = position / segmentLength;
-        }
+        Real bottomFrequency = 0.0;
 
-        _Point2D result = endPoint;
-        result.subtract(startPoint);
-        result.scale(relativePosition);
-        result.add(startPoint);
+        for (Natural laneIndex = 0;  laneIndex < _laneCount;
+             laneIndex++) {
+            const Real topFrequency =
+                (_topFrequencyList[laneIndex] < bottomFrequency
+                 ? bottomFrequency : _topFrequencyList[laneIndex]);
+            const Natural index = Natural{2} * laneIndex;
 
-        Logging_trace1("<<: %1", result.toString());
-        return result;
-    }
+            if (_bandLimitList[index] != bottomFrequency
+                || _bandLimitList[index + 1] != topFrequency) {
+                _bandLimitList[index]     = bottomFrequency;
+                _bandLimitList[index + 1] = topFrequency;
+                _calculateLane(laneIndex, bottomFrequency, topFrequency);
+            }
 
-    /*============================================================*/
+            bottomFrequency = topFrequency;
+        }
 
-    const Real _TransferFunction::_leftDbOffset = 10.0;
+        Logging_trace("<<");
+    }
 
     /*--------------------*/
 
-    void _TransferFunction::_adaptCurvesInSegmentList () {
+    void _FIRCrossoverBank::clear ()
+    {
         Logging_trace(">>");
 
-        const Real radius = _dBKnee * log(10) / 20.0;
-        const Natural segmentCount = _segmentList.size();
-
-        if (segmentCount >= 2) {
-            _TfSegment* segment = nullptr;
-            _TfSegment* nextSegment = &_segmentList[0];
+        _setToValue(_inputSpectrumList, 0.0);
+        _setToValue(_newestSlotList, size_t{0});
+        _setToValue(_inputBlockList, 0.0);
+        _setToValue(_blockPositionList, size_t{0});
+        _setToValue(_outputBlockList, 0.0);
 
-            for (Natural i = 0;  i < segmentCount;  i++) {
-                _TfSegment* previousSegment = segment;
-                segment = nextSegment;
-                nextSegment++;
+        Logging_trace("<<");
+    }
 
-                if (!segment->isStraightLine) {
-                    const _Point2D originalNextSegmentStartPoint =
-                        nextSegment->startPoint;
-                    _Point2D& segmentStartPoint = segment->startPoint;
-                    _Point2D& segmentEndPoint = segment->endPoint;
+    /*--------------------*/
 
-                    /* adapt curve segment to the left */
-                    Real length = previousSegment->length();
-                    Real position = Real::maximum(0.0, length - radius);
-                    segmentStartPoint = previousSegment->interpolate(position);
-                    previousSegment->endPoint = segmentStartPoint;
+    void _FIRCrossoverBank::clearLane (IN Natural laneIndex)
+    {
+        Logging_trace1(">>: laneIndex = %1", TOSTRING(laneIndex));
 
-                    /* adapt curve segment to the right */
-                    length = nextSegment->length();
-                    position = Real::minimum(radius, length / 2.0);
-                    segmentEndPoint = nextSegment->interpolate(position);
-                    nextSegment->startPoint = segmentEndPoint;
+        const size_t blockLength = (size_t) partitionLength;
 
-                    /* find some intermediate point */
-                    _Point2D intermediatePoint = segmentStartPoint;
-                    intermediatePoint.add(segmentEndPoint);
-                    intermediatePoint.add(originalNextSegmentStartPoint);
-                    intermediatePoint.scale(1/3.0);
+        for (Natural channel = 0;  channel < _channelCount;  channel++) {
+            double* outputArray =
+                _outputBlockList.asArray((channel * _laneCount + laneIndex)
+                                         * partitionLength);
 
-                    /* set coefficients of curve */
-                    segment->adaptCoefficients(intermediatePoint);
-                }
+            for (size_t i = 0;  i < blockLength;  i++) {
+                outputArray[i] = 0.0;
             }
         }
 
-        Logging_trace1("<<: %1", toString());
+        Logging_trace("<<");
     }
 
     /*--------------------*/
 
-    void _TransferFunction::_shiftScaleSegmentList ()
+    void _FIRCrossoverBank::copyFirstChannelState ()
     {
-        Logging_trace(">>");
-
-        Real factor = log(10) / 20;
-
-        for (_TfSegment& segment : _segmentList) {
-            segment.startPoint.y += _dBGain;
-            segment.endPoint.y   += _dBGain;
-            segment.startPoint.scale(factor);
-            segment.endPoint.scale(factor);
+        const Natural spectrumLength = Natural{2} * partitionLength + 2;
+        _copyFirstSection(_inputSpectrumList,
+                          _partitionCount * spectrumLength);
+        _copyFirstSection(_newestSlotList, 1);
+        _copyFirstSection(_inputBlockList, Natural{2} * partitionLength);
+        _copyFirstSection(_blockPositionList, 1);
+        _copyFirstSection(_outputBlockList, _laneCount * partitionLength);
+    }
 
-            if (segment.isStraightLine) {
-                segment.a2 = 0.0;
-                segment.a1 = segment.gradient();
-            }
-        }
+    /*--------------------*/
 
-        Logging_trace1("<<: %1", toString());
+    Natural _FIRCrossoverBank::latency () const
+    {
+        return partitionLength + halfFilterLength;
     }
 
     /*--------------------*/
 
-    void _TransferFunction::_updateSegmentListEnds ()
+    void _FIRCrossoverBank::apply (IN Natural channel,
+                                   IN AudioSample* inputArray,
+                                   IN Natural count,
+                                   INOUT _MCompanderBandList& bandList,
+                                   IN Natural bandCount)
     {
-        Logging_trace(">>");
+        Logging_traceHot2(">>: channel = %1, count = %2",
+                          TOSTRING(channel), TOSTRING(count));
+
+        const size_t blockLength = (size_t) partitionLength;
+        const size_t sampleCount = (size_t) count;
+        const size_t activeCount = (size_t) bandCount;
+        double* currentBlock =
+            _inputBlockList.asArray(channel * Natural{2} * partitionLength
+                                    + partitionLength);
+        const double* outputBlockArray =
+            _outputBlockList.asArray(channel * _laneCount
+                                     * partitionLength);
+        size_t position = _blockPositionList[channel];
+        size_t i = 0;
+
+        /* the samples are collected up to a complete block, while
+           the outputs of the previous block are handed out */
+        while (i < sampleCount) {
+            const size_t runLength =
+                std::min(blockLength - position, sampleCount - i);
+
+            for (size_t j = 0;  j < runLength;  j++) {
+                currentBlock[position + j] = (double) inputArray[i + j];
+            }
 
-        Natural segmentCount = _segmentList.size();
+            for (size_t k = 0;  k < activeCount;  k++) {
+                const double* outputArray =
+                    outputBlockArray + k * blockLength + position;
+                AudioSample* bandArray =
+                    bandList[k]->bufferArray(channel) + i;
 
-        for (Natural i = 0;  i < segmentCount - 1;  i++) {
-            _TfSegment& segment = _segmentList[i];
-            const _TfSegment& nextSegment = _segmentList[i+1];
-            segment.endPoint = nextSegment.startPoint;
+                for (size_t j = 0;  j < runLength;  j++) {
+                    bandArray[j] = outputArray[j];
+                }
+            }
+
+            position += runLength;
+            i += runLength;
+
+            if (position == blockLength) {
+                _processBlock(channel, bandCount);
+                position = 0;
+            }
         }
 
-        Logging_trace1("<<: %1", toString());
+        _blockPositionList[channel] = position;
+
+        Logging_traceHot("<<");
     }
 
     /*--------------------*/
 
-    void _TransferFunction::_updateSegmentListKinds () {
-        Logging_trace(">>");
+    void _FIRCrossoverBank::_calculateLane (IN Natural laneIndex,
+                                            IN Real bottomFrequency,
+                                            IN Real topFrequency)
+    {
+        Logging_trace3(">>: laneIndex = %1, bottom = %2, top = %3",
+                       TOSTRING(laneIndex), TOSTRING(bottomFrequency),
+                       TOSTRING(topFrequency));
+
+        const size_t blockLength = (size_t) partitionLength;
+        const size_t partitionCount = (size_t) _partitionCount;
+        const size_t spectrumLength = 2 * blockLength + 2;
+        const size_t center = (size_t) halfFilterLength;
+        const size_t filterLength = 2 * center + 1;
+        const double pi = (double) Real::pi;
+        const double* windowArray = _windowList.asArray();
+        double* timeArray = _timeList.asArray();
+        double* spectrumArray =
+            _filterSpectrumList.asArray(laneIndex * _partitionCount
+                                        * Natural{spectrumLength});
+
+        /* the windowed-sinc lowpass at a relative frequency f has
+           the taps 2f sinc(2f d) at distance d from the center; at
+           the Nyquist frequency it is a pure delay */
+        const auto lowpassTap =
+            [pi] (IN double frequency, IN double distance) {
+                double result;
+
+                if (frequency >= 0.5) {
+                    result = (distance == 0.0 ? 1.0 : 0.0);
+                } else if (distance == 0.0) {
+                    result = 2.0 * frequency;
+                } else {
+                    result = (std::sin(2.0 * pi * frequency * distance)
+                              / (pi * distance));
+                }
 
-        Natural segmentCount = _segmentList.size();
+                return result;
+            };
 
-        if (segmentCount >= 2) {
-            bool isLastSegment = true;
-            for (Natural i = segmentCount;  i-- > 0;) {
-                _TfSegment& segment = _segmentList[i];
-                const bool isStraightLine = ((i % 2) == 0);
-                segment.isStraightLine = isStraightLine;
+        const double bottom = (double) bottomFrequency;
+        const double top    = (double) topFrequency;
 
-                if (!isStraightLine && !isLastSegment) {
-                    const _TfSegment& nextSegment =
-                        _segmentList[i + 1];
-                    segment.startPoint = nextSegment.startPoint;
-                }
+        for (size_t partition = 0;  partition < partitionCount;
+             partition++) {
+            for (size_t j = 0;  j < 2 * blockLength;  j++) {
+                timeArray[j] = 0.0;
+            }
 
-                isLastSegment = false;
+            for (size_t j = 0;  j < blockLength;  j++) {
+                const size_t n = partition * blockLength + j;
+
+                if (n < filterLength) {
+                    const double distance = (double) n - (double) center;
+                    timeArray[j] =
+                        windowArray[n] * (lowpassTap(top, distance)
+                                          - lowpassTap(bottom, distance));
+                }
             }
+
+            _fft.forward(timeArray,
+                         spectrumArray + partition * spectrumLength);
         }
 
-        Logging_trace1("<<: %1", toString());
+        Logging_trace("<<");
     }
 
     /*--------------------*/
 
-    void _TransferFunction::_updateSegmentList () {
-        Logging_trace(">>");
-        /* pass 1: fill all segments with kind and start values */
-        _updateSegmentListKinds();
+    void _FIRCrossoverBank::_processBlock (IN Natural channel,
+                                           IN Natural bandCount)
+    {
+        Logging_traceHot1(">>: channel = %1", TOSTRING(channel));
+
+        const size_t blockLength = (size_t) partitionLength;
+        const size_t partitionCount = (size_t) _partitionCount;
+        const size_t spectrumLength = 2 * blockLength + 2;
+        const size_t binCount = blockLength + 1;
+        double* blockPair =
+            _inputBlockList.asArray(channel * Natural{2} * partitionLength);
+        double* inputSpectrumArray =
+            _inputSpectrumList.asArray(channel * _partitionCount
+                                       * Natural{spectrumLength});
+        const double* filterSpectrumArray = _filterSpectrumList.asArray();
+        double* sumArray  = _spectrumSumList.asArray();
+        double* timeArray = _timeList.asArray();
+        double* outputBlockArray =
+            _outputBlockList.asArray(channel * _laneCount
+                                     * partitionLength);
+
+        /* the newest spectrum replaces the oldest one in the
+           frequency domain delay line */
+        size_t& newestSlot = _newestSlotList[channel];
+        newestSlot = (newestSlot + 1) % partitionCount;
+        _fft.forward(blockPair,
+                     inputSpectrumArray + newestSlot * spectrumLength);
+
+        for (size_t k = 0;  k < (size_t) bandCount;  k++) {
+            const double* laneSpectrumArray =
+                filterSpectrumArray + k * partitionCount * spectrumLength;
+
+            for (size_t b = 0;  b < spectrumLength;  b++) {
+                sumArray[b] = 0.0;
+            }
 
-        /* pass 2: fill all segments with end values and gradient
-                   for the straight lines */
-        _updateSegmentListEnds();
+            /* partition p of the filter meets the input block from p
+               blocks before */
+            for (size_t p = 0;  p < partitionCount;  p++) {
+                const size_t slot =
+                    (newestSlot + partitionCount - p) % partitionCount;
+                const double* x = inputSpectrumArray + slot * spectrumLength;
+                const double* h = laneSpectrumArray + p * spectrumLength;
+
+                for (size_t b = 0;  b < binCount;  b++) {
+                    const double xr = x[2 * b];
+                    const double xi = x[2 * b + 1];
+                    const double hr = h[2 * b];
+                    const double hi = h[2 * b + 1];
+                    sumArray[2 * b]     += xr * hr - xi * hi;
+                    sumArray[2 * b + 1] += xr * hi + xi * hr;
+                }
+            }
 
-        /* pass 3: adapt transfer function by output gain and make
-                   values natural logarithms */
-        _shiftScaleSegmentList();
+            /* overlap-save: only the second half is free of the
+               circular wraparound */
+            _fft.inverse(sumArray, timeArray);
+            double* outputArray = outputBlockArray + k * blockLength;
 
-        /* pass 4: adapt transfer function knees */
-        _adaptCurvesInSegmentList();
+            for (size_t j = 0;  j < blockLength;  j++) {
+                outputArray[j] =
+                    DenormalGuard::flushed(timeArray[blockLength + j]);
+            }
+        }
 
-        Logging_trace1("<<: %1", toString());
+        /* the current block becomes the previous one */
+        for (size_t j = 0;  j < blockLength;  j++) {
+            blockPair[j] = blockPair[blockLength + j];
+        }
+
+        Logging_traceHot("<<");
     }
 
     /*--------------------*/
 
-    _TransferFunction::_TransferFunction ()
-        : _segmentList{3},
-          _minimumLinearInValue{1.0},
-          _minimumLinearOutValue{1.0},
-          _dBGain{0.0},
-          _dBKnee{0.01}
+    Natural _FIRCrossoverBank::byteCount () const
     {
-        Logging_trace(">>");
-        Logging_trace1("<<: %1", toString());
+        using FP = SoXMemoryFootprint;
+        return (Natural{sizeof(_FIRCrossoverBank)}
+                + _fft.byteCount()
+                + FP::listByteCount(_windowList)
+                + FP::listByteCount(_topFrequencyList)
+                + FP::listByteCount(_bandLimitList)
+                + FP::listByteCount(_filterSpectrumList)
+                + FP::listByteCount(_inputSpectrumList)
+                + FP::listByteCount(_newestSlotList)
+                + FP::listByteCount(_inputBlockList)
+                + FP::listByteCount(_blockPositionList)
+                + FP::listByteCount(_outputBlockList)
+                + FP::listByteCount(_spectrumSumList)
+                + FP::listByteCount(_timeList));
     }
 
-    /*--------------------*/
+    /*============================================================*/
 
-    String _TransferFunction::toString () const {
+    static String _mCompanderBandListToString (IN _MCompanderBandList& list)
+    {
+        const Natural bandCount = list.size();
         String st;
-        bool isFirst = true;
 
-        for (const _TfSegment& segment : _segmentList) {
-            st += (isFirst ? "" : ", ");
-            st += segment.toString();
-            isFirst = false;
+        for (Natural bandIndex = 0;  bandIndex < bandCount;  bandIndex++) {
+            const _MCompanderBand* band = list[bandIndex];
+            st += (bandIndex == 0 ? "" : ", ");
+            st += STR::expand("band_%1 = %2",
+                              TOSTRING(bandIndex),
+                              (band == nullptr ? "unreserved"
+                               : band->toString()));
         }
 
-        st = STR::expand("TransferFct("
-                         "minLin = %1, minOut = %2, dBGain = %3dB,"
-                         " dBKnee = %4dB, segments = (%5))",
-                         TOSTRING(_minimumLinearInValue),
-                         TOSTRING(_minimumLinearOutValue),
-                         TOSTRING(_dBGain), TOSTRING(_dBKnee),
-                         st);
+        st = STR::expand("_MCompanderBandList(%1)", st);
         return st;
+
     }
 
-    /*--------------------*/
+}
 
-    void _TransferFunction::adapt (IN Real dBKnee,
-                                   IN Real cDBThreshold,
-                                   IN Real cRatio,
-                                   IN Real dBGain) {
-        Logging_trace4(">>: dBKnee = %1, dBThreshold = %2,"
-                       " ratio = %3, dBGain = %4",
-                       TOSTRING(dBKnee), TOSTRING(cDBThreshold),
-                       TOSTRING(cRatio), TOSTRING(dBGain));
+/*============================================================*/
 
-        const Real ratio = Real::maximum(1.0, cRatio);
-        const Real dBThreshold = Real::minimum(0.0, cDBThreshold);
-        _dBKnee = Real::maximum(0.0, dBKnee);
-        _dBGain = dBGain;
+const Natural SoXMultibandCompander::maximumDetectorDecimation{32};
+const Natural SoXMultibandCompander::maximumGainInterval{32};
 
-        /* set data for the straight segments */
-        _Point2D& segmentStart = _segmentList[0].startPoint;
-        segmentStart = _Point2D(dBThreshold - _leftDbOffset, 0.0);
+/*--------------------*/
 
-        _TfSegment& segment = _segmentList[2];
-        segment.startPoint = _Point2D(dBThreshold, 0.0);
-        segment.endPoint   = _Point2D(0.0, (ratio - 1.0) * dBThreshold / ratio);
+SoXMultibandCompander::SoXMultibandCompander ()
+    : _maximumBandCount{0},
+      _reservedBandCount{0},
+      _bandCount{0},
+      _channelCount{0},
+      _activeChannelCount{0},
+      _signalBuffer{},
+      _blockSampleCount{0},
+      _keyList{},
+      _keyArray{nullptr},
+      _blockLength{SoXKernelTuning::current().companderBlockLength},
+      _lookaheadSampleCount{0},
+      _maximumLookaheadSampleCount{0},
+      _tableEntriesPerOctave{0},
+      _tableIsValidated{false},
+      _usesFastMath{false},
+      _detectorDecimationFactor{1},
+      _gainInterval{1},
+      _crossoverIsLinearPhase{false},
+      _multirateIsReserved{false},
+      _bandsAreMultirate{false},
+      _bandAlignmentLatency{0},
+      _sampleRate{44100.0}
+{
+    Logging_trace(">>");
+    _companderBandList = new _MCompanderBandList();
+    _crossoverBank = new _LRCrossoverBank();
+    _firCrossoverBank = new _FIRCrossoverBank();
+    Logging_trace1("<<: %1", toString());
+}
 
-        _updateSegmentList();
+/*--------------------*/
 
-        const _Point2D& firstSegmentStart = _segmentList[1].startPoint;
-        _minimumLinearInValue  = firstSegmentStart.x.exp();
-        _minimumLinearOutValue = firstSegmentStart.y.exp();
+SoXMultibandCompander::~SoXMultibandCompander () {
+    Logging_trace(">>");
+    _MCompanderBandList* list = (_MCompanderBandList*) _companderBandList;
 
-        Logging_trace1("<<: %1", toString());
+    for (_MCompanderBand* companderBand : *list) {
+        delete companderBand;
     }
 
-    /*--------------------*/
+    delete list;
+    _LRCrossoverBank* bank = (_LRCrossoverBank*) _crossoverBank;
+    delete bank;
+    _FIRCrossoverBank* firBank = (_FIRCrossoverBank*) _firCrossoverBank;
+    delete firBank;
+    Logging_trace("<<");
+}
 
-    Real _TransferFunction::apply (IN Real cValue) const {
-        Real result;
+/*--------------------*/
 
-        if (cValue <= _minimumLinearInValue) {
-            result = _minimumLinearOutValue;
-        } else {
-            const Real value = Real::minimum(cValue, 1.0);
-            Real lnValue = value.log();
-            result = value;
+String SoXMultibandCompander::toString () const {
+    const _MCompanderBandList* companderBandList =
+        (_MCompanderBandList*) _companderBandList;
+    String st =
+        STR::expand("SoXMultibandCompander("
+                    "_maximumBandCount = %1, _reservedBandCount = %2,"
+                    " _effectiveBandCount = %3, _channelCount = %4,"
+                    " _crossoverIsLinearPhase = %5,"
+                    " _bandsAreMultirate = %6,"
+                    " _companderBandList = %7)",
+                    TOSTRING(_maximumBandCount),
+                    TOSTRING(Natural{_reservedBandCount.load()}),
+                    TOSTRING(_bandCount), TOSTRING(_channelCount),
+                    TOSTRING(_crossoverIsLinearPhase),
+                    TOSTRING(_bandsAreMultirate),
+                    _mCompanderBandListToString(*companderBandList));
 
-            for (const _TfSegment& segment : _segmentList) {
-                if (segment.domainContains(lnValue)) {
-                    lnValue -= segment.startPoint.x;
-                    const Real a1 = segment.a1;
-                    const Real a2 = segment.a2;
-                    const Real y  = segment.startPoint.y;
-                    const Real lnResult = y + lnValue * (a2 * lnValue + a1);
-                    result = lnResult.exp();
-                    break;
-                }
-            }
-        }
+    return st;
+}
+
+/*--------------------*/
+
+void
+SoXMultibandCompander::setCompanderBandData (IN Natural bandIndex,
+                                             IN Real sampleRate,
+                                             IN Real attack,
+                                             IN Real release,
+                                             IN Real dBKnee,
+                                             IN Real dBThreshold,
+                                             IN Real ratio,
+                                             IN Real dBGain,
+                                             IN Real topFrequency)
+{
+    Logging_trace9(">>: bandIndex = %1, sampleRate = %2, attack = %3,"
+                   " release = %4, dBKnee = %5, dBThreshold = %6,"
+                   " ratio = %7, dBGain = %8, topFrequency = %9",
+                   TOSTRING(bandIndex), TOSTRING(sampleRate),
+                   TOSTRING(attack), TOSTRING(release),
+                   TOSTRING(dBKnee), TOSTRING(dBThreshold),
+                   TOSTRING(ratio), TOSTRING(dBGain),
+                   TOSTRING(topFrequency));
 
-        return result;
+    _MCompanderBandList* companderBandList =
+        (_MCompanderBandList*) _companderBandList;
+    _MCompanderBand& companderBand = *companderBandList->at(bandIndex);
+    companderBand.adapt(sampleRate,
+                        attack, release, dBKnee, dBThreshold,
+                        ratio, dBGain, topFrequency);
+    _LRCrossoverBank* crossoverBank = (_LRCrossoverBank*) _crossoverBank;
+    crossoverBank->setLane(bandIndex, companderBand.crossoverFilter());
+    _sampleRate = sampleRate;
+
+    /* the FIR lanes are only maintained while they are in use, the
+       others are set up when linear phase is enabled */
+    if (_crossoverIsLinearPhase) {
+        _FIRCrossoverBank* firCrossoverBank =
+            (_FIRCrossoverBank*) _firCrossoverBank;
+        firCrossoverBank->setTopFrequency(bandIndex, topFrequency,
+                                          sampleRate);
+        firCrossoverBank->updateFilters();
     }
 
-    /*============================================================*/
+    _updateDecimationFactors();
+    Logging_trace1("<<: %1", toString());
+}
 
-    Real _Compander::_adaptEnvelopeTime (IN Real t,
-                                         IN Real sampleRate) {
-        const Real one{1.0};
-        return Real::minimum(one,
-                             one - (-one / (sampleRate * t)).exp());
-    }
+/*--------------------*/
 
-    /*--------------------*/
+void SoXMultibandCompander::resize (IN Natural maximumBandCount,
+                                    IN Natural channelCount) {
+    Logging_trace2(">>: maximumBandCount = %1, channelCount = %2",
+                   TOSTRING(maximumBandCount), TOSTRING(channelCount));
+
+    const Natural reservedBandCount =
+        Natural::minimum(maximumBandCount,
+                         Natural{_reservedBandCount.load()});
+    _maximumBandCount = maximumBandCount;
+    _bandCount        = Natural::minimum(reservedBandCount, _bandCount);
+    _channelCount     = channelCount;
+
+    /* the block length tuned for this machine is only taken over
+       here, since all buffers are sized anyway */
+    _blockLength = SoXKernelTuning::current().companderBlockLength;
+
+    /* drop the bands beyond the maximum band count, the slots for
+       the others are kept */
+    _MCompanderBandList* companderBandList =
+        (_MCompanderBandList*) _companderBandList;
 
-    _Compander::_Compander ()
-        : _transferFunction{},
-          _channelsAreAggregated{true},
-          _attackTimeList{},
-          _releaseTimeList{},
-          _volumeList{}
-    {
-        Logging_trace(">>");
-        _volumeList.setLength(_maximumChannelCount);
-        _attackTimeList.setLength(_maximumChannelCount);
-        _releaseTimeList.setLength(_maximumChannelCount);
-        Logging_trace1("<<: %1", toString());
+    for (Natural bandIndex = maximumBandCount;
+         bandIndex < companderBandList->length();  bandIndex++) {
+        delete companderBandList->at(bandIndex);
     }
 
-    /*--------------------*/
-
-    String _Compander::toString () const {
-        String st =
-            STR::expand("_Compander("
-                        "transferFunction = %1, _channelsAreAggregated = %2,"
-                        " _attackTimeList = %3, _releaseTimeList = %4,"
-                        " _volumeList = %5",
-                        _transferFunction.toString(),
-                        TOSTRING(_channelsAreAggregated),
-                        _attackTimeList.toString(),
-                        _releaseTimeList.toString(),
-                        _volumeList.toString());
-
-        return st;
+    companderBandList->setLength(maximumBandCount, nullptr);
+
+    /* the crossover bank is small, hence it has a lane for each
+       possible band and starts with cleared filter histories */
+    _LRCrossoverBank* crossoverBank = (_LRCrossoverBank*) _crossoverBank;
+    crossoverBank->resize(maximumBandCount, channelCount);
+
+    /* only the bands reserved so far get buffers for the new
+       channel count */
+    for (Natural bandIndex = 0;  bandIndex < reservedBandCount;
+         bandIndex++) {
+        _MCompanderBand& companderBand = *companderBandList->at(bandIndex);
+        companderBand.setChannelCount(channelCount, _blockLength);
+        companderBand.setLookahead(_lookaheadSampleCount);
+        crossoverBank->setLane(bandIndex, companderBand.crossoverFilter());
     }
 
-    /*--------------------*/
+    _reservedBandCount = (size_t) reservedBandCount;
 
-    void _Compander::adapt (IN Real sampleRate,
-                            IN Real attack,
-                            IN Real release,
-                            IN Real dBKnee,
-                            IN Real dBThreshold,
-                            IN Real ratio,
-                            IN Real dBGain)
-    {
-        Logging_trace7(">>: sampleRate = %1, attack = %2, release = %3,"
-                       " dBKnee = %4, dBThreshold = %5, ratio = %6,"
-                       " dBGain = %7",
-                       TOSTRING(sampleRate), TOSTRING(attack),
-                       TOSTRING(release), TOSTRING(dBKnee),
-                       TOSTRING(dBThreshold), TOSTRING(ratio),
-                       TOSTRING(dBGain));
+    _FIRCrossoverBank* firCrossoverBank =
+        (_FIRCrossoverBank*) _firCrossoverBank;
 
-        Real time;
-        _transferFunction.adapt(dBKnee, dBThreshold, ratio, dBGain);
-        _channelsAreAggregated = true;
-        _volumeList.fill(1.0);
-        time = _adaptEnvelopeTime(attack, sampleRate);
-        _attackTimeList.fill(time);
-        time = _adaptEnvelopeTime(release, sampleRate);
-        _releaseTimeList.fill(time);
+    if (firCrossoverBank->isAllocated()) {
+        firCrossoverBank->resize(maximumBandCount, channelCount);
 
-        Logging_trace1("<<: %1", toString());
+        if (_crossoverIsLinearPhase) {
+            _setFIRCrossoverLanes();
+        }
     }
 
-    /*--------------------*/
+    _signalBuffer.setLength(channelCount);
+    _signalBuffer.setFrameCount(_blockLength);
+    _keyList.setLength(_blockLength);
+    _updateDecimationFactors();
 
-    void _Compander::apply (IN AudioSampleList& inputSampleList,
-                            OUT AudioSampleList& outputSampleList,
-                            IN bool outputValuesAreSummed)
-    {
-        Logging_trace(">>");
+    Logging_trace("<<");
+}
 
-        Natural channel;
-        const Natural channelCount = inputSampleList.size();
+/*--------------------*/
 
-        if (_channelsAreAggregated) {
-            /* use settings of first channel to represent all
-               channels */
-            channel = 0;
-            const AudioSample maximumSample =
-                _maximumAbsoluteSample(inputSampleList);
-            _integrateVolume(channel, maximumSample);
-        } else {
-            for (channel = 0;  channel < channelCount;  channel++) {
-                const AudioSample inputSample = inputSampleList[channel];
-                _integrateVolume(channel, inputSample);
-            }
-        }
+void SoXMultibandCompander::reserve (IN Natural bandCount)
+{
+    Logging_trace1(">>: bandCount = %1", TOSTRING(bandCount));
 
-        for (channel = 0;  channel < channelCount;  channel++) {
-            const AudioSample inputSample = inputSampleList[channel];
-            const Real currentVolume = _volumeList[channel];
-            const Real amplificationFactor =
-                _transferFunction.apply(currentVolume);
-            AudioSample outputSample = inputSample * amplificationFactor;
+    const Natural reservedBandCount{_reservedBandCount.load()};
+    const Natural requiredBandCount =
+        Natural::minimum(bandCount, _maximumBandCount);
+    _MCompanderBandList* companderBandList =
+        (_MCompanderBandList*) _companderBandList;
 
-            if (outputValuesAreSummed) {
-                outputSample += outputSampleList[channel];
-            }
+    /* a new band gets buffers and delay lines like the existing
+       bands: the delay lines first grow to the maximum lookahead
+       set so far, such that a later lookahead change does not
+       allocate */
+    for (Natural bandIndex = reservedBandCount;
+         bandIndex < requiredBandCount;  bandIndex++) {
+        _MCompanderBand* companderBand =
+            companderBandList->at(bandIndex);
 
-            outputSampleList[channel] = outputSample;
+        if (companderBand == nullptr) {
+            companderBand = new _MCompanderBand();
+            companderBandList->at(bandIndex) = companderBand;
         }
 
-        Logging_trace("<<");
+        companderBand->setChannelCount(_channelCount, _blockLength);
+        companderBand->setTransferFunctionTable(_tableEntriesPerOctave,
+                                                _tableIsValidated);
+        companderBand->setFastMath(_usesFastMath);
+        companderBand->setDetectorDecimation(_detectorDecimationFactor);
+        companderBand->setGainInterval(_gainInterval);
+        companderBand->setLookahead(_maximumLookaheadSampleCount);
+        companderBand->setLookahead(_lookaheadSampleCount);
+
+        if (_multirateIsReserved) {
+            companderBand->reserveMultirate();
+        }
     }
 
-    /*--------------------*/
+    /* publish the new bands only when they are complete */
+    if (requiredBandCount > reservedBandCount) {
+        _reservedBandCount = (size_t) requiredBandCount;
+    }
 
-    void _Compander::_integrateVolume (IN Natural channel,
-                                       IN Real inputVolume)
-    {
-        Logging_trace2(">>: channel = %1, volume = %2",
-                       TOSTRING(channel), TOSTRING(inputVolume));
+    Logging_trace1("<<: reservedBandCount = %1",
+                   TOSTRING(Natural{_reservedBandCount.load()}));
+}
 
-        Real volume = _volumeList[channel];
-        const Real delta = inputVolume - volume;
-        const RealList& timeList = (delta > 0.0
-                                    ? _attackTimeList
-                                    : _releaseTimeList);
-        const Real increment = timeList[channel];
-        volume += (delta * increment);
+/*--------------------*/
 
-        if (_channelsAreAggregated) {
-            /* volume represents all channels */
-            _volumeList.fill(volume);
-        } else {
-            _volumeList[channel] = volume;
-        }
+void SoXMultibandCompander::release ()
+{
+    Logging_trace(">>");
 
-        Logging_trace1("<<: volume = %1", TOSTRING(volume));
+    _MCompanderBandList* companderBandList =
+        (_MCompanderBandList*) _companderBandList;
+
+    for (_MCompanderBand*& companderBand : *companderBandList) {
+        delete companderBand;
+        companderBand = nullptr;
     }
 
-    /*--------------------*/
+    _reservedBandCount = 0;
+    _bandCount = 0;
+    _channelCount = 0;
+    _maximumLookaheadSampleCount = _lookaheadSampleCount;
+    _crossoverIsLinearPhase = false;
+    _multirateIsReserved = false;
+    _bandsAreMultirate = false;
+    _bandAlignmentLatency = 0;
+
+    /* the banks and buffers are shrunk to empty lists, their
+       capacity is given back as well */
+    _LRCrossoverBank* crossoverBank = (_LRCrossoverBank*) _crossoverBank;
+    delete crossoverBank;
+    _crossoverBank = new _LRCrossoverBank();
+    _FIRCrossoverBank* firCrossoverBank =
+        (_FIRCrossoverBank*) _firCrossoverBank;
+    delete firCrossoverBank;
+    _firCrossoverBank = new _FIRCrossoverBank();
+    _signalBuffer = {};
+    _keyList = {};
 
-    AudioSample
-    _Compander::_maximumAbsoluteSample (IN AudioSampleList& sampleList) {
-        AudioSample result = 0.0;
+    Logging_trace1("<<: %1", toString());
+}
 
-        for (const AudioSample& value : sampleList) {
-            const AudioSample absValue = value.abs();
+/*--------------------*/
 
-            if (absValue > result) {
-                result = absValue;
-            }
-        }
+void
+SoXMultibandCompander::setTransferFunctionTable
+                           (IN Natural entriesPerOctave,
+                            IN Boolean isValidated)
+{
+    Logging_trace2(">>: entriesPerOctave = %1, isValidated = %2",
+                   TOSTRING(entriesPerOctave), TOSTRING(isValidated));
 
-        return result;
+    _tableEntriesPerOctave = entriesPerOctave;
+    _tableIsValidated      = isValidated;
+    _MCompanderBandList* companderBandList =
+        (_MCompanderBandList*) _companderBandList;
+
+    for (_MCompanderBand* companderBand : *companderBandList) {
+        if (companderBand != nullptr) {
+            companderBand->setTransferFunctionTable(entriesPerOctave,
+                                                    isValidated);
+        }
     }
 
-    /*--------------------*/
+    Logging_trace("<<");
+}
 
-    void _Compander::setLength (IN Natural channelCount) {
-        Logging_trace1(">>: %1", TOSTRING(channelCount));
+/*--------------------*/
 
-        _volumeList.setLength(channelCount);
-        _attackTimeList.setLength(channelCount);
-        _releaseTimeList.setLength(channelCount);
+Real SoXMultibandCompander::transferFunctionTableDeviation () const
+{
+    const _MCompanderBandList* companderBandList =
+        (_MCompanderBandList*) _companderBandList;
+    Real result = 0.0;
 
-        Logging_trace1("<<: %1", toString());
+    for (Natural bandIndex = 0;  bandIndex < _bandCount;  bandIndex++) {
+        const Real deviation =
+            companderBandList->at(bandIndex)
+                ->transferFunctionTableDeviation();
+        result = Real::maximum(result, deviation);
     }
 
-    /*============================================================*/
+    return result;
+}
 
-    const Natural _LRFilter::order{5};
+/*--------------------*/
 
-    /*--------------------*/
+void SoXMultibandCompander::setFastMath (IN Boolean isEnabled)
+{
+    Logging_trace1(">>: %1", TOSTRING(isEnabled));
 
-    _LRFilter::_LRFilter ()
-            : IIRFilter(order)
-    {
-        Logging_trace1(">>: %1", TOSTRING(order));
-        Logging_trace1("<<: %1", toString());
+    _usesFastMath = isEnabled;
+    _MCompanderBandList* companderBandList =
+        (_MCompanderBandList*) _companderBandList;
+
+    for (_MCompanderBand* companderBand : *companderBandList) {
+        if (companderBand != nullptr) {
+            companderBand->setFastMath(isEnabled);
+        }
     }
 
-    /*--------------------*/
+    Logging_trace("<<");
+}
 
-    void _LRFilter::adapt (IN RealList& coefficientListA,
-                           IN RealList& coefficientListB) {
-        Logging_trace2(">>: listA = %1, listB = %2",
-                       coefficientListA.toString(),
-                       coefficientListB.toString());
+/*--------------------*/
 
-        Natural i = 0;
+void SoXMultibandCompander::setDetectorDecimation (IN Natural factor)
+{
+    Logging_trace1(">>: %1", TOSTRING(factor));
 
-        for (Natural j = 0;  j < 2;  j++) {
-            const RealList& coefficientList =
-                (j == 0
-                 ? coefficientListA
-                 : coefficientListB);
-            _data[i + 0] = coefficientList[0].sqr();
-            _data[i + 1] = Real{2.0} * coefficientList[0] * coefficientList[1];
-            _data[i + 2] = (Real{2.0} * coefficientList[0] * coefficientList[2]
-                            + coefficientList[1].sqr());
-            _data[i + 3] = Real{2.0} * coefficientList[1] * coefficientList[2];
-            _data[i + 4] = coefficientList[2].sqr();
-            i += order;
-        }
+    _detectorDecimationFactor =
+        Natural::maximum(1, Natural::minimum(maximumDetectorDecimation,
+                                             factor));
+    _MCompanderBandList* companderBandList =
+        (_MCompanderBandList*) _companderBandList;
 
-        Logging_trace1("<<: %1", toString());
+    for (_MCompanderBand* companderBand : *companderBandList) {
+        if (companderBand != nullptr) {
+            companderBand->setDetectorDecimation(_detectorDecimationFactor);
+        }
     }
 
-    /*============================================================*/
+    Logging_trace1("<<: %1", TOSTRING(_detectorDecimationFactor));
+}
 
-    _LRCrossoverFilter::_LRCrossoverFilter ()
-        : _lowpassFilter{},
-          _highpassFilter{}
-    {
-        Logging_trace(">>");
-        _lowpassFilter.set(1.0);
-        _highpassFilter.set(0.0);
-        Logging_trace1("<<: %1", toString());
-    }
+/*--------------------*/
 
-    /*--------------------*/
+Natural SoXMultibandCompander::detectorDecimation () const
+{
+    return _detectorDecimationFactor;
+}
 
-    String _LRCrossoverFilter::toString () const
-    {
-        String st = ("_LRCrossoverFilter("
-                     "lowpass = " + _lowpassFilter.toString()
-                     + ", highpass = " + _highpassFilter.toString()
-                     + ")");
-        return st;
-    }
+/*--------------------*/
 
-    /*--------------------*/
+void SoXMultibandCompander::setGainInterval (IN Natural sampleCount)
+{
+    Logging_trace1(">>: %1", TOSTRING(sampleCount));
 
-    void _LRCrossoverFilter::adapt (IN Real frequency,
-                                    IN Real sampleRate) {
-        Logging_trace2(">>: frequency = %1, sampleRate = %2",
-                       TOSTRING(frequency), TOSTRING(sampleRate));
+    _gainInterval = Natural::minimum(maximumGainInterval, sampleCount);
+    _MCompanderBandList* companderBandList =
+        (_MCompanderBandList*) _companderBandList;
 
-        if (frequency >= sampleRate / 2.0) {
-            _lowpassFilter.set(1.0);
-            _highpassFilter.set(0.0);
-        } else {
-            const Real w0 = Real::twoPi * frequency / sampleRate;
-            const Real filterQuality = sqrt(0.5);
-            const Real alpha = w0.sin() / (Real{2.0} * filterQuality);
-            const Real cosW0 = w0.cos();
-            RealList coefficientListA{Natural{3}};
-            RealList coefficientListB{Natural{3}};
-            RealList coefficientListC{Natural{3}};
+    for (_MCompanderBand* companderBand : *companderBandList) {
+        if (companderBand != nullptr) {
+            companderBand->setGainInterval(_gainInterval);
+        }
+    }
 
-            /* biquad lowpass filter numerator */
-            coefficientListA[0] = (Real{1.0} - cosW0) / Real{2.0};
-            coefficientListA[1] = Real{1.0} - cosW0;
-            coefficientListA[2] = coefficientListA[0];
+    Logging_trace1("<<: %1", TOSTRING(_gainInterval));
+}
 
-            /* biquad highpass filter numerator */
-            coefficientListB[0] = (Real{1.0} + cosW0) / Real{2.0};
-            coefficientListB[1] = -Real{1.0} - cosW0;
-            coefficientListB[2] = coefficientListB[0];
+/*--------------------*/
 
-            /* biquad LP/HP filter denominator */
-            coefficientListC[0] = Real{1.0} + alpha;
-            coefficientListC[1] = -Real{2.0} *cosW0;
-            coefficientListC[2] = Real{1.0} - alpha;
+Natural SoXMultibandCompander::gainInterval () const
+{
+    return _gainInterval;
+}
 
-            /* normalize coefficients */
-            Real referenceValue = Real{1.0} / coefficientListC[0];
-            coefficientListA.multiply(referenceValue);
-            coefficientListB.multiply(referenceValue);
-            coefficientListC.multiply(referenceValue);
+/*--------------------*/
 
-            _lowpassFilter.adapt(coefficientListA,
-                                 coefficientListC);
-            _highpassFilter.adapt(coefficientListB,
-                                  coefficientListC);
-        }
+void SoXMultibandCompander::setLookahead (IN Natural sampleCount)
+{
+    Logging_trace1(">>: %1", TOSTRING(sampleCount));
 
-        Logging_trace1("<<: %1", toString());
+    _lookaheadSampleCount = sampleCount;
+    _maximumLookaheadSampleCount =
+        Natural::maximum(_maximumLookaheadSampleCount, sampleCount);
+    _MCompanderBandList* companderBandList =
+        (_MCompanderBandList*) _companderBandList;
+
+    for (_MCompanderBand* companderBand : *companderBandList) {
+        if (companderBand != nullptr) {
+            companderBand->setLookahead(sampleCount);
+        }
     }
 
-    /*--------------------*/
+    /* the rounding of the lookahead in decimated bands changes
+       their alignment */
+    _updateDecimationFactors();
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+Natural SoXMultibandCompander::lookahead () const
+{
+    return _lookaheadSampleCount;
+}
+
+/*--------------------*/
+
+void SoXMultibandCompander::reserveLinearPhaseCrossover ()
+{
+    Logging_trace(">>");
 
-    void
-    _LRCrossoverFilter::apply (IN AudioSampleRingBuffer& inputBuffer,
-                               OUT AudioSampleRingBuffer& outputBufferLow,
-                               OUT AudioSampleRingBuffer& outputBufferHigh)
-    {
-        Logging_trace(">>");
-        _lowpassFilter.apply(inputBuffer, outputBufferLow);
-        _highpassFilter.apply(inputBuffer, outputBufferHigh);
-        Logging_trace("<<");
+    _FIRCrossoverBank* firCrossoverBank =
+        (_FIRCrossoverBank*) _firCrossoverBank;
+
+    if (!firCrossoverBank->isAllocated()) {
+        firCrossoverBank->resize(_maximumBandCount, _channelCount);
     }
 
-    /*--------------------*/
+    Logging_trace("<<");
+}
 
-    void _LRCrossoverFilter::setToIdentity () {
-        Logging_trace(">>");
-        _lowpassFilter.set(1.0);
-        _highpassFilter.set(0.0);
-        Logging_trace1("<<: %1", toString());
-    }
+/*--------------------*/
 
-    /*============================================================*/
+void SoXMultibandCompander::setLinearPhaseCrossover (IN Boolean isEnabled)
+{
+    Logging_trace1(">>: %1", TOSTRING(isEnabled));
 
-    /**
-     * Returns string representation of <C>buffer</C>.
-     */
-    static String _sampleBufferToString (IN _CompanderSampleBuffer& buffer)
-    {
-        const Natural channelCount = buffer.size();
-        String st;
+    if (isEnabled != _crossoverIsLinearPhase) {
+        if (!isEnabled) {
+            /* the recursive filters restart from silence */
+            _LRCrossoverBank* crossoverBank =
+                (_LRCrossoverBank*) _crossoverBank;
 
-        for (Natural channel = 0;  channel < channelCount;  channel++) {
-            st += (channel == 0 ? "" : ", ");
-
-            for (Natural stream = 0;  stream < _companderStreamKindCount;
-                 stream++) {
-                const AudioSampleRingBuffer* ringBuffer =
-                    buffer[channel][(size_t) stream];
-                const String bufferAsString =
-                    (ringBuffer == NULL ? "NULL" : ringBuffer->toString());
-                st += STR::expand("channel_%1_%2 = (%3)",
-                                  TOSTRING(channel) +
-                                  _streamKindAsString[(size_t) stream],
-                                  bufferAsString);
+            for (Natural bandIndex = 0;  bandIndex < _bandCount;
+                 bandIndex++) {
+                crossoverBank->clearLane(bandIndex);
             }
+        } else {
+            /* fallback without prior reservation: this allocates */
+            reserveLinearPhaseCrossover();
+            _FIRCrossoverBank* firCrossoverBank =
+                (_FIRCrossoverBank*) _firCrossoverBank;
+            firCrossoverBank->clear();
+            _setFIRCrossoverLanes();
         }
 
-        st = STR::expand("_CompanderSampleBuffer(%1)", st);
-
-        return st;
+        _crossoverIsLinearPhase = isEnabled;
     }
 
-    /*============================================================*/
+    Logging_trace("<<");
+}
 
-    const Real _MCompanderBand::maxTopFrequency = 1E9;
+/*--------------------*/
 
-    /*--------------------*/
+Boolean SoXMultibandCompander::crossoverIsLinearPhase () const
+{
+    return _crossoverIsLinearPhase;
+}
 
-    _MCompanderBand::_MCompanderBand ()
-        : _channelCount{0},
-          _compander{},
-          _topFrequency{maxTopFrequency},
-          _crossoverFilter{},
-          _buffer{},
-          _inputSampleList{}
-    {
-        Logging_trace(">>");
-        Logging_trace1("<<: %1", toString());
-    }
+/*--------------------*/
 
-    /*--------------------*/
+void SoXMultibandCompander::reserveMultirateBands ()
+{
+    Logging_trace(">>");
 
-    String _MCompanderBand::toString () const
-    {
-        String st =
-            STR::expand("_MCompanderBand("
-                        "_channelCount = %1, _topFrequency = %2Hz,"
-                        " _crossoverFilter = %3, _compander = %4,"
-                        " _buffer = %5, _inputSampleList = %6)",
-                        TOSTRING(_channelCount), TOSTRING(_topFrequency),
-                        _crossoverFilter.toString(), _compander.toString(),
-                        _sampleBufferToString(_buffer),
-                        _inputSampleList.toString());
+    _MCompanderBandList* companderBandList =
+        (_MCompanderBandList*) _companderBandList;
+    const Natural reservedBandCount{_reservedBandCount.load()};
+    _multirateIsReserved = true;
 
-        return st;
+    for (Natural bandIndex = 0;  bandIndex < reservedBandCount;
+         bandIndex++) {
+        companderBandList->at(bandIndex)->reserveMultirate();
     }
 
-    /*--------------------*/
+    Logging_trace("<<");
+}
 
-    void _MCompanderBand::adapt (IN Real sampleRate,
-                                 IN Real attack,
-                                 IN Real release,
-                                 IN Real dBKnee,
-                                 IN Real dBThreshold,
-                                 IN Real ratio,
-                                 IN Real dBGain,
-                                 IN Real topFrequency)
-    {
-        Logging_trace8(">>: sampleRate = %1, attack = %2, release = %3,"
-                       " dBKnee = %4, dBThreshold = %5, ratio = %6,"
-                       " dBGain = %7, topFrequency = %8",
-                       TOSTRING(sampleRate), TOSTRING(attack),
-                       TOSTRING(release), TOSTRING(dBKnee),
-                       TOSTRING(dBThreshold), TOSTRING(ratio),
-                       TOSTRING(dBGain), TOSTRING(topFrequency));
+/*--------------------*/
 
-        _compander.adapt(sampleRate, attack, release,
-                         dBKnee, dBThreshold, ratio, dBGain);
-        _crossoverFilter.adapt(topFrequency, sampleRate);
-        _topFrequency = topFrequency;
+void SoXMultibandCompander::setMultirateBands (IN Boolean isEnabled)
+{
+    Logging_trace1(">>: %1", TOSTRING(isEnabled));
 
-        Logging_trace1("<<: %1", toString());
+    if (isEnabled != _bandsAreMultirate) {
+        if (isEnabled && !_multirateIsReserved) {
+            /* fallback without prior reservation: this allocates */
+            reserveMultirateBands();
+        }
+
+        _bandsAreMultirate = isEnabled;
+        _updateDecimationFactors();
     }
 
-    /*--------------------*/
+    Logging_trace("<<");
+}
 
-    void _MCompanderBand::setChannelCount (IN Natural channelCount)
-    {
-        Logging_trace1(">>: %1", TOSTRING(channelCount));
-        _channelCount = channelCount;
-        _buffer.setLength(channelCount);
-        _compander.setLength(channelCount);
-        _inputSampleList.setLength(channelCount);
-        Logging_trace("<<");
-    }
+/*--------------------*/
 
-    /*--------------------*/
+Boolean SoXMultibandCompander::bandsAreMultirate () const
+{
+    return _bandsAreMultirate;
+}
 
-    void _MCompanderBand::setBuffer (IN Natural channel,
-                                    IN _CompanderStreamKind stream,
-                                    AudioSampleRingBuffer* buffer)
-    {
-        Logging_trace1(">>: channel = %1", TOSTRING(channel));
-        _buffer[channel][stream] = buffer;
-        Logging_trace("<<");
-    }
+/*--------------------*/
 
-    /*--------------------*/
+Natural SoXMultibandCompander::latency () const
+{
+    const _FIRCrossoverBank* firCrossoverBank =
+        (_FIRCrossoverBank*) _firCrossoverBank;
+    const Natural crossoverLatency =
+        (_crossoverIsLinearPhase ? firCrossoverBank->latency() : 0);
+    return (_lookaheadSampleCount + crossoverLatency
+            + _bandAlignmentLatency);
+}
 
-    void _MCompanderBand::apply (OUT AudioSampleList& outputSampleList)
-    {
-        Logging_trace(">>");
+/*--------------------*/
 
-        for (Natural channel = 0;  channel < _channelCount;  channel++) {
-            const _CompanderSampleBufferElement& bufferElement =
-                _buffer[channel];
-            const AudioSampleRingBuffer* outputBufferLow =
-                bufferElement[_kindLowOutputStream];
-            AudioSample inputSample = outputBufferLow->first();
-            _inputSampleList[channel] = inputSample;
-        }
+void
+SoXMultibandCompander::bandCrossoverCoefficients
+                           (IN Natural bandIndex,
+                            OUT RealList& coefficientList) const
+{
+    Logging_trace1(">>: %1", TOSTRING(bandIndex));
 
-        _compander.apply(_inputSampleList, outputSampleList, true);
-        Logging_trace("<<");
+    const _MCompanderBandList* companderBandList =
+        (_MCompanderBandList*) _companderBandList;
+    const Natural sectionLength = _LRFilter::order * 2;
+    coefficientList.clear();
+    coefficientList.setLength(sectionLength * (bandIndex + 1));
+    Natural position = 0;
+
+    for (Natural i = 0;  i <= bandIndex;  i++) {
+        const _LRCrossoverFilter& crossoverFilter =
+            companderBandList->at(i)->crossoverFilter();
+        const _LRFilter& filter =
+            (i < bandIndex ? crossoverFilter.highpassFilter()
+             : crossoverFilter.lowpassFilter());
+
+        for (Natural j = 0;  j < sectionLength;  j++) {
+            coefficientList[position++] = filter.coefficient(j);
+        }
     }
 
-    /*--------------------*/
+    Logging_trace1("<<: %1", coefficientList.toString());
+}
 
-    void _MCompanderBand::calculateCrossover ()
-    {
-        Logging_trace(">>");
+/*--------------------*/
 
-        for (_CompanderSampleBufferElement& bufferElement : _buffer) {
-            const AudioSampleRingBuffer* inputBuffer =
-                bufferElement[_kindInputStream];
-            AudioSampleRingBuffer* outputBufferLow =
-                bufferElement[_kindLowOutputStream];
-            AudioSampleRingBuffer* outputBufferHigh =
-                bufferElement[_kindHighOutputStream];
+Real SoXMultibandCompander::takeGainReduction (IN Natural bandIndex)
+{
+    _MCompanderBandList* companderBandList =
+        (_MCompanderBandList*) _companderBandList;
+    return companderBandList->at(bandIndex)->takeGainReduction();
+}
 
-            _crossoverFilter.apply(*inputBuffer,
-                                   *outputBufferLow,
-                                   *outputBufferHigh);
-        }
+/*--------------------*/
 
-        Logging_trace("<<");
+SoXMemoryFootprint SoXMultibandCompander::memoryFootprint () const
+{
+    const _MCompanderBandList* companderBandList =
+        (_MCompanderBandList*) _companderBandList;
+    const _LRCrossoverBank* bank = (_LRCrossoverBank*) _crossoverBank;
+    const _FIRCrossoverBank* firBank =
+        (_FIRCrossoverBank*) _firCrossoverBank;
+    SoXMemoryFootprint result;
+    Natural& descriptorByteCount = result.descriptorByteCount;
+
+    descriptorByteCount =
+        (Natural{sizeof(_MCompanderBandList)}
+         + SoXMemoryFootprint::listByteCount(*companderBandList)
+         + bank->byteCount()
+         + firBank->byteCount()
+         + _bufferByteCount(_signalBuffer)
+         + SoXMemoryFootprint::listByteCount(_keyList));
+
+    for (const _MCompanderBand* band : *companderBandList) {
+        if (band != nullptr) {
+            const Natural lookaheadByteCount =
+                band->lookaheadByteCount();
+            result.ringBufferByteCount += lookaheadByteCount;
+            descriptorByteCount += band->byteCount() - lookaheadByteCount;
+        }
     }
 
-    /*============================================================*/
+    return result;
+}
 
-    static String _mCompanderBandListToString (IN _MCompanderBandList& list)
-    {
-        const Natural bandCount = list.size();
-        String st;
+/*--------------------*/
 
-        for (Natural bandIndex = 0;  bandIndex < bandCount;  bandIndex++) {
-            st += (bandIndex == 0 ? "" : ", ");
-            st += STR::expand("band_%1 = %2",
-                              TOSTRING(bandIndex),
-                              list[bandIndex].toString());
-        }
+void SoXMultibandCompander::setEffectiveSize (IN Natural bandCount)
+{
+    Logging_trace1(">>: bandCount = %1", TOSTRING(bandCount));
 
-        st = STR::expand("_MCompanderBandList(%1)", st);
-        return st;
+    const Natural newBandCount =
+        Natural::maximum(1, Natural::minimum(_maximumBandCount, bandCount));
 
+    if (newBandCount > Natural{_reservedBandCount.load()}) {
+        /* fallback without prior reservation: this allocates */
+        reserve(newBandCount);
     }
 
-}
+    /* the bands becoming effective and the last band before and
+       after the change (whose crossover is adapted) start with
+       cleared crossover histories */
+    _LRCrossoverBank* crossoverBank = (_LRCrossoverBank*) _crossoverBank;
+    _FIRCrossoverBank* firCrossoverBank =
+        (_FIRCrossoverBank*) _firCrossoverBank;
+    const Natural firstBandIndex =
+        (newBandCount == _bandCount ? newBandCount
+         : Natural::maximum(1, Natural::minimum(_bandCount,
+                                                newBandCount)) - 1);
+
+    for (Natural bandIndex = firstBandIndex;  bandIndex < newBandCount;
+         bandIndex++) {
+        if (_crossoverIsLinearPhase) {
+            firCrossoverBank->clearLane(bandIndex);
+        } else {
+            crossoverBank->clearLane(bandIndex);
+        }
+    }
 
-/*============================================================*/
+    _bandCount = newBandCount;
 
-SoXMultibandCompander::SoXMultibandCompander ()
-    : _allocatedBandCount{0},
-      _bandCount{0},
-      _channelCount{0},
-      _sampleRingBufferVector{}
-{
-    Logging_trace(">>");
-    _companderBandList = new _MCompanderBandList(_allocatedBandCount);
-    Logging_trace1("<<: %1", toString());
+    /* the last band is never decimated */
+    _updateDecimationFactors();
+
+    Logging_trace1("<<: new band count = %1", TOSTRING(_bandCount));
 }
 
 /*--------------------*/
 
-SoXMultibandCompander::~SoXMultibandCompander () {
+void SoXMultibandCompander::_setFIRCrossoverLanes ()
+{
     Logging_trace(">>");
-    _MCompanderBandList* list = (_MCompanderBandList*) _companderBandList;
-    delete list;
+
+    _MCompanderBandList* companderBandList =
+        (_MCompanderBandList*) _companderBandList;
+    _FIRCrossoverBank* firCrossoverBank =
+        (_FIRCrossoverBank*) _firCrossoverBank;
+    const Natural reservedBandCount{_reservedBandCount.load()};
+
+    for (Natural bandIndex = 0;  bandIndex < reservedBandCount;
+         bandIndex++) {
+        const _MCompanderBand& companderBand =
+            *companderBandList->at(bandIndex);
+        firCrossoverBank->setTopFrequency(bandIndex,
+                                          companderBand.topFrequency(),
+                                          _sampleRate);
+    }
+
+    firCrossoverBank->updateFilters();
+
     Logging_trace("<<");
 }
 
 /*--------------------*/
 
-String SoXMultibandCompander::toString () const {
-    const _MCompanderBandList* companderBandList =
+void SoXMultibandCompander::_updateDecimationFactors ()
+{
+    Logging_trace(">>");
+
+    _MCompanderBandList* companderBandList =
         (_MCompanderBandList*) _companderBandList;
-    String st =
-        STR::expand("SoXMultibandCompander("
-                    "_allocatedBandCount = %1, _effectiveBandCount = %2,"
-                    " _channelCount = %3, _companderBandList = %4)",
-                    TOSTRING(_allocatedBandCount), TOSTRING(_bandCount),
-                    TOSTRING(_channelCount),
-                    _mCompanderBandListToString(*companderBandList));
+    const Natural reservedBandCount{_reservedBandCount.load()};
+
+    /* the bands are aligned to the largest delay of any possible
+       factor, hence the latency does not change with the top
+       frequencies */
+    _bandAlignmentLatency = 0;
+
+    if (_bandsAreMultirate) {
+        for (Natural factor = 2;
+             factor <= HalfBandOversampler::maximumFactor;  factor *= 2) {
+            _bandAlignmentLatency =
+                Natural::maximum(_bandAlignmentLatency,
+                                 _multirateLatency(factor,
+                                                   _lookaheadSampleCount));
+        }
+    }
 
-    return st;
+    for (Natural bandIndex = 0;  bandIndex < reservedBandCount;
+         bandIndex++) {
+        _MCompanderBand& companderBand = *companderBandList->at(bandIndex);
+        const Boolean isDecimated =
+            (_bandsAreMultirate && bandIndex + 1 < _bandCount);
+        const Natural factor =
+            (!isDecimated ? 1
+             : _decimationFactor(companderBand.topFrequency(),
+                                 _sampleRate));
+        companderBand.setDecimationFactor(factor);
+        companderBand.setLatencyCompensation(
+            _bandAlignmentLatency - companderBand.multirateLatency());
+    }
+
+    Logging_trace1("<<: bandAlignmentLatency = %1",
+                   TOSTRING(_bandAlignmentLatency));
 }
 
 /*--------------------*/
 
-void
-SoXMultibandCompander::setCompanderBandData (IN Natural bandIndex,
-                                             IN Real sampleRate,
-                                             IN Real attack,
-                                             IN Real release,
-                                             IN Real dBKnee,
-                                             IN Real dBThreshold,
-                                             IN Real ratio,
-                                             IN Real dBGain,
-                                             IN Real topFrequency)
+void SoXMultibandCompander::_applyBand (INOUT void* context,
+                                        IN Natural bandIndex)
 {
-    Logging_trace9(">>: bandIndex = %1, sampleRate = %2, attack = %3,"
-                   " release = %4, dBKnee = %5, dBThreshold = %6,"
-                   " ratio = %7, dBGain = %8, topFrequency = %9",
-                   TOSTRING(bandIndex), TOSTRING(sampleRate),
-                   TOSTRING(attack), TOSTRING(release),
-                   TOSTRING(dBKnee), TOSTRING(dBThreshold),
-                   TOSTRING(ratio), TOSTRING(dBGain),
-                   TOSTRING(topFrequency));
-
+    SoXMultibandCompander* compander = (SoXMultibandCompander*) context;
     _MCompanderBandList* companderBandList =
-        (_MCompanderBandList*) _companderBandList;
-    _MCompanderBand& companderBand =
-        companderBandList->at(bandIndex);
-    companderBand.adapt(sampleRate,
-                        attack, release, dBKnee, dBThreshold,
-                        ratio, dBGain, topFrequency);
-
-    Logging_trace1("<<: %1", toString());
+        (_MCompanderBandList*) compander->_companderBandList;
+    _MCompanderBand* companderBand = companderBandList->at(bandIndex);
+    Logging_span("SoXMultibandCompander.band", companderBand);
+    companderBand->apply(compander->_activeChannelCount,
+                         compander->_blockSampleCount,
+                         compander->_keyArray);
 }
 
 /*--------------------*/
 
-void SoXMultibandCompander::resize (IN Natural bandCount,
-                                    IN Natural channelCount) {
-    Logging_trace2(">>: bandCount = %1, channelCount = %2",
-                   TOSTRING(bandCount), TOSTRING(channelCount));
+void SoXMultibandCompander::apply (INOUT AudioSampleListVector& buffer,
+                                   IN SoXSidechainView& sidechain)
+{
+    const Natural sampleCount = buffer.frameCount();
+    Logging_trace1(">>: sampleCount = %1", TOSTRING(sampleCount));
 
-    _allocatedBandCount = bandCount;
-    _bandCount          = Natural::minimum(bandCount, _bandCount);
-    _channelCount       = channelCount;
+    const Boolean hasSidechain =
+        (!sidechain.isEmpty() && sidechain.frameCount() >= sampleCount);
 
-    /* setup all compander bands */
     _MCompanderBandList* companderBandList =
         (_MCompanderBandList*) _companderBandList;
-    companderBandList->setLength(_allocatedBandCount);
+    _LRCrossoverBank* crossoverBank = (_LRCrossoverBank*) _crossoverBank;
+    _FIRCrossoverBank* firCrossoverBank =
+        (_FIRCrossoverBank*) _firCrossoverBank;
+
+    /* a block with less channels (like the first channel of a mono
+       signal) leaves the state of the other channels untouched */
+    const Natural channelCount =
+        Natural::minimum(buffer.size(), _channelCount);
+    _activeChannelCount = channelCount;
+
+    for (Natural position = 0;  position < sampleCount;
+         position += _blockLength) {
+        const Natural count =
+            Natural::minimum(_blockLength, sampleCount - position);
+
+        /* setup signal buffer for processing */
+        for (Natural channel = 0;  channel < channelCount;  channel++) {
+            const AudioSample* inputArray =
+                buffer[channel].asArray(position);
+            AudioSample* signalArray = _signalBuffer[channel].asArray();
 
-    for (_MCompanderBand& companderBand : *companderBandList) {
-        companderBand.setChannelCount(channelCount);
-    }
+            for (Natural i = 0;  i < count;  i++) {
+                signalArray[(size_t) i] = inputArray[(size_t) i];
+            }
+        }
+
+        /* split the signal by the crossover filters of all bands
+           into the band buffers */
+        Logging_beginSpan("SoXMultibandCompander.crossover", this);
+
+        for (Natural channel = 0;  channel < channelCount;  channel++) {
+            const AudioSample* signalArray =
+                _signalBuffer[channel].asArray();
+
+            if (_crossoverIsLinearPhase) {
+                firCrossoverBank->apply(channel, signalArray, count,
+                                        *companderBandList, _bandCount);
+            } else {
+                crossoverBank->apply(channel, signalArray, count,
+                                     *companderBandList, _bandCount);
+            }
+        }
+
+        Logging_endSpan("SoXMultibandCompander.crossover", this);
 
-    const Natural bufferCountPerChannel = _allocatedBandCount * 2 + 1;
-    _sampleRingBufferVector.resize(_channelCount, bufferCountPerChannel);
+        /* a sidechain gives a single wideband key for all bands */
+        if (!hasSidechain) {
+            _keyArray = nullptr;
+        } else {
+            AudioSample* keyArray = _keyList.asArray();
+            sidechain.maximumAbsoluteSample(position, count, keyArray);
+            _keyArray = keyArray;
+        }
 
-    for (Natural channel = 0;  channel < channelCount;  channel++) {
-        /* connect the compander buffers to the sample buffer
-           matrix */
-        Natural i = 0;
+        /* do compression across all bands; the bands are
+           independent until the final sum */
+        _blockSampleCount = count;
+        SoXWorkerPool::instance().run(_applyBand, this, _bandCount, count);
+
+        /* sum up the bands into the output */
+        for (Natural channel = 0;  channel < channelCount;  channel++) {
+            AudioSample* outputArray = buffer[channel].asArray(position);
 
-        for (_MCompanderBand& companderBand : *companderBandList) {
-            companderBand.setBuffer(channel,
-                                    _kindInputStream,
-                                    &_sampleRingBufferVector.at(channel, i));
-            companderBand.setBuffer(channel,
-                                    _kindLowOutputStream,
-                                    &_sampleRingBufferVector.at(channel,
-                                                                i + 1));
-            companderBand.setBuffer(channel,
-                                    _kindHighOutputStream,
-                                    &_sampleRingBufferVector.at(channel,
-                                                                i + 2));
-            /* take care of single overlapping buffer between the
-               bands */
-            i += 2;
+            for (Natural i = 0;  i < count;  i++) {
+                outputArray[(size_t) i] = 0.0;
+            }
         }
 
-        for (Natural j = 0;  j < bufferCountPerChannel;  j++) {
-            AudioSampleRingBuffer& sampleBuffer =
-                _sampleRingBufferVector.at(channel, j);
-            sampleBuffer.setLength(_LRFilter::order);
+        for (Natural bandIndex = 0;  bandIndex < _bandCount;  bandIndex++) {
+            const _MCompanderBand& companderBand =
+                *companderBandList->at(bandIndex);
+            companderBand.addTo(buffer, channelCount, position, count);
         }
     }
 
@@ -1786,63 +6019,53 @@ void SoXMultibandCompander::resize (IN Natural bandCount,
 
 /*--------------------*/
 
-void SoXMultibandCompander::setEffectiveSize (IN Natural bandCount)
-{
-    Logging_trace1(">>: bandCount = %1", TOSTRING(bandCount));
-    _bandCount =
-        Natural::maximum(1, Natural::minimum(_allocatedBandCount, bandCount));
-    Logging_trace1("<<: new band count = %1", TOSTRING(_bandCount));
-}
-
-/*--------------------*/
-
-void
-SoXMultibandCompander::apply (IN AudioSampleList& inputSampleList,
-                              OUT AudioSampleList& outputSampleList)
+void SoXMultibandCompander::copyFirstChannelState ()
 {
     Logging_trace(">>");
 
-    outputSampleList.setToZero();
-    const Natural bufferCountPerChannel = _bandCount * 2 + 1;
+    _MCompanderBandList* companderBandList =
+        (_MCompanderBandList*) _companderBandList;
+    _LRCrossoverBank* crossoverBank = (_LRCrossoverBank*) _crossoverBank;
+    _FIRCrossoverBank* firCrossoverBank =
+        (_FIRCrossoverBank*) _firCrossoverBank;
 
-    for (Natural channel = 0;  channel < _channelCount;  channel++) {
-        for (Natural j = 0;  j < bufferCountPerChannel;  j++) {
-            AudioSampleRingBuffer& sampleBuffer =
-                _sampleRingBufferVector.at(channel, j);
-            sampleBuffer.shiftRight(0.0);
+    for (_MCompanderBand* companderBand : *companderBandList) {
+        if (companderBand != nullptr) {
+            companderBand->copyFirstChannelState();
         }
+    }
+
+    crossoverBank->copyFirstChannelState();
 
-        /* setup sample buffer for processing */
-        AudioSampleRingBuffer& inputBuffer =
-            _sampleRingBufferVector.at(channel, 0);
-        AudioSample inputSample = inputSampleList[channel];
-        inputBuffer.setFirst(inputSample);
+    if (firCrossoverBank->isAllocated()) {
+        firCrossoverBank->copyFirstChannelState();
     }
 
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXMultibandCompander::clear ()
+{
+    Logging_trace(">>");
+
     _MCompanderBandList* companderBandList =
         (_MCompanderBandList*) _companderBandList;
+    _LRCrossoverBank* crossoverBank = (_LRCrossoverBank*) _crossoverBank;
+    _FIRCrossoverBank* firCrossoverBank =
+        (_FIRCrossoverBank*) _firCrossoverBank;
 
-    /* calculate crossover filtering from input buffers into
-       low and high outputs */
-    for (Natural bandIndex = 0;  bandIndex < _bandCount;  bandIndex++) {
-        _MCompanderBand& companderBand =
-            companderBandList->at(bandIndex);
-        companderBand.calculateCrossover();
+    for (_MCompanderBand* companderBand : *companderBandList) {
+        if (companderBand != nullptr) {
+            companderBand->clear();
+        }
     }
 
-    /* do compression across all bands */
-    for (Natural bandIndex = 0;  bandIndex < _bandCount;  bandIndex++) {
-        _MCompanderBand& companderBand =
-            companderBandList->at(bandIndex);
-        companderBand.apply(outputSampleList);
-    }
+    crossoverBank->clear();
 
-    /* write all output channel samples to buffer */
-    for (Natural channel = 0;  channel < _channelCount;  channel++) {
-        const AudioSample outputSample = outputSampleList[channel];
-        AudioSampleRingBuffer& outputBuffer =
-            _sampleRingBufferVector.at(channel, bufferCountPerChannel - 1);
-        outputBuffer.setFirst(outputSample);
+    if (firCrossoverBank->isAllocated()) {
+        firCrossoverBank->clear();
     }
 
     Logging_trace("<<");
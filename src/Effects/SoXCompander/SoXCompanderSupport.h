@@ -16,17 +16,23 @@
 /* IMPORTS */
 /*=========*/
 
-#include "GenericMatrix.h"
+#include <atomic>
 #include "Object.h"
 #include "Real.h"
-#include "AudioSampleRingBuffer.h"
+#include "RealList.h"
+#include "AudioSampleListVector.h"
+#include "SoXMemoryFootprint.h"
+#include "SoXSidechainView.h"
 
 /*--------------------*/
 
-using Audio::AudioSampleRingBuffer;
+using Audio::AudioSampleList;
+using Audio::AudioSampleListVector;
+using BaseTypes::Containers::RealList;
 using BaseTypes::Primitives::Object;
 using BaseTypes::Primitives::Real;
-using BaseTypes::GenericTypes::GenericMatrix;
+using SoXPlugins::Helpers::SoXMemoryFootprint;
+using SoXPlugins::Helpers::SoXSidechainView;
 
 /*====================*/
 
@@ -39,6 +45,14 @@ namespace SoXPlugins::Effects::SoXCompander {
      */
     struct SoXMultibandCompander {
 
+        /** the maximum number of frames per detector window */
+        static const Natural maximumDetectorDecimation;
+
+        /** the maximum number of frames per gain computation */
+        static const Natural maximumGainInterval;
+
+        /*--------------------*/
+
         /**
          * Sets up a multiband compander.
          */
@@ -60,20 +74,57 @@ namespace SoXPlugins::Effects::SoXCompander {
         /*--------------------*/
 
         /**
-         * Resizes multiband compander to <C>bandCount</C> bands and
-         * <C>channelCount</C> channels.
+         * Resizes multiband compander to at most
+         * <C>maximumBandCount</C> bands and <C>channelCount</C>
+         * channels; only the bands reserved so far get new buffers,
+         * all filter histories and delay lines are cleared.
          *
-         * @param[in] bandCount     the new band count for this effect
-         * @param[in] channelCount  the new channel count for this effect
+         * @param[in] maximumBandCount  the maximum band count for
+         *                              this effect
+         * @param[in] channelCount      the new channel count for
+         *                              this effect
          */
-        void resize (IN Natural bandCount,
+        void resize (IN Natural maximumBandCount,
                      IN Natural channelCount);
 
         /*--------------------*/
 
+        /**
+         * Makes sure that the state (buffers, delay lines and
+         * transfer function tables) of the first <C>bandCount</C>
+         * bands is allocated.  The state of a band is allocated on
+         * its first reservation and then kept, such that the
+         * compander only occupies memory for the largest band count
+         * used so far.  This call allocates, but it does not touch
+         * bands already reserved, hence it may be done outside of
+         * the audio thread while that one processes the effective
+         * bands.
+         *
+         * @param[in] bandCount  the number of bands to be reserved
+         */
+        void reserve (IN Natural bandCount);
+
+        /*--------------------*/
+
+        /**
+         * Frees the state of all bands together with the crossover
+         * and signal buffers, such that an idle compander only keeps
+         * its settings; a later <C>resize</C> and <C>reserve</C>
+         * allocate the state again.  The linear phase crossover and
+         * the multirate bands are switched off and have to be set
+         * again after the reallocation.
+         */
+        void release ();
+
+        /*--------------------*/
+
         /**
          * Sets effective number of bands in multiband compander to
-         * <C>bandCount</C>.
+         * <C>bandCount</C>; the bands becoming effective and the
+         * last band before and after the change start with cleared
+         * crossover filter histories.  When the bands have
+         * been reserved before, this does not allocate, otherwise
+         * they are reserved here.
          *
          * @param[in] bandCount  the new band count for this effect
          */
@@ -114,27 +165,375 @@ namespace SoXPlugins::Effects::SoXCompander {
         /*--------------------*/
 
         /**
-         * Processes samples from <C>inputSampleList</C> by multiband
-         * compander and returns output in <C>outputSampleList</C>;
-         * updates internal buffers for low and high output of each
-         * band and sums up to output.
+         * Sets up lookup tables for the transfer functions of all
+         * bands with <C>entriesPerOctave</C> entries per octave of
+         * the envelope volume, such that the gain per sample is
+         * found by an index and a linear interpolation; zero
+         * disables the tables (the default) and evaluates the knee
+         * curve segments exactly.  If <C>isValidated</C> is set,
+         * each rebuild of a table compares it against the exact
+         * evaluation (see <C>transferFunctionTableDeviation</C>).
+         * The tables are rebuilt on each band data change; this
+         * call allocates, so it must not be done on the audio
+         * thread.
+         *
+         * @param[in] entriesPerOctave  the table resolution (at most
+         *                              1024)
+         * @param[in] isValidated       tells whether tables are
+         *                              checked against exact
+         *                              evaluation
+         */
+        void setTransferFunctionTable (IN Natural entriesPerOctave,
+                                       IN Boolean isValidated = false);
+
+        /*--------------------*/
+
+        /**
+         * Returns the maximum deviation in decibels of the transfer
+         * function tables of the effective bands from the exact
+         * evaluation as found by the last validation (zero without
+         * validation).
+         *
+         * @return  maximum table deviation in decibels
+         */
+        Real transferFunctionTableDeviation () const;
+
+        /*--------------------*/
+
+        /**
+         * Tells whether the transfer functions of all bands use the
+         * fast logarithm and exponential approximations from
+         * <C>FastMath</C> instead of the exact functions for the
+         * conversion of the envelope volume into decibels and of
+         * the gain back into a linear factor (default: exact
+         * functions); the gain deviates by at most
+         * <C>FastMath::dBErrorBound</C> decibels.
+         *
+         * @param[in] isEnabled  tells whether fast math is used
+         */
+        void setFastMath (IN Boolean isEnabled);
+
+        /*--------------------*/
+
+        /**
+         * Sets the decimation of the detectors of all bands to
+         * <C>factor</C> (clipped to 1 ..
+         * <C>maximumDetectorDecimation</C>; default: 1 for
+         * detectors at full sample rate).  A decimated detector
+         * reduces the detector values to their maximum over windows
+         * of <C>factor</C> frames, steps the envelope once per
+         * window and evaluates the transfer function only for the
+         * window ends; the gains in between are linearly
+         * interpolated, hence the cost of envelope and gain
+         * computation drops by about <C>factor</C>.
+         *
+         * The accuracy is bounded as follows: because the window
+         * maximum is followed as if held for the whole window, the
+         * envelope at each window end is never below the envelope
+         * of the full-rate detector and exceeds it by at most the
+         * attack step of one window; the gain reduction within a
+         * window sets in at most <C>factor - 1</C> samples late,
+         * which a lookahead of at least <C>factor</C> samples
+         * compensates.  This call does not allocate.
+         *
+         * @param[in] factor  the number of frames per detector
+         *                    window
+         */
+        void setDetectorDecimation (IN Natural factor);
+
+        /*--------------------*/
+
+        /**
+         * Returns the decimation factor of the detectors.
+         *
+         * @return  number of frames per detector window
+         */
+        Natural detectorDecimation () const;
+
+        /*--------------------*/
+
+        /**
+         * Sets the control rate of the gains of all bands to one
+         * gain computation per <C>sampleCount</C> frames (clipped to
+         * <C>maximumGainInterval</C>; default: 1 for a gain per
+         * frame); zero derives the interval of each band from its
+         * attack time (an eighth of the attack time constant, at
+         * most 32 frames).  In contrast to a decimated detector,
+         * detector and envelope still run at full sample rate, so
+         * no peak is missed; only the transfer function is evaluated
+         * for the last frame of each interval and the gain is ramped
+         * linearly in between by a vectorized multiply.  A
+         * decimated detector takes precedence.  This call does not
+         * allocate.
+         *
+         * @param[in] sampleCount  the number of frames per gain
+         *                         computation
+         */
+        void setGainInterval (IN Natural sampleCount);
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of frames per gain computation (zero
+         * for automatic).
+         *
+         * @return  number of frames per gain computation
+         */
+        Natural gainInterval () const;
+
+        /*--------------------*/
+
+        /**
+         * Sets the lookahead of all bands to <C>sampleCount</C>
+         * samples: the signal path of each band is delayed by a
+         * delay line of that length, while its envelope follows the
+         * undelayed band signal, such that the gain reduction
+         * already sets in before a transient arrives in the output.
+         * The output is delayed by the lookahead (the latency of
+         * the compander); all delay lines are cleared.  The delay
+         * lines only allocate when <C>sampleCount</C> exceeds all
+         * lookaheads set before.
+         *
+         * @param[in] sampleCount  the lookahead in samples
+         */
+        void setLookahead (IN Natural sampleCount);
+
+        /*--------------------*/
+
+        /**
+         * Returns the lookahead of the compander.
+         *
+         * @return  lookahead in samples
+         */
+        Natural lookahead () const;
+
+        /*--------------------*/
+
+        /**
+         * Makes sure that the state of the linear phase crossover
+         * (filter spectra, delay lines and blocks for all possible
+         * bands and channels) is allocated; this allocates on the
+         * first call only, so it may be done outside of the audio
+         * thread before linear phase is enabled there.
+         */
+        void reserveLinearPhaseCrossover ();
+
+        /*--------------------*/
+
+        /**
+         * Tells whether the bands are split by linear phase FIR
+         * filters instead of the Linkwitz-Riley filters (the
+         * default).  The FIR filters are windowed-sinc band passes
+         * evaluated by a partitioned FFT convolution: the bands sum
+         * up to the delayed input without phase distortion, but
+         * the crossover adds a fixed latency (see
+         * <C>latency</C>).  The crossover of the new kind starts
+         * from silence; when it has not been reserved before, this
+         * call allocates.
+         *
+         * @param[in] isEnabled  tells whether the linear phase
+         *                       crossover is used
+         */
+        void setLinearPhaseCrossover (IN Boolean isEnabled);
+
+        /*--------------------*/
+
+        /**
+         * Tells whether the bands are split by the linear phase
+         * crossover.
+         *
+         * @return  information whether crossover is linear phase
+         */
+        Boolean crossoverIsLinearPhase () const;
+
+        /*--------------------*/
+
+        /**
+         * Makes sure that the state for companding bands at a
+         * reduced rate (resamplers, group buffers and compensation
+         * delay lines of all reserved and later reserved bands) is
+         * allocated; this allocates on the first call only, so it
+         * may be done outside of the audio thread before multirate
+         * bands are enabled there.
+         */
+        void reserveMultirateBands ();
+
+        /*--------------------*/
+
+        /**
+         * Tells whether bands with a low top frequency are companded
+         * at a reduced rate: the band signal is decimated by a power
+         * of two (up to eight) after the crossover, such that the
+         * band still ends two octaves below the reduced Nyquist
+         * frequency, companded there and interpolated back by
+         * polyphase half-band filters.  The last band is always
+         * processed at full rate.  All bands are delayed to the
+         * largest delay of any decimation, hence they stay aligned
+         * and the latency (see <C>latency</C>) does not depend on
+         * the top frequencies.  The bands changing their rate start
+         * from silence; when the state has not been reserved
+         * before, this call allocates.
+         *
+         * @param[in] isEnabled  tells whether low bands are
+         *                       decimated
+         */
+        void setMultirateBands (IN Boolean isEnabled);
+
+        /*--------------------*/
+
+        /**
+         * Tells whether bands with a low top frequency are companded
+         * at a reduced rate.
+         *
+         * @return  information whether low bands are decimated
+         */
+        Boolean bandsAreMultirate () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the delay of the compander output against its
+         * input: the lookahead plus the latency of a linear phase
+         * crossover and the alignment of multirate bands (if used).
+         *
+         * @return  latency in samples
+         */
+        Natural latency () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns in <C>coefficientList</C> the coefficients of the
+         * Linkwitz-Riley filter sections whose cascade gives the
+         * signal of the band with <C>bandIndex</C>: the highpasses
+         * of all lower crossovers and the lowpass of the band
+         * itself, each of order 5 (first the b's, then the a's);
+         * this describes the Linkwitz-Riley crossover only, not the
+         * linear phase one.  Must not be called on the audio
+         * thread.
          *
-         * @param[in]  inputSampleList   the queue of samples for all
-         *                               input channels
-         * @param[out] outputSampleList  the queue of samples for all
-         *                               output channels
+         * @param[in]  bandIndex        the index of the band
+         * @param[out] coefficientList  the coefficients of all
+         *                              filter sections of the band
+         */
+        void bandCrossoverCoefficients (IN Natural bandIndex,
+                                        OUT RealList& coefficientList)
+            const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the maximum gain reduction in decibels (relative
+         * to the band gain) of the band with <C>bandIndex</C> since
+         * the last call and restarts its measurement; zero when the
+         * band has not processed a block since.  Must only be
+         * called on the audio thread.
+         *
+         * @param[in] bandIndex  the index of an effective band
+         * @return  gain reduction of band in decibels
+         */
+        Real takeGainReduction (IN Natural bandIndex);
+
+        /*--------------------*/
+
+        /**
+         * Returns the bytes allocated on the heap by the multiband
+         * compander where the lookahead buffers count as ring
+         * buffers and all other bands, crossovers and buffers as
+         * descriptor.  Must not be called on the audio thread.
+         *
+         * @return  memory footprint of compander
+         */
+        SoXMemoryFootprint memoryFootprint () const;
+
+        /*--------------------*/
+
+        /**
+         * Processes all samples in <C>buffer</C> in place by
+         * multiband compander; the samples are handled in blocks
+         * where each block is first split into the bands by the
+         * crossover filters, then companded per band (spread
+         * across the process-wide worker pool, when configured) and
+         * finally summed up to the output.
+         *
+         * When <C>sidechain</C> is not empty, the envelopes of all
+         * bands follow the maximum absolute sample of the sidechain
+         * channels (a wideband key) instead of the band signals,
+         * while the gain is still applied to the bands of
+         * <C>buffer</C>; the sidechain is read in place.
+         *
+         * @param[inout] buffer     the samples for all channels
+         * @param[in]    sidechain  the sidechain with the frame
+         *                          count of buffer (or empty)
+         */
+        void apply (INOUT AudioSampleListVector& buffer,
+                    IN SoXSidechainView& sidechain);
+
+        /*--------------------*/
+
+        /**
+         * Copies the state of the first channel (envelopes,
+         * lookahead delay lines and crossover histories) to all
+         * other channels; used when a block with only the first
+         * channel of identical channels has been processed by
+         * <C>apply</C> before.  Does not allocate.
          */
-        void apply (IN AudioSampleList& inputSampleList,
-                    OUT AudioSampleList& outputSampleList);
+        void copyFirstChannelState ();
+
+        /*--------------------*/
+
+        /**
+         * Resets the state of all channels (envelopes, lookahead
+         * delay lines, crossover histories and the state for the
+         * reduced rate) as after a <C>resize</C>.  Does not
+         * allocate.
+         */
+        void clear ();
 
         /*--------------------*/
         /*--------------------*/
 
         private:
 
-            /** the allocated number of bands in this multiband
+            /**
+             * Sets the lanes of the linear phase crossover to the
+             * top frequencies of all reserved bands and updates its
+             * filters.
+             */
+            void _setFIRCrossoverLanes ();
+
+            /*--------------------*/
+
+            /**
+             * Sets the decimation factors of all reserved bands
+             * from their top frequencies and the alignment delays
+             * from the lookahead.
+             */
+            void _updateDecimationFactors ();
+
+            /*--------------------*/
+
+            /**
+             * Applies the compander of band <C>bandIndex</C> of
+             * multiband compander <C>context</C> to the current
+             * block; used as task function for the worker pool.
+             *
+             * @param[inout] context    the multiband compander
+             * @param[in]    bandIndex  the index of the band
+             */
+            static void _applyBand (INOUT void* context,
+                                    IN Natural bandIndex);
+
+            /*--------------------*/
+
+            /** the maximum number of bands in this multiband
              * compander */
-            Natural _allocatedBandCount;
+            Natural _maximumBandCount;
+
+            /** the number of bands with allocated state in this
+             * multiband compander (set by the thread reserving the
+             * bands, read by the audio thread) */
+            std::atomic<size_t> _reservedBandCount;
 
             /** the effective number of bands in this multiband
              * compander */
@@ -143,19 +542,87 @@ namespace SoXPlugins::Effects::SoXCompander {
             /** the number of channels in this multiband compander */
             Natural _channelCount;
 
-            /** the list of compander bands in this multiband
-             * compander */
+            /** the number of channels in the block currently
+             * processed (at most the channel count) */
+            Natural _activeChannelCount;
+
+            /** the pool of compander bands in this multiband
+             * compander with a slot per possible band */
             Object _companderBandList;
 
-            /**
-             * the vector of sample ring buffers shared between the
-             * bands
-             *
-             * each channel contains (2 * bandCount + 1) sample ring
-             * buffers where each band covers a window of three
-             * entries overlapping in one entry
-             */
-            GenericMatrix<AudioSampleRingBuffer> _sampleRingBufferVector;
+            /** the bank evaluating the crossover filters of all
+             * bands together (private type) */
+            Object _crossoverBank;
+
+            /** the bank evaluating the linear phase crossover
+             * filters of all bands (private type, only allocated on
+             * reservation) */
+            Object _firCrossoverBank;
+
+            /** the signal buffer for a block per channel as input of
+             * the first band */
+            AudioSampleListVector _signalBuffer;
+
+            /** the number of samples per channel in the block
+             * currently processed */
+            Natural _blockSampleCount;
+
+            /** the detector values of the sidechain for a block */
+            AudioSampleList _keyList;
+
+            /** the detector values of the sidechain for the block
+             * currently processed (nullptr without sidechain) */
+            const AudioSample* _keyArray;
+
+            /** the number of samples per channel processed as a
+             * block (tuned per machine) */
+            Natural _blockLength;
+
+            /** the lookahead of all bands in samples */
+            Natural _lookaheadSampleCount;
+
+            /** the maximum lookahead set so far in samples (the
+             * delay line capacity of each reserved band) */
+            Natural _maximumLookaheadSampleCount;
+
+            /** the number of transfer function table entries per
+             * octave (zero for exact evaluation) */
+            Natural _tableEntriesPerOctave;
+
+            /** tells whether the transfer function tables are
+             * validated against the exact evaluation */
+            Boolean _tableIsValidated;
+
+            /** tells whether the transfer functions use fast
+             * approximations of logarithm and exponential */
+            Boolean _usesFastMath;
+
+            /** the number of frames per detector window of all
+             * bands */
+            Natural _detectorDecimationFactor;
+
+            /** the number of frames per gain computation of all bands
+             * (zero for automatic) */
+            Natural _gainInterval;
+
+            /** tells whether the bands are split by the linear
+             * phase crossover */
+            Boolean _crossoverIsLinearPhase;
+
+            /** tells whether the state for multirate bands has been
+             * reserved */
+            Boolean _multirateIsReserved;
+
+            /** tells whether low bands are companded at a reduced
+             * rate */
+            Boolean _bandsAreMultirate;
+
+            /** the delay in samples aligning all bands to the
+             * slowest possible multirate band */
+            Natural _bandAlignmentLatency;
+
+            /** the sample rate of the last band data change */
+            Real _sampleRate;
 
     };
 
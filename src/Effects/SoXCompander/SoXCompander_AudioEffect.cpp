@@ -15,6 +15,7 @@
 #include "RealList.h"
 #include "SoXAudioHelper.h"
 #include "SoXEffectParameterMap.h"
+#include "SoXFrequencyResponseCache.h"
 #include "SoXCompander_AudioEffect.h"
 #include "SoXCompanderSupport.h"
 
@@ -22,7 +23,10 @@
 
 using BaseTypes::Containers::RealList;
 using BaseTypes::GenericTypes::GenericTuple;
+using SoXPlugins::Helpers::SoXAudioHelper;
 using SoXPlugins::Helpers::SoXEffectParameterMap;
+using SoXPlugins::Helpers::SoXFrequencyResponseCache;
+using SoXPlugins::Helpers::precisionProfileToString;
 using SoXPlugins::Effects::SoXCompander::SoXCompander_AudioEffect;
 using SoXPlugins::Effects::SoXCompander::SoXMultibandCompander;
 
@@ -37,6 +41,9 @@ using STR = BaseModules::StringUtil;
 /** maximum top frequency in a compander band */
 const Real _maxTopFrequency{25000.0};
 
+/** maximum lookahead of the compander in milliseconds */
+const Real _maxLookahead{10.0};
+
 /*--------------------*/
 
 namespace SoXPlugins::Effects::SoXCompander {
@@ -98,6 +105,9 @@ namespace SoXPlugins::Effects::SoXCompander {
     using _BandIndexToCompanderDataMap =
         GenericTuple<_CompanderBandParameterData, _maxBandCount>;
 
+    /** fixed-length mapping from natural to a flag */
+    using _BandIndexToFlagMap = GenericTuple<Boolean, _maxBandCount>;
+
     /*====================*/
 
     /**
@@ -111,9 +121,25 @@ namespace SoXPlugins::Effects::SoXCompander {
         /** the number of bands in this multiband compander */
         Natural bandCount;
 
+        /** the lookahead of the compander in milliseconds */
+        Real lookahead;
+
+        /** tells whether the bands are split by the linear phase
+         * crossover instead of the Linkwitz-Riley crossover */
+        Boolean crossoverIsLinearPhase;
+
+        /** tells whether bands with a low top frequency are
+         * companded at a reduced rate */
+        Boolean bandsAreMultirate;
+
         /** the number of audio channels in this multiband compander */
         Natural channelCount;
 
+        /** tells whether the state of the compander is allocated
+         * (only between <C>prepareToPlay</C> and
+         * <C>releaseResources</C>) */
+        Boolean isAllocated;
+
         /** the multiband compander object itself */
         SoXMultibandCompander multibandCompander;
 
@@ -121,11 +147,18 @@ namespace SoXPlugins::Effects::SoXCompander {
           * (like e.g. attack) */
         _BandIndexToCompanderDataMap indexToCompanderBandParamDataMap;
 
-        /** the input sample buffer of this effect */
-        AudioSampleList inputSampleList;
+        /** a map from band index to the information whether some
+          * band parameter has changed without recalculation */
+        _BandIndexToFlagMap indexToBandIsChangedMap;
 
-        /** the output sample buffer of this effect */
-        AudioSampleList outputSampleList;
+        /** the crossover responses of the bands for a display */
+        SoXFrequencyResponseCache responseCache;
+
+        /** the quality level set by a load governor */
+        Natural qualityLevel;
+
+        /** the precision profile of the compander */
+        SoXPrecisionProfile precisionProfile;
 
         /*--------------------*/
         /*--------------------*/
@@ -138,8 +171,17 @@ namespace SoXPlugins::Effects::SoXCompander {
         String toString () const
         {
             String prefix =
-                STR::expand("bandCount = %1, channelCount = %2",
-                            TOSTRING(bandCount), TOSTRING(channelCount));
+                STR::expand("bandCount = %1, lookahead = %2ms,"
+                            " crossoverIsLinearPhase = %3,"
+                            " bandsAreMultirate = %4,"
+                            " channelCount = %5, isAllocated = %6,"
+                            " qualityLevel = %7, precisionProfile = %8",
+                            TOSTRING(bandCount), TOSTRING(lookahead),
+                            TOSTRING(crossoverIsLinearPhase),
+                            TOSTRING(bandsAreMultirate),
+                            TOSTRING(channelCount), TOSTRING(isAllocated),
+                            TOSTRING(qualityLevel),
+                            precisionProfileToString(precisionProfile));
 
             String companderBandDataString;
 
@@ -185,6 +227,25 @@ namespace SoXPlugins::Effects::SoXCompander {
     /** the parameter name of the band index (in English language) */
     static const String parameterName_bandIndex    = "Band Index";
 
+    /** the parameter name of the lookahead (in English language) */
+    static const String parameterName_lookahead    = "Lookahead [ms]";
+
+    /** the parameter name of the crossover kind (in English
+     * language) */
+    static const String parameterName_crossover    = "Crossover";
+
+    /** the list of crossover kinds */
+    static const StringList _crossoverKindList =
+        StringList::fromList({"Linkwitz-Riley", "Linear Phase"});
+
+    /** the parameter name of the band rate (in English language) */
+    static const String parameterName_bandRate     = "Band Rate";
+
+    /** the list of band rates: all bands at full rate or low bands
+     * at a reduced rate */
+    static const StringList _bandRateKindList =
+        StringList::fromList({"Full", "Reduced"});
+
     /** the parameter name of the attack (in English language) */
     static const String parameterName_attack =
         _companderBandParameterNameList[0];
@@ -213,6 +274,28 @@ namespace SoXPlugins::Effects::SoXCompander {
     static const String parameterName_topFrequency =
         _companderBandParameterNameList[6];
 
+    /*....................*/
+    /* parameter ids      */
+    /*....................*/
+
+    /** the identifications of the global parameters in the parameter
+     * map; the band parameters follow band by band in the order of
+     * <C>_companderBandParameterNameList</C> */
+    enum _ParameterId {
+        parameterId_bandCount, parameterId_lookahead,
+        parameterId_crossover, parameterId_bandRate,
+        parameterId_bandIndex, parameterId_firstBandParameter
+    };
+
+    /** the identifications of the band parameters relative to the
+     * first parameter of their band */
+    enum _BandParameterId {
+        bandParameterId_attack, bandParameterId_decay,
+        bandParameterId_dBKnee, bandParameterId_dBThreshold,
+        bandParameterId_ratio, bandParameterId_dBGain,
+        bandParameterId_topFrequency, bandParameterCount
+    };
+
     /*--------------------*/
     /* internal routines  */
     /*--------------------*/
@@ -230,11 +313,17 @@ namespace SoXPlugins::Effects::SoXCompander {
         _EffectDescriptor_CMPD* effectDescriptor =
             new _EffectDescriptor_CMPD{
                 bandCount,  /* bandCount */
+                0.0,        /* lookahead */
+                false,      /* crossoverIsLinearPhase */
+                false,      /* bandsAreMultirate */
                 0,          /* channelCount */
+                false,      /* isAllocated */
                 {},         /* multibandCompander */
                 {},         /* indexToCompanderBandParamDataMap */
-                {},         /* inputSampleList */
-                {}          /* outputSampleList */
+                {},         /* indexToBandIsChangedMap */
+                {},         /* responseCache */
+                0,          /* qualityLevel */
+                SoXPrecisionProfile::soxExact /* precisionProfile */
             };
 
         Logging_trace1("<<: %1", effectDescriptor->toString());
@@ -243,6 +332,174 @@ namespace SoXPlugins::Effects::SoXCompander {
 
     /*--------------------*/
 
+    /**
+     * Sets the approximations of the multiband compander in
+     * <C>effectDescriptor</C> from its quality level and its
+     * precision profile: the fast profile corresponds to the second
+     * quality level (control rate gains with fast math), and the
+     * quality level may reduce the quality further.  All steps
+     * interpolate the gains, and the detectors keep their last gain
+     * for a switch, hence a change is smooth.
+     *
+     * @param[inout] effectDescriptor  descriptor of effect
+     */
+    static void
+    _updateQualitySettings (INOUT _EffectDescriptor_CMPD& effectDescriptor)
+    {
+        const Natural level =
+            (effectDescriptor.precisionProfile != SoXPrecisionProfile::fast
+             ? effectDescriptor.qualityLevel
+             : Natural::maximum(effectDescriptor.qualityLevel, 2));
+        SoXMultibandCompander& multibandCompander =
+            effectDescriptor.multibandCompander;
+        multibandCompander.setGainInterval(level >= 1 ? 0 : 1);
+        multibandCompander.setFastMath(level >= 2);
+        multibandCompander.setDetectorDecimation(level >= 3 ? 4 : 1);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns a parameter map with the definitions of all compander
+     * parameters; this is done once per process and the map is used
+     * as a prototype for each effect instance.
+     *
+     * @return parameter map with all parameter definitions
+     */
+    static SoXEffectParameterMap _makeParameterMap ()
+    {
+        Logging_trace(">>");
+
+        SoXEffectParameterMap result;
+
+        result.setKindInt("-2#" + parameterName_bandCount,
+                          1, _maxBandCount, 1);
+        result.setKindReal("-2#" + parameterName_lookahead,
+                           0.0, _maxLookahead, 0.01);
+        result.setKindEnum("-2#" + parameterName_crossover,
+                           _crossoverKindList);
+        result.setKindEnum("-2#" + parameterName_bandRate,
+                           _bandRateKindList);
+        result.setKindInt("-1#" + parameterName_bandIndex,
+                          1, _maxBandCount, 1);
+
+        for (Natural bandIndex = 0;  bandIndex < _maxBandCount;  bandIndex++) {
+            const auto pagedName =
+                [bandIndex] (String st) {
+                    String result;
+                    result = SoXEffectParameterMap
+                                  ::pagedParameterName(st, bandIndex + 1);
+                    return result;
+                };
+
+            result.setKindReal(pagedName(parameterName_attack),
+                               0.001, 1.0, 0.001);
+            result.setKindReal(pagedName(parameterName_decay),
+                               0.001, 1.0, 0.001);
+            result.setKindReal(pagedName(parameterName_dBKnee),
+                               0.0, 20.0, 0.01);
+            result.setKindReal(pagedName(parameterName_dBThreshold),
+                               -128.0, 0.0, 0.1);
+            result.setKindReal(pagedName(parameterName_ratio),
+                               0.001, 1000.0, 0.001);
+            result.setKindReal(pagedName(parameterName_dBGain),
+                               -20.0, 20.0, 0.01);
+            result.setKindReal(pagedName(parameterName_topFrequency),
+                               0.1, _maxTopFrequency, 0.1);
+        }
+
+        Logging_trace("<<");
+        return result;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Recalculates the compander band with <C>bandIndex</C> in
+     * <C>effectDescriptor</C> from its parameters with a given
+     * <C>sampleRate</C> and resets its change flag.
+     *
+     * @param[inout] effectDescriptor  the compander effect descriptor
+     * @param[in] sampleRate           the sample rate for effect
+     * @param[in] bandIndex            the index of the band
+     */
+    static void
+    _updateBandSettings (INOUT _EffectDescriptor_CMPD& effectDescriptor,
+                         IN Real sampleRate,
+                         IN Natural bandIndex)
+    {
+        Logging_trace1(">>: bandIndex = %1", TOSTRING(bandIndex));
+
+        const _CompanderBandParameterData& data =
+            effectDescriptor.indexToCompanderBandParamDataMap[bandIndex];
+        const bool isUnbounded =
+            (bandIndex >= effectDescriptor.bandCount - 1);
+        const Real topFrequency =
+            (isUnbounded ? _maxTopFrequency : data.topFrequency);
+        effectDescriptor.multibandCompander
+            .setCompanderBandData(bandIndex, sampleRate,
+                                  data.attack, data.decay,
+                                  data.knee, data.threshold,
+                                  data.ratio, data.gain,
+                                  topFrequency);
+        effectDescriptor.indexToBandIsChangedMap[bandIndex] = false;
+
+        Logging_trace("<<");
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the number of samples for a lookahead of
+     * <C>lookahead</C> milliseconds at <C>sampleRate</C>.
+     *
+     * @param[in] lookahead   the lookahead in milliseconds
+     * @param[in] sampleRate  the sample rate for effect
+     * @return  lookahead in samples
+     */
+    static Natural _lookaheadSampleCount (IN Real lookahead,
+                                          IN Real sampleRate)
+    {
+        return (Natural) Real::round(lookahead * sampleRate / 1000.0);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Transfers the crossover filters of the effective bands in
+     * <C>effectDescriptor</C> at <C>sampleRate</C> into its response
+     * cache; a linear phase crossover has no response curves.
+     *
+     * @param[inout] effectDescriptor  the compander effect descriptor
+     * @param[in] sampleRate           the sample rate for effect
+     */
+    static void
+    _updateResponseCurves (INOUT _EffectDescriptor_CMPD& effectDescriptor,
+                           IN Real sampleRate)
+    {
+        Logging_trace(">>");
+
+        SoXFrequencyResponseCache& responseCache =
+            effectDescriptor.responseCache;
+        const Natural curveCount =
+            (effectDescriptor.crossoverIsLinearPhase ? 0
+             : effectDescriptor.bandCount);
+        responseCache.setCurveCount(curveCount);
+        RealList coefficientList;
+
+        for (Natural bandIndex = 0;  bandIndex < curveCount;
+             bandIndex++) {
+            effectDescriptor.multibandCompander
+                .bandCrossoverCoefficients(bandIndex, coefficientList);
+            responseCache.setCurve(bandIndex, sampleRate,
+                                   coefficientList, 5);
+        }
+
+        Logging_trace("<<");
+    }
+
+    /*--------------------*/
+
     /**
      * Recalculates derived parameters in <C>effectDescriptor</C> with a
      * given <C>sampleRate</C> and <C>channelCount</C>.
@@ -260,34 +517,71 @@ namespace SoXPlugins::Effects::SoXCompander {
                        TOSTRING(sampleRate), TOSTRING(channelCount));
 
         effectDescriptor.channelCount = channelCount;
+        effectDescriptor.isAllocated = true;
         const Natural bandCount = effectDescriptor.bandCount;
-        const Natural allocatedBandCount = _maxBandCount;
         SoXMultibandCompander& compander =
             effectDescriptor.multibandCompander;
-        compander.resize(allocatedBandCount, channelCount);
+
+        /* only the bands in use are allocated, further bands are
+           reserved when the band count grows */
+        compander.resize(_maxBandCount, channelCount);
+        compander.reserve(bandCount);
         compander.setEffectiveSize(bandCount);
 
-        for (Natural bandIndex = 0;  bandIndex < allocatedBandCount;
+        for (Natural bandIndex = 0;  bandIndex < bandCount;
              bandIndex++) {
-            Logging_trace1("--: bandIndex = %1", TOSTRING(bandIndex));
-            _CompanderBandParameterData& data =
-                effectDescriptor.indexToCompanderBandParamDataMap[bandIndex];
-            const bool isUnbounded = (bandIndex >= bandCount - 1);
-            const Real topFrequency =
-                (isUnbounded ? _maxTopFrequency : data.topFrequency);
-            compander.setCompanderBandData(bandIndex, sampleRate,
-                                           data.attack, data.decay,
-                                           data.knee, data.threshold,
-                                           data.ratio, data.gain,
-                                           topFrequency);
+            _updateBandSettings(effectDescriptor, sampleRate, bandIndex);
         }
 
-        effectDescriptor.inputSampleList.setLength(channelCount);
-        effectDescriptor.outputSampleList.setLength(channelCount);
+        compander.setLinearPhaseCrossover(
+            effectDescriptor.crossoverIsLinearPhase);
+        compander.setMultirateBands(effectDescriptor.bandsAreMultirate);
+
+        /* the delay lines are allocated for the maximum lookahead,
+           such that a later change of the lookahead does not
+           allocate */
+        compander.setLookahead(_lookaheadSampleCount(_maxLookahead,
+                                                     sampleRate));
+        compander.setLookahead(
+            _lookaheadSampleCount(effectDescriptor.lookahead, sampleRate));
 
+        _updateResponseCurves(effectDescriptor, sampleRate);
         Logging_trace1("<<: %1", effectDescriptor.toString());
     }
 
+    /*--------------------*/
+
+    /**
+     * Recalculates only those parts of <C>effectDescriptor</C>
+     * affected by parameter changes without recalculation with a
+     * given <C>sampleRate</C>: only the changed effective bands are
+     * adapted.  Without allocated state nothing is done, the changed
+     * bands are adapted by the allocation.
+     *
+     * @param[inout] effectDescriptor  the compander effect descriptor
+     * @param[in] sampleRate           the sample rate for effect
+     */
+    static void
+    _updateChangedSettings (INOUT _EffectDescriptor_CMPD& effectDescriptor,
+                            IN Real sampleRate)
+    {
+        Logging_trace(">>");
+
+        if (effectDescriptor.isAllocated) {
+            for (Natural bandIndex = 0;
+                 bandIndex < effectDescriptor.bandCount;  bandIndex++) {
+                if (effectDescriptor.indexToBandIsChangedMap[bandIndex]) {
+                    _updateBandSettings(effectDescriptor, sampleRate,
+                                        bandIndex);
+                }
+            }
+
+            _updateResponseCurves(effectDescriptor, sampleRate);
+        }
+
+        Logging_trace("<<");
+    }
+
 }
 
 /*============================================================*/
@@ -306,40 +600,16 @@ SoXCompander_AudioEffect::SoXCompander_AudioEffect ()
     _EffectDescriptor_CMPD& effectDescriptor =
         TOREFERENCE<_EffectDescriptor_CMPD>(_effectDescriptor);
 
-    /* initialize parameters */
-    _effectParameterMap.clear();
-    _effectParameterMap.setKindInt("-2#" + parameterName_bandCount,
-                                   1, _maxBandCount, 1);
-    _effectParameterMap.setKindInt("-1#" + parameterName_bandIndex,
-                                   1, _maxBandCount, 1);
-
-    for (Natural bandIndex = 0;  bandIndex < _maxBandCount;  bandIndex++) {
-        const auto pagedName =
-            [bandIndex] (String st) {
-                String result;
-                result = SoXEffectParameterMap
-                              ::pagedParameterName(st, bandIndex + 1);
-                return result;
-            };
-
-        _effectParameterMap.setKindReal(pagedName(parameterName_attack),
-                                        0.001, 1.0, 0.001);
-        _effectParameterMap.setKindReal(pagedName(parameterName_decay),
-                                        0.001, 1.0, 0.001);
-        _effectParameterMap.setKindReal(pagedName(parameterName_dBKnee),
-                                        0.0, 20.0, 0.01);
-        _effectParameterMap.setKindReal(pagedName(parameterName_dBThreshold),
-                                        -128.0, 0.0, 0.1);
-        _effectParameterMap.setKindReal(pagedName(parameterName_ratio),
-                                        0.001, 1000.0, 0.001);
-        _effectParameterMap.setKindReal(pagedName(parameterName_dBGain),
-                                        -20.0, 20.0, 0.01);
-        _effectParameterMap.setKindReal(pagedName(parameterName_topFrequency),
-                                        0.1, _maxTopFrequency, 0.1);
-    }
+    /* initialize parameters from the definitions shared by all
+       instances */
+    static const SoXEffectParameterMap parameterMapPrototype =
+        _makeParameterMap();
+    _effectParameterMap = parameterMapPrototype;
 
+    /* the construction only sets up the metadata (e.g. for a plugin
+       scan by the host), the compander state is allocated by
+       prepareToPlay */
     effectDescriptor.bandCount = 1;
-    _updateSettings(effectDescriptor, _sampleRate, 2);
 
     Logging_trace1("<<: %1", toString());
 }
@@ -385,11 +655,249 @@ String SoXCompander_AudioEffect::name() const
 }
 
 /*--------------------*/
-/* parameter change   */
+
+Real SoXCompander_AudioEffect::tailLength () const
+{
+    _EffectDescriptor_CMPD& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CMPD>(_effectDescriptor);
+    const Natural bandCount = effectDescriptor.bandCount;
+    const SoXMultibandCompander& compander =
+        effectDescriptor.multibandCompander;
+    Real result = 0.0;
+
+    if (bandCount > 1 && compander.crossoverIsLinearPhase()) {
+        /* the FIR filters end after their group delay beyond the
+           latency */
+        const Natural crossoverLatency =
+            compander.latency() - compander.lookahead();
+        result = Real{crossoverLatency} / _sampleRate;
+    } else if (bandCount > 1) {
+        /* the crossover with the lowest frequency has the slowest
+           decay; the last band is unbounded and has no crossover */
+        Real frequency = _maxTopFrequency;
+
+        for (Natural bandIndex = 0;  bandIndex < bandCount - 1;
+             bandIndex++) {
+            const Real topFrequency =
+                effectDescriptor
+                    .indexToCompanderBandParamDataMap[bandIndex].topFrequency;
+            frequency = (topFrequency < frequency ? topFrequency
+                         : frequency);
+        }
+
+        /* the Butterworth poles of the bilinear transform have
+           magnitude sqrt((1 - sqrt2 K + K^2) / (1 + sqrt2 K + K^2));
+           they occur twice in a Linkwitz-Riley filter */
+        const Real omega = Real::pi * frequency / _sampleRate;
+        const Real k = omega.sin() / omega.cos();
+        const Real sqrt2K = Real{2.0}.sqrt() * k;
+        const Real kSquared = k * k;
+        const Real poleMagnitude =
+            ((Real::one - sqrt2K + kSquared)
+             / (Real::one + sqrt2K + kSquared)).sqrt();
+        result = SoXAudioHelper::decayTime(poleMagnitude,
+                                           Real::one / _sampleRate) * 2.0;
+    }
+
+    /* the output lags the input by the lookahead and a linear
+       phase crossover */
+    result += Real{latency()} / _sampleRate;
+    return result;
+}
+
+/*--------------------*/
+
+Natural SoXCompander_AudioEffect::latency () const
+{
+    _EffectDescriptor_CMPD& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CMPD>(_effectDescriptor);
+    return effectDescriptor.multibandCompander.latency();
+}
+
+/*--------------------*/
+
+Real SoXCompander_AudioEffect::warmupLength () const
+{
+    _EffectDescriptor_CMPD& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CMPD>(_effectDescriptor);
+    const Natural bandCount = effectDescriptor.bandCount;
+    Real envelopeTime = 0.0;
+
+    /* the envelope follower approaches its target by a factor
+       exp(-1/(sampleRate * time)) per sample, hence the slowest
+       of all attack and decay times determines the settling of the
+       gain */
+    for (Natural bandIndex = 0;  bandIndex < bandCount;  bandIndex++) {
+        const _CompanderBandParameterData& data =
+            effectDescriptor.indexToCompanderBandParamDataMap[bandIndex];
+        envelopeTime = Real::maximum(envelopeTime,
+                                     Real::maximum(data.attack,
+                                                   data.decay));
+    }
+
+    Real result = tailLength();
+
+    if (envelopeTime > 0.0) {
+        const Real loopDuration = Real::one / _sampleRate;
+        const Real loopGain = (-loopDuration / envelopeTime).exp();
+        result += SoXAudioHelper::decayTime(loopGain, loopDuration);
+    }
+
+    return result;
+}
+
+/*--------------------*/
+/* sidechain          */
+/*--------------------*/
+
+Boolean SoXCompander_AudioEffect::hasSidechainInput () const
+{
+    return true;
+}
+
+/*--------------------*/
+/* frequency response */
+/*--------------------*/
+
+Natural SoXCompander_AudioEffect::responseCurveCount () const
+{
+    const _EffectDescriptor_CMPD& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CMPD>(_effectDescriptor);
+    return effectDescriptor.responseCache.curveCount();
+}
+
+/*--------------------*/
+
+Boolean
+SoXCompander_AudioEffect::frequencyResponse (IN Natural curveIndex,
+                                             IN RealList& frequencyList,
+                                             OUT RealList& magnitudeList,
+                                             OUT RealList& phaseList) const
+{
+    Logging_trace1(">>: curveIndex = %1", TOSTRING(curveIndex));
+
+    const _EffectDescriptor_CMPD& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CMPD>(_effectDescriptor);
+    const Boolean result =
+        effectDescriptor.responseCache.evaluate(curveIndex, frequencyList,
+                                                magnitudeList, phaseList);
+
+    Logging_trace1("<<: %1", TOSTRING(result));
+    return result;
+}
+
+/*--------------------*/
+/* metering           */
+/*--------------------*/
+
+Natural SoXCompander_AudioEffect::gainReductionCount () const
+{
+    const _EffectDescriptor_CMPD& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CMPD>(_effectDescriptor);
+    return effectDescriptor.bandCount;
+}
+
+/*--------------------*/
+
+Real SoXCompander_AudioEffect::takeGainReduction (IN Natural index)
+{
+    _EffectDescriptor_CMPD& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CMPD>(_effectDescriptor);
+    return (!effectDescriptor.isAllocated ? Real{0.0}
+            : effectDescriptor.multibandCompander.takeGainReduction(index));
+}
+
+/*--------------------*/
+/* quality level      */
+/*--------------------*/
+
+Natural SoXCompander_AudioEffect::qualityLevelCount () const
+{
+    return 4;
+}
+
+/*--------------------*/
+
+void SoXCompander_AudioEffect::setQualityLevel (IN Natural level)
+{
+    Logging_trace1(">>: %1", TOSTRING(level));
+
+    _EffectDescriptor_CMPD& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CMPD>(_effectDescriptor);
+    effectDescriptor.qualityLevel = level;
+    _updateQualitySettings(effectDescriptor);
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* precision profile  */
+/*--------------------*/
+
+void SoXCompander_AudioEffect::setPrecisionProfile
+                                   (IN SoXPrecisionProfile profile)
+{
+    Logging_trace1(">>: %1", precisionProfileToString(profile));
+
+    _EffectDescriptor_CMPD& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CMPD>(_effectDescriptor);
+    effectDescriptor.precisionProfile = profile;
+    _updateQualitySettings(effectDescriptor);
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* memory footprint   */
+/*--------------------*/
+
+SoXMemoryFootprint SoXCompander_AudioEffect::memoryFootprint () const
+{
+    _EffectDescriptor_CMPD& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CMPD>(_effectDescriptor);
+    SoXMemoryFootprint result = SoXAudioEffect::memoryFootprint();
+    result += effectDescriptor.multibandCompander.memoryFootprint();
+    result.descriptorByteCount +=
+        (Natural{sizeof(_EffectDescriptor_CMPD)}
+         + effectDescriptor.responseCache.byteCount());
+    return result;
+}
+
+/*--------------------*/
+/* mono processing    */
+/*--------------------*/
+
+Boolean SoXCompander_AudioEffect::hasMonoProcessing () const
+{
+    /* the channels are linked, hence identical channels give
+       identical envelopes */
+    return true;
+}
+
+/*--------------------*/
+
+void
+SoXCompander_AudioEffect::copyFirstChannelState (IN Natural channelCount)
+{
+    Logging_trace1(">>: %1", TOSTRING(channelCount));
+
+    _EffectDescriptor_CMPD& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CMPD>(_effectDescriptor);
+
+    if (channelCount > effectDescriptor.channelCount) {
+        _updateSettings(effectDescriptor, _sampleRate, channelCount);
+    }
+
+    effectDescriptor.multibandCompander.copyFirstChannelState();
+
+    Logging_trace("<<");
+}
+
 /*--------------------*/
 
 SoXParameterValueChangeKind SoXCompander_AudioEffect
-::_setValueInternal (IN String& parameterName,
+::_setValueInternal (IN Natural parameterId,
+                     IN String& parameterName,
                      IN String& value,
                      IN Boolean recalculationIsForced)
 {
@@ -402,54 +910,122 @@ SoXParameterValueChangeKind SoXCompander_AudioEffect
         SoXParameterValueChangeKind::parameterChange;
     _EffectDescriptor_CMPD& effectDescriptor =
         TOREFERENCE<_EffectDescriptor_CMPD>(_effectDescriptor);
-    const String bandCountParam = parameterName_bandCount;
-    const String bandIndexParam = parameterName_bandIndex;
 
-    if (STR::endsWith(parameterName, bandCountParam)) {
-        Logging_trace1("--: new bandCount = %1", value);
+    if ((int) parameterId == parameterId_bandCount) {
         const Natural bandCount =
-            Natural::forceToInterval(STR::toNatural(value), 1, _maxBandCount);
+            Natural::forceToInterval((Natural) _effectParameterMap
+                                     .numericValue(parameterId),
+                                     1, _maxBandCount);
+        Logging_trace1("--: new bandCount = %1", TOSTRING(bandCount));
+        const Natural oldBandCount = effectDescriptor.bandCount;
         effectDescriptor.bandCount = bandCount;
-        effectDescriptor.multibandCompander.setEffectiveSize(bandCount);
-        _effectParameterMap.setValue(bandCountParam, TOSTRING(bandCount));
-        _updateSettings(effectDescriptor, _sampleRate, _channelCount);
+
+        if (effectDescriptor.isAllocated) {
+            effectDescriptor.multibandCompander.setEffectiveSize(bandCount);
+        }
+
+        _effectParameterMap.setNumericValue(parameterId, Real{bandCount});
+
+        /* the bands becoming effective and the last band before
+           and after the change (the last band has no top crossover)
+           have to be adapted */
+        const Natural firstChangedBandIndex =
+            Natural::minimum(oldBandCount, bandCount) - 1;
+
+        for (Natural bandIndex = firstChangedBandIndex;
+             bandIndex < bandCount;  bandIndex++) {
+            effectDescriptor.indexToBandIsChangedMap[bandIndex] = true;
+        }
+
+        if (!_parameterBatchIsActive) {
+            _updateChangedSettings(effectDescriptor, _sampleRate);
+        }
+
         result = SoXParameterValueChangeKind::pageCountChange;
-    } else if (STR::endsWith(parameterName, bandIndexParam)) {
+    } else if ((int) parameterId == parameterId_lookahead) {
+        /* the delay lines are preallocated, hence the lookahead
+           can be changed directly */
+        const Real lookahead = _effectParameterMap.numericValue(parameterId);
+        effectDescriptor.lookahead = lookahead;
+        effectDescriptor.multibandCompander
+            .setLookahead(_lookaheadSampleCount(lookahead, _sampleRate));
+    } else if ((int) parameterId == parameterId_crossover) {
+        /* the linear phase crossover has usually been reserved by
+           <C>reserveForValue</C> */
+        const Boolean isLinearPhase = (value == _crossoverKindList[1]);
+        effectDescriptor.crossoverIsLinearPhase = isLinearPhase;
+
+        if (effectDescriptor.isAllocated) {
+            effectDescriptor.multibandCompander
+                .setLinearPhaseCrossover(isLinearPhase);
+            _updateResponseCurves(effectDescriptor, _sampleRate);
+        }
+    } else if ((int) parameterId == parameterId_bandRate) {
+        /* the multirate state has usually been reserved by
+           <C>reserveForValue</C> */
+        const Boolean isMultirate = (value == _bandRateKindList[1]);
+        effectDescriptor.bandsAreMultirate = isMultirate;
+
+        if (effectDescriptor.isAllocated) {
+            effectDescriptor.multibandCompander
+                .setMultirateBands(isMultirate);
+        }
+    } else if ((int) parameterId == parameterId_bandIndex) {
         const Natural bandIndex =
-            Natural::forceToInterval(STR::toNatural(value),
+            Natural::forceToInterval((Natural) _effectParameterMap
+                                     .numericValue(parameterId),
                                      1, effectDescriptor.bandCount);
-        _effectParameterMap.setValue(bandIndexParam, TOSTRING(bandIndex));
+        _effectParameterMap.setNumericValue(parameterId, Real{bandIndex});
         result = SoXParameterValueChangeKind::pageChange;
     } else {
-        Natural pageIndex;
-        String effectiveParameterName;
-        SoXEffectParameterMap::splitParameterName(parameterName,
-                                                 effectiveParameterName,
-                                                 pageIndex);
-        const Natural bandIndex = pageIndex - 1;
+        /* band parameters are laid out band by band */
+        const Natural relativeId =
+            parameterId - Natural{parameterId_firstBandParameter};
+        const Natural bandIndex = relativeId / bandParameterCount;
 
         if (bandIndex < effectDescriptor.bandCount) {
             _CompanderBandParameterData& data =
                 effectDescriptor.indexToCompanderBandParamDataMap[bandIndex];
+            const Real numericValue =
+                _effectParameterMap.numericValue(parameterId);
+
+            switch ((int) (relativeId % bandParameterCount)) {
+                case bandParameterId_attack:
+                    data.attack = numericValue;
+                    break;
+
+                case bandParameterId_decay:
+                    data.decay = numericValue;
+                    break;
+
+                case bandParameterId_dBKnee:
+                    data.knee = numericValue;
+                    break;
+
+                case bandParameterId_dBThreshold:
+                    data.threshold = numericValue;
+                    break;
+
+                case bandParameterId_ratio:
+                    data.ratio = numericValue;
+                    break;
 
-            if (effectiveParameterName == parameterName_attack) {
-                data.attack = STR::toReal(value);
-            } else if (effectiveParameterName == parameterName_decay) {
-                data.decay = STR::toReal(value);
-            } else if (effectiveParameterName == parameterName_dBKnee) {
-                data.knee = STR::toReal(value);
-            } else if (effectiveParameterName == parameterName_dBThreshold) {
-                data.threshold = STR::toReal(value);
-            } else if (effectiveParameterName == parameterName_ratio) {
-                data.ratio = STR::toReal(value);
-            } else if (effectiveParameterName == parameterName_dBGain) {
-                data.gain = STR::toReal(value);
-            } else if (effectiveParameterName == parameterName_topFrequency) {
-                data.topFrequency = STR::toReal(value);
+                case bandParameterId_dBGain:
+                    data.gain = numericValue;
+                    break;
+
+                case bandParameterId_topFrequency:
+                    data.topFrequency = numericValue;
+                    break;
+
+                default:
+                    break;
             }
 
+            effectDescriptor.indexToBandIsChangedMap[bandIndex] = true;
+
             if (recalculationIsForced) {
-                _updateSettings(effectDescriptor, _sampleRate, _channelCount);
+                _updateChangedSettings(effectDescriptor, _sampleRate);
             }
         }
     }
@@ -460,6 +1036,74 @@ SoXParameterValueChangeKind SoXCompander_AudioEffect
 
 /*--------------------*/
 
+void SoXCompander_AudioEffect::recalculateSettings ()
+{
+    Logging_trace(">>");
+
+    _EffectDescriptor_CMPD& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CMPD>(_effectDescriptor);
+
+    if (effectDescriptor.isAllocated) {
+        _updateSettings(effectDescriptor, _sampleRate,
+                        effectDescriptor.channelCount);
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void
+SoXCompander_AudioEffect::reserveForValue (IN String& parameterName,
+                                           IN String& value)
+{
+    Logging_trace2(">>: parameterName = %1, value = %2",
+                   parameterName, value);
+
+    _EffectDescriptor_CMPD& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CMPD>(_effectDescriptor);
+
+    /* without allocated state the reservation is done by
+       prepareToPlay */
+    if (effectDescriptor.isAllocated
+        && _effectParameterMap.contains(parameterName)) {
+        const int parameterId =
+            (int) _effectParameterMap.parameterId(parameterName);
+        SoXMultibandCompander& compander =
+            effectDescriptor.multibandCompander;
+
+        if (parameterId == parameterId_bandCount) {
+            const Natural bandCount =
+                Natural::forceToInterval(STR::toNatural(value, 1),
+                                         1, _maxBandCount);
+            compander.reserve(bandCount);
+        } else if (parameterId == parameterId_crossover
+                   && value == _crossoverKindList[1]) {
+            compander.reserveLinearPhaseCrossover();
+        } else if (parameterId == parameterId_bandRate
+                   && value == _bandRateKindList[1]) {
+            compander.reserveMultirateBands();
+        }
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXCompander_AudioEffect::_recalculateChangedSettings ()
+{
+    Logging_trace(">>");
+
+    _EffectDescriptor_CMPD& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CMPD>(_effectDescriptor);
+    _updateChangedSettings(effectDescriptor, _sampleRate);
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
 void SoXCompander_AudioEffect::setDefaultValues ()
 {
     Logging_trace(">>");
@@ -467,6 +1111,11 @@ void SoXCompander_AudioEffect::setDefaultValues ()
     _channelCount = 2;
 
     _effectParameterMap.setValue("0#" + parameterName_bandCount, "1");
+    _effectParameterMap.setValue("-2#" + parameterName_lookahead, "0");
+    _effectParameterMap.setValue("-2#" + parameterName_crossover,
+                                 _crossoverKindList[0]);
+    _effectParameterMap.setValue("-2#" + parameterName_bandRate,
+                                 _bandRateKindList[0]);
     _effectParameterMap.setValue("-1#" + parameterName_bandIndex, "1");
 
     for (Natural bandIndex = 0;  bandIndex < _maxBandCount;
@@ -501,11 +1150,35 @@ void SoXCompander_AudioEffect::setDefaultValues ()
     _EffectDescriptor_CMPD& effectDescriptor =
         TOREFERENCE<_EffectDescriptor_CMPD>(_effectDescriptor);
     effectDescriptor.bandCount = 1;
-    _updateSettings(effectDescriptor, _sampleRate, _channelCount);
+    effectDescriptor.lookahead = 0.0;
+    effectDescriptor.crossoverIsLinearPhase = false;
+    effectDescriptor.bandsAreMultirate = false;
+
+    if (effectDescriptor.isAllocated) {
+        _updateSettings(effectDescriptor, _sampleRate, _channelCount);
+    }
 
     Logging_trace1("<<: %1", toString());
 }
 
+/*--------------------*/
+/* DSP state          */
+/*--------------------*/
+
+void SoXCompander_AudioEffect::_resetDspState ()
+{
+    Logging_trace(">>");
+
+    _EffectDescriptor_CMPD& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CMPD>(_effectDescriptor);
+
+    if (effectDescriptor.isAllocated) {
+        effectDescriptor.multibandCompander.clear();
+    }
+
+    Logging_trace("<<");
+}
+
 /*--------------------*/
 /* event handling     */
 /*--------------------*/
@@ -514,16 +1187,40 @@ void SoXCompander_AudioEffect::prepareToPlay (IN Real sampleRate)
 {
     Logging_trace1(">>: %1", TOSTRING(sampleRate));
 
-    if (sampleRate == _sampleRate) {
+    _EffectDescriptor_CMPD& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CMPD>(_effectDescriptor);
+
+    if (effectDescriptor.isAllocated && sampleRate == _sampleRate) {
         Logging_trace("--: no recalculation");
     } else {
-        _EffectDescriptor_CMPD& effectDescriptor =
-            TOREFERENCE<_EffectDescriptor_CMPD>(_effectDescriptor);
+        /* compander has to be allocated or recalculated; at least a
+           stereo signal is assumed, more channels are added by the
+           processing */
+        const Natural channelCount =
+            Natural::maximum(2, Natural::maximum(_channelCount,
+                                                 effectDescriptor
+                                                 .channelCount));
         _sampleRate = sampleRate;
-        /* compander has to be recalculated */
-        _updateSettings(effectDescriptor, _sampleRate, _channelCount);
+        _updateSettings(effectDescriptor, _sampleRate, channelCount);
     }
 
+    SoXAudioEffect::prepareToPlay(sampleRate);
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXCompander_AudioEffect::releaseResources ()
+{
+    Logging_trace(">>");
+
+    SoXAudioEffect::releaseResources();
+    _EffectDescriptor_CMPD& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CMPD>(_effectDescriptor);
+    effectDescriptor.multibandCompander.release();
+    effectDescriptor.channelCount = 0;
+    effectDescriptor.isAllocated = false;
+
     Logging_trace("<<");
 }
 
@@ -533,39 +1230,22 @@ void
 SoXCompander_AudioEffect::processBlock
                               (IN Real timePosition,
                                INOUT AudioSampleListVector& buffer) {
-    Logging_trace1(">>: time = %1", TOSTRING(timePosition));
+    Logging_traceHot1(">>: time = %1", TOSTRING(timePosition));
 
     SoXAudioEffect::processBlock(timePosition, buffer);
 
     _EffectDescriptor_CMPD& effectDescriptor =
         TOREFERENCE<_EffectDescriptor_CMPD>(_effectDescriptor);
 
-    if (_channelCount != effectDescriptor.channelCount) {
-        effectDescriptor.channelCount = _channelCount;
+    /* the compander only grows with the channel count, a block
+       with less channels keeps the state of the others */
+    if (_channelCount > effectDescriptor.channelCount) {
         _updateSettings(effectDescriptor, _sampleRate, _channelCount);
     }
 
-    const Natural sampleCount = buffer[0].size();
     SoXMultibandCompander& compander = effectDescriptor.multibandCompander;
-    AudioSampleList& inputSampleList  =
-        effectDescriptor.inputSampleList;
-    AudioSampleList& outputSampleList =
-        effectDescriptor.outputSampleList;
-
-    for (Natural i = 0;  i < sampleCount;  i++) {
-        for (Natural channel = 0;  channel < _channelCount;  channel++) {
-            const AudioSampleList& inputList = buffer[channel];
-            inputSampleList[channel] = inputList[i];
-        }
+    compander.apply(buffer, _sidechain);
+    _guardFiniteness(buffer);
 
-        compander.apply(inputSampleList, outputSampleList);
-
-        /* write output sample list onto all channels */
-        for (Natural channel = 0;  channel < _channelCount;  channel++) {
-            AudioSampleList& outputList = buffer[channel];
-            outputList[i] = outputSampleList[channel];
-        }
-    }
-
-    Logging_trace("<<");
+    Logging_traceHot("<<");
 }
@@ -31,7 +31,7 @@ namespace SoXPlugins::Effects::SoXCompander {
      * compander is just seen as a multiband compander with a single
      * band.
      */
-    struct SoXCompander_AudioEffect : public SoXAudioEffect {
+    struct SoXCompander_AudioEffect final : public SoXAudioEffect {
 
         /*---------------------*/
         /* setup & destruction */
@@ -55,10 +55,148 @@ namespace SoXPlugins::Effects::SoXCompander {
 
         String name () const override;
 
+        /*--------------------*/
+
+        Real tailLength () const override;
+
+        /*--------------------*/
+
+        /**
+         * Returns the latency of the compander, which is its
+         * lookahead plus the delay of a linear phase crossover and
+         * of the band alignment for a reduced band rate in
+         * samples.
+         *
+         * @return  latency in samples
+         */
+        Natural latency () const override;
+
+        /*--------------------*/
+
+        Real warmupLength () const override;
+
+        /*--------------------*/
+        /* sidechain          */
+        /*--------------------*/
+
+        /**
+         * Tells that the compander evaluates an external sidechain:
+         * when connected, its maximum absolute sample drives the
+         * envelopes of all bands.
+         *
+         * @return  true
+         */
+        Boolean hasSidechainInput () const override;
+
+        /*--------------------*/
+        /* frequency response */
+        /*--------------------*/
+
+        /**
+         * Returns the number of response curves of the compander,
+         * which is one crossover response per band for a
+         * Linkwitz-Riley crossover and none for a linear phase
+         * crossover.
+         *
+         * @return  count of response curves
+         */
+        Natural responseCurveCount () const override;
+
+        /*--------------------*/
+
+        Boolean frequencyResponse (IN Natural curveIndex,
+                                   IN RealList& frequencyList,
+                                   OUT RealList& magnitudeList,
+                                   OUT RealList& phaseList)
+            const override;
+
+        /*--------------------*/
+        /* metering           */
+        /*--------------------*/
+
+        /**
+         * Returns the number of effective compander bands, each
+         * with its gain reduction.
+         *
+         * @return  count of gain reduction values
+         */
+        Natural gainReductionCount () const override;
+
+        /*--------------------*/
+
+        Real takeGainReduction (IN Natural index) override;
+
+        /*--------------------*/
+        /* quality level      */
+        /*--------------------*/
+
+        /**
+         * Returns the number of quality levels of the compander:
+         * above full quality the gains are computed at an automatic
+         * control rate, then additionally with fast math
+         * approximations and finally by decimated detectors.
+         *
+         * @return  count of quality levels
+         */
+        Natural qualityLevelCount () const override;
+
+        /*--------------------*/
+
+        void setQualityLevel (IN Natural level) override;
+
+        /*--------------------*/
+        /* precision profile  */
+        /*--------------------*/
+
+        /**
+         * Sets the precision profile of the compander to
+         * <C>profile</C>: the fast profile computes the gains at an
+         * automatic control rate with fast math approximations
+         * (like the second quality level), the other profiles
+         * evaluate them exactly for each sample.
+         *
+         * @param[in] profile  new precision profile
+         */
+        void setPrecisionProfile (IN SoXPrecisionProfile profile) override;
+
+        /*--------------------*/
+        /* memory footprint   */
+        /*--------------------*/
+
+        SoXMemoryFootprint memoryFootprint () const override;
+
+        /*--------------------*/
+        /* mono processing    */
+        /*--------------------*/
+
+        Boolean hasMonoProcessing () const override;
+
+        /*--------------------*/
+
+        void copyFirstChannelState (IN Natural channelCount) override;
+
         /*--------------------*/
         /* parameter change   */
         /*--------------------*/
 
+        void recalculateSettings () override;
+
+        /*--------------------*/
+
+        /**
+         * Reserves the compander bands for a new band count or the
+         * linear phase crossover for a crossover change, such that
+         * the change on the audio thread does not allocate.
+         *
+         * @param[in] parameterName  name of parameter to be set
+         *                           later
+         * @param[in] value          associated value of parameter
+         */
+        void reserveForValue (IN String& parameterName,
+                              IN String& value) override;
+
+        /*--------------------*/
+
         void setDefaultValues () override;
 
         /*--------------------*/
@@ -70,6 +208,10 @@ namespace SoXPlugins::Effects::SoXCompander {
 
         /*--------------------*/
 
+        void releaseResources () override;
+
+        /*--------------------*/
+
         void processBlock (IN Real timePosition,
                            INOUT AudioSampleListVector& buffer)
             override;
@@ -84,8 +226,17 @@ namespace SoXPlugins::Effects::SoXCompander {
 
             /*--------------------*/
 
+            void _recalculateChangedSettings () override;
+
+            /*--------------------*/
+
+            void _resetDspState () override;
+
+            /*--------------------*/
+
             SoXParameterValueChangeKind
-            _setValueInternal (IN String& parameterName,
+            _setValueInternal (IN Natural parameterId,
+                               IN String& parameterName,
                                IN String& value,
                                IN Boolean recalculationIsForced)
                 override;
@@ -28,13 +28,16 @@ namespace SoXPlugins::Effects::SoXCompander {
      * A <C>SoXCompander_AudioProcessor</C> is the JUCE wrapper for
      * the SoX <B>compand</B> and <B>mcompand</B> audio effects; a
      * simple compander is just seen as a multiband compander with a
-     * single band.
+     * single band; an optional sidechain input may drive the
+     * envelopes instead of the input signal (e.g. for ducking).
      */
     struct SoXCompander_AudioProcessor : public SoXAudioProcessor {
 
-        SoXCompander_AudioProcessor () {
+        SoXCompander_AudioProcessor ()
+            : SoXAudioProcessor(true)
+        {
             Logging_initializeWithDefaults("SoXCompander", "SoXPlugins.");
-            _setAssociatedEffect(new SoXCompander_AudioEffect{});
+            _setAssociatedEffect(_makeEffect());
         }
 
         /*--------------------*/
@@ -44,6 +47,15 @@ namespace SoXPlugins::Effects::SoXCompander {
             return String("SoXCompander");
         }
 
+        /*--------------------*/
+
+        protected:
+
+            SoXAudioEffect* _makeEffect () const override
+            {
+                return new SoXCompander_AudioEffect{};
+            }
+
     };
 
 }
@@ -0,0 +1,1432 @@
+/**
+ * @file
+ * The <C>SoXEffectChain_AudioEffect</C> body implements an effect
+ * chaining several SoX effects and processing them in place on a
+ * single buffer.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "GenericList.h"
+#include "Kernels.h"
+#include "Logging.h"
+#include "MyArray.h"
+#include "NaturalList.h"
+#include "SoXEffectChain_AudioEffect.h"
+#include "SoXWorkerPool.h"
+#include "StringList.h"
+
+/*--------------------*/
+
+using Audio::AudioSampleList;
+using Audio::AudioSampleListVector;
+using Audio::Kernels;
+using BaseTypes::Containers::copyArray;
+using BaseTypes::Containers::NaturalList;
+using BaseTypes::Containers::StringList;
+using BaseTypes::GenericTypes::GenericList;
+using BaseTypes::Primitives::Integer;
+using SoXPlugins::Effects::SoXEffectChain::SoXEffectChain_AudioEffect;
+using SoXPlugins::Helpers::SoXEffectParameterKind;
+using SoXPlugins::Helpers::SoXWorkerPool;
+using SoXPlugins::Helpers::precisionProfileToString;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
+
+/*============================================================*/
+
+namespace SoXPlugins::Effects::SoXEffectChain {
+
+    /** the list of values for a yes-no parameter */
+    static const StringList _yesNoList =
+        StringList::makeBySplit("Yes/No", "/");
+
+    /** the name suffix of the bypass parameter of a stage */
+    static const String parameterName_bypass = "Bypass";
+
+    /** the separator between stage number and stage parameter
+     * name */
+    static const String _stageSeparator = ": ";
+
+    /*====================*/
+
+    /**
+     * An <C>_EffectStage</C> object is a single effect within the
+     * chain together with its processing state.
+     */
+    struct _EffectStage {
+
+        /** the effect of this stage (owned by the chain) */
+        SoXAudioEffect* effect;
+
+        /** tells whether the stage is skipped in processing */
+        Boolean isBypassed;
+
+        /** tells whether a parameter batch of the chain has been
+         * forwarded to this stage */
+        Boolean isInBatch;
+
+        /*--------------------*/
+        /*--------------------*/
+
+        String toString () const
+        {
+            String st =
+                STR::expand("_EffectStage(effect = %1,"
+                            " isBypassed = %2, isInBatch = %3)",
+                            effect->name(), TOSTRING(isBypassed),
+                            TOSTRING(isInBatch));
+            return st;
+        }
+
+    };
+
+    /*====================*/
+
+    /**
+     * A <C>_ParallelSection</C> object describes a split of the
+     * chain into branches merged by summation; the branches are
+     * consecutive ranges of stages.
+     */
+    struct _ParallelSection {
+
+        /** the index of the first stage of each branch; a branch
+         * ends where the next one starts and the last one at the
+         * end of the section */
+        NaturalList branchStartList;
+
+        /** the index after the last stage of the section */
+        Natural endStageIndex;
+
+        /** the buffers for the input copies of all branches except
+         * the first one (which works in place) */
+        GenericList<AudioSampleListVector> branchBufferList;
+
+        /*--------------------*/
+        /*--------------------*/
+
+        String toString () const
+        {
+            String st = "_ParallelSection(branchStartList = (";
+
+            for (Natural i = 0;  i < branchStartList.size();  i++) {
+                st += (i == 0 ? "" : ", ") + TOSTRING(branchStartList[i]);
+            }
+
+            st += "), endStageIndex = " + TOSTRING(endStageIndex) + ")";
+            return st;
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns the index after the last stage of the branch with
+         * <C>branchIndex</C>.
+         *
+         * @param[in] branchIndex  zero-based index of branch
+         * @return  end index of branch
+         */
+        Natural branchEnd (IN Natural branchIndex) const
+        {
+            return (branchIndex + 1 < branchStartList.size()
+                    ? branchStartList[branchIndex + 1] : endStageIndex);
+        }
+
+    };
+
+    /*====================*/
+
+    /**
+     * An <C>_EffectDescriptor_CHAIN</C> object is the internal
+     * implementation of an effect chain descriptor type holding the
+     * stages and the mapping from chain parameters onto stage
+     * parameters.
+     */
+    struct _EffectDescriptor_CHAIN {
+
+        /** the stages of the chain in processing order */
+        GenericList<_EffectStage> stageList;
+
+        /** the stage index for each chain parameter (indexed by
+         * parameter identification) */
+        NaturalList parameterIdToStageIndexMap;
+
+        /** the name of the stage parameter for each chain parameter
+         * (indexed by parameter identification); empty for a bypass
+         * parameter */
+        StringList parameterIdToStageParameterNameMap;
+
+        /** the parallel sections in stage order */
+        GenericList<_ParallelSection> sectionList;
+
+        /** tells whether the last section still takes appended
+         * stages */
+        Boolean sectionIsOpen;
+
+        /** the precision profile of all stages */
+        SoXPrecisionProfile precisionProfile{SoXPrecisionProfile::soxExact};
+
+        /*--------------------*/
+        /*--------------------*/
+
+        String toString () const
+        {
+            String st = "_EffectDescriptor_CHAIN(stageList = (";
+
+            for (Natural i = 0;  i < stageList.size();  i++) {
+                st += (i == 0 ? "" : ", ") + stageList[i].toString();
+            }
+
+            st += "), sectionList = (";
+
+            for (Natural i = 0;  i < sectionList.size();  i++) {
+                st += (i == 0 ? "" : ", ") + sectionList[i].toString();
+            }
+
+            st += "), sectionIsOpen = " + TOSTRING(sectionIsOpen);
+            st += (", precisionProfile = "
+                   + precisionProfileToString(precisionProfile) + ")");
+            return st;
+        }
+
+    };
+
+    /*--------------------*/
+    /* internal routines  */
+    /*--------------------*/
+
+    /**
+     * Returns the name of the chain parameter for stage parameter
+     * <C>parameterName</C> of the stage with <C>stageIndex</C>: the
+     * stage number is inserted after a page prefix.
+     *
+     * @param[in] parameterName  name of parameter in stage
+     * @param[in] stageIndex     zero-based index of stage
+     * @return  name of parameter in chain
+     */
+    static String _chainParameterName (IN String& parameterName,
+                                       IN Natural stageIndex)
+    {
+        const String separator = SoXEffectParameterMap::widgetPageSeparator;
+        const String stagePrefix =
+            TOSTRING(stageIndex + 1) + _stageSeparator;
+        const Natural position = STR::find(parameterName, separator);
+        String result;
+
+        if (position == Natural::maximumValue()) {
+            result = stagePrefix + parameterName;
+        } else {
+            const Natural prefixLength = position + separator.length();
+            result = (STR::prefix(parameterName, prefixLength)
+                      + stagePrefix
+                      + STR::substring(parameterName, prefixLength));
+        }
+
+        return result;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Defines parameter <C>chainParameterName</C> in
+     * <C>chainParameterMap</C> with the kind and value range of
+     * parameter <C>parameterName</C> in <C>parameterMap</C>.
+     *
+     * @param[inout] chainParameterMap   parameter map of chain
+     * @param[in]    chainParameterName  name of parameter in chain
+     * @param[in]    parameterMap        parameter map of stage
+     * @param[in]    parameterName       name of parameter in stage
+     */
+    static void
+    _defineParameter (INOUT SoXEffectParameterMap& chainParameterMap,
+                      IN String& chainParameterName,
+                      IN SoXEffectParameterMap& parameterMap,
+                      IN String& parameterName)
+    {
+        const SoXEffectParameterKind kind = parameterMap.kind(parameterName);
+
+        if (kind == SoXEffectParameterKind::enumKind) {
+            StringList valueList;
+            parameterMap.valueRangeEnum(parameterName, valueList);
+            chainParameterMap.setKindEnum(chainParameterName, valueList);
+        } else if (kind == SoXEffectParameterKind::intKind) {
+            Integer lowValue, highValue, delta;
+            parameterMap.valueRangeInt(parameterName,
+                                       lowValue, highValue, delta);
+            chainParameterMap.setKindInt(chainParameterName,
+                                         lowValue, highValue, delta);
+        } else if (kind == SoXEffectParameterKind::realKind) {
+            Real lowValue, highValue, delta;
+            parameterMap.valueRangeReal(parameterName,
+                                        lowValue, highValue, delta);
+            chainParameterMap.setKindReal(chainParameterName,
+                                          lowValue, highValue, delta);
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Copies the values and the activeness of all parameters of
+     * the stage with <C>stageIndex</C> from its parameter map into
+     * <C>chainParameterMap</C>; an enumeration parameter whose value
+     * list has been changed by the stage is redefined.
+     *
+     * @param[inout] chainParameterMap  parameter map of chain
+     * @param[in]    effectDescriptor   descriptor of chain
+     * @param[in]    stageIndex         zero-based index of stage
+     */
+    static void
+    _synchronizeStage (INOUT SoXEffectParameterMap& chainParameterMap,
+                       IN _EffectDescriptor_CHAIN& effectDescriptor,
+                       IN Natural stageIndex)
+    {
+        Logging_trace1(">>: %1", TOSTRING(stageIndex));
+
+        const SoXEffectParameterMap& parameterMap =
+            effectDescriptor.stageList[stageIndex].effect
+                ->effectParameterMap();
+        const NaturalList& stageIndexMap =
+            effectDescriptor.parameterIdToStageIndexMap;
+
+        for (Natural parameterId = 0;  parameterId < stageIndexMap.size();
+             parameterId++) {
+            const String& parameterName =
+                effectDescriptor
+                    .parameterIdToStageParameterNameMap[parameterId];
+
+            if (stageIndexMap[parameterId] == stageIndex
+                && parameterName != "") {
+                const String chainParameterName =
+                    chainParameterMap.parameterName(parameterId);
+
+                if (parameterMap.kind(parameterName)
+                    == SoXEffectParameterKind::enumKind) {
+                    StringList valueList, chainValueList;
+                    parameterMap.valueRangeEnum(parameterName, valueList);
+                    chainParameterMap.valueRangeEnum(chainParameterName,
+                                                     chainValueList);
+
+                    if (valueList != chainValueList) {
+                        chainParameterMap.setKindEnum(chainParameterName,
+                                                      valueList);
+                    }
+                }
+
+                const String value = parameterMap.value(parameterName);
+
+                if (chainParameterMap.isAllowedValue(chainParameterName,
+                                                     value)) {
+                    chainParameterMap.setValue(chainParameterName, value);
+                } else {
+                    chainParameterMap.invalidateValue(chainParameterName);
+                }
+
+                chainParameterMap
+                    .setActiveness(chainParameterName,
+                                   parameterMap.isActive(parameterName));
+            }
+        }
+
+        Logging_trace("<<");
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies <C>processProc</C> to the non-bypassed stages of
+     * <C>effectDescriptor</C> from <C>firstIndex</C> up to (but
+     * not including) <C>endIndex</C> in order.  Before a stage is
+     * processed, it may absorb the directly following stages of the
+     * range (like a gain after a filter) into its own pass;
+     * absorbed stages are then skipped.
+     *
+     * @tparam       ProcessProc       type of stage processing
+     *                                 function
+     * @param[inout] effectDescriptor  descriptor of chain
+     * @param[in]    firstIndex        index of first stage
+     * @param[in]    endIndex          index after last stage
+     * @param[in]    processProc       function processing a single
+     *                                 stage effect in place
+     */
+    template<typename ProcessProc>
+    static void
+    _processStages (INOUT _EffectDescriptor_CHAIN& effectDescriptor,
+                    IN Natural firstIndex,
+                    IN Natural endIndex,
+                    IN ProcessProc& processProc)
+    {
+        GenericList<_EffectStage>& stageList = effectDescriptor.stageList;
+        const Natural stageCount = endIndex;
+        Natural stageIndex = firstIndex;
+
+        while (stageIndex < stageCount) {
+            _EffectStage& stage = stageList[stageIndex];
+            stageIndex++;
+
+            if (!stage.isBypassed) {
+                /* fuse following stages as long as possible */
+                while (stageIndex < stageCount) {
+                    _EffectStage& nextStage = stageList[stageIndex];
+
+                    if (nextStage.isBypassed
+                        || stage.effect->absorbSuccessor(nextStage.effect)) {
+                        stageIndex++;
+                    } else {
+                        break;
+                    }
+                }
+
+                Logging_span("SoXEffectChain.stage", stage.effect);
+                processProc(stage.effect);
+            }
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the sum of <C>valueProc</C> over the non-bypassed
+     * stages of <C>effectDescriptor</C> from <C>firstIndex</C> up
+     * to (but not including) <C>endIndex</C>.
+     *
+     * @tparam    ValueType         type of stage value
+     * @tparam    ValueProc         type of stage value function
+     * @param[in] effectDescriptor  descriptor of chain
+     * @param[in] firstIndex        index of first stage
+     * @param[in] endIndex          index after last stage
+     * @param[in] valueProc         function returning the value of
+     *                              a stage effect
+     * @return  sum of stage values
+     */
+    template<typename ValueType, typename ValueProc>
+    static ValueType
+    _stageValueSum (IN _EffectDescriptor_CHAIN& effectDescriptor,
+                    IN Natural firstIndex,
+                    IN Natural endIndex,
+                    IN ValueProc& valueProc)
+    {
+        ValueType result{Natural{0}};
+
+        for (Natural i = firstIndex;  i < endIndex;  i++) {
+            const _EffectStage& stage = effectDescriptor.stageList[i];
+
+            if (!stage.isBypassed) {
+                result += valueProc(stage.effect);
+            }
+        }
+
+        return result;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the sum of <C>valueProc</C> over the non-bypassed
+     * stages of <C>effectDescriptor</C> along the path through the
+     * chain with the largest sum: the values of serial stages add
+     * up and a parallel section contributes its largest branch
+     * (like for a latency or a tail).
+     *
+     * @tparam    ValueType         type of stage value
+     * @tparam    ValueProc         type of stage value function
+     * @param[in] effectDescriptor  descriptor of chain
+     * @param[in] valueProc         function returning the value of
+     *                              a stage effect
+     * @return  maximum path sum of stage values
+     */
+    template<typename ValueType, typename ValueProc>
+    static ValueType
+    _maximumPathSum (IN _EffectDescriptor_CHAIN& effectDescriptor,
+                     IN ValueProc& valueProc)
+    {
+        ValueType result{Natural{0}};
+        Natural stageIndex = 0;
+
+        for (const _ParallelSection& section
+                 : effectDescriptor.sectionList) {
+            const NaturalList& branchStartList = section.branchStartList;
+            result += _stageValueSum<ValueType>(effectDescriptor,
+                                                stageIndex,
+                                                branchStartList[0],
+                                                valueProc);
+            ValueType maximumValue{Natural{0}};
+
+            for (Natural branchIndex = 0;
+                 branchIndex < branchStartList.size();
+                 branchIndex++) {
+                const ValueType value =
+                    _stageValueSum<ValueType>(effectDescriptor,
+                                              branchStartList[branchIndex],
+                                              section.branchEnd(branchIndex),
+                                              valueProc);
+                maximumValue = (value > maximumValue ? value : maximumValue);
+            }
+
+            result += maximumValue;
+            stageIndex = section.endStageIndex;
+        }
+
+        result += _stageValueSum<ValueType>(effectDescriptor, stageIndex,
+                                            effectDescriptor.stageList.size(),
+                                            valueProc);
+        return result;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the number of bytes of the channel lists in
+     * <C>buffer</C> together with the list of those lists on the
+     * heap.
+     *
+     * @param[in] buffer  the buffer to be measured
+     * @return  count of owned bytes
+     */
+    static Natural _bufferByteCount (IN AudioSampleListVector& buffer)
+    {
+        Natural result = SoXMemoryFootprint::listByteCount(buffer);
+
+        for (const AudioSampleList& sampleList : buffer) {
+            result += SoXMemoryFootprint::listByteCount(sampleList);
+        }
+
+        return result;
+    }
+
+    /*====================*/
+
+    /**
+     * A <C>_BranchTaskContext</C> object holds the data for the
+     * concurrent processing of the branches of a parallel section.
+     */
+    struct _BranchTaskContext {
+
+        /** the descriptor of the chain */
+        _EffectDescriptor_CHAIN* effectDescriptor;
+
+        /** the section to be processed */
+        _ParallelSection* section;
+
+        /** the time position of the block */
+        Real timePosition;
+
+        /** the chain buffer (processed by the first branch) */
+        AudioSampleListVector* buffer;
+
+    };
+
+    /*--------------------*/
+
+    /**
+     * Processes the stages of branch <C>branchIndex</C> of the
+     * section in <C>context</C> on the buffer of the branch; this is
+     * the task function for the worker pool.
+     *
+     * @param[inout] context      the branch task context
+     * @param[in]    branchIndex  zero-based index of branch
+     */
+    static void _processBranch (INOUT void* context,
+                                IN Natural branchIndex)
+    {
+        _BranchTaskContext& taskContext = *((_BranchTaskContext*) context);
+        _ParallelSection& section = *taskContext.section;
+        AudioSampleListVector& buffer =
+            (branchIndex == 0 ? *taskContext.buffer
+             : section.branchBufferList[branchIndex - 1]);
+        const Real timePosition = taskContext.timePosition;
+
+        _processStages(*taskContext.effectDescriptor,
+                       section.branchStartList[branchIndex],
+                       section.branchEnd(branchIndex),
+                       [&] (SoXAudioEffect* effect) {
+                           effect->processBlock(timePosition, buffer);
+                       });
+    }
+
+    /*--------------------*/
+
+    /**
+     * Processes <C>section</C> of <C>effectDescriptor</C> on
+     * <C>buffer</C> at <C>timePosition</C>: the input is copied
+     * into the buffers of all branches but the first, the branches
+     * are processed as tasks on the worker pool and all branch
+     * buffers are added to <C>buffer</C> afterwards.
+     *
+     * @param[inout] effectDescriptor  descriptor of chain
+     * @param[inout] section           parallel section to process
+     * @param[in]    timePosition      time position of block
+     * @param[inout] buffer            chain buffer
+     */
+    static void
+    _processSection (INOUT _EffectDescriptor_CHAIN& effectDescriptor,
+                     INOUT _ParallelSection& section,
+                     IN Real timePosition,
+                     INOUT AudioSampleListVector& buffer)
+    {
+        const Natural channelCount = buffer.size();
+        const Natural frameCount = buffer.frameCount();
+        const Natural branchCount = section.branchStartList.size();
+
+        /* split: the branch buffers only allocate when the block
+           is larger than ever before */
+        for (AudioSampleListVector& branchBuffer
+                 : section.branchBufferList) {
+            branchBuffer.resizeChannels(channelCount, frameCount);
+
+            for (Natural channel = 0;  channel < channelCount;
+                 channel++) {
+                double* targetPtr = (double*) branchBuffer[channel].asArray();
+                const double* sourcePtr =
+                    (const double*) buffer[channel].asArray();
+                copyArray(targetPtr, sourcePtr, frameCount);
+            }
+        }
+
+        _BranchTaskContext taskContext{&effectDescriptor, &section,
+                                       timePosition, &buffer};
+        SoXWorkerPool::instance().run(_processBranch, &taskContext,
+                                      branchCount, frameCount);
+
+        /* merge */
+        const Kernels& kernels = Kernels::current();
+
+        for (const AudioSampleListVector& branchBuffer
+                 : section.branchBufferList) {
+            for (Natural channel = 0;  channel < channelCount;
+                 channel++) {
+                kernels.addDouble((double*) buffer[channel].asArray(),
+                                  (const double*)
+                                  branchBuffer[channel].asArray(),
+                                  (size_t) frameCount);
+            }
+        }
+    }
+
+}
+
+/*============================================================*/
+
+/*---------------------*/
+/* setup & destruction */
+/*---------------------*/
+
+SoXEffectChain_AudioEffect::SoXEffectChain_AudioEffect ()
+{
+    Logging_trace(">>");
+
+    /* initialize descriptor */
+    _effectDescriptor = new _EffectDescriptor_CHAIN{};
+
+    /* initialize parameters */
+    _effectParameterMap.clear();
+
+    Logging_trace1("<<: %1", toString());
+}
+
+/*---------------------*/
+
+SoXEffectChain_AudioEffect::~SoXEffectChain_AudioEffect ()
+{
+    Logging_trace(">>");
+
+    _EffectDescriptor_CHAIN* effectDescriptor =
+        (_EffectDescriptor_CHAIN*) _effectDescriptor;
+
+    for (_EffectStage& stage : effectDescriptor->stageList) {
+        delete stage.effect;
+    }
+
+    delete effectDescriptor;
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXEffectChain_AudioEffect::appendEffect (IN SoXAudioEffect* effect)
+{
+    Logging_trace1(">>: %1", effect->name());
+
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+    const Natural stageIndex = effectDescriptor.stageList.size();
+    effectDescriptor.stageList.append(_EffectStage{(SoXAudioEffect*) effect,
+                                                   false, false});
+
+    if (effectDescriptor.sectionIsOpen) {
+        GenericList<_ParallelSection>& sectionList =
+            effectDescriptor.sectionList;
+        sectionList[sectionList.size() - 1].endStageIndex = stageIndex + 1;
+    }
+
+    /* the footprint of the stage is reported by the chain */
+    _markAsNested((SoXAudioEffect*) effect);
+    ((SoXAudioEffect*) effect)
+        ->setPrecisionProfile(effectDescriptor.precisionProfile);
+
+    /* the bypass parameter precedes the parameters of the stage */
+    const String bypassParameterName =
+        _chainParameterName(parameterName_bypass, stageIndex);
+    _effectParameterMap.setKindEnum(bypassParameterName, _yesNoList);
+    _effectParameterMap.setValue(bypassParameterName, "No");
+    effectDescriptor.parameterIdToStageIndexMap.append(stageIndex);
+    effectDescriptor.parameterIdToStageParameterNameMap.append("");
+
+    const SoXEffectParameterMap& parameterMap =
+        effect->effectParameterMap();
+
+    for (const String& parameterName : parameterMap.parameterNameList()) {
+        _defineParameter(_effectParameterMap,
+                         _chainParameterName(parameterName, stageIndex),
+                         parameterMap, parameterName);
+        effectDescriptor.parameterIdToStageIndexMap.append(stageIndex);
+        effectDescriptor.parameterIdToStageParameterNameMap
+            .append(parameterName);
+    }
+
+    _synchronizeStage(_effectParameterMap, effectDescriptor, stageIndex);
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXEffectChain_AudioEffect::beginParallelSection ()
+{
+    Logging_trace(">>");
+
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+    const Natural stageIndex = effectDescriptor.stageList.size();
+    _ParallelSection section{};
+    section.branchStartList.append(stageIndex);
+    section.endStageIndex = stageIndex;
+    effectDescriptor.sectionList.append(section);
+    effectDescriptor.sectionIsOpen = true;
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXEffectChain_AudioEffect::beginBranch ()
+{
+    Logging_trace(">>");
+
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+
+    if (effectDescriptor.sectionIsOpen) {
+        GenericList<_ParallelSection>& sectionList =
+            effectDescriptor.sectionList;
+        _ParallelSection& section = sectionList[sectionList.size() - 1];
+        section.branchStartList.append(effectDescriptor.stageList.size());
+        section.branchBufferList.append(AudioSampleListVector{});
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXEffectChain_AudioEffect::endParallelSection ()
+{
+    Logging_trace(">>");
+
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+    effectDescriptor.sectionIsOpen = false;
+
+    Logging_trace("<<");
+}
+
+/*-----------------------*/
+/* string representation */
+/*-----------------------*/
+
+String SoXEffectChain_AudioEffect::toString () const
+{
+    String st = "SoXEffectChain_AudioEffect(";
+    st += _asRawString();
+    st += ")";
+
+    return st;
+}
+
+/*--------------------*/
+
+String SoXEffectChain_AudioEffect::_effectDescriptorToString () const
+{
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+    return effectDescriptor.toString();
+}
+
+/*--------------------*/
+/* property queries   */
+/*--------------------*/
+
+String SoXEffectChain_AudioEffect::name () const
+{
+    return "SoX Effect Chain";
+}
+
+/*--------------------*/
+
+Real SoXEffectChain_AudioEffect::tailLength () const
+{
+    Logging_trace(">>");
+
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+    /* each stage prolongs the tail of its predecessors, the
+       longest branch of a section determines its tail */
+    const Real result =
+        _maximumPathSum<Real>(effectDescriptor,
+                              [] (SoXAudioEffect* effect) {
+                                  return effect->tailLength();
+                              });
+
+    Logging_trace1("<<: %1", TOSTRING(result));
+    return result;
+}
+
+/*--------------------*/
+
+Natural SoXEffectChain_AudioEffect::latency () const
+{
+    Logging_trace(">>");
+
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+    const Natural result =
+        _maximumPathSum<Natural>(effectDescriptor,
+                                 [] (SoXAudioEffect* effect) {
+                                     return effect->latency();
+                                 });
+
+    Logging_trace1("<<: %1", TOSTRING(result));
+    return result;
+}
+
+/*--------------------*/
+
+Real SoXEffectChain_AudioEffect::warmupLength () const
+{
+    Logging_trace(">>");
+
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+    /* a stage only settles when its predecessors have settled */
+    const Real result =
+        _maximumPathSum<Real>(effectDescriptor,
+                              [] (SoXAudioEffect* effect) {
+                                  return effect->warmupLength();
+                              });
+
+    Logging_trace1("<<: %1", TOSTRING(result));
+    return result;
+}
+
+/*--------------------*/
+
+Natural SoXEffectChain_AudioEffect::effectCount () const
+{
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+    return effectDescriptor.stageList.size();
+}
+
+/*--------------------*/
+
+Natural SoXEffectChain_AudioEffect::parallelSectionCount () const
+{
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+    return effectDescriptor.sectionList.size();
+}
+
+/*--------------------*/
+
+SoXAudioEffect*
+SoXEffectChain_AudioEffect::effect (IN Natural index) const
+{
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+    return effectDescriptor.stageList[index].effect;
+}
+
+/*--------------------*/
+/* sidechain          */
+/*--------------------*/
+
+Boolean SoXEffectChain_AudioEffect::hasSidechainInput () const
+{
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+    Boolean result = false;
+
+    for (const _EffectStage& stage : effectDescriptor.stageList) {
+        result = result || stage.effect->hasSidechainInput();
+    }
+
+    return result;
+}
+
+/*--------------------*/
+
+void
+SoXEffectChain_AudioEffect::setSidechainInput
+                                (IN SoXSidechainView& sidechain)
+{
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+    SoXAudioEffect::setSidechainInput(sidechain);
+
+    for (_EffectStage& stage : effectDescriptor.stageList) {
+        stage.effect->setSidechainInput(sidechain);
+    }
+}
+
+/*--------------------*/
+/* mono processing    */
+/*--------------------*/
+
+Boolean SoXEffectChain_AudioEffect::hasMonoProcessing () const
+{
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+    Boolean result = true;
+
+    for (const _EffectStage& stage : effectDescriptor.stageList) {
+        result = result && (stage.isBypassed
+                            || stage.effect->hasMonoProcessing());
+    }
+
+    return result;
+}
+
+/*--------------------*/
+
+void
+SoXEffectChain_AudioEffect::copyFirstChannelState (IN Natural channelCount)
+{
+    Logging_trace1(">>: %1", TOSTRING(channelCount));
+
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+
+    for (_EffectStage& stage : effectDescriptor.stageList) {
+        stage.effect->copyFirstChannelState(channelCount);
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+Boolean SoXEffectChain_AudioEffect::hasIndependentChannels () const
+{
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+    Boolean result = true;
+
+    for (const _EffectStage& stage : effectDescriptor.stageList) {
+        result = result && (stage.isBypassed
+                            || stage.effect->hasIndependentChannels());
+    }
+
+    return result;
+}
+
+/*--------------------*/
+/* memory footprint   */
+/*--------------------*/
+
+SoXMemoryFootprint SoXEffectChain_AudioEffect::memoryFootprint () const
+{
+    using FP = SoXMemoryFootprint;
+
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+    SoXMemoryFootprint result = SoXAudioEffect::memoryFootprint();
+    const StringList& stageParameterNameMap =
+        effectDescriptor.parameterIdToStageParameterNameMap;
+    result.descriptorByteCount +=
+        (Natural{sizeof(_EffectDescriptor_CHAIN)}
+         + FP::listByteCount(effectDescriptor.stageList)
+         + FP::listByteCount(effectDescriptor.parameterIdToStageIndexMap)
+         + FP::listByteCount(stageParameterNameMap)
+         + FP::listByteCount(effectDescriptor.sectionList));
+
+    for (const _ParallelSection& section : effectDescriptor.sectionList) {
+        result.descriptorByteCount +=
+            (FP::listByteCount(section.branchStartList)
+             + FP::listByteCount(section.branchBufferList));
+
+        for (const AudioSampleListVector& branchBuffer
+                 : section.branchBufferList) {
+            result.descriptorByteCount += _bufferByteCount(branchBuffer);
+        }
+    }
+
+    for (const String& parameterName : stageParameterNameMap) {
+        result.descriptorByteCount += FP::stringByteCount(parameterName);
+    }
+
+    for (const _EffectStage& stage : effectDescriptor.stageList) {
+        result += stage.effect->memoryFootprint();
+    }
+
+    return result;
+}
+
+/*--------------------*/
+/* quality level      */
+/*--------------------*/
+
+Natural SoXEffectChain_AudioEffect::qualityLevelCount () const
+{
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+    Natural result = 1;
+
+    for (const _EffectStage& stage : effectDescriptor.stageList) {
+        result = Natural::maximum(result,
+                                  stage.effect->qualityLevelCount());
+    }
+
+    return result;
+}
+
+/*--------------------*/
+
+void SoXEffectChain_AudioEffect::setQualityLevel (IN Natural level)
+{
+    Logging_trace1(">>: %1", TOSTRING(level));
+
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+
+    for (_EffectStage& stage : effectDescriptor.stageList) {
+        stage.effect->setQualityLevel(level);
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* precision profile  */
+/*--------------------*/
+
+void SoXEffectChain_AudioEffect::setPrecisionProfile
+                                    (IN SoXPrecisionProfile profile)
+{
+    Logging_trace1(">>: %1", precisionProfileToString(profile));
+
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+    effectDescriptor.precisionProfile = profile;
+
+    for (_EffectStage& stage : effectDescriptor.stageList) {
+        stage.effect->setPrecisionProfile(profile);
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* DSP state          */
+/*--------------------*/
+
+Boolean SoXEffectChain_AudioEffect::hasDspStateSupport () const
+{
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+    Boolean result = true;
+
+    for (const _EffectStage& stage : effectDescriptor.stageList) {
+        result = result && stage.effect->hasDspStateSupport();
+    }
+
+    return result;
+}
+
+/*--------------------*/
+
+void
+SoXEffectChain_AudioEffect::_saveDspState (INOUT DspStateStream& stream)
+    const
+{
+    Logging_trace(">>");
+
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+    ByteList stageStateData;
+    stream.write(effectDescriptor.stageList.length());
+
+    for (const _EffectStage& stage : effectDescriptor.stageList) {
+        stage.effect->saveDspState(stageStateData);
+        stream.writeList(stageStateData);
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void
+SoXEffectChain_AudioEffect::_restoreDspState (INOUT DspStateStream& stream)
+{
+    Logging_trace(">>");
+
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+    ByteList stageStateData;
+    Natural stageCount = 0;
+    stream.read(stageCount);
+
+    if (stageCount != effectDescriptor.stageList.length()) {
+        stream.invalidate();
+    }
+
+    /* each stage checks its own blob */
+    for (_EffectStage& stage : effectDescriptor.stageList) {
+        stream.readList(stageStateData);
+
+        if (stream.isOkay()
+            && !stage.effect->restoreDspState(stageStateData)) {
+            stream.invalidate();
+        }
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* parameter change   */
+/*--------------------*/
+
+SoXParameterValueChangeKind
+SoXEffectChain_AudioEffect::_setValueInternal
+                                (IN Natural parameterId,
+                                 IN String& parameterName,
+                                 IN String& value,
+                                 IN Boolean recalculationIsForced)
+{
+    Logging_trace3(">>: parameterName = %1, value = %2,"
+                   " recalculationIsForced = %3",
+                   parameterName, value,
+                   TOSTRING(recalculationIsForced));
+
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+    SoXParameterValueChangeKind result =
+        SoXParameterValueChangeKind::parameterChange;
+
+    const Natural stageIndex =
+        effectDescriptor.parameterIdToStageIndexMap[parameterId];
+    const String& stageParameterName =
+        effectDescriptor.parameterIdToStageParameterNameMap[parameterId];
+    _EffectStage& stage = effectDescriptor.stageList[stageIndex];
+
+    if (stageParameterName == "") {
+        stage.isBypassed = (value == "Yes");
+    } else {
+        SoXAudioEffect* effect = stage.effect;
+
+        if (_parameterBatchIsActive && !stage.isInBatch) {
+            /* the stage recalculates its changed settings on the
+               commit of the chain batch */
+            effect->beginParameterBatch();
+            stage.isInBatch = true;
+        }
+
+        /* a value set numerically arrives without string form, but
+           the stages are addressed by strings */
+        const String stageValue =
+            (value > "" ? value : _effectParameterMap.value(parameterName));
+
+        /* the stage may already hold the value (e.g. from its
+           defaults), but it must update its internal settings */
+        effect->effectParameterMap().invalidateValue(stageParameterName);
+        result = effect->setValue(stageParameterName, stageValue,
+                                  recalculationIsForced);
+        _synchronizeStage(_effectParameterMap, effectDescriptor,
+                          stageIndex);
+    }
+
+    Logging_trace1("<<: %1", SoXParameterValueChangeKind_toString(result));
+    return result;
+}
+
+/*--------------------*/
+
+void SoXEffectChain_AudioEffect::recalculateSettings ()
+{
+    Logging_trace(">>");
+
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+
+    for (_EffectStage& stage : effectDescriptor.stageList) {
+        stage.effect->recalculateSettings();
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXEffectChain_AudioEffect::_recalculateChangedSettings ()
+{
+    Logging_trace(">>");
+
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+
+    /* only the stages touched by the batch recalculate */
+    for (_EffectStage& stage : effectDescriptor.stageList) {
+        if (stage.isInBatch) {
+            stage.effect->commitParameterBatch();
+            stage.isInBatch = false;
+        }
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXEffectChain_AudioEffect::setDefaultValues ()
+{
+    Logging_trace(">>");
+
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+
+    for (Natural stageIndex = 0;
+         stageIndex < effectDescriptor.stageList.size();
+         stageIndex++) {
+        _EffectStage& stage = effectDescriptor.stageList[stageIndex];
+        SoXAudioEffect* effect = stage.effect;
+        stage.isBypassed = false;
+        _effectParameterMap
+            .setValue(_chainParameterName(parameterName_bypass,
+                                          stageIndex),
+                      "No");
+
+        /* the stage defaults only reach the stage parameter map,
+           hence they are applied to the stage as a whole */
+        effect->setDefaultValues();
+        effect->setParameterValidity(true);
+        SoXEffectParameterMap& parameterMap = effect->effectParameterMap();
+        effect->beginParameterBatch();
+
+        for (const String& parameterName
+                 : parameterMap.parameterNameList()) {
+            const String value = parameterMap.value(parameterName);
+            parameterMap.invalidateValue(parameterName);
+            effect->setValue(parameterName, value, true);
+        }
+
+        effect->commitParameterBatch();
+        _synchronizeStage(_effectParameterMap, effectDescriptor,
+                          stageIndex);
+    }
+
+    Logging_trace1("<<: %1", toString());
+}
+
+/*--------------------*/
+/* event handling     */
+/*--------------------*/
+
+void SoXEffectChain_AudioEffect::prepareToPlay (IN Real sampleRate)
+{
+    Logging_trace1(">>: %1", TOSTRING(sampleRate));
+
+    SoXAudioEffect::prepareToPlay(sampleRate);
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+
+    for (_EffectStage& stage : effectDescriptor.stageList) {
+        stage.effect->prepareToPlay(sampleRate);
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXEffectChain_AudioEffect::releaseResources ()
+{
+    Logging_trace(">>");
+
+    SoXAudioEffect::releaseResources();
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+
+    for (_EffectStage& stage : effectDescriptor.stageList) {
+        stage.effect->releaseResources();
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void
+SoXEffectChain_AudioEffect::processBlock (IN Real timePosition,
+                                          INOUT AudioSampleListVector& buffer)
+{
+    Logging_traceHot1(">>: time = %1", TOSTRING(timePosition));
+
+    SoXAudioEffect::processBlock(timePosition, buffer);
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+
+    /* all serial stages work in place on the same buffer, the
+       sections in between split and merge it */
+    const auto processProc =
+        [&] (SoXAudioEffect* effect) {
+            effect->processBlock(timePosition, buffer);
+        };
+    Natural stageIndex = 0;
+
+    for (_ParallelSection& section : effectDescriptor.sectionList) {
+        _processStages(effectDescriptor, stageIndex,
+                       section.branchStartList[0], processProc);
+        _processSection(effectDescriptor, section, timePosition, buffer);
+        stageIndex = section.endStageIndex;
+    }
+
+    _processStages(effectDescriptor, stageIndex,
+                   effectDescriptor.stageList.size(), processProc);
+
+    Logging_traceHot("<<");
+}
+
+/*--------------------*/
+
+Boolean SoXEffectChain_AudioEffect::hasFloatProcessing () const
+{
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+    /* sections need sample buffers for their branches */
+    Boolean result = effectDescriptor.sectionList.isEmpty();
+
+    for (const _EffectStage& stage : effectDescriptor.stageList) {
+        result = result && (stage.isBypassed
+                            || stage.effect->hasFloatProcessing());
+    }
+
+    return result;
+}
+
+/*--------------------*/
+
+void
+SoXEffectChain_AudioEffect::processFloatBlock
+                                (IN Real timePosition,
+                                 INOUT float* const* channelArray,
+                                 IN Natural channelCount,
+                                 IN Natural sampleCount)
+{
+    Logging_traceHot1(">>: time = %1", TOSTRING(timePosition));
+
+    if (!hasFloatProcessing()) {
+        /* convert once into audio samples for all stages */
+        SoXAudioEffect::processFloatBlock(timePosition, channelArray,
+                                          channelCount, sampleCount);
+    } else {
+        _startBlock(timePosition, channelCount, sampleCount);
+        _EffectDescriptor_CHAIN& effectDescriptor =
+            TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+
+        _processStages(effectDescriptor, 0,
+                       effectDescriptor.stageList.size(),
+                       [&] (SoXAudioEffect* effect) {
+                           effect->processFloatBlock(timePosition,
+                                                    channelArray,
+                                                    channelCount,
+                                                    sampleCount);
+                       });
+    }
+
+    Logging_traceHot("<<");
+}
+
+/*--------------------*/
+
+Boolean SoXEffectChain_AudioEffect::hasDoubleProcessing () const
+{
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+    /* sections need sample buffers for their branches */
+    Boolean result = effectDescriptor.sectionList.isEmpty();
+
+    for (const _EffectStage& stage : effectDescriptor.stageList) {
+        result = result && (stage.isBypassed
+                            || stage.effect->hasDoubleProcessing());
+    }
+
+    return result;
+}
+
+/*--------------------*/
+
+void
+SoXEffectChain_AudioEffect::processDoubleBlock
+                                (IN Real timePosition,
+                                 INOUT double* const* channelArray,
+                                 IN Natural channelCount,
+                                 IN Natural sampleCount)
+{
+    Logging_traceHot1(">>: time = %1", TOSTRING(timePosition));
+
+    if (!hasDoubleProcessing()) {
+        /* copy once into audio samples for all stages */
+        SoXAudioEffect::processDoubleBlock(timePosition, channelArray,
+                                           channelCount, sampleCount);
+    } else {
+        _startBlock(timePosition, channelCount, sampleCount);
+        _EffectDescriptor_CHAIN& effectDescriptor =
+            TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+
+        _processStages(effectDescriptor, 0,
+                       effectDescriptor.stageList.size(),
+                       [&] (SoXAudioEffect* effect) {
+                           effect->processDoubleBlock(timePosition,
+                                                     channelArray,
+                                                     channelCount,
+                                                     sampleCount);
+                       });
+    }
+
+    Logging_traceHot("<<");
+}
+
+/*--------------------*/
+
+Boolean SoXEffectChain_AudioEffect::needsTimePosition () const
+{
+    _EffectDescriptor_CHAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_CHAIN>(_effectDescriptor);
+    Boolean result = false;
+
+    /* a bypassed stage counts as well, because it may be activated
+       during playback */
+    for (const _EffectStage& stage : effectDescriptor.stageList) {
+        result = result || stage.effect->needsTimePosition();
+    }
+
+    return result;
+}
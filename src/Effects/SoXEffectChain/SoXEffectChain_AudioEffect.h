@@ -0,0 +1,370 @@
+/**
+ * @file
+ * The <C>SoXEffectChain_AudioEffect</C> specification defines an
+ * effect chaining several SoX effects and processing them in place
+ * on a single buffer.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXAudioEffect.h"
+
+/*--------------------*/
+
+using SoXPlugins::Effects::SoXAudioEffect;
+
+/*====================*/
+
+namespace SoXPlugins::Effects::SoXEffectChain {
+
+    /**
+     * A <C>SoXEffectChain_AudioEffect</C> object owns a sequence of
+     * SoX effects (the stages) and applies them one after the other
+     * to the same buffer in place.  Hence a chain within a single
+     * plugin converts the host samples at most once on input and
+     * once on output instead of once per effect, and no buffers are
+     * copied between the stages.
+     *
+     * The parameters of the chain are the parameters of all stages
+     * with the one-based stage number as a prefix (like "2: Gain
+     * [dB]"); a page prefix of a stage parameter is kept in front,
+     * such that paged parameters stay paged (like "1#2: Attack").
+     * Additionally each stage has a parameter "<I>n</I>: Bypass"
+     * removing it from processing.  Note that the editor only
+     * supports a single stage with pages.
+     *
+     * Besides serial stages a chain may have parallel sections: a
+     * section splits the signal into branches (each a sequence of
+     * stages) getting the same input and merges them by summing
+     * their outputs, e.g. for a parallel compression with a dry
+     * and a compressed branch.  The branches of a section are
+     * independent, hence they are processed concurrently on the
+     * worker pool when it has threads; the first branch works in
+     * place and the others on copies of the input.  Branches are
+     * not latency compensated against each other.
+     */
+    struct SoXEffectChain_AudioEffect final : public SoXAudioEffect {
+
+        /*---------------------*/
+        /* setup & destruction */
+        /*---------------------*/
+
+        /**
+         * Makes an empty effect chain passing its input unchanged.
+         */
+        SoXEffectChain_AudioEffect ();
+
+        /*--------------------*/
+
+        /**
+         * Destroys effect chain together with its stages.
+         */
+        ~SoXEffectChain_AudioEffect ();
+
+        /*--------------------*/
+
+        /**
+         * Appends <C>effect</C> as the last stage of the chain (or
+         * of the current branch of an open parallel section) and
+         * adds its parameters to the parameter map; the chain takes
+         * ownership of <C>effect</C>.  Stages are numbered in the
+         * order of appending regardless of sections.
+         *
+         * @param[in] effect  effect to be appended
+         */
+        void appendEffect (IN SoXAudioEffect* effect);
+
+        /*--------------------*/
+
+        /**
+         * Opens a parallel section after the stages appended so far
+         * (the split node); the stages appended afterwards form its
+         * first branch until <C>beginBranch</C> starts the next
+         * one.  An empty branch passes its input unchanged (like a
+         * dry send).  Sections are not nested, hence an open
+         * section is closed before.
+         */
+        void beginParallelSection ();
+
+        /*--------------------*/
+
+        /**
+         * Starts the next branch of the open parallel section; does
+         * nothing when no section is open.
+         */
+        void beginBranch ();
+
+        /*--------------------*/
+
+        /**
+         * Closes the open parallel section (the merge node summing
+         * its branches); the stages appended afterwards process
+         * this sum.
+         */
+        void endParallelSection ();
+
+        /*-----------------------*/
+        /* string representation */
+        /*-----------------------*/
+
+        String toString () const override;
+
+        /*--------------------*/
+        /* property queries   */
+        /*--------------------*/
+
+        String name () const override;
+
+        /*--------------------*/
+
+        Real tailLength () const override;
+
+        /*--------------------*/
+
+        Natural latency () const override;
+
+        /*--------------------*/
+
+        Real warmupLength () const override;
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of stages in the chain (including
+         * those in parallel sections).
+         *
+         * @return  count of effects in chain
+         */
+        Natural effectCount () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of parallel sections in the chain.
+         *
+         * @return  count of parallel sections
+         */
+        Natural parallelSectionCount () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the effect at stage <C>index</C> (starting at
+         * zero).
+         *
+         * @param[in] index  index of stage
+         * @return  effect of stage
+         */
+        SoXAudioEffect* effect (IN Natural index) const;
+
+        /*--------------------*/
+        /* sidechain          */
+        /*--------------------*/
+
+        /**
+         * Tells whether some stage evaluates an external sidechain.
+         *
+         * @return  information whether a stage uses a sidechain
+         */
+        Boolean hasSidechainInput () const override;
+
+        /*--------------------*/
+
+        /**
+         * Sets the sidechain for the next processed block of all
+         * stages to <C>sidechain</C>.
+         *
+         * @param[in] sidechain  read-only view onto sidechain
+         *                       channels
+         */
+        void setSidechainInput (IN SoXSidechainView& sidechain) override;
+
+        /*--------------------*/
+        /* mono processing    */
+        /*--------------------*/
+
+        /**
+         * Tells whether all stages not bypassed support the
+         * processing of only the first of identical channels.
+         *
+         * @return  information whether mono processing is supported
+         */
+        Boolean hasMonoProcessing () const override;
+
+        /*--------------------*/
+
+        /**
+         * Copies the state of the first channel to the other
+         * channels up to <C>channelCount</C> in all stages.
+         *
+         * @param[in] channelCount  number of channels to be set
+         */
+        void copyFirstChannelState (IN Natural channelCount) override;
+
+        /*--------------------*/
+
+        /**
+         * Tells whether all stages not bypassed process their
+         * channels independently.
+         *
+         * @return  information whether channels are independent
+         */
+        Boolean hasIndependentChannels () const override;
+
+        /*--------------------*/
+        /* memory footprint   */
+        /*--------------------*/
+
+        /**
+         * Returns the memory footprint of the chain together with
+         * the footprints of all its stages.
+         *
+         * @return  memory footprint of chain and stages
+         */
+        SoXMemoryFootprint memoryFootprint () const override;
+
+        /*--------------------*/
+        /* quality level      */
+        /*--------------------*/
+
+        /**
+         * Returns the maximum number of quality levels of all
+         * stages.
+         *
+         * @return  count of quality levels
+         */
+        Natural qualityLevelCount () const override;
+
+        /*--------------------*/
+
+        /**
+         * Sets the quality level of all stages to <C>level</C>; a
+         * stage with fewer levels uses its lowest quality instead.
+         *
+         * @param[in] level  new quality level
+         */
+        void setQualityLevel (IN Natural level) override;
+
+        /*--------------------*/
+        /* precision profile  */
+        /*--------------------*/
+
+        /**
+         * Sets the precision profile of all stages (also of those
+         * appended later) to <C>profile</C>.
+         *
+         * @param[in] profile  new precision profile
+         */
+        void setPrecisionProfile (IN SoXPrecisionProfile profile) override;
+
+        /*--------------------*/
+        /* DSP state          */
+        /*--------------------*/
+
+        /**
+         * Tells whether all stages can save and restore their
+         * processing state; the state of the chain consists of the
+         * states of its stages.
+         *
+         * @return  information whether DSP state can be transferred
+         */
+        Boolean hasDspStateSupport () const override;
+
+        /*--------------------*/
+        /* parameter change   */
+        /*--------------------*/
+
+        void recalculateSettings () override;
+
+        /*--------------------*/
+
+        void setDefaultValues () override;
+
+        /*--------------------*/
+        /* event handling     */
+        /*--------------------*/
+
+        void prepareToPlay (IN Real sampleRate)
+            override;
+
+        /*--------------------*/
+
+        void releaseResources () override;
+
+        /*--------------------*/
+
+        void processBlock (IN Real timePosition,
+                           INOUT AudioSampleListVector& buffer)
+            override;
+
+        /*--------------------*/
+
+        Boolean hasFloatProcessing () const override;
+
+        /*--------------------*/
+
+        void processFloatBlock (IN Real timePosition,
+                                INOUT float* const* channelArray,
+                                IN Natural channelCount,
+                                IN Natural sampleCount)
+            override;
+
+        /*--------------------*/
+
+        Boolean hasDoubleProcessing () const override;
+
+        /*--------------------*/
+
+        void processDoubleBlock (IN Real timePosition,
+                                 INOUT double* const* channelArray,
+                                 IN Natural channelCount,
+                                 IN Natural sampleCount)
+            override;
+
+        /*--------------------*/
+
+        Boolean needsTimePosition () const override;
+
+        /*--------------------*/
+        /*--------------------*/
+
+        protected:
+
+            String _effectDescriptorToString () const
+                override;
+
+            /*--------------------*/
+
+            void _recalculateChangedSettings () override;
+
+            /*--------------------*/
+
+            SoXParameterValueChangeKind
+            _setValueInternal (IN Natural parameterId,
+                               IN String& parameterName,
+                               IN String& value,
+                               IN Boolean recalculationIsForced)
+                override;
+
+            /*--------------------*/
+
+            void _saveDspState (INOUT DspStateStream& stream) const
+                override;
+
+            /*--------------------*/
+
+            void _restoreDspState (INOUT DspStateStream& stream)
+                override;
+
+    };
+
+}
@@ -0,0 +1,87 @@
+/**
+ * @file
+ * The <C>SoXEffectChain_AudioProcessor</C> module provides
+ * boilerplate code for a plugin chaining several SoX effects.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXAudioProcessor.h"
+#include "SoXCompander_AudioEffect.h"
+#include "SoXEffectChain_AudioEffect.h"
+#include "SoXFilter_AudioEffect.h"
+#include "SoXOverdrive_AudioEffect.h"
+#include "SoXReverb_AudioEffect.h"
+#include "Logging.h"
+
+/*--------------------*/
+
+using SoXPlugins::Effects::SoXCompander::SoXCompander_AudioEffect;
+using SoXPlugins::Effects::SoXFilter::SoXFilter_AudioEffect;
+using SoXPlugins::Effects::SoXOverdrive::SoXOverdrive_AudioEffect;
+using SoXPlugins::Effects::SoXReverb::SoXReverb_AudioEffect;
+using SoXPlugins::ViewAndController::SoXAudioProcessor;
+
+/*====================*/
+
+namespace SoXPlugins::Effects::SoXEffectChain {
+
+    /**
+     * A <C>SoXEffectChain_AudioProcessor</C> is the JUCE wrapper for
+     * a chain of the SoX <B>filter</B>, <B>compand</B>,
+     * <B>overdrive</B> and <B>reverb</B> effects processed in place
+     * within a single plugin
+     */
+    struct SoXEffectChain_AudioProcessor  : public SoXAudioProcessor {
+
+        SoXEffectChain_AudioProcessor ()
+        {
+            Logging_initializeWithDefaults("SoXEffectChain",
+                                           "SoXPlugins.");
+            _setAssociatedEffect(_makeEffect());
+        }
+
+        /*--------------------*/
+
+        String name () const override
+        {
+            return String("SoXEffectChain");
+        }
+
+        /*--------------------*/
+
+        protected:
+
+            SoXAudioEffect* _makeEffect () const override
+            {
+                SoXEffectChain_AudioEffect* effect =
+                    new SoXEffectChain_AudioEffect{};
+                effect->appendEffect(new SoXFilter_AudioEffect{});
+                effect->appendEffect(new SoXCompander_AudioEffect{});
+                effect->appendEffect(new SoXOverdrive_AudioEffect{});
+                effect->appendEffect(new SoXReverb_AudioEffect{});
+                return effect;
+            }
+
+    };
+
+}
+
+/*--------------------*/
+
+/**
+ * Provides a callback for JUCE to create a SoXEffectChain audio
+ * processor.
+ *
+ * @return JUCE audio processor
+ */
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter ()
+{
+    return new SoXPlugins::Effects::SoXEffectChain
+                   ::SoXEffectChain_AudioProcessor();
+}
@@ -0,0 +1,11 @@
+/**
+ * @file
+ * The <C>SoXPlugin-AU_2</C> connects to the JUCE framework client
+ * functions for an AudioUnit in OSX.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2021-01
+ */
+
+#include "JucePluginDefines.h"
+#include <juce_audio_plugin_client/juce_audio_plugin_client_AU_2.mm>
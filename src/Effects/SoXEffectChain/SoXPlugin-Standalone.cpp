@@ -0,0 +1,11 @@
+/**
+ * @file
+ * The <C>SoXPlugin-Standalone</C> connects to the JUCE framework client
+ * functions for standalone applications (e.g. apps on OSX).
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2021-01
+ */
+
+#include "JucePluginDefines.h"
+#include <juce_audio_plugin_client/juce_audio_plugin_client_Standalone.cpp>
@@ -0,0 +1,11 @@
+/**
+ * @file
+ * The <C>SoXPlugin-VST_1</C> connects to the JUCE framework client
+ * functions for a VST3 plugin.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2021-01
+ */
+
+#include "JucePluginDefines.h"
+#include <juce_audio_plugin_client/juce_audio_plugin_client_VST3.mm>
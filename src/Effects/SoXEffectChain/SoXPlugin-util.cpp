@@ -0,0 +1,11 @@
+/**
+ * @file
+ * The <C>SoXPlugin-util</C> connects to the JUCE framework utilities
+ * for a plugin.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2021-01
+ */
+
+#include "JucePluginDefines.h"
+#include <juce_audio_plugin_client/detail/juce_PluginUtilities.h>
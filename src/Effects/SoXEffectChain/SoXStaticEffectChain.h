@@ -0,0 +1,255 @@
+/**
+ * @file
+ * The <C>SoXStaticEffectChain</C> specification and body defines a
+ * chain of SoX effects whose stages are fixed at compile time and
+ * processed without virtual dispatch.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include <tuple>
+#include "AudioSampleListVector.h"
+#include "AudioSampleListView.h"
+#include "SoXAudioEffect.h"
+
+/*--------------------*/
+
+using Audio::AudioSample;
+using Audio::AudioSampleListVector;
+using Audio::AudioSampleListView;
+using SoXPlugins::Effects::SoXAudioEffect;
+
+/*====================*/
+
+namespace SoXPlugins::Effects::SoXEffectChain {
+
+    /**
+     * A <C>SoXStaticEffectChain</C> object owns one effect of each
+     * type in <C>EffectTypes</C> (the stages) and applies them in
+     * that order to the same buffer in place, like a
+     * <C>SoXEffectChain_AudioEffect</C>.  Because the stages are
+     * known at compile time, every stage is called via its concrete
+     * (final) type: the calls are resolved statically and may be
+     * inlined into the processing of the chain, and there is no
+     * per-block walk over a stage list with bypass and fusion
+     * checks.  This pays off for long chains with small blocks.
+     *
+     * The chain is meant for chains configured at build time (like
+     * in a renderer or a benchmark); it has no parameter map of its
+     * own, no bypass, no parallel sections and no stage fusion, the
+     * stages are configured directly via <C>effect</C>.  The plugin
+     * wrappers and the chains configured at runtime keep using the
+     * virtual interface of <C>SoXAudioEffect</C>.
+     *
+     * @tparam EffectTypes  the concrete effect types of the stages
+     *                      in processing order
+     */
+    template<typename... EffectTypes>
+    struct SoXStaticEffectChain {
+
+        /** the number of stages */
+        static constexpr size_t stageCount = sizeof...(EffectTypes);
+
+        /*--------------------*/
+        /* con-/destruction   */
+        /*--------------------*/
+
+        /**
+         * Makes a chain with a new effect for each stage.
+         */
+        SoXStaticEffectChain () = default;
+
+        /*--------------------*/
+
+        SoXStaticEffectChain (IN SoXStaticEffectChain&) = delete;
+
+        /*--------------------*/
+        /* stage access       */
+        /*--------------------*/
+
+        /**
+         * Returns the effect of the stage with <C>stageIndex</C>
+         * with its concrete type.
+         *
+         * @tparam  stageIndex  zero-based index of stage
+         * @return  effect of stage
+         */
+        template<size_t stageIndex>
+        auto& effect ()
+        {
+            return std::get<stageIndex>(_stageTuple);
+        }
+
+        /*--------------------*/
+
+        /**
+         * Applies <C>stageProc</C> to the effects of all stages in
+         * processing order (e.g. for a common setting like the
+         * precision profile).
+         *
+         * @tparam    StageProc  type of stage function
+         * @param[in] stageProc  function taking a
+         *                       <C>SoXAudioEffect&</C>
+         */
+        template<typename StageProc>
+        void forEachStage (IN StageProc& stageProc)
+        {
+            std::apply([&] (EffectTypes&... stage) {
+                           (stageProc((SoXAudioEffect&) stage), ...);
+                       },
+                       _stageTuple);
+        }
+
+        /*--------------------*/
+        /* configuration      */
+        /*--------------------*/
+
+        /**
+         * Sets the parameters of all stages to their defaults and
+         * applies them to the stages (like a host instantiating a
+         * plugin).
+         */
+        void setDefaultValues ()
+        {
+            forEachStage([] (SoXAudioEffect& effect) {
+                /* the defaults only reach the parameter map of a
+                   stage, hence they are applied as a whole */
+                effect.setDefaultValues();
+                effect.setParameterValidity(true);
+                SoXEffectParameterMap& parameterMap =
+                    effect.effectParameterMap();
+                effect.beginParameterBatch();
+
+                for (const String& parameterName
+                         : parameterMap.parameterNameList()) {
+                    const String value = parameterMap.value(parameterName);
+                    parameterMap.invalidateValue(parameterName);
+                    effect.setValue(parameterName, value, true);
+                }
+
+                effect.commitParameterBatch();
+            });
+        }
+
+        /*--------------------*/
+        /* event handling     */
+        /*--------------------*/
+
+        /**
+         * Prepares all stages for playback with <C>sampleRate</C>.
+         *
+         * @param[in] sampleRate  sample rate of processing
+         */
+        void prepareToPlay (IN Real sampleRate)
+        {
+            std::apply([&] (EffectTypes&... stage) {
+                           (stage.EffectTypes::prepareToPlay(sampleRate),
+                            ...);
+                       },
+                       _stageTuple);
+        }
+
+        /*--------------------*/
+
+        /**
+         * Releases the resources of all stages after playback.
+         */
+        void releaseResources ()
+        {
+            std::apply([] (EffectTypes&... stage) {
+                           (stage.EffectTypes::releaseResources(), ...);
+                       },
+                       _stageTuple);
+        }
+
+        /*--------------------*/
+
+        /**
+         * Processes <C>buffer</C> at <C>timePosition</C> by all
+         * stages in order.
+         *
+         * @param[in]    timePosition  time position of block
+         * @param[inout] buffer        audio samples processed in
+         *                             place
+         */
+        void process (IN Real timePosition,
+                      INOUT AudioSampleListVector& buffer)
+        {
+            std::apply([&] (EffectTypes&... stage) {
+                           (stage.EffectTypes::processBlock(timePosition,
+                                                            buffer),
+                            ...);
+                       },
+                       _stageTuple);
+        }
+
+        /*--------------------*/
+
+        /**
+         * Processes the channels viewed by <C>span</C> at
+         * <C>timePosition</C> by all stages in order: when the view
+         * has contiguous channels and all stages process doubles
+         * directly, they work on the channels in place, otherwise
+         * the samples are copied once into a sample buffer for all
+         * stages.
+         *
+         * @param[in]    timePosition  time position of block
+         * @param[inout] span          view on audio samples
+         *                             processed in place
+         */
+        void process (IN Real timePosition,
+                      INOUT AudioSampleListView& span)
+        {
+            AudioSample* const* channelArray = span.channelArray();
+            const Boolean hasDoubleProcessing =
+                std::apply([] (EffectTypes&... stage) {
+                               return (Boolean{true} && ...
+                                       && stage.EffectTypes
+                                              ::hasDoubleProcessing());
+                           },
+                           _stageTuple);
+
+            if (channelArray != nullptr && hasDoubleProcessing) {
+                /* audio samples have the layout of doubles */
+                double* const* doubleArray =
+                    (double* const*) channelArray;
+                const Natural channelCount = span.channelCount();
+                const Natural frameCount = span.frameCount();
+
+                std::apply([&] (EffectTypes&... stage) {
+                               (stage.EffectTypes
+                                    ::processDoubleBlock(timePosition,
+                                                         doubleArray,
+                                                         channelCount,
+                                                         frameCount),
+                                ...);
+                           },
+                           _stageTuple);
+            } else {
+                AudioSampleListVector sampleBuffer{};
+                span.copyTo(sampleBuffer);
+                process(timePosition, sampleBuffer);
+                span.copyFrom(sampleBuffer);
+            }
+        }
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the effects of the stages in processing order */
+            std::tuple<EffectTypes...> _stageTuple;
+
+    };
+
+}
@@ -0,0 +1,202 @@
+/**
+ * @file
+ * The <C>SoXFilterSupport</C> body implements a process-wide cache
+ * for biquad filter coefficients shared by all filter effect
+ * instances as a single <B>_SoXFilterCoefficientCache</B> class.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-01
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXFilterSupport.h"
+
+#include <mutex>
+
+#include "GenericMap.h"
+#include "Logging.h"
+#include "SoXRealtimeGuard.h"
+
+/*--------------------*/
+
+using BaseTypes::GenericTypes::GenericMap;
+using BaseTypes::Primitives::Integer;
+using SoXPlugins::Effects::SoXFilter::_FilterCoefficientKey;
+using SoXPlugins::Effects::SoXFilter::_FilterCoefficientSet;
+using SoXPlugins::Effects::SoXFilter::_SoXFilterCoefficientCache;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
+
+/*============================================================*/
+
+namespace SoXPlugins::Effects::SoXFilter {
+
+    /** the map from filter settings to coefficients */
+    using _FilterCoefficientMap =
+        GenericMap<_FilterCoefficientKey, _FilterCoefficientSet>;
+
+    /*--------------------*/
+
+    /** the shared coefficient map */
+    static _FilterCoefficientMap _coefficientMap;
+
+    /** the lock protecting map and counters */
+    static std::mutex _coefficientMapMutex;
+
+    /** the number of successful lookups */
+    static Natural _hitCount{0};
+
+    /** the number of failed lookups */
+    static Natural _missCount{0};
+
+    /*--------------------*/
+
+    /**
+     * Returns a natural number encoding the flags of
+     * <C>key</C>.
+     *
+     * @param[in] key  filter coefficient key
+     * @return  bit set of the boolean settings
+     */
+    static Natural _flagSet (IN _FilterCoefficientKey& key)
+    {
+        Natural result = 0;
+        result += (key.usesUnpitchedAudioMode ? 1 : 0);
+        result += (key.usesConstantSkirtGain ? 2 : 0);
+        result += (key.isSinglePole ? 4 : 0);
+        return result;
+    }
+
+}
+
+/*============================================================*/
+
+/*--------------------*/
+/* coefficient key    */
+/*--------------------*/
+
+String _FilterCoefficientKey::toString () const
+{
+    return STR::expand("_FilterCoefficientKey(kind = %1,"
+                       " frequency = %2Hz, bandwidth = %3,"
+                       " bandwidthUnit = %4, dBGain = %5dB,"
+                       " equGain = %6dB, flags = %7,"
+                       " sampleRate = %8)",
+                       kind, TOSTRING(frequency), TOSTRING(bandwidth),
+                       TOSTRING(Integer{(int) bandwidthUnit}),
+                       TOSTRING(dBGain), TOSTRING(equGain),
+                       TOSTRING(_flagSet(*this)), TOSTRING(sampleRate));
+}
+
+/*--------------------*/
+
+Boolean
+_FilterCoefficientKey::operator < (IN _FilterCoefficientKey& other) const
+{
+    Boolean result;
+
+    if (kind != other.kind) {
+        result = (kind < other.kind);
+    } else if (frequency != other.frequency) {
+        result = (frequency < other.frequency);
+    } else if (bandwidth != other.bandwidth) {
+        result = (bandwidth < other.bandwidth);
+    } else if (bandwidthUnit != other.bandwidthUnit) {
+        result = (bandwidthUnit < other.bandwidthUnit);
+    } else if (dBGain != other.dBGain) {
+        result = (dBGain < other.dBGain);
+    } else if (equGain != other.equGain) {
+        result = (equGain < other.equGain);
+    } else if (_flagSet(*this) != _flagSet(other)) {
+        result = (_flagSet(*this) < _flagSet(other));
+    } else {
+        result = (sampleRate < other.sampleRate);
+    }
+
+    return result;
+}
+
+/*--------------------*/
+/* coefficient cache  */
+/*--------------------*/
+
+const Natural _SoXFilterCoefficientCache::maximumSize = 1024;
+
+/*--------------------*/
+
+Boolean
+_SoXFilterCoefficientCache::lookup
+                                (IN _FilterCoefficientKey& key,
+                                 OUT _FilterCoefficientSet& coefficientSet)
+{
+    SoXRealtimeGuard_noteLock("_SoXFilterCoefficientCache.lookup");
+    std::lock_guard<std::mutex> lock{_coefficientMapMutex};
+    const Boolean isFound = _coefficientMap.contains(key);
+
+    if (!isFound) {
+        _missCount++;
+    } else {
+        _hitCount++;
+        coefficientSet = _coefficientMap.at(key);
+    }
+
+    Logging_trace2("--: key = %1, isFound = %2",
+                   key.toString(), TOSTRING(isFound));
+    return isFound;
+}
+
+/*--------------------*/
+
+void
+_SoXFilterCoefficientCache::store
+                                (IN _FilterCoefficientKey& key,
+                                 IN _FilterCoefficientSet& coefficientSet)
+{
+    SoXRealtimeGuard_noteLock("_SoXFilterCoefficientCache.store");
+    std::lock_guard<std::mutex> lock{_coefficientMapMutex};
+
+    if (Natural{_coefficientMap.size()} >= maximumSize) {
+        /* keep memory bounded: start afresh */
+        _coefficientMap.clear();
+    }
+
+    _coefficientMap.set(key, coefficientSet);
+}
+
+/*--------------------*/
+
+void _SoXFilterCoefficientCache::clear ()
+{
+    std::lock_guard<std::mutex> lock{_coefficientMapMutex};
+    _coefficientMap.clear();
+    _hitCount  = 0;
+    _missCount = 0;
+}
+
+/*--------------------*/
+
+Natural _SoXFilterCoefficientCache::size ()
+{
+    std::lock_guard<std::mutex> lock{_coefficientMapMutex};
+    return Natural{_coefficientMap.size()};
+}
+
+/*--------------------*/
+
+Natural _SoXFilterCoefficientCache::hitCount ()
+{
+    std::lock_guard<std::mutex> lock{_coefficientMapMutex};
+    return _hitCount;
+}
+
+/*--------------------*/
+
+Natural _SoXFilterCoefficientCache::missCount ()
+{
+    std::lock_guard<std::mutex> lock{_coefficientMapMutex};
+    return _missCount;
+}
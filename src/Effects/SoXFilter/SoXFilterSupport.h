@@ -0,0 +1,222 @@
+/**
+ * @file
+ * The <C>SoXFilterSupport</C> specification defines a process-wide
+ * cache for biquad filter coefficients shared by all filter effect
+ * instances as a single <B>_SoXFilterCoefficientCache</B> class and
+ * the parameter sets of biquad and state variable filters.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-01
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "BiquadFilter.h"
+#include "FilterBandwidthUnit.h"
+#include "MyString.h"
+#include "Natural.h"
+#include "Real.h"
+
+/*--------------------*/
+
+using Audio::BiquadFilterShape;
+using Audio::FilterBandwidthUnit;
+using BaseTypes::Primitives::Boolean;
+using BaseTypes::Primitives::Natural;
+using BaseTypes::Primitives::Real;
+using BaseTypes::Primitives::String;
+
+/*====================*/
+
+namespace SoXPlugins::Effects::SoXFilter {
+
+    /**
+     * A <C>_FilterCoefficientKey</C> object collects all settings
+     * of a filter effect that influence its biquad coefficients.
+     */
+    struct _FilterCoefficientKey {
+
+        /** the filter kind (as a string) */
+        String kind;
+
+        /** the characteristic frequency of the filter */
+        Real frequency;
+
+        /** the nominal value of the bandwidth of the filter */
+        Real bandwidth;
+
+        /** the unit of the bandwidth of the filter */
+        FilterBandwidthUnit bandwidthUnit;
+
+        /** the filter gain */
+        Real dBGain;
+
+        /** the gain for an equalizer */
+        Real equGain;
+
+        /** tells whether filter uses mode for unpitched audio */
+        Boolean usesUnpitchedAudioMode;
+
+        /** tells whether filter uses constant skirt gain */
+        Boolean usesConstantSkirtGain;
+
+        /** tells whether filter is a 1-pole filter */
+        Boolean isSinglePole;
+
+        /** the sample rate of the effect */
+        Real sampleRate;
+
+        /*--------------------*/
+
+        /**
+         * Returns string representation of key
+         *
+         * @return string representation
+         */
+        String toString () const;
+
+        /*--------------------*/
+
+        /**
+         * Tells whether key is lexicographically less than
+         * <C>other</C>.
+         *
+         * @param[in] other  key to be compared with
+         * @return  information whether current key is less than other
+         */
+        Boolean operator < (IN _FilterCoefficientKey& other) const;
+
+    };
+
+    /*--------------------*/
+
+    /**
+     * A <C>_FilterCoefficientSet</C> object holds the coefficients
+     * of a biquad filter together with their shape known from the
+     * filter kind.
+     */
+    struct _FilterCoefficientSet {
+
+        Real b0; /**< IIR filter coefficient b0 */
+        Real b1; /**< IIR filter coefficient b1 */
+        Real b2; /**< IIR filter coefficient b2 */
+        Real a0; /**< IIR filter coefficient a0 */
+        Real a1; /**< IIR filter coefficient a1 */
+        Real a2; /**< IIR filter coefficient a2 */
+
+        /** the shape of the coefficients selecting the kernel */
+        BiquadFilterShape shape;
+
+    };
+
+    /*--------------------*/
+
+    /**
+     * A <C>_SVFParameterSet</C> object holds the settings of a state
+     * variable filter: the cutoff is given as frequency relative to
+     * the sample rate and a factor for the prewarped cutoff (for
+     * shelving filters), hence it can be interpolated and tuned
+     * without trigonometric functions.
+     */
+    struct _SVFParameterSet {
+
+        /** tells whether the filter is realized as a state variable
+         * filter at all */
+        Boolean isActive;
+
+        /** the cutoff frequency divided by the sample rate */
+        Real relativeFrequency;
+
+        /** the factor for the prewarped cutoff */
+        Real frequencyFactor;
+
+        /** the damping (inverse quality) */
+        Real damping;
+
+        Real m0; /**< factor of the input in the output */
+        Real m1; /**< factor of the bandpass in the output */
+        Real m2; /**< factor of the lowpass in the output */
+
+    };
+
+    /*--------------------*/
+
+    /**
+     * The <C>_SoXFilterCoefficientCache</C> is a process-wide and
+     * thread-safe memoization of filter coefficients keyed by the
+     * filter settings and the sample rate; it holds at most
+     * <C>maximumSize</C> entries and is emptied when it overflows.
+     */
+    struct _SoXFilterCoefficientCache {
+
+        /** the maximum number of entries in the cache */
+        static const Natural maximumSize;
+
+        /*--------------------*/
+
+        /**
+         * Looks up coefficients for <C>key</C> and returns them in
+         * <C>coefficientSet</C> when found.
+         *
+         * @param[in]  key             settings of filter
+         * @param[out] coefficientSet  associated coefficients (when
+         *                             found)
+         * @return  information whether key has been found
+         */
+        static Boolean lookup (IN _FilterCoefficientKey& key,
+                               OUT _FilterCoefficientSet& coefficientSet);
+
+        /*--------------------*/
+
+        /**
+         * Stores <C>coefficientSet</C> for <C>key</C>.
+         *
+         * @param[in] key             settings of filter
+         * @param[in] coefficientSet  associated coefficients
+         */
+        static void store (IN _FilterCoefficientKey& key,
+                           IN _FilterCoefficientSet& coefficientSet);
+
+        /*--------------------*/
+
+        /**
+         * Removes all entries from cache and resets the counters.
+         */
+        static void clear ();
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of entries in cache.
+         *
+         * @return  number of cached coefficient sets
+         */
+        static Natural size ();
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of successful lookups.
+         *
+         * @return  count of cache hits
+         */
+        static Natural hitCount ();
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of failed lookups.
+         *
+         * @return  count of cache misses
+         */
+        static Natural missCount ();
+
+    };
+
+}
@@ -18,25 +18,44 @@
 
 #include <cmath>
 
-#include "AudioSampleRingBufferVector.h"
 #include "Dictionary.h"
 #include "FilterBandwidthUnit.h"
-#include "IIRFilter.h"
+#include "BiquadFilter.h"
 #include "Logging.h"
 #include "SoXAudioHelper.h"
+#include "SoXFilterSupport.h"
+#include "SoXFrequencyResponseCache.h"
+#include "SoXParameterSmoother.h"
+#include "SoXSnapshotExchange.h"
+#include "StateVariableFilter.h"
 
 /*--------------------*/
 
-using Audio::AudioSampleRingBufferVector;
 using Audio::FilterBandwidthUnit;
-using Audio::IIRFilter;
+using Audio::BiquadFilter;
+using Audio::BiquadFilterState;
+using Audio::StateVariableFilter;
+using Audio::StateVariableFilterState;
 using BaseTypes::Containers::Dictionary;
 using SoXPlugins::Effects::SoXFilter::SoXFilter_AudioEffect;
+using SoXPlugins::Effects::SoXFilter::_FilterCoefficientKey;
+using SoXPlugins::Effects::SoXFilter::_FilterCoefficientSet;
+using SoXPlugins::Effects::SoXFilter::_SVFParameterSet;
+using SoXPlugins::Effects::SoXFilter::_SoXFilterCoefficientCache;
 using SoXPlugins::Helpers::SoXAudioHelper;
+using SoXPlugins::Helpers::SoXFilterCoefficientRamp;
+using SoXPlugins::Helpers::SoXFrequencyResponseCache;
+using SoXPlugins::Helpers::SoXRamp_sampleCount;
+using SoXPlugins::Helpers::SoXSnapshotExchange;
 
 /** abbreviation for StringUtil */
 using STR = BaseModules::StringUtil;
 
+/*====================*/
+
+/** maximum number of filter sections in a filter effect */
+#define _maxSectionCount  (8)
+
 /*============================================================*/
 
 namespace SoXPlugins::Effects::SoXFilter {
@@ -50,10 +69,26 @@ namespace SoXPlugins::Effects::SoXFilter {
 
     /*--------------------*/
 
+    /** a list of biquad filter states (one per channel) */
+    using _BiquadFilterStateList = GenericList<BiquadFilterState>;
+
+    /** a list of state variable filter states (one per channel) */
+    using _SVFStateList = GenericList<StateVariableFilterState>;
+
+    struct _EffectDescriptor_FLTR;
+
+    /** a list of the filter sections following the first one */
+    using _FilterSectionList = GenericList<_EffectDescriptor_FLTR*>;
+
+    /*--------------------*/
+
     /**
      * An <C>_EffectDescriptor_FLTR</C> object is the internal
      * implementation of a biquad filter effect descriptor type where
      * all sample input is routed to and sample output is routed from.
+     * It describes a single filter section; the descriptor of the
+     * effect is the first section and owns the descriptors of the
+     * further sections applied in series.
      */
     struct _EffectDescriptor_FLTR {
 
@@ -67,11 +102,51 @@ namespace SoXPlugins::Effects::SoXFilter {
         Real a1; /**< IIR filter coefficient a1 */
         Real a2; /**< IIR filter coefficient a2 */
 
-        /** a vector of sample ring buffers for the IIR filter */
-        AudioSampleRingBufferVector sampleRingBufferVector;
+        /** the filter history for each channel */
+        _BiquadFilterStateList filterStateList;
+
+        /** the underlying biquad filter */
+        BiquadFilter filter;
+
+        /** the ramp of the filter coefficients towards b0 to a2 */
+        SoXFilterCoefficientRamp coefficientRamp;
+
+        /** the shape of the coefficients at the end of the ramp
+         * (only changed by the processing) */
+        BiquadFilterShape filterShape;
+
+        /** the block kernel for audio samples selected for the
+         * current coefficient shape */
+        BiquadFilter::BlockKernel blockKernel;
+
+        /** the block kernel for float samples selected for the
+         * current coefficient shape */
+        BiquadFilter::FloatBlockKernel floatBlockKernel;
+
+        /** the handoff of recalculated coefficients to the
+         * processing */
+        SoXSnapshotExchange<_FilterCoefficientSet> coefficientExchange;
+
+        /** the integrator states of the state variable filter for
+         * each channel */
+        _SVFStateList svfStateList;
+
+        /** the state variable filter used instead of the biquad
+         * filter (when active) */
+        StateVariableFilter svFilter;
 
-        /** the underlying IIR filter */
-        IIRFilter filter;
+        /** the ramp of the state variable filter parameters; its six
+         * slots hold relative frequency, frequency factor, damping
+         * and the three mix factors */
+        SoXFilterCoefficientRamp svfParameterRamp;
+
+        /** the handoff of recalculated state variable filter
+         * parameters to the processing */
+        SoXSnapshotExchange<_SVFParameterSet> svfParameterExchange;
+
+        /** tells whether the processing currently uses the state
+         * variable filter (only changed by the processing) */
+        Boolean isStateVariable;
 
         /** the characteristic frequency of the filter */
         Real frequency;
@@ -99,6 +174,35 @@ namespace SoXPlugins::Effects::SoXFilter {
         /** tells whether filter is a 1-pole filter */
         Boolean isSinglePole;
 
+        /** tells whether the filter shall be realized as a state
+         * variable filter (when the kind allows it) */
+        Boolean usesStateVariableStructure;
+
+        /** the filter coefficients for the display of the frequency
+         * response */
+        SoXFrequencyResponseCache responseCache;
+
+        /** for the next block only: the descriptor of a following
+         * filter applied in the same pass (if any) */
+        _EffectDescriptor_FLTR* cascadedDescriptor;
+
+        /** for the next block only: the product of the constant
+         * gains following the filter folded into its numerator */
+        Real absorbedGain;
+
+        /** the number of filter sections applied in series (only
+         * used in the first section) */
+        Natural sectionCount;
+
+        /** the number of filter sections applied in the last block
+         * (only used in the first section and only changed by the
+         * processing) */
+        Natural processedSectionCount;
+
+        /** the descriptors of the sections following the first one
+         * (only owned by the first section) */
+        _FilterSectionList sectionList;
+
         /*--------------------*/
         /*--------------------*/
 
@@ -122,15 +226,24 @@ namespace SoXPlugins::Effects::SoXFilter {
                             TOSTRING(usesUnpitchedAudioMode),
                             TOSTRING(usesConstantSkirtGain),
                             TOSTRING(isSinglePole));
+            st1 += STR::expand(", usesStateVariableStructure = %1,"
+                               " isStateVariable = %2, svFilter = %3,"
+                               " sectionCount = %4",
+                               TOSTRING(usesStateVariableStructure),
+                               TOSTRING(isStateVariable),
+                               svFilter.toString(),
+                               TOSTRING(sectionCount));
 
             String st2 =
                 STR::expand("b0 = %1, b1 = %2, b2 = %3,"
                             " a0 = %4, a1 = %5, a2 = %6,"
-                            " filter = %7, sampleRingBufferVector = %8",
+                            " filter = %7, coefficientRamp = %8,"
+                            " filterStateList = %9",
                             TOSTRING(b0), TOSTRING(b1), TOSTRING(b2),
                             TOSTRING(a0), TOSTRING(a1), TOSTRING(a2),
                             filter.toString(),
-                            sampleRingBufferVector.toString());
+                            coefficientRamp.toString(),
+                            filterStateList.toString());
 
             return STR::expand("_EffectDescriptor_FLTR(%1, %2)", st1, st2);
         }
@@ -141,8 +254,14 @@ namespace SoXPlugins::Effects::SoXFilter {
     /* internal features  */
     /*--------------------*/
 
-    /** the filter order of a biquad filter */
-    static const Natural _biquadFilterOrder = 3;
+    /** the duration of a coefficient ramp (in seconds) */
+    static const Real _coefficientRampDuration = 0.02;
+
+    /** the number of samples processed with the same coefficients
+     * during a ramp */
+    static const Natural _coefficientRampSubBlockLength = 32;
+
+    /*--------------------*/
 
     /** the parameter names of a biquad filter */
     static const StringList _biquadFilterParameterNameList =
@@ -231,6 +350,40 @@ namespace SoXPlugins::Effects::SoXFilter {
     /** the parameter name of the unpitchedMode parameter */
     static const String parameterName_unpitchedMode = "Unpitched Mode?";
 
+    /** the parameter name of the filter structure parameter */
+    static const String parameterName_structure     = "Filter Structure";
+
+    /** the parameter name of the section count parameter */
+    static const String parameterName_sectionCount  = "Section Count";
+
+    /** the parameter name of the section index parameter */
+    static const String parameterName_sectionIndex  = "Section Index";
+
+    /** the list of filter structures: a biquad in direct form or a
+     * state variable filter */
+    static const StringList _structureList =
+        StringList::fromList({"Direct Form", "State Variable"});
+
+    /** the identifications of the parameters in the parameter map:
+     * first the parameters of the first section (in order of
+     * definition, the biquad coefficients come last), then the
+     * section count and index; the parameters of the further
+     * sections follow section by section in the order of the first
+     * section */
+    enum _ParameterId {
+        parameterId_kind, parameterId_frequency, parameterId_bandwidth,
+        parameterId_bandwidthUnit, parameterId_dBGain,
+        parameterId_cstSkirtGain, parameterId_equGain,
+        parameterId_poleCount, parameterId_unpitchedMode,
+        parameterId_structure, parameterId_a0, parameterId_a1, parameterId_a2,
+        parameterId_b0, parameterId_b1, parameterId_b2,
+        parameterId_sectionCount, parameterId_sectionIndex,
+        parameterId_firstSectionParameter
+    };
+
+    /** the number of parameters of a filter section */
+    static const Natural _sectionParameterCount{parameterId_sectionCount};
+
     /*....................*/
     /* BANDWIDTH UNITS    */
     /*....................*/
@@ -283,6 +436,9 @@ namespace SoXPlugins::Effects::SoXFilter {
     /** the character flag for the poleCount parameter set in a dialog */
     static const String paramFlag_poleCount     = "P";
 
+    /** the character flag for the structure parameter set in a dialog */
+    static const String paramFlag_structure     = "S";
+
     /** the character flag for the unpitchedMode parameter set in a dialog */
     static const String paramFlag_unpitchedMode = "U";
 
@@ -294,16 +450,16 @@ namespace SoXPlugins::Effects::SoXFilter {
     static const Dictionary _filterKindToWidgetDataMap =
         Dictionary::makeFromList(
             StringList::makeBySplit(
-                filterKind_allpass    + comma + "F/B"   + comma +
-                filterKind_band       + comma + "U/F/B" + comma +
-                filterKind_bandpass   + comma + "C/F/B" + comma +
-                filterKind_bandreject + comma + "F/B"   + comma +
-                filterKind_bass       + comma + "D/F/B" + comma +
-                filterKind_biquad     + comma + "Q"     + comma +
-                filterKind_equalizer  + comma + "F/B/E" + comma +
-                filterKind_highpass   + comma + "P/F/B" + comma +
-                filterKind_lowpass    + comma + "P/F/B" + comma +
-                filterKind_treble     + comma + "D/F/B",
+                filterKind_allpass    + comma + "F/B/S"   + comma +
+                filterKind_band       + comma + "U/F/B"   + comma +
+                filterKind_bandpass   + comma + "C/F/B/S" + comma +
+                filterKind_bandreject + comma + "F/B/S"   + comma +
+                filterKind_bass       + comma + "D/F/B/S" + comma +
+                filterKind_biquad     + comma + "Q"       + comma +
+                filterKind_equalizer  + comma + "F/B/E/S" + comma +
+                filterKind_highpass   + comma + "P/F/B/S" + comma +
+                filterKind_lowpass    + comma + "P/F/B/S" + comma +
+                filterKind_treble     + comma + "D/F/B/S",
                 comma)
             );
 
@@ -460,11 +616,12 @@ namespace SoXPlugins::Effects::SoXFilter {
     /*--------------------*/
 
     /**
-     * Sets up a new filter effect descriptor and returns it.
+     * Sets up a new descriptor for a single filter section and
+     * returns it.
      *
-     * @return new filter effect descriptor
+     * @return new filter section descriptor
      */
-    static _EffectDescriptor_FLTR* _createEffectDescriptor ()
+    static _EffectDescriptor_FLTR* _createSectionDescriptor ()
     {
         Logging_trace(">>");
 
@@ -472,8 +629,18 @@ namespace SoXPlugins::Effects::SoXFilter {
             new _EffectDescriptor_FLTR{
                 filterKind_biquad,              /* kind */
                 0.0, 0.0, 0.0, 0.0, 0.0, 0.0,   /* coefficients */
-                {2, true, _biquadFilterOrder},  /* sampleRingBufferVector */
-                {_biquadFilterOrder},           /* filter */
+                {2},                            /* filterStateList */
+                {},                             /* filter */
+                {},                             /* coefficientRamp */
+                BiquadFilterShape::general,     /* filterShape */
+                BiquadFilter::blockKernel(BiquadFilterShape::general),
+                BiquadFilter::floatBlockKernel(BiquadFilterShape::general),
+                {},                             /* coefficientExchange */
+                {2},                            /* svfStateList */
+                {},                             /* svFilter */
+                {},                             /* svfParameterRamp */
+                {},                             /* svfParameterExchange */
+                false,                          /* isStateVariable */
                 1000.0,                         /* frequency */
                 1.5,                            /* bandwidth */
                 FilterBandwidthUnit::slope,     /* bandwidthUnit */
@@ -482,6 +649,13 @@ namespace SoXPlugins::Effects::SoXFilter {
                 false,                          /* usesUnpitchedAudioMode */
                 false,                          /* usesConstantSkirtGain */
                 true,                           /* isSinglePole */
+                false,                          /* usesStateVariableStructure */
+                {},                             /* responseCache */
+                nullptr,                        /* cascadedDescriptor */
+                1.0,                            /* absorbedGain */
+                1,                              /* sectionCount */
+                1,                              /* processedSectionCount */
+                {}                              /* sectionList */
             };
 
         Logging_trace1("<<: %1", result->toString());
@@ -491,18 +665,193 @@ namespace SoXPlugins::Effects::SoXFilter {
     /*--------------------*/
 
     /**
-     * Sets up bandwidth unit parameter in <C>parameterMap</C> for
-     * filter kind given as <C>filterKind</C>.
+     * Sets up a new filter effect descriptor with all further
+     * filter sections and returns it; the further sections are
+     * neutral equalizers matching their default parameter values.
+     *
+     * @return new filter effect descriptor
+     */
+    static _EffectDescriptor_FLTR* _createEffectDescriptor ()
+    {
+        Logging_trace(">>");
+
+        _EffectDescriptor_FLTR* result = _createSectionDescriptor();
+
+        for (Natural sectionIndex = 1;  sectionIndex < _maxSectionCount;
+             sectionIndex++) {
+            _EffectDescriptor_FLTR* section = _createSectionDescriptor();
+            section->kind          = filterKind_equalizer;
+            section->bandwidth     = 1.0;
+            section->bandwidthUnit = FilterBandwidthUnit::quality;
+            result->sectionList.append(section);
+        }
+
+        Logging_trace1("<<: %1", result->toString());
+        return result;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the filter section with <C>sectionIndex</C> (starting
+     * at zero) of the filter effect with <C>effectDescriptor</C>.
+     *
+     * @param[in] effectDescriptor  effect descriptor of filter
+     * @param[in] sectionIndex      index of filter section
+     * @return  descriptor of filter section
+     */
+    static _EffectDescriptor_FLTR&
+    _section (INOUT _EffectDescriptor_FLTR& effectDescriptor,
+              IN Natural sectionIndex)
+    {
+        return (sectionIndex == 0
+                ? effectDescriptor
+                : *effectDescriptor.sectionList[sectionIndex - 1]);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the name of the parameter <C>parameterName</C> of the
+     * filter section with <C>sectionIndex</C> (starting at zero):
+     * the first section uses the plain names (as in a filter with a
+     * single section), the further sections are on the pages with
+     * their section number.
+     *
+     * @param[in] parameterName  name of parameter in first section
+     * @param[in] sectionIndex   index of filter section
+     * @return  name of parameter in section
+     */
+    static String _sectionParameterName (IN String& parameterName,
+                                         IN Natural sectionIndex)
+    {
+        return (sectionIndex == 0
+                ? parameterName
+                : SoXEffectParameterMap
+                      ::pagedParameterName(parameterName,
+                                           sectionIndex + 1));
+    }
+
+    /*--------------------*/
+
+    /**
+     * Adds the definitions of all parameters of the filter section
+     * with <C>sectionIndex</C> to <C>parameterMap</C> with
+     * <C>filterKind</C> as default kind.
+     *
+     * @param[inout] parameterMap  parameter map to be extended
+     * @param[in]    sectionIndex  index of filter section
+     * @param[in]    filterKind    default kind of filter section
+     */
+    static void
+    _defineSectionParameters (INOUT SoXEffectParameterMap& parameterMap,
+                              IN Natural sectionIndex,
+                              IN String& filterKind)
+    {
+        Logging_trace2(">>: sectionIndex = %1, filterKind = %2",
+                       TOSTRING(sectionIndex), filterKind);
+
+        const auto pagedName =
+            [sectionIndex] (IN String& parameterName) {
+                return _sectionParameterName(parameterName, sectionIndex);
+            };
+
+        /* calculate list of bandwidth units */
+        const StringList unitCodeList = _unitCodeListForKind(filterKind);
+        StringList bwUnitTextList;
+
+        if (unitCodeList.size() == 0) {
+            bwUnitTextList.append(_bwUnitText_quality);
+        } else {
+            for (Natural i = 0; i < unitCodeList.size(); i++) {
+                const String bandwidthUnitText =
+                    _unitCodeToTextMap.at(unitCodeList[i]);
+                bwUnitTextList.append(bandwidthUnitText);
+            }
+        }
+
+        /* first of all define kind of filter and all parameter names */
+        parameterMap.setKindAndValueEnum(pagedName(parameterName_kind),
+                                         _kindList, filterKind);
+        parameterMap.setKindAndValueReal(pagedName(parameterName_frequency),
+                                         10.0, 20000.0, 0.01, 1000.0);
+        parameterMap.setKindAndValueReal(pagedName(parameterName_bandwidth),
+                                         0.001, 20000.0, 0.001, 1.0);
+        parameterMap.setKindAndValueEnum(pagedName(parameterName_bandwidthUnit),
+                                         bwUnitTextList,
+                                         _bwUnitText_quality);
+        parameterMap.setKindAndValueReal(pagedName(parameterName_dBGain),
+                                         -25.0, 25.0, 0.01, 0.0);
+        parameterMap.setKindAndValueEnum(pagedName(parameterName_cstSkirtGain),
+                                         _yesNoList, "No");
+        parameterMap.setKindAndValueReal(pagedName(parameterName_equGain),
+                                         -25.0, 25.0, 0.01, 0.0);
+        parameterMap.setKindAndValueReal(pagedName(parameterName_poleCount),
+                                         1.0, 2.0, 1.0, 1.0);
+        parameterMap.setKindAndValueEnum(pagedName(parameterName_unpitchedMode),
+                                         _yesNoList, "No");
+        parameterMap.setKindAndValueEnum(pagedName(parameterName_structure),
+                                         _structureList, _structureList[0]);
+
+        for (String parameterName : _biquadFilterParameterNameList) {
+            parameterMap.setKindAndValueReal(pagedName(parameterName),
+                                             -10.0, 10.0, 1e-6, 0.0);
+        }
+
+        Logging_trace("<<");
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns a parameter map with the definitions of all filter
+     * parameters; this is done once per process and the map is used
+     * as a prototype for each effect instance.  The further filter
+     * sections default to neutral equalizers.
+     *
+     * @return parameter map with all parameter definitions
+     */
+    static SoXEffectParameterMap _makeParameterMap ()
+    {
+        Logging_trace(">>");
+
+        SoXEffectParameterMap result;
+
+        _defineSectionParameters(result, 0, _kindList[0]);
+        result.setKindAndValueInt("-2#" + parameterName_sectionCount,
+                                  1, _maxSectionCount, 1, 1);
+        result.setKindAndValueInt("-1#" + parameterName_sectionIndex,
+                                  1, _maxSectionCount, 1, 1);
+
+        for (Natural sectionIndex = 1;  sectionIndex < _maxSectionCount;
+             sectionIndex++) {
+            _defineSectionParameters(result, sectionIndex,
+                                     filterKind_equalizer);
+        }
+
+        Logging_trace("<<");
+        return result;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Sets up bandwidth unit parameter of the filter section with
+     * <C>sectionIndex</C> in <C>parameterMap</C> for filter kind
+     * given as <C>filterKind</C>.
      *
      * @param[inout] parameterMap  effect parameter map of filter effect
      *                             to be updated for bandwidth unit parameter
      * @param[in] filterKind       kind of filter
+     * @param[in] sectionIndex     index of filter section
      */
     static void
     _setBandwidthUnitParameter(INOUT SoXEffectParameterMap& parameterMap,
-                               IN String& filterKind)
+                               IN String& filterKind,
+                               IN Natural sectionIndex)
     {
-        Logging_trace1(">>: %1", filterKind);
+        Logging_trace2(">>: kind = %1, section = %2",
+                       filterKind, TOSTRING(sectionIndex));
 
         const StringList unitCodeList = _unitCodeListForKind(filterKind);
 
@@ -516,9 +865,10 @@ namespace SoXPlugins::Effects::SoXFilter {
             }
 
             Logging_trace1("--: units = %1", bwUnitTextList.toString());
-            parameterMap.setKindAndValueEnum(parameterName_bandwidthUnit,
-                                             bwUnitTextList,
-                                             _bwUnitText_quality);
+            parameterMap.setKindAndValueEnum(
+                _sectionParameterName(parameterName_bandwidthUnit,
+                                      sectionIndex),
+                bwUnitTextList, _bwUnitText_quality);
         }
 
         Logging_trace("<<");
@@ -579,241 +929,1347 @@ namespace SoXPlugins::Effects::SoXFilter {
     /*--------------------*/
 
     /**
-     * Recalculates IIR filter coefficients from other parameters and
-     * <C>sampleRate</C> and updates IIR filter <C>effectDescriptor</C>
-     * accordingly.
+     * Sets the coefficients of the filter in
+     * <C>effectDescriptor</C> to the current values of its
+     * coefficient ramp.
      *
      * @param[inout] effectDescriptor  effect descriptor of filter
-     * @param[in]    sampleRate        new sample rate
      */
-    static void _updateFilterCoefficients
-                    (INOUT _EffectDescriptor_FLTR& effectDescriptor,
-                     IN Real sampleRate)
+    static void
+    _setFilterToRamp (INOUT _EffectDescriptor_FLTR& effectDescriptor)
+    {
+        Real b0, b1, b2, a0, a1, a2;
+        effectDescriptor.coefficientRamp.getCurrent(b0, b1, b2, a0, a1, a2);
+        effectDescriptor.filter.set(b0, b1, b2, a0, a1, a2);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Selects the block kernels of <C>effectDescriptor</C> for the
+     * coefficients of its filter: while the coefficients ramp
+     * between different shapes the general kernels are used,
+     * otherwise the kernels specialized for the coefficient shape.
+     *
+     * @param[inout] effectDescriptor  effect descriptor of filter
+     * @param[in]    shapeIsKept       tells whether the coefficients
+     *                                 ramp within a single shape
+     */
+    static void
+    _selectFilterKernels (INOUT _EffectDescriptor_FLTR& effectDescriptor,
+                          IN Boolean shapeIsKept)
+    {
+        const BiquadFilterShape shape =
+            (shapeIsKept || !effectDescriptor.coefficientRamp.isRamping()
+             ? effectDescriptor.filterShape
+             : BiquadFilterShape::general);
+        effectDescriptor.blockKernel = BiquadFilter::blockKernel(shape);
+        effectDescriptor.floatBlockKernel =
+            BiquadFilter::floatBlockKernel(shape);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Sets the state variable filter in <C>effectDescriptor</C> to
+     * the current values of its parameter ramp; the cutoff is ramped
+     * as relative frequency and only prewarped here by a table
+     * lookup.
+     *
+     * @param[inout] effectDescriptor  effect descriptor of filter
+     */
+    static void
+    _setStateVariableFilterToRamp
+        (INOUT _EffectDescriptor_FLTR& effectDescriptor)
+    {
+        Real relativeFrequency, frequencyFactor, damping, m0, m1, m2;
+        effectDescriptor.svfParameterRamp.getCurrent(relativeFrequency,
+                                                     frequencyFactor,
+                                                     damping, m0, m1, m2);
+        const Real g =
+            (StateVariableFilter::prewarpedFrequency(relativeFrequency)
+             * frequencyFactor);
+        effectDescriptor.svFilter.set(g, damping, m0, m1, m2);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Calculates IIR filter coefficients for the (non-biquad) filter
+     * settings in <C>effectDescriptor</C> and <C>sampleRate</C>.
+     *
+     * @param[in] effectDescriptor  effect descriptor of filter
+     * @param[in] sampleRate        sample rate of filter
+     * @return  the coefficients of the biquad filter and their
+     *          shape
+     */
+    static _FilterCoefficientSet
+    _calculateFilterCoefficients
+        (IN _EffectDescriptor_FLTR& effectDescriptor,
+         IN Real sampleRate)
     {
-        Logging_trace2(">>: kind = %1, sampleRate = %2",
-                       effectDescriptor.kind, TOSTRING(sampleRate));
-        
         Real b0 = 0.0;
         Real b1 = 0.0;
         Real b2 = 0.0;
         Real a0 = 0.0;
         Real a1 = 0.0;
         Real a2 = 0.0;
+        BiquadFilterShape shape = BiquadFilterShape::general;
 
-        if (effectDescriptor.kind == filterKind_biquad) {
-            /* we can just keep the direct coefficients, no
-               calculation is necessary */
-            b0 = effectDescriptor.b0;
-            b1 = effectDescriptor.b1;
-            b2 = effectDescriptor.b2;
-            a0 = effectDescriptor.a0;
-            a1 = effectDescriptor.a1;
-            a2 = effectDescriptor.a2;
-        } else {
-            const Real zero{0.0};
-            const Real one{1.0};
-            const Real two{2.0};
-            const Real four{4.0};
-            const Real ten{10.0};
-
-            const String kind    = effectDescriptor.kind;
-            const Real frequency = effectDescriptor.frequency;
-            const Real bandwidth = effectDescriptor.bandwidth;
-            const FilterBandwidthUnit bandwidthUnit =
-                effectDescriptor.bandwidthUnit;
+        const Real zero{0.0};
+        const Real one{1.0};
+        const Real two{2.0};
+        const Real four{4.0};
+        const Real ten{10.0};
 
-            const Real w0 = Real::twoPi * frequency / sampleRate;
-            const Real cw0 = Real::cos(w0);
-            const Real sw0 = Real::sin(w0);
-            const Real alpha = _alphaForBandwidth(sampleRate,
-                                                  bandwidth,
-                                                  bandwidthUnit,
-                                                  frequency,
-                                                  effectDescriptor.dBGain);
-            const Real a =
-                SoXAudioHelper::dBToLinear(effectDescriptor.dBGain, 40.0);
+        const String& kind   = effectDescriptor.kind;
+        const Real frequency = effectDescriptor.frequency;
+        const Real bandwidth = effectDescriptor.bandwidth;
+        const FilterBandwidthUnit bandwidthUnit =
+            effectDescriptor.bandwidthUnit;
 
-            if (kind == filterKind_allpass) {
-                b0 =  one - alpha;
-                b1 = -two * cw0;
-                b2 =  one + alpha;
-                a0 =  b2;
-                a1 =  b1;
-                a2 =  b0;
-            } else if (kind == filterKind_band) {
-                const Real bandwidthAsFrequency =
-                         (bandwidthUnit == FilterBandwidthUnit::quality
-                          ? frequency / bandwidth
-                          : (bandwidthUnit == FilterBandwidthUnit::octaves
-                             ? Real{(frequency * two.power(bandwidth - one)
-                                     * two.power(-bandwidth / two))}
-                             : bandwidth));
-                a2 = (-Real::twoPi * bandwidthAsFrequency / sampleRate).exp();
-                a1 = -four * a2 / (one + a2) * cw0;
-                a0 = one;
-                b2 = zero;
-                b1 = zero;
-                b0 = Real::sqrt(one - a1.sqr()
-                                / (four * a2)) * (one - a2);
-
-                if (effectDescriptor.usesUnpitchedAudioMode) {
-                    const Real factor =
-                        Real::sqrt(((one + a2).sqr() - a1.sqr())
-                                   * (one - a2) / (one + a2))
-                        / b0;
-                    b0 *= factor;
-                }
-            } else if (kind == filterKind_bandpass
-                       || kind == filterKind_bandreject) {
-                if (kind == filterKind_bandreject) {
-                    b0 =  one;
-                    b1 = -cw0 * two;
-                    b2 =  one;
+        const Real w0 = Real::twoPi * frequency / sampleRate;
+        const Real cw0 = Real::cos(w0);
+        const Real sw0 = Real::sin(w0);
+        const Real alpha = _alphaForBandwidth(sampleRate,
+                                              bandwidth,
+                                              bandwidthUnit,
+                                              frequency,
+                                              effectDescriptor.dBGain);
+        const Real a =
+            SoXAudioHelper::dBToLinear(effectDescriptor.dBGain, 40.0);
+
+        if (kind == filterKind_allpass) {
+            b0 =  one - alpha;
+            b1 = -two * cw0;
+            b2 =  one + alpha;
+            a0 =  b2;
+            a1 =  b1;
+            a2 =  b0;
+        } else if (kind == filterKind_band) {
+            const Real bandwidthAsFrequency =
+                     (bandwidthUnit == FilterBandwidthUnit::quality
+                      ? frequency / bandwidth
+                      : (bandwidthUnit == FilterBandwidthUnit::octaves
+                         ? Real{(frequency * two.power(bandwidth - one)
+                                 * two.power(-bandwidth / two))}
+                         : bandwidth));
+            a2 = (-Real::twoPi * bandwidthAsFrequency / sampleRate).exp();
+            a1 = -four * a2 / (one + a2) * cw0;
+            a0 = one;
+            b2 = zero;
+            b1 = zero;
+            shape = BiquadFilterShape::zeroFree;
+            b0 = Real::sqrt(one - a1.sqr()
+                            / (four * a2)) * (one - a2);
+
+            if (effectDescriptor.usesUnpitchedAudioMode) {
+                const Real factor =
+                    Real::sqrt(((one + a2).sqr() - a1.sqr())
+                               * (one - a2) / (one + a2))
+                    / b0;
+                b0 *= factor;
+            }
+        } else if (kind == filterKind_bandpass
+                   || kind == filterKind_bandreject) {
+            if (kind == filterKind_bandreject) {
+                b0 =  one;
+                b1 = -cw0 * two;
+                b2 =  one;
+                shape = BiquadFilterShape::symmetric;
+            } else {
+                b0 =  (effectDescriptor.usesConstantSkirtGain
+                       ? sw0 / two : alpha);
+                b1 =  zero;
+                b2 = -b0;
+                shape = BiquadFilterShape::antisymmetric;
+            }
+
+            a0 =  alpha + one;
+            a1 = -cw0 * two;
+            a2 = -alpha + one;
+        } else if (kind == filterKind_bass || kind == filterKind_treble) {
+            const Real f = (kind == filterKind_bass ? one : -one);
+            const Real sqrtAlphaA = two * Real::sqrt(a) * alpha;
+            const Real aP1 = a + one;
+            const Real aM1 = a - one;
+            const Real twoF = two * f;
+            b0 =         a * ( (aP1) - f * (aM1) * cw0 + sqrtAlphaA );
+            b1 =  twoF * a * ( (aM1) - f * (aP1) * cw0              );
+            b2 =         a * ( (aP1) - f * (aM1) * cw0 - sqrtAlphaA );
+            a0 =               (aP1) + f * (aM1) * cw0 + sqrtAlphaA;
+            a1 = -twoF *     ( (aM1) + f * (aP1) * cw0              );
+            a2 =               (aP1) + f * (aM1) * cw0 - sqrtAlphaA;
+        } else if (kind == filterKind_equalizer) {
+            const Real filterGain =
+                ten.power(effectDescriptor.equGain / 40.0);
+            b0  = one + alpha * filterGain;
+            b1  = -two * cw0;
+            b2  = one - alpha * filterGain;
+            a0 = one + alpha / filterGain;
+            a1 = b1;
+            a2 = one - alpha / filterGain;
+        } else if (kind == filterKind_highpass
+                   || kind == filterKind_lowpass) {
+            Real factorA, factorB, factorC;
+
+            if (effectDescriptor.isSinglePole) {
+                if (kind == filterKind_highpass) {
+                    factorA = -one;
+                    factorB = 0.5;
+                    factorC = -one;
                 } else {
-                    b0 =  (effectDescriptor.usesConstantSkirtGain
-                           ? sw0 / two : alpha);
-                    b1 =  zero;
-                    b2 = -b0;
+                    factorA = one;
+                    factorB = one;
+                    factorC = zero;
                 }
 
-                a0 =  alpha + one;
-                a1 = -cw0 * two;
-                a2 = -alpha + one;
-            } else if (kind == filterKind_bass || kind == filterKind_treble) {
-                const Real f = (kind == filterKind_bass ? one : -one);
-                const Real sqrtAlphaA = two * Real::sqrt(a) * alpha;
-                const Real aP1 = a + one;
-                const Real aM1 = a - one;
-                const Real twoF = two * f;
-                b0 =         a * ( (aP1) - f * (aM1) * cw0 + sqrtAlphaA );
-                b1 =  twoF * a * ( (aM1) - f * (aP1) * cw0              );
-                b2 =         a * ( (aP1) - f * (aM1) * cw0 - sqrtAlphaA );
-                a0 =               (aP1) + f * (aM1) * cw0 + sqrtAlphaA;
-                a1 = -twoF *     ( (aM1) + f * (aP1) * cw0              );
-                a2 =               (aP1) + f * (aM1) * cw0 - sqrtAlphaA;
-            } else if (kind == filterKind_equalizer) {
-                const Real filterGain =
-                    ten.power(effectDescriptor.equGain / 40.0);
-                b0  = one + alpha * filterGain;
-                b1  = -two * cw0;
-                b2  = one - alpha * filterGain;
-                a0 = one + alpha / filterGain;
-                a1 = b1;
-                a2 = one - alpha / filterGain;
-            } else if (kind == filterKind_highpass
-                       || kind == filterKind_lowpass) {
-                Real factorA, factorB, factorC;
-
-                if (effectDescriptor.isSinglePole) {
-                    if (kind == filterKind_highpass) {
-                        factorA = -one;
-                        factorB = 0.5;
-                        factorC = -one;
-                    } else {
-                        factorA = one;
-                        factorB = one;
-                        factorC = zero;
-                    }
-
-                    a0 = one;
-                    a1 = -Real::exp(-w0);
-                    a2 = zero;
-                    b0  = (one + factorA * a1) * factorB;
-                    b1  = factorC * b0;
-                    b2  = zero;
+                a0 = one;
+                a1 = -Real::exp(-w0);
+                a2 = zero;
+                b0  = (one + factorA * a1) * factorB;
+                b1  = factorC * b0;
+                b2  = zero;
+                shape = BiquadFilterShape::singlePole;
+            } else {
+                if (kind == filterKind_highpass) {
+                    factorA = (one + cw0);
+                    factorB = -one;
                 } else {
-                    if (kind == filterKind_highpass) {
-                        factorA = (one + cw0);
-                        factorB = -one;
-                    } else {
-                        factorA = (one - cw0);
-                        factorB = one;
-                    }
-
-                    b0  = factorA / two;
-                    b1  = factorB * factorA;
-                    b2  = b0;
-                    a0 = one + alpha;
-                    a1 = -two * cw0;
-                    a2 = one - alpha;
+                    factorA = (one - cw0);
+                    factorB = one;
                 }
-            }
 
-            /* update the internal variables */
-            effectDescriptor.b0 = b0;
-            effectDescriptor.b1 = b1;
-            effectDescriptor.b2 = b2;
-            effectDescriptor.a0 = a0;
-            effectDescriptor.a1 = a1;
-            effectDescriptor.a2 = a2;
+                b0  = factorA / two;
+                b1  = factorB * factorA;
+                b2  = b0;
+                shape = BiquadFilterShape::symmetric;
+                a0 = one + alpha;
+                a1 = -two * cw0;
+                a2 = one - alpha;
+            }
         }
 
-        effectDescriptor.filter.set(b0, b1, b2, a0, a1, a2);
-
-        Logging_trace1("<<: %1", effectDescriptor.toString());
+        return _FilterCoefficientSet{b0, b1, b2, a0, a1, a2, shape};
     }
 
     /*--------------------*/
 
     /**
-     * Updates effect parameters in <C>parameterMap</C> for filter
-     * kind given as <C>filterKind</C>.
+     * Tells whether the filter settings in <C>effectDescriptor</C>
+     * ask for a state variable filter and its kind can be realized
+     * by one (all RBJ kinds with two poles).
      *
-     * @param[inout] parameterMap  effect parameter map of filter
-     *                             effect to be initialized
-     * @param[in] filterKind       kind of filter to be set up
+     * @param[in] effectDescriptor  effect descriptor of filter
+     * @return  information whether a state variable filter is used
      */
-    static void
-    _updateParametersForKind (INOUT SoXEffectParameterMap& parameterMap,
-                              IN String& filterKind)
+    static Boolean
+    _isStateVariableFilter (IN _EffectDescriptor_FLTR& effectDescriptor)
     {
-        Logging_trace1(">>: %1", filterKind);
-        Assertion_pre(_kindList.contains(filterKind),
-                      "filter kind must be known");
+        const String& kind = effectDescriptor.kind;
+        const Boolean kindIsSupported =
+            (kind == filterKind_allpass || kind == filterKind_bandpass
+             || kind == filterKind_bandreject || kind == filterKind_bass
+             || kind == filterKind_equalizer || kind == filterKind_treble
+             || ((kind == filterKind_highpass || kind == filterKind_lowpass)
+                 && !effectDescriptor.isSinglePole));
+        return (effectDescriptor.usesStateVariableStructure
+                && kindIsSupported);
+    }
 
-        _setBandwidthUnitParameter(parameterMap, filterKind);
+    /*--------------------*/
 
-        /* activate or deactivate parameter names */
-        Boolean isActive;
-        const String widgetDataString =
-            _filterKindToWidgetDataMap.at(filterKind);
-        const StringList widgetCodeList =
-            StringList::makeBySplit(widgetDataString, separator);
+    /**
+     * Calculates the state variable filter parameters for the filter
+     * settings in <C>effectDescriptor</C> and <C>sampleRate</C>; the
+     * responses are identical to those of the biquad coefficients
+     * from <C>_calculateFilterCoefficients</C>, since the quality
+     * <C>sin(w0) / (2 alpha)</C> is the one of the common analog
+     * prototype.
+     *
+     * @param[in] effectDescriptor  effect descriptor of filter
+     * @param[in] sampleRate        sample rate of filter
+     * @return  the parameters of the state variable filter
+     */
+    static _SVFParameterSet
+    _calculateSVFParameters (IN _EffectDescriptor_FLTR& effectDescriptor,
+                             IN Real sampleRate)
+    {
+        const Real zero{0.0};
+        const Real one{1.0};
+        const Real two{2.0};
 
-        isActive = widgetCodeList.contains(paramFlag_biquad);
-        
-        for (String parameterName : _biquadFilterParameterNameList) {
-            parameterMap.setActiveness(parameterName, isActive);
+        const String& kind   = effectDescriptor.kind;
+        const Real frequency = effectDescriptor.frequency;
+        const Real bandwidth = effectDescriptor.bandwidth;
+        const FilterBandwidthUnit bandwidthUnit =
+            effectDescriptor.bandwidthUnit;
+
+        /* only the octave and slope units need the RBJ alpha */
+        Real quality;
+
+        if (bandwidthUnit == FilterBandwidthUnit::quality) {
+            quality = bandwidth;
+        } else if (bandwidthUnit == FilterBandwidthUnit::butterworth) {
+            quality = Real{0.5}.sqrt();
+        } else if (bandwidthUnit == FilterBandwidthUnit::frequency) {
+            quality = frequency / bandwidth;
+        } else {
+            const Real w0 = Real::twoPi * frequency / sampleRate;
+            const Real alpha = _alphaForBandwidth(sampleRate,
+                                                  bandwidth,
+                                                  bandwidthUnit,
+                                                  frequency,
+                                                  effectDescriptor.dBGain);
+            quality = w0.sin() / (two * alpha);
         }
 
-        isActive = widgetCodeList.contains(paramFlag_poleCount);
-        parameterMap.setActiveness(parameterName_poleCount, isActive);
+        _SVFParameterSet result{true, frequency / sampleRate, one,
+                                one / quality, zero, zero, zero};
+        const Real k = result.damping;
+
+        if (kind == filterKind_allpass) {
+            result.m0 = one;
+            result.m1 = -two * k;
+        } else if (kind == filterKind_bandpass) {
+            /* a constant skirt gain has a peak gain of Q */
+            result.m1 = (effectDescriptor.usesConstantSkirtGain ? one : k);
+        } else if (kind == filterKind_bandreject) {
+            result.m0 = one;
+            result.m1 = -k;
+        } else if (kind == filterKind_bass || kind == filterKind_treble) {
+            const Real a =
+                SoXAudioHelper::dBToLinear(effectDescriptor.dBGain, 40.0);
+            const Real aSquared = a * a;
+
+            if (kind == filterKind_bass) {
+                result.frequencyFactor = one / a.sqrt();
+                result.m0 = one;
+                result.m1 = k * (a - one);
+                result.m2 = aSquared - one;
+            } else {
+                result.frequencyFactor = a.sqrt();
+                result.m0 = aSquared;
+                result.m1 = k * (one - a) * a;
+                result.m2 = one - aSquared;
+            }
+        } else if (kind == filterKind_equalizer) {
+            const Real a =
+                SoXAudioHelper::dBToLinear(effectDescriptor.equGain, 40.0);
+            result.damping = k / a;
+            result.m0 = one;
+            result.m1 = result.damping * (a * a - one);
+        } else if (kind == filterKind_highpass) {
+            result.m0 = one;
+            result.m1 = -k;
+            result.m2 = -one;
+        } else {
+            result.m2 = one;
+        }
 
-        isActive = widgetCodeList.contains(paramFlag_dBGain);
-        parameterMap.setActiveness(parameterName_dBGain, isActive);
+        return result;
+    }
 
-        isActive = widgetCodeList.contains(paramFlag_unpitchedMode);
-        parameterMap.setActiveness(parameterName_unpitchedMode, isActive);
+    /*--------------------*/
 
-        isActive = widgetCodeList.contains(paramFlag_cstSkirtGain);
-        parameterMap.setActiveness(parameterName_cstSkirtGain, isActive);
+    /**
+     * Returns the key of the coefficient cache for the filter
+     * settings in <C>effectDescriptor</C> and <C>sampleRate</C>.
+     *
+     * @param[in] effectDescriptor  effect descriptor of filter
+     * @param[in] sampleRate        sample rate of filter
+     * @return  key for coefficient cache
+     */
+    static _FilterCoefficientKey
+    _coefficientKey (IN _EffectDescriptor_FLTR& effectDescriptor,
+                     IN Real sampleRate)
+    {
+        _FilterCoefficientKey key;
+        key.kind                   = effectDescriptor.kind;
+        key.frequency              = effectDescriptor.frequency;
+        key.bandwidth              = effectDescriptor.bandwidth;
+        key.bandwidthUnit          = effectDescriptor.bandwidthUnit;
+        key.dBGain                 = effectDescriptor.dBGain;
+        key.equGain                = effectDescriptor.equGain;
+        key.usesUnpitchedAudioMode =
+            effectDescriptor.usesUnpitchedAudioMode;
+        key.usesConstantSkirtGain  = effectDescriptor.usesConstantSkirtGain;
+        key.isSinglePole           = effectDescriptor.isSinglePole;
+        key.sampleRate             = sampleRate;
+        return key;
+    }
 
-        isActive = widgetCodeList.contains(paramFlag_frequency);
-        parameterMap.setActiveness(parameterName_frequency, isActive);
+    /*--------------------*/
 
-        isActive = widgetCodeList.contains(paramFlag_bandwidth);
-        parameterMap.setActiveness(parameterName_bandwidth, isActive);
-        parameterMap.setActiveness(parameterName_bandwidthUnit, isActive);
+    /**
+     * Recalculates IIR filter coefficients from other parameters and
+     * <C>sampleRate</C> and updates IIR filter <C>effectDescriptor</C>
+     * accordingly; coefficients of settings already seen by some
+     * filter instance are taken from the process-wide cache.  For a
+     * state variable filter only its parameters are handed over,
+     * which need no trigonometric functions for the common
+     * bandwidth units.
+     *
+     * @param[inout] effectDescriptor  effect descriptor of filter
+     * @param[in]    sampleRate        new sample rate
+     */
+    static void _updateFilterCoefficients
+                    (INOUT _EffectDescriptor_FLTR& effectDescriptor,
+                     IN Real sampleRate)
+    {
+        Logging_trace2(">>: kind = %1, sampleRate = %2",
+                       effectDescriptor.kind, TOSTRING(sampleRate));
 
-        isActive = widgetCodeList.contains(paramFlag_equGain);
-        parameterMap.setActiveness(parameterName_equGain, isActive);
+        _SVFParameterSet& svfParameterSet =
+            effectDescriptor.svfParameterExchange.pendingSnapshot();
+
+        if (_isStateVariableFilter(effectDescriptor)) {
+            /* the state variable filter is tuned by the processing
+               from its parameters, only its poles are kept as biquad
+               denominator for the tail length */
+            svfParameterSet =
+                _calculateSVFParameters(effectDescriptor, sampleRate);
+            const Real w = Real::pi * svfParameterSet.relativeFrequency;
+            const Real g =
+                w.sin() / w.cos() * svfParameterSet.frequencyFactor;
+            const Real k = svfParameterSet.damping;
+            const Real gSquared = g * g;
+            const Real m0 = svfParameterSet.m0;
+            const Real m1 = svfParameterSet.m1;
+            const Real m2 = svfParameterSet.m2;
+            effectDescriptor.a0 = Real{1.0} + g * (g + k);
+            effectDescriptor.a1 = Real{2.0} * (gSquared - Real{1.0});
+            effectDescriptor.a2 = Real{1.0} - g * k + gSquared;
+
+            /* the equivalent numerator: the bandpass has numerator
+               g(1 - z^-2), the lowpass g^2(1 + z^-1)^2 */
+            effectDescriptor.b0 =
+                m0 * effectDescriptor.a0 + m1 * g + m2 * gSquared;
+            effectDescriptor.b1 =
+                m0 * effectDescriptor.a1 + Real{2.0} * m2 * gSquared;
+            effectDescriptor.b2 =
+                m0 * effectDescriptor.a2 - m1 * g + m2 * gSquared;
+            effectDescriptor.svfParameterExchange.publish();
+        } else {
+            svfParameterSet.isActive = false;
+            effectDescriptor.svfParameterExchange.publish();
+            BiquadFilterShape shape = BiquadFilterShape::general;
+
+            if (effectDescriptor.kind != filterKind_biquad) {
+                /* the direct coefficients of a biquad need no
+                   calculation, all others are calculated or taken
+                   from the cache */
+                const _FilterCoefficientKey key =
+                    _coefficientKey(effectDescriptor, sampleRate);
+                _FilterCoefficientSet coefficientSet;
+
+                if (!_SoXFilterCoefficientCache::lookup(key,
+                                                        coefficientSet)) {
+                    coefficientSet =
+                        _calculateFilterCoefficients(effectDescriptor,
+                                                     sampleRate);
+                    _SoXFilterCoefficientCache::store(key, coefficientSet);
+                }
 
-        Logging_trace1("<<: parameterMap = %1", parameterMap.toString());
-    }
+                /* update the internal variables */
+                effectDescriptor.b0 = coefficientSet.b0;
+                effectDescriptor.b1 = coefficientSet.b1;
+                effectDescriptor.b2 = coefficientSet.b2;
+                effectDescriptor.a0 = coefficientSet.a0;
+                effectDescriptor.a1 = coefficientSet.a1;
+                effectDescriptor.a2 = coefficientSet.a2;
+                shape = coefficientSet.shape;
+            }
 
-}
+            /* hand the complete coefficient set over to the
+               processing, which ramps to it from the next block on */
+            _FilterCoefficientSet& coefficientSet =
+                effectDescriptor.coefficientExchange.pendingSnapshot();
+            coefficientSet.b0 = effectDescriptor.b0;
+            coefficientSet.b1 = effectDescriptor.b1;
+            coefficientSet.b2 = effectDescriptor.b2;
+            coefficientSet.a0 = effectDescriptor.a0;
+            coefficientSet.a1 = effectDescriptor.a1;
+            coefficientSet.a2 = effectDescriptor.a2;
+            coefficientSet.shape = shape;
+            effectDescriptor.coefficientExchange.publish();
+        }
 
-/*============================================================*/
+        Logging_trace1("<<: %1", effectDescriptor.toString());
+    }
+
+    /*--------------------*/
+
+    /**
+     * Sets the response curve of the filter effect with
+     * <C>effectDescriptor</C> to the cascade of the coefficients of
+     * all its active filter sections at <C>sampleRate</C>.
+     *
+     * @param[inout] effectDescriptor  effect descriptor of filter
+     * @param[in]    sampleRate        sample rate of filter
+     */
+    static void
+    _updateResponseCurve (INOUT _EffectDescriptor_FLTR& effectDescriptor,
+                          IN Real sampleRate)
+    {
+        Logging_trace1(">>: sectionCount = %1",
+                       TOSTRING(effectDescriptor.sectionCount));
+
+        RealList responseCoefficientList;
+
+        for (Natural sectionIndex = 0;
+             sectionIndex < effectDescriptor.sectionCount;
+             sectionIndex++) {
+            const _EffectDescriptor_FLTR& section =
+                _section(effectDescriptor, sectionIndex);
+            responseCoefficientList.append(
+                RealList::fromList({section.b0, section.b1, section.b2,
+                                    section.a0, section.a1, section.a2}));
+        }
+
+        effectDescriptor.responseCache.setCurve(0, sampleRate,
+                                                responseCoefficientList, 3);
+
+        Logging_trace("<<");
+    }
+
+    /*--------------------*/
+
+    /**
+     * Takes over the coefficients and state variable filter
+     * parameters last published in <C>effectDescriptor</C> as new
+     * targets of their ramps (if any); only called by the
+     * processing.  When the filter structure changes, the states of
+     * the new structure are cleared and its ramp starts at the
+     * target.
+     *
+     * @param[inout] effectDescriptor  effect descriptor of filter
+     */
+    static void _acquireFilterCoefficients
+                    (INOUT _EffectDescriptor_FLTR& effectDescriptor)
+    {
+        SoXSnapshotExchange<_SVFParameterSet>& svfParameterExchange =
+            effectDescriptor.svfParameterExchange;
+
+        if (svfParameterExchange.acquire()) {
+            const _SVFParameterSet& svfParameterSet =
+                svfParameterExchange.currentSnapshot();
+            const Boolean wasStateVariable =
+                effectDescriptor.isStateVariable;
+            effectDescriptor.isStateVariable = svfParameterSet.isActive;
+
+            if (svfParameterSet.isActive) {
+                SoXFilterCoefficientRamp& ramp =
+                    effectDescriptor.svfParameterRamp;
+                ramp.setTarget(svfParameterSet.relativeFrequency,
+                               svfParameterSet.frequencyFactor,
+                               svfParameterSet.damping,
+                               svfParameterSet.m0,
+                               svfParameterSet.m1,
+                               svfParameterSet.m2);
+
+                if (!wasStateVariable) {
+                    for (StateVariableFilterState& state
+                             : effectDescriptor.svfStateList) {
+                        state.clear();
+                    }
+
+                    ramp.finish();
+                }
+
+                _setStateVariableFilterToRamp(effectDescriptor);
+            } else if (wasStateVariable) {
+                for (BiquadFilterState& state
+                         : effectDescriptor.filterStateList) {
+                    state.clear();
+                }
+
+                effectDescriptor.coefficientRamp.finish();
+                _setFilterToRamp(effectDescriptor);
+                _selectFilterKernels(effectDescriptor, true);
+            }
+        }
+
+        SoXSnapshotExchange<_FilterCoefficientSet>& coefficientExchange =
+            effectDescriptor.coefficientExchange;
+
+        if (coefficientExchange.acquire()) {
+            const _FilterCoefficientSet& coefficientSet =
+                coefficientExchange.currentSnapshot();
+            const Boolean shapeIsKept =
+                (coefficientSet.shape == effectDescriptor.filterShape);
+            effectDescriptor.filterShape = coefficientSet.shape;
+            effectDescriptor.coefficientRamp.setTarget(coefficientSet.b0,
+                                                       coefficientSet.b1,
+                                                       coefficientSet.b2,
+                                                       coefficientSet.a0,
+                                                       coefficientSet.a1,
+                                                       coefficientSet.a2);
+            _setFilterToRamp(effectDescriptor);
+            _selectFilterKernels(effectDescriptor, shapeIsKept);
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns pointer to first sample of channel <C>channel</C> in
+     * <C>buffer</C>.
+     *
+     * @param[in] buffer   audio sample buffer
+     * @param[in] channel  index of channel
+     * @return  pointer to first sample of channel
+     */
+    static AudioSample* _channelStart (INOUT AudioSampleListVector& buffer,
+                                       IN Natural channel)
+    {
+        return buffer[channel].asArray();
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns pointer to first sample of channel <C>channel</C> in
+     * <C>channelArray</C>; double samples are used in place as audio
+     * samples.
+     *
+     * @param[in] channelArray  array of pointers to channels
+     * @param[in] channel       index of channel
+     * @return  pointer to first sample of channel
+     */
+    static AudioSample* _channelStart (INOUT double* const* channelArray,
+                                       IN Natural channel)
+    {
+        return (AudioSample*) channelArray[(size_t) channel];
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns pointer to first sample of channel <C>channel</C> in
+     * <C>channelArray</C>.
+     *
+     * @param[in] channelArray  array of pointers to channels
+     * @param[in] channel       index of channel
+     * @return  pointer to first sample of channel
+     */
+    static float* _channelStart (INOUT float* const* channelArray,
+                                 IN Natural channel)
+    {
+        return channelArray[(size_t) channel];
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies <C>filter</C> in place to <C>sampleCount</C> audio
+     * samples of a single channel <C>sampleArray</C> with filter
+     * state <C>state</C> by the block kernel selected in
+     * <C>effectDescriptor</C>.
+     *
+     * @param[in]    effectDescriptor  effect descriptor of filter
+     * @param[in]    filter            biquad filter
+     * @param[inout] sampleArray       samples of channel
+     * @param[in]    sampleCount       number of samples
+     * @param[inout] state             filter state of channel
+     */
+    static void _filterChannel (IN _EffectDescriptor_FLTR& effectDescriptor,
+                                IN BiquadFilter& filter,
+                                INOUT AudioSample* sampleArray,
+                                IN Natural sampleCount,
+                                INOUT BiquadFilterState& state)
+    {
+        effectDescriptor.blockKernel(filter, sampleArray, sampleArray,
+                                     sampleCount, state);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies <C>filter</C> in place to <C>sampleCount</C> float
+     * samples of a single channel <C>sampleArray</C> with filter
+     * state <C>state</C> by the block kernel selected in
+     * <C>effectDescriptor</C>.
+     *
+     * @param[in]    effectDescriptor  effect descriptor of filter
+     * @param[in]    filter            biquad filter
+     * @param[inout] sampleArray       samples of channel
+     * @param[in]    sampleCount       number of samples
+     * @param[inout] state             filter state of channel
+     */
+    static void _filterChannel (IN _EffectDescriptor_FLTR& effectDescriptor,
+                                IN BiquadFilter& filter,
+                                INOUT float* sampleArray,
+                                IN Natural sampleCount,
+                                INOUT BiquadFilterState& state)
+    {
+        effectDescriptor.floatBlockKernel(filter, sampleArray, sampleArray,
+                                          sampleCount, state);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies <C>filter</C> in place to <C>sampleCount</C> audio
+     * samples of two channels <C>sampleArrayA</C> and
+     * <C>sampleArrayB</C> with filter states <C>stateA</C> and
+     * <C>stateB</C>; the vector kernel handles all coefficient
+     * shapes, hence the kernels in <C>effectDescriptor</C> are not
+     * used.
+     *
+     * @param[in]    effectDescriptor  effect descriptor of filter
+     * @param[in]    filter            biquad filter
+     * @param[inout] sampleArrayA      samples of first channel
+     * @param[inout] sampleArrayB      samples of second channel
+     * @param[in]    sampleCount       number of samples per channel
+     * @param[inout] stateA            filter state of first channel
+     * @param[inout] stateB            filter state of second channel
+     */
+    static void
+    _filterChannelPair (IN _EffectDescriptor_FLTR& effectDescriptor,
+                        IN BiquadFilter& filter,
+                        INOUT AudioSample* sampleArrayA,
+                        INOUT AudioSample* sampleArrayB,
+                        IN Natural sampleCount,
+                        INOUT BiquadFilterState& stateA,
+                        INOUT BiquadFilterState& stateB)
+    {
+        filter.applyBlockStereo(sampleArrayA, sampleArrayB,
+                                sampleArrayA, sampleArrayB,
+                                sampleCount, stateA, stateB);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies <C>filter</C> in place to <C>sampleCount</C> float
+     * samples of two channels <C>sampleArrayA</C> and
+     * <C>sampleArrayB</C> with filter states <C>stateA</C> and
+     * <C>stateB</C>.
+     *
+     * @param[in]    effectDescriptor  effect descriptor of filter
+     * @param[in]    filter            biquad filter
+     * @param[inout] sampleArrayA      samples of first channel
+     * @param[inout] sampleArrayB      samples of second channel
+     * @param[in]    sampleCount       number of samples per channel
+     * @param[inout] stateA            filter state of first channel
+     * @param[inout] stateB            filter state of second channel
+     */
+    static void
+    _filterChannelPair (IN _EffectDescriptor_FLTR& effectDescriptor,
+                        IN BiquadFilter& filter,
+                        INOUT float* sampleArrayA,
+                        INOUT float* sampleArrayB,
+                        IN Natural sampleCount,
+                        INOUT BiquadFilterState& stateA,
+                        INOUT BiquadFilterState& stateB)
+    {
+        _filterChannel(effectDescriptor, filter, sampleArrayA, sampleCount,
+                       stateA);
+        _filterChannel(effectDescriptor, filter, sampleArrayB, sampleCount,
+                       stateB);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies <C>filter</C> in place to <C>sampleCount</C> audio
+     * samples of the four channels in <C>sampleArrayList</C> with
+     * filter states in <C>stateList</C>; the vector kernel handles
+     * all coefficient shapes, hence the kernels in
+     * <C>effectDescriptor</C> are not used.
+     *
+     * @param[in]    effectDescriptor  effect descriptor of filter
+     * @param[in]    filter            biquad filter
+     * @param[inout] sampleArrayList   samples of the four channels
+     * @param[in]    sampleCount       number of samples per channel
+     * @param[inout] stateList         filter states of the four
+     *                                 channels
+     */
+    static void
+    _filterChannelQuad (IN _EffectDescriptor_FLTR& effectDescriptor,
+                        IN BiquadFilter& filter,
+                        INOUT AudioSample* const* sampleArrayList,
+                        IN Natural sampleCount,
+                        INOUT BiquadFilterState* const* stateList)
+    {
+        filter.applyBlockQuad(sampleArrayList, sampleCount, stateList);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies <C>filter</C> in place to <C>sampleCount</C> float
+     * samples of the four channels in <C>sampleArrayList</C> with
+     * filter states in <C>stateList</C>.
+     *
+     * @param[in]    effectDescriptor  effect descriptor of filter
+     * @param[in]    filter            biquad filter
+     * @param[inout] sampleArrayList   samples of the four channels
+     * @param[in]    sampleCount       number of samples per channel
+     * @param[inout] stateList         filter states of the four
+     *                                 channels
+     */
+    static void
+    _filterChannelQuad (IN _EffectDescriptor_FLTR& effectDescriptor,
+                        IN BiquadFilter& filter,
+                        INOUT float* const* sampleArrayList,
+                        IN Natural sampleCount,
+                        INOUT BiquadFilterState* const* stateList)
+    {
+        for (size_t i = 0;  i < 4;  i++) {
+            _filterChannel(effectDescriptor, filter, sampleArrayList[i],
+                           sampleCount, *stateList[i]);
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies the biquad filter of <C>effectDescriptor</C> in place
+     * to <C>sampleCount</C> samples in each of the
+     * <C>channelCount</C> channels of <C>channelArray</C>; while
+     * the coefficients are ramping, the block is split into
+     * sub-blocks with a coefficient update after each.
+     *
+     * @tparam       ChannelArray      type of channel container
+     * @param[inout] effectDescriptor  effect descriptor of filter
+     * @param[inout] channelArray      container of input and output
+     *                                 channels
+     * @param[in]    channelCount      number of channels
+     * @param[in]    sampleCount       number of samples per channel
+     */
+    template<typename ChannelArray>
+    static void
+    _applyBiquadFilter (INOUT _EffectDescriptor_FLTR& effectDescriptor,
+                        INOUT ChannelArray& channelArray,
+                        IN Natural channelCount,
+                        IN Natural sampleCount)
+    {
+        SoXFilterCoefficientRamp& ramp = effectDescriptor.coefficientRamp;
+        _BiquadFilterStateList& filterStateList =
+            effectDescriptor.filterStateList;
+        filterStateList.ensureLength(channelCount);
+
+        Natural position = 0;
+
+        while (position < sampleCount) {
+            const Boolean isRamping = ramp.isRamping();
+            const Natural count =
+                (isRamping
+                 ? Natural::minimum(sampleCount - position,
+                                    ramp.subBlockLength())
+                 : sampleCount - position);
+            Natural channel = 0;
+
+            /* an absorbed gain is folded into the numerator */
+            BiquadFilter filter{effectDescriptor.filter};
+
+            if (effectDescriptor.absorbedGain != 1.0) {
+                filter.scale(effectDescriptor.absorbedGain);
+            }
+
+            /* process groups of four channels together */
+            while (channel + 3 < channelCount) {
+                decltype(_channelStart(channelArray, channel))
+                    sampleArrayList[4];
+                BiquadFilterState* stateList[4];
+
+                for (Natural i = 0;  i < 4;  i++) {
+                    const Natural quadChannel = channel + i;
+                    sampleArrayList[(size_t) i] =
+                        (_channelStart(channelArray, quadChannel)
+                         + (size_t) position);
+                    stateList[(size_t) i] = &filterStateList[quadChannel];
+                }
+
+                _filterChannelQuad(effectDescriptor, filter,
+                                   sampleArrayList, count, stateList);
+                channel += 4;
+            }
+
+            /* process a remaining channel pair together */
+            while (channel + 1 < channelCount) {
+                _filterChannelPair(effectDescriptor, filter,
+                                   _channelStart(channelArray, channel)
+                                   + (size_t) position,
+                                   _channelStart(channelArray, channel + 1)
+                                   + (size_t) position,
+                                   count,
+                                   filterStateList[channel],
+                                   filterStateList[channel + 1]);
+                channel += 2;
+            }
+
+            if (channel < channelCount) {
+                /* remaining single channel */
+                auto* sampleArray =
+                    _channelStart(channelArray, channel) + (size_t) position;
+                _filterChannel(effectDescriptor, filter, sampleArray, count,
+                               filterStateList[channel]);
+            }
+
+            if (isRamping) {
+                ramp.advance(count);
+                _setFilterToRamp(effectDescriptor);
+
+                if (!ramp.isRamping()) {
+                    /* the ramp has reached the target shape */
+                    _selectFilterKernels(effectDescriptor, true);
+                }
+            }
+
+            position += count;
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies the state variable filter of <C>effectDescriptor</C>
+     * in place to <C>sampleCount</C> samples in each of the
+     * <C>channelCount</C> channels of <C>channelArray</C>; while
+     * the parameters are ramping, the block is split into
+     * sub-blocks with a filter update after each.
+     *
+     * @tparam       ChannelArray      type of channel container
+     * @param[inout] effectDescriptor  effect descriptor of filter
+     * @param[inout] channelArray      container of input and output
+     *                                 channels
+     * @param[in]    channelCount      number of channels
+     * @param[in]    sampleCount       number of samples per channel
+     */
+    template<typename ChannelArray>
+    static void
+    _applyStateVariableFilter
+        (INOUT _EffectDescriptor_FLTR& effectDescriptor,
+         INOUT ChannelArray& channelArray,
+         IN Natural channelCount,
+         IN Natural sampleCount)
+    {
+        SoXFilterCoefficientRamp& ramp = effectDescriptor.svfParameterRamp;
+        _SVFStateList& svfStateList = effectDescriptor.svfStateList;
+        svfStateList.ensureLength(channelCount);
+
+        Natural position = 0;
+
+        while (position < sampleCount) {
+            const Boolean isRamping = ramp.isRamping();
+            const Natural count =
+                (isRamping
+                 ? Natural::minimum(sampleCount - position,
+                                    ramp.subBlockLength())
+                 : sampleCount - position);
+
+            /* an absorbed gain is folded into the output mix */
+            StateVariableFilter filter{effectDescriptor.svFilter};
+
+            if (effectDescriptor.absorbedGain != 1.0) {
+                filter.scale(effectDescriptor.absorbedGain);
+            }
+
+            for (Natural channel = 0;  channel < channelCount;  channel++) {
+                auto* sampleArray =
+                    _channelStart(channelArray, channel) + (size_t) position;
+                filter.applyBlock(sampleArray, sampleArray, count,
+                                  svfStateList[channel]);
+            }
+
+            if (isRamping) {
+                ramp.advance(count);
+                _setStateVariableFilterToRamp(effectDescriptor);
+            }
+
+            position += count;
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies the filter of <C>effectDescriptor</C> in place to
+     * <C>sampleCount</C> samples in each of the
+     * <C>channelCount</C> channels of <C>channelArray</C> in its
+     * current structure.  Newly published coefficients are taken
+     * over at block start.
+     *
+     * @tparam       ChannelArray      type of channel container
+     * @param[inout] effectDescriptor  effect descriptor of filter
+     * @param[inout] channelArray      container of input and output
+     *                                 channels
+     * @param[in]    channelCount      number of channels
+     * @param[in]    sampleCount       number of samples per channel
+     */
+    template<typename ChannelArray>
+    static void _applyFilter (INOUT _EffectDescriptor_FLTR& effectDescriptor,
+                              INOUT ChannelArray& channelArray,
+                              IN Natural channelCount,
+                              IN Natural sampleCount)
+    {
+        _acquireFilterCoefficients(effectDescriptor);
+
+        if (effectDescriptor.isStateVariable) {
+            _applyStateVariableFilter(effectDescriptor, channelArray,
+                                      channelCount, sampleCount);
+        } else {
+            _applyBiquadFilter(effectDescriptor, channelArray,
+                               channelCount, sampleCount);
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies the filter of <C>effectDescriptor</C> followed by the
+     * filter of <C>nextDescriptor</C> in place to
+     * <C>sampleCount</C> samples in each of the
+     * <C>channelCount</C> channels of <C>channelArray</C> in a
+     * single pass; an absorbed gain is folded into the second
+     * filter.  While one of the coefficient sets is ramping, the
+     * block is split into sub-blocks with a coefficient update
+     * after each.
+     *
+     * @tparam       ChannelArray      type of channel container
+     * @param[inout] effectDescriptor  effect descriptor of first
+     *                                 filter
+     * @param[inout] nextDescriptor    effect descriptor of second
+     *                                 filter
+     * @param[inout] channelArray      container of input and output
+     *                                 channels
+     * @param[in]    channelCount      number of channels
+     * @param[in]    sampleCount       number of samples per channel
+     */
+    template<typename ChannelArray>
+    static void
+    _applyFilterCascade (INOUT _EffectDescriptor_FLTR& effectDescriptor,
+                         INOUT _EffectDescriptor_FLTR& nextDescriptor,
+                         INOUT ChannelArray& channelArray,
+                         IN Natural channelCount,
+                         IN Natural sampleCount)
+    {
+        _acquireFilterCoefficients(effectDescriptor);
+        _acquireFilterCoefficients(nextDescriptor);
+
+        SoXFilterCoefficientRamp& ramp = effectDescriptor.coefficientRamp;
+        SoXFilterCoefficientRamp& nextRamp = nextDescriptor.coefficientRamp;
+        _BiquadFilterStateList& filterStateList =
+            effectDescriptor.filterStateList;
+        _BiquadFilterStateList& nextFilterStateList =
+            nextDescriptor.filterStateList;
+        filterStateList.ensureLength(channelCount);
+        nextFilterStateList.ensureLength(channelCount);
+
+        Natural position = 0;
+
+        while (position < sampleCount) {
+            const Boolean isRamping = ramp.isRamping();
+            const Boolean nextIsRamping = nextRamp.isRamping();
+            Natural count = sampleCount - position;
+            count = (isRamping
+                     ? Natural::minimum(count, ramp.subBlockLength())
+                     : count);
+            count = (nextIsRamping
+                     ? Natural::minimum(count, nextRamp.subBlockLength())
+                     : count);
+
+            const BiquadFilter& filter{effectDescriptor.filter};
+            BiquadFilter nextFilter{nextDescriptor.filter};
+
+            if (effectDescriptor.absorbedGain != 1.0) {
+                nextFilter.scale(effectDescriptor.absorbedGain);
+            }
+
+            for (Natural channel = 0;  channel < channelCount;  channel++) {
+                auto* sampleArray =
+                    _channelStart(channelArray, channel) + (size_t) position;
+                filter.applyBlockCascaded(nextFilter,
+                                          sampleArray, sampleArray, count,
+                                          filterStateList[channel],
+                                          nextFilterStateList[channel]);
+            }
+
+            if (isRamping) {
+                ramp.advance(count);
+                _setFilterToRamp(effectDescriptor);
+            }
+
+            if (nextIsRamping) {
+                nextRamp.advance(count);
+                _setFilterToRamp(nextDescriptor);
+            }
+
+            position += count;
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Clears the filter states of all channels in the filter
+     * section with <C>section</C>.
+     *
+     * @param[inout] section  descriptor of filter section
+     */
+    static void _clearFilterStates (INOUT _EffectDescriptor_FLTR& section)
+    {
+        for (BiquadFilterState& state : section.filterStateList) {
+            state.clear();
+        }
+
+        for (StateVariableFilterState& state : section.svfStateList) {
+            state.clear();
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Appends the processing state of filter section
+     * <C>section</C> (histories, current coefficients and ramps) to
+     * <C>stream</C>.
+     *
+     * @param[in]    section  descriptor of filter section
+     * @param[inout] stream   state stream to be written
+     */
+    static void _saveSectionState (IN _EffectDescriptor_FLTR& section,
+                                   INOUT DspStateStream& stream)
+    {
+        /* the kernels are function pointers, hence only whether
+           they belong to the target shape is stored */
+        const Boolean kernelsFitShape =
+            (section.blockKernel
+             == BiquadFilter::blockKernel(section.filterShape));
+        stream.writeList(section.filterStateList);
+        stream.write(section.filter);
+        stream.write(section.coefficientRamp);
+        stream.write(section.filterShape);
+        stream.write(kernelsFitShape);
+        stream.writeList(section.svfStateList);
+        stream.write(section.svFilter);
+        stream.write(section.svfParameterRamp);
+        stream.write(section.isStateVariable);
+        stream.write(section.processedSectionCount);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Reads the processing state of filter section <C>section</C>
+     * written by <C>_saveSectionState</C> from <C>stream</C>;
+     * pending coefficients are taken before, such that they do not
+     * override the restored ramps later.
+     *
+     * @param[inout] section  descriptor of filter section
+     * @param[inout] stream   state stream to be read
+     */
+    static void _restoreSectionState (INOUT _EffectDescriptor_FLTR& section,
+                                      INOUT DspStateStream& stream)
+    {
+        Boolean kernelsFitShape;
+        _acquireFilterCoefficients(section);
+        stream.readList(section.filterStateList);
+        stream.read(section.filter);
+        stream.read(section.coefficientRamp);
+        stream.read(section.filterShape);
+        stream.read(kernelsFitShape);
+        stream.readList(section.svfStateList);
+        stream.read(section.svFilter);
+        stream.read(section.svfParameterRamp);
+        stream.read(section.isStateVariable);
+        stream.read(section.processedSectionCount);
+        const BiquadFilterShape shape =
+            (kernelsFitShape ? section.filterShape
+             : BiquadFilterShape::general);
+        section.blockKernel = BiquadFilter::blockKernel(shape);
+        section.floatBlockKernel = BiquadFilter::floatBlockKernel(shape);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies all active filter sections of <C>effectDescriptor</C>
+     * in series in place to <C>sampleCount</C> samples in each of
+     * the <C>channelCount</C> channels of <C>channelArray</C>; each
+     * section runs over the complete block of all channels (with
+     * the kernels for channel pairs and quadruples) before the next
+     * one, hence the block stays in the cache for all sections.  An
+     * absorbed gain is folded into the first section and an
+     * absorbed filter is applied after the last section.
+     *
+     * @tparam       ChannelArray      type of channel container
+     * @param[inout] effectDescriptor  effect descriptor of filter
+     * @param[inout] channelArray      container of input and output
+     *                                 channels
+     * @param[in]    channelCount      number of channels
+     * @param[in]    sampleCount       number of samples per channel
+     */
+    template<typename ChannelArray>
+    static void
+    _applyFilterSections (INOUT _EffectDescriptor_FLTR& effectDescriptor,
+                          INOUT ChannelArray& channelArray,
+                          IN Natural channelCount,
+                          IN Natural sampleCount)
+    {
+        const Natural sectionCount = effectDescriptor.processedSectionCount;
+
+        for (Natural sectionIndex = 0;  sectionIndex < sectionCount;
+             sectionIndex++) {
+            _applyFilter(_section(effectDescriptor, sectionIndex),
+                         channelArray, channelCount, sampleCount);
+        }
+
+        if (effectDescriptor.cascadedDescriptor != nullptr) {
+            _applyFilter(*effectDescriptor.cascadedDescriptor,
+                         channelArray, channelCount, sampleCount);
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies the filter of <C>effectDescriptor</C> together with
+     * the effects absorbed for this block in place to
+     * <C>sampleCount</C> samples in each of the
+     * <C>channelCount</C> channels of <C>channelArray</C> and
+     * clears the absorbed effects afterwards; only biquads in
+     * direct form are fused into a single pass, state variable
+     * filters are applied one after the other.  Several filter
+     * sections are applied section by section; the states of
+     * sections becoming active are cleared.
+     *
+     * @tparam       ChannelArray      type of channel container
+     * @param[inout] effectDescriptor  effect descriptor of filter
+     * @param[inout] channelArray      container of input and output
+     *                                 channels
+     * @param[in]    channelCount      number of channels
+     * @param[in]    sampleCount       number of samples per channel
+     */
+    template<typename ChannelArray>
+    static void
+    _applyFusedFilter (INOUT _EffectDescriptor_FLTR& effectDescriptor,
+                       INOUT ChannelArray& channelArray,
+                       IN Natural channelCount,
+                       IN Natural sampleCount)
+    {
+        _EffectDescriptor_FLTR* nextDescriptor =
+            effectDescriptor.cascadedDescriptor;
+        const Natural sectionCount = effectDescriptor.sectionCount;
+
+        for (Natural sectionIndex = effectDescriptor.processedSectionCount;
+             sectionIndex < sectionCount;  sectionIndex++) {
+            _clearFilterStates(_section(effectDescriptor, sectionIndex));
+        }
+
+        effectDescriptor.processedSectionCount = sectionCount;
+
+        if (nextDescriptor != nullptr) {
+            /* only the first section of an absorbed filter is used */
+            _acquireFilterCoefficients(effectDescriptor);
+            _acquireFilterCoefficients(*nextDescriptor);
+            nextDescriptor->processedSectionCount = 1;
+        }
+
+        if (sectionCount > 1) {
+            _applyFilterSections(effectDescriptor, channelArray,
+                                 channelCount, sampleCount);
+        } else if (nextDescriptor == nullptr) {
+            _applyFilter(effectDescriptor, channelArray,
+                         channelCount, sampleCount);
+        } else if (effectDescriptor.isStateVariable
+                   || nextDescriptor->isStateVariable) {
+            _applyFilter(effectDescriptor, channelArray,
+                         channelCount, sampleCount);
+            _applyFilter(*nextDescriptor, channelArray,
+                         channelCount, sampleCount);
+        } else {
+            _applyFilterCascade(effectDescriptor, *nextDescriptor,
+                                channelArray, channelCount, sampleCount);
+        }
+
+        effectDescriptor.cascadedDescriptor = nullptr;
+        effectDescriptor.absorbedGain       = 1.0;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Updates effect parameters of the filter section with
+     * <C>sectionIndex</C> in <C>parameterMap</C> for filter kind
+     * given as <C>filterKind</C>.
+     *
+     * @param[inout] parameterMap  effect parameter map of filter
+     *                             effect to be initialized
+     * @param[in] filterKind       kind of filter to be set up
+     * @param[in] sectionIndex     index of filter section
+     */
+    static void
+    _updateParametersForKind (INOUT SoXEffectParameterMap& parameterMap,
+                              IN String& filterKind,
+                              IN Natural sectionIndex)
+    {
+        Logging_trace2(">>: kind = %1, section = %2",
+                       filterKind, TOSTRING(sectionIndex));
+        Assertion_pre(_kindList.contains(filterKind),
+                      "filter kind must be known");
+
+        const auto pagedName =
+            [sectionIndex] (IN String& parameterName) {
+                return _sectionParameterName(parameterName, sectionIndex);
+            };
+
+        _setBandwidthUnitParameter(parameterMap, filterKind, sectionIndex);
+
+        /* activate or deactivate parameter names */
+        Boolean isActive;
+        const String widgetDataString =
+            _filterKindToWidgetDataMap.at(filterKind);
+        const StringList widgetCodeList =
+            StringList::makeBySplit(widgetDataString, separator);
+
+        isActive = widgetCodeList.contains(paramFlag_biquad);
+        
+        for (String parameterName : _biquadFilterParameterNameList) {
+            parameterMap.setActiveness(pagedName(parameterName), isActive);
+        }
+
+        isActive = widgetCodeList.contains(paramFlag_poleCount);
+        parameterMap.setActiveness(pagedName(parameterName_poleCount),
+                                   isActive);
+
+        isActive = widgetCodeList.contains(paramFlag_dBGain);
+        parameterMap.setActiveness(pagedName(parameterName_dBGain), isActive);
+
+        isActive = widgetCodeList.contains(paramFlag_unpitchedMode);
+        parameterMap.setActiveness(pagedName(parameterName_unpitchedMode),
+                                   isActive);
+
+        isActive = widgetCodeList.contains(paramFlag_cstSkirtGain);
+        parameterMap.setActiveness(pagedName(parameterName_cstSkirtGain),
+                                   isActive);
+
+        isActive = widgetCodeList.contains(paramFlag_frequency);
+        parameterMap.setActiveness(pagedName(parameterName_frequency),
+                                   isActive);
+
+        isActive = widgetCodeList.contains(paramFlag_bandwidth);
+        parameterMap.setActiveness(pagedName(parameterName_bandwidth),
+                                   isActive);
+        parameterMap.setActiveness(pagedName(parameterName_bandwidthUnit),
+                                   isActive);
+
+        isActive = widgetCodeList.contains(paramFlag_equGain);
+        parameterMap.setActiveness(pagedName(parameterName_equGain), isActive);
+
+        isActive = widgetCodeList.contains(paramFlag_structure);
+        parameterMap.setActiveness(pagedName(parameterName_structure),
+                                   isActive);
+
+        Logging_trace1("<<: parameterMap = %1", parameterMap.toString());
+    }
+
+}
+
+/*============================================================*/
 
 /*---------------------*/
 /* setup & destruction */
@@ -826,49 +2282,11 @@ SoXFilter_AudioEffect::SoXFilter_AudioEffect ()
     /* initialize descriptor */
     _effectDescriptor = _createEffectDescriptor();
 
-    /* calculate list of bandwidth units */
-    const String filterKind = _kindList[0];
-    const StringList unitCodeList = _unitCodeListForKind(filterKind);
-    StringList bwUnitTextList;
-
-    if (unitCodeList.size() == 0) {
-        bwUnitTextList.append(_bwUnitText_quality);
-    } else {
-        for (Natural i = 0; i < unitCodeList.size(); i++) {
-            const String bandwidthUnitText =
-                _unitCodeToTextMap.at(unitCodeList[i]);
-            bwUnitTextList.append(bandwidthUnitText);
-        }
-    }
-
-    /* initialize parameters */
-    _effectParameterMap.clear();
-
-    /* first of all define kind of filter and all parameter names */
-    _effectParameterMap.setKindAndValueEnum(parameterName_kind,
-                                            _kindList, filterKind);
-    _effectParameterMap.setKindAndValueReal(parameterName_frequency,
-                                            10.0, 20000.0, 0.01, 1000.0);
-    _effectParameterMap.setKindAndValueReal(parameterName_bandwidth,
-                                            0.001, 20000.0, 0.001, 1.0);
-    _effectParameterMap.setKindAndValueEnum(parameterName_bandwidthUnit,
-                                            bwUnitTextList,
-                                            _bwUnitText_quality);
-    _effectParameterMap.setKindAndValueReal(parameterName_dBGain,
-                                            -25.0, 25.0, 0.01, 0.0);
-    _effectParameterMap.setKindAndValueEnum(parameterName_cstSkirtGain,
-                                            _yesNoList, "No");
-    _effectParameterMap.setKindAndValueReal(parameterName_equGain,
-                                            -25.0, 25.0, 0.01, 0.0);
-    _effectParameterMap.setKindAndValueReal(parameterName_poleCount,
-                                            1.0, 2.0, 1.0, 1.0);
-    _effectParameterMap.setKindAndValueEnum(parameterName_unpitchedMode,
-                                            _yesNoList, "No");
-
-    for (String parameterName : _biquadFilterParameterNameList) {
-        _effectParameterMap.setKindAndValueReal(parameterName,
-                                                -10.0, 10.0, 1e-6, 0.0);
-    }
+    /* initialize parameters from the definitions shared by all
+       instances */
+    static const SoXEffectParameterMap parameterMapPrototype =
+        _makeParameterMap();
+    _effectParameterMap = parameterMapPrototype;
 
     Logging_trace1("<<: %1", toString());
 }
@@ -878,7 +2296,15 @@ SoXFilter_AudioEffect::SoXFilter_AudioEffect ()
 SoXFilter_AudioEffect::~SoXFilter_AudioEffect ()
 {
     Logging_trace(">>");
-    delete (_EffectDescriptor_FLTR*) _effectDescriptor;
+
+    _EffectDescriptor_FLTR* effectDescriptor =
+        (_EffectDescriptor_FLTR*) _effectDescriptor;
+
+    for (_EffectDescriptor_FLTR* section : effectDescriptor->sectionList) {
+        delete section;
+    }
+
+    delete effectDescriptor;
     Logging_trace("<<");
 }
 
@@ -913,13 +2339,262 @@ String SoXFilter_AudioEffect::name() const
     return "SoX Filter";
 }
 
+/*--------------------*/
+
+Real SoXFilter_AudioEffect::tailLength () const
+{
+    _EffectDescriptor_FLTR& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_FLTR>(_effectDescriptor);
+
+    /* the decay is governed by the pole of largest magnitude in all
+       sections, that is the largest root of z^2 + a1 * z + a2 */
+    Real poleMagnitude{0.0};
+
+    for (Natural sectionIndex = 0;
+         sectionIndex < effectDescriptor.sectionCount;
+         sectionIndex++) {
+        const _EffectDescriptor_FLTR& section =
+            _section(effectDescriptor, sectionIndex);
+        const Real a1 = section.a1 / section.a0;
+        const Real a2 = section.a2 / section.a0;
+        const Real discriminant = a1 * a1 - Real{4.0} * a2;
+
+        if (discriminant < 0.0) {
+            /* complex conjugate poles with a product of a2 */
+            poleMagnitude = Real::maximum(poleMagnitude, a2.sqrt());
+        } else {
+            const Real root = discriminant.sqrt();
+            const Real magnitudeA = (-a1 + root).abs() / 2.0;
+            const Real magnitudeB = (-a1 - root).abs() / 2.0;
+            poleMagnitude = Real::maximum(poleMagnitude,
+                                          Real::maximum(magnitudeA,
+                                                        magnitudeB));
+        }
+    }
+
+    return SoXAudioHelper::decayTime(poleMagnitude, Real::one / _sampleRate);
+}
+
+/*--------------------*/
+/* memory footprint   */
+/*--------------------*/
+
+SoXMemoryFootprint SoXFilter_AudioEffect::memoryFootprint () const
+{
+    using FP = SoXMemoryFootprint;
+
+    _EffectDescriptor_FLTR& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_FLTR>(_effectDescriptor);
+    SoXMemoryFootprint result = SoXAudioEffect::memoryFootprint();
+    result.descriptorByteCount +=
+        FP::listByteCount(effectDescriptor.sectionList);
+
+    for (Natural sectionIndex = 0;  sectionIndex < _maxSectionCount;
+         sectionIndex++) {
+        const _EffectDescriptor_FLTR& section =
+            _section(effectDescriptor, sectionIndex);
+        result.descriptorByteCount +=
+            (Natural{sizeof(_EffectDescriptor_FLTR)}
+             + FP::stringByteCount(section.kind)
+             + FP::listByteCount(section.filterStateList)
+             + FP::listByteCount(section.svfStateList)
+             + section.responseCache.byteCount());
+    }
+
+    return result;
+}
+
+/*--------------------*/
+/* mono processing    */
+/*--------------------*/
+
+Boolean SoXFilter_AudioEffect::hasMonoProcessing () const
+{
+    return true;
+}
+
+/*--------------------*/
+
+void
+SoXFilter_AudioEffect::copyFirstChannelState (IN Natural channelCount)
+{
+    Logging_trace1(">>: %1", TOSTRING(channelCount));
+
+    _EffectDescriptor_FLTR& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_FLTR>(_effectDescriptor);
+
+    for (Natural sectionIndex = 0;
+         sectionIndex < effectDescriptor.processedSectionCount;
+         sectionIndex++) {
+        _EffectDescriptor_FLTR& section =
+            _section(effectDescriptor, sectionIndex);
+        _BiquadFilterStateList& filterStateList = section.filterStateList;
+        _SVFStateList& svfStateList = section.svfStateList;
+        filterStateList.ensureLength(channelCount);
+        svfStateList.ensureLength(channelCount);
+
+        for (Natural channel = 1;  channel < channelCount;  channel++) {
+            filterStateList[channel] = filterStateList[0];
+            svfStateList[channel]    = svfStateList[0];
+        }
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+Boolean SoXFilter_AudioEffect::hasIndependentChannels () const
+{
+    /* each channel has its own filter state and all channels share
+       the coefficients */
+    return true;
+}
+
+/*--------------------*/
+/* DSP state          */
+/*--------------------*/
+
+Boolean SoXFilter_AudioEffect::hasDspStateSupport () const
+{
+    return true;
+}
+
+/*--------------------*/
+
+void SoXFilter_AudioEffect::_saveDspState (INOUT DspStateStream& stream)
+    const
+{
+    Logging_trace(">>");
+
+    _EffectDescriptor_FLTR& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_FLTR>(_effectDescriptor);
+
+    for (Natural sectionIndex = 0;  sectionIndex < _maxSectionCount;
+         sectionIndex++) {
+        _saveSectionState(_section(effectDescriptor, sectionIndex),
+                          stream);
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXFilter_AudioEffect::_restoreDspState (INOUT DspStateStream& stream)
+{
+    Logging_trace(">>");
+
+    _EffectDescriptor_FLTR& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_FLTR>(_effectDescriptor);
+
+    for (Natural sectionIndex = 0;  sectionIndex < _maxSectionCount;
+         sectionIndex++) {
+        _restoreSectionState(_section(effectDescriptor, sectionIndex),
+                             stream);
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXFilter_AudioEffect::_resetDspState ()
+{
+    Logging_trace(">>");
+
+    _EffectDescriptor_FLTR& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_FLTR>(_effectDescriptor);
+
+    for (Natural sectionIndex = 0;  sectionIndex < _maxSectionCount;
+         sectionIndex++) {
+        _clearFilterStates(_section(effectDescriptor, sectionIndex));
+    }
+
+    if (effectDescriptor.cascadedDescriptor != nullptr) {
+        /* the state of an absorbed filter is updated in this pass */
+        _clearFilterStates(*effectDescriptor.cascadedDescriptor);
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* stage fusion       */
+/*--------------------*/
+
+Boolean SoXFilter_AudioEffect::absorbSuccessor (INOUT SoXAudioEffect* effect)
+{
+    Logging_trace1(">>: %1", effect->name());
+
+    _EffectDescriptor_FLTR& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_FLTR>(_effectDescriptor);
+    SoXFilter_AudioEffect* filterEffect =
+        dynamic_cast<SoXFilter_AudioEffect*>(effect);
+    Boolean isAbsorbed = false;
+    Real gain;
+
+    if (effect->hasConstantGain(gain)) {
+        /* a gain commutes with the filter and is folded into the
+           numerator of the last filter in the pass */
+        effectDescriptor.absorbedGain *= gain;
+        isAbsorbed = true;
+    } else if (filterEffect != nullptr
+               && filterEffect != this
+               && effectDescriptor.cascadedDescriptor == nullptr
+               && filterEffect->_sampleRate == _sampleRate) {
+        /* a single following filter with a single section runs in
+           the same pass */
+        _EffectDescriptor_FLTR* otherDescriptor =
+            (_EffectDescriptor_FLTR*) filterEffect->_effectDescriptor;
+
+        if (otherDescriptor->sectionCount == 1) {
+            effectDescriptor.cascadedDescriptor = otherDescriptor;
+            isAbsorbed = true;
+        }
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(isAbsorbed));
+    return isAbsorbed;
+}
+
+/*--------------------*/
+/* frequency response */
+/*--------------------*/
+
+Natural SoXFilter_AudioEffect::responseCurveCount () const
+{
+    return 1;
+}
+
+/*--------------------*/
+
+Boolean
+SoXFilter_AudioEffect::frequencyResponse (IN Natural curveIndex,
+                                          IN RealList& frequencyList,
+                                          OUT RealList& magnitudeList,
+                                          OUT RealList& phaseList) const
+{
+    Logging_trace1(">>: curveIndex = %1", TOSTRING(curveIndex));
+
+    const _EffectDescriptor_FLTR& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_FLTR>(_effectDescriptor);
+    const Boolean result =
+        effectDescriptor.responseCache.evaluate(curveIndex, frequencyList,
+                                                magnitudeList, phaseList);
+
+    Logging_trace1("<<: %1", TOSTRING(result));
+    return result;
+}
+
 /*--------------------*/
 /* parameter change   */
 /*--------------------*/
 
 SoXParameterValueChangeKind
 SoXFilter_AudioEffect::_setValueInternal
-                           (IN String& parameterName,
+                           (IN Natural parameterId,
+                            IN String& parameterName,
                             IN String& value,
                             IN Boolean recalculationIsForced)
 {
@@ -933,47 +2608,126 @@ SoXFilter_AudioEffect::_setValueInternal
     SoXParameterValueChangeKind result =
         SoXParameterValueChangeKind::parameterChange;
 
-    if (parameterName == parameterName_kind) {
-        _updateParametersForKind(_effectParameterMap, value);
-        effectDescriptor.kind = _effectParameterMap.value(parameterName);
+    /* the parameters of the further sections are laid out section
+       by section like those of the first section */
+    Natural sectionIndex = 0;
+    Natural sectionParameterId = parameterId;
+
+    if (parameterId >= Natural{parameterId_firstSectionParameter}) {
+        const Natural relativeId =
+            parameterId - Natural{parameterId_firstSectionParameter};
+        sectionIndex       = relativeId / _sectionParameterCount + 1;
+        sectionParameterId = relativeId % _sectionParameterCount;
+    }
+
+    _EffectDescriptor_FLTR& section =
+        _section(effectDescriptor, sectionIndex);
+
+    if ((int) parameterId == parameterId_sectionCount) {
+        const Natural sectionCount =
+            Natural::forceToInterval((Natural) _effectParameterMap
+                                     .numericValue(parameterId),
+                                     1, _maxSectionCount);
+        Logging_trace1("--: new sectionCount = %1",
+                       TOSTRING(sectionCount));
+        effectDescriptor.sectionCount = sectionCount;
+        _effectParameterMap.setNumericValue(parameterId,
+                                            Real{sectionCount});
+
+        if (recalculationIsForced) {
+            _updateResponseCurve(effectDescriptor, _sampleRate);
+        }
+
+        result = SoXParameterValueChangeKind::pageCountChange;
+    } else if ((int) parameterId == parameterId_sectionIndex) {
+        const Natural sectionNumber =
+            Natural::forceToInterval((Natural) _effectParameterMap
+                                     .numericValue(parameterId),
+                                     1, effectDescriptor.sectionCount);
+        _effectParameterMap.setNumericValue(parameterId,
+                                            Real{sectionNumber});
+        result = SoXParameterValueChangeKind::pageChange;
+    } else if ((int) sectionParameterId == parameterId_kind) {
+        _updateParametersForKind(_effectParameterMap, value, sectionIndex);
+        section.kind = _effectParameterMap.value(parameterName);
         result = SoXParameterValueChangeKind::globalChange;
     } else {
         Boolean effectIsUpdated =
             (recalculationIsForced
              && _effectParameterMap.isActive(parameterName));
 
-        if (parameterName == "a0") {
-            effectDescriptor.a0 = STR::toReal(value);
-        } else if (parameterName == "a1") {
-            effectDescriptor.a1 = STR::toReal(value);
-        } else if (parameterName == "a2") {
-            effectDescriptor.a2 = STR::toReal(value);
-        } else if (parameterName == "b0") {
-            effectDescriptor.b0 = STR::toReal(value);
-        } else if (parameterName == "b1") {
-            effectDescriptor.b1 = STR::toReal(value);
-        } else if (parameterName == "b2") {
-            effectDescriptor.b2 = STR::toReal(value);
-        } else if (parameterName == parameterName_bandwidth) {
-            effectDescriptor.bandwidth = STR::toReal(value);
-        } else if (parameterName == parameterName_bandwidthUnit) {
-            effectDescriptor.bandwidthUnit = _toBWUnit(value);
-        } else if (parameterName == parameterName_cstSkirtGain) {
-            effectDescriptor.usesConstantSkirtGain = (value == "Yes");
-        } else if (parameterName == parameterName_dBGain) {
-            effectDescriptor.dBGain = STR::toReal(value);
-        } else if (parameterName == parameterName_equGain) {
-            effectDescriptor.equGain = STR::toReal(value);
-        } else if (parameterName == parameterName_frequency) {
-            effectDescriptor.frequency = STR::toReal(value);
-        } else if (parameterName == parameterName_poleCount) {
-            effectDescriptor.isSinglePole = (STR::toReal(value) == 1.0);
-        } else if (parameterName == parameterName_unpitchedMode) {
-            effectDescriptor.usesUnpitchedAudioMode = (value == "Yes");
+        const Real numericValue =
+            _effectParameterMap.numericValue(parameterId);
+
+        switch ((int) sectionParameterId) {
+            case parameterId_a0:
+                section.a0 = numericValue;
+                break;
+
+            case parameterId_a1:
+                section.a1 = numericValue;
+                break;
+
+            case parameterId_a2:
+                section.a2 = numericValue;
+                break;
+
+            case parameterId_b0:
+                section.b0 = numericValue;
+                break;
+
+            case parameterId_b1:
+                section.b1 = numericValue;
+                break;
+
+            case parameterId_b2:
+                section.b2 = numericValue;
+                break;
+
+            case parameterId_bandwidth:
+                section.bandwidth = numericValue;
+                break;
+
+            case parameterId_bandwidthUnit:
+                section.bandwidthUnit = _toBWUnit(value);
+                break;
+
+            case parameterId_cstSkirtGain:
+                section.usesConstantSkirtGain = (value == "Yes");
+                break;
+
+            case parameterId_dBGain:
+                section.dBGain = numericValue;
+                break;
+
+            case parameterId_equGain:
+                section.equGain = numericValue;
+                break;
+
+            case parameterId_frequency:
+                section.frequency = numericValue;
+                break;
+
+            case parameterId_poleCount:
+                section.isSinglePole = (numericValue == 1.0);
+                break;
+
+            case parameterId_unpitchedMode:
+                section.usesUnpitchedAudioMode = (value == "Yes");
+                break;
+
+            case parameterId_structure:
+                section.usesStateVariableStructure =
+                    (value == _structureList[1]);
+                break;
+
+            default:
+                break;
         }
 
         if (effectIsUpdated) {
-            _updateFilterCoefficients(effectDescriptor, _sampleRate);
+            _updateFilterCoefficients(section, _sampleRate);
+            _updateResponseCurve(effectDescriptor, _sampleRate);
         }
     }
 
@@ -983,11 +2737,38 @@ SoXFilter_AudioEffect::_setValueInternal
 
 /*--------------------*/
 
+void SoXFilter_AudioEffect::recalculateSettings ()
+{
+    Logging_trace(">>");
+
+    _EffectDescriptor_FLTR& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_FLTR>(_effectDescriptor);
+
+    for (Natural sectionIndex = 0;  sectionIndex < _maxSectionCount;
+         sectionIndex++) {
+        _updateFilterCoefficients(_section(effectDescriptor, sectionIndex),
+                                  _sampleRate);
+    }
+
+    _updateResponseCurve(effectDescriptor, _sampleRate);
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
 void SoXFilter_AudioEffect::setDefaultValues () {
     Logging_trace(">>");
-    const String filterKind =
-        _effectParameterMap.value(parameterName_kind);
-    _updateParametersForKind(_effectParameterMap, filterKind);
+
+    for (Natural sectionIndex = 0;  sectionIndex < _maxSectionCount;
+         sectionIndex++) {
+        const String filterKind =
+            _effectParameterMap.value(_sectionParameterName(parameterName_kind,
+                                                            sectionIndex));
+        _updateParametersForKind(_effectParameterMap, filterKind,
+                                 sectionIndex);
+    }
+
     Logging_trace1("<<: %1", toString());
 }
 
@@ -999,15 +2780,40 @@ void SoXFilter_AudioEffect::prepareToPlay (IN Real sampleRate)
 {
     Logging_trace1(">>: %1", TOSTRING(sampleRate));
 
-    if (sampleRate != _sampleRate) {
-        _EffectDescriptor_FLTR& effectDescriptor =
-            TOREFERENCE<_EffectDescriptor_FLTR>(_effectDescriptor);
-        _sampleRate = sampleRate;
+    _EffectDescriptor_FLTR& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_FLTR>(_effectDescriptor);
+    const Boolean sampleRateIsChanged = (sampleRate != _sampleRate);
+    const Natural rampLength =
+        SoXRamp_sampleCount(sampleRate, _coefficientRampDuration);
+    _sampleRate = sampleRate;
+
+    for (Natural sectionIndex = 0;  sectionIndex < _maxSectionCount;
+         sectionIndex++) {
+        _EffectDescriptor_FLTR& section =
+            _section(effectDescriptor, sectionIndex);
+
+        if (sampleRateIsChanged) {
+            /* filter has to be recalculated */
+            _updateFilterCoefficients(section, _sampleRate);
+        }
+
+        /* later coefficient changes are ramped, the current ones
+           are taken immediately */
+        _acquireFilterCoefficients(section);
+        section.coefficientRamp
+            .setRampLength(rampLength, _coefficientRampSubBlockLength);
+        section.svfParameterRamp
+            .setRampLength(rampLength, _coefficientRampSubBlockLength);
+        _setFilterToRamp(section);
+        _selectFilterKernels(section, true);
+        _setStateVariableFilterToRamp(section);
+    }
 
-        /* filter has to be recalculated */
-        _updateFilterCoefficients(effectDescriptor, _sampleRate);
+    if (sampleRateIsChanged) {
+        _updateResponseCurve(effectDescriptor, _sampleRate);
     }
 
+    SoXAudioEffect::prepareToPlay(sampleRate);
     Logging_trace("<<");
 }
 
@@ -1017,35 +2823,71 @@ void
 SoXFilter_AudioEffect::processBlock (IN Real timePosition,
                                      INOUT AudioSampleListVector& buffer)
 {
-    Logging_trace1(">>: time = %1", TOSTRING(timePosition));
+    Logging_traceHot1(">>: time = %1", TOSTRING(timePosition));
 
     SoXAudioEffect::processBlock(timePosition, buffer);
 
     _EffectDescriptor_FLTR& effectDescriptor =
         TOREFERENCE<_EffectDescriptor_FLTR>(_effectDescriptor);
     const Natural sampleCount = buffer[0].size();
-    IIRFilter& filter{effectDescriptor.filter};
-    AudioSampleRingBufferVector& sampleRingBufferVector =
-        effectDescriptor.sampleRingBufferVector;
-
-    for (Natural channel = 0;  channel < _channelCount;
-         channel++) {
-        AudioSampleRingBuffer& inputSampleRingBuffer =
-            sampleRingBufferVector.at(channel, 0);
-        AudioSampleRingBuffer& outputSampleRingBuffer =
-            sampleRingBufferVector.at(channel, 1);
-        const AudioSampleList& inputList = buffer[channel];
-        AudioSampleList& outputList = buffer[channel];
-
-        for (Natural i = 0;  i < sampleCount;  i++) {
-            const AudioSample inputSample = inputList[i];
-            AudioSample& outputSample     = outputList[i];
-            inputSampleRingBuffer.shiftRight(inputSample);
-            outputSampleRingBuffer.shiftRight(0.0);
-            filter.apply(inputSampleRingBuffer, outputSampleRingBuffer);
-            outputSample = outputSampleRingBuffer.first();
-        }
-    }
+    _applyFusedFilter(effectDescriptor, buffer, _channelCount, sampleCount);
+    _guardFiniteness(buffer);
 
-    Logging_trace("<<");
+    Logging_traceHot("<<");
+}
+
+/*--------------------*/
+
+Boolean SoXFilter_AudioEffect::hasFloatProcessing () const
+{
+    return true;
+}
+
+/*--------------------*/
+
+void
+SoXFilter_AudioEffect::processFloatBlock (IN Real timePosition,
+                                          INOUT float* const* channelArray,
+                                          IN Natural channelCount,
+                                          IN Natural sampleCount)
+{
+    Logging_traceHot1(">>: time = %1", TOSTRING(timePosition));
+
+    _startBlock(timePosition, channelCount, sampleCount);
+
+    _EffectDescriptor_FLTR& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_FLTR>(_effectDescriptor);
+    _applyFusedFilter(effectDescriptor, channelArray, _channelCount,
+                      sampleCount);
+    _guardFiniteness(channelArray, _channelCount, sampleCount);
+
+    Logging_traceHot("<<");
+}
+
+/*--------------------*/
+
+Boolean SoXFilter_AudioEffect::hasDoubleProcessing () const
+{
+    return true;
+}
+
+/*--------------------*/
+
+void
+SoXFilter_AudioEffect::processDoubleBlock (IN Real timePosition,
+                                           INOUT double* const* channelArray,
+                                           IN Natural channelCount,
+                                           IN Natural sampleCount)
+{
+    Logging_traceHot1(">>: time = %1", TOSTRING(timePosition));
+
+    _startBlock(timePosition, channelCount, sampleCount);
+
+    _EffectDescriptor_FLTR& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_FLTR>(_effectDescriptor);
+    _applyFusedFilter(effectDescriptor, channelArray, _channelCount,
+                      sampleCount);
+    _guardFiniteness(channelArray, _channelCount, sampleCount);
+
+    Logging_traceHot("<<");
 }
@@ -34,8 +34,14 @@ namespace SoXPlugins::Effects::SoXFilter {
      * <B>bandpass</B>, <B>bandreject</B>, <B>bass</B>, <B>biquad</B>,
      * <B>equalizer</B>, <B>highpass</B>, <B>lowpass</B> and
      * <B>treble</B> into a single plugin.
+     *
+     * Up to eight filter sections can be applied in series (like
+     * for an equalizer with several bands): the first section has
+     * the plain parameter names, the further sections are on the
+     * pages with their section number.  Each section processes the
+     * complete block of all channels before the next one.
      */
-    struct SoXFilter_AudioEffect : public SoXAudioEffect {
+    struct SoXFilter_AudioEffect final : public SoXAudioEffect {
 
         /*---------------------*/
         /* setup & destruction */
@@ -59,10 +65,70 @@ namespace SoXPlugins::Effects::SoXFilter {
 
         String name () const override;
 
+        /*--------------------*/
+
+        Real tailLength () const override;
+
+        /*--------------------*/
+        /* memory footprint   */
+        /*--------------------*/
+
+        SoXMemoryFootprint memoryFootprint () const override;
+
+        /*--------------------*/
+        /* mono processing    */
+        /*--------------------*/
+
+        Boolean hasMonoProcessing () const override;
+
+        /*--------------------*/
+
+        void copyFirstChannelState (IN Natural channelCount) override;
+
+        /*--------------------*/
+
+        Boolean hasIndependentChannels () const override;
+
+        /*--------------------*/
+        /* DSP state          */
+        /*--------------------*/
+
+        Boolean hasDspStateSupport () const override;
+
+        /*--------------------*/
+        /* stage fusion       */
+        /*--------------------*/
+
+        Boolean absorbSuccessor (INOUT SoXAudioEffect* effect) override;
+
+        /*--------------------*/
+        /* frequency response */
+        /*--------------------*/
+
+        /**
+         * Returns the number of response curves of the filter,
+         * which is one.
+         *
+         * @return  count of response curves
+         */
+        Natural responseCurveCount () const override;
+
+        /*--------------------*/
+
+        Boolean frequencyResponse (IN Natural curveIndex,
+                                   IN RealList& frequencyList,
+                                   OUT RealList& magnitudeList,
+                                   OUT RealList& phaseList)
+            const override;
+
         /*--------------------*/
         /* parameter change   */
         /*--------------------*/
 
+        void recalculateSettings () override;
+
+        /*--------------------*/
+
         void setDefaultValues () override;
 
         /*--------------------*/
@@ -78,6 +144,30 @@ namespace SoXPlugins::Effects::SoXFilter {
                            INOUT AudioSampleListVector& buffer)
             override;
 
+        /*--------------------*/
+
+        Boolean hasFloatProcessing () const override;
+
+        /*--------------------*/
+
+        void processFloatBlock (IN Real timePosition,
+                                INOUT float* const* channelArray,
+                                IN Natural channelCount,
+                                IN Natural sampleCount)
+            override;
+
+        /*--------------------*/
+
+        Boolean hasDoubleProcessing () const override;
+
+        /*--------------------*/
+
+        void processDoubleBlock (IN Real timePosition,
+                                 INOUT double* const* channelArray,
+                                 IN Natural channelCount,
+                                 IN Natural sampleCount)
+            override;
+
         /*--------------------*/
         /*--------------------*/
 
@@ -89,11 +179,26 @@ namespace SoXPlugins::Effects::SoXFilter {
             /*--------------------*/
 
             SoXParameterValueChangeKind
-            _setValueInternal (IN String& parameterName,
+            _setValueInternal (IN Natural parameterId,
+                               IN String& parameterName,
                                IN String& value,
                                IN Boolean recalculationIsForced)
                 override;
 
+            /*--------------------*/
+
+            void _saveDspState (INOUT DspStateStream& stream) const
+                override;
+
+            /*--------------------*/
+
+            void _restoreDspState (INOUT DspStateStream& stream)
+                override;
+
+            /*--------------------*/
+
+            void _resetDspState () override;
+
     };
 
 }
@@ -38,7 +38,7 @@ namespace SoXPlugins::Effects::SoXFilter {
         SoXFilter_AudioProcessor ()
         {
             Logging_initializeWithDefaults("SoXFilter", "SoXPlugins.");
-            _setAssociatedEffect(new SoXFilter_AudioEffect{});
+            _setAssociatedEffect(_makeEffect());
         }
 
         /*--------------------*/
@@ -48,6 +48,15 @@ namespace SoXPlugins::Effects::SoXFilter {
             return String("SoXFilter");
         }
 
+        /*--------------------*/
+
+        protected:
+
+            SoXAudioEffect* _makeEffect () const override
+            {
+                return new SoXFilter_AudioEffect{};
+            }
+
     };
 
 }
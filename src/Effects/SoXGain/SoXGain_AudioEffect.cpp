@@ -16,14 +16,39 @@
 /* IMPORTS */
 /*=========*/
 
+#include <algorithm>
+#include <cmath>
+
+#include "AudioSampleRingBufferVector.h"
+#include "Kernels.h"
 #include "Logging.h"
 #include "SoXAudioHelper.h"
 #include "SoXGain_AudioEffect.h"
+#include "SoXParameterSmoother.h"
+
+#if defined(AUDIO_USES_SIMD)
+    #if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+        #include <emmintrin.h>
+        /** SSE2 is used for the knee of the limiter */
+        #define SoXGain_usesSSE2
+    #elif defined(__aarch64__) || defined(_M_ARM64)
+        #include <arm_neon.h>
+        /** NEON is used for the knee of the limiter */
+        #define SoXGain_usesNEON
+    #endif
+#endif
 
 /*--------------------*/
 
+using Audio::AudioSampleRingBuffer;
+using Audio::AudioSampleRingBufferVector;
+using Audio::Kernels;
+using BaseTypes::GenericTypes::GenericList;
 using SoXPlugins::Effects::SoXGain::SoXGain_AudioEffect;
 using SoXPlugins::Helpers::SoXAudioHelper;
+using SoXPlugins::Helpers::SoXRamp_sampleCount;
+using SoXPlugins::Helpers::SoXRampKind;
+using SoXPlugins::Helpers::SoXScalarSmoother;
 
 /** abbreviation for StringUtil */
 using STR = BaseModules::StringUtil;
@@ -32,16 +57,487 @@ using STR = BaseModules::StringUtil;
 
 namespace SoXPlugins::Effects::SoXGain {
 
+    /** the possible values of a yes-no-combobox (in English
+     * language) */
+    static const StringList _yesNoList =
+        StringList::makeBySplit("Yes/No", "/");
+
+    /** the number of frames processed at once by the lookahead
+     * limiter */
+    static const Natural _limiterChunkLength = 64;
+
+    /** the number of channels the limiter is set up for before
+     * the first block */
+    static const Natural _initialChannelCount = 2;
+
+    /** the default limit of the limiter (in dB) */
+    static const Real _defaultLimitInDb = -1.0;
+
+    /*--------------------*/
+
+    /**
+     * A <C>_PeakLimiter</C> object limits the peaks of a signal to
+     * a level by a soft knee: below half of the level (6dB below)
+     * samples pass unchanged, above it the excess is compressed
+     * smoothly such that the level is approached asymptotically.
+     *
+     * Without lookahead each sample is shaped by this knee curve
+     * independently (like the limiter of SoX).  With a lookahead of
+     * <C>n</C> samples all channels are delayed by <C>n</C> and
+     * attenuated by a common gain instead: the gain required by the
+     * knee curve for the peak of each frame is reduced to the
+     * minimum over a window of <C>n + 1</C> frames and then
+     * smoothed by a moving average over the same number of frames;
+     * hence the gain ramps down in the lookahead time before a peak
+     * and reaches the required gain when the peak arrives.
+     */
+    struct _PeakLimiter {
+
+        /** the limit of the output level as a factor */
+        Real limit;
+
+        /** the lookahead in samples (zero for the limiting by the
+         * knee curve per sample) */
+        Natural lookaheadSampleCount;
+
+        /** the delay line per channel for the lookahead */
+        AudioSampleRingBufferVector delayLineVector;
+
+        /** the sample pointers per channel of the current block */
+        GenericList<double*> channelPointerList;
+
+        /** the values of the monotonic queue for the window
+         * minimum of the required gains (a ring of window length) */
+        RealList queueValueList;
+
+        /** the frame indices of the entries in the monotonic
+         * queue */
+        GenericList<size_t> queueIndexList;
+
+        /** the ring index of the oldest queue entry */
+        size_t queueStart;
+
+        /** the number of entries in the queue */
+        size_t queueLength;
+
+        /** the window minima of the last frames for the moving
+         * average (a ring of window length) */
+        RealList windowList;
+
+        /** the ring index of the oldest window minimum */
+        size_t windowPosition;
+
+        /** the index of the next frame */
+        size_t frameIndex;
+
+        /** the gains of the frames of a chunk */
+        RealList gainList;
+
+        /** the delayed samples of a channel for a chunk */
+        RealList delayedList;
+
+        /*--------------------*/
+        /*--------------------*/
+
+        /**
+         * Makes a limiter to the default limit without lookahead.
+         */
+        _PeakLimiter ()
+            : limit{SoXAudioHelper::dBToLinear(_defaultLimitInDb)},
+              lookaheadSampleCount{0},
+              delayLineVector{},
+              channelPointerList{},
+              queueValueList{},
+              queueIndexList{},
+              queueStart{0},
+              queueLength{0},
+              windowList{},
+              windowPosition{0},
+              frameIndex{0},
+              gainList{},
+              delayedList{}
+        {
+            gainList.setLength(_limiterChunkLength);
+            delayedList.setLength(_limiterChunkLength);
+            ensureChannelCount(_initialChannelCount);
+            setLookahead(0);
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns limiter string representation.
+         *
+         * @return  string representation of limiter
+         */
+        String toString () const
+        {
+            return STR::expand("_PeakLimiter(limit = %1,"
+                               " lookaheadSampleCount = %2)",
+                               TOSTRING(limit),
+                               TOSTRING(lookaheadSampleCount));
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of bytes of the buffers of the
+         * limiter.
+         *
+         * @return  count of bytes in buffers
+         */
+        Natural byteCount () const
+        {
+            using FP = SoXMemoryFootprint;
+            return (delayLineVector.byteCount()
+                    + FP::listByteCount(channelPointerList)
+                    + FP::listByteCount(queueValueList)
+                    + FP::listByteCount(queueIndexList)
+                    + FP::listByteCount(windowList)
+                    + FP::listByteCount(gainList)
+                    + FP::listByteCount(delayedList));
+        }
+
+        /*--------------------*/
+
+        /**
+         * Sets the lookahead to <C>sampleCount</C> samples and
+         * resets the state; allocates when the lookahead grows.
+         *
+         * @param[in] sampleCount  lookahead in samples
+         */
+        void setLookahead (IN Natural sampleCount)
+        {
+            const Natural windowLength = sampleCount + 1;
+            lookaheadSampleCount = sampleCount;
+            queueValueList.setLength(windowLength);
+            queueIndexList.setLength(windowLength);
+            windowList.setLength(windowLength);
+            delayLineVector.setRingBufferLength(sampleCount);
+            reset();
+        }
+
+        /*--------------------*/
+
+        /**
+         * Sets the delay lines to silence and the gain to one.
+         */
+        void reset ()
+        {
+            delayLineVector.setToZero();
+            queueStart = 0;
+            queueLength = 0;
+            windowPosition = 0;
+            frameIndex = 0;
+
+            for (Real& windowMinimum : windowList) {
+                windowMinimum = 1.0;
+            }
+        }
+
+        /*--------------------*/
+
+        /**
+         * Ensures that the limiter has delay lines for at least
+         * <C>channelCount</C> channels; allocates only when the
+         * channel count grows beyond all previous counts and then
+         * silences all delay lines (keeping their length).
+         *
+         * @param[in] channelCount  number of channels
+         */
+        void ensureChannelCount (IN Natural channelCount)
+        {
+            if (delayLineVector.ringBufferCount() < channelCount) {
+                delayLineVector.resize(channelCount, 1);
+                delayLineVector.setRingBufferLength(lookaheadSampleCount);
+                channelPointerList.setLength(channelCount);
+            }
+        }
+
+        /*--------------------*/
+
+        /**
+         * Appends the delay lines, the window minimum queue and the
+         * moving average window to <C>stream</C>.
+         *
+         * @param[inout] stream  state stream to be written
+         */
+        void saveState (INOUT DspStateStream& stream) const
+        {
+            delayLineVector.saveState(stream);
+            stream.writeList(queueValueList);
+            stream.writeList(queueIndexList);
+            stream.write(queueStart);
+            stream.write(queueLength);
+            stream.writeList(windowList);
+            stream.write(windowPosition);
+            stream.write(frameIndex);
+        }
+
+        /*--------------------*/
+
+        /**
+         * Reads the state written by <C>saveState</C> from
+         * <C>stream</C> for <C>channelCount</C> channels; the lists
+         * must already have the lengths for the current lookahead.
+         *
+         * @param[inout] stream        state stream to be read
+         * @param[in]    channelCount  number of channels
+         */
+        void restoreState (INOUT DspStateStream& stream,
+                           IN Natural channelCount)
+        {
+            ensureChannelCount(channelCount);
+            delayLineVector.restoreState(stream);
+            stream.readArray(queueValueList.asArray(),
+                             queueValueList.length());
+            stream.readArray(queueIndexList.asArray(),
+                             queueIndexList.length());
+            stream.read(queueStart);
+            stream.read(queueLength);
+            stream.readArray(windowList.asArray(), windowList.length());
+            stream.read(windowPosition);
+            stream.read(frameIndex);
+        }
+
+        /*--------------------*/
+
+        /**
+         * Copies the delay line of the first channel to the other
+         * channels up to <C>channelCount</C>.
+         *
+         * @param[in] channelCount  number of channels to be set
+         */
+        void copyFirstChannelState (IN Natural channelCount)
+        {
+            ensureChannelCount(channelCount);
+
+            for (Natural channel = 1;  channel < channelCount;
+                 channel++) {
+                delayLineVector.at(channel) = delayLineVector.at(0);
+            }
+        }
+
+        /*--------------------*/
+
+        /**
+         * Replaces the <C>count</C> peak values in
+         * <C>valueArray</C> by the gains needed to bring them onto
+         * the knee curve: a peak <C>p</C> gets <C>f(q)/q</C> with
+         * <C>q = max(p, t)</C>, where <C>f</C> is the knee curve and
+         * <C>t</C> the start of the knee, hence peaks below the knee
+         * get a gain of exactly one.
+         *
+         * @param[inout] valueArray  peaks of frames replaced by
+         *                           gains
+         * @param[in]    count       number of values
+         */
+        void _setRequiredGains (INOUT double* valueArray,
+                                IN size_t count) const
+        {
+            const double kneeStart = (double) limit * 0.5;
+            const double kneeWidth = (double) limit - kneeStart;
+
+            for (size_t i = 0;  i < count;  i++) {
+                const double peak = std::max(valueArray[i], kneeStart);
+                const double excess = peak - kneeStart;
+                valueArray[i] =
+                    (kneeStart
+                     + excess * kneeWidth / (excess + kneeWidth)) / peak;
+            }
+        }
+
+        /*--------------------*/
+
+        /**
+         * Replaces the <C>count</C> required gains in
+         * <C>gainArray</C> by the smoothed lookahead gains: the
+         * minimum over the window of the last frames is taken from
+         * a monotonic queue and then averaged over the window.
+         *
+         * @param[inout] gainArray  required gains of frames replaced
+         *                          by effective gains
+         * @param[in]    count      number of gains
+         */
+        void _smoothGains (INOUT double* gainArray,
+                           IN size_t count)
+        {
+            const size_t windowLength = windowList.size();
+            double* queueValueArray = (double*) queueValueList.asArray();
+            size_t* queueIndexArray = queueIndexList.asArray();
+            double* windowArray = (double*) windowList.asArray();
+
+            /* the sum is recalculated per chunk to avoid a drift */
+            double windowSum = 0.0;
+
+            for (size_t i = 0;  i < windowLength;  i++) {
+                windowSum += windowArray[i];
+            }
+
+            for (size_t i = 0;  i < count;  i++) {
+                const double value = gainArray[i];
+
+                /* the oldest entry leaves the window, later entries
+                   with larger gains are never a minimum again */
+                if (queueLength > 0
+                    && queueIndexArray[queueStart] + windowLength
+                       <= frameIndex) {
+                    queueStart = (queueStart + 1) % windowLength;
+                    queueLength--;
+                }
+
+                while (queueLength > 0
+                       && (queueValueArray[(queueStart + queueLength - 1)
+                                           % windowLength]
+                           >= value)) {
+                    queueLength--;
+                }
+
+                const size_t queueEnd =
+                    (queueStart + queueLength) % windowLength;
+                queueValueArray[queueEnd] = value;
+                queueIndexArray[queueEnd] = frameIndex;
+                queueLength++;
+
+                const double minimum = queueValueArray[queueStart];
+                windowSum += minimum - windowArray[windowPosition];
+                windowArray[windowPosition] = minimum;
+                windowPosition = (windowPosition + 1) % windowLength;
+                gainArray[i] = windowSum / (double) windowLength;
+                frameIndex++;
+            }
+        }
+
+        /*--------------------*/
+
+        /**
+         * Applies the lookahead limiter in place to the frames
+         * from <C>position</C> to <C>position + count</C> of the
+         * <C>channelCount</C> channels in <C>channelArray</C>.
+         *
+         * @param[inout] channelArray  array of pointers to the
+         *                             samples per channel
+         * @param[in]    channelCount  number of channels
+         * @param[in]    position      index of first frame
+         * @param[in]    count         number of frames (at most the
+         *                             chunk length)
+         */
+        void _processChunk (INOUT double* const* channelArray,
+                            IN Natural channelCount,
+                            IN Natural position,
+                            IN Natural count)
+        {
+            double* gainArray = (double*) gainList.asArray();
+            double* delayedArray = (double*) delayedList.asArray();
+            const size_t frameCount = (size_t) count;
+
+            /* the peak of each frame over all channels */
+            for (size_t i = 0;  i < frameCount;  i++) {
+                gainArray[i] = 0.0;
+            }
+
+            for (Natural channel = 0;  channel < channelCount;
+                 channel++) {
+                const double* sampleArray =
+                    channelArray[(size_t) channel] + (size_t) position;
+
+                for (size_t i = 0;  i < frameCount;  i++) {
+                    gainArray[i] = std::max(gainArray[i],
+                                            std::abs(sampleArray[i]));
+                }
+            }
+
+            _setRequiredGains(gainArray, frameCount);
+            _smoothGains(gainArray, frameCount);
+
+            /* delay and attenuate each channel */
+            const Natural delayLength = lookaheadSampleCount;
+
+            for (Natural channel = 0;  channel < channelCount;
+                 channel++) {
+                double* sampleArray =
+                    channelArray[(size_t) channel] + (size_t) position;
+                AudioSampleRingBuffer& delayLine =
+                    delayLineVector.at(channel);
+
+                /* audio samples have the layout of doubles */
+                AudioSample* delayedSampleArray =
+                    (AudioSample*) delayedArray;
+                const AudioSample* inputArray =
+                    (const AudioSample*) sampleArray;
+
+                if (count <= delayLength) {
+                    delayLine.readBlock(0, delayedSampleArray, count);
+                    delayLine.writeBlock(inputArray, count);
+                } else {
+                    /* the delayed chunk is the complete delay line
+                       followed by the start of the input chunk */
+                    const size_t remainingCount =
+                        (size_t) (count - delayLength);
+                    delayLine.readBlock(0, delayedSampleArray,
+                                        delayLength);
+                    std::copy(sampleArray, sampleArray + remainingCount,
+                              delayedArray + (size_t) delayLength);
+                    delayLine.writeBlock(inputArray + remainingCount,
+                                         delayLength);
+                }
+
+                for (size_t i = 0;  i < frameCount;  i++) {
+                    sampleArray[i] = delayedArray[i] * gainArray[i];
+                }
+            }
+        }
+
+        /*--------------------*/
+
+        /**
+         * Applies the lookahead limiter in place to the
+         * <C>sampleCount</C> frames of the <C>channelCount</C>
+         * channels in <C>channelArray</C>.
+         *
+         * @param[inout] channelArray  array of pointers to the
+         *                             samples per channel
+         * @param[in]    channelCount  number of channels
+         * @param[in]    sampleCount   number of samples per channel
+         */
+        void processWithLookahead (INOUT double* const* channelArray,
+                                   IN Natural channelCount,
+                                   IN Natural sampleCount)
+        {
+            for (Natural position = 0;  position < sampleCount;
+                 position += _limiterChunkLength) {
+                const Natural count =
+                    Natural::minimum(_limiterChunkLength,
+                                     sampleCount - position);
+                _processChunk(channelArray, channelCount,
+                              position, count);
+            }
+        }
+
+    };
+
+    /*--------------------*/
+
     /**
      * An <C>_EffectDescriptor_GAIN</C> object is the internal
      * implementation of a gain effect descriptor type where all
      * sample input is routed to and sample output is routed from with
-     * a single gain factor parameter.
+     * a single gain factor parameter and an optional peak limiter.
      */
     struct _EffectDescriptor_GAIN {
 
-        /** the gain (as a real factor) */
-        Real gain;
+        /** the gain (as a real factor) ramping exponentially to
+         * new values */
+        SoXScalarSmoother gain{SoXRampKind::exponential};
+
+        /** tells whether the peak limiter is active */
+        Boolean limiterIsActive{false};
+
+        /** the lookahead of the limiter in seconds */
+        Real lookahead{0.0};
+
+        /** the peak limiter after the gain */
+        _PeakLimiter limiter{};
 
         /*--------------------*/
         /*--------------------*/
@@ -49,22 +545,76 @@ namespace SoXPlugins::Effects::SoXGain {
         String toString() const
         {
             String st =
-                STR::expand("_EffectDescriptor_GAIN(gain = %1dB)",
-                            TOSTRING(gain));
+                STR::expand("_EffectDescriptor_GAIN(gain = %1,"
+                            " limiterIsActive = %2, lookahead = %3s,"
+                            " limiter = %4)",
+                            gain.toString(), TOSTRING(limiterIsActive),
+                            TOSTRING(lookahead), limiter.toString());
             return st;
         }
 
+        /*--------------------*/
+
+        /**
+         * Tells whether the limiter is active with a lookahead
+         * (such that its channels are linked and delayed).
+         *
+         * @return  information whether a lookahead is used
+         */
+        Boolean hasLookahead () const
+        {
+            return limiterIsActive && limiter.lookaheadSampleCount > 0;
+        }
+
     };
 
     /*====================*/
 
     /** the parameter name of the gain parameter */
-    static const String parameterName_gain   = "Gain [dB]";
+    static const String parameterName_gain      = "Gain [dB]";
+
+    /** the parameter name of the limiter switch */
+    static const String parameterName_limiter   = "Limiter?";
+
+    /** the parameter name of the limit of the limiter */
+    static const String parameterName_limit     = "Limit [dB]";
+
+    /** the parameter name of the lookahead of the limiter */
+    static const String parameterName_lookahead = "Lookahead [ms]";
+
+    /** the identifications of the parameters in the parameter map
+     * (in order of definition) */
+    enum _ParameterId {
+        parameterId_gain, parameterId_limiter, parameterId_limit,
+        parameterId_lookahead
+    };
+
+    /** the duration of a gain ramp (in seconds) */
+    static const Real _gainRampDuration = 0.02;
 
     /*--------------------*/
     /* internal routines  */
     /*--------------------*/
 
+    /**
+     * Sets the lookahead of the limiter in <C>effectDescriptor</C>
+     * for <C>sampleRate</C> from the lookahead time.
+     *
+     * @param[inout] effectDescriptor  gain parameters and state
+     * @param[in]    sampleRate        the current sample rate
+     */
+    static void
+    _updateLookahead (INOUT _EffectDescriptor_GAIN& effectDescriptor,
+                      IN Real sampleRate)
+    {
+        const Natural sampleCount =
+            (Natural) Real::round(effectDescriptor.lookahead
+                                  * sampleRate);
+        effectDescriptor.limiter.setLookahead(sampleCount);
+    }
+
+    /*--------------------*/
+
     /**
      * Sets up a new gain effect descriptor and returns it.
      *
@@ -74,15 +624,301 @@ namespace SoXPlugins::Effects::SoXGain {
     {
         Logging_trace(">>");
 
-        _EffectDescriptor_GAIN* result =
-            new _EffectDescriptor_GAIN{
-                0.0 /* gain */
-            };
+        _EffectDescriptor_GAIN* result = new _EffectDescriptor_GAIN{};
 
         Logging_trace1("<<: %1", result->toString());
         return result;
     }
 
+    /*--------------------*/
+
+    /**
+     * Returns a parameter map with the definitions of all gain
+     * parameters; this is done once per process and the map is used
+     * as a prototype for each effect instance.
+     *
+     * @return parameter map with all parameter definitions
+     */
+    static SoXEffectParameterMap _makeParameterMap ()
+    {
+        Logging_trace(">>");
+
+        SoXEffectParameterMap result;
+
+        result.setKindReal(parameterName_gain,
+                           -100.0, 100.0, 0.001);
+        result.setKindEnum(parameterName_limiter, _yesNoList);
+        result.setKindReal(parameterName_limit, -20.0, 0.0, 0.1);
+        result.setKindReal(parameterName_lookahead, 0.0, 10.0, 0.1);
+
+        Logging_trace("<<");
+        return result;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Multiplies the <C>sampleCount</C> float samples in
+     * <C>sampleArray</C> in place by a linear gain ramp: sample
+     * <C>i</C> gets the factor <C>startGain + gainIncrement * (i +
+     * 1)</C>; a zero increment gives a constant gain.
+     *
+     * @param[inout] sampleArray    array of samples to be processed
+     * @param[in]    sampleCount    number of samples in array
+     * @param[in]    startGain      gain before first sample
+     * @param[in]    gainIncrement  per-sample increment of gain
+     */
+    static void _applyGainRamp (INOUT float* sampleArray,
+                                IN Natural sampleCount,
+                                IN Real startGain,
+                                IN Real gainIncrement)
+    {
+        Kernels::current().gainRampFloat(sampleArray, (size_t) sampleCount,
+                                         (float) startGain,
+                                         (float) gainIncrement);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Multiplies the <C>sampleCount</C> double samples in
+     * <C>sampleArray</C> in place by a linear gain ramp: sample
+     * <C>i</C> gets the factor <C>startGain + gainIncrement * (i +
+     * 1)</C>; a zero increment gives a constant gain.
+     *
+     * @param[inout] sampleArray    array of samples to be processed
+     * @param[in]    sampleCount    number of samples in array
+     * @param[in]    startGain      gain before first sample
+     * @param[in]    gainIncrement  per-sample increment of gain
+     */
+    static void _applyGainRamp (INOUT double* sampleArray,
+                                IN Natural sampleCount,
+                                IN Real startGain,
+                                IN Real gainIncrement)
+    {
+        Kernels::current().gainRampDouble(sampleArray, (size_t) sampleCount,
+                                          (double) startGain,
+                                          (double) gainIncrement);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Amplifies the <C>sampleCount</C> samples in
+     * <C>sampleArray</C> in place by <C>gain</C>; while the gain
+     * is ramping, it moves linearly within the block from its
+     * current value to the value reached at the end of the block
+     * (or of the ramp, if this comes first), otherwise the constant
+     * factor is used.  <C>gain</C> itself is not advanced, so that
+     * all channels of a block can follow the same ramp.
+     *
+     * @tparam       SampleType   type of samples (float or double)
+     * @param[inout] sampleArray  array of samples to be processed
+     * @param[in]    sampleCount  number of samples in array
+     * @param[in]    gain         smoothed amplification factor
+     */
+    template<typename SampleType>
+    static void _applyGain (INOUT SampleType* sampleArray,
+                            IN Natural sampleCount,
+                            IN SoXScalarSmoother& gain)
+    {
+        const Natural rampCount =
+            Natural::minimum(gain.remainingSampleCount(), sampleCount);
+        Real endGain = gain.currentValue();
+
+        if (rampCount > 0) {
+            SoXScalarSmoother rampedGain = gain;
+            rampedGain.skip(rampCount);
+            const Real startGain = endGain;
+            endGain = rampedGain.currentValue();
+            _applyGainRamp(sampleArray, rampCount, startGain,
+                           (endGain - startGain) / Real{rampCount});
+        }
+
+        _applyGainRamp(sampleArray + (size_t) rampCount,
+                       sampleCount - rampCount, endGain, 0.0);
+    }
+
+
+    /*--------------------*/
+
+    /**
+     * Limits the <C>sampleCount</C> double samples in
+     * <C>sampleArray</C> in place by the knee curve of the limiter
+     * with <C>limit</C> (see <C>_PeakLimiter</C>); the curve is
+     * evaluated without branches as <C>sign(x) * (min(a, t) + e * w
+     * / (e + w))</C> with <C>a = |x|</C>, the knee start <C>t</C>
+     * and width <C>w</C> and the excess <C>e = max(a - t, 0)</C>.
+     *
+     * @param[inout] sampleArray  array of samples to be processed
+     * @param[in]    sampleCount  number of samples in array
+     * @param[in]    limit        limit of output level as factor
+     */
+    static void _limitSamples (INOUT double* sampleArray,
+                               IN Natural sampleCount,
+                               IN Real limit)
+    {
+        const double kneeStart = (double) limit * 0.5;
+        const double kneeWidth = (double) limit - kneeStart;
+        const size_t count = (size_t) sampleCount;
+        size_t i = 0;
+
+        #if defined(SoXGain_usesSSE2)
+            const __m128d signMask = _mm_set1_pd(-0.0);
+            const __m128d zero = _mm_setzero_pd();
+            const __m128d start = _mm_set1_pd(kneeStart);
+            const __m128d width = _mm_set1_pd(kneeWidth);
+
+            for (;  i + 2 <= count;  i += 2) {
+                const __m128d x = _mm_loadu_pd(sampleArray + i);
+                const __m128d a = _mm_andnot_pd(signMask, x);
+                const __m128d e = _mm_max_pd(_mm_sub_pd(a, start), zero);
+                const __m128d y =
+                    _mm_add_pd(_mm_min_pd(a, start),
+                               _mm_div_pd(_mm_mul_pd(e, width),
+                                          _mm_add_pd(e, width)));
+                _mm_storeu_pd(sampleArray + i,
+                              _mm_or_pd(y, _mm_and_pd(signMask, x)));
+            }
+        #elif defined(SoXGain_usesNEON)
+            const uint64x2_t signMask =
+                vdupq_n_u64(0x8000000000000000ULL);
+            const float64x2_t zero = vdupq_n_f64(0.0);
+            const float64x2_t start = vdupq_n_f64(kneeStart);
+            const float64x2_t width = vdupq_n_f64(kneeWidth);
+
+            for (;  i + 2 <= count;  i += 2) {
+                const float64x2_t x = vld1q_f64(sampleArray + i);
+                const float64x2_t a = vabsq_f64(x);
+                const float64x2_t e = vmaxq_f64(vsubq_f64(a, start), zero);
+                const float64x2_t y =
+                    vaddq_f64(vminq_f64(a, start),
+                              vdivq_f64(vmulq_f64(e, width),
+                                        vaddq_f64(e, width)));
+                vst1q_f64(sampleArray + i, vbslq_f64(signMask, x, y));
+            }
+        #endif
+
+        /* scalar fallback and remainder */
+        for (;  i < count;  i++) {
+            const double x = sampleArray[i];
+            const double a = std::abs(x);
+            const double e = std::max(a - kneeStart, 0.0);
+            sampleArray[i] =
+                std::copysign(std::min(a, kneeStart)
+                              + e * kneeWidth / (e + kneeWidth), x);
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Limits the <C>sampleCount</C> float samples in
+     * <C>sampleArray</C> in place by the knee curve of the limiter
+     * with <C>limit</C> (see the double variant).
+     *
+     * @param[inout] sampleArray  array of samples to be processed
+     * @param[in]    sampleCount  number of samples in array
+     * @param[in]    limit        limit of output level as factor
+     */
+    static void _limitSamples (INOUT float* sampleArray,
+                               IN Natural sampleCount,
+                               IN Real limit)
+    {
+        const float kneeStart = (float) limit * 0.5f;
+        const float kneeWidth = (float) limit - kneeStart;
+        const size_t count = (size_t) sampleCount;
+        size_t i = 0;
+
+        #if defined(SoXGain_usesSSE2)
+            const __m128 signMask = _mm_set1_ps(-0.0f);
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 start = _mm_set1_ps(kneeStart);
+            const __m128 width = _mm_set1_ps(kneeWidth);
+
+            for (;  i + 4 <= count;  i += 4) {
+                const __m128 x = _mm_loadu_ps(sampleArray + i);
+                const __m128 a = _mm_andnot_ps(signMask, x);
+                const __m128 e = _mm_max_ps(_mm_sub_ps(a, start), zero);
+                const __m128 y =
+                    _mm_add_ps(_mm_min_ps(a, start),
+                               _mm_div_ps(_mm_mul_ps(e, width),
+                                          _mm_add_ps(e, width)));
+                _mm_storeu_ps(sampleArray + i,
+                              _mm_or_ps(y, _mm_and_ps(signMask, x)));
+            }
+        #elif defined(SoXGain_usesNEON)
+            const uint32x4_t signMask = vdupq_n_u32(0x80000000U);
+            const float32x4_t zero = vdupq_n_f32(0.0f);
+            const float32x4_t start = vdupq_n_f32(kneeStart);
+            const float32x4_t width = vdupq_n_f32(kneeWidth);
+
+            for (;  i + 4 <= count;  i += 4) {
+                const float32x4_t x = vld1q_f32(sampleArray + i);
+                const float32x4_t a = vabsq_f32(x);
+                const float32x4_t e = vmaxq_f32(vsubq_f32(a, start), zero);
+                const float32x4_t y =
+                    vaddq_f32(vminq_f32(a, start),
+                              vdivq_f32(vmulq_f32(e, width),
+                                        vaddq_f32(e, width)));
+                vst1q_f32(sampleArray + i, vbslq_f32(signMask, x, y));
+            }
+        #endif
+
+        /* scalar fallback and remainder */
+        for (;  i < count;  i++) {
+            const float x = sampleArray[i];
+            const float a = std::abs(x);
+            const float e = std::max(a - kneeStart, 0.0f);
+            sampleArray[i] =
+                std::copysign(std::min(a, kneeStart)
+                              + e * kneeWidth / (e + kneeWidth), x);
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Amplifies the <C>channelCount</C> channels in
+     * <C>channelArray</C> with <C>sampleCount</C> samples each in
+     * place by the gain of <C>effectDescriptor</C> and limits them
+     * by the knee curve when the limiter is active without
+     * lookahead; advances the gain by the sample count.
+     *
+     * @tparam       SampleType        type of samples (float or
+     *                                 double)
+     * @param[inout] channelArray      array of pointers to the
+     *                                 samples per channel
+     * @param[in]    channelCount      number of channels
+     * @param[in]    sampleCount       number of samples per channel
+     * @param[inout] effectDescriptor  gain parameters and state
+     */
+    template<typename SampleType>
+    static void
+    _processChannels (INOUT SampleType* const* channelArray,
+                      IN Natural channelCount,
+                      IN Natural sampleCount,
+                      INOUT _EffectDescriptor_GAIN& effectDescriptor)
+    {
+        SoXScalarSmoother& gain = effectDescriptor.gain;
+        const Boolean isLimited =
+            (effectDescriptor.limiterIsActive
+             && !effectDescriptor.hasLookahead());
+        const Real limit = effectDescriptor.limiter.limit;
+
+        for (Natural channel = 0;  channel < channelCount;
+             channel++) {
+            SampleType* sampleArray = channelArray[(size_t) channel];
+            _applyGain(sampleArray, sampleCount, gain);
+
+            if (isLimited) {
+                _limitSamples(sampleArray, sampleCount, limit);
+            }
+        }
+
+        gain.skip(sampleCount);
+    }
+
 }
 
 /*============================================================*/
@@ -98,10 +934,11 @@ SoXGain_AudioEffect::SoXGain_AudioEffect ()
     /* initialize descriptor */
     _effectDescriptor = _createEffectDescriptor();
 
-    /* initialize parameters */
-    _effectParameterMap.clear();
-    _effectParameterMap.setKindReal(parameterName_gain,
-                                    -100.0, 100.0, 0.001);
+    /* initialize parameters from the definitions shared by all
+       instances */
+    static const SoXEffectParameterMap parameterMapPrototype =
+        _makeParameterMap();
+    _effectParameterMap = parameterMapPrototype;
 
     Logging_trace1("<<: %1", toString());
 }
@@ -146,13 +983,133 @@ String SoXGain_AudioEffect::name() const
     return "SoX Gain";
 }
 
+/*--------------------*/
+
+Real SoXGain_AudioEffect::tailLength () const
+{
+    /* the lookahead delays the signal */
+    return Real{latency()} / _sampleRate;
+}
+
+/*--------------------*/
+
+Natural SoXGain_AudioEffect::latency () const
+{
+    _EffectDescriptor_GAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_GAIN>(_effectDescriptor);
+    return (effectDescriptor.hasLookahead()
+            ? effectDescriptor.limiter.lookaheadSampleCount
+            : Natural{0});
+}
+
+/*--------------------*/
+
+Boolean SoXGain_AudioEffect::hasConstantGain (OUT Real& gain) const
+{
+    _EffectDescriptor_GAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_GAIN>(_effectDescriptor);
+    const SoXScalarSmoother& smoothedGain = effectDescriptor.gain;
+    gain = smoothedGain.currentValue();
+
+    /* a ramping gain and the limiter are applied by the effect
+       itself */
+    return (!smoothedGain.isRamping()
+            && !effectDescriptor.limiterIsActive);
+}
+
+/*--------------------*/
+/* memory footprint   */
+/*--------------------*/
+
+SoXMemoryFootprint SoXGain_AudioEffect::memoryFootprint () const
+{
+    _EffectDescriptor_GAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_GAIN>(_effectDescriptor);
+    SoXMemoryFootprint result = SoXAudioEffect::memoryFootprint();
+    result.delayLineByteCount +=
+        effectDescriptor.limiter.delayLineVector.byteCount();
+    result.descriptorByteCount +=
+        (Natural{sizeof(_EffectDescriptor_GAIN)}
+         + effectDescriptor.limiter.byteCount()
+         - effectDescriptor.limiter.delayLineVector.byteCount());
+    return result;
+}
+
+/*--------------------*/
+/* mono processing    */
+/*--------------------*/
+
+Boolean SoXGain_AudioEffect::hasMonoProcessing () const
+{
+    /* the gain smoother and the limiter gain are shared by all
+       channels */
+    return true;
+}
+
+/*--------------------*/
+
+void SoXGain_AudioEffect::copyFirstChannelState (IN Natural channelCount)
+{
+    Logging_trace1(">>: %1", TOSTRING(channelCount));
+    _EffectDescriptor_GAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_GAIN>(_effectDescriptor);
+    effectDescriptor.limiter.copyFirstChannelState(channelCount);
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+Boolean SoXGain_AudioEffect::hasIndependentChannels () const
+{
+    /* the gain smoother only depends on time, but the lookahead
+       limiter links the channels */
+    _EffectDescriptor_GAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_GAIN>(_effectDescriptor);
+    return !effectDescriptor.hasLookahead();
+}
+
+/*--------------------*/
+/* DSP state          */
+/*--------------------*/
+
+Boolean SoXGain_AudioEffect::hasDspStateSupport () const
+{
+    return true;
+}
+
+/*--------------------*/
+
+void SoXGain_AudioEffect::_saveDspState (INOUT DspStateStream& stream)
+    const
+{
+    Logging_trace(">>");
+    const _EffectDescriptor_GAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_GAIN>(_effectDescriptor);
+    stream.write(effectDescriptor.gain);
+    effectDescriptor.limiter.saveState(stream);
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXGain_AudioEffect::_restoreDspState (INOUT DspStateStream& stream)
+{
+    Logging_trace(">>");
+    _EffectDescriptor_GAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_GAIN>(_effectDescriptor);
+    stream.read(effectDescriptor.gain);
+    effectDescriptor.limiter.restoreState(stream, _channelCount);
+    Logging_trace("<<");
+}
+
 /*--------------------*/
 /* parameter change   */
 /*--------------------*/
 
 SoXParameterValueChangeKind
 SoXGain_AudioEffect::_setValueInternal
-                         (IN String& parameterName,
+                         (IN Natural parameterId,
+                          IN String& parameterName,
                           IN String& value,
                           IN Boolean recalculationIsForced)
 {
@@ -166,11 +1123,31 @@ SoXGain_AudioEffect::_setValueInternal
     SoXParameterValueChangeKind result =
         SoXParameterValueChangeKind::parameterChange;
 
-    SoXAudioEffect::setValue(parameterName, value);
+    const Real numericValue = _effectParameterMap.numericValue(parameterId);
+
+    switch ((int) parameterId) {
+        case parameterId_gain:
+            effectDescriptor.gain
+                .setTarget(SoXAudioHelper::dBToLinear(numericValue));
+            break;
+
+        case parameterId_limiter:
+            effectDescriptor.limiterIsActive = (value == "Yes");
+            effectDescriptor.limiter.reset();
+            break;
+
+        case parameterId_limit:
+            effectDescriptor.limiter.limit =
+                SoXAudioHelper::dBToLinear(numericValue);
+            break;
 
-    if (parameterName == parameterName_gain) {
-        const Real dBGain = STR::toReal(value);
-        effectDescriptor.gain = SoXAudioHelper::dBToLinear(dBGain);
+        case parameterId_lookahead:
+            effectDescriptor.lookahead = numericValue / 1000.0;
+            _updateLookahead(effectDescriptor, _sampleRate);
+            break;
+
+        default:
+            break;
     }
 
     Logging_trace1("<<: %1", SoXParameterValueChangeKind_toString(result));
@@ -181,7 +1158,11 @@ SoXGain_AudioEffect::_setValueInternal
 
 void SoXGain_AudioEffect::setDefaultValues () {
     Logging_trace(">>");
-    _effectParameterMap.setValue(parameterName_gain, "0");
+    _effectParameterMap.setValue(parameterName_gain,      "0");
+    _effectParameterMap.setValue(parameterName_limiter,   "No");
+    _effectParameterMap.setValue(parameterName_limit,
+                                 TOSTRING(_defaultLimitInDb));
+    _effectParameterMap.setValue(parameterName_lookahead, "0");
     Logging_trace1("<<: %1", toString());
 }
 
@@ -189,30 +1170,119 @@ void SoXGain_AudioEffect::setDefaultValues () {
 /* event handling     */
 /*--------------------*/
 
+void SoXGain_AudioEffect::prepareToPlay (IN Real sampleRate)
+{
+    Logging_trace1(">>: %1", TOSTRING(sampleRate));
+
+    SoXAudioEffect::prepareToPlay(sampleRate);
+    _EffectDescriptor_GAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_GAIN>(_effectDescriptor);
+
+    /* later gain changes are ramped, the current one is taken
+       immediately */
+    effectDescriptor.gain.setRampLength(SoXRamp_sampleCount(sampleRate,
+                                                            _gainRampDuration));
+    _updateLookahead(effectDescriptor, sampleRate);
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
 void
 SoXGain_AudioEffect::processBlock (IN Real timePosition,
                                    INOUT AudioSampleListVector& buffer)
 {
-    Logging_trace1(">>: time = %1", TOSTRING(timePosition));
+    Logging_traceHot1(">>: time = %1", TOSTRING(timePosition));
 
     SoXAudioEffect::processBlock(timePosition, buffer);
     _EffectDescriptor_GAIN& effectDescriptor =
         TOREFERENCE<_EffectDescriptor_GAIN>(_effectDescriptor);
-
+    _PeakLimiter& limiter = effectDescriptor.limiter;
     const Natural sampleCount = buffer[0].size();
-    const Real gain = effectDescriptor.gain;
+    limiter.ensureChannelCount(_channelCount);
 
-    for (Natural channel = 0;  channel < _channelCount;
-         channel++) {
-        const AudioSampleList& inputList  = buffer[channel];
-        AudioSampleList& outputList = buffer[channel];
+    /* audio samples have the layout of doubles */
+    double** channelArray = limiter.channelPointerList.asArray();
 
-        for (Natural i = 0;  i < sampleCount;  i++) {
-            const AudioSample inputSample = inputList[i];
-            AudioSample& outputSample     = outputList[i];
-            outputSample = (AudioSample) (inputSample * gain);
-        }
+    for (Natural channel = 0;  channel < _channelCount;  channel++) {
+        channelArray[(size_t) channel] =
+            (double*) buffer[channel].asArray();
     }
 
-    Logging_trace("<<");
+    _processChannels(channelArray, _channelCount, sampleCount,
+                     effectDescriptor);
+
+    if (effectDescriptor.hasLookahead()) {
+        limiter.processWithLookahead(channelArray, _channelCount,
+                                     sampleCount);
+    }
+
+    Logging_traceHot("<<");
+}
+
+/*--------------------*/
+
+Boolean SoXGain_AudioEffect::hasFloatProcessing () const
+{
+    return true;
+}
+
+/*--------------------*/
+
+void
+SoXGain_AudioEffect::processFloatBlock (IN Real timePosition,
+                                        INOUT float* const* channelArray,
+                                        IN Natural channelCount,
+                                        IN Natural sampleCount)
+{
+    Logging_traceHot1(">>: time = %1", TOSTRING(timePosition));
+
+    _EffectDescriptor_GAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_GAIN>(_effectDescriptor);
+
+    if (effectDescriptor.hasLookahead()) {
+        /* the lookahead limiter works on the sample buffer */
+        SoXAudioEffect::processFloatBlock(timePosition, channelArray,
+                                          channelCount, sampleCount);
+    } else {
+        _startBlock(timePosition, channelCount, sampleCount);
+        _processChannels(channelArray, _channelCount, sampleCount,
+                         effectDescriptor);
+    }
+
+    Logging_traceHot("<<");
+}
+
+/*--------------------*/
+
+Boolean SoXGain_AudioEffect::hasDoubleProcessing () const
+{
+    return true;
+}
+
+/*--------------------*/
+
+void
+SoXGain_AudioEffect::processDoubleBlock (IN Real timePosition,
+                                         INOUT double* const* channelArray,
+                                         IN Natural channelCount,
+                                         IN Natural sampleCount)
+{
+    Logging_traceHot1(">>: time = %1", TOSTRING(timePosition));
+
+    _EffectDescriptor_GAIN& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_GAIN>(_effectDescriptor);
+
+    if (effectDescriptor.hasLookahead()) {
+        /* the lookahead limiter works on the sample buffer */
+        SoXAudioEffect::processDoubleBlock(timePosition, channelArray,
+                                           channelCount, sampleCount);
+    } else {
+        _startBlock(timePosition, channelCount, sampleCount);
+        _processChannels(channelArray, _channelCount, sampleCount,
+                         effectDescriptor);
+    }
+
+    Logging_traceHot("<<");
 }
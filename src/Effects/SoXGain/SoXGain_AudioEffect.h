@@ -30,8 +30,15 @@ namespace SoXPlugins::Effects::SoXGain {
      * A <C>SoXGain_AudioEffect</C> object models the SoX <B>gain</B>
      * plugin amplifying or attenuating the input signal by a specific
      * dB amount.
+     *
+     * Like <TT>gain -l</TT> in SoX the amplified signal may pass an
+     * optional peak limiter: it limits the peaks to a given level by
+     * a soft knee starting 6dB below that level, either per sample
+     * without latency or with a short lookahead by a gain common to
+     * all channels that ramps down before a peak arrives (reported
+     * as latency).
      */
-    struct SoXGain_AudioEffect : public SoXAudioEffect {
+    struct SoXGain_AudioEffect final : public SoXAudioEffect {
 
         /*---------------------*/
         /* setup & destruction */
@@ -55,6 +62,44 @@ namespace SoXPlugins::Effects::SoXGain {
 
         String name () const override;
 
+        /*--------------------*/
+
+        Real tailLength () const override;
+
+        /*--------------------*/
+
+        Natural latency () const override;
+
+        /*--------------------*/
+
+        Boolean hasConstantGain (OUT Real& gain) const override;
+
+        /*--------------------*/
+        /* memory footprint   */
+        /*--------------------*/
+
+        SoXMemoryFootprint memoryFootprint () const override;
+
+        /*--------------------*/
+        /* mono processing    */
+        /*--------------------*/
+
+        Boolean hasMonoProcessing () const override;
+
+        /*--------------------*/
+
+        void copyFirstChannelState (IN Natural channelCount) override;
+
+        /*--------------------*/
+
+        Boolean hasIndependentChannels () const override;
+
+        /*--------------------*/
+        /* DSP state          */
+        /*--------------------*/
+
+        Boolean hasDspStateSupport () const override;
+
         /*--------------------*/
         /* parameter change   */
         /*--------------------*/
@@ -65,10 +110,39 @@ namespace SoXPlugins::Effects::SoXGain {
         /* event handling     */
         /*--------------------*/
 
+        void prepareToPlay (IN Real sampleRate)
+            override;
+
+        /*--------------------*/
+
         void processBlock (IN Real timePosition,
                            INOUT AudioSampleListVector& buffer)
             override;
 
+        /*--------------------*/
+
+        Boolean hasFloatProcessing () const override;
+
+        /*--------------------*/
+
+        void processFloatBlock (IN Real timePosition,
+                                INOUT float* const* channelArray,
+                                IN Natural channelCount,
+                                IN Natural sampleCount)
+            override;
+
+        /*--------------------*/
+
+        Boolean hasDoubleProcessing () const override;
+
+        /*--------------------*/
+
+        void processDoubleBlock (IN Real timePosition,
+                                 INOUT double* const* channelArray,
+                                 IN Natural channelCount,
+                                 IN Natural sampleCount)
+            override;
+
         /*--------------------*/
         /*--------------------*/
 
@@ -80,11 +154,22 @@ namespace SoXPlugins::Effects::SoXGain {
             /*--------------------*/
 
             SoXParameterValueChangeKind
-            _setValueInternal (IN String& parameterName,
+            _setValueInternal (IN Natural parameterId,
+                               IN String& parameterName,
                                IN String& value,
                                IN Boolean recalculationIsForced)
                 override;
 
+            /*--------------------*/
+
+            void _saveDspState (INOUT DspStateStream& stream) const
+                override;
+
+            /*--------------------*/
+
+            void _restoreDspState (INOUT DspStateStream& stream)
+                override;
+
     };
 
 }
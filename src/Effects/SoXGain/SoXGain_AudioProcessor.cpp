@@ -33,7 +33,7 @@ namespace SoXPlugins::Effects::SoXGain {
         SoXGain_AudioProcessor ()
         {
             Logging_initializeWithDefaults("SoXGain", "SoXPlugins.");
-            _setAssociatedEffect(new SoXGain_AudioEffect{});
+            _setAssociatedEffect(_makeEffect());
         }
 
         /*--------------------*/
@@ -43,6 +43,15 @@ namespace SoXPlugins::Effects::SoXGain {
             return String("SoXGain");
         }
 
+        /*--------------------*/
+
+        protected:
+
+            SoXAudioEffect* _makeEffect () const override
+            {
+                return new SoXGain_AudioEffect{};
+            }
+
     };
 
 }
@@ -19,13 +19,24 @@
 #include "SoXOverdrive_AudioEffect.h"
 
 #include <cmath>
+#include <type_traits>
 #include "Logging.h"
-#include "AudioSampleRingBufferVector.h"
+#include "DenormalGuard.h"
+#include "GenericList.h"
+#include "HalfBandOversampler.h"
+#include "Kernels.h"
+#include "ScratchArena.h"
 #include "SoXAudioHelper.h"
+#include "StringList.h"
 
 /*--------------------*/
 
-using Audio::AudioSampleRingBufferVector;
+using Audio::DenormalGuard;
+using Audio::HalfBandOversampler;
+using Audio::Kernels;
+using Audio::ScratchArena;
+using BaseTypes::Containers::StringList;
+using BaseTypes::GenericTypes::GenericList;
 using SoXPlugins::Effects::SoXOverdrive::SoXOverdrive_AudioEffect;
 using SoXPlugins::Helpers::SoXAudioHelper;
 
@@ -36,6 +47,17 @@ using STR = BaseModules::StringUtil;
 
 namespace SoXPlugins::Effects::SoXOverdrive {
 
+    /**
+     * The <C>_ShaperCurve</C> is an enumeration type for the curves
+     * of the overdrive shaper: the clipped cubic of SoX (evaluated
+     * directly) or a hyperbolic tangent (interpolated in a table).
+     */
+    enum class _ShaperCurve {
+        cubic, tanh
+    };
+
+    /*====================*/
+
     /**
      * An <C>_EffectDescriptor_OVRD</C> object is the internal
      * implementation of an <B>overdrive</B> effect descriptor type
@@ -51,8 +73,33 @@ namespace SoXPlugins::Effects::SoXOverdrive {
           * a DC offset applied to the signal*/
         Real colour;
 
-        /** the list of samples ring buffers for input and output */
-        AudioSampleRingBufferVector sampleRingBufferVector;
+        /** the oversampling factor of all channels */
+        Natural oversamplingFactor;
+
+        /** tells whether the shaper uses first-order antiderivative
+         * anti-aliasing */
+        Boolean isAntiderivativeMode;
+
+        /** the curve of the shaper */
+        _ShaperCurve curve;
+
+        /** the last input sample of the DC blocker per channel */
+        GenericList<AudioSample> previousInputSampleList;
+
+        /** the last output sample of the DC blocker per channel */
+        GenericList<AudioSample> previousOutputSampleList;
+
+        /** the last shaper input (after gain and offset) per
+         * channel */
+        GenericList<AudioSample> previousShaperInputList;
+
+        /** the antiderivative of the shaper at the last shaper input
+         * per channel */
+        GenericList<AudioSample> previousAntiderivativeList;
+
+        /** the oversamplers for the distortion (one per channel,
+         * owned by the descriptor) */
+        GenericList<HalfBandOversampler*> oversamplerList;
 
         /*--------------------*/
         /*--------------------*/
@@ -66,9 +113,18 @@ namespace SoXPlugins::Effects::SoXOverdrive {
         {
             String st =
                 STR::expand("gain = %1dB, colour = %2,"
-                            " sampleRingBufferVector = %3",
+                            " dcBlockerState = (%3, %4 / %5, %6),"
+                            " isAntiderivativeMode = %7,"
+                            " curve = %8, oversampler = %9",
                             TOSTRING(gain), TOSTRING(colour),
-                            sampleRingBufferVector.toString());
+                            TOSTRING(previousInputSampleList[0]),
+                            TOSTRING(previousOutputSampleList[0]),
+                            TOSTRING(previousInputSampleList[1]),
+                            TOSTRING(previousOutputSampleList[1]),
+                            TOSTRING(isAntiderivativeMode),
+                            (curve == _ShaperCurve::cubic
+                             ? "cubic" : "tanh"),
+                            oversamplerList[0]->toString());
  
             st = STR::expand("_EffectDescriptor_OVRD(%1)", st);
             return st;
@@ -84,13 +140,100 @@ namespace SoXPlugins::Effects::SoXOverdrive {
     /** the parameter name of the colour parameter */
     static const String parameterName_colour = "Colour";
 
+    /** the parameter name of the oversampling parameter */
+    static const String parameterName_oversampling = "Oversampling";
+
+    /** the parameter name of the anti-aliasing parameter */
+    static const String parameterName_antiAliasing = "Anti-Aliasing";
+
+    /** the parameter name of the curve parameter */
+    static const String parameterName_curve = "Curve";
+
+    /** the identifications of the parameters in the parameter map
+     * (in order of definition) */
+    enum _ParameterId {
+        parameterId_gain, parameterId_colour, parameterId_oversampling,
+        parameterId_antiAliasing, parameterId_curve
+    };
+
+    /** the list of oversampling factors (the position in the list
+     * is the binary logarithm of the factor) */
+    static const StringList _oversamplingList =
+        StringList::makeBySplit("1x/2x/4x/8x", "/");
+
+    /** the list of anti-aliasing modes of the shaper: none or first
+     * order antiderivative anti-aliasing */
+    static const StringList _antiAliasingList =
+        StringList::makeBySplit("None/ADAA", "/");
+
+    /** the list of shaper curves (in order of <C>_ShaperCurve</C>) */
+    static const StringList _curveList =
+        StringList::makeBySplit("Cubic/Tanh", "/");
+
+    /** the minimum difference of consecutive shaper inputs for the
+     * difference quotient of the antiderivative; below that the
+     * shaper is evaluated at the mean of both inputs */
+    static const double _minimumShaperInputDelta = 1e-5;
+
     /** the factor from colour parameter to DC offset in the effect */
     static const Real colourFactor = 0.005;
 
+    /** the number of intervals of a shaper table */
+    static const size_t _shaperTableIntervalCount = 4096;
+
+    /** the input range of the tanh table: beyond +-8 the tanh
+     * differs from +-1 by less than 3E-7 */
+    static const double _tanhTableRange = 8.0;
+
+    /** the number of channels the channel states are initially
+     * allocated for */
+    static const Natural _initialChannelCount = 2;
+
     /*--------------------*/
     /* internal routines  */
     /*--------------------*/
 
+    /**
+     * Ensures that <C>effectDescriptor</C> has DC blocker states and
+     * oversamplers for at least <C>channelCount</C> channels; new
+     * channels start with a cleared state and the current
+     * oversampling factor.  Allocates only when the channel count
+     * grows beyond all previous counts.
+     *
+     * @param[inout] effectDescriptor  overdrive parameters and state
+     * @param[in]    channelCount      number of channels
+     */
+    static void
+    _ensureChannelCount (INOUT _EffectDescriptor_OVRD& effectDescriptor,
+                         IN Natural channelCount)
+    {
+        GenericList<HalfBandOversampler*>& oversamplerList =
+            effectDescriptor.oversamplerList;
+
+        if (oversamplerList.size() < channelCount) {
+            Logging_trace1(">>: %1", TOSTRING(channelCount));
+
+            effectDescriptor.previousInputSampleList
+                .ensureLength(channelCount);
+            effectDescriptor.previousOutputSampleList
+                .ensureLength(channelCount);
+            effectDescriptor.previousShaperInputList
+                .ensureLength(channelCount);
+            effectDescriptor.previousAntiderivativeList
+                .ensureLength(channelCount);
+
+            while (oversamplerList.size() < channelCount) {
+                HalfBandOversampler* oversampler = new HalfBandOversampler();
+                oversampler->setFactor(effectDescriptor.oversamplingFactor);
+                oversamplerList.append(oversampler);
+            }
+
+            Logging_trace("<<");
+        }
+    }
+
+    /*--------------------*/
+
     /**
      * Sets up a new effect descriptor and returns it.
      *
@@ -104,13 +247,786 @@ namespace SoXPlugins::Effects::SoXOverdrive {
             new _EffectDescriptor_OVRD{
                 SoXAudioHelper::dBToLinear(0.0),  /* gain */
                 Real{20.0} * colourFactor,        /* colour */
-                {2, true, 1}                      /* sampleRingBufferVector */
+                1,                                /* oversamplingFactor */
+                false,                            /* isAntiderivativeMode */
+                _ShaperCurve::cubic               /* curve */
             };
 
+        _ensureChannelCount(*result, _initialChannelCount);
+
+        /* the chunk buffers are taken from the scratch arena: dry,
+           wet and high rate samples for the largest factor plus the
+           intermediate samples of the oversampler */
+        const Natural chunkLength = HalfBandOversampler::maximumBlockLength;
+        const Natural factor = HalfBandOversampler::maximumFactor;
+        ScratchArena::announceCapacity
+            (Natural{2} * ScratchArena::footprint<AudioSample>(chunkLength)
+             + ScratchArena::footprint<AudioSample>(chunkLength * factor)
+             + HalfBandOversampler::scratchByteCount());
+
         Logging_trace1("<<: %1", result->toString());
         return result;
     }
 
+    /*--------------------*/
+
+    /**
+     * Returns a parameter map with the definitions of all overdrive
+     * parameters; this is done once per process and the map is used
+     * as a prototype for each effect instance.
+     *
+     * @return parameter map with all parameter definitions
+     */
+    static SoXEffectParameterMap _makeParameterMap ()
+    {
+        Logging_trace(">>");
+
+        SoXEffectParameterMap result;
+
+        result.setKindAndValueInt(parameterName_gain,
+                                  0, 100, 1, 20);
+        result.setKindAndValueInt(parameterName_colour,
+                                  0, 100, 1, 20);
+        result.setKindAndValueEnum(parameterName_oversampling,
+                                   _oversamplingList,
+                                   _oversamplingList[0]);
+        result.setKindAndValueEnum(parameterName_antiAliasing,
+                                   _antiAliasingList,
+                                   _antiAliasingList[0]);
+        result.setKindAndValueEnum(parameterName_curve,
+                                   _curveList, _curveList[0]);
+
+        Logging_trace("<<");
+        return result;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies the memoryless part of the overdrive with
+     * <C>gain</C> and <C>colour</C> (gain, DC offset, clipping and
+     * cubic shaping) to the <C>sampleCount</C> float samples in
+     * <C>inputArray</C> and stores the results in
+     * <C>outputArray</C>; the shaping is calculated in float
+     * precision.
+     *
+     * @param[in]  inputArray   array of input samples
+     * @param[out] outputArray  array of shaped samples
+     * @param[in]  sampleCount  number of samples in arrays
+     * @param[in]  gain         gain of overdrive (as a factor)
+     * @param[in]  colour       DC offset of overdrive
+     */
+    static void _shapeSamples (IN float* inputArray,
+                               OUT AudioSample* outputArray,
+                               IN Natural sampleCount,
+                               IN Real gain,
+                               IN Real colour)
+    {
+        Kernels::current().waveshapeFloat(inputArray,
+                                          (double*) outputArray,
+                                          (size_t) sampleCount,
+                                          (float) gain, (float) colour);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies the memoryless part of the overdrive with
+     * <C>gain</C> and <C>colour</C> (gain, DC offset, clipping and
+     * cubic shaping) to the <C>sampleCount</C> double samples in
+     * <C>inputArray</C> and stores the results in
+     * <C>outputArray</C>; both arrays may coincide.
+     *
+     * @param[in]  inputArray   array of input samples
+     * @param[out] outputArray  array of shaped samples
+     * @param[in]  sampleCount  number of samples in arrays
+     * @param[in]  gain         gain of overdrive (as a factor)
+     * @param[in]  colour       DC offset of overdrive
+     */
+    static void _shapeSamples (IN double* inputArray,
+                               OUT AudioSample* outputArray,
+                               IN Natural sampleCount,
+                               IN Real gain,
+                               IN Real colour)
+    {
+        Kernels::current().waveshapeDouble(inputArray,
+                                           (double*) outputArray,
+                                           (size_t) sampleCount,
+                                           (double) gain, (double) colour);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies the memoryless part of the overdrive to the audio
+     * samples in <C>inputArray</C>; see its double variant.
+     *
+     * @param[in]  inputArray   array of input samples
+     * @param[out] outputArray  array of shaped samples
+     * @param[in]  sampleCount  number of samples in arrays
+     * @param[in]  gain         gain of overdrive (as a factor)
+     * @param[in]  colour       DC offset of overdrive
+     */
+    static void _shapeSamples (IN AudioSample* inputArray,
+                               OUT AudioSample* outputArray,
+                               IN Natural sampleCount,
+                               IN Real gain,
+                               IN Real colour)
+    {
+        _shapeSamples((const double*) inputArray, outputArray,
+                      sampleCount, gain, colour);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the cubic shaper function (clipping and cubic shaping)
+     * at <C>x</C>.
+     *
+     * @param[in] x  shaper input (after gain and offset)
+     * @return  shaped value
+     */
+    static inline double _cubicValue (IN double x)
+    {
+        const double value = (x < -1.0 ? -1.0 : (x > 1.0 ? 1.0 : x));
+        return value - (value * value * value) / 3.0;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the antiderivative of the cubic shaper function at
+     * <C>x</C>: x^2/2 - x^4/12 within the clipping limits and a
+     * continuous linear continuation with slope +-2/3 outside.
+     *
+     * @param[in] x  shaper input (after gain and offset)
+     * @return  antiderivative of shaper
+     */
+    static inline double _cubicAntiderivative (IN double x)
+    {
+        const double squaredX = x * x;
+        const double absoluteX = (x < 0.0 ? -x : x);
+        return (absoluteX <= 1.0
+                ? squaredX / 2.0 - squaredX * squaredX / 12.0
+                : absoluteX * (2.0 / 3.0) - 0.25);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the tanh shaper function at <C>x</C>.
+     *
+     * @param[in] x  shaper input (after gain and offset)
+     * @return  shaped value
+     */
+    static double _tanhValue (IN double x)
+    {
+        return std::tanh(x);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the antiderivative of the tanh shaper function at
+     * <C>x</C>: log(cosh(x)), calculated as |x| + log(1 + exp(-2|x|))
+     * - log(2) without overflow for large inputs.
+     *
+     * @param[in] x  shaper input (after gain and offset)
+     * @return  antiderivative of shaper
+     */
+    static double _tanhAntiderivative (IN double x)
+    {
+        const double absoluteX = (x < 0.0 ? -x : x);
+        return (absoluteX + std::log1p(std::exp(-2.0 * absoluteX))
+                - 0.69314718055994531);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the shaper function for <C>curve</C> at <C>x</C>.
+     *
+     * @param[in] curve  curve of shaper
+     * @param[in] x      shaper input (after gain and offset)
+     * @return  shaped value
+     */
+    static inline double _shaperValue (IN _ShaperCurve curve,
+                                       IN double x)
+    {
+        return (curve == _ShaperCurve::cubic
+                ? _cubicValue(x) : _tanhValue(x));
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the antiderivative of the shaper function for
+     * <C>curve</C> at <C>x</C>.
+     *
+     * @param[in] curve  curve of shaper
+     * @param[in] x      shaper input (after gain and offset)
+     * @return  antiderivative of shaper
+     */
+    static inline double _shaperAntiderivative (IN _ShaperCurve curve,
+                                                IN double x)
+    {
+        return (curve == _ShaperCurve::cubic
+                ? _cubicAntiderivative(x) : _tanhAntiderivative(x));
+    }
+
+    /*--------------------*/
+
+    /**
+     * Fills <C>table</C> with <C>curveFunction</C> sampled at
+     * <C>_shaperTableIntervalCount + 1</C> equidistant points from
+     * <C>-range</C> to <C>range</C> followed by a copy of the last
+     * value as a guard for the interpolation at the upper end.
+     *
+     * @param[out] table          shaper table to be filled
+     * @param[in]  range          bound of the table input range
+     * @param[in]  curveFunction  shaper function to be tabulated
+     * @return  always true
+     */
+    static Boolean _fillShaperTable (OUT double* table,
+                                     IN double range,
+                                     double (*curveFunction) (double))
+    {
+        Logging_trace1(">>: %1", TOSTRING(Real{range}));
+
+        const double stepSize =
+            2.0 * range / (double) _shaperTableIntervalCount;
+
+        for (size_t i = 0;  i <= _shaperTableIntervalCount;  i++) {
+            table[i] = curveFunction(-range + (double) i * stepSize);
+        }
+
+        table[_shaperTableIntervalCount + 1] =
+            table[_shaperTableIntervalCount];
+
+        Logging_trace("<<");
+        return true;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the table of the tanh shaper shared by all overdrive
+     * effects: the curve is independent of gain and colour, hence
+     * it is calculated once on the first call (by the constructor,
+     * never on the audio thread).  Its 32kB fit into the first or
+     * second level cache.
+     *
+     * @return  tanh table with guard entry
+     */
+    static const double* _tanhTable ()
+    {
+        static double table[_shaperTableIntervalCount + 2];
+        static const Boolean isFilled =
+            _fillShaperTable(table, _tanhTableRange, _tanhValue);
+        (void) isFilled;
+        return table;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies the memoryless part of the overdrive with
+     * <C>gain</C> and <C>colour</C> and the tanh curve to the
+     * <C>sampleCount</C> samples in <C>inputArray</C> by linear
+     * interpolation in the tanh table and stores the results in
+     * <C>outputArray</C> (both arrays may coincide).  The cost per
+     * sample does not depend on the curve and the kernels use
+     * gathers where available; gain and colour are scaled to the
+     * table range, which is a power of two.
+     *
+     * @tparam     SampleType   type of input samples (float or
+     *                          double)
+     * @param[in]  inputArray   array of input samples
+     * @param[out] outputArray  array of shaped samples
+     * @param[in]  sampleCount  number of samples in arrays
+     * @param[in]  gain         gain of overdrive (as a factor)
+     * @param[in]  colour       DC offset of overdrive
+     */
+    template<typename SampleType>
+    static void _shapeSamplesByTable (IN SampleType* inputArray,
+                                      OUT AudioSample* outputArray,
+                                      IN Natural sampleCount,
+                                      IN Real gain,
+                                      IN Real colour)
+    {
+        const Kernels& kernels = Kernels::current();
+        const size_t count = (size_t) sampleCount;
+        double* shapedArray = (double*) outputArray;
+        const double* sourceArray = shapedArray;
+
+        if constexpr (std::is_same<SampleType, float>::value) {
+            kernels.floatToDouble(shapedArray, inputArray, count);
+        } else {
+            /* audio samples have the layout of doubles */
+            sourceArray = (const double*) inputArray;
+        }
+
+        kernels.waveshapeTable(sourceArray, shapedArray, count,
+                               (double) gain / _tanhTableRange,
+                               (double) colour / _tanhTableRange,
+                               _tanhTable(), _shaperTableIntervalCount);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies the memoryless part of the overdrive with
+     * <C>gain</C> and <C>colour</C> to the <C>sampleCount</C>
+     * samples in <C>inputArray</C> with first-order antiderivative
+     * anti-aliasing and stores the results in <C>outputArray</C>
+     * (both arrays may coincide): each output is the difference
+     * quotient of the shaper antiderivative between the previous and
+     * the current shaper input (kept in <C>previousShaperInput</C>
+     * and <C>previousAntiderivative</C>), which is the mean of the
+     * shaper over that interval.  This suppresses most aliasing
+     * without oversampling at the cost of a delay of half a sample
+     * in the wet signal.  The curve is evaluated exactly.
+     *
+     * @tparam       SampleType              type of input samples
+     *                                       (float or double)
+     * @param[in]    inputArray              array of input samples
+     * @param[out]   outputArray             array of shaped samples
+     * @param[in]    sampleCount             number of samples in
+     *                                       arrays
+     * @param[in]    gain                    gain of overdrive (as a
+     *                                       factor)
+     * @param[in]    colour                  DC offset of overdrive
+     * @param[in]    curve                   curve of shaper
+     * @param[inout] previousShaperInput     last shaper input
+     * @param[inout] previousAntiderivative  antiderivative at last
+     *                                       shaper input
+     */
+    template<typename SampleType>
+    static void
+    _shapeSamplesAntiderivatively (IN SampleType* inputArray,
+                                   OUT AudioSample* outputArray,
+                                   IN Natural sampleCount,
+                                   IN Real gain,
+                                   IN Real colour,
+                                   IN _ShaperCurve curve,
+                                   INOUT AudioSample& previousShaperInput,
+                                   INOUT AudioSample& previousAntiderivative)
+    {
+        const size_t count = (size_t) sampleCount;
+        const double gainFactor = (double) gain;
+        const double offset     = (double) colour;
+        double* shapedArray = (double*) outputArray;
+        double previousX = (double) previousShaperInput;
+        double previousF = (double) previousAntiderivative;
+
+        for (size_t i = 0;  i < count;  i++) {
+            const double x = (double) inputArray[i] * gainFactor + offset;
+            const double f = _shaperAntiderivative(curve, x);
+            const double delta = x - previousX;
+            const double absoluteDelta = (delta < 0.0 ? -delta : delta);
+            shapedArray[i] =
+                (absoluteDelta < _minimumShaperInputDelta
+                 ? _shaperValue(curve, (x + previousX) / 2.0)
+                 : (f - previousF) / delta);
+            previousX = x;
+            previousF = f;
+        }
+
+        previousShaperInput    = previousX;
+        previousAntiderivative = previousF;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies the memoryless part of the overdrive with
+     * <C>gain</C> and <C>colour</C> to the <C>sampleCount</C>
+     * samples in <C>inputArray</C> and stores the results in
+     * <C>outputArray</C> (both arrays may coincide); uses
+     * antiderivative anti-aliasing when <C>isAntiderivativeMode</C>
+     * is set, otherwise the cubic curve is evaluated directly and
+     * the tanh curve is interpolated in its table.  The last shaper
+     * input and its antiderivative are always updated in
+     * <C>previousShaperInput</C> and <C>previousAntiderivative</C>,
+     * such that switching on the anti-aliasing does not produce a
+     * click.
+     *
+     * @tparam       SampleType              type of input samples
+     *                                       (float or double)
+     * @param[in]    inputArray              array of input samples
+     * @param[out]   outputArray             array of shaped samples
+     * @param[in]    sampleCount             number of samples in
+     *                                       arrays
+     * @param[in]    gain                    gain of overdrive (as a
+     *                                       factor)
+     * @param[in]    colour                  DC offset of overdrive
+     * @param[in]    curve                   curve of shaper
+     * @param[in]    isAntiderivativeMode    information whether
+     *                                       antiderivative
+     *                                       anti-aliasing is used
+     * @param[inout] previousShaperInput     last shaper input
+     * @param[inout] previousAntiderivative  antiderivative at last
+     *                                       shaper input
+     */
+    template<typename SampleType>
+    static void
+    _shapeSamplesInMode (IN SampleType* inputArray,
+                         OUT AudioSample* outputArray,
+                         IN Natural sampleCount,
+                         IN Real gain,
+                         IN Real colour,
+                         IN _ShaperCurve curve,
+                         IN Boolean isAntiderivativeMode,
+                         INOUT AudioSample& previousShaperInput,
+                         INOUT AudioSample& previousAntiderivative)
+    {
+        if (isAntiderivativeMode) {
+            _shapeSamplesAntiderivatively(inputArray, outputArray,
+                                          sampleCount, gain, colour,
+                                          curve, previousShaperInput,
+                                          previousAntiderivative);
+        } else if (sampleCount > 0) {
+            /* the last input is read before it may be overwritten */
+            const double x =
+                ((double) inputArray[(size_t) sampleCount - 1]
+                 * (double) gain + (double) colour);
+
+            if (curve == _ShaperCurve::cubic) {
+                _shapeSamples(inputArray, outputArray, sampleCount,
+                              gain, colour);
+            } else {
+                _shapeSamplesByTable(inputArray, outputArray,
+                                     sampleCount, gain, colour);
+            }
+
+            previousShaperInput    = x;
+            previousAntiderivative = _shaperAntiderivative(curve, x);
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Passes the <C>sampleCount</C> shaped samples in
+     * <C>wetArray</C> through the DC blocker with its state in
+     * <C>previousInputSample</C> and <C>previousOutputSample</C> and
+     * mixes them with the samples in <C>dryArray</C> into
+     * <C>outputArray</C>; dry and output array may coincide.  The
+     * recursion is kept in plain double registers and its results
+     * replace the shaped samples; for double dry samples the mix is
+     * then done by the SIMD kernels.
+     *
+     * @tparam       DrySampleType         type of dry samples (float
+     *                                     or double)
+     * @tparam       SampleType            type of output samples
+     *                                     (float or double)
+     * @param[in]    dryArray              array of dry samples
+     * @param[inout] wetArray              array of shaped samples
+     * @param[out]   outputArray           array of output samples
+     * @param[in]    sampleCount           number of samples in arrays
+     * @param[inout] previousInputSample   last input of DC blocker
+     * @param[inout] previousOutputSample  last output of DC blocker
+     */
+    template<typename DrySampleType, typename SampleType>
+    static void _blockDCAndMix (IN DrySampleType* dryArray,
+                                INOUT AudioSample* wetArray,
+                                OUT SampleType* outputArray,
+                                IN Natural sampleCount,
+                                INOUT AudioSample& previousInputSample,
+                                INOUT AudioSample& previousOutputSample)
+    {
+        const size_t count = (size_t) sampleCount;
+        const double dcBlockerFactor = 0.995;
+        const double dryFactor       = 0.5;
+        const double wetFactor       = 0.75;
+        double* filteredArray = (double*) wetArray;
+        double inputState  = (double) previousInputSample;
+        double outputState = (double) previousOutputSample;
+
+        for (size_t i = 0;  i < count;  i++) {
+            const double newValue = filteredArray[i];
+            const double outputSample =
+                newValue - inputState + dcBlockerFactor * outputState;
+            filteredArray[i] = outputSample;
+            inputState  = newValue;
+            outputState = DenormalGuard::flushed(outputSample);
+        }
+
+        previousInputSample  = inputState;
+        previousOutputSample = outputState;
+
+        /* halving the dry sample is exact, hence the kernels give
+           the same results as the scalar loop */
+        constexpr bool dryIsDouble =
+            std::is_same<DrySampleType, double>::value;
+        const Kernels& kernels = Kernels::current();
+
+        if constexpr (dryIsDouble
+                      && std::is_same<SampleType, double>::value) {
+            kernels.mixDouble(outputArray, dryArray, filteredArray,
+                              count, dryFactor, wetFactor);
+        } else if constexpr (dryIsDouble) {
+            kernels.mixDouble(filteredArray, dryArray, filteredArray,
+                              count, dryFactor, wetFactor);
+            kernels.doubleToFloat(outputArray, filteredArray, count);
+        } else {
+            for (size_t i = 0;  i < count;  i++) {
+                outputArray[i] =
+                    (SampleType) ((double) dryArray[i] * dryFactor
+                                  + filteredArray[i] * wetFactor);
+            }
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies overdrive with <C>gain</C> and <C>colour</C> in place
+     * to the <C>sampleCount</C> samples in <C>sampleArray</C>: in
+     * chunks fitting into a scratch arena buffer the memoryless
+     * shaping is done as a single (vectorized) pass and afterwards
+     * the recursive DC blocker with its state in
+     * <C>previousInputSample</C> and <C>previousOutputSample</C>.
+     * The shaping uses <C>curve</C> and antiderivative
+     * anti-aliasing with its state in <C>previousShaperInput</C>
+     * and <C>previousAntiderivative</C> when
+     * <C>isAntiderivativeMode</C> is set.
+     *
+     * @tparam       SampleType              type of samples (float
+     *                                       or double)
+     * @param[inout] sampleArray             array of samples to be
+     *                                       processed
+     * @param[in]    sampleCount             number of samples in
+     *                                       array
+     * @param[in]    gain                    gain of overdrive (as a
+     *                                       factor)
+     * @param[in]    colour                  DC offset of overdrive
+     * @param[in]    curve                   curve of shaper
+     * @param[in]    isAntiderivativeMode    information whether
+     *                                       antiderivative
+     *                                       anti-aliasing is used
+     * @param[inout] previousShaperInput     last shaper input
+     * @param[inout] previousAntiderivative  antiderivative at last
+     *                                       shaper input
+     * @param[inout] previousInputSample     last input of DC blocker
+     * @param[inout] previousOutputSample    last output of DC blocker
+     */
+    template<typename SampleType>
+    static void _applyOverdrive (INOUT SampleType* sampleArray,
+                                 IN Natural sampleCount,
+                                 IN Real gain,
+                                 IN Real colour,
+                                 IN _ShaperCurve curve,
+                                 IN Boolean isAntiderivativeMode,
+                                 INOUT AudioSample& previousShaperInput,
+                                 INOUT AudioSample& previousAntiderivative,
+                                 INOUT AudioSample& previousInputSample,
+                                 INOUT AudioSample& previousOutputSample)
+    {
+        ScratchArena::Scope scratchScope;
+        AudioSample* wetArray =
+            scratchScope.allocate<AudioSample>
+                (HalfBandOversampler::maximumBlockLength);
+        SampleType* samplePtr = sampleArray;
+        Natural remainingCount = sampleCount;
+
+        while (remainingCount > 0) {
+            const Natural chunkLength =
+                Natural::minimum(remainingCount,
+                                 HalfBandOversampler::maximumBlockLength);
+            _shapeSamplesInMode(samplePtr, wetArray, chunkLength,
+                                gain, colour, curve,
+                                isAntiderivativeMode,
+                                previousShaperInput,
+                                previousAntiderivative);
+            _blockDCAndMix(samplePtr, wetArray, samplePtr, chunkLength,
+                           previousInputSample, previousOutputSample);
+            samplePtr      += (size_t) chunkLength;
+            remainingCount -= chunkLength;
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies overdrive with <C>gain</C> and <C>colour</C> in place
+     * to the <C>sampleCount</C> samples in <C>sampleArray</C> with
+     * the nonlinearity calculated at the rate raised by
+     * <C>oversampler</C>; the input is delayed by the oversampler
+     * latency for the dry part of the mix, the DC blocker with its
+     * state in <C>previousInputSample</C> and
+     * <C>previousOutputSample</C> runs at the original rate.  The
+     * shaper with <C>curve</C> and the antiderivative anti-aliasing
+     * (when <C>isAntiderivativeMode</C> is set) work at the raised
+     * rate, the latter with its state in
+     * <C>previousShaperInput</C> and <C>previousAntiderivative</C>.
+     * The samples are processed in chunks fitting into scratch arena
+     * buffers.
+     *
+     * @tparam       SampleType              type of samples (float
+     *                                       or double)
+     * @param[inout] oversampler             oversampler of channel
+     * @param[inout] sampleArray             array of samples to be
+     *                                       processed
+     * @param[in]    sampleCount             number of samples in
+     *                                       array
+     * @param[in]    gain                    gain of overdrive (as a
+     *                                       factor)
+     * @param[in]    colour                  DC offset of overdrive
+     * @param[in]    curve                   curve of shaper
+     * @param[in]    isAntiderivativeMode    information whether
+     *                                       antiderivative
+     *                                       anti-aliasing is used
+     * @param[inout] previousShaperInput     last shaper input
+     * @param[inout] previousAntiderivative  antiderivative at last
+     *                                       shaper input
+     * @param[inout] previousInputSample     last input of DC blocker
+     * @param[inout] previousOutputSample    last output of DC blocker
+     */
+    template<typename SampleType>
+    static void
+    _applyOversampledOverdrive
+        (INOUT HalfBandOversampler& oversampler,
+         INOUT SampleType* sampleArray,
+         IN Natural sampleCount,
+         IN Real gain,
+         IN Real colour,
+         IN _ShaperCurve curve,
+         IN Boolean isAntiderivativeMode,
+         INOUT AudioSample& previousShaperInput,
+         INOUT AudioSample& previousAntiderivative,
+         INOUT AudioSample& previousInputSample,
+         INOUT AudioSample& previousOutputSample)
+    {
+        const Natural factor = oversampler.factor();
+        const Natural maximumChunkLength =
+            HalfBandOversampler::maximumBlockLength;
+        ScratchArena::Scope scratchScope;
+        AudioSample* dryArray =
+            scratchScope.allocate<AudioSample>(maximumChunkLength);
+        AudioSample* wetArray =
+            scratchScope.allocate<AudioSample>(maximumChunkLength);
+        AudioSample* highRateArray =
+            scratchScope.allocate<AudioSample>(maximumChunkLength * factor);
+        SampleType* samplePtr = sampleArray;
+        Natural remainingCount = sampleCount;
+
+        while (remainingCount > 0) {
+            const Natural chunkLength =
+                Natural::minimum(remainingCount,
+                                 HalfBandOversampler::maximumBlockLength);
+            const size_t count = (size_t) chunkLength;
+            double* drySampleArray = (double*) dryArray;
+
+            for (size_t i = 0;  i < count;  i++) {
+                drySampleArray[i] = (double) samplePtr[i];
+            }
+
+            /* only the nonlinearity runs at the raised rate */
+            oversampler.upsample(dryArray, chunkLength, highRateArray);
+            _shapeSamplesInMode(highRateArray, highRateArray,
+                                chunkLength * factor, gain, colour,
+                                curve, isAntiderivativeMode,
+                                previousShaperInput,
+                                previousAntiderivative);
+            oversampler.downsample(highRateArray, chunkLength, wetArray);
+            oversampler.delay(dryArray, chunkLength);
+            _blockDCAndMix(drySampleArray, wetArray,
+                           samplePtr, chunkLength,
+                           previousInputSample, previousOutputSample);
+
+            samplePtr      += count;
+            remainingCount -= chunkLength;
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies overdrive described by <C>effectDescriptor</C> to the
+     * <C>sampleCount</C> samples in <C>sampleArray</C> of channel
+     * <C>channel</C>, oversampled when the oversampling factor of
+     * the effect is above one.
+     *
+     * @tparam       SampleType        type of samples (float or
+     *                                 double)
+     * @param[inout] effectDescriptor  overdrive parameters and state
+     * @param[in]    channel           index of channel
+     * @param[inout] sampleArray       array of samples to be
+     *                                 processed
+     * @param[in]    sampleCount       number of samples in array
+     */
+    template<typename SampleType>
+    static void
+    _applyOverdriveToChannel (INOUT _EffectDescriptor_OVRD& effectDescriptor,
+                              IN Natural channel,
+                              INOUT SampleType* sampleArray,
+                              IN Natural sampleCount)
+    {
+        const Real gain   = effectDescriptor.gain;
+        const Real colour = effectDescriptor.colour;
+        const _ShaperCurve curve = effectDescriptor.curve;
+        const Boolean isAntiderivativeMode =
+            effectDescriptor.isAntiderivativeMode;
+        HalfBandOversampler& oversampler =
+            *effectDescriptor.oversamplerList[channel];
+        AudioSample& previousShaperInput =
+            effectDescriptor.previousShaperInputList[channel];
+        AudioSample& previousAntiderivative =
+            effectDescriptor.previousAntiderivativeList[channel];
+        AudioSample& previousInputSample =
+            effectDescriptor.previousInputSampleList[channel];
+        AudioSample& previousOutputSample =
+            effectDescriptor.previousOutputSampleList[channel];
+
+        if (oversampler.factor() == 1) {
+            _applyOverdrive(sampleArray, sampleCount, gain, colour,
+                            curve, isAntiderivativeMode,
+                            previousShaperInput,
+                            previousAntiderivative,
+                            previousInputSample, previousOutputSample);
+        } else {
+            _applyOversampledOverdrive(oversampler,
+                                       sampleArray, sampleCount,
+                                       gain, colour, curve,
+                                       isAntiderivativeMode,
+                                       previousShaperInput,
+                                       previousAntiderivative,
+                                       previousInputSample,
+                                       previousOutputSample);
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies overdrive described by <C>effectDescriptor</C> in
+     * place to <C>channelCount</C> channels in <C>channelArray</C>
+     * with <C>sampleCount</C> samples each.
+     *
+     * @tparam       SampleType        type of samples (float or
+     *                                 double)
+     * @param[inout] effectDescriptor  overdrive parameters and state
+     * @param[inout] channelArray      array of pointers to the
+     *                                 samples per channel
+     * @param[in]    channelCount      number of channels
+     * @param[in]    sampleCount       number of samples per channel
+     */
+    template<typename SampleType>
+    static void
+    _applyOverdriveToChannels (INOUT _EffectDescriptor_OVRD& effectDescriptor,
+                               INOUT SampleType* const* channelArray,
+                               IN Natural channelCount,
+                               IN Natural sampleCount)
+    {
+        for (Natural channel = 0;  channel < channelCount;
+             channel++) {
+            _applyOverdriveToChannel(effectDescriptor, channel,
+                                     channelArray[(size_t) channel],
+                                     sampleCount);
+        }
+    }
+
 }
 
 /*============================================================*/
@@ -126,11 +1042,16 @@ SoXOverdrive_AudioEffect::SoXOverdrive_AudioEffect ()
     /* initialize descriptor */
     _effectDescriptor = _createEffectDescriptor();
 
-    /* initialize parameters */
-    _effectParameterMap.setKindAndValueInt(parameterName_gain,
-                                           0, 100, 1, 20);
-    _effectParameterMap.setKindAndValueInt(parameterName_colour,
-                                           0, 100, 1, 20);
+    /* initialize parameters from the definitions shared by all
+       instances */
+    static const SoXEffectParameterMap parameterMapPrototype =
+        _makeParameterMap();
+    _effectParameterMap = parameterMapPrototype;
+
+    /* the shaper table is calculated here and never on the audio
+       thread */
+    _tanhTable();
+
     Logging_trace1("<<: %1", toString());
 }
 
@@ -139,7 +1060,15 @@ SoXOverdrive_AudioEffect::SoXOverdrive_AudioEffect ()
 SoXOverdrive_AudioEffect::~SoXOverdrive_AudioEffect ()
 {
     Logging_trace(">>");
-    delete (_EffectDescriptor_OVRD*) _effectDescriptor;
+    _EffectDescriptor_OVRD* effectDescriptor =
+        (_EffectDescriptor_OVRD*) _effectDescriptor;
+
+    for (HalfBandOversampler* oversampler
+             : effectDescriptor->oversamplerList) {
+        delete oversampler;
+    }
+
+    delete effectDescriptor;
     Logging_trace("<<");
 }
 
@@ -174,13 +1103,194 @@ String SoXOverdrive_AudioEffect::name() const
     return "SoX Overdrive";
 }
 
+/*--------------------*/
+
+Real SoXOverdrive_AudioEffect::tailLength () const
+{
+    /* the DC blocker is the only recursion, the oversampling only
+       delays its input */
+    return (SoXAudioHelper::decayTime(0.995, Real::one / _sampleRate)
+            + Real{(double) latency()} / _sampleRate);
+}
+
+/*--------------------*/
+
+Natural SoXOverdrive_AudioEffect::latency () const
+{
+    _EffectDescriptor_OVRD& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_OVRD>(_effectDescriptor);
+    return effectDescriptor.oversamplerList[0]->latency();
+}
+
+/*--------------------*/
+/* memory footprint   */
+/*--------------------*/
+
+SoXMemoryFootprint SoXOverdrive_AudioEffect::memoryFootprint () const
+{
+    using FP = SoXMemoryFootprint;
+
+    _EffectDescriptor_OVRD& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_OVRD>(_effectDescriptor);
+    SoXMemoryFootprint result = SoXAudioEffect::memoryFootprint();
+    result.descriptorByteCount +=
+        (Natural{sizeof(_EffectDescriptor_OVRD)}
+         + FP::listByteCount(effectDescriptor.previousInputSampleList)
+         + FP::listByteCount(effectDescriptor.previousOutputSampleList)
+         + FP::listByteCount(effectDescriptor.previousShaperInputList)
+         + FP::listByteCount(effectDescriptor.previousAntiderivativeList)
+         + FP::listByteCount(effectDescriptor.oversamplerList));
+
+    for (const HalfBandOversampler* oversampler
+             : effectDescriptor.oversamplerList) {
+        result.descriptorByteCount += oversampler->byteCount();
+    }
+
+    return result;
+}
+
+/*--------------------*/
+/* mono processing    */
+/*--------------------*/
+
+Boolean SoXOverdrive_AudioEffect::hasMonoProcessing () const
+{
+    return true;
+}
+
+/*--------------------*/
+
+void
+SoXOverdrive_AudioEffect::copyFirstChannelState (IN Natural channelCount)
+{
+    Logging_trace1(">>: %1", TOSTRING(channelCount));
+
+    _EffectDescriptor_OVRD& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_OVRD>(_effectDescriptor);
+    _ensureChannelCount(effectDescriptor, channelCount);
+    GenericList<AudioSample>& previousInputSampleList =
+        effectDescriptor.previousInputSampleList;
+    GenericList<AudioSample>& previousOutputSampleList =
+        effectDescriptor.previousOutputSampleList;
+    GenericList<AudioSample>& previousShaperInputList =
+        effectDescriptor.previousShaperInputList;
+    GenericList<AudioSample>& previousAntiderivativeList =
+        effectDescriptor.previousAntiderivativeList;
+    const HalfBandOversampler& firstOversampler =
+        *effectDescriptor.oversamplerList[0];
+
+    for (Natural channel = 1;  channel < channelCount;  channel++) {
+        previousInputSampleList[channel]  = previousInputSampleList[0];
+        previousOutputSampleList[channel] = previousOutputSampleList[0];
+        previousShaperInputList[channel]  = previousShaperInputList[0];
+        previousAntiderivativeList[channel] =
+            previousAntiderivativeList[0];
+        effectDescriptor.oversamplerList[channel]
+            ->copyStateFrom(firstOversampler);
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+Boolean SoXOverdrive_AudioEffect::hasIndependentChannels () const
+{
+    return true;
+}
+
+/*--------------------*/
+/* DSP state          */
+/*--------------------*/
+
+Boolean SoXOverdrive_AudioEffect::hasDspStateSupport () const
+{
+    return true;
+}
+
+/*--------------------*/
+
+void SoXOverdrive_AudioEffect::_saveDspState (INOUT DspStateStream& stream)
+    const
+{
+    Logging_trace(">>");
+
+    const _EffectDescriptor_OVRD& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_OVRD>(_effectDescriptor);
+    stream.writeList(effectDescriptor.previousInputSampleList);
+    stream.writeList(effectDescriptor.previousOutputSampleList);
+    stream.writeList(effectDescriptor.previousShaperInputList);
+    stream.writeList(effectDescriptor.previousAntiderivativeList);
+
+    for (const HalfBandOversampler* oversampler
+             : effectDescriptor.oversamplerList) {
+        oversampler->saveState(stream);
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void
+SoXOverdrive_AudioEffect::_restoreDspState (INOUT DspStateStream& stream)
+{
+    Logging_trace(">>");
+
+    _EffectDescriptor_OVRD& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_OVRD>(_effectDescriptor);
+    _ensureChannelCount(effectDescriptor, _channelCount);
+    const Natural channelCount =
+        effectDescriptor.oversamplerList.length();
+    stream.readArray(effectDescriptor.previousInputSampleList.asArray(),
+                     channelCount);
+    stream.readArray(effectDescriptor.previousOutputSampleList.asArray(),
+                     channelCount);
+    stream.readArray(effectDescriptor.previousShaperInputList.asArray(),
+                     channelCount);
+    stream.readArray(effectDescriptor.previousAntiderivativeList
+                     .asArray(),
+                     channelCount);
+
+    for (HalfBandOversampler* oversampler
+             : effectDescriptor.oversamplerList) {
+        oversampler->restoreState(stream);
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXOverdrive_AudioEffect::_resetDspState ()
+{
+    Logging_trace(">>");
+
+    _EffectDescriptor_OVRD& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_OVRD>(_effectDescriptor);
+    const Natural channelCount =
+        effectDescriptor.oversamplerList.length();
+
+    /* all channels start over like new ones */
+    for (Natural channel = 0;  channel < channelCount;  channel++) {
+        effectDescriptor.previousInputSampleList[channel]    = 0.0;
+        effectDescriptor.previousOutputSampleList[channel]   = 0.0;
+        effectDescriptor.previousShaperInputList[channel]    = 0.0;
+        effectDescriptor.previousAntiderivativeList[channel] = 0.0;
+        effectDescriptor.oversamplerList[channel]->reset();
+    }
+
+    Logging_trace("<<");
+}
+
 /*--------------------*/
 /* parameter change   */
 /*--------------------*/
 
 SoXParameterValueChangeKind
 SoXOverdrive_AudioEffect::_setValueInternal
-                              (IN String& parameterName,
+                              (IN Natural parameterId,
+                               IN String& parameterName,
                                IN String& value,
                                IN Boolean recalculationIsForced)
 {
@@ -194,11 +1304,42 @@ SoXOverdrive_AudioEffect::_setValueInternal
     SoXParameterValueChangeKind result =
         SoXParameterValueChangeKind::parameterChange;
 
-    if (parameterName == parameterName_gain) {
-        const Real dBGain = STR::toReal(value);
-        effectDescriptor.gain = SoXAudioHelper::dBToLinear(dBGain);
-    } else if (parameterName == parameterName_colour) {
-        effectDescriptor.colour = STR::toReal(value) * colourFactor;
+    const Real numericValue = _effectParameterMap.numericValue(parameterId);
+
+    switch ((int) parameterId) {
+        case parameterId_gain:
+            effectDescriptor.gain = SoXAudioHelper::dBToLinear(numericValue);
+            break;
+
+        case parameterId_colour:
+            effectDescriptor.colour = numericValue * colourFactor;
+            break;
+
+        case parameterId_oversampling:
+            {
+                const Natural factor{(size_t) 1 << (int) numericValue};
+                effectDescriptor.oversamplingFactor = factor;
+
+                for (HalfBandOversampler* oversampler
+                         : effectDescriptor.oversamplerList) {
+                    oversampler->setFactor(factor);
+                }
+            }
+
+            break;
+
+        case parameterId_antiAliasing:
+            effectDescriptor.isAntiderivativeMode = (value == "ADAA");
+            break;
+
+        case parameterId_curve:
+            effectDescriptor.curve =
+                (value == "Tanh" ? _ShaperCurve::tanh
+                 : _ShaperCurve::cubic);
+            break;
+
+        default:
+            break;
     }
 
     Logging_trace1("<<: %1", SoXParameterValueChangeKind_toString(result));
@@ -211,6 +1352,11 @@ void SoXOverdrive_AudioEffect::setDefaultValues () {
     Logging_trace(">>");
     _effectParameterMap.setValue(parameterName_gain, "20");
     _effectParameterMap.setValue(parameterName_colour, "20");
+    _effectParameterMap.setValue(parameterName_oversampling,
+                                 _oversamplingList[0]);
+    _effectParameterMap.setValue(parameterName_antiAliasing,
+                                 _antiAliasingList[0]);
+    _effectParameterMap.setValue(parameterName_curve, _curveList[0]);
     Logging_trace1("<<: %1", toString());
 }
 
@@ -222,48 +1368,82 @@ void
 SoXOverdrive_AudioEffect::processBlock (IN Real timePosition,
                                         INOUT AudioSampleListVector& buffer)
 {
-    Logging_trace1(">>: %1", TOSTRING(timePosition));
+    Logging_traceHot1(">>: %1", TOSTRING(timePosition));
 
     SoXAudioEffect::processBlock(timePosition, buffer);
     _EffectDescriptor_OVRD& effectDescriptor =
         TOREFERENCE<_EffectDescriptor_OVRD>(_effectDescriptor);
 
     const Natural sampleCount = buffer[0].size();
-    const Real gain   = effectDescriptor.gain;
-    const Real colour = effectDescriptor.colour;
-    AudioSampleRingBufferVector& sampleRingBufferVector =
-        effectDescriptor.sampleRingBufferVector;
+    _ensureChannelCount(effectDescriptor, _channelCount);
 
     for (Natural channel = 0;  channel < _channelCount;
          channel++) {
-        AudioSampleRingBuffer& inputSampleRingBuffer =
-            sampleRingBufferVector.at(channel, 0);
-        AudioSampleRingBuffer& outputSampleRingBuffer =
-            sampleRingBufferVector.at(channel, 1);
-        const AudioSampleList& inputList  = buffer[channel];
-        AudioSampleList& outputList = buffer[channel];
-
-        for (Natural i = 0;  i < sampleCount;  i++) {
-            const AudioSample inputSample = inputList[i];
-            const AudioSample previousInputSample =
-                inputSampleRingBuffer.first();
-            const AudioSample previousOutputSample =
-                outputSampleRingBuffer.first();
-            AudioSample newValue;
-
-            newValue = (AudioSample) (inputSample * gain + colour);
-            newValue = newValue.forceToInterval(-1.0, 1.0);
-            newValue = (newValue - (newValue * newValue * newValue)
-                        / Real{3.0});
-            const AudioSample outputSample =
-                (newValue - previousInputSample
-                 + Real{0.995}  * previousOutputSample);
-            outputList[i] = (inputSample / Real::two
-                             + outputSample * Real{0.75});
-            inputSampleRingBuffer.setFirst(newValue);
-            outputSampleRingBuffer.setFirst(outputSample);
-        }
+        /* audio samples have the layout of doubles */
+        double* sampleArray = (double*) buffer[channel].asArray();
+        _applyOverdriveToChannel(effectDescriptor, channel,
+                                 sampleArray, sampleCount);
     }
 
-    Logging_trace("<<");
+    _guardFiniteness(buffer);
+
+    Logging_traceHot("<<");
+}
+
+/*--------------------*/
+
+Boolean SoXOverdrive_AudioEffect::hasFloatProcessing () const
+{
+    return true;
+}
+
+/*--------------------*/
+
+void
+SoXOverdrive_AudioEffect::processFloatBlock
+                              (IN Real timePosition,
+                               INOUT float* const* channelArray,
+                               IN Natural channelCount,
+                               IN Natural sampleCount)
+{
+    Logging_traceHot1(">>: %1", TOSTRING(timePosition));
+
+    _startBlock(timePosition, channelCount, sampleCount);
+    _EffectDescriptor_OVRD& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_OVRD>(_effectDescriptor);
+    _ensureChannelCount(effectDescriptor, _channelCount);
+    _applyOverdriveToChannels(effectDescriptor, channelArray,
+                              _channelCount, sampleCount);
+    _guardFiniteness(channelArray, _channelCount, sampleCount);
+
+    Logging_traceHot("<<");
+}
+
+/*--------------------*/
+
+Boolean SoXOverdrive_AudioEffect::hasDoubleProcessing () const
+{
+    return true;
+}
+
+/*--------------------*/
+
+void
+SoXOverdrive_AudioEffect::processDoubleBlock
+                              (IN Real timePosition,
+                               INOUT double* const* channelArray,
+                               IN Natural channelCount,
+                               IN Natural sampleCount)
+{
+    Logging_traceHot1(">>: %1", TOSTRING(timePosition));
+
+    _startBlock(timePosition, channelCount, sampleCount);
+    _EffectDescriptor_OVRD& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_OVRD>(_effectDescriptor);
+    _ensureChannelCount(effectDescriptor, _channelCount);
+    _applyOverdriveToChannels(effectDescriptor, channelArray,
+                              _channelCount, sampleCount);
+    _guardFiniteness(channelArray, _channelCount, sampleCount);
+
+    Logging_traceHot("<<");
 }
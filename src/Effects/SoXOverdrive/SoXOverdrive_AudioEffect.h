@@ -32,7 +32,7 @@ namespace SoXPlugins::Effects::SoXOverdrive {
      * with tanh distortion and adapting the colour by asymmetric
      * shaping
      */
-    struct SoXOverdrive_AudioEffect : public SoXAudioEffect {
+    struct SoXOverdrive_AudioEffect final : public SoXAudioEffect {
 
         /*---------------------*/
         /* setup & destruction */
@@ -56,6 +56,40 @@ namespace SoXPlugins::Effects::SoXOverdrive {
 
         String name () const override;
 
+        /*--------------------*/
+
+        Real tailLength () const override;
+
+        /*--------------------*/
+
+        Natural latency () const override;
+
+        /*--------------------*/
+        /* memory footprint   */
+        /*--------------------*/
+
+        SoXMemoryFootprint memoryFootprint () const override;
+
+        /*--------------------*/
+        /* mono processing    */
+        /*--------------------*/
+
+        Boolean hasMonoProcessing () const override;
+
+        /*--------------------*/
+
+        void copyFirstChannelState (IN Natural channelCount) override;
+
+        /*--------------------*/
+
+        Boolean hasIndependentChannels () const override;
+
+        /*--------------------*/
+        /* DSP state          */
+        /*--------------------*/
+
+        Boolean hasDspStateSupport () const override;
+
         /*--------------------*/
         /* parameter change   */
         /*--------------------*/
@@ -70,6 +104,30 @@ namespace SoXPlugins::Effects::SoXOverdrive {
                            INOUT AudioSampleListVector& buffer)
             override;
 
+        /*--------------------*/
+
+        Boolean hasFloatProcessing () const override;
+
+        /*--------------------*/
+
+        void processFloatBlock (IN Real timePosition,
+                                INOUT float* const* channelArray,
+                                IN Natural channelCount,
+                                IN Natural sampleCount)
+            override;
+
+        /*--------------------*/
+
+        Boolean hasDoubleProcessing () const override;
+
+        /*--------------------*/
+
+        void processDoubleBlock (IN Real timePosition,
+                                 INOUT double* const* channelArray,
+                                 IN Natural channelCount,
+                                 IN Natural sampleCount)
+            override;
+
         /*--------------------*/
         /*--------------------*/
 
@@ -81,11 +139,26 @@ namespace SoXPlugins::Effects::SoXOverdrive {
             /*--------------------*/
 
             SoXParameterValueChangeKind
-            _setValueInternal (IN String& parameterName,
+            _setValueInternal (IN Natural parameterId,
+                               IN String& parameterName,
                                IN String& value,
                                IN Boolean recalculationIsForced)
                 override;
 
+            /*--------------------*/
+
+            void _saveDspState (INOUT DspStateStream& stream) const
+                override;
+
+            /*--------------------*/
+
+            void _restoreDspState (INOUT DspStateStream& stream)
+                override;
+
+            /*--------------------*/
+
+            void _resetDspState () override;
+
     };
 
 }
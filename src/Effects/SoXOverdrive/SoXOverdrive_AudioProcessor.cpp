@@ -34,7 +34,7 @@ namespace SoXPlugins::Effects::SoXOverdrive {
         SoXOverdrive_AudioProcessor ()
         {
             Logging_initializeWithDefaults("SoXOverdrive", "SoXPlugins.");
-            _setAssociatedEffect(new SoXOverdrive_AudioEffect{});
+            _setAssociatedEffect(_makeEffect());
         }
 
         /*--------------------*/
@@ -44,6 +44,15 @@ namespace SoXPlugins::Effects::SoXOverdrive {
             return String("SoXOverdrive");
         }
 
+        /*--------------------*/
+
+        protected:
+
+            SoXAudioEffect* _makeEffect () const override
+            {
+                return new SoXOverdrive_AudioEffect{};
+            }
+
     };
 
 }
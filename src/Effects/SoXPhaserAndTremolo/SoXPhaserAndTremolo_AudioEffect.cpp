@@ -25,19 +25,37 @@
 #include <cmath>
 #include <cstdio>
 
+#include "GenericList.h"
 #include "Logging.h"
 #include "Percentage.h"
-#include "AudioSampleRingBufferVector.h"
+#include "ModulatedDelayLine.h"
 #include "WaveForm.h"
+#include "SoXAudioHelper.h"
 #include "SoXPhaserAndTremolo_AudioEffect.h"
 
+#if defined(AUDIO_USES_SIMD)
+    #if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+        #include <emmintrin.h>
+        /** SSE2 is used for the tremolo modulation */
+        #define SoXPhaserAndTremolo_usesSSE2
+    #elif defined(__aarch64__) || defined(_M_ARM64)
+        #include <arm_neon.h>
+        /** NEON is used for the tremolo modulation */
+        #define SoXPhaserAndTremolo_usesNEON
+    #endif
+#endif
+
 /*--------------------*/
 
-using Audio::AudioSampleRingBufferVector;
+using Audio::ModulatedDelayLine;
 using Audio::WaveForm;
+using Audio::WaveFormGenerator;
 using Audio::WaveFormKind;
 using Audio::WaveFormIteratorState;
+using BaseTypes::GenericTypes::GenericList;
 using BaseTypes::Primitives::Percentage;
+using SoXPlugins::Helpers::SoXAudioHelper;
+using SoXPlugins::Helpers::precisionProfileToString;
 using SoXPlugins::Effects::SoXPhaserAndTremolo
       ::SoXPhaserAndTremolo_AudioEffect;
 
@@ -51,6 +69,17 @@ namespace SoXPlugins::Effects::SoXPhaserAndTremolo {
     /** the maximum allowable delay in seconds */
     static const Real _maximumDelay = 0.005;
 
+    /** the number of modulation values rendered at once */
+    static const Natural _modulationChunkLength = 256;
+
+    /** the minimum number of samples between exact evaluations of
+     * the modulation for a reduced quality level */
+    static const Natural _coarseModulationControlInterval = 32;
+
+    /** the number of channels the delay lines are initially
+     * allocated for */
+    static const Natural _initialChannelCount = 2;
+
     /** the internal separator for lists */
     static const String separator = "/";
 
@@ -96,6 +125,15 @@ namespace SoXPlugins::Effects::SoXPhaserAndTremolo {
     /** the name for the waveform kind parameter */
     static const String parameterName_waveFormKind = "Waveform";
 
+    /** the identifications of the parameters in the parameter map
+     * (in order of definition) */
+    enum _ParameterId {
+        parameterId_effectKind, parameterId_inGain, parameterId_outGain,
+        parameterId_delayInMs, parameterId_decay, parameterId_depth,
+        parameterId_frequency, parameterId_waveFormKind,
+        parameterId_timeOffset
+    };
+
     /** the list of all parameter names */
     static const StringList _allParameterNameList =
         StringList::fromList({parameterName_decay,
@@ -174,14 +212,42 @@ namespace SoXPlugins::Effects::SoXPhaserAndTremolo {
         /** the modulation depth in percent */
         Percentage depth;
 
-        /** the sample ring buffer for the delay line */
-        AudioSampleRingBufferVector delayRingBufferList;
+        /** the delay lines per channel (owned by the descriptor) */
+        GenericList<ModulatedDelayLine*> delayLineList;
+
+        /** the sample pointers per channel of the current block
+         * (with the length of the delay line list) */
+        GenericList<double*> channelPointerList;
+
+        /** the delay length in samples */
+        Natural delayLineLength;
+
+        /** tells whether the delay follows the modulation
+         * fractionally instead of in integral samples like SoX */
+        Boolean hasFractionalDelay;
+
+        /** the buffer for a chunk of modulation values rendered
+         * from the waveform */
+        RealList modulationList;
+
+        /** the buffer for the delays of a chunk derived from the
+         * modulation values */
+        RealList delayList;
+
+        /** the sample rate the waveform and delay lines have been
+         * set up for (zero when not yet set up) */
+        Real settingsSampleRate;
 
-        /** the delay buffer length in samples */
-        Natural delayRingBufferLength;
+        /** the number of samples between exact evaluations of the
+         * modulation requested by the client */
+        Natural modulationControlInterval;
 
-        /** the pointer to the delay buffer (as an index) */
-        Natural delayRingBufferIndex;
+        /** information whether the quality level set by a load
+         * governor demands a coarse modulation control rate */
+        Boolean hasCoarseModulation;
+
+        /** the precision profile of the effect */
+        SoXPrecisionProfile precisionProfile;
 
         /*--------------------*/
         /*--------------------*/
@@ -205,13 +271,13 @@ namespace SoXPlugins::Effects::SoXPhaserAndTremolo {
 
             String st2 =
                 STR::expand(" waveForm = %1,"
-                            " delayRingBufferLength = %2,"
-                            " delayRingBufferIndex = %3,"
-                            " delayRingBufferList = %4",
+                            " delayLineLength = %2,"
+                            " hasFractionalDelay = %3,"
+                            " delayLine = %4",
                             waveForm.toString(),
-                            TOSTRING(delayRingBufferLength),
-                            TOSTRING(delayRingBufferIndex),
-                            delayRingBufferList.toString());
+                            TOSTRING(delayLineLength),
+                            TOSTRING(hasFractionalDelay),
+                            delayLineList[0]->toString());
 
             return STR::expand("_EffectDescriptor_PHTR(%1, %2)",
                                st1, st2);
@@ -225,6 +291,45 @@ namespace SoXPlugins::Effects::SoXPhaserAndTremolo {
     /* internal routines  */
     /*--------------------*/
 
+    /**
+     * Ensures that <C>effectDescriptor</C> has delay lines for at
+     * least <C>channelCount</C> channels together with the
+     * modulation buffers; new delay lines are cleared and have the
+     * current delay line length.  Allocates only when the channel
+     * count grows beyond all previous counts.
+     *
+     * @param[inout] effectDescriptor  phaser/tremolo parameters and
+     *                                 state
+     * @param[in]    channelCount      number of channels
+     */
+    static void
+    _ensureChannelCount (INOUT _EffectDescriptor_PHTR& effectDescriptor,
+                         IN Natural channelCount)
+    {
+        GenericList<ModulatedDelayLine*>& delayLineList =
+            effectDescriptor.delayLineList;
+
+        if (delayLineList.size() < channelCount) {
+            Logging_trace1(">>: %1", TOSTRING(channelCount));
+
+            while (delayLineList.size() < channelCount) {
+                ModulatedDelayLine* delayLine = new ModulatedDelayLine();
+                delayLine->setMaximumDelay(
+                    Natural::maximum(1, effectDescriptor.delayLineLength));
+                delayLineList.append(delayLine);
+            }
+
+            effectDescriptor.channelPointerList.setLength(channelCount);
+            effectDescriptor.modulationList
+                .setLength(_modulationChunkLength);
+            effectDescriptor.delayList.setLength(_modulationChunkLength);
+
+            Logging_trace("<<");
+        }
+    }
+
+    /*--------------------*/
+
     /**
      * Sets up a new phaser/tremolo effect descriptor based on
      * <C>sampleRate</C>
@@ -255,17 +360,67 @@ namespace SoXPlugins::Effects::SoXPhaserAndTremolo {
                 0.4,                                   /* decay */
                 40.0,                                  /* depth */
 
-                {2, false, maximumDelayBufferLength},  /* delayRingBufferList */
-                maximumDelayBufferLength,              /* delayRingBufferLength */
-                0                                      /* delayRingBufferIndex */
+                {},                                    /* delayLineList */
+                {},                                    /* channelPointerList */
+                maximumDelayBufferLength,              /* delayLineLength */
+                false                                  /* hasFractionalDelay */
             };
 
+        /* the delay lines and modulation buffers are allocated by
+           prepareToPlay */
+        result->settingsSampleRate = 0.0;
+        result->modulationControlInterval = 1;
+        result->hasCoarseModulation = false;
+        result->precisionProfile = SoXPrecisionProfile::soxExact;
+
         Logging_trace1("<<: %1", result->toString());
         return result;
     }
 
     /*--------------------*/
 
+    /**
+     * Returns a parameter map with the definitions of all phaser
+     * and tremolo parameters; this is done once per process and the
+     * map is used as a prototype for each effect instance.
+     *
+     * @return parameter map with all parameter definitions
+     */
+    static SoXEffectParameterMap _makeParameterMap ()
+    {
+        Logging_trace(">>");
+
+        SoXEffectParameterMap result;
+        const String effectKind = _kindList[0];
+        const StringList waveFormKindValueList =
+            StringList::makeBySplit("Sine/Triangle", separator);
+
+        result.setKindAndValueEnum(parameterName_effectKind,
+                                   _kindList, effectKind);
+        result.setKindReal(parameterName_inGain,
+                           0.0, 1.0, 0.001);
+        result.setKindReal(parameterName_outGain,
+                           0.0, 1000.0, 0.001);
+        result.setKindReal(parameterName_delayInMs,
+                           0.0, 5.0, 0.001);
+        result.setKindReal(parameterName_decay,
+                           0.0, 0.99, 0.001);
+        result.setKindReal(parameterName_depth,
+                           0.0, 100.0, 0.001);
+        result.setKindReal(parameterName_frequency,
+                           0.1, 2.0, 0.001);
+        result.setKindEnum(parameterName_waveFormKind,
+                           waveFormKindValueList);
+        result.setKindReal(parameterName_timeOffset,
+                           -8192.0, +8192.0,
+                           Real::two.power(-16.0));
+
+        Logging_trace("<<");
+        return result;
+    }
+
+    /*--------------------*/
+
     /**
      * Updates effect parameters in <C>parameterMap</C> for effect
      * kind given as <C>effectKind</C>.
@@ -300,6 +455,27 @@ namespace SoXPlugins::Effects::SoXPhaserAndTremolo {
 
     /*--------------------*/
 
+    /**
+     * Returns the phase of the modulation waveform in
+     * <C>effectDescriptor</C> at time <C>currentTime</C> locked to
+     * its time offset.
+     *
+     * @param[in] effectDescriptor  descriptor of effect
+     * @param[in] currentTime       current time for effect
+     * @return  phase of waveform in radians
+     */
+    static Radians
+    _phaseAtTime (IN _EffectDescriptor_PHTR& effectDescriptor,
+                  IN Real currentTime)
+    {
+        return (_defaultPhase
+                + WaveForm::phaseByTime(effectDescriptor.frequency,
+                                        effectDescriptor.timeOffset,
+                                        currentTime));
+    }
+
+    /*--------------------*/
+
     /**
      * Recalculates derived parameters in <C>effectDescriptor</C> from
      * parameter map and <C>sampleRate</C> and start time in
@@ -318,18 +494,18 @@ namespace SoXPlugins::Effects::SoXPhaserAndTremolo {
 
         const Real frequency = effectDescriptor.frequency;
         const Real waveFormLength = sampleRate / frequency;
-        Natural delayRingBufferLength;
+        Natural delayLineLength;
         Real lowModulationValue;
         Real highModulationValue;
         Boolean hasIntegerValues;
 
         if (effectDescriptor.isPhaser) {
             /* phaser */
-            delayRingBufferLength =
+            delayLineLength =
                 Natural{Real::round(effectDescriptor.delay * sampleRate)};
             lowModulationValue  = 1.0;
-            highModulationValue = Real{delayRingBufferLength};
-            hasIntegerValues = true;
+            highModulationValue = Real{delayLineLength};
+            hasIntegerValues = !effectDescriptor.hasFractionalDelay;
         } else {
             /* tremolo: set some effect parameters to constants */
             effectDescriptor.delay   = 0.0;
@@ -337,7 +513,7 @@ namespace SoXPlugins::Effects::SoXPhaserAndTremolo {
             effectDescriptor.outGain = 1.0;
             effectDescriptor.waveFormKind = WaveFormKind::sine;
 
-            delayRingBufferLength = 0;
+            delayLineLength = 0;
             lowModulationValue =
                 Real{1.0} - effectDescriptor.depth / Real{100.0};
             highModulationValue = 1.0;
@@ -345,28 +521,289 @@ namespace SoXPlugins::Effects::SoXPhaserAndTremolo {
         }
 
         /* delay settings */
-        effectDescriptor.delayRingBufferIndex  = 0;
-        effectDescriptor.delayRingBufferLength = delayRingBufferLength;
-        AudioSampleRingBufferVector& ringBufferList =
-            effectDescriptor.delayRingBufferList;
-        ringBufferList.setRingBufferLength(delayRingBufferLength);
-        ringBufferList.setToZero();
+        effectDescriptor.delayLineLength = delayLineLength;
+
+        for (ModulatedDelayLine* delayLine
+                 : effectDescriptor.delayLineList) {
+            delayLine->setMaximumDelay(Natural::maximum(1, delayLineLength));
+        }
 
         /* waveform */
         const Radians effectivePhase =
-            (_defaultPhase
-             + WaveForm::phaseByTime(frequency,
-                                        effectDescriptor.timeOffset,
-                                        currentTime));
+            _phaseAtTime(effectDescriptor, currentTime);
 
         WaveForm& waveForm = effectDescriptor.waveForm;
         waveForm.set(waveFormLength, effectDescriptor.waveFormKind,
                      lowModulationValue, highModulationValue,
                      effectivePhase, hasIntegerValues);
+        effectDescriptor.settingsSampleRate = sampleRate;
 
         Logging_trace1("<<: %1", effectDescriptor.toString());
     }
 
+    /*--------------------*/
+
+    /**
+     * Resynchronizes the modulation waveform in
+     * <C>effectDescriptor</C> to <C>currentTime</C> after a jump of
+     * the playhead: when the settings belong to <C>sampleRate</C>,
+     * only the phase of the waveform is repositioned in constant
+     * time and the delay lines are kept, otherwise all derived
+     * settings are recalculated (a frequency change already does
+     * this when it is set).
+     *
+     * @param[inout] effectDescriptor  descriptor of effect
+     * @param[in]    sampleRate        sample rate for effect
+     * @param[in]    currentTime       current time for effect
+     */
+    static void
+    _resynchronize (INOUT _EffectDescriptor_PHTR& effectDescriptor,
+                    IN Real sampleRate, IN Real currentTime)
+    {
+        if (effectDescriptor.settingsSampleRate != sampleRate) {
+            _updateSettings(effectDescriptor, sampleRate, currentTime);
+        } else {
+            effectDescriptor.waveForm
+                .setPhase(_phaseAtTime(effectDescriptor, currentTime));
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Sets the control interval of the modulation waveform in
+     * <C>effectDescriptor</C> from the interval requested by the
+     * client, coarsened for a reduced quality level or the fast
+     * precision profile; since the modulation is interpolated
+     * between exact evaluations, a change does not cause a
+     * discontinuity.
+     *
+     * @param[inout] effectDescriptor  descriptor of effect
+     */
+    static void
+    _updateModulationControlInterval
+        (INOUT _EffectDescriptor_PHTR& effectDescriptor)
+    {
+        const Boolean isCoarse =
+            (effectDescriptor.hasCoarseModulation
+             || (effectDescriptor.precisionProfile
+                 == SoXPrecisionProfile::fast));
+        const Natural controlInterval =
+            (!isCoarse
+             ? effectDescriptor.modulationControlInterval
+             : Natural::maximum(_coarseModulationControlInterval,
+                                effectDescriptor.modulationControlInterval));
+        effectDescriptor.waveForm.setControlInterval(controlInterval);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Multiplies the <C>sampleCount</C> float samples in
+     * <C>sampleArray</C> in place by the factors in
+     * <C>factorArray</C>.
+     *
+     * @param[inout] sampleArray  array of samples to be processed
+     * @param[in]    factorArray  array of factors
+     * @param[in]    sampleCount  number of samples in arrays
+     */
+    static void _multiplySamples (INOUT float* sampleArray,
+                                  IN Real* factorArray,
+                                  IN Natural sampleCount)
+    {
+        const double* factorPtr = (const double*) factorArray;
+        const size_t count = (size_t) sampleCount;
+        size_t i = 0;
+
+        #if defined(SoXPhaserAndTremolo_usesSSE2)
+            for (;  i + 4 <= count;  i += 4) {
+                const __m128 factorsA =
+                    _mm_cvtpd_ps(_mm_loadu_pd(factorPtr + i));
+                const __m128 factorsB =
+                    _mm_cvtpd_ps(_mm_loadu_pd(factorPtr + i + 2));
+                const __m128 factors = _mm_movelh_ps(factorsA, factorsB);
+                _mm_storeu_ps(sampleArray + i,
+                              _mm_mul_ps(_mm_loadu_ps(sampleArray + i),
+                                         factors));
+            }
+        #elif defined(SoXPhaserAndTremolo_usesNEON)
+            for (;  i + 4 <= count;  i += 4) {
+                const float32x4_t factors =
+                    vcombine_f32(vcvt_f32_f64(vld1q_f64(factorPtr + i)),
+                                 vcvt_f32_f64(vld1q_f64(factorPtr + i + 2)));
+                vst1q_f32(sampleArray + i,
+                          vmulq_f32(vld1q_f32(sampleArray + i), factors));
+            }
+        #endif
+
+        /* scalar fallback and remainder */
+        for (;  i < count;  i++) {
+            sampleArray[i] = sampleArray[i] * (float) factorPtr[i];
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Multiplies the <C>sampleCount</C> double samples in
+     * <C>sampleArray</C> in place by the factors in
+     * <C>factorArray</C>.
+     *
+     * @param[inout] sampleArray  array of samples to be processed
+     * @param[in]    factorArray  array of factors
+     * @param[in]    sampleCount  number of samples in arrays
+     */
+    static void _multiplySamples (INOUT double* sampleArray,
+                                  IN Real* factorArray,
+                                  IN Natural sampleCount)
+    {
+        const double* factorPtr = (const double*) factorArray;
+        const size_t count = (size_t) sampleCount;
+        size_t i = 0;
+
+        #if defined(SoXPhaserAndTremolo_usesSSE2)
+            for (;  i + 2 <= count;  i += 2) {
+                _mm_storeu_pd(sampleArray + i,
+                              _mm_mul_pd(_mm_loadu_pd(sampleArray + i),
+                                         _mm_loadu_pd(factorPtr + i)));
+            }
+        #elif defined(SoXPhaserAndTremolo_usesNEON)
+            for (;  i + 2 <= count;  i += 2) {
+                vst1q_f64(sampleArray + i,
+                          vmulq_f64(vld1q_f64(sampleArray + i),
+                                    vld1q_f64(factorPtr + i)));
+            }
+        #endif
+
+        /* scalar fallback and remainder */
+        for (;  i < count;  i++) {
+            sampleArray[i] = sampleArray[i] * factorPtr[i];
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies tremolo modulation from <C>waveForm</C> in place to
+     * <C>channelCount</C> channels in <C>channelArray</C> with
+     * <C>sampleCount</C> samples each and advances the waveform by
+     * that number of samples; the modulation is rendered once per
+     * chunk into <C>modulationList</C> and shared by all channels.
+     *
+     * @tparam       SampleType      type of samples (float or double)
+     * @param[inout] channelArray    array of pointers to the samples
+     *                               per channel
+     * @param[in]    channelCount    number of channels
+     * @param[in]    sampleCount     number of samples per channel
+     * @param[inout] waveForm        modulation waveform
+     * @param[inout] modulationList  buffer for the modulation values
+     */
+    template<typename SampleType>
+    static void _applyTremoloToChannels (INOUT SampleType* const* channelArray,
+                                         IN Natural channelCount,
+                                         IN Natural sampleCount,
+                                         INOUT WaveForm& waveForm,
+                                         INOUT RealList& modulationList)
+    {
+        const Natural chunkLength = modulationList.length();
+        Real* modulationArray = modulationList.asArray();
+        Natural position = 0;
+
+        while (position < sampleCount) {
+            const Natural count =
+                Natural::minimum(chunkLength, sampleCount - position);
+            waveForm.render(modulationArray, count);
+
+            for (Natural channel = 0;  channel < channelCount;
+                 channel++) {
+                SampleType* sampleArray = channelArray[(size_t) channel];
+                _multiplySamples(sampleArray + (size_t) position,
+                                 modulationArray, count);
+            }
+
+            position += count;
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies the phaser from <C>effectDescriptor</C> in place to
+     * <C>channelCount</C> channels in <C>channelArray</C> with
+     * <C>sampleCount</C> samples each using the delay lines of the
+     * descriptor and advances the waveform by that number of
+     * samples; the modulation is rendered once per chunk, converted
+     * into delays in samples and shared by all channels.
+     *
+     * @param[inout] channelArray      array of pointers to the
+     *                                 samples per channel
+     * @param[in]    channelCount      number of channels
+     * @param[in]    sampleCount       number of samples per channel
+     * @param[inout] effectDescriptor  descriptor of effect
+     */
+    static void
+    _applyPhaserToChannels (INOUT double* const* channelArray,
+                            IN Natural channelCount,
+                            IN Natural sampleCount,
+                            INOUT _EffectDescriptor_PHTR& effectDescriptor)
+    {
+        const double inGain  = (double) effectDescriptor.inGain;
+        const double outGain = (double) effectDescriptor.outGain;
+        const double decay   = (double) effectDescriptor.decay;
+        const Natural delayLineLength = effectDescriptor.delayLineLength;
+        WaveForm& waveForm = effectDescriptor.waveForm;
+        Real* modulationArray = effectDescriptor.modulationList.asArray();
+
+        /* the modulation values and delays have the layout of
+           doubles */
+        const double* modulationValueArray = (double*) modulationArray;
+        double* delayArray = (double*) effectDescriptor.delayList.asArray();
+
+        /* a modulation value m reads the delay line at the position
+           m after the last written sample in a ring of the delay line
+           length; this is a delay of length + 1 - m samples */
+        const double delayOffset = (double) delayLineLength + 1.0;
+        Natural position = 0;
+
+        while (position < sampleCount) {
+            const Natural count =
+                Natural::minimum(_modulationChunkLength,
+                                 sampleCount - position);
+            waveForm.render(modulationArray, count);
+
+            for (size_t j = 0;  j < (size_t) count;  j++) {
+                delayArray[j] = delayOffset - modulationValueArray[j];
+            }
+
+            for (Natural channel = 0;  channel < channelCount;
+                 channel++) {
+                double* chunkArray =
+                    channelArray[(size_t) channel] + (size_t) position;
+
+                if (delayLineLength == 0) {
+                    for (size_t j = 0;  j < (size_t) count;  j++) {
+                        chunkArray[j] = 0.0;
+                    }
+                } else {
+                    for (size_t j = 0;  j < (size_t) count;  j++) {
+                        chunkArray[j] *= inGain;
+                    }
+
+                    ModulatedDelayLine& delayLine =
+                        *effectDescriptor.delayLineList[channel];
+                    delayLine.applyFeedbackComb(chunkArray, delayArray,
+                                                count, decay);
+
+                    for (size_t j = 0;  j < (size_t) count;  j++) {
+                        chunkArray[j] *= outGain;
+                    }
+                }
+            }
+
+            position += count;
+        }
+    }
+
 }
 
 /*============================================================*/
@@ -382,31 +819,11 @@ SoXPhaserAndTremolo_AudioEffect::SoXPhaserAndTremolo_AudioEffect ()
     /* initialize descriptor */
     _effectDescriptor = _createEffectDescriptor(_sampleRate);
 
-    /* initialize parameters */
-    const String effectKind = _kindList[0];
-    const StringList waveFormKindValueList =
-        StringList::makeBySplit("Sine/Triangle", separator);
-
-    _effectParameterMap.clear();
-    _effectParameterMap.setKindAndValueEnum(parameterName_effectKind,
-                                            _kindList, effectKind);
-    _effectParameterMap.setKindReal(parameterName_inGain,
-                                    0.0, 1.0, 0.001);
-    _effectParameterMap.setKindReal(parameterName_outGain,
-                                    0.0, 1000.0, 0.001);
-    _effectParameterMap.setKindReal(parameterName_delayInMs,
-                                    0.0, 5.0, 0.001);
-    _effectParameterMap.setKindReal(parameterName_decay,
-                                    0.0, 0.99, 0.001);
-    _effectParameterMap.setKindReal(parameterName_depth,
-                                    0.0, 100.0, 0.001);
-    _effectParameterMap.setKindReal(parameterName_frequency,
-                                    0.1, 2.0, 0.001);
-    _effectParameterMap.setKindEnum(parameterName_waveFormKind,
-                                    waveFormKindValueList);
-    _effectParameterMap.setKindReal(parameterName_timeOffset,
-                                    -8192.0, +8192.0,
-                                    Real::two.power(-16.0));
+    /* initialize parameters from the definitions shared by all
+       instances */
+    static const SoXEffectParameterMap parameterMapPrototype =
+        _makeParameterMap();
+    _effectParameterMap = parameterMapPrototype;
 
     Logging_trace1("<<: %1", toString());
 }
@@ -416,7 +833,15 @@ SoXPhaserAndTremolo_AudioEffect::SoXPhaserAndTremolo_AudioEffect ()
 SoXPhaserAndTremolo_AudioEffect::~SoXPhaserAndTremolo_AudioEffect ()
 {
     Logging_trace(">>");
-    delete (_EffectDescriptor_PHTR*) _effectDescriptor;
+    _EffectDescriptor_PHTR* effectDescriptor =
+        (_EffectDescriptor_PHTR*) _effectDescriptor;
+
+    for (ModulatedDelayLine* delayLine
+             : effectDescriptor->delayLineList) {
+        delete delayLine;
+    }
+
+    delete effectDescriptor;
     Logging_trace("<<");
 }
 
@@ -451,13 +876,198 @@ String SoXPhaserAndTremolo_AudioEffect::name() const
     return "SoX Phaser & Tremolo";
 }
 
+/*--------------------*/
+
+Real SoXPhaserAndTremolo_AudioEffect::tailLength () const
+{
+    _EffectDescriptor_PHTR& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_PHTR>(_effectDescriptor);
+    Real result = 0.0;
+
+    if (effectDescriptor.isPhaser) {
+        /* the delay line feeds back with the decay factor at most
+           every delay time */
+        const Real delay = effectDescriptor.delay;
+        result = (delay
+                  + SoXAudioHelper::decayTime(effectDescriptor.decay,
+                                              delay));
+    }
+
+    return result;
+}
+
+/*--------------------*/
+
+Real SoXPhaserAndTremolo_AudioEffect::warmupLength () const
+{
+    _EffectDescriptor_PHTR& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_PHTR>(_effectDescriptor);
+
+    /* the phaser reads its delay line at integer positions from the
+       waveform table; a waveform resynchronized from the time
+       position may hit a neighbouring position, hence a phaser
+       cannot be rendered in segments identical to a continuous
+       rendering */
+    return (effectDescriptor.isPhaser ? Real::infinity
+            : SoXAudioEffect::warmupLength());
+}
+
+/*--------------------*/
+/* memory footprint   */
+/*--------------------*/
+
+SoXMemoryFootprint
+SoXPhaserAndTremolo_AudioEffect::memoryFootprint () const
+{
+    using FP = SoXMemoryFootprint;
+
+    _EffectDescriptor_PHTR& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_PHTR>(_effectDescriptor);
+    SoXMemoryFootprint result = SoXAudioEffect::memoryFootprint();
+
+    for (const ModulatedDelayLine* delayLine
+             : effectDescriptor.delayLineList) {
+        result.delayLineByteCount += delayLine->byteCount();
+    }
+
+    /* the wave tables are shared by all instances and not
+       counted */
+    result.descriptorByteCount +=
+        (Natural{sizeof(_EffectDescriptor_PHTR)}
+         + FP::listByteCount(effectDescriptor.delayLineList)
+         + FP::listByteCount(effectDescriptor.channelPointerList)
+         + FP::listByteCount(effectDescriptor.modulationList)
+         + FP::listByteCount(effectDescriptor.delayList));
+    return result;
+}
+
+/*--------------------*/
+/* mono processing    */
+/*--------------------*/
+
+Boolean SoXPhaserAndTremolo_AudioEffect::hasMonoProcessing () const
+{
+    /* the tremolo modulates all channels identically, the phaser
+       has a delay line per channel */
+    _EffectDescriptor_PHTR& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_PHTR>(_effectDescriptor);
+    return !effectDescriptor.isPhaser;
+}
+
+/*--------------------*/
+/* DSP state          */
+/*--------------------*/
+
+Boolean SoXPhaserAndTremolo_AudioEffect::hasDspStateSupport () const
+{
+    return true;
+}
+
+/*--------------------*/
+
+void
+SoXPhaserAndTremolo_AudioEffect::_saveDspState
+                                     (INOUT DspStateStream& stream) const
+{
+    Logging_trace(">>");
+
+    const _EffectDescriptor_PHTR& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_PHTR>(_effectDescriptor);
+    const GenericList<ModulatedDelayLine*>& delayLineList =
+        effectDescriptor.delayLineList;
+    effectDescriptor.waveForm.saveState(stream);
+    stream.write(Natural{delayLineList.size()});
+
+    for (const ModulatedDelayLine* delayLine : delayLineList) {
+        delayLine->saveState(stream);
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void
+SoXPhaserAndTremolo_AudioEffect::_restoreDspState
+                                     (INOUT DspStateStream& stream)
+{
+    Logging_trace(">>");
+
+    _EffectDescriptor_PHTR& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_PHTR>(_effectDescriptor);
+    const GenericList<ModulatedDelayLine*>& delayLineList =
+        effectDescriptor.delayLineList;
+    Natural delayLineCount;
+
+    /* the derived settings are only calculated by the first block
+       after preparation, hence they are brought to the current
+       sample rate before the wave form and delay lines are
+       overwritten */
+    _resynchronize(effectDescriptor, _sampleRate, _currentTimePosition);
+    effectDescriptor.waveForm.restoreState(stream);
+    stream.read(delayLineCount);
+    _ensureChannelCount(effectDescriptor, delayLineCount);
+
+    if (delayLineCount != Natural{delayLineList.size()}) {
+        stream.invalidate();
+    }
+
+    for (ModulatedDelayLine* delayLine : delayLineList) {
+        delayLine->restoreState(stream);
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXPhaserAndTremolo_AudioEffect::_resetDspState ()
+{
+    Logging_trace(">>");
+
+    _EffectDescriptor_PHTR& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_PHTR>(_effectDescriptor);
+
+    /* only the phaser feedback lines carry state between samples,
+       the modulation keeps running */
+    for (ModulatedDelayLine* delayLine : effectDescriptor.delayLineList) {
+        delayLine->clear();
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* quality level      */
+/*--------------------*/
+
+Natural SoXPhaserAndTremolo_AudioEffect::qualityLevelCount () const
+{
+    return 2;
+}
+
+/*--------------------*/
+
+void SoXPhaserAndTremolo_AudioEffect::setQualityLevel (IN Natural level)
+{
+    Logging_trace1(">>: %1", TOSTRING(level));
+
+    _EffectDescriptor_PHTR& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_PHTR>(_effectDescriptor);
+    effectDescriptor.hasCoarseModulation = (level >= 1);
+    _updateModulationControlInterval(effectDescriptor);
+
+    Logging_trace("<<");
+}
+
 /*--------------------*/
 /* parameter change   */
 /*--------------------*/
 
 SoXParameterValueChangeKind
 SoXPhaserAndTremolo_AudioEffect::_setValueInternal
-                                      (IN String& parameterName,
+                                      (IN Natural parameterId,
+                                       IN String& parameterName,
                                        IN String& value,
                                        IN Boolean recalculationIsForced)
 {
@@ -471,7 +1081,7 @@ SoXPhaserAndTremolo_AudioEffect::_setValueInternal
     SoXParameterValueChangeKind result =
         SoXParameterValueChangeKind::parameterChange;
 
-    if (parameterName == parameterName_effectKind) {
+    if ((int) parameterId == parameterId_effectKind) {
         _updateParametersForKind(_effectParameterMap, value);
         effectDescriptor.isPhaser = (value != _tremoloEffectKind);
         result = SoXParameterValueChangeKind::globalChange;
@@ -480,24 +1090,46 @@ SoXPhaserAndTremolo_AudioEffect::_setValueInternal
             (recalculationIsForced
              && _effectParameterMap.isActive(parameterName));
 
-        if (parameterName == parameterName_decay) {
-            effectDescriptor.decay = STR::toReal(value);
-        } else if (parameterName == parameterName_delayInMs) {
-            effectDescriptor.delay = STR::toReal(value) / 1000.0;
-        } else if (parameterName == parameterName_depth) {
-            effectDescriptor.depth = STR::toPercentage(value);
-        } else if (parameterName == parameterName_frequency) {
-            effectDescriptor.frequency = STR::toReal(value);
-        } else if (parameterName == parameterName_inGain) {
-            effectDescriptor.inGain = STR::toReal(value);
-        } else if (parameterName == parameterName_outGain) {
-            effectDescriptor.outGain = STR::toReal(value);
-        } else if (parameterName == parameterName_waveFormKind) {
-            effectDescriptor.waveFormKind = (value == "Sine"
-                                              ? WaveFormKind::sine
-                                              : WaveFormKind::triangle);
-        } else if (parameterName == parameterName_timeOffset) {
-            effectDescriptor.timeOffset = STR::toReal(value);
+        const Real numericValue =
+            _effectParameterMap.numericValue(parameterId);
+
+        switch ((int) parameterId) {
+            case parameterId_decay:
+                effectDescriptor.decay = numericValue;
+                break;
+
+            case parameterId_delayInMs:
+                effectDescriptor.delay = numericValue / 1000.0;
+                break;
+
+            case parameterId_depth:
+                effectDescriptor.depth = Percentage{numericValue};
+                break;
+
+            case parameterId_frequency:
+                effectDescriptor.frequency = numericValue;
+                break;
+
+            case parameterId_inGain:
+                effectDescriptor.inGain = numericValue;
+                break;
+
+            case parameterId_outGain:
+                effectDescriptor.outGain = numericValue;
+                break;
+
+            case parameterId_waveFormKind:
+                effectDescriptor.waveFormKind = (value == "Sine"
+                                                 ? WaveFormKind::sine
+                                                 : WaveFormKind::triangle);
+                break;
+
+            case parameterId_timeOffset:
+                effectDescriptor.timeOffset = numericValue;
+                break;
+
+            default:
+                break;
         }
 
         if (effectIsUpdated) {
@@ -512,6 +1144,19 @@ SoXPhaserAndTremolo_AudioEffect::_setValueInternal
 
 /*--------------------*/
 
+void SoXPhaserAndTremolo_AudioEffect::recalculateSettings ()
+{
+    Logging_trace(">>");
+
+    _EffectDescriptor_PHTR& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_PHTR>(_effectDescriptor);
+    _updateSettings(effectDescriptor, _sampleRate, _currentTimePosition);
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
 void SoXPhaserAndTremolo_AudioEffect::setDefaultValues ()
 {
     Logging_trace(">>");
@@ -536,16 +1181,125 @@ void SoXPhaserAndTremolo_AudioEffect::setDefaultValues ()
     Logging_trace1("<<: %1", toString());
 }
 
+/*--------------------*/
+
+void SoXPhaserAndTremolo_AudioEffect::setModulationControlInterval
+                                         (IN Natural sampleCount)
+{
+    Logging_trace1(">>: %1", TOSTRING(sampleCount));
+
+    _EffectDescriptor_PHTR& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_PHTR>(_effectDescriptor);
+    effectDescriptor.modulationControlInterval = sampleCount;
+    _updateModulationControlInterval(effectDescriptor);
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXPhaserAndTremolo_AudioEffect::setFractionalModulation
+                                         (IN Boolean isFractional)
+{
+    Logging_trace1(">>: %1", TOSTRING(isFractional));
+
+    _EffectDescriptor_PHTR& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_PHTR>(_effectDescriptor);
+    effectDescriptor.hasFractionalDelay = isFractional;
+    _updateSettings(effectDescriptor, _sampleRate, _currentTimePosition);
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXPhaserAndTremolo_AudioEffect::setRotatorModulation
+                                         (IN Boolean isRotator)
+{
+    Logging_trace1(">>: %1", TOSTRING(isRotator));
+
+    _EffectDescriptor_PHTR& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_PHTR>(_effectDescriptor);
+    effectDescriptor.waveForm.setGenerator(isRotator
+                                           ? WaveFormGenerator::rotator
+                                           : WaveFormGenerator::table);
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* precision profile  */
+/*--------------------*/
+
+void SoXPhaserAndTremolo_AudioEffect::setPrecisionProfile
+                                         (IN SoXPrecisionProfile profile)
+{
+    Logging_trace1(">>: %1", precisionProfileToString(profile));
+
+    _EffectDescriptor_PHTR& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_PHTR>(_effectDescriptor);
+    const Boolean isHighQuality =
+        (profile == SoXPrecisionProfile::highQuality);
+    effectDescriptor.precisionProfile = profile;
+    _updateModulationControlInterval(effectDescriptor);
+    setRotatorModulation(isHighQuality);
+
+    if (isHighQuality != effectDescriptor.hasFractionalDelay) {
+        setFractionalModulation(isHighQuality);
+    }
+
+    Logging_trace("<<");
+}
+
 /*--------------------*/
 /* event handling     */
 /*--------------------*/
 
+void SoXPhaserAndTremolo_AudioEffect::prepareToPlay (IN Real sampleRate)
+{
+    Logging_trace1(">>: %1", TOSTRING(sampleRate));
+
+    SoXAudioEffect::prepareToPlay(sampleRate);
+    _EffectDescriptor_PHTR& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_PHTR>(_effectDescriptor);
+    _ensureChannelCount(effectDescriptor,
+                        Natural::maximum(_initialChannelCount,
+                                         _channelCount));
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXPhaserAndTremolo_AudioEffect::releaseResources ()
+{
+    Logging_trace(">>");
+
+    SoXAudioEffect::releaseResources();
+    _EffectDescriptor_PHTR& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_PHTR>(_effectDescriptor);
+
+    for (ModulatedDelayLine* delayLine
+             : effectDescriptor.delayLineList) {
+        delete delayLine;
+    }
+
+    effectDescriptor.delayLineList = {};
+    effectDescriptor.channelPointerList = {};
+    effectDescriptor.modulationList = {};
+    effectDescriptor.delayList = {};
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
 void
 SoXPhaserAndTremolo_AudioEffect::processBlock
                                     (IN Real timePosition,
                                      INOUT AudioSampleListVector& buffer)
 {
-    Logging_trace1(">>: time = %1", TOSTRING(timePosition));
+    Logging_traceHot1(">>: time = %1", TOSTRING(timePosition));
 
     SoXAudioEffect::processBlock(timePosition, buffer);
 
@@ -555,57 +1309,131 @@ SoXPhaserAndTremolo_AudioEffect::processBlock
     if (_timePositionHasMoved) {
         /* playhead was moved ==> keep time synchronisation of
            waveform */
-        _updateSettings(effectDescriptor, _sampleRate,
-                        _currentTimePosition);
+        _resynchronize(effectDescriptor, _sampleRate,
+                       _currentTimePosition);
     }
 
     const Natural sampleCount = buffer[0].size();
-    const Boolean isPhaser = effectDescriptor.isPhaser;
-    const Real inGain   = effectDescriptor.inGain;
-    const Real outGain  = effectDescriptor.outGain;
-    const Real decay    = effectDescriptor.decay;
-    const Natural delayRingBufferLength =
-        effectDescriptor.delayRingBufferLength;
-    Natural delayRingBufferIndex  =
-        effectDescriptor.delayRingBufferIndex;
-    AudioSampleRingBufferVector& delayRingBufferList =
-        effectDescriptor.delayRingBufferList;
-    WaveForm& waveForm = effectDescriptor.waveForm;
-    WaveFormIteratorState state = waveForm.state();
-
-    for (Natural channel = 0;  channel < _channelCount;
-         channel++) {
-        const AudioSampleList& inputList = buffer[channel];
-        AudioSampleList& outputList = buffer[channel];
-        AudioSampleRingBuffer& delayRingBuffer = delayRingBufferList[channel];
-
-        waveForm.setState(state);
-        delayRingBufferIndex = effectDescriptor.delayRingBufferIndex;
-
-        for (Natural i = 0;  i < sampleCount;  i++) {
-            const AudioSample inputSample = inputList[i];
-            AudioSample outputSample = 0.0;
-
-            if (!isPhaser) {
-                Real factor = waveForm.current();
-                outputSample = inputSample * factor;
-            } else if (delayRingBufferLength > 0) {
-                const Natural modulatedIndex =
-                    ((delayRingBufferIndex + Natural{waveForm.current()})
-                     % delayRingBufferLength);
-                outputSample = (inputSample * inGain
-                                + delayRingBuffer[modulatedIndex] * decay);
-                delayRingBufferIndex =
-                    (delayRingBufferIndex + 1) % delayRingBufferLength;
-                delayRingBuffer[delayRingBufferIndex] = outputSample;
-                outputSample *= outGain;
-            }
+    _ensureChannelCount(effectDescriptor, _channelCount);
+
+    /* audio samples have the layout of doubles; the channels are
+       processed together such that the modulation is only rendered
+       once per chunk */
+    double** channelArray =
+        effectDescriptor.channelPointerList.asArray();
 
-            outputList[i] = outputSample;
-            waveForm.advance();
+    for (Natural channel = 0;  channel < _channelCount;  channel++) {
+        channelArray[(size_t) channel] =
+            (double*) buffer[channel].asArray();
+    }
+
+    if (!effectDescriptor.isPhaser) {
+        _applyTremoloToChannels(channelArray, _channelCount, sampleCount,
+                                effectDescriptor.waveForm,
+                                effectDescriptor.modulationList);
+    } else {
+        _applyPhaserToChannels(channelArray, _channelCount, sampleCount,
+                               effectDescriptor);
+        _guardFiniteness(buffer);
+    }
+
+    Logging_traceHot("<<");
+}
+
+/*--------------------*/
+
+Boolean SoXPhaserAndTremolo_AudioEffect::hasFloatProcessing () const
+{
+    /* only the tremolo is processed natively in float, the phaser
+       keeps its feedback delay line in double precision */
+    _EffectDescriptor_PHTR& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_PHTR>(_effectDescriptor);
+    return !effectDescriptor.isPhaser;
+}
+
+/*--------------------*/
+
+void
+SoXPhaserAndTremolo_AudioEffect::processFloatBlock
+                                    (IN Real timePosition,
+                                     INOUT float* const* channelArray,
+                                     IN Natural channelCount,
+                                     IN Natural sampleCount)
+{
+    Logging_traceHot1(">>: time = %1", TOSTRING(timePosition));
+
+    _EffectDescriptor_PHTR& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_PHTR>(_effectDescriptor);
+
+    if (effectDescriptor.isPhaser) {
+        SoXAudioEffect::processFloatBlock(timePosition, channelArray,
+                                          channelCount, sampleCount);
+    } else {
+        _startBlock(timePosition, channelCount, sampleCount);
+        _ensureChannelCount(effectDescriptor, _channelCount);
+
+        if (_timePositionHasMoved) {
+            /* playhead was moved ==> keep time synchronisation of
+               waveform */
+            _resynchronize(effectDescriptor, _sampleRate,
+                       _currentTimePosition);
         }
+
+        _applyTremoloToChannels(channelArray, _channelCount, sampleCount,
+                                effectDescriptor.waveForm,
+                                effectDescriptor.modulationList);
     }
 
-    effectDescriptor.delayRingBufferIndex = delayRingBufferIndex;
-    Logging_trace("<<");
+    Logging_traceHot("<<");
+}
+
+/*--------------------*/
+
+Boolean SoXPhaserAndTremolo_AudioEffect::hasDoubleProcessing () const
+{
+    return hasFloatProcessing();
+}
+
+/*--------------------*/
+
+void
+SoXPhaserAndTremolo_AudioEffect::processDoubleBlock
+                                    (IN Real timePosition,
+                                     INOUT double* const* channelArray,
+                                     IN Natural channelCount,
+                                     IN Natural sampleCount)
+{
+    Logging_traceHot1(">>: time = %1", TOSTRING(timePosition));
+
+    _EffectDescriptor_PHTR& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_PHTR>(_effectDescriptor);
+
+    if (effectDescriptor.isPhaser) {
+        SoXAudioEffect::processDoubleBlock(timePosition, channelArray,
+                                           channelCount, sampleCount);
+    } else {
+        _startBlock(timePosition, channelCount, sampleCount);
+        _ensureChannelCount(effectDescriptor, _channelCount);
+
+        if (_timePositionHasMoved) {
+            /* playhead was moved ==> keep time synchronisation of
+               waveform */
+            _resynchronize(effectDescriptor, _sampleRate,
+                       _currentTimePosition);
+        }
+
+        _applyTremoloToChannels(channelArray, _channelCount, sampleCount,
+                                effectDescriptor.waveForm,
+                                effectDescriptor.modulationList);
+    }
+
+    Logging_traceHot("<<");
+}
+
+/*--------------------*/
+
+Boolean SoXPhaserAndTremolo_AudioEffect::needsTimePosition () const
+{
+    /* the modulation is synchronized with the playhead */
+    return true;
 }
@@ -32,7 +32,7 @@ namespace SoXPlugins::Effects::SoXPhaserAndTremolo {
      * <B>phaser</B> and <B>tremolo</B> modulation effects that have
      * similar parameters and hence are combined into a single plugin.
      */
-    struct SoXPhaserAndTremolo_AudioEffect : public SoXAudioEffect {
+    struct SoXPhaserAndTremolo_AudioEffect final : public SoXAudioEffect {
 
         /*---------------------*/
         /* setup & destruction */
@@ -56,20 +56,166 @@ namespace SoXPlugins::Effects::SoXPhaserAndTremolo {
 
         String name () const override;
 
+        /*--------------------*/
+
+        Real tailLength () const override;
+
+        /*--------------------*/
+
+        Real warmupLength () const override;
+
+        /*--------------------*/
+        /* memory footprint   */
+        /*--------------------*/
+
+        SoXMemoryFootprint memoryFootprint () const override;
+
+        /*--------------------*/
+        /* mono processing    */
+        /*--------------------*/
+
+        Boolean hasMonoProcessing () const override;
+
+        /*--------------------*/
+        /* DSP state          */
+        /*--------------------*/
+
+        Boolean hasDspStateSupport () const override;
+
+        /*--------------------*/
+        /* quality level      */
+        /*--------------------*/
+
+        /**
+         * Returns the number of quality levels of the effect: above
+         * full quality the modulation is evaluated exactly only
+         * every 32 samples and interpolated in between.
+         *
+         * @return  count of quality levels
+         */
+        Natural qualityLevelCount () const override;
+
+        /*--------------------*/
+
+        void setQualityLevel (IN Natural level) override;
+
         /*--------------------*/
         /* parameter change   */
         /*--------------------*/
 
+        void recalculateSettings () override;
+
+        /*--------------------*/
+
         void setDefaultValues () override;
 
+        /*--------------------*/
+
+        /**
+         * Sets the number of samples between exact evaluations of
+         * the modulation waveform to <C>sampleCount</C> (e.g. 16 or
+         * 32); in between the modulation is interpolated linearly.
+         * The default of one evaluates the waveform for every
+         * sample like SoX does; a reduced quality level uses at
+         * least 32.
+         *
+         * @param[in] sampleCount  number of samples between exact
+         *                         evaluations of the modulation
+         */
+        void setModulationControlInterval (IN Natural sampleCount);
+
+        /*--------------------*/
+
+        /**
+         * Tells the phaser to follow the modulation with fractional
+         * delays read by linear interpolation when
+         * <C>isFractional</C> is set; by default the delay is
+         * rounded to integral samples like SoX does.  Resets the
+         * delay lines.
+         *
+         * @param[in] isFractional  tells whether the phaser delay is
+         *                          fractional
+         */
+        void setFractionalModulation (IN Boolean isFractional);
+
+        /*--------------------*/
+
+        /**
+         * Tells the effect to render a sine modulation by a
+         * recursive rotator instead of the sine wave table when
+         * <C>isRotator</C> is set; the rotator needs no table
+         * accesses and follows the phase exactly, but the values
+         * differ from the table by its interpolation error.  Has no
+         * effect on a triangle modulation or a modulation control
+         * interval greater than one.
+         *
+         * @param[in] isRotator  tells whether a sine modulation is
+         *                       rendered by a rotator
+         */
+        void setRotatorModulation (IN Boolean isRotator);
+
+        /*--------------------*/
+        /* precision profile  */
+        /*--------------------*/
+
+        /**
+         * Sets the precision profile of the effect to
+         * <C>profile</C>: the high quality profile uses fractional
+         * phaser delays and a rotator for a sine modulation, the
+         * fast profile evaluates the modulation only every 32
+         * samples (like a reduced quality level); the profile
+         * overrides the settings of <C>setFractionalModulation</C>
+         * and <C>setRotatorModulation</C>.
+         *
+         * @param[in] profile  new precision profile
+         */
+        void setPrecisionProfile (IN SoXPrecisionProfile profile) override;
+
         /*--------------------*/
         /* event handling     */
         /*--------------------*/
 
+        void prepareToPlay (IN Real sampleRate)
+            override;
+
+        /*--------------------*/
+
+        void releaseResources () override;
+
+        /*--------------------*/
+
         void processBlock (IN Real timePosition,
                            INOUT AudioSampleListVector& buffer)
             override;
 
+        /*--------------------*/
+
+        Boolean hasFloatProcessing () const override;
+
+        /*--------------------*/
+
+        void processFloatBlock (IN Real timePosition,
+                                INOUT float* const* channelArray,
+                                IN Natural channelCount,
+                                IN Natural sampleCount)
+            override;
+
+        /*--------------------*/
+
+        Boolean hasDoubleProcessing () const override;
+
+        /*--------------------*/
+
+        void processDoubleBlock (IN Real timePosition,
+                                 INOUT double* const* channelArray,
+                                 IN Natural channelCount,
+                                 IN Natural sampleCount)
+            override;
+
+        /*--------------------*/
+
+        Boolean needsTimePosition () const override;
+
         /*--------------------*/
         /*--------------------*/
 
@@ -81,11 +227,26 @@ namespace SoXPlugins::Effects::SoXPhaserAndTremolo {
             /*--------------------*/
 
             SoXParameterValueChangeKind
-            _setValueInternal (IN String& parameterName,
+            _setValueInternal (IN Natural parameterId,
+                               IN String& parameterName,
                                IN String& value,
                                IN Boolean recalculationIsForced)
                 override;
 
+            /*--------------------*/
+
+            void _saveDspState (INOUT DspStateStream& stream) const
+                override;
+
+            /*--------------------*/
+
+            void _restoreDspState (INOUT DspStateStream& stream)
+                override;
+
+            /*--------------------*/
+
+            void _resetDspState () override;
+
     };
 
 }
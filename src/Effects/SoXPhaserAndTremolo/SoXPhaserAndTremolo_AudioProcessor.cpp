@@ -37,7 +37,7 @@ namespace SoXPlugins::Effects::SoXPhaserAndTremolo {
         {
             Logging_initializeWithDefaults("SoXPhaserAndTremolo",
                                            "SoXPlugins.");
-            _setAssociatedEffect(new SoXPhaserAndTremolo_AudioEffect{});
+            _setAssociatedEffect(_makeEffect());
         }
 
         /*--------------------*/
@@ -47,6 +47,15 @@ namespace SoXPlugins::Effects::SoXPhaserAndTremolo {
             return String("SoXPhaserAndTremolo");
         }
 
+        /*--------------------*/
+
+        protected:
+
+            SoXAudioEffect* _makeEffect () const override
+            {
+                return new SoXPhaserAndTremolo_AudioEffect{};
+            }
+
     };
 
 }
@@ -20,18 +20,31 @@
 
 #include "SoXReverbSupport.h"
 
+#include <algorithm>
+#include "AlignedAllocator.h"
+#include "Assertion.h"
+#include "DenormalGuard.h"
 #include "GenericTuple.h"
+#include "Kernels.h"
 #include "Logging.h"
-#include "NaturalList.h"
+#include "SampleRateContext.h"
 #include "SoXAudioHelper.h"
+#include "SoXWorkerPool.h"
 
 /*--------------------*/
 
 using Audio::AudioSample;
-using BaseTypes::Containers::NaturalList;
+using Audio::DelayLineSample;
+using Audio::DenormalGuard;
+using Audio::Kernels;
+using Audio::SampleRateContext;
+using Audio::SampleRateContextPtr;
+using Audio::SampleRateTableKind;
+using BaseTypes::GenericTypes::AlignedAllocator;
 using BaseTypes::GenericTypes::GenericTuple;
 using SoXPlugins::Effects::SoXReverb::_SoXReverb;
 using SoXPlugins::Helpers::SoXAudioHelper;
+using SoXPlugins::Helpers::SoXWorkerPool;
 
 /** abbreviation for StringUtil */
 using STR = BaseModules::StringUtil;
@@ -44,8 +57,16 @@ namespace SoXPlugins::Effects::SoXReverb {
     /* CONSTANTS          */
     /*--------------------*/
 
-    /** the maximum number of supported channels */
-    static constexpr size_t _maxChannelCount = 100;
+    /** the maximum number of samples per channel processed as a
+     * block */
+    static const Natural _blockLength = 256;
+
+    /** the number of delay line samples in a cache line; the delay
+     * memory of each channel is padded to full cache lines, such
+     * that channels processed on different threads do not share
+     * cache lines */
+    static const Natural _cacheLineSampleCount =
+        Natural{64 / sizeof(DelayLineSample)};
 
     /* Freeverb construction parameters */
 
@@ -56,19 +77,176 @@ namespace SoXPlugins::Effects::SoXReverb {
     static constexpr size_t _lineAllpassFilterCount = 4;
 
     /** the stereo spread in samples in freeverb */
-    static const Real _stereoSpread = 12.0;
+    static constexpr Real _stereoSpread = 12.0;
 
     /** the allpass factor in freeverb */
     static const Real _allpassFactor = 0.5;
 
+    /* economy quality parameters */
+
+    /** the number of comb filters used in economy quality (every
+     * other filter of the comb filter length list) */
+    static constexpr size_t _economyCombFilterCount = 4;
+
+    /** the number of allpass filters used in economy quality (every
+     * other filter of the allpass filter length list) */
+    static constexpr size_t _economyAllpassFilterCount = 2;
+
+    static_assert((_lineAllpassFilterCount
+                   - _economyAllpassFilterCount) % 2 == 0,
+                  "an even number of allpass filters must be skipped");
+
+    /** the power gain of a freeverb allpass filter for white noise
+     * (1 + 1/(1 - g^2) for allpass factor g) */
+    static const Real _allpassPowerGain =
+        Real{1.0} + Real{1.0} / (Real{1.0}
+                                 - _allpassFactor * _allpassFactor);
+
+    /** the gain compensating the filters dropped in economy quality
+     * for white noise (assuming uncorrelated comb filter outputs) */
+    static const Real _economyGain =
+        (Real{(double) _lineCombFilterCount / _economyCombFilterCount}
+         * _allpassPowerGain.power(Real{(double) _lineAllpassFilterCount
+                                        - _economyAllpassFilterCount})
+        ).sqrt();
+
+    /** the duration of a crossfade between the qualities in
+     * seconds */
+    static const Real _qualityFadeDuration = 0.05;
+
     /*--------------------*/
     /* TYPE DEFINITIONS   */
     /*--------------------*/
 
     /**
-     * A <C>_SamplePair</C> is a pair of audio samples.
+     * A <C>_SampleArrayPair</C> is a pair of audio sample arrays.
+     */
+    using _SampleArrayPair = GenericTuple<AudioSample*, 2>;
+
+    /**
+     * A <C>_DelayLineSampleList</C> is a cache line aligned list of
+     * delay line samples.
+     */
+    using _DelayLineSampleList =
+        GenericList<DelayLineSample, nullptr, nullptr,
+                    AlignedAllocator<DelayLineSample>>;
+
+    /*====================*/
+    /* Delay Line         */
+    /*====================*/
+
+    /**
+     * A <C>_DelayLine</C> object delays samples by its length; its
+     * samples are held as <C>DelayLineSample</C> in external storage
+     * (possibly as floats), while blocks are read and written as
+     * audio samples.
      */
-    using _SamplePair = GenericTuple<AudioSample, 2>;
+    struct _DelayLine {
+
+        /*--------------------*/
+        /* setup              */
+        /*--------------------*/
+
+        /**
+         * Makes delay line without storage and with length zero.
+         */
+        _DelayLine ();
+
+        /*--------------------*/
+
+        /**
+         * Gets length of delay line.
+         *
+         * @return  length of delay line
+         */
+        Natural length () const;
+
+        /*--------------------*/
+
+        /**
+         * Sets length of delay line to <C>length</C> and clears it;
+         * this must not exceed the capacity of the storage and does
+         * not allocate.
+         *
+         * @param[in] length  new length of delay line
+         */
+        void setLength (IN Natural length);
+
+        /*--------------------*/
+
+        /**
+         * Makes delay line use <C>storage</C> with <C>capacity</C>
+         * samples and resets its length to zero.
+         *
+         * @param[inout] storage   external storage for delay line
+         * @param[in]    capacity  count of samples in storage
+         */
+        void setStorage (INOUT DelayLineSample* storage,
+                         IN Natural capacity);
+
+        /*--------------------*/
+        /* block access       */
+        /*--------------------*/
+
+        /**
+         * Reads the <C>count</C> oldest samples of delay line into
+         * <C>sampleArray</C>; <C>count</C> must not exceed the
+         * length.
+         *
+         * @param[out] sampleArray  the delayed samples
+         * @param[in]  count        the number of samples
+         */
+        void readBlock (OUT AudioSample* sampleArray,
+                        IN Natural count) const;
+
+        /*--------------------*/
+
+        /**
+         * Replaces the <C>count</C> oldest samples of delay line by
+         * the samples in <C>sampleArray</C>, which then become the
+         * newest; <C>count</C> must not exceed the length.
+         *
+         * @param[in] sampleArray  the new samples
+         * @param[in] count        the number of samples
+         */
+        void writeBlock (IN AudioSample* sampleArray,
+                         IN Natural count);
+
+        /*--------------------*/
+
+        /**
+         * Delays the <C>count</C> samples in <C>inputArray</C> by
+         * the length of delay line and writes them to
+         * <C>outputArray</C> (which must not overlap the input);
+         * unlike <C>readBlock</C> and <C>writeBlock</C> the count may
+         * exceed the length.
+         *
+         * @param[in]  inputArray   the input samples
+         * @param[out] outputArray  the delayed samples
+         * @param[in]  count        the number of samples
+         */
+        void delayBlock (IN AudioSample* inputArray,
+                         OUT AudioSample* outputArray,
+                         IN Natural count);
+
+        /*--------------------*/
+        /*--------------------*/
+
+        protected:
+
+            /** the samples of the delay line (external storage) */
+            DelayLineSample* _data;
+
+            /** the count of samples in <C>_data</C> */
+            size_t _capacity;
+
+            /** the length of the delay line */
+            size_t _length;
+
+            /** the position of the oldest sample */
+            size_t _position;
+
+    };
 
     /*====================*/
     /* Allpass Filter     */
@@ -100,101 +278,231 @@ namespace SoXPlugins::Effects::SoXReverb {
 
         /*--------------------*/
 
+        /**
+         * Returns the number of bytes of filter and its block list
+         * on the heap (without the external delay storage).
+         *
+         * @return  count of owned bytes
+         */
+        Natural byteCount () const;
+
+        /*--------------------*/
+
         /**
          * Sets length of sample ring buffer in filter to
-         * <C>length</C>.
+         * <C>length</C>; this must not exceed the capacity of the
+         * storage and does not allocate.
          *
          * @param[in] length  new length of sample ring buffer
          */
         void setRingBufferLength (IN Natural length);
 
+        /*--------------------*/
+
+        /**
+         * Makes the sample ring buffer of filter use
+         * <C>storage</C> with <C>capacity</C> samples and resets its
+         * length to zero.
+         *
+         * @param[inout] storage   external storage for delay line
+         * @param[in]    capacity  count of samples in storage
+         */
+        void setStorage (INOUT DelayLineSample* storage,
+                         IN Natural capacity);
+
         /*--------------------*/
         /* filter application */
         /*--------------------*/
 
         /**
-         * Applies allpass filter to single <C>inputSample</C> and
-         * returns resulting sample.
+         * Applies allpass filter to the <C>count</C> samples in
+         * <C>sampleArray</C> and replaces them by the resulting
+         * samples; <C>count</C> must not exceed the ring buffer
+         * length, hence all delayed samples of the block are
+         * available before the block is written back.
          *
-         * @param[in] inputSample  single input sample
-         * @return  output sample of allpass
+         * @param[inout] sampleArray  the input and output samples
+         * @param[in]    count        the number of samples
          */
-        AudioSample apply (IN AudioSample inputSample);
+        void applyBlock (INOUT AudioSample* sampleArray,
+                         IN Natural count);
 
         /*--------------------*/
         /*--------------------*/
 
         protected:
 
-            /** internal sample ring buffer of allpass */
-            AudioSampleRingBuffer _sampleRingBuffer;
+            /** the delay line of allpass */
+            _DelayLine _delayLine;
+
+            /** the delayed samples of the current block */
+            AudioSampleList _delayedSampleList;
 
     };
 
     /*====================*/
-    /* Comb Filter        */
+    /* Comb Filter Bank   */
     /*====================*/
 
+    /** a list of ring buffer lengths for the comb filters of a
+     * reverb line */
+    using _CombFilterLengthList = GenericTuple<Natural,
+                                               _lineCombFilterCount>;
+
+    /*--------------------*/
+
     /**
-     * A <C>_CombFilter</C> object is a simple Schröder-Moorer comb
-     * filter with an associated sample ring buffer as a delay line
-     * and a single stored sample.
+     * A <C>_CombFilterBank</C> object is the set of parallel
+     * Schröder-Moorer comb filters of a reverb line.  The delay lines
+     * of all comb filters are segments of a single external array; their
+     * read positions and stored samples are held as arrays indexed by
+     * comb filter ("lanes"), such that a sample is processed by all
+     * comb filters with SIMD operations on several lanes (by the
+     * comb filter bank kernel in <C>Kernels</C>).
+     *
+     * The lanes start with every other comb filter of the length
+     * list followed by the remaining ("optional") ones; in economy
+     * quality only the leading lanes are processed and their sum is
+     * amplified for compensation, while a quality weight between 0
+     * (economy) and 1 (final render) crossfades between both sums.
      */
-    struct _CombFilter {
+    struct _CombFilterBank {
 
         /*--------------------*/
         /* setup              */
         /*--------------------*/
 
         /**
-         * Makes comb filter with embedded sample ring buffer.
+         * Makes comb filter bank with empty delay lines.
          */
-        _CombFilter ();
+        _CombFilterBank ();
 
         /*--------------------*/
 
         /**
-         * Gets length of sample ring buffer in filter
+         * Gets length of delay line of comb filter with
+         * <C>index</C>.
          *
-         * @return length of sample ring buffer
+         * @param[in] index  the index of the comb filter
+         * @return length of delay line
          */
-        Natural ringBufferLength () const;
+        Natural ringBufferLength (IN Natural index) const;
 
         /*--------------------*/
 
         /**
-         * Sets length of sample ring buffer in filter
+         * Sets lengths of delay lines of all comb filters to
+         * <C>lengthList</C> and clears the delay lines; the sum of
+         * the lengths must not exceed the capacity of the storage
+         * and this does not allocate.
          *
-         * @param[in] length  new length of sample ring buffer
+         * @param[in] lengthList  new lengths of delay lines
          */
-        void setRingBufferLength (IN Natural length);
+        void setRingBufferLengths (IN _CombFilterLengthList& lengthList);
+
+        /*--------------------*/
+
+        /**
+         * Makes the delay lines of all comb filters use consecutive
+         * segments of <C>storage</C> with <C>capacity</C> samples
+         * and resets their lengths to zero.
+         *
+         * @param[inout] storage   external storage for delay lines
+         * @param[in]    capacity  count of samples in storage
+         */
+        void setStorage (INOUT DelayLineSample* storage,
+                         IN Natural capacity);
+
+        /*--------------------*/
+
+        /**
+         * Clears the delay lines and states of the optional comb
+         * filters (those skipped in economy quality), such that they
+         * can be faded in without stale samples.
+         */
+        void clearOptionalFilters ();
 
         /*--------------------*/
         /* filter application */
         /*--------------------*/
 
         /**
-         * Applies comb filter to single <C>inputSample</C> with
-         * parameters <C>feedback</C> and <C>hfDamping</C>.
+         * Applies the comb filters to single <C>inputSample</C> with
+         * parameters <C>feedback</C> and <C>hfDamping</C> and returns
+         * the sum of their outputs crossfaded between economy and
+         * final render quality by <C>qualityWeight</C>; for a
+         * weight of zero the optional comb filters are skipped.
          *
-         * @param[in] inputSample  single input sample
-         * @param[in] feedback     feedback of comb filter
-         * @param[in] hfDamping    hfDamping of comb filter
-         * @return  output sample of comb filter
+         * @param[in] inputSample    single input sample
+         * @param[in] feedback       feedback of comb filters
+         * @param[in] hfDamping      hfDamping of comb filters
+         * @param[in] qualityWeight  the weight of the final render
+         *                           sum (between 0 and 1)
+         * @return  sum of output samples of comb filters
          */
         AudioSample apply (IN AudioSample inputSample,
-                           IN Real feedback, IN Real hfDamping);
+                           IN Real feedback, IN Real hfDamping,
+                           IN Real qualityWeight);
+
+        /*--------------------*/
+
+        /**
+         * Applies the comb filters to the <C>count</C> samples in
+         * <C>inputArray</C> with parameters <C>feedback</C> and
+         * <C>hfDamping</C> and writes the sums of their outputs to
+         * <C>outputArray</C>; the quality weight starts at
+         * <C>qualityWeight</C> and changes by
+         * <C>weightIncrement</C> per sample.
+         *
+         * @param[in]  inputArray       the input samples
+         * @param[out] outputArray      the summed output samples
+         * @param[in]  count            the number of samples
+         * @param[in]  feedback         feedback of comb filters
+         * @param[in]  hfDamping        hfDamping of comb filters
+         * @param[in]  qualityWeight    the weight of the final render
+         *                              sum at the block start
+         * @param[in]  weightIncrement  the change of the weight per
+         *                              sample
+         */
+        void applyBlock (IN AudioSample* inputArray,
+                         OUT AudioSample* outputArray,
+                         IN Natural count,
+                         IN Real feedback,
+                         IN Real hfDamping,
+                         IN Real qualityWeight,
+                         IN Real weightIncrement);
 
         /*--------------------*/
         /*--------------------*/
 
         protected:
 
-            /** internal sample ring buffer of comb filter */
-            AudioSampleRingBuffer _sampleRingBuffer;
+            /** the delay lines of all comb filters one after the
+             * other (external storage) */
+            DelayLineSample* _delayLineData;
+
+            /** the count of samples in <C>_delayLineData</C> */
+            size_t _capacity;
+
+            /** the start of the delay line per lane in
+             * <C>_delayLineData</C> */
+            GenericTuple<size_t, _lineCombFilterCount> _offsetList;
 
-            /** the single state sample of comb filter */
-            AudioSample _storedSample;
+            /** the length of the delay line per lane */
+            GenericTuple<size_t, _lineCombFilterCount> _lengthList;
+
+            /** the current read and write position per lane
+             * relative to its delay line start */
+            GenericTuple<size_t, _lineCombFilterCount> _positionList;
+
+            /** the single state sample per lane */
+            GenericTuple<double, _lineCombFilterCount> _storedSampleList;
+
+            /** the output samples per lane of the current step */
+            GenericTuple<double, _lineCombFilterCount> _outputSampleList;
+
+            /** the kernels for the processor */
+            const Kernels* _kernels;
 
     };
 
@@ -209,9 +517,9 @@ namespace SoXPlugins::Effects::SoXReverb {
     struct _ReverbLine {
 
         /**
-         * Constructs a complete reverb line and all filters; creates
-         * all sample ring buffers with arbitrary length to be adapted
-         * by later adjustments.
+         * Constructs a complete reverb line and all filters with
+         * empty delay lines; their storage is assigned by
+         * <C>setStorage</C>.
          */
         _ReverbLine ();
 
@@ -233,51 +541,206 @@ namespace SoXPlugins::Effects::SoXReverb {
 
         /*--------------------*/
 
+        /**
+         * Returns the number of samples needed for the delay lines
+         * of a reverb line at the rate of <C>sampleRateContext</C>
+         * with maximum room scale and stereo depth; without
+         * <C>hasCombFilters</C> only the allpass filters are
+         * counted.
+         *
+         * @param[in] sampleRateContext  sample rate context of
+         *                               reverb line
+         * @param[in] hasCombFilters     tells whether reverb line
+         *                               has its own comb filters
+         * @return  count of samples for all delay lines
+         */
+        static Natural
+        storageLength (IN SampleRateContext& sampleRateContext,
+                       IN Boolean hasCombFilters);
+
+        /*--------------------*/
+
+        /**
+         * Makes the delay lines of reverb line use consecutive
+         * segments of <C>storage</C> having
+         * <C>storageLength(sampleRateContext, hasCombFilters)</C>
+         * samples; all delay line lengths are reset to zero.  A
+         * reverb line without <C>hasCombFilters</C> only has
+         * allpass filters and must be fed with the comb filter
+         * output of another line via <C>applyAllpassFilters</C>.
+         *
+         * @param[inout] storage            external storage for
+         *                                  delay lines
+         * @param[in]    sampleRateContext  sample rate context of
+         *                                  reverb line
+         * @param[in]    hasCombFilters     tells whether reverb line
+         *                                  has its own comb filters
+         */
+        void setStorage (INOUT DelayLineSample* storage,
+                         IN SampleRateContext& sampleRateContext,
+                         IN Boolean hasCombFilters);
+
+        /*--------------------*/
+
         /**
          * Adjusts lengths of sample ring buffers for reverb line
-         * based on <C>sampleRate</C>, <C>roomScale</C> and
-         * <C>stereoDepth</C>.
+         * based on <C>sampleRateContext</C>, <C>roomScale</C> and
+         * <C>stereoDepth</C>; does not allocate, the storage must
+         * have been set for that sample rate context.
          *
-         * @param[in] sampleRate   new sample rate of reverb line 
-         * @param[in] roomScale    new room scale of reverb line 
-         * @param[in] stereoDepth  new stereo depth of reverb line
+         * @param[in] sampleRateContext  sample rate context of
+         *                               reverb line
+         * @param[in] roomScale          new room scale of reverb
+         *                               line
+         * @param[in] stereoDepth        new stereo depth of reverb
+         *                               line
          */
-        void adjustRingBufferLengths (IN Real sampleRate,
+        void
+        adjustRingBufferLengths (IN SampleRateContext& sampleRateContext,
                                  IN Real roomScale,
                                  IN Real stereoDepth);
 
         /*--------------------*/
 
         /**
-         * Applies reverb line to single <C>inputSample</C> and
-         * returns output sample with parameters <C>feedback</C>,
-         * <C>hfDamping</C> and <C>gain</C>; the comb filters are
-         * applied to the input in parallel, the allpass filters in
-         * series.
+         * Sets quality of reverb line to economy when
+         * <C>isEconomy</C> is set and to final render otherwise; a
+         * change is crossfaded over a short duration and the
+         * filters skipped in economy quality are cleared before
+         * being faded in.
          *
-         * @param[in] inputSample  single input sample
-         * @param[in] feedback     feedback parameter for comb filters
-         * @param[in] hfDamping    hf damping parameter for comb filters
-         * @param[in] gain         the gain of the reverb line
-         * @return  output sample of reverb line
+         * @param[in] isEconomy  tells whether economy quality is
+         *                       used
          */
-        AudioSample apply (IN AudioSample inputSample,
-                              IN Real feedback,
-                              IN Real hfDamping,
-                              IN Real gain);
+        void setQuality (IN Boolean isEconomy);
+
+        /*--------------------*/
+
+        /**
+         * Returns the maximum number of samples that can be processed
+         * by <C>applyBlock</C> in one go, which is the length of the
+         * shortest allpass delay line.
+         *
+         * @return  maximum block length
+         */
+        Natural maximumBlockLength () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of bytes of reverb line and its filters
+         * on the heap (without the external delay storage).
+         *
+         * @return  count of owned bytes
+         */
+        Natural byteCount () const;
+
+        /*--------------------*/
+
+        /**
+         * Applies reverb line to the <C>count</C> samples in
+         * <C>inputArray</C> with parameters <C>feedback</C>,
+         * <C>hfDamping</C> and <C>gain</C> and writes the result to
+         * <C>outputArray</C>; the comb filters are applied to the
+         * input in parallel, the allpass filters in series, each
+         * filter to the complete block.  <C>count</C> must neither
+         * exceed <C>maximumBlockLength()</C> nor the block length.
+         *
+         * @param[in]  inputArray   the input samples
+         * @param[out] outputArray  the output samples
+         * @param[in]  count        the number of samples
+         * @param[in]  feedback     feedback parameter for comb filters
+         * @param[in]  hfDamping    hf damping parameter for comb filters
+         * @param[in]  gain         the gain of the reverb line
+         */
+        void applyBlock (IN AudioSample* inputArray,
+                         OUT AudioSample* outputArray,
+                         IN Natural count,
+                         IN Real feedback,
+                         IN Real hfDamping,
+                         IN Real gain);
+
+        /*--------------------*/
+
+        /**
+         * Applies the comb filters of reverb line to the
+         * <C>count</C> samples in <C>inputArray</C> with parameters
+         * <C>feedback</C> and <C>hfDamping</C> and writes their sum
+         * to <C>outputArray</C>; this is the first half of
+         * <C>applyBlock</C> and must be followed by
+         * <C>applyAllpassFilters</C> for the same block.
+         *
+         * @param[in]  inputArray   the input samples
+         * @param[out] outputArray  the comb filter output samples
+         * @param[in]  count        the number of samples
+         * @param[in]  feedback     feedback parameter for comb filters
+         * @param[in]  hfDamping    hf damping parameter for comb filters
+         */
+        void applyCombFilters (IN AudioSample* inputArray,
+                               OUT AudioSample* outputArray,
+                               IN Natural count,
+                               IN Real feedback,
+                               IN Real hfDamping);
+
+        /*--------------------*/
+
+        /**
+         * Applies the allpass filters of reverb line in series and
+         * then <C>gain</C> to the <C>count</C> comb filter output
+         * samples in <C>sampleArray</C>; this is the second half of
+         * <C>applyBlock</C> and advances a quality crossfade.
+         *
+         * @param[inout] sampleArray  the samples to be filtered
+         * @param[in]    count        the number of samples
+         * @param[in]    gain         the gain of the reverb line
+         */
+        void applyAllpassFilters (INOUT AudioSample* sampleArray,
+                                  IN Natural count,
+                                  IN Real gain);
 
         /*--------------------*/
         /*--------------------*/
 
         protected:
 
+            /**
+             * Returns the change of the quality weight per sample in
+             * the current block: zero when the weight has reached
+             * the requested quality.
+             *
+             * @return  quality weight increment per sample
+             */
+            Real _qualityWeightIncrement () const;
+
+            /*--------------------*/
+
             /** the list of all allpass filters in reverb line */
             GenericTuple<_AllpassFilter*,
                          _lineAllpassFilterCount> _allpassFilterList;
 
-            /** the list of all comb filters in reverb line */
-            GenericTuple<_CombFilter*,
-                         _lineCombFilterCount>    _combFilterList;
+            /** the bank of all comb filters in reverb line */
+            _CombFilterBank _combFilterBank;
+
+            /** information whether the comb filter bank has delay
+             * storage (otherwise the comb filter output of another
+             * line is used) */
+            Boolean _hasCombFilters;
+
+            /** information whether economy quality is requested */
+            Boolean _isEconomy;
+
+            /** the current weight of the final render quality (0 for
+             * economy, 1 for final render and in between during a
+             * crossfade) */
+            Real _qualityWeight;
+
+            /** the change of the quality weight per sample during a
+             * crossfade */
+            Real _qualityWeightStep;
+
+            /** the input samples of an optional allpass filter
+             * during a crossfade */
+            AudioSampleList _dryList;
 
     };
 
@@ -291,14 +754,20 @@ namespace SoXPlugins::Effects::SoXReverb {
      * whether stereo depth is greater than 0 or not); also there is a
      * delay of the input sample via a channel delay line (when
      * predelay is non-zero)
+     *
+     * When the reverb lines are shared, the second line has no comb
+     * filters of its own: it reads the comb filter output of the
+     * first line through a tap delayed by the stereo spread and
+     * decorrelates it by its own allpass filters (with lengths
+     * offset by the stereo depth); this roughly halves the delay
+     * memory of a channel, but is not equivalent to SoX.
      */
     struct _ReverbChannel {
 
         /**
          * Constructs a complete reverb line with predelay line and
-         * all filters for one channel; creates all sample ring
-         * buffers with arbitrary length to be adapted by later
-         * adjustments.
+         * all filters for one channel with empty delay lines; their
+         * storage is assigned by <C>setStorage</C>.
          */
         _ReverbChannel ();
 
@@ -321,50 +790,180 @@ namespace SoXPlugins::Effects::SoXReverb {
 
         /*--------------------*/
 
+        /**
+         * Returns the number of samples needed for the predelay line
+         * and the delay lines of all reverb lines of a reverb
+         * channel at the rate of <C>sampleRateContext</C> with
+         * maximum predelay, room scale and stereo depth (padded to
+         * full cache lines); <C>linesAreShared</C> tells whether the
+         * reverb lines share their comb filters.
+         *
+         * @param[in] sampleRateContext  sample rate context of
+         *                               reverb channel
+         * @param[in] linesAreShared     tells whether the reverb
+         *                               lines share their comb
+         *                               filters
+         * @return  count of samples for all delay lines
+         */
+        static Natural
+        storageLength (IN SampleRateContext& sampleRateContext,
+                       IN Boolean linesAreShared);
+
+        /*--------------------*/
+
+        /**
+         * Makes the predelay line and the delay lines of all reverb
+         * lines use consecutive segments of <C>storage</C> having
+         * <C>storageLength(sampleRateContext, linesAreShared)</C>
+         * samples; all delay line lengths are reset to zero.
+         *
+         * @param[inout] storage            external storage for
+         *                                  delay lines
+         * @param[in]    sampleRateContext  sample rate context of
+         *                                  reverb channel
+         * @param[in]    linesAreShared     tells whether the reverb
+         *                                  lines share their comb
+         *                                  filters
+         */
+        void setStorage (INOUT DelayLineSample* storage,
+                         IN SampleRateContext& sampleRateContext,
+                         IN Boolean linesAreShared);
+
+        /*--------------------*/
+
         /**
          * Adjusts lengths of all filter ring buffers in reverb
-         * channel according to parameters <C>sampleRate</C>,
+         * channel according to parameters <C>sampleRateContext</C>,
          * <C>roomScale</C> and <C>stereoDepth</C> to their effective
          * length; adjusts input ring buffer to length
-         * <C>predelay</C>.
+         * <C>predelay</C>.  Does not allocate, the storage must have
+         * been set for that sample rate context.
          *
-         * @param[in] sampleRate   new sample rate for reverb channel
-         * @param[in] predelay     new predelay for reverb channel
-         * @param[in] roomScale    new room scale for reverb channel
-         * @param[in] stereoDepth  new stereo depth for reverb channel
+         * @param[in] sampleRateContext  sample rate context of
+         *                               reverb channel
+         * @param[in] predelay           new predelay for reverb
+         *                               channel
+         * @param[in] roomScale          new room scale for reverb
+         *                               channel
+         * @param[in] stereoDepth        new stereo depth for reverb
+         *                               channel
          */
-        void adjustRingBufferLengths (IN Real sampleRate,
+        void
+        adjustRingBufferLengths (IN SampleRateContext& sampleRateContext,
                                  IN Real predelay,
                                  IN Real roomScale,
                                  IN Real stereoDepth);
 
         /*--------------------*/
 
+        /**
+         * Adjusts the input ring buffer of reverb channel to length
+         * <C>predelay</C> for <C>sampleRateContext</C> and leaves
+         * the reverb lines untouched.
+         *
+         * @param[in] sampleRateContext  sample rate context of
+         *                               reverb channel
+         * @param[in] predelay           new predelay for reverb
+         *                               channel
+         */
+        void adjustPredelay (IN SampleRateContext& sampleRateContext,
+                             IN Real predelay);
+
+        /*--------------------*/
+
+        /**
+         * Adjusts the filter ring buffers of the reverb lines to
+         * <C>roomScale</C> and <C>stereoDepth</C> for
+         * <C>sampleRateContext</C> and leaves the input ring buffer
+         * untouched.
+         *
+         * @param[in] sampleRateContext  sample rate context of
+         *                               reverb channel
+         * @param[in] roomScale          new room scale for reverb
+         *                               channel
+         * @param[in] stereoDepth        new stereo depth for reverb
+         *                               channel
+         */
+        void
+        adjustReverbLineLengths (IN SampleRateContext& sampleRateContext,
+                                 IN Real roomScale,
+                                 IN Real stereoDepth);
+
+        /*--------------------*/
+
+        /**
+         * Sets quality of all reverb lines to economy when
+         * <C>isEconomy</C> is set and to final render otherwise.
+         *
+         * @param[in] isEconomy  tells whether economy quality is
+         *                       used
+         */
+        void setQuality (IN Boolean isEconomy);
+
+        /*--------------------*/
+
+        /**
+         * Returns the maximum number of samples that can be processed
+         * by <C>applyBlock</C> in one go.
+         *
+         * @return  maximum block length
+         */
+        Natural maximumBlockLength () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of bytes of reverb channel, its block
+         * list and its reverb lines on the heap (without the
+         * external delay storage).
+         *
+         * @return  count of owned bytes
+         */
+        Natural byteCount () const;
+
+        /*--------------------*/
+
         /**
          * Applies current reverb channel with parameters
-         * <C>feedback</C>, <C>hfDamping</C> and <C>gain</C> to single
-         * <C>inputSample</C> and returns output samples in
-         * <C>wetSamplePair</C>.
+         * <C>feedback</C>, <C>hfDamping</C> and <C>gain</C> to the
+         * <C>count</C> samples in <C>inputArray</C> and writes the
+         * output samples of the reverb lines to the arrays in
+         * <C>wetArrayPair</C>; <C>count</C> must neither exceed
+         * <C>maximumBlockLength()</C> nor the block length.
          *
-         * @param[in]  inputSample    single input sample
-         * @param[in]  feedback       feedback of comb filters
-         * @param[in]  hfDamping      hfDamping of comb filters
-         * @param[in]  gain           the gain of the reverb lines
-         * @param[out] wetSamplePair  pair of output samples
+         * @param[in]  inputArray    the input samples
+         * @param[in]  count         the number of samples
+         * @param[in]  feedback      feedback of comb filters
+         * @param[in]  hfDamping     hfDamping of comb filters
+         * @param[in]  gain          the gain of the reverb lines
+         * @param[out] wetArrayPair  pair of output sample arrays
          */
-        void apply (IN AudioSample inputSample,
-                    IN Real feedback,
-                    IN Real hfDamping,
-                    IN Real gain,
-                    OUT _SamplePair& wetSamplePair);
+        void applyBlock (IN AudioSample* inputArray,
+                         IN Natural count,
+                         IN Real feedback,
+                         IN Real hfDamping,
+                         IN Real gain,
+                         OUT _SampleArrayPair& wetArrayPair);
 
         /*--------------------*/
         /*--------------------*/
 
         protected:
 
-            /** the ring buffer of input samples in this reverb channel */
-            AudioSampleRingBuffer _inputSampleRingBuffer;
+            /** the predelay line of input samples in this reverb
+             * channel */
+            _DelayLine _inputDelayLine;
+
+            /** the predelayed input samples of the current block */
+            AudioSampleList _delayedInputList;
+
+            /** information whether the second reverb line uses the
+             * comb filters of the first one */
+            Boolean _linesAreShared;
+
+            /** the tap delay of the shared comb filter output for
+             * the second reverb line */
+            _DelayLine _combTapDelayLine;
 
             /** the number of associated reverb lines (typically 1 or 2) */
             Natural _reverbLineCount;
@@ -388,8 +987,60 @@ namespace SoXPlugins::Effects::SoXReverb {
      * freeverb parameters like e.g.\ feedback, stereo depth and room
      * scale.
      */
+    /** the number of parameters of a reverb (in the order of
+     * <C>_SoXReverb::setParameters</C>) */
+    static constexpr size_t _reverbParameterCount = 7;
+
+    /*--------------------*/
+
+    /**
+     * The parts of the reverb state derived from its parameters;
+     * a set of parts is given as the bitwise or of its elements.
+     */
+    enum _ReverbStatePart : int {
+        /** the suppression of the direct signal */
+        _reverbStatePart_dryMix     = 1,
+        /** the feedback of the comb filters */
+        _reverbStatePart_feedback   = 2,
+        /** the high frequency damping of the comb filters */
+        _reverbStatePart_hfDamping  = 4,
+        /** the gain of the reverb lines */
+        _reverbStatePart_wetGain    = 8,
+        /** the lengths of the input delay lines */
+        _reverbStatePart_inputDelay = 16,
+        /** the lengths of the filter delay lines, the number of
+         * reverb lines per channel and the block length */
+        _reverbStatePart_lineDelays = 32
+    };
+
+    /*--------------------*/
+
+    /** the dependency graph of the reverb state: the parts of the
+     * state depending on each parameter (in the order of
+     * <C>_SoXReverb::setParameters</C>); a parameter change only
+     * recalculates those parts, hence only a change of predelay,
+     * room scale or stereo depth touches delay lines */
+    static const int _dependentStatePartsList[_reverbParameterCount] = {
+        _reverbStatePart_dryMix,      /* isWetOnly */
+        _reverbStatePart_feedback,    /* reverberance */
+        _reverbStatePart_hfDamping,   /* hfDamping */
+        _reverbStatePart_lineDelays,  /* roomScale */
+        _reverbStatePart_lineDelays,  /* stereoDepth */
+        _reverbStatePart_inputDelay,  /* predelay */
+        _reverbStatePart_wetGain      /* wetDbGain */
+    };
+
+    /*--------------------*/
+
     struct _ReverbEffectParameterData {
 
+        /** the parameter values last set (with the value ranges
+         * adjusted, the wet-only flag as zero or one) */
+        Real parameterValueList[_reverbParameterCount];
+
+        /** information whether parameters have been set at all */
+        Boolean parametersAreKnown;
+
         /** information whether direct signal should be suppressed in
          * output */
         Boolean isWetOnly;
@@ -412,12 +1063,56 @@ namespace SoXPlugins::Effects::SoXReverb {
         /** the room scale as a factor */
         Real roomScale;
 
+        /** information whether the reverb uses economy quality
+         * (with fewer filters) instead of the exact SoX algorithm */
+        Boolean isEconomy;
+
+        /** information whether the reverb lines of each channel
+         * share their comb filters (not equivalent to SoX) */
+        Boolean linesAreShared;
+
+        /** information whether the delay line arena has been carved
+         * for shared reverb lines */
+        Boolean arenaLinesAreShared;
+
         /** the number of channels in this reverb */
         Natural channelCount;
 
+        /** the shared context of the sample rate of this reverb
+         * with its delay length table */
+        SampleRateContextPtr sampleRateContext;
+
         /** the list of reverb channels */
         _ReverbChannelList reverbChannelList{};
 
+        /** the delay memory of all reverb channels one after the
+         * other sized for maximum predelay, room scale and stereo
+         * depth at the sample rate */
+        _DelayLineSampleList delayLineArena;
+
+        /** the maximum number of samples per channel processed as a
+         * block by all reverb channels */
+        Natural blockLength;
+
+        /** the wet output of both reverb lines of each channel for
+         * a block (with index 2 * channel + line) */
+        AudioSampleListVector wetBuffer;
+
+        /** information whether the reverb channels are processed
+         * concurrently on the worker pool */
+        Boolean isParallel;
+
+        /** during processing: the buffer with the current block */
+        AudioSampleListVector* currentBuffer;
+
+        /** during processing: the position of the current block in
+         * the buffer */
+        Natural blockPosition;
+
+        /** during processing: the number of samples in the current
+         * block */
+        Natural blockSampleCount;
+
         /*--------------------*/
         /*--------------------*/
 
@@ -433,10 +1128,10 @@ namespace SoXPlugins::Effects::SoXReverb {
     /*============================================================*/
 
     /* the maximum value for the room scale */
-    static const Real _maximumRoomScale   = 1.0;
+    static constexpr Real _maximumRoomScale   = 1.0;
 
     /* the maximum value for the stereo depth */
-    static const Real _maximumStereoDepth = 1.0;
+    static constexpr Real _maximumStereoDepth = 1.0;
 
     /* the maximum value for the predelay in seconds */
     static const Real _maximumPredelay    = 0.5;
@@ -445,87 +1140,549 @@ namespace SoXPlugins::Effects::SoXReverb {
     static const Real _defaultSampleRate = 100.0;
 
     /** reference sample rate for reverb line delays */
-    static const Real _referenceSampleRate = 44100.0;
+    static constexpr Real _referenceSampleRate = 44100.0;
 
     /** list of sample ring buffer lengths for comb filters */
-    static const NaturalList _combFilterLengthList =
-        NaturalList::fromList({Natural{1116}, Natural{1188},
-                               Natural{1277}, Natural{1356},
-                               Natural{1422}, Natural{1491},
-                               Natural{1557}, Natural{1617}});
+    static constexpr size_t _combFilterLengthList[_lineCombFilterCount] =
+        { 1116, 1188, 1277, 1356, 1422, 1491, 1557, 1617 };
 
     /** list of sample ring buffer lengths for allpass filters */
-    static const NaturalList _allpassFilterLengthList =
-        NaturalList::fromList({Natural{225}, Natural{341},
-                               Natural{441}, Natural{556}});
+    static constexpr size_t
+        _allpassFilterLengthList[_lineAllpassFilterCount] =
+            { 225, 341, 441, 556 };
 
-    /*============================================================*/
+    /*--------------------*/
+    /* delay length table */
+    /*--------------------*/
 
-    _AllpassFilter::_AllpassFilter ()
-        : _sampleRingBuffer{}
-    {
-    }
+    /** the number of tabulated stereo offsets (-1, 0 and +1) */
+    static constexpr size_t _stereoOffsetCount = 3;
 
-    /*--------------------*/
+    /**
+     * A <C>_DelayLengthTable</C> holds the delay line lengths of the
+     * filters of a reverb line for a sample rate at maximum room
+     * scale (the default) indexed by stereo offset plus one,
+     * where the stereo offset is the stereo depth with the sign of
+     * the filter index (plus for even indices).
+     */
+    struct _DelayLengthTable {
 
-    Natural _AllpassFilter::ringBufferLength () const
-    {
-        return _sampleRingBuffer.length();
-    }
+        /** the comb filter lengths per stereo offset */
+        size_t combFilterLengthList[_stereoOffsetCount]
+                                   [_lineCombFilterCount];
+
+        /** the allpass filter lengths per stereo offset */
+        size_t allpassFilterLengthList[_stereoOffsetCount]
+                                      [_lineAllpassFilterCount];
+
+    };
 
     /*--------------------*/
 
-    void _AllpassFilter::setRingBufferLength (IN Natural length)
+    /**
+     * Returns the delay line length for a filter with
+     * <C>length</C> at the reference sample rate scaled to
+     * <C>sampleRate</C> at maximum room scale with stereo offset
+     * <C>offset</C>; this does exactly the operations of the runtime
+     * calculation in <C>_reverbLineDelayLength</C>, hence gives the
+     * same results.
+     *
+     * @param[in] sampleRate  the sample rate of reverb
+     * @param[in] length      the filter length at reference rate
+     * @param[in] offset      the stereo offset
+     * @return  the delay line length
+     */
+    static constexpr size_t _scaledDelayLength (IN Real sampleRate,
+                                                IN size_t length,
+                                                IN Real offset)
+    {
+        const Real factor =
+            sampleRate / _referenceSampleRate * _maximumRoomScale;
+        const Real result =
+            factor * (Real{(double) length} + _stereoSpread * offset);
+        return (size_t) ((double) result + 0.5);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the table of delay line lengths for
+     * <C>sampleRate</C> at maximum room scale.
+     *
+     * @param[in] sampleRate  the sample rate of reverb
+     * @return  the delay length table
+     */
+    static constexpr _DelayLengthTable
+    _makeDelayLengthTable (IN double sampleRate)
+    {
+        _DelayLengthTable result{};
+
+        for (size_t j = 0;  j < _stereoOffsetCount;  j++) {
+            const Real offset{(double) j - 1.0};
+
+            for (size_t k = 0;  k < _lineCombFilterCount;  k++) {
+                result.combFilterLengthList[j][k] =
+                    _scaledDelayLength(sampleRate,
+                                       _combFilterLengthList[k], offset);
+            }
+
+            for (size_t k = 0;  k < _lineAllpassFilterCount;  k++) {
+                result.allpassFilterLengthList[j][k] =
+                    _scaledDelayLength(sampleRate,
+                                       _allpassFilterLengthList[k],
+                                       offset);
+            }
+        }
+
+        return result;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the table of delay line lengths for
+     * <C>sampleRate</C> on the heap (the factory of the delay length
+     * table kind in the sample rate context).
+     *
+     * @param[in] sampleRate  the sample rate of reverb
+     * @return  the new delay length table
+     */
+    static Object _makeDelayLengthTableObject (IN Real sampleRate)
+    {
+        return new _DelayLengthTable{_makeDelayLengthTable((double)
+                                                           sampleRate)};
+    }
+
+    /*--------------------*/
+
+    /**
+     * Destroys the delay length <C>table</C> made by
+     * <C>_makeDelayLengthTableObject</C>.
+     *
+     * @param[inout] table  the delay length table
+     */
+    static void _destroyDelayLengthTable (INOUT Object table)
+    {
+        delete (_DelayLengthTable*) table;
+    }
+
+    /*--------------------*/
+
+    /** the kind of the delay length table in a sample rate context;
+     * its tables are shared by all reverbs at the same rate */
+    static const SampleRateTableKind _delayLengthTableKind{
+        "reverbDelayLengths",
+        _makeDelayLengthTableObject,
+        _destroyDelayLengthTable
+    };
+
+    /*============================================================*/
+
+    _DelayLine::_DelayLine ()
+        : _data{nullptr},
+          _capacity{0},
+          _length{0},
+          _position{0}
+    {
+    }
+
+    /*--------------------*/
+
+    Natural _DelayLine::length () const
+    {
+        return Natural{_length};
+    }
+
+    /*--------------------*/
+
+    void _DelayLine::setLength (IN Natural length)
+    {
+        Assertion_pre((size_t) length <= _capacity,
+                      "delay line storage must be large enough");
+        _length   = (size_t) length;
+        _position = 0;
+
+        for (size_t i = 0;  i < _length;  i++) {
+            _data[i] = 0;
+        }
+    }
+
+    /*--------------------*/
+
+    void _DelayLine::setStorage (INOUT DelayLineSample* storage,
+                                 IN Natural capacity)
+    {
+        _data     = storage;
+        _capacity = (size_t) capacity;
+        setLength(0);
+    }
+
+    /*--------------------*/
+
+    void _DelayLine::readBlock (OUT AudioSample* sampleArray,
+                                IN Natural count) const
     {
-        _sampleRingBuffer.setLength(length);
+        /* copy the segment up to the end of the delay line and then
+           the segment from its start */
+        const size_t totalCount = (size_t) count;
+        const size_t countA = std::min(totalCount, _length - _position);
+        const DelayLineSample* sourcePtr = &_data[_position];
+
+        for (size_t i = 0;  i < countA;  i++) {
+            sampleArray[i] = (double) sourcePtr[i];
+        }
+
+        for (size_t i = countA;  i < totalCount;  i++) {
+            sampleArray[i] = (double) _data[i - countA];
+        }
     }
 
     /*--------------------*/
 
-    AudioSample _AllpassFilter::apply (IN AudioSample inputSample)
+    void _DelayLine::writeBlock (IN AudioSample* sampleArray,
+                                 IN Natural count)
     {
-        const AudioSample outputSample = _sampleRingBuffer.first();
-        const AudioSample newSample =
-            inputSample + outputSample * _allpassFactor;
-        _sampleRingBuffer.shiftLeft(newSample);
-        return outputSample - inputSample;
+        const size_t totalCount = (size_t) count;
+        const size_t countA = std::min(totalCount, _length - _position);
+        DelayLineSample* targetPtr = &_data[_position];
+
+        for (size_t i = 0;  i < countA;  i++) {
+            targetPtr[i] = (DelayLineSample) (double) sampleArray[i];
+        }
+
+        for (size_t i = countA;  i < totalCount;  i++) {
+            _data[i - countA] = (DelayLineSample) (double) sampleArray[i];
+        }
+
+        const size_t position = _position + totalCount;
+        _position = (position >= _length ? position - _length : position);
     }
 
     /*--------------------*/
 
-    _CombFilter::_CombFilter ()
-        : _sampleRingBuffer{},
-          _storedSample{0.0}
+    void _DelayLine::delayBlock (IN AudioSample* inputArray,
+                                 OUT AudioSample* outputArray,
+                                 IN Natural count)
     {
+        const Natural length{_length};
+
+        if (count <= length) {
+            readBlock(outputArray, count);
+            writeBlock(inputArray, count);
+        } else {
+            /* the delayed block is the complete delay line followed
+               by the start of the input block, the delay line
+               afterwards holds the end of the input block */
+            const Natural remainingCount = count - length;
+            readBlock(outputArray, length);
+
+            for (Natural i = 0;  i < remainingCount;  i++) {
+                outputArray[(size_t) (length + i)] =
+                    inputArray[(size_t) i];
+            }
+
+            writeBlock(&inputArray[(size_t) remainingCount], length);
+        }
+    }
+
+    /*============================================================*/
+
+    _AllpassFilter::_AllpassFilter ()
+        : _delayLine{},
+          _delayedSampleList{}
+    {
+    }
+
+    /*--------------------*/
+
+    Natural _AllpassFilter::ringBufferLength () const
+    {
+        return _delayLine.length();
     }
 
     /*--------------------*/
 
-    Natural _CombFilter::ringBufferLength () const
+    Natural _AllpassFilter::byteCount () const
     {
-        return _sampleRingBuffer.length();
+        return Natural{sizeof(_AllpassFilter)
+                       + (_delayedSampleList.capacity()
+                          * sizeof(AudioSample))};
     }
 
     /*--------------------*/
 
-    void _CombFilter::setRingBufferLength (IN Natural length)
+    void _AllpassFilter::setRingBufferLength (IN Natural length)
     {
-        _sampleRingBuffer.setLength(length);
+        _delayLine.setLength(length);
     }
 
     /*--------------------*/
 
-    AudioSample _CombFilter::apply (IN AudioSample inputSample,
-                                       IN Real feedback,
-                                       IN Real hfDamping)
+    void _AllpassFilter::setStorage (INOUT DelayLineSample* storage,
+                                     IN Natural capacity)
     {
-        const AudioSample outputSample = _sampleRingBuffer.first();
-        _storedSample = (outputSample
-                         + (_storedSample - outputSample) * hfDamping);
-        _sampleRingBuffer.shiftLeft(inputSample + _storedSample * feedback);
+        /* a block never exceeds the delay line length, hence the
+           capacity also suffices for the delayed samples */
+        _delayLine.setStorage(storage, capacity);
+        _delayedSampleList.setLength(capacity);
+    }
+
+    /*--------------------*/
+
+    void _AllpassFilter::applyBlock (INOUT AudioSample* sampleArray,
+                                     IN Natural count)
+    {
+        AudioSample* delayedArray = _delayedSampleList.asArray();
+        _delayLine.readBlock(delayedArray, count);
+
+        /* the delayed samples are replaced by the new samples for
+           the delay line */
+        for (Natural i = 0;  i < count;  i++) {
+            const AudioSample inputSample  = sampleArray[(size_t) i];
+            const AudioSample outputSample = delayedArray[(size_t) i];
+            delayedArray[(size_t) i] =
+                DenormalGuard::flushed(inputSample
+                                       + outputSample * _allpassFactor);
+            sampleArray[(size_t) i] = outputSample - inputSample;
+        }
+
+        _delayLine.writeBlock(delayedArray, count);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Tells whether the comb or allpass filter with <C>index</C> is
+     * optional, i.e. skipped in economy quality; this holds for
+     * every other filter (those with odd index).
+     *
+     * @param[in] index  the index of the filter (starting at zero)
+     * @return  information whether filter is optional
+     */
+    static inline Boolean _isOptionalFilter (IN Natural index)
+    {
+        return (index % 2 == 1);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the lane of the comb filter with <C>index</C> in a comb
+     * filter bank: the non-optional filters come first in their
+     * order, followed by the optional ones.
+     *
+     * @param[in] index  the index of the comb filter
+     * @return  lane of comb filter
+     */
+    static inline size_t _combFilterLane (IN size_t index)
+    {
+        return (!_isOptionalFilter(Natural{index}) ? index / 2
+                : _economyCombFilterCount + index / 2);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the index of the comb filter in <C>lane</C> of a comb
+     * filter bank (the inverse of <C>_combFilterLane</C>).
+     *
+     * @param[in] lane  the lane in the comb filter bank
+     * @return  index of comb filter
+     */
+    static inline size_t _combFilterIndex (IN size_t lane)
+    {
+        return (lane < _economyCombFilterCount ? 2 * lane
+                : 2 * (lane - _economyCombFilterCount) + 1);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the quality weight at sample <C>index</C> of a block
+     * for a crossfade starting with <C>qualityWeight</C> and
+     * changing by <C>weightIncrement</C> per sample.
+     *
+     * @param[in] qualityWeight    the weight at the block start
+     * @param[in] weightIncrement  the change of the weight per sample
+     * @param[in] index            the index of the sample in block
+     * @return  weight limited to the interval [0, 1]
+     */
+    static inline Real _qualityWeightAt (IN Real qualityWeight,
+                                         IN Real weightIncrement,
+                                         IN Natural index)
+    {
+        const Real result = qualityWeight + weightIncrement * Real{index};
+        return result.forceToInterval(0.0, 1.0);
+    }
+
+    /*--------------------*/
+
+    _CombFilterBank::_CombFilterBank ()
+        : _delayLineData{nullptr},
+          _capacity{0},
+          _offsetList{},
+          _lengthList{},
+          _positionList{},
+          _storedSampleList{},
+          _outputSampleList{},
+          _kernels{&Kernels::current()}
+    {
+        for (size_t k = 0;  k < _lineCombFilterCount;  k++) {
+            _offsetList[k]       = 0;
+            _lengthList[k]       = 0;
+            _positionList[k]     = 0;
+            _storedSampleList[k] = 0.0;
+            _outputSampleList[k] = 0.0;
+        }
+    }
+
+    /*--------------------*/
+
+    Natural _CombFilterBank::ringBufferLength (IN Natural index) const
+    {
+        return Natural{_lengthList[_combFilterLane((size_t) index)]};
+    }
+
+    /*--------------------*/
+
+    void
+    _CombFilterBank::setRingBufferLengths
+                         (IN _CombFilterLengthList& lengthList)
+    {
+        /* each delay line gets at least one slot, such that reads
+           and writes stay within its segment */
+        size_t offset = 0;
+
+        for (size_t k = 0;  k < _lineCombFilterCount;  k++) {
+            const size_t length = (size_t) lengthList[_combFilterIndex(k)];
+            _offsetList[k]   = offset;
+            _lengthList[k]   = length;
+            _positionList[k] = 0;
+            offset += (length == 0 ? 1 : length);
+        }
+
+        Assertion_pre(offset <= _capacity,
+                      "comb filter storage must be large enough");
+
+        for (size_t i = 0;  i < offset;  i++) {
+            _delayLineData[i] = 0;
+        }
+    }
+
+    /*--------------------*/
+
+    void _CombFilterBank::setStorage (INOUT DelayLineSample* storage,
+                                      IN Natural capacity)
+    {
+        _delayLineData = storage;
+        _capacity      = (size_t) capacity;
+        _CombFilterLengthList lengthList;
+
+        for (size_t k = 0;  k < _lineCombFilterCount;  k++) {
+            lengthList[k] = 0;
+        }
+
+        setRingBufferLengths(lengthList);
+    }
+
+    /*--------------------*/
+
+    void _CombFilterBank::clearOptionalFilters ()
+    {
+        for (size_t k = _economyCombFilterCount;
+             k < _lineCombFilterCount;  k++) {
+            const size_t length = std::max(_lengthList[k], size_t{1});
+            DelayLineSample* delayLine = &_delayLineData[_offsetList[k]];
+
+            for (size_t i = 0;  i < length;  i++) {
+                delayLine[i] = 0;
+            }
+
+            _positionList[k]     = 0;
+            _storedSampleList[k] = 0.0;
+        }
+    }
+
+    /*--------------------*/
+
+    AudioSample _CombFilterBank::apply (IN AudioSample inputSample,
+                                        IN Real feedback,
+                                        IN Real hfDamping,
+                                        IN Real qualityWeight)
+    {
+        const size_t laneCount = (qualityWeight == 0.0
+                                  ? _economyCombFilterCount
+                                  : _lineCombFilterCount);
+        size_t slotIndexArray[_lineCombFilterCount];
+
+        for (size_t k = 0;  k < laneCount;  k++) {
+            slotIndexArray[k] = _offsetList[k] + _positionList[k];
+        }
+
+        _kernels->combFilterBank(_delayLineData, slotIndexArray,
+                                 _storedSampleList.data(),
+                                 _outputSampleList.data(),
+                                 laneCount,
+                                 (double) inputSample, (double) feedback,
+                                 (double) hfDamping);
+
+        /* advance the delay lines */
+        for (size_t k = 0;  k < laneCount;  k++) {
+            const size_t position = _positionList[k] + 1;
+            _positionList[k] = (position >= _lengthList[k] ? 0 : position);
+        }
+
+        AudioSample outputSample = 0.0;
+
+        if (qualityWeight == 1.0) {
+            /* sum up the outputs in filter order as SoX does */
+            for (size_t i = 0;  i < _lineCombFilterCount;  i++) {
+                outputSample += _outputSampleList[_combFilterLane(i)];
+            }
+        } else {
+            /* crossfade the compensated sum of the non-optional
+               filters with the sum of all filters */
+            AudioSample economySample = 0.0;
+            AudioSample optionalSample = 0.0;
+
+            for (size_t k = 0;  k < laneCount;  k++) {
+                if (k < _economyCombFilterCount) {
+                    economySample += _outputSampleList[k];
+                } else {
+                    optionalSample += _outputSampleList[k];
+                }
+            }
+
+            outputSample =
+                (economySample * ((Real::one - qualityWeight)
+                                  * _economyGain
+                                  + qualityWeight)
+                 + optionalSample * qualityWeight);
+        }
+
         return outputSample;
     }
 
+    /*--------------------*/
+
+    void _CombFilterBank::applyBlock (IN AudioSample* inputArray,
+                                      OUT AudioSample* outputArray,
+                                      IN Natural count,
+                                      IN Real feedback,
+                                      IN Real hfDamping,
+                                      IN Real qualityWeight,
+                                      IN Real weightIncrement)
+    {
+        for (Natural i = 0;  i < count;  i++) {
+            const Real weight =
+                (weightIncrement == 0.0 ? qualityWeight
+                 : _qualityWeightAt(qualityWeight, weightIncrement, i));
+            outputArray[(size_t) i] =
+                apply(inputArray[(size_t) i], feedback, hfDamping,
+                      weight);
+        }
+    }
+
     /*============================================================*/
 
     /**
@@ -540,7 +1697,7 @@ namespace SoXPlugins::Effects::SoXReverb {
      *                          or allpass
      *                          filter should be calculated
      * @param[in] index         the index of the filter (starting at zero)
-     * @param[in] sampleRate    the sample rate of reverb
+     * @param[in] sampleRateContext  the sample rate context of reverb
      * @param[in] cRoomScale    the room scale of reverb
      * @param[in] stereoDepth   the desired stereo depth of reverb
      * @return  length of filter sample ring buffer
@@ -549,48 +1706,70 @@ namespace SoXPlugins::Effects::SoXReverb {
     Natural _reverbLineDelayLength (IN Boolean isCreation,
                                     IN Boolean isCombFilter,
                                     IN Natural index,
-                                    IN Real sampleRate,
+                                    IN SampleRateContext& sampleRateContext,
                                     IN Real cRoomScale,
                                     IN Real stereoDepth)
     {
+        const Real sampleRate = sampleRateContext.sampleRate();
         const Real roomScale = (isCreation ? _maximumRoomScale
                                 : (isCombFilter ? cRoomScale : 1.0));
         const Real factor = sampleRate / _referenceSampleRate * roomScale;
         const Integer sign = (index % 2 == 0 ? 1 : -1);
         const Real offset = (isCreation ? _maximumStereoDepth
                              : stereoDepth * sign);
-        const NaturalList& lengthList = (isCombFilter
-                                         ? _combFilterLengthList
-                                         : _allpassFilterLengthList);
-        const Natural length = lengthList[index];
-        const Real adjustment = _stereoSpread;
-        const Natural result =
-            Natural{Real::round(factor
-                                * (Real{length} + adjustment * offset))};
+
+        /* the lengths at maximum room scale and full or no stereo
+           depth are tabulated in the shared sample rate context */
+        const Boolean isTabulated =
+            (roomScale == _maximumRoomScale
+             && (offset == -1.0 || offset == 0.0 || offset == 1.0));
+        Natural result;
+
+        if (isTabulated) {
+            const _DelayLengthTable& table =
+                TOREFERENCE<_DelayLengthTable>
+                    (sampleRateContext.table(_delayLengthTableKind));
+            const size_t offsetIndex = (size_t) ((int) offset + 1);
+            const size_t* lengthList =
+                (isCombFilter ? table.combFilterLengthList[offsetIndex]
+                 : table.allpassFilterLengthList[offsetIndex]);
+            result = Natural{lengthList[(size_t) index]};
+        } else {
+            const size_t* lengthList = (isCombFilter
+                                        ? _combFilterLengthList
+                                        : _allpassFilterLengthList);
+            const Natural length{lengthList[(size_t) index]};
+            const Real adjustment = _stereoSpread;
+            result =
+                Natural{Real::round(factor
+                                    * (Real{length} + adjustment * offset))};
+        }
+
         return result;
     }
 
     /*--------------------*/
 
     /**
-     * Returns initial filter delay line maximum length for the
-     * sampleRingBuffer for given parameters.
+     * Returns the maximum filter delay line length for the
+     * sampleRingBuffer for given parameters (for any room scale and
+     * stereo depth).
      *
      * @param[in] isCombFilter  tells to adapt comb filter or allpass
      *                          filter
      * @param[in] index         the index of the filter (starting at zero)
-     * @param[in] sampleRate    the sample rate of reverb
-     * @return maximum ring buffer length (for later setup)
+     * @param[in] sampleRateContext  the sample rate context of reverb
+     * @return maximum ring buffer length (for storage allocation)
      */
-    static
-    Natural _initialReverbLineDelayLength (IN Boolean isCombFilter,
-                                           IN Natural index,
-                                           IN Real sampleRate)
+    static Natural
+    _maximumReverbLineDelayLength (IN Boolean isCombFilter,
+                                   IN Natural index,
+                                   IN SampleRateContext& sampleRateContext)
     {
         /* calculate maximum ring buffer length with arbitrary values
            for <channel>, <roomScale> and <stereoDepth> */
-        return _reverbLineDelayLength(true, isCombFilter,
-                                      index, sampleRate, 0.0, 0.0);
+        return _reverbLineDelayLength(true, isCombFilter, index,
+                                      sampleRateContext, 0.0, 0.0);
     }
 
     /*--------------------*/
@@ -598,50 +1777,44 @@ namespace SoXPlugins::Effects::SoXReverb {
     /**
      * Returns adapted filter delay line length for the sample ring
      * buffer for given parameters <C>isCombFilter</C>,
-     * <C>sampleRate</C>, <C>roomScale</C> and <C>stereoDepth</C> to
-     * their effective length.
+     * <C>sampleRateContext</C>, <C>roomScale</C> and
+     * <C>stereoDepth</C> to their effective length.
      *
      * @param[in] isCombFilter  tells whether length for comb filter or
      *                          allpass filter should be calculated
      * @param[in] index         the index of the filter (starting at zero)
-     * @param[in] sampleRate    the sample rate of reverb
+     * @param[in] sampleRateContext  the sample rate context of reverb
      * @param[in] roomScale     the room scale of reverb
      * @param[in] stereoDepth   the desired stereo depth of reverb
      * @return  adapted length of filter sample ring buffer
      */
-    static
-    Natural _adjustedReverbLineDelayLength (IN Boolean isCombFilter,
-                                            IN Natural index,
-                                            IN Real sampleRate,
-                                            IN Real roomScale,
-                                            IN Real stereoDepth)
+    static Natural
+    _adjustedReverbLineDelayLength (IN Boolean isCombFilter,
+                                    IN Natural index,
+                                    IN SampleRateContext& sampleRateContext,
+                                    IN Real roomScale,
+                                    IN Real stereoDepth)
     {
         return _reverbLineDelayLength(false, isCombFilter, index,
-                                      sampleRate, roomScale, stereoDepth);
+                                      sampleRateContext, roomScale,
+                                      stereoDepth);
     }
 
     /*============================================================*/
 
     _ReverbLine::_ReverbLine ()
         : _allpassFilterList{},
-          _combFilterList{}
+          _combFilterBank{},
+          _hasCombFilters{true},
+          _isEconomy{false},
+          _qualityWeight{1.0},
+          _qualityWeightStep{1.0},
+          _dryList{}
     {
-        /* set allpass filters delay line lengths */
-        for (Natural i = 0;  i < _lineAllpassFilterCount;  i++) {
-            _AllpassFilter* allpassFilter = new _AllpassFilter();
-            const Natural length =
-                _initialReverbLineDelayLength(false, i, _defaultSampleRate);
-            allpassFilter->setRingBufferLength(length);
-            _allpassFilterList[i] = allpassFilter;
-        }
+        _dryList.setLength(_blockLength);
 
-        /* set comb filters delay line lengths */
-        for (Natural i = 0;  i < _lineCombFilterCount;  i++) {
-            _CombFilter* combFilter = new _CombFilter();
-            const Natural length =
-                _initialReverbLineDelayLength(true, i, _defaultSampleRate);
-            combFilter->setRingBufferLength(length);
-            _combFilterList[i] = combFilter;
+        for (Natural i = 0;  i < _lineAllpassFilterCount;  i++) {
+            _allpassFilterList[i] = new _AllpassFilter();
         }
     }
 
@@ -652,10 +1825,6 @@ namespace SoXPlugins::Effects::SoXReverb {
         for (_AllpassFilter* filter : _allpassFilterList) {
             delete filter;
         }
-
-        for (_CombFilter* filter : _combFilterList) {
-            delete filter;
-        }
     }
 
     /*--------------------*/
@@ -673,14 +1842,13 @@ namespace SoXPlugins::Effects::SoXReverb {
                    + TOSTRING(ringBufferLength));
         }
 
-        st += ", ";
-
-        for (Natural i = 0;  i < _lineCombFilterCount;  i++) {
-            const _CombFilter* filter = _combFilterList[i];
-            const Natural ringBufferLength = filter->ringBufferLength();
-            st += ((i > 0 ? ", cf(" : "cf(")
-                   + TOSTRING(i) + ")="
-                   + TOSTRING(ringBufferLength));
+        if (_hasCombFilters) {
+            for (Natural i = 0;  i < _lineCombFilterCount;  i++) {
+                const Natural ringBufferLength =
+                    _combFilterBank.ringBufferLength(i);
+                st += (", cf(" + TOSTRING(i) + ")="
+                       + TOSTRING(ringBufferLength));
+            }
         }
 
         st += ")";
@@ -689,60 +1857,251 @@ namespace SoXPlugins::Effects::SoXReverb {
 
     /*--------------------*/
 
-    void _ReverbLine::adjustRingBufferLengths (IN Real sampleRate,
-                                          IN Real roomScale,
-                                          IN Real stereoDepth)
+    Natural
+    _ReverbLine::storageLength (IN SampleRateContext& sampleRateContext,
+                                IN Boolean hasCombFilters)
+    {
+        Natural result = 0;
+
+        for (Natural i = 0;  i < _lineAllpassFilterCount;  i++) {
+            result += _maximumReverbLineDelayLength(false, i,
+                                                    sampleRateContext);
+        }
+
+        /* each comb filter occupies at least one slot */
+        if (hasCombFilters) {
+            for (Natural i = 0;  i < _lineCombFilterCount;  i++) {
+                result +=
+                    Natural::maximum(1,
+                                     _maximumReverbLineDelayLength
+                                         (true, i, sampleRateContext));
+            }
+        }
+
+        return result;
+    }
+
+    /*--------------------*/
+
+    void _ReverbLine::setStorage (INOUT DelayLineSample* storage,
+                                  IN SampleRateContext& sampleRateContext,
+                                  IN Boolean hasCombFilters)
+    {
+        DelayLineSample* segment = storage;
+        _hasCombFilters = hasCombFilters;
+
+        for (Natural i = 0;  i < _lineAllpassFilterCount;  i++) {
+            const Natural capacity =
+                _maximumReverbLineDelayLength(false, i,
+                                              sampleRateContext);
+            _allpassFilterList[i]->setStorage(segment, capacity);
+            segment += (size_t) capacity;
+        }
+
+        if (hasCombFilters) {
+            const Natural combFilterCapacity =
+                (storageLength(sampleRateContext, true)
+                 - Natural{(size_t) (segment - storage)});
+            _combFilterBank.setStorage(segment, combFilterCapacity);
+        }
+    }
+
+    /*--------------------*/
+
+    void _ReverbLine::adjustRingBufferLengths
+                          (IN SampleRateContext& sampleRateContext,
+                           IN Real roomScale,
+                           IN Real stereoDepth)
     {
         /* adjust allpass filter delay lines */
         for (Natural i = 0;  i < _lineAllpassFilterCount;  i++) {
             _AllpassFilter* allpassFilter = _allpassFilterList[i];
             const Natural length =
-                _adjustedReverbLineDelayLength(false, i, sampleRate,
+                _adjustedReverbLineDelayLength(false, i, sampleRateContext,
                                                roomScale, stereoDepth);
             allpassFilter->setRingBufferLength(length);
         }
 
-        /* adjust comb filter delay lines */
-        for (Natural i = 0;  i < _lineCombFilterCount;  i++) {
-            _CombFilter* combFilter = _combFilterList[i];
-            const Natural length =
-                _adjustedReverbLineDelayLength(true, i, sampleRate,
-                                               roomScale, stereoDepth);
-            combFilter->setRingBufferLength(length);
+        /* adjust comb filter delay lines (if any) */
+        if (_hasCombFilters) {
+            _CombFilterLengthList lengthList;
+
+            for (Natural i = 0;  i < _lineCombFilterCount;  i++) {
+                lengthList[(size_t) i] =
+                    _adjustedReverbLineDelayLength(true, i,
+                                                   sampleRateContext,
+                                                   roomScale, stereoDepth);
+            }
+
+            _combFilterBank.setRingBufferLengths(lengthList);
         }
+
+        /* all delay lines are cleared, hence the requested quality
+           applies at once */
+        const Real sampleRate = sampleRateContext.sampleRate();
+        const Natural fadeLength =
+            Natural::maximum(1, Natural{Real::round(_qualityFadeDuration
+                                                    * sampleRate)});
+        _qualityWeightStep = Real::one / Real{fadeLength};
+        _qualityWeight     = (_isEconomy ? 0.0 : 1.0);
     }
 
     /*--------------------*/
 
-    AudioSample _ReverbLine::apply (IN AudioSample inputSample,
-                                       IN Real feedback,
-                                       IN Real hfDamping,
-                                       IN Real gain)
+    void _ReverbLine::setQuality (IN Boolean isEconomy)
     {
-        /* route input sample through the filters */
-        AudioSample outputSample = 0.0;
+        if (!isEconomy && _qualityWeight == 0.0) {
+            /* the optional filters have been idle and are faded in
+               from silence */
+            if (_hasCombFilters) {
+                _combFilterBank.clearOptionalFilters();
+            }
+
+            for (Natural i = 0;  i < _lineAllpassFilterCount;  i++) {
+                if (_isOptionalFilter(i)) {
+                    _AllpassFilter* filter = _allpassFilterList[i];
+                    filter->setRingBufferLength(filter->ringBufferLength());
+                }
+            }
+        }
+
+        _isEconomy = isEconomy;
+    }
+
+    /*--------------------*/
 
-        /* process comb filters in parallel */
-        for (_CombFilter* filter : _combFilterList) {
-            outputSample += filter->apply(inputSample, feedback, hfDamping);
+    Natural _ReverbLine::maximumBlockLength () const
+    {
+        Natural result = Natural::maximumValue();
+
+        for (const _AllpassFilter* filter : _allpassFilterList) {
+            result = Natural::minimum(result, filter->ringBufferLength());
         }
 
-        /* process allpass filters in series */
-        for (_AllpassFilter* filter : _allpassFilterList) {
-            outputSample = filter->apply(outputSample);
+        return result;
+    }
+
+    /*--------------------*/
+
+    Natural _ReverbLine::byteCount () const
+    {
+        Natural result{sizeof(_ReverbLine)
+                       + _dryList.capacity() * sizeof(AudioSample)};
+
+        for (const _AllpassFilter* filter : _allpassFilterList) {
+            result += filter->byteCount();
         }
 
-        outputSample *= gain;
-        return outputSample;
+        return result;
+    }
+
+    /*--------------------*/
+
+    void _ReverbLine::applyBlock (IN AudioSample* inputArray,
+                                  OUT AudioSample* outputArray,
+                                  IN Natural count,
+                                  IN Real feedback,
+                                  IN Real hfDamping,
+                                  IN Real gain)
+    {
+        applyCombFilters(inputArray, outputArray, count,
+                         feedback, hfDamping);
+        applyAllpassFilters(outputArray, count, gain);
+    }
+
+    /*--------------------*/
+
+    void _ReverbLine::applyCombFilters (IN AudioSample* inputArray,
+                                        OUT AudioSample* outputArray,
+                                        IN Natural count,
+                                        IN Real feedback,
+                                        IN Real hfDamping)
+    {
+        /* route input samples through the filters; the comb filters
+           are processed in parallel */
+        Logging_beginSpan("_ReverbLine.combFilterBank", this);
+        _combFilterBank.applyBlock(inputArray, outputArray, count,
+                                   feedback, hfDamping,
+                                   _qualityWeight,
+                                   _qualityWeightIncrement());
+        Logging_endSpan("_ReverbLine.combFilterBank", this);
+    }
+
+    /*--------------------*/
+
+    void _ReverbLine::applyAllpassFilters (INOUT AudioSample* sampleArray,
+                                           IN Natural count,
+                                           IN Real gain)
+    {
+        AudioSample* outputArray = sampleArray;
+        const Real weightIncrement = _qualityWeightIncrement();
+        const Boolean isFading = (weightIncrement != 0.0);
+
+        /* process allpass filters in series; the optional ones are
+           skipped in economy quality and crossfaded with their
+           direct path (the inverted input) while the quality
+           changes; because an even number of filters is skipped,
+           the inversions cancel in economy quality */
+        for (Natural j = 0;  j < _lineAllpassFilterCount;  j++) {
+            _AllpassFilter* filter = _allpassFilterList[j];
+
+            if (!_isOptionalFilter(j)
+                || (!isFading && _qualityWeight == 1.0)) {
+                filter->applyBlock(outputArray, count);
+            } else if (isFading) {
+                AudioSample* dryArray = _dryList.asArray();
+
+                for (Natural i = 0;  i < count;  i++) {
+                    dryArray[(size_t) i] = outputArray[(size_t) i];
+                }
+
+                filter->applyBlock(outputArray, count);
+
+                for (Natural i = 0;  i < count;  i++) {
+                    const Real weight =
+                        _qualityWeightAt(_qualityWeight,
+                                         weightIncrement, i);
+                    const AudioSample drySample = dryArray[(size_t) i];
+                    outputArray[(size_t) i] =
+                        (outputArray[(size_t) i] * weight
+                         - drySample * (Real::one - weight));
+                }
+            }
+        }
+
+        for (Natural i = 0;  i < count;  i++) {
+            outputArray[(size_t) i] *= gain;
+        }
+
+        if (isFading) {
+            _qualityWeight = _qualityWeightAt(_qualityWeight,
+                                              weightIncrement, count);
+        }
+    }
+
+    /*--------------------*/
+
+    Real _ReverbLine::_qualityWeightIncrement () const
+    {
+        /* a quality weight differing from the requested quality
+           moves towards it during this block */
+        const Real targetWeight = (_isEconomy ? 0.0 : 1.0);
+        return (_qualityWeight == targetWeight ? 0.0
+                : (_isEconomy ? -_qualityWeightStep : _qualityWeightStep));
     }
 
     /*============================================================*/
 
     _ReverbChannel::_ReverbChannel ()
-        : _inputSampleRingBuffer{0},
+        : _inputDelayLine{},
+          _delayedInputList{},
+          _linesAreShared{false},
+          _combTapDelayLine{},
           _reverbLineCount{2},
           _reverbLineList{2}
     {
+        _delayedInputList.setLength(_blockLength);
+
         for (_ReverbLine*& reverbLine : _reverbLineList) {
             reverbLine = new _ReverbLine();
         }
@@ -763,7 +2122,10 @@ namespace SoXPlugins::Effects::SoXReverb {
     {
         String st = ("ReverbChannel("
                      "predelay = "
-                     + TOSTRING(_inputSampleRingBuffer.length()));
+                     + TOSTRING(_inputDelayLine.length())
+                     + ", linesAreShared = " + TOSTRING(_linesAreShared)
+                     + ", combTap = "
+                     + TOSTRING(_combTapDelayLine.length()));
 
         /* add information about reverb lines */
         for (const _ReverbLine* reverbLine : _reverbLineList) {
@@ -776,52 +2138,280 @@ namespace SoXPlugins::Effects::SoXReverb {
 
     /*--------------------*/
 
-    void _ReverbChannel::adjustRingBufferLengths (IN Real sampleRate,
-                                             IN Real predelay,
-                                             IN Real roomScale,
-                                             IN Real stereoDepth)
+    /**
+     * Returns the maximum predelay line length at
+     * <C>sampleRate</C>.
+     *
+     * @param[in] sampleRate  the sample rate of reverb
+     * @return  maximum predelay length in samples
+     */
+    static Natural _maximumPredelayLength (IN Real sampleRate)
+    {
+        return Natural{Real::round(_maximumPredelay * sampleRate)};
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the length of the tap delay line for the shared comb
+     * filter output at <C>sampleRate</C> for <C>roomScale</C> and
+     * <C>stereoDepth</C>: the stereo spread of the comb filters.
+     *
+     * @param[in] sampleRate   the sample rate of reverb
+     * @param[in] roomScale    the room scale of reverb
+     * @param[in] stereoDepth  the stereo depth of reverb
+     * @return  tap delay length in samples
+     */
+    static Natural _combTapLength (IN Real sampleRate,
+                                   IN Real roomScale,
+                                   IN Real stereoDepth)
+    {
+        const Real factor = sampleRate / _referenceSampleRate * roomScale;
+        return Natural{Real::round(factor * _stereoSpread * stereoDepth)};
+    }
+
+    /*--------------------*/
+
+    Natural
+    _ReverbChannel::storageLength (IN SampleRateContext& sampleRateContext,
+                                   IN Boolean linesAreShared)
+    {
+        const Real sampleRate = sampleRateContext.sampleRate();
+        Natural result =
+            (_maximumPredelayLength(sampleRate)
+             + _ReverbLine::storageLength(sampleRateContext, true));
+
+        if (linesAreShared) {
+            result += (_combTapLength(sampleRate, _maximumRoomScale,
+                                      _maximumStereoDepth)
+                       + _ReverbLine::storageLength(sampleRateContext,
+                                                    false));
+        } else {
+            result += _ReverbLine::storageLength(sampleRateContext, true);
+        }
+
+        return ((result + _cacheLineSampleCount - 1)
+                / _cacheLineSampleCount * _cacheLineSampleCount);
+    }
+
+    /*--------------------*/
+
+    void
+    _ReverbChannel::setStorage (INOUT DelayLineSample* storage,
+                                IN SampleRateContext& sampleRateContext,
+                                IN Boolean linesAreShared)
+    {
+        const Real sampleRate = sampleRateContext.sampleRate();
+        _linesAreShared = linesAreShared;
+        const Natural predelayCapacity = _maximumPredelayLength(sampleRate);
+        _inputDelayLine.setStorage(storage, predelayCapacity);
+        DelayLineSample* segment = storage + (size_t) predelayCapacity;
+        Boolean hasCombFilters = true;
+
+        for (_ReverbLine* reverbLine : _reverbLineList) {
+            reverbLine->setStorage(segment, sampleRateContext,
+                                   hasCombFilters);
+            segment +=
+                (size_t) _ReverbLine::storageLength(sampleRateContext,
+                                                    hasCombFilters);
+            hasCombFilters = !linesAreShared;
+        }
+
+        const Natural tapCapacity =
+            (!linesAreShared ? Natural{0}
+             : _combTapLength(sampleRate, _maximumRoomScale,
+                              _maximumStereoDepth));
+        _combTapDelayLine.setStorage(segment, tapCapacity);
+    }
+
+    /*--------------------*/
+
+    void _ReverbChannel::adjustRingBufferLengths
+                             (IN SampleRateContext& sampleRateContext,
+                              IN Real predelay,
+                              IN Real roomScale,
+                              IN Real stereoDepth)
+    {
+        adjustPredelay(sampleRateContext, predelay);
+        adjustReverbLineLengths(sampleRateContext, roomScale, stereoDepth);
+    }
+
+    /*--------------------*/
+
+    void
+    _ReverbChannel::adjustPredelay (IN SampleRateContext& sampleRateContext,
+                                    IN Real predelay)
     {
         const Natural ringBufferLength =
-            Natural{Real::round(predelay * sampleRate)};
-        _inputSampleRingBuffer.setLength(ringBufferLength);
+            Natural{Real::round(predelay * sampleRateContext.sampleRate())};
+        _inputDelayLine.setLength(ringBufferLength);
+    }
+
+    /*--------------------*/
 
+    void _ReverbChannel::adjustReverbLineLengths
+                             (IN SampleRateContext& sampleRateContext,
+                              IN Real roomScale,
+                              IN Real stereoDepth)
+    {
         /* adapt lengths of reverb lines; when stereo depth is zero,
            only a single reverb line is used per channel */
         _reverbLineCount = (stereoDepth == 0.0 ? 1 : 2);
         Real effectiveStereoDepth = 0.0;
 
         for (_ReverbLine* reverbLine : _reverbLineList) {
-            reverbLine->adjustRingBufferLengths(sampleRate, roomScale,
-                                           effectiveStereoDepth);
+            reverbLine->adjustRingBufferLengths(sampleRateContext,
+                                                roomScale,
+                                                effectiveStereoDepth);
             effectiveStereoDepth = stereoDepth;
         }
+
+        if (_linesAreShared) {
+            _combTapDelayLine.setLength
+                (_combTapLength(sampleRateContext.sampleRate(),
+                                roomScale, stereoDepth));
+        }
+    }
+
+    /*--------------------*/
+
+    void _ReverbChannel::setQuality (IN Boolean isEconomy)
+    {
+        for (_ReverbLine* reverbLine : _reverbLineList) {
+            reverbLine->setQuality(isEconomy);
+        }
+    }
+
+    /*--------------------*/
+
+    Natural _ReverbChannel::maximumBlockLength () const
+    {
+        Natural result = Natural::maximumValue();
+
+        for (Natural i = 0;  i < _reverbLineCount;  i++) {
+            const _ReverbLine* reverbLine = _reverbLineList[i];
+            result = Natural::minimum(result,
+                                      reverbLine->maximumBlockLength());
+        }
+
+        return result;
+    }
+
+    /*--------------------*/
+
+    Natural _ReverbChannel::byteCount () const
+    {
+        Natural result{sizeof(_ReverbChannel)
+                       + (_delayedInputList.capacity()
+                          * sizeof(AudioSample))
+                       + (_reverbLineList.capacity()
+                          * sizeof(_ReverbLine*))};
+
+        for (const _ReverbLine* reverbLine : _reverbLineList) {
+            result += reverbLine->byteCount();
+        }
+
+        return result;
     }
 
     /*--------------------*/
 
-    void _ReverbChannel::apply (IN AudioSample cInputSample,
-                                IN Real feedback,
-                                IN Real hfDamping,
-                                IN Real gain,
-                                OUT _SamplePair& wetSamplePair)
+    void _ReverbChannel::applyBlock (IN AudioSample* inputArray,
+                                     IN Natural count,
+                                     IN Real feedback,
+                                     IN Real hfDamping,
+                                     IN Real gain,
+                                     OUT _SampleArrayPair& wetArrayPair)
     {
-        AudioSample inputSample = cInputSample;
+        const AudioSample* lineInputArray = inputArray;
+        const Natural predelayLength = _inputDelayLine.length();
 
         /* check and process predelay */
-        if (_inputSampleRingBuffer.length() > 0) {
-            const AudioSample firstSample = _inputSampleRingBuffer.first();
-            _inputSampleRingBuffer.shiftLeft(inputSample);
-            inputSample = firstSample;
+        if (predelayLength > 0) {
+            AudioSample* delayedArray = _delayedInputList.asArray();
+            _inputDelayLine.delayBlock(inputArray, delayedArray, count);
+            lineInputArray = delayedArray;
         }
 
         /* process all reverb lines for this channel and store their
-           results in output sample list */
-        for (Natural i = 0;  i < _reverbLineCount;  i++) {
-            _ReverbLine* reverbLine = _reverbLineList[i];
-            const AudioSample outputSample =
-                reverbLine->apply(inputSample, feedback, hfDamping, gain);
-            wetSamplePair[i] = outputSample;
+           results in the wet arrays */
+        if (_linesAreShared && _reverbLineCount > 1) {
+            /* the second line taps the comb filter output of the
+               first line before its allpass filters */
+            _ReverbLine* firstLine  = _reverbLineList[0];
+            _ReverbLine* secondLine = _reverbLineList[1];
+            firstLine->applyCombFilters(lineInputArray, wetArrayPair[0],
+                                        count, feedback, hfDamping);
+            _combTapDelayLine.delayBlock(wetArrayPair[0],
+                                         wetArrayPair[1], count);
+            firstLine->applyAllpassFilters(wetArrayPair[0], count, gain);
+            secondLine->applyAllpassFilters(wetArrayPair[1], count, gain);
+        } else {
+            for (Natural i = 0;  i < _reverbLineCount;  i++) {
+                _ReverbLine* reverbLine = _reverbLineList[i];
+                reverbLine->applyBlock(lineInputArray, wetArrayPair[i],
+                                       count, feedback, hfDamping, gain);
+            }
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Sets the block length of reverb parameter data
+     * <C>effectParameterData</C> from the current delay line lengths
+     * of its channels: it is bounded by the shortest delay line such
+     * that each filter can process a block in one go.
+     *
+     * @param[inout] effectParameterData  the reverb parameter data
+     */
+    static void
+    _updateBlockLength (INOUT _ReverbEffectParameterData& effectParameterData)
+    {
+        Natural blockLength = _blockLength;
+
+        for (_ReverbChannel* reverbChannel
+                 : effectParameterData.reverbChannelList) {
+            blockLength =
+                Natural::minimum(blockLength,
+                                 reverbChannel->maximumBlockLength());
         }
+
+        effectParameterData.blockLength = Natural::maximum(blockLength, 1);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies the reverb channel <C>channel</C> of reverb parameter
+     * data <C>context</C> to its current block and stores the result
+     * in the wet buffer; used as task function for the worker pool.
+     *
+     * @param[inout] context  the reverb parameter data
+     * @param[in]    channel  the index of the reverb channel
+     */
+    static void _applyReverbChannel (INOUT void* context,
+                                     IN Natural channel)
+    {
+        _ReverbEffectParameterData& effectParameterData =
+            *((_ReverbEffectParameterData*) context);
+        AudioSampleListVector& buffer = *effectParameterData.currentBuffer;
+        AudioSampleListVector& wetBuffer = effectParameterData.wetBuffer;
+        _SampleArrayPair wetArrayPair;
+        wetArrayPair[0] = wetBuffer[Natural{2} * channel].asArray();
+        wetArrayPair[1] = wetBuffer[Natural{2} * channel + 1].asArray();
+
+        _ReverbChannel* reverbChannel =
+            effectParameterData.reverbChannelList[channel];
+        Logging_span("SoXReverb.channel", reverbChannel);
+        reverbChannel->applyBlock(buffer[channel]
+                                      .asArray(effectParameterData
+                                               .blockPosition),
+                                  effectParameterData.blockSampleCount,
+                                  effectParameterData.feedback,
+                                  effectParameterData.hfDamping,
+                                  effectParameterData.wetGain,
+                                  wetArrayPair);
     }
 
     /*--------------------*/
@@ -832,11 +2422,14 @@ namespace SoXPlugins::Effects::SoXReverb {
             STR::expand("isWetOnly = %1, feedback = %2,"
                         " hfDamping = %3%, predelay = %4s"
                         " stereoDepth = %5%, wetGain = %6dB"
-                        " roomScale = %7%, channelCount = %8)",
+                        " roomScale = %7%, channelCount = %8,"
+                        " isEconomy = %9",
                         TOSTRING(isWetOnly), TOSTRING(feedback),
                         TOSTRING(hfDamping), TOSTRING(predelay),
                         TOSTRING(stereoDepth), TOSTRING(wetGain),
-                        TOSTRING(roomScale), TOSTRING(channelCount));
+                        TOSTRING(roomScale), TOSTRING(channelCount),
+                        TOSTRING(isEconomy));
+        prefix += ", linesAreShared = " + TOSTRING(linesAreShared);
 
         /* add information about reverb channels */
         String channelDataAsString;
@@ -864,6 +2457,7 @@ _SoXReverb::_SoXReverb ()
     _ReverbEffectParameterData& effectParameterData =
         TOREFERENCE<_ReverbEffectParameterData>(_effectParameterData);
 
+    effectParameterData.parametersAreKnown = false;
     effectParameterData.isWetOnly    = false;
     effectParameterData.feedback     = 0.0;
     effectParameterData.hfDamping    = 0.0;
@@ -871,8 +2465,18 @@ _SoXReverb::_SoXReverb ()
     effectParameterData.wetGain      = 0.0;
     effectParameterData.predelay     = 0.0;
     effectParameterData.roomScale    = 10.0;
+    effectParameterData.isEconomy    = false;
+    effectParameterData.linesAreShared      = false;
+    effectParameterData.arenaLinesAreShared = false;
     effectParameterData.channelCount = 0;
+    effectParameterData.sampleRateContext =
+        SampleRateContext::forSampleRate(_defaultSampleRate);
     effectParameterData.reverbChannelList.clear();
+    effectParameterData.blockLength  = _blockLength;
+    effectParameterData.isParallel   = false;
+    effectParameterData.currentBuffer    = nullptr;
+    effectParameterData.blockPosition    = 0;
+    effectParameterData.blockSampleCount = 0;
 
     Logging_trace1("<<: %1", toString());
 }
@@ -922,24 +2526,83 @@ void _SoXReverb::setParameters (IN Boolean isWetOnly,
     const Real predelay = cPredelay.forceToInterval(0.0, _maximumPredelay);
     const Real wetDbGain = cWetDbGain.forceToInterval(-10.0, 10.0);
 
+    /* find the state parts depending on the changed parameters */
+    const Real valueList[_reverbParameterCount] = {
+        (isWetOnly ? Real::one : Real::zero), Real{reverberance},
+        Real{hfDamping}, Real{roomScale}, Real{stereoDepth}, predelay,
+        wetDbGain
+    };
+    int changedStateParts = 0;
+
+    for (size_t i = 0;  i < _reverbParameterCount;  i++) {
+        Real& storedValue = effectParameterData.parameterValueList[i];
+
+        if (!effectParameterData.parametersAreKnown
+            || valueList[i] != storedValue) {
+            changedStateParts |= _dependentStatePartsList[i];
+            storedValue = valueList[i];
+        }
+    }
+
+    effectParameterData.parametersAreKnown = true;
+
     /* calculate technical parameters */
     const Real minimumFeedback =  -1 / log(1 - 0.3);
     const Real maximumFeedback =
         (Real{100.0} / (Real{1 - 0.98}.log() * minimumFeedback + 1.0));
 
-    /* set reverb parameters */
-    effectParameterData.isWetOnly   = isWetOnly;
-    effectParameterData.feedback    =
-        Real::one - Real::exp((Real{reverberance} - maximumFeedback)
-                            / (minimumFeedback * maximumFeedback));
-    effectParameterData.hfDamping   = hfDamping / 100.0 * 0.3 + 0.2;
-    effectParameterData.predelay    = predelay;
-    effectParameterData.stereoDepth = stereoDepth / 100.0;
-    effectParameterData.roomScale   = roomScale / 100.0 * 0.9 + 0.1;
-    effectParameterData.wetGain     =
-        SoXAudioHelper::dBToLinear(wetDbGain) * 0.015;
+    /* recalculate only the changed state parts */
+    if (changedStateParts & _reverbStatePart_dryMix) {
+        effectParameterData.isWetOnly = isWetOnly;
+    }
 
-    Logging_trace1("<<: %1", toString());
+    if (changedStateParts & _reverbStatePart_feedback) {
+        effectParameterData.feedback =
+            Real::one - Real::exp((Real{reverberance} - maximumFeedback)
+                                  / (minimumFeedback * maximumFeedback));
+    }
+
+    if (changedStateParts & _reverbStatePart_hfDamping) {
+        effectParameterData.hfDamping = hfDamping / 100.0 * 0.3 + 0.2;
+    }
+
+    if (changedStateParts & _reverbStatePart_wetGain) {
+        effectParameterData.wetGain =
+            SoXAudioHelper::dBToLinear(wetDbGain) * 0.015;
+    }
+
+    /* the delay lines of existing channels are adjusted right away,
+       new channels get them in resize */
+    const SampleRateContext& sampleRateContext =
+        *effectParameterData.sampleRateContext;
+
+    if (changedStateParts & _reverbStatePart_inputDelay) {
+        effectParameterData.predelay = predelay;
+
+        for (_ReverbChannel* reverbChannel
+                 : effectParameterData.reverbChannelList) {
+            reverbChannel->adjustPredelay(sampleRateContext, predelay);
+        }
+    }
+
+    if (changedStateParts & _reverbStatePart_lineDelays) {
+        effectParameterData.stereoDepth = stereoDepth / 100.0;
+        effectParameterData.roomScale   = roomScale / 100.0 * 0.9 + 0.1;
+
+        for (_ReverbChannel* reverbChannel
+                 : effectParameterData.reverbChannelList) {
+            reverbChannel->adjustReverbLineLengths
+                               (sampleRateContext,
+                                effectParameterData.roomScale,
+                                effectParameterData.stereoDepth);
+        }
+
+        _updateBlockLength(effectParameterData);
+    }
+
+    Logging_trace2("<<: changedStateParts = %1, %2",
+                   TOSTRING(Natural{(size_t) changedStateParts}),
+                   toString());
 }
 
 /*--------------------*/
@@ -953,11 +2616,29 @@ void _SoXReverb::resize (IN Real sampleRate,
     _ReverbEffectParameterData& effectParameterData =
         TOREFERENCE<_ReverbEffectParameterData>(_effectParameterData);
 
-    effectParameterData.channelCount = channelCount;
     _ReverbChannelList& reverbChannelList =
         effectParameterData.reverbChannelList;
-
     const Natural oldChannelCount = reverbChannelList.size();
+    const Boolean linesAreShared = effectParameterData.linesAreShared;
+    const Boolean sampleRateIsKept =
+        (sampleRate == effectParameterData.sampleRateContext->sampleRate());
+    const Boolean storageIsValid =
+        (sampleRateIsKept
+         && channelCount == oldChannelCount
+         && linesAreShared == effectParameterData.arenaLinesAreShared);
+    effectParameterData.channelCount = channelCount;
+
+    if (!sampleRateIsKept) {
+        effectParameterData.sampleRateContext =
+            SampleRateContext::forSampleRate(sampleRate);
+    }
+
+    /* the delay length table is made here (if not yet done by
+       another reverb at this rate), hence later parameter changes
+       on the audio thread do not allocate */
+    const SampleRateContext& sampleRateContext =
+        *effectParameterData.sampleRateContext;
+    sampleRateContext.table(_delayLengthTableKind);
 
     /* get rid of extraneous channels */
     for (Natural channel = channelCount;
@@ -973,69 +2654,274 @@ void _SoXReverb::resize (IN Real sampleRate,
         reverbChannelList[channel] = new _ReverbChannel();
     }
 
+    if (!storageIsValid) {
+        /* carve the delay lines of all channels out of a single
+           arena sized for the maximum parameter values, hence
+           parameter changes only adapt the delay lengths */
+        const Natural channelStorageLength =
+            _ReverbChannel::storageLength(sampleRateContext,
+                                          linesAreShared);
+        _DelayLineSampleList arena;
+        arena.setLength(channelCount * channelStorageLength);
+
+        for (Natural channel = 0;  channel < channelCount;  channel++) {
+            DelayLineSample* storage =
+                arena.asArray(channel * channelStorageLength);
+            reverbChannelList[channel]->setStorage(storage,
+                                                   sampleRateContext,
+                                                   linesAreShared);
+        }
+
+        /* the old arena is released when leaving this block */
+        effectParameterData.delayLineArena.swap(arena);
+        effectParameterData.arenaLinesAreShared = linesAreShared;
+    }
+
     for (_ReverbChannel* reverbChannel : reverbChannelList) {
+        reverbChannel->setQuality(effectParameterData.isEconomy);
         reverbChannel->adjustRingBufferLengths
-                           (sampleRate,
+                           (sampleRateContext,
                             effectParameterData.predelay,
                             effectParameterData.roomScale,
                             effectParameterData.stereoDepth);
     }
 
+    _updateBlockLength(effectParameterData);
+    effectParameterData.wetBuffer.setLength(Natural{2} * channelCount);
+    effectParameterData.wetBuffer.setFrameCount(_blockLength);
+
     Logging_trace("<<");
 }
 
 /*--------------------*/
 
-void _SoXReverb::apply (IN AudioSampleRingBuffer& inputSampleList,
-                        OUT AudioSampleRingBuffer& outputSampleList)
+void _SoXReverb::clear ()
 {
     Logging_trace(">>");
 
     _ReverbEffectParameterData& effectParameterData =
         TOREFERENCE<_ReverbEffectParameterData>(_effectParameterData);
 
-    AudioSample inputSample;
-    _ReverbChannelList& reverbChannelList =
-        effectParameterData.reverbChannelList;
+    /* adjusting the delay lines to their current lengths clears
+       them */
+    for (_ReverbChannel* reverbChannel
+             : effectParameterData.reverbChannelList) {
+        reverbChannel->adjustRingBufferLengths
+                           (*effectParameterData.sampleRateContext,
+                            effectParameterData.predelay,
+                            effectParameterData.roomScale,
+                            effectParameterData.stereoDepth);
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void _SoXReverb::setQuality (IN Boolean isEconomy)
+{
+    Logging_trace1(">>: %1", TOSTRING(isEconomy));
+
+    _ReverbEffectParameterData& effectParameterData =
+        TOREFERENCE<_ReverbEffectParameterData>(_effectParameterData);
+    effectParameterData.isEconomy = isEconomy;
+
+    for (_ReverbChannel* reverbChannel
+             : effectParameterData.reverbChannelList) {
+        reverbChannel->setQuality(isEconomy);
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void _SoXReverb::setLinesAreShared (IN Boolean linesAreShared)
+{
+    Logging_trace1(">>: %1", TOSTRING(linesAreShared));
+
+    _ReverbEffectParameterData& effectParameterData =
+        TOREFERENCE<_ReverbEffectParameterData>(_effectParameterData);
+    effectParameterData.linesAreShared = linesAreShared;
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+Real _SoXReverb::tailLength () const
+{
+    Logging_trace(">>");
+
+    _ReverbEffectParameterData& effectParameterData =
+        TOREFERENCE<_ReverbEffectParameterData>(_effectParameterData);
+    const SampleRateContext& sampleRateContext =
+        *effectParameterData.sampleRateContext;
+    const Real sampleRate  = sampleRateContext.sampleRate();
+    const Real roomScale   = effectParameterData.roomScale;
+    const Real stereoDepth = effectParameterData.stereoDepth;
+
+    /* the comb filters loop with the feedback factor (damping only
+       reduces it), the longest one decays slowest; in economy
+       quality the optional filters do not contribute */
+    const Boolean isEconomy = effectParameterData.isEconomy;
+    Natural combFilterLength = 0;
+
+    for (Natural i = 0;  i < _lineCombFilterCount;  i++) {
+        if (!isEconomy || !_isOptionalFilter(i)) {
+            const Natural length =
+                _adjustedReverbLineDelayLength(true, i, sampleRateContext,
+                                               roomScale, stereoDepth);
+            combFilterLength = Natural::maximum(combFilterLength, length);
+        }
+    }
+
+    Real result =
+        (effectParameterData.predelay
+         + SoXAudioHelper::decayTime(effectParameterData.feedback,
+                                     Real{combFilterLength} / sampleRate));
+
+    /* the allpass filters are in series and add their decay */
+    for (Natural i = 0;  i < _lineAllpassFilterCount;  i++) {
+        if (!isEconomy || !_isOptionalFilter(i)) {
+            const Natural allpassFilterLength =
+                _adjustedReverbLineDelayLength(false, i, sampleRateContext,
+                                               roomScale, stereoDepth);
+            result += SoXAudioHelper::decayTime(_allpassFactor,
+                                                (Real{allpassFilterLength}
+                                                 / sampleRate));
+        }
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(result));
+    return result;
+}
+
+/*--------------------*/
+
+SoXMemoryFootprint _SoXReverb::memoryFootprint () const
+{
+    using FP = SoXMemoryFootprint;
+
+    _ReverbEffectParameterData& effectParameterData =
+        TOREFERENCE<_ReverbEffectParameterData>(_effectParameterData);
+    SoXMemoryFootprint result{};
+    result.delayLineByteCount =
+        FP::listByteCount(effectParameterData.delayLineArena);
+    result.descriptorByteCount =
+        (Natural{sizeof(_ReverbEffectParameterData)}
+         + FP::listByteCount(effectParameterData.reverbChannelList)
+         + FP::listByteCount(effectParameterData.wetBuffer));
+
+    for (const _ReverbChannel* reverbChannel
+             : effectParameterData.reverbChannelList) {
+        result.descriptorByteCount += reverbChannel->byteCount();
+    }
+
+    for (const AudioSampleList& sampleList
+             : effectParameterData.wetBuffer) {
+        result.descriptorByteCount += FP::listByteCount(sampleList);
+    }
+
+    return result;
+}
+
+/*--------------------*/
+
+void _SoXReverb::setParallelProcessing (IN Boolean isParallel)
+{
+    Logging_trace1(">>: %1", TOSTRING(isParallel));
+
+    _ReverbEffectParameterData& effectParameterData =
+        TOREFERENCE<_ReverbEffectParameterData>(_effectParameterData);
+    effectParameterData.isParallel = isParallel;
+
+    if (isParallel) {
+        /* a stereo reverb needs a single worker besides the audio
+           thread */
+        const Natural channelCount =
+            Natural::maximum(effectParameterData.channelCount, 2);
+        SoXWorkerPool& pool = SoXWorkerPool::instance();
+        pool.reserveThreads(SoXWorkerPool::suggestedThreadCount(channelCount));
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void _SoXReverb::apply (INOUT AudioSampleListVector& buffer)
+{
+    const Natural sampleCount = buffer.frameCount();
+    Logging_trace1(">>: sampleCount = %1", TOSTRING(sampleCount));
+
+    _ReverbEffectParameterData& effectParameterData =
+        TOREFERENCE<_ReverbEffectParameterData>(_effectParameterData);
+
+    AudioSampleListVector& wetBuffer = effectParameterData.wetBuffer;
     const Natural channelCount = effectParameterData.channelCount;
-    GenericTuple<_SamplePair, _maxChannelCount> wetSamplePairList;
-
-    /* when stereo depth is non-zero for a reverb, each reverb channel
-       produces a pair of output samples to be stored in a list of wet
-       result pairs */
-    for (Natural channel = 0;  channel < channelCount;  channel++) {
-        /* collect all wet sample pairs */
-        _SamplePair& wetSamplePair = wetSamplePairList[channel];
-        _ReverbChannel* reverbChannel = reverbChannelList[channel];
-        inputSample = inputSampleList[channel];
-        reverbChannel->apply(inputSample,
-                             effectParameterData.feedback,
-                             effectParameterData.hfDamping,
-                             effectParameterData.wetGain,
-                             wetSamplePair);
-    }
-
-    /* combine wet sample pairs with input samples */
-    const Boolean hasMultipleLines =
-        (effectParameterData.stereoDepth > 0.0 && channelCount == 2);
-
-    for (Natural channel = 0;  channel < channelCount;  channel++) {
-        _SamplePair& wetSamplePair = wetSamplePairList[channel];
-        AudioSample outputSample;
-
-        if (!hasMultipleLines) {
-            outputSample = wetSamplePair[0];
+    const Natural blockLength  = effectParameterData.blockLength;
+    const Boolean hasMultipleLines = (effectParameterData.stereoDepth > 0.0);
+    effectParameterData.currentBuffer = &buffer;
+
+    for (Natural position = 0;  position < sampleCount;
+         position += blockLength) {
+        const Natural count =
+            Natural::minimum(blockLength, sampleCount - position);
+
+        /* when stereo depth is non-zero for a reverb, each reverb
+           channel produces a pair of output blocks to be stored in
+           the wet buffer; the channels are independent until the
+           final mix */
+        effectParameterData.blockPosition    = position;
+        effectParameterData.blockSampleCount = count;
+
+        if (effectParameterData.isParallel) {
+            SoXWorkerPool::instance().run(_applyReverbChannel,
+                                          &effectParameterData,
+                                          channelCount, count);
         } else {
-            const _SamplePair& otherWetSamplePair =
-                wetSamplePairList[Natural{1} - channel];
-            outputSample = (wetSamplePair[channel]
-                            + otherWetSamplePair[channel]) / 2.0;
+            for (Natural channel = 0;  channel < channelCount;
+                 channel++) {
+                _applyReverbChannel(&effectParameterData, channel);
+            }
         }
 
-        inputSample  = inputSampleList[channel];
-        outputSample += (effectParameterData.isWetOnly ? 0.0
-                         : inputSample);
-        outputSampleList[channel] = outputSample;
+        /* combine wet samples with input samples; the channels
+           form stereo pairs (0/1, 2/3, ...) and for multiple lines
+           the wet signal of a paired channel is the mean of the
+           associated lines of both channels in its pair; that mean
+           replaces the wet samples of the line, because no other
+           channel reads them */
+        const Kernels& kernels = Kernels::current();
+        const size_t blockCount = (size_t) count;
+
+        for (Natural channel = 0;  channel < channelCount;  channel++) {
+            double* sampleArray =
+                (double*) buffer[channel].asArray(position);
+            const Natural lineIndex = channel % 2;
+            const Natural otherChannel = channel - lineIndex
+                                         + (Natural{1} - lineIndex);
+            const Boolean isPaired =
+                (hasMultipleLines && otherChannel < channelCount);
+            const Natural wetIndex =
+                Natural{2} * channel + (isPaired ? lineIndex : 0);
+            double* wetArray = (double*) wetBuffer[wetIndex].asArray();
+
+            if (isPaired) {
+                const double* otherWetArray =
+                    (const double*) wetBuffer[Natural{2} * otherChannel
+                                              + lineIndex].asArray();
+                kernels.mixDouble(wetArray, wetArray, otherWetArray,
+                                  blockCount, 0.5, 0.5);
+            }
+
+            if (effectParameterData.isWetOnly) {
+                std::copy(wetArray, wetArray + blockCount, sampleArray);
+            } else {
+                kernels.addDouble(sampleArray, wetArray, blockCount);
+            }
+        }
     }
 
     Logging_trace("<<");
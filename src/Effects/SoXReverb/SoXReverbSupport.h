@@ -16,23 +16,27 @@
 /* IMPORTS */
 /*=========*/
 
-#include "AudioSampleRingBuffer.h"
+#include "AudioSampleListVector.h"
 #include "Object.h"
 #include "Percentage.h"
+#include "SoXMemoryFootprint.h"
 
 /*--------------------*/
 
-using Audio::AudioSampleRingBuffer;
+using Audio::AudioSampleListVector;
 using BaseTypes::Primitives::Object;
 using BaseTypes::Primitives::Percentage;
 using BaseTypes::Primitives::Real;
+using SoXPlugins::Helpers::SoXMemoryFootprint;
 
 /*====================*/
 
 namespace SoXPlugins::Effects::SoXReverb {
 
     /**
-     * A <C>_SoXReverb</C> object models the plain Freeverb algorithm.
+     * A <C>_SoXReverb</C> object models the plain Freeverb algorithm;
+     * in economy quality it uses only every other comb and allpass
+     * filter of each reverb line with a gain compensation.
      */
     struct _SoXReverb {
 
@@ -63,6 +67,13 @@ namespace SoXPlugins::Effects::SoXReverb {
          * Initializes reverb with <C>isWetOnly</C>,
          * <C>reverberance</C>, <C>hfDamping</C>, <C>roomScale</C>,
          * <C>stereoDepth</C>, <C>predelay</C> and <C>wetDbGain</C>.
+         * Only the state depending on the parameters changed since
+         * the last call is recalculated: the scalar gains, feedback
+         * and damping are just set, a changed predelay only adjusts
+         * the input delay lines and only a changed room scale or
+         * stereo depth adjusts the filter delay lines (clearing
+         * them); the delay lines of all other parts keep their
+         * contents.
          *
          * @param[in] isWetOnly     information whether direct signal
          *                          should be suppressed in output
@@ -87,7 +98,11 @@ namespace SoXPlugins::Effects::SoXReverb {
 
         /**
          * Sets number of reverb channels to <C>channelCount</C> and the
-         * sample rate to <C>sampleRate</C>.
+         * sample rate to <C>sampleRate</C> and adapts all delay lines
+         * to the current parameters (clearing them); a parameter
+         * change alone does not need a resize.  The delay memory for
+         * maximum predelay, room scale and stereo depth is only
+         * allocated when sample rate or channel count change.
          *
          * @param[in] sampleRate    the new sample rate for this effect
          * @param[in] channelCount  the new channel count for this effect
@@ -98,17 +113,97 @@ namespace SoXPlugins::Effects::SoXReverb {
         /*--------------------*/
 
         /**
-         * Applies this reverb to samples for all channels in
-         * <C>inputSampleList</C> and writes result in
-         * <C>outputSampleList</C>.
+         * Clears the delay lines and filter states of all channels
+         * (e.g. after non-finite samples have entered them) without
+         * reallocating; the reverb tail is lost.
+         */
+        void clear ();
+
+        /*--------------------*/
+
+        /**
+         * Sets quality of reverb to economy when <C>isEconomy</C> is
+         * set and to final render (the exact SoX algorithm)
+         * otherwise; economy quality skips half of the comb and
+         * allpass filters and compensates the gain.  A change is
+         * crossfaded over a short duration without clearing the
+         * reverb tail.
+         *
+         * @param[in] isEconomy  tells whether economy quality is
+         *                       used
+         */
+        void setQuality (IN Boolean isEconomy);
+
+        /*--------------------*/
+
+        /**
+         * Sets whether the two reverb lines of each channel share
+         * their comb filters to <C>linesAreShared</C>; then the
+         * second line reads the comb filter output of the first
+         * through a tap delayed by the stereo spread and only has
+         * its own allpass filters.  This roughly halves the delay
+         * memory and cache footprint at nonzero stereo depth, but is
+         * not equivalent to SoX.  A change takes effect with the
+         * next <C>resize</C>, which reallocates and clears the delay
+         * lines.
+         *
+         * @param[in] linesAreShared  tells whether the reverb lines
+         *                            share their comb filters
+         */
+        void setLinesAreShared (IN Boolean linesAreShared);
+
+        /*--------------------*/
+
+        /**
+         * Sets whether the reverb channels are processed concurrently
+         * on the shared worker pool to <C>isParallel</C>; when set,
+         * the pool is given enough threads for all channels (as far
+         * as the hardware allows).  Blocks too short for the pool
+         * and a pool without threads fall back to serial processing.
+         * Spawns threads, hence must not be called on the audio
+         * thread.
+         *
+         * @param[in] isParallel  tells whether channels are processed
+         *                        concurrently
+         */
+        void setParallelProcessing (IN Boolean isParallel);
+
+        /*--------------------*/
+
+        /**
+         * Returns the time in seconds the output of this reverb
+         * needs to decay below the silence threshold after the input
+         * has become silent: the predelay plus the decay times of
+         * the slowest comb filter and of all allpass filters (as
+         * far as used by the current quality).
+         *
+         * @return  tail length in seconds
+         */
+        Real tailLength () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of bytes this reverb occupies on the
+         * heap: the delay line arena as delay lines and all other
+         * channel data and buffers as descriptor.
+         *
+         * @return  memory footprint of reverb
+         */
+        SoXMemoryFootprint memoryFootprint () const;
+
+        /*--------------------*/
+
+        /**
+         * Applies this reverb in place to the samples of all
+         * channels in <C>buffer</C>; the samples are processed in
+         * blocks bounded by the shortest delay line, such that each
+         * filter handles a complete block at once.
          *
-         * @param[in]  inputSampleList   the queue of samples for all
-         *                               input channels
-         * @param[out] outputSampleList  the queue of samples for all
-         *                               output channels
+         * @param[inout] buffer  the input and output samples of all
+         *                       channels
          */
-        void apply (IN AudioSampleRingBuffer& inputSampleList,
-                    OUT AudioSampleRingBuffer& outputSampleList);
+        void apply (INOUT AudioSampleListVector& buffer);
 
         /*--------------------*/
         /*--------------------*/
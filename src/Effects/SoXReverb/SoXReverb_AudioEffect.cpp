@@ -13,13 +13,17 @@
 /*=========*/
 
 #include "SoXReverb_AudioEffect.h"
+
+#include <utility>
 #include "Logging.h"
 #include "SoXReverbSupport.h"
+#include "SoXWorkerPool.h"
 
 /*--------------------*/
 
 using SoXPlugins::Effects::SoXReverb::_SoXReverb;
 using SoXPlugins::Effects::SoXReverb::SoXReverb_AudioEffect;
+using SoXPlugins::Helpers::SoXWorkerPool;
 
 /** abbreviation for StringUtil */
 using STR = BaseModules::StringUtil;
@@ -32,6 +36,16 @@ namespace SoXPlugins::Effects::SoXReverb {
     static const StringList _yesNoList =
         StringList::makeBySplit("Yes/No", "/");
 
+    /** the possible values of the quality combobox (in English
+     * language) */
+    static const StringList _qualityList =
+        StringList::makeBySplit("Final Render/Economy", "/");
+
+    /** the possible values of the stereo lines combobox (in English
+     * language) */
+    static const StringList _stereoLinesList =
+        StringList::makeBySplit("Separate/Shared", "/");
+
     /*--------------------*/
 
     /**
@@ -65,12 +79,54 @@ namespace SoXPlugins::Effects::SoXReverb {
         /** the gain of the wet signal in decibels */
         Real wetDbGain;
 
+        /** information whether the reverb uses economy quality
+         * instead of the exact SoX algorithm */
+        Boolean isEconomyQuality;
+
+        /** information whether the quality level set by a load
+         * governor demands economy quality */
+        Boolean isEconomyLevel;
+
+        /** information whether the reverb lines of a channel share
+         * their comb filters instead of the exact SoX algorithm */
+        Boolean linesAreShared;
+
         /** the number of channels of this effect */
         Natural channelCount;
 
         /** the internal reverb effect */
         _SoXReverb reverb;
 
+        /** information whether the reverb is processed pipelined on
+         * the worker pool */
+        Boolean isPipelined;
+
+        /** the number of samples in a pipeline block */
+        Natural pipelineBlockLength;
+
+        /** the pipeline block being filled with input samples */
+        AudioSampleListVector pipelineInputBuffer;
+
+        /** the pipeline block processed by the detached task (or
+         * its result) */
+        AudioSampleListVector pipelineTaskBuffer;
+
+        /** the processed pipeline block being delivered as
+         * output */
+        AudioSampleListVector pipelineOutputBuffer;
+
+        /** the number of samples in the input and output pipeline
+         * blocks already exchanged with the host */
+        Natural pipelineFillCount;
+
+        /** the handle of the detached task processing the task
+         * buffer */
+        Natural pipelineTaskHandle;
+
+        /** information whether the detached task has not yet been
+         * completed */
+        Boolean pipelineTaskIsPending;
+
         /*--------------------*/
         /*--------------------*/
 
@@ -86,13 +142,21 @@ namespace SoXPlugins::Effects::SoXReverb {
                             "isWetOnly = %1, reverberance = %2%,"
                             " hfDamping = %3%, roomScale = %4%,"
                             " stereoDepth = %5%, preDelayInMs = %6ms,"
-                            " wetDbGain = %7dB, channelCount = %8,"
-                            " reverb = %9)",
+                            " wetDbGain = %7dB, isEconomyQuality = %8,"
+                            " channelCount = %9, reverb = %A,",
                             TOSTRING(isWetOnly), TOSTRING(reverberance),
                             TOSTRING(hfDamping), TOSTRING(roomScale),
                             TOSTRING(stereoDepth), TOSTRING(preDelayInMs),
-                            TOSTRING(wetDbGain), TOSTRING(channelCount),
-                            reverb.toString());
+                            TOSTRING(wetDbGain),
+                            TOSTRING(isEconomyQuality),
+                            TOSTRING(channelCount), reverb.toString());
+            st += STR::expand(" isEconomyLevel = %1,"
+                              " linesAreShared = %2, isPipelined = %3,"
+                              " pipelineBlockLength = %4)",
+                              TOSTRING(isEconomyLevel),
+                              TOSTRING(linesAreShared),
+                              TOSTRING(isPipelined),
+                              TOSTRING(pipelineBlockLength));
 
             return st;
         }
@@ -126,6 +190,21 @@ namespace SoXPlugins::Effects::SoXReverb {
     /** the name for the wetGain parameter */
     static const String parameterName_wetGain      = "Wet Gain [dB]";
 
+    /** the name for the quality parameter */
+    static const String parameterName_quality      = "Quality";
+
+    /** the name for the stereo lines parameter */
+    static const String parameterName_stereoLines  = "Stereo Lines";
+
+    /** the identifications of the parameters in the parameter map
+     * (in order of definition) */
+    enum _ParameterId {
+        parameterId_isWetOnly, parameterId_reverberance,
+        parameterId_hfDamping, parameterId_roomScale,
+        parameterId_stereoDepth, parameterId_preDelay, parameterId_wetGain,
+        parameterId_quality, parameterId_stereoLines
+    };
+
     /*--------------------*/
     /* internal routines  */
     /*--------------------*/
@@ -148,8 +227,19 @@ namespace SoXPlugins::Effects::SoXReverb {
                 100.0, /* stereoDepth */
                 0.0,   /* preDelayInMs */
                 0.0,   /* wetDbGain */
+                false, /* isEconomyQuality */
+                false, /* isEconomyLevel */
+                false, /* linesAreShared */
                 0,     /* channelCount */
-                {}     /* reverb */
+                {},    /* reverb */
+                false, /* isPipelined */
+                SoXReverb_AudioEffect::defaultPipelineBlockLength,
+                {},    /* pipelineInputBuffer */
+                {},    /* pipelineTaskBuffer */
+                {},    /* pipelineOutputBuffer */
+                0,     /* pipelineFillCount */
+                SoXWorkerPool::completedTaskHandle,
+                false  /* pipelineTaskIsPending */
             };
 
         Logging_trace1("<<: %1", result->toString());
@@ -158,6 +248,64 @@ namespace SoXPlugins::Effects::SoXReverb {
 
     /*--------------------*/
 
+    /**
+     * Returns a parameter map with the definitions of all reverb
+     * parameters; this is done once per process and the map is used
+     * as a prototype for each effect instance.
+     *
+     * @return parameter map with all parameter definitions
+     */
+    static SoXEffectParameterMap _makeParameterMap ()
+    {
+        Logging_trace(">>");
+
+        SoXEffectParameterMap result;
+
+        result.setKindEnum(parameterName_isWetOnly, _yesNoList);
+        result.setKindReal(parameterName_reverberance,
+                           0.0, 100.0, 0.001);
+        result.setKindReal(parameterName_hfDamping,
+                           0.0, 100.0, 0.001);
+        result.setKindReal(parameterName_roomScale,
+                           0.0, 100.0, 0.001);
+        result.setKindReal(parameterName_stereoDepth,
+                           0.0, 100.0, 0.001);
+        result.setKindReal(parameterName_preDelay,
+                           0.0, 500.0, 0.001);
+        result.setKindReal(parameterName_wetGain,
+                           -100.0, 100.0, 0.001);
+        result.setKindEnum(parameterName_quality, _qualityList);
+        result.setKindEnum(parameterName_stereoLines, _stereoLinesList);
+
+        Logging_trace("<<");
+        return result;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Passes the parameters of reverb <C>effectDescriptor</C> to its
+     * reverb, which only recalculates the state depending on the
+     * changed ones (hence automating a gain does not touch the
+     * delay lines).
+     *
+     * @param[inout] effectDescriptor  effect descriptor of reverb
+     */
+    static void
+    _updateParameters (INOUT _EffectDescriptor_RVRB& effectDescriptor)
+    {
+        effectDescriptor.reverb
+            .setParameters(effectDescriptor.isWetOnly,
+                           effectDescriptor.reverberance,
+                           effectDescriptor.hfDamping,
+                           effectDescriptor.roomScale,
+                           effectDescriptor.stereoDepth,
+                           effectDescriptor.preDelayInMs / 1000.0,
+                           effectDescriptor.wetDbGain);
+    }
+
+    /*--------------------*/
+
     /**
      * Recalculates derived parameters in reverb <C>effectDescriptor</C>
      * from other parameters, <C>sampleRate</C> and <C>channelCount</C>.
@@ -177,22 +325,165 @@ namespace SoXPlugins::Effects::SoXReverb {
                        TOSTRING(sampleRate), TOSTRING(channelCount));
 
         _SoXReverb& reverb = effectDescriptor.reverb;
-        reverb.setParameters(effectDescriptor.isWetOnly,
-                             effectDescriptor.reverberance,
-                             effectDescriptor.hfDamping,
-                             effectDescriptor.roomScale,
-                             effectDescriptor.stereoDepth,
-                             effectDescriptor.preDelayInMs / 1000.0,
-                             effectDescriptor.wetDbGain);
+        _updateParameters(effectDescriptor);
+        reverb.setQuality(effectDescriptor.isEconomyQuality
+                          || effectDescriptor.isEconomyLevel);
+        reverb.setLinesAreShared(effectDescriptor.linesAreShared);
         reverb.resize(sampleRate, channelCount);
 
         Logging_trace1("<<: %1", effectDescriptor.toString());
     }
 
+    /*--------------------*/
+
+    /**
+     * Applies the reverb of <C>context</C> to its pipeline task
+     * buffer; used as detached task function for the worker pool.
+     *
+     * @param[inout] context    the reverb effect descriptor
+     * @param[in]    taskIndex  the index of the task (unused)
+     */
+    static void _processPipelineBlock (INOUT void* context,
+                                       IN Natural taskIndex)
+    {
+        _EffectDescriptor_RVRB& effectDescriptor =
+            *static_cast<_EffectDescriptor_RVRB*>(context);
+        effectDescriptor.reverb
+            .apply(effectDescriptor.pipelineTaskBuffer);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Waits for the pending detached task of
+     * <C>effectDescriptor</C> (if any) and makes its result the
+     * output block of the pipeline; a task is only pending at the
+     * start of a pipeline block, hence this may be done early
+     * (e.g. before the reverb settings change).
+     *
+     * @param[inout] effectDescriptor  effect descriptor of reverb
+     */
+    static void
+    _completePipelineTask (INOUT _EffectDescriptor_RVRB& effectDescriptor)
+    {
+        if (effectDescriptor.pipelineTaskIsPending) {
+            SoXWorkerPool::instance()
+                .completeDetachedTask(effectDescriptor.pipelineTaskHandle);
+            std::swap(effectDescriptor.pipelineTaskBuffer,
+                      effectDescriptor.pipelineOutputBuffer);
+            effectDescriptor.pipelineTaskHandle =
+                SoXWorkerPool::completedTaskHandle;
+            effectDescriptor.pipelineTaskIsPending = false;
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Empties the pipeline of <C>effectDescriptor</C> and sets its
+     * blocks to <C>channelCount</C> channels of silence.
+     *
+     * @param[inout] effectDescriptor  effect descriptor of reverb
+     * @param[in]    channelCount      new channel count
+     */
+    static void
+    _resetPipeline (INOUT _EffectDescriptor_RVRB& effectDescriptor,
+                    IN Natural channelCount)
+    {
+        Logging_trace1(">>: %1", TOSTRING(channelCount));
+
+        _completePipelineTask(effectDescriptor);
+        const Natural blockLength = effectDescriptor.pipelineBlockLength;
+
+        for (AudioSampleListVector* buffer
+                 : {&effectDescriptor.pipelineInputBuffer,
+                    &effectDescriptor.pipelineTaskBuffer,
+                    &effectDescriptor.pipelineOutputBuffer}) {
+            buffer->resizeChannels(channelCount, blockLength);
+            buffer->setToZero();
+        }
+
+        effectDescriptor.pipelineFillCount = 0;
+
+        Logging_trace("<<");
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies the reverb of <C>effectDescriptor</C> pipelined to
+     * <C>buffer</C>: the input samples are collected into the
+     * input block of the pipeline and replaced by the samples of
+     * the output block at the same position; each complete input
+     * block is handed to the worker pool and its result becomes the
+     * output block at the start of the next pipeline block, such
+     * that the output is delayed by exactly one pipeline block.
+     *
+     * @param[inout] effectDescriptor  effect descriptor of reverb
+     * @param[inout] buffer            the input and output samples
+     *                                 of all channels
+     */
+    static void
+    _applyPipelined (INOUT _EffectDescriptor_RVRB& effectDescriptor,
+                     INOUT AudioSampleListVector& buffer)
+    {
+        const Natural sampleCount = buffer.frameCount();
+        const Natural channelCount = buffer.size();
+        const Natural blockLength = effectDescriptor.pipelineBlockLength;
+        Natural& fillCount = effectDescriptor.pipelineFillCount;
+
+        for (Natural position = 0;  position < sampleCount;) {
+            if (fillCount == 0) {
+                _completePipelineTask(effectDescriptor);
+            }
+
+            const Natural count =
+                Natural::minimum(blockLength - fillCount,
+                                 sampleCount - position);
+
+            for (Natural channel = 0;  channel < channelCount;
+                 channel++) {
+                AudioSample* sampleArray =
+                    buffer[channel].asArray(position);
+                AudioSample* inputArray =
+                    effectDescriptor.pipelineInputBuffer[channel]
+                    .asArray(fillCount);
+                const AudioSample* outputArray =
+                    effectDescriptor.pipelineOutputBuffer[channel]
+                    .asArray(fillCount);
+
+                for (Natural i = 0;  i < count;  i++) {
+                    inputArray[(size_t) i]  = sampleArray[(size_t) i];
+                    sampleArray[(size_t) i] = outputArray[(size_t) i];
+                }
+            }
+
+            position  += count;
+            fillCount += count;
+
+            if (fillCount == blockLength) {
+                /* the task buffer is free, because its result has
+                   been moved to the output block */
+                std::swap(effectDescriptor.pipelineInputBuffer,
+                          effectDescriptor.pipelineTaskBuffer);
+                effectDescriptor.pipelineTaskHandle =
+                    SoXWorkerPool::instance()
+                    .startDetachedTask(_processPipelineBlock,
+                                       &effectDescriptor);
+                effectDescriptor.pipelineTaskIsPending = true;
+                fillCount = 0;
+            }
+        }
+    }
+
 }
 
 /*============================================================*/
 
+const Natural SoXReverb_AudioEffect::defaultPipelineBlockLength = 512;
+
+/*============================================================*/
+
 /*---------------------*/
 /* setup & destruction */
 /*---------------------*/
@@ -206,23 +497,15 @@ SoXReverb_AudioEffect::SoXReverb_AudioEffect ()
     _EffectDescriptor_RVRB& effectDescriptor =
         TOREFERENCE<_EffectDescriptor_RVRB>(_effectDescriptor);
 
-    /* initialize parameters */
-    _effectParameterMap.clear();
-    _effectParameterMap.setKindEnum(parameterName_isWetOnly, _yesNoList);
-    _effectParameterMap.setKindReal(parameterName_reverberance,
-                                    0.0, 100.0, 0.001);
-    _effectParameterMap.setKindReal(parameterName_hfDamping,
-                                    0.0, 100.0, 0.001);
-    _effectParameterMap.setKindReal(parameterName_roomScale,
-                                    0.0, 100.0, 0.001);
-    _effectParameterMap.setKindReal(parameterName_stereoDepth,
-                                    0.0, 100.0, 0.001);
-    _effectParameterMap.setKindReal(parameterName_preDelay,
-                                    0.0, 500.0, 0.001);
-    _effectParameterMap.setKindReal(parameterName_wetGain,
-                                    -100.0, 100.0, 0.001);
-
-    _updateSettings(effectDescriptor, _sampleRate, _channelCount);
+    /* initialize parameters from the definitions shared by all
+       instances */
+    static const SoXEffectParameterMap parameterMapPrototype =
+        _makeParameterMap();
+    _effectParameterMap = parameterMapPrototype;
+
+    /* without channels no delay lines are allocated, this is done
+       by prepareToPlay */
+    _updateSettings(effectDescriptor, _sampleRate, 0);
 
     Logging_trace1("<<: %1", toString());
 }
@@ -232,7 +515,11 @@ SoXReverb_AudioEffect::SoXReverb_AudioEffect ()
 SoXReverb_AudioEffect::~SoXReverb_AudioEffect ()
 {
     Logging_trace(">>");
-    delete (_EffectDescriptor_RVRB*) _effectDescriptor;
+    _EffectDescriptor_RVRB* effectDescriptor =
+        (_EffectDescriptor_RVRB*) _effectDescriptor;
+    /* a detached task must not outlive its descriptor */
+    _completePipelineTask(*effectDescriptor);
+    delete effectDescriptor;
     Logging_trace("<<");
 }
 
@@ -267,13 +554,79 @@ String SoXReverb_AudioEffect::name() const
     return "SoX Reverb";
 }
 
+/*--------------------*/
+
+Real SoXReverb_AudioEffect::tailLength () const
+{
+    _EffectDescriptor_RVRB& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_RVRB>(_effectDescriptor);
+    return effectDescriptor.reverb.tailLength();
+}
+
+/*--------------------*/
+
+Natural SoXReverb_AudioEffect::latency () const
+{
+    _EffectDescriptor_RVRB& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_RVRB>(_effectDescriptor);
+    return (effectDescriptor.isPipelined
+            ? effectDescriptor.pipelineBlockLength : Natural{0});
+}
+
+/*--------------------*/
+/* memory footprint   */
+/*--------------------*/
+
+SoXMemoryFootprint SoXReverb_AudioEffect::memoryFootprint () const
+{
+    _EffectDescriptor_RVRB& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_RVRB>(_effectDescriptor);
+    SoXMemoryFootprint result = SoXAudioEffect::memoryFootprint();
+    result += effectDescriptor.reverb.memoryFootprint();
+    result.descriptorByteCount += sizeof(_EffectDescriptor_RVRB);
+    return result;
+}
+
+/*--------------------*/
+/* quality level      */
+/*--------------------*/
+
+Natural SoXReverb_AudioEffect::qualityLevelCount () const
+{
+    return 2;
+}
+
+/*--------------------*/
+
+void SoXReverb_AudioEffect::setQualityLevel (IN Natural level)
+{
+    Logging_trace1(">>: %1", TOSTRING(level));
+
+    _EffectDescriptor_RVRB& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_RVRB>(_effectDescriptor);
+    const Boolean isEconomyLevel = (level >= 1);
+
+    if (isEconomyLevel != effectDescriptor.isEconomyLevel) {
+        /* the reverb crossfades between the qualities, but must
+           not change while a detached task uses it */
+        _completePipelineTask(effectDescriptor);
+        effectDescriptor.isEconomyLevel = isEconomyLevel;
+        effectDescriptor.reverb
+            .setQuality(effectDescriptor.isEconomyQuality
+                        || isEconomyLevel);
+    }
+
+    Logging_trace("<<");
+}
+
 /*--------------------*/
 /* parameter change   */
 /*--------------------*/
 
 SoXParameterValueChangeKind
 SoXReverb_AudioEffect::_setValueInternal
-                           (IN String& parameterName,
+                           (IN Natural parameterId,
+                            IN String& parameterName,
                             IN String& value,
                             IN Boolean recalculationIsForced)
 {
@@ -287,24 +640,66 @@ SoXReverb_AudioEffect::_setValueInternal
     SoXParameterValueChangeKind result =
         SoXParameterValueChangeKind::parameterChange;
 
-    if (parameterName == parameterName_isWetOnly) {
-        effectDescriptor.isWetOnly = (value == "Yes");
-    } else if (parameterName == parameterName_reverberance) {
-        effectDescriptor.reverberance = STR::toPercentage(value);
-    } else if (parameterName == parameterName_hfDamping) {
-        effectDescriptor.hfDamping = STR::toPercentage(value);
-    } else if (parameterName == parameterName_roomScale) {
-        effectDescriptor.roomScale = STR::toPercentage(value);
-    } else if (parameterName == parameterName_stereoDepth) {
-        effectDescriptor.stereoDepth = STR::toPercentage(value);
-    } else if (parameterName == parameterName_preDelay) {
-        effectDescriptor.preDelayInMs = STR::toReal(value);
-    } else if (parameterName == parameterName_wetGain) {
-        effectDescriptor.wetDbGain = STR::toReal(value);
+    const Real numericValue = _effectParameterMap.numericValue(parameterId);
+    Boolean isRecalculationNeeded = true;
+
+    /* the reverb must not change while a detached task uses it */
+    _completePipelineTask(effectDescriptor);
+
+    switch ((int) parameterId) {
+        case parameterId_isWetOnly:
+            effectDescriptor.isWetOnly = (value == "Yes");
+            break;
+
+        case parameterId_reverberance:
+            effectDescriptor.reverberance = Percentage{numericValue};
+            break;
+
+        case parameterId_hfDamping:
+            effectDescriptor.hfDamping = Percentage{numericValue};
+            break;
+
+        case parameterId_roomScale:
+            effectDescriptor.roomScale = Percentage{numericValue};
+            break;
+
+        case parameterId_stereoDepth:
+            effectDescriptor.stereoDepth = Percentage{numericValue};
+            break;
+
+        case parameterId_preDelay:
+            effectDescriptor.preDelayInMs = numericValue;
+            break;
+
+        case parameterId_wetGain:
+            effectDescriptor.wetDbGain = numericValue;
+            break;
+
+        case parameterId_quality:
+            /* the reverb crossfades between the qualities, hence
+               its delay lines must not be reset */
+            effectDescriptor.isEconomyQuality = (value == "Economy");
+            effectDescriptor.reverb
+                .setQuality(effectDescriptor.isEconomyQuality
+                            || effectDescriptor.isEconomyLevel);
+            isRecalculationNeeded = false;
+            break;
+
+        case parameterId_stereoLines:
+            /* the delay memory is carved anew, hence this clears the
+               reverb tail */
+            effectDescriptor.linesAreShared = (value == "Shared");
+            _updateSettings(effectDescriptor, _sampleRate,
+                            effectDescriptor.channelCount);
+            isRecalculationNeeded = false;
+            break;
+
+        default:
+            break;
     }
 
-    if (recalculationIsForced) {
-        _updateSettings(effectDescriptor, _sampleRate, _channelCount);
+    if (recalculationIsForced && isRecalculationNeeded) {
+        _updateParameters(effectDescriptor);
     }
 
     Logging_trace1("<<: %1", SoXParameterValueChangeKind_toString(result));
@@ -313,6 +708,20 @@ SoXReverb_AudioEffect::_setValueInternal
 
 /*--------------------*/
 
+void SoXReverb_AudioEffect::recalculateSettings ()
+{
+    Logging_trace(">>");
+
+    _EffectDescriptor_RVRB& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_RVRB>(_effectDescriptor);
+    _completePipelineTask(effectDescriptor);
+    _updateParameters(effectDescriptor);
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
 void SoXReverb_AudioEffect::setDefaultValues ()
 {
     Logging_trace(">>");
@@ -324,19 +733,115 @@ void SoXReverb_AudioEffect::setDefaultValues ()
     _effectParameterMap.setValue(parameterName_stereoDepth,  "100");
     _effectParameterMap.setValue(parameterName_preDelay,     "0");
     _effectParameterMap.setValue(parameterName_wetGain,      "0");
+    _effectParameterMap.setValue(parameterName_quality,      "Final Render");
+    _effectParameterMap.setValue(parameterName_stereoLines,  "Separate");
 
     Logging_trace1("<<: %1", toString());
 }
 
+/*--------------------*/
+/* configuration      */
+/*--------------------*/
+
+void SoXReverb_AudioEffect::setPipelinedProcessing
+                                (IN Boolean isPipelined,
+                                 IN Natural blockLength)
+{
+    Logging_trace2(">>: isPipelined = %1, blockLength = %2",
+                   TOSTRING(isPipelined), TOSTRING(blockLength));
+
+    _EffectDescriptor_RVRB& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_RVRB>(_effectDescriptor);
+    _completePipelineTask(effectDescriptor);
+    effectDescriptor.isPipelined = isPipelined;
+    effectDescriptor.pipelineBlockLength = Natural::maximum(blockLength, 1);
+
+    if (isPipelined) {
+        SoXWorkerPool::instance().reserveThreads(1);
+        _resetPipeline(effectDescriptor, effectDescriptor.channelCount);
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* DSP state          */
+/*--------------------*/
+
+void SoXReverb_AudioEffect::_resetDspState ()
+{
+    Logging_trace(">>");
+
+    _EffectDescriptor_RVRB& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_RVRB>(_effectDescriptor);
+    _completePipelineTask(effectDescriptor);
+    effectDescriptor.reverb.clear();
+
+    if (effectDescriptor.isPipelined) {
+        /* the blocks in flight are just as spoiled */
+        _resetPipeline(effectDescriptor, effectDescriptor.channelCount);
+    }
+
+    Logging_trace("<<");
+}
+
 /*--------------------*/
 /* event handling     */
 /*--------------------*/
 
+void SoXReverb_AudioEffect::prepareToPlay (IN Real sampleRate)
+{
+    Logging_trace1(">>: %1", TOSTRING(sampleRate));
+
+    _EffectDescriptor_RVRB& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_RVRB>(_effectDescriptor);
+    _completePipelineTask(effectDescriptor);
+    SoXAudioEffect::prepareToPlay(sampleRate);
+
+    /* the delay lines are allocated here for the channels known so
+       far (at least stereo), the processing only reallocates when
+       the channel count differs */
+    const Natural channelCount =
+        Natural::maximum(2, Natural::maximum(_channelCount,
+                                             effectDescriptor
+                                             .channelCount));
+    effectDescriptor.channelCount = channelCount;
+    _updateSettings(effectDescriptor, _sampleRate, channelCount);
+
+    if (effectDescriptor.isPipelined) {
+        _resetPipeline(effectDescriptor, channelCount);
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXReverb_AudioEffect::releaseResources ()
+{
+    Logging_trace(">>");
+
+    _EffectDescriptor_RVRB& effectDescriptor =
+        TOREFERENCE<_EffectDescriptor_RVRB>(_effectDescriptor);
+    _completePipelineTask(effectDescriptor);
+    SoXAudioEffect::releaseResources();
+
+    /* the reverb keeps its parameters, but drops its channels
+       together with their delay lines */
+    effectDescriptor.channelCount = 0;
+    effectDescriptor.reverb.resize(_sampleRate, 0);
+    _resetPipeline(effectDescriptor, 0);
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
 void SoXReverb_AudioEffect::processBlock
                                 (IN Real timePosition,
                                  INOUT AudioSampleListVector& buffer)
 {
-    Logging_trace1(">>: time = %1", TOSTRING(timePosition));
+    Logging_traceHot1(">>: time = %1", TOSTRING(timePosition));
 
     SoXAudioEffect::processBlock(timePosition, buffer);
 
@@ -345,32 +850,24 @@ void SoXReverb_AudioEffect::processBlock
         TOREFERENCE<_EffectDescriptor_RVRB>(_effectDescriptor);
 
     if (_channelCount != effectDescriptor.channelCount) {
+        _completePipelineTask(effectDescriptor);
         effectDescriptor.channelCount = _channelCount;
-        _updateSettings(effectDescriptor, _sampleRate, _channelCount);
-    }
+        _updateSettings(effectDescriptor, _sampleRate,
+                        effectDescriptor.channelCount);
 
-    const Natural sampleCount = buffer[0].size();
-    _SoXReverb& reverb = effectDescriptor.reverb;
-    AudioSampleRingBuffer inputSampleList{_channelCount};
-    AudioSampleRingBuffer outputSampleList{_channelCount};
-
-    for (Natural i = 0;  i < sampleCount;  i++) {
-        /* read all channel samples into one list */
-        for (Natural channel = 0;  channel < _channelCount;
-             channel++) {
-            const AudioSampleList& inputList = buffer[channel];
-            inputSampleList[channel] = inputList[i];
+        if (effectDescriptor.isPipelined) {
+            _resetPipeline(effectDescriptor, _channelCount);
         }
+    }
 
-        reverb.apply(inputSampleList, outputSampleList);
-
-        /* write output sample list onto all channels */
-        for (Natural channel = 0;  channel < _channelCount;
-             channel++) {
-            AudioSampleList& outputList = buffer[channel];
-            outputList[i] = outputSampleList[channel];
-        }
+    if (effectDescriptor.isPipelined) {
+        _applyPipelined(effectDescriptor, buffer);
+    } else {
+        _SoXReverb& reverb = effectDescriptor.reverb;
+        reverb.apply(buffer);
     }
 
-    Logging_trace("<<");
+    _guardFiniteness(buffer);
+
+    Logging_traceHot("<<");
 }
@@ -30,9 +30,23 @@ namespace SoXPlugins::Effects::SoXReverb {
     /**
      * A <C>SoXReverb_AudioEffect</C> object models the SoX
      * <B>reverb</B> plugin as a simple reverb implementing the
-     * Freeverb algorithm.
+     * Freeverb algorithm; an economy quality with fewer filters
+     * can be selected for realtime use, while the final render
+     * quality is the exact SoX algorithm.
+     *
+     * In the optional pipelined mode the reverb of a block is
+     * computed as a detached task of the shared worker pool while
+     * the host proceeds and delivered with the next block; the dry
+     * signal is delayed accordingly and one pipeline block is
+     * reported as latency.  The pipeline works on blocks of fixed
+     * length, hence the work is completely taken from the audio
+     * thread when that length equals the block length of the host.
      */
-    struct SoXReverb_AudioEffect : public SoXAudioEffect {
+    struct SoXReverb_AudioEffect final : public SoXAudioEffect {
+
+        /** the default number of samples in a block of the
+         * pipelined mode */
+        static const Natural defaultPipelineBlockLength;
 
         /*---------------------*/
         /* setup & destruction */
@@ -56,16 +70,82 @@ namespace SoXPlugins::Effects::SoXReverb {
 
         String name () const override;
 
+        /*--------------------*/
+
+        Real tailLength () const override;
+
+        /*--------------------*/
+
+        Natural latency () const override;
+
+        /*--------------------*/
+        /* memory footprint   */
+        /*--------------------*/
+
+        SoXMemoryFootprint memoryFootprint () const override;
+
+        /*--------------------*/
+        /* quality level      */
+        /*--------------------*/
+
+        /**
+         * Returns the number of quality levels of the reverb: above
+         * full quality the reverb switches to economy quality
+         * regardless of its quality parameter.
+         *
+         * @return  count of quality levels
+         */
+        Natural qualityLevelCount () const override;
+
+        /*--------------------*/
+
+        void setQualityLevel (IN Natural level) override;
+
         /*--------------------*/
         /* parameter change   */
         /*--------------------*/
 
+        void recalculateSettings () override;
+
+        /*--------------------*/
+
         void setDefaultValues () override;
 
+        /*--------------------*/
+        /* configuration      */
+        /*--------------------*/
+
+        /**
+         * Sets whether the reverb is processed pipelined on the
+         * shared worker pool to <C>isPipelined</C> with blocks of
+         * <C>blockLength</C> samples (which is the latency in that
+         * mode); when set, the pool is given a worker thread (as
+         * far as the hardware allows).  The pipeline starts empty.
+         * Spawns threads and allocates, hence must not be called on
+         * the audio thread.
+         *
+         * @param[in] isPipelined  tells whether the reverb is
+         *                         processed pipelined
+         * @param[in] blockLength  number of samples in a pipeline
+         *                         block
+         */
+        void setPipelinedProcessing
+                 (IN Boolean isPipelined,
+                  IN Natural blockLength = defaultPipelineBlockLength);
+
         /*--------------------*/
         /* event handling     */
         /*--------------------*/
 
+        void prepareToPlay (IN Real sampleRate)
+            override;
+
+        /*--------------------*/
+
+        void releaseResources () override;
+
+        /*--------------------*/
+
         void processBlock (IN Real timePosition,
                            INOUT AudioSampleListVector& buffer)
             override;
@@ -80,8 +160,13 @@ namespace SoXPlugins::Effects::SoXReverb {
 
             /*--------------------*/
 
+            void _resetDspState () override;
+
+            /*--------------------*/
+
             SoXParameterValueChangeKind
-            _setValueInternal (IN String& parameterName,
+            _setValueInternal (IN Natural parameterId,
+                               IN String& parameterName,
                                IN String& value,
                                IN Boolean recalculationIsForced)
                 override;
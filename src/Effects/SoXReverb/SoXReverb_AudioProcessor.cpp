@@ -33,7 +33,7 @@ namespace SoXPlugins::Effects::SoXReverb {
         SoXReverb_AudioProcessor ()
         {
             Logging_initializeWithDefaults("SoXReverb", "SoXPlugins.");
-            _setAssociatedEffect(new SoXReverb_AudioEffect{});
+            _setAssociatedEffect(_makeEffect());
         }
 
         /*--------------------*/
@@ -43,6 +43,15 @@ namespace SoXPlugins::Effects::SoXReverb {
             return String("SoXReverb");
         }
 
+        /*--------------------*/
+
+        protected:
+
+            SoXAudioEffect* _makeEffect () const override
+            {
+                return new SoXReverb_AudioEffect{};
+            }
+
     };
 
 }
@@ -0,0 +1,381 @@
+/**
+ * @file
+ * The <C>SoXEngine</C> body implements the C interface to the SoX
+ * effect engines by wrapping the effects of the offline renderer.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXEngine.h"
+
+#include "DenormalGuard.h"
+#include "Logging.h"
+#include "SoXOfflineRenderer.h"
+
+/*--------------------*/
+
+using Audio::DenormalGuard;
+using SoXPlugins::Effects::SoXAudioEffect;
+using SoXPlugins::Helpers::SoXEffectParameterKind;
+using SoXPlugins::Helpers::SoXEffectParameterMap;
+using SoXPlugins::Helpers::precisionProfileFromString;
+using SoXPlugins::Renderer::SoXOfflineRenderer;
+
+/*====================*/
+
+/**
+ * A <C>SoXEngine_Effect</C> object is an effect together with the
+ * time position of its next block.
+ */
+struct SoXEngine_Effect {
+
+    /** the wrapped effect (owned) */
+    SoXAudioEffect* effect;
+
+    /** the sample rate of the last preparation */
+    Real sampleRate;
+
+    /** the index of the first frame of the next block */
+    Natural framePosition;
+
+};
+
+/*====================*/
+/* PRIVATE FEATURES   */
+/*====================*/
+
+/**
+ * Returns the parameter map of <C>engineEffect</C>.
+ *
+ * @param[in] engineEffect  effect queried
+ * @return  parameter map of effect
+ */
+static SoXEffectParameterMap&
+_parameterMap (IN SoXEngine_Effect* engineEffect)
+{
+    return engineEffect->effect->effectParameterMap();
+}
+
+/*--------------------*/
+
+/**
+ * Returns the time position of the next block of
+ * <C>engineEffect</C> in seconds.
+ *
+ * @param[in] engineEffect  effect queried
+ * @return  time position of next block
+ */
+static Real _timePosition (IN SoXEngine_Effect* engineEffect)
+{
+    return (engineEffect->sampleRate > 0.0
+            ? Real{engineEffect->framePosition} / engineEffect->sampleRate
+            : Real{0.0});
+}
+
+/*--------------------*/
+
+/**
+ * Tells whether <C>value</C> is allowed as numeric value for the
+ * parameter named <C>parameterName</C> in <C>parameterMap</C>.
+ *
+ * @param[in] parameterMap   parameter map of effect
+ * @param[in] parameterName  name of parameter
+ * @param[in] value          numeric value to be checked
+ * @return  information whether value is in range of parameter
+ */
+static Boolean _isInRange (IN SoXEffectParameterMap& parameterMap,
+                           IN String& parameterName,
+                           IN Real value)
+{
+    Boolean result = false;
+    const SoXEffectParameterKind kind =
+        parameterMap.kind(parameterName);
+
+    if (kind == SoXEffectParameterKind::realKind) {
+        Real lowValue;
+        Real highValue;
+        Real delta;
+        parameterMap.valueRangeReal(parameterName,
+                                    lowValue, highValue, delta);
+        result = (lowValue <= value && value <= highValue);
+    } else if (kind == SoXEffectParameterKind::intKind) {
+        Integer lowValue;
+        Integer highValue;
+        Integer delta;
+        parameterMap.valueRangeInt(parameterName,
+                                   lowValue, highValue, delta);
+        result = (Real{lowValue} <= value && value <= Real{highValue}
+                  && Real::floor(value) == value);
+    } else if (kind == SoXEffectParameterKind::enumKind) {
+        StringList valueList;
+        parameterMap.valueRangeEnum(parameterName, valueList);
+        const Natural valueCount{valueList.size()};
+        result = (value >= 0.0 && value < Real{valueCount}
+                  && Real::floor(value) == value);
+    }
+
+    return result;
+}
+
+/*====================*/
+/* PUBLIC FEATURES    */
+/*====================*/
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+SoXEngine_Effect* SoXEngine_createEffect (const char* effectTitle)
+{
+    Logging_trace1(">>: %1",
+                   (effectTitle == nullptr ? "" : effectTitle));
+
+    SoXEngine_Effect* result = nullptr;
+
+    if (effectTitle != nullptr) {
+        SoXAudioEffect* effect =
+            SoXOfflineRenderer::makeEffect(String{effectTitle});
+
+        if (effect != nullptr) {
+            result = new SoXEngine_Effect{effect, 0.0, 0};
+        }
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(result != nullptr));
+    return result;
+}
+
+/*--------------------*/
+
+void SoXEngine_destroyEffect (SoXEngine_Effect* effect)
+{
+    Logging_trace(">>");
+
+    if (effect != nullptr) {
+        effect->effect->releaseResources();
+        delete effect->effect;
+        delete effect;
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* parameters         */
+/*--------------------*/
+
+int SoXEngine_parameterCount (const SoXEngine_Effect* effect)
+{
+    Logging_trace(">>");
+    const int result =
+        (int) _parameterMap(effect).parameterNameList().size();
+    Logging_trace1("<<: %1", TOSTRING(result));
+    return result;
+}
+
+/*--------------------*/
+
+int SoXEngine_parameterId (const SoXEngine_Effect* effect,
+                           const char* parameterName)
+{
+    Logging_trace1(">>: %1",
+                   (parameterName == nullptr ? "" : parameterName));
+
+    int result = -1;
+
+    if (parameterName != nullptr) {
+        const Natural parameterId =
+            _parameterMap(effect).parameterId(String{parameterName});
+
+        if (parameterId != SoXEffectParameterMap::undefinedId) {
+            result = (int) parameterId;
+        }
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(result));
+    return result;
+}
+
+/*--------------------*/
+
+const char* SoXEngine_parameterName (const SoXEngine_Effect* effect,
+                                     int parameterId)
+{
+    Logging_trace1(">>: %1", TOSTRING(parameterId));
+
+    const char* result = "";
+
+    if (parameterId >= 0) {
+        result = _parameterMap(effect).parameterName(parameterId).c_str();
+    }
+
+    Logging_trace1("<<: %1", result);
+    return result;
+}
+
+/*--------------------*/
+
+int SoXEngine_setParameter (SoXEngine_Effect* effect,
+                            int parameterId,
+                            double value)
+{
+    Logging_trace2(">>: parameterId = %1, value = %2",
+                   TOSTRING(parameterId), TOSTRING(value));
+
+    int result = 0;
+
+    if (parameterId >= 0) {
+        const SoXEffectParameterMap& parameterMap =
+            _parameterMap(effect);
+        const String& parameterName =
+            parameterMap.parameterName(parameterId);
+
+        if (parameterName != ""
+            && _isInRange(parameterMap, parameterName, value)) {
+            effect->effect->setNumericValue(parameterId, value, true);
+            result = 1;
+        }
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(result));
+    return result;
+}
+
+/*--------------------*/
+
+int SoXEngine_setParameterText (SoXEngine_Effect* effect,
+                                int parameterId,
+                                const char* value)
+{
+    Logging_trace2(">>: parameterId = %1, value = %2",
+                   TOSTRING(parameterId),
+                   (value == nullptr ? "" : value));
+
+    int result = 0;
+
+    if (parameterId >= 0 && value != nullptr) {
+        SoXEffectParameterMap& parameterMap = _parameterMap(effect);
+        const String parameterName =
+            parameterMap.parameterName(parameterId);
+        const String stringValue{value};
+
+        if (parameterName != ""
+            && parameterMap.isAllowedValue(parameterName,
+                                           stringValue)) {
+            /* make sure that the effect takes over the value even
+               when the map already has it */
+            parameterMap.invalidateValue(parameterName);
+            effect->effect->setValue(parameterName, stringValue, true);
+            result = 1;
+        }
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(result));
+    return result;
+}
+
+/*--------------------*/
+
+int SoXEngine_setPrecisionProfile (SoXEngine_Effect* effect,
+                                   const char* profileName)
+{
+    Logging_trace1(">>: %1", (profileName == nullptr ? "" : profileName));
+
+    SoXPrecisionProfile profile = SoXPrecisionProfile::soxExact;
+    const Boolean isKnown =
+        (profileName != nullptr
+         && precisionProfileFromString(String{profileName}, profile));
+
+    if (isKnown) {
+        effect->effect->setPrecisionProfile(profile);
+    }
+
+    const int result = (isKnown ? 1 : 0);
+    Logging_trace1("<<: %1", TOSTRING(result));
+    return result;
+}
+
+/*--------------------*/
+/* processing         */
+/*--------------------*/
+
+void SoXEngine_prepareToPlay (SoXEngine_Effect* effect,
+                              double sampleRate)
+{
+    Logging_trace1(">>: %1", TOSTRING(sampleRate));
+
+    effect->sampleRate = sampleRate;
+    effect->framePosition = 0;
+    effect->effect->prepareToPlay(sampleRate);
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXEngine_processFloat (SoXEngine_Effect* effect,
+                             float* const* channelArray,
+                             int channelCount,
+                             int frameCount)
+{
+    Logging_trace2(">>: channelCount = %1, frameCount = %2",
+                   TOSTRING(channelCount), TOSTRING(frameCount));
+
+    if (channelCount > 0 && frameCount > 0) {
+        const DenormalGuard denormalGuard{};
+        effect->effect->processFloatBlock(_timePosition(effect),
+                                          channelArray,
+                                          channelCount, frameCount);
+        effect->framePosition += frameCount;
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXEngine_processDouble (SoXEngine_Effect* effect,
+                              double* const* channelArray,
+                              int channelCount,
+                              int frameCount)
+{
+    Logging_trace2(">>: channelCount = %1, frameCount = %2",
+                   TOSTRING(channelCount), TOSTRING(frameCount));
+
+    if (channelCount > 0 && frameCount > 0) {
+        const DenormalGuard denormalGuard{};
+        effect->effect->processDoubleBlock(_timePosition(effect),
+                                           channelArray,
+                                           channelCount, frameCount);
+        effect->framePosition += frameCount;
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* queries            */
+/*--------------------*/
+
+int SoXEngine_latency (const SoXEngine_Effect* effect)
+{
+    Logging_trace(">>");
+    const int result = (int) effect->effect->latency();
+    Logging_trace1("<<: %1", TOSTRING(result));
+    return result;
+}
+
+/*--------------------*/
+
+double SoXEngine_tailLength (const SoXEngine_Effect* effect)
+{
+    Logging_trace(">>");
+    const double result = (double) effect->effect->tailLength();
+    Logging_trace1("<<: %1", TOSTRING(result));
+    return result;
+}
@@ -0,0 +1,255 @@
+/**
+ * @file
+ * The <C>SoXEngine</C> specification defines a C interface to the
+ * SoX effect engines for embedding them into other programs without
+ * JUCE or a plugin wrapper.
+ *
+ * An effect is made by <C>SoXEngine_createEffect</C> from its plugin
+ * or effect name (like "SoXReverb", "SoX Reverb" or a chain like
+ * "SoXFilter > SoXGain") with its default parameters.  Parameters
+ * are addressed by their identification, which is the index in the
+ * parameter list of the effect (from zero up to the parameter count
+ * minus one).  After <C>SoXEngine_prepareToPlay</C> the effect
+ * processes consecutive planar blocks of float or double samples in
+ * place.  An effect object must not be used by several threads at
+ * the same time; different effect objects are independent.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*--------------------*/
+
+#if defined(_WIN32)
+    #if defined(SOXENGINE_IS_EXPORTED)
+        #define SOXENGINE_API __declspec(dllexport)
+    #elif defined(SOXENGINE_IS_IMPORTED)
+        #define SOXENGINE_API __declspec(dllimport)
+    #else
+        #define SOXENGINE_API
+    #endif
+#else
+    #define SOXENGINE_API __attribute__((visibility("default")))
+#endif
+
+/*====================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /** an opaque SoX effect with its processing state */
+    typedef struct SoXEngine_Effect SoXEngine_Effect;
+
+    /*--------------------*/
+    /* con-/destruction   */
+    /*--------------------*/
+
+    /**
+     * Makes a new effect for <C>effectTitle</C> with default
+     * parameters; returns NULL for an unknown title.
+     *
+     * @param[in] effectTitle  plugin or effect name of effect or
+     *                         several of them separated by ">"
+     * @return  new effect or NULL
+     */
+    SOXENGINE_API SoXEngine_Effect*
+    SoXEngine_createEffect (const char* effectTitle);
+
+    /*--------------------*/
+
+    /**
+     * Destroys <C>effect</C> (NULL is ignored).
+     *
+     * @param[inout] effect  effect to be destroyed
+     */
+    SOXENGINE_API void
+    SoXEngine_destroyEffect (SoXEngine_Effect* effect);
+
+    /*--------------------*/
+    /* parameters         */
+    /*--------------------*/
+
+    /**
+     * Returns the number of parameters of <C>effect</C>.
+     *
+     * @param[in] effect  effect queried
+     * @return  number of parameters
+     */
+    SOXENGINE_API int
+    SoXEngine_parameterCount (const SoXEngine_Effect* effect);
+
+    /*--------------------*/
+
+    /**
+     * Returns the identification of parameter named
+     * <C>parameterName</C> of <C>effect</C> or -1 when unknown.
+     *
+     * @param[in] effect         effect queried
+     * @param[in] parameterName  name of parameter
+     * @return  identification of parameter or -1
+     */
+    SOXENGINE_API int
+    SoXEngine_parameterId (const SoXEngine_Effect* effect,
+                           const char* parameterName);
+
+    /*--------------------*/
+
+    /**
+     * Returns the name of the parameter with <C>parameterId</C> of
+     * <C>effect</C> (empty for an unknown identification); the
+     * string stays valid until the effect is destroyed.
+     *
+     * @param[in] effect       effect queried
+     * @param[in] parameterId  identification of parameter
+     * @return  name of parameter
+     */
+    SOXENGINE_API const char*
+    SoXEngine_parameterName (const SoXEngine_Effect* effect,
+                             int parameterId);
+
+    /*--------------------*/
+
+    /**
+     * Sets the parameter with <C>parameterId</C> of <C>effect</C>
+     * to numeric <C>value</C>: the value itself for a real or
+     * integer parameter and the index in the value list for an
+     * enumeration parameter.  Returns 1 when the value has been
+     * set and 0 when the parameter is unknown or the value is out
+     * of its range.
+     *
+     * @param[inout] effect       effect to be changed
+     * @param[in]    parameterId  identification of parameter
+     * @param[in]    value        new numeric value of parameter
+     * @return  1 for success, 0 for failure
+     */
+    SOXENGINE_API int
+    SoXEngine_setParameter (SoXEngine_Effect* effect,
+                            int parameterId,
+                            double value);
+
+    /*--------------------*/
+
+    /**
+     * Sets the parameter with <C>parameterId</C> of <C>effect</C>
+     * to <C>value</C> in the text form of the plugin state (like
+     * "50" or "Final Render").  Returns 1 when the value has been
+     * set and 0 when the parameter is unknown or the value is not
+     * allowed.
+     *
+     * @param[inout] effect       effect to be changed
+     * @param[in]    parameterId  identification of parameter
+     * @param[in]    value        new text value of parameter
+     * @return  1 for success, 0 for failure
+     */
+    SOXENGINE_API int
+    SoXEngine_setParameterText (SoXEngine_Effect* effect,
+                                int parameterId,
+                                const char* value);
+
+    /*--------------------*/
+
+    /**
+     * Sets the precision profile of <C>effect</C> to the profile
+     * named <C>profileName</C> ("soxExact", the default,
+     * "highQuality" or "fast"); must be called before
+     * <C>SoXEngine_prepareToPlay</C> or between blocks on the
+     * processing thread.  Returns 1 when the profile has been set
+     * and 0 when the name is unknown.
+     *
+     * @param[inout] effect       effect to be changed
+     * @param[in]    profileName  name of precision profile
+     * @return  1 for success, 0 for failure
+     */
+    SOXENGINE_API int
+    SoXEngine_setPrecisionProfile (SoXEngine_Effect* effect,
+                                   const char* profileName);
+
+    /*--------------------*/
+    /* processing         */
+    /*--------------------*/
+
+    /**
+     * Prepares <C>effect</C> for processing at <C>sampleRate</C>
+     * and restarts its time position at zero; must be called
+     * before the first block is processed.
+     *
+     * @param[inout] effect      effect to be prepared
+     * @param[in]    sampleRate  sample rate in Hz
+     */
+    SOXENGINE_API void
+    SoXEngine_prepareToPlay (SoXEngine_Effect* effect,
+                             double sampleRate);
+
+    /*--------------------*/
+
+    /**
+     * Processes <C>frameCount</C> frames in the
+     * <C>channelCount</C> float channels of
+     * <C>channelArray</C> in place by <C>effect</C>; the block
+     * follows the previous one in time.
+     *
+     * @param[inout] effect        effect applied
+     * @param[inout] channelArray  array of sample arrays per
+     *                             channel
+     * @param[in]    channelCount  number of channels
+     * @param[in]    frameCount    number of frames per channel
+     */
+    SOXENGINE_API void
+    SoXEngine_processFloat (SoXEngine_Effect* effect,
+                            float* const* channelArray,
+                            int channelCount,
+                            int frameCount);
+
+    /*--------------------*/
+
+    /**
+     * Processes <C>frameCount</C> frames in the
+     * <C>channelCount</C> double channels of
+     * <C>channelArray</C> in place by <C>effect</C>; the block
+     * follows the previous one in time.
+     *
+     * @param[inout] effect        effect applied
+     * @param[inout] channelArray  array of sample arrays per
+     *                             channel
+     * @param[in]    channelCount  number of channels
+     * @param[in]    frameCount    number of frames per channel
+     */
+    SOXENGINE_API void
+    SoXEngine_processDouble (SoXEngine_Effect* effect,
+                             double* const* channelArray,
+                             int channelCount,
+                             int frameCount);
+
+    /*--------------------*/
+    /* queries            */
+    /*--------------------*/
+
+    /**
+     * Returns the latency of <C>effect</C> in frames.
+     *
+     * @param[in] effect  effect queried
+     * @return  latency in frames
+     */
+    SOXENGINE_API int
+    SoXEngine_latency (const SoXEngine_Effect* effect);
+
+    /*--------------------*/
+
+    /**
+     * Returns the length of the tail of <C>effect</C> after the
+     * input has ended in seconds.
+     *
+     * @param[in] effect  effect queried
+     * @return  tail length in seconds
+     */
+    SOXENGINE_API double
+    SoXEngine_tailLength (const SoXEngine_Effect* effect);
+
+#ifdef __cplusplus
+}
+#endif
@@ -17,10 +17,12 @@
 /*=========*/
 
 #include <cmath>
+#include "FastMath.h"
 #include "Real.h"
 
 /*--------------------*/
 
+using BaseTypes::Primitives::FastMath;
 using BaseTypes::Primitives::Real;
 
 /*====================*/
@@ -34,6 +36,43 @@ namespace SoXPlugins::Helpers {
      */
     struct SoXAudioHelper {
 
+        /** the magnitude below which samples are regarded as
+         * silence (-120dB) */
+        static constexpr double silenceThreshold = 1E-6;
+
+        /*--------------------*/
+
+        /**
+         * Returns the time in seconds for the state of a recursion
+         * with factor <C>loopGain</C> applied every
+         * <C>loopDuration</C> seconds to decay from full scale below
+         * <C>silenceThreshold</C>; returns infinity when the
+         * recursion does not decay.
+         *
+         * @param[in] loopGain      the factor applied per loop
+         * @param[in] loopDuration  the duration of a loop in seconds
+         * @return  decay time in seconds
+         */
+        inline static Real decayTime (IN Real loopGain,
+                                      IN Real loopDuration)
+        {
+            const Real magnitude = loopGain.abs();
+            Real result;
+
+            if (magnitude >= Real::one) {
+                result = Real::infinity;
+            } else if (magnitude == Real::zero) {
+                result = loopDuration;
+            } else {
+                result = (loopDuration * Real{silenceThreshold}.log()
+                          / magnitude.log());
+            }
+
+            return result;
+        }
+
+        /*--------------------*/
+
         /**
          * Returns linear factor for <C>dBValue</C> with given
          * <C>quotient</C>.
@@ -49,5 +88,26 @@ namespace SoXPlugins::Helpers {
             return Real::power(10.0, dBValue / quotient);
         }
 
+        /*--------------------*/
+
+        /**
+         * Returns an approximation of the linear factor for
+         * <C>dBValue</C> with given <C>quotient</C> deviating at
+         * most <C>FastMath::dBErrorBound</C> decibels from
+         * <C>dBToLinear</C>; intended for gain stages evaluated per
+         * sample.
+         *
+         * @param[in] dBValue   the decibel value to be converted
+         * @param[in] quotient  the factor to be applied to
+         *                      log value
+         * @return  approximation of linear factor
+         */
+        inline static Real fastDBToLinear (IN Real dBValue,
+                                           IN Real quotient = 20.0)
+        {
+            return Real{FastMath::fastDbToLinear((double) dBValue,
+                                                 (double) quotient)};
+        }
+
     };
 }
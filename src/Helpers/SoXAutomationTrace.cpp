@@ -0,0 +1,462 @@
+/**
+ * @file
+ * The <C>SoXAutomationTrace</C> body implements a compact binary
+ * trace of the parameter changes and processed blocks of an effect
+ * instance together with a recorder filling such a trace on the
+ * audio thread.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXAutomationTrace.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include "Logging.h"
+
+/*--------------------*/
+
+using SoXPlugins::Helpers::SoXAutomationTrace;
+using SoXPlugins::Helpers::SoXAutomationTraceEntry;
+using SoXPlugins::Helpers::SoXAutomationTraceEntryKind;
+using SoXPlugins::Helpers::SoXAutomationTraceRecorder;
+
+/** a list of bytes */
+typedef std::vector<std::uint8_t> _ByteList;
+
+/*====================*/
+
+/** the magic string at the start of a trace file */
+static const char _magicString[] = "SOXTRACE";
+
+/** the length of the magic string */
+static constexpr size_t _magicStringLength = 8;
+
+/** the version of the trace file format */
+static constexpr std::uint32_t _formatVersion = 1;
+
+/** the number of bytes of an entry head (kind and time stamp) */
+static constexpr size_t _entryHeadByteCount = 1 + 8;
+
+/*--------------------*/
+/* auxiliary routines */
+/*--------------------*/
+
+/**
+ * Returns the current time of the steady clock in nanoseconds.
+ *
+ * @return  current time stamp
+ */
+static std::uint64_t _currentTimeStamp ()
+{
+    using namespace std::chrono;
+    const auto duration = steady_clock::now().time_since_epoch();
+    return (std::uint64_t) duration_cast<nanoseconds>(duration).count();
+}
+
+/*--------------------*/
+
+/**
+ * Encodes the lower <C>byteCount</C> bytes of <C>value</C> in
+ * little-endian order at <C>data</C>.
+ *
+ * @param[out] data       address of encoded bytes
+ * @param[in]  value      value to be encoded
+ * @param[in]  byteCount  number of bytes to be encoded
+ */
+static void _encodeUnsigned (OUT std::uint8_t* data,
+                             IN std::uint64_t value,
+                             IN size_t byteCount)
+{
+    for (size_t i = 0;  i < byteCount;  i++) {
+        data[i] = (std::uint8_t) (value >> (8 * i));
+    }
+}
+
+/*--------------------*/
+
+/**
+ * Returns the bit pattern of <C>value</C>.
+ *
+ * @param[in] value  real value
+ * @return  bit pattern as unsigned integer
+ */
+static std::uint64_t _doubleBits (IN double value)
+{
+    std::uint64_t result;
+    std::memcpy(&result, &value, sizeof(result));
+    return result;
+}
+
+/*--------------------*/
+
+/**
+ * Appends the lower <C>byteCount</C> bytes of <C>value</C> in
+ * little-endian order to <C>byteList</C>.
+ *
+ * @param[inout] byteList   list of bytes to be extended
+ * @param[in]    value      value to be encoded
+ * @param[in]    byteCount  number of bytes to be encoded
+ */
+static void _appendUnsigned (INOUT _ByteList& byteList,
+                             IN std::uint64_t value,
+                             IN size_t byteCount)
+{
+    std::uint8_t data[8];
+    _encodeUnsigned(data, value, byteCount);
+    byteList.insert(byteList.end(), data, data + byteCount);
+}
+
+/*--------------------*/
+
+/**
+ * Appends <C>st</C> prefixed by its 16-bit length to
+ * <C>byteList</C>.
+ *
+ * @param[inout] byteList  list of bytes to be extended
+ * @param[in]    st        string to be encoded
+ */
+static void _appendString (INOUT _ByteList& byteList,
+                           IN String& st)
+{
+    const size_t length = std::min(st.length(), (size_t) 0xFFFF);
+    _appendUnsigned(byteList, length, 2);
+    byteList.insert(byteList.end(), st.data(), st.data() + length);
+}
+
+/*--------------------*/
+
+/**
+ * A <C>_ByteReader</C> object reads little-endian numbers and
+ * strings from a list of bytes; reading beyond the end marks the
+ * reader as failed and returns zeros.
+ */
+struct _ByteReader {
+
+    /** the bytes read */
+    const _ByteList& byteList;
+
+    /** the position of the next byte */
+    size_t position;
+
+    /** tells whether some read has failed */
+    Boolean hasFailed;
+
+    /*--------------------*/
+
+    /**
+     * Tells whether all bytes have been read.
+     *
+     * @return  information whether reader is at end
+     */
+    Boolean isAtEnd () const
+    {
+        return (position >= byteList.size());
+    }
+
+    /*--------------------*/
+
+    /**
+     * Reads an unsigned number with <C>byteCount</C> bytes.
+     *
+     * @param[in] byteCount  number of bytes of number
+     * @return  number read
+     */
+    std::uint64_t readUnsigned (IN size_t byteCount)
+    {
+        std::uint64_t result = 0;
+
+        if (position + byteCount > byteList.size()) {
+            hasFailed = true;
+            position = byteList.size();
+        } else {
+            for (size_t i = 0;  i < byteCount;  i++) {
+                result |= (std::uint64_t) byteList[position + i] << (8 * i);
+            }
+
+            position += byteCount;
+        }
+
+        return result;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Reads a real number.
+     *
+     * @return  number read
+     */
+    Real readReal ()
+    {
+        const std::uint64_t bits = readUnsigned(8);
+        double result;
+        std::memcpy(&result, &bits, sizeof(result));
+        return Real{result};
+    }
+
+    /*--------------------*/
+
+    /**
+     * Reads a string prefixed by its 16-bit length.
+     *
+     * @return  string read
+     */
+    String readString ()
+    {
+        const size_t length = (size_t) readUnsigned(2);
+        String result;
+
+        if (position + length > byteList.size()) {
+            hasFailed = true;
+            position = byteList.size();
+        } else {
+            result = String{(const char*) byteList.data() + position,
+                            length};
+            position += length;
+        }
+
+        return result;
+    }
+
+};
+
+/*====================*/
+
+Boolean SoXAutomationTrace::readFromFile (IN String& fileName)
+{
+    Logging_trace1(">>: %1", fileName);
+
+    std::ifstream file{fileName, std::ios::binary};
+    const _ByteList byteList{std::istreambuf_iterator<char>(file),
+                             std::istreambuf_iterator<char>()};
+    _ByteReader reader{byteList, 0, false};
+    Boolean isOkay =
+        (byteList.size() >= _magicStringLength
+         && std::memcmp(byteList.data(), _magicString,
+                        _magicStringLength) == 0);
+
+    parameterNameList.clear();
+    initialValueList.clear();
+    entryList.clear();
+
+    if (isOkay) {
+        reader.position = _magicStringLength;
+        isOkay = (reader.readUnsigned(4) <= _formatVersion);
+    }
+
+    if (isOkay) {
+        effectName   = reader.readString();
+        sampleRate   = reader.readReal();
+        channelCount = Natural{(size_t) reader.readUnsigned(4)};
+        const Natural parameterCount =
+            Natural{(size_t) reader.readUnsigned(4)};
+
+        for (Natural i = 0;  i < parameterCount;  i++) {
+            parameterNameList.append(reader.readString());
+            initialValueList.append(reader.readString());
+        }
+
+        while (!reader.isAtEnd() && !reader.hasFailed) {
+            SoXAutomationTraceEntry entry{};
+            entry.kind =
+                (SoXAutomationTraceEntryKind) reader.readUnsigned(1);
+            entry.timeStamp = reader.readUnsigned(8);
+
+            if (entry.kind == SoXAutomationTraceEntryKind::block) {
+                entry.sampleCount = Natural{(size_t) reader.readUnsigned(4)};
+            } else {
+                entry.parameterId = Natural{(size_t) reader.readUnsigned(2)};
+                entry.recalculationIsForced = (reader.readUnsigned(1) != 0);
+
+                if (entry.kind == SoXAutomationTraceEntryKind::stringValue) {
+                    entry.value = reader.readString();
+                } else {
+                    entry.numericValue = reader.readReal();
+                }
+            }
+
+            entryList.append(entry);
+        }
+
+        isOkay = !reader.hasFailed;
+    }
+
+    Logging_trace2("<<: isOkay = %1, entryCount = %2",
+                   TOSTRING(isOkay), TOSTRING(entryList.length()));
+    return isOkay;
+}
+
+/*====================*/
+
+SoXAutomationTraceRecorder::SoXAutomationTraceRecorder ()
+    : _buffer{},
+      _length{0},
+      _startTimeStamp{0},
+      _isActive{false}
+{
+}
+
+/*--------------------*/
+
+Boolean SoXAutomationTraceRecorder::isActive () const
+{
+    return _isActive;
+}
+
+/*--------------------*/
+
+void SoXAutomationTraceRecorder::start (IN Natural byteCount)
+{
+    Logging_trace1(">>: %1", TOSTRING(byteCount));
+    _buffer.resize((size_t) byteCount);
+    _length = 0;
+    _startTimeStamp = _currentTimeStamp();
+    _isActive = true;
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXAutomationTraceRecorder::stop ()
+{
+    Logging_trace(">>");
+    _buffer.clear();
+    _buffer.shrink_to_fit();
+    _length = 0;
+    _isActive = false;
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXAutomationTraceRecorder::recordBlock (IN Natural sampleCount)
+{
+    if (_hasSpaceFor(_entryHeadByteCount + 4)) {
+        std::uint8_t data[4];
+        _appendHead(SoXAutomationTraceEntryKind::block);
+        _encodeUnsigned(data, (std::uint64_t) sampleCount, 4);
+        _append(data, 4);
+    }
+}
+
+/*--------------------*/
+
+void
+SoXAutomationTraceRecorder::recordValue (IN Natural parameterId,
+                                         IN String& value,
+                                         IN Boolean recalculationIsForced)
+{
+    const size_t length = std::min(value.length(), (size_t) 0xFFFF);
+
+    if (_hasSpaceFor(_entryHeadByteCount + 5 + length)) {
+        std::uint8_t data[5];
+        _appendHead(SoXAutomationTraceEntryKind::stringValue);
+        _encodeUnsigned(data, (std::uint64_t) parameterId, 2);
+        data[2] = (recalculationIsForced ? 1 : 0);
+        _encodeUnsigned(data + 3, length, 2);
+        _append(data, 5);
+        _append(value.data(), length);
+    }
+}
+
+/*--------------------*/
+
+void
+SoXAutomationTraceRecorder::recordNumericValue
+                                (IN Natural parameterId,
+                                 IN Real value,
+                                 IN Boolean recalculationIsForced)
+{
+    if (_hasSpaceFor(_entryHeadByteCount + 11)) {
+        std::uint8_t data[11];
+        _appendHead(SoXAutomationTraceEntryKind::numericValue);
+        _encodeUnsigned(data, (std::uint64_t) parameterId, 2);
+        data[2] = (recalculationIsForced ? 1 : 0);
+        _encodeUnsigned(data + 3, _doubleBits((double) value), 8);
+        _append(data, 11);
+    }
+}
+
+/*--------------------*/
+
+Boolean
+SoXAutomationTraceRecorder::writeToFile
+                                (IN String& fileName,
+                                 IN String& effectName,
+                                 IN Real sampleRate,
+                                 IN Natural channelCount,
+                                 IN StringList& parameterNameList,
+                                 IN StringList& initialValueList) const
+{
+    Logging_trace3(">>: fileName = %1, effect = %2, length = %3",
+                   fileName, effectName, TOSTRING(Natural{_length}));
+
+    _ByteList header;
+    header.insert(header.end(),
+                  _magicString, _magicString + _magicStringLength);
+    _appendUnsigned(header, _formatVersion, 4);
+    _appendString(header, effectName);
+    _appendUnsigned(header, _doubleBits((double) sampleRate), 8);
+    _appendUnsigned(header, (std::uint64_t) channelCount, 4);
+
+    const Natural parameterCount = parameterNameList.length();
+    _appendUnsigned(header, (std::uint64_t) parameterCount, 4);
+
+    for (Natural i = 0;  i < parameterCount;  i++) {
+        _appendString(header, parameterNameList[i]);
+        _appendString(header,
+                      (i < initialValueList.length()
+                       ? initialValueList[i] : String{}));
+    }
+
+    std::ofstream file{fileName, std::ios::binary};
+    file.write((const char*) header.data(), (std::streamsize) header.size());
+    file.write((const char*) _buffer.data(), (std::streamsize) _length);
+    file.close();
+    const Boolean isOkay = !file.fail();
+
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+/* internal routines  */
+/*--------------------*/
+
+Boolean SoXAutomationTraceRecorder::_hasSpaceFor (IN size_t byteCount)
+{
+    /* a full buffer ends the capture, such that the trace does not
+       get holes */
+    _isActive = (_isActive && _length + byteCount <= _buffer.size());
+    return _isActive;
+}
+
+/*--------------------*/
+
+void SoXAutomationTraceRecorder::_append (IN void* data,
+                                          IN size_t byteCount)
+{
+    std::memcpy(_buffer.data() + _length, data, byteCount);
+    _length += byteCount;
+}
+
+/*--------------------*/
+
+void
+SoXAutomationTraceRecorder::_appendHead
+                                (IN SoXAutomationTraceEntryKind kind)
+{
+    std::uint8_t data[_entryHeadByteCount];
+    data[0] = (std::uint8_t) kind;
+    _encodeUnsigned(data + 1, _currentTimeStamp() - _startTimeStamp, 8);
+    _append(data, _entryHeadByteCount);
+}
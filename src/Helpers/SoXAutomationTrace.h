@@ -0,0 +1,304 @@
+/**
+ * @file
+ * The <C>SoXAutomationTrace</C> specification defines a compact
+ * binary trace of the parameter changes and processed blocks of an
+ * effect instance together with a recorder filling such a trace on
+ * the audio thread.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include <cstdint>
+#include <vector>
+#include "GenericList.h"
+#include "MyString.h"
+#include "Natural.h"
+#include "Real.h"
+#include "StringList.h"
+
+/*--------------------*/
+
+using BaseTypes::Containers::StringList;
+using BaseTypes::GenericTypes::GenericList;
+using BaseTypes::Primitives::Boolean;
+using BaseTypes::Primitives::Natural;
+using BaseTypes::Primitives::Real;
+using BaseTypes::Primitives::String;
+
+/*====================*/
+
+namespace SoXPlugins::Helpers {
+
+    /**
+     * The kinds of entries in an automation trace.
+     */
+    enum class SoXAutomationTraceEntryKind : std::uint8_t {
+        block = 1, stringValue = 2, numericValue = 3
+    };
+
+    /*--------------------*/
+
+    /**
+     * A <C>SoXAutomationTraceEntry</C> object is a single entry of
+     * an automation trace: either a block of samples processed by
+     * the effect or a parameter value set in string or numeric
+     * form.
+     */
+    struct SoXAutomationTraceEntry {
+
+        /** the kind of entry */
+        SoXAutomationTraceEntryKind kind;
+
+        /** the time of the entry since the start of the capture in
+         * nanoseconds */
+        std::uint64_t timeStamp;
+
+        /** the number of samples per channel of a block */
+        Natural sampleCount;
+
+        /** the identification of the parameter of a value (an
+         * index into the parameter name list of the trace) */
+        Natural parameterId;
+
+        /** the string value of a string value entry */
+        String value;
+
+        /** the numeric value of a numeric value entry */
+        Real numericValue;
+
+        /** tells whether setting the value forces the
+         * recalculation of the effect */
+        Boolean recalculationIsForced;
+
+    };
+
+    /*--------------------*/
+
+    /** a list of automation trace entries */
+    using SoXAutomationTraceEntryList =
+        GenericList<SoXAutomationTraceEntry>;
+
+    /*====================*/
+
+    /**
+     * A <C>SoXAutomationTrace</C> object is the content of an
+     * automation trace file: the name of the traced effect, the
+     * sample rate and channel count of the processing, the names
+     * of the parameters, their values at the start of the capture
+     * and the sequence of entries in the order seen by the effect.
+     *
+     * The file starts with a magic string and a version, followed
+     * by the header data and the entries; all numbers are stored in
+     * little-endian order and strings are prefixed with their
+     * 16-bit length.
+     */
+    struct SoXAutomationTrace {
+
+        /** the name of the traced effect */
+        String effectName;
+
+        /** the sample rate of the processing */
+        Real sampleRate;
+
+        /** the number of channels processed */
+        Natural channelCount;
+
+        /** the parameter names indexed by the parameter
+         * identifications in the entries */
+        StringList parameterNameList;
+
+        /** the values of the parameters at the start of the
+         * capture (parallel to <C>parameterNameList</C>) */
+        StringList initialValueList;
+
+        /** the entries in order */
+        SoXAutomationTraceEntryList entryList;
+
+        /*--------------------*/
+
+        /**
+         * Reads trace from file named <C>fileName</C> and tells
+         * whether this has been successful.
+         *
+         * @param[in] fileName  name of trace file
+         * @return  information whether file is a readable trace
+         */
+        Boolean readFromFile (IN String& fileName);
+
+    };
+
+    /*====================*/
+
+    /**
+     * A <C>SoXAutomationTraceRecorder</C> object collects the
+     * entries of an automation trace in a byte buffer allocated at
+     * the start of the capture.  Recording is done on the audio
+     * thread only and neither allocates nor locks; when the buffer
+     * is full, the capture stops and the trace is truncated.  The
+     * recorder must only be started and written to a file while no
+     * entries are recorded (like in <C>prepareToPlay</C> and
+     * <C>releaseResources</C>).
+     */
+    struct SoXAutomationTraceRecorder {
+
+        /**
+         * Makes an inactive recorder.
+         */
+        SoXAutomationTraceRecorder ();
+
+        /*--------------------*/
+
+        /**
+         * Tells whether the recorder captures entries.
+         *
+         * @return  information whether capture is active
+         */
+        Boolean isActive () const;
+
+        /*--------------------*/
+
+        /**
+         * Starts a new capture with a buffer of <C>byteCount</C>
+         * bytes; previously recorded entries are discarded.
+         *
+         * @param[in] byteCount  capacity of trace buffer in bytes
+         */
+        void start (IN Natural byteCount);
+
+        /*--------------------*/
+
+        /**
+         * Stops the capture and discards the recorded entries.
+         */
+        void stop ();
+
+        /*--------------------*/
+
+        /**
+         * Records the processing of a block with
+         * <C>sampleCount</C> samples per channel.
+         *
+         * @param[in] sampleCount  number of samples per channel in
+         *                         block
+         */
+        void recordBlock (IN Natural sampleCount);
+
+        /*--------------------*/
+
+        /**
+         * Records the setting of parameter with
+         * <C>parameterId</C> to string <C>value</C>.
+         *
+         * @param[in] parameterId            identification of
+         *                                   parameter
+         * @param[in] value                  new value of parameter
+         * @param[in] recalculationIsForced  tells whether the
+         *                                   recalculation is forced
+         */
+        void recordValue (IN Natural parameterId,
+                          IN String& value,
+                          IN Boolean recalculationIsForced);
+
+        /*--------------------*/
+
+        /**
+         * Records the setting of parameter with
+         * <C>parameterId</C> to numeric <C>value</C>.
+         *
+         * @param[in] parameterId            identification of
+         *                                   parameter
+         * @param[in] value                  new numeric value of
+         *                                   parameter
+         * @param[in] recalculationIsForced  tells whether the
+         *                                   recalculation is forced
+         */
+        void recordNumericValue (IN Natural parameterId,
+                                 IN Real value,
+                                 IN Boolean recalculationIsForced);
+
+        /*--------------------*/
+
+        /**
+         * Writes header data and the recorded entries as a trace
+         * file named <C>fileName</C> and tells whether this has
+         * been successful; the capture continues.
+         *
+         * @param[in] fileName           name of trace file
+         * @param[in] effectName         name of traced effect
+         * @param[in] sampleRate         sample rate of processing
+         * @param[in] channelCount       number of channels
+         * @param[in] parameterNameList  the parameter names indexed
+         *                               by identification
+         * @param[in] initialValueList   the parameter values at the
+         *                               start of the capture
+         * @return  information whether file has been written
+         */
+        Boolean writeToFile (IN String& fileName,
+                             IN String& effectName,
+                             IN Real sampleRate,
+                             IN Natural channelCount,
+                             IN StringList& parameterNameList,
+                             IN StringList& initialValueList) const;
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /**
+             * Tells whether <C>byteCount</C> more bytes fit into
+             * the buffer; otherwise the capture stops.
+             *
+             * @param[in] byteCount  number of bytes to be written
+             * @return  information whether bytes may be written
+             */
+            Boolean _hasSpaceFor (IN size_t byteCount);
+
+            /*--------------------*/
+
+            /**
+             * Appends <C>byteCount</C> bytes at <C>data</C> to the
+             * buffer.
+             *
+             * @param[in] data       address of bytes
+             * @param[in] byteCount  number of bytes
+             */
+            void _append (IN void* data, IN size_t byteCount);
+
+            /*--------------------*/
+
+            /**
+             * Appends the entry head with <C>kind</C> and the
+             * current time stamp to the buffer.
+             *
+             * @param[in] kind  kind of entry
+             */
+            void _appendHead (IN SoXAutomationTraceEntryKind kind);
+
+            /*--------------------*/
+
+            /** the buffer with the encoded entries */
+            std::vector<std::uint8_t> _buffer;
+
+            /** the number of bytes used in the buffer */
+            size_t _length;
+
+            /** the time stamp of the capture start in
+             * nanoseconds */
+            std::uint64_t _startTimeStamp;
+
+            /** tells whether entries are captured */
+            Boolean _isActive;
+
+    };
+
+}
@@ -15,14 +15,21 @@
 
 #include "SoXEffectParameterMap.h"
 
+#include <algorithm>
 #include <cmath>
 #include "Assertion.h"
+#include "GenericMap.h"
+#include "GenericStringHashMap.h"
 #include "Logging.h"
+#include "SoXMemoryFootprint.h"
 
 /*--------------------*/
 
+using BaseTypes::GenericTypes::GenericMap;
+using BaseTypes::GenericTypes::GenericStringHashMap;
 using SoXPlugins::Helpers::SoXEffectParameterKind;
 using SoXPlugins::Helpers::SoXEffectParameterMap;
+using SoXPlugins::Helpers::SoXMemoryFootprint;
 
 namespace Helpers = SoXPlugins::Helpers;
 
@@ -33,10 +40,45 @@ using STR = BaseModules::StringUtil;
 
 static const String rangeListSeparator = "¦";
 
+/** the estimated bytes of a map entry besides key and value (node
+ * links or bucket slots) */
+static const size_t _mapEntryOverhead = 4 * sizeof(void*);
+
 /*--------------------*/
 
 const String SoXEffectParameterMap::unknownValue = "???";
 const String SoXEffectParameterMap::widgetPageSeparator = "#";
+const Natural SoXEffectParameterMap::undefinedId = Natural::maximumValue();
+
+/*--------------------*/
+
+/**
+ * The definitions of all parameters of a parameter map; those do not
+ * change when parameter values are set and hence are shared by copies
+ * of a map.
+ */
+struct SoXEffectParameterMap::_Schema {
+
+    /** the name list of the parameters (indexed by
+     * identification) */
+    StringList parameterNameList;
+
+    /** the mapping from parameter name to value range (encoded as a
+     *  string) */
+    Dictionary parameterNameToValueRangeMap;
+
+    /** the mapping from parameter name to audio parameter kind */
+    GenericMap<String, SoXEffectParameterKind> parameterNameToKindMap;
+
+    /** the mapping from parameter name to its numeric
+     * identification */
+    GenericStringHashMap<Natural> parameterNameToIdMap;
+
+    /** the value lists of the enumeration parameters indexed by
+     * identification (empty for other kinds) */
+    GenericList<StringList> enumValueListList;
+
+};
 
 /*--------------------*/
 /*--------------------*/
@@ -68,33 +110,7 @@ void _adaptRealValueToPrecision (INOUT String& value,
                               (Natural) fractionalDigitCount);
     }
     
-    Logging_trace1("<<: value = %1", value)
-}
-
-/*--------------------*/
-
-/**
- * Adds a new parameter name <C>parameterName</C> to internal lists and
- * clears any existing value, kind and value range settings for it
- * 
- * @param[inout] parameterNameList        list of parameter names in map
- * @param[inout] parameterNameToValueMap  mapping from names to values
- * @param[inout] activeParameterNameSet   set of parameter names considered
- *                                        active
- * @param[in]    parameterName            name of parameter to be added
- */
-void _addToParameterList (INOUT StringList& parameterNameList,
-                          INOUT Dictionary& parameterNameToValueMap,
-                          INOUT StringSet& activeParameterNameSet,
-                          IN String& parameterName)
-{
-    if (!parameterNameList.contains(parameterName)) {
-        parameterNameList.append(parameterName);
-    }
-
-    parameterNameToValueMap[parameterName] =
-        SoXEffectParameterMap::unknownValue;
-    activeParameterNameSet.add(parameterName);
+    Logging_trace1("<<: value = %1", value);
 }
 
 /*--------------------*/
@@ -145,7 +161,7 @@ static void _splitParameterName (IN String parameterName,
  */
 static
 StringList _splitRangeData (IN SoXEffectParameterMap* parameterMap,
-                            IN Dictionary parameterNameToValueRangeMap,
+                            IN Dictionary& parameterNameToValueRangeMap,
                             IN String& parameterName,
                             IN SoXEffectParameterKind kind)
 {
@@ -199,6 +215,13 @@ String Helpers::effectParameterKindToString
 /*--------------------*/
 
 SoXEffectParameterMap::SoXEffectParameterMap ()
+    : _schema{std::make_shared<_Schema>()},
+      _valueList{},
+      _isActiveList{},
+      _numericValueList{},
+      _valueIsStaleList{},
+      _valueIsKnownList{},
+      _sequenceLock{}
 {
     Logging_trace(">>");
     Logging_trace1("<<: %1", toString());
@@ -221,20 +244,18 @@ String SoXEffectParameterMap::toString () const
             map<String, SoXEffectParameterKind>,
             SoXEffectParameterKind,
             effectParameterKindToString
-        >("Map", _parameterNameToKindMap);
+        >("Map", _schema->parameterNameToKindMap);
 
     const String result =
         ("SoXEffectParameterMap("
-         "_parameterNameList = "
-             + _parameterNameList.toString()
-         + ", _parameterNameToValueMap = "
-             + _parameterNameToValueMap.toString()
-         + ", _parameterNameToKindMap = "
+         "parameterNameList = "
+             + _schema->parameterNameList.toString()
+         + ", parameterNameToKindMap = "
              + parameterNameToKindRepr
-         + ", _parameterNameToValueRangeMap = "
-             + _parameterNameToValueRangeMap.toString()
-         + ", _activeParameterNameSet = "
-             + _activeParameterNameSet.toString()
+         + ", parameterNameToValueRangeMap = "
+             + _schema->parameterNameToValueRangeMap.toString()
+         + ", _valueList = " + _valueList.toString()
+         + ", _isActiveList = " + _isActiveList.toString()
          + ")");
 
     return result;
@@ -248,11 +269,12 @@ String SoXEffectParameterMap::toString () const
 void SoXEffectParameterMap::clear()
 {
     Logging_trace(">>");
-    _parameterNameList.clear();
-    _parameterNameToValueMap.clear();
-    _parameterNameToKindMap.clear();
-    _parameterNameToValueRangeMap.clear();
-    _activeParameterNameSet.clear();
+    _schema = std::make_shared<_Schema>();
+    _valueList.clear();
+    _isActiveList.clear();
+    _numericValueList.clear();
+    _valueIsStaleList.clear();
+    _valueIsKnownList.clear();
     Logging_trace("<<");
 }
 
@@ -263,7 +285,7 @@ void SoXEffectParameterMap::clear()
 Boolean SoXEffectParameterMap::contains (IN String& parameterName) const
 {
     Logging_trace(">>");
-    Boolean result = _parameterNameToValueMap.contains(parameterName);
+    Boolean result = _schema->parameterNameToIdMap.contains(parameterName);
     Logging_trace1("<<: %1", result.toString());
     return result;
 }
@@ -273,7 +295,7 @@ Boolean SoXEffectParameterMap::contains (IN String& parameterName) const
 StringList SoXEffectParameterMap::parameterNameList () const
 {
     Logging_trace(">>");
-    const StringList& result = _parameterNameList;
+    const StringList& result = _schema->parameterNameList;
     Logging_trace1("<<: %1", result.toString());
     return result;
 }
@@ -282,7 +304,80 @@ StringList SoXEffectParameterMap::parameterNameList () const
 
 Dictionary SoXEffectParameterMap::parameterNameToValueMap () const
 {
-    return _parameterNameToValueMap;
+    Dictionary result;
+
+    /* values set numerically get their string form only now */
+    for (Natural id = 0;  id < _valueList.size();  id++) {
+        const String& parameterName = _schema->parameterNameList[id];
+        result.set(parameterName,
+                   (_valueIsStaleList[id]
+                    ? valueFromNumericValue(id, _numericValueList[id])
+                    : _valueList[id]));
+    }
+
+    return result;
+}
+
+/*--------------------*/
+
+Natural SoXEffectParameterMap::byteCount () const
+{
+    using FP = SoXMemoryFootprint;
+
+    /* the schema holds each name in the name list and as key in
+       three maps */
+    const _Schema& schema = *_schema;
+    Natural schemaByteCount =
+        (Natural{sizeof(_Schema)}
+         + FP::listByteCount(schema.parameterNameList)
+         + FP::listByteCount(schema.enumValueListList));
+
+    for (Natural id = 0;  id < schema.parameterNameList.size();  id++) {
+        const String& parameterName = schema.parameterNameList[id];
+        schemaByteCount +=
+            (Natural{4} * FP::stringByteCount(parameterName)
+             + Natural{3 * (sizeof(String) + _mapEntryOverhead)
+                       + sizeof(String) + sizeof(Natural)
+                       + sizeof(SoXEffectParameterKind)});
+
+        for (const String& value : schema.enumValueListList[id]) {
+            schemaByteCount +=
+                Natural{sizeof(String)} + FP::stringByteCount(value);
+        }
+    }
+
+    const Natural shareCount{(size_t) std::max(_schema.use_count(), 1L)};
+    Natural result = (schemaByteCount / shareCount
+                      + FP::listByteCount(_valueList)
+                      + FP::listByteCount(_isActiveList)
+                      + FP::listByteCount(_numericValueList)
+                      + FP::listByteCount(_valueIsStaleList)
+                      + FP::listByteCount(_valueIsKnownList));
+
+    for (const String& value : _valueList) {
+        result += FP::stringByteCount(value);
+    }
+
+    return result;
+}
+
+/*--------------------*/
+
+Natural SoXEffectParameterMap::parameterId (IN String& parameterName) const
+{
+    return _schema->parameterNameToIdMap.atWithDefault(parameterName,
+                                                       undefinedId);
+}
+
+/*--------------------*/
+
+const String&
+SoXEffectParameterMap::parameterName (IN Natural parameterId) const
+{
+    static const String emptyString{};
+    const StringList& parameterNameList = _schema->parameterNameList;
+    return (parameterId < parameterNameList.size()
+            ? parameterNameList[parameterId] : emptyString);
 }
 
 /*--------------------*/
@@ -294,10 +389,9 @@ SoXEffectParameterKind SoXEffectParameterMap::kind
     Logging_trace1(">>: %1", parameterName);
 
     SoXEffectParameterKind result;
-    const Boolean isKey = (_parameterNameToKindMap.find(parameterName)
-                           != _parameterNameToKindMap.end());
-    result = (isKey ? _parameterNameToKindMap.at(parameterName)
-              : SoXEffectParameterKind::unknownKind);
+    result = _schema->parameterNameToKindMap
+                 .atWithDefault(parameterName,
+                                SoXEffectParameterKind::unknownKind);
 
     Logging_trace1("<<: %1", effectParameterKindToString(result));
     return result;
@@ -314,9 +408,9 @@ void SoXEffectParameterMap::valueRangeEnum (IN String& parameterName,
     const SoXEffectParameterKind p = kind(parameterName);
 
     if (p == SoXEffectParameterKind::enumKind
-        && _parameterNameToValueRangeMap.contains(parameterName)) {
+        && _schema->parameterNameToValueRangeMap.contains(parameterName)) {
         const String listAsString =
-            _parameterNameToValueRangeMap.at(parameterName);
+            _schema->parameterNameToValueRangeMap.at(parameterName);
         result = StringList::makeBySplit(listAsString,
                                          rangeListSeparator);
     }
@@ -335,7 +429,8 @@ void SoXEffectParameterMap::valueRangeInt (IN String& parameterName,
     Logging_trace1(">>: %1", parameterName);
 
     const StringList rangeValueList =
-        _splitRangeData(this, _parameterNameToValueRangeMap, parameterName,
+        _splitRangeData(this, _schema->parameterNameToValueRangeMap,
+                        parameterName,
                         SoXEffectParameterKind::intKind);
 
     if (rangeValueList.size() != 3) {
@@ -364,7 +459,7 @@ void SoXEffectParameterMap::valueRangeReal (IN String& parameterName,
     Logging_trace1(">>: %1", parameterName);
 
     const StringList rangeValueList =
-        _splitRangeData(this, _parameterNameToValueRangeMap,
+        _splitRangeData(this, _schema->parameterNameToValueRangeMap,
                         parameterName, SoXEffectParameterKind::realKind);
 
     if (rangeValueList.size() != 3) {
@@ -392,11 +487,11 @@ Boolean SoXEffectParameterMap::isAllowedValue (IN String& parameterName,
 
     Boolean isOkay;
 
-    if (!_parameterNameList.contains(parameterName)) {
+    if (!contains(parameterName)) {
         isOkay = false;
     } else {
         const SoXEffectParameterKind kind =
-            _parameterNameToKindMap.at(parameterName);
+            _schema->parameterNameToKindMap.at(parameterName);
 
         if (kind == SoXEffectParameterKind::intKind) {
             isOkay = STR::isInt(value);
@@ -521,12 +616,12 @@ Boolean SoXEffectParameterMap::valueIsDifferent (IN String& parameterName,
                                                  IN String value) const
 {
     Logging_trace2(">>: parameterName = %1, value = %2",
-                   parameterName, TOSTRING(value));
+                   parameterName, value);
 
     Boolean isDifferent;
     const Boolean isRealValue =
         (kind(parameterName) == SoXEffectParameterKind::realKind);
-    String storedValue = _parameterNameToValueMap.at(parameterName);
+    String storedValue = this->value(parameterName);
 
     if (!isRealValue) {
         isDifferent = (storedValue != value);
@@ -553,10 +648,10 @@ void SoXEffectParameterMap::setActiveness (IN String& parameterName,
     Logging_trace2(">>: parameterName = %1, isActive = %2",
                    parameterName, TOSTRING(isActive));
 
-    if (isActive) {
-        _activeParameterNameSet.add(parameterName);
-    } else {
-        _activeParameterNameSet.remove(parameterName);
+    const Natural id = parameterId(parameterName);
+
+    if (id != undefinedId) {
+        _isActiveList[id] = isActive;
     }
 
     Logging_trace("<<");
@@ -567,7 +662,8 @@ void SoXEffectParameterMap::setActiveness (IN String& parameterName,
 Boolean SoXEffectParameterMap::isActive (IN String& parameterName) const
 {
     Logging_trace1(">>: %1", parameterName);
-    Boolean result = _activeParameterNameSet.contains(parameterName);
+    const Natural id = parameterId(parameterName);
+    Boolean result = (id != undefinedId && _isActiveList[id]);
     Logging_trace1("<<: %1", TOSTRING(result));
     return result;
 }
@@ -581,14 +677,8 @@ void SoXEffectParameterMap::setActivenessForNameList
     Logging_trace2(">>: isActive = %1, nameList = %2",
                    TOSTRING(isActive), parameterNameList.toString());
 
-    if (isActive) {
-        for (String parameterName : parameterNameList) {
-            _activeParameterNameSet.add(parameterName);
-        }
-    } else {
-        for (String parameterName : parameterNameList) {
-            _activeParameterNameSet.remove(parameterName);
-        }
+    for (const String& parameterName : parameterNameList) {
+        setActiveness(parameterName, isActive);
     }
     
     Logging_trace("<<");
@@ -600,7 +690,7 @@ void SoXEffectParameterMap::changeActivenessByPage (IN Natural lastPageIndex)
 {
     Logging_trace1(">>: %1", TOSTRING(lastPageIndex));
 
-    for (String& parameterName : _parameterNameList) {
+    for (const String& parameterName : _schema->parameterNameList) {
         String effectiveParameterName;
         Natural pageIndex;
         Integer nominalPageIndex;
@@ -625,16 +715,32 @@ void SoXEffectParameterMap::setValue (IN String& parameterName,
     String adaptedValue = value;
 
     if (isAllowedValue(parameterName, adaptedValue)) {
-        Boolean isRealValue =
-            (kind(parameterName) == SoXEffectParameterKind::realKind);
+        const SoXEffectParameterKind parameterKind = kind(parameterName);
+        const Natural id = parameterId(parameterName);
+        Real numericValue;
+
+        if (parameterKind == SoXEffectParameterKind::enumKind) {
+            StringList valueList;
+            valueRangeEnum(parameterName, valueList);
+            numericValue = Real{valueList.position(value)};
+        } else {
+            /* keep the unrounded value like a direct conversion of
+               the string would */
+            numericValue = STR::toReal(value);
 
-        if (isRealValue) {
-            Real lowValue, highValue, delta;
-            valueRangeReal(parameterName, lowValue, highValue, delta);
-            _adaptRealValueToPrecision(adaptedValue, delta);
+            if (parameterKind == SoXEffectParameterKind::realKind) {
+                Real lowValue, highValue, delta;
+                valueRangeReal(parameterName, lowValue, highValue, delta);
+                _adaptRealValueToPrecision(adaptedValue, delta);
+            }
         }
 
-        _parameterNameToValueMap[parameterName] = adaptedValue;
+        _sequenceLock.beginWrite();
+        _numericValueList[id] = numericValue;
+        _valueList[id] = adaptedValue;
+        _valueIsStaleList[id] = false;
+        _valueIsKnownList[id] = true;
+        _sequenceLock.endWrite();
     }
 
     Logging_trace("<<");
@@ -646,8 +752,14 @@ void SoXEffectParameterMap::invalidateValue (IN String& parameterName)
 {
     Logging_trace1(">>: %1", parameterName);
 
-    if (_parameterNameList.contains(parameterName)) {
-        _parameterNameToValueMap[parameterName] = unknownValue;
+    const Natural id = parameterId(parameterName);
+
+    if (id != undefinedId) {
+        _sequenceLock.beginWrite();
+        _valueList[id] = unknownValue;
+        _valueIsStaleList[id] = false;
+        _valueIsKnownList[id] = false;
+        _sequenceLock.endWrite();
     }
 
     Logging_trace("<<");
@@ -658,12 +770,124 @@ void SoXEffectParameterMap::invalidateValue (IN String& parameterName)
 String SoXEffectParameterMap::value (IN String& parameterName) const
 {
     Logging_trace1(">>: %1", parameterName);
-    String result = _parameterNameToValueMap.atWithDefault(parameterName,
-                                                           unknownValue);
+
+    String result;
+    const Natural id = parameterId(parameterName);
+
+    if (id == undefinedId) {
+        result = unknownValue;
+    } else if (_valueIsStaleList[id]) {
+        result = valueFromNumericValue(id, _numericValueList[id]);
+    } else {
+        result = _valueList[id];
+    }
+
     Logging_trace1("<<: %1", result);
     return result;
 }
 
+/*--------------------*/
+
+Real SoXEffectParameterMap::numericValue (IN Natural parameterId) const
+{
+    Assertion_pre(parameterId < _numericValueList.size(),
+                  "parameter identification must be known");
+    return _numericValueList[parameterId];
+}
+
+/*--------------------*/
+
+void SoXEffectParameterMap::setNumericValue (IN Natural parameterId,
+                                             IN Real value)
+{
+    Assertion_pre(parameterId < _numericValueList.size(),
+                  "parameter identification must be known");
+    _sequenceLock.beginWrite();
+    _numericValueList[parameterId] = value;
+    _valueIsStaleList[parameterId] = true;
+    _valueIsKnownList[parameterId] = true;
+    _sequenceLock.endWrite();
+}
+
+/*--------------------*/
+
+const String& SoXEffectParameterMap::enumValue (IN Natural parameterId)
+    const
+{
+    static const String emptyString{};
+    const StringList& valueList = _schema->enumValueListList[parameterId];
+    const Real index = Real::round(_numericValueList[parameterId]);
+    const Boolean isInRange =
+        (index >= Real::zero && index < Real{Natural{valueList.size()}});
+    return (isInRange ? valueList[(Natural) index] : emptyString);
+}
+
+/*--------------------*/
+/* concurrent access  */
+/*--------------------*/
+
+size_t SoXEffectParameterMap::changeStamp () const
+{
+    return _sequenceLock.beginRead();
+}
+
+/*--------------------*/
+
+
+void SoXEffectParameterMap::readValueSnapshot
+                               (OUT GenericList<Real>& numericValueList,
+                                OUT GenericList<Boolean>& valueIsKnownList)
+    const
+{
+    const Natural parameterCount = _numericValueList.size();
+    numericValueList.setLength(parameterCount);
+    valueIsKnownList.setLength(parameterCount);
+    Boolean isConsistent = false;
+
+    /* the copy only contains plain values, hence a torn copy is
+       harmless and simply discarded */
+    while (!isConsistent) {
+        const size_t sequenceNumber = _sequenceLock.beginRead();
+
+        for (Natural id = 0;  id < parameterCount;  id++) {
+            numericValueList[id] = _numericValueList[id];
+            valueIsKnownList[id] = _valueIsKnownList[id];
+        }
+
+        isConsistent = _sequenceLock.endRead(sequenceNumber);
+    }
+}
+
+/*--------------------*/
+
+String
+SoXEffectParameterMap::valueFromNumericValue (IN Natural parameterId,
+                                              IN Real numericValue) const
+{
+    String result;
+    const String& parameterName = this->parameterName(parameterId);
+    const SoXEffectParameterKind kind = this->kind(parameterName);
+
+    if (kind == SoXEffectParameterKind::enumKind) {
+        const StringList& valueList =
+            _schema->enumValueListList[parameterId];
+        const Real index = Real::round(numericValue);
+        const Boolean isInRange =
+            (index >= Real::zero
+             && index < Real{Natural{valueList.size()}});
+        result = (isInRange ? valueList[(Natural) index] : "");
+    } else if (kind == SoXEffectParameterKind::intKind) {
+        result = TOSTRING(Integer{(int) Real::round(numericValue)});
+    } else {
+        Real lowValue, highValue, delta;
+        valueRangeReal(parameterName, lowValue, highValue, delta);
+        result = TOSTRING(numericValue);
+        _adaptRealValueToPrecision(result, delta);
+    }
+
+    return result;
+}
+
 /*--------------------*/
 /* kind change        */
 /*--------------------*/
@@ -679,15 +903,16 @@ void SoXEffectParameterMap::setKindInt (IN String& parameterName,
                    parameterName, lowValue.toString(),
                    highValue.toString(), delta.toString());
 
-    _addToParameterList(_parameterNameList, _parameterNameToValueMap,
-                        _activeParameterNameSet, parameterName);
-    _parameterNameToKindMap[parameterName] = SoXEffectParameterKind::intKind;
+    _makeSchemaExclusive();
+    _addParameter(parameterName);
+    _schema->parameterNameToKindMap[parameterName] =
+        SoXEffectParameterKind::intKind;
     const String lowValueAsString = lowValue.toString();
     const String rangeAsString =
         (lowValueAsString + rangeListSeparator
          + highValue.toString() + rangeListSeparator
          + delta.toString());
-    _parameterNameToValueRangeMap[parameterName] = rangeAsString;
+    _schema->parameterNameToValueRangeMap[parameterName] = rangeAsString;
     setValue(parameterName, lowValueAsString);
 
     Logging_trace("<<");
@@ -706,16 +931,16 @@ void SoXEffectParameterMap::setKindReal (IN String& parameterName,
                    parameterName, TOSTRING(lowValue),
                    TOSTRING(highValue), TOSTRING(delta));
 
-    _addToParameterList(_parameterNameList, _parameterNameToValueMap,
-                        _activeParameterNameSet, parameterName);
-    _parameterNameToKindMap[parameterName] =
+    _makeSchemaExclusive();
+    _addParameter(parameterName);
+    _schema->parameterNameToKindMap[parameterName] =
         SoXEffectParameterKind::realKind;
     const String lowValueAsString = TOSTRING(lowValue);
     const String rangeAsString =
         (lowValueAsString + rangeListSeparator
          + TOSTRING(highValue) + rangeListSeparator
          + STR::toString(delta, 0, 15, "0", true));
-    _parameterNameToValueRangeMap[parameterName] = rangeAsString;
+    _schema->parameterNameToValueRangeMap[parameterName] = rangeAsString;
     setValue(parameterName, lowValueAsString);
 
     Logging_trace("<<");
@@ -730,11 +955,13 @@ void SoXEffectParameterMap::setKindEnum (IN String& parameterName,
     Logging_trace2(">>: %1, range = %2",
                    parameterName, valueList.toString());
 
-    _addToParameterList(_parameterNameList, _parameterNameToValueMap,
-                        _activeParameterNameSet, parameterName);
-    _parameterNameToKindMap[parameterName] = SoXEffectParameterKind::enumKind;
+    _makeSchemaExclusive();
+    const Natural id = _addParameter(parameterName);
+    _schema->parameterNameToKindMap[parameterName] =
+        SoXEffectParameterKind::enumKind;
     const String rangeAsString = valueList.join(rangeListSeparator);
-    _parameterNameToValueRangeMap[parameterName] = rangeAsString;
+    _schema->parameterNameToValueRangeMap[parameterName] = rangeAsString;
+    _schema->enumValueListList[id] = valueList;
     setValue(parameterName, valueList[0]);
 
     Logging_trace("<<");
@@ -855,3 +1082,43 @@ SoXEffectParameterMap::isPageSelector (IN String parameterName) {
     Logging_trace1("<<: %1", TOSTRING(isPageSelector));
     return isPageSelector;
 }
+
+/*--------------------*/
+/* internal routines  */
+/*--------------------*/
+
+Natural SoXEffectParameterMap::_addParameter (IN String& parameterName)
+{
+    Natural result = parameterId(parameterName);
+
+    /* a new or redefined parameter also counts as a change for
+       the change stamp */
+    _sequenceLock.beginWrite();
+
+    if (result == undefinedId) {
+        result = _valueList.size();
+        _schema->parameterNameToIdMap.set(parameterName, result);
+        _schema->parameterNameList.append(parameterName);
+        _schema->enumValueListList.append(StringList());
+        _valueList.append(unknownValue);
+        _isActiveList.append(true);
+        _numericValueList.append(Real::zero);
+        _valueIsStaleList.append(false);
+        _valueIsKnownList.append(false);
+    }
+
+    _valueList[result] = unknownValue;
+    _valueIsKnownList[result] = false;
+    _isActiveList[result] = true;
+    _sequenceLock.endWrite();
+    return result;
+}
+
+/*--------------------*/
+
+void SoXEffectParameterMap::_makeSchemaExclusive ()
+{
+    if (_schema.use_count() > 1) {
+        _schema = std::make_shared<_Schema>(*_schema);
+    }
+}
@@ -8,6 +8,21 @@
  * Entries can be set to active or inactive to provide a complete list
  * of parameters to audio processors.
  *
+ * Each parameter also gets a numeric identification in order of its
+ * definition and its value is additionally stored in numeric form, so
+ * that effects can dispatch and read values without string
+ * operations.
+ *
+ * The parameter definitions (names, kinds, ranges and
+ * identifications) form a schema that copies of a map share, so
+ * that an effect type defines them only once and each instance
+ * merely holds its current values.
+ *
+ * Value changes are guarded by a sequence lock, such that other
+ * threads (like the editor or the state saving of the host) can
+ * take consistent snapshots of the values while the audio thread
+ * changes them without blocking it.
+ *
  * @author Dr. Thomas Tensi
  * @date   2020-08
  */
@@ -20,14 +35,16 @@
 /* IMPORTS */
 /*=========*/
 
+#include <memory>
 #include "Dictionary.h"
+#include "GenericList.h"
 #include "Real.h"
-#include "StringSet.h"
+#include "SoXSequenceLock.h"
 
 /*--------------------*/
 
 using BaseTypes::Containers::Dictionary;
-using BaseTypes::Containers::StringSet;
+using BaseTypes::GenericTypes::GenericList;
 using BaseTypes::Primitives::Integer;
 using BaseTypes::Primitives::Natural;
 using BaseTypes::Primitives::Real;
@@ -72,6 +89,10 @@ namespace SoXPlugins::Helpers {
          * and widget name */
         static const String widgetPageSeparator;
 
+        /** the identification returned for an unknown parameter
+         * name */
+        static const Natural undefinedId;
+
         /*--------------------*/
         /*--------------------*/
 
@@ -141,6 +162,42 @@ namespace SoXPlugins::Helpers {
 
         /*--------------------*/
 
+        /**
+         * Returns an estimate of the number of bytes allocated on
+         * the heap by this map; the parameter definitions shared by
+         * copies of the map are counted proportionally.
+         *
+         * @return  count of owned bytes
+         */
+        Natural byteCount () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the numeric identification of
+         * <C>parameterName</C>; identifications are assigned in
+         * order of definition starting with zero and stay fixed
+         * until the map is cleared.
+         *
+         * @param[in] parameterName  name of parameter
+         * @return  identification of parameter or
+         *          <C>undefinedId</C> when unknown
+         */
+        Natural parameterId (IN String& parameterName) const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the name of the parameter with identification
+         * <C>parameterId</C>.
+         *
+         * @param[in] parameterId  identification of parameter
+         * @return  name of parameter (empty when unknown)
+         */
+        const String& parameterName (IN Natural parameterId) const;
+
+        /*--------------------*/
+
         /**
          * Returns the parameter kind of <C>parameterName</C>; if
          * parameter name is not in allowed list, unknown is
@@ -376,6 +433,103 @@ namespace SoXPlugins::Helpers {
          */
         String value (IN String& parameterName) const;
 
+        /*--------------------*/
+
+        /**
+         * Gets the numeric form of the value last set for the
+         * parameter with <C>parameterId</C>: the value itself for a
+         * real or integer parameter and the index of the value in
+         * its value list for an enumeration parameter.
+         *
+         * @param[in] parameterId  identification of parameter
+         * @return  numeric value of parameter
+         */
+        Real numericValue (IN Natural parameterId) const;
+
+        /*--------------------*/
+
+        /**
+         * Sets the numeric form of the value for the parameter with
+         * <C>parameterId</C> to <C>value</C> without any string
+         * operation (hence this may be called on the audio thread);
+         * the value must be within the parameter range (and for an
+         * enumeration parameter the index of a value in its list).
+         * The string form is only derived on its next query via
+         * <C>value</C> or <C>parameterNameToValueMap</C>.
+         *
+         * @param[in] parameterId  identification of parameter
+         * @param[in] value        new numeric value of parameter
+         */
+        void setNumericValue (IN Natural parameterId, IN Real value);
+
+        /*--------------------*/
+
+        /**
+         * Returns the current value of the enumeration parameter
+         * with <C>parameterId</C> as a reference into its value list
+         * (so without copying a string); for other parameter kinds
+         * an empty string is returned.
+         *
+         * @param[in] parameterId  identification of parameter
+         * @return  current enumeration value or empty string
+         */
+        const String& enumValue (IN Natural parameterId) const;
+
+        /*--------------------*/
+        /* concurrent access  */
+        /*--------------------*/
+
+        /**
+         * Returns a stamp of the parameter values that changes with
+         * every value change and with every parameter added or
+         * redefined; hence an equal stamp at two points in time
+         * tells that the map has not changed in between.  Like
+         * <C>readValueSnapshot</C> this may be called on any thread
+         * and never blocks the changing thread.
+         *
+         * @return  change stamp of map
+         */
+        size_t changeStamp () const;
+
+        /*--------------------*/
+
+
+        /**
+         * Copies the numeric forms of all parameter values into
+         * <C>numericValueList</C> (indexed by identification) and
+         * tells per parameter in <C>valueIsKnownList</C> whether it
+         * has a value.  The copy is consistent, that is, it never
+         * contains part of a value change: a change overlapping the
+         * copy makes it repeat, but the changing thread is never
+         * blocked.  Hence this may be called on any thread while a
+         * single other thread changes values (but not the kinds of
+         * the parameters); the lists are only allocated when too
+         * short.
+         *
+         * @param[out] numericValueList  numeric values of parameters
+         * @param[out] valueIsKnownList  information per parameter
+         *                               whether it has a value
+         */
+        void readValueSnapshot (OUT GenericList<Real>& numericValueList,
+                                OUT GenericList<Boolean>& valueIsKnownList)
+            const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the string form of the numeric value
+         * <C>numericValue</C> (for example from a value snapshot)
+         * for the parameter with <C>parameterId</C> like
+         * <C>value</C> does; does not access the current values and
+         * hence may be called on any thread.
+         *
+         * @param[in] parameterId   identification of parameter
+         * @param[in] numericValue  numeric value of parameter
+         * @return  value of parameter as a string
+         */
+        String valueFromNumericValue (IN Natural parameterId,
+                                      IN Real numericValue) const;
+
         /*--------------------*/
         /* kind change        */
         /*--------------------*/
@@ -567,23 +721,59 @@ namespace SoXPlugins::Helpers {
 
         private:
 
-            /** the name list of the parameters */
-            StringList _parameterNameList;
-
-            /** the mapping from parameter name to associated
-             * values */
-            Dictionary _parameterNameToValueMap;
-
-            /** the mapping from parameter name to value range
-             *  (encoded as a string) */
-            Dictionary _parameterNameToValueRangeMap;
-
-            /** the mapping from parameter name to audio parameter
-             *  kind */
-            GenericMap<String, SoXEffectParameterKind> _parameterNameToKindMap;
-
-            /** the set of parameter names considered active */
-            StringSet _activeParameterNameSet;
+            /** the type of the parameter definitions shared by
+             * copies of this map */
+            struct _Schema;
+
+            /** the parameter definitions; changing a kind of a map
+             * sharing them makes a private copy first */
+            std::shared_ptr<_Schema> _schema;
+
+            /** the values of the parameters as strings indexed by
+             * identification */
+            StringList _valueList;
+
+            /** tells per identification whether the parameter is
+             * active */
+            GenericList<Boolean> _isActiveList;
+
+            /** the numeric values of the parameters indexed by
+             * identification */
+            GenericList<Real> _numericValueList;
+
+            /** tells per identification whether the numeric value
+             * has been set by <C>setNumericValue</C> and the string
+             * value is outdated */
+            GenericList<Boolean> _valueIsStaleList;
+
+            /** tells per identification whether the parameter has a
+             * value (and not the unknown value) */
+            GenericList<Boolean> _valueIsKnownList;
+
+            /** the sequence lock guarding the value changes for
+             * concurrent snapshots */
+            SoXSequenceLock _sequenceLock;
+
+            /*--------------------*/
+
+            /**
+             * Adds a new parameter name <C>parameterName</C> to the
+             * schema and the value lists and sets its value to
+             * unknown and the parameter to active; a new name gets
+             * the next free identification.
+             *
+             * @param[in] parameterName  name of parameter to be added
+             * @return  identification of parameter
+             */
+            Natural _addParameter (IN String& parameterName);
+
+            /*--------------------*/
+
+            /**
+             * Ensures that the schema is not shared with another map
+             * before it is changed.
+             */
+            void _makeSchemaExclusive ();
 
     };
 
@@ -0,0 +1,340 @@
+/**
+ * @file
+ * The <C>SoXFrequencyResponseCache</C> body implements a thread-safe
+ * store of the filter coefficients of the response curves of an
+ * effect together with their last evaluation for a display.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXFrequencyResponseCache.h"
+
+#include <cmath>
+#include <mutex>
+#include "GenericList.h"
+#include "IIRFilter.h"
+#include "Logging.h"
+#include "SoXMemoryFootprint.h"
+#include "SoXRealtimeGuard.h"
+
+/*--------------------*/
+
+using Audio::IIRFilter;
+using BaseTypes::GenericTypes::GenericList;
+using SoXPlugins::Helpers::SoXFrequencyResponseCache;
+using SoXPlugins::Helpers::SoXMemoryFootprint;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
+
+/*====================*/
+
+namespace SoXPlugins::Helpers {
+
+    /**
+     * A <C>_ResponseCurve</C> object holds the filter sections of a
+     * single response curve and its last evaluation.
+     */
+    struct _ResponseCurve {
+
+        /** the sample rate of the filter sections */
+        Real sampleRate;
+
+        /** the coefficients of all sections (for each section
+         * first the b's, then the a's) */
+        RealList coefficientList;
+
+        /** the order of each section */
+        Natural sectionOrder;
+
+        /** tells whether the evaluation below belongs to the
+         * current coefficients */
+        Boolean isEvaluated;
+
+        /** the frequencies in Hz of the last evaluation */
+        RealList frequencyList;
+
+        /** the magnitudes of the last evaluation */
+        RealList magnitudeList;
+
+        /** the phases of the last evaluation */
+        RealList phaseList;
+
+        /*--------------------*/
+
+        /**
+         * Makes a curve with a flat response.
+         */
+        _ResponseCurve ()
+            : sampleRate{44100.0},
+              coefficientList{},
+              sectionOrder{0},
+              isEvaluated{false},
+              frequencyList{},
+              magnitudeList{},
+              phaseList{}
+        {
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns string representation of curve.
+         *
+         * @return string representation
+         */
+        String toString () const
+        {
+            return STR::expand("_ResponseCurve(sampleRate = %1,"
+                               " sectionOrder = %2,"
+                               " coefficientList = %3,"
+                               " isEvaluated = %4)",
+                               TOSTRING(sampleRate),
+                               TOSTRING(sectionOrder),
+                               coefficientList.toString(),
+                               TOSTRING(isEvaluated));
+        }
+
+        /*--------------------*/
+
+        /**
+         * Tells whether the last evaluation has been done for the
+         * frequencies in <C>otherFrequencyList</C>.
+         *
+         * @param[in] otherFrequencyList  the frequencies in Hz
+         * @return  information whether the cached evaluation fits
+         */
+        Boolean fits (IN RealList& otherFrequencyList) const
+        {
+            const Natural count = frequencyList.length();
+            Boolean result = (isEvaluated
+                              && count == otherFrequencyList.length());
+
+            for (Natural i = 0;  result && i < count;  i++) {
+                result = (frequencyList[i] == otherFrequencyList[i]);
+            }
+
+            return result;
+        }
+
+        /*--------------------*/
+
+        /**
+         * Evaluates the response of the section cascade at the
+         * frequencies in Hz in <C>newFrequencyList</C> and keeps
+         * the result.
+         *
+         * @param[in] newFrequencyList  the frequencies in Hz
+         */
+        void evaluate (IN RealList& newFrequencyList)
+        {
+            const Natural count = newFrequencyList.length();
+            frequencyList = newFrequencyList;
+            magnitudeList.clear();
+            magnitudeList.setLength(count, 1.0);
+            phaseList.clear();
+            phaseList.setLength(count, 0.0);
+
+            /* the filter sections work on frequencies relative to
+               the sample rate */
+            RealList relativeFrequencyList = newFrequencyList;
+            relativeFrequencyList.multiply(Real{1.0} / sampleRate);
+
+            const Natural sectionLength = sectionOrder * 2;
+            const Natural sectionCount =
+                (sectionLength == 0 ? 0
+                 : coefficientList.length() / sectionLength);
+
+            for (Natural section = 0;  section < sectionCount;
+                 section++) {
+                IIRFilter::accumulateFrequencyResponse
+                    (coefficientList.asArray(section * sectionLength),
+                     sectionOrder,
+                     relativeFrequencyList.asArray(), count,
+                     magnitudeList.asArray(), phaseList.asArray());
+            }
+
+            for (Real& phase : phaseList) {
+                phase = std::remainder((double) phase,
+                                       (double) Real::twoPi);
+            }
+
+            isEvaluated = true;
+        }
+
+    };
+
+    /*--------------------*/
+
+    /**
+     * A <C>_CacheDescriptor</C> object holds the curves of a
+     * response cache together with the lock protecting them.
+     */
+    struct _CacheDescriptor {
+
+        /** the lock for all accesses to the curves */
+        std::mutex mutex;
+
+        /** the response curves */
+        GenericList<_ResponseCurve> curveList;
+
+    };
+
+}
+
+/*--------------------*/
+
+using SoXPlugins::Helpers::_CacheDescriptor;
+using SoXPlugins::Helpers::_ResponseCurve;
+
+/** abbreviation for a lock on the cache */
+using _Lock = std::lock_guard<std::mutex>;
+
+/*============================================================*/
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+SoXFrequencyResponseCache::SoXFrequencyResponseCache ()
+{
+    Logging_trace(">>");
+    _descriptor = new _CacheDescriptor();
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+SoXFrequencyResponseCache::~SoXFrequencyResponseCache ()
+{
+    Logging_trace(">>");
+    delete (_CacheDescriptor*) _descriptor;
+    Logging_trace("<<");
+}
+
+/*-----------------------*/
+/* string representation */
+/*-----------------------*/
+
+String SoXFrequencyResponseCache::toString () const
+{
+    _CacheDescriptor& descriptor =
+        TOREFERENCE<_CacheDescriptor>(_descriptor);
+    const _Lock lock{descriptor.mutex};
+    return STR::expand("SoXFrequencyResponseCache(curveCount = %1)",
+                       TOSTRING(descriptor.curveList.length()));
+}
+
+/*--------------------*/
+/* property access    */
+/*--------------------*/
+
+Natural SoXFrequencyResponseCache::curveCount () const
+{
+    _CacheDescriptor& descriptor =
+        TOREFERENCE<_CacheDescriptor>(_descriptor);
+    const _Lock lock{descriptor.mutex};
+    return descriptor.curveList.length();
+}
+
+/*--------------------*/
+
+Natural SoXFrequencyResponseCache::byteCount () const
+{
+    using FP = SoXMemoryFootprint;
+
+    _CacheDescriptor& descriptor =
+        TOREFERENCE<_CacheDescriptor>(_descriptor);
+    const _Lock lock{descriptor.mutex};
+    Natural result = (Natural{sizeof(_CacheDescriptor)}
+                      + FP::listByteCount(descriptor.curveList));
+
+    for (const _ResponseCurve& curve : descriptor.curveList) {
+        result += (FP::listByteCount(curve.coefficientList)
+                   + FP::listByteCount(curve.frequencyList)
+                   + FP::listByteCount(curve.magnitudeList)
+                   + FP::listByteCount(curve.phaseList));
+    }
+
+    return result;
+}
+
+/*--------------------*/
+/* property change    */
+/*--------------------*/
+
+void SoXFrequencyResponseCache::setCurveCount (IN Natural curveCount)
+{
+    Logging_trace1(">>: %1", TOSTRING(curveCount));
+
+    _CacheDescriptor& descriptor =
+        TOREFERENCE<_CacheDescriptor>(_descriptor);
+    const _Lock lock{descriptor.mutex};
+    descriptor.curveList.setLength(curveCount);
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXFrequencyResponseCache::setCurve (IN Natural curveIndex,
+                                          IN Real sampleRate,
+                                          IN RealList& coefficientList,
+                                          IN Natural sectionOrder)
+{
+    Logging_trace4(">>: curveIndex = %1, sampleRate = %2,"
+                   " coefficientList = %3, sectionOrder = %4",
+                   TOSTRING(curveIndex), TOSTRING(sampleRate),
+                   coefficientList.toString(), TOSTRING(sectionOrder));
+
+    _CacheDescriptor& descriptor =
+        TOREFERENCE<_CacheDescriptor>(_descriptor);
+    SoXRealtimeGuard_noteLock("SoXFrequencyResponseCache.setCurve");
+    const _Lock lock{descriptor.mutex};
+    descriptor.curveList.ensureLength(curveIndex + 1);
+    _ResponseCurve& curve = descriptor.curveList[curveIndex];
+    curve.sampleRate      = sampleRate;
+    curve.coefficientList = coefficientList;
+    curve.sectionOrder    = sectionOrder;
+    curve.isEvaluated     = false;
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* evaluation         */
+/*--------------------*/
+
+Boolean SoXFrequencyResponseCache::evaluate (IN Natural curveIndex,
+                                             IN RealList& frequencyList,
+                                             OUT RealList& magnitudeList,
+                                             OUT RealList& phaseList) const
+{
+    Logging_trace2(">>: curveIndex = %1, frequencyCount = %2",
+                   TOSTRING(curveIndex),
+                   TOSTRING(frequencyList.length()));
+
+    _CacheDescriptor& descriptor =
+        TOREFERENCE<_CacheDescriptor>(_descriptor);
+    const _Lock lock{descriptor.mutex};
+    const Boolean result = (curveIndex < descriptor.curveList.length());
+
+    if (result) {
+        _ResponseCurve& curve = descriptor.curveList[curveIndex];
+
+        if (!curve.fits(frequencyList)) {
+            curve.evaluate(frequencyList);
+        }
+
+        magnitudeList = curve.magnitudeList;
+        phaseList     = curve.phaseList;
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(result));
+    return result;
+}
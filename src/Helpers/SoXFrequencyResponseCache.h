@@ -0,0 +1,179 @@
+/**
+ * @file
+ * The <C>SoXFrequencyResponseCache</C> specification defines a
+ * thread-safe store of the filter coefficients of the response
+ * curves of an effect together with their last evaluation for a
+ * display.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "MyString.h"
+#include "Natural.h"
+#include "Object.h"
+#include "Real.h"
+#include "RealList.h"
+
+/*--------------------*/
+
+using BaseTypes::Containers::RealList;
+using BaseTypes::Primitives::Boolean;
+using BaseTypes::Primitives::Natural;
+using BaseTypes::Primitives::Object;
+using BaseTypes::Primitives::Real;
+using BaseTypes::Primitives::String;
+
+/*====================*/
+
+namespace SoXPlugins::Helpers {
+
+    /**
+     * A <C>SoXFrequencyResponseCache</C> object holds the frequency
+     * response curves of an effect (like the response of a filter
+     * or the bands of a crossover) for a display.  Each curve is
+     * given as a cascade of IIR filter sections of the same order;
+     * the effect sets the coefficients of a curve whenever they
+     * change, while a display thread evaluates the curves at its
+     * frequencies by <C>evaluate</C>.
+     *
+     * The evaluation of a curve is kept until its coefficients
+     * change, hence a display asking repeatedly for the same
+     * frequencies just gets a copy.  All operations lock the cache
+     * and may allocate, so they must not be called on the audio
+     * thread; the (costly) evaluation is meant to be done on a
+     * background thread instead of the message thread.
+     */
+    struct SoXFrequencyResponseCache {
+
+        /*--------------------*/
+        /* con-/destruction   */
+        /*--------------------*/
+
+        /**
+         * Makes a cache without curves.
+         */
+        SoXFrequencyResponseCache ();
+
+        /*--------------------*/
+
+        /**
+         * Destroys cache.
+         */
+        ~SoXFrequencyResponseCache ();
+
+        /*--------------------*/
+
+        SoXFrequencyResponseCache (IN SoXFrequencyResponseCache&) = delete;
+
+        /*-----------------------*/
+        /* string representation */
+        /*-----------------------*/
+
+        /**
+         * Returns string representation of cache.
+         *
+         * @return string representation
+         */
+        String toString () const;
+
+        /*--------------------*/
+        /* property access    */
+        /*--------------------*/
+
+        /**
+         * Returns the number of curves in the cache.
+         *
+         * @return  count of curves
+         */
+        Natural curveCount () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of bytes allocated on the heap by the
+         * cache (including its descriptor).
+         *
+         * @return  count of owned bytes
+         */
+        Natural byteCount () const;
+
+        /*--------------------*/
+        /* property change    */
+        /*--------------------*/
+
+        /**
+         * Sets the number of curves in the cache to
+         * <C>curveCount</C>; new curves have a flat response.
+         *
+         * @param[in] curveCount  the new count of curves
+         */
+        void setCurveCount (IN Natural curveCount);
+
+        /*--------------------*/
+
+        /**
+         * Sets the curve with <C>curveIndex</C> to the cascade of
+         * IIR filter sections of <C>sectionOrder</C> at
+         * <C>sampleRate</C> with coefficients in
+         * <C>coefficientList</C> (for each section first the b's,
+         * then the a's) and discards its previous evaluation; the
+         * curve count is extended when necessary.
+         *
+         * @param[in] curveIndex       the index of the curve
+         * @param[in] sampleRate       the sample rate of the filters
+         * @param[in] coefficientList  the coefficients of all
+         *                             sections
+         * @param[in] sectionOrder     the order of each section
+         */
+        void setCurve (IN Natural curveIndex,
+                       IN Real sampleRate,
+                       IN RealList& coefficientList,
+                       IN Natural sectionOrder);
+
+        /*--------------------*/
+        /* evaluation         */
+        /*--------------------*/
+
+        /**
+         * Calculates the response of the curve with
+         * <C>curveIndex</C> at the frequencies in Hz in
+         * <C>frequencyList</C> and returns the linear magnitudes in
+         * <C>magnitudeList</C> and the phases in radians (from -pi
+         * to pi) in <C>phaseList</C>; the result is taken from the
+         * cache when the coefficients and frequencies are unchanged
+         * since the last evaluation.  Returns false for an unknown
+         * curve.
+         *
+         * @param[in]  curveIndex     the index of the curve
+         * @param[in]  frequencyList  the frequencies in Hz
+         * @param[out] magnitudeList  the linear magnitudes of the
+         *                            response
+         * @param[out] phaseList      the phases of the response in
+         *                            radians
+         * @return  information whether curve exists
+         */
+        Boolean evaluate (IN Natural curveIndex,
+                          IN RealList& frequencyList,
+                          OUT RealList& magnitudeList,
+                          OUT RealList& phaseList) const;
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the internal data of the cache (private type) */
+            Object _descriptor;
+
+    };
+
+}
@@ -0,0 +1,732 @@
+/**
+ * @file
+ * The <C>SoXKernelTuning</C> body implements the processing settings
+ * tuned by micro-benchmarks for the executing machine together with
+ * their per-machine configuration file.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXKernelTuning.h"
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include "DenormalGuard.h"
+#include "Dictionary.h"
+#include "File.h"
+#include "GenericList.h"
+#include "Logging.h"
+#include "OperatingSystem.h"
+#include "SoXWorkerPool.h"
+#include "StringList.h"
+
+/*--------------------*/
+
+using Audio::DelayLineSample;
+using Audio::DenormalGuard;
+using Audio::Kernels;
+using BaseModules::File;
+using BaseModules::OperatingSystem;
+using BaseTypes::Containers::Dictionary;
+using BaseTypes::Containers::StringList;
+using BaseTypes::GenericTypes::GenericList;
+using SoXPlugins::Helpers::SoXKernelTuning;
+using SoXPlugins::Helpers::SoXWorkerPool;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
+
+/** the clock for the benchmarks */
+using _Clock = std::chrono::steady_clock;
+
+/*====================*/
+
+/** the version of the configuration file format */
+static const Natural _fileFormatVersion = 1;
+
+/** the number of samples per channel in the kernel benchmark */
+static const Natural _kernelSampleCount = 4096;
+
+/** the number of comb filter lanes in the kernel benchmark */
+static const Natural _combLaneCount = 8;
+
+/** the number of timed rounds per candidate (the fastest counts) */
+static const Natural _roundCount = 5;
+
+/** the factor by which a candidate must beat the preferred one
+ * for replacing it */
+static const double _significantSpeedup = 0.97;
+
+/** the number of band-like tasks in the parallel benchmark */
+static const Natural _bandTaskCount = 4;
+
+/** the number of samples per band processed in one timed round of
+ * the parallel benchmark */
+static const Natural _bandSampleCount = 16384;
+
+/** the number of biquad stages per band in the parallel benchmark
+ * (crossover, detector and gain smoothing of a compander band) */
+static const Natural _bandStageCount = 6;
+
+/** the coefficients (b0, b1, b2, a1, a2) of a stable low pass used
+ * in the benchmarks */
+static const double _lowPassCoefficientArray[5] = {
+    0.0675, 0.135, 0.0675, -1.143, 0.413
+};
+
+/*--------------------*/
+
+/**
+ * Returns the time in seconds since <C>startTime</C>.
+ *
+ * @param[in] startTime  the start of the time interval
+ * @return  elapsed time in seconds
+ */
+static double _elapsedTime (IN _Clock::time_point startTime)
+{
+    const std::chrono::duration<double> duration =
+        _Clock::now() - startTime;
+    return duration.count();
+}
+
+/*--------------------*/
+
+/**
+ * Returns the identification of the executing processor written to
+ * the configuration file: its widest instruction set and number of
+ * hardware threads.
+ *
+ * @return  processor identification
+ */
+static String _processorIdentification ()
+{
+    KernelInstructionSet widestInstructionSet =
+        KernelInstructionSet::scalar;
+
+    for (KernelInstructionSet instructionSet :
+             { KernelInstructionSet::sse2, KernelInstructionSet::avx2,
+               KernelInstructionSet::avx512,
+               KernelInstructionSet::neon }) {
+        if (Kernels::isSupported(instructionSet)) {
+            widestInstructionSet = instructionSet;
+        }
+    }
+
+    const Natural hardwareThreadCount =
+        Natural{(size_t) std::thread::hardware_concurrency()};
+    return STR::expand("%1/%2",
+                       Kernels::instructionSetName(widestInstructionSet),
+                       TOSTRING(hardwareThreadCount));
+}
+
+/*--------------------*/
+
+/**
+ * Returns the instruction set named <C>name</C> in
+ * <C>instructionSet</C> and tells whether the name is known and the
+ * set is supported.
+ *
+ * @param[in]  name            name of instruction set
+ * @param[out] instructionSet  associated instruction set
+ * @return  information whether name denotes a usable set
+ */
+static Boolean _instructionSetFromName (
+                   IN String& name,
+                   OUT KernelInstructionSet& instructionSet)
+{
+    Boolean isFound = false;
+
+    for (KernelInstructionSet candidate :
+             { KernelInstructionSet::scalar, KernelInstructionSet::sse2,
+               KernelInstructionSet::avx2, KernelInstructionSet::avx512,
+               KernelInstructionSet::neon }) {
+        if (!isFound && Kernels::instructionSetName(candidate) == name
+            && Kernels::isSupported(candidate)) {
+            instructionSet = candidate;
+            isFound = true;
+        }
+    }
+
+    return isFound;
+}
+
+/*--------------------*/
+
+/**
+ * Returns the natural value for <C>key</C> in <C>dictionary</C> in
+ * <C>value</C> and tells whether it is a positive natural not
+ * exceeding <C>maximumValue</C>.
+ *
+ * @param[in]  dictionary    the key-value pairs of a file
+ * @param[in]  key           the key of the value
+ * @param[in]  maximumValue  the maximum acceptable value
+ * @param[out] value         the associated value
+ * @return  information whether value is acceptable
+ */
+static Boolean _naturalForKey (IN Dictionary& dictionary,
+                               IN String& key,
+                               IN Natural maximumValue,
+                               OUT Natural& value)
+{
+    const String st = dictionary.atWithDefault(key, "");
+    Boolean isOkay = STR::isNatural(st);
+
+    if (isOkay) {
+        value = STR::toNatural(st);
+        isOkay = (value > 0 && value <= maximumValue);
+    }
+
+    return isOkay;
+}
+
+/*====================*/
+/* KERNEL BENCHMARK   */
+/*====================*/
+
+/**
+ * A <C>_KernelBenchmarkData</C> object holds the buffers processed
+ * by the kernels in the benchmark of the instruction sets.
+ */
+struct _KernelBenchmarkData {
+
+    /** four channels of double samples */
+    GenericList<double> channelList[4];
+
+    /** a channel of float samples */
+    GenericList<float> floatList;
+
+    /** the delay line of the comb filters */
+    GenericList<DelayLineSample> delayLine;
+
+    /** the slot indices of the comb filters in the delay line */
+    GenericList<size_t> slotIndexList;
+
+    /** the damping states of the comb filters */
+    GenericList<double> storedSampleList;
+
+    /** the outputs of the comb filters */
+    GenericList<double> combOutputList;
+
+    /** the biquad states (z1 and z2 of four channels) */
+    double biquadStateArray[8];
+
+    /*--------------------*/
+
+    /**
+     * Makes the benchmark buffers filled with a deterministic noise
+     * signal.
+     */
+    _KernelBenchmarkData ()
+    {
+        const size_t sampleCount = (size_t) _kernelSampleCount;
+        std::uint32_t seed = 12345;
+
+        for (GenericList<double>& channel : channelList) {
+            channel.setLength(_kernelSampleCount, 0.0);
+        }
+
+        floatList.setLength(_kernelSampleCount, 0.0f);
+
+        for (size_t i = 0;  i < sampleCount;  i++) {
+            seed = seed * 1664525 + 1013904223;
+            const double sample = (double) (seed >> 8) / 16777216.0 - 0.5;
+            channelList[0][i] = sample;
+            channelList[1][i] = -sample;
+            channelList[2][i] = 0.5 * sample;
+            channelList[3][i] = -0.5 * sample;
+            floatList[i] = (float) sample;
+        }
+
+        delayLine.setLength(_kernelSampleCount, 0);
+        slotIndexList.setLength(_combLaneCount, 0);
+        storedSampleList.setLength(_combLaneCount, 0.0);
+        combOutputList.setLength(_combLaneCount, 0.0);
+
+        for (size_t lane = 0;  lane < (size_t) _combLaneCount;  lane++) {
+            slotIndexList[lane] = lane * 397 % sampleCount;
+        }
+
+        for (double& state : biquadStateArray) {
+            state = 0.0;
+        }
+    }
+
+};
+
+/*--------------------*/
+
+/**
+ * Processes the buffers in <C>data</C> once by a typical mix of the
+ * kernels in <C>kernels</C> and returns the time needed in seconds.
+ *
+ * @param[in]    kernels  the kernel table to be measured
+ * @param[inout] data     the benchmark buffers
+ * @return  processing time in seconds
+ */
+static double _measureKernels (IN Kernels& kernels,
+                               INOUT _KernelBenchmarkData& data)
+{
+    const size_t sampleCount = (size_t) _kernelSampleCount;
+    const size_t combSampleCount = sampleCount / 8;
+    double* channelArray[4] = {
+        data.channelList[0].data(), data.channelList[1].data(),
+        data.channelList[2].data(), data.channelList[3].data()
+    };
+    double resultArray[2];
+    const _Clock::time_point startTime = _Clock::now();
+
+    kernels.biquadStereo(channelArray[0], channelArray[1],
+                         channelArray[0], channelArray[1],
+                         sampleCount, _lowPassCoefficientArray,
+                         data.biquadStateArray);
+    kernels.biquadQuad(channelArray, sampleCount,
+                       _lowPassCoefficientArray, data.biquadStateArray);
+    kernels.gainRampDouble(channelArray[2], sampleCount, 1.0, 0.0);
+    kernels.waveshapeDouble(channelArray[2], channelArray[3],
+                            sampleCount, 0.9, 0.1);
+    kernels.mixDouble(channelArray[2], channelArray[2], channelArray[3],
+                      sampleCount, 0.5, 0.75);
+    kernels.floatToDouble(channelArray[3], data.floatList.data(),
+                          sampleCount);
+    kernels.gainRampFloat(data.floatList.data(), sampleCount,
+                          1.0f, 0.0f);
+    kernels.doubleToFloat(data.floatList.data(), channelArray[3],
+                          sampleCount);
+    kernels.levelFloat(data.floatList.data(), sampleCount, resultArray);
+    kernels.levelDouble(channelArray[1], sampleCount, resultArray);
+
+    for (size_t i = 0;  i < combSampleCount;  i++) {
+        kernels.combFilterBank(data.delayLine.data(),
+                               data.slotIndexList.data(),
+                               data.storedSampleList.data(),
+                               data.combOutputList.data(),
+                               (size_t) _combLaneCount,
+                               channelArray[0][i], 0.7, 0.3);
+
+        for (size_t& slotIndex : data.slotIndexList) {
+            slotIndex = (slotIndex + 1) % sampleCount;
+        }
+    }
+
+    return _elapsedTime(startTime);
+}
+
+/*====================*/
+/* PARALLEL BENCHMARK */
+/*====================*/
+
+/**
+ * A <C>_BandBenchmarkData</C> object holds the buffers of the
+ * band-like tasks in the benchmark of parallel processing.
+ */
+struct _BandBenchmarkData {
+
+    /** the kernels used by the tasks */
+    const Kernels* kernels;
+
+    /** the number of samples per block */
+    Natural blockLength;
+
+    /** two channels of samples per band */
+    GenericList<GenericList<double>> channelList;
+
+    /** the biquad states per band and stage (z1 and z2 of two
+     * channels) */
+    GenericList<double> stateList;
+
+};
+
+/*--------------------*/
+
+/**
+ * Processes a block of band <C>bandIndex</C> in the benchmark of
+ * parallel processing by a cascade of biquads.
+ *
+ * @param[inout] context    the benchmark data
+ * @param[in]    bandIndex  the index of the band
+ */
+static void _processBenchmarkBand (INOUT void* context,
+                                   IN Natural bandIndex)
+{
+    _BandBenchmarkData& data = *((_BandBenchmarkData*) context);
+    const size_t blockLength = (size_t) data.blockLength;
+    double* channelA = data.channelList[2 * (size_t) bandIndex].data();
+    double* channelB =
+        data.channelList[2 * (size_t) bandIndex + 1].data();
+
+    for (Natural stage = 0;  stage < _bandStageCount;  stage++) {
+        const size_t stateIndex =
+            4 * ((size_t) bandIndex * (size_t) _bandStageCount
+                 + (size_t) stage);
+        data.kernels->biquadStereo(channelA, channelB,
+                                   channelA, channelB, blockLength,
+                                   _lowPassCoefficientArray,
+                                   &data.stateList[stateIndex]);
+    }
+}
+
+/*--------------------*/
+
+/**
+ * Processes <C>_bandSampleCount</C> samples of all bands in blocks of
+ * <C>data.blockLength</C> samples on the worker pool and returns the
+ * fastest time of several rounds in seconds.
+ *
+ * @param[inout] data  the benchmark data
+ * @return  processing time in seconds
+ */
+static double _measureBands (INOUT _BandBenchmarkData& data)
+{
+    SoXWorkerPool& workerPool = SoXWorkerPool::instance();
+    const Natural blockCount = _bandSampleCount / data.blockLength;
+    double result = 0.0;
+
+    for (Natural round = 0;  round < _roundCount;  round++) {
+        const _Clock::time_point startTime = _Clock::now();
+
+        for (Natural block = 0;  block < blockCount;  block++) {
+            workerPool.run(_processBenchmarkBand, &data,
+                           _bandTaskCount, data.blockLength);
+        }
+
+        const double time = _elapsedTime(startTime);
+        result = (round == 0 ? time : std::min(result, time));
+    }
+
+    return result;
+}
+
+/*============================================================*/
+
+/*--------------------*/
+/* class variables    */
+/*--------------------*/
+
+const NaturalList SoXKernelTuning::companderBlockLengthList =
+    NaturalList::fromList({ 64, 128, 256, 512, 1024 });
+
+const NaturalList SoXKernelTuning::parallelBlockLengthList =
+    NaturalList::fromList({ 32, 64, 128, 256, 512, 1024 });
+
+/*--------------------*/
+
+/**
+ * Returns the mutex protecting the process-wide settings; it is
+ * never locked on the audio thread.
+ *
+ * @return  reference to settings mutex
+ */
+static std::mutex& _currentTuningMutex ()
+{
+    static std::mutex mutex{};
+    return mutex;
+}
+
+/*--------------------*/
+
+/**
+ * Returns the process-wide settings.
+ *
+ * @return  reference to current settings
+ */
+static SoXKernelTuning& _currentTuning ()
+{
+    static SoXKernelTuning tuning{};
+    return tuning;
+}
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+SoXKernelTuning::SoXKernelTuning ()
+    : instructionSet{Kernels::current().instructionSet},
+      companderBlockLength{256},
+      parallelBlockLength{128}
+{
+}
+
+/*-----------------------*/
+/* string representation */
+/*-----------------------*/
+
+String SoXKernelTuning::toString () const
+{
+    String st =
+        STR::expand("SoXKernelTuning("
+                    "instructionSet = %1, companderBlockLength = %2,"
+                    " parallelBlockLength = %3)",
+                    Kernels::instructionSetName(instructionSet),
+                    TOSTRING(companderBlockLength),
+                    TOSTRING(parallelBlockLength));
+
+    return st;
+}
+
+/*--------------------*/
+/* persistence        */
+/*--------------------*/
+
+String SoXKernelTuning::defaultFileName ()
+{
+    Logging_trace(">>");
+
+    /* the host name is part of the file name, since home
+       directories are often shared between machines */
+    String hostName = OperatingSystem::hostName();
+    hostName = (hostName == "" ? String{"local"} : hostName);
+    const String result =
+        STR::expand("%1/SoXPlugins/SoXKernelTuning-%2.cfg",
+                    OperatingSystem::configurationDirectoryPath(),
+                    hostName);
+
+    Logging_trace1("<<: %1", result);
+    return result;
+}
+
+/*--------------------*/
+
+Boolean SoXKernelTuning::readFromFile (IN String& fileName)
+{
+    Logging_trace1(">>: %1", fileName);
+
+    File file;
+    Boolean isOkay = (OperatingSystem::fileExists(fileName)
+                      && file.open(fileName, "r"));
+    Dictionary dictionary;
+
+    if (isOkay) {
+        const StringList lineList = file.readLines();
+        file.close();
+
+        for (const String& line : lineList) {
+            String key;
+            String value;
+
+            if (!STR::startsWith(line, "#")
+                && STR::splitAt(line, "=", key, value)) {
+                dictionary.set(STR::strip(key), STR::strip(value));
+            }
+        }
+    }
+
+    KernelInstructionSet fileInstructionSet = KernelInstructionSet::scalar;
+    Natural fileCompanderBlockLength = 0;
+    Natural fileParallelBlockLength = 0;
+    isOkay = (isOkay
+              && (dictionary.atWithDefault("version", "")
+                  == TOSTRING(_fileFormatVersion))
+              && (dictionary.atWithDefault("processor", "")
+                  == _processorIdentification())
+              && _instructionSetFromName(
+                     dictionary.atWithDefault("instructionSet", ""),
+                     fileInstructionSet)
+              && _naturalForKey(dictionary, "companderBlockLength",
+                                8192, fileCompanderBlockLength)
+              && _naturalForKey(dictionary, "parallelBlockLength",
+                                65536, fileParallelBlockLength));
+
+    if (isOkay) {
+        instructionSet       = fileInstructionSet;
+        companderBlockLength = fileCompanderBlockLength;
+        parallelBlockLength  = fileParallelBlockLength;
+    }
+
+    Logging_trace2("<<: isOkay = %1, %2", TOSTRING(isOkay), toString());
+    return isOkay;
+}
+
+/*--------------------*/
+
+Boolean SoXKernelTuning::writeToFile (IN String& fileName) const
+{
+    Logging_trace1(">>: %1", fileName);
+
+    File file;
+    const Boolean isOkay =
+        (OperatingSystem::makeDirectory(OperatingSystem::dirname(fileName))
+         && file.open(fileName, "w"));
+
+    if (isOkay) {
+        const String st =
+            STR::expand("# processing settings measured for this"
+                        " machine\n"
+                        "version = %1\n"
+                        "processor = %2\n"
+                        "instructionSet = %3\n"
+                        "companderBlockLength = %4\n"
+                        "parallelBlockLength = %5\n",
+                        TOSTRING(_fileFormatVersion),
+                        _processorIdentification(),
+                        Kernels::instructionSetName(instructionSet),
+                        TOSTRING(companderBlockLength),
+                        TOSTRING(parallelBlockLength));
+        file.writeString(st);
+        file.close();
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+/* measurement        */
+/*--------------------*/
+
+void SoXKernelTuning::measureInstructionSet ()
+{
+    Logging_trace(">>");
+
+    DenormalGuard denormalGuard{};
+    _KernelBenchmarkData data{};
+    KernelInstructionSet bestInstructionSet = KernelInstructionSet::scalar;
+    double bestTime = 0.0;
+
+    /* the sets are visited from the widest to the narrowest, hence
+       a narrower set must be significantly faster to win */
+    for (KernelInstructionSet candidate :
+             { KernelInstructionSet::neon, KernelInstructionSet::avx512,
+               KernelInstructionSet::avx2, KernelInstructionSet::sse2,
+               KernelInstructionSet::scalar }) {
+        if (Kernels::isSupported(candidate)) {
+            const Kernels& kernels = Kernels::forInstructionSet(candidate);
+            double time = 0.0;
+
+            /* the first round only warms up caches and clocks */
+            _measureKernels(kernels, data);
+
+            for (Natural round = 0;  round < _roundCount;  round++) {
+                const double roundTime = _measureKernels(kernels, data);
+                time = (round == 0 ? roundTime
+                        : std::min(time, roundTime));
+            }
+
+            Logging_trace2("--: %1 = %2s",
+                           Kernels::instructionSetName(candidate),
+                           TOSTRING(Real{time}));
+
+            if (bestTime == 0.0 || time < bestTime * _significantSpeedup) {
+                bestInstructionSet = candidate;
+                bestTime = time;
+            }
+        }
+    }
+
+    instructionSet = bestInstructionSet;
+    Logging_trace1("<<: %1", Kernels::instructionSetName(instructionSet));
+}
+
+/*--------------------*/
+
+void SoXKernelTuning::measureParallelBlockLength ()
+{
+    Logging_trace(">>");
+
+    SoXWorkerPool& workerPool = SoXWorkerPool::instance();
+    const Natural threadCount =
+        SoXWorkerPool::suggestedThreadCount(_bandTaskCount);
+
+    if (threadCount == 0) {
+        Logging_trace("--: single hardware thread, kept");
+    } else {
+        DenormalGuard denormalGuard{};
+        const Natural previousThreadCount = workerPool.threadCount();
+        const Natural previousBlockLength =
+            workerPool.minimumBlockLength();
+        const Natural lastCandidate =
+            parallelBlockLengthList[parallelBlockLengthList.size() - 1];
+        _BandBenchmarkData data{};
+        data.kernels = &Kernels::forInstructionSet(instructionSet);
+        data.stateList.setLength(Natural{4} * _bandTaskCount
+                                 * _bandStageCount, 0.0);
+        data.channelList.setLength(Natural{2} * _bandTaskCount);
+
+        for (GenericList<double>& channel : data.channelList) {
+            channel.setLength(lastCandidate, 0.25);
+        }
+
+        /* when no candidate is faster in parallel, the bands of
+           all usual blocks are processed serially */
+        const Natural serialBlockLength = Natural{2} * lastCandidate;
+        Natural result = serialBlockLength;
+        workerPool.reserveThreads(threadCount);
+
+        for (const Natural blockLength : parallelBlockLengthList) {
+            data.blockLength = blockLength;
+            workerPool.setMinimumBlockLength(serialBlockLength);
+            const double serialTime = _measureBands(data);
+            workerPool.setMinimumBlockLength(1);
+            const double parallelTime = _measureBands(data);
+            Logging_trace3("--: blockLength = %1,"
+                           " serial = %2s, parallel = %3s",
+                           TOSTRING(blockLength),
+                           TOSTRING(Real{serialTime}),
+                           TOSTRING(Real{parallelTime}));
+
+            if (result > blockLength
+                && parallelTime < 0.9 * serialTime) {
+                result = blockLength;
+            }
+        }
+
+        workerPool.configure(previousThreadCount, previousBlockLength);
+        parallelBlockLength = result;
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(parallelBlockLength));
+}
+
+/*--------------------*/
+/* process settings   */
+/*--------------------*/
+
+SoXKernelTuning SoXKernelTuning::current ()
+{
+    std::scoped_lock lock{_currentTuningMutex()};
+    return _currentTuning();
+}
+
+/*--------------------*/
+
+void SoXKernelTuning::setCurrent (IN SoXKernelTuning& tuning)
+{
+    Logging_trace1(">>: %1", tuning.toString());
+
+    std::scoped_lock lock{_currentTuningMutex()};
+    _currentTuning() = tuning;
+    Kernels::select(tuning.instructionSet);
+    SoXWorkerPool::instance()
+        .setMinimumBlockLength(tuning.parallelBlockLength);
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXKernelTuning::initialize ()
+{
+    static std::once_flag onceFlag;
+
+    std::call_once(onceFlag, [] () {
+        Logging_trace(">>");
+
+        const String fileName = defaultFileName();
+        SoXKernelTuning tuning{};
+
+        if (!tuning.readFromFile(fileName)) {
+            tuning.measureInstructionSet();
+            tuning.measureParallelBlockLength();
+            tuning.writeToFile(fileName);
+        }
+
+        setCurrent(tuning);
+        Logging_trace("<<");
+    });
+}
@@ -0,0 +1,200 @@
+/**
+ * @file
+ * The <C>SoXKernelTuning</C> specification defines the processing
+ * settings tuned by micro-benchmarks for the executing machine
+ * (kernel instruction set, compander block length and threshold
+ * for parallel band processing) together with their per-machine
+ * configuration file.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "Kernels.h"
+#include "MyString.h"
+#include "Natural.h"
+#include "NaturalList.h"
+
+/*--------------------*/
+
+using Audio::KernelInstructionSet;
+using BaseTypes::Containers::NaturalList;
+using BaseTypes::Primitives::Boolean;
+using BaseTypes::Primitives::Natural;
+using BaseTypes::Primitives::String;
+
+/*====================*/
+
+namespace SoXPlugins::Helpers {
+
+    /**
+     * A <C>SoXKernelTuning</C> object holds the settings of the
+     * processing paths whose best choice depends on the machine:
+     * the instruction set of the kernel table (the widest one is
+     * not always the fastest), the number of samples the multiband
+     * compander processes as a block and the block length from
+     * which the compander bands are spread across the worker pool.
+     *
+     * The process-wide settings are loaded by <C>initialize</C>
+     * from a configuration file per machine; when the file is
+     * missing or has been written for another processor, the
+     * effect-independent settings are measured by micro-benchmarks
+     * (taking a fraction of a second) and the file is written, so
+     * this only happens on the first load.  Settings needing a
+     * complete effect (like the compander block length) are
+     * measured on demand by the test program and stored in the same
+     * file.
+     *
+     * The storage precision of delay lines is not a setting here,
+     * because it is fixed at compile time.
+     */
+    struct SoXKernelTuning {
+
+        /** the candidates for the compander block length */
+        static const NaturalList companderBlockLengthList;
+
+        /** the candidates for the minimum block length of
+         * parallel band processing */
+        static const NaturalList parallelBlockLengthList;
+
+        /*--------------------*/
+
+        /** the instruction set of the kernel table */
+        KernelInstructionSet instructionSet;
+
+        /** the number of samples per channel processed as a block
+         * by the multiband compander */
+        Natural companderBlockLength;
+
+        /** the minimum block length for processing the compander
+         * bands by the worker pool */
+        Natural parallelBlockLength;
+
+        /*--------------------*/
+        /* con-/destruction   */
+        /*--------------------*/
+
+        /**
+         * Makes settings with the defaults: the widest instruction
+         * set of the processor and the fixed block lengths used
+         * before tuning.
+         */
+        SoXKernelTuning ();
+
+        /*-----------------------*/
+        /* string representation */
+        /*-----------------------*/
+
+        /**
+         * Returns string representation of settings.
+         *
+         * @return string representation
+         */
+        String toString () const;
+
+        /*--------------------*/
+        /* persistence        */
+        /*--------------------*/
+
+        /**
+         * Returns the name of the configuration file for the
+         * executing machine in the per-user configuration directory.
+         *
+         * @return  name of configuration file
+         */
+        static String defaultFileName ();
+
+        /*--------------------*/
+
+        /**
+         * Reads the settings from the file named <C>fileName</C> and
+         * tells whether this has been successful; settings from a
+         * missing or malformed file or one written for another
+         * processor are not taken over.
+         *
+         * @param[in] fileName  name of configuration file
+         * @return  information whether settings have been read
+         */
+        Boolean readFromFile (IN String& fileName);
+
+        /*--------------------*/
+
+        /**
+         * Writes the settings together with an identification of
+         * the processor to the file named <C>fileName</C> (creating
+         * its directory when missing) and tells whether this has
+         * been successful.
+         *
+         * @param[in] fileName  name of configuration file
+         * @return  information whether file has been written
+         */
+        Boolean writeToFile (IN String& fileName) const;
+
+        /*--------------------*/
+        /* measurement        */
+        /*--------------------*/
+
+        /**
+         * Sets the instruction set to the fastest one supported in
+         * a micro-benchmark of the kernels; a narrower set must be
+         * clearly faster to replace a wider one.
+         */
+        void measureInstructionSet ();
+
+        /*--------------------*/
+
+        /**
+         * Sets the parallel block length to the shortest candidate
+         * where four band-like tasks are clearly faster on the
+         * worker pool than on the calling thread (or to twice the
+         * longest candidate when there is none); keeps it when the
+         * machine has a single hardware thread.  The pool gets
+         * worker threads for the measurement and is afterwards
+         * reset to its former thread count.
+         */
+        void measureParallelBlockLength ();
+
+        /*--------------------*/
+        /* process settings   */
+        /*--------------------*/
+
+        /**
+         * Returns the settings currently used in the process.
+         *
+         * @return  current settings
+         */
+        static SoXKernelTuning current ();
+
+        /*--------------------*/
+
+        /**
+         * Sets the settings used in the process to <C>tuning</C>:
+         * selects the kernel table and sets the worker pool
+         * threshold; a new compander block length is taken over by
+         * the next resize of a compander.
+         *
+         * @param[in] tuning  new settings
+         */
+        static void setCurrent (IN SoXKernelTuning& tuning);
+
+        /*--------------------*/
+
+        /**
+         * Loads the settings for the executing machine from its
+         * configuration file or, when not available, measures and
+         * stores them, and makes them current; only the first call
+         * in a process has an effect.
+         */
+        static void initialize ();
+
+    };
+
+}
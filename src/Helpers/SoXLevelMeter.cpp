@@ -0,0 +1,274 @@
+/**
+ * @file
+ * The <C>SoXLevelMeter</C> body implements the measurement of peak
+ * and RMS levels and gain reductions on the audio thread and their
+ * lock-free handoff to a display.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXLevelMeter.h"
+
+#include <cmath>
+#include "Kernels.h"
+#include "Logging.h"
+
+/*--------------------*/
+
+using Audio::Kernels;
+using SoXPlugins::Helpers::SoXLevelMeter;
+using SoXPlugins::Helpers::SoXLevelMeterSnapshot;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
+
+/*====================*/
+
+/**
+ * Accumulates the levels of the first <C>sampleCount</C> samples of
+ * the <C>channelCount</C> channels in <C>channelArray</C> by the
+ * level kernel <C>levelKernel</C> into the peaks in
+ * <C>peakArray</C> and the sums of squares in
+ * <C>squareSumArray</C>.
+ *
+ * @tparam       SampleType      type of samples (float or double)
+ * @param[in]    levelKernel     the kernel measuring a channel
+ * @param[in]    channelArray    the samples per channel
+ * @param[in]    channelCount    the number of channels
+ * @param[in]    sampleCount     the number of samples per channel
+ * @param[inout] peakArray       the peaks per channel
+ * @param[inout] squareSumArray  the sums of squares per channel
+ */
+template<typename SampleType>
+static void _accumulateLevels (void (*levelKernel) (IN SampleType*,
+                                                    IN size_t,
+                                                    OUT double*),
+                               IN SampleType* const* channelArray,
+                               IN Natural channelCount,
+                               IN Natural sampleCount,
+                               INOUT double* peakArray,
+                               INOUT double* squareSumArray)
+{
+    double resultArray[2];
+
+    for (size_t channel = 0;  channel < (size_t) channelCount;
+         channel++) {
+        levelKernel(channelArray[channel], (size_t) sampleCount,
+                    resultArray);
+        peakArray[channel] = (resultArray[0] > peakArray[channel]
+                              ? resultArray[0] : peakArray[channel]);
+        squareSumArray[channel] += resultArray[1];
+    }
+}
+
+/*====================*/
+
+SoXLevelMeterSnapshot::SoXLevelMeterSnapshot ()
+    : sequenceNumber{0},
+      channelCount{0},
+      peakList{},
+      rmsList{},
+      gainReductionCount{0},
+      gainReductionList{}
+{
+}
+
+/*--------------------*/
+
+String SoXLevelMeterSnapshot::toString () const
+{
+    String peakString;
+    String rmsString;
+    String gainReductionString;
+
+    for (Natural channel = 0;  channel < channelCount;  channel++) {
+        const String separator = (channel > 0 ? ", " : "");
+        peakString += separator + TOSTRING(peakList[(size_t) channel]);
+        rmsString  += separator + TOSTRING(rmsList[(size_t) channel]);
+    }
+
+    for (Natural i = 0;  i < gainReductionCount;  i++) {
+        gainReductionString +=
+            ((i > 0 ? ", " : "")
+             + TOSTRING(gainReductionList[(size_t) i]));
+    }
+
+    return STR::expand("SoXLevelMeterSnapshot(sequenceNumber = %1,"
+                       " peakList = (%2), rmsList = (%3),"
+                       " gainReductionList = (%4))",
+                       TOSTRING(sequenceNumber), peakString, rmsString,
+                       gainReductionString);
+}
+
+/*====================*/
+
+const Real SoXLevelMeter::_windowDuration{0.05};
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+SoXLevelMeter::SoXLevelMeter ()
+    : _windowLength{0},
+      _windowSampleCount{0},
+      _sequenceNumber{0},
+      _channelCount{0},
+      _peakArray{},
+      _squareSumArray{},
+      _gainReductionCount{0},
+      _gainReductionArray{},
+      _exchange{}
+{
+    Logging_trace(">>");
+    setSampleRate(44100.0);
+    Logging_trace("<<");
+}
+
+/*-----------------------*/
+/* string representation */
+/*-----------------------*/
+
+String SoXLevelMeter::toString () const
+{
+    return STR::expand("SoXLevelMeter(windowLength = %1,"
+                       " sequenceNumber = %2)",
+                       TOSTRING(_windowLength),
+                       TOSTRING(_sequenceNumber));
+}
+
+/*--------------------*/
+/* property change    */
+/*--------------------*/
+
+void SoXLevelMeter::setSampleRate (IN Real sampleRate)
+{
+    Logging_trace1(">>: %1", TOSTRING(sampleRate));
+    _windowLength =
+        Natural::maximum(1, (Natural) Real::round(sampleRate
+                                                  * _windowDuration));
+    _clearWindow();
+    Logging_trace1("<<: %1", toString());
+}
+
+/*--------------------*/
+/* audio thread       */
+/*--------------------*/
+
+void SoXLevelMeter::recordGainReduction (IN Natural index,
+                                         IN Real dBValue)
+{
+    if (index < SoXLevelMeterSnapshot::maximumGainReductionCount) {
+        Real& gainReduction = _gainReductionArray[(size_t) index];
+        gainReduction = Real::maximum(gainReduction, dBValue);
+        _gainReductionCount = Natural::maximum(_gainReductionCount,
+                                               index + 1);
+    }
+}
+
+/*--------------------*/
+
+void SoXLevelMeter::measureBlock (IN float* const* channelArray,
+                                  IN Natural channelCount,
+                                  IN Natural sampleCount)
+{
+    const Natural effectiveChannelCount =
+        Natural::minimum(channelCount,
+                         SoXLevelMeterSnapshot::maximumChannelCount);
+    _accumulateLevels(Kernels::current().levelFloat,
+                      channelArray, effectiveChannelCount, sampleCount,
+                      _peakArray, _squareSumArray);
+    _channelCount = Natural::maximum(_channelCount, effectiveChannelCount);
+    _advanceWindow(sampleCount);
+}
+
+/*--------------------*/
+
+void SoXLevelMeter::measureBlock (IN double* const* channelArray,
+                                  IN Natural channelCount,
+                                  IN Natural sampleCount)
+{
+    const Natural effectiveChannelCount =
+        Natural::minimum(channelCount,
+                         SoXLevelMeterSnapshot::maximumChannelCount);
+    _accumulateLevels(Kernels::current().levelDouble,
+                      channelArray, effectiveChannelCount, sampleCount,
+                      _peakArray, _squareSumArray);
+    _channelCount = Natural::maximum(_channelCount, effectiveChannelCount);
+    _advanceWindow(sampleCount);
+}
+
+/*--------------------*/
+/* display thread     */
+/*--------------------*/
+
+Boolean SoXLevelMeter::acquire (OUT SoXLevelMeterSnapshot& snapshot)
+{
+    const Boolean isAcquired = _exchange.acquire();
+
+    if (isAcquired) {
+        snapshot = _exchange.currentSnapshot();
+    }
+
+    return isAcquired;
+}
+
+/*--------------------*/
+/* internal routines  */
+/*--------------------*/
+
+void SoXLevelMeter::_clearWindow ()
+{
+    _windowSampleCount  = 0;
+    _channelCount       = 0;
+    _gainReductionCount = 0;
+
+    for (size_t channel = 0;
+         channel < SoXLevelMeterSnapshot::maximumChannelCount;
+         channel++) {
+        _peakArray[channel]      = 0.0;
+        _squareSumArray[channel] = 0.0;
+    }
+
+    for (size_t i = 0;
+         i < SoXLevelMeterSnapshot::maximumGainReductionCount;  i++) {
+        _gainReductionArray[i] = 0.0;
+    }
+}
+
+/*--------------------*/
+
+void SoXLevelMeter::_advanceWindow (IN Natural sampleCount)
+{
+    _windowSampleCount += sampleCount;
+
+    if (_windowSampleCount >= _windowLength) {
+        /* the window is complete: copy it into the slot of the
+           producer and hand it over */
+        SoXLevelMeterSnapshot& snapshot = _exchange.pendingSnapshot();
+        const double sampleCountFactor =
+            1.0 / (double) _windowSampleCount;
+        _sequenceNumber++;
+        snapshot.sequenceNumber     = _sequenceNumber;
+        snapshot.channelCount       = _channelCount;
+        snapshot.gainReductionCount = _gainReductionCount;
+
+        for (size_t channel = 0;  channel < (size_t) _channelCount;
+             channel++) {
+            snapshot.peakList[channel] = _peakArray[channel];
+            snapshot.rmsList[channel] =
+                std::sqrt(_squareSumArray[channel] * sampleCountFactor);
+        }
+
+        for (size_t i = 0;  i < (size_t) _gainReductionCount;  i++) {
+            snapshot.gainReductionList[i] = _gainReductionArray[i];
+        }
+
+        _exchange.publish();
+        _clearWindow();
+    }
+}
@@ -0,0 +1,272 @@
+/**
+ * @file
+ * The <C>SoXLevelMeter</C> specification defines the measurement of
+ * peak and RMS levels and gain reductions on the audio thread and
+ * their lock-free handoff to a display.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "MyString.h"
+#include "Natural.h"
+#include "Real.h"
+#include "SoXSnapshotExchange.h"
+
+/*--------------------*/
+
+using BaseTypes::Primitives::Boolean;
+using BaseTypes::Primitives::Natural;
+using BaseTypes::Primitives::Real;
+using BaseTypes::Primitives::String;
+using SoXPlugins::Helpers::SoXSnapshotExchange;
+
+/*====================*/
+
+namespace SoXPlugins::Helpers {
+
+    /**
+     * A <C>SoXLevelMeterSnapshot</C> object holds the levels of a
+     * single measurement window: the peak and RMS level per channel
+     * (as linear magnitudes) and the maximum gain reductions of the
+     * effect (in decibels).  It has a fixed size, hence copying it
+     * never allocates.
+     */
+    struct SoXLevelMeterSnapshot {
+
+        /** the maximum number of channels measured */
+        static constexpr size_t maximumChannelCount = 64;
+
+        /** the maximum number of gain reduction values */
+        static constexpr size_t maximumGainReductionCount = 16;
+
+        /*--------------------*/
+
+        /** the number of measurement windows completed before this
+         * one (zero for no measurement at all) */
+        Natural sequenceNumber;
+
+        /** the number of channels measured */
+        Natural channelCount;
+
+        /** the maximum sample magnitude per channel */
+        Real peakList[maximumChannelCount];
+
+        /** the root mean square of the samples per channel */
+        Real rmsList[maximumChannelCount];
+
+        /** the number of gain reduction values */
+        Natural gainReductionCount;
+
+        /** the maximum gain reductions in decibels */
+        Real gainReductionList[maximumGainReductionCount];
+
+        /*--------------------*/
+
+        /**
+         * Makes an empty snapshot without channels.
+         */
+        SoXLevelMeterSnapshot ();
+
+        /*--------------------*/
+
+        /**
+         * Returns string representation of snapshot
+         *
+         * @return string representation
+         */
+        String toString () const;
+
+    };
+
+    /*====================*/
+
+    /**
+     * A <C>SoXLevelMeter</C> object measures the levels of the
+     * blocks processed by an effect on the audio thread and hands
+     * them over to a display.  The audio thread accumulates the
+     * peak and the sum of squares per channel (by the SIMD level
+     * kernels) and the gain reductions over a window of about 50ms
+     * and publishes the complete window as a snapshot by a
+     * <C>SoXSnapshotExchange</C>; a display timer acquires the
+     * latest snapshot at the display rate.  Hence the audio side
+     * never allocates or waits and the display never sees the
+     * audio buffers; windows published between two display ticks
+     * are lost, but each of them covers more than a display
+     * period.
+     */
+    struct SoXLevelMeter {
+
+        /*--------------------*/
+        /* con-/destruction   */
+        /*--------------------*/
+
+        /**
+         * Makes a level meter for a sample rate of 44.1kHz without
+         * any measurement.
+         */
+        SoXLevelMeter ();
+
+        /*--------------------*/
+
+        SoXLevelMeter (IN SoXLevelMeter&) = delete;
+
+        /*-----------------------*/
+        /* string representation */
+        /*-----------------------*/
+
+        /**
+         * Returns string representation of level meter
+         *
+         * @return string representation
+         */
+        String toString () const;
+
+        /*--------------------*/
+        /* property change    */
+        /*--------------------*/
+
+        /**
+         * Sets the sample rate of the measured signal to
+         * <C>sampleRate</C> and restarts the current window; must
+         * not be called while the audio thread measures.
+         *
+         * @param[in] sampleRate  the sample rate of the signal
+         */
+        void setSampleRate (IN Real sampleRate);
+
+        /*--------------------*/
+        /* audio thread       */
+        /*--------------------*/
+
+        /**
+         * Records <C>dBValue</C> as gain reduction with
+         * <C>index</C> for the current window, where the maximum
+         * reduction of the window is kept; indices beyond the
+         * maximum count are ignored.
+         *
+         * @param[in] index    the index of the gain reduction value
+         * @param[in] dBValue  the gain reduction in decibels
+         */
+        void recordGainReduction (IN Natural index,
+                                  IN Real dBValue);
+
+        /*--------------------*/
+
+        /**
+         * Measures the first <C>sampleCount</C> samples of the
+         * <C>channelCount</C> float channels in
+         * <C>channelArray</C>; when the current window is complete,
+         * it is published.
+         *
+         * @param[in] channelArray  the samples per channel
+         * @param[in] channelCount  the number of channels
+         * @param[in] sampleCount   the number of samples per channel
+         */
+        void measureBlock (IN float* const* channelArray,
+                           IN Natural channelCount,
+                           IN Natural sampleCount);
+
+        /*--------------------*/
+
+        /**
+         * Measures the first <C>sampleCount</C> samples of the
+         * <C>channelCount</C> double channels in
+         * <C>channelArray</C>; when the current window is complete,
+         * it is published.
+         *
+         * @param[in] channelArray  the samples per channel
+         * @param[in] channelCount  the number of channels
+         * @param[in] sampleCount   the number of samples per channel
+         */
+        void measureBlock (IN double* const* channelArray,
+                           IN Natural channelCount,
+                           IN Natural sampleCount);
+
+        /*--------------------*/
+        /* display thread     */
+        /*--------------------*/
+
+        /**
+         * Takes over the latest published window (if any) into
+         * <C>snapshot</C> and tells whether there was a new one;
+         * must only be called by a single display thread.
+         *
+         * @param[out] snapshot  the levels of the latest window
+         * @return  information whether a new window has been
+         *          acquired
+         */
+        Boolean acquire (OUT SoXLevelMeterSnapshot& snapshot);
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the duration of a measurement window in seconds */
+            static const Real _windowDuration;
+
+            /*--------------------*/
+
+            /** the number of samples in a window */
+            Natural _windowLength;
+
+            /** the number of samples measured in the current
+             * window */
+            Natural _windowSampleCount;
+
+            /** the number of windows published */
+            Natural _sequenceNumber;
+
+            /** the number of channels in the current window */
+            Natural _channelCount;
+
+            /** the peaks of the current window per channel */
+            double _peakArray[SoXLevelMeterSnapshot::maximumChannelCount];
+
+            /** the sums of squares of the current window per
+             * channel */
+            double _squareSumArray[SoXLevelMeterSnapshot
+                                   ::maximumChannelCount];
+
+            /** the number of gain reduction values in the current
+             * window */
+            Natural _gainReductionCount;
+
+            /** the maximum gain reductions of the current window */
+            Real _gainReductionArray[SoXLevelMeterSnapshot
+                                     ::maximumGainReductionCount];
+
+            /** the handoff of the completed windows to the
+             * display */
+            SoXSnapshotExchange<SoXLevelMeterSnapshot> _exchange;
+
+            /*--------------------*/
+
+            /**
+             * Restarts the accumulation of a window.
+             */
+            void _clearWindow ();
+
+            /*--------------------*/
+
+            /**
+             * Adds <C>sampleCount</C> samples to the current window
+             * and publishes it when complete.
+             *
+             * @param[in] sampleCount  the number of samples per
+             *                         channel measured
+             */
+            void _advanceWindow (IN Natural sampleCount);
+
+    };
+
+}
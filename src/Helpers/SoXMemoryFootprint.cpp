@@ -0,0 +1,75 @@
+/**
+ * @file
+ * The <C>SoXMemoryFootprint</C> body implements the memory
+ * footprint of an effect instance broken down by kind of storage.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXMemoryFootprint.h"
+#include "StringUtil.h"
+
+/*--------------------*/
+
+using SoXPlugins::Helpers::SoXMemoryFootprint;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
+
+/*====================*/
+
+SoXMemoryFootprint::SoXMemoryFootprint ()
+    : delayLineByteCount{0},
+      ringBufferByteCount{0},
+      parameterMapByteCount{0},
+      descriptorByteCount{0}
+{
+}
+
+/*--------------------*/
+
+String SoXMemoryFootprint::toString () const
+{
+    return STR::expand("SoXMemoryFootprint(total = %1,"
+                       " delayLines = %2, ringBuffers = %3,"
+                       " parameterMap = %4, descriptor = %5)",
+                       TOSTRING(totalByteCount()),
+                       TOSTRING(delayLineByteCount),
+                       TOSTRING(ringBufferByteCount),
+                       TOSTRING(parameterMapByteCount),
+                       TOSTRING(descriptorByteCount));
+}
+
+/*--------------------*/
+
+Natural SoXMemoryFootprint::totalByteCount () const
+{
+    return (delayLineByteCount + ringBufferByteCount
+            + parameterMapByteCount + descriptorByteCount);
+}
+
+/*--------------------*/
+
+SoXMemoryFootprint&
+SoXMemoryFootprint::operator+= (IN SoXMemoryFootprint& other)
+{
+    delayLineByteCount    += other.delayLineByteCount;
+    ringBufferByteCount   += other.ringBufferByteCount;
+    parameterMapByteCount += other.parameterMapByteCount;
+    descriptorByteCount   += other.descriptorByteCount;
+    return *this;
+}
+
+/*--------------------*/
+
+Natural SoXMemoryFootprint::stringByteCount (IN String& st)
+{
+    /* short strings are held within the string object */
+    const size_t capacity = st.capacity();
+    return Natural{capacity < sizeof(String) ? 0 : capacity + 1};
+}
@@ -0,0 +1,121 @@
+/**
+ * @file
+ * The <C>SoXMemoryFootprint</C> specification defines the memory
+ * footprint of an effect instance broken down by kind of storage.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "MyString.h"
+#include "Natural.h"
+
+/*--------------------*/
+
+using BaseTypes::Primitives::Natural;
+using BaseTypes::Primitives::String;
+
+/*====================*/
+
+namespace SoXPlugins::Helpers {
+
+    /**
+     * A <C>SoXMemoryFootprint</C> object tells the number of bytes
+     * an effect instance occupies on the heap broken down by delay
+     * lines, ring buffers, parameter map and descriptor; the
+     * descriptor part covers the effect descriptor together with
+     * all other state and working buffers owned by it.  The counts
+     * are based on the capacities of the containers, hence they are
+     * close to but not exactly the bytes taken from the allocator.
+     */
+    struct SoXMemoryFootprint {
+
+        /** the bytes in delay lines */
+        Natural delayLineByteCount;
+
+        /** the bytes in ring buffers (like lookahead buffers) */
+        Natural ringBufferByteCount;
+
+        /** the bytes in the parameter map */
+        Natural parameterMapByteCount;
+
+        /** the bytes in the effect descriptor and its other
+         * buffers */
+        Natural descriptorByteCount;
+
+        /*--------------------*/
+        /*--------------------*/
+
+        /**
+         * Makes an empty footprint.
+         */
+        SoXMemoryFootprint ();
+
+        /*--------------------*/
+
+        /**
+         * Returns string representation of footprint
+         *
+         * @return string representation
+         */
+        String toString () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the total number of bytes of footprint.
+         *
+         * @return  sum of all parts
+         */
+        Natural totalByteCount () const;
+
+        /*--------------------*/
+
+        /**
+         * Adds all parts of <C>other</C> to this footprint.
+         *
+         * @param[in] other  footprint to be added
+         * @return  this footprint
+         */
+        SoXMemoryFootprint& operator+= (IN SoXMemoryFootprint& other);
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of bytes allocated by list-like
+         * container <C>list</C> for its elements (not counting
+         * memory referenced by the elements).
+         *
+         * @param[in] list  container with a capacity
+         * @return  count of bytes for elements
+         */
+        template <typename ListType>
+        static Natural listByteCount (IN ListType& list)
+        {
+            using ElementType = typename ListType::value_type;
+            return Natural{list.capacity() * sizeof(ElementType)};
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of bytes allocated by <C>st</C> outside
+         * of the string object itself (zero for short strings held
+         * inside the object).
+         *
+         * @param[in] st  string to be checked
+         * @return  count of bytes for characters
+         */
+        static Natural stringByteCount (IN String& st);
+
+    };
+
+}
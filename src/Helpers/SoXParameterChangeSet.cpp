@@ -0,0 +1,109 @@
+/**
+ * @file
+ * The <C>SoXParameterChangeSet</C> body implements a lock-free set
+ * of pending parameter change kinds per parameter for coalescing
+ * change notifications.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXParameterChangeSet.h"
+
+/*--------------------*/
+
+using SoXPlugins::Helpers::SoXParameterChangeSet;
+
+/*====================*/
+
+/**
+ * Returns the bit of <C>kind</C> in a change kind set.
+ *
+ * @param[in] kind  change kind
+ * @return  bit mask for kind
+ */
+static unsigned _kindBit (IN SoXParameterValueChangeKind kind)
+{
+    return 1u << (unsigned) kind;
+}
+
+/*============================================================*/
+
+/*--------------------*/
+/* setup              */
+/*--------------------*/
+
+SoXParameterChangeSet::SoXParameterChangeSet ()
+    : _kindSetArray{},
+      _length{0},
+      _someSlotIsChanged{false}
+{
+}
+
+/*--------------------*/
+
+void SoXParameterChangeSet::setLength (IN Natural count)
+{
+    _kindSetArray.reset(new std::atomic<unsigned>[(size_t) count]);
+    _length = count;
+
+    for (size_t i = 0;  i < (size_t) count;  i++) {
+        _kindSetArray[i].store(0, std::memory_order_relaxed);
+    }
+
+    _someSlotIsChanged.store(false);
+}
+
+/*--------------------*/
+/* property queries   */
+/*--------------------*/
+
+Natural SoXParameterChangeSet::length () const
+{
+    return _length;
+}
+
+/*--------------------*/
+
+Boolean SoXParameterChangeSet::contains (IN Natural kindSet,
+                                         IN SoXParameterValueChangeKind kind)
+{
+    return (((size_t) kindSet & _kindBit(kind)) != 0);
+}
+
+/*--------------------*/
+/* producer side      */
+/*--------------------*/
+
+void SoXParameterChangeSet::mark (IN Natural index,
+                                  IN SoXParameterValueChangeKind kind)
+{
+    if (index < _length) {
+        _kindSetArray[(size_t) index].fetch_or(_kindBit(kind),
+                                               std::memory_order_release);
+        _someSlotIsChanged.store(true, std::memory_order_release);
+    }
+}
+
+/*--------------------*/
+/* consumer side      */
+/*--------------------*/
+
+Boolean SoXParameterChangeSet::takeChangeIndication ()
+{
+    return _someSlotIsChanged.exchange(false, std::memory_order_acquire);
+}
+
+/*--------------------*/
+
+Natural SoXParameterChangeSet::take (IN Natural index)
+{
+    const unsigned kindSet =
+        _kindSetArray[(size_t) index].exchange(0,
+                                               std::memory_order_acquire);
+    return Natural{(size_t) kindSet};
+}
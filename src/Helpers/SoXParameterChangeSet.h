@@ -0,0 +1,149 @@
+/**
+ * @file
+ * The <C>SoXParameterChangeSet</C> specification defines a lock-free
+ * set of pending parameter change kinds per parameter for coalescing
+ * change notifications.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include <atomic>
+#include <memory>
+#include "Natural.h"
+#include "SoXParameterValueChangeKind.h"
+
+/*--------------------*/
+
+using BaseTypes::Primitives::Boolean;
+using BaseTypes::Primitives::Natural;
+using SoXPlugins::Helpers::SoXParameterValueChangeKind;
+
+/*====================*/
+
+namespace SoXPlugins::Helpers {
+
+    /**
+     * A <C>SoXParameterChangeSet</C> object records for each
+     * parameter index the set of change kinds occurred since the
+     * consumer has taken them (the dirty bits of that parameter).
+     * Marking a change never waits and may be done from any thread;
+     * a single consumer (like an editor timer) takes the change
+     * kinds at its own rate, such that many changes of a parameter
+     * in between are coalesced into a single notification.
+     */
+    struct SoXParameterChangeSet {
+
+        /*--------------------*/
+        /* setup              */
+        /*--------------------*/
+
+        /**
+         * Makes an empty change set without any parameter slots.
+         */
+        SoXParameterChangeSet ();
+
+        /*--------------------*/
+
+        SoXParameterChangeSet (IN SoXParameterChangeSet&) = delete;
+
+        /*--------------------*/
+
+        /**
+         * Sets the number of parameter slots to <C>count</C> with
+         * no changes recorded; must not be called concurrently with
+         * any other operation.
+         *
+         * @param[in] count  new number of parameter slots
+         */
+        void setLength (IN Natural count);
+
+        /*--------------------*/
+        /* property queries   */
+        /*--------------------*/
+
+        /**
+         * Returns the number of parameter slots.
+         *
+         * @return  count of slots
+         */
+        Natural length () const;
+
+        /*--------------------*/
+
+        /**
+         * Tells whether change kind set <C>kindSet</C> (as returned
+         * by <C>take</C>) contains <C>kind</C>.
+         *
+         * @param[in] kindSet  set of change kinds
+         * @param[in] kind     change kind to be checked
+         * @return  information whether kind is in set
+         */
+        static Boolean contains (IN Natural kindSet,
+                                 IN SoXParameterValueChangeKind kind);
+
+        /*--------------------*/
+        /* producer side      */
+        /*--------------------*/
+
+        /**
+         * Records a change of kind <C>kind</C> for the parameter at
+         * <C>index</C>; an index out of range is ignored.
+         *
+         * @param[in] index  index of parameter slot
+         * @param[in] kind   kind of change
+         */
+        void mark (IN Natural index, IN SoXParameterValueChangeKind kind);
+
+        /*--------------------*/
+        /* consumer side      */
+        /*--------------------*/
+
+        /**
+         * Tells whether some change has been recorded since the last
+         * call and resets this information; the consumer must then
+         * check all slots via <C>take</C>.
+         *
+         * @return  information whether some slot might be changed
+         */
+        Boolean takeChangeIndication ();
+
+        /*--------------------*/
+
+        /**
+         * Returns the set of change kinds recorded for the parameter
+         * at <C>index</C> since the last call and clears it; the
+         * result is zero when there was no change.
+         *
+         * @param[in] index  index of parameter slot
+         * @return  set of change kinds (to be checked by
+         *          <C>contains</C>)
+         */
+        Natural take (IN Natural index);
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the change kind sets of all parameters as bit sets */
+            std::unique_ptr<std::atomic<unsigned>[]> _kindSetArray;
+
+            /** the number of parameter slots */
+            Natural _length;
+
+            /** tells whether some change has been recorded since
+             * the last change indication */
+            std::atomic<bool> _someSlotIsChanged;
+
+    };
+
+}
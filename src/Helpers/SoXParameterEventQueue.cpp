@@ -0,0 +1,125 @@
+/**
+ * @file
+ * The <C>SoXParameterEventQueue</C> body implements a bounded queue
+ * of timestamped parameter changes handed from arbitrary threads to
+ * the audio thread.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-01
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXParameterEventQueue.h"
+
+#include <utility>
+#include "Logging.h"
+#include "SoXRealtimeGuard.h"
+
+/*--------------------*/
+
+using SoXPlugins::Helpers::SoXParameterEvent;
+using SoXPlugins::Helpers::SoXParameterEventQueue;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
+
+/*====================*/
+
+/*--------------------*/
+/* parameter event    */
+/*--------------------*/
+
+String SoXParameterEvent::toString () const
+{
+    return STR::expand("SoXParameterEvent(timePosition = %1,"
+                       " parameterName = %2, value = %3,"
+                       " recalculationIsForced = %4, changeKind = %5)",
+                       TOSTRING(timePosition), parameterName, value,
+                       TOSTRING(recalculationIsForced),
+                       SoXParameterValueChangeKind_toString(changeKind));
+}
+
+/*--------------------*/
+/* event queue        */
+/*--------------------*/
+
+SoXParameterEventQueue::SoXParameterEventQueue (IN Natural capacity)
+    : _eventList{},
+      _firstIndex{0},
+      _count{0}
+{
+    _eventList.setLength(Natural::maximum(1, capacity));
+}
+
+/*--------------------*/
+
+String SoXParameterEventQueue::toString () const
+{
+    std::lock_guard<std::mutex> lock{_mutex};
+    return STR::expand("SoXParameterEventQueue(capacity = %1,"
+                       " firstIndex = %2, count = %3)",
+                       TOSTRING(_eventList.length()),
+                       TOSTRING(_firstIndex), TOSTRING(_count));
+}
+
+/*--------------------*/
+
+Boolean SoXParameterEventQueue::push (INOUT SoXParameterEvent& event)
+{
+    Logging_trace1(">>: %1", event.toString());
+
+    SoXRealtimeGuard_noteLock("SoXParameterEventQueue.push");
+    std::lock_guard<std::mutex> lock{_mutex};
+    const Natural capacity = _eventList.length();
+    const Boolean isAppended = (_count < capacity);
+
+    if (isAppended) {
+        std::swap(_eventList[(_firstIndex + _count) % capacity], event);
+        _count++;
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(isAppended));
+    return isAppended;
+}
+
+/*--------------------*/
+
+Boolean
+SoXParameterEventQueue::tryGetNextTimePosition (OUT Real& timePosition)
+{
+    Boolean isFound = false;
+    std::unique_lock<std::mutex> lock{_mutex, std::try_to_lock};
+
+    if (lock.owns_lock() && _count > 0) {
+        timePosition = _eventList[_firstIndex].timePosition;
+        isFound = true;
+    }
+
+    return isFound;
+}
+
+/*--------------------*/
+
+Boolean SoXParameterEventQueue::tryPop (IN Real timeLimit,
+                                        INOUT SoXParameterEvent& event)
+{
+    Boolean isFound = false;
+    std::unique_lock<std::mutex> lock{_mutex, std::try_to_lock};
+
+    if (lock.owns_lock() && _count > 0) {
+        SoXParameterEvent& firstEvent = _eventList[_firstIndex];
+
+        if (firstEvent.timePosition <= timeLimit) {
+            /* swap contents, so that no string is copied */
+            std::swap(event, firstEvent);
+            _firstIndex = (_firstIndex + 1) % _eventList.length();
+            _count--;
+            isFound = true;
+        }
+    }
+
+    return isFound;
+}
@@ -0,0 +1,165 @@
+/**
+ * @file
+ * The <C>SoXParameterEventQueue</C> specification defines a bounded
+ * queue of timestamped parameter changes handed from arbitrary
+ * threads to the audio thread.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-01
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include <mutex>
+#include "GenericList.h"
+#include "MyString.h"
+#include "Natural.h"
+#include "Real.h"
+#include "SoXParameterValueChangeKind.h"
+
+/*--------------------*/
+
+using BaseTypes::GenericTypes::GenericList;
+using BaseTypes::Primitives::Boolean;
+using BaseTypes::Primitives::Natural;
+using BaseTypes::Primitives::Real;
+using BaseTypes::Primitives::String;
+using SoXPlugins::Helpers::SoXParameterValueChangeKind;
+
+/*====================*/
+
+namespace SoXPlugins::Helpers {
+
+    /**
+     * A <C>SoXParameterEvent</C> object is a change of an effect
+     * parameter to be applied at some time position.
+     */
+    struct SoXParameterEvent {
+
+        /** the time position (in seconds) where the change takes
+         * effect; minus infinity means as soon as possible */
+        Real timePosition{-Real::infinity};
+
+        /** the name of the parameter */
+        String parameterName;
+
+        /** the new value of the parameter */
+        String value;
+
+        /** tells whether dependent settings must be recalculated */
+        Boolean recalculationIsForced{true};
+
+        /** the kind of change reported by the effect (only set when
+         * the event has been applied) */
+        SoXParameterValueChangeKind changeKind{
+            SoXParameterValueChangeKind::parameterChange
+        };
+
+        /*--------------------*/
+
+        /**
+         * Returns string representation of event
+         *
+         * @return string representation
+         */
+        String toString () const;
+
+    };
+
+    /*--------------------*/
+
+    /**
+     * A <C>SoXParameterEventQueue</C> object is a bounded FIFO of
+     * parameter events.  Any thread may push events; the consumer
+     * (typically the audio thread) only tries to acquire the queue
+     * lock and never waits for it.  Events are handed in and out by
+     * swapping their contents with a caller-supplied event, hence
+     * neither pushing nor consuming an event copies strings once the
+     * slots have been used.
+     */
+    struct SoXParameterEventQueue {
+
+        /**
+         * Makes empty queue with <C>capacity</C> event slots.
+         *
+         * @param[in] capacity  maximum number of pending events
+         */
+        SoXParameterEventQueue (IN Natural capacity = 256);
+
+        /*--------------------*/
+
+        /**
+         * Returns string representation of queue
+         *
+         * @return string representation
+         */
+        String toString () const;
+
+        /*--------------------*/
+
+        /**
+         * Appends <C>event</C> at the end of the queue by swapping
+         * its contents with a free slot (so <C>event</C> is
+         * undefined afterwards); waits for the queue lock.
+         *
+         * @param[inout] event  event to be appended
+         * @return  information whether event has been appended, false
+         *          when queue is full
+         */
+        Boolean push (INOUT SoXParameterEvent& event);
+
+        /*--------------------*/
+
+        /**
+         * Tells the time position of the first pending event without
+         * waiting for the queue lock.
+         *
+         * @param[out] timePosition  time position of first event (if
+         *                           any)
+         * @return  information whether an event is pending and the
+         *          lock could be acquired
+         */
+        Boolean tryGetNextTimePosition (OUT Real& timePosition);
+
+        /*--------------------*/
+
+        /**
+         * Removes the first pending event when its time position does
+         * not exceed <C>timeLimit</C> and returns it in
+         * <C>event</C>; does not wait for the queue lock.
+         *
+         * @param[in]    timeLimit  latest time position of an event
+         *                          to be removed
+         * @param[inout] event      event receiving the contents of
+         *                          the removed event
+         * @return  information whether an event has been removed
+         */
+        Boolean tryPop (IN Real timeLimit,
+                        INOUT SoXParameterEvent& event);
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the ring of event slots */
+            GenericList<SoXParameterEvent> _eventList;
+
+            /** the index of the first pending event */
+            Natural _firstIndex;
+
+            /** the number of pending events */
+            Natural _count;
+
+            /** the lock protecting the queue */
+            mutable std::mutex _mutex;
+
+    };
+
+}
@@ -0,0 +1,192 @@
+/**
+ * @file
+ * The <C>SoXParameterSlotExchange</C> specification defines a
+ * wait-free handoff of the latest values of a fixed set of
+ * parameters from arbitrary producer threads to a single consumer
+ * thread.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include <atomic>
+#include <memory>
+#include "Natural.h"
+
+/*--------------------*/
+
+using BaseTypes::Primitives::Boolean;
+using BaseTypes::Primitives::Natural;
+
+/*====================*/
+
+namespace SoXPlugins::Helpers {
+
+    /**
+     * A <C>SoXParameterSlotExchange</C> object has one slot per
+     * parameter index holding a value of type <C>T</C> and a flag
+     * telling whether the slot has been changed since the consumer
+     * has taken it.  Producers (like the host automation calling
+     * from any thread) overwrite the slot value and set the flags,
+     * the consumer (like the audio thread at block start) takes the
+     * changed slots; no side ever waits and nothing is allocated
+     * after <C>setLength</C>.  When a slot is set several times
+     * before it is taken, only the latest value is seen.
+     *
+     * @tparam T  type of slot value (must be trivially copyable,
+     *            such that atomic access is lock-free)
+     */
+    template<typename T>
+    struct SoXParameterSlotExchange {
+
+        /**
+         * Makes exchange without any slots.
+         */
+        SoXParameterSlotExchange ()
+            : _slotArray{},
+              _length{0},
+              _someSlotIsChanged{false}
+        {
+        }
+
+        /*--------------------*/
+
+        SoXParameterSlotExchange (IN SoXParameterSlotExchange&) = delete;
+
+        /*--------------------*/
+        /* configuration      */
+        /*--------------------*/
+
+        /**
+         * Sets the number of slots to <C>count</C> with all slots
+         * unchanged; must not be called concurrently with any other
+         * operation.
+         *
+         * @param[in] count  new number of slots
+         */
+        void setLength (IN Natural count)
+        {
+            _slotArray.reset(new _Slot[(size_t) count]);
+            _length = count;
+
+            for (size_t i = 0;  i < (size_t) count;  i++) {
+                _slotArray[i].value.store(T{}, std::memory_order_relaxed);
+                _slotArray[i].isChanged.store(false,
+                                              std::memory_order_relaxed);
+            }
+
+            _someSlotIsChanged.store(false);
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of slots.
+         *
+         * @return  count of slots
+         */
+        Natural length () const
+        {
+            return _length;
+        }
+
+        /*--------------------*/
+        /* producer side      */
+        /*--------------------*/
+
+        /**
+         * Sets slot at <C>index</C> to <C>value</C> and marks it as
+         * changed; an index out of range is ignored.
+         *
+         * @param[in] index  index of slot
+         * @param[in] value  new value of slot
+         */
+        void set (IN Natural index, IN T value)
+        {
+            if (index < _length) {
+                _Slot& slot = _slotArray[(size_t) index];
+                slot.value.store(value, std::memory_order_relaxed);
+                slot.isChanged.store(true, std::memory_order_release);
+                _someSlotIsChanged.store(true, std::memory_order_release);
+            }
+        }
+
+        /*--------------------*/
+        /* consumer side      */
+        /*--------------------*/
+
+        /**
+         * Tells whether some slot has been changed since the last
+         * call and resets this information; the consumer must then
+         * check all slots via <C>tryTake</C>.
+         *
+         * @return  information whether some slot might be changed
+         */
+        Boolean takeChangeIndication ()
+        {
+            return _someSlotIsChanged.exchange(false,
+                                               std::memory_order_acquire);
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns value of slot at <C>index</C> in <C>value</C> when
+         * it has been changed since it has been taken last time and
+         * marks it as unchanged; tells whether the slot has been
+         * changed.
+         *
+         * @param[in]  index  index of slot
+         * @param[out] value  latest value of slot (if changed)
+         * @return  information whether slot has been changed
+         */
+        Boolean tryTake (IN Natural index, OUT T& value)
+        {
+            _Slot& slot = _slotArray[(size_t) index];
+            const Boolean isChanged =
+                slot.isChanged.exchange(false, std::memory_order_acquire);
+
+            if (isChanged) {
+                value = slot.value.load(std::memory_order_relaxed);
+            }
+
+            return isChanged;
+        }
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** a single slot with its value and change flag */
+            struct _Slot {
+
+                /** the latest value */
+                std::atomic<T> value;
+
+                /** tells whether value has not yet been taken */
+                std::atomic<bool> isChanged;
+
+            };
+
+            /** the slots of all parameters */
+            std::unique_ptr<_Slot[]> _slotArray;
+
+            /** the number of slots */
+            Natural _length;
+
+            /** tells whether some slot has been changed since the
+             * last change indication */
+            std::atomic<bool> _someSlotIsChanged;
+
+    };
+
+}
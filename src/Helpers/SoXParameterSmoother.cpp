@@ -0,0 +1,22 @@
+/**
+ * @file
+ * The <C>SoXParameterSmoother</C> body implements ramps for effect
+ * parameters <I>(this is the formal CPP file used when not doing
+ * inlining in production code)</I>.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-01
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXParameterSmoother.h"
+
+/*====================*/
+
+#ifdef DEBUG
+    /* module implementation contains functions */
+    #include "SoXParameterSmoother.cpp-inc"
+#endif
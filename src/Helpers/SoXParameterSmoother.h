@@ -0,0 +1,352 @@
+/**
+ * @file
+ * The <C>SoXParameterSmoother</C> specification defines ramps for
+ * effect parameters: a scalar smoother with linear or exponential
+ * ramps for gains and a coefficient ramp for biquad filters
+ * interpolating once per sub-block.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-01
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "MyString.h"
+#include "Natural.h"
+#include "Real.h"
+
+/*--------------------*/
+
+using BaseTypes::Primitives::Boolean;
+using BaseTypes::Primitives::Natural;
+using BaseTypes::Primitives::Real;
+using BaseTypes::Primitives::String;
+
+/*====================*/
+
+namespace SoXPlugins::Helpers {
+
+    /**
+     * The <C>SoXRampKind</C> type is the enumeration of the
+     * shapes of a parameter ramp.
+     */
+    enum class SoXRampKind : int {
+        linear, exponential
+    };
+
+    /*--------------------*/
+
+    /**
+     * Returns the number of samples of a ramp with
+     * <C>rampDuration</C> seconds for <C>sampleRate</C>.
+     *
+     * @param[in] sampleRate    sample rate of effect
+     * @param[in] rampDuration  duration of ramp (in seconds)
+     * @return  number of samples in ramp
+     */
+    Natural SoXRamp_sampleCount (IN Real sampleRate,
+                                 IN Real rampDuration);
+
+    /*====================*/
+
+    /**
+     * A <C>SoXScalarSmoother</C> object moves a scalar parameter
+     * (like a gain factor) from its current value to a target value
+     * within a fixed number of samples.  The ramp is either linear
+     * or exponential; the latter needs nonzero values of equal sign
+     * and otherwise falls back to a linear ramp.  The ramp steps are
+     * calculated when the target changes, hence stepping is a single
+     * addition or multiplication per sample.
+     */
+    struct SoXScalarSmoother {
+
+        /**
+         * Makes smoother with ramp shape <C>kind</C> at value
+         * zero; as long as the ramp length is zero, all target
+         * changes are applied immediately.
+         *
+         * @param[in] kind  shape of ramp
+         */
+        SoXScalarSmoother (IN SoXRampKind kind = SoXRampKind::linear);
+
+        /*--------------------*/
+
+        /**
+         * Returns string representation of smoother
+         *
+         * @return string representation
+         */
+        String toString () const;
+
+        /*--------------------*/
+        /* property queries   */
+        /*--------------------*/
+
+        /**
+         * Returns the current value of the smoother.
+         *
+         * @return  current value
+         */
+        Real currentValue () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the value the smoother is moving to.
+         *
+         * @return  target value
+         */
+        Real targetValue () const;
+
+        /*--------------------*/
+
+        /**
+         * Tells whether the smoother has not yet reached its target.
+         *
+         * @return  information whether a ramp is in progress
+         */
+        Boolean isRamping () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of samples until the target is reached.
+         *
+         * @return  remaining length of current ramp (zero when not
+         *          ramping)
+         */
+        Natural remainingSampleCount () const;
+
+        /*--------------------*/
+        /* change             */
+        /*--------------------*/
+
+        /**
+         * Sets number of samples of a ramp to <C>sampleCount</C>
+         * and jumps to the target value.
+         *
+         * @param[in] sampleCount  number of samples in a ramp (zero
+         *                         disables smoothing)
+         */
+        void setRampLength (IN Natural sampleCount);
+
+        /*--------------------*/
+
+        /**
+         * Sets the target value to <C>value</C>; the smoother ramps
+         * towards it when a ramp length is set, otherwise the value
+         * is taken immediately.
+         *
+         * @param[in] value  new target value
+         */
+        void setTarget (IN Real value);
+
+        /*--------------------*/
+
+        /**
+         * Jumps to the target value ending any ramp.
+         */
+        void finish ();
+
+        /*--------------------*/
+
+        /**
+         * Advances smoother by one sample and returns the new
+         * current value.
+         *
+         * @return  value for current sample
+         */
+        Real next ();
+
+        /*--------------------*/
+
+        /**
+         * Advances smoother by <C>sampleCount</C> samples.
+         *
+         * @param[in] sampleCount  number of samples to skip
+         */
+        void skip (IN Natural sampleCount);
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the shape of the ramps */
+            SoXRampKind _kind;
+
+            /** the number of samples in a ramp */
+            Natural _rampLength;
+
+            /** the current value */
+            Real _currentValue;
+
+            /** the target value */
+            Real _targetValue;
+
+            /** the per-sample increment (linear) or factor
+             * (exponential) of the current ramp */
+            Real _step;
+
+            /** tells whether current ramp is multiplicative */
+            Boolean _isMultiplicative;
+
+            /** the number of samples until the target is reached */
+            Natural _remainingSampleCount;
+
+    };
+
+    /*====================*/
+
+    /**
+     * A <C>SoXFilterCoefficientRamp</C> object moves the six
+     * coefficients of a biquad filter linearly to target values.
+     * The coefficients are meant to be updated only once per
+     * sub-block of <C>subBlockLength()</C> samples, so no
+     * coefficient calculation is done per sample.
+     */
+    struct SoXFilterCoefficientRamp {
+
+        /**
+         * Makes coefficient ramp for a null filter; as long as the
+         * ramp length is zero, all target changes are applied
+         * immediately.
+         */
+        SoXFilterCoefficientRamp ();
+
+        /*--------------------*/
+
+        /**
+         * Returns string representation of ramp
+         *
+         * @return string representation
+         */
+        String toString () const;
+
+        /*--------------------*/
+        /* property queries   */
+        /*--------------------*/
+
+        /**
+         * Tells whether the coefficients have not yet reached their
+         * targets.
+         *
+         * @return  information whether a ramp is in progress
+         */
+        Boolean isRamping () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns number of samples processed with the same
+         * coefficients during a ramp.
+         *
+         * @return  sub-block length
+         */
+        Natural subBlockLength () const;
+
+        /*--------------------*/
+
+        /**
+         * Gets the current coefficients.
+         *
+         * @param[out] b0  filter coefficient b0
+         * @param[out] b1  filter coefficient b1
+         * @param[out] b2  filter coefficient b2
+         * @param[out] a0  filter coefficient a0
+         * @param[out] a1  filter coefficient a1
+         * @param[out] a2  filter coefficient a2
+         */
+        void getCurrent (OUT Real& b0, OUT Real& b1, OUT Real& b2,
+                         OUT Real& a0, OUT Real& a1, OUT Real& a2) const;
+
+        /*--------------------*/
+        /* change             */
+        /*--------------------*/
+
+        /**
+         * Sets number of samples of a ramp to <C>sampleCount</C>
+         * and the number of samples per coefficient update to
+         * <C>subBlockLength</C>; jumps to the target coefficients.
+         *
+         * @param[in] sampleCount     number of samples in a ramp
+         *                            (zero disables smoothing)
+         * @param[in] subBlockLength  number of samples per
+         *                            coefficient update
+         */
+        void setRampLength (IN Natural sampleCount,
+                            IN Natural subBlockLength = 32);
+
+        /*--------------------*/
+
+        /**
+         * Sets the target coefficients; the ramp moves towards
+         * them when a ramp length is set, otherwise they are taken
+         * immediately.
+         *
+         * @param[in] b0  filter coefficient b0
+         * @param[in] b1  filter coefficient b1
+         * @param[in] b2  filter coefficient b2
+         * @param[in] a0  filter coefficient a0
+         * @param[in] a1  filter coefficient a1
+         * @param[in] a2  filter coefficient a2
+         */
+        void setTarget (IN Real b0, IN Real b1, IN Real b2,
+                        IN Real a0, IN Real a1, IN Real a2);
+
+        /*--------------------*/
+
+        /**
+         * Jumps to the target coefficients ending any ramp.
+         */
+        void finish ();
+
+        /*--------------------*/
+
+        /**
+         * Advances ramp by <C>sampleCount</C> samples.
+         *
+         * @param[in] sampleCount  number of samples to skip
+         */
+        void advance (IN Natural sampleCount);
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the number of samples in a ramp */
+            Natural _rampLength;
+
+            /** the number of samples per coefficient update */
+            Natural _subBlockLength;
+
+            /** the current coefficients (b0, b1, b2, a0, a1, a2) */
+            Real _currentList[6];
+
+            /** the target coefficients (b0, b1, b2, a0, a1, a2) */
+            Real _targetList[6];
+
+            /** the per-sample increments of the coefficients */
+            Real _stepList[6];
+
+            /** the number of samples until the targets are
+             * reached */
+            Natural _remainingSampleCount;
+
+    };
+
+}
+
+/*============================================================*/
+
+#ifndef DEBUG
+    /* production code is inlined */
+    #include "SoXParameterSmoother.cpp-inc"
+#endif
@@ -0,0 +1,99 @@
+/**
+ * @file
+ * The <C>SoXPrecisionProfile</C> body implements the conversions and
+ * regression tolerances of the precision profiles of the effects.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXPrecisionProfile.h"
+
+#include "StringUtil.h"
+
+/*--------------------*/
+
+using SoXPlugins::Helpers::SoXPrecisionProfile;
+
+namespace Helpers = SoXPlugins::Helpers;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
+
+/*====================*/
+
+String Helpers::precisionProfileToString (IN SoXPrecisionProfile profile)
+{
+    String result;
+
+    switch (profile) {
+        case SoXPrecisionProfile::soxExact:
+            result = "soxExact";
+            break;
+
+        case SoXPrecisionProfile::highQuality:
+            result = "highQuality";
+            break;
+
+        default:
+            result = "fast";
+    }
+
+    return result;
+}
+
+/*--------------------*/
+
+Boolean Helpers::precisionProfileFromString
+                     (IN String& st,
+                      OUT SoXPrecisionProfile& profile)
+{
+    const String lowercaseName = STR::toLowercase(STR::strip(st));
+    Boolean isFound = true;
+
+    if (lowercaseName == "soxexact") {
+        profile = SoXPrecisionProfile::soxExact;
+    } else if (lowercaseName == "highquality") {
+        profile = SoXPrecisionProfile::highQuality;
+    } else if (lowercaseName == "fast") {
+        profile = SoXPrecisionProfile::fast;
+    } else {
+        isFound = false;
+    }
+
+    return isFound;
+}
+
+/*--------------------*/
+
+void Helpers::precisionProfileTolerance
+                  (IN SoXPrecisionProfile profile,
+                   OUT Real& maximumAbsoluteError,
+                   OUT Real& maximumRmsErrorInDb)
+{
+    /* the bounds are those found by the profile check of the test
+       program with some headroom: the high quality profile is
+       dominated by the phaser, whose fractional delays differ
+       audibly from the delays rounded by SoX, the fast profile by
+       the coarse phaser modulation, while the fast compander stays
+       below -80dB */
+    switch (profile) {
+        case SoXPrecisionProfile::soxExact:
+            maximumAbsoluteError = 0.0;
+            maximumRmsErrorInDb  = -400.0;
+            break;
+
+        case SoXPrecisionProfile::highQuality:
+            maximumAbsoluteError = 2.0E-1;
+            maximumRmsErrorInDb  = -40.0;
+            break;
+
+        default:
+            maximumAbsoluteError = 1.0E-1;
+            maximumRmsErrorInDb  = -70.0;
+    }
+}
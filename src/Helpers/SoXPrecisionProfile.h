@@ -0,0 +1,109 @@
+/**
+ * @file
+ * The <C>SoXPrecisionProfile</C> specification defines the precision
+ * profiles selecting between the exact SoX algorithms and faster
+ * approximations consistently for all effects of an instance or an
+ * offline rendering.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "MyString.h"
+#include "Real.h"
+
+/*--------------------*/
+
+using BaseTypes::Primitives::Boolean;
+using BaseTypes::Primitives::Real;
+using BaseTypes::Primitives::String;
+
+/*====================*/
+
+namespace SoXPlugins::Helpers {
+
+    /**
+     * The <C>SoXPrecisionProfile</C> is an enumeration type for the
+     * numerical profiles of the effects:
+     *
+     *  - <C>soxExact</C> (the default) evaluates the algorithms of
+     *    SoX exactly, such that a rendering is bit-identical to
+     *    earlier releases (for mastering),
+     *
+     *  - <C>highQuality</C> deviates from SoX where SoX itself
+     *    approximates: the phaser follows its modulation by
+     *    fractional delays and sine modulations are rendered by a
+     *    rotator instead of the interpolated wave table,
+     *
+     *  - <C>fast</C> trades accuracy for processing load: the
+     *    compander uses the fast logarithm and exponential and
+     *    evaluates its gains at control rate, and the modulation of
+     *    phaser and tremolo is only evaluated every 32 samples and
+     *    interpolated in between (for tracking and live use).
+     *
+     * Gain, overdrive, filters and reverb have no approximations, so
+     * all profiles give the same results for them (the economy
+     * quality of the reverb changes the sound and hence stays a
+     * parameter); the SIMD kernels give identical results for all
+     * instruction sets anyway.  The quality level of a load
+     * governor is applied on top of a profile.
+     */
+    enum class SoXPrecisionProfile {
+        soxExact, highQuality, fast
+    };
+
+    /*--------------------*/
+
+    /**
+     * Converts <C>profile</C> to a string ("soxExact",
+     * "highQuality" or "fast").
+     *
+     * @param[in] profile  precision profile to be converted
+     * @return string representation of <C>profile</C>
+     */
+    String precisionProfileToString (IN SoXPrecisionProfile profile);
+
+    /*--------------------*/
+
+    /**
+     * Converts <C>st</C> (a string representation of a profile,
+     * case is ignored) to <C>profile</C> and tells whether
+     * <C>st</C> has been a valid profile name; otherwise
+     * <C>profile</C> is unchanged.
+     *
+     * @param[in]  st       string representation of profile
+     * @param[out] profile  associated precision profile
+     * @return  information whether <C>st</C> is a profile name
+     */
+    Boolean precisionProfileFromString (IN String& st,
+                                        OUT SoXPrecisionProfile& profile);
+
+    /*--------------------*/
+
+    /**
+     * Returns the regression tolerances of <C>profile</C> for the
+     * deviation of a rendering from the SoX-exact rendering of the
+     * same signal: the maximum absolute sample error in
+     * <C>maximumAbsoluteError</C> and the maximum RMS error in
+     * decibels relative to full scale in
+     * <C>maximumRmsErrorInDb</C>; the SoX-exact profile must match
+     * exactly.
+     *
+     * @param[in]  profile               precision profile
+     * @param[out] maximumAbsoluteError  maximum absolute sample
+     *                                   error
+     * @param[out] maximumRmsErrorInDb   maximum RMS error in dB
+     */
+    void precisionProfileTolerance (IN SoXPrecisionProfile profile,
+                                    OUT Real& maximumAbsoluteError,
+                                    OUT Real& maximumRmsErrorInDb);
+
+}
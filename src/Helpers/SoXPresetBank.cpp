@@ -0,0 +1,726 @@
+/**
+ * @file
+ * The <C>SoXPresetBank</C> body implements a bank of named effect
+ * presets kept as decoded parameter snapshots and stored in a
+ * compact binary file with an index.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXPresetBank.h"
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include "ByteList.h"
+#include "File.h"
+#include "Integer.h"
+#include "Logging.h"
+
+/*--------------------*/
+
+using BaseModules::File;
+using BaseTypes::Containers::ByteList;
+using BaseTypes::Primitives::Integer;
+using SoXPlugins::Helpers::SoXPresetBank;
+using SoXPlugins::Helpers::SoXPresetParameter;
+using SoXPlugins::Helpers::SoXPresetParameterList;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
+
+/*====================*/
+
+namespace SoXPlugins::Helpers {
+
+    /** the magic number at the start of a bank file ("SoXP" when
+     * read little-endian) */
+    static const std::uint64_t _bankMagicNumber = 0x50586F53;
+
+    /** the current version of the bank file format */
+    static const std::uint64_t _bankVersion = 1;
+
+    /** the number of bytes of a parameter in the preset data
+     * (identification, kind and value) */
+    static const size_t _parameterByteCount = 4 + 1 + 8;
+
+    /*--------------------*/
+
+    /**
+     * A <C>_ByteReader</C> object decodes little-endian numbers and
+     * strings from a byte array; reading beyond the end yields zero
+     * values and clears <C>isOkay</C>.
+     */
+    struct _ByteReader {
+
+        /** the bytes to be decoded */
+        const std::uint8_t* data;
+
+        /** the number of bytes in <C>data</C> */
+        size_t length;
+
+        /** the position of the next byte to be read */
+        size_t position;
+
+        /** tells whether all reads so far have been within the
+         * data */
+        Boolean isOkay;
+
+        /*--------------------*/
+
+        /**
+         * Makes a reader for the <C>length</C> bytes at
+         * <C>data</C>.
+         *
+         * @param[in] data    the bytes to be decoded
+         * @param[in] length  the number of bytes
+         */
+        _ByteReader (IN std::uint8_t* data, IN size_t length)
+            : data{data},
+              length{length},
+              position{0},
+              isOkay{true}
+        {
+        }
+
+        /*--------------------*/
+
+        /**
+         * Tells whether <C>byteCount</C> bytes are available and
+         * clears the okay flag if not.
+         *
+         * @param[in] byteCount  the number of bytes requested
+         * @return  information whether bytes are available
+         */
+        Boolean isAvailable (IN size_t byteCount)
+        {
+            isOkay = isOkay && (byteCount <= length - position);
+            return isOkay;
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns the unsigned number in the next <C>byteCount</C>
+         * bytes.
+         *
+         * @param[in] byteCount  the number of bytes (at most eight)
+         * @return  decoded number (or zero beyond the end)
+         */
+        std::uint64_t readNumber (IN size_t byteCount)
+        {
+            std::uint64_t result = 0;
+
+            if (isAvailable(byteCount)) {
+                for (size_t i = byteCount;  i > 0;  i--) {
+                    result = (result << 8) | data[position + i - 1];
+                }
+
+                position += byteCount;
+            }
+
+            return result;
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns the double in the next eight bytes.
+         *
+         * @return  decoded double (or zero beyond the end)
+         */
+        double readDouble ()
+        {
+            const std::uint64_t bits = readNumber(8);
+            double result;
+            std::memcpy(&result, &bits, sizeof(result));
+            return result;
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns the string given by its length in four bytes
+         * followed by its characters.
+         *
+         * @return  decoded string (or empty string beyond the end)
+         */
+        String readString ()
+        {
+            const size_t characterCount = (size_t) readNumber(4);
+            String result;
+
+            if (isAvailable(characterCount)) {
+                result = String((const char*) &data[position],
+                                characterCount);
+                position += characterCount;
+            }
+
+            return result;
+        }
+
+    };
+
+    /*--------------------*/
+
+    /**
+     * A <C>_ByteWriter</C> object appends little-endian numbers and
+     * strings to a byte list.
+     */
+    struct _ByteWriter {
+
+        /** the bytes written */
+        ByteList byteList;
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of bytes written so far.
+         *
+         * @return  count of bytes
+         */
+        size_t length () const
+        {
+            return (size_t) byteList.length();
+        }
+
+        /*--------------------*/
+
+        /**
+         * Writes <C>value</C> into the <C>byteCount</C> bytes at
+         * <C>position</C> (which must have been written before).
+         *
+         * @param[in] position   the byte position in list
+         * @param[in] value      the number to be written
+         * @param[in] byteCount  the number of bytes (at most eight)
+         */
+        void writeNumberAt (IN size_t position,
+                            IN std::uint64_t value,
+                            IN size_t byteCount)
+        {
+            std::uint8_t* data = (std::uint8_t*) byteList.asArray();
+            std::uint64_t remainingValue = value;
+
+            for (size_t i = 0;  i < byteCount;  i++) {
+                data[position + i] = (std::uint8_t) (remainingValue & 0xFF);
+                remainingValue >>= 8;
+            }
+        }
+
+        /*--------------------*/
+
+        /**
+         * Appends <C>value</C> in <C>byteCount</C> bytes.
+         *
+         * @param[in] value      the number to be written
+         * @param[in] byteCount  the number of bytes (at most eight)
+         */
+        void appendNumber (IN std::uint64_t value, IN size_t byteCount)
+        {
+            const size_t position = length();
+            byteList.setLength(position + byteCount);
+            writeNumberAt(position, value, byteCount);
+        }
+
+        /*--------------------*/
+
+        /**
+         * Appends <C>value</C> in eight bytes.
+         *
+         * @param[in] value  the double to be written
+         */
+        void appendDouble (IN double value)
+        {
+            std::uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            appendNumber(bits, 8);
+        }
+
+        /*--------------------*/
+
+        /**
+         * Appends <C>st</C> as its length in four bytes followed by
+         * its characters.
+         *
+         * @param[in] st  the string to be written
+         */
+        void appendString (IN String& st)
+        {
+            const size_t characterCount = st.length();
+            appendNumber(characterCount, 4);
+            const size_t position = length();
+            byteList.setLength(position + characterCount);
+            std::memcpy((std::uint8_t*) byteList.asArray() + position,
+                        st.c_str(), characterCount);
+        }
+
+    };
+
+    /*--------------------*/
+
+    /**
+     * A <C>_BankDescriptor</C> object holds the presets of a bank
+     * together with an index from preset names to positions.
+     */
+    struct _BankDescriptor {
+
+        /** the name of the effect the presets belong to */
+        String effectName;
+
+        /** the names of the presets in index order */
+        StringList presetNameList;
+
+        /** the parameters of the presets in index order */
+        GenericList<SoXPresetParameterList> presetList;
+
+        /** the map from preset name to index */
+        std::map<String, Natural> nameToIndexMap;
+
+        /*--------------------*/
+
+        /**
+         * Makes an empty bank.
+         */
+        _BankDescriptor ()
+            : effectName{},
+              presetNameList{},
+              presetList{},
+              nameToIndexMap{}
+        {
+        }
+
+        /*--------------------*/
+
+        /**
+         * Removes all presets.
+         */
+        void clear ()
+        {
+            presetNameList.clear();
+            presetList.clear();
+            nameToIndexMap.clear();
+        }
+
+        /*--------------------*/
+
+        /**
+         * Appends preset named <C>presetName</C> with
+         * <C>parameterList</C> or replaces an existing preset with
+         * that name.
+         *
+         * @param[in] presetName     the name of the preset
+         * @param[in] parameterList  the parameters of the preset
+         */
+        void setPreset (IN String& presetName,
+                        IN SoXPresetParameterList& parameterList)
+        {
+            const auto iterator = nameToIndexMap.find(presetName);
+
+            if (iterator != nameToIndexMap.end()) {
+                presetList[iterator->second] = parameterList;
+            } else {
+                nameToIndexMap[presetName] = presetList.length();
+                presetNameList.append(presetName);
+                presetList.append(parameterList);
+            }
+        }
+
+    };
+
+    /*--------------------*/
+
+    /**
+     * Tells whether <C>parameter</C> fits to a parameter in
+     * <C>parameterMap</C>: its identification must be known, its
+     * kind must match and its value must be within range.
+     *
+     * @param[in] parameterMap  the parameters of the effect
+     * @param[in] parameter     the preset parameter to be checked
+     * @return  information whether parameter may be set
+     */
+    static Boolean
+    _isAllowedParameter (IN SoXEffectParameterMap& parameterMap,
+                         IN SoXPresetParameter& parameter)
+    {
+        const String& parameterName =
+            parameterMap.parameterName(parameter.parameterId);
+        const SoXEffectParameterKind kind =
+            (parameterName > "" ? parameterMap.kind(parameterName)
+             : SoXEffectParameterKind::unknownKind);
+        const Real value = parameter.value;
+        Boolean result = (kind == parameter.kind);
+
+        if (!result) {
+            /* unknown parameter or other kind */
+        } else if (kind == SoXEffectParameterKind::realKind) {
+            Real lowValue, highValue, delta;
+            parameterMap.valueRangeReal(parameterName,
+                                        lowValue, highValue, delta);
+            result = (value >= lowValue && value <= highValue);
+        } else if (kind == SoXEffectParameterKind::intKind) {
+            Integer lowValue, highValue, delta;
+            parameterMap.valueRangeInt(parameterName,
+                                       lowValue, highValue, delta);
+            result = (value == Real::round(value)
+                      && value >= Real{(double) (int) lowValue}
+                      && value <= Real{(double) (int) highValue});
+        } else {
+            StringList enumValueList;
+            parameterMap.valueRangeEnum(parameterName, enumValueList);
+            result = (value == Real::round(value)
+                      && value >= Real{0.0}
+                      && value < Real{(double) enumValueList.size()});
+        }
+
+        return result;
+    }
+
+}
+
+/*--------------------*/
+
+using SoXPlugins::Helpers::_BankDescriptor;
+using SoXPlugins::Helpers::_ByteReader;
+using SoXPlugins::Helpers::_ByteWriter;
+
+/*============================================================*/
+
+SoXPresetParameter::SoXPresetParameter ()
+    : parameterId{0},
+      kind{SoXEffectParameterKind::unknownKind},
+      value{0.0}
+{
+}
+
+/*--------------------*/
+
+String SoXPresetParameter::toString () const
+{
+    return STR::expand("SoXPresetParameter(id = %1, kind = %2,"
+                       " value = %3)",
+                       TOSTRING(parameterId),
+                       effectParameterKindToString(kind),
+                       TOSTRING(value));
+}
+
+/*============================================================*/
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+SoXPresetBank::SoXPresetBank ()
+{
+    Logging_trace(">>");
+    _descriptor = new _BankDescriptor();
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+SoXPresetBank::~SoXPresetBank ()
+{
+    Logging_trace(">>");
+    delete (_BankDescriptor*) _descriptor;
+    Logging_trace("<<");
+}
+
+/*-----------------------*/
+/* string representation */
+/*-----------------------*/
+
+String SoXPresetBank::toString () const
+{
+    const _BankDescriptor& descriptor =
+        TOREFERENCE<_BankDescriptor>(_descriptor);
+    return STR::expand("SoXPresetBank(effectName = %1,"
+                       " presetNameList = %2)",
+                       descriptor.effectName,
+                       descriptor.presetNameList.toString());
+}
+
+/*--------------------*/
+/* property access    */
+/*--------------------*/
+
+String SoXPresetBank::effectName () const
+{
+    const _BankDescriptor& descriptor =
+        TOREFERENCE<_BankDescriptor>(_descriptor);
+    return descriptor.effectName;
+}
+
+/*--------------------*/
+
+Natural SoXPresetBank::presetCount () const
+{
+    const _BankDescriptor& descriptor =
+        TOREFERENCE<_BankDescriptor>(_descriptor);
+    return descriptor.presetList.length();
+}
+
+/*--------------------*/
+
+String SoXPresetBank::presetName (IN Natural presetIndex) const
+{
+    const _BankDescriptor& descriptor =
+        TOREFERENCE<_BankDescriptor>(_descriptor);
+    return (presetIndex < descriptor.presetNameList.size()
+            ? descriptor.presetNameList[presetIndex] : String());
+}
+
+/*--------------------*/
+
+StringList SoXPresetBank::presetNameList () const
+{
+    const _BankDescriptor& descriptor =
+        TOREFERENCE<_BankDescriptor>(_descriptor);
+    return descriptor.presetNameList;
+}
+
+/*--------------------*/
+
+Boolean SoXPresetBank::findPreset (IN String& presetName,
+                                   OUT Natural& presetIndex) const
+{
+    const _BankDescriptor& descriptor =
+        TOREFERENCE<_BankDescriptor>(_descriptor);
+    const auto iterator = descriptor.nameToIndexMap.find(presetName);
+    const Boolean isFound = (iterator != descriptor.nameToIndexMap.end());
+    presetIndex = (isFound ? iterator->second : Natural{0});
+    return isFound;
+}
+
+/*--------------------*/
+
+const SoXPresetParameterList&
+SoXPresetBank::preset (IN Natural presetIndex) const
+{
+    const _BankDescriptor& descriptor =
+        TOREFERENCE<_BankDescriptor>(_descriptor);
+    return descriptor.presetList[presetIndex];
+}
+
+/*--------------------*/
+/* property change    */
+/*--------------------*/
+
+void SoXPresetBank::clear (IN String& effectName)
+{
+    Logging_trace1(">>: %1", effectName);
+
+    _BankDescriptor& descriptor =
+        TOREFERENCE<_BankDescriptor>(_descriptor);
+    descriptor.clear();
+    descriptor.effectName = effectName;
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXPresetBank::storePreset (IN String& presetName,
+                                 IN SoXEffectParameterMap& parameterMap)
+{
+    Logging_trace1(">>: %1", presetName);
+
+    _BankDescriptor& descriptor =
+        TOREFERENCE<_BankDescriptor>(_descriptor);
+    const StringList parameterNameList = parameterMap.parameterNameList();
+    SoXPresetParameterList parameterList;
+
+    /* keep the order of the parameter map, since some parameters
+       (like a band count) must be set before others */
+    for (const String& parameterName : parameterNameList) {
+        SoXPresetParameter parameter;
+        parameter.parameterId = parameterMap.parameterId(parameterName);
+        parameter.kind        = parameterMap.kind(parameterName);
+        parameter.value       =
+            parameterMap.numericValue(parameter.parameterId);
+        parameterList.append(parameter);
+    }
+
+    descriptor.setPreset(presetName, parameterList);
+
+    Logging_trace1("<<: parameterCount = %1",
+                   TOSTRING(parameterList.length()));
+}
+
+/*--------------------*/
+
+void
+SoXPresetBank::restrictToParameterMap (IN SoXEffectParameterMap& parameterMap)
+{
+    Logging_trace(">>");
+
+    _BankDescriptor& descriptor =
+        TOREFERENCE<_BankDescriptor>(_descriptor);
+
+    for (SoXPresetParameterList& parameterList : descriptor.presetList) {
+        SoXPresetParameterList allowedParameterList;
+
+        for (const SoXPresetParameter& parameter : parameterList) {
+            if (_isAllowedParameter(parameterMap, parameter)) {
+                allowedParameterList.append(parameter);
+            } else {
+                Logging_trace1("--: dropped %1", parameter.toString());
+            }
+        }
+
+        parameterList = allowedParameterList;
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* persistence        */
+/*--------------------*/
+
+Boolean SoXPresetBank::load (IN String& fileName,
+                             IN String& effectName)
+{
+    Logging_trace2(">>: fileName = %1, effectName = %2",
+                   fileName, effectName);
+
+    _BankDescriptor& descriptor =
+        TOREFERENCE<_BankDescriptor>(_descriptor);
+    File file;
+    ByteList byteList;
+    Boolean isOkay = file.open(fileName, "rb");
+
+    if (isOkay) {
+        /* the complete file is read at once and decoded from
+           memory */
+        const Natural fileLength = File::length(fileName);
+        byteList.setLength(fileLength);
+        isOkay = (file.readInto(byteList.asArray(), 0, fileLength)
+                  == fileLength);
+        file.close();
+    }
+
+    _ByteReader reader{(std::uint8_t*) byteList.asArray(),
+                       (size_t) byteList.length()};
+    _BankDescriptor newDescriptor;
+    StringList presetNameList;
+    GenericList<std::uint64_t> offsetList;
+    GenericList<std::uint64_t> lengthList;
+
+    if (isOkay) {
+        /* header and index */
+        isOkay = (reader.readNumber(4) == _bankMagicNumber
+                  && reader.readNumber(4) <= _bankVersion);
+        newDescriptor.effectName = reader.readString();
+        isOkay = isOkay && (newDescriptor.effectName == effectName);
+        const size_t presetCount = (size_t) reader.readNumber(4);
+
+        for (size_t i = 0;  isOkay && i < presetCount;  i++) {
+            presetNameList.append(reader.readString());
+            offsetList.append(reader.readNumber(8));
+            lengthList.append(reader.readNumber(4));
+            isOkay = reader.isOkay;
+        }
+    }
+
+    for (Natural i = 0;  isOkay && i < presetNameList.size();  i++) {
+        /* preset data as given by the index */
+        const size_t offset = (size_t) offsetList[i];
+        const size_t length = (size_t) lengthList[i];
+        isOkay = (offset <= reader.length
+                  && length <= reader.length - offset);
+
+        if (isOkay) {
+            _ByteReader presetReader{reader.data + offset, length};
+            const size_t parameterCount =
+                (size_t) presetReader.readNumber(4);
+            isOkay = presetReader.isAvailable(parameterCount
+                                              * _parameterByteCount);
+            SoXPresetParameterList parameterList;
+
+            for (size_t j = 0;  isOkay && j < parameterCount;  j++) {
+                SoXPresetParameter parameter;
+                parameter.parameterId =
+                    (size_t) presetReader.readNumber(4);
+                parameter.kind =
+                    (SoXEffectParameterKind) presetReader.readNumber(1);
+                parameter.value = Real{presetReader.readDouble()};
+                parameterList.append(parameter);
+            }
+
+            newDescriptor.setPreset(presetNameList[i], parameterList);
+        }
+    }
+
+    if (isOkay) {
+        descriptor.effectName     = newDescriptor.effectName;
+        descriptor.presetNameList = newDescriptor.presetNameList;
+        descriptor.presetList     = newDescriptor.presetList;
+        descriptor.nameToIndexMap = newDescriptor.nameToIndexMap;
+    }
+
+    Logging_trace2("<<: isOkay = %1, bank = %2",
+                   TOSTRING(isOkay), toString());
+    return isOkay;
+}
+
+/*--------------------*/
+
+Boolean SoXPresetBank::save (IN String& fileName) const
+{
+    Logging_trace1(">>: %1", fileName);
+
+    const _BankDescriptor& descriptor =
+        TOREFERENCE<_BankDescriptor>(_descriptor);
+    const Natural presetCount = descriptor.presetList.length();
+    _ByteWriter writer;
+
+    /* header and index with offsets to be filled in later */
+    writer.appendNumber(_bankMagicNumber, 4);
+    writer.appendNumber(_bankVersion, 4);
+    writer.appendString(descriptor.effectName);
+    writer.appendNumber((size_t) presetCount, 4);
+    GenericList<size_t> indexPositionList;
+
+    for (Natural i = 0;  i < presetCount;  i++) {
+        writer.appendString(descriptor.presetNameList[i]);
+        indexPositionList.append(writer.length());
+        writer.appendNumber(0, 8);
+        writer.appendNumber(0, 4);
+    }
+
+    /* preset data */
+    for (Natural i = 0;  i < presetCount;  i++) {
+        const SoXPresetParameterList& parameterList =
+            descriptor.presetList[i];
+        const size_t offset = writer.length();
+        writer.appendNumber((size_t) parameterList.length(), 4);
+
+        for (const SoXPresetParameter& parameter : parameterList) {
+            writer.appendNumber((size_t) parameter.parameterId, 4);
+            writer.appendNumber((std::uint64_t) parameter.kind, 1);
+            writer.appendDouble((double) parameter.value);
+        }
+
+        const size_t indexPosition = indexPositionList[i];
+        writer.writeNumberAt(indexPosition, offset, 8);
+        writer.writeNumberAt(indexPosition + 8,
+                             writer.length() - offset, 4);
+    }
+
+    File file;
+    Boolean isOkay = file.open(fileName, "wb");
+
+    if (isOkay) {
+        const Natural byteCount = writer.byteList.length();
+        isOkay = (file.write(writer.byteList, 0, byteCount) == byteCount);
+        file.close();
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
@@ -0,0 +1,281 @@
+/**
+ * @file
+ * The <C>SoXPresetBank</C> specification defines a bank of named
+ * effect presets kept as decoded parameter snapshots and stored in a
+ * compact binary file with an index.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "GenericList.h"
+#include "MyString.h"
+#include "Natural.h"
+#include "Object.h"
+#include "Real.h"
+#include "SoXEffectParameterMap.h"
+#include "StringList.h"
+
+/*--------------------*/
+
+using BaseTypes::Containers::StringList;
+using BaseTypes::GenericTypes::GenericList;
+using BaseTypes::Primitives::Boolean;
+using BaseTypes::Primitives::Natural;
+using BaseTypes::Primitives::Object;
+using BaseTypes::Primitives::Real;
+using BaseTypes::Primitives::String;
+using SoXPlugins::Helpers::SoXEffectParameterKind;
+using SoXPlugins::Helpers::SoXEffectParameterMap;
+
+/*====================*/
+
+namespace SoXPlugins::Helpers {
+
+    /**
+     * A <C>SoXPresetParameter</C> object holds the value of a single
+     * parameter in a preset in numeric form: the value itself for a
+     * real or integer parameter and the index in the value list for
+     * an enumeration parameter.
+     */
+    struct SoXPresetParameter {
+
+        /** the identification of the parameter in the parameter
+         * map */
+        Natural parameterId;
+
+        /** the kind of the parameter */
+        SoXEffectParameterKind kind;
+
+        /** the numeric value of the parameter */
+        Real value;
+
+        /*--------------------*/
+
+        /**
+         * Makes an unknown parameter with value zero.
+         */
+        SoXPresetParameter ();
+
+        /*--------------------*/
+
+        /**
+         * Returns string representation of preset parameter
+         *
+         * @return string representation
+         */
+        String toString () const;
+
+    };
+
+    /*--------------------*/
+
+    /** a list of parameters of a preset (in the order of the
+     * parameter map) */
+    using SoXPresetParameterList = GenericList<SoXPresetParameter>;
+
+    /*====================*/
+
+    /**
+     * A <C>SoXPresetBank</C> object holds a list of named presets
+     * for a single effect.  Each preset is kept as the list of the
+     * numeric parameter values ready for
+     * <C>SoXAudioEffect::setNumericValue</C>, so that switching to a
+     * preset needs neither string parsing nor range checks; presets
+     * are identified by their name or their index in the bank.
+     *
+     * A bank is stored in a binary file (all numbers little-endian):
+     * a header with magic number, version, effect name and preset
+     * count is followed by an index with name, byte offset and byte
+     * length per preset and then by the preset data with parameter
+     * identification, kind and value (as a double) per parameter.
+     * All operations allocate and must not be called on the audio
+     * thread.
+     */
+    struct SoXPresetBank {
+
+        /*--------------------*/
+        /* con-/destruction   */
+        /*--------------------*/
+
+        /**
+         * Makes an empty bank without effect name.
+         */
+        SoXPresetBank ();
+
+        /*--------------------*/
+
+        /**
+         * Destroys bank.
+         */
+        ~SoXPresetBank ();
+
+        /*--------------------*/
+
+        SoXPresetBank (IN SoXPresetBank&) = delete;
+
+        /*-----------------------*/
+        /* string representation */
+        /*-----------------------*/
+
+        /**
+         * Returns string representation of bank.
+         *
+         * @return string representation
+         */
+        String toString () const;
+
+        /*--------------------*/
+        /* property access    */
+        /*--------------------*/
+
+        /**
+         * Returns the name of the effect the presets belong to.
+         *
+         * @return  effect name
+         */
+        String effectName () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of presets in the bank.
+         *
+         * @return  count of presets
+         */
+        Natural presetCount () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the name of the preset with <C>presetIndex</C>
+         * (or an empty string for an unknown index).
+         *
+         * @param[in] presetIndex  the index of the preset
+         * @return  name of preset
+         */
+        String presetName (IN Natural presetIndex) const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the names of all presets in the bank in index
+         * order.
+         *
+         * @return  list of preset names
+         */
+        StringList presetNameList () const;
+
+        /*--------------------*/
+
+        /**
+         * Looks up the preset named <C>presetName</C> and returns
+         * its index in <C>presetIndex</C>; tells whether the preset
+         * exists.
+         *
+         * @param[in]  presetName   the name of the preset
+         * @param[out] presetIndex  the index of the preset
+         * @return  information whether preset is in bank
+         */
+        Boolean findPreset (IN String& presetName,
+                            OUT Natural& presetIndex) const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the parameters of the preset with
+         * <C>presetIndex</C>; the index must be valid.
+         *
+         * @param[in] presetIndex  the index of the preset
+         * @return  list of parameters of preset
+         */
+        const SoXPresetParameterList& preset (IN Natural presetIndex)
+            const;
+
+        /*--------------------*/
+        /* property change    */
+        /*--------------------*/
+
+        /**
+         * Removes all presets and sets the effect name to
+         * <C>effectName</C>.
+         *
+         * @param[in] effectName  the name of the effect of the bank
+         */
+        void clear (IN String& effectName);
+
+        /*--------------------*/
+
+        /**
+         * Stores the current values of all parameters in
+         * <C>parameterMap</C> as preset named <C>presetName</C>; an
+         * existing preset with that name is replaced, otherwise the
+         * preset is appended.
+         *
+         * @param[in] presetName    the name of the preset
+         * @param[in] parameterMap  the parameters of the effect
+         */
+        void storePreset (IN String& presetName,
+                          IN SoXEffectParameterMap& parameterMap);
+
+        /*--------------------*/
+
+        /**
+         * Restricts all presets to the parameters in
+         * <C>parameterMap</C>: parameters with unknown
+         * identification, a different kind or a value out of range
+         * are dropped, so that the remaining values can be set
+         * without further checks.
+         *
+         * @param[in] parameterMap  the parameters of the effect
+         */
+        void restrictToParameterMap (IN SoXEffectParameterMap& parameterMap);
+
+        /*--------------------*/
+        /* persistence        */
+        /*--------------------*/
+
+        /**
+         * Replaces the bank by the bank in binary form in the file
+         * named <C>fileName</C> and tells whether this has been
+         * successful; a bank for an effect other than
+         * <C>effectName</C> is rejected and on failure the bank is
+         * unchanged.
+         *
+         * @param[in] fileName    the name of the bank file
+         * @param[in] effectName  the name of the effect expected
+         * @return  information whether the file has been read
+         */
+        Boolean load (IN String& fileName, IN String& effectName);
+
+        /*--------------------*/
+
+        /**
+         * Writes the bank in binary form to the file named
+         * <C>fileName</C> and tells whether this has been
+         * successful.
+         *
+         * @param[in] fileName  the name of the bank file
+         * @return  information whether the file has been written
+         */
+        Boolean save (IN String& fileName) const;
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the internal data of the bank (private type) */
+            Object _descriptor;
+
+    };
+
+}
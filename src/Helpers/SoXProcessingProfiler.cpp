@@ -0,0 +1,540 @@
+/**
+ * @file
+ * The <C>SoXProcessingProfiler</C> body implements a lightweight
+ * real-time CPU profiler for the block processing of a single effect
+ * instance together with a process-wide registry of all profilers.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXProcessingProfiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <mutex>
+#include "GenericSet.h"
+#include "Logging.h"
+
+/*--------------------*/
+
+using BaseTypes::GenericTypes::GenericSet;
+using SoXPlugins::Helpers::SoXProcessingProfiler;
+using SoXPlugins::Helpers::SoXProcessingStatistics;
+using SoXPlugins::Helpers::SoXProcessingStatisticsList;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
+
+/*====================*/
+
+/** a set of profiler pointers */
+typedef GenericSet<SoXProcessingProfiler*> _SoXProcessingProfilerPtrSet;
+
+/*--------------------*/
+
+/** the weight of a new block in the running means (about the last
+ * 32 blocks are relevant) */
+static const double _smoothingFactor = 1.0 / 32.0;
+
+/** the loads above which blocks are counted as getting close to
+ * or missing their deadline */
+static const double _budgetThresholdList[] = { 0.5, 0.8, 1.0 };
+
+/** the width of a bucket in the load histogram */
+static const double _loadBucketWidth = 0.05;
+
+/** the name of the environment variable switching on profiling */
+static const char* _enablingVariableName = "SOXPLUGINS_PROFILING";
+
+/*--------------------*/
+/* auxiliary routines */
+/*--------------------*/
+
+/**
+ * Returns the current time of the steady clock in nanoseconds.
+ *
+ * @return  current time stamp
+ */
+static std::uint64_t _currentTimeStamp ()
+{
+    using namespace std::chrono;
+    const auto duration = steady_clock::now().time_since_epoch();
+    return (std::uint64_t) duration_cast<nanoseconds>(duration).count();
+}
+
+/*--------------------*/
+
+/**
+ * Returns the histogram bucket for <C>duration</C> in nanoseconds;
+ * there are four buckets per octave, the first two octaves are
+ * not subdivided.
+ *
+ * @param[in] duration     duration in nanoseconds
+ * @param[in] bucketCount  number of buckets in histogram
+ * @return  index of associated bucket
+ */
+static size_t _bucketIndex (IN std::uint64_t duration,
+                            IN size_t bucketCount)
+{
+    size_t octave = 0;
+
+    while (octave < 63 && (duration >> (octave + 1)) != 0) {
+        octave++;
+    }
+
+    const size_t subBucket =
+        (octave < 2 ? 0 : (size_t) ((duration >> (octave - 2)) & 3));
+    return std::min(octave * 4 + subBucket, bucketCount - 1);
+}
+
+/*--------------------*/
+
+/**
+ * Returns the upper bound in nanoseconds of the durations in
+ * histogram bucket <C>bucketIndex</C>.
+ *
+ * @param[in] bucketIndex  index of bucket
+ * @return  upper duration bound for bucket
+ */
+static double _bucketUpperBound (IN size_t bucketIndex)
+{
+    const size_t octave    = bucketIndex / 4;
+    const size_t subBucket = bucketIndex % 4;
+    double result;
+
+    if (octave < 2) {
+        result = (double) (std::uint64_t{2} << octave);
+    } else {
+        result = (double) ((std::uint64_t{5} + subBucket)
+                           << (octave - 2));
+    }
+
+    return result;
+}
+
+/*--------------------*/
+
+/**
+ * Returns the load histogram bucket for relative processing time
+ * <C>load</C>; all loads beyond the covered range go into the last
+ * bucket.
+ *
+ * @param[in] load         relative processing time
+ * @param[in] bucketCount  number of buckets in load histogram
+ * @return  index of associated bucket
+ */
+static size_t _loadBucketIndex (IN double load,
+                                IN size_t bucketCount)
+{
+    const double bucketPosition = load / _loadBucketWidth;
+    return (bucketPosition >= (double) (bucketCount - 1)
+            ? bucketCount - 1
+            : (size_t) bucketPosition);
+}
+
+/*--------------------*/
+
+/**
+ * Returns the flag telling whether profiling is active; it is
+ * initialized from the environment on first use.
+ *
+ * @return  reference to process-wide activity flag
+ */
+static std::atomic<bool>& _isEnabledFlag ()
+{
+    static std::atomic<bool> isEnabled{[] () {
+        const char* value = std::getenv(_enablingVariableName);
+        return (value != nullptr && value[0] != '\0'
+                && String{value} != "0");
+    }()};
+
+    return isEnabled;
+}
+
+/*--------------------*/
+
+/**
+ * Returns the mutex protecting the registry; it is never locked on
+ * the audio thread.
+ *
+ * @return  reference to registry mutex
+ */
+static std::mutex& _registryMutex ()
+{
+    static std::mutex mutex{};
+    return mutex;
+}
+
+/*--------------------*/
+
+/**
+ * Returns the set of all registered profilers.
+ *
+ * @return  reference to process-wide profiler set
+ */
+static _SoXProcessingProfilerPtrSet& _registry ()
+{
+    static _SoXProcessingProfilerPtrSet registry{};
+    return registry;
+}
+
+/*====================*/
+
+String SoXProcessingStatistics::toString () const
+{
+    return STR::expand("%1: blocks = %2, mean = %3us, p99 = %4us,"
+                       " max = %5us, load = %6%, p99 load = %7%,"
+                       " max load = %8%, >50% = %9, >80% = %A,"
+                       " >100% = %B",
+                       name, TOSTRING(blockCount),
+                       TOSTRING(meanTime),
+                       TOSTRING(percentile99Time),
+                       TOSTRING(maximumTime),
+                       TOSTRING(load),
+                       TOSTRING(percentile99Load),
+                       TOSTRING(maximumLoad),
+                       TOSTRING(halfBudgetCount),
+                       TOSTRING(criticalBudgetCount),
+                       TOSTRING(overrunCount));
+}
+
+/*====================*/
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+SoXProcessingProfiler::SoXProcessingProfiler (IN String& name)
+    : _name{name},
+      _blockCount{0},
+      _meanTime{0.0},
+      _meanLoad{0.0},
+      _maximumTime{0},
+      _maximumLoad{0.0}
+{
+    Logging_trace1(">>: %1", name);
+
+    for (size_t i = 0;  i < _histogramBucketCount;  i++) {
+        _histogram[i].store(0, std::memory_order_relaxed);
+    }
+
+    for (size_t i = 0;  i < _loadHistogramBucketCount;  i++) {
+        _loadHistogram[i].store(0, std::memory_order_relaxed);
+    }
+
+    for (std::atomic<std::uint64_t>& count : _budgetExcessCountList) {
+        count.store(0, std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard<std::mutex> guard{_registryMutex()};
+        _registry().add(this);
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+SoXProcessingProfiler::~SoXProcessingProfiler ()
+{
+    Logging_trace1(">>: %1", _name);
+
+    {
+        std::lock_guard<std::mutex> guard{_registryMutex()};
+        _registry().remove(this);
+    }
+
+    Logging_trace("<<");
+}
+
+/*-----------------------*/
+/* string representation */
+/*-----------------------*/
+
+String SoXProcessingProfiler::toString () const
+{
+    return STR::expand("SoXProcessingProfiler(%1)",
+                       statistics().toString());
+}
+
+/*--------------------*/
+/* property change    */
+/*--------------------*/
+
+void SoXProcessingProfiler::setName (IN String& name)
+{
+    Logging_trace1(">>: %1", name);
+
+    /* the name is read by the registry under its lock */
+    std::lock_guard<std::mutex> guard{_registryMutex()};
+    _name = name;
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXProcessingProfiler::reset ()
+{
+    Logging_trace(">>");
+
+    _blockCount.store(0, std::memory_order_relaxed);
+    _meanTime.store(0.0, std::memory_order_relaxed);
+    _meanLoad.store(0.0, std::memory_order_relaxed);
+    _maximumTime.store(0, std::memory_order_relaxed);
+    _maximumLoad.store(0.0, std::memory_order_relaxed);
+
+    for (size_t i = 0;  i < _histogramBucketCount;  i++) {
+        _histogram[i].store(0, std::memory_order_relaxed);
+    }
+
+    for (size_t i = 0;  i < _loadHistogramBucketCount;  i++) {
+        _loadHistogram[i].store(0, std::memory_order_relaxed);
+    }
+
+    for (std::atomic<std::uint64_t>& count : _budgetExcessCountList) {
+        count.store(0, std::memory_order_relaxed);
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* measurement        */
+/*--------------------*/
+
+std::uint64_t SoXProcessingProfiler::startBlock () const
+{
+    std::uint64_t result = 0;
+
+    if (_isEnabledFlag().load(std::memory_order_relaxed)) {
+        result = _currentTimeStamp();
+    }
+
+    return result;
+}
+
+/*--------------------*/
+
+void SoXProcessingProfiler::endBlock (IN std::uint64_t startTimeStamp,
+                                      IN Natural sampleCount,
+                                      IN Real sampleRate)
+{
+    if (startTimeStamp != 0) {
+        const std::uint64_t duration =
+            _currentTimeStamp() - startTimeStamp;
+
+        /* the audio thread is the only writer, hence relaxed loads
+           and stores suffice for the running values */
+        const std::uint64_t blockCount =
+            _blockCount.load(std::memory_order_relaxed);
+        const double factor =
+            (blockCount == 0 ? 1.0 : _smoothingFactor);
+        const double blockDuration =
+            (sampleRate > Real::zero
+             ? (double) Real{sampleCount} / (double) sampleRate * 1.0E9
+             : 0.0);
+        const double load =
+            (blockDuration > 0.0 ? (double) duration / blockDuration
+             : 0.0);
+
+        double meanTime = _meanTime.load(std::memory_order_relaxed);
+        meanTime += factor * ((double) duration - meanTime);
+        _meanTime.store(meanTime, std::memory_order_relaxed);
+
+        double meanLoad = _meanLoad.load(std::memory_order_relaxed);
+        meanLoad += factor * (load - meanLoad);
+        _meanLoad.store(meanLoad, std::memory_order_relaxed);
+
+        if (duration > _maximumTime.load(std::memory_order_relaxed)) {
+            _maximumTime.store(duration, std::memory_order_relaxed);
+        }
+
+        const size_t bucketIndex =
+            _bucketIndex(duration, _histogramBucketCount);
+        _histogram[bucketIndex].fetch_add(1, std::memory_order_relaxed);
+
+        /* deadline monitoring only makes sense for a known block
+           duration */
+        if (blockDuration > 0.0) {
+            if (load > _maximumLoad.load(std::memory_order_relaxed)) {
+                _maximumLoad.store(load, std::memory_order_relaxed);
+            }
+
+            const size_t loadBucketIndex =
+                _loadBucketIndex(load, _loadHistogramBucketCount);
+            _loadHistogram[loadBucketIndex]
+                .fetch_add(1, std::memory_order_relaxed);
+
+            for (size_t i = 0;  i < 3;  i++) {
+                if (load > _budgetThresholdList[i]) {
+                    _budgetExcessCountList[i]
+                        .fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        _blockCount.store(blockCount + 1, std::memory_order_relaxed);
+    }
+}
+
+/*--------------------*/
+/* statistics         */
+/*--------------------*/
+
+SoXProcessingStatistics SoXProcessingProfiler::statistics () const
+{
+    SoXProcessingStatistics result;
+    result.name = _name;
+
+    std::uint64_t histogram[_histogramBucketCount];
+    std::uint64_t totalCount = 0;
+
+    for (size_t i = 0;  i < _histogramBucketCount;  i++) {
+        histogram[i] = _histogram[i].load(std::memory_order_relaxed);
+        totalCount += histogram[i];
+    }
+
+    /* find the bucket where 99% of the blocks are reached */
+    const double maximumTime =
+        (double) _maximumTime.load(std::memory_order_relaxed);
+    const std::uint64_t percentileCount =
+        totalCount - totalCount / 100;
+    std::uint64_t count = 0;
+    double percentile99Time = 0.0;
+
+    for (size_t i = 0;  i < _histogramBucketCount && totalCount > 0;
+         i++) {
+        count += histogram[i];
+
+        if (count >= percentileCount) {
+            percentile99Time =
+                std::min(_bucketUpperBound(i), maximumTime);
+            break;
+        }
+    }
+
+    /* find the load bucket where 99% of the blocks are reached */
+    result.loadHistogram.setLength(Natural{_loadHistogramBucketCount});
+    std::uint64_t totalLoadCount = 0;
+
+    for (size_t i = 0;  i < _loadHistogramBucketCount;  i++) {
+        const std::uint64_t bucketCount =
+            _loadHistogram[i].load(std::memory_order_relaxed);
+        result.loadHistogram[i] = Natural{(size_t) bucketCount};
+        totalLoadCount += bucketCount;
+    }
+
+    const double maximumLoad =
+        _maximumLoad.load(std::memory_order_relaxed);
+    const std::uint64_t loadPercentileCount =
+        totalLoadCount - totalLoadCount / 100;
+    std::uint64_t loadCount = 0;
+    double percentile99Load = 0.0;
+    Boolean isFound = false;
+
+    for (size_t i = 0;
+         i < _loadHistogramBucketCount && totalLoadCount > 0 && !isFound;
+         i++) {
+        loadCount += (size_t) result.loadHistogram[i];
+
+        if (loadCount >= loadPercentileCount) {
+            isFound = true;
+            percentile99Load =
+                std::min((double) (i + 1) * _loadBucketWidth,
+                         maximumLoad);
+        }
+    }
+
+    const double nanosecondsPerMicrosecond = 1000.0;
+    result.blockCount =
+        Natural{(size_t) _blockCount.load(std::memory_order_relaxed)};
+    result.meanTime =
+        _meanTime.load(std::memory_order_relaxed)
+        / nanosecondsPerMicrosecond;
+    result.percentile99Time =
+        percentile99Time / nanosecondsPerMicrosecond;
+    result.maximumTime = maximumTime / nanosecondsPerMicrosecond;
+    result.load = _meanLoad.load(std::memory_order_relaxed) * 100.0;
+    result.percentile99Load = percentile99Load * 100.0;
+    result.maximumLoad = maximumLoad * 100.0;
+    result.halfBudgetCount =
+        Natural{(size_t) _budgetExcessCountList[0]
+                             .load(std::memory_order_relaxed)};
+    result.criticalBudgetCount =
+        Natural{(size_t) _budgetExcessCountList[1]
+                             .load(std::memory_order_relaxed)};
+    result.overrunCount =
+        Natural{(size_t) _budgetExcessCountList[2]
+                             .load(std::memory_order_relaxed)};
+    return result;
+}
+
+/*--------------------*/
+/* registry           */
+/*--------------------*/
+
+Boolean SoXProcessingProfiler::isEnabled ()
+{
+    return _isEnabledFlag().load(std::memory_order_relaxed);
+}
+
+/*--------------------*/
+
+void SoXProcessingProfiler::setIsEnabled (IN Boolean isEnabled)
+{
+    Logging_trace1(">>: %1", TOSTRING(isEnabled));
+    _isEnabledFlag().store((bool) isEnabled, std::memory_order_relaxed);
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+SoXProcessingStatisticsList SoXProcessingProfiler::registeredStatistics ()
+{
+    Logging_trace(">>");
+
+    SoXProcessingStatisticsList result;
+
+    {
+        std::lock_guard<std::mutex> guard{_registryMutex()};
+
+        for (const SoXProcessingProfiler* profiler : _registry()) {
+            result.append(profiler->statistics());
+        }
+    }
+
+    std::sort(result.begin(), result.end(),
+              [] (IN SoXProcessingStatistics& statisticsA,
+                  IN SoXProcessingStatistics& statisticsB) {
+                  return statisticsA.load > statisticsB.load;
+              });
+
+    Logging_trace1("<<: count = %1", TOSTRING(result.length()));
+    return result;
+}
+
+/*--------------------*/
+
+String SoXProcessingProfiler::report ()
+{
+    Logging_trace(">>");
+
+    const SoXProcessingStatisticsList statisticsList =
+        registeredStatistics();
+    String result = "";
+
+    for (const SoXProcessingStatistics& statistics : statisticsList) {
+        result += statistics.toString() + "\n";
+    }
+
+    Logging_trace("<<");
+    return result;
+}
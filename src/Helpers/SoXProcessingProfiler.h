@@ -0,0 +1,326 @@
+/**
+ * @file
+ * The <C>SoXProcessingProfiler</C> specification defines a
+ * lightweight real-time CPU profiler for the block processing of a
+ * single effect instance together with a process-wide registry of
+ * all profilers.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include <atomic>
+#include <cstdint>
+#include "GenericList.h"
+#include "MyString.h"
+#include "Natural.h"
+#include "NaturalList.h"
+#include "Real.h"
+
+/*--------------------*/
+
+using BaseTypes::Containers::NaturalList;
+using BaseTypes::GenericTypes::GenericList;
+using BaseTypes::Primitives::Boolean;
+using BaseTypes::Primitives::Natural;
+using BaseTypes::Primitives::Real;
+using BaseTypes::Primitives::String;
+
+/*====================*/
+
+namespace SoXPlugins::Helpers {
+
+    /**
+     * A <C>SoXProcessingStatistics</C> object is a snapshot of the
+     * processing time statistics of a single effect instance; all
+     * times are in microseconds, all loads are in percent of the
+     * real time duration of a block (the deadline of the audio
+     * callback).
+     */
+    struct SoXProcessingStatistics {
+
+        /** the name of the profiled effect instance */
+        String name;
+
+        /** the number of blocks measured */
+        Natural blockCount;
+
+        /** the running mean of the processing time per block */
+        Real meanTime;
+
+        /** the 99th percentile of the processing time per block
+         * (estimated from a histogram with quarter octave
+         * resolution) */
+        Real percentile99Time;
+
+        /** the maximum processing time per block */
+        Real maximumTime;
+
+        /** the running mean of the processing time relative to the
+         * real time duration of a block in percent */
+        Real load;
+
+        /** the 99th percentile of the load per block (estimated
+         * from the load histogram) */
+        Real percentile99Load;
+
+        /** the maximum load per block */
+        Real maximumLoad;
+
+        /** the number of blocks with a load above 50% */
+        Natural halfBudgetCount;
+
+        /** the number of blocks with a load above 80% (risking a
+         * dropout) */
+        Natural criticalBudgetCount;
+
+        /** the number of blocks with a load above 100% (missing the
+         * deadline) */
+        Natural overrunCount;
+
+        /** the histogram of the load per block; entry i counts the
+         * blocks with a load in [5i%, 5(i+1)%), the last entry
+         * collects all loads of 200% and above */
+        NaturalList loadHistogram;
+
+        /*--------------------*/
+
+        /**
+         * Returns string representation of statistics
+         *
+         * @return string representation
+         */
+        String toString () const;
+
+    };
+
+    /*--------------------*/
+
+    /** a list of processing statistics */
+    using SoXProcessingStatisticsList =
+        GenericList<SoXProcessingStatistics>;
+
+    /*====================*/
+
+    /**
+     * A <C>SoXProcessingProfiler</C> object measures the processing
+     * time of the blocks of a single effect instance with the
+     * steady clock.  The audio thread is the only writer of the
+     * counters and only does relaxed atomic updates (no locks, no
+     * allocation), other threads read them at any time for a
+     * consistent enough snapshot.
+     *
+     * Besides the processing time the profiler also monitors how
+     * close each block gets to its deadline: the ratio of processing
+     * time and real time duration of the block goes into a load
+     * histogram and blocks above 50%, 80% and 100% of that budget
+     * are counted, such that instances occasionally causing
+     * dropouts stand out even with a low mean load.
+     *
+     * All profilers are registered in a process-wide registry, such
+     * that the worst offenders in a large session can be found
+     * without an external profiler.  Profiling is switched on and
+     * off process-wide; when it is off, measuring a block costs a
+     * single relaxed atomic load.
+     */
+    struct SoXProcessingProfiler {
+
+        /*--------------------*/
+        /* con-/destruction   */
+        /*--------------------*/
+
+        /**
+         * Makes a profiler for an instance named <C>name</C> and
+         * registers it in the process-wide registry.
+         *
+         * @param[in] name  name of profiled effect instance
+         */
+        SoXProcessingProfiler (IN String& name = "");
+
+        /*--------------------*/
+
+        /**
+         * Unregisters profiler from the process-wide registry.
+         */
+        ~SoXProcessingProfiler ();
+
+        /*--------------------*/
+
+        SoXProcessingProfiler (IN SoXProcessingProfiler&) = delete;
+
+        /*-----------------------*/
+        /* string representation */
+        /*-----------------------*/
+
+        /**
+         * Returns string representation of profiler
+         *
+         * @return string representation
+         */
+        String toString () const;
+
+        /*--------------------*/
+        /* property change    */
+        /*--------------------*/
+
+        /**
+         * Sets name of profiled instance to <C>name</C>; must not
+         * be called on the audio thread.
+         *
+         * @param[in] name  new name of profiled effect instance
+         */
+        void setName (IN String& name);
+
+        /*--------------------*/
+
+        /**
+         * Clears all counters of profiler; may be called from any
+         * thread, a block measured concurrently may survive the
+         * reset.
+         */
+        void reset ();
+
+        /*--------------------*/
+        /* measurement        */
+        /*--------------------*/
+
+        /**
+         * Returns the start time stamp for a block measurement, zero
+         * when profiling is switched off.
+         *
+         * @return  time stamp in nanoseconds (or zero)
+         */
+        std::uint64_t startBlock () const;
+
+        /*--------------------*/
+
+        /**
+         * Records the processing of a block of <C>sampleCount</C>
+         * samples at <C>sampleRate</C> started at
+         * <C>startTimeStamp</C> (as returned by
+         * <C>startBlock</C>); does nothing for a zero start time
+         * stamp.
+         *
+         * @param[in] startTimeStamp  time stamp of block start in
+         *                            nanoseconds
+         * @param[in] sampleCount     number of samples per channel in
+         *                            block
+         * @param[in] sampleRate      sample rate of processing
+         */
+        void endBlock (IN std::uint64_t startTimeStamp,
+                       IN Natural sampleCount,
+                       IN Real sampleRate);
+
+        /*--------------------*/
+        /* statistics         */
+        /*--------------------*/
+
+        /**
+         * Returns a snapshot of the statistics of this profiler.
+         *
+         * @return  processing statistics
+         */
+        SoXProcessingStatistics statistics () const;
+
+        /*--------------------*/
+        /* registry           */
+        /*--------------------*/
+
+        /**
+         * Tells whether profiling is switched on process-wide; the
+         * initial setting is taken from the environment variable
+         * <C>SOXPLUGINS_PROFILING</C> (set to a nonempty value other
+         * than "0").
+         *
+         * @return  information whether profiling is active
+         */
+        static Boolean isEnabled ();
+
+        /*--------------------*/
+
+        /**
+         * Switches profiling process-wide on or off depending on
+         * <C>isEnabled</C>.
+         *
+         * @param[in] isEnabled  information whether profiling shall
+         *                       be active
+         */
+        static void setIsEnabled (IN Boolean isEnabled);
+
+        /*--------------------*/
+
+        /**
+         * Returns the statistics of all registered profilers sorted
+         * by descending load (the worst offender first).
+         *
+         * @return  list of processing statistics
+         */
+        static SoXProcessingStatisticsList registeredStatistics ();
+
+        /*--------------------*/
+
+        /**
+         * Returns a multiline report with the statistics of all
+         * registered profilers sorted by descending load.
+         *
+         * @return  report string
+         */
+        static String report ();
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the number of histogram buckets for the processing
+             * time (four per octave of nanoseconds) */
+            static constexpr size_t _histogramBucketCount = 160;
+
+            /** the number of histogram buckets for the load (5%
+             * each up to 200%, one bucket for larger loads) */
+            static constexpr size_t _loadHistogramBucketCount = 41;
+
+            /*--------------------*/
+
+            /** the name of the profiled instance */
+            String _name;
+
+            /** the number of measured blocks */
+            std::atomic<std::uint64_t> _blockCount;
+
+            /** the running mean of the processing time in
+             * nanoseconds */
+            std::atomic<double> _meanTime;
+
+            /** the running mean of the relative processing time */
+            std::atomic<double> _meanLoad;
+
+            /** the maximum processing time in nanoseconds */
+            std::atomic<std::uint64_t> _maximumTime;
+
+            /** the histogram of the processing times */
+            std::atomic<std::uint32_t>
+                _histogram[_histogramBucketCount];
+
+            /** the maximum relative processing time */
+            std::atomic<double> _maximumLoad;
+
+            /** the numbers of blocks with a relative processing time
+             * above 50%, 80% and 100% */
+            std::atomic<std::uint64_t> _budgetExcessCountList[3];
+
+            /** the histogram of the relative processing times */
+            std::atomic<std::uint32_t>
+                _loadHistogram[_loadHistogramBucketCount];
+
+    };
+
+}
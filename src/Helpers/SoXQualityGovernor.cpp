@@ -0,0 +1,293 @@
+/**
+ * @file
+ * The <C>SoXQualityGovernor</C> body implements an opt-in governor
+ * stepping the quality level of an effect down when the block
+ * processing gets close to its deadline and up again when the load
+ * has recovered.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXQualityGovernor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include "Logging.h"
+
+/*--------------------*/
+
+using SoXPlugins::Helpers::SoXQualityGovernor;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
+
+/*====================*/
+
+/** the smoothed load above which the quality is stepped down */
+static const double _stepDownLoad = 0.8;
+
+/** the smoothed load below which the quality may be stepped up */
+static const double _stepUpLoad = 0.5;
+
+/** the load of a single block missing its deadline; this steps
+ * the quality down regardless of the smoothed load */
+static const double _overrunLoad = 1.0;
+
+/** the time constant in seconds for smoothing the load */
+static const double _smoothingDuration = 0.1;
+
+/** the minimum time in seconds after a transition before the
+ * quality is stepped down again */
+static const double _holdDuration = 0.25;
+
+/** the time in seconds the smoothed load must stay low before the
+ * quality is stepped up */
+static const double _recoveryDuration = 2.0;
+
+/** the name of the environment variable switching on the
+ * governor */
+static const char* _enablingVariableName = "SOXPLUGINS_QUALITY_GOVERNOR";
+
+/*--------------------*/
+/* auxiliary routines */
+/*--------------------*/
+
+/**
+ * Returns the current time of the steady clock in nanoseconds.
+ *
+ * @return  current time stamp
+ */
+static std::uint64_t _currentTimeStamp ()
+{
+    using namespace std::chrono;
+    const auto duration = steady_clock::now().time_since_epoch();
+    return (std::uint64_t) duration_cast<nanoseconds>(duration).count();
+}
+
+/*--------------------*/
+
+/**
+ * Tells whether the environment switches on the governor.
+ *
+ * @return  information whether governor is initially active
+ */
+static Boolean _isEnabledByEnvironment ()
+{
+    const char* value = std::getenv(_enablingVariableName);
+    return (value != nullptr && value[0] != '\0'
+            && String{value} != "0");
+}
+
+/*====================*/
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+SoXQualityGovernor::SoXQualityGovernor ()
+    : _isEnabled{_isEnabledByEnvironment()},
+      _levelCount{1},
+      _level{0},
+      _smoothedLoad{0.0},
+      _timeSinceTransition{0.0},
+      _recoveryTime{0.0},
+      _transitionCount{0},
+      _loggedTransitionCount{0}
+{
+    Logging_trace(">>");
+
+    for (std::atomic<std::uint64_t>& entry : _transitionRing) {
+        entry.store(0, std::memory_order_relaxed);
+    }
+
+    Logging_trace1("<<: %1", toString());
+}
+
+/*-----------------------*/
+/* string representation */
+/*-----------------------*/
+
+String SoXQualityGovernor::toString () const
+{
+    return STR::expand("SoXQualityGovernor(isEnabled = %1,"
+                       " levelCount = %2, level = %3,"
+                       " transitionCount = %4)",
+                       TOSTRING(isEnabled()),
+                       TOSTRING(Natural{_levelCount}),
+                       TOSTRING(level()),
+                       TOSTRING(Natural{_transitionCount
+                                        .load(std::memory_order_relaxed)}));
+}
+
+/*--------------------*/
+/* configuration      */
+/*--------------------*/
+
+Boolean SoXQualityGovernor::isEnabled () const
+{
+    return _isEnabled.load(std::memory_order_relaxed);
+}
+
+/*--------------------*/
+
+void SoXQualityGovernor::setIsEnabled (IN Boolean isEnabled)
+{
+    Logging_trace1(">>: %1", TOSTRING(isEnabled));
+    _isEnabled.store(isEnabled, std::memory_order_relaxed);
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXQualityGovernor::setLevelCount (IN Natural levelCount)
+{
+    Logging_trace1(">>: %1", TOSTRING(levelCount));
+
+    _levelCount = std::max((size_t) levelCount, size_t{1});
+    _level.store(0, std::memory_order_relaxed);
+    _smoothedLoad        = 0.0;
+    _timeSinceTransition = 0.0;
+    _recoveryTime        = 0.0;
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* measurement        */
+/*--------------------*/
+
+Natural SoXQualityGovernor::level () const
+{
+    return Natural{_level.load(std::memory_order_relaxed)};
+}
+
+/*--------------------*/
+
+std::uint64_t SoXQualityGovernor::startBlock () const
+{
+    std::uint64_t result = 0;
+
+    if (_isEnabled.load(std::memory_order_relaxed)) {
+        result = _currentTimeStamp();
+    }
+
+    return result;
+}
+
+/*--------------------*/
+
+Boolean SoXQualityGovernor::endBlock (IN std::uint64_t startTimeStamp,
+                                      IN Natural sampleCount,
+                                      IN Real sampleRate)
+{
+    const size_t level = _level.load(std::memory_order_relaxed);
+    const double blockDuration =
+        (sampleRate > Real::zero
+         ? (double) Real{sampleCount} / (double) sampleRate
+         : 0.0);
+    size_t newLevel = level;
+
+    if (startTimeStamp == 0) {
+        /* a governor switched off runs at full quality */
+        newLevel = 0;
+    } else if (blockDuration > 0.0) {
+        const double duration =
+            (double) (_currentTimeStamp() - startTimeStamp) * 1.0E-9;
+        const double load = duration / blockDuration;
+        const double factor =
+            std::min(1.0, blockDuration / _smoothingDuration);
+        _smoothedLoad += factor * (load - _smoothedLoad);
+        _timeSinceTransition += blockDuration;
+        _recoveryTime =
+            (_smoothedLoad < _stepUpLoad ? _recoveryTime + blockDuration
+             : 0.0);
+
+        if ((_smoothedLoad > _stepDownLoad || load > _overrunLoad)
+            && level + 1 < _levelCount
+            && _timeSinceTransition >= _holdDuration) {
+            newLevel = level + 1;
+        } else if (level > 0 && _recoveryTime >= _recoveryDuration) {
+            newLevel = level - 1;
+        }
+    }
+
+    const Boolean levelHasChanged = (newLevel != level);
+
+    if (levelHasChanged) {
+        _changeLevel(newLevel, _smoothedLoad);
+    }
+
+    return levelHasChanged;
+}
+
+/*--------------------*/
+/* transition log     */
+/*--------------------*/
+
+Natural SoXQualityGovernor::logTransitions ()
+{
+    const std::uint64_t transitionCount =
+        _transitionCount.load(std::memory_order_acquire);
+    const Natural result{transitionCount - _loggedTransitionCount};
+
+    for (std::uint64_t number = _loggedTransitionCount;
+         number < transitionCount;  number++) {
+        const std::uint64_t entry =
+            _transitionRing[number % _transitionRingSize]
+                .load(std::memory_order_relaxed);
+
+        if ((entry >> 32) != (number & 0xFFFFFFFFu)) {
+            Logging_trace1("--: transition %1 lost",
+                           TOSTRING(Natural{number}));
+        } else {
+            const Natural oldLevel{(entry >> 24) & 0xFF};
+            const Natural newLevel{(entry >> 16) & 0xFF};
+            const Real load{(double) (entry & 0xFFFF) / 10.0};
+            Logging_trace4("--: transition %1, quality level %2 -> %3,"
+                           " load = %4%",
+                           TOSTRING(Natural{number}),
+                           TOSTRING(oldLevel), TOSTRING(newLevel),
+                           TOSTRING(load));
+        }
+    }
+
+    _loggedTransitionCount = transitionCount;
+    return result;
+}
+
+/*--------------------*/
+/* private features   */
+/*--------------------*/
+
+void SoXQualityGovernor::_changeLevel (IN size_t newLevel,
+                                       IN double load)
+{
+    const std::uint64_t number =
+        _transitionCount.load(std::memory_order_relaxed);
+    const std::uint64_t loadInPermille =
+        (std::uint64_t) std::min(std::max(load, 0.0) * 1000.0,
+                                 65535.0);
+    const std::uint64_t oldLevel =
+        (std::uint64_t) _level.load(std::memory_order_relaxed);
+    const std::uint64_t entry =
+        ((number & 0xFFFFFFFFu) << 32
+         | (oldLevel & 0xFF) << 24
+         | ((std::uint64_t) newLevel & 0xFF) << 16
+         | loadInPermille);
+
+    _transitionRing[number % _transitionRingSize]
+        .store(entry, std::memory_order_relaxed);
+    _transitionCount.store(number + 1, std::memory_order_release);
+    _level.store(newLevel, std::memory_order_relaxed);
+
+    /* the next step down waits for the new level to take effect,
+       a step up needs a fresh recovery period */
+    _timeSinceTransition = 0.0;
+    _recoveryTime        = 0.0;
+}
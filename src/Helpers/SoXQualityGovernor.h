@@ -0,0 +1,235 @@
+/**
+ * @file
+ * The <C>SoXQualityGovernor</C> specification defines an opt-in
+ * governor stepping the quality level of an effect down when the
+ * block processing gets close to its deadline and up again when the
+ * load has recovered.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include <atomic>
+#include <cstdint>
+#include "MyString.h"
+#include "Natural.h"
+#include "Real.h"
+
+/*--------------------*/
+
+using BaseTypes::Primitives::Boolean;
+using BaseTypes::Primitives::Natural;
+using BaseTypes::Primitives::Real;
+using BaseTypes::Primitives::String;
+
+/*====================*/
+
+namespace SoXPlugins::Helpers {
+
+    /**
+     * A <C>SoXQualityGovernor</C> object degrades the quality of a
+     * single effect instance gracefully under deadline pressure.  It
+     * measures the load of each block (the ratio of processing time
+     * and real time duration of the block) with the steady clock
+     * and smoothes it over about a tenth of a second.  When the
+     * smoothed load exceeds 80% or a block misses its deadline, the
+     * quality level is stepped down by one (at most once per quarter
+     * second, such that the lower level can take effect); when the
+     * smoothed load has stayed below 50% for two seconds, the level
+     * is stepped up by one.  The effect itself applies a level
+     * change without audible discontinuities.
+     *
+     * The audio thread is the only writer of the governor state and
+     * neither locks nor allocates; each transition is recorded in a
+     * small lock-free ring, from which another thread writes it to
+     * the log.  The governor is off by default; its initial setting
+     * is taken from the environment variable
+     * <C>SOXPLUGINS_QUALITY_GOVERNOR</C> (set to a nonempty value
+     * other than "0").  When it is off, a block costs a single
+     * relaxed atomic load.
+     */
+    struct SoXQualityGovernor {
+
+        /*--------------------*/
+        /* con-/destruction   */
+        /*--------------------*/
+
+        /**
+         * Makes a governor with a single quality level, switched
+         * on or off according to the environment.
+         */
+        SoXQualityGovernor ();
+
+        /*--------------------*/
+
+        SoXQualityGovernor (IN SoXQualityGovernor&) = delete;
+
+        /*-----------------------*/
+        /* string representation */
+        /*-----------------------*/
+
+        /**
+         * Returns string representation of governor.
+         *
+         * @return string representation
+         */
+        String toString () const;
+
+        /*--------------------*/
+        /* configuration      */
+        /*--------------------*/
+
+        /**
+         * Tells whether the governor is switched on.
+         *
+         * @return  information whether governor is active
+         */
+        Boolean isEnabled () const;
+
+        /*--------------------*/
+
+        /**
+         * Switches the governor on or off depending on
+         * <C>isEnabled</C>; may be called from any thread, a
+         * governor switched off returns to full quality with the
+         * next block.
+         *
+         * @param[in] isEnabled  information whether governor shall
+         *                       be active
+         */
+        void setIsEnabled (IN Boolean isEnabled);
+
+        /*--------------------*/
+
+        /**
+         * Sets the number of quality levels of the governed effect
+         * to <C>levelCount</C> and restarts at full quality; must
+         * not be called concurrently with the block processing.
+         *
+         * @param[in] levelCount  count of quality levels
+         */
+        void setLevelCount (IN Natural levelCount);
+
+        /*--------------------*/
+        /* measurement        */
+        /*--------------------*/
+
+        /**
+         * Returns the current quality level (zero for full
+         * quality); may be called from any thread.
+         *
+         * @return  current quality level
+         */
+        Natural level () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the start time stamp for a block measurement, zero
+         * when the governor is switched off.
+         *
+         * @return  time stamp in nanoseconds (or zero)
+         */
+        std::uint64_t startBlock () const;
+
+        /*--------------------*/
+
+        /**
+         * Records the processing of a block of <C>sampleCount</C>
+         * samples at <C>sampleRate</C> started at
+         * <C>startTimeStamp</C> (as returned by <C>startBlock</C>),
+         * adapts the quality level and tells whether it has
+         * changed; must only be called on the audio thread.  A zero
+         * start time stamp returns to full quality.
+         *
+         * @param[in] startTimeStamp  time stamp of block start in
+         *                            nanoseconds
+         * @param[in] sampleCount     number of samples per channel in
+         *                            block
+         * @param[in] sampleRate      sample rate of processing
+         * @return  information whether quality level has changed
+         */
+        Boolean endBlock (IN std::uint64_t startTimeStamp,
+                          IN Natural sampleCount,
+                          IN Real sampleRate);
+
+        /*--------------------*/
+        /* transition log     */
+        /*--------------------*/
+
+        /**
+         * Writes a log entry for each quality level transition
+         * since the last call and returns their number; must not be
+         * called on the audio thread and only from one thread at a
+         * time.  Transitions overwritten in the ring before being
+         * logged are reported as lost.
+         *
+         * @return  number of transitions since last call
+         */
+        Natural logTransitions ();
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the number of transitions kept for the log */
+            static constexpr size_t _transitionRingSize = 16;
+
+            /*--------------------*/
+
+            /**
+             * Changes the quality level to <C>newLevel</C> and
+             * records the transition with the smoothed load
+             * <C>load</C>.
+             *
+             * @param[in] newLevel  new quality level
+             * @param[in] load      smoothed load at transition
+             */
+            void _changeLevel (IN size_t newLevel,
+                               IN double load);
+
+            /*--------------------*/
+
+            /** tells whether the governor is active */
+            std::atomic<bool> _isEnabled;
+
+            /** the number of quality levels of the effect */
+            size_t _levelCount;
+
+            /** the current quality level */
+            std::atomic<size_t> _level;
+
+            /** the smoothed load of the recent blocks */
+            double _smoothedLoad;
+
+            /** the time in seconds since the last transition */
+            double _timeSinceTransition;
+
+            /** the time in seconds the smoothed load has been low
+             * enough for a step up */
+            double _recoveryTime;
+
+            /** the number of transitions so far */
+            std::atomic<std::uint64_t> _transitionCount;
+
+            /** the recent transitions, each encoded with its number,
+             * its levels and its load */
+            std::atomic<std::uint64_t>
+                _transitionRing[_transitionRingSize];
+
+            /** the number of transitions already logged (only used
+             * by the logging thread) */
+            std::uint64_t _loggedTransitionCount;
+
+    };
+
+}
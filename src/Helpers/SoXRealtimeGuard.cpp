@@ -0,0 +1,331 @@
+/**
+ * @file
+ * The <C>SoXRealtimeGuard</C> body implements a debug detector for
+ * heap allocations and blocking locks within the audio callback
+ * together with the replacement of the global allocation operators
+ * when the check is active.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXRealtimeGuard.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "Logging.h"
+
+/*--------------------*/
+
+using SoXPlugins::Helpers::SoXRealtimeGuard;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
+
+/*====================*/
+
+/** the tag of the innermost guard on this thread (NULL for a
+ * thread not marked as real-time thread) */
+static thread_local const char* _currentTag = NULL;
+
+/** tells whether a violation is currently reported on this thread
+ * (the logging itself allocates) */
+static thread_local bool _isReporting = false;
+
+/** the number of violations since the last reset */
+static std::atomic<size_t> _violationCount{0};
+
+/*--------------------*/
+
+/**
+ * Counts and logs a violation of kind <C>kind</C> for the operation
+ * or lock named <C>name</C> when the current thread is marked as
+ * real-time thread.
+ *
+ * @param[in] kind  the kind of violation
+ * @param[in] name  the name of the operation or lock
+ */
+static void _noteViolation (IN char* kind, IN char* name)
+{
+    if (_currentTag != NULL && !_isReporting) {
+        _violationCount.fetch_add(1, std::memory_order_relaxed);
+        _isReporting = true;
+        Logging_traceError2("--: %1 in real-time scope '%2'",
+                            STR::expand("%1 '%2'", kind, name),
+                            _currentTag);
+        _isReporting = false;
+    }
+}
+
+/*====================*/
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+SoXRealtimeGuard::SoXRealtimeGuard (IN char* tag)
+    : _previousTag{_currentTag}
+{
+    _currentTag = tag;
+}
+
+/*--------------------*/
+
+SoXRealtimeGuard::~SoXRealtimeGuard ()
+{
+    _currentTag = _previousTag;
+}
+
+/*--------------------*/
+/* property access    */
+/*--------------------*/
+
+Boolean SoXRealtimeGuard::isActive ()
+{
+    #ifdef REALTIME_CHECK_IS_ACTIVE
+        return true;
+    #else
+        return false;
+    #endif
+}
+
+/*--------------------*/
+
+Natural SoXRealtimeGuard::violationCount ()
+{
+    return Natural{_violationCount.load(std::memory_order_relaxed)};
+}
+
+/*--------------------*/
+/* property change    */
+/*--------------------*/
+
+void SoXRealtimeGuard::resetViolationCount ()
+{
+    _violationCount.store(0, std::memory_order_relaxed);
+}
+
+/*--------------------*/
+/* event notification */
+/*--------------------*/
+
+void SoXRealtimeGuard::noteAllocation (IN char* operationName)
+{
+    _noteViolation("heap operation", operationName);
+}
+
+/*--------------------*/
+
+void SoXRealtimeGuard::noteLock (IN char* tag)
+{
+    _noteViolation("lock", tag);
+}
+
+/*============================================================*/
+
+#ifdef REALTIME_CHECK_IS_ACTIVE
+
+    /*-------------------------------------*/
+    /* replacement of allocation operators */
+    /*-------------------------------------*/
+
+    /**
+     * Allocates <C>size</C> bytes with at least the alignment
+     * <C>alignment</C> (zero for the default alignment) and returns
+     * them (or NULL when memory is exhausted).
+     *
+     * @param[in] size       the number of bytes
+     * @param[in] alignment  the required alignment (or zero)
+     * @return  pointer to the memory or NULL
+     */
+    static void* _allocate (IN size_t size, IN size_t alignment)
+    {
+        const size_t effectiveSize = (size == 0 ? 1 : size);
+        void* result;
+
+        if (alignment == 0) {
+            result = std::malloc(effectiveSize);
+        } else {
+            #ifdef _MSC_VER
+                result = _aligned_malloc(effectiveSize, alignment);
+            #else
+                /* aligned_alloc requires a multiple of the
+                   alignment */
+                result = std::aligned_alloc(alignment,
+                                            ((effectiveSize + alignment - 1)
+                                             / alignment * alignment));
+            #endif
+        }
+
+        return result;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Allocates <C>size</C> bytes with alignment <C>alignment</C>
+     * (zero for the default alignment) and throws
+     * <C>std::bad_alloc</C> when memory is exhausted.
+     *
+     * @param[in] size       the number of bytes
+     * @param[in] alignment  the required alignment (or zero)
+     * @return  pointer to the memory
+     */
+    static void* _allocateOrThrow (IN size_t size, IN size_t alignment)
+    {
+        SoXRealtimeGuard::noteAllocation("operator new");
+        void* result = _allocate(size, alignment);
+
+        if (result == NULL) {
+            throw std::bad_alloc();
+        }
+
+        return result;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Frees memory at <C>ptr</C> allocated by <C>_allocate</C> with
+     * alignment <C>alignment</C> (zero for the default alignment).
+     *
+     * @param[in] ptr        the memory to be freed (may be NULL)
+     * @param[in] alignment  the alignment used for allocation
+     */
+    static void _free (IN void* ptr, IN size_t alignment)
+    {
+        if (ptr != NULL) {
+            SoXRealtimeGuard::noteAllocation("operator delete");
+
+            #ifdef _MSC_VER
+                if (alignment != 0) {
+                    _aligned_free((void*) ptr);
+                } else {
+                    std::free((void*) ptr);
+                }
+            #else
+                std::free((void*) ptr);
+            #endif
+        }
+    }
+
+    /*--------------------*/
+
+    void* operator new (size_t size)
+    {
+        return _allocateOrThrow(size, 0);
+    }
+
+    void* operator new[] (size_t size)
+    {
+        return _allocateOrThrow(size, 0);
+    }
+
+    void* operator new (size_t size, std::align_val_t alignment)
+    {
+        return _allocateOrThrow(size, (size_t) alignment);
+    }
+
+    void* operator new[] (size_t size, std::align_val_t alignment)
+    {
+        return _allocateOrThrow(size, (size_t) alignment);
+    }
+
+    void* operator new (size_t size, IN std::nothrow_t&) noexcept
+    {
+        SoXRealtimeGuard::noteAllocation("operator new");
+        return _allocate(size, 0);
+    }
+
+    void* operator new[] (size_t size, IN std::nothrow_t&) noexcept
+    {
+        SoXRealtimeGuard::noteAllocation("operator new");
+        return _allocate(size, 0);
+    }
+
+    void* operator new (size_t size, std::align_val_t alignment,
+                        IN std::nothrow_t&) noexcept
+    {
+        SoXRealtimeGuard::noteAllocation("operator new");
+        return _allocate(size, (size_t) alignment);
+    }
+
+    void* operator new[] (size_t size, std::align_val_t alignment,
+                          IN std::nothrow_t&) noexcept
+    {
+        SoXRealtimeGuard::noteAllocation("operator new");
+        return _allocate(size, (size_t) alignment);
+    }
+
+    /*--------------------*/
+
+    void operator delete (void* ptr) noexcept
+    {
+        _free(ptr, 0);
+    }
+
+    void operator delete[] (void* ptr) noexcept
+    {
+        _free(ptr, 0);
+    }
+
+    void operator delete (void* ptr, size_t) noexcept
+    {
+        _free(ptr, 0);
+    }
+
+    void operator delete[] (void* ptr, size_t) noexcept
+    {
+        _free(ptr, 0);
+    }
+
+    void operator delete (void* ptr, std::align_val_t alignment) noexcept
+    {
+        _free(ptr, (size_t) alignment);
+    }
+
+    void operator delete[] (void* ptr, std::align_val_t alignment) noexcept
+    {
+        _free(ptr, (size_t) alignment);
+    }
+
+    void operator delete (void* ptr, size_t,
+                          std::align_val_t alignment) noexcept
+    {
+        _free(ptr, (size_t) alignment);
+    }
+
+    void operator delete[] (void* ptr, size_t,
+                            std::align_val_t alignment) noexcept
+    {
+        _free(ptr, (size_t) alignment);
+    }
+
+    void operator delete (void* ptr, IN std::nothrow_t&) noexcept
+    {
+        _free(ptr, 0);
+    }
+
+    void operator delete[] (void* ptr, IN std::nothrow_t&) noexcept
+    {
+        _free(ptr, 0);
+    }
+
+    void operator delete (void* ptr, std::align_val_t alignment,
+                          IN std::nothrow_t&) noexcept
+    {
+        _free(ptr, (size_t) alignment);
+    }
+
+    void operator delete[] (void* ptr, std::align_val_t alignment,
+                            IN std::nothrow_t&) noexcept
+    {
+        _free(ptr, (size_t) alignment);
+    }
+
+#endif
@@ -0,0 +1,165 @@
+/**
+ * @file
+ * The <C>SoXRealtimeGuard</C> specification defines a debug
+ * detector for heap allocations and blocking locks within the audio
+ * callback.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "Natural.h"
+
+/*--------------------*/
+
+using BaseTypes::Primitives::Boolean;
+using BaseTypes::Primitives::Natural;
+
+/*====================*/
+
+#ifdef REALTIME_CHECK_IS_ACTIVE
+    /**
+     * Marks the current thread as real-time thread until the end of
+     * the enclosing scope; <C>tag</C> is a string literal naming the
+     * scope in violation reports
+     */
+    #define SoXRealtimeGuard_scope(tag) \
+        const SoXPlugins::Helpers::SoXRealtimeGuard _realtimeGuard{tag}
+
+    /**
+     * Notes that the blocking lock named by string literal
+     * <C>tag</C> is about to be acquired
+     */
+    #define SoXRealtimeGuard_noteLock(tag) \
+        SoXPlugins::Helpers::SoXRealtimeGuard::noteLock(tag)
+#else
+    /* for an inactive check the macros are simply empty */
+
+    /** Marks the current thread as real-time thread (empty) */
+    #define SoXRealtimeGuard_scope(tag)
+
+    /** Notes that a blocking lock is acquired (empty) */
+    #define SoXRealtimeGuard_noteLock(tag)
+#endif
+
+/*====================*/
+
+namespace SoXPlugins::Helpers {
+
+    /**
+     * A <C>SoXRealtimeGuard</C> object marks the current thread as
+     * real-time thread during its lifetime; guards may be nested
+     * and the innermost tag identifies the scope.
+     *
+     * When the check is active (by the compile-time define
+     * <C>REALTIME_CHECK_IS_ACTIVE</C>, set for debug builds), the
+     * global <C>operator new</C> and <C>operator delete</C> are
+     * replaced and each allocation or deallocation on a marked
+     * thread is counted as a violation and logged with the tag of
+     * the scope; the same is done for blocking locks announced by
+     * <C>SoXRealtimeGuard_noteLock</C>.  Allocations by
+     * <C>malloc</C> cannot be intercepted portably and are not
+     * detected.  When the check is inactive, the guard does nothing
+     * and the violation count stays zero.
+     */
+    struct SoXRealtimeGuard {
+
+        /*--------------------*/
+        /* con-/destruction   */
+        /*--------------------*/
+
+        /**
+         * Marks current thread as real-time thread with scope
+         * named <C>tag</C>.
+         *
+         * @param[in] tag  the name of the scope (a string literal)
+         */
+        SoXRealtimeGuard (IN char* tag);
+
+        /*--------------------*/
+
+        /**
+         * Restores the marking of the current thread before this
+         * guard.
+         */
+        ~SoXRealtimeGuard ();
+
+        /*--------------------*/
+
+        SoXRealtimeGuard (IN SoXRealtimeGuard&) = delete;
+
+        /*--------------------*/
+        /* property access    */
+        /*--------------------*/
+
+        /**
+         * Tells whether the check has been compiled in.
+         *
+         * @return  information whether violations are detected
+         */
+        static Boolean isActive ();
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of violations on real-time threads
+         * since the last reset.
+         *
+         * @return  count of allocations, deallocations and locks
+         */
+        static Natural violationCount ();
+
+        /*--------------------*/
+        /* property change    */
+        /*--------------------*/
+
+        /**
+         * Sets the violation count to zero.
+         */
+        static void resetViolationCount ();
+
+        /*--------------------*/
+        /* event notification */
+        /*--------------------*/
+
+        /**
+         * Records a heap operation named <C>operationName</C> on
+         * the current thread; this is a violation on a real-time
+         * thread.
+         *
+         * @param[in] operationName  the kind of heap operation (a
+         *                           string literal)
+         */
+        static void noteAllocation (IN char* operationName);
+
+        /*--------------------*/
+
+        /**
+         * Records the acquisition of the blocking lock named
+         * <C>tag</C> on the current thread; this is a violation on a
+         * real-time thread.
+         *
+         * @param[in] tag  the name of the lock (a string literal)
+         */
+        static void noteLock (IN char* tag);
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the tag of the enclosing guard on this thread (if
+             * any) */
+            const char* _previousTag;
+
+    };
+
+}
@@ -0,0 +1,165 @@
+/**
+ * @file
+ * The <C>SoXSequenceLock</C> specification defines a sequence lock
+ * (seqlock) giving readers on arbitrary threads consistent copies of
+ * data changed by a single writer thread without ever blocking the
+ * writer.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include <atomic>
+#include <thread>
+#include "Natural.h"
+
+/*--------------------*/
+
+using BaseTypes::Primitives::Boolean;
+
+/*====================*/
+
+namespace SoXPlugins::Helpers {
+
+    /**
+     * A <C>SoXSequenceLock</C> object protects trivially copyable
+     * data changed by one writer at a time and read by any number
+     * of readers.  The writer brackets each change by
+     * <C>beginWrite</C> and <C>endWrite</C>, which makes the sequence
+     * number odd during the change; it never waits and does not
+     * allocate, hence it may run on the audio thread.  A reader
+     * copies the data between <C>beginRead</C> and <C>endRead</C>
+     * and retries when <C>endRead</C> reports that a change has
+     * overlapped the copy; a reader thus never delays the writer
+     * and only repeats its copy on an actual conflict.
+     *
+     * The data must only be copied (never dereferenced) in the read
+     * section, since it might be torn until <C>endRead</C> has
+     * confirmed it; writers must be serialized by the caller.
+     */
+    struct SoXSequenceLock {
+
+        /**
+         * Makes a lock without any change.
+         */
+        SoXSequenceLock ()
+            : _sequenceNumber{0}
+        {
+        }
+
+        /*--------------------*/
+
+        /**
+         * Makes a lock for a copy of the data protected by
+         * <C>otherLock</C>; the copy has a sequence of its own.
+         *
+         * @param[in] otherLock  lock of the original data
+         */
+        SoXSequenceLock (IN SoXSequenceLock& otherLock)
+            : _sequenceNumber{0}
+        {
+            (void) otherLock;
+        }
+
+        /*--------------------*/
+
+        /**
+         * Keeps the sequence of this lock on an assignment of the
+         * protected data; this counts as a change for the readers.
+         *
+         * @param[in] otherLock  lock of the assigned data
+         * @return  this lock
+         */
+        SoXSequenceLock& operator= (IN SoXSequenceLock& otherLock)
+        {
+            (void) otherLock;
+            _sequenceNumber.fetch_add(2, std::memory_order_release);
+            return *this;
+        }
+
+        /*--------------------*/
+        /* writer side        */
+        /*--------------------*/
+
+        /**
+         * Marks the start of a change of the protected data.
+         */
+        void beginWrite ()
+        {
+            _sequenceNumber.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+
+        /*--------------------*/
+
+        /**
+         * Marks the end of a change of the protected data.
+         */
+        void endWrite ()
+        {
+            _sequenceNumber.fetch_add(1, std::memory_order_release);
+        }
+
+        /*--------------------*/
+        /* reader side        */
+        /*--------------------*/
+
+        /**
+         * Marks the start of a copy of the protected data and
+         * returns the sequence number to be checked by
+         * <C>endRead</C>; while a change is in progress, the reader
+         * yields until it has ended.
+         *
+         * @return  sequence number at start of copy
+         */
+        size_t beginRead () const
+        {
+            size_t result =
+                _sequenceNumber.load(std::memory_order_acquire);
+
+            while (result % 2 != 0) {
+                std::this_thread::yield();
+                result = _sequenceNumber.load(std::memory_order_acquire);
+            }
+
+            return result;
+        }
+
+        /*--------------------*/
+
+        /**
+         * Tells whether the data copied since <C>beginRead</C>
+         * (returning <C>sequenceNumber</C>) is consistent, that is,
+         * no change has overlapped the copy.
+         *
+         * @param[in] sequenceNumber  sequence number at start of
+         *                            copy
+         * @return  information whether copy is consistent
+         */
+        Boolean endRead (IN size_t sequenceNumber) const
+        {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return (_sequenceNumber.load(std::memory_order_relaxed)
+                    == sequenceNumber);
+        }
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the number of change starts and ends so far; odd
+             * while a change is in progress */
+            std::atomic<size_t> _sequenceNumber;
+
+    };
+
+}
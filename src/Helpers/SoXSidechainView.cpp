@@ -0,0 +1,157 @@
+/**
+ * @file
+ * The <C>SoXSidechainView</C> body implements a read-only view onto
+ * the sidechain channels of a block in host memory.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXSidechainView.h"
+
+#include <cmath>
+
+/*--------------------*/
+
+using SoXPlugins::Helpers::SoXSidechainView;
+
+/*====================*/
+
+namespace SoXPlugins::Helpers {
+
+    /**
+     * Sets the first <C>count</C> entries of <C>maximumArray</C> to
+     * the maximum absolute sample over <C>channelCount</C> channels
+     * of <C>channelArray</C> in the frames starting at
+     * <C>position</C>.
+     *
+     * @tparam     SampleType    type of host samples (float or
+     *                           double)
+     * @param[in]  channelArray  array of pointers to channels
+     * @param[in]  channelCount  number of channels
+     * @param[in]  position      index of first frame
+     * @param[in]  count         number of frames
+     * @param[out] maximumArray  the maximum absolute sample per frame
+     */
+    template<typename SampleType>
+    static void
+    _maximumAbsoluteSample (IN SampleType* const* channelArray,
+                            IN Natural channelCount,
+                            IN Natural position,
+                            IN Natural count,
+                            OUT AudioSample* maximumArray)
+    {
+        double* resultArray = (double*) maximumArray;
+
+        for (size_t i = 0;  i < (size_t) count;  i++) {
+            resultArray[i] = 0.0;
+        }
+
+        for (Natural channel = 0;  channel < channelCount;  channel++) {
+            const SampleType* sampleArray =
+                channelArray[(size_t) channel] + (size_t) position;
+
+            for (size_t i = 0;  i < (size_t) count;  i++) {
+                const double absValue =
+                    std::abs((double) sampleArray[i]);
+                resultArray[i] = (absValue > resultArray[i]
+                                  ? absValue : resultArray[i]);
+            }
+        }
+    }
+
+}
+
+/*============================================================*/
+
+/*--------------------*/
+/* setup              */
+/*--------------------*/
+
+SoXSidechainView::SoXSidechainView ()
+    : _floatChannelArray{nullptr},
+      _doubleChannelArray{nullptr},
+      _channelCount{0},
+      _frameCount{0}
+{
+}
+
+/*--------------------*/
+
+void SoXSidechainView::set (IN float* const* channelArray,
+                            IN Natural channelCount,
+                            IN Natural frameCount)
+{
+    _floatChannelArray  = channelArray;
+    _doubleChannelArray = nullptr;
+    _channelCount       = channelCount;
+    _frameCount         = frameCount;
+}
+
+/*--------------------*/
+
+void SoXSidechainView::set (IN double* const* channelArray,
+                            IN Natural channelCount,
+                            IN Natural frameCount)
+{
+    _floatChannelArray  = nullptr;
+    _doubleChannelArray = channelArray;
+    _channelCount       = channelCount;
+    _frameCount         = frameCount;
+}
+
+/*--------------------*/
+
+void SoXSidechainView::clear ()
+{
+    _floatChannelArray  = nullptr;
+    _doubleChannelArray = nullptr;
+    _channelCount       = 0;
+    _frameCount         = 0;
+}
+
+/*--------------------*/
+/* property queries   */
+/*--------------------*/
+
+Boolean SoXSidechainView::isEmpty () const
+{
+    return (_channelCount == 0);
+}
+
+/*--------------------*/
+
+Natural SoXSidechainView::channelCount () const
+{
+    return _channelCount;
+}
+
+/*--------------------*/
+
+Natural SoXSidechainView::frameCount () const
+{
+    return _frameCount;
+}
+
+/*--------------------*/
+/* evaluation         */
+/*--------------------*/
+
+void
+SoXSidechainView::maximumAbsoluteSample (IN Natural position,
+                                         IN Natural count,
+                                         OUT AudioSample* maximumArray)
+    const
+{
+    if (_floatChannelArray != nullptr) {
+        _maximumAbsoluteSample(_floatChannelArray, _channelCount,
+                               position, count, maximumArray);
+    } else {
+        _maximumAbsoluteSample(_doubleChannelArray, _channelCount,
+                               position, count, maximumArray);
+    }
+}
@@ -0,0 +1,153 @@
+/**
+ * @file
+ * The <C>SoXSidechainView</C> specification defines a read-only
+ * view onto the sidechain channels of a block in host memory.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "AudioSample.h"
+#include "Natural.h"
+
+/*--------------------*/
+
+using Audio::AudioSample;
+using BaseTypes::Primitives::Boolean;
+using BaseTypes::Primitives::Natural;
+
+/*====================*/
+
+namespace SoXPlugins::Helpers {
+
+    /**
+     * A <C>SoXSidechainView</C> object refers to the channels of a
+     * sidechain (like the key signal of a ducking compander) in the
+     * host buffer without copying them; the samples are either
+     * floats or doubles depending on the host.  The view is only
+     * valid during the processing of a single block and must not
+     * be kept beyond it.
+     */
+    struct SoXSidechainView {
+
+        /*--------------------*/
+        /* setup              */
+        /*--------------------*/
+
+        /**
+         * Makes an empty sidechain view (no sidechain connected).
+         */
+        SoXSidechainView ();
+
+        /*--------------------*/
+
+        /**
+         * Sets view onto <C>channelCount</C> float channels in
+         * <C>channelArray</C> with <C>frameCount</C> samples each.
+         *
+         * @param[in] channelArray  array of pointers to channels
+         * @param[in] channelCount  number of channels
+         * @param[in] frameCount    number of samples per channel
+         */
+        void set (IN float* const* channelArray,
+                  IN Natural channelCount,
+                  IN Natural frameCount);
+
+        /*--------------------*/
+
+        /**
+         * Sets view onto <C>channelCount</C> double channels in
+         * <C>channelArray</C> with <C>frameCount</C> samples each.
+         *
+         * @param[in] channelArray  array of pointers to channels
+         * @param[in] channelCount  number of channels
+         * @param[in] frameCount    number of samples per channel
+         */
+        void set (IN double* const* channelArray,
+                  IN Natural channelCount,
+                  IN Natural frameCount);
+
+        /*--------------------*/
+
+        /**
+         * Resets view to be empty.
+         */
+        void clear ();
+
+        /*--------------------*/
+        /* property queries   */
+        /*--------------------*/
+
+        /**
+         * Tells whether no sidechain is connected.
+         *
+         * @return  information whether view has no channels
+         */
+        Boolean isEmpty () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns number of channels in view.
+         *
+         * @return  number of sidechain channels
+         */
+        Natural channelCount () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns number of samples per channel in view.
+         *
+         * @return  number of frames
+         */
+        Natural frameCount () const;
+
+        /*--------------------*/
+        /* evaluation         */
+        /*--------------------*/
+
+        /**
+         * Sets the first <C>count</C> entries of
+         * <C>maximumArray</C> to the maximum absolute sample over
+         * all sidechain channels in the frames starting at
+         * <C>position</C>; the channels are scanned one after the
+         * other on contiguous samples.
+         *
+         * @param[in]  position      index of first frame
+         * @param[in]  count         number of frames
+         * @param[out] maximumArray  the maximum absolute sample per
+         *                           frame
+         */
+        void maximumAbsoluteSample (IN Natural position,
+                                    IN Natural count,
+                                    OUT AudioSample* maximumArray) const;
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the float channels (if any) */
+            const float* const* _floatChannelArray;
+
+            /** the double channels (if any) */
+            const double* const* _doubleChannelArray;
+
+            /** the number of channels */
+            Natural _channelCount;
+
+            /** the number of samples per channel */
+            Natural _frameCount;
+
+    };
+
+}
@@ -0,0 +1,155 @@
+/**
+ * @file
+ * The <C>SoXSnapshotExchange</C> specification defines a wait-free
+ * handoff of parameter snapshots from a producer thread to the audio
+ * thread via triple buffering.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-01
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include <atomic>
+#include "Natural.h"
+
+/*--------------------*/
+
+using BaseTypes::Primitives::Boolean;
+using BaseTypes::Primitives::Natural;
+
+/*====================*/
+
+namespace SoXPlugins::Helpers {
+
+    /**
+     * A <C>SoXSnapshotExchange</C> object hands snapshots of type
+     * <C>T</C> from a single producer (e.g. the parameter change
+     * code) to a single consumer (e.g. the audio thread at block
+     * start).  It holds three slots: the producer fills its slot and
+     * publishes it by a single atomic exchange with the middle slot,
+     * the consumer exchanges its slot with the middle slot when that
+     * has been published since the last acquisition.  Hence no side
+     * ever waits, nothing is allocated or reclaimed and the consumer
+     * never sees a partially written snapshot; when the producer
+     * publishes several snapshots in between, the consumer only gets
+     * the latest.
+     *
+     * @tparam T  type of snapshot (must be default-constructible
+     *            and assignable)
+     */
+    template<typename T>
+    struct SoXSnapshotExchange {
+
+        /**
+         * Makes exchange with default snapshots and nothing
+         * published.
+         */
+        SoXSnapshotExchange ()
+            : _slotList{},
+              _writeIndex{0},
+              _readIndex{1},
+              _middleState{2}
+        {
+        }
+
+        /*--------------------*/
+        /* producer side      */
+        /*--------------------*/
+
+        /**
+         * Returns the slot to be filled by the producer before
+         * <C>publish</C>.
+         *
+         * @return  snapshot slot owned by producer
+         */
+        T& pendingSnapshot ()
+        {
+            return _slotList[(size_t) _writeIndex];
+        }
+
+        /*--------------------*/
+
+        /**
+         * Makes the pending snapshot available to the consumer; the
+         * producer gets a fresh slot for the next snapshot.
+         */
+        void publish ()
+        {
+            const size_t previousState =
+                _middleState.exchange((size_t) _writeIndex
+                                      | _publishedFlag);
+            _writeIndex = Natural{previousState & _indexMask};
+        }
+
+        /*--------------------*/
+        /* consumer side      */
+        /*--------------------*/
+
+        /**
+         * Takes over the latest published snapshot (if any) as the
+         * current snapshot of the consumer.
+         *
+         * @return  information whether a new snapshot has been
+         *          acquired
+         */
+        Boolean acquire ()
+        {
+            Boolean isAcquired =
+                ((_middleState.load() & _publishedFlag) != 0);
+
+            if (isAcquired) {
+                const size_t previousState =
+                    _middleState.exchange((size_t) _readIndex);
+                _readIndex = Natural{previousState & _indexMask};
+            }
+
+            return isAcquired;
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns the snapshot last acquired by the consumer.
+         *
+         * @return  current snapshot of consumer
+         */
+        const T& currentSnapshot () const
+        {
+            return _slotList[(size_t) _readIndex];
+        }
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the mask for the slot index in the middle state */
+            static constexpr size_t _indexMask = 3;
+
+            /** the flag in the middle state telling that the middle
+             * slot has been published and not yet acquired */
+            static constexpr size_t _publishedFlag = 4;
+
+            /** the three snapshot slots */
+            T _slotList[3];
+
+            /** the index of the slot owned by the producer */
+            Natural _writeIndex;
+
+            /** the index of the slot owned by the consumer */
+            Natural _readIndex;
+
+            /** the index of the middle slot combined with the
+             * published flag */
+            std::atomic<size_t> _middleState;
+
+    };
+
+}
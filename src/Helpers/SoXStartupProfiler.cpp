@@ -0,0 +1,238 @@
+/**
+ * @file
+ * The <C>SoXStartupProfiler</C> body implements a process-wide
+ * accumulation of the durations of the startup phases of the plugin
+ * instances.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXStartupProfiler.h"
+
+#include <atomic>
+#include <chrono>
+#include "Logging.h"
+
+/*--------------------*/
+
+using SoXPlugins::Helpers::SoXStartupPhase;
+using SoXPlugins::Helpers::SoXStartupPhaseStatistics;
+using SoXPlugins::Helpers::SoXStartupProfiler;
+
+namespace Helpers = SoXPlugins::Helpers;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
+
+/*====================*/
+
+/** the number of startup phases */
+static constexpr size_t _phaseCount =
+    (size_t) SoXStartupPhase::firstPrepareToPlay + 1;
+
+/*--------------------*/
+
+/**
+ * The accumulated counters of a single startup phase.
+ */
+struct _PhaseCounters {
+
+    /** the number of measured runs */
+    std::atomic<std::uint64_t> count{0};
+
+    /** the sum of the durations of all runs in nanoseconds */
+    std::atomic<std::uint64_t> totalTime{0};
+
+    /** the maximum duration of a single run in nanoseconds */
+    std::atomic<std::uint64_t> maximumTime{0};
+
+};
+
+/*--------------------*/
+/* auxiliary routines */
+/*--------------------*/
+
+/**
+ * Returns the current time of the steady clock in nanoseconds.
+ *
+ * @return  current time stamp
+ */
+static std::uint64_t _currentTimeStamp ()
+{
+    using namespace std::chrono;
+    const auto duration = steady_clock::now().time_since_epoch();
+    return (std::uint64_t) duration_cast<nanoseconds>(duration).count();
+}
+
+/*--------------------*/
+
+/**
+ * Returns the process-wide counters of <C>phase</C>.
+ *
+ * @param[in] phase  startup phase
+ * @return  reference to counters of phase
+ */
+static _PhaseCounters& _phaseCounters (IN SoXStartupPhase phase)
+{
+    static _PhaseCounters counterList[_phaseCount];
+    return counterList[(size_t) phase];
+}
+
+/*====================*/
+
+/*--------------------*/
+/* EXPORTED ROUTINES  */
+/*--------------------*/
+
+String Helpers::startupPhaseToString
+                    (IN SoXStartupPhase phase)
+{
+    String result;
+
+    switch (phase) {
+        case SoXStartupPhase::construction:
+            result = "construction";
+            break;
+
+        case SoXStartupPhase::parameterMapBuild:
+            result = "parameterMapBuild";
+            break;
+
+        case SoXStartupPhase::editorCreation:
+            result = "editorCreation";
+            break;
+
+        case SoXStartupPhase::stateRestore:
+            result = "stateRestore";
+            break;
+
+        default:
+            result = "firstPrepareToPlay";
+    }
+
+    return result;
+}
+
+/*====================*/
+
+String SoXStartupPhaseStatistics::toString () const
+{
+    const Real meanTime =
+        (count == 0 ? Real::zero : totalTime / Real{count});
+    return STR::expand("%1: count = %2, total = %3ms, mean = %4ms,"
+                       " max = %5ms",
+                       startupPhaseToString(phase), TOSTRING(count),
+                       TOSTRING(totalTime), TOSTRING(meanTime),
+                       TOSTRING(maximumTime));
+}
+
+/*====================*/
+
+SoXStartupProfiler::Span::Span (IN SoXStartupPhase phase)
+    : _phase{phase},
+      _startTimeStamp{startPhase()}
+{
+}
+
+/*--------------------*/
+
+SoXStartupProfiler::Span::~Span ()
+{
+    endPhase(_phase, _startTimeStamp);
+}
+
+/*====================*/
+
+/*--------------------*/
+/* measurement        */
+/*--------------------*/
+
+std::uint64_t SoXStartupProfiler::startPhase ()
+{
+    return _currentTimeStamp();
+}
+
+/*--------------------*/
+
+void SoXStartupProfiler::endPhase (IN SoXStartupPhase phase,
+                                   IN std::uint64_t startTimeStamp)
+{
+    const std::uint64_t duration = _currentTimeStamp() - startTimeStamp;
+    _PhaseCounters& counters = _phaseCounters(phase);
+    counters.count.fetch_add(1, std::memory_order_relaxed);
+    counters.totalTime.fetch_add(duration, std::memory_order_relaxed);
+
+    /* several instances may be constructed concurrently, hence the
+       maximum is updated by a compare-exchange loop */
+    std::uint64_t maximumTime =
+        counters.maximumTime.load(std::memory_order_relaxed);
+
+    while (duration > maximumTime
+           && !counters.maximumTime
+                   .compare_exchange_weak(maximumTime, duration,
+                                          std::memory_order_relaxed)) {
+    }
+
+    Logging_trace2("--: phase = %1, duration = %2ms",
+                   startupPhaseToString(phase),
+                   TOSTRING(Real{(double) duration / 1.0E6}));
+}
+
+/*--------------------*/
+/* statistics         */
+/*--------------------*/
+
+SoXStartupPhaseStatistics
+SoXStartupProfiler::statistics (IN SoXStartupPhase phase)
+{
+    const _PhaseCounters& counters = _phaseCounters(phase);
+    const double nanosecondsPerMillisecond = 1.0E6;
+    SoXStartupPhaseStatistics result;
+    result.phase = phase;
+    result.count =
+        Natural{(size_t) counters.count.load(std::memory_order_relaxed)};
+    result.totalTime =
+        Real{(double) counters.totalTime.load(std::memory_order_relaxed)
+             / nanosecondsPerMillisecond};
+    result.maximumTime =
+        Real{(double) counters.maximumTime.load(std::memory_order_relaxed)
+             / nanosecondsPerMillisecond};
+    return result;
+}
+
+/*--------------------*/
+
+String SoXStartupProfiler::report ()
+{
+    Logging_trace(">>");
+
+    String result = "";
+
+    for (size_t i = 0;  i < _phaseCount;  i++) {
+        result += statistics((SoXStartupPhase) i).toString() + "\n";
+    }
+
+    Logging_trace("<<");
+    return result;
+}
+
+/*--------------------*/
+
+void SoXStartupProfiler::reset ()
+{
+    Logging_trace(">>");
+
+    for (size_t i = 0;  i < _phaseCount;  i++) {
+        _PhaseCounters& counters = _phaseCounters((SoXStartupPhase) i);
+        counters.count.store(0, std::memory_order_relaxed);
+        counters.totalTime.store(0, std::memory_order_relaxed);
+        counters.maximumTime.store(0, std::memory_order_relaxed);
+    }
+
+    Logging_trace("<<");
+}
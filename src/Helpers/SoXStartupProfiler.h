@@ -0,0 +1,193 @@
+/**
+ * @file
+ * The <C>SoXStartupProfiler</C> specification defines a process-wide
+ * accumulation of the durations of the startup phases of the plugin
+ * instances (construction, parameter map build, editor creation,
+ * state restore and first preparation for playing).
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include <cstdint>
+#include "MyString.h"
+#include "Natural.h"
+#include "Real.h"
+
+/*--------------------*/
+
+using BaseTypes::Primitives::Natural;
+using BaseTypes::Primitives::Real;
+using BaseTypes::Primitives::String;
+
+/*====================*/
+
+namespace SoXPlugins::Helpers {
+
+    /**
+     * The phases of a plugin instance startup measured by the
+     * startup profiler.
+     */
+    enum class SoXStartupPhase {
+        construction, parameterMapBuild, editorCreation,
+        stateRestore, firstPrepareToPlay
+    };
+
+    /*--------------------*/
+
+    /**
+     * Converts <C>phase</C> to a string.
+     *
+     * @param[in] phase  startup phase to be converted
+     * @return string representation of <C>phase</C>
+     */
+    String startupPhaseToString (IN SoXStartupPhase phase);
+
+    /*====================*/
+
+    /**
+     * A <C>SoXStartupPhaseStatistics</C> object is a snapshot of the
+     * accumulated durations of a single startup phase over all plugin
+     * instances of the process; all times are in milliseconds.
+     */
+    struct SoXStartupPhaseStatistics {
+
+        /** the measured phase */
+        SoXStartupPhase phase;
+
+        /** the number of measured phase runs */
+        Natural count;
+
+        /** the sum of the durations of all runs */
+        Real totalTime;
+
+        /** the maximum duration of a single run */
+        Real maximumTime;
+
+        /*--------------------*/
+
+        /**
+         * Returns string representation of statistics
+         *
+         * @return string representation
+         */
+        String toString () const;
+
+    };
+
+    /*====================*/
+
+    /**
+     * The <C>SoXStartupProfiler</C> module accumulates the durations
+     * of the startup phases of all plugin instances in the process
+     * with the steady clock.  The counters are lock-free atomics, so
+     * phases may be measured on any thread; since every phase run
+     * costs two clock reads only, measurement is always on.
+     */
+    struct SoXStartupProfiler {
+
+        /**
+         * A <C>Span</C> object measures the duration of a startup
+         * phase from its construction to its destruction.
+         */
+        struct Span {
+
+            /**
+             * Starts the measurement of a run of <C>phase</C>.
+             *
+             * @param[in] phase  startup phase to be measured
+             */
+            Span (IN SoXStartupPhase phase);
+
+            /*--------------------*/
+
+            /**
+             * Ends the measurement and records the run.
+             */
+            ~Span ();
+
+            /*--------------------*/
+
+            Span (IN Span&) = delete;
+
+            /*--------------------*/
+            /*--------------------*/
+
+            private:
+
+                /** the measured phase */
+                SoXStartupPhase _phase;
+
+                /** the time stamp of the phase start in
+                 * nanoseconds */
+                std::uint64_t _startTimeStamp;
+
+        };
+
+        /*--------------------*/
+        /* measurement        */
+        /*--------------------*/
+
+        /**
+         * Returns the start time stamp for a phase measurement.
+         *
+         * @return  time stamp in nanoseconds
+         */
+        static std::uint64_t startPhase ();
+
+        /*--------------------*/
+
+        /**
+         * Records a run of <C>phase</C> started at
+         * <C>startTimeStamp</C> (as returned by
+         * <C>startPhase</C>).
+         *
+         * @param[in] phase           measured startup phase
+         * @param[in] startTimeStamp  time stamp of phase start in
+         *                            nanoseconds
+         */
+        static void endPhase (IN SoXStartupPhase phase,
+                              IN std::uint64_t startTimeStamp);
+
+        /*--------------------*/
+        /* statistics         */
+        /*--------------------*/
+
+        /**
+         * Returns a snapshot of the accumulated statistics of
+         * <C>phase</C>.
+         *
+         * @param[in] phase  startup phase to be reported
+         * @return  phase statistics
+         */
+        static SoXStartupPhaseStatistics statistics
+                                             (IN SoXStartupPhase phase);
+
+        /*--------------------*/
+
+        /**
+         * Returns a multiline report with the statistics of all
+         * startup phases in phase order.
+         *
+         * @return  report string
+         */
+        static String report ();
+
+        /*--------------------*/
+
+        /**
+         * Clears the accumulated statistics of all phases.
+         */
+        static void reset ();
+
+    };
+
+}
@@ -0,0 +1,564 @@
+/**
+ * @file
+ * The <C>SoXTelemetryPublisher</C> body implements an opt-in
+ * publisher writing per-instance processing counters into a named
+ * shared memory segment, such that an external agent can monitor
+ * all effect instances of a process without opening their editors.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXTelemetryPublisher.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include "Logging.h"
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+/*--------------------*/
+
+using SoXPlugins::Helpers::SoXTelemetryPublisher;
+using SoXPlugins::Helpers::SoXTelemetrySegmentHeader;
+using SoXPlugins::Helpers::SoXTelemetrySlotData;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
+
+/*====================*/
+
+static_assert(sizeof(SoXTelemetrySegmentHeader) == 64,
+              "the segment header must have the documented size");
+
+static_assert(sizeof(SoXTelemetrySlotData) == 256,
+              "a segment slot must have the documented size");
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "the counters in shared memory must be address-free");
+
+/** the weight of a new block in the smoothed load (about the last
+ * 32 blocks are relevant) */
+static const double _smoothingFactor = 1.0 / 32.0;
+
+/** the load above which a block is counted as critical */
+static const double _criticalLoad = 0.8;
+
+/** the name of the environment variable switching on the
+ * telemetry */
+static const char* _enablingVariableName = "SOXPLUGINS_TELEMETRY";
+
+/*--------------------*/
+/* auxiliary routines */
+/*--------------------*/
+
+/**
+ * Returns the current time of the steady clock in nanoseconds.
+ *
+ * @return  current time stamp
+ */
+static std::uint64_t _currentTimeStamp ()
+{
+    using namespace std::chrono;
+    const auto duration = steady_clock::now().time_since_epoch();
+    return (std::uint64_t) duration_cast<nanoseconds>(duration).count();
+}
+
+/*--------------------*/
+
+/**
+ * Tells whether the environment switches on the telemetry.
+ *
+ * @return  information whether telemetry is published
+ */
+static Boolean _isEnabledByEnvironment ()
+{
+    const char* value = std::getenv(_enablingVariableName);
+    return (value != nullptr && value[0] != '\0'
+            && String{value} != "0");
+}
+
+/*--------------------*/
+
+/**
+ * Returns the id of the current process.
+ *
+ * @return  process id
+ */
+static std::uint64_t _processId ()
+{
+    #ifdef _WIN32
+        return 0;
+    #else
+        return (std::uint64_t) getpid();
+    #endif
+}
+
+/*--------------------*/
+
+/**
+ * Counts the non-finite and denormal samples among the
+ * <C>sampleCount</C> samples in the <C>channelCount</C> channels of
+ * <C>channelArray</C> and adds them to <C>nonFiniteCount</C> and
+ * <C>denormalCount</C>; <C>smallestNormal</C> is the smallest
+ * normal magnitude of the sample type.
+ *
+ * @tparam SampleType  float or double
+ * @param[in]    channelArray    the samples per channel
+ * @param[in]    channelCount    number of channels
+ * @param[in]    sampleCount     number of samples per channel
+ * @param[in]    smallestNormal  smallest normal sample magnitude
+ * @param[inout] nonFiniteCount  count of non-finite samples
+ * @param[inout] denormalCount   count of denormal samples
+ */
+template <typename SampleType>
+static void _countSpecialSamples (IN SampleType* const* channelArray,
+                                  IN Natural channelCount,
+                                  IN Natural sampleCount,
+                                  IN SampleType smallestNormal,
+                                  INOUT std::uint64_t& nonFiniteCount,
+                                  INOUT std::uint64_t& denormalCount)
+{
+    for (size_t channel = 0;  channel < (size_t) channelCount;
+         channel++) {
+        const SampleType* sampleArray = channelArray[channel];
+
+        for (size_t i = 0;  i < (size_t) sampleCount;  i++) {
+            const SampleType sample = sampleArray[i];
+            const SampleType magnitude = std::fabs(sample);
+            nonFiniteCount += !std::isfinite(sample);
+            denormalCount  += (magnitude != 0
+                               && magnitude < smallestNormal);
+        }
+    }
+}
+
+/*====================*/
+
+namespace SoXPlugins::Helpers {
+
+    /**
+     * A <C>_TelemetrySegment</C> object is the shared memory
+     * segment of the process with its slots; it is created on the
+     * first claim of a slot and removed when the process ends.
+     */
+    struct _TelemetrySegment {
+
+        /** the mapped segment (or null when not available) */
+        std::uint8_t* data{nullptr};
+
+        /** the length of the mapped segment in bytes */
+        size_t length{0};
+
+        /** information whether creating the segment has already
+         * been tried */
+        Boolean isInitialized{false};
+
+        /** the last instance id handed out */
+        std::uint64_t lastInstanceId{0};
+
+        /*--------------------*/
+
+        /**
+         * Unmaps and removes the segment (if any).
+         */
+        ~_TelemetrySegment ()
+        {
+            #ifndef _WIN32
+                if (data != nullptr) {
+                    munmap((void*) data, length);
+                    shm_unlink(SoXTelemetryPublisher::segmentName()
+                               .c_str());
+                }
+            #endif
+        }
+
+        /*--------------------*/
+
+        /**
+         * Creates and maps the segment with an initialized header
+         * unless this has already been tried.
+         */
+        void initialize ()
+        {
+            if (!isInitialized) {
+                isInitialized = true;
+                const size_t slotCount = SoXTelemetryPublisher::slotCount;
+                const size_t byteCount =
+                    (sizeof(SoXTelemetrySegmentHeader)
+                     + slotCount * sizeof(SoXTelemetrySlotData));
+
+                #ifndef _WIN32
+                    const String name = SoXTelemetryPublisher::segmentName();
+                    const int descriptor =
+                        shm_open(name.c_str(), O_CREAT | O_RDWR, 0644);
+
+                    if (descriptor >= 0) {
+                        void* address = MAP_FAILED;
+
+                        if (ftruncate(descriptor, (off_t) byteCount) == 0) {
+                            address = mmap(nullptr, byteCount,
+                                           PROT_READ | PROT_WRITE,
+                                           MAP_SHARED, descriptor, 0);
+                        }
+
+                        /* the mapping stays valid after the
+                           descriptor is closed */
+                        ::close(descriptor);
+
+                        if (address == MAP_FAILED) {
+                            shm_unlink(name.c_str());
+                        } else {
+                            data   = (std::uint8_t*) address;
+                            length = byteCount;
+                        }
+                    }
+
+                    Logging_trace2("--: segment = %1, isAvailable = %2",
+                                   name, TOSTRING(data != nullptr));
+                #endif
+
+                if (data != nullptr) {
+                    /* the header is completed by the magic number,
+                       such that a reader never sees a partial
+                       one */
+                    std::memset(data, 0, byteCount);
+                    SoXTelemetrySegmentHeader* header =
+                        (SoXTelemetrySegmentHeader*) data;
+                    header->layoutVersion =
+                        SoXTelemetrySegmentHeader::currentLayoutVersion;
+                    header->slotCount = (std::uint32_t) slotCount;
+                    header->headerByteCount =
+                        (std::uint32_t) sizeof(SoXTelemetrySegmentHeader);
+                    header->slotByteCount =
+                        (std::uint32_t) sizeof(SoXTelemetrySlotData);
+                    header->processId = _processId();
+                    std::atomic_thread_fence(std::memory_order_release);
+                    header->magic = SoXTelemetrySegmentHeader::magicNumber;
+                }
+            }
+        }
+
+        /*--------------------*/
+
+        /**
+         * Returns the slot with index <C>index</C>.
+         *
+         * @param[in] index  slot index
+         * @return  slot data
+         */
+        SoXTelemetrySlotData* slot (IN size_t index) const
+        {
+            return (SoXTelemetrySlotData*)
+                       (data + sizeof(SoXTelemetrySegmentHeader)
+                        + index * sizeof(SoXTelemetrySlotData));
+        }
+
+    };
+
+}
+
+/*--------------------*/
+
+using SoXPlugins::Helpers::_TelemetrySegment;
+
+/**
+ * Returns the mutex protecting the slot allocation; it is never
+ * locked on the audio thread.
+ *
+ * @return  reference to segment mutex
+ */
+static std::mutex& _segmentMutex ()
+{
+    static std::mutex mutex{};
+    return mutex;
+}
+
+/*--------------------*/
+
+/**
+ * Returns the shared memory segment of the process.
+ *
+ * @return  reference to segment
+ */
+static _TelemetrySegment& _segment ()
+{
+    static _TelemetrySegment segment{};
+    return segment;
+}
+
+/*--------------------*/
+
+/**
+ * Copies <C>name</C> into the name field of <C>slot</C> (truncated
+ * and NUL-terminated).
+ *
+ * @param[inout] slot  slot to be changed
+ * @param[in]    name  new name of instance
+ */
+static void _setSlotName (INOUT SoXTelemetrySlotData& slot,
+                          IN String& name)
+{
+    const size_t length =
+        std::min(name.size(), SoXTelemetrySlotData::nameLength - 1);
+    std::memset(slot.name, 0, SoXTelemetrySlotData::nameLength);
+    std::memcpy(slot.name, name.c_str(), length);
+}
+
+/*====================*/
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+SoXTelemetryPublisher::SoXTelemetryPublisher (IN String& name)
+    : _slot{nullptr},
+      _smoothedLoad{0.0}
+{
+    Logging_trace1(">>: %1", name);
+
+    if (isEnabled()) {
+        std::lock_guard<std::mutex> guard{_segmentMutex()};
+        _TelemetrySegment& segment = _segment();
+        segment.initialize();
+
+        for (size_t i = 0;  i < slotCount;  i++) {
+            SoXTelemetrySlotData* slot =
+                (segment.data == nullptr ? nullptr : segment.slot(i));
+
+            if (_slot == nullptr && slot != nullptr
+                && slot->instanceId.load(std::memory_order_relaxed) == 0) {
+                /* the counters are complete before the slot is
+                   published by its id */
+                std::memset((void*) slot, 0, sizeof(SoXTelemetrySlotData));
+                _setSlotName(*slot, name);
+                segment.lastInstanceId++;
+                slot->instanceId.store(segment.lastInstanceId,
+                                       std::memory_order_release);
+                _slot = slot;
+            }
+        }
+    }
+
+    Logging_trace1("<<: %1", toString());
+}
+
+/*--------------------*/
+
+SoXTelemetryPublisher::~SoXTelemetryPublisher ()
+{
+    Logging_trace(">>");
+
+    if (_slot != nullptr) {
+        std::lock_guard<std::mutex> guard{_segmentMutex()};
+        _slot->instanceId.store(0, std::memory_order_release);
+    }
+
+    Logging_trace("<<");
+}
+
+/*-----------------------*/
+/* string representation */
+/*-----------------------*/
+
+String SoXTelemetryPublisher::toString () const
+{
+    String st = "SoXTelemetryPublisher(isPublished = ";
+    st += TOSTRING(isPublished());
+
+    if (_slot != nullptr) {
+        st += STR::expand(", instanceId = %1, name = %2",
+                          TOSTRING(Natural{_slot->instanceId
+                                           .load(std::memory_order_relaxed)}),
+                          String{_slot->name});
+    }
+
+    st += ")";
+    return st;
+}
+
+/*--------------------*/
+/* queries            */
+/*--------------------*/
+
+Boolean SoXTelemetryPublisher::isEnabled ()
+{
+    static const Boolean isEnabled = _isEnabledByEnvironment();
+    return isEnabled;
+}
+
+/*--------------------*/
+
+String SoXTelemetryPublisher::segmentName ()
+{
+    return "/SoXPlugins-telemetry-" + TOSTRING(Natural{_processId()});
+}
+
+/*--------------------*/
+
+Boolean SoXTelemetryPublisher::isPublished () const
+{
+    return (_slot != nullptr);
+}
+
+/*--------------------*/
+/* property change    */
+/*--------------------*/
+
+void SoXTelemetryPublisher::setName (IN String& name)
+{
+    Logging_trace1(">>: %1", name);
+
+    if (_slot != nullptr) {
+        /* a reader may see a partially changed name, but this only
+           happens when the effect of an instance is set */
+        _setSlotName(*_slot, name);
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXTelemetryPublisher::setMemoryByteCount (IN Natural byteCount)
+{
+    Logging_trace1(">>: %1", TOSTRING(byteCount));
+
+    if (_slot != nullptr) {
+        _slot->memoryByteCount.store((std::uint64_t) byteCount,
+                                     std::memory_order_relaxed);
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* measurement        */
+/*--------------------*/
+
+std::uint64_t SoXTelemetryPublisher::startBlock () const
+{
+    return (_slot == nullptr ? 0 : _currentTimeStamp());
+}
+
+/*--------------------*/
+
+void SoXTelemetryPublisher::endBlock (IN std::uint64_t startTimeStamp,
+                                      IN float* const* channelArray,
+                                      IN Natural channelCount,
+                                      IN Natural sampleCount,
+                                      IN Real sampleRate,
+                                      IN Natural qualityLevel)
+{
+    if (startTimeStamp != 0) {
+        std::uint64_t nonFiniteCount = 0;
+        std::uint64_t denormalCount  = 0;
+        _countSpecialSamples(channelArray, channelCount, sampleCount,
+                             FLT_MIN, nonFiniteCount, denormalCount);
+        _updateBlockCounters(startTimeStamp, sampleCount, sampleRate,
+                             nonFiniteCount, denormalCount,
+                             qualityLevel);
+    }
+}
+
+/*--------------------*/
+
+void SoXTelemetryPublisher::endBlock (IN std::uint64_t startTimeStamp,
+                                      IN double* const* channelArray,
+                                      IN Natural channelCount,
+                                      IN Natural sampleCount,
+                                      IN Real sampleRate,
+                                      IN Natural qualityLevel)
+{
+    if (startTimeStamp != 0) {
+        std::uint64_t nonFiniteCount = 0;
+        std::uint64_t denormalCount  = 0;
+        _countSpecialSamples(channelArray, channelCount, sampleCount,
+                             DBL_MIN, nonFiniteCount, denormalCount);
+        _updateBlockCounters(startTimeStamp, sampleCount, sampleRate,
+                             nonFiniteCount, denormalCount,
+                             qualityLevel);
+    }
+}
+
+/*--------------------*/
+/* private features   */
+/*--------------------*/
+
+void SoXTelemetryPublisher::_updateBlockCounters
+                                (IN std::uint64_t startTimeStamp,
+                                 IN Natural sampleCount,
+                                 IN Real sampleRate,
+                                 IN std::uint64_t nonFiniteCount,
+                                 IN std::uint64_t denormalCount,
+                                 IN Natural qualityLevel)
+{
+    /* the audio thread is the only writer of the block counters,
+       hence plain loads and stores suffice */
+    constexpr std::memory_order relaxed = std::memory_order_relaxed;
+    SoXTelemetrySlotData& slot = *_slot;
+    const std::uint64_t timeStamp = _currentTimeStamp();
+    const double blockDuration =
+        (sampleRate > Real::zero
+         ? (double) Real{sampleCount} / (double) sampleRate
+         : 0.0);
+    const double load =
+        (blockDuration == 0.0 ? 0.0
+         : (double) (timeStamp - startTimeStamp) * 1.0E-9
+           / blockDuration);
+    _smoothedLoad += _smoothingFactor * (load - _smoothedLoad);
+    const std::uint64_t loadInPermille =
+        (std::uint64_t) std::round(load * 1000.0);
+
+    slot.blockCount.store(slot.blockCount.load(relaxed) + 1, relaxed);
+    slot.sampleCount.store(slot.sampleCount.load(relaxed)
+                           + (std::uint64_t) sampleCount, relaxed);
+
+    if (load > 1.0) {
+        slot.deadlineMissCount
+            .store(slot.deadlineMissCount.load(relaxed) + 1, relaxed);
+    }
+
+    if (load > _criticalLoad) {
+        slot.criticalBlockCount
+            .store(slot.criticalBlockCount.load(relaxed) + 1, relaxed);
+    }
+
+    slot.loadInPermille
+        .store((std::uint64_t) std::round(_smoothedLoad * 1000.0),
+               relaxed);
+
+    if (loadInPermille > slot.maximumLoadInPermille.load(relaxed)) {
+        slot.maximumLoadInPermille.store(loadInPermille, relaxed);
+    }
+
+    if (nonFiniteCount > 0) {
+        slot.nonFiniteSampleCount
+            .store(slot.nonFiniteSampleCount.load(relaxed)
+                   + nonFiniteCount, relaxed);
+    }
+
+    if (denormalCount > 0) {
+        slot.denormalSampleCount
+            .store(slot.denormalSampleCount.load(relaxed)
+                   + denormalCount, relaxed);
+    }
+
+    slot.qualityLevel.store((std::uint64_t) qualityLevel, relaxed);
+    slot.lastUpdateTime.store(timeStamp, relaxed);
+    slot.updateCount.store(slot.updateCount.load(relaxed) + 1,
+                           std::memory_order_release);
+}
@@ -0,0 +1,384 @@
+/**
+ * @file
+ * The <C>SoXTelemetryPublisher</C> specification defines an opt-in
+ * publisher writing per-instance processing counters into a named
+ * shared memory segment, such that an external agent can monitor
+ * all effect instances of a process without opening their editors.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include <atomic>
+#include <cstdint>
+#include "MyString.h"
+#include "Natural.h"
+#include "Real.h"
+
+/*--------------------*/
+
+using BaseTypes::Primitives::Boolean;
+using BaseTypes::Primitives::Natural;
+using BaseTypes::Primitives::Real;
+using BaseTypes::Primitives::String;
+
+/*====================*/
+
+namespace SoXPlugins::Helpers {
+
+    /**
+     * A <C>SoXTelemetrySegmentHeader</C> is the start of the shared
+     * memory segment of a process.  The segment is named
+     * <C>/SoXPlugins-telemetry-PID</C> (with the decimal process id,
+     * on Linux found in <C>/dev/shm</C>) and consists of this header
+     * followed by <C>slotCount</C> slots of <C>slotByteCount</C>
+     * bytes each.  All numbers are unsigned 64-bit or 32-bit
+     * integers in the byte order of the machine; a reader must
+     * check the magic number and the layout version and must use
+     * <C>headerByteCount</C> and <C>slotByteCount</C> for locating
+     * the slots, because later versions only append fields.
+     *
+     * Layout version 1:
+     *
+     *   - header: magic (8 bytes, "SOXTELEM"), layoutVersion (4),
+     *     slotCount (4), headerByteCount (4), slotByteCount (4),
+     *     processId (8), 32 bytes reserved
+     *   - slot: see <C>SoXTelemetrySlotData</C>
+     *
+     * A segment left over by a crashed process is recognized by its
+     * process id not being alive.
+     */
+    struct SoXTelemetrySegmentHeader {
+
+        /** the magic number of a segment ("SOXTELEM" in memory) */
+        static constexpr std::uint64_t magicNumber =
+            0x4D454C4554584F53ull;
+
+        /** the current layout version */
+        static constexpr std::uint32_t currentLayoutVersion = 1;
+
+        /*--------------------*/
+
+        /** the magic number identifying a telemetry segment */
+        std::uint64_t magic;
+
+        /** the version of the segment layout */
+        std::uint32_t layoutVersion;
+
+        /** the number of instance slots following the header */
+        std::uint32_t slotCount;
+
+        /** the number of bytes of the header */
+        std::uint32_t headerByteCount;
+
+        /** the number of bytes of each slot */
+        std::uint32_t slotByteCount;
+
+        /** the id of the publishing process */
+        std::uint64_t processId;
+
+        /** reserved for later versions (zero) */
+        std::uint64_t reserved[4];
+
+    };
+
+    /*--------------------*/
+
+    /**
+     * A <C>SoXTelemetrySlotData</C> is the slot of a single effect
+     * instance in the shared memory segment (256 bytes in layout
+     * version 1).  Each counter is written by a single thread with a
+     * plain relaxed atomic store (the block counters by the audio
+     * thread, the others by the message thread), hence a reader may
+     * see a block partially updated, but never a torn value.
+     *
+     * A slot is free when its <C>instanceId</C> is zero; a new
+     * instance fills name and counters before publishing its
+     * nonzero id, a leaving instance clears the id first.  A reader
+     * detects the reuse of a slot by a changed instance id; it gets
+     * a consistent block by reading <C>updateCount</C> before and
+     * after the counters and retrying when it has changed.
+     */
+    struct SoXTelemetrySlotData {
+
+        /** the number of characters in the name of an instance
+         * (including the terminating NUL) */
+        static constexpr size_t nameLength = 128;
+
+        /*--------------------*/
+
+        /** the process-unique id of the instance (zero for a free
+         * slot) */
+        std::atomic<std::uint64_t> instanceId;
+
+        /** the number of block updates so far */
+        std::atomic<std::uint64_t> updateCount;
+
+        /** the number of processed blocks */
+        std::atomic<std::uint64_t> blockCount;
+
+        /** the number of processed samples per channel */
+        std::atomic<std::uint64_t> sampleCount;
+
+        /** the number of blocks missing their deadline (with a
+         * processing time longer than their real time duration) */
+        std::atomic<std::uint64_t> deadlineMissCount;
+
+        /** the number of blocks with a load above 80% */
+        std::atomic<std::uint64_t> criticalBlockCount;
+
+        /** the smoothed DSP load in permille of real time */
+        std::atomic<std::uint64_t> loadInPermille;
+
+        /** the maximum DSP load of a block in permille of real
+         * time */
+        std::atomic<std::uint64_t> maximumLoadInPermille;
+
+        /** the memory footprint of the instance in bytes (as of
+         * its last preparation) */
+        std::atomic<std::uint64_t> memoryByteCount;
+
+        /** the number of output samples being NaN or infinite */
+        std::atomic<std::uint64_t> nonFiniteSampleCount;
+
+        /** the number of output samples being denormal */
+        std::atomic<std::uint64_t> denormalSampleCount;
+
+        /** the current quality level (zero for full quality) */
+        std::atomic<std::uint64_t> qualityLevel;
+
+        /** the time of the last block update in nanoseconds of the
+         * steady clock */
+        std::atomic<std::uint64_t> lastUpdateTime;
+
+        /** reserved for later versions (zero) */
+        std::atomic<std::uint64_t> reserved[3];
+
+        /** the name of the instance (NUL-terminated UTF-8) */
+        char name[nameLength];
+
+    };
+
+    /*====================*/
+
+    /**
+     * A <C>SoXTelemetryPublisher</C> object publishes the counters
+     * of a single effect instance in a slot of the process-wide
+     * shared memory segment: its DSP load, deadline misses, memory
+     * footprint, non-finite and denormal output samples and quality
+     * level.  The audio thread neither locks nor allocates, it only
+     * does relaxed atomic loads and stores into the slot, hence an
+     * external agent may scrape the segment at any time.
+     *
+     * Publishing is off by default; its setting is taken once per
+     * process from the environment variable
+     * <C>SOXPLUGINS_TELEMETRY</C> (set to a nonempty value other
+     * than "0").  When it is off, no segment is created and a block
+     * costs a single pointer check.  When all slots of the segment
+     * are taken, further instances are not published.  The segment
+     * is only available on POSIX systems (like <C>MappedFile</C>).
+     */
+    struct SoXTelemetryPublisher {
+
+        /** the number of instance slots in the segment */
+        static constexpr size_t slotCount = 64;
+
+        /*--------------------*/
+        /* con-/destruction   */
+        /*--------------------*/
+
+        /**
+         * Makes a publisher for an instance named <C>name</C> and
+         * claims a slot in the segment of the process (creating the
+         * segment on first use) when publishing is enabled.
+         *
+         * @param[in] name  name of published effect instance
+         */
+        SoXTelemetryPublisher (IN String& name = "");
+
+        /*--------------------*/
+
+        /**
+         * Releases the slot of the publisher (if any).
+         */
+        ~SoXTelemetryPublisher ();
+
+        /*--------------------*/
+
+        SoXTelemetryPublisher (IN SoXTelemetryPublisher&) = delete;
+
+        /*-----------------------*/
+        /* string representation */
+        /*-----------------------*/
+
+        /**
+         * Returns string representation of publisher.
+         *
+         * @return string representation
+         */
+        String toString () const;
+
+        /*--------------------*/
+        /* queries            */
+        /*--------------------*/
+
+        /**
+         * Tells whether publishing is switched on in this process.
+         *
+         * @return  information whether telemetry is published
+         */
+        static Boolean isEnabled ();
+
+        /*--------------------*/
+
+        /**
+         * Returns the name of the shared memory segment of this
+         * process.
+         *
+         * @return  segment name
+         */
+        static String segmentName ();
+
+        /*--------------------*/
+
+        /**
+         * Tells whether this publisher owns a slot in the segment.
+         *
+         * @return  information whether instance is published
+         */
+        Boolean isPublished () const;
+
+        /*--------------------*/
+        /* property change    */
+        /*--------------------*/
+
+        /**
+         * Sets name of published instance to <C>name</C>
+         * (truncated to the slot name length); must not be called
+         * on the audio thread.
+         *
+         * @param[in] name  new name of effect instance
+         */
+        void setName (IN String& name);
+
+        /*--------------------*/
+
+        /**
+         * Sets the memory footprint of the instance to
+         * <C>byteCount</C>; must not be called on the audio thread.
+         *
+         * @param[in] byteCount  memory footprint in bytes
+         */
+        void setMemoryByteCount (IN Natural byteCount);
+
+        /*--------------------*/
+        /* measurement        */
+        /*--------------------*/
+
+        /**
+         * Returns the start time stamp for a block measurement, zero
+         * when the instance is not published.
+         *
+         * @return  time stamp in nanoseconds (or zero)
+         */
+        std::uint64_t startBlock () const;
+
+        /*--------------------*/
+
+        /**
+         * Records the processing of a block of <C>sampleCount</C>
+         * samples at <C>sampleRate</C> in the <C>channelCount</C>
+         * channels of <C>channelArray</C> started at
+         * <C>startTimeStamp</C> (as returned by <C>startBlock</C>)
+         * together with <C>qualityLevel</C>; the output samples are
+         * scanned for non-finite and denormal values.  Does nothing
+         * for a zero start time stamp; must only be called on the
+         * audio thread.
+         *
+         * @param[in] startTimeStamp  time stamp of block start in
+         *                            nanoseconds
+         * @param[in] channelArray    the output samples per channel
+         * @param[in] channelCount    number of channels
+         * @param[in] sampleCount     number of samples per channel in
+         *                            block
+         * @param[in] sampleRate      sample rate of processing
+         * @param[in] qualityLevel    current quality level
+         */
+        void endBlock (IN std::uint64_t startTimeStamp,
+                       IN float* const* channelArray,
+                       IN Natural channelCount,
+                       IN Natural sampleCount,
+                       IN Real sampleRate,
+                       IN Natural qualityLevel);
+
+        /*--------------------*/
+
+        /**
+         * Records the processing of a block of <C>sampleCount</C>
+         * samples at <C>sampleRate</C> in the <C>channelCount</C>
+         * channels of <C>channelArray</C> started at
+         * <C>startTimeStamp</C> together with
+         * <C>qualityLevel</C> (for double precision samples).
+         *
+         * @param[in] startTimeStamp  time stamp of block start in
+         *                            nanoseconds
+         * @param[in] channelArray    the output samples per channel
+         * @param[in] channelCount    number of channels
+         * @param[in] sampleCount     number of samples per channel in
+         *                            block
+         * @param[in] sampleRate      sample rate of processing
+         * @param[in] qualityLevel    current quality level
+         */
+        void endBlock (IN std::uint64_t startTimeStamp,
+                       IN double* const* channelArray,
+                       IN Natural channelCount,
+                       IN Natural sampleCount,
+                       IN Real sampleRate,
+                       IN Natural qualityLevel);
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /**
+             * Updates the block counters of the slot for a block of
+             * <C>sampleCount</C> samples at <C>sampleRate</C>
+             * started at <C>startTimeStamp</C> with
+             * <C>nonFiniteCount</C> and <C>denormalCount</C> output
+             * samples and <C>qualityLevel</C>.
+             *
+             * @param[in] startTimeStamp  time stamp of block start
+             * @param[in] sampleCount     number of samples per channel
+             * @param[in] sampleRate      sample rate of processing
+             * @param[in] nonFiniteCount  number of non-finite samples
+             * @param[in] denormalCount   number of denormal samples
+             * @param[in] qualityLevel    current quality level
+             */
+            void _updateBlockCounters (IN std::uint64_t startTimeStamp,
+                                       IN Natural sampleCount,
+                                       IN Real sampleRate,
+                                       IN std::uint64_t nonFiniteCount,
+                                       IN std::uint64_t denormalCount,
+                                       IN Natural qualityLevel);
+
+            /*--------------------*/
+
+            /** the slot of this instance in the segment (or null
+             * when not published) */
+            SoXTelemetrySlotData* _slot;
+
+            /** the smoothed load of the recent blocks */
+            double _smoothedLoad;
+
+    };
+
+}
@@ -0,0 +1,828 @@
+/**
+ * @file
+ * The <C>SoXWorkerPool</C> body implements a process-wide pool of
+ * pre-spawned worker threads for spreading independent tasks of an
+ * audio block across several cores.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-02
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXWorkerPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include "DenormalGuard.h"
+#include "Logging.h"
+#include "OperatingSystem.h"
+
+/*--------------------*/
+
+using Audio::DenormalGuard;
+using BaseModules::OperatingSystem;
+using SoXPlugins::Helpers::SoXWorkerPool;
+using SoXPlugins::Helpers::SoXWorkerPoolStatistics;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
+
+/** the clock for deadlines and idle times */
+using _Clock = std::chrono::steady_clock;
+
+/*====================*/
+
+/** the number of polls of an idle worker before it sleeps */
+static const Natural _idleSpinCount = 2000;
+
+/** the maximum sleep time of an idle worker (in microseconds); a
+ * wakeup missed because the audio thread does not lock the wakeup
+ * mutex is caught up after this time */
+static const Natural _maximumSleepTime = 1000;
+
+/** the mask for a task index in a task range */
+static const std::uint64_t _taskIndexMask = 0xFFFF;
+
+/** the shift of the first task index in a task range */
+static const int _firstIndexShift = 16;
+
+/** the shift of the generation in a task range */
+static const int _generationShift = 32;
+
+/*--------------------*/
+
+/**
+ * Returns the task range word for <C>generation</C> with tasks from
+ * <C>firstIndex</C> up to (excluding) <C>lastIndex</C>.
+ *
+ * @param[in] generation  generation of task set
+ * @param[in] firstIndex  index of first task in range
+ * @param[in] lastIndex   index after last task in range
+ * @return  task range word
+ */
+static std::uint64_t _makeTaskRange (IN std::uint64_t generation,
+                                     IN std::uint64_t firstIndex,
+                                     IN std::uint64_t lastIndex)
+{
+    return ((generation << _generationShift)
+            | (firstIndex << _firstIndexShift)
+            | lastIndex);
+}
+
+/*--------------------*/
+
+/**
+ * Returns the number of nanoseconds elapsed since
+ * <C>startTime</C>.
+ *
+ * @param[in] startTime  start of time interval
+ * @return  elapsed time in nanoseconds
+ */
+static std::uint64_t _elapsedNanoseconds (IN _Clock::time_point startTime)
+{
+    const auto duration = _Clock::now() - startTime;
+    return (std::uint64_t)
+        std::chrono::duration_cast<std::chrono::nanoseconds>(duration)
+        .count();
+}
+
+/*====================*/
+
+SoXWorkerPoolStatistics::SoXWorkerPoolStatistics ()
+    : parallelTaskSetCount{0},
+      taskCount{0},
+      stealCount{0},
+      deadlineMissCount{0},
+      idleTime{0.0},
+      realtimeThreadCount{0},
+      detachedTaskCount{0}
+{
+}
+
+/*--------------------*/
+
+String SoXWorkerPoolStatistics::toString () const
+{
+    return STR::expand("SoXWorkerPoolStatistics("
+                       "parallelTaskSetCount = %1, taskCount = %2,"
+                       " stealCount = %3, deadlineMissCount = %4,",
+                       TOSTRING(parallelTaskSetCount),
+                       TOSTRING(taskCount), TOSTRING(stealCount),
+                       TOSTRING(deadlineMissCount))
+        + STR::expand(" idleTime = %1, realtimeThreadCount = %2,"
+                      " detachedTaskCount = %3)",
+                      TOSTRING(idleTime),
+                      TOSTRING(realtimeThreadCount),
+                      TOSTRING(detachedTaskCount));
+}
+
+/*====================*/
+
+const Natural SoXWorkerPool::maximumThreadCount = 16;
+
+const Natural SoXWorkerPool::maximumDetachedTaskCount =
+    Natural{_detachedTaskSlotCount};
+
+const Natural SoXWorkerPool::completedTaskHandle =
+    Natural{_detachedTaskSlotCount};
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+SoXWorkerPool& SoXWorkerPool::instance ()
+{
+    static SoXWorkerPool pool{};
+    return pool;
+}
+
+/*--------------------*/
+
+SoXWorkerPool::SoXWorkerPool ()
+    : _threadList{},
+      _minimumBlockLength{128},
+      _isStopped{false},
+      _generation{0},
+      _activeRangeCount{0},
+      _finishedTaskCount{0},
+      _droppedTaskCount{0},
+      _taskFunction{nullptr},
+      _taskContext{nullptr},
+      _hasDeadline{false},
+      _deadline{},
+      _parallelTaskSetCount{0},
+      _deadlineMissCount{0},
+      _realtimeThreadCount{0},
+      _detachedTaskCount{0},
+      _wakeupMutex{},
+      _wakeupCondition{}
+{
+    Logging_trace(">>");
+    _isBusy.clear();
+
+    for (_ThreadSlot& slot : _slotList) {
+        slot.taskRange.store(0);
+    }
+
+    for (_DetachedTaskSlot& taskSlot : _detachedTaskList) {
+        taskSlot.state.store(_DetachedTaskState::free);
+        taskSlot.taskFunction = nullptr;
+        taskSlot.context = nullptr;
+    }
+
+    resetStatistics();
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+SoXWorkerPool::~SoXWorkerPool ()
+{
+    Logging_trace(">>");
+    _stopThreads();
+    Logging_trace("<<");
+}
+
+/*-----------------------*/
+/* string representation */
+/*-----------------------*/
+
+String SoXWorkerPool::toString () const
+{
+    return STR::expand("SoXWorkerPool(threadCount = %1,"
+                       " minimumBlockLength = %2)",
+                       TOSTRING(threadCount()),
+                       TOSTRING(Natural{_minimumBlockLength.load()}));
+}
+
+/*--------------------*/
+/* configuration      */
+/*--------------------*/
+
+void SoXWorkerPool::configure (IN Natural threadCount,
+                               IN Natural minimumBlockLength)
+{
+    Logging_trace2(">>: threadCount = %1, minimumBlockLength = %2",
+                   TOSTRING(threadCount), TOSTRING(minimumBlockLength));
+
+    /* wait until no task set is processed; meanwhile callers fall
+       back to their own thread */
+    while (_isBusy.test_and_set(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+
+    _minimumBlockLength.store((size_t) minimumBlockLength);
+    const Natural effectiveThreadCount =
+        Natural::minimum(threadCount, maximumThreadCount);
+
+    if (effectiveThreadCount != this->threadCount()) {
+        _stopThreads();
+        _startThreads(effectiveThreadCount);
+    }
+
+    _isBusy.clear(std::memory_order_release);
+    Logging_trace1("<<: %1", toString());
+}
+
+/*--------------------*/
+
+void SoXWorkerPool::setMinimumBlockLength (IN Natural minimumBlockLength)
+{
+    Logging_trace1(">>: %1", TOSTRING(minimumBlockLength));
+    _minimumBlockLength.store((size_t) minimumBlockLength);
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+Natural SoXWorkerPool::minimumBlockLength () const
+{
+    return Natural{_minimumBlockLength.load()};
+}
+
+/*--------------------*/
+
+Natural SoXWorkerPool::threadCount () const
+{
+    return Natural{_threadList.size()};
+}
+
+/*--------------------*/
+
+Natural SoXWorkerPool::suggestedThreadCount (IN Natural taskCount)
+{
+    Logging_trace1(">>: %1", TOSTRING(taskCount));
+
+    const Natural hardwareThreadCount =
+        Natural{(size_t) std::thread::hardware_concurrency()};
+    Natural result = 0;
+
+    if (taskCount > 1 && hardwareThreadCount > 1) {
+        result = Natural::minimum(taskCount - 1, hardwareThreadCount - 1);
+        result = Natural::minimum(result, maximumThreadCount);
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(result));
+    return result;
+}
+
+/*--------------------*/
+
+void SoXWorkerPool::reserveThreads (IN Natural threadCount)
+{
+    Logging_trace1(">>: %1", TOSTRING(threadCount));
+
+    if (threadCount > this->threadCount()) {
+        configure(threadCount, Natural{_minimumBlockLength.load()});
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXWorkerPool::_startThreads (IN Natural threadCount)
+{
+    Logging_trace1(">>: %1", TOSTRING(threadCount));
+
+    _isStopped.store(false);
+    _realtimeThreadCount.store(0);
+
+    /* real-time workers sharing cores with the caller could starve
+       it, hence they are only raised when each has a core of its
+       own */
+    const Boolean isRealtime =
+        ((size_t) threadCount < (size_t) std::thread::hardware_concurrency());
+
+    /* slot 0 belongs to the calling thread */
+    for (Natural i = 1;  i <= threadCount;  i++) {
+        _threadList.push_back(std::thread{&SoXWorkerPool::_workerLoop,
+                                          this, (size_t) i,
+                                          (bool) isRealtime});
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXWorkerPool::_stopThreads ()
+{
+    Logging_trace(">>");
+
+    {
+        std::lock_guard<std::mutex> lock{_wakeupMutex};
+        _isStopped.store(true);
+    }
+
+    _wakeupCondition.notify_all();
+
+    for (std::thread& thread : _threadList) {
+        thread.join();
+    }
+
+    _threadList.clear();
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* processing         */
+/*--------------------*/
+
+void SoXWorkerPool::run (IN TaskFunction taskFunction,
+                         INOUT void* context,
+                         IN Natural taskCount,
+                         IN Natural blockLength)
+{
+    runUntil(taskFunction, context, taskCount, blockLength,
+             Deadline::max());
+}
+
+/*--------------------*/
+
+Boolean SoXWorkerPool::runUntil (IN TaskFunction taskFunction,
+                                 INOUT void* context,
+                                 IN Natural taskCount,
+                                 IN Natural blockLength,
+                                 IN Deadline deadline)
+{
+    Logging_traceHot2(">>: taskCount = %1, blockLength = %2",
+                      TOSTRING(taskCount), TOSTRING(blockLength));
+
+    const Boolean hasDeadline = (deadline != Deadline::max());
+    Boolean isParallel =
+        (taskCount > 1 && taskCount <= Natural{_taskIndexMask}
+         && (size_t) blockLength >= _minimumBlockLength.load()
+         && !_isBusy.test_and_set(std::memory_order_acquire));
+    Boolean isComplete = true;
+
+    if (isParallel && _threadList.empty()) {
+        _isBusy.clear(std::memory_order_release);
+        isParallel = false;
+    }
+
+    if (isParallel) {
+        isComplete = _runParallel(taskFunction, context, taskCount,
+                                  hasDeadline, deadline);
+        _isBusy.clear(std::memory_order_release);
+    } else {
+        for (Natural taskIndex = 0;  taskIndex < taskCount;  taskIndex++) {
+            isComplete = (isComplete
+                          && (!hasDeadline || _Clock::now() <= deadline));
+
+            if (isComplete) {
+                taskFunction(context, taskIndex);
+            }
+        }
+    }
+
+    if (!isComplete) {
+        _deadlineMissCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Logging_traceHot2("<<: isParallel = %1, isComplete = %2",
+                      TOSTRING(isParallel), TOSTRING(isComplete));
+    return isComplete;
+}
+
+/*--------------------*/
+
+Natural SoXWorkerPool::startDetachedTask (IN TaskFunction taskFunction,
+                                          INOUT void* context)
+{
+    Logging_traceHot(">>");
+
+    size_t taskHandle = _detachedTaskSlotCount;
+
+    if (!_threadList.empty()) {
+        for (size_t i = 0;
+             taskHandle == _detachedTaskSlotCount
+                 && i < _detachedTaskSlotCount;
+             i++) {
+            _DetachedTaskState state = _DetachedTaskState::free;
+
+            if (_detachedTaskList[i].state
+                    .compare_exchange_strong(state,
+                                             _DetachedTaskState::reserved,
+                                             std::memory_order_acquire)) {
+                taskHandle = i;
+            }
+        }
+    }
+
+    if (taskHandle == _detachedTaskSlotCount) {
+        taskFunction(context, 0);
+    } else {
+        /* the task data is published by the release store of the
+           state */
+        _DetachedTaskSlot& taskSlot = _detachedTaskList[taskHandle];
+        taskSlot.taskFunction = taskFunction;
+        taskSlot.context      = context;
+        taskSlot.state.store(_DetachedTaskState::submitted,
+                             std::memory_order_release);
+        _wakeupCondition.notify_all();
+    }
+
+    const Natural result{taskHandle};
+    Logging_traceHot1("<<: %1", TOSTRING(result));
+    return result;
+}
+
+/*--------------------*/
+
+void SoXWorkerPool::completeDetachedTask (IN Natural taskHandle)
+{
+    Logging_traceHot1(">>: %1", TOSTRING(taskHandle));
+
+    if (taskHandle < completedTaskHandle) {
+        _DetachedTaskSlot& taskSlot =
+            _detachedTaskList[(size_t) taskHandle];
+        _DetachedTaskState state = _DetachedTaskState::submitted;
+
+        if (taskSlot.state
+                .compare_exchange_strong(state,
+                                         _DetachedTaskState::running,
+                                         std::memory_order_acquire)) {
+            /* no worker has taken the task so far, hence it is
+               processed here */
+            Logging_beginSpan("SoXWorkerPool.detachedTask",
+                              taskSlot.context);
+            taskSlot.taskFunction(taskSlot.context, 0);
+            Logging_endSpan("SoXWorkerPool.detachedTask",
+                            taskSlot.context);
+        } else {
+            while (taskSlot.state.load(std::memory_order_acquire)
+                   != _DetachedTaskState::done) {
+                std::this_thread::yield();
+            }
+        }
+
+        taskSlot.state.store(_DetachedTaskState::free,
+                             std::memory_order_release);
+    }
+
+    Logging_traceHot("<<");
+}
+
+/*--------------------*/
+
+Boolean SoXWorkerPool::_runParallel (IN TaskFunction taskFunction,
+                                     INOUT void* context,
+                                     IN Natural taskCount,
+                                     IN Boolean hasDeadline,
+                                     IN Deadline deadline)
+{
+    /* the task set data is published by the release stores of the
+       ranges and only read after a task has been taken */
+    _taskFunction = taskFunction;
+    _taskContext  = context;
+    _hasDeadline  = hasDeadline;
+    _deadline     = deadline;
+    _finishedTaskCount.store(0, std::memory_order_relaxed);
+    _droppedTaskCount.store(0, std::memory_order_relaxed);
+
+    /* the tasks are split into contiguous ranges for the caller
+       and the workers, the first ranges get one more task for an
+       uneven split */
+    const std::uint64_t generation =
+        (_generation.load(std::memory_order_relaxed) + 1) & 0xFFFFFFFF;
+    const size_t totalTaskCount = (size_t) taskCount;
+    const size_t rangeCount =
+        std::min(_threadList.size() + 1, totalTaskCount);
+    const size_t rangeLength = totalTaskCount / rangeCount;
+    const size_t remainder = totalTaskCount % rangeCount;
+    size_t firstIndex = 0;
+
+    for (size_t slotIndex = 0;  slotIndex < _rangeCount;  slotIndex++) {
+        const size_t length =
+            (slotIndex >= rangeCount ? 0
+             : rangeLength + (slotIndex < remainder ? 1 : 0));
+        _slotList[slotIndex].taskRange
+            .store(_makeTaskRange(generation, firstIndex,
+                                  firstIndex + length),
+                   std::memory_order_release);
+        firstIndex += length;
+    }
+
+    _activeRangeCount.store(rangeCount, std::memory_order_relaxed);
+    _generation.store(generation, std::memory_order_release);
+    _parallelTaskSetCount.fetch_add(1, std::memory_order_relaxed);
+    _wakeupCondition.notify_all();
+
+    /* help processing; after the deadline the tasks not taken are
+       dropped and only the tasks started by the workers are
+       waited for */
+    _processTasks(0);
+    _dropPendingTasks();
+
+    while (_finishedTaskCount.load(std::memory_order_acquire)
+           < totalTaskCount) {
+        std::this_thread::yield();
+    }
+
+    return (_droppedTaskCount.load(std::memory_order_relaxed) == 0);
+}
+
+/*--------------------*/
+
+Boolean SoXWorkerPool::_takeTask (IN size_t slotIndex,
+                                  IN std::uint64_t generation,
+                                  IN Boolean isOwner,
+                                  OUT size_t& taskIndex)
+{
+    std::atomic<std::uint64_t>& taskRange =
+        _slotList[slotIndex].taskRange;
+    std::uint64_t range = taskRange.load(std::memory_order_acquire);
+    Boolean isTaken = false;
+    Boolean isDone = false;
+
+    while (!isDone) {
+        const std::uint64_t firstIndex =
+            (range >> _firstIndexShift) & _taskIndexMask;
+        const std::uint64_t lastIndex = range & _taskIndexMask;
+
+        if ((range >> _generationShift) != generation
+            || firstIndex >= lastIndex) {
+            isDone = true;
+        } else {
+            /* the owner takes from the front, thieves from the
+               back, such that they rarely collide */
+            const std::uint64_t newRange =
+                (isOwner
+                 ? _makeTaskRange(generation, firstIndex + 1, lastIndex)
+                 : _makeTaskRange(generation, firstIndex, lastIndex - 1));
+
+            if (taskRange.compare_exchange_weak(range, newRange,
+                                                std::memory_order_acq_rel,
+                                                std::memory_order_acquire)) {
+                taskIndex = (size_t) (isOwner ? firstIndex : lastIndex - 1);
+                isTaken = true;
+                isDone  = true;
+            }
+        }
+    }
+
+    return isTaken;
+}
+
+/*--------------------*/
+
+Boolean SoXWorkerPool::_processTasks (IN size_t slotIndex)
+{
+    const std::uint64_t generation =
+        _generation.load(std::memory_order_acquire);
+    const size_t rangeCount =
+        _activeRangeCount.load(std::memory_order_relaxed);
+    _ThreadSlot& slot = _slotList[slotIndex];
+    Boolean isProcessed = false;
+    Boolean isDone = false;
+
+    while (!isDone) {
+        size_t taskIndex = 0;
+        size_t victimIndex = slotIndex;
+        Boolean isTaken = _takeTask(slotIndex, generation, true, taskIndex);
+
+        for (size_t i = 1;  !isTaken && i < rangeCount;  i++) {
+            victimIndex = (slotIndex + i) % rangeCount;
+            isTaken = _takeTask(victimIndex, generation, false, taskIndex);
+        }
+
+        if (!isTaken) {
+            isDone = true;
+        } else if (_hasDeadline && _Clock::now() > _deadline) {
+            /* the task set cannot change before this task has been
+               finished, hence its data is valid */
+            _droppedTaskCount.fetch_add(1, std::memory_order_relaxed);
+            _finishedTaskCount.fetch_add(1, std::memory_order_release);
+            isDone = true;
+        } else {
+            Logging_beginSpan("SoXWorkerPool.task", _taskContext);
+            _taskFunction(_taskContext, Natural{taskIndex});
+            Logging_endSpan("SoXWorkerPool.task", _taskContext);
+            slot.taskCount.fetch_add(1, std::memory_order_relaxed);
+
+            if (victimIndex != slotIndex) {
+                slot.stealCount.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            _finishedTaskCount.fetch_add(1, std::memory_order_release);
+            isProcessed = true;
+        }
+    }
+
+    return isProcessed;
+}
+
+/*--------------------*/
+
+void SoXWorkerPool::_dropPendingTasks ()
+{
+    const std::uint64_t generation =
+        _generation.load(std::memory_order_relaxed);
+    const size_t rangeCount =
+        _activeRangeCount.load(std::memory_order_relaxed);
+
+    for (size_t slotIndex = 0;  slotIndex < rangeCount;  slotIndex++) {
+        std::atomic<std::uint64_t>& taskRange =
+            _slotList[slotIndex].taskRange;
+        std::uint64_t range = taskRange.load(std::memory_order_acquire);
+        Boolean isDone = false;
+
+        while (!isDone) {
+            const std::uint64_t firstIndex =
+                (range >> _firstIndexShift) & _taskIndexMask;
+            const std::uint64_t lastIndex = range & _taskIndexMask;
+
+            if (firstIndex >= lastIndex) {
+                isDone = true;
+            } else if (taskRange.compare_exchange_weak(
+                           range,
+                           _makeTaskRange(generation, lastIndex,
+                                          lastIndex),
+                           std::memory_order_acq_rel,
+                           std::memory_order_acquire)) {
+                const size_t count = (size_t) (lastIndex - firstIndex);
+                _droppedTaskCount.fetch_add(count,
+                                            std::memory_order_relaxed);
+                _finishedTaskCount.fetch_add(count,
+                                             std::memory_order_release);
+                isDone = true;
+            }
+        }
+    }
+}
+
+/*--------------------*/
+
+Boolean SoXWorkerPool::_hasPendingTask () const
+{
+    const std::uint64_t generation =
+        _generation.load(std::memory_order_acquire);
+    const size_t rangeCount =
+        _activeRangeCount.load(std::memory_order_relaxed);
+    Boolean result = false;
+
+    for (size_t slotIndex = 0;  !result && slotIndex < rangeCount;
+         slotIndex++) {
+        const std::uint64_t range =
+            _slotList[slotIndex].taskRange.load(std::memory_order_acquire);
+        const std::uint64_t firstIndex =
+            (range >> _firstIndexShift) & _taskIndexMask;
+        const std::uint64_t lastIndex = range & _taskIndexMask;
+        result = ((range >> _generationShift) == generation
+                  && firstIndex < lastIndex);
+    }
+
+    return result;
+}
+
+/*--------------------*/
+
+Boolean SoXWorkerPool::_processDetachedTask ()
+{
+    Boolean isProcessed = false;
+
+    for (_DetachedTaskSlot& taskSlot : _detachedTaskList) {
+        _DetachedTaskState state = _DetachedTaskState::submitted;
+
+        if (taskSlot.state
+                .compare_exchange_strong(state,
+                                         _DetachedTaskState::running,
+                                         std::memory_order_acquire)) {
+            Logging_beginSpan("SoXWorkerPool.detachedTask",
+                              taskSlot.context);
+            taskSlot.taskFunction(taskSlot.context, 0);
+            Logging_endSpan("SoXWorkerPool.detachedTask",
+                            taskSlot.context);
+            taskSlot.state.store(_DetachedTaskState::done,
+                                 std::memory_order_release);
+            _detachedTaskCount.fetch_add(1, std::memory_order_relaxed);
+            isProcessed = true;
+        }
+    }
+
+    return isProcessed;
+}
+
+/*--------------------*/
+
+Boolean SoXWorkerPool::_hasPendingDetachedTask () const
+{
+    Boolean result = false;
+
+    for (const _DetachedTaskSlot& taskSlot : _detachedTaskList) {
+        result = (result
+                  || (taskSlot.state.load(std::memory_order_relaxed)
+                      == _DetachedTaskState::submitted));
+    }
+
+    return result;
+}
+
+/*--------------------*/
+
+void SoXWorkerPool::_workerLoop (IN size_t slotIndex,
+                                 IN Boolean isRealtimeRequested)
+{
+    /* the tasks run effect code in the same floating point mode as
+       the audio thread */
+    const DenormalGuard denormalGuard{};
+    _ThreadSlot& slot = _slotList[slotIndex];
+    Natural idleCount = 0;
+
+    /* a real-time thread does not spin when idle: a yield only
+       gives way to threads of the same priority, hence a spinning
+       worker would starve an audio thread with normal priority on
+       the same core */
+    const Boolean isRealtime =
+        (isRealtimeRequested && OperatingSystem::raiseThreadPriority());
+    const Natural idleSpinCount = (isRealtime ? 0 : _idleSpinCount);
+
+    if (isRealtime) {
+        _realtimeThreadCount.fetch_add(1);
+    }
+
+    while (!_isStopped.load()) {
+        const _Clock::time_point startTime = _Clock::now();
+
+        /* task sets are preferred, because their caller is
+           waiting */
+        if (_processTasks(slotIndex) || _processDetachedTask()) {
+            idleCount = 0;
+        } else {
+            if (idleCount < idleSpinCount) {
+                idleCount++;
+                std::this_thread::yield();
+            } else {
+                const auto isWakeupNeeded = [this] {
+                    return (_isStopped.load() || _hasPendingTask()
+                            || _hasPendingDetachedTask());
+                };
+                std::unique_lock<std::mutex> lock{_wakeupMutex};
+                _wakeupCondition.wait_for(lock,
+                                          std::chrono::microseconds{
+                                              (int) _maximumSleepTime},
+                                          isWakeupNeeded);
+            }
+
+            slot.idleTime.fetch_add(_elapsedNanoseconds(startTime),
+                                    std::memory_order_relaxed);
+        }
+    }
+}
+
+/*--------------------*/
+/* measurement        */
+/*--------------------*/
+
+SoXWorkerPoolStatistics SoXWorkerPool::statistics () const
+{
+    Logging_trace(">>");
+
+    SoXWorkerPoolStatistics result{};
+    std::uint64_t taskCount = 0;
+    std::uint64_t stealCount = 0;
+    std::uint64_t idleTime = 0;
+
+    for (const _ThreadSlot& slot : _slotList) {
+        taskCount  += slot.taskCount.load(std::memory_order_relaxed);
+        stealCount += slot.stealCount.load(std::memory_order_relaxed);
+        idleTime   += slot.idleTime.load(std::memory_order_relaxed);
+    }
+
+    result.parallelTaskSetCount =
+        Natural{(size_t) _parallelTaskSetCount.load()};
+    result.taskCount         = Natural{(size_t) taskCount};
+    result.stealCount        = Natural{(size_t) stealCount};
+    result.deadlineMissCount = Natural{(size_t) _deadlineMissCount.load()};
+    result.idleTime          = Real{(double) idleTime * 1.0E-9};
+    result.realtimeThreadCount =
+        Natural{_realtimeThreadCount.load()};
+    result.detachedTaskCount =
+        Natural{(size_t) _detachedTaskCount.load()};
+
+    Logging_trace1("<<: %1", result.toString());
+    return result;
+}
+
+/*--------------------*/
+
+void SoXWorkerPool::resetStatistics ()
+{
+    Logging_trace(">>");
+
+    for (_ThreadSlot& slot : _slotList) {
+        slot.taskCount.store(0, std::memory_order_relaxed);
+        slot.stealCount.store(0, std::memory_order_relaxed);
+        slot.idleTime.store(0, std::memory_order_relaxed);
+    }
+
+    _parallelTaskSetCount.store(0, std::memory_order_relaxed);
+    _deadlineMissCount.store(0, std::memory_order_relaxed);
+    _detachedTaskCount.store(0, std::memory_order_relaxed);
+
+    Logging_trace("<<");
+}
@@ -0,0 +1,653 @@
+/**
+ * @file
+ * The <C>SoXWorkerPool</C> specification defines a process-wide
+ * pool of pre-spawned worker threads for spreading independent
+ * tasks of an audio block (like the bands of a multiband effect)
+ * across several cores.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-02
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include "GenericList.h"
+#include "MyString.h"
+#include "Natural.h"
+#include "Real.h"
+
+/*--------------------*/
+
+using BaseTypes::GenericTypes::GenericList;
+using BaseTypes::Primitives::Boolean;
+using BaseTypes::Primitives::Natural;
+using BaseTypes::Primitives::Real;
+using BaseTypes::Primitives::String;
+
+/*====================*/
+
+namespace SoXPlugins::Helpers {
+
+    /**
+     * A <C>SoXWorkerPoolStatistics</C> object holds the counters of
+     * the worker pool since the last reset.
+     */
+    struct SoXWorkerPoolStatistics {
+
+        /** the number of task sets spread across the worker
+         * threads */
+        Natural parallelTaskSetCount;
+
+        /** the number of tasks processed in parallel task sets */
+        Natural taskCount;
+
+        /** the number of tasks taken from the range of another
+         * thread */
+        Natural stealCount;
+
+        /** the number of task sets with tasks dropped at their
+         * deadline */
+        Natural deadlineMissCount;
+
+        /** the accumulated time of all worker threads without a
+         * task (in seconds) */
+        Real idleTime;
+
+        /** the number of worker threads running with real-time
+         * priority */
+        Natural realtimeThreadCount;
+
+        /** the number of detached tasks processed by worker
+         * threads */
+        Natural detachedTaskCount;
+
+        /*--------------------*/
+        /*--------------------*/
+
+        /**
+         * Makes statistics with all counters zero.
+         */
+        SoXWorkerPoolStatistics ();
+
+        /*--------------------*/
+
+        /**
+         * Returns string representation of statistics
+         *
+         * @return string representation
+         */
+        String toString () const;
+
+    };
+
+    /*--------------------*/
+
+    /**
+     * A <C>SoXWorkerPool</C> object is a set of pre-spawned worker
+     * threads shared by all plugin instances in a process; the
+     * workers get real-time priority where the operating system
+     * permits it and each worker has a core of its own.
+     *
+     * A task set is split into contiguous task ranges, one for the
+     * calling thread and one per worker.  Each thread takes tasks
+     * from the front of its own range and, when that is empty,
+     * steals single tasks from the back of the other ranges; a
+     * range is a single atomic word (holding a generation and the
+     * bounds) changed by compare-and-swap, so the handoff is
+     * lock-free and nothing is allocated on submission.  The caller
+     * works on the tasks itself and afterwards only waits for the
+     * tasks already taken by workers.  A task set may have a
+     * deadline: tasks not yet started when it has passed are
+     * dropped, hence it is only meant for work that may be
+     * redone later.
+     *
+     * The pool is opt-in: it has no threads unless it is configured
+     * otherwise, and task sets for short blocks, with a single task
+     * or while the pool is used by another instance are processed
+     * on the calling thread.
+     *
+     * Besides task sets the pool takes detached tasks: the caller
+     * does not wait for such a task when starting it, but only when
+     * completing it later (typically in the next audio block), so
+     * its work is completely removed from the calling thread when a
+     * worker is idle in between.  A detached task not yet taken by
+     * a worker on completion is processed by the completing thread.
+     */
+    struct SoXWorkerPool {
+
+        /**
+         * A task function processes task <C>taskIndex</C> of a task
+         * set on <C>context</C>.
+         */
+        using TaskFunction = void (*) (INOUT void* context,
+                                       IN Natural taskIndex);
+
+        /*--------------------*/
+
+        /**
+         * A point in time where a task set must be completed.
+         */
+        using Deadline = std::chrono::steady_clock::time_point;
+
+        /*--------------------*/
+
+        /** the maximum number of worker threads in the pool */
+        static const Natural maximumThreadCount;
+
+        /** the maximum number of detached tasks started and not
+         * yet completed at the same time */
+        static const Natural maximumDetachedTaskCount;
+
+        /** the handle of a detached task that has already been
+         * processed when starting it */
+        static const Natural completedTaskHandle;
+
+        /*--------------------*/
+        /* con-/destruction   */
+        /*--------------------*/
+
+        /**
+         * Returns the pool shared by all plugin instances in the
+         * process.
+         *
+         * @return  process-wide worker pool
+         */
+        static SoXWorkerPool& instance ();
+
+        /*--------------------*/
+
+        /**
+         * Stops and joins all worker threads.
+         */
+        ~SoXWorkerPool ();
+
+        /*--------------------*/
+
+        SoXWorkerPool (IN SoXWorkerPool&) = delete;
+
+        /*-----------------------*/
+        /* string representation */
+        /*-----------------------*/
+
+        /**
+         * Returns string representation of pool
+         *
+         * @return string representation
+         */
+        String toString () const;
+
+        /*--------------------*/
+        /* configuration      */
+        /*--------------------*/
+
+        /**
+         * Sets the pool to <C>threadCount</C> worker threads (at
+         * most <C>maximumThreadCount</C>, zero disables parallel
+         * processing) and the block length below which task sets
+         * are processed on the calling thread to
+         * <C>minimumBlockLength</C>; spawns or joins threads, hence
+         * must not be called on the audio thread.
+         *
+         * @param[in] threadCount         the new number of worker
+         *                                threads
+         * @param[in] minimumBlockLength  the minimum number of
+         *                                samples in a block for
+         *                                parallel processing
+         */
+        void configure (IN Natural threadCount,
+                        IN Natural minimumBlockLength);
+
+        /*--------------------*/
+
+        /**
+         * Sets the block length below which task sets are processed
+         * on the calling thread to <C>minimumBlockLength</C> and
+         * keeps the worker threads; may be called at any time.
+         *
+         * @param[in] minimumBlockLength  the minimum number of
+         *                                samples in a block for
+         *                                parallel processing
+         */
+        void setMinimumBlockLength (IN Natural minimumBlockLength);
+
+        /*--------------------*/
+
+        /**
+         * Returns the block length below which task sets are
+         * processed on the calling thread.
+         *
+         * @return  minimum number of samples for parallel processing
+         */
+        Natural minimumBlockLength () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of worker threads in the pool.
+         *
+         * @return  number of worker threads
+         */
+        Natural threadCount () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the suggested number of worker threads for task
+         * sets with <C>taskCount</C> tasks: the calling thread
+         * processes one task itself and one hardware thread is left
+         * to the host, at most <C>maximumThreadCount</C> are used.
+         *
+         * @param[in] taskCount  the number of tasks in a task set
+         * @return  suggested number of worker threads
+         */
+        static Natural suggestedThreadCount (IN Natural taskCount);
+
+        /*--------------------*/
+
+        /**
+         * Makes sure that the pool has at least <C>threadCount</C>
+         * worker threads (at most <C>maximumThreadCount</C>) and
+         * keeps the minimum block length; spawns threads, hence must
+         * not be called on the audio thread.
+         *
+         * @param[in] threadCount  the minimum number of worker threads
+         */
+        void reserveThreads (IN Natural threadCount);
+
+        /*--------------------*/
+        /* processing         */
+        /*--------------------*/
+
+        /**
+         * Processes <C>taskCount</C> independent tasks of a block
+         * with <C>blockLength</C> samples by calling
+         * <C>taskFunction</C> on <C>context</C> for each task index
+         * and returns when all tasks are done; the tasks are spread
+         * across the worker threads and the calling thread when the
+         * pool has threads, is not busy and the block is long
+         * enough, otherwise they are processed in order on the
+         * calling thread.
+         *
+         * @param[in]    taskFunction  function processing a single
+         *                             task
+         * @param[inout] context       data of the task set
+         * @param[in]    taskCount     number of tasks
+         * @param[in]    blockLength   number of samples in block
+         */
+        void run (IN TaskFunction taskFunction,
+                  INOUT void* context,
+                  IN Natural taskCount,
+                  IN Natural blockLength);
+
+        /*--------------------*/
+
+        /**
+         * Processes <C>taskCount</C> independent tasks of a block
+         * with <C>blockLength</C> samples like <C>run</C>, but drops
+         * all tasks not started before <C>deadline</C>; tells
+         * whether all tasks have been processed.  Tasks already
+         * started are always completed before returning.
+         *
+         * @param[in]    taskFunction  function processing a single
+         *                             task
+         * @param[inout] context       data of the task set
+         * @param[in]    taskCount     number of tasks
+         * @param[in]    blockLength   number of samples in block
+         * @param[in]    deadline      latest time for starting a
+         *                             task
+         * @return  information whether no task has been dropped
+         */
+        Boolean runUntil (IN TaskFunction taskFunction,
+                          INOUT void* context,
+                          IN Natural taskCount,
+                          IN Natural blockLength,
+                          IN Deadline deadline);
+
+        /*--------------------*/
+
+        /**
+         * Starts a detached task calling <C>taskFunction</C> on
+         * <C>context</C> with task index zero on some worker thread
+         * and returns its handle for <C>completeDetachedTask</C>
+         * without waiting for it.  When the pool has no threads or
+         * already <C>maximumDetachedTaskCount</C> detached tasks,
+         * the task is processed on the calling thread and
+         * <C>completedTaskHandle</C> is returned.  Does not lock or
+         * allocate, hence may be called on the audio thread.
+         *
+         * @param[in]    taskFunction  function processing the task
+         * @param[inout] context       data of the task
+         * @return  handle of detached task
+         */
+        Natural startDetachedTask (IN TaskFunction taskFunction,
+                                   INOUT void* context);
+
+        /*--------------------*/
+
+        /**
+         * Returns when the detached task with <C>taskHandle</C> is
+         * done and releases its handle: a task not yet taken by a
+         * worker is processed on the calling thread, otherwise the
+         * calling thread waits for the worker; nothing is done for
+         * <C>completedTaskHandle</C>.
+         *
+         * @param[in] taskHandle  handle of detached task
+         */
+        void completeDetachedTask (IN Natural taskHandle);
+
+        /*--------------------*/
+        /* measurement        */
+        /*--------------------*/
+
+        /**
+         * Returns the counters of the pool since the last reset.
+         *
+         * @return  pool statistics
+         */
+        SoXWorkerPoolStatistics statistics () const;
+
+        /*--------------------*/
+
+        /**
+         * Sets all counters of the pool to zero.
+         */
+        void resetStatistics ();
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the number of task ranges: one per worker and one for
+             * the calling thread */
+            static constexpr size_t _rangeCount = 17;
+
+            /** the number of slots for detached tasks */
+            static constexpr size_t _detachedTaskSlotCount = 16;
+
+            /*--------------------*/
+
+            /**
+             * The task range and the counters of a thread on a
+             * separate cache line
+             */
+            struct alignas(64) _ThreadSlot {
+
+                /** the task range combining generation (upper 32
+                 * bits), index of first (middle 16 bits) and index
+                 * after last unprocessed task (lower 16 bits) */
+                std::atomic<std::uint64_t> taskRange;
+
+                /** the number of tasks processed */
+                std::atomic<std::uint64_t> taskCount;
+
+                /** the number of tasks stolen from other ranges */
+                std::atomic<std::uint64_t> stealCount;
+
+                /** the time without a task in nanoseconds */
+                std::atomic<std::uint64_t> idleTime;
+
+            };
+
+            /*--------------------*/
+
+            /**
+             * The states of a slot for a detached task: it is
+             * reserved by the starting thread, then submitted and
+             * finally run by a worker or the completing thread
+             */
+            enum class _DetachedTaskState {
+                free, reserved, submitted, running, done
+            };
+
+            /*--------------------*/
+
+            /**
+             * A slot for a detached task on a separate cache line
+             */
+            struct alignas(64) _DetachedTaskSlot {
+
+                /** the state of the slot */
+                std::atomic<_DetachedTaskState> state;
+
+                /** the function of the task (only read after
+                 * taking the task) */
+                TaskFunction taskFunction;
+
+                /** the context of the task (only read after
+                 * taking the task) */
+                void* context;
+
+            };
+
+            /*--------------------*/
+
+            /**
+             * Makes pool without worker threads.
+             */
+            SoXWorkerPool ();
+
+            /*--------------------*/
+
+            /**
+             * Spawns <C>threadCount</C> worker threads.
+             *
+             * @param[in] threadCount  number of threads to be spawned
+             */
+            void _startThreads (IN Natural threadCount);
+
+            /*--------------------*/
+
+            /**
+             * Stops and joins all worker threads.
+             */
+            void _stopThreads ();
+
+            /*--------------------*/
+
+            /**
+             * Processes the task set in parallel with an optional
+             * <C>deadline</C> and tells whether no task has been
+             * dropped; expects the pool to be reserved for the
+             * caller.
+             *
+             * @param[in]    taskFunction  function processing a
+             *                             single task
+             * @param[inout] context       data of the task set
+             * @param[in]    taskCount     number of tasks
+             * @param[in]    hasDeadline   information whether
+             *                             <C>deadline</C> applies
+             * @param[in]    deadline      latest time for starting a
+             *                             task
+             * @return  information whether no task has been dropped
+             */
+            Boolean _runParallel (IN TaskFunction taskFunction,
+                                  INOUT void* context,
+                                  IN Natural taskCount,
+                                  IN Boolean hasDeadline,
+                                  IN Deadline deadline);
+
+            /*--------------------*/
+
+            /**
+             * Takes a task with generation <C>generation</C> from the
+             * range of slot <C>slotIndex</C> into
+             * <C>taskIndex</C> (from the front when
+             * <C>isOwner</C> is set, otherwise from the back) and
+             * tells whether there was one.
+             *
+             * @param[in]  slotIndex   index of thread slot
+             * @param[in]  generation  generation of current task set
+             * @param[in]  isOwner     information whether the calling
+             *                         thread owns the range
+             * @param[out] taskIndex   index of task taken
+             * @return  information whether a task has been taken
+             */
+            Boolean _takeTask (IN size_t slotIndex,
+                               IN std::uint64_t generation,
+                               IN Boolean isOwner,
+                               OUT size_t& taskIndex);
+
+            /*--------------------*/
+
+            /**
+             * Processes tasks of the current task set for the thread
+             * with slot <C>slotIndex</C> (first from its own range,
+             * then stolen from the others) until none is left or the
+             * deadline has passed and tells whether some task has
+             * been processed.
+             *
+             * @param[in] slotIndex  index of slot of calling thread
+             * @return  information whether a task has been processed
+             */
+            Boolean _processTasks (IN size_t slotIndex);
+
+            /*--------------------*/
+
+            /**
+             * Drops all tasks of the current task set not yet taken
+             * by some thread.
+             */
+            void _dropPendingTasks ();
+
+            /*--------------------*/
+
+            /**
+             * Tells whether the current task set has tasks not yet
+             * taken by some thread.
+             *
+             * @return  information whether a task is pending
+             */
+            Boolean _hasPendingTask () const;
+
+            /*--------------------*/
+
+            /**
+             * Takes a submitted detached task and processes it on
+             * the calling worker thread and tells whether there has
+             * been one.
+             *
+             * @return  information whether a detached task has been
+             *          processed
+             */
+            Boolean _processDetachedTask ();
+
+            /*--------------------*/
+
+            /**
+             * Tells whether some detached task has been submitted
+             * and not yet taken.
+             *
+             * @return  information whether a detached task is
+             *          pending
+             */
+            Boolean _hasPendingDetachedTask () const;
+
+            /*--------------------*/
+
+            /**
+             * Runs the loop of the worker thread with slot
+             * <C>slotIndex</C>: processes pending tasks, spins for a
+             * while when idle and finally sleeps until woken up or
+             * stopped; the thread gets real-time priority when
+             * <C>isRealtimeRequested</C> is set and the operating
+             * system permits it.
+             *
+             * @param[in] slotIndex            index of slot of worker
+             * @param[in] isRealtimeRequested  information whether
+             *                                 real-time priority is
+             *                                 requested
+             */
+            void _workerLoop (IN size_t slotIndex,
+                              IN Boolean isRealtimeRequested);
+
+            /*--------------------*/
+
+            /** the worker threads */
+            GenericList<std::thread> _threadList;
+
+            /** the slots of the calling thread (index 0) and the
+             * workers */
+            _ThreadSlot _slotList[_rangeCount];
+
+            /** the minimum number of samples in a block for parallel
+             * processing */
+            std::atomic<size_t> _minimumBlockLength;
+
+            /** tells whether the pool is used by some caller (or is
+             * being configured) */
+            std::atomic_flag _isBusy;
+
+            /** tells whether the worker threads shall terminate */
+            std::atomic<bool> _isStopped;
+
+            /** the generation of the current task set */
+            std::atomic<std::uint64_t> _generation;
+
+            /** the number of ranges in the current task set */
+            std::atomic<size_t> _activeRangeCount;
+
+            /** the number of completed or dropped tasks in the
+             * current task set */
+            std::atomic<size_t> _finishedTaskCount;
+
+            /** the number of dropped tasks in the current task
+             * set */
+            std::atomic<size_t> _droppedTaskCount;
+
+            /** the function of the current task set (only read after
+             * taking a task) */
+            TaskFunction _taskFunction;
+
+            /** the context of the current task set (only read after
+             * taking a task) */
+            void* _taskContext;
+
+            /** tells whether the current task set has a deadline
+             * (only read after taking a task) */
+            bool _hasDeadline;
+
+            /** the deadline of the current task set (only read
+             * after taking a task) */
+            Deadline _deadline;
+
+            /** the number of parallel task sets since the last
+             * reset */
+            std::atomic<std::uint64_t> _parallelTaskSetCount;
+
+            /** the number of task sets with dropped tasks since the
+             * last reset */
+            std::atomic<std::uint64_t> _deadlineMissCount;
+
+            /** the number of workers with real-time priority */
+            std::atomic<size_t> _realtimeThreadCount;
+
+            /** the slots for detached tasks */
+            _DetachedTaskSlot _detachedTaskList[_detachedTaskSlotCount];
+
+            /** the number of detached tasks processed by workers
+             * since the last reset */
+            std::atomic<std::uint64_t> _detachedTaskCount;
+
+            /** the mutex used by idle workers for sleeping (never
+             * locked by an audio thread) */
+            std::mutex _wakeupMutex;
+
+            /** the condition for waking up sleeping workers */
+            std::condition_variable _wakeupCondition;
+
+    };
+
+}
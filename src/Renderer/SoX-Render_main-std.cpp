@@ -0,0 +1,518 @@
+/**
+ * @file
+ * The <C>SoX-Render</C> module implements a command-line program
+ * rendering an uncompressed WAV or AIFF file through a single SoX
+ * effect or a chain of SoX effects without a DAW; the effect and its
+ * parameters are given by a parameter file in the key-value form of
+ * the plugin state.
+ *
+ * Usage: <TT>SoX-Render [--buffered] [--segments segmentCount]
+ * [--checkpoint checkpointFile [--interval seconds]] parameterFile
+ * inputFile outputFile [blockSize]</TT> for a single file
+ * (optionally split into segments rendered concurrently or resumed
+ * at the last checkpoint after an interruption or split into
+ * segments rendered by render nodes via <TT>--nodes
+ * host:port,...</TT>), <TT>SoX-Render --node port</TT> for a
+ * render node serving segments over TCP,
+ * <TT>SoX-Render [--buffered] --normalize level inputFile
+ * outputFile [blockSize]</TT> for a peak normalization of a single
+ * file in two passes or <TT>SoX-Render [--buffered] [--normalize
+ * level] [--cache directory [--cachesize megabytes] [--cacheage
+ * days]] --batch manifestFile [threadCount [blockSize]]</TT> for a
+ * batch of files rendered concurrently (skipping files found in a
+ * render cache), <TT>SoX-Render [--buffered]
+ * [--normalize level] --daemon directory [threadCount
+ * [blockSize]]</TT> for a daemon processing request files in a
+ * watched directory with warm effect instances or <TT>SoX-Render
+ * --raw type:channels:rate parameterFile [blockSize]</TT> for raw
+ * samples streamed from standard input to standard output.  In the
+ * single file and the raw mode the option <TT>--sox
+ * effectCommand</TT> replaces the parameter file by an effect chain
+ * in SoX command-line syntax (like <TT>"gain -3 highpass 80 reverb
+ * 50"</TT>) and the option <TT>--precision profile</TT> selects the
+ * precision profile of the effects ("soxExact", "highQuality" or
+ * "fast").
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include <iostream>
+
+#include "Logging.h"
+#include "OperatingSystem.h"
+#include "SoXBatchRenderer.h"
+#include "SoXCommandParser.h"
+#include "SoXKernelTuning.h"
+#include "SoXOfflineRenderer.h"
+#include "SoXRenderCluster.h"
+#include "SoXRenderDaemon.h"
+
+/*--------------------*/
+
+using std::cerr;
+
+using BaseModules::OperatingSystem;
+using SoXPlugins::Helpers::SoXKernelTuning;
+using SoXPlugins::Helpers::SoXPrecisionProfile;
+using SoXPlugins::Helpers::precisionProfileFromString;
+using SoXPlugins::Renderer::SoXAudioFileFormat;
+using SoXPlugins::Renderer::SoXBatchRenderer;
+using SoXPlugins::Renderer::SoXCommandParser;
+using SoXPlugins::Renderer::SoXOfflineRenderer;
+using SoXPlugins::Renderer::SoXRenderCacheEvictionPolicy;
+using SoXPlugins::Renderer::SoXRenderCoordinator;
+using SoXPlugins::Renderer::SoXRenderDaemon;
+using SoXPlugins::Renderer::SoXRenderNode;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
+
+/*====================*/
+
+/**
+ * Writes the usage of the program to standard error.
+ */
+static void _writeUsage ()
+{
+    cerr << ("usage: SoX-Render [--buffered] [--segments segmentCount]"
+             " [--encoders encoderCount]\n"
+             "                  [--checkpoint checkpointFile"
+             " [--interval seconds]]\n"
+             "                  [--nodes host:port,...]"
+             " parameterFile inputFile outputFile\n"
+             "                  [blockSize]\n"
+             "       SoX-Render [--buffered] --normalize level"
+             " inputFile outputFile [blockSize]\n"
+             "       SoX-Render [--buffered] [--normalize level]"
+             " [--unpinned] [--unbatched]\n"
+             "                  [--cache directory [--cachesize"
+             " megabytes]\n"
+             "                  [--cacheage days]]"
+             " --batch manifestFile"
+             " [threadCount [blockSize]]\n"
+             "       SoX-Render [--buffered] [--normalize level]\n"
+             "                  --daemon directory"
+             " [threadCount [blockSize]]\n"
+             "       SoX-Render --node port\n"
+             "       SoX-Render --raw type:channels:rate parameterFile"
+             " [blockSize]\n"
+             "       SoX-Render [--buffered] --sox effectCommand"
+             " inputFile outputFile\n"
+             "                  [blockSize]\n"
+             "       SoX-Render --raw type:channels:rate --sox"
+             " effectCommand [blockSize]\n"
+             "       (single file and raw modes also take"
+             " [--precision profile])\n"
+             "  --buffered:    read input by buffered I/O instead of a"
+             " memory mapping\n"
+             "  --cache:       take batch outputs from a render cache"
+             " in directory and\n"
+             "                 store new outputs there\n"
+             "  --cacheage:    evict cache entries unused for more"
+             " than days\n"
+             "  --cachesize:   evict least recently used cache entries"
+             " beyond megabytes\n"
+             "  --checkpoint:  save progress to checkpointFile and"
+             " resume from there\n"
+             "                 after an interruption (not with"
+             " segments)\n"
+             "  --daemon:      render the '.job' manifests appearing in"
+             " directory until\n"
+             "                 a file 'stop' appears there\n"
+             "  --encoders:    number of threads encoding the output"
+             " (default 1),\n"
+             "                 reports the throughput per stage\n"
+             "  --interval:    audio seconds between checkpoints"
+             " (default 60)\n"
+             "  --node:        serve segments for coordinators on TCP"
+             " port\n"
+             "  --nodes:       render segments on the render nodes at"
+             " host[:port]\n"
+             "                 (default port ")
+         << TOSTRING(SoXRenderNode::defaultPort)
+         << ("; with --segments: number of segments)\n"
+             "  --normalize:   scale to a peak of level dB (for batch"
+             " lines without\n"
+             "                 parameter file)\n"
+             "  --precision:   precision profile of the effects: soxExact"
+             " (default),\n"
+             "                 highQuality or fast\n"
+             "  --raw:         filter interleaved little-endian samples"
+             " from stdin to\n"
+             "                 stdout (type one of f32, f64, s16, s24,"
+             " s32)\n"
+             "  --sox:         effect chain in SoX syntax instead of a"
+             " parameter file\n"
+             "                 (one argument, effects: ")
+         << SoXCommandParser::effectNameList().join(" ")
+         << (")\n"
+             "  --segments:    render a single file in segments on"
+             " several cores\n"
+             "                 (segmentCount 0: one per core)\n"
+             "  --unbatched:   render each batch file by an effect of"
+             " its own\n"
+             "  --unpinned:    do not pin batch workers to processors\n"
+             "  manifestFile:  lines with (optional) parameter file,"
+             " input and output\n"
+             "                 separated by tabs\n"
+             "  threadCount:   number of worker threads (default: all"
+             " cores)\n"
+             "  parameterFile: first line is the effect (one of ")
+         << SoXOfflineRenderer::effectNameList().join(", ")
+         << "),\n"
+         << "                 or a chain of effects separated by '>',\n"
+         << "                 further lines are 'name = \"value\"'\n"
+         << "  blockSize:     frames per block (default "
+         << TOSTRING(SoXOfflineRenderer::defaultBlockSize) << ")\n";
+}
+
+/*--------------------*/
+
+/**
+ * Sets up the effect of <C>renderer</C> from the SoX effect command
+ * <C>soxCommand</C> when <C>hasSoXCommand</C> is set and otherwise
+ * from the parameter file named <C>parameterFileName</C>; tells
+ * whether this has been successful.
+ *
+ * @param[inout] renderer           offline renderer to be set up
+ * @param[in]    hasSoXCommand      information whether a SoX command
+ *                                  is given
+ * @param[in]    soxCommand         SoX effect command
+ * @param[in]    parameterFileName  name of parameter file
+ * @return  information whether effect has been set up
+ */
+static Boolean _setUpEffect (INOUT SoXOfflineRenderer& renderer,
+                             IN Boolean hasSoXCommand,
+                             IN String& soxCommand,
+                             IN String& parameterFileName)
+{
+    return (hasSoXCommand
+            ? renderer.setEffectCommand(soxCommand)
+            : renderer.readParameterFile(parameterFileName));
+}
+
+/*--------------------*/
+/*--------------------*/
+
+int main (int argc, char* argv[]) {
+    Logging_initialize();
+    const String temporaryDirectoryPath =
+        OperatingSystem::temporaryDirectoryPath();
+    Logging_setFileName(temporaryDirectoryPath + "/SoXRender.log", false);
+    Logging_setIgnoredFunctionNamePrefix("SoXPlugins.");
+    Logging_trace(">>");
+
+    int exitCode = 0;
+    Boolean isBuffered = false;
+    Boolean isBatch = false;
+    Boolean isDaemon = false;
+    Boolean isNode = false;
+    Boolean isSegmented = false;
+    Boolean isNormalizing = false;
+    Boolean isRaw = false;
+    Boolean workersArePinned = true;
+    Boolean jobsAreBatched = true;
+    Boolean hasSoXCommand = false;
+    Boolean isPrecisionProfileValid = true;
+    SoXPrecisionProfile precisionProfile = SoXPrecisionProfile::soxExact;
+    Natural segmentCount = 0;
+    Natural nodePort = 0;
+    Natural encoderCount = 0;
+    Real normalizationLevel = 0.0;
+    Real checkpointInterval = 60.0;
+    String checkpointFileName;
+    String cacheDirectoryName;
+    SoXRenderCacheEvictionPolicy cacheEvictionPolicy{};
+    String nodeListText;
+    String rawDescription;
+    String soxCommand;
+    int argumentCount = argc;
+    char** argumentList = argv;
+
+    /* leading options are removed from the argument list */
+    while (argumentCount > 1) {
+        const String option = argumentList[1];
+
+        if (option == "--buffered") {
+            isBuffered = true;
+        } else if (option == "--batch") {
+            isBatch = true;
+        } else if (option == "--daemon") {
+            isDaemon = true;
+        } else if (option == "--unpinned") {
+            workersArePinned = false;
+        } else if (option == "--unbatched") {
+            jobsAreBatched = false;
+        } else if (option == "--segments" && argumentCount > 2) {
+            isSegmented = true;
+            segmentCount = STR::toNatural(argumentList[2], 0);
+            argumentCount--;
+            argumentList++;
+        } else if (option == "--node" && argumentCount > 2) {
+            isNode = true;
+            nodePort = STR::toNatural(argumentList[2], 0);
+            argumentCount--;
+            argumentList++;
+        } else if (option == "--nodes" && argumentCount > 2) {
+            nodeListText = argumentList[2];
+            argumentCount--;
+            argumentList++;
+        } else if (option == "--encoders" && argumentCount > 2) {
+            encoderCount = STR::toNatural(argumentList[2], 0);
+            argumentCount--;
+            argumentList++;
+        } else if (option == "--checkpoint" && argumentCount > 2) {
+            checkpointFileName = argumentList[2];
+            argumentCount--;
+            argumentList++;
+        } else if (option == "--interval" && argumentCount > 2) {
+            checkpointInterval = STR::toReal(argumentList[2], 60.0);
+            argumentCount--;
+            argumentList++;
+        } else if (option == "--cache" && argumentCount > 2) {
+            cacheDirectoryName = argumentList[2];
+            argumentCount--;
+            argumentList++;
+        } else if (option == "--cachesize" && argumentCount > 2) {
+            cacheEvictionPolicy.maximumByteCount =
+                STR::toNatural(argumentList[2], 0) * 1024 * 1024;
+            argumentCount--;
+            argumentList++;
+        } else if (option == "--cacheage" && argumentCount > 2) {
+            cacheEvictionPolicy.maximumAge =
+                STR::toReal(argumentList[2], 0.0) * 86400.0;
+            argumentCount--;
+            argumentList++;
+        } else if (option == "--raw" && argumentCount > 2) {
+            isRaw = true;
+            rawDescription = argumentList[2];
+            argumentCount--;
+            argumentList++;
+        } else if (option == "--sox" && argumentCount > 2) {
+            hasSoXCommand = true;
+            soxCommand = argumentList[2];
+            argumentCount--;
+            argumentList++;
+        } else if (option == "--precision" && argumentCount > 2) {
+            isPrecisionProfileValid =
+                precisionProfileFromString(argumentList[2],
+                                           precisionProfile);
+            argumentCount--;
+            argumentList++;
+        } else if (option == "--normalize" && argumentCount > 2) {
+            isNormalizing = true;
+            normalizationLevel = STR::toReal(argumentList[2], 0.0);
+            argumentCount--;
+            argumentList++;
+        } else {
+            break;
+        }
+
+        argumentCount--;
+        argumentList++;
+        argumentList[0] = argv[0];
+    }
+
+    /* use the processing settings measured for this machine (on
+       the first run they are measured now) */
+    SoXKernelTuning::initialize();
+
+    if (!isPrecisionProfileValid) {
+        _writeUsage();
+        exitCode = 2;
+    } else if (isNode) {
+        if (argumentCount != 1) {
+            _writeUsage();
+            exitCode = 2;
+        } else {
+            SoXRenderNode node{};
+            node.setProgressIsReported(true);
+
+            if (!node.run(nodePort)) {
+                cerr << "SoX-Render: " << node.errorMessage() << "\n";
+                exitCode = 1;
+            }
+        }
+    } else if (isDaemon) {
+        if (argumentCount < 2 || argumentCount > 4) {
+            _writeUsage();
+            exitCode = 2;
+        } else {
+            const String directoryName = argumentList[1];
+            const Natural threadCount =
+                (argumentCount < 3 ? Natural{0}
+                 : STR::toNatural(argumentList[2], 0));
+            const Natural blockSize =
+                (argumentCount < 4 ? SoXOfflineRenderer::defaultBlockSize
+                 : STR::toNatural(argumentList[3], 0));
+            SoXRenderDaemon daemon{};
+            daemon.setInputIsMapped(!isBuffered);
+            daemon.setThreadCount(threadCount);
+            daemon.setBlockSize(blockSize);
+            daemon.setProgressIsReported(true);
+            daemon.setNormalizationLevel(normalizationLevel);
+
+            if (!daemon.run(directoryName)) {
+                cerr << "SoX-Render: " << daemon.errorMessage() << "\n";
+                exitCode = 1;
+            } else {
+                cerr << "SoX-Render: "
+                     << daemon.statistics().toString() << "\n";
+            }
+        }
+    } else if (isBatch) {
+        if (argumentCount < 2 || argumentCount > 4) {
+            _writeUsage();
+            exitCode = 2;
+        } else {
+            const String manifestFileName = argumentList[1];
+            const Natural threadCount =
+                (argumentCount < 3 ? Natural{0}
+                 : STR::toNatural(argumentList[2], 0));
+            const Natural blockSize =
+                (argumentCount < 4 ? SoXOfflineRenderer::defaultBlockSize
+                 : STR::toNatural(argumentList[3], 0));
+            SoXBatchRenderer renderer{};
+            renderer.setInputIsMapped(!isBuffered);
+            renderer.setThreadCount(threadCount);
+            renderer.setWorkersArePinned(workersArePinned);
+            renderer.setJobsAreBatched(jobsAreBatched);
+            renderer.setBlockSize(blockSize);
+            renderer.setProgressIsReported(true);
+            renderer.setNormalizationLevel(normalizationLevel);
+            renderer.setCacheEvictionPolicy(cacheEvictionPolicy);
+
+            if (!renderer.setCacheDirectory(cacheDirectoryName)
+                || !renderer.readManifest(manifestFileName)) {
+                cerr << "SoX-Render: " << renderer.errorMessage() << "\n";
+                exitCode = 1;
+            } else {
+                const Boolean isOkay = renderer.run();
+                cerr << "SoX-Render: "
+                     << renderer.statistics().toString() << "\n";
+
+                if (!isOkay) {
+                    cerr << renderer.errorMessage();
+                    exitCode = 1;
+                }
+            }
+        }
+    } else if (isRaw) {
+        /* standard output carries the samples, hence all messages go
+           to standard error */
+        SoXAudioFileFormat format{};
+
+        /* a SoX command replaces the parameter file argument */
+        const int firstPosition = (hasSoXCommand ? 1 : 2);
+
+        if (argumentCount < firstPosition
+            || argumentCount > firstPosition + 1) {
+            _writeUsage();
+            exitCode = 2;
+        } else if (!format.setFromRawDescription(rawDescription)) {
+            cerr << "SoX-Render: bad raw format " << rawDescription
+                 << "\n";
+            exitCode = 2;
+        } else {
+            const String parameterFileName =
+                (hasSoXCommand ? "" : argumentList[1]);
+            const Natural blockSize =
+                (argumentCount <= firstPosition
+                 ? SoXOfflineRenderer::defaultBlockSize
+                 : STR::toNatural(argumentList[firstPosition], 0));
+            SoXOfflineRenderer renderer{};
+            renderer.setPrecisionProfile(precisionProfile);
+
+            if (!_setUpEffect(renderer, hasSoXCommand, soxCommand,
+                              parameterFileName)
+                || !renderer.renderStream(format, blockSize)) {
+                cerr << "SoX-Render: " << renderer.errorMessage() << "\n";
+                exitCode = 1;
+            }
+        }
+    } else if (isNormalizing) {
+        if (argumentCount < 3 || argumentCount > 4) {
+            _writeUsage();
+            exitCode = 2;
+        } else {
+            const String inputFileName  = argumentList[1];
+            const String outputFileName = argumentList[2];
+            const Natural blockSize =
+                (argumentCount < 4 ? SoXOfflineRenderer::defaultBlockSize
+                 : STR::toNatural(argumentList[3], 0));
+            SoXOfflineRenderer renderer{};
+            renderer.setInputIsMapped(!isBuffered);
+
+            if (!renderer.renderNormalized(inputFileName, outputFileName,
+                                           normalizationLevel,
+                                           blockSize)) {
+                cerr << "SoX-Render: " << renderer.errorMessage() << "\n";
+                exitCode = 1;
+            }
+        }
+    } else if (argumentCount < (hasSoXCommand ? 3 : 4)
+               || argumentCount > (hasSoXCommand ? 4 : 5)) {
+        _writeUsage();
+        exitCode = 2;
+    } else {
+        /* a SoX command replaces the parameter file argument */
+        const int firstPosition = (hasSoXCommand ? 1 : 2);
+        const String parameterFileName =
+            (hasSoXCommand ? "" : argumentList[1]);
+        const String inputFileName  = argumentList[firstPosition];
+        const String outputFileName = argumentList[firstPosition + 1];
+        const Natural blockSize =
+            (argumentCount <= firstPosition + 2
+             ? SoXOfflineRenderer::defaultBlockSize
+             : STR::toNatural(argumentList[firstPosition + 2], 0));
+        SoXOfflineRenderer renderer{};
+        renderer.setInputIsMapped(!isBuffered);
+        renderer.setEncoderThreadCount(encoderCount);
+        renderer.setCheckpointing(checkpointFileName, checkpointInterval);
+        renderer.setPrecisionProfile(precisionProfile);
+
+        const Boolean isDistributed = (nodeListText != "");
+        SoXRenderCoordinator coordinator{};
+        coordinator.setInputIsMapped(!isBuffered);
+
+        const Boolean isOkay =
+            (_setUpEffect(renderer, hasSoXCommand, soxCommand,
+                          parameterFileName)
+             && (isDistributed
+                 ? Boolean{coordinator.setNodeList(nodeListText)
+                           && coordinator.render(renderer, inputFileName,
+                                                 outputFileName,
+                                                 segmentCount,
+                                                 blockSize)}
+                 : isSegmented
+                 ? renderer.renderInSegments(inputFileName,
+                                             outputFileName,
+                                             segmentCount, blockSize)
+                 : renderer.render(inputFileName, outputFileName,
+                                   blockSize)));
+
+        if (!isOkay) {
+            cerr << "SoX-Render: "
+                 << (isDistributed && coordinator.errorMessage() != ""
+                     ? coordinator.errorMessage()
+                     : renderer.errorMessage())
+                 << "\n";
+            exitCode = 1;
+        } else if (isDistributed) {
+            cerr << "SoX-Render: "
+                 << coordinator.statistics().toString() << "\n";
+        } else if (encoderCount > 0 && !isSegmented) {
+            cerr << "SoX-Render: "
+                 << renderer.encoderStatistics().toString() << "\n";
+        }
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(Integer{exitCode}));
+    Logging_finalize();
+    return exitCode;
+}
@@ -0,0 +1,1141 @@
+/**
+ * @file
+ * The <C>SoXAudioFile</C> body implements block-wise streaming
+ * readers and writers for uncompressed WAV and AIFF audio files and
+ * for raw PCM on the standard streams used by the offline renderer.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXAudioFile.h"
+
+#include <cmath>
+#include <cstring>
+#include "Logging.h"
+#include "StringList.h"
+
+#ifdef _WIN32
+    #include <fcntl.h>
+    #include <io.h>
+#endif
+
+/*--------------------*/
+
+using BaseTypes::Containers::StringList;
+using SoXPlugins::Renderer::SoXAudioFileFormat;
+using SoXPlugins::Renderer::SoXAudioFileKind;
+using SoXPlugins::Renderer::SoXAudioFileReader;
+using SoXPlugins::Renderer::SoXAudioFileWriter;
+using SoXPlugins::Renderer::SoXAudioStream;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
+
+/*====================*/
+
+/** the WAV format tag for integer PCM samples */
+static const std::uint64_t _wavFormatTag_pcm = 1;
+
+/** the WAV format tag for IEEE float samples */
+static const std::uint64_t _wavFormatTag_float = 3;
+
+/** the WAV format tag for an extensible format (with the real format
+ * tag in the first two bytes of the sub format GUID) */
+static const std::uint64_t _wavFormatTag_extensible = 0xFFFE;
+
+/** the version time stamp for the FVER chunk of an AIFC file */
+static const std::uint64_t _aifcVersion = 0xA2805140;
+
+/** the maximum size of a header written (in bytes) */
+static const size_t _maximumHeaderSize = 64;
+
+/*--------------------*/
+/* auxiliary routines */
+/*--------------------*/
+
+/**
+ * Returns the unsigned number in the <C>byteCount</C> bytes at
+ * <C>data</C> with the byte order given by <C>isBigEndian</C>.
+ *
+ * @param[in] data         pointer to bytes
+ * @param[in] byteCount    number of bytes (at most eight)
+ * @param[in] isBigEndian  information whether most significant byte
+ *                         comes first
+ * @return  unsigned number
+ */
+static std::uint64_t _readNumber (IN std::uint8_t* data,
+                                  IN size_t byteCount,
+                                  IN bool isBigEndian)
+{
+    std::uint64_t result = 0;
+
+    for (size_t i = 0;  i < byteCount;  i++) {
+        const size_t j = (isBigEndian ? i : byteCount - 1 - i);
+        result = (result << 8) | data[j];
+    }
+
+    return result;
+}
+
+/*--------------------*/
+
+/**
+ * Stores the lowest <C>byteCount</C> bytes of <C>value</C> at
+ * <C>data</C> with the byte order given by <C>isBigEndian</C>.
+ *
+ * @param[out] data         pointer to bytes
+ * @param[in]  value        unsigned number to be stored
+ * @param[in]  byteCount    number of bytes (at most eight)
+ * @param[in]  isBigEndian  information whether most significant
+ *                          byte comes first
+ */
+static void _writeNumber (OUT std::uint8_t* data,
+                          IN std::uint64_t value,
+                          IN size_t byteCount,
+                          IN bool isBigEndian)
+{
+    std::uint64_t remainingValue = value;
+
+    for (size_t i = 0;  i < byteCount;  i++) {
+        const size_t j = (isBigEndian ? byteCount - 1 - i : i);
+        data[j] = (std::uint8_t) (remainingValue & 0xFF);
+        remainingValue >>= 8;
+    }
+}
+
+/*--------------------*/
+
+/**
+ * Returns the value of the 80-bit IEEE extended precision number at
+ * <C>data</C> (as used for the sample rate of AIFF files).
+ *
+ * @param[in] data  pointer to ten big-endian bytes
+ * @return  value of number
+ */
+static double _readExtended (IN std::uint8_t* data)
+{
+    const std::uint64_t signAndExponent = _readNumber(data, 2, true);
+    const std::uint64_t mantissa = _readNumber(data + 2, 8, true);
+    const int exponent = (int) (signAndExponent & 0x7FFF) - 16383 - 63;
+    const double result = std::ldexp((double) mantissa, exponent);
+    return ((signAndExponent & 0x8000) != 0 ? -result : result);
+}
+
+/*--------------------*/
+
+/**
+ * Stores the nonnegative integer <C>value</C> as an 80-bit IEEE
+ * extended precision number at <C>data</C>.
+ *
+ * @param[out] data   pointer to ten bytes
+ * @param[in]  value  value to be stored
+ */
+static void _writeExtended (OUT std::uint8_t* data,
+                            IN std::uint64_t value)
+{
+    std::uint64_t mantissa = value;
+    std::uint64_t exponent = 0;
+
+    if (mantissa != 0) {
+        exponent = 16383 + 63;
+
+        while ((mantissa & 0x8000000000000000ULL) == 0) {
+            mantissa <<= 1;
+            exponent--;
+        }
+    }
+
+    _writeNumber(data, exponent, 2, true);
+    _writeNumber(data + 2, mantissa, 8, true);
+}
+
+/*--------------------*/
+
+/**
+ * Tells whether the four bytes at <C>data</C> equal the chunk
+ * identifier <C>id</C>.
+ *
+ * @param[in] data  pointer to four bytes
+ * @param[in] id    four character chunk identifier
+ * @return  information whether identifiers match
+ */
+static bool _hasId (IN std::uint8_t* data, IN char* id)
+{
+    return std::memcmp(data, id, 4) == 0;
+}
+
+/*--------------------*/
+
+/**
+ * Appends <C>byteCount</C> bytes of <C>value</C> to header array
+ * <C>data</C> at <C>position</C> and advances the position.
+ *
+ * @param[inout] data         header array
+ * @param[inout] position     current position in header
+ * @param[in]    value        unsigned number to be stored
+ * @param[in]    byteCount    number of bytes
+ * @param[in]    isBigEndian  information whether most significant
+ *                            byte comes first
+ */
+static void _appendNumber (INOUT std::uint8_t* data,
+                           INOUT size_t& position,
+                           IN std::uint64_t value,
+                           IN size_t byteCount,
+                           IN bool isBigEndian)
+{
+    _writeNumber(&data[position], value, byteCount, isBigEndian);
+    position += byteCount;
+}
+
+/*--------------------*/
+
+/**
+ * Appends four character identifier <C>id</C> to header array
+ * <C>data</C> at <C>position</C> and advances the position.
+ *
+ * @param[inout] data      header array
+ * @param[inout] position  current position in header
+ * @param[in]    id        four character chunk identifier
+ */
+static void _appendId (INOUT std::uint8_t* data,
+                       INOUT size_t& position,
+                       IN char* id)
+{
+    std::memcpy(&data[position], id, 4);
+    position += 4;
+}
+
+/*====================*/
+
+String SoXAudioFileFormat::toString () const
+{
+    const String kindName =
+        (kind == SoXAudioFileKind::wav ? "wav" : "aiff");
+    return STR::expand("SoXAudioFileFormat(kind = %1, channelCount = %2,"
+                       " sampleRate = %3, bitsPerSample = %4,"
+                       " isFloat = %5, isBigEndian = %6)",
+                       kindName, TOSTRING(channelCount),
+                       TOSTRING(sampleRate), TOSTRING(bitsPerSample),
+                       TOSTRING(isFloat), TOSTRING(isBigEndian));
+}
+
+/*--------------------*/
+
+Boolean SoXAudioFileFormat::setFromRawDescription (IN String& description)
+{
+    Logging_trace1(">>: %1", description);
+
+    const StringList partList =
+        StringList::makeBySplit(STR::strip(description), ":");
+    const Boolean hasAllParts = (partList.size() == 3);
+    const String typeName =
+        (hasAllParts ? STR::toLowercase(partList[0]) : "");
+    const Character typeCharacter =
+        (typeName.length() == 3 ? STR::firstCharacter(typeName) : ' ');
+    const Boolean hasValidType =
+        (typeCharacter == 'f' || typeCharacter == 's');
+
+    /* raw data is always little-endian, hence it is treated like
+       the payload of a WAV file (without unsigned 8 bit samples) */
+    kind          = SoXAudioFileKind::wav;
+    isFloat       = (typeCharacter == 'f');
+    isBigEndian   = false;
+    bitsPerSample =
+        (hasValidType ? STR::toNatural(typeName.substr(1), 0)
+         : Natural{0});
+    channelCount  =
+        (hasAllParts ? STR::toNatural(partList[1], 0) : Natural{0});
+    sampleRate    =
+        (hasAllParts ? STR::toNatural(partList[2], 0) : Natural{0});
+    const Boolean isOkay =
+        (hasValidType && bitsPerSample > 8 && isSupported());
+
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+
+Boolean SoXAudioFileFormat::isSupported () const
+{
+    const Boolean hasSupportedSampleSize =
+        (isFloat
+         ? (bitsPerSample == 32 || bitsPerSample == 64)
+         : (bitsPerSample == 8  || bitsPerSample == 16
+            || bitsPerSample == 24 || bitsPerSample == 32));
+    return (channelCount > 0 && sampleRate > 0 && hasSupportedSampleSize);
+}
+
+/*--------------------*/
+
+Natural SoXAudioFileFormat::bytesPerFrame () const
+{
+    return channelCount * (bitsPerSample / 8);
+}
+
+/*--------------------*/
+
+void SoXAudioFileFormat::decode (IN std::uint8_t* data,
+                                 IN Natural frameCount,
+                                 INOUT AudioSampleListVector& buffer,
+                                 IN Natural position) const
+{
+    const size_t sampleSize = (size_t) bitsPerSample / 8;
+    const size_t channels = (size_t) channelCount;
+    const bool bigEndian = (bool) isBigEndian;
+    const bool isUnsigned =
+        (sampleSize == 1 && kind == SoXAudioFileKind::wav);
+    const int shift = 64 - (int) (size_t) bitsPerSample;
+    const double scaleFactor =
+        1.0 / std::ldexp(1.0, (int) (size_t) bitsPerSample - 1);
+    const std::uint8_t* ptr = data;
+
+    for (size_t channel = 0;  channel < channels;  channel++) {
+        AudioSampleList& sampleList = buffer[channel];
+        const std::uint8_t* samplePtr = ptr + channel * sampleSize;
+
+        for (size_t i = 0;  i < (size_t) frameCount;  i++) {
+            const std::uint64_t rawValue =
+                _readNumber(samplePtr, sampleSize, bigEndian);
+            double value;
+
+            if (isFloat) {
+                if (sampleSize == 4) {
+                    const std::uint32_t bits = (std::uint32_t) rawValue;
+                    float floatValue;
+                    std::memcpy(&floatValue, &bits, sizeof(float));
+                    value = floatValue;
+                } else {
+                    std::memcpy(&value, &rawValue, sizeof(double));
+                }
+            } else if (isUnsigned) {
+                value = ((double) rawValue - 128.0) * scaleFactor;
+            } else {
+                /* sign extension via the topmost bit */
+                const std::int64_t signedValue =
+                    (std::int64_t) (rawValue << shift) >> shift;
+                value = (double) signedValue * scaleFactor;
+            }
+
+            sampleList[(size_t) position + i] = value;
+            samplePtr += channels * sampleSize;
+        }
+    }
+}
+
+/*--------------------*/
+
+void SoXAudioFileFormat::encode (IN AudioSampleListVector& buffer,
+                                 IN Natural frameCount,
+                                 OUT std::uint8_t* data) const
+{
+    const size_t sampleSize = (size_t) bitsPerSample / 8;
+    const size_t channels = (size_t) channelCount;
+    const bool bigEndian = (bool) isBigEndian;
+    const bool isUnsigned =
+        (sampleSize == 1 && kind == SoXAudioFileKind::wav);
+    const double scaleFactor =
+        std::ldexp(1.0, (int) (size_t) bitsPerSample - 1);
+    const double maximumValue = scaleFactor - 1.0;
+
+    for (size_t channel = 0;  channel < channels;  channel++) {
+        const AudioSampleList& sampleList = buffer[channel];
+        std::uint8_t* samplePtr = data + channel * sampleSize;
+
+        for (size_t i = 0;  i < (size_t) frameCount;  i++) {
+            const double value = (double) sampleList[i];
+            std::uint64_t rawValue;
+
+            if (isFloat) {
+                if (sampleSize == 4) {
+                    const float floatValue = (float) value;
+                    std::uint32_t bits;
+                    std::memcpy(&bits, &floatValue, sizeof(float));
+                    rawValue = bits;
+                } else {
+                    std::memcpy(&rawValue, &value, sizeof(double));
+                }
+            } else {
+                double scaledValue = std::round(value * scaleFactor);
+                scaledValue = (scaledValue > maximumValue ? maximumValue
+                               : scaledValue < -scaleFactor ? -scaleFactor
+                               : scaledValue);
+                const std::int64_t signedValue =
+                    (std::int64_t) scaledValue + (isUnsigned ? 128 : 0);
+                rawValue = (std::uint64_t) signedValue;
+            }
+
+            _writeNumber(samplePtr, rawValue, sampleSize, bigEndian);
+            samplePtr += channels * sampleSize;
+        }
+    }
+}
+
+/*====================*/
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+SoXAudioFileReader::SoXAudioFileReader ()
+    : _file{},
+      _mappedFile{},
+      _format{},
+      _dataPosition{0},
+      _releasePosition{0},
+      _frameCount{0},
+      _framePosition{0},
+      _byteList{}
+{
+}
+
+/*--------------------*/
+
+SoXAudioFileReader::~SoXAudioFileReader ()
+{
+    close();
+}
+
+/*--------------------*/
+/* status change      */
+/*--------------------*/
+
+Boolean SoXAudioFileReader::open (IN String& fileName,
+                                  IN Boolean mappingIsRequested)
+{
+    Logging_trace2(">>: fileName = %1, mappingIsRequested = %2",
+                   fileName, TOSTRING(mappingIsRequested));
+
+    close();
+    _format = SoXAudioFileFormat{};
+    _frameCount = 0;
+    _framePosition = 0;
+    Boolean isOkay = _file.open(fileName, "rb");
+    const Natural fileLength = (isOkay ? File::length(fileName) : 0);
+    ByteList headerList{};
+    Natural dataLength = 0;
+    Natural aiffFrameCount = Natural::maximumValue();
+    Boolean hasFormat = false;
+    Boolean hasData = false;
+
+    if (isOkay) {
+        isOkay = (_file.read(headerList, 0, 12) == 12);
+    }
+
+    if (isOkay) {
+        const std::uint8_t* data = (std::uint8_t*) headerList.asArray();
+
+        if (_hasId(data, "RIFF") && _hasId(data + 8, "WAVE")) {
+            _format.kind = SoXAudioFileKind::wav;
+        } else if (_hasId(data, "FORM")
+                   && (_hasId(data + 8, "AIFF")
+                       || _hasId(data + 8, "AIFC"))) {
+            _format.kind = SoXAudioFileKind::aiff;
+            _format.isBigEndian = true;
+        } else {
+            isOkay = false;
+        }
+    }
+
+    const bool isAiff = (_format.kind == SoXAudioFileKind::aiff);
+
+    /* scan the chunks for the format and the payload */
+    while (isOkay && !(hasFormat && hasData)) {
+        const Natural chunkPosition = _file.position() + 8;
+
+        if (_file.read(headerList, 0, 8) < 8) {
+            break;
+        }
+
+        const std::uint8_t* data = (std::uint8_t*) headerList.asArray();
+        const Natural chunkLength =
+            Natural{(size_t) _readNumber(data + 4, 4, isAiff)};
+
+        if (_hasId(data, "fmt ") || _hasId(data, "COMM")) {
+            const Natural count = Natural::minimum(chunkLength, 40);
+            isOkay = (_file.read(headerList, 0, count) == count);
+            data = (std::uint8_t*) headerList.asArray();
+
+            if (!isOkay) {
+                /* truncated chunk */
+            } else if (!isAiff && count >= 16) {
+                std::uint64_t formatTag = _readNumber(data, 2, false);
+
+                if (formatTag == _wavFormatTag_extensible && count >= 26) {
+                    formatTag = _readNumber(data + 24, 2, false);
+                }
+
+                _format.channelCount =
+                    Natural{(size_t) _readNumber(data + 2, 2, false)};
+                _format.sampleRate =
+                    Natural{(size_t) _readNumber(data + 4, 4, false)};
+                _format.bitsPerSample =
+                    Natural{(size_t) _readNumber(data + 14, 2, false)};
+                _format.isFloat = (formatTag == _wavFormatTag_float);
+                isOkay = (formatTag == _wavFormatTag_pcm
+                          || formatTag == _wavFormatTag_float);
+                hasFormat = true;
+            } else if (isAiff && count >= 18) {
+                const Natural sampleSize =
+                    Natural{(size_t) _readNumber(data + 6, 2, true)};
+                _format.channelCount =
+                    Natural{(size_t) _readNumber(data, 2, true)};
+                aiffFrameCount =
+                    Natural{(size_t) _readNumber(data + 2, 4, true)};
+                _format.sampleRate =
+                    Natural{(size_t) std::lround(_readExtended(data + 8))};
+
+                /* samples are left-justified in whole bytes */
+                _format.bitsPerSample = (sampleSize + 7) / 8 * 8;
+
+                if (count >= 22) {
+                    const std::uint8_t* compressionType = data + 18;
+
+                    if (_hasId(compressionType, "sowt")) {
+                        _format.isBigEndian = false;
+                    } else if (_hasId(compressionType, "fl32")
+                               || _hasId(compressionType, "FL32")) {
+                        _format.isFloat = true;
+                        _format.bitsPerSample = 32;
+                    } else if (_hasId(compressionType, "fl64")
+                               || _hasId(compressionType, "FL64")) {
+                        _format.isFloat = true;
+                        _format.bitsPerSample = 64;
+                    } else {
+                        isOkay = _hasId(compressionType, "NONE");
+                    }
+                }
+
+                hasFormat = true;
+            } else {
+                isOkay = false;
+            }
+        } else if (_hasId(data, "data")) {
+            _dataPosition = chunkPosition;
+            dataLength = chunkLength;
+            hasData = true;
+        } else if (_hasId(data, "SSND")) {
+            isOkay = (_file.read(headerList, 0, 8) == 8);
+            data = (std::uint8_t*) headerList.asArray();
+            const Natural offset =
+                Natural{(size_t) _readNumber(data, 4, true)};
+            _dataPosition = chunkPosition + offset + 8;
+            dataLength = (chunkLength < offset + 8 ? Natural{0}
+                          : chunkLength - offset - 8);
+            hasData = true;
+        }
+
+        /* chunks are padded to an even length */
+        isOkay = isOkay && _file.setPosition(chunkPosition + chunkLength
+                                             + chunkLength % 2);
+    }
+
+    isOkay = isOkay && hasFormat && hasData && _format.isSupported();
+
+    if (isOkay) {
+        /* streaming writers may leave the payload length open */
+        const Natural availableLength =
+            (fileLength > _dataPosition ? fileLength - _dataPosition
+             : Natural{0});
+        dataLength = Natural::minimum(dataLength, availableLength);
+        _frameCount = Natural::minimum(dataLength / _format.bytesPerFrame(),
+                                       aiffFrameCount);
+        isOkay = _file.setPosition(_dataPosition);
+    }
+
+    if (isOkay && mappingIsRequested && _mappedFile.open(fileName)) {
+        /* the header has been parsed by buffered I/O, the payload
+           is taken from the mapping */
+        _file.close();
+        _releasePosition = _dataPosition;
+        _mappedFile.adviseSequentialAccess();
+    }
+
+    if (!isOkay) {
+        close();
+    }
+
+    Logging_trace3("<<: isOkay = %1, isMapped = %2, format = %3",
+                   TOSTRING(isOkay), TOSTRING(isMapped()),
+                   _format.toString());
+    return isOkay;
+}
+
+/*--------------------*/
+
+void SoXAudioFileReader::close ()
+{
+    _file.closeConditionally();
+    _mappedFile.close();
+}
+
+/*--------------------*/
+/* property queries   */
+/*--------------------*/
+
+const SoXAudioFileFormat& SoXAudioFileReader::format () const
+{
+    return _format;
+}
+
+/*--------------------*/
+
+Natural SoXAudioFileReader::frameCount () const
+{
+    return _frameCount;
+}
+
+/*--------------------*/
+
+Boolean SoXAudioFileReader::isMapped () const
+{
+    return _mappedFile.isOpen();
+}
+
+/*--------------------*/
+
+const std::uint8_t* SoXAudioFileReader::mappedPayload () const
+{
+    return (_mappedFile.isOpen()
+            ? _mappedFile.data() + (size_t) _dataPosition : nullptr);
+}
+
+/*--------------------*/
+/* access             */
+/*--------------------*/
+
+Natural SoXAudioFileReader::read (OUT AudioSampleListVector& buffer,
+                                  IN Natural frameCount)
+{
+    Logging_traceHot1(">>: %1", TOSTRING(frameCount));
+
+    const Natural bytesPerFrame = _format.bytesPerFrame();
+    const Natural requestedCount =
+        Natural::minimum(frameCount, _frameCount - _framePosition);
+    const Boolean isMapped = _mappedFile.isOpen();
+    const Natural position =
+        _dataPosition + _framePosition * bytesPerFrame;
+    const std::uint8_t* data = nullptr;
+    Natural result = 0;
+
+    if (requestedCount == 0) {
+        /* end of file */
+    } else if (isMapped) {
+        /* decode in place from the mapping and request the next
+           block ahead */
+        result = requestedCount;
+        data = _mappedFile.data() + (size_t) position;
+        _mappedFile.prefetch(position + result * bytesPerFrame,
+                             result * bytesPerFrame);
+    } else if (_file.isOpen()) {
+        /* read positionally into the block buffer (which only grows)
+           and request the next block ahead */
+        const Natural requestedByteCount = requestedCount * bytesPerFrame;
+
+        if (_byteList.length() < requestedByteCount) {
+            _byteList.setLength(requestedByteCount);
+        }
+
+        data = (std::uint8_t*) _byteList.asArray();
+        const Natural byteCount =
+            _file.readInto(_byteList.asArray(), position,
+                           requestedByteCount);
+        result = byteCount / bytesPerFrame;
+        _file.prefetch(position + byteCount, requestedByteCount);
+    }
+
+    if (buffer.length() != _format.channelCount) {
+        buffer.setLength(_format.channelCount);
+    }
+
+    buffer.setFrameCount(result);
+    _format.decode(data, result, buffer);
+    _framePosition += result;
+
+    if (isMapped && result > 0) {
+        /* drop the pages of the previous and this block; pages
+           shared by both blocks are released now */
+        const Natural endPosition = position + result * bytesPerFrame;
+        _mappedFile.release(_releasePosition,
+                            endPosition - _releasePosition);
+        _releasePosition = position;
+    }
+
+    Logging_traceHot1("<<: %1", TOSTRING(result));
+    return result;
+}
+
+/*--------------------*/
+
+void SoXAudioFileReader::setFramePosition (IN Natural framePosition)
+{
+    Logging_trace1(">>: %1", TOSTRING(framePosition));
+
+    _framePosition = Natural::minimum(framePosition, _frameCount);
+    const Natural position =
+        _dataPosition + _framePosition * _format.bytesPerFrame();
+
+    /* buffered reads are positional, hence only a mapping has to
+       be adjusted */
+    if (_mappedFile.isOpen()) {
+        _releasePosition = position;
+    }
+
+    Logging_trace("<<");
+}
+
+/*====================*/
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+SoXAudioFileWriter::SoXAudioFileWriter ()
+    : _file{},
+      _format{},
+      _dataPosition{0},
+      _frameCount{0},
+      _byteList{}
+{
+}
+
+/*--------------------*/
+
+SoXAudioFileWriter::~SoXAudioFileWriter ()
+{
+    close();
+}
+
+/*--------------------*/
+/* status change      */
+/*--------------------*/
+
+Boolean SoXAudioFileWriter::open (IN String& fileName,
+                                  IN SoXAudioFileFormat& format)
+{
+    Logging_trace2(">>: fileName = %1, format = %2",
+                   fileName, format.toString());
+
+    close();
+    _format = format;
+    _format.isBigEndian = (_format.kind == SoXAudioFileKind::aiff);
+    _frameCount = 0;
+    Boolean isOkay = _format.isSupported();
+
+    if (isOkay) {
+        isOkay = _file.open(fileName, "wb");
+    }
+
+    if (isOkay) {
+        _writeHeader();
+        _dataPosition = _file.position();
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+
+Boolean SoXAudioFileWriter::reopen (IN String& fileName,
+                                    IN SoXAudioFileFormat& format,
+                                    IN Natural frameCount)
+{
+    Logging_trace3(">>: fileName = %1, format = %2, frameCount = %3",
+                   fileName, format.toString(), TOSTRING(frameCount));
+
+    close();
+    _format = format;
+    _format.isBigEndian = (_format.kind == SoXAudioFileKind::aiff);
+    _frameCount = frameCount;
+    const Natural fileLength = File::length(fileName);
+    Boolean isOkay = _format.isSupported();
+
+    if (isOkay) {
+        isOkay = _file.open(fileName, "r+b");
+    }
+
+    if (isOkay) {
+        /* the header has a fixed size, hence rewriting it for the
+           valid frames keeps the payload position */
+        _writeHeader();
+        _dataPosition = _file.position();
+        isOkay = (fileLength
+                  >= _dataPosition + frameCount * _format.bytesPerFrame());
+
+        if (!isOkay) {
+            _file.close();
+        }
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+
+void SoXAudioFileWriter::close ()
+{
+    Logging_trace(">>");
+
+    if (_file.isOpen()) {
+        const Natural dataLength = _frameCount * _format.bytesPerFrame();
+
+        if (dataLength % 2 != 0) {
+            /* pad the payload chunk to an even length */
+            _file.setPosition(_dataPosition + dataLength);
+            _byteList.setLength(1);
+            _byteList[0] = 0;
+            _file.write(_byteList, 0, 1);
+        }
+
+        _file.setPosition(0);
+        _writeHeader();
+        _file.close();
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+Boolean SoXAudioFileWriter::flush ()
+{
+    Logging_trace(">>");
+    const Boolean isOkay = (_file.isOpen() && _file.flush());
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+/* property queries   */
+/*--------------------*/
+
+const SoXAudioFileFormat& SoXAudioFileWriter::format () const
+{
+    return _format;
+}
+
+/*--------------------*/
+
+Natural SoXAudioFileWriter::frameCount () const
+{
+    return _frameCount;
+}
+
+/*--------------------*/
+/* access             */
+/*--------------------*/
+
+Boolean SoXAudioFileWriter::write (IN AudioSampleListVector& buffer,
+                                   IN Natural frameCount)
+{
+    Logging_traceHot1(">>: %1", TOSTRING(frameCount));
+
+    const Natural byteCount = frameCount * _format.bytesPerFrame();
+
+    if (_byteList.length() < byteCount) {
+        _byteList.setLength(byteCount);
+    }
+
+    _format.encode(buffer, frameCount,
+                   (std::uint8_t*) _byteList.asArray());
+    const Boolean isOkay =
+        (_file.isOpen() && _file.write(_byteList, 0, byteCount) == byteCount);
+    _frameCount += (isOkay ? frameCount : Natural{0});
+
+    Logging_traceHot1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+
+Boolean SoXAudioFileWriter::writeAt (IN AudioSampleListVector& buffer,
+                                     IN Natural frameCount,
+                                     IN Natural framePosition)
+{
+    Logging_traceHot2(">>: frameCount = %1, framePosition = %2",
+                      TOSTRING(frameCount), TOSTRING(framePosition));
+
+    const Natural byteCount = frameCount * _format.bytesPerFrame();
+
+    if (_byteList.length() < byteCount) {
+        _byteList.setLength(byteCount);
+    }
+
+    _format.encode(buffer, frameCount,
+                   (std::uint8_t*) _byteList.asArray());
+    const Boolean isOkay =
+        writeEncodedAt(_byteList, frameCount, framePosition);
+
+    Logging_traceHot1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+
+Boolean SoXAudioFileWriter::writeEncodedAt (IN ByteList& byteList,
+                                            IN Natural frameCount,
+                                            IN Natural framePosition)
+{
+    Logging_traceHot2(">>: frameCount = %1, framePosition = %2",
+                      TOSTRING(frameCount), TOSTRING(framePosition));
+
+    const Natural bytesPerFrame = _format.bytesPerFrame();
+    const Natural byteCount = frameCount * bytesPerFrame;
+    Boolean isOkay = (_file.isOpen() && byteList.length() >= byteCount);
+
+    if (isOkay) {
+        isOkay = _file.setPosition(_dataPosition
+                                   + framePosition * bytesPerFrame);
+    }
+
+    if (isOkay) {
+        isOkay = (_file.write(byteList, 0, byteCount) == byteCount);
+    }
+
+    if (isOkay) {
+        _frameCount =
+            Natural::maximum(_frameCount, framePosition + frameCount);
+    }
+
+    Logging_traceHot1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+
+void SoXAudioFileWriter::_writeHeader ()
+{
+    Logging_trace1(">>: frameCount = %1", TOSTRING(_frameCount));
+
+    std::uint8_t data[_maximumHeaderSize];
+    size_t position = 0;
+    const std::uint64_t dataLength =
+        (std::uint64_t) (size_t) (_frameCount * _format.bytesPerFrame());
+    const std::uint64_t paddedDataLength = dataLength + dataLength % 2;
+    const std::uint64_t channelCount = (size_t) _format.channelCount;
+    const std::uint64_t bitsPerSample = (size_t) _format.bitsPerSample;
+
+    if (_format.kind == SoXAudioFileKind::wav) {
+        const std::uint64_t blockAlign = (size_t) _format.bytesPerFrame();
+        const std::uint64_t sampleRate = (size_t) _format.sampleRate;
+        _appendId(data, position, "RIFF");
+        _appendNumber(data, position, 36 + paddedDataLength, 4, false);
+        _appendId(data, position, "WAVE");
+        _appendId(data, position, "fmt ");
+        _appendNumber(data, position, 16, 4, false);
+        _appendNumber(data, position,
+                      (_format.isFloat ? _wavFormatTag_float
+                       : _wavFormatTag_pcm), 2, false);
+        _appendNumber(data, position, channelCount, 2, false);
+        _appendNumber(data, position, sampleRate, 4, false);
+        _appendNumber(data, position, sampleRate * blockAlign, 4, false);
+        _appendNumber(data, position, blockAlign, 2, false);
+        _appendNumber(data, position, bitsPerSample, 2, false);
+        _appendId(data, position, "data");
+        _appendNumber(data, position, dataLength, 4, false);
+    } else {
+        /* float samples need the AIFC variant with a compression
+           type and a version chunk */
+        const bool isAifc = (bool) _format.isFloat;
+        const std::uint64_t commonLength = (isAifc ? 24 : 18);
+        const std::uint64_t formLength =
+            (4 + (isAifc ? 12 : 0) + 8 + commonLength + 16
+             + paddedDataLength);
+        _appendId(data, position, "FORM");
+        _appendNumber(data, position, formLength, 4, true);
+        _appendId(data, position, (isAifc ? "AIFC" : "AIFF"));
+
+        if (isAifc) {
+            _appendId(data, position, "FVER");
+            _appendNumber(data, position, 4, 4, true);
+            _appendNumber(data, position, _aifcVersion, 4, true);
+        }
+
+        _appendId(data, position, "COMM");
+        _appendNumber(data, position, commonLength, 4, true);
+        _appendNumber(data, position, channelCount, 2, true);
+        _appendNumber(data, position, (size_t) _frameCount, 4, true);
+        _appendNumber(data, position, bitsPerSample, 2, true);
+        _writeExtended(&data[position], (size_t) _format.sampleRate);
+        position += 10;
+
+        if (isAifc) {
+            /* compression type and an empty padded name */
+            _appendId(data, position,
+                      (bitsPerSample == 32 ? "fl32" : "fl64"));
+            _appendNumber(data, position, 0, 2, true);
+        }
+
+        _appendId(data, position, "SSND");
+        _appendNumber(data, position, 8 + dataLength, 4, true);
+        _appendNumber(data, position, 0, 4, true);
+        _appendNumber(data, position, 0, 4, true);
+    }
+
+    _byteList.setLength(position);
+    std::memcpy(_byteList.asArray(), data, position);
+    _file.write(_byteList, 0, position);
+
+    Logging_trace1("<<: headerLength = %1", TOSTRING(Natural{position}));
+}
+
+/*====================*/
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+SoXAudioStream::SoXAudioStream ()
+    : _stream{nullptr},
+      _format{},
+      _frameCount{0},
+      _byteList{}
+{
+    Logging_trace(">>");
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+SoXAudioStream::~SoXAudioStream ()
+{
+    Logging_trace(">>");
+    close();
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+Boolean SoXAudioStream::open (IN Boolean isInput,
+                              IN SoXAudioFileFormat& format)
+{
+    Logging_trace2(">>: isInput = %1, format = %2",
+                   TOSTRING(isInput), format.toString());
+
+    close();
+    const Boolean isOkay = format.isSupported();
+
+    if (isOkay) {
+        _stream     = (isInput ? stdin : stdout);
+        _format     = format;
+        _frameCount = 0;
+
+        /* without a stdio buffer each block is transferred directly
+           between the pipe and the byte list */
+        #ifdef _WIN32
+            _setmode(_fileno(_stream), _O_BINARY);
+        #endif
+
+        std::setvbuf(_stream, nullptr, _IONBF, 0);
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+
+void SoXAudioStream::close ()
+{
+    Logging_trace(">>");
+
+    if (_stream != nullptr) {
+        std::fflush(_stream);
+        _stream = nullptr;
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* property queries   */
+/*--------------------*/
+
+const SoXAudioFileFormat& SoXAudioStream::format () const
+{
+    return _format;
+}
+
+/*--------------------*/
+
+Natural SoXAudioStream::frameCount () const
+{
+    return _frameCount;
+}
+
+/*--------------------*/
+/* access             */
+/*--------------------*/
+
+Natural SoXAudioStream::read (OUT AudioSampleListVector& buffer,
+                              IN Natural frameCount)
+{
+    Logging_traceHot1(">>: %1", TOSTRING(frameCount));
+
+    const size_t bytesPerFrame = (size_t) _format.bytesPerFrame();
+    const size_t requestedByteCount = (size_t) frameCount * bytesPerFrame;
+    size_t byteCount = 0;
+    Boolean isDone = (_stream == nullptr);
+
+    if (_byteList.length() < requestedByteCount) {
+        _byteList.setLength(requestedByteCount);
+    }
+
+    /* a pipe delivers partial blocks, hence read until the block is
+       complete or the input has ended */
+    while (!isDone && byteCount < requestedByteCount) {
+        const size_t count =
+            std::fread((std::uint8_t*) _byteList.asArray() + byteCount,
+                       1, requestedByteCount - byteCount, _stream);
+        byteCount += count;
+        isDone = (count == 0);
+    }
+
+    const Natural result{bytesPerFrame == 0 ? 0
+                         : byteCount / bytesPerFrame};
+
+    if (buffer.length() != _format.channelCount) {
+        buffer.setLength(_format.channelCount);
+    }
+
+    buffer.setFrameCount(result);
+    _format.decode((std::uint8_t*) _byteList.asArray(), result, buffer);
+    _frameCount += result;
+
+    Logging_traceHot1("<<: %1", TOSTRING(result));
+    return result;
+}
+
+/*--------------------*/
+
+Boolean SoXAudioStream::write (IN AudioSampleListVector& buffer,
+                               IN Natural frameCount)
+{
+    Logging_traceHot1(">>: %1", TOSTRING(frameCount));
+
+    const size_t byteCount =
+        (size_t) (frameCount * _format.bytesPerFrame());
+    Boolean isOkay = (_stream != nullptr);
+
+    if (_byteList.length() < byteCount) {
+        _byteList.setLength(byteCount);
+    }
+
+    if (isOkay) {
+        _format.encode(buffer, frameCount,
+                       (std::uint8_t*) _byteList.asArray());
+        isOkay = (std::fwrite(_byteList.asArray(), 1, byteCount, _stream)
+                  == byteCount);
+        _frameCount += (isOkay ? frameCount : Natural{0});
+    }
+
+    Logging_traceHot1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
@@ -0,0 +1,603 @@
+/**
+ * @file
+ * The <C>SoXAudioFile</C> specification defines block-wise streaming
+ * readers and writers for uncompressed WAV and AIFF audio files and
+ * for raw PCM on the standard streams used by the offline renderer.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include <cstdint>
+#include <cstdio>
+#include "AudioSampleListVector.h"
+#include "ByteList.h"
+#include "File.h"
+#include "MappedFile.h"
+
+/*--------------------*/
+
+using Audio::AudioSampleListVector;
+using BaseModules::File;
+using BaseModules::MappedFile;
+using BaseTypes::Containers::ByteList;
+
+/*====================*/
+
+namespace SoXPlugins::Renderer {
+
+    /**
+     * The kind of an audio file container.
+     */
+    enum class SoXAudioFileKind {
+        wav, aiff
+    };
+
+    /*--------------------*/
+
+    /**
+     * A <C>SoXAudioFileFormat</C> object describes the layout of the
+     * interleaved PCM payload of an audio file and converts between
+     * this layout and audio samples.
+     */
+    struct SoXAudioFileFormat {
+
+        /** the kind of file container */
+        SoXAudioFileKind kind{SoXAudioFileKind::wav};
+
+        /** the number of interleaved channels */
+        Natural channelCount{0};
+
+        /** the sample rate in Hz */
+        Natural sampleRate{0};
+
+        /** the number of bits per sample (8, 16, 24, 32 or 64) */
+        Natural bitsPerSample{0};
+
+        /** tells whether samples are IEEE floating point numbers */
+        Boolean isFloat{false};
+
+        /** tells whether multibyte samples are big-endian */
+        Boolean isBigEndian{false};
+
+        /*--------------------*/
+
+        /**
+         * Returns string representation of format
+         *
+         * @return string representation
+         */
+        String toString () const;
+
+        /*--------------------*/
+
+        /**
+         * Sets the format from the raw PCM description
+         * <C>description</C> of the form "type:channels:rate" with
+         * type one of "f32", "f64", "s16", "s24" or "s32" (always
+         * little-endian) and tells whether the description is
+         * valid.
+         *
+         * @param[in] description  description of raw PCM layout
+         * @return  information whether description is valid
+         */
+        Boolean setFromRawDescription (IN String& description);
+
+        /*--------------------*/
+
+        /**
+         * Tells whether format describes a supported sample layout.
+         *
+         * @return  information whether format is supported
+         */
+        Boolean isSupported () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of bytes of an interleaved frame.
+         *
+         * @return  bytes per frame
+         */
+        Natural bytesPerFrame () const;
+
+        /*--------------------*/
+
+        /**
+         * Decodes <C>frameCount</C> interleaved frames from
+         * <C>data</C> into the channels of <C>buffer</C> starting at
+         * frame <C>position</C>; the buffer must be large enough.
+         *
+         * @param[in]    data        interleaved PCM bytes
+         * @param[in]    frameCount  number of frames to decode
+         * @param[inout] buffer      buffer receiving the samples
+         * @param[in]    position    first frame position in buffer
+         */
+        void decode (IN std::uint8_t* data,
+                     IN Natural frameCount,
+                     INOUT AudioSampleListVector& buffer,
+                     IN Natural position = 0) const;
+
+        /*--------------------*/
+
+        /**
+         * Encodes <C>frameCount</C> frames from the channels of
+         * <C>buffer</C> as interleaved PCM bytes into <C>data</C>;
+         * integer samples are clipped to the representable range.
+         *
+         * @param[in]  buffer      buffer with the samples
+         * @param[in]  frameCount  number of frames to encode
+         * @param[out] data        interleaved PCM bytes (large enough
+         *                         for the frames)
+         */
+        void encode (IN AudioSampleListVector& buffer,
+                     IN Natural frameCount,
+                     OUT std::uint8_t* data) const;
+
+    };
+
+    /*====================*/
+
+    /**
+     * A <C>SoXAudioFileReader</C> object reads the PCM payload of an
+     * uncompressed WAV or AIFF file block by block; only a single
+     * block of raw bytes is held in memory regardless of the file
+     * length.
+     *
+     * When possible the payload is memory mapped and decoded
+     * directly from the mapping without an intermediate copy; the
+     * mapping is read with sequential access hints, the next block
+     * is prefetched and consumed pages are released, so that also
+     * then the file is never loaded completely.  Otherwise the
+     * reader falls back to buffered I/O.
+     */
+    struct SoXAudioFileReader {
+
+        /**
+         * Makes a reader without an associated file.
+         */
+        SoXAudioFileReader ();
+
+        /*--------------------*/
+
+        /**
+         * Closes the reader.
+         */
+        ~SoXAudioFileReader ();
+
+        /*--------------------*/
+
+        SoXAudioFileReader (IN SoXAudioFileReader&) = delete;
+
+        /*--------------------*/
+
+        /**
+         * Opens the file named <C>fileName</C>, parses its header
+         * and tells whether it is a supported audio file; the
+         * payload is memory mapped when <C>mappingIsRequested</C> is
+         * set and mapping is possible.
+         *
+         * @param[in] fileName            name of audio file
+         * @param[in] mappingIsRequested  information whether the
+         *                                payload shall be memory
+         *                                mapped
+         * @return  information whether file could be opened
+         */
+        Boolean open (IN String& fileName,
+                      IN Boolean mappingIsRequested = true);
+
+        /*--------------------*/
+
+        /**
+         * Closes the associated file.
+         */
+        void close ();
+
+        /*--------------------*/
+
+        /**
+         * Returns the format of the associated file.
+         *
+         * @return  audio file format
+         */
+        const SoXAudioFileFormat& format () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the total number of frames in the associated file.
+         *
+         * @return  frame count of file
+         */
+        Natural frameCount () const;
+
+        /*--------------------*/
+
+        /**
+         * Tells whether the payload of the associated file is read
+         * via a memory mapping.
+         *
+         * @return  information whether file is memory mapped
+         */
+        Boolean isMapped () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns a read-only view onto the complete PCM payload
+         * when the file is memory mapped.
+         *
+         * @return  pointer to first payload byte (nullptr when the
+         *          file is not mapped)
+         */
+        const std::uint8_t* mappedPayload () const;
+
+        /*--------------------*/
+
+        /**
+         * Reads at most <C>frameCount</C> following frames into
+         * <C>buffer</C>, adapts its channel and frame count to the
+         * frames read and returns their number (zero at the end of
+         * the file).
+         *
+         * @param[out] buffer      buffer receiving the samples
+         * @param[in]  frameCount  maximum number of frames to read
+         * @return  number of frames read
+         */
+        Natural read (OUT AudioSampleListVector& buffer,
+                      IN Natural frameCount);
+
+        /*--------------------*/
+
+        /**
+         * Sets the index of the next frame to be read to
+         * <C>framePosition</C> (at most the frame count of the
+         * file).
+         *
+         * @param[in] framePosition  index of next frame to be read
+         */
+        void setFramePosition (IN Natural framePosition);
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the associated file for positional reads when not
+             * mapped */
+            File _file;
+
+            /** the associated file when memory mapped */
+            MappedFile _mappedFile;
+
+            /** the format of the file */
+            SoXAudioFileFormat _format;
+
+            /** the byte position of the PCM payload in file */
+            Natural _dataPosition;
+
+            /** the byte position of the previous block in a mapped
+             * file (the start of the range still to be released) */
+            Natural _releasePosition;
+
+            /** the total number of frames in file */
+            Natural _frameCount;
+
+            /** the index of the next frame to be read */
+            Natural _framePosition;
+
+            /** the buffer for the raw bytes of a block */
+            ByteList _byteList;
+
+    };
+
+    /*====================*/
+
+    /**
+     * A <C>SoXAudioFileWriter</C> object writes audio samples block by
+     * block as the PCM payload of an uncompressed WAV or AIFF file;
+     * the header is completed when the writer is closed.
+     */
+    struct SoXAudioFileWriter {
+
+        /**
+         * Makes a writer without an associated file.
+         */
+        SoXAudioFileWriter ();
+
+        /*--------------------*/
+
+        /**
+         * Closes the writer and completes the file.
+         */
+        ~SoXAudioFileWriter ();
+
+        /*--------------------*/
+
+        SoXAudioFileWriter (IN SoXAudioFileWriter&) = delete;
+
+        /*--------------------*/
+
+        /**
+         * Creates the file named <C>fileName</C> with
+         * <C>format</C>, writes a preliminary header and tells
+         * whether this has been successful.
+         *
+         * @param[in] fileName  name of audio file
+         * @param[in] format    format of the file
+         * @return  information whether file could be created
+         */
+        Boolean open (IN String& fileName,
+                      IN SoXAudioFileFormat& format);
+
+        /*--------------------*/
+
+        /**
+         * Reopens the existing file named <C>fileName</C> written
+         * with <C>format</C> for appending after its first
+         * <C>frameCount</C> frames (like after an interrupted
+         * rendering), rewrites its header for that frame count and
+         * tells whether this has been successful; later frames in
+         * the file are overwritten by the next writes.
+         *
+         * @param[in] fileName    name of audio file
+         * @param[in] format      format of the file
+         * @param[in] frameCount  number of valid frames in file
+         * @return  information whether file could be reopened
+         */
+        Boolean reopen (IN String& fileName,
+                        IN SoXAudioFileFormat& format,
+                        IN Natural frameCount);
+
+        /*--------------------*/
+
+        /**
+         * Completes the header with the final sizes and closes the
+         * associated file.
+         */
+        void close ();
+
+        /*--------------------*/
+
+        /**
+         * Hands all frames written so far over to the operating
+         * system and tells whether this has been successful; the
+         * header is only completed by <C>close</C>.
+         *
+         * @return  information whether flush has been successful
+         */
+        Boolean flush ();
+
+        /*--------------------*/
+
+        /**
+         * Returns the format of the associated file.
+         *
+         * @return  audio file format
+         */
+        const SoXAudioFileFormat& format () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of frames written so far.
+         *
+         * @return  frame count
+         */
+        Natural frameCount () const;
+
+        /*--------------------*/
+
+        /**
+         * Writes the first <C>frameCount</C> frames of
+         * <C>buffer</C> to the file and tells whether this has been
+         * successful.
+         *
+         * @param[in] buffer      buffer with the samples
+         * @param[in] frameCount  number of frames to write
+         * @return  information whether write has been successful
+         */
+        Boolean write (IN AudioSampleListVector& buffer,
+                       IN Natural frameCount);
+
+        /*--------------------*/
+
+        /**
+         * Writes the first <C>frameCount</C> frames of
+         * <C>buffer</C> to the file starting at frame index
+         * <C>framePosition</C> and tells whether this has been
+         * successful; the frame count of the file is extended when
+         * necessary and all frames must be written before the
+         * writer is closed.  Consecutive writes at arbitrary
+         * positions must be serialized by the caller.
+         *
+         * @param[in] buffer         buffer with the samples
+         * @param[in] frameCount     number of frames to write
+         * @param[in] framePosition  index of first frame to be
+         *                           written
+         * @return  information whether write has been successful
+         */
+        Boolean writeAt (IN AudioSampleListVector& buffer,
+                         IN Natural frameCount,
+                         IN Natural framePosition);
+
+        /*--------------------*/
+
+        /**
+         * Writes <C>frameCount</C> frames already encoded in the
+         * format of the file as the leading bytes of
+         * <C>byteList</C> starting at frame index
+         * <C>framePosition</C> and tells whether this has been
+         * successful; like for <C>writeAt</C> the writes must be
+         * serialized by the caller, but the encoding may be done
+         * concurrently elsewhere.
+         *
+         * @param[in] byteList       encoded interleaved PCM bytes
+         * @param[in] frameCount     number of frames to write
+         * @param[in] framePosition  index of first frame to be
+         *                           written
+         * @return  information whether write has been successful
+         */
+        Boolean writeEncodedAt (IN ByteList& byteList,
+                                IN Natural frameCount,
+                                IN Natural framePosition);
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /**
+             * Writes the header for the current frame count at the
+             * start of the file.
+             */
+            void _writeHeader ();
+
+            /*--------------------*/
+
+            /** the associated file */
+            File _file;
+
+            /** the format of the file */
+            SoXAudioFileFormat _format;
+
+            /** the byte position of the PCM payload in file */
+            Natural _dataPosition;
+
+            /** the number of frames written */
+            Natural _frameCount;
+
+            /** the buffer for the raw bytes of a block */
+            ByteList _byteList;
+
+    };
+
+    /*====================*/
+
+    /**
+     * A <C>SoXAudioStream</C> object reads or writes headerless
+     * interleaved PCM with a given format on the standard input or
+     * standard output of the process, for example within a pipeline
+     * of command line tools.  The standard stream is switched to
+     * unbuffered binary mode, hence each block is transferred by
+     * system calls directly between the pipe and the block bytes,
+     * which are decoded straight into the channels of the sample
+     * buffer.
+     */
+    struct SoXAudioStream {
+
+        /**
+         * Makes a stream without an associated standard stream.
+         */
+        SoXAudioStream ();
+
+        /*--------------------*/
+
+        /**
+         * Flushes the stream.
+         */
+        ~SoXAudioStream ();
+
+        /*--------------------*/
+
+        SoXAudioStream (IN SoXAudioStream&) = delete;
+
+        /*--------------------*/
+
+        /**
+         * Associates the stream with the standard input (when
+         * <C>isInput</C> is set) or the standard output with PCM
+         * layout <C>format</C> and tells whether this has been
+         * successful.
+         *
+         * @param[in] isInput  information whether the standard
+         *                     input is read
+         * @param[in] format   layout of the raw PCM data
+         * @return  information whether the format is supported
+         */
+        Boolean open (IN Boolean isInput,
+                      IN SoXAudioFileFormat& format);
+
+        /*--------------------*/
+
+        /**
+         * Flushes the stream and drops the association.
+         */
+        void close ();
+
+        /*--------------------*/
+
+        /**
+         * Returns the format of the stream.
+         *
+         * @return  audio format
+         */
+        const SoXAudioFileFormat& format () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the number of frames transferred so far.
+         *
+         * @return  frame count
+         */
+        Natural frameCount () const;
+
+        /*--------------------*/
+
+        /**
+         * Reads at most <C>frameCount</C> following frames into
+         * <C>buffer</C>, adapts its channel and frame count to the
+         * frames read and returns their number; waits for the pipe
+         * until the frames are complete or the input ends (zero at
+         * the end, an incomplete final frame is dropped).
+         *
+         * @param[out] buffer      buffer receiving the samples
+         * @param[in]  frameCount  maximum number of frames to read
+         * @return  number of frames read
+         */
+        Natural read (OUT AudioSampleListVector& buffer,
+                      IN Natural frameCount);
+
+        /*--------------------*/
+
+        /**
+         * Writes the first <C>frameCount</C> frames of
+         * <C>buffer</C> to the stream and tells whether this has
+         * been successful.
+         *
+         * @param[in] buffer      buffer with the samples
+         * @param[in] frameCount  number of frames to write
+         * @return  information whether write has been successful
+         */
+        Boolean write (IN AudioSampleListVector& buffer,
+                       IN Natural frameCount);
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the associated standard stream (if any) */
+            std::FILE* _stream;
+
+            /** the format of the stream */
+            SoXAudioFileFormat _format;
+
+            /** the number of frames transferred */
+            Natural _frameCount;
+
+            /** the buffer for the raw bytes of a block */
+            ByteList _byteList;
+
+    };
+
+}
@@ -0,0 +1,1275 @@
+/**
+ * @file
+ * The <C>SoXBatchRenderer</C> body implements a renderer processing
+ * a manifest of audio files concurrently on several worker threads,
+ * each with its own effect instances.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXBatchRenderer.h"
+
+#include <chrono>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include "DspStateStream.h"
+#include "File.h"
+#include "Logging.h"
+#include "OperatingSystem.h"
+#include "SoXOfflineRenderer.h"
+
+/*--------------------*/
+
+using Audio::DspStateStream;
+using BaseModules::File;
+using BaseModules::OperatingSystem;
+using SoXPlugins::Renderer::SoXBatchJob;
+using SoXPlugins::Renderer::SoXBatchJobList;
+using SoXPlugins::Renderer::SoXBatchRenderer;
+using SoXPlugins::Renderer::SoXBatchStatistics;
+using SoXPlugins::Renderer::SoXOfflineRenderer;
+using SoXPlugins::Renderer::SoXRenderCache;
+using SoXPlugins::Renderer::SoXRenderCacheEvictionPolicy;
+
+namespace FileSystem = std::filesystem;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
+
+/*====================*/
+
+/** the number of queued jobs per worker thread */
+static const Natural _queueLengthPerThread = 2;
+
+/** the maximum number of jobs rendered together by a single effect
+ * instance */
+static const Natural _maximumGroupJobCount = 16;
+
+/*====================*/
+
+/**
+ * The <C>_SoXPeakScanState</C> tells whether the peak of the input
+ * of a normalization job is still unknown, has been measured or
+ * could not be measured, or whether the output has been taken from
+ * the render cache instead.
+ */
+enum class _SoXPeakScanState {
+    pending, known, failed, cached
+};
+
+/*====================*/
+
+/**
+ * A <C>_SoXBatchJobQueue</C> object is a bounded queue of job group
+ * indices between the dispatching thread and the workers: the
+ * dispatcher blocks when the queue is full, a worker blocks when it
+ * is empty until it is closed.
+ */
+struct _SoXBatchJobQueue {
+
+    /** the maximum number of queued jobs */
+    size_t capacity;
+
+    /** the indices of the queued jobs */
+    std::deque<size_t> jobIndexList;
+
+    /** tells whether no more jobs will be added */
+    bool isClosed;
+
+    /** the mutex protecting the queue */
+    std::mutex mutex;
+
+    /** the condition signalled on a change of the queue */
+    std::condition_variable changeCondition;
+
+    /*--------------------*/
+
+    /**
+     * Appends job index <C>jobIndex</C> and waits while the queue
+     * is full.
+     *
+     * @param[in] jobIndex  index of job to be queued
+     */
+    void push (IN size_t jobIndex)
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        changeCondition.wait(lock, [this] () {
+            return jobIndexList.size() < capacity;
+        });
+        jobIndexList.push_back(jobIndex);
+        changeCondition.notify_all();
+    }
+
+    /*--------------------*/
+
+    /**
+     * Removes the next job index into <C>jobIndex</C> and waits
+     * while the queue is empty; tells whether a job has been
+     * found (false when the queue is empty and closed).
+     *
+     * @param[out] jobIndex  index of next job
+     * @return  information whether there is a job
+     */
+    bool pop (OUT size_t& jobIndex)
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        changeCondition.wait(lock, [this] () {
+            return !jobIndexList.empty() || isClosed;
+        });
+        const bool result = !jobIndexList.empty();
+
+        if (result) {
+            jobIndex = jobIndexList.front();
+            jobIndexList.pop_front();
+            changeCondition.notify_all();
+        }
+
+        return result;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Marks the queue as complete and wakes up all waiting
+     * workers.
+     */
+    void close ()
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        isClosed = true;
+        changeCondition.notify_all();
+    }
+
+};
+
+/*--------------------*/
+
+/**
+ * A <C>_SoXBatchContext</C> object holds the data shared by the
+ * workers of a batch run.
+ */
+struct _SoXBatchContext {
+
+    /** the batch renderer with the jobs and settings */
+    const SoXBatchJobList* jobList;
+
+    /** the indices of the jobs rendered together per group (in
+     * manifest order) */
+    GenericList<NaturalList> jobGroupList;
+
+    /** the number of frames per block */
+    Natural blockSize;
+
+    /** tells whether input files are memory mapped */
+    Boolean inputIsMapped;
+
+    /** tells whether progress is reported */
+    Boolean progressIsReported;
+
+    /** the peak level of normalization jobs in decibels */
+    Real normalizationLevel;
+
+    /** the render cache (possibly inactive) */
+    const SoXRenderCache* cache;
+
+    /** the cache key per job (empty when unknown); each entry is
+     * only accessed by the thread processing its job */
+    GenericList<String> cacheKeyList;
+
+    /** the number of worker threads */
+    Natural threadCount;
+
+    /** tells whether workers are pinned to processors */
+    Boolean workersArePinned;
+
+    /** the processor of each worker */
+    NaturalList workerProcessorList;
+
+    /** the processor package (socket) of each worker */
+    NaturalList workerPackageList;
+
+    /** the queue of pending jobs */
+    _SoXBatchJobQueue queue;
+
+    /** the mutex protecting the peak scan data below */
+    std::mutex scanMutex;
+
+    /** the condition signalled on a change of the peak scan data */
+    std::condition_variable scanCondition;
+
+    /** the number of leading jobs (in manifest order) taken over by
+     * the workers */
+    size_t startedJobCount;
+
+    /** the peak scan state per job */
+    GenericList<_SoXPeakScanState> scanStateList;
+
+    /** the measured peak per job (for a known peak) */
+    GenericList<Real> peakList;
+
+    /** the description of a failed peak scan per job */
+    GenericList<String> scanErrorList;
+
+    /** the mutex protecting the result data below */
+    std::mutex resultMutex;
+
+    /** the number of completed jobs */
+    Natural completedCount;
+
+    /** the number of failed jobs */
+    Natural failureCount;
+
+    /** the number of jobs rendered in groups */
+    Natural batchedJobCount;
+
+    /** the number of jobs taken from the render cache */
+    Natural cachedJobCount;
+
+    /** the total duration of rendered audio */
+    Real audioDuration;
+
+    /** the number of workers pinned to their processor */
+    Natural pinnedWorkerCount;
+
+    /** the duration of rendered audio per processor package */
+    GenericList<Real> packageAudioDurationList;
+
+    /** the accumulated error messages */
+    String errorMessage;
+
+    /** the start time of the run */
+    std::chrono::steady_clock::time_point startTime;
+
+};
+
+/*--------------------*/
+/* auxiliary routines */
+/*--------------------*/
+
+/**
+ * Returns the seconds elapsed since <C>startTime</C>.
+ *
+ * @param[in] startTime  start time point
+ * @return  elapsed time in seconds
+ */
+static Real
+_elapsedTime (IN std::chrono::steady_clock::time_point& startTime)
+{
+    const std::chrono::duration<double> duration =
+        std::chrono::steady_clock::now() - startTime;
+    return Real{duration.count()};
+}
+
+/*--------------------*/
+
+/**
+ * Returns <C>value</C> in fixed point notation with
+ * <C>fractionalDigitCount</C> digits after the decimal point.
+ *
+ * @param[in] value                 number to be formatted
+ * @param[in] fractionalDigitCount  number of fractional digits
+ * @return  string representation
+ */
+static String _toFixedString (IN Real value,
+                              IN int fractionalDigitCount)
+{
+    std::ostringstream stream;
+    stream << std::fixed << std::setprecision(fractionalDigitCount)
+           << (double) value;
+    return stream.str();
+}
+
+/*--------------------*/
+
+/**
+ * Returns <C>fileName</C> relative to <C>directoryPath</C> unless it
+ * is absolute.
+ *
+ * @param[in] fileName       absolute or relative file name
+ * @param[in] directoryPath  base directory for relative names
+ * @return  resolved file name
+ */
+static String _resolvedFileName (IN String& fileName,
+                                 IN String& directoryPath)
+{
+    const Boolean isRelative =
+        (directoryPath != "" && FileSystem::path(fileName).is_relative());
+    return (isRelative ? directoryPath + "/" + fileName : fileName);
+}
+
+/*--------------------*/
+
+/**
+ * Tells whether <C>job</C> is a peak normalization.
+ *
+ * @param[in] job  batch job
+ * @return  information whether job normalizes its input
+ */
+static Boolean _isNormalization (IN SoXBatchJob& job)
+{
+    return (job.parameterFileName == "");
+}
+
+/*--------------------*/
+
+/**
+ * Returns the parameter state identifying a normalization to
+ * <C>level</C> decibels in a cache key; the peak is not part of it,
+ * since it follows from the input.
+ *
+ * @param[in] level  target peak level in decibels
+ * @return  binary parameter state of normalization
+ */
+static ByteList _normalizationParameterState (IN Real level)
+{
+    DspStateStream stream{};
+    const double rawLevel = (double) level;
+    stream.writeString("normalization");
+    stream.write(rawLevel);
+    return stream.byteList();
+}
+
+/*--------------------*/
+
+/**
+ * Tells whether the effect defined by the parameter file named
+ * <C>parameterFileName</C> processes its channels independently,
+ * hence several files can be rendered by a single instance.
+ *
+ * @param[in] parameterFileName  name of parameter file
+ * @return  information whether effect can render groups of files
+ */
+static Boolean _hasIndependentChannels (IN String& parameterFileName)
+{
+    SoXOfflineRenderer renderer{};
+    return (renderer.readParameterFile(parameterFileName)
+            && renderer.hasIndependentChannels());
+}
+
+/*--------------------*/
+
+/**
+ * Returns the groups of jobs from <C>jobList</C> rendered together
+ * ordered by their first job: jobs with the same parameter file
+ * whose effect has independent channels are grouped (when
+ * <C>jobsAreBatched</C> is set), all other jobs form a group of
+ * their own.  A group has at most <C>_maximumGroupJobCount</C> jobs
+ * and is only as large as needed to give each of the
+ * <C>threadCount</C> workers a group.
+ *
+ * @param[in] jobList         list of jobs
+ * @param[in] threadCount     number of workers
+ * @param[in] jobsAreBatched  information whether jobs may be grouped
+ * @return  list of job index lists
+ */
+static GenericList<NaturalList>
+_makeJobGroupList (IN SoXBatchJobList& jobList,
+                   IN Natural threadCount,
+                   IN Boolean jobsAreBatched)
+{
+    Logging_trace2(">>: jobCount = %1, threadCount = %2",
+                   TOSTRING(jobList.length()), TOSTRING(threadCount));
+
+    GenericList<NaturalList> result;
+    std::map<String, Boolean> isBatchableMap;
+    std::map<String, NaturalList> batchableJobIndexListMap;
+
+    for (Natural jobIndex = 0;  jobIndex < jobList.length();
+         jobIndex++) {
+        const SoXBatchJob& job = jobList[jobIndex];
+        const String& parameterFileName = job.parameterFileName;
+        Boolean isBatchable = false;
+
+        if (jobsAreBatched && !_isNormalization(job)) {
+            if (isBatchableMap.count(parameterFileName) == 0) {
+                isBatchableMap[parameterFileName] =
+                    _hasIndependentChannels(parameterFileName);
+            }
+
+            isBatchable = isBatchableMap[parameterFileName];
+        }
+
+        if (isBatchable) {
+            batchableJobIndexListMap[parameterFileName].append(jobIndex);
+        } else {
+            result.append(NaturalList{});
+            result[result.size() - 1].append(jobIndex);
+        }
+    }
+
+    for (const auto& entry : batchableJobIndexListMap) {
+        const NaturalList& jobIndexList = entry.second;
+        const Natural jobCount = jobIndexList.size();
+        const Natural groupJobCount =
+            Natural::minimum(_maximumGroupJobCount,
+                             (jobCount + threadCount - 1) / threadCount);
+
+        for (Natural i = 0;  i < jobCount;  i++) {
+            if (i % groupJobCount == 0) {
+                result.append(NaturalList{});
+            }
+
+            result[result.size() - 1].append(jobIndexList[i]);
+        }
+    }
+
+    std::sort(result.begin(), result.end(),
+              [] (IN NaturalList& jobIndexListA,
+                  IN NaturalList& jobIndexListB) {
+                  return jobIndexListA[0] < jobIndexListB[0];
+              });
+
+    Logging_trace1("<<: groupCount = %1", TOSTRING(result.size()));
+    return result;
+}
+
+/*--------------------*/
+
+/**
+ * Sets the processor and the processor package of each of the
+ * <C>threadCount</C> workers in <C>context</C> and returns the
+ * number of packages.  The processors available to the process are
+ * grouped by package and dealt out round-robin over the packages,
+ * hence the workers are spread evenly across the sockets and within
+ * a socket the processors are taken in ascending order (on Linux
+ * the physical cores before their hyperthread siblings); surplus
+ * workers wrap around.
+ *
+ * @param[inout] context      batch context
+ * @param[in]    threadCount  number of workers
+ * @return  number of processor packages
+ */
+static Natural _placeWorkers (INOUT _SoXBatchContext& context,
+                              IN Natural threadCount)
+{
+    Logging_trace1(">>: %1", TOSTRING(threadCount));
+
+    const NaturalList processorList = OperatingSystem::processorList();
+    NaturalList packageIdList;
+    GenericList<NaturalList> packageProcessorListList;
+
+    /* packages are numbered densely in order of appearance */
+    for (const Natural processorIndex : processorList) {
+        const Natural packageId =
+            OperatingSystem::processorPackageIndex(processorIndex);
+        Natural package = packageIdList.size();
+
+        for (Natural j = 0;  j < packageIdList.size();  j++) {
+            package = (packageIdList[j] == packageId ? j : package);
+        }
+
+        if (package == packageIdList.size()) {
+            packageIdList.append(packageId);
+            packageProcessorListList.append(NaturalList{});
+        }
+
+        packageProcessorListList[package].append(processorIndex);
+    }
+
+    const Natural packageCount = packageIdList.size();
+    NaturalList orderedProcessorList;
+    NaturalList orderedPackageList;
+
+    for (Natural round = 0;  round < processorList.size();  round++) {
+        for (Natural package = 0;  package < packageCount;  package++) {
+            const NaturalList& packageProcessorList =
+                packageProcessorListList[package];
+
+            if (round < packageProcessorList.size()) {
+                orderedProcessorList.append(packageProcessorList[round]);
+                orderedPackageList.append(package);
+            }
+        }
+    }
+
+    for (Natural i = 0;  i < threadCount;  i++) {
+        const Natural position = i % orderedProcessorList.size();
+        context.workerProcessorList.append(orderedProcessorList[position]);
+        context.workerPackageList.append(orderedPackageList[position]);
+    }
+
+    Logging_trace2("<<: packageCount = %1, processors = %2",
+                   TOSTRING(packageCount),
+                   context.workerProcessorList.toString());
+    return packageCount;
+}
+
+/*--------------------*/
+
+/**
+ * Measures the peaks of the inputs of all normalization jobs in
+ * <C>context</C> in manifest order, such that a peak is known
+ * before a worker needs it; the scan stays at most one job per
+ * worker ahead of the jobs taken over by the workers.  When the
+ * output of a job is found in the render cache, it is copied
+ * instead and the peak scan is skipped.
+ *
+ * @param[inout] context  batch context
+ */
+static void _scannerLoop (INOUT _SoXBatchContext& context)
+{
+    Logging_trace(">>");
+
+    SoXOfflineRenderer renderer{};
+    renderer.setInputIsMapped(context.inputIsMapped);
+    const SoXBatchJobList& jobList = *context.jobList;
+    const SoXRenderCache& cache = *context.cache;
+    const ByteList parameterState =
+        _normalizationParameterState(context.normalizationLevel);
+    const size_t lookaheadCount = (size_t) context.threadCount;
+
+    for (size_t jobIndex = 0;  jobIndex < (size_t) jobList.length();
+         jobIndex++) {
+        const SoXBatchJob& job = jobList[jobIndex];
+
+        if (_isNormalization(job)) {
+            {
+                std::unique_lock<std::mutex> lock{context.scanMutex};
+                context.scanCondition.wait(lock, [&] () {
+                    return (jobIndex
+                            < context.startedJobCount + lookaheadCount);
+                });
+            }
+
+            String key;
+            const Boolean isCached =
+                (cache.isActive()
+                 && cache.makeKey(job.inputFileName, parameterState,
+                                  context.blockSize, job.outputFileName,
+                                  key)
+                 && cache.fetch(key, job.outputFileName));
+            Real peak = 0.0;
+            const Boolean isOkay =
+                (isCached
+                 || renderer.measurePeak(job.inputFileName, peak));
+
+            std::lock_guard<std::mutex> lock{context.scanMutex};
+            context.cacheKeyList[jobIndex] = key;
+            context.peakList[jobIndex] = peak;
+            context.scanErrorList[jobIndex] =
+                (isOkay ? "" : renderer.errorMessage());
+            context.scanStateList[jobIndex] =
+                (isCached ? _SoXPeakScanState::cached
+                 : isOkay ? _SoXPeakScanState::known
+                 : _SoXPeakScanState::failed);
+            context.scanCondition.notify_all();
+        }
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+/**
+ * Renders the normalization job <C>job</C> at <C>jobIndex</C> by
+ * <C>renderer</C> with the peak measured by the scanner in
+ * <C>context</C> (waiting for it if necessary) and tells whether
+ * this has been successful; tells in <C>isCached</C> whether the
+ * scanner has taken the output from the render cache instead (and
+ * otherwise stores it there) and returns the description of a
+ * failure in <C>errorMessage</C>.
+ *
+ * @param[inout] context       batch context
+ * @param[inout] renderer      offline renderer of worker
+ * @param[in]    job           normalization job
+ * @param[in]    jobIndex      index of job
+ * @param[out]   isCached      information whether output has been
+ *                             taken from the cache
+ * @param[out]   errorMessage  description of failure
+ * @return  information whether rendering has been successful
+ */
+static Boolean _renderNormalization (INOUT _SoXBatchContext& context,
+                                     INOUT SoXOfflineRenderer& renderer,
+                                     IN SoXBatchJob& job,
+                                     IN size_t jobIndex,
+                                     OUT Boolean& isCached,
+                                     OUT String& errorMessage)
+{
+    Logging_trace1(">>: %1", job.inputFileName);
+
+    Real peak = 0.0;
+    String key;
+    Boolean isOkay;
+
+    {
+        std::unique_lock<std::mutex> lock{context.scanMutex};
+        context.scanCondition.wait(lock, [&] () {
+            return (context.scanStateList[jobIndex]
+                    != _SoXPeakScanState::pending);
+        });
+        const _SoXPeakScanState state = context.scanStateList[jobIndex];
+        isCached = (state == _SoXPeakScanState::cached);
+        isOkay = (isCached || state == _SoXPeakScanState::known);
+        peak = context.peakList[jobIndex];
+        key = context.cacheKeyList[jobIndex];
+        errorMessage = context.scanErrorList[jobIndex];
+    }
+
+    if (isOkay && !isCached) {
+        isOkay =
+            (renderer.setNormalizingGain(peak, context.normalizationLevel)
+             && renderer.render(job.inputFileName, job.outputFileName,
+                                context.blockSize));
+        errorMessage = (isOkay ? "" : renderer.errorMessage());
+
+        if (isOkay && key != "") {
+            context.cache->store(key, job.outputFileName);
+        }
+    }
+
+    Logging_trace2("<<: isOkay = %1, isCached = %2",
+                   TOSTRING(isOkay), TOSTRING(isCached));
+    return isOkay;
+}
+
+/*--------------------*/
+
+/**
+ * Records the completion of <C>job</C> with success <C>isOkay</C>
+ * and failure description <C>errorMessage</C> in <C>context</C> and
+ * reports the progress (when requested); <C>isCached</C> tells
+ * whether the output has been taken from the render cache.  Must be
+ * called with the result mutex held.
+ *
+ * @param[inout] context       batch context
+ * @param[in]    job           completed job
+ * @param[in]    isOkay        information whether job was successful
+ * @param[in]    isCached      information whether output has been
+ *                             taken from the cache
+ * @param[in]    errorMessage  description of failure
+ */
+static void _recordCompletion (INOUT _SoXBatchContext& context,
+                               IN SoXBatchJob& job,
+                               IN Boolean isOkay,
+                               IN Boolean isCached,
+                               IN String& errorMessage)
+{
+    context.completedCount++;
+    context.cachedJobCount += (isCached ? 1 : 0);
+
+    if (!isOkay) {
+        context.failureCount++;
+        context.errorMessage +=
+            STR::expand("%1: %2\n", job.inputFileName, errorMessage);
+    }
+
+    if (context.progressIsReported) {
+        const Real elapsedTime = _elapsedTime(context.startTime);
+        const Real speed =
+            (elapsedTime > 0.0 ? context.audioDuration / elapsedTime
+             : Real{0.0});
+        OperatingSystem::writeMessageToConsole(
+            STR::expand("[%1/%2] %3 %4 (total %5x realtime)",
+                        TOSTRING(context.completedCount),
+                        TOSTRING(context.jobList->length()),
+                        job.outputFileName,
+                        (isCached ? "cached"
+                         : isOkay ? "done" : "FAILED"),
+                        _toFixedString(speed, 1)));
+    }
+}
+
+/*--------------------*/
+
+/**
+ * Renders the single job at <C>jobIndex</C> in <C>context</C> by
+ * <C>renderer</C> of a worker on processor package
+ * <C>package</C> and records its result; a successful output is
+ * stored in the render cache under the key of the job (if any).
+ *
+ * @param[inout] context   batch context
+ * @param[inout] renderer  offline renderer of worker
+ * @param[in]    jobIndex  index of job
+ * @param[in]    package   processor package of worker
+ */
+static void _renderJob (INOUT _SoXBatchContext& context,
+                        INOUT SoXOfflineRenderer& renderer,
+                        IN size_t jobIndex,
+                        IN Natural package)
+{
+    const SoXBatchJob& job = (*context.jobList)[jobIndex];
+    Logging_trace1(">>: %1", job.inputFileName);
+
+    String errorMessage;
+    Boolean isCached = false;
+    Boolean isOkay;
+
+    if (_isNormalization(job)) {
+        isOkay = _renderNormalization(context, renderer, job,
+                                      jobIndex, isCached, errorMessage);
+    } else {
+        /* reading the parameters makes a new effect, so no state
+           is carried over from the previous file */
+        const String& key = context.cacheKeyList[jobIndex];
+        isOkay =
+            (renderer.readParameterFile(job.parameterFileName)
+             && renderer.render(job.inputFileName,
+                                job.outputFileName,
+                                context.blockSize));
+        errorMessage = (isOkay ? "" : renderer.errorMessage());
+
+        if (isOkay && key != "") {
+            context.cache->store(key, job.outputFileName);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock{context.resultMutex};
+
+    if (isOkay && !isCached) {
+        const Real duration = renderer.renderedDuration();
+        context.audioDuration += duration;
+        context.packageAudioDurationList[package] += duration;
+    }
+
+    _recordCompletion(context, job, isOkay, isCached, errorMessage);
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+}
+
+/*--------------------*/
+
+/**
+ * Renders the jobs with indices <C>jobIndexList</C> in
+ * <C>context</C> (sharing their parameter file) together by a single
+ * effect instance of <C>renderer</C> of a worker on processor
+ * package <C>package</C> and records their results; tells whether
+ * this has been successful, otherwise nothing is recorded.  The
+ * outputs are stored in the render cache under the keys of their
+ * jobs (if any).
+ *
+ * @param[inout] context       batch context
+ * @param[inout] renderer      offline renderer of worker
+ * @param[in]    jobIndexList  indices of jobs in group
+ * @param[in]    package       processor package of worker
+ * @return  information whether the group has been rendered
+ */
+static Boolean _renderJobGroup (INOUT _SoXBatchContext& context,
+                                INOUT SoXOfflineRenderer& renderer,
+                                IN NaturalList& jobIndexList,
+                                IN Natural package)
+{
+    Logging_trace1(">>: %1", jobIndexList.toString());
+
+    const SoXBatchJobList& jobList = *context.jobList;
+    StringList inputFileNameList;
+    StringList outputFileNameList;
+
+    for (const Natural jobIndex : jobIndexList) {
+        inputFileNameList.append(jobList[jobIndex].inputFileName);
+        outputFileNameList.append(jobList[jobIndex].outputFileName);
+    }
+
+    const Boolean isOkay =
+        (renderer.readParameterFile(
+             jobList[jobIndexList[0]].parameterFileName)
+         && renderer.renderBatch(inputFileNameList, outputFileNameList,
+                                 context.blockSize));
+
+    if (isOkay) {
+        for (const Natural jobIndex : jobIndexList) {
+            const String& key = context.cacheKeyList[jobIndex];
+
+            if (key != "") {
+                context.cache->store(key,
+                                     jobList[jobIndex].outputFileName);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock{context.resultMutex};
+        const Real duration = renderer.renderedDuration();
+        context.audioDuration += duration;
+        context.packageAudioDurationList[package] += duration;
+        context.batchedJobCount += jobIndexList.size();
+
+        for (const Natural jobIndex : jobIndexList) {
+            _recordCompletion(context, jobList[jobIndex], true, false,
+                              "");
+        }
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+
+/**
+ * Copies the outputs of the jobs with indices <C>jobIndexList</C>
+ * in <C>context</C> from the render cache where possible and
+ * records them as completed; returns the indices of the remaining
+ * jobs to be rendered.  The key of each job is calculated from the
+ * parameter state of its effect made by <C>renderer</C> and kept
+ * in the context for storing the rendered output; normalization
+ * jobs are looked up by the scanner instead.
+ *
+ * @param[inout] context       batch context
+ * @param[inout] renderer      offline renderer of worker
+ * @param[in]    jobIndexList  indices of jobs in group
+ * @return  indices of jobs not found in cache
+ */
+static NaturalList _takeCachedJobs (INOUT _SoXBatchContext& context,
+                                    INOUT SoXOfflineRenderer& renderer,
+                                    IN NaturalList& jobIndexList)
+{
+    Logging_trace1(">>: %1", jobIndexList.toString());
+
+    const SoXBatchJobList& jobList = *context.jobList;
+    const SoXRenderCache& cache = *context.cache;
+    NaturalList result;
+
+    for (const Natural jobIndex : jobIndexList) {
+        const SoXBatchJob& job = jobList[jobIndex];
+        const Boolean isCached =
+            (cache.isActive() && !_isNormalization(job)
+             && renderer.readParameterFile(job.parameterFileName)
+             && cache.makeKey(job.inputFileName,
+                              renderer.parameterState(),
+                              context.blockSize, job.outputFileName,
+                              context.cacheKeyList[jobIndex])
+             && cache.fetch(context.cacheKeyList[jobIndex],
+                            job.outputFileName));
+
+        if (isCached) {
+            std::lock_guard<std::mutex> lock{context.resultMutex};
+            _recordCompletion(context, job, true, true, "");
+        } else {
+            result.append(jobIndex);
+        }
+    }
+
+    Logging_trace1("<<: %1", result.toString());
+    return result;
+}
+
+/*--------------------*/
+
+/**
+ * Processes the job groups from the queue in <C>context</C> as
+ * worker <C>workerIndex</C> with a separate offline renderer until
+ * the queue is exhausted; jobs found in the render cache are
+ * dropped from their group and a group that cannot be rendered
+ * together is rendered job by job.
+ *
+ * @param[inout] context      batch context
+ * @param[in]    workerIndex  index of worker
+ */
+static void _workerLoop (INOUT _SoXBatchContext& context,
+                         IN size_t workerIndex)
+{
+    Logging_trace1(">>: %1", TOSTRING(workerIndex));
+
+    const Natural package = context.workerPackageList[workerIndex];
+
+    if (context.workersArePinned) {
+        const Boolean isPinned =
+            OperatingSystem::pinThreadToProcessor(
+                context.workerProcessorList[workerIndex]);
+        std::lock_guard<std::mutex> lock{context.resultMutex};
+        context.pinnedWorkerCount += (isPinned ? 1 : 0);
+    }
+
+    /* the renderer and each effect instance are made after pinning,
+       hence their memory is first touched on the node of the
+       worker */
+    SoXOfflineRenderer renderer{};
+    renderer.setInputIsMapped(context.inputIsMapped);
+    size_t groupIndex = 0;
+
+    while (context.queue.pop(groupIndex)) {
+        const NaturalList& jobIndexList =
+            context.jobGroupList[groupIndex];
+
+        {
+            /* the scanner may now proceed further */
+            std::lock_guard<std::mutex> lock{context.scanMutex};
+            context.startedJobCount =
+                std::max(context.startedJobCount,
+                         (size_t) jobIndexList.last() + 1);
+            context.scanCondition.notify_all();
+        }
+
+        const NaturalList pendingJobIndexList =
+            _takeCachedJobs(context, renderer, jobIndexList);
+        const Boolean isRendered =
+            (pendingJobIndexList.size() > 1
+             && _renderJobGroup(context, renderer, pendingJobIndexList,
+                                package));
+
+        if (!isRendered) {
+            for (const Natural jobIndex : pendingJobIndexList) {
+                _renderJob(context, renderer, (size_t) jobIndex,
+                           package);
+            }
+        }
+    }
+
+    Logging_trace("<<");
+}
+
+/*====================*/
+
+String SoXBatchStatistics::toString () const
+{
+    const Real speed =
+        (elapsedTime > 0.0 ? audioDuration / elapsedTime : Real{0.0});
+    String result =
+        STR::expand("jobs = %1, failures = %2, batched = %3,"
+                    " cached = %4, audio = %5s, elapsed = %6s,"
+                    " throughput = %7x realtime, pinned = %8",
+                    TOSTRING(jobCount), TOSTRING(failureCount),
+                    TOSTRING(batchedJobCount), TOSTRING(cachedJobCount),
+                    _toFixedString(audioDuration, 1),
+                    _toFixedString(elapsedTime, 2),
+                    _toFixedString(speed, 1),
+                    TOSTRING(pinnedWorkerCount));
+
+    for (Natural package = 0;  package < packageWorkerCountList.size();
+         package++) {
+        const Natural workerCount = packageWorkerCountList[package];
+        const Real packageSpeed =
+            (elapsedTime > 0.0
+             ? packageAudioDurationList[package] / elapsedTime
+             : Real{0.0});
+        const Real workerSpeed =
+            (workerCount > 0 ? packageSpeed / Real{(double) workerCount}
+             : Real{0.0});
+        result +=
+            STR::expand("; socket %1: workers = %2,"
+                        " throughput = %3x realtime (%4x per worker)",
+                        TOSTRING(package), TOSTRING(workerCount),
+                        _toFixedString(packageSpeed, 1),
+                        _toFixedString(workerSpeed, 1));
+    }
+
+    return result;
+}
+
+/*====================*/
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+SoXBatchRenderer::SoXBatchRenderer ()
+    : _jobList{},
+      _threadCount{0},
+      _blockSize{SoXOfflineRenderer::defaultBlockSize},
+      _inputIsMapped{true},
+      _progressIsReported{false},
+      _workersArePinned{true},
+      _jobsAreBatched{true},
+      _normalizationLevel{0.0},
+      _cache{},
+      _statistics{0, 0, 0, 0, 0.0, 0.0, 0, NaturalList{},
+                  GenericList<Real>{}},
+      _errorMessage{""}
+{
+    Logging_trace(">>");
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* configuration      */
+/*--------------------*/
+
+Boolean SoXBatchRenderer::readManifest (IN String& fileName)
+{
+    Logging_trace1(">>: %1", fileName);
+    const Boolean isOkay = readJobList(fileName, _jobList, _errorMessage);
+    Logging_trace2("<<: isOkay = %1, jobCount = %2",
+                   TOSTRING(isOkay), TOSTRING(_jobList.length()));
+    return isOkay;
+}
+
+/*--------------------*/
+
+Boolean SoXBatchRenderer::readJobList (IN String& fileName,
+                                       INOUT SoXBatchJobList& jobList,
+                                       OUT String& errorMessage)
+{
+    Logging_trace1(">>: %1", fileName);
+
+    File file;
+    Boolean isOkay = file.open(fileName, "rb");
+
+    if (!isOkay) {
+        errorMessage = STR::expand("cannot open manifest %1", fileName);
+    } else {
+        const String directoryPath = OperatingSystem::dirname(fileName);
+        const StringList lineList = file.readLines();
+        file.close();
+
+        for (Natural i = 0;  isOkay && i < lineList.size();  i++) {
+            const String line = STR::strip(lineList[i]);
+            const StringList partList =
+                StringList::makeBySplit(line, "\t");
+
+            if (line == "" || STR::startsWith(line, "#")) {
+                /* empty and comment lines are ignored */
+            } else if (partList.size() < 2 || partList.size() > 3) {
+                isOkay = false;
+                errorMessage =
+                    STR::expand("%1, line %2: expected (optional)"
+                                " parameter file, input and output"
+                                " separated by tabs",
+                                fileName, TOSTRING(i + 1));
+            } else {
+                /* a job without parameter file is a normalization */
+                const Natural offset = partList.size() - 2;
+                SoXBatchJob job;
+                job.parameterFileName =
+                    (offset == 0 ? ""
+                     : _resolvedFileName(STR::strip(partList[0]),
+                                         directoryPath));
+                job.inputFileName =
+                    _resolvedFileName(STR::strip(partList[offset]),
+                                      directoryPath);
+                job.outputFileName =
+                    _resolvedFileName(STR::strip(partList[offset + 1]),
+                                      directoryPath);
+                jobList.append(job);
+            }
+        }
+    }
+
+    Logging_trace2("<<: isOkay = %1, jobCount = %2",
+                   TOSTRING(isOkay), TOSTRING(jobList.length()));
+    return isOkay;
+}
+
+/*--------------------*/
+
+void SoXBatchRenderer::addJob (IN SoXBatchJob& job)
+{
+    Logging_trace2(">>: input = %1, output = %2",
+                   job.inputFileName, job.outputFileName);
+    _jobList.append(job);
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXBatchRenderer::setThreadCount (IN Natural threadCount)
+{
+    Logging_trace1(">>: %1", TOSTRING(threadCount));
+    _threadCount = threadCount;
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXBatchRenderer::setBlockSize (IN Natural blockSize)
+{
+    Logging_trace1(">>: %1", TOSTRING(blockSize));
+    _blockSize = blockSize;
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXBatchRenderer::setInputIsMapped (IN Boolean isMapped)
+{
+    Logging_trace1(">>: %1", TOSTRING(isMapped));
+    _inputIsMapped = isMapped;
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXBatchRenderer::setProgressIsReported (IN Boolean isReported)
+{
+    Logging_trace1(">>: %1", TOSTRING(isReported));
+    _progressIsReported = isReported;
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXBatchRenderer::setWorkersArePinned (IN Boolean arePinned)
+{
+    Logging_trace1(">>: %1", TOSTRING(arePinned));
+    _workersArePinned = arePinned;
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXBatchRenderer::setJobsAreBatched (IN Boolean areBatched)
+{
+    Logging_trace1(">>: %1", TOSTRING(areBatched));
+    _jobsAreBatched = areBatched;
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXBatchRenderer::setNormalizationLevel (IN Real level)
+{
+    Logging_trace1(">>: %1", TOSTRING(level));
+    _normalizationLevel = level;
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+Boolean SoXBatchRenderer::setCacheDirectory (IN String& directoryName)
+{
+    Logging_trace1(">>: %1", directoryName);
+    const Boolean isOkay = _cache.setDirectory(directoryName);
+    _errorMessage =
+        (isOkay ? ""
+         : STR::expand("cannot use cache directory %1", directoryName));
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+
+void SoXBatchRenderer::setCacheEvictionPolicy
+                           (IN SoXRenderCacheEvictionPolicy& policy)
+{
+    Logging_trace(">>");
+    _cache.setEvictionPolicy(policy);
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* processing         */
+/*--------------------*/
+
+Boolean SoXBatchRenderer::run ()
+{
+    Logging_trace1(">>: jobCount = %1", TOSTRING(_jobList.length()));
+
+    const Natural hardwareThreadCount =
+        Natural::maximum(1, (size_t) std::thread::hardware_concurrency());
+    const Natural threadCount =
+        Natural::maximum(1,
+                         Natural::minimum(_threadCount == 0
+                                          ? hardwareThreadCount
+                                          : _threadCount,
+                                          _jobList.length()));
+
+    _SoXBatchContext context{};
+    context.jobList            = &_jobList;
+    context.jobGroupList       =
+        _makeJobGroupList(_jobList, threadCount, _jobsAreBatched);
+    context.blockSize          = _blockSize;
+    context.inputIsMapped      = _inputIsMapped;
+    context.progressIsReported = _progressIsReported;
+    context.normalizationLevel = _normalizationLevel;
+    context.cache              = &_cache;
+    context.threadCount        = threadCount;
+    context.workersArePinned   = _workersArePinned;
+    context.queue.capacity     =
+        (size_t) (threadCount * _queueLengthPerThread);
+    context.queue.isClosed     = false;
+    context.startedJobCount    = 0;
+    context.scanStateList.setLength(_jobList.length());
+    context.peakList.setLength(_jobList.length());
+    context.scanErrorList.setLength(_jobList.length());
+    context.cacheKeyList.setLength(_jobList.length());
+    context.completedCount     = 0;
+    context.failureCount       = 0;
+    context.batchedJobCount    = 0;
+    context.cachedJobCount     = 0;
+    context.audioDuration      = 0.0;
+    context.pinnedWorkerCount  = 0;
+    context.errorMessage       = "";
+    context.startTime          = std::chrono::steady_clock::now();
+
+    const Natural packageCount = _placeWorkers(context, threadCount);
+    context.packageAudioDurationList.setLength(packageCount, 0.0);
+
+    GenericList<std::thread> threadList;
+    Boolean hasNormalization = false;
+
+    for (const SoXBatchJob& job : _jobList) {
+        hasNormalization = (hasNormalization || _isNormalization(job));
+    }
+
+    for (_SoXPeakScanState& state : context.scanStateList) {
+        state = _SoXPeakScanState::pending;
+    }
+
+    /* the peak scans only read the inputs, hence a single scanner
+       thread runs besides the workers */
+    if (hasNormalization) {
+        threadList.push_back(std::thread{_scannerLoop,
+                                         std::ref(context)});
+    }
+
+    for (Natural i = 0;  i < threadCount;  i++) {
+        threadList.push_back(std::thread{_workerLoop,
+                                         std::ref(context), (size_t) i});
+    }
+
+    /* dispatch the job groups in manifest order of their first
+       jobs */
+    for (size_t groupIndex = 0;
+         groupIndex < (size_t) context.jobGroupList.length();
+         groupIndex++) {
+        context.queue.push(groupIndex);
+    }
+
+    context.queue.close();
+
+    for (std::thread& thread : threadList) {
+        thread.join();
+    }
+
+    _statistics.jobCount          = context.completedCount;
+    _statistics.failureCount      = context.failureCount;
+    _statistics.batchedJobCount   = context.batchedJobCount;
+    _statistics.cachedJobCount    = context.cachedJobCount;
+    _statistics.audioDuration     = context.audioDuration;
+    _statistics.elapsedTime       = _elapsedTime(context.startTime);
+    _statistics.pinnedWorkerCount = context.pinnedWorkerCount;
+    _statistics.packageAudioDurationList =
+        context.packageAudioDurationList;
+    _statistics.packageWorkerCountList.clear();
+    _statistics.packageWorkerCountList.setLength(packageCount, 0);
+
+    for (const Natural package : context.workerPackageList) {
+        _statistics.packageWorkerCountList[package]++;
+    }
+    _errorMessage             = context.errorMessage;
+    const Boolean isOkay = (context.failureCount == 0);
+
+    /* the outputs of this run are the most recently used entries,
+       hence they survive the eviction unless the cache is too
+       small */
+    _cache.evict();
+
+    Logging_trace2("<<: isOkay = %1, statistics = %2",
+                   TOSTRING(isOkay), _statistics.toString());
+    return isOkay;
+}
+
+/*--------------------*/
+/* queries            */
+/*--------------------*/
+
+SoXBatchStatistics SoXBatchRenderer::statistics () const
+{
+    return _statistics;
+}
+
+/*--------------------*/
+
+String SoXBatchRenderer::errorMessage () const
+{
+    return _errorMessage;
+}
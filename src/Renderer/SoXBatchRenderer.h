@@ -0,0 +1,394 @@
+/**
+ * @file
+ * The <C>SoXBatchRenderer</C> specification defines a renderer
+ * processing a manifest of audio files concurrently on several
+ * worker threads, each with its own effect instances.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "GenericList.h"
+#include "MyString.h"
+#include "Natural.h"
+#include "NaturalList.h"
+#include "Real.h"
+#include "SoXRenderCache.h"
+
+/*--------------------*/
+
+using BaseTypes::Containers::NaturalList;
+using BaseTypes::GenericTypes::GenericList;
+using BaseTypes::Primitives::Boolean;
+using BaseTypes::Primitives::Natural;
+using BaseTypes::Primitives::Real;
+using BaseTypes::Primitives::String;
+
+/*====================*/
+
+namespace SoXPlugins::Renderer {
+
+    /**
+     * A <C>SoXBatchJob</C> object describes the rendering of a
+     * single file of a batch.
+     */
+    struct SoXBatchJob {
+
+        /** the name of the parameter file defining the effect; empty
+         * for a peak normalization to the level of the batch */
+        String parameterFileName;
+
+        /** the name of the input audio file */
+        String inputFileName;
+
+        /** the name of the output audio file */
+        String outputFileName;
+
+    };
+
+    /*--------------------*/
+
+    /** a list of batch jobs */
+    using SoXBatchJobList = GenericList<SoXBatchJob>;
+
+    /*====================*/
+
+    /**
+     * A <C>SoXBatchStatistics</C> object summarizes a batch run.
+     */
+    struct SoXBatchStatistics {
+
+        /** the number of jobs processed */
+        Natural jobCount;
+
+        /** the number of failed jobs */
+        Natural failureCount;
+
+        /** the number of jobs rendered together with others by a
+         * single effect instance */
+        Natural batchedJobCount;
+
+        /** the number of jobs taken from the render cache */
+        Natural cachedJobCount;
+
+        /** the total duration of the rendered audio in seconds */
+        Real audioDuration;
+
+        /** the wall clock time of the run in seconds */
+        Real elapsedTime;
+
+        /** the number of workers pinned to a processor */
+        Natural pinnedWorkerCount;
+
+        /** the number of workers per processor package (socket) */
+        NaturalList packageWorkerCountList;
+
+        /** the duration of the audio rendered by the workers of
+         * each processor package in seconds */
+        GenericList<Real> packageAudioDurationList;
+
+        /*--------------------*/
+
+        /**
+         * Returns string representation of statistics with the
+         * throughput as a multiple of real time overall and per
+         * processor package.
+         *
+         * @return string representation
+         */
+        String toString () const;
+
+    };
+
+    /*====================*/
+
+    /**
+     * A <C>SoXBatchRenderer</C> object renders all jobs of a manifest
+     * on a set of worker threads.  Each worker owns a separate
+     * offline renderer and makes a fresh effect instance for every
+     * file, hence each output is identical to a serial render.  Jobs
+     * are handed to the workers via a bounded queue, so that only a
+     * few jobs are in flight at any time; progress and throughput
+     * are reported on the console after each file.
+     *
+     * By default each worker is pinned to a processor of its own
+     * and the workers are spread evenly across the processor
+     * packages (sockets): worker <I>i</I> goes to package <I>i</I>
+     * modulo the package count.  A worker makes its renderer and
+     * all effect instances and buffers after being pinned, hence
+     * this state is first touched and thus allocated on the memory
+     * node of its socket and never migrates; the throughput is
+     * reported per package.
+     *
+     * A manifest is a text file with one job per line consisting of
+     * the parameter file, the input file and the output file
+     * separated by tabulators; empty lines and lines starting with
+     * "#" are ignored.  Relative file names in the manifest are
+     * taken relative to the directory of the manifest.
+     *
+     * A line with only the input and the output file is a peak
+     * normalization to the normalization level of the batch (like
+     * "gain -n" of SoX), which needs two passes over the input: a
+     * separate scanner thread measures the peaks of these files in
+     * manifest order ahead of the workers, so that the peak scan of
+     * a file overlaps the gain pass of its predecessors.
+     *
+     * Jobs with the same parameter file whose effect processes its
+     * channels independently (like the filter or the gain) are
+     * rendered in groups of up to 16 files by a single effect
+     * instance on one worker: the channels of all files of a group
+     * form one buffer, such that the multichannel kernels process
+     * several files in their lanes; a group is only as large as
+     * needed to keep all workers busy.  The outputs are identical
+     * to separate renderings; when a group fails (for example for
+     * different sample rates), its files are rendered separately.
+     *
+     * When a cache directory is set, each output is looked up in a
+     * content-addressed render cache before rendering (see
+     * <C>SoXRenderCache</C>): the key covers the input samples, the
+     * effect with its parameters, the block size, the output kind
+     * and the engine version, hence a hit is identical to a fresh
+     * rendering.  Jobs found are copied from the cache (and removed
+     * from their group), all others are rendered and stored; after
+     * the run the cache is trimmed to its eviction policy.  For a
+     * normalization the key uses the target level instead of the
+     * peak, hence a hit also skips the peak scan.
+     */
+    struct SoXBatchRenderer {
+
+        /*--------------------*/
+        /* con-/destruction   */
+        /*--------------------*/
+
+        /**
+         * Makes a batch renderer without jobs.
+         */
+        SoXBatchRenderer ();
+
+        /*--------------------*/
+
+        SoXBatchRenderer (IN SoXBatchRenderer&) = delete;
+
+        /*--------------------*/
+        /* configuration      */
+        /*--------------------*/
+
+        /**
+         * Reads the jobs from the manifest file named
+         * <C>fileName</C> and tells whether this has been
+         * successful.
+         *
+         * @param[in] fileName  name of manifest file
+         * @return  information whether manifest is okay
+         */
+        Boolean readManifest (IN String& fileName);
+
+        /*--------------------*/
+
+        /**
+         * Appends the jobs from the manifest file named
+         * <C>fileName</C> to <C>jobList</C> and tells whether this
+         * has been successful; returns the description of a failure
+         * in <C>errorMessage</C>.
+         *
+         * @param[in]    fileName      name of manifest file
+         * @param[inout] jobList       list of jobs to be extended
+         * @param[out]   errorMessage  description of failure
+         * @return  information whether manifest is okay
+         */
+        static Boolean readJobList (IN String& fileName,
+                                    INOUT SoXBatchJobList& jobList,
+                                    OUT String& errorMessage);
+
+        /*--------------------*/
+
+        /**
+         * Appends <C>job</C> to the jobs of the batch.
+         *
+         * @param[in] job  job to be added
+         */
+        void addJob (IN SoXBatchJob& job);
+
+        /*--------------------*/
+
+        /**
+         * Sets the number of worker threads to <C>threadCount</C>;
+         * zero selects the number of hardware threads.
+         *
+         * @param[in] threadCount  number of worker threads
+         */
+        void setThreadCount (IN Natural threadCount);
+
+        /*--------------------*/
+
+        /**
+         * Sets the number of frames per processing block to
+         * <C>blockSize</C>.
+         *
+         * @param[in] blockSize  number of frames per block
+         */
+        void setBlockSize (IN Natural blockSize);
+
+        /*--------------------*/
+
+        /**
+         * Defines whether input files are memory mapped depending on
+         * <C>isMapped</C>.
+         *
+         * @param[in] isMapped  information whether input files are
+         *                      memory mapped
+         */
+        void setInputIsMapped (IN Boolean isMapped);
+
+        /*--------------------*/
+
+        /**
+         * Defines whether progress is reported on the console after
+         * each file depending on <C>isReported</C>.
+         *
+         * @param[in] isReported  information whether progress is
+         *                        reported
+         */
+        void setProgressIsReported (IN Boolean isReported);
+
+        /*--------------------*/
+
+        /**
+         * Defines whether each worker is pinned to a processor
+         * depending on <C>arePinned</C> (where the operating system
+         * supports it).
+         *
+         * @param[in] arePinned  information whether workers are
+         *                       pinned to processors
+         */
+        void setWorkersArePinned (IN Boolean arePinned);
+
+        /*--------------------*/
+
+        /**
+         * Defines whether jobs with the same parameter file are
+         * rendered together by a single effect instance (where the
+         * effect allows it) depending on <C>areBatched</C> (default
+         * true).
+         *
+         * @param[in] areBatched  information whether jobs are
+         *                        rendered in groups
+         */
+        void setJobsAreBatched (IN Boolean areBatched);
+
+        /*--------------------*/
+
+        /**
+         * Sets the peak level of normalization jobs to
+         * <C>level</C> decibels full scale (default 0dB).
+         *
+         * @param[in] level  target peak level in decibels
+         */
+        void setNormalizationLevel (IN Real level);
+
+        /*--------------------*/
+
+        /**
+         * Sets the directory of the render cache to
+         * <C>directoryName</C> (created when missing) and tells
+         * whether it is usable; an empty name disables the cache
+         * (the default).
+         *
+         * @param[in] directoryName  name of cache directory
+         * @return  information whether cache directory is usable
+         */
+        Boolean setCacheDirectory (IN String& directoryName);
+
+        /*--------------------*/
+
+        /**
+         * Sets the limits of the render cache applied after each run
+         * to <C>policy</C> (default: no limits).
+         *
+         * @param[in] policy  eviction policy of cache
+         */
+        void setCacheEvictionPolicy
+                 (IN SoXRenderCacheEvictionPolicy& policy);
+
+        /*--------------------*/
+        /* processing         */
+        /*--------------------*/
+
+        /**
+         * Renders all jobs and tells whether all of them have been
+         * successful.
+         *
+         * @return  information whether no job failed
+         */
+        Boolean run ();
+
+        /*--------------------*/
+        /* queries            */
+        /*--------------------*/
+
+        /**
+         * Returns the statistics of the last run.
+         *
+         * @return  batch statistics
+         */
+        SoXBatchStatistics statistics () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the description of the last failures (one line
+         * per failure).
+         *
+         * @return  error message (empty when there was no failure)
+         */
+        String errorMessage () const;
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the jobs of the batch */
+            SoXBatchJobList _jobList;
+
+            /** the number of worker threads (zero for automatic) */
+            Natural _threadCount;
+
+            /** the number of frames per block */
+            Natural _blockSize;
+
+            /** tells whether input files are memory mapped */
+            Boolean _inputIsMapped;
+
+            /** tells whether progress is reported */
+            Boolean _progressIsReported;
+
+            /** tells whether workers are pinned to processors */
+            Boolean _workersArePinned;
+
+            /** tells whether jobs are rendered in groups */
+            Boolean _jobsAreBatched;
+
+            /** the peak level of normalization jobs in decibels */
+            Real _normalizationLevel;
+
+            /** the cache of rendered outputs */
+            SoXRenderCache _cache;
+
+            /** the statistics of the last run */
+            SoXBatchStatistics _statistics;
+
+            /** the description of the last failures */
+            String _errorMessage;
+
+    };
+
+}
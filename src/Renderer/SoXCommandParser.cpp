@@ -0,0 +1,962 @@
+/**
+ * @file
+ * The <C>SoXCommandParser</C> body implements the translation of an
+ * effect chain in the command-line syntax of SoX into the parameter
+ * text of the offline renderer.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXCommandParser.h"
+
+#include "GenericList.h"
+#include "Integer.h"
+#include "Logging.h"
+#include "Real.h"
+#include "SoXEffectParameterMap.h"
+
+/*--------------------*/
+
+using BaseTypes::GenericTypes::GenericList;
+using BaseTypes::Primitives::Integer;
+using BaseTypes::Primitives::Natural;
+using BaseTypes::Primitives::Real;
+using SoXPlugins::Helpers::SoXEffectParameterMap;
+using SoXPlugins::Renderer::SoXCommandParser;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
+
+/*====================*/
+
+/** the maximum gain in decibels of the compander (the range of its
+ * gain parameter); a larger gain goes to a separate gain stage */
+static const Real _maximumCompanderGain = 20.0;
+
+/** the maximum lookahead of the compander in milliseconds (the
+ * range of its lookahead parameter) */
+static const Real _maximumCompanderLookahead = 10.0;
+
+/** the maximum ratio of the compander (the range of its ratio
+ * parameter) */
+static const Real _maximumCompanderRatio = 1000.0;
+
+/** the minimum threshold of the compander in decibels (the range of
+ * its threshold parameter) */
+static const Real _minimumCompanderThreshold = -128.0;
+
+/** the quality of a two-pole high- or low-pass without width (a
+ * Butterworth response like in SoX) */
+static const String _defaultPassFilterQuality = "0.7071";
+
+/*--------------------*/
+
+/**
+ * A <C>_SoXStage</C> object is a single effect of the translated
+ * chain with its parameter settings in order.
+ */
+struct _SoXStage {
+
+    /** the plugin name of the effect */
+    String effectTitle;
+
+    /** the names of the parameters set */
+    StringList parameterNameList;
+
+    /** the values of the parameters set */
+    StringList valueList;
+
+    /*--------------------*/
+
+    /**
+     * Makes a stage for effect <C>title</C> without parameters.
+     *
+     * @param[in] title  plugin name of effect
+     */
+    _SoXStage (IN String& title)
+        : effectTitle{title},
+          parameterNameList{},
+          valueList{}
+    {
+    }
+
+    /*--------------------*/
+
+    /**
+     * Sets parameter <C>parameterName</C> to <C>value</C>.
+     *
+     * @param[in] parameterName  name of parameter
+     * @param[in] value          value of parameter as string
+     */
+    void set (IN String& parameterName, IN String& value)
+    {
+        parameterNameList.append(parameterName);
+        valueList.append(value);
+    }
+
+};
+
+/*--------------------*/
+
+/** a list of translated stages */
+using _SoXStageList = GenericList<_SoXStage>;
+
+/*--------------------*/
+/* auxiliary routines */
+/*--------------------*/
+
+/**
+ * Returns <C>value</C> as a string for a parameter text.
+ *
+ * @param[in] value  real value
+ * @return  string representation without blanks
+ */
+static String _toText (IN Real value)
+{
+    return STR::toString(value);
+}
+
+/*--------------------*/
+
+/**
+ * Tells whether <C>st</C> is a number in the sense of SoX.
+ *
+ * @param[in] st  argument to be checked
+ * @return  information whether argument is numeric
+ */
+static Boolean _isNumber (IN String& st)
+{
+    return STR::isReal(st);
+}
+
+/*--------------------*/
+
+/**
+ * Converts the frequency argument <C>st</C> (in Hz or with suffix
+ * "k" in kHz) into <C>frequency</C> in Hz and tells whether it is
+ * valid.
+ *
+ * @param[in]  st         frequency argument
+ * @param[out] frequency  frequency in Hz as string
+ * @return  information whether argument is a frequency
+ */
+static Boolean _toFrequency (IN String& st, OUT String& frequency)
+{
+    const Boolean isKilohertz = STR::endsWith(st, "k");
+    const String number =
+        (isKilohertz ? STR::prefix(st, st.length() - 1) : st);
+    const Boolean isOkay = _isNumber(number);
+
+    if (isOkay) {
+        frequency = (isKilohertz
+                     ? _toText(STR::toReal(number) * Real{1000.0})
+                     : number);
+    }
+
+    return isOkay;
+}
+
+/*--------------------*/
+
+/**
+ * Converts the width argument <C>st</C> of filter
+ * <C>effectName</C> with an optional unit suffix from
+ * <C>unitCodeList</C> (the first one being the default) into
+ * <C>bandwidth</C> and the unit name <C>unitName</C> of the filter
+ * plugin; tells whether it is valid and otherwise returns a
+ * description in <C>errorMessage</C>.
+ *
+ * @param[in]  effectName    name of SoX filter effect
+ * @param[in]  st            width argument
+ * @param[in]  unitCodeList  allowed unit suffixes (default first)
+ * @param[out] bandwidth     bandwidth as string
+ * @param[out] unitName      bandwidth unit of filter plugin
+ * @param[out] errorMessage  description of failure
+ * @return  information whether argument is a width
+ */
+static Boolean _toWidth (IN String& effectName,
+                         IN String& st,
+                         IN String& unitCodeList,
+                         OUT String& bandwidth,
+                         OUT String& unitName,
+                         OUT String& errorMessage)
+{
+    const Character lastCharacter =
+        (st == "" ? ' ' : STR::lastCharacter(st));
+    const Boolean hasUnit = (STR::contains("hkoqs", lastCharacter));
+    const String unitCode =
+        (hasUnit ? STR::toString(lastCharacter)
+         : STR::toString(STR::firstCharacter(unitCodeList)));
+    const String number =
+        (hasUnit ? STR::prefix(st, st.length() - 1) : st);
+    Boolean isOkay = (_isNumber(number)
+                      && STR::contains(unitCodeList, unitCode));
+
+    if (!isOkay) {
+        errorMessage = STR::expand("bad width '%1' for %2",
+                                   st, effectName);
+    } else if (unitCode == "k") {
+        bandwidth = _toText(STR::toReal(number) * Real{1000.0});
+        unitName  = "Frequency";
+    } else {
+        bandwidth = number;
+        unitName  = (unitCode == "h" ? "Frequency"
+                     : unitCode == "o" ? "Octave(s)"
+                     : unitCode == "q" ? "Quality"
+                     : "Slope");
+    }
+
+    return isOkay;
+}
+
+/*--------------------*/
+
+/**
+ * Tells whether the number of <C>argumentList</C> of
+ * <C>effectName</C> is between <C>minimumCount</C> and
+ * <C>maximumCount</C>; otherwise returns a description in
+ * <C>errorMessage</C>.
+ *
+ * @param[in]  effectName    name of SoX effect
+ * @param[in]  argumentList  arguments of effect
+ * @param[in]  minimumCount  minimum number of arguments
+ * @param[in]  maximumCount  maximum number of arguments
+ * @param[out] errorMessage  description of failure
+ * @return  information whether argument count is okay
+ */
+static Boolean _hasArgumentCount (IN String& effectName,
+                                  IN StringList& argumentList,
+                                  IN Natural minimumCount,
+                                  IN Natural maximumCount,
+                                  OUT String& errorMessage)
+{
+    const Natural count = argumentList.size();
+    const Boolean isOkay = (minimumCount <= count
+                            && count <= maximumCount);
+
+    if (!isOkay) {
+        errorMessage = STR::expand("%1 expects %2 to %3 arguments,"
+                                   " found %4",
+                                   effectName, TOSTRING(minimumCount),
+                                   TOSTRING(maximumCount),
+                                   TOSTRING(count));
+    }
+
+    return isOkay;
+}
+
+/*--------------------*/
+
+/**
+ * Tells whether all entries of <C>argumentList</C> of
+ * <C>effectName</C> starting at <C>position</C> are numbers;
+ * otherwise returns a description in <C>errorMessage</C>.
+ *
+ * @param[in]  effectName    name of SoX effect
+ * @param[in]  argumentList  arguments of effect
+ * @param[in]  position      index of first numeric argument
+ * @param[out] errorMessage  description of failure
+ * @return  information whether arguments are numeric
+ */
+static Boolean _areNumbers (IN String& effectName,
+                            IN StringList& argumentList,
+                            IN Natural position,
+                            OUT String& errorMessage)
+{
+    Boolean isOkay = true;
+
+    for (Natural i = position;  isOkay && i < argumentList.size();
+         i++) {
+        isOkay = _isNumber(argumentList[i]);
+
+        if (!isOkay) {
+            errorMessage = STR::expand("bad argument '%1' for %2",
+                                       argumentList[i], effectName);
+        }
+    }
+
+    return isOkay;
+}
+
+/*--------------------*/
+/* filter effects     */
+/*--------------------*/
+
+/**
+ * Returns the filter kind of the filter plugin for SoX filter
+ * <C>effectName</C>.
+ *
+ * @param[in] effectName  name of SoX filter effect
+ * @return  filter kind of filter plugin
+ */
+static String _filterKind (IN String& effectName)
+{
+    return (effectName == "allpass"    ? "Allpass"
+            : effectName == "band"       ? "Band"
+            : effectName == "bandpass"   ? "BandPass"
+            : effectName == "bandreject" ? "BandReject"
+            : effectName == "bass"       ? "Bass"
+            : effectName == "biquad"     ? "Biquad"
+            : effectName == "equalizer"  ? "Equalizer"
+            : effectName == "highpass"   ? "HighPass"
+            : effectName == "lowpass"    ? "LowPass"
+            : "Treble");
+}
+
+/*--------------------*/
+
+/**
+ * Translates the filter <C>effectName</C> with frequency argument
+ * <C>frequencyArgument</C> and width argument
+ * <C>widthArgument</C> (with allowed units
+ * <C>unitCodeList</C>) into <C>stage</C>; tells whether this has
+ * been successful and otherwise returns a description in
+ * <C>errorMessage</C>.
+ *
+ * @param[in]    effectName         name of SoX filter effect
+ * @param[in]    frequencyArgument  frequency argument
+ * @param[in]    widthArgument      width argument
+ * @param[in]    unitCodeList       allowed width units
+ * @param[inout] stage              filter stage
+ * @param[out]   errorMessage       description of failure
+ * @return  information whether translation has been successful
+ */
+static Boolean _setFrequencyAndWidth (IN String& effectName,
+                                      IN String& frequencyArgument,
+                                      IN String& widthArgument,
+                                      IN String& unitCodeList,
+                                      INOUT _SoXStage& stage,
+                                      OUT String& errorMessage)
+{
+    String frequency;
+    String bandwidth;
+    String unitName;
+    Boolean isOkay = _toFrequency(frequencyArgument, frequency);
+
+    if (!isOkay) {
+        errorMessage = STR::expand("bad frequency '%1' for %2",
+                                   frequencyArgument, effectName);
+    } else {
+        isOkay = _toWidth(effectName, widthArgument, unitCodeList,
+                          bandwidth, unitName, errorMessage);
+    }
+
+    if (isOkay) {
+        stage.set("Frequency [Hz]", frequency);
+        stage.set("Bandwidth", bandwidth);
+        stage.set("Bandwidth Unit", unitName);
+    }
+
+    return isOkay;
+}
+
+/*--------------------*/
+
+/**
+ * Translates SoX filter <C>effectName</C> with
+ * <C>argumentList</C> into a new stage in <C>stageList</C>; tells
+ * whether this has been successful and otherwise returns a
+ * description in <C>errorMessage</C>.
+ *
+ * @param[in]    effectName    name of SoX filter effect
+ * @param[in]    argumentList  arguments of effect
+ * @param[inout] stageList     list of stages to be extended
+ * @param[out]   errorMessage  description of failure
+ * @return  information whether translation has been successful
+ */
+static Boolean _translateFilter (IN String& effectName,
+                                 IN StringList& argumentList,
+                                 INOUT _SoXStageList& stageList,
+                                 OUT String& errorMessage)
+{
+    _SoXStage stage{"SoXFilter"};
+    stage.set("Filter Kind", _filterKind(effectName));
+    const String option = (argumentList.size() > 0 ? argumentList[0]
+                           : "");
+    const Boolean isPassFilter =
+        (effectName == "lowpass" || effectName == "highpass");
+
+    /* the pole count options of the pass filters look like numbers */
+    const Boolean hasOption =
+        (isPassFilter ? (option == "-1" || option == "-2")
+         : (STR::startsWith(option, "-") && !_isNumber(option)));
+    StringList parameterList = argumentList;
+    Boolean isOkay = true;
+
+    if (hasOption) {
+        parameterList = parameterList.slice(1);
+    }
+
+    if (isPassFilter) {
+        /* [-1|-2] frequency [width[q|o|h|k]] */
+        const Boolean isSinglePole = (option == "-1");
+        isOkay = _hasArgumentCount(effectName, parameterList, 1,
+                                   (isSinglePole ? 1 : 2),
+                                   errorMessage);
+
+        if (isOkay) {
+            stage.set("Number of Poles", (isSinglePole ? "1" : "2"));
+            const String widthArgument =
+                (parameterList.size() > 1 ? parameterList[1]
+                 : _defaultPassFilterQuality + "q");
+            isOkay = _setFrequencyAndWidth(effectName, parameterList[0],
+                                           widthArgument, "qohk",
+                                           stage, errorMessage);
+        }
+    } else if (effectName == "bass" || effectName == "treble") {
+        /* gain [frequency [width[s|h|k|q|o]]], frequency and width
+           are checked when converted */
+        isOkay = (!hasOption
+                  && _hasArgumentCount(effectName, parameterList, 1, 3,
+                                       errorMessage)
+                  && _areNumbers(effectName, parameterList.slice(0, 1),
+                                 0, errorMessage));
+
+        if (isOkay) {
+            stage.set("Gain [dB]", parameterList[0]);
+            const String frequencyArgument =
+                (parameterList.size() > 1 ? parameterList[1]
+                 : effectName == "bass" ? "100" : "3000");
+            const String widthArgument =
+                (parameterList.size() > 2 ? parameterList[2] : "0.5s");
+            isOkay = _setFrequencyAndWidth(effectName, frequencyArgument,
+                                           widthArgument, "shkqo",
+                                           stage, errorMessage);
+        } else if (hasOption) {
+            errorMessage = STR::expand("bad option %1 for %2",
+                                       option, effectName);
+        }
+    } else if (effectName == "biquad") {
+        /* b0 b1 b2 a0 a1 a2 */
+        isOkay = (!hasOption
+                  && _hasArgumentCount(effectName, parameterList, 6, 6,
+                                       errorMessage)
+                  && _areNumbers(effectName, parameterList, 0,
+                                 errorMessage));
+
+        if (isOkay) {
+            const StringList coefficientNameList =
+                StringList::makeBySplit("b0/b1/b2/a0/a1/a2", "/");
+
+            for (Natural i = 0;  i < 6;  i++) {
+                stage.set(coefficientNameList[i], parameterList[i]);
+            }
+        } else if (hasOption) {
+            errorMessage = STR::expand("bad option %1 for %2",
+                                       option, effectName);
+        }
+    } else {
+        /* bandpass [-c] frequency width, band [-n] frequency
+           [width], bandreject, allpass: frequency width,
+           equalizer: frequency width gain */
+        const String allowedOption =
+            (effectName == "bandpass" ? "-c"
+             : effectName == "band" ? "-n" : "");
+        const Boolean isEqualizer = (effectName == "equalizer");
+        const Natural minimumCount =
+            (isEqualizer ? 3 : effectName == "band" ? 1 : 2);
+        const Natural maximumCount = (isEqualizer ? 3 : 2);
+        isOkay = ((!hasOption || option == allowedOption)
+                  && _hasArgumentCount(effectName, parameterList,
+                                       minimumCount, maximumCount,
+                                       errorMessage));
+
+        if (isOkay) {
+            String frequency = "";
+            _toFrequency(parameterList[0], frequency);
+
+            /* the band width defaults to half the center frequency */
+            const String widthArgument =
+                (parameterList.size() > 1 ? parameterList[1]
+                 : _toText(STR::toReal(frequency, 0.0) / Real{2.0})
+                   + "h");
+            const String unitCodeList = (isEqualizer ? "qohk" : "hkqo");
+
+            if (effectName == "bandpass") {
+                stage.set("Cst. Skirt Gain?", (hasOption ? "Yes" : "No"));
+            } else if (effectName == "band") {
+                stage.set("Unpitched Mode?", (hasOption ? "Yes" : "No"));
+            }
+
+            isOkay = _setFrequencyAndWidth(effectName, parameterList[0],
+                                           widthArgument, unitCodeList,
+                                           stage, errorMessage);
+
+            if (isOkay && isEqualizer) {
+                isOkay = _areNumbers(effectName, parameterList, 2,
+                                     errorMessage);
+                stage.set("Eq. Gain [dB]", parameterList[2]);
+            }
+        } else if (hasOption) {
+            errorMessage = STR::expand("bad option %1 for %2",
+                                       option, effectName);
+        }
+    }
+
+    if (isOkay) {
+        stageList.append(stage);
+    }
+
+    return isOkay;
+}
+
+/*--------------------*/
+/* other effects      */
+/*--------------------*/
+
+/**
+ * Translates SoX effect compand with <C>argumentList</C> into new
+ * stages in <C>stageList</C>: the compander and possibly a gain
+ * stage for a gain beyond the range of the compander; tells whether
+ * this has been successful and otherwise returns a description in
+ * <C>errorMessage</C>.
+ *
+ * @param[in]    argumentList  arguments of effect
+ * @param[inout] stageList     list of stages to be extended
+ * @param[out]   errorMessage  description of failure
+ * @return  information whether translation has been successful
+ */
+static Boolean _translateCompand (IN StringList& argumentList,
+                                  INOUT _SoXStageList& stageList,
+                                  OUT String& errorMessage)
+{
+    /* attack1,decay1{,attack2,decay2} [soft-knee-dB:]in-dB1[,out-dB1]
+       {,in-dB2,out-dB2} [gain [initial-volume-dB [delay]]] */
+    const String effectName = "compand";
+    Boolean isOkay =
+        (_hasArgumentCount(effectName, argumentList, 2, 5, errorMessage)
+         && _areNumbers(effectName, argumentList, 2, errorMessage));
+    StringList timeList;
+    StringList pointList;
+    String knee = "0.01";
+
+    if (isOkay) {
+        timeList = StringList::makeBySplit(argumentList[0], ",");
+        const StringList transferPartList =
+            StringList::makeBySplit(argumentList[1], ":");
+        pointList =
+            StringList::makeBySplit(transferPartList.last(), ",");
+        knee = (transferPartList.size() > 1 ? transferPartList[0]
+                : knee);
+        isOkay = (timeList.size() >= 2 && timeList.size() % 2 == 0
+                  && _areNumbers(effectName, timeList, 0, errorMessage)
+                  && transferPartList.size() <= 2 && _isNumber(knee)
+                  && _areNumbers(effectName, pointList, 0,
+                                 errorMessage));
+
+        if (!isOkay && errorMessage == "") {
+            errorMessage = STR::expand("bad attack/decay '%1' or"
+                                       " transfer function '%2'"
+                                       " for compand",
+                                       argumentList[0],
+                                       argumentList[1]);
+        }
+    }
+
+    if (isOkay) {
+        /* an odd count omits the output of the first point, which
+           then lies on the unity line; a point at 0dB is appended
+           like in SoX */
+        GenericList<Real> inputLevelList;
+        GenericList<Real> outputLevelList;
+        const Natural pointCount = pointList.size();
+        const Natural offset = pointCount % 2;
+
+        if (offset == 1) {
+            inputLevelList.append(STR::toReal(pointList[0]));
+            outputLevelList.append(STR::toReal(pointList[0]));
+        }
+
+        for (Natural i = offset;  i + 1 < pointCount;  i += 2) {
+            inputLevelList.append(STR::toReal(pointList[i]));
+            outputLevelList.append(STR::toReal(pointList[i + 1]));
+        }
+
+        if (inputLevelList.last() != Real::zero) {
+            inputLevelList.append(Real::zero);
+            outputLevelList.append(Real::zero);
+        }
+
+        /* the last segment of the transfer function defines the
+           threshold and the ratio */
+        const Natural count = inputLevelList.size();
+        const Real inputLevelA = inputLevelList[count - 2];
+        const Real outputLevelA = outputLevelList[count - 2];
+        const Real inputDelta = inputLevelList[count - 1] - inputLevelA;
+        const Real outputDelta =
+            outputLevelList[count - 1] - outputLevelA;
+        const Real ratio =
+            (outputDelta <= Real::zero ? _maximumCompanderRatio
+             : Real::minimum(_maximumCompanderRatio,
+                             inputDelta / outputDelta));
+        const Real threshold =
+            Real::maximum(_minimumCompanderThreshold, inputLevelA);
+        const Real soxGain =
+            (argumentList.size() > 2 ? STR::toReal(argumentList[2])
+             : Real::zero);
+        const Real gain = outputLevelA - threshold + soxGain;
+        const Boolean companderHasGain =
+            (gain.abs() <= _maximumCompanderGain);
+        const Real delay =
+            (argumentList.size() > 4 ? STR::toReal(argumentList[4])
+             : Real::zero);
+        isOkay = (inputDelta > Real::zero && ratio >= Real{1.0});
+
+        if (!isOkay) {
+            errorMessage = STR::expand("expanding transfer function"
+                                       " '%1' is not supported for"
+                                       " compand", argumentList[1]);
+        } else {
+            _SoXStage stage{"SoXCompander"};
+            stage.set("-2#Band Count", "1");
+            stage.set("-2#Lookahead [ms]",
+                      _toText(Real::minimum(_maximumCompanderLookahead,
+                                            delay * Real{1000.0})));
+            stage.set("1#Attack [s]", timeList[0]);
+            stage.set("1#Decay [s]", timeList[1]);
+            stage.set("1#Knee [dB]", knee);
+            stage.set("1#Threshold [dB]", _toText(threshold));
+            stage.set("1#Ratio", _toText(ratio));
+            stage.set("1#Gain [dB]",
+                      (companderHasGain ? _toText(gain) : "0"));
+            stageList.append(stage);
+
+            if (!companderHasGain) {
+                _SoXStage gainStage{"SoXGain"};
+                gainStage.set("Gain [dB]", _toText(gain));
+                stageList.append(gainStage);
+            }
+        }
+    }
+
+    return isOkay;
+}
+
+/*--------------------*/
+
+/**
+ * Translates SoX effect <C>effectName</C> (one of gain, vol,
+ * overdrive, phaser, tremolo and reverb) with
+ * <C>argumentList</C> into a new stage in <C>stageList</C>; tells
+ * whether this has been successful and otherwise returns a
+ * description in <C>errorMessage</C>.
+ *
+ * @param[in]    effectName    name of SoX effect
+ * @param[in]    argumentList  arguments of effect
+ * @param[inout] stageList     list of stages to be extended
+ * @param[out]   errorMessage  description of failure
+ * @return  information whether translation has been successful
+ */
+static Boolean _translateSimpleEffect (IN String& effectName,
+                                       IN StringList& argumentList,
+                                       INOUT _SoXStageList& stageList,
+                                       OUT String& errorMessage)
+{
+    _SoXStage stage{""};
+    Boolean isOkay = true;
+
+    if (effectName == "gain") {
+        /* [-l] [gain-dB] without the options for normalization,
+           balance and headroom */
+        StringList gainArgumentList = argumentList;
+        const Boolean isLimited =
+            (gainArgumentList.size() > 0 && gainArgumentList[0] == "-l");
+
+        if (isLimited) {
+            gainArgumentList = gainArgumentList.slice(1);
+        }
+
+        stage.effectTitle = "SoXGain";
+        isOkay = (_hasArgumentCount(effectName, gainArgumentList, 0, 1,
+                                    errorMessage)
+                  && _areNumbers(effectName, gainArgumentList, 0,
+                                 errorMessage));
+        stage.set("Gain [dB]",
+                  (gainArgumentList.size() > 0 ? gainArgumentList[0]
+                   : "0"));
+        stage.set("Limiter?", (isLimited ? "Yes" : "No"));
+    } else if (effectName == "vol") {
+        /* gain[dB] [amplitude|power|dB] */
+        stage.effectTitle = "SoXGain";
+        isOkay = _hasArgumentCount(effectName, argumentList, 1, 2,
+                                   errorMessage);
+
+        if (isOkay) {
+            const Boolean hasDbSuffix =
+                STR::endsWith(argumentList[0], "dB");
+            const String number =
+                (hasDbSuffix
+                 ? STR::prefix(argumentList[0],
+                               argumentList[0].length() - 2)
+                 : argumentList[0]);
+            const String gainKind =
+                (hasDbSuffix ? "dB"
+                 : argumentList.size() > 1 ? argumentList[1]
+                 : "amplitude");
+            const Real value = STR::toReal(number, 0.0);
+            const Real logFactor = (gainKind == "power" ? 10.0 : 20.0);
+            isOkay = (_isNumber(number)
+                      && (gainKind == "dB"
+                          || ((gainKind == "amplitude"
+                               || gainKind == "power")
+                              && value > Real::zero)));
+
+            if (!isOkay) {
+                errorMessage = STR::expand("bad volume '%1' for vol",
+                                           argumentList.join(" "));
+            } else {
+                stage.set("Gain [dB]",
+                          (gainKind == "dB" ? number
+                           : _toText(logFactor * value.log()
+                                     / Real{10.0}.log())));
+            }
+        }
+    } else if (effectName == "overdrive") {
+        /* [gain [colour]], the plugin has integer values */
+        stage.effectTitle = "SoXOverdrive";
+        isOkay = (_hasArgumentCount(effectName, argumentList, 0, 2,
+                                    errorMessage)
+                  && _areNumbers(effectName, argumentList, 0,
+                                 errorMessage));
+        const StringList parameterNameList =
+            StringList::makeBySplit("Gain [dB]/Colour", "/");
+
+        for (Natural i = 0;  isOkay && i < argumentList.size();  i++) {
+            const Real value = STR::toReal(argumentList[i]);
+            const Integer roundedValue{
+                (int) Real::floor(value + Real{0.5})};
+            stage.set(parameterNameList[i], TOSTRING(roundedValue));
+        }
+    } else if (effectName == "phaser") {
+        /* gain-in gain-out delay decay speed [-s|-t] */
+        stage.effectTitle = "SoXPhaserAndTremolo";
+        StringList parameterList = argumentList;
+        String waveform = "Sine";
+
+        if (parameterList.size() > 0
+            && (parameterList.last() == "-s"
+                || parameterList.last() == "-t")) {
+            waveform = (parameterList.last() == "-s" ? "Sine"
+                        : "Triangle");
+            parameterList = parameterList.slice(0, -1);
+        }
+
+        isOkay = (_hasArgumentCount(effectName, parameterList, 0, 5,
+                                    errorMessage)
+                  && _areNumbers(effectName, parameterList, 0,
+                                 errorMessage));
+        const StringList parameterNameList =
+            StringList::makeBySplit("In Gain/Out Gain/Delay [ms]/Decay"
+                                    "/Modulation [Hz]", "/");
+        stage.set("Effect Kind", "Phaser");
+
+        for (Natural i = 0;  isOkay && i < parameterList.size();  i++) {
+            stage.set(parameterNameList[i], parameterList[i]);
+        }
+
+        stage.set("Waveform", waveform);
+    } else if (effectName == "tremolo") {
+        /* speed [depth] */
+        stage.effectTitle = "SoXPhaserAndTremolo";
+        isOkay = (_hasArgumentCount(effectName, argumentList, 1, 2,
+                                    errorMessage)
+                  && _areNumbers(effectName, argumentList, 0,
+                                 errorMessage));
+        stage.set("Effect Kind", "Tremolo");
+
+        if (isOkay) {
+            stage.set("Modulation [Hz]", argumentList[0]);
+            stage.set("Depth [%]",
+                      (argumentList.size() > 1 ? argumentList[1] : "40"));
+        }
+    } else {
+        /* reverb [-w|--wet-only] [reverberance [HF-damping
+           [room-scale [stereo-depth [pre-delay [wet-gain]]]]]] */
+        stage.effectTitle = "SoXReverb";
+        StringList parameterList = argumentList;
+        const Boolean isWetOnly =
+            (parameterList.size() > 0
+             && (parameterList[0] == "-w"
+                 || parameterList[0] == "--wet-only"));
+
+        if (isWetOnly) {
+            parameterList = parameterList.slice(1);
+        }
+
+        isOkay = (_hasArgumentCount(effectName, parameterList, 0, 6,
+                                    errorMessage)
+                  && _areNumbers(effectName, parameterList, 0,
+                                 errorMessage));
+        const StringList parameterNameList =
+            StringList::makeBySplit("Reverberance [%]/HF Damping [%]"
+                                    "/Room Scale [%]/Stereo Depth [%]"
+                                    "/Predelay [ms]/Wet Gain [dB]", "/");
+        stage.set("Is Wet Only?", (isWetOnly ? "Yes" : "No"));
+
+        for (Natural i = 0;  isOkay && i < parameterList.size();  i++) {
+            stage.set(parameterNameList[i], parameterList[i]);
+        }
+    }
+
+    if (isOkay) {
+        stageList.append(stage);
+    }
+
+    return isOkay;
+}
+
+/*--------------------*/
+
+/**
+ * Translates SoX effect <C>effectName</C> with
+ * <C>argumentList</C> into new stages in <C>stageList</C>; tells
+ * whether this has been successful and otherwise returns a
+ * description in <C>errorMessage</C>.
+ *
+ * @param[in]    effectName    name of SoX effect
+ * @param[in]    argumentList  arguments of effect
+ * @param[inout] stageList     list of stages to be extended
+ * @param[out]   errorMessage  description of failure
+ * @return  information whether translation has been successful
+ */
+static Boolean _translateEffect (IN String& effectName,
+                                 IN StringList& argumentList,
+                                 INOUT _SoXStageList& stageList,
+                                 OUT String& errorMessage)
+{
+    Logging_trace2(">>: effect = %1, arguments = %2",
+                   effectName, argumentList.toString());
+
+    const StringList filterNameList =
+        StringList::makeBySplit("allpass/band/bandpass/bandreject/bass"
+                                "/biquad/equalizer/highpass/lowpass"
+                                "/treble", "/");
+    Boolean isOkay;
+
+    if (filterNameList.contains(effectName)) {
+        isOkay = _translateFilter(effectName, argumentList, stageList,
+                                  errorMessage);
+    } else if (effectName == "compand") {
+        isOkay = _translateCompand(argumentList, stageList,
+                                   errorMessage);
+    } else {
+        isOkay = _translateSimpleEffect(effectName, argumentList,
+                                        stageList, errorMessage);
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*====================*/
+
+Boolean SoXCommandParser::toParameterText (IN String& command,
+                                           OUT String& parameterText,
+                                           OUT String& errorMessage)
+{
+    Logging_trace1(">>: %1", command);
+
+    const StringList effectNames = effectNameList();
+    String normalizedCommand = command;
+    STR::replace(normalizedCommand, "\t", " ");
+    STR::replace(normalizedCommand, "\n", " ");
+    const StringList rawTokenList =
+        StringList::makeBySplit(normalizedCommand, " ");
+    StringList tokenList;
+    _SoXStageList stageList;
+    errorMessage = "";
+
+    for (const String& token : rawTokenList) {
+        if (token != "") {
+            tokenList.append(token);
+        }
+    }
+
+    Boolean isOkay = (tokenList.size() > 0);
+
+    if (!isOkay) {
+        errorMessage = "empty SoX effect chain";
+    }
+
+    /* an effect takes all following tokens up to the next effect
+       name as its arguments */
+    Natural position = 0;
+
+    while (isOkay && position < tokenList.size()) {
+        const String effectName = tokenList[position];
+        StringList argumentList;
+        position++;
+
+        while (position < tokenList.size()
+               && !effectNames.contains(tokenList[position])) {
+            argumentList.append(tokenList[position]);
+            position++;
+        }
+
+        isOkay = effectNames.contains(effectName);
+
+        if (!isOkay) {
+            errorMessage = STR::expand("unknown SoX effect '%1' - must"
+                                       " be one of %2", effectName,
+                                       effectNames.join(", "));
+        } else {
+            isOkay = _translateEffect(effectName, argumentList,
+                                      stageList, errorMessage);
+        }
+    }
+
+    if (isOkay) {
+        /* a chain has the stage number as parameter prefix (after
+           the page prefix like in the effect chain) */
+        const Boolean isChain = (stageList.size() > 1);
+        const String separator =
+            SoXEffectParameterMap::widgetPageSeparator;
+        StringList titleList;
+        StringList lineList;
+
+        for (Natural i = 0;  i < stageList.size();  i++) {
+            const _SoXStage& stage = stageList[i];
+            const String prefix =
+                (isChain ? STR::expand("%1: ", TOSTRING(i + 1)) : "");
+            titleList.append(stage.effectTitle);
+
+            for (Natural j = 0;  j < stage.parameterNameList.size();
+                 j++) {
+                const String& parameterName = stage.parameterNameList[j];
+                const Natural position = STR::find(parameterName,
+                                                   separator);
+                const Natural prefixLength =
+                    (position == Natural::maximumValue() ? 0
+                     : position + separator.length());
+                const String chainParameterName =
+                    (STR::prefix(parameterName, prefixLength) + prefix
+                     + STR::substring(parameterName, prefixLength));
+                lineList.append(STR::expand("%1 = \"%2\"",
+                                            chainParameterName,
+                                            stage.valueList[j]));
+            }
+        }
+
+        lineList.prepend(titleList.join(" > "));
+        parameterText = lineList.join("\n");
+    }
+
+    Logging_trace2("<<: isOkay = %1, parameterText = %2",
+                   TOSTRING(isOkay), parameterText);
+    return isOkay;
+}
+
+/*--------------------*/
+
+StringList SoXCommandParser::effectNameList ()
+{
+    return StringList::makeBySplit("allpass/band/bandpass/bandreject"
+                                   "/bass/biquad/compand/equalizer/gain"
+                                   "/highpass/lowpass/overdrive/phaser"
+                                   "/reverb/treble/tremolo/vol", "/");
+}
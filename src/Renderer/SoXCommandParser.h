@@ -0,0 +1,89 @@
+/**
+ * @file
+ * The <C>SoXCommandParser</C> specification defines the translation
+ * of an effect chain in the command-line syntax of SoX into the
+ * parameter text of the offline renderer.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "MyString.h"
+#include "StringList.h"
+
+/*--------------------*/
+
+using BaseTypes::Containers::StringList;
+using BaseTypes::Primitives::Boolean;
+using BaseTypes::Primitives::String;
+
+/*====================*/
+
+namespace SoXPlugins::Renderer {
+
+    /**
+     * A <C>SoXCommandParser</C> translates the effect part of a SoX
+     * command line (like <TT>gain -3 highpass 80 compand 0.3,1
+     * 6:-70,-60,-20 -5 -90 0.2 reverb 50</TT>) into a parameter text
+     * for a chain of the corresponding SoX plugin effects, such that
+     * scripts calling SoX can be switched to the offline renderer.
+     *
+     * The supported effects are allpass, band, bandpass, bandreject,
+     * bass, biquad, compand, equalizer, gain, highpass, lowpass,
+     * overdrive, phaser, reverb, treble, tremolo and vol with the
+     * arguments and defaults of SoX (frequencies may have a "k"
+     * suffix, widths the suffixes "h", "k", "o", "q" and "s" where
+     * SoX allows them).  Options changing the processing outside of
+     * the effect (like the normalization of gain) are rejected, the
+     * option "-l" of gain selects the limiter of the gain plugin.
+     *
+     * The compander of the plugins models a transfer function by a
+     * threshold and a ratio, hence the transfer function of compand
+     * is approximated by its last segment: the threshold is the
+     * input level where that segment starts, the ratio its inverse
+     * slope and the gain shifts it onto the given points.  Only the
+     * first attack and decay pair is used (the channels are always
+     * linked), the initial volume is ignored and the delay becomes
+     * the lookahead of the compander (limited to its maximum).
+     */
+    struct SoXCommandParser {
+
+        /**
+         * Translates the SoX effect chain <C>command</C> into a
+         * parameter text for the offline renderer returned in
+         * <C>parameterText</C> and tells whether this has been
+         * successful; returns the description of a failure in
+         * <C>errorMessage</C>.
+         *
+         * @param[in]  command        SoX effect names with their
+         *                            arguments separated by blanks
+         * @param[out] parameterText  parameter text with title line
+         *                            and key-value lines
+         * @param[out] errorMessage   description of failure
+         * @return  information whether command has been translated
+         */
+        static Boolean toParameterText (IN String& command,
+                                        OUT String& parameterText,
+                                        OUT String& errorMessage);
+
+        /*--------------------*/
+
+        /**
+         * Returns the names of the SoX effects accepted in a
+         * command.
+         *
+         * @return  list of SoX effect names
+         */
+        static StringList effectNameList ();
+
+    };
+
+}
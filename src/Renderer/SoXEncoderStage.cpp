@@ -0,0 +1,491 @@
+/**
+ * @file
+ * The <C>SoXEncoderStage</C> body implements the output stage of the
+ * offline renderer: processed blocks are handed over a bounded
+ * lock-free ring to encoder threads writing them to an audio file.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXEncoderStage.h"
+
+#include <iomanip>
+#include <sstream>
+#include "Logging.h"
+
+/*--------------------*/
+
+using SoXPlugins::Renderer::SoXEncoderStage;
+using SoXPlugins::Renderer::SoXEncoderStageStatistics;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
+
+/*====================*/
+
+/** the maximum time in microseconds an idle thread sleeps before
+ * checking the ring again */
+static const Natural _maximumSleepTime = 1000;
+
+/*--------------------*/
+
+const Natural SoXEncoderStage::defaultSlotCount = 8;
+
+/*--------------------*/
+/* auxiliary routines */
+/*--------------------*/
+
+/**
+ * Returns the seconds in <C>nanosecondCount</C>.
+ *
+ * @param[in] nanosecondCount  duration in nanoseconds
+ * @return  duration in seconds
+ */
+static Real _toSeconds (IN std::uint64_t nanosecondCount)
+{
+    return Real{(double) nanosecondCount * 1.0E-9};
+}
+
+/*--------------------*/
+
+/**
+ * Returns the nanoseconds between <C>startTime</C> and
+ * <C>endTime</C>.
+ *
+ * @param[in] startTime  start time point
+ * @param[in] endTime    end time point
+ * @return  duration in nanoseconds
+ */
+static std::uint64_t
+_nanosecondsBetween (IN std::chrono::steady_clock::time_point& startTime,
+                     IN std::chrono::steady_clock::time_point& endTime)
+{
+    return (std::uint64_t)
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            endTime - startTime).count();
+}
+
+/*--------------------*/
+
+/**
+ * Returns <C>value</C> in fixed point notation with
+ * <C>fractionalDigitCount</C> digits after the decimal point.
+ *
+ * @param[in] value                 number to be formatted
+ * @param[in] fractionalDigitCount  number of fractional digits
+ * @return  string representation
+ */
+static String _toFixedString (IN Real value,
+                              IN int fractionalDigitCount)
+{
+    std::ostringstream stream;
+    stream << std::fixed << std::setprecision(fractionalDigitCount)
+           << (double) value;
+    return stream.str();
+}
+
+/*--------------------*/
+
+/**
+ * Returns <C>audioDuration</C> divided by <C>busyTime</C> with one
+ * fractional digit (zero for no busy time).
+ *
+ * @param[in] audioDuration  duration of audio in seconds
+ * @param[in] busyTime       busy time of stage in seconds
+ * @return  throughput as a multiple of real time
+ */
+static String _speedString (IN Real audioDuration,
+                            IN Real busyTime)
+{
+    return _toFixedString(busyTime > 0.0 ? audioDuration / busyTime
+                          : Real{0.0}, 1);
+}
+
+/*====================*/
+
+SoXEncoderStageStatistics::SoXEncoderStageStatistics ()
+    : encoderThreadCount{0},
+      slotCount{0},
+      blockCount{0},
+      audioDuration{0.0},
+      processingTime{0.0},
+      stallTime{0.0},
+      encodingTime{0.0},
+      writingTime{0.0}
+{
+}
+
+/*--------------------*/
+
+String SoXEncoderStageStatistics::toString () const
+{
+    /* the encoders work in parallel, hence their stage throughput
+       refers to the time per encoder */
+    const Real encodingStageTime =
+        (encoderThreadCount == 0 ? encodingTime
+         : encodingTime / Real{(double) encoderThreadCount});
+    return STR::expand("blocks = %1, slots = %2, encoders = %3;"
+                       " processing = %4s (%5x realtime),"
+                       " stall = %6s, encoding = %7s (%8x realtime),"
+                       " writing = %9s (%Ax realtime)",
+                       TOSTRING(blockCount), TOSTRING(slotCount),
+                       TOSTRING(encoderThreadCount),
+                       _toFixedString(processingTime, 3),
+                       _speedString(audioDuration, processingTime),
+                       _toFixedString(stallTime, 3),
+                       _toFixedString(encodingTime, 3),
+                       _speedString(audioDuration, encodingStageTime),
+                       _toFixedString(writingTime, 3),
+                       _speedString(audioDuration, writingTime));
+}
+
+/*====================*/
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+SoXEncoderStage::SoXEncoderStage ()
+    : _slotList{nullptr},
+      _slotCount{0},
+      _threadList{},
+      _writer{nullptr},
+      _acquirePosition{0},
+      _submitPosition{0},
+      _firstFramePosition{0},
+      _framePosition{0},
+      _claimPosition{0},
+      _completedCount{0},
+      _isOkay{true},
+      _isStopped{true},
+      _sleeperCount{0},
+      _startTime{},
+      _statistics{},
+      _encodingTime{0},
+      _writingTime{0}
+{
+    Logging_trace(">>");
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+SoXEncoderStage::~SoXEncoderStage ()
+{
+    Logging_trace(">>");
+    finish();
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* processing         */
+/*--------------------*/
+
+void SoXEncoderStage::start (INOUT SoXAudioFileWriter& writer,
+                             IN Natural encoderThreadCount,
+                             IN Natural slotCount)
+{
+    Logging_trace2(">>: encoderThreadCount = %1, slotCount = %2",
+                   TOSTRING(encoderThreadCount), TOSTRING(slotCount));
+
+    finish();
+
+    /* the slot buffers are filled on first use by the producer,
+       hence their memory is local to its thread */
+    _writer    = &writer;
+    _slotCount = (size_t) Natural::maximum(2, slotCount);
+    _slotList  = new _Slot[_slotCount];
+
+    for (size_t i = 0;  i < _slotCount;  i++) {
+        _slotList[i].sequenceNumber.store(i);
+        _slotList[i].frameCount    = 0;
+        _slotList[i].framePosition = 0;
+    }
+
+    const Natural threadCount = Natural::maximum(1, encoderThreadCount);
+    _acquirePosition    = 0;
+    _submitPosition     = 0;
+    _firstFramePosition = writer.frameCount();
+    _framePosition      = _firstFramePosition;
+    _claimPosition.store(0);
+    _completedCount.store(0);
+    _isOkay.store(true);
+    _isStopped.store(false);
+    _encodingTime.store(0);
+    _writingTime.store(0);
+    _statistics = SoXEncoderStageStatistics{};
+    _statistics.encoderThreadCount = threadCount;
+    _statistics.slotCount          = Natural{_slotCount};
+    _startTime = _Clock::now();
+
+    for (Natural i = 0;  i < threadCount;  i++) {
+        _threadList.push_back(std::thread{&SoXEncoderStage::_encoderLoop,
+                                          this});
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+AudioSampleListVector& SoXEncoderStage::acquireBuffer ()
+{
+    Logging_traceHot1(">>: %1", TOSTRING(Natural{_acquirePosition}));
+
+    const size_t position = _acquirePosition;
+    _Slot& slot = _slotList[position % _slotCount];
+    const auto isFree = [&slot, position] () {
+        return (slot.sequenceNumber.load(std::memory_order_acquire)
+                == position);
+    };
+
+    if (!isFree()) {
+        /* backpressure: the encoders have not yet written the block
+           from the previous round */
+        const _Clock::time_point startTime = _Clock::now();
+
+        while (!isFree()) {
+            _sleepUntil(isFree);
+        }
+
+        const _Clock::time_point endTime = _Clock::now();
+        _statistics.stallTime +=
+            _toSeconds(_nanosecondsBetween(startTime, endTime));
+    }
+
+    _acquirePosition++;
+
+    Logging_traceHot("<<");
+    return slot.buffer;
+}
+
+/*--------------------*/
+
+void SoXEncoderStage::submit (IN Natural frameCount)
+{
+    Logging_traceHot1(">>: %1", TOSTRING(frameCount));
+
+    _Slot& slot = _slotList[_submitPosition % _slotCount];
+    slot.frameCount    = frameCount;
+    slot.framePosition = _framePosition;
+    _framePosition += frameCount;
+    slot.sequenceNumber.store(_submitPosition + 1,
+                              std::memory_order_release);
+    _submitPosition++;
+    _signalChange();
+
+    Logging_traceHot("<<");
+}
+
+/*--------------------*/
+
+Boolean SoXEncoderStage::waitUntilWritten ()
+{
+    Logging_trace(">>");
+
+    const size_t submittedCount = _submitPosition;
+    const auto isComplete = [this, submittedCount] () {
+        return (_completedCount.load() >= submittedCount);
+    };
+
+    while (!isComplete()) {
+        _sleepUntil(isComplete);
+    }
+
+    const Boolean isOkay = _isOkay.load();
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+
+Boolean SoXEncoderStage::finish ()
+{
+    Logging_trace(">>");
+
+    if (_slotList != nullptr) {
+        const _Clock::time_point finishTime = _Clock::now();
+        const size_t submittedCount = _submitPosition;
+        const auto isComplete = [this, submittedCount] () {
+            return (_completedCount.load() >= submittedCount);
+        };
+
+        while (!isComplete()) {
+            _sleepUntil(isComplete);
+        }
+
+        _isStopped.store(true);
+        _signalChange();
+
+        for (std::thread& thread : _threadList) {
+            thread.join();
+        }
+
+        _threadList.clear();
+        delete[] _slotList;
+        _slotList = nullptr;
+
+        const Real sampleRate =
+            Real{Natural::maximum(1, _writer->format().sampleRate)};
+        const Real producerTime =
+            _toSeconds(_nanosecondsBetween(_startTime, finishTime));
+        _statistics.blockCount     = Natural{submittedCount};
+        _statistics.audioDuration  =
+            Real{_framePosition - _firstFramePosition} / sampleRate;
+        _statistics.processingTime =
+            Real::maximum(0.0, producerTime - _statistics.stallTime);
+        _statistics.encodingTime   = _toSeconds(_encodingTime.load());
+        _statistics.writingTime    = _toSeconds(_writingTime.load());
+        _writer = nullptr;
+        Logging_trace1("--: %1", _statistics.toString());
+    }
+
+    const Boolean isOkay = _isOkay.load();
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+/* queries            */
+/*--------------------*/
+
+SoXEncoderStageStatistics SoXEncoderStage::statistics () const
+{
+    return _statistics;
+}
+
+/*--------------------*/
+/* internal routines  */
+/*--------------------*/
+
+void SoXEncoderStage::_encoderLoop ()
+{
+    Logging_trace(">>");
+
+    const auto hasWork = [this] () {
+        const size_t position = _claimPosition.load();
+        const _Slot& slot = _slotList[position % _slotCount];
+        return (_isStopped.load()
+                || (slot.sequenceNumber.load(std::memory_order_acquire)
+                    == position + 1));
+    };
+
+    while (!_isStopped.load()) {
+        if (!_processSlot()) {
+            _sleepUntil(hasWork);
+        }
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+Boolean SoXEncoderStage::_processSlot ()
+{
+    size_t position = _claimPosition.load();
+    _Slot* slot = nullptr;
+    Boolean isDone = false;
+
+    /* the slot at the claim position is taken when it has been
+       submitted in this round; a failed exchange or an outdated
+       position (the slot has already been written) retries with
+       the current claim position */
+    while (!isDone) {
+        _Slot& candidate = _slotList[position % _slotCount];
+        const size_t sequenceNumber =
+            candidate.sequenceNumber.load(std::memory_order_acquire);
+
+        if (sequenceNumber < position + 1) {
+            /* nothing submitted at this position */
+            isDone = true;
+        } else if (sequenceNumber > position + 1) {
+            position = _claimPosition.load();
+        } else if (_claimPosition.compare_exchange_weak(position,
+                                                        position + 1)) {
+            slot = &candidate;
+            isDone = true;
+        }
+    }
+
+    if (slot != nullptr) {
+        const SoXAudioFileFormat& format = _writer->format();
+        const Natural byteCount =
+            slot->frameCount * format.bytesPerFrame();
+        const _Clock::time_point startTime = _Clock::now();
+
+        if (slot->byteList.length() < byteCount) {
+            slot->byteList.setLength(byteCount);
+        }
+
+        format.encode(slot->buffer, slot->frameCount,
+                      (std::uint8_t*) slot->byteList.asArray());
+        const _Clock::time_point encodedTime = _Clock::now();
+        Boolean isOkay;
+
+        {
+            /* encoded blocks are written at their frame position,
+               hence encoders may complete out of order */
+            std::lock_guard<std::mutex> lock{_writeMutex};
+            isOkay = _writer->writeEncodedAt(slot->byteList,
+                                             slot->frameCount,
+                                             slot->framePosition);
+        }
+
+        const _Clock::time_point endTime = _Clock::now();
+        _encodingTime.fetch_add(_nanosecondsBetween(startTime,
+                                                    encodedTime));
+        _writingTime.fetch_add(_nanosecondsBetween(encodedTime,
+                                                   endTime));
+
+        if (!isOkay) {
+            _isOkay.store(false);
+        }
+
+        /* the slot is free for the next round of the ring */
+        slot->sequenceNumber.store(position + _slotCount,
+                                   std::memory_order_release);
+        _completedCount.fetch_add(1);
+        _signalChange();
+    }
+
+    return (slot != nullptr);
+}
+
+/*--------------------*/
+
+void SoXEncoderStage::_signalChange ()
+{
+    /* the mutex is taken briefly, such that a thread between its
+       check and its wait cannot miss the notification */
+    if (_sleeperCount.load() > 0) {
+        {
+            std::lock_guard<std::mutex> lock{_wakeupMutex};
+        }
+
+        _wakeupCondition.notify_all();
+    }
+}
+
+/*--------------------*/
+
+template <typename Predicate>
+void SoXEncoderStage::_sleepUntil (IN Predicate condition)
+{
+    _sleeperCount.fetch_add(1);
+
+    {
+        std::unique_lock<std::mutex> lock{_wakeupMutex};
+        _wakeupCondition.wait_for(lock,
+                                  std::chrono::microseconds{
+                                      (int) _maximumSleepTime},
+                                  condition);
+    }
+
+    _sleeperCount.fetch_sub(1);
+}
@@ -0,0 +1,356 @@
+/**
+ * @file
+ * The <C>SoXEncoderStage</C> specification defines the output stage
+ * of the offline renderer: processed blocks are handed over a
+ * bounded lock-free ring to encoder threads writing them to an
+ * audio file.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include "GenericList.h"
+#include "SoXAudioFile.h"
+
+/*--------------------*/
+
+using BaseTypes::GenericTypes::GenericList;
+using BaseTypes::Primitives::Real;
+
+/*====================*/
+
+namespace SoXPlugins::Renderer {
+
+    /**
+     * A <C>SoXEncoderStageStatistics</C> object tells how long each
+     * stage of a rendering has been busy together with its
+     * throughput as a multiple of real time.
+     */
+    struct SoXEncoderStageStatistics {
+
+        /** the number of encoder threads */
+        Natural encoderThreadCount;
+
+        /** the number of blocks in the ring */
+        Natural slotCount;
+
+        /** the number of blocks written */
+        Natural blockCount;
+
+        /** the duration of the written audio in seconds */
+        Real audioDuration;
+
+        /** the time the producer spent on reading and processing
+         * in seconds */
+        Real processingTime;
+
+        /** the time the producer waited for a free block because
+         * the encoders lagged behind in seconds */
+        Real stallTime;
+
+        /** the time spent on encoding summed over all encoder
+         * threads in seconds */
+        Real encodingTime;
+
+        /** the time spent on writing to the file in seconds */
+        Real writingTime;
+
+        /*--------------------*/
+        /*--------------------*/
+
+        /**
+         * Makes statistics with all counters zero.
+         */
+        SoXEncoderStageStatistics ();
+
+        /*--------------------*/
+
+        /**
+         * Returns string representation of statistics with the
+         * throughput of each stage as a multiple of real time.
+         *
+         * @return string representation
+         */
+        String toString () const;
+
+    };
+
+    /*====================*/
+
+    /**
+     * A <C>SoXEncoderStage</C> object decouples the encoding and
+     * writing of an output file from the processing thread.  The
+     * producer takes the buffer of a free slot from a ring of
+     * preallocated slots, fills it with processed samples and
+     * submits it; encoder threads claim submitted slots in order,
+     * encode them concurrently into the file format and write the
+     * bytes at their frame position, hence several encoders may
+     * work on consecutive blocks at the same time.
+     *
+     * The handoff is a single atomic sequence number per slot
+     * (telling whether it is free, submitted or claimed in the
+     * current round of the ring), so neither side takes a lock for
+     * a block.  The ring provides backpressure: when all slots are
+     * in use, the producer waits for the encoders, such that the
+     * memory of the stage is bounded by the slot count times the
+     * block size.  Only idle threads sleep on a condition variable
+     * for at most a short time.
+     */
+    struct SoXEncoderStage {
+
+        /** the default number of slots in the ring */
+        static const Natural defaultSlotCount;
+
+        /*--------------------*/
+        /* con-/destruction   */
+        /*--------------------*/
+
+        /**
+         * Makes a stage without encoder threads.
+         */
+        SoXEncoderStage ();
+
+        /*--------------------*/
+
+        /**
+         * Finishes the stage (when started) and destroys it.
+         */
+        ~SoXEncoderStage ();
+
+        /*--------------------*/
+
+        SoXEncoderStage (IN SoXEncoderStage&) = delete;
+
+        /*--------------------*/
+        /* processing         */
+        /*--------------------*/
+
+        /**
+         * Starts <C>encoderThreadCount</C> encoder threads (at least
+         * one) writing to <C>writer</C> via a ring of
+         * <C>slotCount</C> slots (at least two); the writer must be
+         * open and stay alive until <C>finish</C>.  The submitted
+         * frames follow those already in the file of the writer.
+         *
+         * @param[inout] writer              writer for output file
+         * @param[in]    encoderThreadCount  number of encoder threads
+         * @param[in]    slotCount           number of slots in ring
+         */
+        void start (INOUT SoXAudioFileWriter& writer,
+                    IN Natural encoderThreadCount,
+                    IN Natural slotCount = defaultSlotCount);
+
+        /*--------------------*/
+
+        /**
+         * Returns the buffer of the next free slot for filling by
+         * the producer and waits while there is none; up to the
+         * slot count buffers may be acquired before the oldest one
+         * is submitted.
+         *
+         * @return  sample buffer of slot
+         */
+        AudioSampleListVector& acquireBuffer ();
+
+        /*--------------------*/
+
+        /**
+         * Hands the oldest acquired slot with its first
+         * <C>frameCount</C> frames over to the encoders; the frames
+         * follow those of the previous submission in the file.
+         *
+         * @param[in] frameCount  number of valid frames in buffer
+         */
+        void submit (IN Natural frameCount);
+
+        /*--------------------*/
+
+        /**
+         * Waits until all submitted slots are written (but keeps
+         * the encoder threads running) and tells whether all writes
+         * have been successful so far.
+         *
+         * @return  information whether all writes have been
+         *          successful
+         */
+        Boolean waitUntilWritten ();
+
+        /*--------------------*/
+
+        /**
+         * Waits until all submitted slots are written, stops the
+         * encoder threads and tells whether all writes have been
+         * successful; acquired but unsubmitted slots are dropped.
+         *
+         * @return  information whether all writes have been
+         *          successful
+         */
+        Boolean finish ();
+
+        /*--------------------*/
+        /* queries            */
+        /*--------------------*/
+
+        /**
+         * Returns the statistics of the last run of the stage
+         * (complete after <C>finish</C>).
+         *
+         * @return  stage statistics
+         */
+        SoXEncoderStageStatistics statistics () const;
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** abbreviation for the clock used for time
+             * measurement */
+            using _Clock = std::chrono::steady_clock;
+
+            /**
+             * A <C>_Slot</C> object is a preallocated block of the
+             * ring together with its encoded bytes.
+             */
+            struct _Slot {
+
+                /** the sequence number of the slot: equal to its
+                 * position in the ring sequence when free and to
+                 * the position plus one when submitted; writing
+                 * advances it to the position of the next round */
+                std::atomic<size_t> sequenceNumber;
+
+                /** the processed samples */
+                AudioSampleListVector buffer;
+
+                /** the number of valid frames in buffer */
+                Natural frameCount;
+
+                /** the index of the first frame in the file */
+                Natural framePosition;
+
+                /** the samples encoded in the file format */
+                ByteList byteList;
+
+            };
+
+            /*--------------------*/
+
+            /** the ring of slots (allocated by <C>start</C>) */
+            _Slot* _slotList;
+
+            /** the number of slots in the ring */
+            size_t _slotCount;
+
+            /** the encoder threads */
+            GenericList<std::thread> _threadList;
+
+            /** the writer for the output file */
+            SoXAudioFileWriter* _writer;
+
+            /** the mutex serializing the writes to the file */
+            std::mutex _writeMutex;
+
+            /** the position of the next slot to be acquired */
+            size_t _acquirePosition;
+
+            /** the position of the next slot to be submitted */
+            size_t _submitPosition;
+
+            /** the frame position of the first submitted slot */
+            Natural _firstFramePosition;
+
+            /** the frame position of the next submitted slot */
+            Natural _framePosition;
+
+            /** the position of the next slot to be claimed by an
+             * encoder */
+            std::atomic<size_t> _claimPosition;
+
+            /** the number of slots written (successfully or not) */
+            std::atomic<size_t> _completedCount;
+
+            /** tells whether all writes have been successful */
+            std::atomic<bool> _isOkay;
+
+            /** tells whether the encoder threads shall stop */
+            std::atomic<bool> _isStopped;
+
+            /** the mutex for sleeping threads */
+            std::mutex _wakeupMutex;
+
+            /** the number of threads sleeping on the condition */
+            std::atomic<size_t> _sleeperCount;
+
+            /** the condition signalled on a change of a slot */
+            std::condition_variable _wakeupCondition;
+
+            /** the time of <C>start</C> */
+            _Clock::time_point _startTime;
+
+            /** the statistics of the stage (the encoding and
+             * writing times are accumulated in nanoseconds below) */
+            SoXEncoderStageStatistics _statistics;
+
+            /** the encoding time summed over the encoders in
+             * nanoseconds */
+            std::atomic<std::uint64_t> _encodingTime;
+
+            /** the writing time in nanoseconds */
+            std::atomic<std::uint64_t> _writingTime;
+
+            /*--------------------*/
+
+            /**
+             * Runs the loop of an encoder thread: claims, encodes
+             * and writes submitted slots until the stage is
+             * stopped.
+             */
+            void _encoderLoop ();
+
+            /*--------------------*/
+
+            /**
+             * Claims the next submitted slot, encodes and writes it
+             * and tells whether there has been one.
+             *
+             * @return  information whether a slot has been
+             *          processed
+             */
+            Boolean _processSlot ();
+
+            /*--------------------*/
+
+            /**
+             * Wakes up all threads sleeping on a slot change (if
+             * any).
+             */
+            void _signalChange ();
+
+            /*--------------------*/
+
+            /**
+             * Waits a short time or until <C>condition</C> holds.
+             *
+             * @param[in] condition  predicate ending the wait
+             */
+            template <typename Predicate>
+            void _sleepUntil (IN Predicate condition);
+
+    };
+
+}
@@ -0,0 +1,1866 @@
+/**
+ * @file
+ * The <C>SoXOfflineRenderer</C> body implements a renderer applying
+ * a single SoX effect to an audio file without a DAW.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXOfflineRenderer.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "DenormalGuard.h"
+#include "DspStateStream.h"
+#include "File.h"
+#include "Kernels.h"
+#include "Logging.h"
+#include "NaturalList.h"
+#include "SoXAudioFile.h"
+#include "SoXCommandParser.h"
+#include "SoXEncoderStage.h"
+#include "SoXCompander_AudioEffect.h"
+#include "SoXEffectChain_AudioEffect.h"
+#include "SoXFilter_AudioEffect.h"
+#include "SoXGain_AudioEffect.h"
+#include "SoXOverdrive_AudioEffect.h"
+#include "SoXPhaserAndTremolo_AudioEffect.h"
+#include "SoXReverb_AudioEffect.h"
+#include "SoXWorkerPool.h"
+#include "StateArena.h"
+
+/*--------------------*/
+
+using Audio::DenormalGuard;
+using Audio::DspStateStream;
+using Audio::Kernels;
+using BaseModules::File;
+using BaseTypes::Containers::NaturalList;
+using BaseTypes::GenericTypes::StateArena;
+using SoXPlugins::Effects::SoXCompander::SoXCompander_AudioEffect;
+using SoXPlugins::Effects::SoXEffectChain::SoXEffectChain_AudioEffect;
+using SoXPlugins::Effects::SoXFilter::SoXFilter_AudioEffect;
+using SoXPlugins::Effects::SoXGain::SoXGain_AudioEffect;
+using SoXPlugins::Effects::SoXOverdrive::SoXOverdrive_AudioEffect;
+using SoXPlugins::Effects::SoXPhaserAndTremolo
+         ::SoXPhaserAndTremolo_AudioEffect;
+using SoXPlugins::Effects::SoXReverb::SoXReverb_AudioEffect;
+using SoXPlugins::Helpers::SoXEffectParameterMap;
+using SoXPlugins::Helpers::SoXPrecisionProfile;
+using SoXPlugins::Helpers::SoXWorkerPool;
+using SoXPlugins::Renderer::SoXAudioFileFormat;
+using SoXPlugins::Renderer::SoXAudioFileKind;
+using SoXPlugins::Renderer::SoXAudioFileReader;
+using SoXPlugins::Renderer::SoXAudioFileWriter;
+using SoXPlugins::Renderer::SoXAudioStream;
+using SoXPlugins::Renderer::SoXCommandParser;
+using SoXPlugins::Renderer::SoXEncoderStage;
+using SoXPlugins::Renderer::SoXEncoderStageStatistics;
+using SoXPlugins::Renderer::SoXOfflineRenderer;
+using SoXPlugins::Helpers::precisionProfileFromString;
+using SoXPlugins::Helpers::precisionProfileToString;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
+
+/*====================*/
+
+/** the character enclosing parameter values */
+static const Character _quoteCharacter = '"';
+
+/** the separator between the effect titles of a chain */
+static const String _chainSeparator = ">";
+
+/** the name of the pseudo parameter line selecting the precision
+ * profile of the effect */
+static const String _precisionProfileParameterName = "Precision Profile";
+
+/** the symbol opening a parallel section of a chain */
+static const String _sectionStartSymbol = "{";
+
+/** the separator between the branches of a parallel section */
+static const String _branchSeparator = "|";
+
+/** the symbol closing a parallel section of a chain */
+static const String _sectionEndSymbol = "}";
+
+/** the list of all symbols structuring a chain title */
+static const StringList _chainSymbolList =
+    StringList::makeBySplit(">/{/|/}", "/");
+
+/** the effect titles of the default effect chain (like in the
+ * plugin) */
+static const String _defaultChainTitle =
+    "SoXFilter > SoXCompander > SoXOverdrive > SoXReverb";
+
+/*--------------------*/
+
+/** the number of frames read per block by the peak measurement */
+static const Natural _peakScanBlockSize = 65536;
+
+/** the number of bytes reserved in the batch arena per channel
+ * buffer in addition to its samples (for the header and alignment of
+ * the storage) */
+static const size_t _batchBufferOverhead = 128;
+
+/** the maximum absolute gain in decibels of a normalization (the
+ * range of the gain effect) */
+static const Real _maximumNormalizingGain = 100.0;
+
+/** the resolution in decibels of the gain of a normalization (the
+ * step of the gain parameter) */
+static const Real _normalizingGainStep = 0.001;
+
+/*--------------------*/
+
+/** the identification at the start of a checkpoint file */
+static const String _checkpointMagic = "SoXRenderCheckpoint";
+
+/** the version of the checkpoint file layout */
+static const Natural _checkpointVersion = 1;
+
+/** the suffix of the file a checkpoint is written to before it
+ * replaces the previous one */
+static const String _temporaryFileSuffix = ".tmp";
+
+/*--------------------*/
+
+const Natural SoXOfflineRenderer::defaultBlockSize = 4096;
+
+const String SoXOfflineRenderer::engineVersion = "1.0";
+
+/*====================*/
+
+/**
+ * A <C>_SoXRenderingContext</C> object holds the data shared by the
+ * processing task and the reading task of a rendering step: two
+ * buffers from the encoder stage are used alternately, one is
+ * processed while the other is filled with the next input block.
+ */
+struct _SoXRenderingContext {
+
+    /** the effect applied */
+    SoXAudioEffect* effect;
+
+    /** the reader for the input file */
+    SoXAudioFileReader* reader;
+
+    /** the number of frames per block */
+    Natural blockSize;
+
+    /** the two alternating sample buffers (slots of the encoder
+     * stage) */
+    AudioSampleListVector* bufferList[2];
+
+    /** the number of valid frames per buffer */
+    Natural frameCountList[2];
+
+    /** the index of the buffer being processed */
+    Natural processingIndex;
+
+    /** the time position of the processed block in seconds */
+    Real timePosition;
+
+};
+
+/*--------------------*/
+
+/**
+ * A <C>_SoXStreamContext</C> object holds the data shared by the
+ * processing task and the transfer task of a streaming step: one
+ * buffer is processed while the other is written to the output
+ * stream (when it holds a processed block) and then filled with the
+ * next block from the input stream.
+ */
+struct _SoXStreamContext {
+
+    /** the effect applied */
+    SoXAudioEffect* effect;
+
+    /** the raw input stream */
+    SoXAudioStream* inputStream;
+
+    /** the raw output stream */
+    SoXAudioStream* outputStream;
+
+    /** the number of frames per block */
+    Natural blockSize;
+
+    /** the two alternating sample buffers */
+    AudioSampleListVector bufferList[2];
+
+    /** the number of valid frames per buffer */
+    Natural frameCountList[2];
+
+    /** the index of the buffer being processed */
+    Natural processingIndex;
+
+    /** tells whether the transfer buffer holds a processed block
+     * not yet written */
+    Boolean hasPendingOutput;
+
+    /** tells whether all writes have been successful */
+    Boolean isOkay;
+
+    /** the time position of the processed block in seconds */
+    Real timePosition;
+
+};
+
+/*--------------------*/
+
+/**
+ * A <C>_SoXSegmentContext</C> object holds the data shared by the
+ * tasks of a segmented rendering: each task renders one segment
+ * with its own effect and reader and writes the output frames of
+ * the segment into the common writer.
+ */
+struct _SoXSegmentContext {
+
+    /** the parameter text defining the effect */
+    String parameterText;
+
+    /** the name of the input audio file */
+    String inputFileName;
+
+    /** tells whether the input file is memory mapped */
+    Boolean inputIsMapped;
+
+    /** the writer for the output file (shared by all segments) */
+    SoXAudioFileWriter* writer;
+
+    /** the lock serializing accesses to writer and error message */
+    std::mutex lock;
+
+    /** the sample rate of the input file */
+    Real sampleRate;
+
+    /** the number of frames per block */
+    Natural blockSize;
+
+    /** the total number of frames of the input file */
+    Natural frameCount;
+
+    /** the number of frames per segment (except for the last) */
+    Natural segmentLength;
+
+    /** the number of frames processed before a segment and
+     * discarded */
+    Natural warmupFrameCount;
+
+    /** tells whether all segments have been successful */
+    std::atomic<bool> isOkay;
+
+    /** the description of the first failure */
+    String errorMessage;
+
+};
+
+/*--------------------*/
+
+/**
+ * A <C>_SoXRenderCheckpoint</C> object holds a checkpoint of a
+ * rendering: the rendering it belongs to, the number of frames
+ * completely written to the output file and the state of the effect
+ * after processing them.
+ */
+struct _SoXRenderCheckpoint {
+
+    /** the name of the input audio file */
+    String inputFileName;
+
+    /** the name of the output audio file */
+    String outputFileName;
+
+    /** the parameter text defining the effect */
+    String parameterText;
+
+    /** the number of frames per block */
+    Natural blockSize;
+
+    /** the number of frames processed and written */
+    Natural framePosition;
+
+    /** the time position after the processed frames in seconds */
+    Real timePosition;
+
+    /** tells whether the effect state is available (otherwise the
+     * processed frames are replayed on resumption) */
+    Boolean hasEffectState;
+
+    /** the effect state after the processed frames */
+    ByteList effectStateData;
+
+};
+
+/*--------------------*/
+/* auxiliary routines */
+/*--------------------*/
+
+/**
+ * Returns <C>effectTitle</C> in a normalized form for comparison:
+ * in lowercase without blanks and with "&" replaced by "and".
+ *
+ * @param[in] effectTitle  plugin or effect name
+ * @return  normalized name
+ */
+static String _normalizedEffectTitle (IN String& effectTitle)
+{
+    String result = STR::toLowercase(STR::strip(effectTitle));
+    STR::replace(result, " ", "");
+    STR::replace(result, "&", "and");
+    return result;
+}
+
+/*--------------------*/
+
+/**
+ * Splits <C>chainTitle</C> into tokens: the chain symbols and the
+ * stripped effect titles in between (omitting empty ones).
+ *
+ * @param[in] chainTitle  effect titles of a chain with symbols
+ * @return  list of tokens in order
+ */
+static StringList _chainTokenList (IN String& chainTitle)
+{
+    StringList result;
+    String effectTitle;
+
+    for (Natural i = 0;  i < chainTitle.length();  i++) {
+        String symbol;
+        STR::append(symbol, STR::characterAt(chainTitle, i));
+
+        if (!_chainSymbolList.contains(symbol)) {
+            effectTitle += symbol;
+        } else {
+            effectTitle = STR::strip(effectTitle);
+
+            if (effectTitle != "") {
+                result.append(effectTitle);
+            }
+
+            result.append(symbol);
+            effectTitle = "";
+        }
+    }
+
+    effectTitle = STR::strip(effectTitle);
+
+    if (effectTitle != "") {
+        result.append(effectTitle);
+    }
+
+    return result;
+}
+
+/*--------------------*/
+
+/**
+ * Processes task <C>taskIndex</C> of a rendering step on
+ * <C>context</C>: task 0 processes the current buffer by the
+ * effect, task 1 fills the other buffer with the next input block.
+ *
+ * @param[inout] context    rendering context
+ * @param[in]    taskIndex  index of task
+ */
+static void _processRenderingTask (INOUT void* context,
+                                   IN Natural taskIndex)
+{
+    _SoXRenderingContext& renderingContext =
+        *static_cast<_SoXRenderingContext*>(context);
+    const size_t processingIndex =
+        (size_t) renderingContext.processingIndex;
+
+    if (taskIndex == 0) {
+        if (renderingContext.frameCountList[processingIndex] > 0) {
+            renderingContext.effect->processBlock(
+                renderingContext.timePosition,
+                *renderingContext.bufferList[processingIndex]);
+        }
+    } else {
+        const size_t transferIndex = 1 - processingIndex;
+        renderingContext.frameCountList[transferIndex] =
+            renderingContext.reader->read(
+                *renderingContext.bufferList[transferIndex],
+                renderingContext.blockSize);
+    }
+}
+
+/*--------------------*/
+
+/**
+ * Processes task <C>taskIndex</C> of a streaming step on
+ * <C>context</C>: task 0 processes the current buffer by the
+ * effect, task 1 writes the other buffer (when pending) to the
+ * output stream and fills it with the next input block.
+ *
+ * @param[inout] context    stream context
+ * @param[in]    taskIndex  index of task
+ */
+static void _processStreamTask (INOUT void* context,
+                                IN Natural taskIndex)
+{
+    _SoXStreamContext& streamContext =
+        *static_cast<_SoXStreamContext*>(context);
+    const size_t processingIndex =
+        (size_t) streamContext.processingIndex;
+
+    if (taskIndex == 0) {
+        if (streamContext.frameCountList[processingIndex] > 0) {
+            streamContext.effect->processBlock(
+                streamContext.timePosition,
+                streamContext.bufferList[processingIndex]);
+        }
+    } else {
+        const size_t transferIndex = 1 - processingIndex;
+        AudioSampleListVector& buffer =
+            streamContext.bufferList[transferIndex];
+
+        if (streamContext.hasPendingOutput) {
+            streamContext.isOkay =
+                (streamContext.outputStream->write(
+                     buffer, streamContext.frameCountList[transferIndex])
+                 && streamContext.isOkay);
+        }
+
+        streamContext.frameCountList[transferIndex] =
+            streamContext.inputStream->read(buffer,
+                                            streamContext.blockSize);
+    }
+}
+
+/*--------------------*/
+
+/**
+ * Makes a new effect and sets its parameters from the parameter
+ * text <C>st</C>; returns nullptr and sets <C>errorMessage</C> when
+ * this fails.
+ *
+ * @param[in]  st            parameter text with title line and
+ *                           key-value lines
+ * @param[out] errorMessage  description of failure
+ * @return  new effect or nullptr
+ */
+static SoXAudioEffect* _makeConfiguredEffect (IN String& st,
+                                              OUT String& errorMessage)
+{
+    Logging_trace1(">>: %1", st);
+
+    const StringList lineList = StringList::makeBySplit(st, "\n");
+    const String effectTitle =
+        (lineList.size() == 0 ? "" : STR::strip(lineList[0]));
+    SoXAudioEffect* effect = SoXOfflineRenderer::makeEffect(effectTitle);
+    Boolean isOkay = (effect != nullptr);
+
+    if (!isOkay) {
+        errorMessage = STR::expand("unknown effect '%1' - must be one"
+                                   " of %2",
+                                   effectTitle,
+                                   SoXOfflineRenderer::effectNameList()
+                                       .join(", "));
+    } else {
+        /* parameters are set in the order of the text, such that a
+           page count parameter precedes the page parameters
+           depending on it */
+        SoXEffectParameterMap& parameterMap =
+            effect->effectParameterMap();
+        SoXPrecisionProfile profile = SoXPrecisionProfile::soxExact;
+
+        for (Natural i = 1;  isOkay && i < lineList.size();  i++) {
+            const String line = STR::strip(lineList[i]);
+            const StringList partList = StringList::makeBySplit(line, "=");
+            const String parameterName =
+                (partList.size() == 2 ? STR::strip(partList[0]) : "");
+            String value =
+                (partList.size() == 2 ? STR::strip(partList[1]) : "");
+
+            if (value.length() >= 2
+                && STR::firstCharacter(value) == _quoteCharacter
+                && STR::lastCharacter(value) == _quoteCharacter) {
+                value = value.substr(1, value.length() - 2);
+            }
+
+            if (line == "") {
+                /* empty lines are ignored */
+            } else if (partList.size() != 2) {
+                isOkay = false;
+                errorMessage = STR::expand("bad parameter line '%1'",
+                                           line);
+            } else if (parameterName == _precisionProfileParameterName) {
+                isOkay = precisionProfileFromString(value, profile);
+                errorMessage =
+                    (isOkay ? errorMessage
+                     : STR::expand("bad precision profile '%1'", value));
+            } else if (!parameterMap.contains(parameterName)) {
+                isOkay = false;
+                errorMessage = STR::expand("unknown parameter '%1'",
+                                           parameterName);
+            } else if (!parameterMap.isAllowedValue(parameterName,
+                                                    value)) {
+                isOkay = false;
+                errorMessage = STR::expand("bad value '%1' for"
+                                           " parameter '%2'",
+                                           value, parameterName);
+            } else {
+                parameterMap.invalidateValue(parameterName);
+                effect->setValue(parameterName, value, true);
+            }
+        }
+
+        /* the profile is applied after the parameters, hence its
+           line may occur anywhere */
+        effect->setPrecisionProfile(profile);
+    }
+
+    if (!isOkay) {
+        delete effect;
+        effect = nullptr;
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return effect;
+}
+
+/*--------------------*/
+
+/**
+ * Tells whether <C>line</C> of a parameter text selects the
+ * precision profile.
+ *
+ * @param[in] line  line of parameter text
+ * @return  information whether line is a precision profile line
+ */
+static Boolean _isPrecisionProfileLine (IN String& line)
+{
+    const StringList partList = StringList::makeBySplit(line, "=");
+    return (partList.size() == 2
+            && STR::strip(partList[0]) == _precisionProfileParameterName);
+}
+
+/*--------------------*/
+
+/**
+ * Returns the parameter text <C>st</C> with its precision profile
+ * lines replaced by a line for <C>profile</C> at the end (or
+ * without such a line for the SoX-exact profile).
+ *
+ * @param[in] st       parameter text
+ * @param[in] profile  precision profile
+ * @return  parameter text selecting <C>profile</C>
+ */
+static String _withPrecisionProfile (IN String& st,
+                                     IN SoXPrecisionProfile profile)
+{
+    const StringList lineList = StringList::makeBySplit(st, "\n");
+    StringList resultLineList;
+
+    for (const String& line : lineList) {
+        if (!_isPrecisionProfileLine(line)) {
+            resultLineList.append(line);
+        }
+    }
+
+    if (profile != SoXPrecisionProfile::soxExact) {
+        resultLineList.append(STR::expand("%1 = \"%2\"",
+                                          _precisionProfileParameterName,
+                                          precisionProfileToString(profile)));
+    }
+
+    return resultLineList.join("\n");
+}
+
+/*--------------------*/
+
+/**
+ * Returns the format for an output file named <C>fileName</C> with
+ * the sample layout of <C>inputFormat</C>: AIFF for an
+ * ".aif"/".aiff" extension and WAV otherwise.
+ *
+ * @param[in] inputFormat  format of the input file
+ * @param[in] fileName     name of output file
+ * @return  format of output file
+ */
+static SoXAudioFileFormat
+_outputFileFormat (IN SoXAudioFileFormat& inputFormat,
+                   IN String& fileName)
+{
+    const String lowercaseName = STR::toLowercase(fileName);
+    SoXAudioFileFormat result = inputFormat;
+    result.kind =
+        (STR::endsWith(lowercaseName, ".aif")
+         || STR::endsWith(lowercaseName, ".aiff")
+         ? SoXAudioFileKind::aiff : SoXAudioFileKind::wav);
+    return result;
+}
+
+/*--------------------*/
+
+/**
+ * Reads the checkpoint file named <C>fileName</C> into
+ * <C>checkpoint</C> and tells whether it exists and is complete.
+ *
+ * @param[in]  fileName    name of checkpoint file
+ * @param[out] checkpoint  checkpoint read
+ * @return  information whether checkpoint has been read
+ */
+static Boolean _readCheckpoint (IN String& fileName,
+                                OUT _SoXRenderCheckpoint& checkpoint)
+{
+    Logging_trace1(">>: %1", fileName);
+
+    File file;
+    Boolean isOkay = file.open(fileName, "rb");
+
+    if (isOkay) {
+        ByteList byteList;
+        file.read(byteList);
+        file.close();
+
+        DspStateStream stream{byteList};
+        String magic;
+        Natural version = 0;
+        stream.readString(magic);
+        stream.read(version);
+        isOkay = (stream.isOkay() && magic == _checkpointMagic
+                  && version == _checkpointVersion);
+
+        if (isOkay) {
+            stream.readString(checkpoint.inputFileName);
+            stream.readString(checkpoint.outputFileName);
+            stream.readString(checkpoint.parameterText);
+            stream.read(checkpoint.blockSize);
+            stream.read(checkpoint.framePosition);
+            stream.read(checkpoint.timePosition);
+            stream.read(checkpoint.hasEffectState);
+            stream.readList(checkpoint.effectStateData);
+            isOkay = (stream.isOkay() && stream.isAtEnd());
+        }
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+
+/**
+ * Writes <C>checkpoint</C> to the checkpoint file named
+ * <C>fileName</C> and tells whether this has been successful; the
+ * previous checkpoint is only replaced by a complete new one.
+ *
+ * @param[in] fileName    name of checkpoint file
+ * @param[in] checkpoint  checkpoint to be written
+ * @return  information whether checkpoint has been written
+ */
+static Boolean _writeCheckpoint (IN String& fileName,
+                                 IN _SoXRenderCheckpoint& checkpoint)
+{
+    Logging_trace2(">>: fileName = %1, framePosition = %2",
+                   fileName, TOSTRING(checkpoint.framePosition));
+
+    DspStateStream stream{};
+    stream.writeString(_checkpointMagic);
+    stream.write(_checkpointVersion);
+    stream.writeString(checkpoint.inputFileName);
+    stream.writeString(checkpoint.outputFileName);
+    stream.writeString(checkpoint.parameterText);
+    stream.write(checkpoint.blockSize);
+    stream.write(checkpoint.framePosition);
+    stream.write(checkpoint.timePosition);
+    stream.write(checkpoint.hasEffectState);
+    stream.writeList(checkpoint.effectStateData);
+
+    const ByteList& byteList = stream.byteList();
+    const Natural byteCount = byteList.length();
+    const String temporaryFileName = fileName + _temporaryFileSuffix;
+    File file;
+    Boolean isOkay = file.open(temporaryFileName, "wb");
+
+    if (isOkay) {
+        isOkay = (file.write(byteList, 0, byteCount) == byteCount
+                  && file.flush());
+        file.close();
+        isOkay = (isOkay && File::rename(temporaryFileName, fileName));
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+
+/**
+ * Brings <C>effect</C> (prepared for <C>sampleRate</C>) and
+ * <C>reader</C> to the position of <C>checkpoint</C> and returns
+ * the time position there in <C>timePosition</C>: the effect state
+ * is restored when available, otherwise the frames before the
+ * checkpoint are processed again in the blocks of the checkpoint
+ * with the output discarded, which reproduces the effect state bit
+ * by bit.  Tells whether this has been successful.
+ *
+ * @param[inout] effect        effect to be resumed
+ * @param[inout] reader        reader for the input file
+ * @param[in]    checkpoint    checkpoint to resume at
+ * @param[in]    sampleRate    sample rate of input file
+ * @param[out]   timePosition  time position of checkpoint
+ * @return  information whether effect has been resumed
+ */
+static Boolean _resumeAtCheckpoint (INOUT SoXAudioEffect* effect,
+                                    INOUT SoXAudioFileReader& reader,
+                                    IN _SoXRenderCheckpoint& checkpoint,
+                                    IN Real sampleRate,
+                                    OUT Real& timePosition)
+{
+    Logging_trace2(">>: framePosition = %1, hasEffectState = %2",
+                   TOSTRING(checkpoint.framePosition),
+                   TOSTRING(checkpoint.hasEffectState));
+
+    Boolean isOkay = true;
+    timePosition = 0.0;
+
+    if (checkpoint.hasEffectState) {
+        isOkay = effect->restoreDspState(checkpoint.effectStateData);
+        reader.setFramePosition(checkpoint.framePosition);
+        timePosition = checkpoint.timePosition;
+    } else {
+        AudioSampleListVector buffer{};
+        Natural framePosition = 0;
+
+        while (isOkay && framePosition < checkpoint.framePosition) {
+            const Natural frameCount =
+                reader.read(buffer, checkpoint.blockSize);
+            isOkay = (frameCount > 0);
+
+            if (isOkay) {
+                effect->processBlock(timePosition, buffer);
+                framePosition += frameCount;
+                timePosition += Real{frameCount} / sampleRate;
+            }
+        }
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+
+/**
+ * Renders segment <C>segmentIndex</C> of a segmented rendering on
+ * <C>context</C>: a fresh effect processes the warm-up frames
+ * before the segment (whose output is discarded) and then the
+ * frames of the segment, which are written at their position in
+ * the output file.
+ *
+ * @param[inout] context       segment context
+ * @param[in]    segmentIndex  index of segment
+ */
+static void _processSegmentTask (INOUT void* context,
+                                 IN Natural segmentIndex)
+{
+    Logging_trace1(">>: %1", TOSTRING(segmentIndex));
+
+    _SoXSegmentContext& segmentContext =
+        *static_cast<_SoXSegmentContext*>(context);
+    const DenormalGuard denormalGuard{};
+    const Natural segmentStart =
+        segmentIndex * segmentContext.segmentLength;
+    const Natural segmentEnd =
+        Natural::minimum(segmentStart + segmentContext.segmentLength,
+                         segmentContext.frameCount);
+    const Natural startFrame =
+        segmentStart - Natural::minimum(segmentStart,
+                                        segmentContext.warmupFrameCount);
+    const Real sampleRate = segmentContext.sampleRate;
+    String errorMessage = "";
+    SoXAudioFileReader reader{};
+    SoXAudioEffect* effect =
+        _makeConfiguredEffect(segmentContext.parameterText,
+                              errorMessage);
+    Boolean isOkay = (effect != nullptr);
+
+    if (isOkay
+        && !reader.open(segmentContext.inputFileName,
+                        segmentContext.inputIsMapped)) {
+        isOkay = false;
+        errorMessage = STR::expand("cannot read audio file %1",
+                                   segmentContext.inputFileName);
+    }
+
+    if (isOkay) {
+        AudioSampleListVector buffer;
+        Natural framePosition = startFrame;
+        effect->prepareToPlay(sampleRate);
+        reader.setFramePosition(startFrame);
+
+        while (isOkay && framePosition < segmentEnd
+               && segmentContext.isOkay.load()) {
+            /* the warm-up blocks end exactly at the segment start,
+               such that no block mixes discarded and kept frames */
+            const Natural limit =
+                (framePosition < segmentStart ? segmentStart
+                 : segmentEnd);
+            const Natural frameCount =
+                reader.read(buffer,
+                            Natural::minimum(segmentContext.blockSize,
+                                             limit - framePosition));
+            isOkay = (frameCount > 0);
+
+            if (!isOkay) {
+                errorMessage =
+                    STR::expand("unexpected end of audio file %1",
+                                segmentContext.inputFileName);
+            } else {
+                effect->processBlock(Real{framePosition} / sampleRate,
+                                     buffer);
+
+                if (framePosition >= segmentStart) {
+                    std::lock_guard<std::mutex>
+                        guard{segmentContext.lock};
+                    isOkay =
+                        segmentContext.writer->writeAt(buffer,
+                                                       frameCount,
+                                                       framePosition);
+                    errorMessage = (isOkay ? ""
+                                    : "write error on audio file");
+                }
+
+                framePosition += frameCount;
+            }
+        }
+
+        effect->releaseResources();
+    }
+
+    delete effect;
+
+    if (!isOkay) {
+        std::lock_guard<std::mutex> guard{segmentContext.lock};
+
+        if (segmentContext.isOkay.load()) {
+            segmentContext.errorMessage = errorMessage;
+            segmentContext.isOkay = false;
+        }
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+}
+
+/*====================*/
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+SoXOfflineRenderer::SoXOfflineRenderer ()
+    : _checkpointFileName{""},
+      _checkpointInterval{0.0},
+      _effect{nullptr},
+      _encoderStatistics{},
+      _encoderThreadCount{1},
+      _errorMessage{""},
+      _inputIsMapped{true},
+      _parameterText{""},
+      _precisionProfile{SoXPrecisionProfile::soxExact},
+      _renderedDuration{0.0}
+{
+    Logging_trace(">>");
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+SoXOfflineRenderer::~SoXOfflineRenderer ()
+{
+    Logging_trace(">>");
+    delete _effect;
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* configuration      */
+/*--------------------*/
+
+Boolean SoXOfflineRenderer::readParameterFile (IN String& fileName)
+{
+    Logging_trace1(">>: %1", fileName);
+
+    File file;
+    Boolean isOkay = file.open(fileName, "rb");
+
+    if (!isOkay) {
+        _errorMessage = STR::expand("cannot open parameter file %1",
+                                    fileName);
+    } else {
+        const StringList lineList = file.readLines();
+        file.close();
+        isOkay = setParameterText(lineList.join("\n"));
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+
+Boolean SoXOfflineRenderer::setParameterText (IN String& st)
+{
+    Logging_trace1(">>: %1", st);
+
+    /* a text without a profile line gets the profile of the
+       renderer */
+    const StringList lineList = StringList::makeBySplit(st, "\n");
+    Boolean hasProfileLine = false;
+
+    for (const String& line : lineList) {
+        hasProfileLine = hasProfileLine || _isPrecisionProfileLine(line);
+    }
+
+    const String text =
+        (hasProfileLine ? st : _withPrecisionProfile(st, _precisionProfile));
+    delete _effect;
+    _effect = _makeConfiguredEffect(text, _errorMessage);
+    const Boolean isOkay = (_effect != nullptr);
+    _parameterText = (isOkay ? text : "");
+
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+
+Boolean SoXOfflineRenderer::setEffectCommand (IN String& command)
+{
+    Logging_trace1(">>: %1", command);
+
+    String parameterText;
+    Boolean isOkay =
+        SoXCommandParser::toParameterText(command, parameterText,
+                                          _errorMessage);
+
+    if (isOkay) {
+        isOkay = setParameterText(parameterText);
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+
+void SoXOfflineRenderer::setPrecisionProfile
+                             (IN SoXPrecisionProfile profile)
+{
+    Logging_trace1(">>: %1", precisionProfileToString(profile));
+
+    _precisionProfile = profile;
+
+    if (_effect != nullptr) {
+        /* the effect is made again, such that the parameter text
+           describes it completely */
+        setParameterText(_withPrecisionProfile(_parameterText, profile));
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXOfflineRenderer::setInputIsMapped (IN Boolean isMapped)
+{
+    Logging_trace1(">>: %1", TOSTRING(isMapped));
+    _inputIsMapped = isMapped;
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXOfflineRenderer::setEncoderThreadCount (IN Natural threadCount)
+{
+    Logging_trace1(">>: %1", TOSTRING(threadCount));
+    _encoderThreadCount = Natural::maximum(1, threadCount);
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXOfflineRenderer::setCheckpointing (IN String& checkpointFileName,
+                                           IN Real interval)
+{
+    Logging_trace2(">>: fileName = %1, interval = %2",
+                   checkpointFileName, TOSTRING(interval));
+    _checkpointFileName = checkpointFileName;
+    _checkpointInterval = Real::maximum(0.0, interval);
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+Boolean SoXOfflineRenderer::setNormalizingGain (IN Real peak,
+                                                IN Real targetLevel)
+{
+    Logging_trace2(">>: peak = %1, targetLevel = %2",
+                   TOSTRING(peak), TOSTRING(targetLevel));
+
+    /* a silent file stays silent, hence it is left unchanged */
+    const Real peakLevel =
+        (peak > Real::zero
+         ? Real{20.0} * peak.log() / Real{10.0}.log()
+         : targetLevel);
+    const Real gain =
+        Real::maximum(-_maximumNormalizingGain,
+                      Real::minimum(_maximumNormalizingGain,
+                                    targetLevel - peakLevel));
+
+    /* the gain is rounded down to the parameter resolution, such
+       that the result never exceeds the target level */
+    const Real roundedGain =
+        Real::floor(gain / _normalizingGainStep) * _normalizingGainStep;
+    const Boolean isOkay =
+        setParameterText(STR::expand("SoXGain\nGain [dB] = \"%1\"",
+                                     roundedGain.toString(0, 3)));
+
+    Logging_trace2("<<: isOkay = %1, gain = %2",
+                   TOSTRING(isOkay), TOSTRING(roundedGain));
+    return isOkay;
+}
+
+/*--------------------*/
+/* processing         */
+/*--------------------*/
+
+Boolean SoXOfflineRenderer::render (IN String& inputFileName,
+                                    IN String& outputFileName,
+                                    IN Natural blockSize)
+{
+    Logging_trace3(">>: input = %1, output = %2, blockSize = %3",
+                   inputFileName, outputFileName, TOSTRING(blockSize));
+
+    const DenormalGuard denormalGuard{};
+    SoXAudioFileReader reader{};
+    SoXAudioFileWriter writer{};
+    Boolean isOkay = (_effect != nullptr && blockSize > 0);
+    _renderedDuration = 0.0;
+
+    /* a checkpoint is only used for exactly the same rendering */
+    const Boolean hasCheckpoints = (_checkpointFileName != "");
+    _SoXRenderCheckpoint checkpoint{};
+    Boolean isResumed =
+        (isOkay && hasCheckpoints
+         && _readCheckpoint(_checkpointFileName, checkpoint)
+         && checkpoint.inputFileName == inputFileName
+         && checkpoint.outputFileName == outputFileName
+         && checkpoint.parameterText == _parameterText
+         && checkpoint.blockSize == blockSize);
+
+    if (!isOkay) {
+        _errorMessage = (_effect == nullptr ? "no effect defined"
+                         : "block size must be positive");
+    } else if (!reader.open(inputFileName, _inputIsMapped)) {
+        isOkay = false;
+        _errorMessage = STR::expand("cannot read audio file %1",
+                                    inputFileName);
+    } else {
+        /* an output file not matching the checkpoint is rendered
+           from the start */
+        const SoXAudioFileFormat outputFormat =
+            _outputFileFormat(reader.format(), outputFileName);
+        isResumed = (isResumed
+                     && writer.reopen(outputFileName, outputFormat,
+                                      checkpoint.framePosition));
+
+        if (!isResumed && !writer.open(outputFileName, outputFormat)) {
+            isOkay = false;
+            _errorMessage = STR::expand("cannot write audio file %1",
+                                        outputFileName);
+        }
+    }
+
+    if (isOkay) {
+        const Real sampleRate = Real{reader.format().sampleRate};
+        _effect->prepareToPlay(sampleRate);
+
+        _SoXRenderingContext context{};
+        context.effect          = _effect;
+        context.reader          = &reader;
+        context.blockSize       = blockSize;
+        context.processingIndex = 0;
+        context.timePosition    = 0.0;
+
+        if (isResumed) {
+            isOkay = _resumeAtCheckpoint(_effect, reader, checkpoint,
+                                         sampleRate,
+                                         context.timePosition);
+        }
+
+        /* the checkpoints are placed at block boundaries after the
+           given audio duration */
+        const Natural checkpointDistance =
+            Natural::maximum(1, Natural{Real::round(_checkpointInterval
+                                                    * sampleRate)});
+        Natural framePosition = writer.frameCount();
+        Natural nextCheckpointPosition =
+            framePosition + checkpointDistance;
+        checkpoint.inputFileName  = inputFileName;
+        checkpoint.outputFileName = outputFileName;
+        checkpoint.parameterText  = _parameterText;
+        checkpoint.blockSize      = blockSize;
+
+        /* the encoding and writing run on the encoder threads, the
+           reading on a worker while the caller processes, hence at
+           least one worker is needed for the overlap */
+        SoXEncoderStage encoderStage{};
+        encoderStage.start(writer, _encoderThreadCount);
+        SoXWorkerPool& workerPool = SoXWorkerPool::instance();
+        workerPool.reserveThreads(1);
+
+        /* prime the first buffer synchronously */
+        context.bufferList[0] = &encoderStage.acquireBuffer();
+        context.frameCountList[0] =
+            (!isOkay ? Natural{0}
+             : reader.read(*context.bufferList[0], blockSize));
+        context.frameCountList[1] = 0;
+
+        while (context.frameCountList[(size_t) context.processingIndex]
+               > 0) {
+            const size_t processingIndex =
+                (size_t) context.processingIndex;
+            const Natural frameCount =
+                context.frameCountList[processingIndex];
+            context.bufferList[1 - processingIndex] =
+                &encoderStage.acquireBuffer();
+            workerPool.run(_processRenderingTask, &context, 2,
+                           blockSize);
+
+            /* the processed buffer goes to the encoders, the other
+               one holds the next input */
+            encoderStage.submit(frameCount);
+            context.timePosition += Real{frameCount} / sampleRate;
+            context.processingIndex = 1 - processingIndex;
+            framePosition += frameCount;
+
+            if (hasCheckpoints
+                && framePosition >= nextCheckpointPosition) {
+                /* the effect state belongs to the submitted frames,
+                   hence these must be in the file before the
+                   checkpoint refers to them; a failing checkpoint
+                   does not stop the rendering */
+                nextCheckpointPosition =
+                    framePosition + checkpointDistance;
+                checkpoint.framePosition = framePosition;
+                checkpoint.timePosition  = context.timePosition;
+                checkpoint.hasEffectState =
+                    _effect->saveDspState(checkpoint.effectStateData);
+
+                if (encoderStage.waitUntilWritten() && writer.flush()) {
+                    _writeCheckpoint(_checkpointFileName, checkpoint);
+                }
+            }
+        }
+
+        /* the buffer with the empty final read is dropped */
+        const Boolean isResumable = isOkay;
+        isOkay = encoderStage.finish() && isResumable;
+        _encoderStatistics = encoderStage.statistics();
+        _effect->releaseResources();
+        _renderedDuration = Real{writer.frameCount()} / sampleRate;
+        writer.close();
+
+        if (!isResumable) {
+            _errorMessage = STR::expand("checkpoint %1 does not fit"
+                                        " the effect",
+                                        _checkpointFileName);
+        } else if (!isOkay) {
+            _errorMessage = STR::expand("write error on audio file %1",
+                                        outputFileName);
+        } else if (hasCheckpoints) {
+            File::remove(_checkpointFileName);
+        }
+    }
+
+    Logging_trace2("<<: isOkay = %1, message = %2",
+                   TOSTRING(isOkay), _errorMessage);
+    return isOkay;
+}
+
+/*--------------------*/
+
+Boolean
+SoXOfflineRenderer::renderBatch (IN StringList& inputFileNameList,
+                                 IN StringList& outputFileNameList,
+                                 IN Natural blockSize)
+{
+    Logging_trace3(">>: inputs = %1, outputs = %2, blockSize = %3",
+                   inputFileNameList.toString(),
+                   outputFileNameList.toString(), TOSTRING(blockSize));
+
+    const DenormalGuard denormalGuard{};
+    const Natural fileCount = inputFileNameList.size();
+    std::unique_ptr<SoXAudioFileReader[]>
+        readerArray{new SoXAudioFileReader[(size_t) fileCount]};
+    std::unique_ptr<SoXAudioFileWriter[]>
+        writerArray{new SoXAudioFileWriter[(size_t) fileCount]};
+    Boolean isOkay = (_effect != nullptr && blockSize > 0
+                      && fileCount > 0
+                      && outputFileNameList.size() == fileCount);
+    Natural batchChannelCount = 0;
+    _renderedDuration = 0.0;
+
+    if (!isOkay) {
+        _errorMessage =
+            (_effect == nullptr ? "no effect defined"
+             : blockSize == 0 ? "block size must be positive"
+             : "input and output files do not correspond");
+    } else if (!_effect->hasIndependentChannels()) {
+        isOkay = false;
+        _errorMessage = "effect cannot render files together";
+    }
+
+    for (Natural i = 0;  isOkay && i < fileCount;  i++) {
+        const String& inputFileName  = inputFileNameList[i];
+        const String& outputFileName = outputFileNameList[i];
+        SoXAudioFileReader& reader = readerArray[(size_t) i];
+
+        if (!reader.open(inputFileName, _inputIsMapped)) {
+            isOkay = false;
+            _errorMessage = STR::expand("cannot read audio file %1",
+                                        inputFileName);
+        } else if (reader.format().sampleRate
+                   != readerArray[0].format().sampleRate) {
+            isOkay = false;
+            _errorMessage = STR::expand("sample rate of %1 differs from"
+                                        " that of %2",
+                                        inputFileName,
+                                        inputFileNameList[0]);
+        } else if (!writerArray[(size_t) i]
+                        .open(outputFileName,
+                              _outputFileFormat(reader.format(),
+                                                outputFileName))) {
+            isOkay = false;
+            _errorMessage = STR::expand("cannot write audio file %1",
+                                        outputFileName);
+        }
+
+        batchChannelCount += reader.format().channelCount;
+    }
+
+    if (isOkay) {
+        const Real sampleRate = Real{readerArray[0].format().sampleRate};
+
+        /* the effect state and the block buffers of all files are
+           touched for every block, hence they lie in an arena with
+           large pages (reducing the TLB misses) which is prefaulted
+           before the first block */
+        const size_t channelByteCount =
+            (size_t) blockSize * sizeof(AudioSample)
+            + _batchBufferOverhead;
+        StateArena batchArena{};
+        batchArena.reserve(((size_t) batchChannelCount * channelByteCount
+                            + (size_t) _effect->memoryFootprint()
+                                               .totalByteCount()),
+                           true);
+        StateArena::Scope arenaScope{batchArena};
+        _effect->prepareToPlay(sampleRate);
+
+        GenericList<AudioSampleListVector> fileBufferList;
+        fileBufferList.setLength(fileCount);
+
+        for (Natural i = 0;  i < fileCount;  i++) {
+            fileBufferList[i]
+                .resizeChannels(readerArray[(size_t) i].format()
+                                    .channelCount,
+                                blockSize);
+        }
+
+        batchArena.prefault(false);
+        NaturalList fileFrameCountList;
+        fileFrameCountList.setLength(fileCount, 0);
+        AudioSampleListVector batchBuffer{};
+        batchBuffer.setLength(batchChannelCount);
+        Real timePosition = 0.0;
+        Boolean isDone = false;
+
+        while (!isDone) {
+            /* the longest file defines the length of the block */
+            Natural frameCount = 0;
+
+            for (Natural i = 0;  i < fileCount;  i++) {
+                fileFrameCountList[i] =
+                    readerArray[(size_t) i].read(fileBufferList[i],
+                                                 blockSize);
+                frameCount =
+                    Natural::maximum(frameCount, fileFrameCountList[i]);
+            }
+
+            isDone = (frameCount == 0);
+
+            if (!isDone) {
+                /* the channels of all files are moved into the batch
+                   buffer without copying; a file that has ended
+                   early contributes silence */
+                Natural batchChannel = 0;
+
+                for (Natural i = 0;  i < fileCount;  i++) {
+                    const Natural fileFrameCount = fileFrameCountList[i];
+
+                    for (AudioSampleList& sampleList : fileBufferList[i]) {
+                        if (fileFrameCount < frameCount) {
+                            sampleList.setLength(frameCount);
+                            sampleList.setToZero(fileFrameCount);
+                        }
+
+                        std::swap(batchBuffer[batchChannel], sampleList);
+                        batchChannel++;
+                    }
+                }
+
+                _effect->processBlock(timePosition, batchBuffer);
+                batchChannel = 0;
+
+                for (Natural i = 0;  i < fileCount;  i++) {
+                    for (AudioSampleList& sampleList : fileBufferList[i]) {
+                        std::swap(batchBuffer[batchChannel], sampleList);
+                        batchChannel++;
+                    }
+
+                    if (fileFrameCountList[i] > 0) {
+                        isOkay =
+                            (writerArray[(size_t) i]
+                                 .write(fileBufferList[i],
+                                        fileFrameCountList[i])
+                             && isOkay);
+                    }
+                }
+
+                timePosition += Real{frameCount} / sampleRate;
+            }
+        }
+
+        _effect->releaseResources();
+
+        for (Natural i = 0;  i < fileCount;  i++) {
+            SoXAudioFileWriter& writer = writerArray[(size_t) i];
+            _renderedDuration += Real{writer.frameCount()} / sampleRate;
+            writer.close();
+        }
+
+        if (!isOkay) {
+            _errorMessage = STR::expand("write error on audio files %1",
+                                        outputFileNameList.join(", "));
+        }
+    }
+
+    Logging_trace2("<<: isOkay = %1, message = %2",
+                   TOSTRING(isOkay), _errorMessage);
+    return isOkay;
+}
+
+/*--------------------*/
+
+Boolean SoXOfflineRenderer::renderStream (IN SoXAudioFileFormat& format,
+                                          IN Natural blockSize)
+{
+    Logging_trace2(">>: format = %1, blockSize = %2",
+                   format.toString(), TOSTRING(blockSize));
+
+    const DenormalGuard denormalGuard{};
+    SoXAudioStream inputStream{};
+    SoXAudioStream outputStream{};
+    Boolean isOkay = (_effect != nullptr && blockSize > 0);
+    _renderedDuration = 0.0;
+
+    if (!isOkay) {
+        _errorMessage = (_effect == nullptr ? "no effect defined"
+                         : "block size must be positive");
+    } else if (!inputStream.open(true, format)
+               || !outputStream.open(false, format)) {
+        isOkay = false;
+        _errorMessage = STR::expand("unsupported raw format %1",
+                                    format.toString());
+    }
+
+    if (isOkay) {
+        const Real sampleRate = Real{format.sampleRate};
+        _effect->prepareToPlay(sampleRate);
+
+        _SoXStreamContext context{};
+        context.effect           = _effect;
+        context.inputStream      = &inputStream;
+        context.outputStream     = &outputStream;
+        context.blockSize        = blockSize;
+        context.processingIndex  = 0;
+        context.hasPendingOutput = false;
+        context.isOkay           = true;
+        context.timePosition     = 0.0;
+
+        /* the writing and reading run on a worker while the caller
+           processes, hence at least one worker is needed for the
+           overlap */
+        SoXWorkerPool& workerPool = SoXWorkerPool::instance();
+        workerPool.reserveThreads(1);
+
+        /* prime the first buffer synchronously */
+        context.frameCountList[0] =
+            inputStream.read(context.bufferList[0], blockSize);
+        context.frameCountList[1] = 0;
+
+        while (context.frameCountList[(size_t) context.processingIndex]
+               > 0) {
+            const size_t processingIndex =
+                (size_t) context.processingIndex;
+            const Natural frameCount =
+                context.frameCountList[processingIndex];
+            workerPool.run(_processStreamTask, &context, 2, blockSize);
+
+            /* the processed buffer is written in the next step while
+               the other one (holding the next input) is processed */
+            context.hasPendingOutput = true;
+            context.timePosition += Real{frameCount} / sampleRate;
+            context.processingIndex = 1 - processingIndex;
+        }
+
+        /* the final processed block is left pending when the input
+           ends */
+        if (context.hasPendingOutput) {
+            const size_t transferIndex =
+                1 - (size_t) context.processingIndex;
+            context.isOkay =
+                (outputStream.write(context.bufferList[transferIndex],
+                                    context.frameCountList[transferIndex])
+                 && context.isOkay);
+        }
+
+        isOkay = context.isOkay;
+        _effect->releaseResources();
+        _renderedDuration = Real{outputStream.frameCount()} / sampleRate;
+        outputStream.close();
+
+        if (!isOkay) {
+            _errorMessage = "write error on standard output";
+        }
+    }
+
+    Logging_trace2("<<: isOkay = %1, message = %2",
+                   TOSTRING(isOkay), _errorMessage);
+    return isOkay;
+}
+
+/*--------------------*/
+
+Boolean SoXOfflineRenderer::renderInSegments (IN String& inputFileName,
+                                              IN String& outputFileName,
+                                              IN Natural segmentCount,
+                                              IN Natural blockSize)
+{
+    Logging_trace4(">>: input = %1, output = %2, segmentCount = %3,"
+                   " blockSize = %4",
+                   inputFileName, outputFileName,
+                   TOSTRING(segmentCount), TOSTRING(blockSize));
+
+    SoXAudioFileReader reader{};
+    Boolean isOkay = (_effect != nullptr && blockSize > 0);
+    Natural frameCount = 0;
+    Real sampleRate = 1.0;
+    Real warmupLength = Real::infinity;
+    Natural effectiveSegmentCount =
+        (segmentCount > 0 ? segmentCount
+         : Natural::maximum(1,
+                            (size_t) std::thread::hardware_concurrency()));
+    _renderedDuration = 0.0;
+
+    if (!isOkay) {
+        _errorMessage = (_effect == nullptr ? "no effect defined"
+                         : "block size must be positive");
+    } else if (!reader.open(inputFileName, _inputIsMapped)) {
+        isOkay = false;
+        _errorMessage = STR::expand("cannot read audio file %1",
+                                    inputFileName);
+    } else {
+        frameCount = reader.frameCount();
+        sampleRate = Real{reader.format().sampleRate};
+        _effect->prepareToPlay(sampleRate);
+        warmupLength = _effect->warmupLength();
+        _effect->releaseResources();
+    }
+
+    /* segments are only worthwhile when each of them is longer
+       than its warm-up and a block, otherwise most of the work is
+       discarded */
+    const Boolean isSegmentable =
+        (isOkay && warmupLength != Real::infinity);
+    const Natural warmupFrameCount =
+        (isSegmentable
+         ? Natural{(size_t) (double) Real::ceiling(warmupLength
+                                                   * sampleRate)}
+         : Natural{0});
+
+    if (isSegmentable) {
+        effectiveSegmentCount =
+            Natural::maximum(1,
+                             Natural::minimum(effectiveSegmentCount,
+                                              frameCount
+                                              / Natural::maximum(
+                                                  blockSize,
+                                                  warmupFrameCount)));
+    }
+
+    if (isOkay && (!isSegmentable || effectiveSegmentCount == 1)) {
+        reader.close();
+        Logging_trace("--: rendering serially");
+        isOkay = render(inputFileName, outputFileName, blockSize);
+    } else if (isOkay) {
+        SoXAudioFileWriter writer{};
+
+        if (!writer.open(outputFileName,
+                         _outputFileFormat(reader.format(),
+                                           outputFileName))) {
+            isOkay = false;
+            _errorMessage = STR::expand("cannot write audio file %1",
+                                        outputFileName);
+        } else {
+            /* the segment count is adapted such that no segment is
+               empty */
+            const Natural segmentLength =
+                (frameCount + effectiveSegmentCount - 1)
+                / effectiveSegmentCount;
+            effectiveSegmentCount =
+                (frameCount + segmentLength - 1) / segmentLength;
+
+            _SoXSegmentContext context{};
+            context.parameterText    = _parameterText;
+            context.inputFileName    = inputFileName;
+            context.inputIsMapped    = _inputIsMapped;
+            context.writer           = &writer;
+            context.sampleRate       = sampleRate;
+            context.blockSize        = blockSize;
+            context.frameCount       = frameCount;
+            context.segmentLength    = segmentLength;
+            context.warmupFrameCount = warmupFrameCount;
+            context.isOkay           = true;
+            context.errorMessage     = "";
+            reader.close();
+
+            SoXWorkerPool& workerPool = SoXWorkerPool::instance();
+            workerPool.reserveThreads(effectiveSegmentCount - 1);
+            workerPool.run(_processSegmentTask, &context,
+                           effectiveSegmentCount, frameCount);
+
+            isOkay = context.isOkay.load();
+
+            if (!isOkay) {
+                _errorMessage = STR::expand("%1 (rendering %2)",
+                                            context.errorMessage,
+                                            outputFileName);
+            }
+
+            _renderedDuration = Real{writer.frameCount()} / sampleRate;
+            writer.close();
+        }
+    }
+
+    Logging_trace2("<<: isOkay = %1, message = %2",
+                   TOSTRING(isOkay), _errorMessage);
+    return isOkay;
+}
+
+/*--------------------*/
+
+Boolean SoXOfflineRenderer::measurePeak (IN String& inputFileName,
+                                         OUT Real& peak)
+{
+    Logging_trace1(">>: %1", inputFileName);
+
+    const Kernels& kernels = Kernels::current();
+    SoXAudioFileReader reader{};
+    const Boolean isOkay = reader.open(inputFileName, _inputIsMapped);
+    double maximum = 0.0;
+
+    if (!isOkay) {
+        _errorMessage = STR::expand("cannot read audio file %1",
+                                    inputFileName);
+    } else {
+        AudioSampleListVector buffer;
+        Natural frameCount = reader.read(buffer, _peakScanBlockSize);
+
+        while (frameCount > 0) {
+            for (const AudioSampleList& sampleList : buffer) {
+                const double channelPeak =
+                    kernels.peakDouble((const double*) sampleList.asArray(),
+                                       (size_t) frameCount);
+                maximum = (channelPeak > maximum ? channelPeak : maximum);
+            }
+
+            frameCount = reader.read(buffer, _peakScanBlockSize);
+        }
+    }
+
+    peak = Real{maximum};
+    Logging_trace2("<<: isOkay = %1, peak = %2",
+                   TOSTRING(isOkay), TOSTRING(peak));
+    return isOkay;
+}
+
+/*--------------------*/
+
+Boolean SoXOfflineRenderer::renderNormalized (IN String& inputFileName,
+                                              IN String& outputFileName,
+                                              IN Real targetLevel,
+                                              IN Natural blockSize)
+{
+    Logging_trace4(">>: input = %1, output = %2, targetLevel = %3,"
+                   " blockSize = %4",
+                   inputFileName, outputFileName,
+                   TOSTRING(targetLevel), TOSTRING(blockSize));
+
+    Real peak;
+    const Boolean isOkay =
+        (measurePeak(inputFileName, peak)
+         && setNormalizingGain(peak, targetLevel)
+         && render(inputFileName, outputFileName, blockSize));
+
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+/* queries            */
+/*--------------------*/
+
+String SoXOfflineRenderer::errorMessage () const
+{
+    return _errorMessage;
+}
+
+/*--------------------*/
+
+Real SoXOfflineRenderer::renderedDuration () const
+{
+    return _renderedDuration;
+}
+
+/*--------------------*/
+
+SoXEncoderStageStatistics SoXOfflineRenderer::encoderStatistics () const
+{
+    return _encoderStatistics;
+}
+
+/*--------------------*/
+
+Boolean SoXOfflineRenderer::hasIndependentChannels () const
+{
+    return (_effect != nullptr && _effect->hasIndependentChannels());
+}
+
+/*--------------------*/
+
+ByteList SoXOfflineRenderer::parameterState () const
+{
+    Logging_trace(">>");
+
+    DspStateStream stream{};
+
+    if (_effect != nullptr) {
+        const StringList lineList =
+            StringList::makeBySplit(_parameterText, "\n");
+        const StringList effectTitleList =
+            StringList::makeBySplit(lineList[0], _chainSeparator);
+        const SoXEffectParameterMap& parameterMap =
+            _effect->effectParameterMap();
+        const StringList parameterNameList =
+            parameterMap.parameterNameList();
+
+        for (const String& effectTitle : effectTitleList) {
+            stream.writeString(_normalizedEffectTitle(effectTitle));
+        }
+
+        /* the profile is not part of the parameter map */
+        for (const String& line : lineList) {
+            if (_isPrecisionProfileLine(line)) {
+                stream.writeString(STR::strip(line));
+            }
+        }
+
+        for (const String& parameterName : parameterNameList) {
+            stream.writeString(parameterName);
+            stream.writeString(parameterMap.value(parameterName));
+        }
+    }
+
+    const ByteList result = stream.byteList();
+    Logging_trace1("<<: byteCount = %1", TOSTRING(result.length()));
+    return result;
+}
+
+/*--------------------*/
+
+String SoXOfflineRenderer::parameterText () const
+{
+    return _parameterText;
+}
+
+/*--------------------*/
+
+StringList SoXOfflineRenderer::effectNameList ()
+{
+    StringList result;
+    result.append("SoXCompander");
+    result.append("SoXEffectChain");
+    result.append("SoXFilter");
+    result.append("SoXGain");
+    result.append("SoXOverdrive");
+    result.append("SoXPhaserAndTremolo");
+    result.append("SoXReverb");
+    return result;
+}
+
+/*--------------------*/
+
+SoXAudioEffect* SoXOfflineRenderer::makeEffect (IN String& effectTitle)
+{
+    Logging_trace1(">>: %1", effectTitle);
+
+    const String name = _normalizedEffectTitle(effectTitle);
+    SoXAudioEffect* result = nullptr;
+
+    if (name == "soxeffectchain" || STR::contains(name, _chainSeparator)
+        || STR::contains(name, _sectionStartSymbol)) {
+        result = makeEffectChain(name == "soxeffectchain"
+                                 ? _defaultChainTitle : effectTitle);
+    } else if (name == "soxcompander") {
+        result = new SoXCompander_AudioEffect{};
+    } else if (name == "soxfilter") {
+        result = new SoXFilter_AudioEffect{};
+    } else if (name == "soxgain") {
+        result = new SoXGain_AudioEffect{};
+    } else if (name == "soxoverdrive") {
+        result = new SoXOverdrive_AudioEffect{};
+    } else if (name == "soxphaserandtremolo") {
+        result = new SoXPhaserAndTremolo_AudioEffect{};
+    } else if (name == "soxreverb") {
+        result = new SoXReverb_AudioEffect{};
+    }
+
+    if (result != nullptr) {
+        result->setDefaultValues();
+        result->setParameterValidity(true);
+
+        /* the defaults only reach the parameter map, hence they are
+           applied to the effect like a host does when instantiating
+           the plugin */
+        SoXEffectParameterMap& parameterMap =
+            result->effectParameterMap();
+        const StringList parameterNameList =
+            parameterMap.parameterNameList();
+
+        for (const String& parameterName : parameterNameList) {
+            const String value = parameterMap.value(parameterName);
+            parameterMap.invalidateValue(parameterName);
+            result->setValue(parameterName, value, true);
+        }
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(result != nullptr));
+    return result;
+}
+
+/*--------------------*/
+
+SoXAudioEffect*
+SoXOfflineRenderer::makeEffectChain (IN String& chainTitle)
+{
+    Logging_trace1(">>: %1", chainTitle);
+
+    const StringList tokenList = _chainTokenList(chainTitle);
+    SoXEffectChain_AudioEffect* chain = new SoXEffectChain_AudioEffect{};
+    Boolean isOkay = true;
+    Boolean sectionIsOpen = false;
+
+    /* tells whether an effect title (or a section start) may come
+       next and whether it must come next (after a separator) */
+    Boolean titleIsAllowed = true;
+    Boolean titleIsRequired = false;
+
+    for (Natural i = 0;  isOkay && i < tokenList.size();  i++) {
+        const String& token = tokenList[i];
+
+        if (token == _chainSeparator) {
+            isOkay = !titleIsAllowed;
+            titleIsAllowed  = true;
+            titleIsRequired = true;
+        } else if (token == _sectionStartSymbol) {
+            /* sections are not nested */
+            isOkay = (titleIsAllowed && !sectionIsOpen);
+            chain->beginParallelSection();
+            sectionIsOpen   = true;
+            titleIsAllowed  = true;
+            titleIsRequired = false;
+        } else if (token == _branchSeparator
+                   || token == _sectionEndSymbol) {
+            /* a branch may be empty, but not end in a separator */
+            isOkay = (sectionIsOpen && !titleIsRequired);
+            const Boolean isSectionEnd = (token == _sectionEndSymbol);
+
+            if (isSectionEnd) {
+                chain->endParallelSection();
+            } else {
+                chain->beginBranch();
+            }
+
+            sectionIsOpen   = !isSectionEnd;
+            titleIsAllowed  = !isSectionEnd;
+            titleIsRequired = false;
+        } else {
+            const String name = _normalizedEffectTitle(token);
+
+            /* chains are not nested */
+            SoXAudioEffect* effect =
+                (!titleIsAllowed || name == "soxeffectchain" ? nullptr
+                 : makeEffect(token));
+            isOkay = (effect != nullptr);
+
+            if (isOkay) {
+                chain->appendEffect(effect);
+            }
+
+            titleIsAllowed  = false;
+            titleIsRequired = false;
+        }
+    }
+
+    isOkay = (isOkay && !sectionIsOpen && !titleIsAllowed);
+
+    if (!isOkay) {
+        delete chain;
+        chain = nullptr;
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(chain != nullptr));
+    return chain;
+}
+
+/*--------------------*/
+
+SoXAudioEffect*
+SoXOfflineRenderer::makeConfiguredEffect (IN String& st,
+                                          OUT String& errorMessage)
+{
+    return _makeConfiguredEffect(st, errorMessage);
+}
+
+/*--------------------*/
+
+SoXAudioFileFormat
+SoXOfflineRenderer::outputFileFormat (IN SoXAudioFileFormat& inputFormat,
+                                      IN String& fileName)
+{
+    return _outputFileFormat(inputFormat, fileName);
+}
@@ -0,0 +1,532 @@
+/**
+ * @file
+ * The <C>SoXOfflineRenderer</C> specification defines a renderer
+ * applying a single SoX effect to an audio file without a DAW; the
+ * effect and its parameters are given by a parameter text in the
+ * key-value form of the plugin state.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXAudioEffect.h"
+#include "SoXEncoderStage.h"
+#include "StringList.h"
+
+/*--------------------*/
+
+using BaseTypes::Containers::StringList;
+using SoXPlugins::Effects::SoXAudioEffect;
+
+/*====================*/
+
+namespace SoXPlugins::Renderer {
+
+    /**
+     * A <C>SoXOfflineRenderer</C> object streams an audio file
+     * block by block through a SoX effect into another audio file
+     * with memory bounded by the block size.  Processing is
+     * pipelined: while block <I>n</I> is processed, the input of
+     * block <I>n+1</I> is read on a worker thread and the output of
+     * the preceding blocks is encoded and written by the encoder
+     * threads of a <C>SoXEncoderStage</C>, which hold at most a few
+     * blocks before the processing waits for them.
+     *
+     * The parameter text has the effect title in its first line
+     * (either the plugin name like "SoXReverb" or the effect name
+     * like "SoX Reverb") followed by lines <C>name = "value"</C> for
+     * the parameters deviating from the effect defaults.  A chain of
+     * effects processed in place is given by effect titles separated
+     * by ">" (like "SoXFilter > SoXGain") or by "SoXEffectChain"
+     * for the chain of the plugin; the chain parameters have the
+     * stage number as prefix (like "2: Gain [dB]").  A parallel
+     * section of a chain encloses its branches in braces separated
+     * by "|", where an empty branch passes the signal unchanged
+     * (like "SoXFilter > { SoXCompander | } > SoXReverb" for a
+     * parallel compression).  A line <C>Precision Profile =
+     * "fast"</C> (or "highQuality" or "soxExact", the default)
+     * selects the precision profile of all effects (see
+     * <C>SoXPrecisionProfile</C>); because it is part of the text,
+     * segments, render nodes, checkpoints and the render cache
+     * use the same profile.
+     */
+    struct SoXOfflineRenderer {
+
+        /** the default number of frames per block */
+        static const Natural defaultBlockSize;
+
+        /** the version of the rendering engine; it identifies the
+         * processing of the effects and must be changed whenever
+         * some effect renders different output for the same
+         * parameters */
+        static const String engineVersion;
+
+        /*--------------------*/
+        /* con-/destruction   */
+        /*--------------------*/
+
+        /**
+         * Makes a renderer without an effect.
+         */
+        SoXOfflineRenderer ();
+
+        /*--------------------*/
+
+        /**
+         * Destroys renderer and its effect.
+         */
+        ~SoXOfflineRenderer ();
+
+        /*--------------------*/
+
+        SoXOfflineRenderer (IN SoXOfflineRenderer&) = delete;
+
+        /*--------------------*/
+        /* configuration      */
+        /*--------------------*/
+
+        /**
+         * Makes the effect and sets its parameters from the
+         * parameter file named <C>fileName</C>; tells whether this
+         * has been successful.
+         *
+         * @param[in] fileName  name of parameter file
+         * @return  information whether effect has been set up
+         */
+        Boolean readParameterFile (IN String& fileName);
+
+        /*--------------------*/
+
+        /**
+         * Makes the effect and sets its parameters from the
+         * parameter text <C>st</C>; tells whether this has been
+         * successful.
+         *
+         * @param[in] st  parameter text with title line and
+         *                key-value lines
+         * @return  information whether effect has been set up
+         */
+        Boolean setParameterText (IN String& st);
+
+        /*--------------------*/
+
+        /**
+         * Makes the effect chain from the SoX effect command
+         * <C>command</C> (like "gain -3 highpass 80 reverb 50") and
+         * tells whether this has been successful.
+         *
+         * @param[in] command  SoX effect names with their arguments
+         * @return  information whether effect has been set up
+         */
+        Boolean setEffectCommand (IN String& command);
+
+        /*--------------------*/
+
+        /**
+         * Sets the precision profile of the effect to
+         * <C>profile</C>: the parameter text of the current effect
+         * and of effects set up later gets the corresponding
+         * profile line (unless such a text has a profile line of
+         * its own).
+         *
+         * @param[in] profile  precision profile of effect
+         */
+        void setPrecisionProfile (IN SoXPrecisionProfile profile);
+
+        /*--------------------*/
+
+        /**
+         * Defines whether input files shall be memory mapped (when
+         * supported by the platform, the default) or read by
+         * buffered I/O depending on <C>isMapped</C>.
+         *
+         * @param[in] isMapped  information whether input files are
+         *                      memory mapped
+         */
+        void setInputIsMapped (IN Boolean isMapped);
+
+        /*--------------------*/
+
+        /**
+         * Sets the number of encoder threads writing the output of
+         * <C>render</C> to <C>threadCount</C> (at least one, the
+         * default); more threads encode consecutive blocks in
+         * parallel.
+         *
+         * @param[in] threadCount  number of encoder threads
+         */
+        void setEncoderThreadCount (IN Natural threadCount);
+
+        /*--------------------*/
+
+        /**
+         * Lets <C>render</C> write a checkpoint to the file named
+         * <C>checkpointFileName</C> after each <C>interval</C>
+         * seconds of audio (an empty name switches checkpoints off,
+         * the default).  A checkpoint records the frames completely
+         * written to the output file and the state of the effect
+         * after them; when a rendering with the same files,
+         * parameter text and block size finds a checkpoint, it
+         * resumes there and continues bit-identically to an
+         * uninterrupted rendering.  The checkpoint file is removed
+         * when the rendering is complete.
+         *
+         * Effects without support for saving their state (like
+         * the compander and the reverb) are brought to the
+         * checkpoint by processing the input before it again with
+         * the output discarded.
+         *
+         * @param[in] checkpointFileName  name of checkpoint file
+         * @param[in] interval            audio duration in seconds
+         *                                between checkpoints
+         */
+        void setCheckpointing (IN String& checkpointFileName,
+                               IN Real interval);
+
+        /*--------------------*/
+
+        /**
+         * Makes a gain effect normalizing a file with maximum
+         * magnitude <C>peak</C> to the level <C>targetLevel</C> in
+         * decibels (like "gain -n" of SoX); the gain is limited to
+         * the range of the gain effect and a silent file is left
+         * unchanged.  Tells whether this has been successful.
+         *
+         * @param[in] peak         maximum magnitude of the file
+         * @param[in] targetLevel  the peak level of the result in
+         *                         decibels full scale
+         * @return  information whether effect has been set up
+         */
+        Boolean setNormalizingGain (IN Real peak,
+                                    IN Real targetLevel);
+
+        /*--------------------*/
+        /* processing         */
+        /*--------------------*/
+
+        /**
+         * Renders the audio file named <C>inputFileName</C> through
+         * the effect into the file <C>outputFileName</C> in blocks
+         * of <C>blockSize</C> frames; the output has the sample
+         * layout of the input and is written as AIFF for an
+         * ".aif"/".aiff" extension and as WAV otherwise.  When
+         * checkpoints are active, an interrupted rendering is
+         * resumed (see <C>setCheckpointing</C>).  Tells whether
+         * rendering has been successful.
+         *
+         * @param[in] inputFileName   name of input audio file
+         * @param[in] outputFileName  name of output audio file
+         * @param[in] blockSize       number of frames per block
+         * @return  information whether rendering has been successful
+         */
+        Boolean render (IN String& inputFileName,
+                        IN String& outputFileName,
+                        IN Natural blockSize = defaultBlockSize);
+
+        /*--------------------*/
+
+        /**
+         * Renders each audio file in <C>inputFileNameList</C> into
+         * the file at the same position in
+         * <C>outputFileNameList</C> like <C>render</C>, but all
+         * files are processed in lockstep by the single effect
+         * instance: the channels of all files form one buffer, file
+         * after file, such that the multichannel kernels of the
+         * effect (like the four channel biquad of the filter)
+         * process corresponding samples of several files in their
+         * lanes.  This needs an effect with independent channels and
+         * input files with the same sample rate; the channels of a
+         * file ending early are fed with silence.  The outputs are
+         * identical to separate renderings with fresh effects; tells
+         * whether rendering has been successful.  The effect state
+         * and the block buffers lie in a prefaulted arena with large
+         * pages (where the system provides them).
+         *
+         * @param[in] inputFileNameList   names of input audio files
+         * @param[in] outputFileNameList  names of output audio files
+         * @param[in] blockSize           number of frames per block
+         * @return  information whether rendering has been successful
+         */
+        Boolean renderBatch (IN StringList& inputFileNameList,
+                             IN StringList& outputFileNameList,
+                             IN Natural blockSize = defaultBlockSize);
+
+        /*--------------------*/
+
+        /**
+         * Renders interleaved raw samples with <C>format</C> from
+         * standard input through the effect to standard output in
+         * blocks of <C>blockSize</C> frames until the input ends;
+         * the samples are converted directly between the pipes and
+         * the block buffers, and while a block is processed, the
+         * preceding block is written and the next one read on a
+         * worker thread.  Tells whether rendering has been
+         * successful.
+         *
+         * @param[in] format     sample layout of both streams (a
+         *                       little-endian raw format)
+         * @param[in] blockSize  number of frames per block
+         * @return  information whether rendering has been successful
+         */
+        Boolean renderStream (IN SoXAudioFileFormat& format,
+                              IN Natural blockSize = defaultBlockSize);
+
+        /*--------------------*/
+
+        /**
+         * Renders the audio file named <C>inputFileName</C> like
+         * <C>render</C>, but splits it into <C>segmentCount</C>
+         * segments (zero selects the number of hardware threads)
+         * rendered concurrently, each by a fresh effect instance.
+         * Each segment is preceded by a pre-roll of the warm-up
+         * length of the effect whose output is discarded; when the
+         * effect cannot be segmented or the file is too short for
+         * segments longer than the pre-roll, the file is rendered
+         * serially.  Tells whether rendering has been successful.
+         *
+         * The result differs from a serial rendering only by the
+         * residue of the initial effect state after the pre-roll,
+         * which is below the silence threshold of -120dB (so
+         * stateless effects give identical output); effects with
+         * an LFO (like the tremolo) reproduce their phase from the
+         * time position.
+         *
+         * @param[in] inputFileName   name of input audio file
+         * @param[in] outputFileName  name of output audio file
+         * @param[in] segmentCount    number of segments (zero for
+         *                            automatic)
+         * @param[in] blockSize       number of frames per block
+         * @return  information whether rendering has been successful
+         */
+        Boolean renderInSegments (IN String& inputFileName,
+                                  IN String& outputFileName,
+                                  IN Natural segmentCount = 0,
+                                  IN Natural blockSize = defaultBlockSize);
+
+        /*--------------------*/
+
+        /**
+         * Returns in <C>peak</C> the maximum magnitude of all
+         * samples of the audio file named <C>inputFileName</C> and
+         * tells whether the file could be read; this pass only
+         * reads the (possibly memory mapped) file and is bound by
+         * its I/O.
+         *
+         * @param[in]  inputFileName  name of input audio file
+         * @param[out] peak           maximum magnitude of samples
+         * @return  information whether file has been read
+         */
+        Boolean measurePeak (IN String& inputFileName,
+                             OUT Real& peak);
+
+        /*--------------------*/
+
+        /**
+         * Normalizes the audio file named <C>inputFileName</C> to
+         * the peak level <C>targetLevel</C> in decibels into the
+         * file <C>outputFileName</C> in two passes: the first
+         * measures the peak, the second renders the file through a
+         * gain effect with the derived gain (which replaces the
+         * current effect).  Tells whether rendering has been
+         * successful.
+         *
+         * @param[in] inputFileName   name of input audio file
+         * @param[in] outputFileName  name of output audio file
+         * @param[in] targetLevel     the peak level of the result
+         *                            in decibels full scale
+         * @param[in] blockSize       number of frames per block
+         * @return  information whether rendering has been successful
+         */
+        Boolean renderNormalized (IN String& inputFileName,
+                                  IN String& outputFileName,
+                                  IN Real targetLevel = 0.0,
+                                  IN Natural blockSize = defaultBlockSize);
+
+        /*--------------------*/
+        /* queries            */
+        /*--------------------*/
+
+        /**
+         * Returns the description of the last failure.
+         *
+         * @return  error message (empty when there was no failure)
+         */
+        String errorMessage () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the duration of the audio rendered by the last
+         * call of <C>render</C> or <C>renderStream</C> (summed over
+         * all files for <C>renderBatch</C>).
+         *
+         * @return  rendered duration in seconds
+         */
+        Real renderedDuration () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the statistics of the processing and output
+         * stages of the last call of <C>render</C>.
+         *
+         * @return  encoder stage statistics
+         */
+        SoXEncoderStageStatistics encoderStatistics () const;
+
+        /*--------------------*/
+
+        /**
+         * Tells whether the current effect processes its channels
+         * independently, hence several files can be rendered
+         * together by <C>renderBatch</C>.
+         *
+         * @return  information whether effect can render batches
+         */
+        Boolean hasIndependentChannels () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the parameter state of the current effect in the
+         * binary form of a <C>DspStateStream</C>: the normalized
+         * effect titles followed by all parameter names with their
+         * values in the order of the effect.  Parameter texts
+         * defining the same effect settings (regardless of layout,
+         * order or omitted defaults) give the same state.
+         *
+         * @return  binary parameter state (empty without effect)
+         */
+        ByteList parameterState () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the parameter text the current effect has been
+         * made from (in the form of <C>setParameterText</C>).
+         *
+         * @return  parameter text (empty without effect)
+         */
+        String parameterText () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the list of effect names accepted in the title
+         * line of a parameter text.
+         *
+         * @return  list of plugin names of all effects
+         */
+        static StringList effectNameList ();
+
+        /*--------------------*/
+
+        /**
+         * Makes a new effect for title <C>effectTitle</C> (compared
+         * case-insensitively ignoring blanks, with "&" standing for
+         * "and"); a title with several effects makes an effect chain
+         * via <C>makeEffectChain</C>.  Returns nullptr for an unknown
+         * title.
+         *
+         * @param[in] effectTitle  plugin or effect name of effect
+         * @return  new effect with default values or nullptr
+         */
+        static SoXAudioEffect* makeEffect (IN String& effectTitle);
+
+        /*--------------------*/
+
+        /**
+         * Makes a new effect chain for <C>chainTitle</C> consisting
+         * of effect titles separated by ">" and parallel sections
+         * (branches separated by "|" in braces, not nested); the
+         * stages are made by <C>makeEffect</C> and the serial ones
+         * are processed in place on a single buffer.  Returns
+         * nullptr when some title is unknown or the structure is
+         * malformed.
+         *
+         * @param[in] chainTitle  effect titles of stages in order
+         * @return  new effect chain with default values or nullptr
+         */
+        static SoXAudioEffect* makeEffectChain (IN String& chainTitle);
+
+        /*--------------------*/
+
+        /**
+         * Makes a new effect from the parameter text <C>st</C> (in
+         * the form of <C>setParameterText</C>) with all its
+         * parameters set; returns nullptr and sets
+         * <C>errorMessage</C> when the text is not valid.
+         *
+         * @param[in]  st            parameter text with title line
+         *                           and key-value lines
+         * @param[out] errorMessage  description of failure
+         * @return  new configured effect or nullptr
+         */
+        static SoXAudioEffect* makeConfiguredEffect (IN String& st,
+                                                     OUT String&
+                                                     errorMessage);
+
+        /*--------------------*/
+
+        /**
+         * Returns the format for an output file named
+         * <C>fileName</C> with the sample layout of
+         * <C>inputFormat</C> as used by <C>render</C>: AIFF for an
+         * ".aif"/".aiff" extension and WAV otherwise.
+         *
+         * @param[in] inputFormat  format of the input file
+         * @param[in] fileName     name of output file
+         * @return  format of output file
+         */
+        static SoXAudioFileFormat
+        outputFileFormat (IN SoXAudioFileFormat& inputFormat,
+                          IN String& fileName);
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the name of the checkpoint file of <C>render</C>
+             * (empty for no checkpoints) */
+            String _checkpointFileName;
+
+            /** the audio duration in seconds between checkpoints */
+            Real _checkpointInterval;
+
+            /** the effect applied */
+            SoXAudioEffect* _effect;
+
+            /** the statistics of the stages of the last rendering */
+            SoXEncoderStageStatistics _encoderStatistics;
+
+            /** the number of encoder threads for the output */
+            Natural _encoderThreadCount;
+
+            /** the description of the last failure */
+            String _errorMessage;
+
+            /** tells whether input files are memory mapped */
+            Boolean _inputIsMapped;
+
+            /** the parameter text the effect has been made from */
+            String _parameterText;
+
+            /** the precision profile for parameter texts without a
+             * profile line */
+            SoXPrecisionProfile _precisionProfile;
+
+            /** the duration of the last rendered file in seconds */
+            Real _renderedDuration;
+
+    };
+
+}
@@ -0,0 +1,538 @@
+/**
+ * @file
+ * The <C>SoXRenderCache</C> body implements a content-addressed
+ * cache of rendered audio files in a directory, such that renderings
+ * of unchanged inputs with unchanged effect settings can be skipped.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXRenderCache.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+#include <thread>
+#include "DspStateStream.h"
+#include "File.h"
+#include "GenericList.h"
+#include "Logging.h"
+#include "OperatingSystem.h"
+#include "SoXOfflineRenderer.h"
+
+/*--------------------*/
+
+using Audio::DspStateStream;
+using BaseModules::File;
+using BaseModules::OperatingSystem;
+using BaseTypes::Containers::StringList;
+using BaseTypes::GenericTypes::GenericList;
+using SoXPlugins::Renderer::SoXOfflineRenderer;
+using SoXPlugins::Renderer::SoXRenderCache;
+using SoXPlugins::Renderer::SoXRenderCacheEvictionPolicy;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
+
+/*====================*/
+
+/** the number of bytes copied or hashed at once */
+static const Natural _chunkByteCount = 1024 * 1024;
+
+/** the extension of cache entry files */
+static const String _entryExtension = ".cache";
+
+/** the extension of cache entry files while being written */
+static const String _temporaryExtension = ".tmp";
+
+/*====================*/
+
+/**
+ * A <C>_Sha256</C> object calculates the SHA-256 digest (FIPS 180-4)
+ * of a byte sequence handed over in arbitrary pieces.
+ */
+struct _Sha256 {
+
+    /** the chaining state */
+    std::uint32_t state[8];
+
+    /** the pending bytes of an incomplete block */
+    std::uint8_t block[64];
+
+    /** the number of pending bytes in block */
+    size_t blockLength;
+
+    /** the total number of bytes hashed */
+    std::uint64_t byteCount;
+
+    /*--------------------*/
+
+    /**
+     * Makes a digest for an empty byte sequence.
+     */
+    _Sha256 ()
+        : state{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19},
+          block{},
+          blockLength{0},
+          byteCount{0}
+    {
+    }
+
+    /*--------------------*/
+
+    /**
+     * Appends the <C>count</C> bytes at <C>data</C> to the hashed
+     * sequence.
+     *
+     * @param[in] data   start of bytes
+     * @param[in] count  number of bytes
+     */
+    void update (IN std::uint8_t* data, IN size_t count)
+    {
+        byteCount += count;
+
+        for (size_t i = 0;  i < count;  i++) {
+            block[blockLength++] = data[i];
+
+            if (blockLength == 64) {
+                _compress();
+                blockLength = 0;
+            }
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Appends the raw representation of <C>byteList</C> with its
+     * length to the hashed sequence.
+     *
+     * @param[in] byteList  bytes to be hashed
+     */
+    void updateWithList (IN ByteList& byteList)
+    {
+        const std::uint64_t length = byteList.size();
+        update((const std::uint8_t*) &length, sizeof(length));
+        update((const std::uint8_t*) byteList.data(), byteList.size());
+    }
+
+    /*--------------------*/
+
+    /**
+     * Finishes the calculation and returns the digest as 64
+     * lowercase hexadecimal digits.
+     *
+     * @return  digest in hexadecimal notation
+     */
+    String hexDigest ()
+    {
+        const std::uint64_t bitCount = byteCount * 8;
+        const std::uint8_t padding = 0x80;
+        const std::uint8_t zero = 0;
+        update(&padding, 1);
+
+        while (blockLength != 56) {
+            update(&zero, 1);
+        }
+
+        for (int i = 7;  i >= 0;  i--) {
+            const std::uint8_t b = (std::uint8_t) (bitCount >> (8 * i));
+            update(&b, 1);
+        }
+
+        const char* hexDigitList = "0123456789abcdef";
+        String result;
+
+        for (const std::uint32_t word : state) {
+            for (int i = 28;  i >= 0;  i -= 4) {
+                result += hexDigitList[(word >> i) & 0xF];
+            }
+        }
+
+        return result;
+    }
+
+    /*--------------------*/
+    /*--------------------*/
+
+    private:
+
+        /**
+         * Returns <C>x</C> rotated right by <C>n</C> bits.
+         *
+         * @param[in] x  word to be rotated
+         * @param[in] n  number of bit positions
+         * @return  rotated word
+         */
+        static std::uint32_t _rotate (IN std::uint32_t x, IN int n)
+        {
+            return (x >> n) | (x << (32 - n));
+        }
+
+        /*--------------------*/
+
+        /**
+         * Processes the complete block into the chaining state.
+         */
+        void _compress ()
+        {
+            static const std::uint32_t k[64] = {
+                0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+                0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+                0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+                0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+                0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+                0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+                0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+                0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+                0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+                0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+                0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+                0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+                0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+                0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+                0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+                0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+            };
+
+            std::uint32_t w[64];
+
+            for (size_t i = 0;  i < 16;  i++) {
+                w[i] = (((std::uint32_t) block[4 * i] << 24)
+                        | ((std::uint32_t) block[4 * i + 1] << 16)
+                        | ((std::uint32_t) block[4 * i + 2] << 8)
+                        | (std::uint32_t) block[4 * i + 3]);
+            }
+
+            for (size_t i = 16;  i < 64;  i++) {
+                const std::uint32_t s0 =
+                    (_rotate(w[i - 15], 7) ^ _rotate(w[i - 15], 18)
+                     ^ (w[i - 15] >> 3));
+                const std::uint32_t s1 =
+                    (_rotate(w[i - 2], 17) ^ _rotate(w[i - 2], 19)
+                     ^ (w[i - 2] >> 10));
+                w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+            }
+
+            std::uint32_t v[8];
+            std::copy(state, state + 8, v);
+
+            for (size_t i = 0;  i < 64;  i++) {
+                const std::uint32_t s1 =
+                    _rotate(v[4], 6) ^ _rotate(v[4], 11) ^ _rotate(v[4], 25);
+                const std::uint32_t choice =
+                    (v[4] & v[5]) ^ (~v[4] & v[6]);
+                const std::uint32_t t1 = v[7] + s1 + choice + k[i] + w[i];
+                const std::uint32_t s0 =
+                    _rotate(v[0], 2) ^ _rotate(v[0], 13) ^ _rotate(v[0], 22);
+                const std::uint32_t majority =
+                    (v[0] & v[1]) ^ (v[0] & v[2]) ^ (v[1] & v[2]);
+                const std::uint32_t t2 = s0 + majority;
+                v[7] = v[6];  v[6] = v[5];  v[5] = v[4];
+                v[4] = v[3] + t1;
+                v[3] = v[2];  v[2] = v[1];  v[1] = v[0];
+                v[0] = t1 + t2;
+            }
+
+            for (size_t i = 0;  i < 8;  i++) {
+                state[i] += v[i];
+            }
+        }
+
+};
+
+/*====================*/
+
+/**
+ * Returns the kind of the output file named <C>fileName</C> as
+ * written by the offline renderer: "aiff" for an ".aif"/".aiff"
+ * extension and "wav" otherwise.
+ *
+ * @param[in] fileName  name of output file
+ * @return  name of output file kind
+ */
+static String _outputKindName (IN String& fileName)
+{
+    const String lowercaseName = STR::toLowercase(fileName);
+    return (STR::endsWith(lowercaseName, ".aif")
+            || STR::endsWith(lowercaseName, ".aiff")
+            ? "aiff" : "wav");
+}
+
+/*--------------------*/
+
+/**
+ * Copies the file named <C>sourceFileName</C> chunk by chunk to
+ * <C>targetFileName</C> and tells whether this has been successful;
+ * on a failure a partial target is removed.
+ *
+ * @param[in] sourceFileName  name of file to be copied
+ * @param[in] targetFileName  name of copy
+ * @return  information whether file has been copied
+ */
+static Boolean _copyFile (IN String& sourceFileName,
+                          IN String& targetFileName)
+{
+    Logging_trace2(">>: source = %1, target = %2",
+                   sourceFileName, targetFileName);
+
+    File sourceFile;
+    File targetFile;
+    Boolean isOkay = (sourceFile.open(sourceFileName, "rb")
+                      && targetFile.open(targetFileName, "wb"));
+    ByteList byteList;
+    Natural byteCount = (isOkay ? _chunkByteCount : 0);
+
+    while (byteCount == _chunkByteCount) {
+        byteCount = sourceFile.read(byteList, 0, _chunkByteCount);
+        isOkay = isOkay && (targetFile.write(byteList, 0, byteCount)
+                            == byteCount);
+        byteCount = (isOkay ? byteCount : Natural{0});
+    }
+
+    isOkay = isOkay && targetFile.flush();
+    sourceFile.closeConditionally();
+    targetFile.closeConditionally();
+
+    if (!isOkay) {
+        File::remove(targetFileName);
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*====================*/
+
+SoXRenderCacheEvictionPolicy::SoXRenderCacheEvictionPolicy ()
+    : maximumByteCount{0},
+      maximumEntryCount{0},
+      maximumAge{0.0}
+{
+}
+
+/*====================*/
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+SoXRenderCache::SoXRenderCache ()
+    : _directoryName{},
+      _evictionPolicy{}
+{
+    Logging_trace(">>");
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* configuration      */
+/*--------------------*/
+
+Boolean SoXRenderCache::setDirectory (IN String& directoryName)
+{
+    Logging_trace1(">>: %1", directoryName);
+
+    const Boolean isOkay =
+        (directoryName == ""
+         || OperatingSystem::makeDirectory(directoryName));
+    _directoryName = (isOkay ? directoryName : "");
+
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+
+void SoXRenderCache::setEvictionPolicy
+                         (IN SoXRenderCacheEvictionPolicy& policy)
+{
+    Logging_trace3(">>: maximumByteCount = %1, maximumEntryCount = %2,"
+                   " maximumAge = %3",
+                   TOSTRING(policy.maximumByteCount),
+                   TOSTRING(policy.maximumEntryCount),
+                   TOSTRING(policy.maximumAge));
+    _evictionPolicy = policy;
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* queries            */
+/*--------------------*/
+
+Boolean SoXRenderCache::isActive () const
+{
+    return (_directoryName != "");
+}
+
+/*--------------------*/
+
+Boolean SoXRenderCache::makeKey (IN String& inputFileName,
+                                 IN ByteList& parameterState,
+                                 IN Natural blockSize,
+                                 IN String& outputFileName,
+                                 OUT String& key) const
+{
+    Logging_trace3(">>: input = %1, blockSize = %2, output = %3",
+                   inputFileName, TOSTRING(blockSize), outputFileName);
+
+    /* the settings are hashed in the binary state format, hence the
+       key does not depend on the layout of the parameter file */
+    DspStateStream settingsStream{};
+    const std::uint64_t rawBlockSize = (size_t) blockSize;
+    settingsStream.writeString(SoXOfflineRenderer::engineVersion);
+    settingsStream.writeList(parameterState);
+    settingsStream.write(rawBlockSize);
+    settingsStream.writeString(_outputKindName(outputFileName));
+
+    _Sha256 digest{};
+    digest.updateWithList(settingsStream.byteList());
+
+    File inputFile;
+    Boolean isOkay = inputFile.open(inputFileName, "rb");
+    ByteList byteList;
+    Natural byteCount = (isOkay ? _chunkByteCount : 0);
+
+    while (byteCount == _chunkByteCount) {
+        byteCount = inputFile.read(byteList, 0, _chunkByteCount);
+        digest.update((const std::uint8_t*) byteList.data(),
+                      (size_t) byteCount);
+    }
+
+    inputFile.closeConditionally();
+    key = (isOkay ? digest.hexDigest() : "");
+
+    Logging_trace2("<<: isOkay = %1, key = %2", TOSTRING(isOkay), key);
+    return isOkay;
+}
+
+/*--------------------*/
+/* entry access       */
+/*--------------------*/
+
+Boolean SoXRenderCache::fetch (IN String& key,
+                               IN String& outputFileName) const
+{
+    Logging_trace2(">>: key = %1, output = %2", key, outputFileName);
+
+    const String entryFileName = _entryFileName(key);
+    Boolean isFound =
+        (isActive() && key != ""
+         && OperatingSystem::fileExists(entryFileName));
+
+    if (isFound) {
+        /* the modification time of an entry is its last use */
+        OperatingSystem::touchFile(entryFileName);
+        isFound = _copyFile(entryFileName, outputFileName);
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(isFound));
+    return isFound;
+}
+
+/*--------------------*/
+
+Boolean SoXRenderCache::store (IN String& key,
+                               IN String& outputFileName) const
+{
+    Logging_trace2(">>: key = %1, output = %2", key, outputFileName);
+
+    /* the copy has a name specific to the thread and is renamed
+       when complete, hence a concurrent fetch never sees a partial
+       entry and concurrent stores of the same key do not collide */
+    std::ostringstream threadIdStream;
+    threadIdStream << std::this_thread::get_id();
+    const String entryFileName = _entryFileName(key);
+    const String temporaryFileName =
+        entryFileName + "." + threadIdStream.str() + _temporaryExtension;
+    const Boolean isOkay =
+        (isActive() && key != ""
+         && _copyFile(outputFileName, temporaryFileName)
+         && File::rename(temporaryFileName, entryFileName));
+
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+
+Natural SoXRenderCache::evict () const
+{
+    Logging_trace(">>");
+
+    /** a cache entry with its file name, size and age */
+    struct _Entry {
+        String fileName;
+        Natural byteCount;
+        Real age;
+    };
+
+    GenericList<_Entry> entryList;
+    Natural totalByteCount = 0;
+    Natural result = 0;
+
+    if (isActive()) {
+        const StringList fileNameList =
+            OperatingSystem::fileNameList(_directoryName);
+
+        for (const String& fileName : fileNameList) {
+            if (STR::endsWith(fileName, _entryExtension)) {
+                const String entryFileName =
+                    _directoryName + "/" + fileName;
+                const _Entry entry{
+                    entryFileName, File::length(entryFileName),
+                    OperatingSystem::fileAge(entryFileName)
+                };
+                entryList.append(entry);
+                totalByteCount += entry.byteCount;
+            }
+        }
+    }
+
+    /* the oldest entries come first */
+    std::sort(entryList.begin(), entryList.end(),
+              [] (IN _Entry& entryA, IN _Entry& entryB) {
+                  return entryA.age > entryB.age;
+              });
+
+    const SoXRenderCacheEvictionPolicy& policy = _evictionPolicy;
+    Natural entryCount = entryList.size();
+
+    for (const _Entry& entry : entryList) {
+        const Boolean isTooOld =
+            (policy.maximumAge > 0.0 && entry.age > policy.maximumAge);
+        const Boolean hasTooManyEntries =
+            (policy.maximumEntryCount > 0
+             && entryCount > policy.maximumEntryCount);
+        const Boolean isTooLarge =
+            (policy.maximumByteCount > 0
+             && totalByteCount > policy.maximumByteCount);
+
+        if ((isTooOld || hasTooManyEntries || isTooLarge)
+            && File::remove(entry.fileName)) {
+            entryCount--;
+            totalByteCount -= entry.byteCount;
+            result++;
+        }
+    }
+
+    Logging_trace3("<<: evicted = %1, remaining = %2, bytes = %3",
+                   TOSTRING(result), TOSTRING(entryCount),
+                   TOSTRING(totalByteCount));
+    return result;
+}
+
+/*--------------------*/
+/* internal routines  */
+/*--------------------*/
+
+String SoXRenderCache::_entryFileName (IN String& key) const
+{
+    return _directoryName + "/" + key + _entryExtension;
+}
@@ -0,0 +1,215 @@
+/**
+ * @file
+ * The <C>SoXRenderCache</C> specification defines a content-addressed
+ * cache of rendered audio files in a directory, such that renderings
+ * of unchanged inputs with unchanged effect settings can be skipped.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "ByteList.h"
+#include "MyString.h"
+#include "Natural.h"
+#include "Real.h"
+
+/*--------------------*/
+
+using BaseTypes::Containers::ByteList;
+using BaseTypes::Primitives::Boolean;
+using BaseTypes::Primitives::Natural;
+using BaseTypes::Primitives::Real;
+using BaseTypes::Primitives::String;
+
+/*====================*/
+
+namespace SoXPlugins::Renderer {
+
+    /**
+     * A <C>SoXRenderCacheEvictionPolicy</C> object defines the
+     * limits of a render cache; a limit of zero means no limit.
+     * Entries older than the maximum age are removed first, then
+     * the least recently used entries until the cache is within
+     * the byte and entry limits.
+     */
+    struct SoXRenderCacheEvictionPolicy {
+
+        /** the maximum total size of all entries in bytes */
+        Natural maximumByteCount;
+
+        /** the maximum number of entries */
+        Natural maximumEntryCount;
+
+        /** the maximum time in seconds since the last use of an
+         * entry */
+        Real maximumAge;
+
+        /*--------------------*/
+
+        /**
+         * Makes a policy without limits.
+         */
+        SoXRenderCacheEvictionPolicy ();
+
+    };
+
+    /*====================*/
+
+    /**
+     * A <C>SoXRenderCache</C> object stores rendered audio files in
+     * a cache directory under a key derived from everything
+     * influencing the result: the content of the input file, the
+     * binary parameter state of the effect, the block size, the
+     * output file kind and the engine version.  The key is the
+     * SHA-256 digest of these data in hexadecimal notation, hence
+     * renaming or moving an input does not invalidate its entries,
+     * while any change of its samples does.
+     *
+     * Each entry is a copy of the output file; its modification
+     * time records its last use, which drives the eviction of the
+     * least recently used entries.  Entries are written to a
+     * temporary file and renamed, hence several workers may fetch
+     * and store concurrently; all methods are const after the
+     * configuration.
+     */
+    struct SoXRenderCache {
+
+        /*--------------------*/
+        /* con-/destruction   */
+        /*--------------------*/
+
+        /**
+         * Makes an inactive cache.
+         */
+        SoXRenderCache ();
+
+        /*--------------------*/
+        /* configuration      */
+        /*--------------------*/
+
+        /**
+         * Sets the cache directory to <C>directoryName</C> (created
+         * when missing) and tells whether this has been successful;
+         * an empty name makes the cache inactive.
+         *
+         * @param[in] directoryName  name of cache directory
+         * @return  information whether cache directory is usable
+         */
+        Boolean setDirectory (IN String& directoryName);
+
+        /*--------------------*/
+
+        /**
+         * Sets the limits for <C>evict</C> to <C>policy</C>.
+         *
+         * @param[in] policy  eviction policy
+         */
+        void setEvictionPolicy (IN SoXRenderCacheEvictionPolicy& policy);
+
+        /*--------------------*/
+        /* queries            */
+        /*--------------------*/
+
+        /**
+         * Tells whether the cache has a directory.
+         *
+         * @return  information whether cache is active
+         */
+        Boolean isActive () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns in <C>key</C> the cache key for rendering the
+         * input file named <C>inputFileName</C> with the effect
+         * parameter state <C>parameterState</C> in blocks of
+         * <C>blockSize</C> frames into the file named
+         * <C>outputFileName</C> and tells whether the input could be
+         * read.
+         *
+         * @param[in]  inputFileName   name of input audio file
+         * @param[in]  parameterState  binary parameter state of effect
+         * @param[in]  blockSize       number of frames per block
+         * @param[in]  outputFileName  name of output audio file
+         * @param[out] key             cache key
+         * @return  information whether key has been calculated
+         */
+        Boolean makeKey (IN String& inputFileName,
+                         IN ByteList& parameterState,
+                         IN Natural blockSize,
+                         IN String& outputFileName,
+                         OUT String& key) const;
+
+        /*--------------------*/
+        /* entry access       */
+        /*--------------------*/
+
+        /**
+         * Copies the entry for <C>key</C> to the file named
+         * <C>outputFileName</C>, marks the entry as used and tells
+         * whether the entry has been found and copied.
+         *
+         * @param[in] key             cache key
+         * @param[in] outputFileName  name of output audio file
+         * @return  information whether output has been taken from
+         *          the cache
+         */
+        Boolean fetch (IN String& key,
+                       IN String& outputFileName) const;
+
+        /*--------------------*/
+
+        /**
+         * Stores a copy of the file named <C>outputFileName</C> as
+         * entry for <C>key</C> and tells whether this has been
+         * successful.
+         *
+         * @param[in] key             cache key
+         * @param[in] outputFileName  name of rendered audio file
+         * @return  information whether entry has been stored
+         */
+        Boolean store (IN String& key,
+                       IN String& outputFileName) const;
+
+        /*--------------------*/
+
+        /**
+         * Removes entries according to the eviction policy and
+         * returns the number of removed entries.
+         *
+         * @return  number of evicted entries
+         */
+        Natural evict () const;
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /**
+             * Returns the file name of the entry for <C>key</C>.
+             *
+             * @param[in] key  cache key
+             * @return  name of entry file
+             */
+            String _entryFileName (IN String& key) const;
+
+            /*--------------------*/
+
+            /** the cache directory (empty for an inactive cache) */
+            String _directoryName;
+
+            /** the limits of the cache */
+            SoXRenderCacheEvictionPolicy _evictionPolicy;
+
+    };
+
+}
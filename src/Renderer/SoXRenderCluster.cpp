@@ -0,0 +1,1135 @@
+/**
+ * @file
+ * The <C>SoXRenderCluster</C> body implements a render node serving
+ * segments of a rendering over TCP and a coordinator splitting the
+ * rendering of a long file across several such nodes.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXRenderCluster.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include "DenormalGuard.h"
+#include "DspStateStream.h"
+#include "GenericList.h"
+#include "Logging.h"
+#include "OperatingSystem.h"
+#include "SoXAudioFile.h"
+#include "TcpConnection.h"
+
+/*--------------------*/
+
+using Audio::DenormalGuard;
+using Audio::DspStateStream;
+using BaseModules::OperatingSystem;
+using BaseModules::TcpConnection;
+using BaseModules::TcpListener;
+using BaseTypes::GenericTypes::GenericList;
+using SoXPlugins::Renderer::SoXAudioFileReader;
+using SoXPlugins::Renderer::SoXAudioFileWriter;
+using SoXPlugins::Renderer::SoXClusterStatistics;
+using SoXPlugins::Renderer::SoXOfflineRenderer;
+using SoXPlugins::Renderer::SoXRenderCoordinator;
+using SoXPlugins::Renderer::SoXRenderNode;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
+
+/*====================*/
+
+/** the identification at the start of a segment request */
+static const String _requestMagic = "SoXRenderSegmentRequest";
+
+/** the identification at the start of a segment answer */
+static const String _answerMagic = "SoXRenderSegmentAnswer";
+
+/** the version of the request and answer layout */
+static const std::uint32_t _protocolVersion = 1;
+
+/** the maximum length of a message accepted in bytes */
+static const Natural _maximumMessageLength{(size_t) 1 << 30};
+
+/** the number of sample bytes aimed at per segment transfer; longer
+ * files are split into more segments than node connections */
+static const Natural _maximumSegmentByteCount{(size_t) 64 << 20};
+
+/** the maximum number of channels accepted in a request */
+static const Natural _maximumChannelCount = 256;
+
+/** the separator between node addresses */
+static const String _nodeSeparator = ",";
+
+/*--------------------*/
+
+const Natural SoXRenderNode::defaultPort = 47300;
+
+const Real SoXRenderCoordinator::defaultNodeTimeout = 600.0;
+
+/*====================*/
+
+/**
+ * A <C>_SoXClusterContext</C> object holds the data shared by the
+ * node workers of a distributed rendering: the segment layout, the
+ * pending segments, the common writer and the statistics.
+ */
+struct _SoXClusterContext {
+
+    /** the parameter text defining the effect */
+    String parameterText;
+
+    /** the name of the input audio file */
+    String inputFileName;
+
+    /** tells whether the input file is memory mapped */
+    Boolean inputIsMapped;
+
+    /** the sample rate of the input file */
+    Real sampleRate;
+
+    /** the number of channels of the input file */
+    Natural channelCount;
+
+    /** the number of frames per block */
+    Natural blockSize;
+
+    /** the total number of frames of the input file */
+    Natural frameCount;
+
+    /** the number of frames per segment (except for the last) */
+    Natural segmentLength;
+
+    /** the number of frames processed before a segment and
+     * discarded */
+    Natural warmupFrameCount;
+
+    /** the maximum time for a transfer to or from a node */
+    Real nodeTimeout;
+
+    /** the writer for the output file (shared by all segments) */
+    SoXAudioFileWriter* writer;
+
+    /** the lock serializing accesses to writer, pending segments,
+     * statistics and error message */
+    std::mutex lock;
+
+    /** the indices of the segments not yet rendered */
+    std::deque<Natural> pendingSegmentList;
+
+    /** the statistics of the rendering */
+    SoXClusterStatistics statistics;
+
+    /** tells whether no fatal failure has occured */
+    std::atomic<bool> isOkay;
+
+    /** the description of the first fatal failure */
+    String errorMessage;
+
+};
+
+/*====================*/
+
+/**
+ * Returns <C>value</C> as a string with
+ * <C>fractionalDigitCount</C> digits after the decimal point.
+ *
+ * @param[in] value                 value to be converted
+ * @param[in] fractionalDigitCount  number of fractional digits
+ * @return  fixed-point representation
+ */
+static String _toFixedString (IN Real value,
+                              IN int fractionalDigitCount)
+{
+    std::ostringstream stream;
+    stream << std::fixed << std::setprecision(fractionalDigitCount)
+           << (double) value;
+    return stream.str();
+}
+
+/*--------------------*/
+
+/**
+ * Returns the time elapsed since <C>startTime</C> in seconds.
+ *
+ * @param[in] startTime  start of measured interval
+ * @return  elapsed time in seconds
+ */
+static Real
+_elapsedTime (IN std::chrono::steady_clock::time_point& startTime)
+{
+    const std::chrono::duration<double> duration =
+        std::chrono::steady_clock::now() - startTime;
+    return Real{duration.count()};
+}
+
+/*--------------------*/
+
+/**
+ * Appends the first <C>frameCount</C> frames of all channels of
+ * <C>buffer</C> as a block to <C>stream</C>.
+ *
+ * @param[inout] stream      message stream
+ * @param[in]    buffer      buffer with samples
+ * @param[in]    frameCount  number of frames in block
+ */
+static void _writeBlock (INOUT DspStateStream& stream,
+                         IN AudioSampleListVector& buffer,
+                         IN Natural frameCount)
+{
+    stream.write((std::uint64_t) (size_t) frameCount);
+
+    for (const AudioSampleList& sampleList : buffer) {
+        stream.writeArray(sampleList.asArray(), frameCount);
+    }
+}
+
+/*--------------------*/
+
+/**
+ * Reads the next block with <C>channelCount</C> channels from
+ * <C>stream</C> into <C>buffer</C> and returns its frame count in
+ * <C>frameCount</C>; tells whether a complete, nonempty block has
+ * been read.
+ *
+ * @param[inout] stream        message stream
+ * @param[in]    channelCount  number of channels in block
+ * @param[out]   buffer        buffer receiving the samples
+ * @param[out]   frameCount    number of frames in block
+ * @return  information whether block has been read
+ */
+static Boolean _readBlock (INOUT DspStateStream& stream,
+                           IN Natural channelCount,
+                           OUT AudioSampleListVector& buffer,
+                           OUT Natural& frameCount)
+{
+    std::uint64_t count = 0;
+    stream.read(count);
+
+    /* the frame count is checked against the message length before
+       any allocation */
+    const std::uint64_t messageLength =
+        (std::uint64_t) (size_t) stream.byteList().length();
+    Boolean isOkay =
+        (stream.isOkay() && count > 0
+         && count <= messageLength / sizeof(AudioSample)
+                     / (std::uint64_t) (size_t) channelCount);
+    frameCount = (isOkay ? Natural{(size_t) count} : Natural{0});
+
+    if (isOkay) {
+        buffer.resizeChannels(channelCount, frameCount);
+
+        for (AudioSampleList& sampleList : buffer) {
+            stream.readArray(sampleList.asArray(), frameCount);
+        }
+
+        isOkay = stream.isOkay();
+    }
+
+    return isOkay;
+}
+
+/*--------------------*/
+
+/**
+ * Sets <C>startFrame</C>, <C>segmentStart</C> and
+ * <C>segmentEnd</C> to the first frame processed (including the
+ * pre-roll), the first frame written and the frame after the last
+ * one of segment <C>segmentIndex</C> in <C>context</C>.
+ *
+ * @param[in]  context       cluster context
+ * @param[in]  segmentIndex  index of segment
+ * @param[out] startFrame    first frame processed
+ * @param[out] segmentStart  first frame of segment
+ * @param[out] segmentEnd    frame after segment
+ */
+static void _getSegmentBounds (IN _SoXClusterContext& context,
+                               IN Natural segmentIndex,
+                               OUT Natural& startFrame,
+                               OUT Natural& segmentStart,
+                               OUT Natural& segmentEnd)
+{
+    segmentStart = segmentIndex * context.segmentLength;
+    segmentEnd   = Natural::minimum(segmentStart + context.segmentLength,
+                                    context.frameCount);
+    startFrame   =
+        segmentStart - Natural::minimum(segmentStart,
+                                        context.warmupFrameCount);
+}
+
+/*--------------------*/
+
+/**
+ * Builds the request for segment <C>segmentIndex</C> of
+ * <C>context</C> into <C>request</C> from the input read by
+ * <C>reader</C>: the pre-roll blocks end exactly at the segment
+ * start like in a local segmented rendering.  Tells whether the
+ * input could be read, otherwise sets <C>errorMessage</C>.
+ *
+ * @param[in]    context       cluster context
+ * @param[inout] reader        reader for input file
+ * @param[in]    segmentIndex  index of segment
+ * @param[out]   request       request message
+ * @param[out]   errorMessage  description of failure
+ * @return  information whether request has been built
+ */
+static Boolean _makeRequest (IN _SoXClusterContext& context,
+                             INOUT SoXAudioFileReader& reader,
+                             IN Natural segmentIndex,
+                             OUT ByteList& request,
+                             OUT String& errorMessage)
+{
+    Logging_trace1(">>: %1", TOSTRING(segmentIndex));
+
+    Natural startFrame;
+    Natural segmentStart;
+    Natural segmentEnd;
+    _getSegmentBounds(context, segmentIndex,
+                      startFrame, segmentStart, segmentEnd);
+
+    DspStateStream stream{};
+    stream.writeString(_requestMagic);
+    stream.write(_protocolVersion);
+    stream.writeString(context.parameterText);
+    stream.write((double) context.sampleRate);
+    stream.write((std::uint64_t) (size_t) context.channelCount);
+    stream.write((std::uint64_t) (size_t) startFrame);
+    stream.write((std::uint64_t) (size_t) segmentStart);
+    stream.write((std::uint64_t) (size_t) segmentEnd);
+
+    AudioSampleListVector buffer;
+    Natural framePosition = startFrame;
+    Boolean isOkay = true;
+    reader.setFramePosition(startFrame);
+
+    while (isOkay && framePosition < segmentEnd) {
+        const Natural limit =
+            (framePosition < segmentStart ? segmentStart : segmentEnd);
+        const Natural frameCount =
+            reader.read(buffer,
+                        Natural::minimum(context.blockSize,
+                                         limit - framePosition));
+        isOkay = (frameCount > 0);
+
+        if (!isOkay) {
+            errorMessage = STR::expand("unexpected end of audio file %1",
+                                       context.inputFileName);
+        } else {
+            _writeBlock(stream, buffer, frameCount);
+            framePosition += frameCount;
+        }
+    }
+
+    request = stream.byteList();
+    Logging_trace2("<<: isOkay = %1, byteCount = %2",
+                   TOSTRING(isOkay), TOSTRING(request.length()));
+    return isOkay;
+}
+
+/*--------------------*/
+
+/**
+ * Renders the segment described by <C>request</C> by a fresh
+ * effect and returns the answer in <C>answer</C>: either the
+ * processed segment blocks or an error message.  Sets
+ * <C>segmentTime</C> and <C>segmentDuration</C> to the start time
+ * and the duration of the segment in seconds and tells whether the
+ * rendering has been successful.
+ *
+ * @param[in]  request          request message
+ * @param[out] answer           answer message
+ * @param[out] segmentTime      start time of segment
+ * @param[out] segmentDuration  duration of segment
+ * @return  information whether segment has been rendered
+ */
+static Boolean _renderSegment (IN ByteList& request,
+                               OUT ByteList& answer,
+                               OUT Real& segmentTime,
+                               OUT Real& segmentDuration)
+{
+    Logging_trace1(">>: byteCount = %1", TOSTRING(request.length()));
+
+    DspStateStream input{request};
+    String magic;
+    std::uint32_t version = 0;
+    String parameterText;
+    double sampleRate = 0.0;
+    std::uint64_t channelCount = 0;
+    std::uint64_t startFrame = 0;
+    std::uint64_t segmentStart = 0;
+    std::uint64_t segmentEnd = 0;
+    input.readString(magic);
+    input.read(version);
+    input.readString(parameterText);
+    input.read(sampleRate);
+    input.read(channelCount);
+    input.read(startFrame);
+    input.read(segmentStart);
+    input.read(segmentEnd);
+
+    Boolean isOkay =
+        (input.isOkay() && magic == _requestMagic
+         && version == _protocolVersion && sampleRate > 0.0
+         && channelCount > 0
+         && channelCount <= (std::uint64_t) (size_t) _maximumChannelCount
+         && startFrame <= segmentStart && segmentStart < segmentEnd);
+    String errorMessage = (isOkay ? "" : "malformed segment request");
+    segmentTime     = (isOkay ? Real{(double) segmentStart / sampleRate}
+                       : Real{0.0});
+    segmentDuration =
+        (isOkay ? Real{(double) (segmentEnd - segmentStart) / sampleRate}
+         : Real{0.0});
+    SoXAudioEffect* effect =
+        (!isOkay ? nullptr
+         : SoXOfflineRenderer::makeConfiguredEffect(parameterText,
+                                                    errorMessage));
+    isOkay = (effect != nullptr);
+    DspStateStream output{};
+    output.writeString(_answerMagic);
+    output.write((std::uint8_t) 1);
+    output.writeString("");
+
+    if (isOkay) {
+        const DenormalGuard denormalGuard{};
+        const Natural channels{(size_t) channelCount};
+        AudioSampleListVector buffer;
+        std::uint64_t framePosition = startFrame;
+        Natural frameCount;
+        effect->prepareToPlay(Real{sampleRate});
+
+        while (isOkay && framePosition < segmentEnd) {
+            /* a block must not cross the segment start, such that
+               the blocks match those of a local rendering */
+            const std::uint64_t limit =
+                (framePosition < segmentStart ? segmentStart
+                 : segmentEnd);
+            isOkay = (_readBlock(input, channels, buffer, frameCount)
+                      && framePosition + (size_t) frameCount <= limit);
+
+            if (!isOkay) {
+                errorMessage = "malformed segment request";
+            } else {
+                effect->processBlock(Real{(double) framePosition
+                                          / sampleRate},
+                                     buffer);
+
+                if (framePosition >= segmentStart) {
+                    _writeBlock(output, buffer, frameCount);
+                }
+
+                framePosition += (size_t) frameCount;
+            }
+        }
+
+        effect->releaseResources();
+    }
+
+    delete effect;
+
+    if (isOkay) {
+        answer = output.byteList();
+    } else {
+        DspStateStream errorOutput{};
+        errorOutput.writeString(_answerMagic);
+        errorOutput.write((std::uint8_t) 0);
+        errorOutput.writeString(errorMessage);
+        answer = errorOutput.byteList();
+    }
+
+    Logging_trace2("<<: isOkay = %1, message = %2",
+                   TOSTRING(isOkay), errorMessage);
+    return isOkay;
+}
+
+/*--------------------*/
+
+/**
+ * Writes the segment blocks of <C>answer</C> for segment
+ * <C>segmentIndex</C> at their position in the output file of
+ * <C>context</C>.  Tells whether the answer is a complete
+ * successful answer, otherwise sets <C>errorMessage</C>;
+ * <C>isWritten</C> tells whether all writes have been successful.
+ *
+ * @param[inout] context       cluster context
+ * @param[in]    answer        answer message
+ * @param[in]    segmentIndex  index of segment
+ * @param[out]   isWritten     information whether the writes to the
+ *                             output file have been successful
+ * @param[out]   errorMessage  description of failure
+ * @return  information whether answer has been valid
+ */
+static Boolean _writeAnswer (INOUT _SoXClusterContext& context,
+                             IN ByteList& answer,
+                             IN Natural segmentIndex,
+                             OUT Boolean& isWritten,
+                             OUT String& errorMessage)
+{
+    Logging_trace1(">>: %1", TOSTRING(segmentIndex));
+
+    Natural startFrame;
+    Natural segmentStart;
+    Natural segmentEnd;
+    _getSegmentBounds(context, segmentIndex,
+                      startFrame, segmentStart, segmentEnd);
+
+    DspStateStream input{answer};
+    String magic;
+    std::uint8_t status = 0;
+    String message;
+    input.readString(magic);
+    input.read(status);
+    input.readString(message);
+
+    Boolean isOkay = (input.isOkay() && magic == _answerMagic
+                      && status != 0);
+    errorMessage = (isOkay ? ""
+                    : (message == "" ? "malformed segment answer"
+                       : message));
+    isWritten = true;
+    AudioSampleListVector buffer;
+    Natural framePosition = segmentStart;
+    Natural frameCount;
+
+    while (isOkay && isWritten && framePosition < segmentEnd) {
+        isOkay = (_readBlock(input, context.channelCount,
+                             buffer, frameCount)
+                  && framePosition + frameCount <= segmentEnd);
+
+        if (!isOkay) {
+            errorMessage = "malformed segment answer";
+        } else {
+            std::lock_guard<std::mutex> guard{context.lock};
+            isWritten = context.writer->writeAt(buffer, frameCount,
+                                                framePosition);
+            errorMessage = (isWritten ? "" : "write error on audio file");
+            framePosition += frameCount;
+        }
+    }
+
+    Logging_trace2("<<: isOkay = %1, isWritten = %2",
+                   TOSTRING(isOkay), TOSTRING(isWritten));
+    return isOkay;
+}
+
+/*--------------------*/
+
+/**
+ * Removes the next pending segment from <C>context</C> and returns
+ * its index in <C>segmentIndex</C>; tells whether there has been
+ * one.
+ *
+ * @param[inout] context       cluster context
+ * @param[out]   segmentIndex  index of segment taken
+ * @return  information whether a segment was pending
+ */
+static Boolean _takeSegment (INOUT _SoXClusterContext& context,
+                             OUT Natural& segmentIndex)
+{
+    std::lock_guard<std::mutex> guard{context.lock};
+    const Boolean isFound = (context.pendingSegmentList.size() > 0);
+
+    if (isFound) {
+        segmentIndex = context.pendingSegmentList.front();
+        context.pendingSegmentList.pop_front();
+    }
+
+    return isFound;
+}
+
+/*--------------------*/
+
+/**
+ * Records the fatal failure described by <C>errorMessage</C> in
+ * <C>context</C> (unless there has been one before), such that
+ * all workers stop.
+ *
+ * @param[inout] context       cluster context
+ * @param[in]    errorMessage  description of failure
+ */
+static void _setFailure (INOUT _SoXClusterContext& context,
+                         IN String& errorMessage)
+{
+    std::lock_guard<std::mutex> guard{context.lock};
+
+    if (context.isOkay.load()) {
+        context.errorMessage = errorMessage;
+        context.isOkay = false;
+    }
+}
+
+/*--------------------*/
+
+/**
+ * Renders pending segments of <C>context</C> on the node at
+ * <C>hostName</C> and <C>port</C> until none is left or the node
+ * fails; the segment of a failed node is put back for the other
+ * workers.
+ *
+ * @param[inout] context   cluster context
+ * @param[in]    hostName  name of node host
+ * @param[in]    port      TCP port of node
+ */
+static void _nodeWorker (INOUT _SoXClusterContext& context,
+                         IN String hostName,
+                         IN Natural port)
+{
+    Logging_trace2(">>: host = %1, port = %2",
+                   hostName, TOSTRING(port));
+
+    TcpConnection connection;
+    SoXAudioFileReader reader{};
+    connection.setTimeout(context.nodeTimeout);
+    Boolean nodeIsOkay = connection.open(hostName, port);
+    Boolean hasSegment = true;
+
+    if (!reader.open(context.inputFileName, context.inputIsMapped)) {
+        nodeIsOkay = false;
+        _setFailure(context,
+                    STR::expand("cannot read audio file %1",
+                                context.inputFileName));
+    }
+
+    while (nodeIsOkay && hasSegment && context.isOkay.load()) {
+        Natural segmentIndex;
+        hasSegment = _takeSegment(context, segmentIndex);
+
+        if (hasSegment) {
+            ByteList request;
+            ByteList answer;
+            String errorMessage;
+            Boolean isWritten = true;
+
+            if (!_makeRequest(context, reader, segmentIndex,
+                              request, errorMessage)) {
+                _setFailure(context, errorMessage);
+            } else {
+                nodeIsOkay =
+                    (connection.send(request)
+                     && connection.receive(answer, _maximumMessageLength)
+                     && _writeAnswer(context, answer, segmentIndex,
+                                     isWritten, errorMessage));
+                std::lock_guard<std::mutex> guard{context.lock};
+
+                if (!isWritten && context.isOkay.load()) {
+                    context.errorMessage = errorMessage;
+                    context.isOkay = false;
+                } else if (!isWritten) {
+                    /* another failure has been recorded before */
+                } else if (!nodeIsOkay) {
+                    Logging_traceError2("node %1 failed on segment %2",
+                                        hostName,
+                                        TOSTRING(segmentIndex));
+                    context.pendingSegmentList.push_back(segmentIndex);
+                    context.statistics.retryCount++;
+                } else {
+                    context.statistics.remoteSegmentCount++;
+                }
+            }
+        }
+    }
+
+    if (!nodeIsOkay && context.isOkay.load()) {
+        std::lock_guard<std::mutex> guard{context.lock};
+        context.statistics.failedNodeCount++;
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(nodeIsOkay));
+}
+
+/*--------------------*/
+
+/**
+ * Renders the segments of <C>context</C> left over by the node
+ * workers in this process, one after the other.
+ *
+ * @param[inout] context  cluster context
+ */
+static void _renderPendingSegmentsLocally (INOUT _SoXClusterContext& context)
+{
+    Logging_trace(">>");
+
+    SoXAudioFileReader reader{};
+    Natural segmentIndex;
+
+    if (context.pendingSegmentList.size() > 0
+        && !reader.open(context.inputFileName, context.inputIsMapped)) {
+        _setFailure(context,
+                    STR::expand("cannot read audio file %1",
+                                context.inputFileName));
+    }
+
+    while (context.isOkay.load() && _takeSegment(context, segmentIndex)) {
+        ByteList request;
+        ByteList answer;
+        String errorMessage;
+        Boolean isWritten = true;
+        Real segmentTime;
+        Real segmentDuration;
+        const Boolean isOkay =
+            (_makeRequest(context, reader, segmentIndex,
+                          request, errorMessage)
+             && _renderSegment(request, answer,
+                               segmentTime, segmentDuration)
+             && _writeAnswer(context, answer, segmentIndex,
+                             isWritten, errorMessage)
+             && isWritten);
+
+        if (!isOkay) {
+            _setFailure(context, errorMessage);
+        } else {
+            context.statistics.localSegmentCount++;
+        }
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+/**
+ * Serves the segment requests arriving on <C>connection</C> until
+ * the coordinator closes it and destroys the connection
+ * afterwards; reports each segment on the console when
+ * <C>progressIsReported</C> is set.
+ *
+ * @param[inout] connection          connection to a coordinator
+ * @param[in]    progressIsReported  information whether segments
+ *                                   are reported
+ */
+static void _serveConnection (INOUT TcpConnection* connection,
+                              IN Boolean progressIsReported)
+{
+    Logging_trace(">>");
+
+    ByteList request;
+    ByteList answer;
+    Boolean isOpen = true;
+
+    while (isOpen) {
+        isOpen = connection->receive(request, _maximumMessageLength);
+
+        if (isOpen) {
+            const std::chrono::steady_clock::time_point startTime =
+                std::chrono::steady_clock::now();
+            Real segmentTime;
+            Real segmentDuration;
+            const Boolean isOkay =
+                _renderSegment(request, answer,
+                               segmentTime, segmentDuration);
+            const Real renderingTime = _elapsedTime(startTime);
+            isOpen = connection->send(answer);
+
+            if (progressIsReported) {
+                OperatingSystem::writeMessageToConsole(
+                    STR::expand("segment at %1s (%2s) %3"
+                                " (%4x realtime)",
+                                _toFixedString(segmentTime, 3),
+                                _toFixedString(segmentDuration, 3),
+                                (isOkay ? "done" : "FAILED"),
+                                _toFixedString(renderingTime > 0.0
+                                               ? segmentDuration
+                                                 / renderingTime
+                                               : Real{0.0},
+                                               1)));
+            }
+        }
+    }
+
+    delete connection;
+    Logging_trace("<<");
+}
+
+/*====================*/
+
+SoXClusterStatistics::SoXClusterStatistics ()
+    : segmentCount{0},
+      remoteSegmentCount{0},
+      localSegmentCount{0},
+      retryCount{0},
+      failedNodeCount{0},
+      audioDuration{0.0},
+      warmupDuration{0.0},
+      renderingTime{0.0}
+{
+}
+
+/*--------------------*/
+
+String SoXClusterStatistics::toString () const
+{
+    const Real throughput =
+        (renderingTime > 0.0 ? audioDuration / renderingTime
+         : Real{0.0});
+    const Real warmupOverhead =
+        (audioDuration > 0.0 ? warmupDuration / audioDuration * 100.0
+         : Real{0.0});
+    return STR::expand("segments = %1 (remote = %2, local = %3),"
+                       " retries = %4, failed nodes = %5,"
+                       " audio = %6s, time = %7s,"
+                       " throughput = %8x realtime,"
+                       " pre-roll overhead = %9%",
+                       TOSTRING(segmentCount),
+                       TOSTRING(remoteSegmentCount),
+                       TOSTRING(localSegmentCount),
+                       TOSTRING(retryCount), TOSTRING(failedNodeCount),
+                       _toFixedString(audioDuration, 1),
+                       _toFixedString(renderingTime, 3),
+                       _toFixedString(throughput, 1),
+                       _toFixedString(warmupOverhead, 1));
+}
+
+/*============================================================*/
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+SoXRenderNode::SoXRenderNode ()
+    : _progressIsReported{false},
+      _errorMessage{""}
+{
+    Logging_trace(">>");
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* configuration      */
+/*--------------------*/
+
+void SoXRenderNode::setProgressIsReported (IN Boolean isReported)
+{
+    Logging_trace1(">>: %1", TOSTRING(isReported));
+    _progressIsReported = isReported;
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* processing         */
+/*--------------------*/
+
+Boolean SoXRenderNode::run (IN Natural port)
+{
+    Logging_trace1(">>: %1", TOSTRING(port));
+
+    TcpListener listener;
+    const Boolean isOkay =
+        (TcpConnection::isAvailable() && listener.open(port));
+
+    if (!isOkay) {
+        _errorMessage = STR::expand("cannot listen on port %1",
+                                    TOSTRING(port));
+    } else {
+        if (_progressIsReported) {
+            OperatingSystem::writeMessageToConsole(
+                STR::expand("render node listening on port %1",
+                            TOSTRING(listener.port())));
+        }
+
+        /* each coordinator connection gets a thread of its own
+           owning the connection */
+        while (isOkay) {
+            TcpConnection* connection = new TcpConnection();
+
+            if (!listener.accept(*connection)) {
+                delete connection;
+            } else {
+                std::thread{_serveConnection, connection,
+                            _progressIsReported}.detach();
+            }
+        }
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+/* queries            */
+/*--------------------*/
+
+String SoXRenderNode::errorMessage () const
+{
+    return _errorMessage;
+}
+
+/*============================================================*/
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+SoXRenderCoordinator::SoXRenderCoordinator ()
+    : _hostNameList{},
+      _portList{},
+      _inputIsMapped{true},
+      _nodeTimeout{defaultNodeTimeout},
+      _statistics{},
+      _errorMessage{""}
+{
+    Logging_trace(">>");
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* configuration      */
+/*--------------------*/
+
+Boolean SoXRenderCoordinator::setNodeList (IN String& nodeListText)
+{
+    Logging_trace1(">>: %1", nodeListText);
+
+    const StringList addressList =
+        StringList::makeBySplit(nodeListText, _nodeSeparator);
+    Boolean isOkay = (TcpConnection::isAvailable()
+                      && addressList.size() > 0);
+    _hostNameList.clear();
+    _portList.clear();
+
+    for (const String& rawAddress : addressList) {
+        /* the port follows the last colon, such that the host may
+           be a bracketed IPv6 address */
+        const String address = STR::strip(rawAddress);
+        const size_t colonPosition = address.rfind(':');
+        const Boolean hasPort = (colonPosition != String::npos
+                                 && address.find(']', colonPosition)
+                                    == String::npos);
+        String hostName =
+            (hasPort ? address.substr(0, colonPosition) : address);
+        const Natural port =
+            (hasPort ? STR::toNatural(address.substr(colonPosition + 1),
+                                      0)
+             : SoXRenderNode::defaultPort);
+
+        if (hostName.length() >= 2
+            && STR::firstCharacter(hostName) == '['
+            && STR::lastCharacter(hostName) == ']') {
+            hostName = hostName.substr(1, hostName.length() - 2);
+        }
+
+        if (hostName == "" || port == 0 || port > 65535) {
+            isOkay = false;
+            _errorMessage = STR::expand("bad node address '%1'",
+                                        address);
+        } else {
+            _hostNameList.append(hostName);
+            _portList.append(port);
+        }
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
+
+/*--------------------*/
+
+void SoXRenderCoordinator::setInputIsMapped (IN Boolean isMapped)
+{
+    Logging_trace1(">>: %1", TOSTRING(isMapped));
+    _inputIsMapped = isMapped;
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXRenderCoordinator::setNodeTimeout (IN Real timeout)
+{
+    Logging_trace1(">>: %1", TOSTRING(timeout));
+    _nodeTimeout = timeout;
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* processing         */
+/*--------------------*/
+
+Boolean SoXRenderCoordinator::render (INOUT SoXOfflineRenderer& renderer,
+                                      IN String& inputFileName,
+                                      IN String& outputFileName,
+                                      IN Natural segmentCount,
+                                      IN Natural blockSize)
+{
+    Logging_trace4(">>: input = %1, output = %2, segmentCount = %3,"
+                   " blockSize = %4",
+                   inputFileName, outputFileName,
+                   TOSTRING(segmentCount), TOSTRING(blockSize));
+
+    const std::chrono::steady_clock::time_point startTime =
+        std::chrono::steady_clock::now();
+    const String parameterText = renderer.parameterText();
+    SoXAudioFileReader reader{};
+    Boolean isOkay = (parameterText != "" && blockSize > 0
+                      && _hostNameList.size() > 0);
+    Real warmupLength = Real::infinity;
+    _statistics = SoXClusterStatistics{};
+
+    if (!isOkay) {
+        _errorMessage = (parameterText == "" ? "no effect defined"
+                         : blockSize == 0 ? "block size must be positive"
+                         : "no render nodes defined");
+    } else if (!reader.open(inputFileName, _inputIsMapped)) {
+        isOkay = false;
+        _errorMessage = STR::expand("cannot read audio file %1",
+                                    inputFileName);
+    } else {
+        SoXAudioEffect* effect =
+            SoXOfflineRenderer::makeConfiguredEffect(parameterText,
+                                                     _errorMessage);
+        isOkay = (effect != nullptr);
+
+        if (isOkay) {
+            effect->prepareToPlay(Real{reader.format().sampleRate});
+            warmupLength = effect->warmupLength();
+            effect->releaseResources();
+        }
+
+        delete effect;
+    }
+
+    if (isOkay && warmupLength == Real::infinity) {
+        /* without a bounded warm-up the segments would differ from
+           a serial rendering */
+        Logging_trace("--: rendering locally");
+        reader.close();
+        isOkay = renderer.render(inputFileName, outputFileName,
+                                 blockSize);
+        _errorMessage = (isOkay ? "" : renderer.errorMessage());
+        _statistics.segmentCount      = 1;
+        _statistics.localSegmentCount = (isOkay ? 1 : 0);
+        _statistics.audioDuration     = renderer.renderedDuration();
+    } else if (isOkay) {
+        const SoXAudioFileFormat format = reader.format();
+        const Real sampleRate = Real{format.sampleRate};
+        const Natural frameCount = reader.frameCount();
+        const Natural warmupFrameCount{
+            (size_t) (double) Real::ceiling(warmupLength * sampleRate)};
+        const Natural connectionCount = _hostNameList.size();
+        const Natural framesPerTransfer =
+            Natural::maximum(1,
+                             _maximumSegmentByteCount
+                             / (format.channelCount
+                                * Natural{sizeof(AudioSample)}));
+
+        /* segments must be small enough for a transfer and longer
+           than their warm-up and a block */
+        Natural effectiveSegmentCount =
+            Natural::maximum((segmentCount > 0 ? segmentCount
+                              : connectionCount),
+                             (frameCount + framesPerTransfer - 1)
+                             / framesPerTransfer);
+        effectiveSegmentCount =
+            Natural::maximum(1,
+                             Natural::minimum(effectiveSegmentCount,
+                                              frameCount
+                                              / Natural::maximum(
+                                                  blockSize,
+                                                  warmupFrameCount)));
+        const Natural segmentLength =
+            Natural::maximum(1,
+                             (frameCount + effectiveSegmentCount - 1)
+                             / effectiveSegmentCount);
+        effectiveSegmentCount =
+            (frameCount + segmentLength - 1) / segmentLength;
+
+        SoXAudioFileWriter writer{};
+        reader.close();
+
+        if (!writer.open(outputFileName,
+                         SoXOfflineRenderer::outputFileFormat(
+                             format, outputFileName))) {
+            isOkay = false;
+            _errorMessage = STR::expand("cannot write audio file %1",
+                                        outputFileName);
+        } else {
+            _SoXClusterContext context{};
+            context.parameterText    = parameterText;
+            context.inputFileName    = inputFileName;
+            context.inputIsMapped    = _inputIsMapped;
+            context.sampleRate       = sampleRate;
+            context.channelCount     = format.channelCount;
+            context.blockSize        = blockSize;
+            context.frameCount       = frameCount;
+            context.segmentLength    = segmentLength;
+            context.warmupFrameCount = warmupFrameCount;
+            context.nodeTimeout      = _nodeTimeout;
+            context.writer           = &writer;
+            context.isOkay           = true;
+            context.errorMessage     = "";
+            Natural warmupFrameSum = 0;
+
+            for (Natural i = 0;  i < effectiveSegmentCount;  i++) {
+                Natural startFrame;
+                Natural segmentStart;
+                Natural segmentEnd;
+                _getSegmentBounds(context, i,
+                                  startFrame, segmentStart, segmentEnd);
+                context.pendingSegmentList.push_back(i);
+                warmupFrameSum += segmentStart - startFrame;
+            }
+
+            GenericList<std::thread> threadList;
+
+            for (Natural i = 0;  i < connectionCount;  i++) {
+                threadList.push_back(std::thread{_nodeWorker,
+                                                 std::ref(context),
+                                                 _hostNameList[i],
+                                                 _portList[i]});
+            }
+
+            for (std::thread& thread : threadList) {
+                thread.join();
+            }
+
+            /* segments left over by failed nodes are rendered
+               here */
+            _renderPendingSegmentsLocally(context);
+            isOkay = context.isOkay.load();
+
+            if (!isOkay) {
+                _errorMessage = STR::expand("%1 (rendering %2)",
+                                            context.errorMessage,
+                                            outputFileName);
+            }
+
+            _statistics = context.statistics;
+            _statistics.segmentCount   = effectiveSegmentCount;
+            _statistics.audioDuration  =
+                Real{writer.frameCount()} / sampleRate;
+            _statistics.warmupDuration =
+                Real{warmupFrameSum} / sampleRate;
+            writer.close();
+        }
+    }
+
+    _statistics.renderingTime = _elapsedTime(startTime);
+    Logging_trace3("<<: isOkay = %1, message = %2, statistics = %3",
+                   TOSTRING(isOkay), _errorMessage,
+                   _statistics.toString());
+    return isOkay;
+}
+
+/*--------------------*/
+/* queries            */
+/*--------------------*/
+
+SoXClusterStatistics SoXRenderCoordinator::statistics () const
+{
+    return _statistics;
+}
+
+/*--------------------*/
+
+String SoXRenderCoordinator::errorMessage () const
+{
+    return _errorMessage;
+}
@@ -0,0 +1,327 @@
+/**
+ * @file
+ * The <C>SoXRenderCluster</C> specification defines a render node
+ * serving segments of a rendering over TCP and a coordinator
+ * splitting the rendering of a long file across several such nodes.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "NaturalList.h"
+#include "SoXOfflineRenderer.h"
+
+/*--------------------*/
+
+using BaseTypes::Containers::NaturalList;
+
+/*====================*/
+
+namespace SoXPlugins::Renderer {
+
+    /**
+     * A <C>SoXClusterStatistics</C> object summarizes a rendering
+     * distributed by a coordinator.
+     */
+    struct SoXClusterStatistics {
+
+        /** the number of segments of the rendering */
+        Natural segmentCount;
+
+        /** the number of segments rendered by the nodes */
+        Natural remoteSegmentCount;
+
+        /** the number of segments rendered locally after all nodes
+         * had failed */
+        Natural localSegmentCount;
+
+        /** the number of segment attempts failed on some node and
+         * retried */
+        Natural retryCount;
+
+        /** the number of nodes dropped after a failure */
+        Natural failedNodeCount;
+
+        /** the duration of the rendered audio in seconds */
+        Real audioDuration;
+
+        /** the duration of the pre-roll audio processed in addition
+         * before the segments in seconds */
+        Real warmupDuration;
+
+        /** the elapsed time of the rendering in seconds */
+        Real renderingTime;
+
+        /*--------------------*/
+        /*--------------------*/
+
+        /**
+         * Makes statistics with all counters zero.
+         */
+        SoXClusterStatistics ();
+
+        /*--------------------*/
+
+        /**
+         * Returns string representation of statistics with the
+         * throughput and the pre-roll overhead.
+         *
+         * @return  string representation
+         */
+        String toString () const;
+
+    };
+
+    /*====================*/
+
+    /**
+     * A <C>SoXRenderNode</C> object serves segment requests of
+     * coordinators on a TCP port until the process is terminated.
+     * Each connection is served by a thread of its own, hence a
+     * coordinator uses several cores of a node by connecting to it
+     * several times.
+     *
+     * A request carries the parameter text of the effect, the
+     * sample rate, the position of the segment in the file and the
+     * input samples in blocks: first the pre-roll blocks before the
+     * segment and then the segment blocks.  The node processes all
+     * blocks in order by a fresh effect with the time positions of
+     * the file and answers with the processed segment blocks (or
+     * an error message).  Samples are transferred as doubles, such
+     * that the output of a node is identical to that of a local
+     * segmented rendering.  There is no authentication, hence
+     * nodes must only be reachable from a trusted network.
+     */
+    struct SoXRenderNode {
+
+        /** the default TCP port of a render node */
+        static const Natural defaultPort;
+
+        /*--------------------*/
+        /* con-/destruction   */
+        /*--------------------*/
+
+        /**
+         * Makes a node with default settings.
+         */
+        SoXRenderNode ();
+
+        /*--------------------*/
+
+        SoXRenderNode (IN SoXRenderNode&) = delete;
+
+        /*--------------------*/
+        /* configuration      */
+        /*--------------------*/
+
+        /**
+         * Defines whether each served segment is reported on the
+         * console depending on <C>isReported</C> (default: false).
+         *
+         * @param[in] isReported  information whether segments are
+         *                        reported
+         */
+        void setProgressIsReported (IN Boolean isReported);
+
+        /*--------------------*/
+        /* processing         */
+        /*--------------------*/
+
+        /**
+         * Serves segment requests on TCP port <C>port</C>; only
+         * returns (with false) when the port cannot be listened on.
+         *
+         * @param[in] port  TCP port to listen on
+         * @return  information whether node has been running
+         */
+        Boolean run (IN Natural port);
+
+        /*--------------------*/
+        /* queries            */
+        /*--------------------*/
+
+        /**
+         * Returns the description of the last failure.
+         *
+         * @return  error message (empty when there was no failure)
+         */
+        String errorMessage () const;
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** tells whether served segments are reported */
+            Boolean _progressIsReported;
+
+            /** the description of the last failure */
+            String _errorMessage;
+
+    };
+
+    /*====================*/
+
+    /**
+     * A <C>SoXRenderCoordinator</C> object renders an audio file
+     * like <C>SoXOfflineRenderer::renderInSegments</C>, but the
+     * segments are rendered by render nodes over TCP instead of
+     * local threads.  Each node address gets a worker thread with a
+     * connection of its own: it reads the input of the next pending
+     * segment (preceded by the pre-roll of the warm-up length of
+     * the effect), ships it to its node and writes the answer at
+     * the position of the segment in the output file, hence the
+     * output is stitched in order regardless of the completion
+     * order.
+     *
+     * When a node fails (no connection, a broken connection, a
+     * timeout or an error answer), its segment is put back for the
+     * other nodes and the node is dropped; segments still pending
+     * when all nodes are gone are rendered locally.  Because the
+     * segments are independent, the throughput grows with the
+     * number of nodes, reduced by the pre-roll processed per
+     * segment and by the network transfer.
+     */
+    struct SoXRenderCoordinator {
+
+        /** the default maximum time in seconds for sending a
+         * segment to a node or waiting for its answer */
+        static const Real defaultNodeTimeout;
+
+        /*--------------------*/
+        /* con-/destruction   */
+        /*--------------------*/
+
+        /**
+         * Makes a coordinator without nodes.
+         */
+        SoXRenderCoordinator ();
+
+        /*--------------------*/
+
+        SoXRenderCoordinator (IN SoXRenderCoordinator&) = delete;
+
+        /*--------------------*/
+        /* configuration      */
+        /*--------------------*/
+
+        /**
+         * Sets the render nodes from <C>nodeListText</C> with node
+         * addresses "host:port" (or just "host" for the default
+         * port) separated by commas; an address may occur several
+         * times for several connections to a node.  Tells whether
+         * the list is well-formed and not empty.
+         *
+         * @param[in] nodeListText  comma-separated node addresses
+         * @return  information whether node list has been set
+         */
+        Boolean setNodeList (IN String& nodeListText);
+
+        /*--------------------*/
+
+        /**
+         * Defines whether the input file shall be memory mapped
+         * (the default) depending on <C>isMapped</C>.
+         *
+         * @param[in] isMapped  information whether input file is
+         *                      memory mapped
+         */
+        void setInputIsMapped (IN Boolean isMapped);
+
+        /*--------------------*/
+
+        /**
+         * Sets the maximum time for sending a segment to a node or
+         * waiting for its answer to <C>timeout</C> seconds; a node
+         * exceeding it counts as failed.
+         *
+         * @param[in] timeout  node timeout in seconds
+         */
+        void setNodeTimeout (IN Real timeout);
+
+        /*--------------------*/
+        /* processing         */
+        /*--------------------*/
+
+        /**
+         * Renders the audio file named <C>inputFileName</C> through
+         * the effect of <C>renderer</C> into the file
+         * <C>outputFileName</C> on the nodes in
+         * <C>segmentCount</C> segments (zero selects one per node
+         * connection) of blocks of <C>blockSize</C> frames; more
+         * segments are used when a segment would be too large for a
+         * single transfer.  When the effect cannot be segmented (it
+         * has an unbounded warm-up), the file is rendered locally
+         * by <C>renderer</C>.  Tells whether rendering has been
+         * successful.
+         *
+         * @param[inout] renderer        renderer with the effect
+         * @param[in]    inputFileName   name of input audio file
+         * @param[in]    outputFileName  name of output audio file
+         * @param[in]    segmentCount    number of segments (zero for
+         *                               automatic)
+         * @param[in]    blockSize       number of frames per block
+         * @return  information whether rendering has been successful
+         */
+        Boolean render (INOUT SoXOfflineRenderer& renderer,
+                        IN String& inputFileName,
+                        IN String& outputFileName,
+                        IN Natural segmentCount = 0,
+                        IN Natural blockSize =
+                            SoXOfflineRenderer::defaultBlockSize);
+
+        /*--------------------*/
+        /* queries            */
+        /*--------------------*/
+
+        /**
+         * Returns the statistics of the last rendering.
+         *
+         * @return  cluster statistics
+         */
+        SoXClusterStatistics statistics () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the description of the last failure.
+         *
+         * @return  error message (empty when there was no failure)
+         */
+        String errorMessage () const;
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the host names of the node connections */
+            StringList _hostNameList;
+
+            /** the ports of the node connections */
+            NaturalList _portList;
+
+            /** tells whether the input file is memory mapped */
+            Boolean _inputIsMapped;
+
+            /** the maximum time for a transfer to or from a node in
+             * seconds */
+            Real _nodeTimeout;
+
+            /** the statistics of the last rendering */
+            SoXClusterStatistics _statistics;
+
+            /** the description of the last failure */
+            String _errorMessage;
+
+    };
+
+}
@@ -0,0 +1,617 @@
+/**
+ * @file
+ * The <C>SoXRenderDaemon</C> body implements a long-running renderer
+ * taking render requests from a watched directory and processing
+ * them on warm worker threads.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXRenderDaemon.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include "File.h"
+#include "Logging.h"
+#include "OperatingSystem.h"
+#include "SoXOfflineRenderer.h"
+
+/*--------------------*/
+
+using BaseModules::File;
+using BaseModules::OperatingSystem;
+using SoXPlugins::Renderer::SoXBatchJob;
+using SoXPlugins::Renderer::SoXBatchJobList;
+using SoXPlugins::Renderer::SoXBatchRenderer;
+using SoXPlugins::Renderer::SoXDaemonStatistics;
+using SoXPlugins::Renderer::SoXOfflineRenderer;
+using SoXPlugins::Renderer::SoXRenderDaemon;
+
+/** abbreviation for StringUtil */
+using STR = BaseModules::StringUtil;
+
+/*====================*/
+
+/** the extension of request files */
+static const String _requestExtension = ".job";
+
+/** the name of the file stopping the daemon */
+static const String _stopFileName = "stop";
+
+/*--------------------*/
+
+const Real SoXRenderDaemon::defaultPollingInterval = 0.1;
+
+/*====================*/
+
+/**
+ * A <C>_SoXDaemonJobResult</C> object tells the outcome of a single
+ * job of a request.
+ */
+struct _SoXDaemonJobResult {
+
+    /** tells whether the job has been successful */
+    Boolean isOkay;
+
+    /** the duration of the rendered audio in seconds */
+    Real audioDuration;
+
+    /** the time for setting up the effect in seconds */
+    Real setupTime;
+
+    /** the time for rendering in seconds */
+    Real renderingTime;
+
+    /** the time from the pickup of the request to the completion of
+     * the job in seconds */
+    Real latency;
+
+    /** the description of a failure */
+    String errorMessage;
+
+};
+
+/*--------------------*/
+
+/**
+ * A <C>_SoXDaemonContext</C> object holds the data shared by the
+ * dispatching thread and the workers of a daemon: the jobs of the
+ * current request are queued by index and their results collected.
+ */
+struct _SoXDaemonContext {
+
+    /** the number of frames per block */
+    Natural blockSize;
+
+    /** tells whether input files are memory mapped */
+    Boolean inputIsMapped;
+
+    /** tells whether completed jobs are reported */
+    Boolean progressIsReported;
+
+    /** the peak level of normalization jobs in decibels */
+    Real normalizationLevel;
+
+    /** the mutex protecting the data below */
+    std::mutex mutex;
+
+    /** the condition signalled on a change of queue or results */
+    std::condition_variable changeCondition;
+
+    /** the jobs of the current request */
+    const SoXBatchJobList* jobList;
+
+    /** the indices of the queued jobs */
+    std::deque<size_t> jobIndexList;
+
+    /** tells whether the daemon is shutting down */
+    bool isClosed;
+
+    /** the results of the jobs of the current request */
+    GenericList<_SoXDaemonJobResult> resultList;
+
+    /** the number of completed jobs of the current request */
+    size_t completedCount;
+
+    /** the time of the pickup of the current request */
+    std::chrono::steady_clock::time_point requestStartTime;
+
+};
+
+/*--------------------*/
+/* auxiliary routines */
+/*--------------------*/
+
+/**
+ * Returns the seconds elapsed since <C>startTime</C>.
+ *
+ * @param[in] startTime  start time point
+ * @return  elapsed time in seconds
+ */
+static Real
+_elapsedTime (IN std::chrono::steady_clock::time_point& startTime)
+{
+    const std::chrono::duration<double> duration =
+        std::chrono::steady_clock::now() - startTime;
+    return Real{duration.count()};
+}
+
+/*--------------------*/
+
+/**
+ * Returns <C>value</C> in fixed point notation with
+ * <C>fractionalDigitCount</C> digits after the decimal point.
+ *
+ * @param[in] value                 number to be formatted
+ * @param[in] fractionalDigitCount  number of fractional digits
+ * @return  string representation
+ */
+static String _toFixedString (IN Real value,
+                              IN int fractionalDigitCount)
+{
+    std::ostringstream stream;
+    stream << std::fixed << std::setprecision(fractionalDigitCount)
+           << (double) value;
+    return stream.str();
+}
+
+/*--------------------*/
+
+/**
+ * Returns the throughput for <C>audioDuration</C> seconds of audio
+ * rendered in <C>time</C> seconds as a multiple of real time.
+ *
+ * @param[in] audioDuration  duration of audio in seconds
+ * @param[in] time           processing time in seconds
+ * @return  throughput (zero for an empty time)
+ */
+static Real _throughput (IN Real audioDuration, IN Real time)
+{
+    return (time > 0.0 ? audioDuration / time : Real{0.0});
+}
+
+/*--------------------*/
+
+/**
+ * Returns the line describing <C>result</C> of the job with output
+ * file <C>outputFileName</C> in a result file.
+ *
+ * @param[in] outputFileName  name of output file of job
+ * @param[in] result          job result
+ * @return  line for result file (without newline)
+ */
+static String _resultLine (IN String& outputFileName,
+                           IN _SoXDaemonJobResult& result)
+{
+    const String statusText = (result.isOkay ? "ok" : "FAILED");
+    const String detailText =
+        (!result.isOkay ? result.errorMessage
+         : STR::expand("audio = %1s, latency = %2s, setup = %3s,"
+                       " rendering = %4s, throughput = %5x realtime",
+                       _toFixedString(result.audioDuration, 3),
+                       _toFixedString(result.latency, 3),
+                       _toFixedString(result.setupTime, 4),
+                       _toFixedString(result.renderingTime, 3),
+                       _toFixedString(_throughput(result.audioDuration,
+                                                  result.renderingTime),
+                                      1)));
+    return STR::expand("%1\t%2\t%3", statusText, outputFileName,
+                       detailText);
+}
+
+/*--------------------*/
+
+/**
+ * Returns the names of the request files in the directory named
+ * <C>directoryName</C> in ascending order.
+ *
+ * @param[in] directoryName  name of watched directory
+ * @return  list of request file names (without directory)
+ */
+static StringList _requestNameList (IN String& directoryName)
+{
+    StringList result;
+
+    for (const String& fileName
+             : OperatingSystem::fileNameList(directoryName)) {
+        if (STR::endsWith(fileName, _requestExtension)) {
+            result.append(fileName);
+        }
+    }
+
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+/*--------------------*/
+
+/**
+ * Processes the jobs of the requests in <C>context</C> as worker
+ * <C>workerIndex</C> with a single offline renderer until the
+ * daemon shuts down.
+ *
+ * @param[inout] context      daemon context
+ * @param[in]    workerIndex  index of worker
+ */
+static void _workerLoop (INOUT _SoXDaemonContext& context,
+                         IN size_t workerIndex)
+{
+    Logging_trace1(">>: %1", TOSTRING(workerIndex));
+
+    SoXOfflineRenderer renderer{};
+    renderer.setInputIsMapped(context.inputIsMapped);
+    Boolean isDone = false;
+
+    while (!isDone) {
+        const SoXBatchJob* job = nullptr;
+        size_t jobIndex = 0;
+
+        {
+            std::unique_lock<std::mutex> lock{context.mutex};
+            context.changeCondition.wait(lock, [&] () {
+                return (!context.jobIndexList.empty()
+                        || context.isClosed);
+            });
+            isDone = context.jobIndexList.empty();
+
+            if (!isDone) {
+                jobIndex = context.jobIndexList.front();
+                context.jobIndexList.pop_front();
+                job = &(*context.jobList)[jobIndex];
+            }
+        }
+
+        if (!isDone) {
+            std::chrono::steady_clock::time_point startTime =
+                std::chrono::steady_clock::now();
+            _SoXDaemonJobResult result;
+            result.setupTime = 0.0;
+
+            if (job->parameterFileName == "") {
+                /* the gain effect is made between the two passes,
+                   hence its setup counts as rendering */
+                result.isOkay =
+                    renderer.renderNormalized(job->inputFileName,
+                                              job->outputFileName,
+                                              context.normalizationLevel,
+                                              context.blockSize);
+            } else {
+                result.isOkay =
+                    renderer.readParameterFile(job->parameterFileName);
+                result.setupTime = _elapsedTime(startTime);
+                startTime = std::chrono::steady_clock::now();
+                result.isOkay =
+                    (result.isOkay
+                     && renderer.render(job->inputFileName,
+                                        job->outputFileName,
+                                        context.blockSize));
+            }
+
+            result.renderingTime = _elapsedTime(startTime);
+            result.audioDuration =
+                (result.isOkay ? renderer.renderedDuration()
+                 : Real{0.0});
+            result.errorMessage  =
+                (result.isOkay ? "" : renderer.errorMessage());
+
+            std::lock_guard<std::mutex> lock{context.mutex};
+            result.latency = _elapsedTime(context.requestStartTime);
+            context.resultList[jobIndex] = result;
+            context.completedCount++;
+            context.changeCondition.notify_all();
+
+            if (context.progressIsReported) {
+                OperatingSystem::writeMessageToConsole(
+                    STR::expand("%1 %2 (latency %3s, %4x realtime)",
+                                job->outputFileName,
+                                (result.isOkay ? "done" : "FAILED"),
+                                _toFixedString(result.latency, 3),
+                                _toFixedString(
+                                    _throughput(result.audioDuration,
+                                                result.renderingTime),
+                                    1)));
+            }
+        }
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+/**
+ * Claims and processes the request file named <C>requestFileName</C>
+ * on the workers of <C>context</C>, writes its result file and adds
+ * its jobs to <C>statistics</C>; a request already claimed by
+ * another daemon is skipped.
+ *
+ * @param[inout] context          daemon context
+ * @param[in]    requestFileName  name of request file
+ * @param[inout] statistics       statistics of daemon
+ */
+static void _processRequest (INOUT _SoXDaemonContext& context,
+                             IN String& requestFileName,
+                             INOUT SoXDaemonStatistics& statistics)
+{
+    Logging_trace1(">>: %1", requestFileName);
+
+    const String runningFileName = requestFileName + ".running";
+    const std::chrono::steady_clock::time_point startTime =
+        std::chrono::steady_clock::now();
+
+    /* renaming is atomic, hence only one daemon gets the request */
+    if (std::rename(requestFileName.c_str(),
+                    runningFileName.c_str()) == 0) {
+        SoXBatchJobList jobList;
+        String errorMessage;
+        const Boolean isOkay =
+            SoXBatchRenderer::readJobList(runningFileName, jobList,
+                                          errorMessage);
+        const size_t jobCount = (size_t) jobList.length();
+        StringList resultLineList;
+
+        if (!isOkay) {
+            resultLineList.append(STR::expand("FAILED\t%1\t%2",
+                                              requestFileName,
+                                              errorMessage));
+        } else {
+            std::unique_lock<std::mutex> lock{context.mutex};
+            context.jobList          = &jobList;
+            context.requestStartTime = startTime;
+            context.completedCount   = 0;
+            context.resultList.clear();
+            context.resultList.setLength(jobCount);
+
+            for (size_t jobIndex = 0;  jobIndex < jobCount;  jobIndex++) {
+                context.jobIndexList.push_back(jobIndex);
+            }
+
+            context.changeCondition.notify_all();
+            context.changeCondition.wait(lock, [&] () {
+                return (context.completedCount == jobCount);
+            });
+            context.jobList = nullptr;
+        }
+
+        for (size_t jobIndex = 0;  isOkay && jobIndex < jobCount;
+             jobIndex++) {
+            const _SoXDaemonJobResult& result =
+                context.resultList[jobIndex];
+            resultLineList.append(
+                _resultLine(jobList[jobIndex].outputFileName, result));
+            statistics.jobCount++;
+            statistics.failureCount  += (result.isOkay ? 0 : 1);
+            statistics.audioDuration += result.audioDuration;
+            statistics.setupTime     += result.setupTime;
+            statistics.renderingTime += result.renderingTime;
+            statistics.latency       += result.latency;
+        }
+
+        statistics.requestCount++;
+        File file;
+
+        if (file.open(requestFileName + ".result", "wb")) {
+            file.writeString(resultLineList.join("\n") + "\n");
+            file.close();
+        }
+
+        std::rename(runningFileName.c_str(),
+                    (requestFileName + ".done").c_str());
+    }
+
+    Logging_trace("<<");
+}
+
+/*====================*/
+
+SoXDaemonStatistics::SoXDaemonStatistics ()
+    : requestCount{0},
+      jobCount{0},
+      failureCount{0},
+      audioDuration{0.0},
+      setupTime{0.0},
+      renderingTime{0.0},
+      latency{0.0}
+{
+}
+
+/*--------------------*/
+
+String SoXDaemonStatistics::toString () const
+{
+    const Real divisor = Real{(double) Natural::maximum(1, jobCount)};
+    return STR::expand("requests = %1, jobs = %2, failures = %3,"
+                       " audio = %4s, mean latency = %5s,"
+                       " mean setup = %6s,"
+                       " throughput = %7x realtime per job",
+                       TOSTRING(requestCount), TOSTRING(jobCount),
+                       TOSTRING(failureCount),
+                       _toFixedString(audioDuration, 1),
+                       _toFixedString(latency / divisor, 3),
+                       _toFixedString(setupTime / divisor, 4),
+                       _toFixedString(_throughput(audioDuration,
+                                                  renderingTime), 1));
+}
+
+/*====================*/
+
+/*--------------------*/
+/* con-/destruction   */
+/*--------------------*/
+
+SoXRenderDaemon::SoXRenderDaemon ()
+    : _threadCount{0},
+      _blockSize{SoXOfflineRenderer::defaultBlockSize},
+      _inputIsMapped{true},
+      _progressIsReported{false},
+      _normalizationLevel{0.0},
+      _pollingInterval{defaultPollingInterval},
+      _statistics{},
+      _errorMessage{""}
+{
+    Logging_trace(">>");
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* configuration      */
+/*--------------------*/
+
+void SoXRenderDaemon::setThreadCount (IN Natural threadCount)
+{
+    Logging_trace1(">>: %1", TOSTRING(threadCount));
+    _threadCount = threadCount;
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXRenderDaemon::setBlockSize (IN Natural blockSize)
+{
+    Logging_trace1(">>: %1", TOSTRING(blockSize));
+    _blockSize = blockSize;
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXRenderDaemon::setInputIsMapped (IN Boolean isMapped)
+{
+    Logging_trace1(">>: %1", TOSTRING(isMapped));
+    _inputIsMapped = isMapped;
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXRenderDaemon::setProgressIsReported (IN Boolean isReported)
+{
+    Logging_trace1(">>: %1", TOSTRING(isReported));
+    _progressIsReported = isReported;
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXRenderDaemon::setNormalizationLevel (IN Real level)
+{
+    Logging_trace1(">>: %1", TOSTRING(level));
+    _normalizationLevel = level;
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXRenderDaemon::setPollingInterval (IN Real interval)
+{
+    Logging_trace1(">>: %1", TOSTRING(interval));
+    _pollingInterval = interval;
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/* processing         */
+/*--------------------*/
+
+Boolean SoXRenderDaemon::run (IN String& directoryName)
+{
+    Logging_trace1(">>: %1", directoryName);
+
+    const Boolean isOkay = OperatingSystem::directoryExists(directoryName);
+
+    if (!isOkay) {
+        _errorMessage = STR::expand("cannot watch directory %1",
+                                    directoryName);
+    } else {
+        const Natural hardwareThreadCount =
+            Natural::maximum(1,
+                             (size_t) std::thread::hardware_concurrency());
+        const Natural threadCount =
+            (_threadCount == 0 ? hardwareThreadCount : _threadCount);
+        const String stopFileName = directoryName + "/" + _stopFileName;
+        const std::chrono::duration<double> pollingInterval{
+            (double) _pollingInterval};
+
+        _SoXDaemonContext context{};
+        context.blockSize          = _blockSize;
+        context.inputIsMapped      = _inputIsMapped;
+        context.progressIsReported = _progressIsReported;
+        context.normalizationLevel = _normalizationLevel;
+        context.jobList            = nullptr;
+        context.isClosed           = false;
+        context.completedCount     = 0;
+
+        GenericList<std::thread> threadList;
+
+        for (Natural i = 0;  i < threadCount;  i++) {
+            threadList.push_back(std::thread{_workerLoop,
+                                             std::ref(context),
+                                             (size_t) i});
+        }
+
+        Boolean isStopped = false;
+
+        while (!isStopped) {
+            const StringList requestNameList =
+                _requestNameList(directoryName);
+
+            for (Natural i = 0;  !isStopped && i < requestNameList.size();
+                 i++) {
+                _processRequest(context,
+                                directoryName + "/" + requestNameList[i],
+                                _statistics);
+                isStopped = OperatingSystem::fileExists(stopFileName);
+            }
+
+            isStopped = OperatingSystem::fileExists(stopFileName);
+
+            if (!isStopped && requestNameList.size() == 0) {
+                std::this_thread::sleep_for(pollingInterval);
+            }
+        }
+
+        std::remove(stopFileName.c_str());
+
+        {
+            std::lock_guard<std::mutex> lock{context.mutex};
+            context.isClosed = true;
+            context.changeCondition.notify_all();
+        }
+
+        for (std::thread& thread : threadList) {
+            thread.join();
+        }
+    }
+
+    Logging_trace2("<<: isOkay = %1, statistics = %2",
+                   TOSTRING(isOkay), _statistics.toString());
+    return isOkay;
+}
+
+/*--------------------*/
+/* queries            */
+/*--------------------*/
+
+SoXDaemonStatistics SoXRenderDaemon::statistics () const
+{
+    return _statistics;
+}
+
+/*--------------------*/
+
+String SoXRenderDaemon::errorMessage () const
+{
+    return _errorMessage;
+}
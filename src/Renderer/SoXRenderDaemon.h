@@ -0,0 +1,250 @@
+/**
+ * @file
+ * The <C>SoXRenderDaemon</C> specification defines a long-running
+ * renderer taking render requests from a watched directory and
+ * processing them on warm worker threads.
+ *
+ * @author Dr. Thomas Tensi
+ * @date   2024-03
+ */
+
+/*====================*/
+
+#pragma once
+
+/*=========*/
+/* IMPORTS */
+/*=========*/
+
+#include "SoXBatchRenderer.h"
+
+/*====================*/
+
+namespace SoXPlugins::Renderer {
+
+    /**
+     * A <C>SoXDaemonStatistics</C> object summarizes the requests
+     * processed by a daemon so far.
+     */
+    struct SoXDaemonStatistics {
+
+        /** the number of requests processed */
+        Natural requestCount;
+
+        /** the number of jobs processed */
+        Natural jobCount;
+
+        /** the number of failed jobs */
+        Natural failureCount;
+
+        /** the total duration of the rendered audio in seconds */
+        Real audioDuration;
+
+        /** the time for setting up the effects summed over all
+         * jobs in seconds */
+        Real setupTime;
+
+        /** the rendering time summed over all jobs in seconds */
+        Real renderingTime;
+
+        /** the latency (from the pickup of its request to its
+         * completion) summed over all jobs in seconds */
+        Real latency;
+
+        /*--------------------*/
+        /*--------------------*/
+
+        /**
+         * Makes statistics with all counters zero.
+         */
+        SoXDaemonStatistics ();
+
+        /*--------------------*/
+
+        /**
+         * Returns string representation of statistics with the mean
+         * latency and setup time and the throughput per job.
+         *
+         * @return  string representation
+         */
+        String toString () const;
+
+    };
+
+    /*====================*/
+
+    /**
+     * A <C>SoXRenderDaemon</C> object watches a directory for render
+     * requests and processes them until it is stopped; the process
+     * start, the construction of the parameter map prototypes and
+     * the generation of the effect tables (both shared by all
+     * instances of an effect) are paid once instead of per file.
+     * The workers are started once and keep their offline
+     * renderers; each job still gets a fresh effect instance
+     * (copying the warm prototypes), because the processing state
+     * of a used instance is not reset by <C>prepareToPlay</C> in
+     * all effects, so each output is identical to that of a
+     * separate program run.
+     *
+     * A request is a file with extension ".job" in the manifest
+     * format of the batch renderer (relative names are taken
+     * relative to the watched directory).  The daemon claims a
+     * request by renaming it to ".job.running", spreads its jobs
+     * over the workers and, when all are complete, writes a file
+     * ".job.result" with one line per job (status, output file,
+     * audio duration, latency, effect setup time, rendering time
+     * and throughput) and renames the request to ".job.done".
+     * Requests are processed in the order of their names; a file
+     * named "stop" in the directory ends the daemon after the
+     * current request and is removed.
+     */
+    struct SoXRenderDaemon {
+
+        /** the default time between two scans of the directory in
+         * seconds */
+        static const Real defaultPollingInterval;
+
+        /*--------------------*/
+        /* con-/destruction   */
+        /*--------------------*/
+
+        /**
+         * Makes a daemon with default settings.
+         */
+        SoXRenderDaemon ();
+
+        /*--------------------*/
+
+        SoXRenderDaemon (IN SoXRenderDaemon&) = delete;
+
+        /*--------------------*/
+        /* configuration      */
+        /*--------------------*/
+
+        /**
+         * Sets the number of worker threads to <C>threadCount</C>;
+         * zero (the default) selects the number of hardware
+         * threads.
+         *
+         * @param[in] threadCount  number of worker threads
+         */
+        void setThreadCount (IN Natural threadCount);
+
+        /*--------------------*/
+
+        /**
+         * Sets the number of frames per block for all jobs.
+         *
+         * @param[in] blockSize  number of frames per block
+         */
+        void setBlockSize (IN Natural blockSize);
+
+        /*--------------------*/
+
+        /**
+         * Defines whether input files shall be memory mapped (the
+         * default) depending on <C>isMapped</C>.
+         *
+         * @param[in] isMapped  information whether input files are
+         *                      memory mapped
+         */
+        void setInputIsMapped (IN Boolean isMapped);
+
+        /*--------------------*/
+
+        /**
+         * Defines whether each completed job is reported on the
+         * console depending on <C>isReported</C> (default: false).
+         *
+         * @param[in] isReported  information whether jobs are
+         *                        reported
+         */
+        void setProgressIsReported (IN Boolean isReported);
+
+        /*--------------------*/
+
+        /**
+         * Sets the peak level for jobs without parameter file in
+         * decibels full scale (default: 0dB).
+         *
+         * @param[in] level  peak level of normalized files
+         */
+        void setNormalizationLevel (IN Real level);
+
+        /*--------------------*/
+
+        /**
+         * Sets the time between two scans of the watched directory
+         * to <C>interval</C> seconds.
+         *
+         * @param[in] interval  polling interval in seconds
+         */
+        void setPollingInterval (IN Real interval);
+
+        /*--------------------*/
+        /* processing         */
+        /*--------------------*/
+
+        /**
+         * Processes the requests in the directory named
+         * <C>directoryName</C> until it is stopped and tells whether
+         * the directory could be watched (failed jobs are only
+         * reported in the result files).
+         *
+         * @param[in] directoryName  name of watched directory
+         * @return  information whether directory has been watched
+         */
+        Boolean run (IN String& directoryName);
+
+        /*--------------------*/
+        /* queries            */
+        /*--------------------*/
+
+        /**
+         * Returns the statistics of the requests processed so far.
+         *
+         * @return  daemon statistics
+         */
+        SoXDaemonStatistics statistics () const;
+
+        /*--------------------*/
+
+        /**
+         * Returns the description of the last failure.
+         *
+         * @return  error message (empty when there was no failure)
+         */
+        String errorMessage () const;
+
+        /*--------------------*/
+        /*--------------------*/
+
+        private:
+
+            /** the number of worker threads (zero for automatic) */
+            Natural _threadCount;
+
+            /** the number of frames per block */
+            Natural _blockSize;
+
+            /** tells whether input files are memory mapped */
+            Boolean _inputIsMapped;
+
+            /** tells whether completed jobs are reported */
+            Boolean _progressIsReported;
+
+            /** the peak level of normalization jobs in decibels */
+            Real _normalizationLevel;
+
+            /** the time between two directory scans in seconds */
+            Real _pollingInterval;
+
+            /** the statistics of the requests processed */
+            SoXDaemonStatistics _statistics;
+
+            /** the description of the last failure */
+            String _errorMessage;
+
+    };
+
+}
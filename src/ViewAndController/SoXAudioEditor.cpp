@@ -14,15 +14,19 @@
 
 #include "SoXAudioEditor.h"
 
+#include <cmath>
 #include <map>
 #include "Logging.h"
 #include "NaturalList.h"
+#include "SoXProcessingProfiler.h"
 #include "StringSet.h"
 
 /*--------------------*/
 
 using BaseTypes::Containers::NaturalList;
 using BaseTypes::Containers::StringSet;
+using SoXPlugins::Helpers::SoXProcessingProfiler;
+using SoXPlugins::Helpers::SoXProcessingStatistics;
 using SoXPlugins::ViewAndController::SoXAudioEditor;
 using SoXPlugins::ViewAndController::SoXAudioEditorWidgetPtrList;
 
@@ -104,6 +108,32 @@ static const juce::Colour _dimmedBackgroundColor  = _grey8;
 static const Natural _defaultWidth    = 500;
 /** the default height of an SoXPlugin widget in pixels */
 static const Natural _heightPerWidget =  40;
+/** the height of the profiling overlay line in pixels */
+static const Natural _profilingOverlayHeight = 16;
+/** the rate of applying pending parameter changes in Hz */
+static const int _changeNotificationRate = 30;
+/** the rate of checking whether a hidden editor is showing again in
+ * Hz */
+static const int _hiddenPollingRate = 2;
+/** the number of timer ticks between refreshes of the profiling
+ * overlay (about 4Hz) */
+static const Natural _profilingOverlayTickCount = 8;
+/** the width of the level meter at the right border in pixels */
+static const Natural _levelMeterWidth = 24;
+/** the lowest level shown in the level meter in decibels */
+static const double _levelMeterMinimumDb = -60.0;
+/** the largest gain reduction shown in the level meter in
+ * decibels */
+static const double _levelMeterMaximumGainReduction = 24.0;
+/** the factor applied to the displayed levels per timer tick
+ * without new levels (about 20dB per second) */
+static const double _levelMeterFalloffFactor = 0.93;
+/** the color of the RMS level bars */
+static const juce::Colour _levelRmsColor = _green.darker(0.3f);
+/** the color of the peak level marks */
+static const juce::Colour _levelPeakColor = _yellow;
+/** the color of the gain reduction bars */
+static const juce::Colour _gainReductionColor = _red.darker(0.2f);
 
 /*--------------------*/
 /* auxiliary routines */
@@ -303,6 +333,48 @@ static NaturalList _findPageIndices (INOUT SoXAudioEditor* currentEditor)
 
 /*--------------------*/
 
+/**
+ * Ensures that each widget in <C>widgetList</C> shown on page
+ * <C>pageIndex</C> has its components: they are taken over from an
+ * inactive widget of the same shape or newly made otherwise.
+ *
+ * @param[inout] widgetList  widget list of current editor
+ * @param[in]    pageIndex   current editor page
+ */
+static void
+_makeComponentsForPage (INOUT SoXAudioEditorWidgetPtrList& widgetList,
+                        IN Natural pageIndex)
+{
+    Logging_trace1(">>: page = %1", TOSTRING(pageIndex));
+
+    const Natural widgetCount = widgetList.size();
+
+    for (SoXAudioEditorWidget* widget : widgetList) {
+        if (widget->isOnPage(pageIndex) && !widget->hasComponents()) {
+            /* find some inactive widget to take the components
+               from */
+            Natural donorIndex = 0;
+
+            while (donorIndex < widgetCount
+                   && (widgetList[donorIndex]->isOnPage(pageIndex)
+                       || !widget->canAdoptComponentsOf(
+                                     *widgetList[donorIndex]))) {
+                donorIndex++;
+            }
+
+            if (donorIndex < widgetCount) {
+                widget->adoptComponentsOf(*widgetList[donorIndex]);
+            } else {
+                widget->makeComponents();
+            }
+        }
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
 /**
  * Tells each widget in <C>widgetList</C> about new page
  * <C>currentEditorPage</C>.
@@ -323,6 +395,45 @@ _notifyWidgetsAboutPageChange (INOUT SoXAudioEditorWidgetPtrList& widgetList,
     Logging_trace("<<");
 }
 
+/*--------------------*/
+
+/**
+ * Returns the relative height in the level meter for the linear
+ * <C>level</C>, from zero at the lowest level shown to one at full
+ * scale.
+ *
+ * @param[in] level  the linear level
+ * @return  relative height in the unit interval
+ */
+static float _relativeLevelHeight (IN Real level)
+{
+    const double dBLevel =
+        (level <= Real{0.0} ? _levelMeterMinimumDb
+         : 20.0 * std::log10((double) level));
+    const double result = 1.0 - dBLevel / _levelMeterMinimumDb;
+    return (float) (result < 0.0 ? 0.0 : (result > 1.0 ? 1.0 : result));
+}
+
+/*--------------------*/
+
+/**
+ * Lowers <C>displayedValue</C> by the falloff factor unless
+ * <C>newValue</C> is larger; tells whether the displayed value is
+ * still visible.
+ *
+ * @param[inout] displayedValue  the value shown in the level meter
+ * @param[in]    newValue        the newly measured value (or zero)
+ * @return  information whether the displayed value is nonzero
+ */
+static Boolean _applyLevelFalloff (INOUT Real& displayedValue,
+                                   IN Real newValue)
+{
+    Real value = displayedValue * _levelMeterFalloffFactor;
+    value = (value < Real{1E-4} ? Real{0.0} : value);
+    displayedValue = Real::maximum(value, newValue);
+    return (displayedValue > Real{0.0});
+}
+
 /*--------------------*/
 /* EXPORTED FEATURES  */
 /*--------------------*/
@@ -332,12 +443,27 @@ SoXAudioEditor::SoXAudioEditor (INOUT SoXAudioProcessor& processor)
       _processor(processor),
       _currentEditorPageIndex(1),
       _lastEditorPageIndex(1),
-      _fixedWidgetPercentage(Percentage{100.0})
+      _fixedWidgetPercentage(Percentage{100.0}),
+      _backgroundImage{},
+      _backgroundIsActivePage(false),
+      _backgroundScaleFactor(1.0),
+      _widgetsNeedPageNotification(true),
+      _isShowing(false),
+      _profilingOverlayIsShown(false),
+      _memoryFootprintText{},
+      _pendingChangeSet{},
+      _changeKindSetList{},
+      _timerTickCount(0),
+      _displayedLevels{},
+      _acquiredLevels{}
 {
     Logging_trace(">>");
 
     _changeLookAndFeel(getLookAndFeel());
 
+    /* the background image covers the whole editor */
+    setOpaque(true);
+
     /* define some default size */
     setSize(50, 50);
 
@@ -358,10 +484,25 @@ SoXAudioEditor::SoXAudioEditor (INOUT SoXAudioProcessor& processor)
     _lastEditorPageIndex    = pageIndices[0];
     _currentEditorPageIndex = pageIndices[1];
 
+    /* one slot per parameter and one for changes without
+       parameter */
+    const Natural slotCount =
+        effectParameterMap().parameterNameList().size() + 1;
+    _pendingChangeSet.setLength(slotCount);
+    _changeKindSetList.setLength(slotCount, 0);
+    _pendingValueList.setLength(slotCount);
+    _pendingParameterIdList.clear();
+
     /* register at audio processor for change notification */
     _processor.registerObserver(this);
     _resetAppearance();
 
+    /* the timer applies the pending changes and polls the levels
+       and the profiling switch; it runs at full rate only when the
+       editor is showing */
+    startTimerHz(_hiddenPollingRate);
+    _updateShowingState();
+
     Logging_trace("<<");
 }
 
@@ -370,6 +511,8 @@ SoXAudioEditor::SoXAudioEditor (INOUT SoXAudioProcessor& processor)
 SoXAudioEditor::~SoXAudioEditor ()
 {
     Logging_trace(">>");
+    stopTimer();
+    _submitPendingValues();
     _processor.unregisterObserver(this);
     _clearWidgetList(_widgetList);
     Logging_trace("<<");
@@ -383,40 +526,116 @@ void SoXAudioEditor::paint (juce::Graphics& graphics)
 {
     Logging_trace(">>");
 
-    juce::Rectangle<int> rectangle = getLocalBounds();
-    const Integer height{rectangle.getHeight()};
-    const Integer y{_fixedWidgetPercentage.of(height)};
-    Logging_trace2("--: height = %1, y = %2",
-                   height.toString(), y.toString());
-
-    /* fill fixed part with default background color */
-    rectangle.setHeight((int) y);
-    graphics.setColour(_defaultBackgroundColor);
-    graphics.fillRect(rectangle);
-
-    /* fill page part with color depending on activeness of page */
+    /* the static background is only rendered again when the size,
+       the display scale or the page activeness has changed */
     const Boolean isActivePage =
         (_currentEditorPageIndex <= _lastEditorPageIndex);
-    const juce::Colour pageColor = (isActivePage
-                                    ? _activePageColor
-                                    : _inactivePageColor);
-    rectangle.setY((int) y);
-    rectangle.setHeight((int) (height - y));
-    graphics.setColour(pageColor);
-    graphics.fillRect(rectangle);
+    const Real scaleFactor =
+        Real{graphics.getInternalContext().getPhysicalPixelScaleFactor()};
+
+    if (!_backgroundImage.isValid()
+        || isActivePage != _backgroundIsActivePage
+        || scaleFactor != _backgroundScaleFactor) {
+        _renderBackground(isActivePage, scaleFactor);
+    }
+
+    graphics.drawImage(_backgroundImage, getLocalBounds().toFloat());
+
+    if (_widgetsNeedPageNotification) {
+        _notifyWidgetsAboutPageChange(_widgetList, _currentEditorPageIndex);
+        _widgetsNeedPageNotification = false;
+    }
 
-    _notifyWidgetsAboutPageChange(_widgetList, _currentEditorPageIndex);
     Logging_trace("<<");
 }
 
 /*--------------------*/
 
+void SoXAudioEditor::paintOverChildren (juce::Graphics& graphics)
+{
+    const juce::Rectangle<int> meterBounds = _levelMeterBounds();
+    const Natural channelCount = _displayedLevels.channelCount;
+    const Natural gainReductionCount = _displayedLevels.gainReductionCount;
+    const Natural barCount = channelCount + gainReductionCount;
+
+    if (barCount > 0) {
+        /* one bar per channel from the bottom (RMS filled, peak as
+           a mark) followed by one bar per gain reduction from the
+           top */
+        const float barWidth =
+            (float) meterBounds.getWidth() / (float) barCount;
+        const float height = (float) meterBounds.getHeight();
+        const float bottom = (float) meterBounds.getBottom();
+        float x = (float) meterBounds.getX();
+
+        for (Natural channel = 0;  channel < channelCount;  channel++) {
+            const float rmsHeight =
+                height * _relativeLevelHeight(_displayedLevels
+                                              .rmsList[(size_t) channel]);
+            const float peakHeight =
+                height * _relativeLevelHeight(_displayedLevels
+                                              .peakList[(size_t) channel]);
+            graphics.setColour(_levelRmsColor);
+            graphics.fillRect(x, bottom - rmsHeight,
+                              barWidth - 1.0f, rmsHeight);
+            graphics.setColour(_levelPeakColor);
+            graphics.fillRect(x, bottom - peakHeight,
+                              barWidth - 1.0f, 2.0f);
+            x += barWidth;
+        }
+
+        for (Natural i = 0;  i < gainReductionCount;  i++) {
+            const double gainReduction =
+                (double) _displayedLevels.gainReductionList[(size_t) i];
+            const float reductionHeight =
+                height * (float) (gainReduction
+                                  >= _levelMeterMaximumGainReduction
+                                  ? 1.0
+                                  : (gainReduction
+                                     / _levelMeterMaximumGainReduction));
+            graphics.setColour(_gainReductionColor);
+            graphics.fillRect(x, (float) meterBounds.getY(),
+                              barWidth - 1.0f, reductionHeight);
+            x += barWidth;
+        }
+    }
+
+    if (_profilingOverlayIsShown) {
+        const SoXProcessingStatistics statistics =
+            _processor.processingStatistics();
+        const String text =
+            STR::expand("CPU: mean %1us, p99 %2us, max %3us, load %4%,"
+                        " max load %5%, >80% %6, xruns %7",
+                        TOSTRING(statistics.meanTime),
+                        TOSTRING(statistics.percentile99Time),
+                        TOSTRING(statistics.maximumTime),
+                        TOSTRING(statistics.load),
+                        TOSTRING(statistics.maximumLoad),
+                        TOSTRING(statistics.criticalBudgetCount),
+                        TOSTRING(statistics.overrunCount))
+            + _memoryFootprintText;
+
+        juce::Rectangle<int> rectangle = getLocalBounds();
+        rectangle =
+            rectangle.removeFromBottom((int) _profilingOverlayHeight);
+        graphics.setColour(_semiGrey5);
+        graphics.fillRect(rectangle);
+        graphics.setColour(_black);
+        graphics.drawText(juce::String(text), rectangle,
+                          juce::Justification::centred, true);
+    }
+}
+
+/*--------------------*/
+
 void SoXAudioEditor::resized ()
 {
     Logging_trace(">>");
-    for (SoXAudioEditorWidget* widget : _widgetList) {
-        widget->resized();
-    }
+    _backgroundImage = juce::Image{};
+
+    /* the page is set again for the widgets, because other editors
+       may have changed it */
+    _notifyWidgetsAboutPageChange(_widgetList, _currentEditorPageIndex);
     Logging_trace("<<");
 }
 
@@ -432,8 +651,24 @@ const SoXEffectParameterMap& SoXAudioEditor::effectParameterMap () const
 void SoXAudioEditor::setValue (IN String& parameterName,
                                IN String& value)
 {
-    Logging_trace(">>");
-    _processor.setValue(parameterName, value);
+    Logging_trace2(">>: parameterName = %1, value = %2",
+                   parameterName, value);
+
+    const Natural parameterId = effectParameterMap().parameterId(parameterName);
+
+    if (parameterId == SoXEffectParameterMap::undefinedId
+        || parameterId >= _pendingValueList.length()) {
+        _processor.setValue(parameterName, value);
+    } else {
+        /* only the latest value per parameter and timer tick is
+           submitted */
+        if (_pendingValueList[parameterId].empty()) {
+            _pendingParameterIdList.append(parameterId);
+        }
+
+        _pendingValueList[parameterId] = value;
+    }
+
     Logging_trace("<<");
 }
 
@@ -445,43 +680,290 @@ SoXAudioEditor::notifyAboutChange (IN SoXParameterValueChangeKind kind,
 {
     Logging_trace2(">>: kind = %1, data = %2",
                    SoXParameterValueChangeKind_toString(kind), data);
-    Boolean repaintIsNecessary = false;
 
-    if (kind == SoXParameterValueChangeKind::globalChange) {
-        _resetAppearance();
-    } else if (kind == SoXParameterValueChangeKind::pageChange) {
-        repaintIsNecessary = true;
-    } else {
-        const String parameterName = data;
-        const String value = effectParameterMap().value(parameterName);
-        Logging_trace2("--: parameterName = %1, value = %2",
-                       parameterName, value);
-
-        for (SoXAudioEditorWidget* widget : _widgetList) {
-            if (widget->parameterName() == parameterName) {
-                widget->setValue(value);
+    /* changes without a known parameter go to the last slot */
+    const Natural parameterId = effectParameterMap().parameterId(data);
+    const Natural index =
+        (parameterId == SoXEffectParameterMap::undefinedId
+         ? _pendingChangeSet.length() - 1 : parameterId);
+    _pendingChangeSet.mark(index, kind);
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+/*--------------------*/
+
+void SoXAudioEditor::visibilityChanged ()
+{
+    _updateShowingState();
+}
+
+/*--------------------*/
+
+void SoXAudioEditor::parentHierarchyChanged ()
+{
+    _updateShowingState();
+}
+
+/*--------------------*/
+
+void SoXAudioEditor::timerCallback ()
+{
+    _submitPendingValues();
+
+    /* minimizing a window does not necessarily lead to a callback,
+       hence the state is also polled */
+    _updateShowingState();
+
+    if (_isShowing) {
+        _flushPendingChanges();
+        _updateLevelMeter();
+        _timerTickCount =
+            (_timerTickCount + 1) % _profilingOverlayTickCount;
+
+        if (_timerTickCount == 0) {
+            const Boolean overlayIsShown =
+                SoXProcessingProfiler::isEnabled();
+
+            if (overlayIsShown || _profilingOverlayIsShown) {
+                _profilingOverlayIsShown = overlayIsShown;
+
+                if (overlayIsShown) {
+                    _updateMemoryFootprintText();
+                }
+
+                const juce::Rectangle<int> rectangle =
+                    getLocalBounds()
+                        .removeFromBottom((int) _profilingOverlayHeight);
+                repaint(rectangle);
             }
         }
+    }
+}
+
+/*--------------------*/
 
-        if (kind == SoXParameterValueChangeKind::pageCountChange) {
-            _lastEditorPageIndex =
-                Natural::maximum(1, STR::toNatural(value, 1));
-            repaintIsNecessary = true;
-        } else if (SoXEffectParameterMap::isPageSelector(parameterName)) {
-            _currentEditorPageIndex =
-                Natural::maximum(1, STR::toNatural(value, 1));
-            repaintIsNecessary = true;
+void SoXAudioEditor::_submitPendingValues ()
+{
+    const Natural count = _pendingParameterIdList.length();
+
+    if (count > 0) {
+        Logging_trace1(">>: count = %1", TOSTRING(count));
+
+        const SoXEffectParameterMap& parameterMap = effectParameterMap();
+
+        for (Natural i = 0;  i < count;  i++) {
+            const Natural parameterId = _pendingParameterIdList[i];
+            const String& parameterName =
+                parameterMap.parameterName(parameterId);
+            const Boolean recalculationIsForced = (i + 1 == count);
+            _processor.setValue(parameterName,
+                                _pendingValueList[parameterId],
+                                recalculationIsForced);
+            _pendingValueList[parameterId].clear();
         }
+
+        _pendingParameterIdList.clear();
+        Logging_trace("<<");
     }
+}
+
+/*--------------------*/
 
-    if (repaintIsNecessary) {
-        repaint();
+void SoXAudioEditor::_updateShowingState ()
+{
+    const Boolean isShowingNow = isShowing();
+
+    if (isShowingNow != _isShowing) {
+        Logging_trace1(">>: %1", TOSTRING(isShowingNow));
+        _isShowing = isShowingNow;
+
+        if (!isShowingNow) {
+            startTimerHz(_hiddenPollingRate);
+        } else {
+            /* resynchronize with all changes recorded while
+               hidden */
+            startTimerHz(_changeNotificationRate);
+            _flushPendingChanges();
+            repaint();
+        }
+
+        Logging_trace("<<");
     }
+}
 
-    Logging_trace("<<");
+/*--------------------*/
+
+void SoXAudioEditor::_updateMemoryFootprintText ()
+{
+    const Natural bytesPerKiB = 1024;
+    const SoXMemoryFootprint footprint = _processor.memoryFootprint();
+    Natural effectCount;
+    const SoXMemoryFootprint totalFootprint =
+        SoXAudioEffect::totalMemoryFootprint(effectCount);
+    _memoryFootprintText =
+        STR::expand(" | MEM: %1KiB (delay %2KiB, ring %3KiB),"
+                    " all %4 effects %5KiB",
+                    TOSTRING(footprint.totalByteCount() / bytesPerKiB),
+                    TOSTRING(footprint.delayLineByteCount / bytesPerKiB),
+                    TOSTRING(footprint.ringBufferByteCount / bytesPerKiB),
+                    TOSTRING(effectCount),
+                    TOSTRING(totalFootprint.totalByteCount()
+                             / bytesPerKiB));
 }
 
 /*--------------------*/
+
+juce::Rectangle<int> SoXAudioEditor::_levelMeterBounds () const
+{
+    /* the widget rows leave a margin at the right border, the
+       profiling overlay keeps the bottom line */
+    juce::Rectangle<int> result = getLocalBounds();
+    result.removeFromBottom((int) _profilingOverlayHeight);
+    result = result.removeFromRight((int) _levelMeterWidth).reduced(2);
+    return result;
+}
+
+/*--------------------*/
+
+void SoXAudioEditor::_updateLevelMeter ()
+{
+    const Boolean isAcquired = _processor.acquireLevels(_acquiredLevels);
+    Boolean repaintIsNecessary = false;
+
+    if (isAcquired) {
+        _displayedLevels.channelCount = _acquiredLevels.channelCount;
+        _displayedLevels.gainReductionCount =
+            _acquiredLevels.gainReductionCount;
+    }
+
+    /* without new levels the displayed levels fall off towards
+       zero */
+    const Real zero{0.0};
+
+    for (size_t channel = 0;
+         channel < (size_t) _displayedLevels.channelCount;  channel++) {
+        const Boolean peakIsVisible =
+            _applyLevelFalloff(_displayedLevels.peakList[channel],
+                               (isAcquired
+                                ? _acquiredLevels.peakList[channel]
+                                : zero));
+        const Boolean rmsIsVisible =
+            _applyLevelFalloff(_displayedLevels.rmsList[channel],
+                               (isAcquired
+                                ? _acquiredLevels.rmsList[channel]
+                                : zero));
+        repaintIsNecessary =
+            repaintIsNecessary || peakIsVisible || rmsIsVisible;
+    }
+
+    for (size_t i = 0;
+         i < (size_t) _displayedLevels.gainReductionCount;  i++) {
+        const Boolean reductionIsVisible =
+            _applyLevelFalloff(_displayedLevels.gainReductionList[i],
+                               (isAcquired
+                                ? _acquiredLevels.gainReductionList[i]
+                                : zero));
+        repaintIsNecessary = repaintIsNecessary || reductionIsVisible;
+    }
+
+    if (repaintIsNecessary || isAcquired) {
+        repaint(_levelMeterBounds());
+    }
+}
+
+/*--------------------*/
+
+void SoXAudioEditor::_flushPendingChanges ()
+{
+    if (_pendingChangeSet.takeChangeIndication()) {
+        Logging_trace(">>");
+
+        const SoXParameterValueChangeKind globalChange =
+            SoXParameterValueChangeKind::globalChange;
+        const SoXParameterValueChangeKind pageChange =
+            SoXParameterValueChangeKind::pageChange;
+        const SoXParameterValueChangeKind pageCountChange =
+            SoXParameterValueChangeKind::pageCountChange;
+        const SoXParameterValueChangeKind parameterChange =
+            SoXParameterValueChangeKind::parameterChange;
+        const SoXEffectParameterMap& parameterMap = effectParameterMap();
+        const Natural slotCount = _pendingChangeSet.length();
+        Boolean appearanceIsReset = false;
+        Boolean repaintIsNecessary = false;
+
+        for (Natural i = 0;  i < slotCount;  i++) {
+            const Natural kindSet = _pendingChangeSet.take(i);
+            _changeKindSetList[i] = kindSet;
+            appearanceIsReset =
+                (appearanceIsReset
+                 || SoXParameterChangeSet::contains(kindSet, globalChange));
+            repaintIsNecessary =
+                (repaintIsNecessary
+                 || SoXParameterChangeSet::contains(kindSet, pageChange));
+        }
+
+        if (appearanceIsReset) {
+            _resetAppearance();
+        }
+
+        /* the audio thread may change values meanwhile, hence they
+           are taken from a consistent snapshot */
+        GenericList<Real> numericValueList;
+        GenericList<Boolean> valueIsKnownList;
+        parameterMap.readValueSnapshot(numericValueList, valueIsKnownList);
+
+        /* the last slot has no parameter and hence no value */
+        for (Natural parameterId = 0;  parameterId < slotCount - 1;
+             parameterId++) {
+            const Natural kindSet = _changeKindSetList[parameterId];
+
+            if (SoXParameterChangeSet::contains(kindSet, parameterChange)
+                || SoXParameterChangeSet::contains(kindSet,
+                                                   pageCountChange)) {
+                const String& parameterName =
+                    parameterMap.parameterName(parameterId);
+                const String value =
+                    (valueIsKnownList[parameterId]
+                     ? parameterMap.valueFromNumericValue(
+                           parameterId, numericValueList[parameterId])
+                     : SoXEffectParameterMap::unknownValue);
+                Logging_trace2("--: parameterName = %1, value = %2",
+                               parameterName, value);
+
+                /* the widget only repaints itself */
+                for (SoXAudioEditorWidget* widget : _widgetList) {
+                    if (widget->parameterName() == parameterName) {
+                        widget->setValue(value);
+                    }
+                }
+
+                if (SoXParameterChangeSet::contains(kindSet,
+                                                    pageCountChange)) {
+                    _lastEditorPageIndex =
+                        Natural::maximum(1, STR::toNatural(value, 1));
+                    repaintIsNecessary = true;
+                } else if (SoXEffectParameterMap
+                           ::isPageSelector(parameterName)) {
+                    _currentEditorPageIndex =
+                        Natural::maximum(1, STR::toNatural(value, 1));
+                    _makeComponentsForPage(_widgetList,
+                                           _currentEditorPageIndex);
+                    _widgetsNeedPageNotification = true;
+                    repaintIsNecessary = true;
+                }
+            }
+        }
+
+        if (repaintIsNecessary) {
+            repaint();
+        }
+
+        Logging_trace("<<");
+    }
+}
+
 /*--------------------*/
 
 void SoXAudioEditor::_resetAppearance ()
@@ -489,6 +971,8 @@ void SoXAudioEditor::_resetAppearance ()
     Logging_trace(">>");
 
     NaturalList widgetCountList = _addWidgetsToList(this, _widgetList);
+    _makeComponentsForPage(_widgetList, _currentEditorPageIndex);
+    _widgetsNeedPageNotification = true;
     const Natural fixedWidgetCount = widgetCountList[0];
     const Natural maximumWidgetCount =
         Natural::maximum(1, widgetCountList[1]);
@@ -517,5 +1001,50 @@ void SoXAudioEditor::_resetAppearance ()
                           * Real{fixedWidgetCount})
                       - rowSpaceHeight / two)};
 
+    /* the fixed part may have changed */
+    _backgroundImage = juce::Image{};
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXAudioEditor::_renderBackground (IN Boolean isActivePage,
+                                        IN Real scaleFactor)
+{
+    Logging_trace2(">>: isActivePage = %1, scaleFactor = %2",
+                   TOSTRING(isActivePage), TOSTRING(scaleFactor));
+
+    juce::Rectangle<int> rectangle = getLocalBounds();
+    const Integer width{rectangle.getWidth()};
+    const Integer height{rectangle.getHeight()};
+    const Integer y{_fixedWidgetPercentage.of(height)};
+    const int imageWidth =
+        (int) Integer::maximum(1, (Integer) Real::round(Real{width}
+                                                        * scaleFactor));
+    const int imageHeight =
+        (int) Integer::maximum(1, (Integer) Real::round(Real{height}
+                                                        * scaleFactor));
+    _backgroundImage =
+        juce::Image(juce::Image::RGB, imageWidth, imageHeight, false);
+    juce::Graphics graphics(_backgroundImage);
+    graphics.addTransform(juce::AffineTransform::scale((float) scaleFactor));
+
+    /* fill fixed part with default background color */
+    rectangle.setHeight((int) y);
+    graphics.setColour(_defaultBackgroundColor);
+    graphics.fillRect(rectangle);
+
+    /* fill page part with color depending on activeness of page */
+    const juce::Colour pageColor = (isActivePage
+                                    ? _activePageColor
+                                    : _inactivePageColor);
+    rectangle.setY((int) y);
+    rectangle.setHeight((int) (height - y));
+    graphics.setColour(pageColor);
+    graphics.fillRect(rectangle);
+
+    _backgroundIsActivePage = isActivePage;
+    _backgroundScaleFactor  = scaleFactor;
     Logging_trace("<<");
 }
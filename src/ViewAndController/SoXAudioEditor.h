@@ -17,12 +17,20 @@
 /*=========*/
 
 #include "GenericList.h"
+#include "NaturalList.h"
 #include "SoXAudioEditorWidget.h"
 #include "SoXAudioProcessor.h"
+#include "SoXLevelMeter.h"
+#include "SoXParameterChangeSet.h"
+#include "StringList.h"
 
 /*--------------------*/
 
+using BaseTypes::Containers::NaturalList;
+using BaseTypes::Containers::StringList;
 using BaseTypes::GenericTypes::GenericList;
+using SoXPlugins::Helpers::SoXLevelMeterSnapshot;
+using SoXPlugins::Helpers::SoXParameterChangeSet;
 using SoXPlugins::ViewAndController::SoXAudioProcessor;
 using SoXPlugins::ViewAndController::SoXAudioEditorWidget;
 
@@ -38,9 +46,34 @@ namespace SoXPlugins::ViewAndController {
     /**
      * A <C>SoXAudioEditor</C> object models the (generic)audio editor
      * for a plugin, represented by a display window containing the
-     * parameters in editor widgets.
+     * parameters in editor widgets.  While profiling is switched
+     * on, the processing time and deadline statistics of the
+     * processor are shown in an overlay line at the bottom of the
+     * editor together with the memory footprint of the instance and
+     * of all effects in the process.  A level
+     * meter at the right border shows the peak and RMS output level
+     * per channel and the gain reductions of the effect; it polls
+     * the levels measured on the audio thread at the display rate
+     * and never touches the audio buffers.
+     *
+     * Change notifications from the processor are only recorded as
+     * pending change kinds per parameter and applied to the widgets
+     * by a timer at a bounded rate; hence dense automation leads to
+     * at most one widget update per parameter and timer tick, and
+     * the complete editor is only repainted on page changes.
+     * Likewise value changes from the widgets (like a slider drag)
+     * are coalesced to the latest value per parameter and only
+     * submitted to the processor once per timer tick, hence the
+     * effect recalculates at most once per display frame.
+     *
+     * While the editor is not showing (hidden or in a minimized
+     * window), no changes are applied and the level meter is not
+     * refreshed; the timer then only checks at a low rate whether
+     * the editor is showing again.  When it is, all changes
+     * recorded in the meantime are applied in a single pass.
      */
-    struct SoXAudioEditor : public juce::AudioProcessorEditor {
+    struct SoXAudioEditor : public juce::AudioProcessorEditor,
+                            private juce::Timer {
 
         /**
          * Creates an empty audio editor (without fields)
@@ -69,11 +102,39 @@ namespace SoXPlugins::ViewAndController {
 
         /*--------------------*/
 
+        /**
+         * Tells editor to paint the level meter and the profiling
+         * overlay (if any) over the widgets in <C>graphics</C>.
+         *
+         * @param graphics  JUCE graphics context to be used by
+         *                  editor
+         */
+        void paintOverChildren (juce::Graphics& graphics) override;
+
+        /*--------------------*/
+
         /**
          * Tells editor to resize contents.
          */
         void resized() override;
 
+        /*--------------------*/
+
+        /**
+         * Tells editor that its visibility has changed; the
+         * refresh is suspended or resumed accordingly.
+         */
+        void visibilityChanged () override;
+
+        /*--------------------*/
+
+        /**
+         * Tells editor that it has been added to or removed from
+         * some parent; the refresh is suspended or resumed
+         * accordingly.
+         */
+        void parentHierarchyChanged () override;
+
         /*--------------------*/
         /* parameter mgmt     */
         /*--------------------*/
@@ -91,7 +152,10 @@ namespace SoXPlugins::ViewAndController {
         /**
          * Sets parameter named <C>parameterName</C> to
          * <C>value</C> (caused by a change in one of the embedded
-         * widgets).  If value has wrong kind, it is ignored.
+         * widgets).  If value has wrong kind, it is ignored.  The
+         * value is only recorded and submitted to the processor on
+         * the next timer tick, where a later value for the same
+         * parameter replaces it.
          *
          * @param[in] parameterName  name of parameter to be set
          * @param[in] value          new value of parameter
@@ -102,10 +166,14 @@ namespace SoXPlugins::ViewAndController {
         /*--------------------*/
 
         /**
-         * Callback method to get informed about a change.
+         * Callback method to get informed about a change; the
+         * change is only recorded and displayed on the next timer
+         * tick, hence this neither blocks nor repaints and may be
+         * called from any thread.
          *
          * @param[in] kind  change kind
-         * @param[in] data  data depending on change kind
+         * @param[in] data  data depending on change kind (the
+         *                  parameter name for parameter changes)
          */
         virtual void notifyAboutChange (IN SoXParameterValueChangeKind kind,
                                         IN String& data="");
@@ -132,6 +200,87 @@ namespace SoXPlugins::ViewAndController {
 
         private:
 
+            /**
+             * Applies the pending changes and refreshes the level
+             * meter and the profiling overlay periodically.
+             */
+            void timerCallback () override;
+
+            /*--------------------*/
+
+            /**
+             * Takes over the latest levels from the processor into
+             * the displayed levels (which fall off slowly when no
+             * new levels arrive) and repaints the level meter when
+             * necessary.
+             */
+            void _updateLevelMeter ();
+
+            /*--------------------*/
+
+            /**
+             * Recalculates the memory footprint of the processor
+             * and the total footprint of all effects in the process
+             * for the profiling overlay.
+             */
+            void _updateMemoryFootprintText ();
+
+            /*--------------------*/
+
+            /**
+             * Returns the area of the level meter in the editor.
+             *
+             * @return  rectangle of level meter
+             */
+            juce::Rectangle<int> _levelMeterBounds () const;
+
+            /*--------------------*/
+
+            /**
+             * Applies all changes recorded by
+             * <C>notifyAboutChange</C> since the last call to the
+             * widgets and the page setup; repaints the editor at most
+             * once.
+             */
+            void _flushPendingChanges ();
+
+            /*--------------------*/
+
+            /**
+             * Submits the values recorded by <C>setValue</C> since
+             * the last call to the processor; only the last
+             * submission forces a recalculation of the effect.
+             */
+            void _submitPendingValues ();
+
+            /*--------------------*/
+
+            /**
+             * Checks whether the editor is showing on screen; on a
+             * change either suspends the refresh (and lowers the
+             * timer rate) or resumes it by applying all pending
+             * changes and repainting the editor.
+             */
+            void _updateShowingState ();
+
+            /*--------------------*/
+
+            /**
+             * Renders the static background (the fixed part and
+             * the page part in the color for <C>isActivePage</C>)
+             * into the cached background image for a display with
+             * <C>scaleFactor</C> physical pixels per logical pixel.
+             *
+             * @param[in] isActivePage  tells whether the current
+             *                          page is active
+             * @param[in] scaleFactor   the physical pixel scale
+             *                          factor of the display
+             */
+            void _renderBackground (IN Boolean isActivePage,
+                                    IN Real scaleFactor);
+
+            /*--------------------*/
+
             /** list of all widgets shown in this sox audio
              * editor */
             SoXAudioEditorWidgetPtrList _widgetList;
@@ -147,6 +296,63 @@ namespace SoXPlugins::ViewAndController {
              * to the maximum widget count (for a paged editor) */
             Percentage _fixedWidgetPercentage;
 
+            /** the cached rendering of the static background;
+             * invalid when it must be rendered again */
+            juce::Image _backgroundImage;
+
+            /** tells whether the cached background shows an active
+             * page */
+            Boolean _backgroundIsActivePage;
+
+            /** the physical pixel scale factor of the cached
+             * background */
+            Real _backgroundScaleFactor;
+
+            /** tells whether the widgets must be told about the
+             * current page on the next paint (after a page change or
+             * a reset of the widgets) */
+            Boolean _widgetsNeedPageNotification;
+
+            /** tells whether the editor is currently showing on
+             * screen; otherwise the refresh is suspended */
+            Boolean _isShowing;
+
+            /** tells whether the profiling overlay is currently
+             * shown */
+            Boolean _profilingOverlayIsShown;
+
+            /** the memory footprint text in the profiling overlay
+             * (refreshed by the timer) */
+            String _memoryFootprintText;
+
+            /** the pending change kinds per parameter identification
+             * with an additional last slot for changes without
+             * parameter */
+            SoXParameterChangeSet _pendingChangeSet;
+
+            /** the change kinds taken from the pending change set
+             * during a flush (preallocated) */
+            NaturalList _changeKindSetList;
+
+            /** the latest values set by the widgets and not yet
+             * submitted to the processor indexed by parameter
+             * identification (empty for no pending value) */
+            StringList _pendingValueList;
+
+            /** the identifications of the parameters with pending
+             * values in order of their first change */
+            NaturalList _pendingParameterIdList;
+
+            /** the number of timer ticks since the last refresh of
+             * the profiling overlay */
+            Natural _timerTickCount;
+
+            /** the levels shown in the level meter */
+            SoXLevelMeterSnapshot _displayedLevels;
+
+            /** the levels last acquired from the processor */
+            SoXLevelMeterSnapshot _acquiredLevels;
+
             /*--------------------*/
 
             JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SoXAudioEditor)
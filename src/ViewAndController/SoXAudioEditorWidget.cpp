@@ -109,53 +109,59 @@ namespace SoXPlugins::ViewAndController {
     /*--------------------*/
 
     /**
-     * Constructs a JUCE widget from <C>map</C> for parameter named
-     * <C>parameterName</C> with <C>kind</C> defining either a slider or a
-     * combo box; <C>eventDispatcher</C> defines the event handler for the
-     * editor.
+     * Adapts JUCE widget <C>widget</C> of <C>kind</C> to parameter
+     * named <C>parameterName</C> from <C>map</C>: sets its name, its
+     * range and its current value and moves its change listener from
+     * <C>oldEventDispatcher</C> (if any) to <C>eventDispatcher</C>;
+     * the items of a combo box are expected to be already there.
      *
-     * @param[in] map              audio parameter map for this editor
-     * @param[in] parameterName    the parameter associated with new widget
-     * @param[in] kind             the parameter kind of widget
-     * @param[in] eventDispatcher  the associated event dispatcher for this
-     *                             editor
+     * @param[inout] widget              the JUCE widget to be adapted
+     * @param[in] map                    audio parameter map for this
+     *                                   editor
+     * @param[in] parameterName          the parameter associated with
+     *                                   widget
+     * @param[in] kind                   the parameter kind of widget
+     * @param[in] oldEventDispatcher     the event dispatcher
+     *                                   previously listening to
+     *                                   widget (or NULL)
+     * @param[in] eventDispatcher        the event dispatcher for the
+     *                                   editor
      */
-    static juce::Component* _makeWidget (IN SoXEffectParameterMap& map,
-                                         IN String& parameterName,
-                                         IN SoXEffectParameterKind& kind,
-                                         EventDispatcher* eventDispatcher)
+    static void _adaptWidget (INOUT juce::Component* widget,
+                              IN SoXEffectParameterMap& map,
+                              IN String& parameterName,
+                              IN SoXEffectParameterKind& kind,
+                              EventDispatcher* oldEventDispatcher,
+                              EventDispatcher* eventDispatcher)
     {
         Logging_trace2(">>: name = %1, kind = %2",
                        parameterName, effectParameterKindToString(kind));
 
-        juce::Component* result;
-        const juce::String componentName = juce::String(parameterName);
         const String currentValue = map.value(parameterName);
+        widget->setName(juce::String(parameterName));
 
-        if (kind == SoXEffectParameterKind::unknownKind) {
-            const juce::String lText("????");
-            juce::Label* label = new juce::Label(componentName);
-            label->setText(lText, noNotification);
-            result = label;
-        } else if (kind == SoXEffectParameterKind::enumKind) {
+        if (kind == SoXEffectParameterKind::enumKind) {
+            juce::ComboBox* comboBox =
+                dynamic_cast<juce::ComboBox*>(widget);
             StringList valueList;
-            juce::ComboBox* comboBox = new juce::ComboBox(componentName);
             map.valueRangeEnum(parameterName, valueList);
             Natural selectedId = 0;
 
             for (Natural i = 1;  i <= valueList.size();  i++) {
                 const String st = valueList[i - 1];
-                const juce::String itemText(st);
-                comboBox->addItem(itemText, (int) i);
                 selectedId = (st == currentValue ? i : selectedId);
             }
 
             comboBox->setSelectedId((int) selectedId, noNotification);
+
+            if (oldEventDispatcher != NULL) {
+                comboBox->removeListener(oldEventDispatcher);
+            }
+
             comboBox->addListener(eventDispatcher);
-            result = comboBox;
-        } else {
+        } else if (kind != SoXEffectParameterKind::unknownKind) {
+            juce::Slider* slider = dynamic_cast<juce::Slider*>(widget);
             Real lowValue, highValue, delta;
-            juce::Slider* slider = new juce::Slider(componentName);
 
             if (kind == SoXEffectParameterKind::realKind) {
                 map.valueRangeReal(parameterName,
@@ -172,15 +178,95 @@ namespace SoXPlugins::ViewAndController {
                              (double) delta);
             slider->setValue((double) STR::toReal(currentValue),
                              noNotification);
-            slider->setVelocityBasedMode(true);
+
+            if (oldEventDispatcher != NULL) {
+                slider->removeListener(oldEventDispatcher);
+            }
+
             slider->addListener(eventDispatcher);
+        }
+
+        Logging_trace("<<");
+    }
+
+    /*--------------------*/
+
+    /**
+     * Constructs a JUCE widget from <C>map</C> for parameter named
+     * <C>parameterName</C> with <C>kind</C> defining either a slider or a
+     * combo box; <C>eventDispatcher</C> defines the event handler for the
+     * editor.
+     *
+     * @param[in] map              audio parameter map for this editor
+     * @param[in] parameterName    the parameter associated with new widget
+     * @param[in] kind             the parameter kind of widget
+     * @param[in] eventDispatcher  the associated event dispatcher for this
+     *                             editor
+     */
+    static juce::Component* _makeWidget (IN SoXEffectParameterMap& map,
+                                         IN String& parameterName,
+                                         IN SoXEffectParameterKind& kind,
+                                         EventDispatcher* eventDispatcher)
+    {
+        Logging_trace2(">>: name = %1, kind = %2",
+                       parameterName, effectParameterKindToString(kind));
+
+        juce::Component* result;
+
+        if (kind == SoXEffectParameterKind::unknownKind) {
+            const juce::String lText("????");
+            juce::Label* label = new juce::Label();
+            label->setText(lText, noNotification);
+            result = label;
+        } else if (kind == SoXEffectParameterKind::enumKind) {
+            StringList valueList;
+            juce::ComboBox* comboBox = new juce::ComboBox();
+            map.valueRangeEnum(parameterName, valueList);
+
+            for (Natural i = 1;  i <= valueList.size();  i++) {
+                const juce::String itemText(valueList[i - 1]);
+                comboBox->addItem(itemText, (int) i);
+            }
+
+            result = comboBox;
+        } else {
+            juce::Slider* slider = new juce::Slider();
+            slider->setVelocityBasedMode(true);
             result = slider;
         }
 
+        _adaptWidget(result, map, parameterName, kind,
+                     NULL, eventDispatcher);
         Logging_trace("<<");
         return result;
     }
 
+    /*--------------------*/
+
+    /**
+     * Returns the shape of a widget for parameter named
+     * <C>parameterName</C> in <C>map</C>: the parameter kind and for
+     * enums the list of values.
+     *
+     * @param[in] map            audio parameter map for this editor
+     * @param[in] parameterName  the parameter associated with widget
+     * @return  string describing the shape
+     */
+    static String _widgetShape (IN SoXEffectParameterMap& map,
+                                IN String& parameterName)
+    {
+        const SoXEffectParameterKind kind = map.kind(parameterName);
+        String result = effectParameterKindToString(kind);
+
+        if (kind == SoXEffectParameterKind::enumKind) {
+            StringList valueList;
+            map.valueRangeEnum(parameterName, valueList);
+            result += ":" + valueList.toString();
+        }
+
+        return result;
+    }
+
 }
 
 /*============================================================*/
@@ -194,24 +280,20 @@ SoXAudioEditorWidget::SoXAudioEditorWidget (INOUT juce::Component* parent,
                                             IN String& parameterName,
                                             IN String& labelText)
     : _parameterName(parameterName),
-      _labelWidget(new juce::Label()),
+      _labelText(labelText),
+      _shape(_widgetShape(map, parameterName)),
+      _parent(parent),
+      _pageNumber(0),
+      _rowNumber(0),
+      _labelWidget(NULL),
+      _controlWidget(NULL),
       _parameterMap(map)
 {
     Logging_trace2(">>: name = %1, label = %2", parameterName, labelText);
 
-    const SoXEffectParameterKind kind = map.kind(parameterName);
-    const juce::String lText(labelText);
     SoXAudioEditor* editor = dynamic_cast<SoXAudioEditor*>(parent);
-    EventDispatcher* eventDispatcher = new EventDispatcher(editor);
-
-    _controlWidget   = _makeWidget(map, parameterName, kind,
-                                   eventDispatcher);
-    _eventDispatcher = eventDispatcher;
-    _labelWidget->setText(lText, noNotification);
+    _eventDispatcher = new EventDispatcher(editor);
 
-    /* add real widgets to parent */
-    parent->addChildComponent(_labelWidget);
-    parent->addChildComponent(_controlWidget);
     Logging_trace("<<");
 }
 
@@ -237,6 +319,76 @@ String SoXAudioEditorWidget::parameterName () const
     return _parameterName;
 }
 
+/*--------------------*/
+
+Boolean SoXAudioEditorWidget::isOnPage (IN Natural pageNumber) const
+{
+    return (_pageNumber == pageNumber || _pageNumber == 0);
+}
+
+/*--------------------*/
+
+Boolean SoXAudioEditorWidget::hasComponents () const
+{
+    return (_controlWidget != NULL);
+}
+
+/*--------------------*/
+/* component handling */
+/*--------------------*/
+
+void SoXAudioEditorWidget::makeComponents ()
+{
+    Logging_trace1(">>: %1", _parameterName);
+
+    if (!hasComponents()) {
+        const SoXEffectParameterKind kind = _parameterMap.kind(_parameterName);
+        EventDispatcher* eventDispatcher =
+            (EventDispatcher*) _eventDispatcher;
+        _labelWidget   = new juce::Label();
+        _controlWidget = _makeWidget(_parameterMap, _parameterName, kind,
+                                     eventDispatcher);
+        _labelWidget->setText(juce::String(_labelText), noNotification);
+
+        /* add real widgets to parent */
+        _parent->addChildComponent(_labelWidget);
+        _parent->addChildComponent(_controlWidget);
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+Boolean
+SoXAudioEditorWidget::canAdoptComponentsOf
+                          (IN SoXAudioEditorWidget& other) const
+{
+    return (!hasComponents() && other.hasComponents()
+            && _parent == other._parent && _shape == other._shape);
+}
+
+/*--------------------*/
+
+void SoXAudioEditorWidget::adoptComponentsOf
+                               (INOUT SoXAudioEditorWidget& other)
+{
+    Logging_trace2(">>: %1 <- %2", _parameterName, other._parameterName);
+
+    const SoXEffectParameterKind kind = _parameterMap.kind(_parameterName);
+    _labelWidget   = other._labelWidget;
+    _controlWidget = other._controlWidget;
+    other._labelWidget   = NULL;
+    other._controlWidget = NULL;
+
+    _labelWidget->setText(juce::String(_labelText), noNotification);
+    _adaptWidget(_controlWidget, _parameterMap, _parameterName, kind,
+                 (EventDispatcher*) other._eventDispatcher,
+                 (EventDispatcher*) _eventDispatcher);
+
+    Logging_trace("<<");
+}
+
 /*--------------------*/
 /* event processing   */
 /*--------------------*/
@@ -245,7 +397,10 @@ void SoXAudioEditorWidget::setValue (IN String value)
 {
     Logging_trace1(">>: %1", value);
 
-    if (_parameterMap.isAllowedValue(_parameterName, value)) {
+    /* a widget without components picks up the current value when
+       they are made */
+    if (hasComponents()
+        && _parameterMap.isAllowedValue(_parameterName, value)) {
         juce::Slider* slider =
             dynamic_cast<juce::Slider*>(_controlWidget);
         juce::ComboBox* comboBox =
@@ -271,7 +426,7 @@ void SoXAudioEditorWidget::resized ()
 {
     Logging_trace(">>");
 
-    if (_widgetIsActive) {
+    if (_widgetIsActive && hasComponents()) {
         /* only resize active widgets */
         const Natural parentWidth  =
             _controlWidget->getParentWidth();
@@ -340,11 +495,15 @@ SoXAudioEditorWidget::handlePageChange (IN Natural pageNumber)
 {
     Logging_trace1(">>: %1", TOSTRING(pageNumber));
     _currentPageNumber = pageNumber;
-    const Boolean isVisible = _widgetIsActive;
-    _controlWidget->setVisible(isVisible);
-    _labelWidget->setVisible(isVisible);
-    /* redraw widgets upon page change */
-    resized();
+
+    if (hasComponents()) {
+        const Boolean isVisible = _widgetIsActive;
+        _controlWidget->setVisible(isVisible);
+        _labelWidget->setVisible(isVisible);
+        /* redraw widgets upon page change */
+        resized();
+    }
+
     Logging_trace("<<");
 }
 
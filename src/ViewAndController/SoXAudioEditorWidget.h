@@ -39,6 +39,13 @@ namespace SoXPlugins::ViewAndController {
      * the widgets are layout out in a vertical manner as rows; note
      * that there is no subclassing for comboboxex or sliders: all
      * processing is done in a single class.
+     *
+     * The JUCE components of a widget are only created when its
+     * page is shown for the first time; when another page is shown,
+     * a widget may take over the components of an inactive widget
+     * of the same shape instead of creating new ones, hence the
+     * effort for opening an editor only depends on the visible page
+     * and not on the total number of pages.
     */
     struct SoXAudioEditorWidget {
 
@@ -50,7 +57,9 @@ namespace SoXPlugins::ViewAndController {
          * parameter defines whether it will be represented as a
          * combobox (for enums) or slider (for ints and real
          * values); <C>labelName</C> tells how the parameter will
-         * be labelled in the GUI
+         * be labelled in the GUI; the JUCE components are not
+         * created here, but by <C>makeComponents</C> or
+         * <C>adoptComponentsOf</C>
          *
          * @param[inout] parent       JUCE component enclosing this
          *                            widget
@@ -82,6 +91,64 @@ namespace SoXPlugins::ViewAndController {
          */
         String parameterName () const;
 
+        /*--------------------*/
+
+        /**
+         * Tells whether this widget is shown when page with
+         * <C>pageNumber</C> is active.
+         *
+         * @param[in] pageNumber  index of active page (starting at 1)
+         * @return  information whether widget is on that page
+         */
+        Boolean isOnPage (IN Natural pageNumber) const;
+
+        /*--------------------*/
+
+        /**
+         * Tells whether the JUCE components of this widget exist.
+         *
+         * @return  information whether components have been made or
+         *          adopted
+         */
+        Boolean hasComponents () const;
+
+        /*--------------------*/
+        /* component handling */
+        /*--------------------*/
+
+        /**
+         * Creates the JUCE components of this widget and adds them
+         * (invisible) to the parent; does nothing when they already
+         * exist.
+         */
+        void makeComponents ();
+
+        /*--------------------*/
+
+        /**
+         * Tells whether this widget without components can take over
+         * the components of <C>other</C>: this is the case when
+         * <C>other</C> has components and both widgets have the
+         * same shape (the same kind of parameter and for enums the
+         * same values).
+         *
+         * @param[in] other  widget possibly giving away its
+         *                   components
+         * @return  information whether components can be adopted
+         */
+        Boolean canAdoptComponentsOf (IN SoXAudioEditorWidget& other) const;
+
+        /*--------------------*/
+
+        /**
+         * Takes over the components of <C>other</C> and adapts them
+         * to the parameter of this widget; afterwards <C>other</C>
+         * has no components.
+         *
+         * @param[inout] other  widget giving away its components
+         */
+        void adoptComponentsOf (INOUT SoXAudioEditorWidget& other);
+
         /*--------------------*/
         /* event processing   */
         /*--------------------*/
@@ -194,6 +261,17 @@ namespace SoXPlugins::ViewAndController {
             /** name of parameter displayed by this widget */
             String _parameterName;
 
+            /** text of label shown for widget */
+            String _labelText;
+
+            /** the shape of the widget: the parameter kind and for
+             * enums the list of values; widgets with equal shape
+             * may exchange their components */
+            String _shape;
+
+            /** the JUCE component enclosing this widget */
+            juce::Component* _parent;
+
             /** page position within editor (where zero means:
              * show on all pages) */
             Natural _pageNumber;
@@ -202,10 +280,12 @@ namespace SoXPlugins::ViewAndController {
              * zero) */
             Natural _rowNumber;
 
-            /** label shown for widget */
+            /** label shown for widget (NULL before components are
+             * made) */
             juce::Label*     _labelWidget;
 
-            /** control widget: either combobox or slider */
+            /** control widget: either combobox or slider (NULL
+             * before components are made) */
             juce::Component* _controlWidget;
 
             /** object responsible for dispatching change events from
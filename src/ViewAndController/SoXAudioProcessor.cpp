@@ -12,17 +12,59 @@
 /* IMPORTS */
 /*=========*/
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include "DenormalGuard.h"
 #include "GenericSet.h"
+#include "Kernels.h"
 #include "Logging.h"
 #include "MyArray.h"
+#include "SoXAutomationTrace.h"
 #include "SoXAudioEditor.h"
+#include "SoXAudioHelper.h"
+#include "SoXKernelTuning.h"
+#include "SoXParameterEventQueue.h"
+#include "SoXParameterSlotExchange.h"
+#include "SoXPresetBank.h"
+#include "SoXQualityGovernor.h"
+#include "SoXRealtimeGuard.h"
+#include "SoXStartupProfiler.h"
+#include "SoXTelemetryPublisher.h"
+#include "SoXWorkerPool.h"
+#include "StateArena.h"
 
 /*--------------------*/
 
 using Audio::AudioSampleListVector;
-using BaseTypes::Containers::convertArray;
+using Audio::AudioSampleListView;
+using Audio::DenormalGuard;
+using Audio::Kernels;
+using BaseTypes::Containers::copyArray;
 using BaseTypes::GenericTypes::GenericSet;
+using BaseTypes::GenericTypes::StateArena;
+using SoXPlugins::Helpers::SoXAudioHelper;
+using SoXPlugins::Helpers::SoXAutomationTraceRecorder;
 using SoXPlugins::Helpers::SoXEffectParameterKind;
+using SoXPlugins::Helpers::SoXKernelTuning;
+using SoXPlugins::Helpers::SoXLevelMeter;
+using SoXPlugins::Helpers::SoXParameterEvent;
+using SoXPlugins::Helpers::SoXParameterEventQueue;
+using SoXPlugins::Helpers::SoXParameterSlotExchange;
+using SoXPlugins::Helpers::SoXPresetBank;
+using SoXPlugins::Helpers::SoXPresetParameter;
+using SoXPlugins::Helpers::SoXPresetParameterList;
+using SoXPlugins::Helpers::SoXProcessingProfiler;
+using SoXPlugins::Helpers::SoXQualityGovernor;
+using SoXPlugins::Helpers::SoXSidechainView;
+using SoXPlugins::Helpers::SoXStartupPhase;
+using SoXPlugins::Helpers::SoXStartupProfiler;
+using SoXPlugins::Helpers::SoXTelemetryPublisher;
+using SoXPlugins::Helpers::SoXWorkerPool;
+using SoXPlugins::Helpers::precisionProfileFromString;
+using SoXPlugins::Helpers::precisionProfileToString;
 using SoXPlugins::ViewAndController::SoXAudioEditor;
 
 /** abbreviation for StringUtil */
@@ -36,6 +78,44 @@ typedef GenericSet<SoXAudioEditor*> _SoXAudioEditorPtrSet;
 /** a mapping from string to natural */
 typedef GenericMap<String, Natural> StringToNaturalMap;
 
+/** the maximum number of channels on the main bus (enough for
+ * 7th order ambisonics) */
+static const Natural _maximumChannelCount = 64;
+
+/** the duration in seconds of the crossfade when switching the
+ * bypass */
+static const Real _bypassFadeDuration = 0.01;
+
+/** the maximum number of samples of a fixed effect block when
+ * re-blocking */
+static const Natural _maximumReblockLength = 1024;
+
+/** the name of the environment variable with the directory for
+ * automation traces; when set, every instance captures its
+ * parameter changes and blocks from <C>prepareToPlay</C> to
+ * <C>releaseResources</C> */
+static const char* _automationCaptureVariableName =
+    "SOXPLUGINS_AUTOMATION_CAPTURE";
+
+/** the name of the environment variable with the initial precision
+ * profile of all instances (like "fast") */
+static const char* _precisionProfileVariableName =
+    "SOXPLUGINS_PRECISION_PROFILE";
+
+/** the name of the environment variable switching on the locking
+ * of the state arena in physical memory (set to a nonempty value
+ * other than "0") */
+static const char* _memoryLockingVariableName =
+    "SOXPLUGINS_LOCK_MEMORY";
+
+/** the size of the buffer of an automation trace in bytes (about
+ * ten minutes of stereo blocks with dense automation) */
+static const Natural _automationCaptureByteCount = 16 * 1024 * 1024;
+
+/** the number of automation traces written by all processors (for
+ * unique file names) */
+static std::atomic<unsigned> _automationTraceCount{0};
+
 /*============================================================*/
 
 /**
@@ -57,27 +137,47 @@ static Real _stretchToRealInterval (IN Real unitIntervalValue,
     return lowValue + unitIntervalValue * (highValue - lowValue);
 }
 
-/*--------------------*/
+/**
+ * Returns the directory for automation traces from the environment
+ * or an empty string when capturing is off.
+ *
+ * @return  path of trace directory or empty string
+ */
+static String _automationCaptureDirectory ()
+{
+    const char* value = std::getenv(_automationCaptureVariableName);
+    return (value == nullptr ? String{} : String{value});
+}
 
 /**
- * Returns value from interval <C>lowValue</C> to <C>highValue</C>
- * defined by unit interval factor <C>unitIntervalValue</C>.
+ * Returns the initial precision profile from the environment (the
+ * SoX-exact profile when not set or unknown).
  *
- * @param[in] unitIntervalValue  value between 0 and 1
- * @param[in] lowValue           lower bound value of target interval
- * @param[in] highValue          higher bound value of target interval
- * @return  scaled value in target interval
+ * @return  initial precision profile
  */
-static Integer _stretchToIntegerInterval (IN Real unitIntervalValue,
-                                          IN Integer lowValue,
-                                          IN Integer highValue)
+static SoXPrecisionProfile _precisionProfileFromEnvironment ()
 {
-    Assertion_pre(unitIntervalValue.isInInterval(Real::zero, Real::one),
-                  STR::expand("value must be in unit interval- %1",
-                              TOSTRING(unitIntervalValue)));
-    const Real stretchedValue =
-        _stretchToRealInterval(unitIntervalValue, lowValue, highValue);
-    return (Integer) Real::round(stretchedValue);
+    const char* value = std::getenv(_precisionProfileVariableName);
+    SoXPrecisionProfile result = SoXPrecisionProfile::soxExact;
+
+    if (value != nullptr) {
+        precisionProfileFromString(String{value}, result);
+    }
+
+    return result;
+}
+
+/**
+ * Tells whether the environment switches on the locking of the
+ * state arenas in physical memory.
+ *
+ * @return  information whether state arenas are locked
+ */
+static Boolean _memoryLockingIsEnabled ()
+{
+    const char* value = std::getenv(_memoryLockingVariableName);
+    return (value != nullptr && value[0] != '\0'
+            && String{value} != "0");
 }
 
 /*============================================================*/
@@ -90,12 +190,26 @@ namespace SoXPlugins::ViewAndController {
     /** number of decimal places for reals in serialized form */
     static const Natural decimalPlaceCount = 5;
 
+    /** the magic number at the start of the binary state form
+     * ("SoXB" when read little-endian) */
+    static const int binaryStateMagicNumber = 0x42586F53;
+
+    /** the current version of the binary state form */
+    static const int binaryStateVersion = 1;
+
+    /*--------------------*/
+
+    struct _SoXAudioProcessorDescriptor;
+
     /*--------------------*/
 
     /** a listener for effect parameters */
     struct _EffectParameterListener
         : juce::AudioProcessorParameter::Listener {
 
+        /** the associated processor descriptor for this listener */
+        _SoXAudioProcessorDescriptor* descriptor;
+
         /** the associated processor for this listener */
         SoXAudioProcessor* processor;
 
@@ -112,77 +226,47 @@ namespace SoXPlugins::ViewAndController {
 
     /*--------------------*/
 
-    void
-    _EffectParameterListener::parameterValueChanged (int paramIndex,
-                                                     float newValue)
+    void _EffectParameterListener::parameterGestureChanged (int, bool)
     {
-        const Natural parameterIndex{paramIndex};
-        const Real unitIntervalValue{newValue};
-        Logging_trace2(">>: parameterIndex = %1, value = %2",
-                       TOSTRING(parameterIndex),
-                       TOSTRING(unitIntervalValue));
+    }
 
-        /* find associated parameter */
-        const juce::AudioProcessorParameter* parameter =
-            processor->getParameters()[(int) parameterIndex];
-        const String parameterName{parameter->getName(1000).toStdString()};
-        Logging_trace1("--: parameterName = %1", parameterName);
-        const SoXEffectParameterMap& parameterMap =
-            processor->effectParameterMap();
+    /*--------------------*/
+    /*--------------------*/
 
-        if (parameterMap.contains(parameterName)) {
-            String value;
-            const SoXEffectParameterKind kind =
-                parameterMap.kind(parameterName);
-            Logging_trace1("--: parameterKind = %1",
-                           effectParameterKindToString(kind));
+    /** the data of a juce parameter for converting its normalized
+     * value into the numeric effect parameter value without any
+     * string operation */
+    struct _HostParameterData {
 
-            if (kind == SoXEffectParameterKind::realKind) {
-                Real lowValue, highValue, delta;
-                parameterMap.valueRangeReal(parameterName,
-                                            lowValue, highValue, delta);
-                /* scale to range */
-                value =
-                    TOSTRING(_stretchToRealInterval(unitIntervalValue,
-                                                    lowValue, highValue));
-            } else if (kind == SoXEffectParameterKind::intKind) {
-                Integer lowValue, highValue, delta;
-                parameterMap.valueRangeInt(parameterName,
-                                           lowValue, highValue, delta);
-                /* scale to range */
-                value =
-                    TOSTRING(_stretchToIntegerInterval(unitIntervalValue,
-                                                       lowValue, highValue));
-            } else if (kind == SoXEffectParameterKind::enumKind) {
-                StringList enumValueList;
-                parameterMap.valueRangeEnum(parameterName, enumValueList);
-                Integer elementCount{(int) enumValueList.size()};
-                Natural valueIndex =
-                    Natural{_stretchToIntegerInterval(unitIntervalValue,
-                                                      0, elementCount - 1)};
-                value = enumValueList.at(valueIndex);
-            } else {
-                Logging_traceError1("cannot happen, kind = %1",
-                                    effectParameterKindToString(kind));
-            }
+        /** the identification of the parameter in the effect
+         * parameter map */
+        Natural parameterId;
 
-            if (value > "") {
-                /* lock the juce message manager for updating */
-                const juce::MessageManagerLock mutex;
-                processor->setValue(parameterName, value, false);
-            }
-        }
+        /** the kind of the parameter */
+        SoXEffectParameterKind kind;
 
-        Logging_trace("<<");
-    }
+        /** the numeric value for a normalized value of zero */
+        Real lowValue;
 
-    /*--------------------*/
+        /** the numeric value for a normalized value of one */
+        Real highValue;
 
-    void _EffectParameterListener::parameterGestureChanged (int, bool)
-    {
-    }
+        /** the minimum difference of numeric values considered a
+         * change */
+        Real delta;
+
+    };
 
     /*--------------------*/
+
+    /**
+     * The phases of a crossfade between two effect instances on a
+     * program change: no crossfade, crossfade running on the audio
+     * thread or crossfade complete with the target effect still to
+     * replace the running one on the message thread
+     */
+    enum class _MorphState { idle, fading, complete };
+
     /*--------------------*/
 
     /** the associated descriptor type for an audio processor */
@@ -200,8 +284,295 @@ namespace SoXPlugins::ViewAndController {
         /** a map from parameter name to index within parameter
          * list */
         StringToNaturalMap parameterNameToIndexMap;
+
+        /** the conversion data of the juce parameters indexed by
+         * parameter index */
+        GenericList<_HostParameterData> hostParameterDataList;
+
+        /** the numeric parameter values set by the host and still
+         * to be applied, indexed by parameter index */
+        SoXParameterSlotExchange<Real> hostValueExchange{};
+
+        /** the change kinds of host values applied to the effect
+         * and still to be reported on the message thread, indexed
+         * by parameter index */
+        SoXParameterSlotExchange<SoXParameterValueChangeKind>
+            hostChangeExchange{};
+
+        /** the sample buffer for conversion from and to the host
+         * format; preallocated in <C>prepareToPlay</C> and reused
+         * for every block */
+        AudioSampleListVector audioSampleBuffer{};
+
+        /** the number of channels preallocated in the sample
+         * buffer */
+        Natural allocatedChannelCount{0};
+
+        /** the number of samples per channel preallocated in the
+         * sample buffer (the maximum block size of the host) */
+        Natural allocatedSampleCount{0};
+
+        /** the number of sidechain channels following the main
+         * channels in the host buffer (cached in
+         * <C>prepareToPlay</C>) */
+        Natural sidechainChannelCount{0};
+
+        /** the number of main input channels of the host buffer
+         * (cached in <C>prepareToPlay</C>, because the bus layout
+         * only changes when not playing) */
+        Natural channelCount{0};
+
+        /** the number of output channels of the host buffer (cached
+         * in <C>prepareToPlay</C>) */
+        Natural outputChannelCount{0};
+
+        /** the sample rate of the host (cached in
+         * <C>prepareToPlay</C>) */
+        Real sampleRate{44100.0};
+
+        /** tells whether the processor is between
+         * <C>prepareToPlay</C> and <C>releaseResources</C>; then
+         * parameter changes are queued for the audio thread */
+        std::atomic<bool> isPlaying{false};
+
+        /** the parameter changes pending for the audio thread */
+        SoXParameterEventQueue eventQueue{};
+
+        /** the parameter changes applied by the audio thread and
+         * still to be reported on the message thread */
+        SoXParameterEventQueue appliedEventQueue{};
+
+        /** the event slot used by the audio thread for exchange with
+         * the queues */
+        SoXParameterEvent event{};
+
+        /** the number of samples since the input has become silent;
+         * when this exceeds the tail of the effect, the effect is
+         * not called any longer until the input is audible again */
+        Natural silentSampleCount{0};
+
+        /** tells whether the effect only processes the first of
+         * the identical main channels (the state of the first
+         * channel then stands for all channels) */
+        Boolean isMonoProcessing{false};
+
+        /** tells whether the effect states of all channels are
+         * known to be equal (apart from mono processing), such that
+         * identical channels may be processed as mono */
+        Boolean channelStatesAreEqual{true};
+
+        /** the profiler measuring the processing time per host
+         * block */
+        SoXProcessingProfiler profiler{};
+
+        /** the governor adapting the quality level of the effect to
+         * the processing load (off by default) */
+        SoXQualityGovernor qualityGovernor{};
+
+        /** the precision profile of the effect (also of a crossfade
+         * target) */
+        SoXPrecisionProfile precisionProfile{
+            _precisionProfileFromEnvironment()};
+
+        /** the publisher of the processing counters for external
+         * monitoring (only active when switched on by the
+         * environment) */
+        SoXTelemetryPublisher telemetryPublisher{};
+
+        /** the time stamp of the start of the processor construction
+         * in nanoseconds; reset to zero when the construction phase
+         * has been recorded */
+        std::uint64_t constructionStartTimeStamp{0};
+
+        /** tells whether <C>prepareToPlay</C> has already been
+         * called for this processor */
+        Boolean isPrepared{false};
+
+        /** tells whether the recalculation of the effect settings
+         * after a state restoration is still running or pending on
+         * the worker pool */
+        std::atomic<bool> stateRestorationIsPending{false};
+
+        /** the handle of the detached task recalculating the effect
+         * settings after a state restoration (the completed handle
+         * when no thread has to wait for it) */
+        std::atomic<size_t> stateRestorationTaskHandle{
+            (size_t) SoXWorkerPool::completedTaskHandle};
+
+        /** the serialized state returned by the last call of
+         * <C>getStateInformation</C> */
+        juce::MemoryBlock stateCache{};
+
+        /** the parameter map the state cache has been serialized
+         * from (NULL when the cache is invalid) */
+        const SoXEffectParameterMap* stateCacheParameterMap{NULL};
+
+        /** the change stamp of the parameter map when the state
+         * cache has been serialized */
+        size_t stateCacheChangeStamp{0};
+
+        /** the recorder of the automation trace (only active when
+         * capturing is switched on by the environment) */
+        SoXAutomationTraceRecorder automationRecorder{};
+
+        /** the parameter values at the start of the automation
+         * capture indexed by parameter identification */
+        StringList automationInitialValueList{};
+
+        /** the sample rate of the automation capture */
+        Real automationSampleRate{0.0};
+
+        /** the contiguous storage for the sample buffers and the
+         * effect state (re)built in <C>prepareToPlay</C> */
+        StateArena stateArena{};
+
+        /** the number of bytes the last preparation has requested
+         * from the state arena (zero before the first one) */
+        size_t stateArenaDemand{0};
+
+        /** the meter measuring the output levels for a display */
+        SoXLevelMeter levelMeter{};
+
+        /** the presets of the effect (also the host programs) */
+        SoXPresetBank presetBank{};
+
+        /** the index of the preset applied last */
+        Natural currentPresetIndex{0};
+
+        /** the duration of the crossfade on a program change in
+         * seconds (zero for a direct switch) */
+        Real morphDuration{0.05};
+
+        /** the phase of the crossfade; the audio thread only
+         * accesses the target effect and the crossfade data when
+         * this is not idle */
+        std::atomic<_MorphState> morphState{_MorphState::idle};
+
+        /** the target effect of the crossfade prepared on the
+         * message thread */
+        SoXAudioEffect* morphEffect{NULL};
+
+        /** the number of samples of the crossfade */
+        Natural morphLength{1};
+
+        /** the number of samples of the crossfade already done */
+        Natural morphPosition{0};
+
+        /** the sample buffer for the input and output of the target
+         * effect; preallocated in <C>prepareToPlay</C> */
+        AudioSampleListVector morphBuffer{};
+
+        /** the names of the parameters changed by the preset of the
+         * crossfade target (reported after the crossfade) */
+        StringList morphParameterNameList{};
+
+        /** the change kinds of the parameters changed by the preset
+         * of the crossfade target */
+        GenericList<SoXParameterValueChangeKind> morphChangeKindList{};
+
+        /** the program requested by a MIDI program change on the
+         * audio thread (negative for none) */
+        std::atomic<int> requestedProgram{-1};
+
+        /** the host parameter for the bypass (owned by the
+         * processor) */
+        juce::AudioParameterBool* bypassParameter{NULL};
+
+        /** the bypass state of the audio thread (the target of a
+         * running bypass crossfade) */
+        Boolean isBypassed{false};
+
+        /** the number of samples of a bypass crossfade */
+        Natural bypassFadeLength{1};
+
+        /** the number of samples of the bypass crossfade still to
+         * be done (zero for none) */
+        Natural bypassFadeRemainder{0};
+
+        /** the sample buffer for the dry input during a bypass
+         * crossfade and for the silence fed to the effect while
+         * bypassed; preallocated in <C>prepareToPlay</C> */
+        AudioSampleListVector bypassBuffer{};
+
+        /** the block length for re-blocking requested for the next
+         * <C>prepareToPlay</C> (zero for none) */
+        Natural requestedReblockLength{0};
+
+        /** tells whether a latency of one block is accepted for
+         * the re-blocking requested for the next
+         * <C>prepareToPlay</C> */
+        Boolean requestedReblockingHasLatency{false};
+
+        /** the number of samples of each effect block when
+         * re-blocking (zero when host blocks are passed
+         * unchanged) */
+        Natural reblockLength{0};
+
+        /** tells whether the re-blocking gathers complete blocks
+         * with a latency of one block instead of splitting the host
+         * blocks */
+        Boolean reblockingHasLatency{false};
+
+        /** the float host input (main and sidechain channels)
+         * gathered for the next effect block when re-blocking with
+         * latency; preallocated in <C>prepareToPlay</C> */
+        juce::AudioBuffer<float> reblockFloatBuffer{};
+
+        /** the double host input (main and sidechain channels)
+         * gathered for the next effect block when re-blocking with
+         * latency; preallocated in <C>prepareToPlay</C> */
+        juce::AudioBuffer<double> reblockDoubleBuffer{};
+
+        /** the output of the last effect block still to be passed
+         * to the host when re-blocking with latency; preallocated
+         * in <C>prepareToPlay</C> */
+        AudioSampleListVector reblockOutputBuffer{};
+
+        /** the number of samples already gathered for the next
+         * effect block */
+        Natural reblockFillCount{0};
     };
 
+    /*--------------------*/
+
+    void
+    _EffectParameterListener::parameterValueChanged (int paramIndex,
+                                                     float newValue)
+    {
+        /* hosts call this on any thread (often the audio thread
+           during automation), hence it neither locks nor does any
+           string operation: the normalized value is converted
+           arithmetically and handed over to the thread applying
+           it */
+        const Natural parameterIndex{paramIndex};
+        const Real unitIntervalValue{newValue};
+        Logging_trace2(">>: parameterIndex = %1, value = %2",
+                       TOSTRING(parameterIndex),
+                       TOSTRING(unitIntervalValue));
+
+        if (parameterIndex < descriptor->hostParameterDataList.size()) {
+            const _HostParameterData& data =
+                descriptor->hostParameterDataList[parameterIndex];
+            Real value = _stretchToRealInterval(unitIntervalValue,
+                                                data.lowValue,
+                                                data.highValue);
+
+            if (data.kind != SoXEffectParameterKind::realKind) {
+                value = Real::round(value);
+            }
+
+            descriptor->hostValueExchange.set(parameterIndex, value);
+
+            if (!descriptor->isPlaying) {
+                /* without audio thread the value is applied on the
+                   message thread */
+                processor->triggerAsyncUpdate();
+            }
+        }
+
+        Logging_trace("<<");
+    }
+
     /*--------------------*/
     /* internal routines  */
     /*--------------------*/
@@ -284,98 +655,83 @@ namespace SoXPlugins::ViewAndController {
     /*--------------------*/
 
     /**
-     * Replaces all newline in <C>st</C> by another character and returns
-     * result.
-     *
-     * @param[in] st  string to be normalized
-     * @return string with newlines removed
-     */
-    static String _normalize (IN String& st)
-    {
-        String result = st;
-        STR::replace(result, "\n", "§");
-        return result;
-    }
-
-    /*--------------------*/
-
-    /**
-     * Converts audio parameter in <C>map</C> to serialized string form;
-     * <C>title</C> is added for reference as the first line
+     * Returns the conversion data for the juce parameter object of
+     * <C>parameterName</C> with data taken from
+     * <C>effectParameterMap</C>.
      *
-     * @param[in] parameterMap  map of audio parameters in processor
-     * @param[in] title         title for audio processor parameter
-     *                          serialization
+     * @param[in] parameterName       name of audio parameter in map
+     * @param[in] effectParameterMap  map of all audio parameters to
+     *                                associated attributes
+     * @return  data for converting normalized values of parameter
      */
-    static String _convertMapToString (IN SoXEffectParameterMap& parameterMap,
-                                       IN String& title)
+    static _HostParameterData
+    _makeHostParameterData (IN String& parameterName,
+                            IN SoXEffectParameterMap& effectParameterMap)
     {
-        Logging_trace2(">>: map = %1, title = %2",
-                       parameterMap.toString(), title);
-
-        const StringList parameterNameList = parameterMap.parameterNameList();
-        String result = title + "\n";
-
-        for (Natural i = 0;  i < parameterNameList.size();  i++) {
-            const String parameterName = parameterNameList[i];
-            const SoXEffectParameterKind kind =
-                parameterMap.kind(parameterName);
-            String parameterValue = parameterMap.value(parameterName);
-
-            if (kind == SoXEffectParameterKind::enumKind) {
-                STR::prepend(parameterValue, quoteCharacter);
-                STR::append(parameterValue, quoteCharacter);
-            }
+        _HostParameterData result;
+        result.parameterId = effectParameterMap.parameterId(parameterName);
+        result.kind        = effectParameterMap.kind(parameterName);
 
-            /* write each entry as a line */
-            result += (parameterName + " = " + parameterValue + "\n");
+        if (result.kind == SoXEffectParameterKind::realKind) {
+            effectParameterMap.valueRangeReal(parameterName,
+                                              result.lowValue,
+                                              result.highValue,
+                                              result.delta);
+        } else if (result.kind == SoXEffectParameterKind::intKind) {
+            Integer lowValue, highValue, delta;
+            effectParameterMap.valueRangeInt(parameterName,
+                                             lowValue, highValue, delta);
+            result.lowValue  = Real{lowValue};
+            result.highValue = Real{highValue};
+            result.delta     = Real::one;
+        } else {
+            StringList enumValueList;
+            effectParameterMap.valueRangeEnum(parameterName,
+                                              enumValueList);
+            result.lowValue  = Real::zero;
+            result.highValue = Real{Natural{enumValueList.size()}} - Real::one;
+            result.delta     = Real::one;
         }
 
-        Logging_trace1("<<: %1", _normalize(result));
         return result;
     }
 
     /*--------------------*/
 
     /**
-     * Reads value settings from serialized form in <C>st</C> to
-     * <C>audioProcessor</C> and into <C>parameterMap</C>
+     * Reads value settings from serialized text form in <C>st</C>
+     * into <C>parameterNameList</C> and <C>valueList</C>; values not
+     * allowed for a parameter in <C>parameterMap</C> are replaced by
+     * its current value.
      *
-     * @param[in] audioProcessor  the audio processor to be set by external
-     *                            string
-     * @param[in] parameterMap    map from audio parameters to associated
-     *                            data
-     * @param[in] st              string with serialized processor
-     *                            information
+     * @param[in]  parameterMap       map from audio parameters to
+     *                                associated data
+     * @param[in]  st                 string with serialized processor
+     *                                information
+     * @param[out] parameterNameList  list of parameter names read
+     * @param[out] valueList          list of associated values
      */
     static void
-    _readKeyValueMapString (INOUT SoXAudioProcessor* audioProcessor,
-                            INOUT SoXEffectParameterMap& parameterMap,
-                            IN String& st)
+    _readKeyValueMapString (IN SoXEffectParameterMap& parameterMap,
+                            IN String& st,
+                            OUT StringList& parameterNameList,
+                            OUT StringList& valueList)
     {
         Logging_trace1(">>: st = %1", st);
 
         /* read the data as written by the string conversion */
         const StringList lineList = StringList::makeBySplit(st, "\n");
+        parameterNameList.clear();
+        valueList.clear();
 
-        /* throw away empty last line and title => first index is 1,
-           last index is lineCount - 1 */
-        const Natural firstIndex = 1;
-        const Natural lastIndex  = lineList.size() - 2;
-        Natural previousPageNumber = Natural::maximumValue();
-
-        for (Natural i = firstIndex; i <= lastIndex; i++) {
+        /* throw away title => first index is 1 */
+        for (Natural i = 1; i < lineList.size(); i++) {
             const String line = lineList[i];
             const StringList partList = StringList::makeBySplit(line, "=");
 
             if (partList.size() == 2) {
-                Natural pageNumber;
-                String labelName;
                 const String parameterName = STR::strip(partList[0]);
                 String value = STR::strip(partList[1]);
-                SoXEffectParameterMap::splitParameterName(parameterName,
-                                                         labelName,
-                                                         pageNumber);
 
                 if (value.length() >= 2
                     && STR::firstCharacter(value) == quoteCharacter
@@ -383,26 +739,187 @@ namespace SoXPlugins::ViewAndController {
                     value = value.substr(1, value.length() - 2);
                 }
 
-                /* the recalculation is forced when the value is
-                   outside a page or the last value of the sequence */
-                const Boolean isOnSamePage =
-                    (previousPageNumber == pageNumber);
-                const Boolean recalculationIsForced =
-                  (i == lastIndex || !isOnSamePage);
-
-                /* make sure that the value in parameter map does not
-                   match the new value */
-                if (!parameterMap.isAllowedValue(parameterName, value)) {
-                    value = parameterMap.value(parameterName);
+                if (parameterMap.contains(parameterName)) {
+                    if (!parameterMap.isAllowedValue(parameterName,
+                                                     value)) {
+                        value = parameterMap.value(parameterName);
+                    }
+
+                    parameterNameList.append(parameterName);
+                    valueList.append(value);
                 }
+            }
+        }
+
+        Logging_trace1("<<: count = %1", TOSTRING(parameterNameList.size()));
+    }
 
-                parameterMap.invalidateValue(parameterName);
-                audioProcessor->setValue(parameterName, value,
-                                         recalculationIsForced);
+    /*--------------------*/
+
+    /**
+     * Converts audio parameters in <C>parameterMap</C> to serialized
+     * binary form in <C>destData</C>: a header with magic number,
+     * format version, <C>title</C> and parameter count is followed by
+     * one entry per parameter with its identification, kind and
+     * value (a double for reals, an integer for integers and the
+     * value index for enumerations); all numbers are little-endian.
+     *
+     * @param[in]  parameterMap  map of audio parameters in processor
+     * @param[in]  title         title for audio processor parameter
+     *                           serialization
+     * @param[out] destData      JUCE memory block receiving the
+     *                           serialized form
+     */
+    static void
+    _convertMapToBinary (IN SoXEffectParameterMap& parameterMap,
+                         IN String& title,
+                         OUT juce::MemoryBlock& destData)
+    {
+        Logging_trace1(">>: title = %1", title);
+
+        const StringList parameterNameList = parameterMap.parameterNameList();
+        const Natural parameterCount = parameterNameList.size();
+        GenericList<Real> numericValueList;
+        GenericList<Boolean> valueIsKnownList;
+        destData.reset();
+
+        /* the values may be changed concurrently by the audio
+           thread, hence they are taken from a consistent snapshot */
+        parameterMap.readValueSnapshot(numericValueList, valueIsKnownList);
+        juce::MemoryOutputStream stream{destData, false};
+
+        stream.writeInt(binaryStateMagicNumber);
+        stream.writeInt(binaryStateVersion);
+        stream.writeString(juce::String(title));
+        stream.writeInt((int) parameterCount);
+
+        for (Natural i = 0;  i < parameterCount;  i++) {
+            const String& parameterName = parameterNameList[i];
+            const Natural parameterId =
+                parameterMap.parameterId(parameterName);
+            const SoXEffectParameterKind kind =
+                parameterMap.kind(parameterName);
+            const Real numericValue = numericValueList[parameterId];
+
+            stream.writeInt((int) parameterId);
+            stream.writeByte((char) kind);
+
+            if (kind == SoXEffectParameterKind::realKind) {
+                stream.writeDouble((double) numericValue);
+            } else {
+                stream.writeInt((int) Real::round(numericValue));
             }
         }
 
-        Logging_trace("<<");
+        stream.flush();
+        Logging_trace1("<<: size = %1", TOSTRING(Natural{destData.getSize()}));
+    }
+
+    /*--------------------*/
+
+    /**
+     * Reads value settings from serialized binary form in
+     * <C>data</C> with length <C>sizeInBytes</C> into
+     * <C>parameterNameList</C> and <C>valueList</C> and tells whether
+     * the data is in binary form at all; entries with unknown
+     * identification or mismatching kind are skipped, values not
+     * allowed for a parameter in <C>parameterMap</C> are replaced by
+     * its current value.
+     *
+     * @param[in]  parameterMap       map from audio parameters to
+     *                                associated data
+     * @param[in]  data               byte list with serialized form
+     * @param[in]  sizeInBytes        length of serialized data
+     * @param[out] parameterNameList  list of parameter names read
+     * @param[out] valueList          list of associated values
+     * @return  information whether data has the binary form
+     */
+    static Boolean
+    _readBinaryState (IN SoXEffectParameterMap& parameterMap,
+                      const void* data,
+                      IN Natural sizeInBytes,
+                      OUT StringList& parameterNameList,
+                      OUT StringList& valueList)
+    {
+        Logging_trace1(">>: size = %1", TOSTRING(sizeInBytes));
+
+        juce::MemoryInputStream stream{data, (size_t) sizeInBytes, false};
+        parameterNameList.clear();
+        valueList.clear();
+        const Boolean isBinary =
+            (sizeInBytes >= 8
+             && stream.readInt() == binaryStateMagicNumber);
+
+        if (!isBinary) {
+            Logging_trace("--: no binary form");
+        } else {
+            const int version = stream.readInt();
+
+            if (version > binaryStateVersion) {
+                Logging_traceError1("unknown state version - %1",
+                                    TOSTRING(Integer{version}));
+            } else {
+                const String title{stream.readString().toStdString()};
+                const Natural parameterCount =
+                    (Natural) Integer::maximum(0, stream.readInt());
+                Logging_trace2("--: title = %1, count = %2",
+                               title, TOSTRING(parameterCount));
+
+                for (Natural i = 0;
+                     i < parameterCount && !stream.isExhausted();  i++) {
+                    const Natural parameterId =
+                        (Natural) Integer::maximum(0, stream.readInt());
+                    const SoXEffectParameterKind storedKind =
+                        (SoXEffectParameterKind) stream.readByte();
+                    Real numericValue;
+
+                    if (storedKind == SoXEffectParameterKind::realKind) {
+                        numericValue = Real{stream.readDouble()};
+                    } else {
+                        numericValue = Real{(double) stream.readInt()};
+                    }
+
+                    const String parameterName =
+                        parameterMap.parameterName(parameterId);
+
+                    if (parameterName > ""
+                        && parameterMap.kind(parameterName) == storedKind) {
+                        String value;
+
+                        if (storedKind == SoXEffectParameterKind::realKind) {
+                            value = TOSTRING(numericValue);
+                        } else if (storedKind
+                                   == SoXEffectParameterKind::intKind) {
+                            value = TOSTRING(Integer{(int) numericValue});
+                        } else {
+                            StringList enumValueList;
+                            parameterMap.valueRangeEnum(parameterName,
+                                                        enumValueList);
+                            const Integer valueIndex{(int) numericValue};
+                            const Integer valueCount{
+                                (int) enumValueList.size()
+                            };
+                            const Boolean isInRange =
+                                (valueIndex >= 0 && valueIndex < valueCount);
+                            value = (isInRange
+                                     ? enumValueList[(Natural) valueIndex]
+                                     : "");
+                        }
+
+                        if (!parameterMap.isAllowedValue(parameterName,
+                                                         value)) {
+                            value = parameterMap.value(parameterName);
+                        }
+
+                        parameterNameList.append(parameterName);
+                        valueList.append(value);
+                    }
+                }
+            }
+        }
+
+        Logging_trace1("<<: %1", TOSTRING(isBinary));
+        return isBinary;
     }
 
     /*--------------------*/
@@ -431,333 +948,2502 @@ namespace SoXPlugins::ViewAndController {
     /*--------------------*/
 
     /**
-     * Update juce parameter object <C>parameter</C> named
-     * <C>parameterName</C> to <C>value</C> using data taken from
-     * <C>effectParameterMap</C>.
+     * Converts <C>count</C> float host samples in
+     * <C>sourceArray</C> to audio samples in <C>targetArray</C> by
+     * the format conversion kernel.
      *
-     * @param[inout] parameter           juce audio parameter object
-     * @param[in]    parameterName       name of audio parameter in map
-     * @param[in]    effectParameterMap  map of all audio parameters to
-     *                                   associated attributes
-     * @param[in]    value               new value for parameter
+     * @param[out] targetArray  array of audio samples
+     * @param[in]  sourceArray  array of host samples
+     * @param[in]  count        number of samples
      */
-    static void
-    _updateAudioProcessorParameter
-            (INOUT juce::AudioProcessorParameter* parameter,
-             IN String& parameterName,
-             IN SoXEffectParameterMap& effectParameterMap,
-             IN String& value)
+    static void _convertFromHost (OUT AudioSample* targetArray,
+                                  IN float* sourceArray,
+                                  IN Natural count)
     {
-        Logging_trace2(">>: parameterName = %1, value = %2",
-                       parameterName, value);
+        Kernels::current().floatToDouble((double*) targetArray,
+                                         sourceArray, (size_t) count);
+    }
 
-        const SoXEffectParameterKind kind =
-            effectParameterMap.kind(parameterName);
+    /*--------------------*/
 
-        if (kind == SoXEffectParameterKind::realKind) {
-            const float realValue = (float) STR::toReal(value);
-            juce::AudioParameterFloat& fParameter =
-                TOREFERENCE<juce::AudioParameterFloat>(parameter);
-            fParameter = realValue;
-        } else if (kind == SoXEffectParameterKind::intKind) {
-            const int intValue = (int) STR::toInteger(value);
-            juce::AudioParameterInt& iParameter =
-                TOREFERENCE<juce::AudioParameterInt>(parameter);
-            iParameter = intValue;
-        } else if (kind == SoXEffectParameterKind::enumKind) {
-            StringList enumValueList;
-            effectParameterMap.valueRangeEnum(parameterName, enumValueList);
-            int valueIndex =
-                (int) Integer::maximum(0,
-                                       enumValueList.position(value));
-            juce::AudioParameterChoice& cParameter =
-                TOREFERENCE<juce::AudioParameterChoice>(parameter);
-            cParameter = (int) valueIndex;
-        }
+    /**
+     * Copies <C>count</C> double host samples in <C>sourceArray</C>
+     * to audio samples in <C>targetArray</C> as a single block
+     * (audio samples have the layout of doubles).
+     *
+     * @param[out] targetArray  array of audio samples
+     * @param[in]  sourceArray  array of host samples
+     * @param[in]  count        number of samples
+     */
+    static void _convertFromHost (OUT AudioSample* targetArray,
+                                  IN double* sourceArray,
+                                  IN Natural count)
+    {
+        double* targetPtr = (double*) targetArray;
+        const double* sourcePtr = sourceArray;
+        copyArray(targetPtr, sourcePtr, count);
+    }
 
-        
-        Logging_trace("<<");
+    /*--------------------*/
+
+    /**
+     * Converts <C>count</C> audio samples in <C>sourceArray</C> to
+     * float host samples in <C>targetArray</C> by the format
+     * conversion kernel.
+     *
+     * @param[out] targetArray  array of host samples
+     * @param[in]  sourceArray  array of audio samples
+     * @param[in]  count        number of samples
+     */
+    static void _convertToHost (OUT float* targetArray,
+                                IN AudioSample* sourceArray,
+                                IN Natural count)
+    {
+        Kernels::current().doubleToFloat(targetArray,
+                                         (const double*) sourceArray,
+                                         (size_t) count);
     }
-    
-}
 
-/*============================================================*/
+    /*--------------------*/
 
-/*--------------------*/
-/* setup              */
-/*--------------------*/
+    /**
+     * Copies <C>count</C> audio samples in <C>sourceArray</C> to
+     * double host samples in <C>targetArray</C> as a single block
+     * (audio samples have the layout of doubles).
+     *
+     * @param[out] targetArray  array of host samples
+     * @param[in]  sourceArray  array of audio samples
+     * @param[in]  count        number of samples
+     */
+    static void _convertToHost (OUT double* targetArray,
+                                IN AudioSample* sourceArray,
+                                IN Natural count)
+    {
+        double* targetPtr = targetArray;
+        const double* sourcePtr = (const double*) sourceArray;
+        copyArray(targetPtr, sourcePtr, count);
+    }
 
-SoXAudioProcessor::SoXAudioProcessor ()
-     : juce::AudioProcessor(BusesProperties()
-              .withInput("Input", juce::AudioChannelSet::stereo(), true)
-              .withOutput("Output", juce::AudioChannelSet::stereo(), true))
-{
-    Logging_trace(">>");
-    _descriptor = new _SoXAudioProcessorDescriptor();
-    _SoXAudioProcessorDescriptor& descriptor =
-        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
-    descriptor.listener.processor = this;
-    Logging_trace("<<");
-}
+    /*--------------------*/
 
-/*--------------------*/
+    /**
+     * Processes the first <C>channelCount</C> channels of
+     * <C>buffer</C> by <C>effect</C> at <C>timePosition</C> via
+     * the sample buffer preallocated in <C>descriptor</C>; samples
+     * are converted to audio samples before and back after
+     * processing.
+     *
+     * @tparam       SampleType    type of host samples (float or
+     *                             double)
+     * @param[inout] descriptor    processor descriptor with the
+     *                             preallocated sample buffer
+     * @param[inout] buffer        juce buffer with input and output
+     *                             samples
+     * @param[in]    timePosition  time position of block start
+     * @param[in]    channelCount  number of channels to process
+     * @param[in]    sampleCount   number of samples per channel
+     */
+    template<typename SampleType>
+    static void
+    _processViaSampleBuffer (INOUT _SoXAudioProcessorDescriptor& descriptor,
+                             INOUT juce::AudioBuffer<SampleType>& buffer,
+                             IN Real timePosition,
+                             IN Natural channelCount,
+                             IN Natural sampleCount)
+    {
+        /* reuse the buffer preallocated in prepareToPlay: shrinking
+           or regrowing a list within its capacity does not
+           allocate */
+        #ifdef DEBUG
+            Assertion_check(channelCount <= descriptor.allocatedChannelCount
+                            && sampleCount <= descriptor.allocatedSampleCount,
+                            "audio thread must not allocate sample buffers");
+        #endif
+
+        AudioSampleListVector& audioSampleBuffer =
+            descriptor.audioSampleBuffer;
+        audioSampleBuffer.resizeChannels(channelCount, sampleCount);
+
+        for (Natural channel = 0;  channel < channelCount;  channel++) {
+            const SampleType* inputPtr =
+                buffer.getReadPointer((int) channel);
+            AudioSampleList& sampleList = audioSampleBuffer[channel];
+            _convertFromHost(sampleList.asArray(), inputPtr, sampleCount);
+        }
 
-SoXAudioProcessor::~SoXAudioProcessor ()
-{
-    Logging_trace(">>");
-    _SoXAudioProcessorDescriptor* descriptor =
-        (_SoXAudioProcessorDescriptor*) _descriptor;
-    delete descriptor;
-    Logging_trace("<<");
-    Logging_finalize();
-}
+        descriptor.effect->processBlock(timePosition, audioSampleBuffer);
 
-/*--------------------*/
+        for (Natural channel = 0;  channel < channelCount;  channel++) {
+            SampleType* outputPtr = buffer.getWritePointer((int) channel);
+            AudioSampleList& sampleList = audioSampleBuffer[channel];
+            _convertToHost(outputPtr, sampleList.asArray(), sampleCount);
+        }
+    }
 
-juce::AudioProcessorEditor* SoXAudioProcessor::createEditor ()
-{
+    /*--------------------*/
+
+    /**
+     * Hands the sidechain channels following the first
+     * <C>channelCount</C> channels of <C>buffer</C> to
+     * <C>effect</C> as a view without copying; the view is empty
+     * when the sidechain bus is disabled.
+     *
+     * @tparam       SampleType    type of host samples (float or
+     *                             double)
+     * @param[in]    descriptor    processor descriptor
+     * @param[inout] effect        effect getting the sidechain
+     * @param[in]    buffer        juce buffer with main and sidechain
+     *                             channels
+     * @param[in]    channelCount  number of main channels
+     * @param[in]    sampleCount   number of samples per channel
+     */
+    template<typename SampleType>
+    static void
+    _setSidechain (IN _SoXAudioProcessorDescriptor& descriptor,
+                   INOUT SoXAudioEffect* effect,
+                   IN juce::AudioBuffer<SampleType>& buffer,
+                   IN Natural channelCount,
+                   IN Natural sampleCount)
+    {
+        SoXSidechainView sidechain{};
+
+        if (descriptor.sidechainChannelCount > 0) {
+            sidechain.set(buffer.getArrayOfReadPointers()
+                          + (size_t) channelCount,
+                          descriptor.sidechainChannelCount, sampleCount);
+        }
+
+        effect->setSidechainInput(sidechain);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Processes the first <C>channelCount</C> channels of float
+     * buffer <C>buffer</C> by the effect in <C>descriptor</C> at
+     * <C>timePosition</C>, directly when the effect supports float
+     * samples and via the sample buffer otherwise.
+     *
+     * @param[inout] descriptor    processor descriptor
+     * @param[inout] buffer        juce buffer with input and output
+     *                             samples
+     * @param[in]    timePosition  time position of block start
+     * @param[in]    channelCount  number of channels to process
+     * @param[in]    sampleCount   number of samples per channel
+     */
+    static void
+    _processSubBlock (INOUT _SoXAudioProcessorDescriptor& descriptor,
+                      INOUT juce::AudioBuffer<float>& buffer,
+                      IN Real timePosition,
+                      IN Natural channelCount,
+                      IN Natural sampleCount)
+    {
+        SoXAudioEffect* effect = descriptor.effect;
+        _setSidechain(descriptor, effect, buffer, channelCount,
+                      sampleCount);
+
+        if (effect->hasFloatProcessing()) {
+            /* the effect works directly on the host channels without
+               any conversion */
+            effect->processFloatBlock(timePosition,
+                                      buffer.getArrayOfWritePointers(),
+                                      channelCount, sampleCount);
+        } else {
+            _processViaSampleBuffer(descriptor, buffer, timePosition,
+                                    channelCount, sampleCount);
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Processes the first <C>channelCount</C> channels of double
+     * buffer <C>buffer</C> by the effect in <C>descriptor</C> at
+     * <C>timePosition</C>, directly when the effect supports double
+     * samples and via the sample buffer otherwise.
+     *
+     * @param[inout] descriptor    processor descriptor
+     * @param[inout] buffer        juce buffer with input and output
+     *                             samples
+     * @param[in]    timePosition  time position of block start
+     * @param[in]    channelCount  number of channels to process
+     * @param[in]    sampleCount   number of samples per channel
+     */
+    static void
+    _processSubBlock (INOUT _SoXAudioProcessorDescriptor& descriptor,
+                      INOUT juce::AudioBuffer<double>& buffer,
+                      IN Real timePosition,
+                      IN Natural channelCount,
+                      IN Natural sampleCount)
+    {
+        SoXAudioEffect* effect = descriptor.effect;
+        _setSidechain(descriptor, effect, buffer, channelCount,
+                      sampleCount);
+
+        if (effect->hasDoubleProcessing()) {
+            /* the effect works directly on the host channels: double
+               samples have the layout of audio samples */
+            AudioSampleListView bufferView{
+                (AudioSample* const*) buffer.getArrayOfWritePointers(),
+                channelCount, sampleCount
+            };
+            effect->processBlock(timePosition, bufferView);
+        } else {
+            _processViaSampleBuffer(descriptor, buffer, timePosition,
+                                    channelCount, sampleCount);
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Tells whether the first <C>channelCount</C> channels of
+     * <C>buffer</C> are silent, i.e. no sample magnitude exceeds the
+     * silence threshold.
+     *
+     * @tparam    SampleType    type of host samples (float or double)
+     * @param[in] buffer        juce buffer with samples
+     * @param[in] channelCount  number of channels to check
+     * @return  information whether buffer is silent
+     */
+    template<typename SampleType>
+    static Boolean
+    _isSilent (IN juce::AudioBuffer<SampleType>& buffer,
+               IN Natural channelCount)
+    {
+        const int sampleCount = buffer.getNumSamples();
+        const SampleType threshold =
+            (SampleType) SoXAudioHelper::silenceThreshold;
+        Boolean result = true;
+
+        for (Natural channel = 0;  result && channel < channelCount;
+             channel++) {
+            result = (buffer.getMagnitude((int) channel, 0, sampleCount)
+                      <= threshold);
+        }
+
+        return result;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Tells whether the first <C>channelCount</C> channels of
+     * <C>buffer</C> are bitwise identical to the first channel; the
+     * comparison is done by <C>memcmp</C> which is vectorized by
+     * the C library.
+     *
+     * @tparam    SampleType    type of host samples (float or double)
+     * @param[in] buffer        juce buffer with samples
+     * @param[in] channelCount  number of channels to check
+     * @return  information whether all channels are identical
+     */
+    template<typename SampleType>
+    static Boolean
+    _channelsAreIdentical (IN juce::AudioBuffer<SampleType>& buffer,
+                           IN Natural channelCount)
+    {
+        const size_t byteCount =
+            (size_t) buffer.getNumSamples() * sizeof(SampleType);
+        const SampleType* firstPtr = buffer.getReadPointer(0);
+        Boolean result = true;
+
+        for (Natural channel = 1;  result && channel < channelCount;
+             channel++) {
+            const SampleType* samplePtr =
+                buffer.getReadPointer((int) channel);
+            result = (std::memcmp(samplePtr, firstPtr, byteCount) == 0);
+        }
+
+        return result;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Processes the first <C>channelCount</C> channels of
+     * <C>buffer</C> at <C>timePosition</C> by the effect in
+     * <C>descriptor</C>; when the channels are identical, the effect
+     * supports it and its channel states are equal, only the first
+     * channel is processed and copied to the others.  When the
+     * channels diverge again, the effect continues for all channels
+     * from the state of the first channel.
+     *
+     * @tparam       SampleType    type of host samples (float or
+     *                             double)
+     * @param[inout] descriptor    processor descriptor
+     * @param[inout] buffer        juce buffer with input and output
+     *                             samples
+     * @param[in]    timePosition  time position of block start
+     * @param[in]    channelCount  number of channels to process
+     */
+    template<typename SampleType>
+    static void
+    _processMonoOrAllChannels
+        (INOUT _SoXAudioProcessorDescriptor& descriptor,
+         INOUT juce::AudioBuffer<SampleType>& buffer,
+         IN Real timePosition,
+         IN Natural channelCount)
+    {
+        SoXAudioEffect* effect = descriptor.effect;
+        const Natural sampleCount = (Natural) buffer.getNumSamples();
+
+        /* a sidechain view would start at the second main channel
+           for a single processed channel */
+        const Boolean monoIsPossible =
+            (channelCount > 1
+             && descriptor.sidechainChannelCount == 0
+             && descriptor.channelStatesAreEqual
+             && effect->hasMonoProcessing());
+        const Boolean isMono =
+            (monoIsPossible && _channelsAreIdentical(buffer, channelCount));
+
+        if (descriptor.isMonoProcessing && !isMono) {
+            effect->copyFirstChannelState(channelCount);
+        }
+
+        /* identical channels keep equal states */
+        descriptor.isMonoProcessing      = isMono;
+        descriptor.channelStatesAreEqual = isMono;
+
+        if (!isMono) {
+            _processSubBlock(descriptor, buffer, timePosition,
+                             channelCount, sampleCount);
+        } else {
+            _processSubBlock(descriptor, buffer, timePosition,
+                             1, sampleCount);
+
+            for (Natural channel = 1;  channel < channelCount;
+                 channel++) {
+                buffer.copyFrom((int) channel, 0, buffer, 0, 0,
+                                (int) sampleCount);
+            }
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Processes the first <C>channelCount</C> channels of
+     * <C>buffer</C> at <C>timePosition</C> by the effect in
+     * <C>descriptor</C> unless the input is silent and has been so
+     * longer than the tail of the effect; then the effect state has
+     * decayed, the effect is not called and the output is cleared.
+     *
+     * @tparam       SampleType    type of host samples (float or
+     *                             double)
+     * @param[inout] descriptor    processor descriptor
+     * @param[inout] buffer        juce buffer with input and output
+     *                             samples
+     * @param[in]    timePosition  time position of block start
+     * @param[in]    sampleRate    sample rate of processor
+     * @param[in]    channelCount  number of channels to process
+     */
+    template<typename SampleType>
+    static void
+    _processOrSkipSubBlock (INOUT _SoXAudioProcessorDescriptor& descriptor,
+                            INOUT juce::AudioBuffer<SampleType>& buffer,
+                            IN Real timePosition,
+                            IN Real sampleRate,
+                            IN Natural channelCount)
+    {
+        const Natural sampleCount = (Natural) buffer.getNumSamples();
+        const Boolean inputIsSilent = _isSilent(buffer, channelCount);
+        const Real tailSampleCount =
+            descriptor.effect->tailLength() * sampleRate;
+        Natural& silentSampleCount = descriptor.silentSampleCount;
+
+        if (inputIsSilent && Real{silentSampleCount} >= tailSampleCount) {
+            for (Natural channel = 0;  channel < channelCount;  channel++) {
+                buffer.clear((int) channel, 0, (int) sampleCount);
+            }
+
+            /* the states of all channels have decayed */
+            descriptor.channelStatesAreEqual = true;
+        } else {
+            if (descriptor.automationRecorder.isActive()) {
+                descriptor.automationRecorder.recordBlock(sampleCount);
+            }
+
+            _processMonoOrAllChannels(descriptor, buffer, timePosition,
+                                      channelCount);
+        }
+
+        /* the count stops at the tail, such that it does not wrap
+           around in long silent passages */
+        if (!inputIsSilent) {
+            silentSampleCount = 0;
+        } else if (Real{silentSampleCount} < tailSampleCount) {
+            silentSampleCount += sampleCount;
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the target effect of the crossfade in
+     * <C>descriptor</C> when a crossfade is running or complete and
+     * NULL otherwise.
+     *
+     * @param[in] descriptor  processor descriptor
+     * @return  target effect of crossfade or NULL
+     */
+    static SoXAudioEffect*
+    _morphTargetEffect (IN _SoXAudioProcessorDescriptor& descriptor)
+    {
+        const _MorphState morphState =
+            descriptor.morphState.load(std::memory_order_acquire);
+        return (morphState == _MorphState::idle
+                ? NULL : descriptor.morphEffect);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the current time of <C>playHead</C> when the effect
+     * in <C>descriptor</C> or the target effect of a crossfade
+     * depends on it or when a parameter change scheduled for a time
+     * position is pending and zero otherwise; in the latter case the
+     * playhead is not queried at all, which saves its overhead for
+     * small host blocks.  A scheduled change hidden by a busy event
+     * queue is found in the next block; before that it is not due
+     * at time zero anyway.
+     *
+     * @param[inout] descriptor  processor descriptor
+     * @param[in]    playHead    the JUCE audio play head
+     * @return  current time (or zero when not needed)
+     */
+    static Real
+    _timePositionWhenNeeded (INOUT _SoXAudioProcessorDescriptor& descriptor,
+                             juce::AudioPlayHead* playHead)
+    {
+        const SoXAudioEffect* morphEffect = _morphTargetEffect(descriptor);
+        Real eventTimePosition = Real::infinity;
+        const Boolean eventIsFound =
+            descriptor.eventQueue.tryGetNextTimePosition(eventTimePosition);
+        const Boolean timePositionIsNeeded =
+            (descriptor.effect->needsTimePosition()
+             || (morphEffect != NULL && morphEffect->needsTimePosition())
+             || (eventIsFound && eventTimePosition != -Real::infinity));
+        return (timePositionIsNeeded ? _readTime(playHead) : Real{0.0});
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies all parameter values set by the host in
+     * <C>descriptor</C> since the last call to its effect in
+     * numeric form and hands their change kinds over for reporting
+     * on the message thread; tells whether some value has been
+     * applied.  Values differing from the current ones by less than
+     * the parameter precision are ignored, such that the update of
+     * a juce parameter after a change from the editor does not come
+     * back as another change; during a crossfade the values are
+     * also applied to its target effect.  Does no string operation
+     * and never waits, hence may run on the audio thread.
+     *
+     * @param[inout] descriptor  processor descriptor
+     * @return  information whether some value has been applied
+     */
+    static Boolean
+    _applyHostValues (INOUT _SoXAudioProcessorDescriptor& descriptor)
+    {
+        SoXParameterSlotExchange<Real>& hostValueExchange =
+            descriptor.hostValueExchange;
+        Boolean someValueIsApplied = false;
+
+        if (hostValueExchange.takeChangeIndication()) {
+            SoXAudioEffect* effect = descriptor.effect;
+            SoXAudioEffect* morphEffect = _morphTargetEffect(descriptor);
+            const SoXEffectParameterMap& parameterMap =
+                effect->effectParameterMap();
+            const Natural parameterCount = hostValueExchange.length();
+            Real value;
+
+            for (Natural parameterIndex = 0;
+                 parameterIndex < parameterCount;  parameterIndex++) {
+                if (hostValueExchange.tryTake(parameterIndex, value)) {
+                    const _HostParameterData& data =
+                        descriptor.hostParameterDataList[parameterIndex];
+                    const Real currentValue =
+                        parameterMap.numericValue(data.parameterId);
+
+                    if (Real::abs(value - currentValue) >= data.delta) {
+                        const SoXParameterValueChangeKind changeKind =
+                            effect->setNumericValue(data.parameterId,
+                                                    value, false);
+
+                        if (morphEffect != NULL) {
+                            morphEffect->setNumericValue(data.parameterId,
+                                                         value, false);
+                        }
+
+                        if (descriptor.automationRecorder.isActive()) {
+                            descriptor.automationRecorder
+                                .recordNumericValue(data.parameterId,
+                                                    value, false);
+                        }
+
+                        descriptor.hostChangeExchange.set(parameterIndex,
+                                                          changeKind);
+                        someValueIsApplied = true;
+                    }
+                }
+            }
+        }
+
+        return someValueIsApplied;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Applies all queued parameter changes of <C>descriptor</C>
+     * with a time position up to <C>timeLimit</C> to its effect and
+     * hands them over for reporting on the message thread (during
+     * a crossfade also to its target effect); tells whether some
+     * change has been applied.  Runs on the audio thread and never
+     * waits for the pending event queue.
+     *
+     * @param[inout] descriptor  processor descriptor
+     * @param[in]    timeLimit   latest time position of an event to
+     *                           be applied
+     * @return  information whether some event has been applied
+     */
+    static Boolean
+    _applyDueEvents (INOUT _SoXAudioProcessorDescriptor& descriptor,
+                     IN Real timeLimit)
+    {
+        SoXAudioEffect* effect = descriptor.effect;
+        SoXAudioEffect* morphEffect = _morphTargetEffect(descriptor);
+        const SoXEffectParameterMap& parameterMap =
+            effect->effectParameterMap();
+        SoXParameterEvent& event = descriptor.event;
+        Boolean someEventIsApplied = false;
+
+        while (descriptor.eventQueue.tryPop(timeLimit, event)) {
+            const String& parameterName = event.parameterName;
+
+            if (parameterMap.contains(parameterName)
+                && parameterMap.valueIsDifferent(parameterName,
+                                                 event.value)) {
+                event.changeKind =
+                    effect->setValue(parameterName, event.value,
+                                     event.recalculationIsForced);
+
+                if (morphEffect != NULL) {
+                    morphEffect->setValue(parameterName, event.value,
+                                          event.recalculationIsForced);
+                }
+
+                if (descriptor.automationRecorder.isActive()) {
+                    descriptor.automationRecorder
+                        .recordValue(parameterMap.parameterId(parameterName),
+                                     event.value,
+                                     event.recalculationIsForced);
+                }
+
+                descriptor.appliedEventQueue.push(event);
+                someEventIsApplied = true;
+            }
+        }
+
+        return someEventIsApplied;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Processes the first <C>channelCount</C> channels of
+     * <C>buffer</C> starting at <C>timePosition</C> by the effect
+     * in <C>descriptor</C>; the block is split at the positions of
+     * the queued parameter changes and each change is applied
+     * exactly at its sample position (events before the block start
+     * are applied at the start); tells whether some change has been
+     * applied.
+     *
+     * @tparam       SampleType    type of host samples (float or
+     *                             double)
+     * @param[inout] descriptor    processor descriptor
+     * @param[inout] buffer        juce buffer with input and output
+     *                             samples
+     * @param[in]    timePosition  time position of block start
+     * @param[in]    sampleRate    sample rate of processor
+     * @param[in]    channelCount  number of channels to process
+     * @return  information whether some event has been applied
+     */
+    template<typename SampleType>
+    static Boolean
+    _processWithEvents (INOUT _SoXAudioProcessorDescriptor& descriptor,
+                        INOUT juce::AudioBuffer<SampleType>& buffer,
+                        IN Real timePosition,
+                        IN Real sampleRate,
+                        IN Natural channelCount)
+    {
+        const Natural sampleCount = (Natural) buffer.getNumSamples();
+        const Real sampleDuration = Real::one / sampleRate;
+        SoXParameterEventQueue& eventQueue = descriptor.eventQueue;
+
+        /* host automation values are applied at block start; events
+           are due at a position when they are not later than half a
+           sample after it */
+        Boolean someEventIsApplied = _applyHostValues(descriptor);
+        someEventIsApplied =
+            (_applyDueEvents(descriptor,
+                             timePosition + sampleDuration / 2.0)
+             || someEventIsApplied);
+        Natural position = 0;
+
+        while (position < sampleCount) {
+            Natural endPosition = sampleCount;
+            Real eventTimePosition;
+
+            if (eventQueue.tryGetNextTimePosition(eventTimePosition)) {
+                const Real eventOffset =
+                    Real::ceiling((eventTimePosition - timePosition)
+                                  * sampleRate);
+
+                if (eventOffset > Real{position}
+                    && eventOffset < Real{sampleCount}) {
+                    endPosition = (Natural) eventOffset;
+                }
+            }
+
+            /* a buffer referencing the host channels does not
+               allocate for the usual channel counts; it also covers
+               the sidechain channels after the main channels */
+            const Natural bufferChannelCount =
+                channelCount + descriptor.sidechainChannelCount;
+            juce::AudioBuffer<SampleType>
+                subBuffer{buffer.getArrayOfWritePointers(),
+                          (int) bufferChannelCount, (int) position,
+                          (int) (endPosition - position)};
+            _processOrSkipSubBlock(descriptor, subBuffer,
+                                   (timePosition
+                                    + Real{position} * sampleDuration),
+                                   sampleRate, channelCount);
+            position = endPosition;
+
+            if (position < sampleCount) {
+                const Real timeLimit =
+                    timePosition
+                    + (Real{position} + 0.5) * sampleDuration;
+                someEventIsApplied =
+                    (_applyDueEvents(descriptor, timeLimit)
+                     || someEventIsApplied);
+            }
+        }
+
+        return someEventIsApplied;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Copies the first <C>channelCount</C> channels of <C>buffer</C>
+     * into the crossfade buffer of <C>descriptor</C> when a
+     * crossfade is running or complete and tells whether this is
+     * the case; must be called before the running effect
+     * overwrites the input in <C>buffer</C>.
+     *
+     * @tparam       SampleType    type of host samples (float or
+     *                             double)
+     * @param[inout] descriptor    processor descriptor
+     * @param[in]    buffer        juce buffer with input samples
+     * @param[in]    channelCount  number of channels to copy
+     * @return  information whether a crossfade is active
+     */
+    template<typename SampleType>
+    static Boolean
+    _captureMorphInput (INOUT _SoXAudioProcessorDescriptor& descriptor,
+                        IN juce::AudioBuffer<SampleType>& buffer,
+                        IN Natural channelCount)
+    {
+        const Boolean isMorphing = (_morphTargetEffect(descriptor) != NULL);
+
+        if (isMorphing) {
+            /* the buffer has been preallocated in prepareToPlay */
+            const Natural sampleCount = (Natural) buffer.getNumSamples();
+            AudioSampleListVector& morphBuffer = descriptor.morphBuffer;
+            morphBuffer.resizeChannels(channelCount, sampleCount);
+
+            for (Natural channel = 0;  channel < channelCount;
+                 channel++) {
+                const SampleType* inputPtr =
+                    buffer.getReadPointer((int) channel);
+                AudioSampleList& sampleList = morphBuffer[channel];
+                _convertFromHost(sampleList.asArray(), inputPtr,
+                                 sampleCount);
+            }
+        }
+
+        return isMorphing;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Processes the input captured by <C>_captureMorphInput</C> with
+     * the crossfade target in <C>descriptor</C> at
+     * <C>timePosition</C> and fades the output of the running
+     * effect in the first <C>channelCount</C> channels of
+     * <C>buffer</C> linearly to it; tells whether the crossfade has
+     * become complete with this block.  Both effects get the same
+     * input, hence an equal-gain fade keeps the level.
+     *
+     * @tparam       SampleType    type of host samples (float or
+     *                             double)
+     * @param[inout] descriptor    processor descriptor
+     * @param[inout] buffer        juce buffer with output of
+     *                             running effect and sidechain
+     * @param[in]    timePosition  time position of block start
+     * @param[in]    channelCount  number of channels to process
+     * @return  information whether the crossfade has just been
+     *          completed
+     */
+    template<typename SampleType>
+    static Boolean
+    _crossfadeToMorphTarget (INOUT _SoXAudioProcessorDescriptor& descriptor,
+                             INOUT juce::AudioBuffer<SampleType>& buffer,
+                             IN Real timePosition,
+                             IN Natural channelCount)
+    {
+        SoXAudioEffect* effect = descriptor.morphEffect;
+        AudioSampleListVector& morphBuffer = descriptor.morphBuffer;
+        const Natural sampleCount = (Natural) buffer.getNumSamples();
+        const size_t morphLength = (size_t) descriptor.morphLength;
+        const size_t morphPosition = (size_t) descriptor.morphPosition;
+        const double lengthFactor = 1.0 / (double) morphLength;
+
+        _setSidechain(descriptor, effect, buffer, channelCount,
+                      sampleCount);
+        effect->processBlock(timePosition, morphBuffer);
+
+        for (Natural channel = 0;  channel < channelCount;  channel++) {
+            SampleType* outputPtr = buffer.getWritePointer((int) channel);
+            const AudioSample* targetPtr = morphBuffer[channel].asArray();
+
+            for (size_t i = 0;  i < (size_t) sampleCount;  i++) {
+                const size_t position =
+                    std::min(morphPosition + i, morphLength);
+                const double factor = (double) position * lengthFactor;
+                const double value = (double) outputPtr[i];
+                outputPtr[i] =
+                    (SampleType) (value
+                                  + factor * ((double) targetPtr[i]
+                                              - value));
+            }
+        }
+
+        const Natural position =
+            Natural::minimum(descriptor.morphPosition + sampleCount,
+                             descriptor.morphLength);
+        const Boolean isCompleted =
+            (position == descriptor.morphLength
+             && descriptor.morphPosition < descriptor.morphLength);
+        descriptor.morphPosition = position;
+
+        if (isCompleted) {
+            descriptor.morphState.store(_MorphState::complete,
+                                        std::memory_order_release);
+        }
+
+        return isCompleted;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Records the last MIDI program change in <C>midiMessages</C>
+     * (if any) in <C>descriptor</C> for the message thread and
+     * tells whether there was one; reads the raw message bytes,
+     * hence does not allocate.
+     *
+     * @param[inout] descriptor    processor descriptor
+     * @param[in]    midiMessages  midi messages of current block
+     * @return  information whether a program change has been
+     *          recorded
+     */
+    static Boolean
+    _takeProgramChange (INOUT _SoXAudioProcessorDescriptor& descriptor,
+                        IN juce::MidiBuffer& midiMessages)
+    {
+        Boolean isRecorded = false;
+
+        for (const juce::MidiMessageMetadata metadata : midiMessages) {
+            const juce::uint8* data = metadata.data;
+
+            if (metadata.numBytes >= 2 && (data[0] & 0xF0) == 0xC0) {
+                descriptor.requestedProgram.store((int) data[1]);
+                isRecorded = true;
+            }
+        }
+
+        return isRecorded;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Lets the effect in <C>descriptor</C> decay while the processor
+     * is bypassed: the effect is fed silence until its tail has
+     * passed and is not called at all afterwards, hence it is in a
+     * decayed state when re-engaged; parameter changes up to the
+     * end of the block are applied.  The host channels are passed
+     * unchanged; tells whether some parameter change has been
+     * applied.
+     *
+     * @tparam       SampleType    type of host samples (float or
+     *                             double)
+     * @param[inout] descriptor    processor descriptor
+     * @param[in]    buffer        juce buffer with input and
+     *                             sidechain samples
+     * @param[in]    timePosition  time position of block start
+     * @param[in]    sampleRate    sample rate of processor
+     * @param[in]    channelCount  number of main channels
+     * @return  information whether some event has been applied
+     */
+    template<typename SampleType>
+    static Boolean
+    _decayWhileBypassed (INOUT _SoXAudioProcessorDescriptor& descriptor,
+                         IN juce::AudioBuffer<SampleType>& buffer,
+                         IN Real timePosition,
+                         IN Real sampleRate,
+                         IN Natural channelCount)
+    {
+        SoXAudioEffect* effect = descriptor.effect;
+        const Natural sampleCount = (Natural) buffer.getNumSamples();
+        const Real tailSampleCount = effect->tailLength() * sampleRate;
+        Natural& silentSampleCount = descriptor.silentSampleCount;
+        Boolean someEventIsApplied = _applyHostValues(descriptor);
+        someEventIsApplied =
+            (_applyDueEvents(descriptor,
+                             timePosition + Real{sampleCount} / sampleRate)
+             || someEventIsApplied);
+
+        if (descriptor.isMonoProcessing) {
+            /* the silence is fed to all channels */
+            effect->copyFirstChannelState(channelCount);
+            descriptor.isMonoProcessing = false;
+        }
+
+        if (Real{silentSampleCount} < tailSampleCount) {
+            AudioSampleListVector& bypassBuffer = descriptor.bypassBuffer;
+            bypassBuffer.resizeChannels(channelCount, sampleCount);
+            bypassBuffer.setToZero();
+            _setSidechain(descriptor, effect, buffer, channelCount,
+                          sampleCount);
+            effect->processBlock(timePosition, bypassBuffer);
+            silentSampleCount += sampleCount;
+        }
+
+        return someEventIsApplied;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Processes the first <C>channelCount</C> channels of
+     * <C>buffer</C> at <C>timePosition</C> according to the bypass
+     * parameter in <C>descriptor</C>: when bypassed, the input is
+     * passed and the effect only decays, otherwise the effect (and
+     * the target of a program crossfade) processes the block; a
+     * change of the bypass is crossfaded between the dry input and
+     * the processed signal.  Tells whether some parameter change
+     * or the end of a program crossfade must be handled on the
+     * message thread.
+     *
+     * @tparam       SampleType    type of host samples (float or
+     *                             double)
+     * @param[inout] descriptor    processor descriptor
+     * @param[inout] buffer        juce buffer with input and output
+     *                             samples
+     * @param[in]    timePosition  time position of block start
+     * @param[in]    sampleRate    sample rate of processor
+     * @param[in]    channelCount  number of channels to process
+     * @return  information whether an update is necessary
+     */
+    template<typename SampleType>
+    static Boolean
+    _processOrBypass (INOUT _SoXAudioProcessorDescriptor& descriptor,
+                      INOUT juce::AudioBuffer<SampleType>& buffer,
+                      IN Real timePosition,
+                      IN Real sampleRate,
+                      IN Natural channelCount)
+    {
+        const Natural sampleCount = (Natural) buffer.getNumSamples();
+        const Boolean bypassIsRequested = descriptor.bypassParameter->get();
+        Boolean updateIsNecessary = false;
+
+        if (bypassIsRequested != descriptor.isBypassed) {
+            /* a crossfade still running is reversed from its current
+               position */
+            descriptor.isBypassed = bypassIsRequested;
+            descriptor.bypassFadeRemainder =
+                descriptor.bypassFadeLength - descriptor.bypassFadeRemainder;
+        }
+
+        if (descriptor.isBypassed && descriptor.bypassFadeRemainder == 0) {
+            updateIsNecessary =
+                _decayWhileBypassed(descriptor, buffer, timePosition,
+                                    sampleRate, channelCount);
+
+            /* a program crossfade cannot be heard, hence it ends
+               here */
+            _MorphState fadingState = _MorphState::fading;
+            updateIsNecessary =
+                (descriptor.morphState
+                 .compare_exchange_strong(fadingState,
+                                          _MorphState::complete)
+                 || updateIsNecessary);
+        } else {
+            const Natural fadeRemainder = descriptor.bypassFadeRemainder;
+            AudioSampleListVector& dryBuffer = descriptor.bypassBuffer;
+
+            if (fadeRemainder > 0) {
+                dryBuffer.resizeChannels(channelCount, sampleCount);
+
+                for (Natural channel = 0;  channel < channelCount;
+                     channel++) {
+                    _convertFromHost(dryBuffer[channel].asArray(),
+                                     buffer.getReadPointer((int) channel),
+                                     sampleCount);
+                }
+            }
+
+            const Boolean isMorphing =
+                _captureMorphInput(descriptor, buffer, channelCount);
+            updateIsNecessary =
+                _processWithEvents(descriptor, buffer, timePosition,
+                                   sampleRate, channelCount);
+
+            if (isMorphing) {
+                updateIsNecessary =
+                    (_crossfadeToMorphTarget(descriptor, buffer,
+                                             timePosition, channelCount)
+                     || updateIsNecessary);
+            }
+
+            if (fadeRemainder > 0) {
+                /* the processed signal fades out towards the bypass
+                   and in when re-engaged */
+                const size_t fadeLength = (size_t) descriptor.bypassFadeLength;
+                const size_t fadePosition =
+                    fadeLength - (size_t) fadeRemainder;
+                const double lengthFactor = 1.0 / (double) fadeLength;
+                const Boolean isFadingOut = descriptor.isBypassed;
+
+                for (Natural channel = 0;  channel < channelCount;
+                     channel++) {
+                    SampleType* outputPtr =
+                        buffer.getWritePointer((int) channel);
+                    const AudioSample* dryPtr =
+                        dryBuffer[channel].asArray();
+
+                    for (size_t i = 0;  i < (size_t) sampleCount;  i++) {
+                        const size_t position =
+                            std::min(fadePosition + i, fadeLength);
+                        const double progress =
+                            (double) position * lengthFactor;
+                        const double factor =
+                            (isFadingOut ? 1.0 - progress : progress);
+                        const double dryValue = (double) dryPtr[i];
+                        outputPtr[i] =
+                            (SampleType) (dryValue
+                                          + factor * ((double) outputPtr[i]
+                                                      - dryValue));
+                    }
+                }
+
+                descriptor.bypassFadeRemainder =
+                    (fadeRemainder > sampleCount
+                     ? fadeRemainder - sampleCount : Natural{0});
+            }
+        }
+
+        return updateIsNecessary;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the preallocated buffer of <C>descriptor</C> for
+     * gathering float host input when re-blocking with latency.
+     *
+     * @param[inout] descriptor  processor descriptor
+     * @param[in]    buffer      juce buffer of host (only for
+     *                           selecting the sample type)
+     * @return  gathering buffer
+     */
+    static juce::AudioBuffer<float>&
+    _reblockBuffer (INOUT _SoXAudioProcessorDescriptor& descriptor,
+                    IN juce::AudioBuffer<float>&)
+    {
+        return descriptor.reblockFloatBuffer;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the preallocated buffer of <C>descriptor</C> for
+     * gathering double host input when re-blocking with latency.
+     *
+     * @param[inout] descriptor  processor descriptor
+     * @param[in]    buffer      juce buffer of host (only for
+     *                           selecting the sample type)
+     * @return  gathering buffer
+     */
+    static juce::AudioBuffer<double>&
+    _reblockBuffer (INOUT _SoXAudioProcessorDescriptor& descriptor,
+                    IN juce::AudioBuffer<double>&)
+    {
+        return descriptor.reblockDoubleBuffer;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Processes the first <C>channelCount</C> channels of
+     * <C>buffer</C> at <C>timePosition</C> in effect blocks of the
+     * fixed re-blocking length in <C>descriptor</C> with a latency
+     * of one block: the host input is gathered until a block is
+     * complete, while the host output is taken from the output of
+     * the previous block; hence the effect always gets the same
+     * sample count regardless of the host block sizes.  Tells
+     * whether an update on the message thread is necessary.
+     *
+     * @tparam       SampleType    type of host samples (float or
+     *                             double)
+     * @param[inout] descriptor    processor descriptor
+     * @param[inout] buffer        juce buffer with input and output
+     *                             samples
+     * @param[in]    timePosition  time position of block start
+     * @param[in]    sampleRate    sample rate of processor
+     * @param[in]    channelCount  number of channels to process
+     * @return  information whether an update is necessary
+     */
+    template<typename SampleType>
+    static Boolean
+    _processWithBlockLatency (INOUT _SoXAudioProcessorDescriptor& descriptor,
+                              INOUT juce::AudioBuffer<SampleType>& buffer,
+                              IN Real timePosition,
+                              IN Real sampleRate,
+                              IN Natural channelCount)
+    {
+        const Natural blockLength = descriptor.reblockLength;
+        const Natural sampleCount = (Natural) buffer.getNumSamples();
+        const Natural bufferChannelCount =
+            channelCount + descriptor.sidechainChannelCount;
+        const Real sampleDuration = Real::one / sampleRate;
+        juce::AudioBuffer<SampleType>& gatherBuffer =
+            _reblockBuffer(descriptor, buffer);
+        AudioSampleListVector& outputBuffer =
+            descriptor.reblockOutputBuffer;
+        Natural& fillCount = descriptor.reblockFillCount;
+        Boolean updateIsNecessary = false;
+        Natural position = 0;
+
+        while (position < sampleCount) {
+            const Natural count =
+                Natural::minimum(blockLength - fillCount,
+                                 sampleCount - position);
+
+            /* the input is taken before the host channels are
+               overwritten by the delayed output */
+            for (Natural channel = 0;  channel < bufferChannelCount;
+                 channel++) {
+                gatherBuffer.copyFrom((int) channel, (int) fillCount,
+                                      buffer, (int) channel,
+                                      (int) position, (int) count);
+            }
+
+            for (Natural channel = 0;  channel < channelCount;
+                 channel++) {
+                _convertToHost(buffer.getWritePointer((int) channel,
+                                                      (int) position),
+                               (outputBuffer[channel].asArray()
+                                + (size_t) fillCount),
+                               count);
+            }
+
+            fillCount += count;
+            position  += count;
+
+            if (fillCount == blockLength) {
+                /* the gathered block has started one block length
+                   before the current position */
+                const Real blockTimePosition =
+                    timePosition
+                    + (Real{position} - Real{blockLength})
+                      * sampleDuration;
+                juce::AudioBuffer<SampleType>
+                    blockBuffer{gatherBuffer.getArrayOfWritePointers(),
+                                (int) bufferChannelCount,
+                                (int) blockLength};
+                updateIsNecessary =
+                    (_processOrBypass(descriptor, blockBuffer,
+                                      blockTimePosition, sampleRate,
+                                      channelCount)
+                     || updateIsNecessary);
+
+                for (Natural channel = 0;  channel < channelCount;
+                     channel++) {
+                    _convertFromHost(outputBuffer[channel].asArray(),
+                                     blockBuffer.getReadPointer((int) channel),
+                                     blockLength);
+                }
+
+                fillCount = 0;
+            }
+        }
+
+        return updateIsNecessary;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Processes the first <C>channelCount</C> channels of
+     * <C>buffer</C> at <C>timePosition</C> according to the
+     * re-blocking settings in <C>descriptor</C>: without
+     * re-blocking the host block is processed as a whole, for
+     * re-blocking without latency it is split into blocks of the
+     * fixed length and a shorter remainder and for re-blocking with
+     * latency the effect only gets complete blocks delayed by one
+     * block.  Tells whether an update on the message thread is
+     * necessary.
+     *
+     * @tparam       SampleType    type of host samples (float or
+     *                             double)
+     * @param[inout] descriptor    processor descriptor
+     * @param[inout] buffer        juce buffer with input and output
+     *                             samples
+     * @param[in]    timePosition  time position of block start
+     * @param[in]    sampleRate    sample rate of processor
+     * @param[in]    channelCount  number of channels to process
+     * @return  information whether an update is necessary
+     */
+    template<typename SampleType>
+    static Boolean
+    _processReblocked (INOUT _SoXAudioProcessorDescriptor& descriptor,
+                       INOUT juce::AudioBuffer<SampleType>& buffer,
+                       IN Real timePosition,
+                       IN Real sampleRate,
+                       IN Natural channelCount)
+    {
+        const Natural blockLength = descriptor.reblockLength;
+        Boolean updateIsNecessary = false;
+
+        if (blockLength == 0) {
+            updateIsNecessary =
+                _processOrBypass(descriptor, buffer, timePosition,
+                                 sampleRate, channelCount);
+        } else if (descriptor.reblockingHasLatency) {
+            updateIsNecessary =
+                _processWithBlockLatency(descriptor, buffer,
+                                         timePosition, sampleRate,
+                                         channelCount);
+        } else {
+            const Natural sampleCount = (Natural) buffer.getNumSamples();
+            const Natural bufferChannelCount =
+                channelCount + descriptor.sidechainChannelCount;
+            const Real sampleDuration = Real::one / sampleRate;
+
+            for (Natural position = 0;  position < sampleCount;
+                 position += blockLength) {
+                const Natural count =
+                    Natural::minimum(blockLength, sampleCount - position);
+                juce::AudioBuffer<SampleType>
+                    subBuffer{buffer.getArrayOfWritePointers(),
+                              (int) bufferChannelCount, (int) position,
+                              (int) count};
+                updateIsNecessary =
+                    (_processOrBypass(descriptor, subBuffer,
+                                      (timePosition
+                                       + Real{position} * sampleDuration),
+                                      sampleRate, channelCount)
+                     || updateIsNecessary);
+            }
+        }
+
+        return updateIsNecessary;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Measures the output levels in the first <C>channelCount</C>
+     * channels of <C>buffer</C> and the gain reductions of the
+     * effect in <C>descriptor</C> by its level meter; runs on the
+     * audio thread and neither allocates nor waits.
+     *
+     * @tparam       SampleType    type of host samples (float or
+     *                             double)
+     * @param[inout] descriptor    processor descriptor
+     * @param[in]    buffer        juce buffer with output samples
+     * @param[in]    channelCount  number of channels to measure
+     */
+    template<typename SampleType>
+    static void
+    _measureLevels (INOUT _SoXAudioProcessorDescriptor& descriptor,
+                    IN juce::AudioBuffer<SampleType>& buffer,
+                    IN Natural channelCount)
+    {
+        SoXAudioEffect* effect = descriptor.effect;
+        SoXLevelMeter& levelMeter = descriptor.levelMeter;
+        const Natural gainReductionCount = effect->gainReductionCount();
+
+        for (Natural i = 0;  i < gainReductionCount;  i++) {
+            levelMeter.recordGainReduction(i, effect->takeGainReduction(i));
+        }
+
+        levelMeter.measureBlock(buffer.getArrayOfReadPointers(),
+                                channelCount,
+                                (Natural) buffer.getNumSamples());
+    }
+
+    /*--------------------*/
+
+    /**
+     * Sets the quality level of the effects in <C>descriptor</C>
+     * (the running one and a crossfade target) to the level of its
+     * governor; runs on the audio thread between blocks.
+     *
+     * @param[inout] descriptor  processor descriptor
+     */
+    static void
+    _applyQualityLevel (INOUT _SoXAudioProcessorDescriptor& descriptor)
+    {
+        const Natural level = descriptor.qualityGovernor.level();
+        descriptor.effect->setQualityLevel(level);
+
+        if (descriptor.morphState.load(std::memory_order_acquire)
+            != _MorphState::idle) {
+            descriptor.morphEffect->setQualityLevel(level);
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Recalculates the effect settings of the processor with
+     * descriptor <C>context</C> at the end of a state restoration;
+     * runs as a detached task of the worker pool.
+     *
+     * @param[inout] context  processor descriptor
+     */
+    static void _restoreEffectSettings (INOUT void* context,
+                                        IN Natural)
+    {
+        _SoXAudioProcessorDescriptor& descriptor =
+            TOREFERENCE<_SoXAudioProcessorDescriptor>(context);
+        SoXAudioEffect* effect = descriptor.effect;
+        Logging_span("SoXAudioProcessor.restoreState", effect);
+        effect->commitParameterBatch();
+        effect->setParameterValidity(true);
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns when the recalculation of the effect settings of a
+     * state restoration in <C>descriptor</C> is done; a task not yet
+     * taken by a worker is processed on the calling thread.  May be
+     * called from several threads at a time: exactly one of them
+     * completes the task, the others wait for it.
+     *
+     * @param[inout] descriptor  processor descriptor
+     */
+    static void
+    _completeStateRestoration (INOUT _SoXAudioProcessorDescriptor&
+                                   descriptor)
+    {
+        const size_t completedTaskHandle =
+            (size_t) SoXWorkerPool::completedTaskHandle;
+
+        while (descriptor.stateRestorationIsPending
+                   .load(std::memory_order_acquire)) {
+            const size_t taskHandle =
+                descriptor.stateRestorationTaskHandle
+                    .exchange(completedTaskHandle,
+                              std::memory_order_acq_rel);
+
+            if (taskHandle == completedTaskHandle) {
+                /* another thread completes the task or it is just
+                   being started */
+                std::this_thread::yield();
+            } else {
+                SoXWorkerPool::instance()
+                    .completeDetachedTask(Natural{taskHandle});
+                descriptor.stateRestorationIsPending
+                    .store(false, std::memory_order_release);
+            }
+        }
+    }
+
+    /*--------------------*/
+
+    /**
+     * Returns the bus properties of a processor with a stereo main
+     * input and output and an optional disabled stereo sidechain
+     * input depending on <C>hasSidechain</C>.
+     *
+     * @param[in] hasSidechain  information whether processor has a
+     *                          sidechain input
+     * @return  juce bus properties
+     */
+    static juce::AudioProcessor::BusesProperties
+    _busesProperties (IN Boolean hasSidechain)
+    {
+        juce::AudioProcessor::BusesProperties result =
+            juce::AudioProcessor::BusesProperties()
+                .withInput("Input", juce::AudioChannelSet::stereo(), true)
+                .withOutput("Output", juce::AudioChannelSet::stereo(),
+                            true);
+
+        if (hasSidechain) {
+            result = result.withInput("Sidechain",
+                                      juce::AudioChannelSet::stereo(),
+                                      false);
+        }
+
+        return result;
+    }
+
+    /*--------------------*/
+
+    /**
+     * Update juce parameter object <C>parameter</C> named
+     * <C>parameterName</C> to <C>value</C> using data taken from
+     * <C>effectParameterMap</C>.
+     *
+     * @param[inout] parameter           juce audio parameter object
+     * @param[in]    parameterName       name of audio parameter in map
+     * @param[in]    effectParameterMap  map of all audio parameters to
+     *                                   associated attributes
+     * @param[in]    value               new value for parameter
+     */
+    static void
+    _updateAudioProcessorParameter
+            (INOUT juce::AudioProcessorParameter* parameter,
+             IN String& parameterName,
+             IN SoXEffectParameterMap& effectParameterMap,
+             IN String& value)
+    {
+        Logging_trace2(">>: parameterName = %1, value = %2",
+                       parameterName, value);
+
+        const SoXEffectParameterKind kind =
+            effectParameterMap.kind(parameterName);
+
+        if (kind == SoXEffectParameterKind::realKind) {
+            const float realValue = (float) STR::toReal(value);
+            juce::AudioParameterFloat& fParameter =
+                TOREFERENCE<juce::AudioParameterFloat>(parameter);
+            fParameter = realValue;
+        } else if (kind == SoXEffectParameterKind::intKind) {
+            const int intValue = (int) STR::toInteger(value);
+            juce::AudioParameterInt& iParameter =
+                TOREFERENCE<juce::AudioParameterInt>(parameter);
+            iParameter = intValue;
+        } else if (kind == SoXEffectParameterKind::enumKind) {
+            StringList enumValueList;
+            effectParameterMap.valueRangeEnum(parameterName, enumValueList);
+            int valueIndex =
+                (int) Integer::maximum(0,
+                                       enumValueList.position(value));
+            juce::AudioParameterChoice& cParameter =
+                TOREFERENCE<juce::AudioParameterChoice>(parameter);
+            cParameter = (int) valueIndex;
+        }
+
+        
+        Logging_trace("<<");
+    }
+    
+}
+
+/*============================================================*/
+
+/*--------------------*/
+/* setup              */
+/*--------------------*/
+
+SoXAudioProcessor::SoXAudioProcessor ()
+     : SoXAudioProcessor(false)
+{
+}
+
+/*--------------------*/
+
+SoXAudioProcessor::SoXAudioProcessor (IN Boolean hasSidechain)
+     : juce::AudioProcessor(_busesProperties(hasSidechain))
+{
+    Logging_trace(">>");
+    const std::uint64_t startTimeStamp = SoXStartupProfiler::startPhase();
+    _descriptor = new _SoXAudioProcessorDescriptor();
+    _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    descriptor.constructionStartTimeStamp = startTimeStamp;
+    descriptor.listener.descriptor = &descriptor;
+    descriptor.listener.processor  = this;
+
+    /* select the SIMD kernels and processing settings tuned for
+       this machine when the plugin is loaded (on the first load
+       they are measured now) */
+    SoXKernelTuning::initialize();
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+SoXAudioProcessor::~SoXAudioProcessor ()
+{
+    Logging_trace(">>");
+    cancelPendingUpdate();
+    _SoXAudioProcessorDescriptor* descriptor =
+        (_SoXAudioProcessorDescriptor*) _descriptor;
+    _completeStateRestoration(*descriptor);
+    delete descriptor->morphEffect;
+    delete descriptor;
+    Logging_trace("<<");
+    Logging_finalize();
+}
+
+/*--------------------*/
+
+juce::AudioProcessorEditor* SoXAudioProcessor::createEditor ()
+{
+    Logging_trace(">>");
+    juce::AudioProcessorEditor* result;
+
+    {
+        SoXStartupProfiler::Span span{SoXStartupPhase::editorCreation};
+        result = new SoXAudioEditor(*this);
+    }
+
+    Logging_trace("<<");
+    return result;
+}
+
+/*--------------------*/
+/* property queries   */
+/*--------------------*/
+
+bool SoXAudioProcessor::supportsDoublePrecisionProcessing () const
+{
+    return true;
+}
+
+/*--------------------*/
+
+bool
+SoXAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts)
+    const
+{
+    /* any channel layout is fine as long as input and output
+       match, because the effects process each channel with
+       separate state */
+    const juce::AudioChannelSet& inputChannelSet =
+        layouts.getMainInputChannelSet();
+    const juce::AudioChannelSet& outputChannelSet =
+        layouts.getMainOutputChannelSet();
+    const Natural channelCount{(size_t) outputChannelSet.size()};
+    Boolean result = (!outputChannelSet.isDisabled()
+                      && inputChannelSet == outputChannelSet
+                      && channelCount <= _maximumChannelCount);
+
+    /* a sidechain only feeds the detector of the effect, hence its
+       layout is independent of the main buses */
+    for (int busIndex = 1;  busIndex < layouts.inputBuses.size();
+         busIndex++) {
+        const Natural sidechainChannelCount{
+            (size_t) layouts.getChannelSet(true, busIndex).size()
+        };
+        result = result && sidechainChannelCount <= _maximumChannelCount;
+    }
+
+    return result;
+}
+
+/*--------------------*/
+
+bool SoXAudioProcessor::acceptsMidi () const
+{
+    /* program changes select presets */
+    return true;
+}
+
+/*--------------------*/
+
+bool SoXAudioProcessor::producesMidi () const
+{
+    return false;
+}
+
+/*--------------------*/
+
+bool SoXAudioProcessor::isMidiEffect () const
+{
+    return false;
+}
+
+/*--------------------*/
+
+double SoXAudioProcessor::getTailLengthSeconds () const
+{
+    _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    _completeStateRestoration(descriptor);
+    return (double) descriptor.effect->tailLength();
+}
+
+/*--------------------*/
+
+juce::AudioProcessorParameter*
+SoXAudioProcessor::getBypassParameter () const
+{
+    _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    return descriptor.bypassParameter;
+}
+
+/*--------------------*/
+
+int SoXAudioProcessor::getNumPrograms ()
+{
+    /* hosts expect at least one program */
+    _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    const Natural presetCount = descriptor.presetBank.presetCount();
+    return (int) Natural::maximum(1, presetCount);
+}
+
+/*--------------------*/
+
+int SoXAudioProcessor::getCurrentProgram ()
+{
+    _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    return (int) descriptor.currentPresetIndex;
+}
+
+/*--------------------*/
+
+void SoXAudioProcessor::setCurrentProgram (int index)
+{
+    Logging_trace1(">>: %1", TOSTRING(Integer{index}));
+
+    _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    const Natural presetCount = descriptor.presetBank.presetCount();
+
+    if (index >= 0 && (Natural) index < presetCount) {
+        _applyPreset((Natural) index);
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+const juce::String SoXAudioProcessor::getProgramName (int index)
+{
+    _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    const SoXPresetBank& presetBank = descriptor.presetBank;
+    const Boolean isKnown =
+        (index >= 0 && (Natural) index < presetBank.presetCount());
+    return (isKnown
+            ? juce::String(presetBank.presetName((Natural) index))
+            : juce::String("default"));
+}
+
+/*--------------------*/
+
+void SoXAudioProcessor::changeProgramName (int, const juce::String&)
+{
+    /* does not apply */
+}
+
+/*--------------------*/
+
+bool SoXAudioProcessor::hasEditor () const
+{
+    return true;
+}
+
+/*--------------------*/
+
+const juce::String SoXAudioProcessor::getName () const
+{
+    return juce::String(name());
+}
+
+/*--------------------*/
+
+String SoXAudioProcessor::name () const
+{
+    return String("???");
+}
+
+/*--------------------*/
+/* persistence        */
+/*--------------------*/
+
+void SoXAudioProcessor::getStateInformation (OUT juce::MemoryBlock& destData)
+{
+    Logging_trace(">>");
+
+    _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    _completeStateRestoration(descriptor);
+
+    /* the state is only serialized again when the parameter map has
+       changed since the last call; the stamp is taken before the
+       serialization, hence a concurrent change is caught on the
+       next call */
+    const SoXEffectParameterMap& parameterMap = effectParameterMap();
+    const size_t changeStamp = parameterMap.changeStamp();
+
+    if (descriptor.stateCacheParameterMap != &parameterMap
+        || descriptor.stateCacheChangeStamp != changeStamp) {
+        const String title = getName().toStdString();
+        _convertMapToBinary(parameterMap, title, descriptor.stateCache);
+        descriptor.stateCacheParameterMap = &parameterMap;
+        descriptor.stateCacheChangeStamp  = changeStamp;
+    }
+
+    /* stores state of audio processor in <destData> */
+    destData = descriptor.stateCache;
+
+    Logging_trace1("<<: size = %1", TOSTRING(Natural{destData.getSize()}));
+}
+
+/*--------------------*/
+
+void SoXAudioProcessor::setStateInformation (const void* data,
+                                             int sizeInBytes)
+{
+    Logging_trace1(">>: size = %1", TOSTRING(Integer{sizeInBytes}));
+
+    SoXStartupProfiler::Span span{SoXStartupPhase::stateRestore};
+    _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    const SoXEffectParameterMap& parameterMap = effectParameterMap();
+    const Natural byteCount = (Natural) Integer::maximum(0, sizeInBytes);
+    _completeStateRestoration(descriptor);
+
+    /* restores state of audio processor from <data>; the older text
+       form is still accepted */
+    StringList parameterNameList;
+    StringList valueList;
+
+    if (!_readBinaryState(parameterMap, data, byteCount,
+                          parameterNameList, valueList)) {
+        const String st((char *) data, (size_t) byteCount);
+        _readKeyValueMapString(parameterMap, st,
+                               parameterNameList, valueList);
+    }
+
+    _applyValueList(parameterNameList, valueList);
+
+    /* the effect settings may still be recalculated by the worker
+       pool, hence the effect is not inspected here */
+    Logging_trace1("<<: count = %1",
+                   TOSTRING(parameterNameList.size()));
+}
+
+/*--------------------*/
+/* parameter map      */
+/*--------------------*/
+
+SoXEffectParameterMap& SoXAudioProcessor::effectParameterMap () const
+{
+    _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    SoXAudioEffect* effect = descriptor.effect;
+    return effect->effectParameterMap();
+}
+
+/*--------------------*/
+
+void SoXAudioProcessor::setValue (IN String& parameterName,
+                                  IN String& value,
+                                  IN Boolean recalculationIsForced)
+{
+    Logging_trace3(">>: parameterName = %1, value = %2,"
+                   " recalcIsForced = %3",
+                   parameterName, value,
+                   TOSTRING(recalculationIsForced));
+
+    _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    Boolean isQueued = false;
+    _completeStateRestoration(descriptor);
+
+    if (descriptor.isPlaying) {
+        /* hand over to audio thread for the next block, but let the
+           effect allocate for the value here */
+        descriptor.effect->reserveForValue(parameterName, value);
+
+        if (descriptor.morphEffect != NULL) {
+            descriptor.morphEffect->reserveForValue(parameterName, value);
+        }
+
+        SoXParameterEvent event{-Real::infinity, parameterName, value,
+                                recalculationIsForced};
+        isQueued = descriptor.eventQueue.push(event);
+    }
+
+    if (!isQueued) {
+        _applyValue(parameterName, value, recalculationIsForced);
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXAudioProcessor::scheduleValue (IN String& parameterName,
+                                       IN String& value,
+                                       IN Real timePosition)
+{
+    Logging_trace3(">>: parameterName = %1, value = %2,"
+                   " timePosition = %3",
+                   parameterName, value, TOSTRING(timePosition));
+
+    _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    Boolean isQueued = false;
+    _completeStateRestoration(descriptor);
+
+    if (descriptor.isPlaying) {
+        descriptor.effect->reserveForValue(parameterName, value);
+
+        if (descriptor.morphEffect != NULL) {
+            descriptor.morphEffect->reserveForValue(parameterName, value);
+        }
+
+        SoXParameterEvent event{timePosition, parameterName, value, true};
+        isQueued = descriptor.eventQueue.push(event);
+    }
+
+    if (!isQueued) {
+        _applyValue(parameterName, value, true);
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXAudioProcessor::_applyValue (IN String& parameterName,
+                                     IN String& value,
+                                     IN Boolean recalculationIsForced)
+{
+    Logging_trace3(">>: parameterName = %1, value = %2,"
+                   " recalcIsForced = %3",
+                   parameterName, value,
+                   TOSTRING(recalculationIsForced));
+
+    _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    const SoXEffectParameterMap& parameterMap = effectParameterMap();
+
+    if (!parameterMap.contains(parameterName)) {
+        Logging_trace1("--: bad parameter - %1", parameterName);
+    } else {
+        if (parameterMap.valueIsDifferent(parameterName, value)) {
+            /* update effect and parameter map */
+            SoXAudioEffect* effect = descriptor.effect;
+            const SoXParameterValueChangeKind changeKind =
+                effect->setValue(parameterName, value,
+                                 recalculationIsForced);
+            _reportValueChange(parameterName, value, changeKind);
+        }
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXAudioProcessor::_applyValueList (IN StringList& parameterNameList,
+                                         IN StringList& valueList)
+{
+    Logging_trace1(">>: count = %1", TOSTRING(parameterNameList.size()));
+
+    _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    SoXAudioEffect* effect = descriptor.effect;
+    SoXEffectParameterMap& parameterMap = effectParameterMap();
+
+    /* the audio thread must not run while the effect is changed
+       directly; suspending waits for the current block */
+    suspendProcessing(true);
+    effect->beginParameterBatch();
+
+    for (Natural i = 0;  i < parameterNameList.size();  i++) {
+        const String& parameterName = parameterNameList[i];
+
+        /* make sure that the value in parameter map does not match
+           the new value, so that the effect is updated */
+        parameterMap.invalidateValue(parameterName);
+        _applyValue(parameterName, valueList[i], true);
+    }
+
+    /* the expensive recalculation at the end of the batch is left
+       to the worker pool, such that many instances restored on a
+       project load recalculate in parallel; the pending flag is
+       set before the audio thread may run again */
+    SoXWorkerPool& workerPool = SoXWorkerPool::instance();
+    workerPool.reserveThreads(SoXWorkerPool::suggestedThreadCount(
+                                  SoXWorkerPool::maximumDetachedTaskCount));
+    descriptor.stateRestorationIsPending.store(true,
+                                               std::memory_order_release);
+    const Natural taskHandle =
+        workerPool.startDetachedTask(_restoreEffectSettings, &descriptor);
+
+    if (taskHandle == SoXWorkerPool::completedTaskHandle) {
+        descriptor.stateRestorationIsPending
+            .store(false, std::memory_order_release);
+    } else {
+        descriptor.stateRestorationTaskHandle
+            .store((size_t) taskHandle, std::memory_order_release);
+    }
+
+    suspendProcessing(false);
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXAudioProcessor::_applyPreset (IN Natural presetIndex)
+{
+    Logging_trace1(">>: %1", TOSTRING(presetIndex));
+
+    _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    _completeStateRestoration(descriptor);
+
+    /* a crossfade still running ends here, such that the new preset
+       starts from its target */
+    _finishMorph();
+    SoXAudioEffect* effect =
+        (descriptor.isPlaying && descriptor.morphDuration > Real{0.0}
+         ? _makeEffect() : NULL);
+
+    if (effect == NULL) {
+        _setPresetValues(presetIndex);
+    } else {
+        _startMorph(presetIndex, effect);
+    }
+
+    descriptor.currentPresetIndex = presetIndex;
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXAudioProcessor::_setPresetValues (IN Natural presetIndex)
+{
+    Logging_trace1(">>: %1", TOSTRING(presetIndex));
+
+    _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    SoXAudioEffect* effect = descriptor.effect;
+    const SoXEffectParameterMap& parameterMap = effectParameterMap();
+    const SoXPresetParameterList& parameterList =
+        descriptor.presetBank.preset(presetIndex);
+
+    /* the preset values have been checked when loading, so they are
+       set numerically without any string parsing; the audio thread
+       waits for the complete batch */
+    suspendProcessing(true);
+    effect->beginParameterBatch();
+
+    for (const SoXPresetParameter& parameter : parameterList) {
+        const Natural parameterId = parameter.parameterId;
+
+        if (parameterMap.numericValue(parameterId) != parameter.value) {
+            const String parameterName =
+                parameterMap.parameterName(parameterId);
+            const SoXParameterValueChangeKind changeKind =
+                effect->setNumericValue(parameterId, parameter.value,
+                                        true);
+            _reportValueChange(parameterName,
+                               parameterMap.value(parameterName),
+                               changeKind);
+        }
+    }
+
+    effect->commitParameterBatch();
+    effect->setParameterValidity(true);
+    suspendProcessing(false);
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void SoXAudioProcessor::_startMorph (IN Natural presetIndex,
+                                     INOUT SoXAudioEffect* effect)
+{
+    Logging_trace1(">>: %1", TOSTRING(presetIndex));
+
+    _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    const SoXEffectParameterMap& parameterMap = effectParameterMap();
+    const SoXEffectParameterMap& targetParameterMap =
+        effect->effectParameterMap();
+    const SoXPresetParameterList& parameterList =
+        descriptor.presetBank.preset(presetIndex);
+    const StringList parameterNameList = parameterMap.parameterNameList();
+    const Real sampleRate{getSampleRate()};
+    StringList& changedNameList = descriptor.morphParameterNameList;
+    GenericList<SoXParameterValueChangeKind>& changeKindList =
+        descriptor.morphChangeKindList;
+
+    /* the target starts from the current values of the running
+       effect with the preset on top; it is completely set up and
+       prepared here, such that the audio thread neither parses nor
+       allocates */
+    effect->setDefaultValues();
+    effect->beginParameterBatch();
+
+    for (const String& parameterName : parameterNameList) {
+        effect->setValue(parameterName, parameterMap.value(parameterName),
+                         false);
+    }
+
+    changedNameList.clear();
+    changeKindList.clear();
+
+    for (const SoXPresetParameter& parameter : parameterList) {
+        const Natural parameterId = parameter.parameterId;
+
+        if (targetParameterMap.numericValue(parameterId)
+            != parameter.value) {
+            changedNameList.append(targetParameterMap
+                                   .parameterName(parameterId));
+            changeKindList.append(effect->setNumericValue(parameterId,
+                                                          parameter.value,
+                                                          true));
+        }
+    }
+
+    effect->commitParameterBatch();
+    effect->setParameterValidity(true);
+    effect->setPrecisionProfile(descriptor.precisionProfile);
+    effect->prepareToPlay(sampleRate);
+    effect->publishMemoryFootprint();
+    effect->setQualityLevel(descriptor.qualityGovernor.level());
+
+    /* the audio thread takes over the crossfade data only after
+       the state change */
+    descriptor.morphEffect   = effect;
+    descriptor.morphPosition = 0;
+    descriptor.morphLength   =
+        Natural::maximum(1, (Natural) Real::round(descriptor.morphDuration
+                                                  * sampleRate));
+    descriptor.morphState.store(_MorphState::fading,
+                                std::memory_order_release);
+
+    Logging_trace1("<<: morphLength = %1",
+                   TOSTRING(descriptor.morphLength));
+}
+
+/*--------------------*/
+
+void SoXAudioProcessor::_finishMorph ()
+{
     Logging_trace(">>");
+
+    _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    const _MorphState morphState =
+        descriptor.morphState.load(std::memory_order_acquire);
+
+    if (morphState != _MorphState::idle) {
+        SoXAudioEffect* effect = descriptor.effect;
+
+        {
+            /* the callback lock waits for the current block, the
+               next one is processed by the target alone */
+            const juce::ScopedLock lock{getCallbackLock()};
+            descriptor.effect                = descriptor.morphEffect;
+            descriptor.morphEffect           = NULL;
+            descriptor.silentSampleCount     = 0;
+            descriptor.isMonoProcessing      = false;
+            descriptor.channelStatesAreEqual = false;
+            descriptor.morphState.store(_MorphState::idle,
+                                        std::memory_order_release);
+
+            /* the cached state stems from the previous effect */
+            descriptor.stateCacheParameterMap = NULL;
+
+            /* the governor may have changed the level since the
+               start of the crossfade */
+            descriptor.effect
+                ->setQualityLevel(descriptor.qualityGovernor.level());
+        }
+
+        effect->releaseResources();
+        delete effect;
+
+        /* report the preset values only now, such that observers
+           and host see the values of the effect actually running */
+        const SoXEffectParameterMap& parameterMap = effectParameterMap();
+        StringList& changedNameList = descriptor.morphParameterNameList;
+
+        for (Natural i = 0;  i < changedNameList.size();  i++) {
+            const String& parameterName = changedNameList[i];
+            _reportValueChange(parameterName,
+                               parameterMap.value(parameterName),
+                               descriptor.morphChangeKindList[i]);
+        }
+
+        changedNameList.clear();
+        descriptor.morphChangeKindList.clear();
+        _updateLatency();
+    }
+
+    Logging_trace("<<");
+}
+
+/*--------------------*/
+
+void
+SoXAudioProcessor::_reportValueChange
+                       (IN String& parameterName,
+                        IN String& value,
+                        IN SoXParameterValueChangeKind changeKind)
+{
+    Logging_trace3(">>: parameterName = %1, value = %2, kind = %3",
+                   parameterName, value,
+                   SoXParameterValueChangeKind_toString(changeKind));
+
+    _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    const SoXEffectParameterMap& parameterMap = effectParameterMap();
+
+    /* notify listeners */
+    SoXParameterValueChangeKind parameterChange = 
+        SoXParameterValueChangeKind::parameterChange;
+
+    if (changeKind != parameterChange) {
+        _notifyObserversAboutChange(changeKind, parameterName);
+    }
+
+    _notifyObserversAboutChange(parameterChange, parameterName);
+
+    /* update juce parameter object */
+    Natural parameterIndex =
+        descriptor.parameterNameToIndexMap.at(parameterName);
+    juce::AudioProcessorParameter* parameter =
+        getParameters()[(int) parameterIndex];
+    _updateAudioProcessorParameter(parameter,
+                                   parameterName,
+                                   parameterMap,
+                                   value);
+
+    _updateLatency();
+
     Logging_trace("<<");
-    return new SoXAudioEditor(*this);
 }
 
-/*--------------------*/
-/* property queries   */
 /*--------------------*/
 
-bool SoXAudioProcessor::supportsDoublePrecisionProcessing () const
+void SoXAudioProcessor::_updateLatency ()
 {
-    return false;
-}
+    Logging_trace(">>");
 
-/*--------------------*/
+    _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    /* re-blocking with latency delays by one block */
+    const Natural reblockLatency =
+        (descriptor.reblockingHasLatency
+         ? descriptor.reblockLength : Natural{0});
+    const int latency =
+        (int) (descriptor.effect->latency() + reblockLatency);
+
+    if (latency != getLatencySamples()) {
+        setLatencySamples(latency);
+    }
 
-bool SoXAudioProcessor::acceptsMidi () const
-{
-    return false;
+    Logging_trace1("<<: %1", TOSTRING(Natural{latency}));
 }
 
 /*--------------------*/
 
-bool SoXAudioProcessor::producesMidi () const
+void SoXAudioProcessor::setValues (IN Dictionary& dictionary)
 {
-    return false;
+    Logging_trace1(">>: %1", dictionary.toString());
+
+    Natural count = dictionary.size();
+
+    for (auto& entry : dictionary) {
+        const String parameterName = entry.first;
+        const String value         = entry.second;
+        const Boolean recalculationIsForced = (--count == 0);
+        setValue(parameterName, value, recalculationIsForced);
+    }
+
+    Logging_trace("<<");
 }
 
 /*--------------------*/
 
-bool SoXAudioProcessor::isMidiEffect () const
+void SoXAudioProcessor::_setAssociatedEffect (IN SoXAudioEffect* effect)
 {
-    return false;
+    Logging_trace(">>");
+
+    _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    descriptor.effect = (SoXAudioEffect*) effect;
+    descriptor.effect->setPrecisionProfile(descriptor.precisionProfile);
+    descriptor.profiler.setName(effect->name());
+    descriptor.telemetryPublisher.setName(effect->name());
+
+    {
+        SoXStartupProfiler::Span span{SoXStartupPhase::parameterMapBuild};
+        _registerParameters();
+    }
+
+    /* the associated effect is set at the end of the construction
+       of the concrete processor, hence construction ends here */
+    if (descriptor.constructionStartTimeStamp != 0) {
+        SoXStartupProfiler::endPhase(SoXStartupPhase::construction,
+                                     descriptor.constructionStartTimeStamp);
+        descriptor.constructionStartTimeStamp = 0;
+    }
+
+    Logging_trace("<<");
 }
 
 /*--------------------*/
 
-double SoXAudioProcessor::getTailLengthSeconds () const
+void SoXAudioProcessor::_registerParameters ()
 {
-    return 0.0;
+    Logging_trace(">>");
+
+    _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+
+    const SoXEffectParameterMap& parameterMap = effectParameterMap();
+    Logging_trace1("--: parameterMap = %1", parameterMap.toString());
+    const StringList parameterNameList = parameterMap.parameterNameList();
+
+    for (const String& parameterName : parameterNameList) {
+        juce::AudioProcessorParameter* parameter =
+            _constructParameterObject(parameterName, parameterMap);
+
+        if (parameter != NULL) {
+            addParameter(parameter);
+            Natural parameterIndex = parameter->getParameterIndex();
+            descriptor.parameterNameToIndexMap.set(parameterName,
+                                                   parameterIndex);
+            descriptor.hostParameterDataList
+                .setLength(parameterIndex + 1);
+            descriptor.hostParameterDataList[parameterIndex] =
+                _makeHostParameterData(parameterName, parameterMap);
+            parameter->addListener(&descriptor.listener);
+        }
+    }
+
+    const Natural parameterCount = descriptor.hostParameterDataList.size();
+    descriptor.hostValueExchange.setLength(parameterCount);
+    descriptor.hostChangeExchange.setLength(parameterCount);
+
+    /* the bypass parameter comes after the effect parameters, hence
+       it does not affect their indices; it is read directly by the
+       audio thread */
+    const juce::ParameterID bypassParameterID = juce::String("bypass");
+    descriptor.bypassParameter =
+        new juce::AudioParameterBool(bypassParameterID, "Bypass", false);
+    addParameter(descriptor.bypassParameter);
+
+    Logging_trace("<<");
 }
 
 /*--------------------*/
 
-int SoXAudioProcessor::getNumPrograms ()
+void SoXAudioProcessor::_startAutomationCapture (IN Real sampleRate)
 {
-    return 1;
+    const String directoryPath = _automationCaptureDirectory();
+
+    if (directoryPath > "") {
+        Logging_trace1(">>: %1", directoryPath);
+
+        _SoXAudioProcessorDescriptor& descriptor =
+            TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+        const SoXEffectParameterMap& parameterMap = effectParameterMap();
+        const StringList parameterNameList =
+            parameterMap.parameterNameList();
+        StringList& valueList = descriptor.automationInitialValueList;
+        valueList.clear();
+        valueList.setLength(parameterNameList.size());
+
+        for (const String& parameterName : parameterNameList) {
+            const Natural parameterId =
+                parameterMap.parameterId(parameterName);
+
+            if (parameterId < valueList.size()) {
+                valueList[parameterId] = parameterMap.value(parameterName);
+            }
+        }
+
+        descriptor.automationSampleRate = sampleRate;
+        descriptor.automationRecorder.start(_automationCaptureByteCount);
+        Logging_trace("<<");
+    }
 }
 
 /*--------------------*/
 
-int SoXAudioProcessor::getCurrentProgram ()
+void SoXAudioProcessor::_finishAutomationCapture ()
 {
-    return 0;
+    const String directoryPath = _automationCaptureDirectory();
+
+    if (directoryPath > "") {
+        Logging_trace1(">>: %1", directoryPath);
+
+        _SoXAudioProcessorDescriptor& descriptor =
+            TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+        const SoXEffectParameterMap& parameterMap = effectParameterMap();
+        const Natural parameterCount =
+            descriptor.automationInitialValueList.size();
+        StringList parameterNameList;
+
+        for (Natural parameterId = 0;  parameterId < parameterCount;
+             parameterId++) {
+            parameterNameList.append(parameterMap
+                                     .parameterName(parameterId));
+        }
+
+        const Natural traceIndex{(size_t) ++_automationTraceCount};
+        const String fileName =
+            STR::expand("%1/%2-%3.soxtrace",
+                        directoryPath, name(), TOSTRING(traceIndex));
+        descriptor.automationRecorder
+            .writeToFile(fileName, name(), descriptor.automationSampleRate,
+                         getMainBusNumInputChannels(), parameterNameList,
+                         descriptor.automationInitialValueList);
+        descriptor.automationRecorder.stop();
+        Logging_trace("<<");
+    }
 }
 
 /*--------------------*/
 
-void SoXAudioProcessor::setCurrentProgram (int)
+SoXAudioEffect* SoXAudioProcessor::_makeEffect () const
 {
-    /* does not apply */
+    return NULL;
 }
 
+/*--------------------*/
+/* profiling          */
 /*--------------------*/
 
-const juce::String SoXAudioProcessor::getProgramName (int)
+SoXProcessingStatistics SoXAudioProcessor::processingStatistics () const
 {
-    return "default";
+    const _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    return descriptor.profiler.statistics();
 }
 
+/*--------------------*/
+/* quality governor   */
 /*--------------------*/
 
-void SoXAudioProcessor::changeProgramName (int, const juce::String&)
+void SoXAudioProcessor::setQualityGovernorIsEnabled (IN Boolean isEnabled)
 {
-    /* does not apply */
+    Logging_trace1(">>: %1", TOSTRING(isEnabled));
+
+    _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    descriptor.qualityGovernor.setIsEnabled(isEnabled);
+
+    Logging_trace("<<");
 }
 
 /*--------------------*/
 
-bool SoXAudioProcessor::hasEditor () const
+Natural SoXAudioProcessor::qualityLevel () const
 {
-    return true;
+    const _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    return descriptor.qualityGovernor.level();
 }
 
+/*--------------------*/
+/* precision profile  */
 /*--------------------*/
 
-const juce::String SoXAudioProcessor::getName () const
+void SoXAudioProcessor::setPrecisionProfile (IN SoXPrecisionProfile profile)
 {
-    return juce::String(name());
+    Logging_trace1(">>: %1", precisionProfileToString(profile));
+
+    _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    _completeStateRestoration(descriptor);
+
+    /* a crossfade still running ends here, such that only a single
+       effect has to be changed; the audio thread must not run while
+       the effect is changed directly */
+    _finishMorph();
+    descriptor.precisionProfile = profile;
+    suspendProcessing(true);
+    descriptor.effect->setPrecisionProfile(profile);
+    suspendProcessing(false);
+
+    Logging_trace("<<");
 }
 
 /*--------------------*/
 
-String SoXAudioProcessor::name () const
+SoXPrecisionProfile SoXAudioProcessor::precisionProfile () const
 {
-    return String("???");
+    const _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    return descriptor.precisionProfile;
 }
 
-/*--------------------*/
-/* persistence        */
 /*--------------------*/
 
-void SoXAudioProcessor::getStateInformation (OUT juce::MemoryBlock& destData)
+SoXMemoryFootprint SoXAudioProcessor::memoryFootprint ()
 {
     Logging_trace(">>");
 
-    /* stores state of audio processor in <destData> */
-    const String title = getName().toStdString();
-    const String st = _convertMapToString(effectParameterMap(), title);
-    const Natural sizeInBytes = st.size();
-    destData.setSize((int) sizeInBytes);
-    destData.copyFrom(st.c_str(), 0, (int) sizeInBytes);
+    _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    _completeStateRestoration(descriptor);
+    const SoXMemoryFootprint result =
+        descriptor.effect->publishMemoryFootprint();
 
-    Logging_trace1("<<: %1", _normalize(st));
+    Logging_trace1("<<: %1", result.toString());
+    return result;
 }
 
+/*--------------------*/
+/* metering           */
 /*--------------------*/
 
-void SoXAudioProcessor::setStateInformation (const void* data,
-                                             int sizeInBytes)
+Boolean
+SoXAudioProcessor::acquireLevels (OUT SoXLevelMeterSnapshot& snapshot)
 {
-    Logging_trace(">>");
-
     _SoXAudioProcessorDescriptor& descriptor =
         TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
-    SoXAudioEffect* effect = descriptor.effect;
-
-    /* restores state of audio processor from <data> */
-    String st((char *) data, sizeInBytes);
-    _readKeyValueMapString(this, effectParameterMap(), st);
-    effect->setParameterValidity(true);
-
-    Logging_trace2("<<: data = %1, processor = %2",
-                   _normalize(st), effect->toString());
+    return descriptor.levelMeter.acquire(snapshot);
 }
 
 /*--------------------*/
-/* parameter map      */
+/* presets            */
 /*--------------------*/
 
-SoXEffectParameterMap& SoXAudioProcessor::effectParameterMap () const
+Boolean SoXAudioProcessor::loadPresetBank (IN String& fileName)
 {
+    Logging_trace1(">>: %1", fileName);
+
     _SoXAudioProcessorDescriptor& descriptor =
         TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
-    SoXAudioEffect* effect = descriptor.effect;
-    return effect->effectParameterMap();
+    SoXPresetBank& presetBank = descriptor.presetBank;
+    const Boolean isOkay = presetBank.load(fileName, name());
+
+    if (isOkay) {
+        presetBank.restrictToParameterMap(effectParameterMap());
+        descriptor.currentPresetIndex = 0;
+        updateHostDisplay();
+    }
+
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
 }
 
 /*--------------------*/
 
-void SoXAudioProcessor::setValue (IN String& parameterName,
-                                  IN String& value,
-                                  IN Boolean recalculationIsForced)
+Boolean SoXAudioProcessor::savePresetBank (IN String& fileName) const
 {
-    Logging_trace3(">>: parameterName = %1, value = %2,"
-                   " recalcIsForced = %3",
-                   parameterName, value,
-                   TOSTRING(recalculationIsForced));
+    Logging_trace1(">>: %1", fileName);
 
     _SoXAudioProcessorDescriptor& descriptor =
         TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
-    const SoXEffectParameterMap& parameterMap = effectParameterMap();
+    const Boolean isOkay = descriptor.presetBank.save(fileName);
 
-    if (!parameterMap.contains(parameterName)) {
-        Logging_trace1("--: bad parameter - %1", parameterName);
-    } else {
-        if (parameterMap.valueIsDifferent(parameterName, value)) {
-            /* update effect and parameter map */
-            SoXAudioEffect* effect = descriptor.effect;
-            const SoXParameterValueChangeKind changeKind =
-                effect->setValue(parameterName, value,
-                                 recalculationIsForced);
+    Logging_trace1("<<: %1", TOSTRING(isOkay));
+    return isOkay;
+}
 
-            /* notify listeners */
-            SoXParameterValueChangeKind parameterChange = 
-                SoXParameterValueChangeKind::parameterChange;
-        
-            if (changeKind != parameterChange) {
-                _notifyObserversAboutChange(changeKind, parameterName);
-            }
+/*--------------------*/
 
-            _notifyObserversAboutChange(parameterChange, parameterName);
+void SoXAudioProcessor::storePreset (IN String& presetName)
+{
+    Logging_trace1(">>: %1", presetName);
 
-            /* update juce parameter object */
-            Natural parameterIndex =
-                descriptor.parameterNameToIndexMap.at(parameterName);
-            juce::AudioProcessorParameter* parameter =
-                getParameters()[(int) parameterIndex];
-            _updateAudioProcessorParameter(parameter,
-                                           parameterName,
-                                           parameterMap,
-                                           value);
-        }
+    _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    SoXPresetBank& presetBank = descriptor.presetBank;
+
+    if (presetBank.effectName() != name()) {
+        presetBank.clear(name());
     }
 
+    presetBank.storePreset(presetName, effectParameterMap());
+    presetBank.findPreset(presetName, descriptor.currentPresetIndex);
+    updateHostDisplay();
+
     Logging_trace("<<");
 }
 
 /*--------------------*/
 
-void SoXAudioProcessor::setValues (IN Dictionary& dictionary)
+Boolean SoXAudioProcessor::selectPreset (IN String& presetName)
 {
-    Logging_trace1(">>: %1", dictionary.toString());
+    Logging_trace1(">>: %1", presetName);
 
-    Natural count = dictionary.size();
+    _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    Natural presetIndex;
+    const Boolean isFound =
+        descriptor.presetBank.findPreset(presetName, presetIndex);
 
-    for (auto& entry : dictionary) {
-        const String parameterName = entry.first;
-        const String value         = entry.second;
-        const Boolean recalculationIsForced = (--count == 0);
-        setValue(parameterName, value, recalculationIsForced);
+    if (isFound) {
+        _applyPreset(presetIndex);
     }
 
-    Logging_trace("<<");
+    Logging_trace1("<<: %1", TOSTRING(isFound));
+    return isFound;
 }
 
 /*--------------------*/
 
-void SoXAudioProcessor::_setAssociatedEffect (IN SoXAudioEffect* effect)
+void SoXAudioProcessor::setMorphDuration (IN Real duration)
 {
-    Logging_trace(">>");
+    Logging_trace1(">>: %1", TOSTRING(duration));
 
     _SoXAudioProcessorDescriptor& descriptor =
         TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
-    descriptor.effect = (SoXAudioEffect*) effect;
+    descriptor.morphDuration = Real::maximum(Real{0.0}, duration);
 
-    const SoXEffectParameterMap& parameterMap = effectParameterMap();
-    Logging_trace1("--: parameterMap = %1", parameterMap.toString());
-    const StringList parameterNameList = parameterMap.parameterNameList();
+    Logging_trace("<<");
+}
 
-    for (const String& parameterName : parameterNameList) {
-        juce::AudioProcessorParameter* parameter =
-            _constructParameterObject(parameterName, parameterMap);
+/*--------------------*/
 
-        if (parameter != NULL) {
-            addParameter(parameter);
-            Natural parameterIndex = parameter->getParameterIndex();
-            descriptor.parameterNameToIndexMap.set(parameterName,
-                                                   parameterIndex);
-            parameter->addListener(&descriptor.listener);
-        }
-    }
+void SoXAudioProcessor::setReblocking (IN Natural blockLength,
+                                       IN Boolean isLatencyAccepted)
+{
+    Logging_trace2(">>: blockLength = %1, isLatencyAccepted = %2",
+                   TOSTRING(blockLength), TOSTRING(isLatencyAccepted));
+
+    _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    descriptor.requestedReblockLength =
+        Natural::minimum(blockLength, _maximumReblockLength);
+    descriptor.requestedReblockingHasLatency = isLatencyAccepted;
 
     Logging_trace("<<");
 }
@@ -797,8 +3483,11 @@ SoXAudioProcessor::_notifyObserversAboutChange
 
     _SoXAudioProcessorDescriptor& descriptor =
         TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
-    _SoXAudioEditorPtrSet observerSet = descriptor.observerSet;
+    const _SoXAudioEditorPtrSet& observerSet = descriptor.observerSet;
 
+    /* the editors only record the change for their next refresh,
+       hence they cannot change the observer set meanwhile and the
+       set need not be copied */
     for (SoXAudioEditor* editor : observerSet) {
         if (editor != nullptr) {
             editor->notifyAboutChange(kind, parameterName);
@@ -812,14 +3501,82 @@ SoXAudioProcessor::_notifyObserversAboutChange
 /* event handling     */
 /*--------------------*/
 
-void SoXAudioProcessor::prepareToPlay (double sampleRate, int)
+void SoXAudioProcessor::prepareToPlay (double sampleRate,
+                                       int maximumExpectedSamplesPerBlock)
 {
-    Logging_trace1(">>: sampleRate = %1",
-                   TOSTRING(Real{sampleRate}));
+    Logging_trace2(">>: sampleRate = %1, maximumSampleCount = %2",
+                   TOSTRING(Real{sampleRate}),
+                   TOSTRING(Natural{maximumExpectedSamplesPerBlock}));
 
     _SoXAudioProcessorDescriptor& descriptor =
         TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    _completeStateRestoration(descriptor);
     SoXAudioEffect* effect = descriptor.effect;
+    const Boolean isFirstPreparation = !descriptor.isPrepared;
+    const std::uint64_t startTimeStamp = SoXStartupProfiler::startPhase();
+
+    /* the buffers and the effect state set up from here on lie
+       contiguously in the instance arena (in processing order); its
+       size is the demand of the last preparation or else estimated
+       from the current footprint */
+    StateArena& stateArena = descriptor.stateArena;
+    const size_t arenaByteCount =
+        (descriptor.stateArenaDemand > 0 ? descriptor.stateArenaDemand
+         : (size_t) effect->memoryFootprint().totalByteCount());
+    stateArena.reserve(arenaByteCount);
+    StateArena::Scope arenaScope{stateArena};
+
+    /* the re-blocking settings only change here, when the audio
+       thread is not running */
+    const Natural reblockLength = descriptor.requestedReblockLength;
+    descriptor.reblockLength = reblockLength;
+    descriptor.reblockingHasLatency =
+        (reblockLength > 0 && descriptor.requestedReblockingHasLatency);
+    descriptor.reblockFillCount = 0;
+
+    /* preallocate the conversion buffer for the maximum block size,
+       so that the audio thread only adapts its length */
+    const Natural channelCount = getMainBusNumInputChannels();
+    const Natural sampleCount =
+        Natural::maximum(Natural{maximumExpectedSamplesPerBlock},
+                         reblockLength);
+    AudioSampleListVector& audioSampleBuffer = descriptor.audioSampleBuffer;
+
+    /* the buffers are rebuilt, such that they move into the arena */
+    for (AudioSampleListVector* buffer
+             : {&audioSampleBuffer, &descriptor.morphBuffer,
+                &descriptor.bypassBuffer,
+                &descriptor.reblockOutputBuffer}) {
+        *buffer = AudioSampleListVector{};
+    }
+
+    audioSampleBuffer.resizeChannels(channelCount, sampleCount);
+    descriptor.morphBuffer.resizeChannels(channelCount, sampleCount);
+    descriptor.bypassBuffer.resizeChannels(channelCount, sampleCount);
+    descriptor.bypassFadeLength =
+        Natural::maximum(1, (Natural) Real::round(Real{sampleRate}
+                                                  * _bypassFadeDuration));
+    descriptor.bypassFadeRemainder = 0;
+    descriptor.allocatedChannelCount = channelCount;
+    descriptor.channelCount          = channelCount;
+    descriptor.outputChannelCount    = getTotalNumOutputChannels();
+    descriptor.sidechainChannelCount =
+        Natural{getTotalNumInputChannels()} - channelCount;
+    descriptor.sampleRate            = sampleRate;
+    descriptor.allocatedSampleCount  = sampleCount;
+    descriptor.silentSampleCount     = 0;
+    descriptor.levelMeter.setSampleRate(sampleRate);
+
+    if (descriptor.reblockingHasLatency) {
+        const int inputChannelCount = getTotalNumInputChannels();
+        descriptor.reblockFloatBuffer.setSize(inputChannelCount,
+                                              (int) reblockLength);
+        descriptor.reblockDoubleBuffer.setSize(inputChannelCount,
+                                               (int) reblockLength);
+        descriptor.reblockOutputBuffer.resizeChannels(channelCount,
+                                                      reblockLength);
+        descriptor.reblockOutputBuffer.setToZero();
+    }
 
     if (!effect->hasValidParameters()) {
         effect->setDefaultValues();
@@ -827,6 +3584,40 @@ void SoXAudioProcessor::prepareToPlay (double sampleRate, int)
     }
 
     effect->prepareToPlay(sampleRate);
+    descriptor.qualityGovernor.setLevelCount(effect->qualityLevelCount());
+    effect->setQualityLevel(0);
+    descriptor.stateArenaDemand =
+        stateArena.usedByteCount() + stateArena.overflowByteCount();
+
+    /* all pages of the arena are touched here, such that the first
+       blocks on the audio thread cause no page faults */
+    if (!stateArena.prefault(_memoryLockingIsEnabled())) {
+        Logging_trace("--: state arena could not be locked");
+    }
+
+    Logging_trace3("--: state arena capacity = %1, used = %2,"
+                   " overflow = %3",
+                   TOSTRING(Natural{stateArena.capacity()}),
+                   TOSTRING(Natural{stateArena.usedByteCount()}),
+                   TOSTRING(Natural{stateArena.overflowByteCount()}));
+    const SoXMemoryFootprint footprint = effect->publishMemoryFootprint();
+    descriptor.telemetryPublisher
+        .setMemoryByteCount(footprint.totalByteCount());
+    _updateLatency();
+    _startAutomationCapture(sampleRate);
+
+    /* from now on parameter changes go through the event queue */
+    descriptor.isPlaying = true;
+
+    if (isFirstPreparation) {
+        /* the startup of this instance is complete: report the
+           summary over all instances so far */
+        SoXStartupProfiler::endPhase(SoXStartupPhase::firstPrepareToPlay,
+                                     startTimeStamp);
+        descriptor.isPrepared = true;
+        Logging_trace1("--: startup summary =\n%1",
+                       SoXStartupProfiler::report());
+    }
 
     Logging_trace("<<");
 }
@@ -838,22 +3629,124 @@ void SoXAudioProcessor::releaseResources ()
     Logging_trace(">>");
     _SoXAudioProcessorDescriptor& descriptor =
         TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    _completeStateRestoration(descriptor);
+    _finishMorph();
     SoXAudioEffect* effect = descriptor.effect;
     effect->releaseResources();
+    _finishAutomationCapture();
+
+    /* the arena memory goes back to the heap as soon as the state
+       living in it is rebuilt or destroyed */
+    descriptor.stateArena.release();
+
+    if (SoXProcessingProfiler::isEnabled()) {
+        /* report the deadline statistics of the finished run */
+        const SoXProcessingStatistics statistics =
+            descriptor.profiler.statistics();
+        Logging_trace2("--: %1, loadHistogram = %2",
+                       statistics.toString(),
+                       statistics.loadHistogram.toString());
+    }
+
+    /* apply the changes the audio thread has not processed */
+    descriptor.isPlaying = false;
+    SoXParameterEvent event;
+
+    while (descriptor.eventQueue.tryPop(Real::infinity, event)) {
+        _applyValue(event.parameterName, event.value,
+                    event.recalculationIsForced);
+    }
+
+    handleAsyncUpdate();
     Logging_trace("<<");
 }
 
 /*--------------------*/
 
 void SoXAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                      juce::MidiBuffer&)
+                                      juce::MidiBuffer& midiMessages)
 {
     _SoXAudioProcessorDescriptor& descriptor =
         TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
-    SoXAudioEffect* effect = descriptor.effect;
+    /* a state restoration still pending is waited for (or even
+       done) here, outside of the real-time guard of the block */
+    _completeStateRestoration(descriptor);
+    /* decaying effect states must not run into denormals */
+    const DenormalGuard denormalGuard{};
+    /* in debug builds: count allocations and locks in the
+       callback */
+    SoXRealtimeGuard_scope("SoXAudioProcessor.processBlock");
+    Logging_span("SoXAudioProcessor.processBlock", this);
+
+    /* the sidechain channels follow the main channels in buffer;
+       the channel counts and the sample rate are loop invariants
+       cached in prepareToPlay */
+    const Natural channelCount = descriptor.channelCount;
+    const Natural outputChannelCount = descriptor.outputChannelCount;
+    const Natural sampleCount = (Natural) buffer.getNumSamples();
+
+    /* In case we have more outputs than inputs, this code clears any
+       output channels that didn't contain input data */
+    for (Natural i = channelCount;  i < outputChannelCount;  i++) {
+        buffer.clear((int) i, 0, (int) sampleCount);
+    }
+
+    const Real currentTimePosition =
+        _timePositionWhenNeeded(descriptor, getPlayHead());
+    const Real sampleRate = descriptor.sampleRate;
+    const std::uint64_t startTimeStamp = descriptor.profiler.startBlock();
+    const std::uint64_t governorTimeStamp =
+        descriptor.qualityGovernor.startBlock();
+    const std::uint64_t telemetryTimeStamp =
+        descriptor.telemetryPublisher.startBlock();
+
+    const Boolean updateIsNecessary =
+        _processReblocked(descriptor, buffer, currentTimePosition,
+                          sampleRate, channelCount);
+
+    if (_takeProgramChange(descriptor, midiMessages)
+        || updateIsNecessary) {
+        triggerAsyncUpdate();
+    }
+
+    _measureLevels(descriptor, buffer, channelCount);
+    descriptor.profiler.endBlock(startTimeStamp, sampleCount, sampleRate);
+
+    if (descriptor.qualityGovernor.endBlock(governorTimeStamp,
+                                            sampleCount, sampleRate)) {
+        /* the transition is logged on the message thread */
+        _applyQualityLevel(descriptor);
+        triggerAsyncUpdate();
+    }
+
+    descriptor.telemetryPublisher
+        .endBlock(telemetryTimeStamp, buffer.getArrayOfReadPointers(),
+                  channelCount, sampleCount, sampleRate,
+                  descriptor.qualityGovernor.level());
+}
+
+/*--------------------*/
 
-    const Natural channelCount = getTotalNumInputChannels();
-    const Natural outputChannelCount = getTotalNumOutputChannels();
+void SoXAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer,
+                                      juce::MidiBuffer& midiMessages)
+{
+    _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    /* a state restoration still pending is waited for (or even
+       done) here, outside of the real-time guard of the block */
+    _completeStateRestoration(descriptor);
+    /* decaying effect states must not run into denormals */
+    const DenormalGuard denormalGuard{};
+    /* in debug builds: count allocations and locks in the
+       callback */
+    SoXRealtimeGuard_scope("SoXAudioProcessor.processBlock");
+    Logging_span("SoXAudioProcessor.processBlock", this);
+
+    /* the sidechain channels follow the main channels in buffer;
+       the channel counts and the sample rate are loop invariants
+       cached in prepareToPlay */
+    const Natural channelCount = descriptor.channelCount;
+    const Natural outputChannelCount = descriptor.outputChannelCount;
     const Natural sampleCount = (Natural) buffer.getNumSamples();
 
     /* In case we have more outputs than inputs, this code clears any
@@ -862,21 +3755,102 @@ void SoXAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         buffer.clear((int) i, 0, (int) sampleCount);
     }
 
-    AudioSampleListVector audioSampleBuffer{};
+    const Real currentTimePosition =
+        _timePositionWhenNeeded(descriptor, getPlayHead());
+    const Real sampleRate = descriptor.sampleRate;
+    const std::uint64_t startTimeStamp = descriptor.profiler.startBlock();
+    const std::uint64_t governorTimeStamp =
+        descriptor.qualityGovernor.startBlock();
+    const std::uint64_t telemetryTimeStamp =
+        descriptor.telemetryPublisher.startBlock();
+
+    const Boolean updateIsNecessary =
+        _processReblocked(descriptor, buffer, currentTimePosition,
+                          sampleRate, channelCount);
+
+    if (_takeProgramChange(descriptor, midiMessages)
+        || updateIsNecessary) {
+        triggerAsyncUpdate();
+    }
+
+    _measureLevels(descriptor, buffer, channelCount);
+    descriptor.profiler.endBlock(startTimeStamp, sampleCount, sampleRate);
+
+    if (descriptor.qualityGovernor.endBlock(governorTimeStamp,
+                                            sampleCount, sampleRate)) {
+        /* the transition is logged on the message thread */
+        _applyQualityLevel(descriptor);
+        triggerAsyncUpdate();
+    }
+
+    descriptor.telemetryPublisher
+        .endBlock(telemetryTimeStamp, buffer.getArrayOfReadPointers(),
+                  channelCount, sampleCount, sampleRate,
+                  descriptor.qualityGovernor.level());
+}
+
+/*--------------------*/
+
+void SoXAudioProcessor::handleAsyncUpdate ()
+{
+    Logging_trace(">>");
+
+    _SoXAudioProcessorDescriptor& descriptor =
+        TOREFERENCE<_SoXAudioProcessorDescriptor>(_descriptor);
+    _completeStateRestoration(descriptor);
+
+    /* a complete crossfade is finished first, such that the
+       changes below are reported for the effect now running */
+    if (descriptor.morphState.load(std::memory_order_acquire)
+        == _MorphState::complete) {
+        _finishMorph();
+    }
+
+    const SoXEffectParameterMap& parameterMap = effectParameterMap();
+    SoXParameterEvent event;
+    descriptor.qualityGovernor.logTransitions();
+
+    if (!descriptor.isPlaying) {
+        /* no audio thread applies the host values */
+        _applyHostValues(descriptor);
+    }
+
+    /* when the audio thread holds the queue lock, it triggers
+       another update after its push */
+    while (descriptor.appliedEventQueue.tryPop(Real::infinity, event)) {
+        _reportValueChange(event.parameterName, event.value,
+                           event.changeKind);
+    }
 
-    for (Natural channel = 0;  channel < channelCount;  channel++) {
-        const float* inputPtr = buffer.getReadPointer((int) channel);
-        AudioSampleList sampleList{sampleCount};
-        convertArray(sampleList.asArray(), inputPtr, sampleCount);
-        audioSampleBuffer.append(sampleList);
+    /* the string forms of the host values are only made here */
+    SoXParameterSlotExchange<SoXParameterValueChangeKind>&
+        hostChangeExchange = descriptor.hostChangeExchange;
+
+    if (hostChangeExchange.takeChangeIndication()) {
+        SoXParameterValueChangeKind changeKind;
+
+        for (Natural parameterIndex = 0;
+             parameterIndex < hostChangeExchange.length();
+             parameterIndex++) {
+            if (hostChangeExchange.tryTake(parameterIndex, changeKind)) {
+                const _HostParameterData& data =
+                    descriptor.hostParameterDataList[parameterIndex];
+                const String& parameterName =
+                    parameterMap.parameterName(data.parameterId);
+                _reportValueChange(parameterName,
+                                   parameterMap.value(parameterName),
+                                   changeKind);
+            }
+        }
     }
 
-    const Real currentTimePosition = _readTime(getPlayHead());
-    effect->processBlock(currentTimePosition, audioSampleBuffer);
+    /* a program change from MIDI is handled like one from the
+       host */
+    const int requestedProgram = descriptor.requestedProgram.exchange(-1);
 
-    for (Natural channel = 0;  channel < channelCount;  channel++) {
-        float* outputPtr = buffer.getWritePointer((int) channel);
-        AudioSampleList& sampleList = audioSampleBuffer[channel];
-        convertArray(outputPtr, sampleList.asArray(), sampleCount);
+    if (requestedProgram >= 0) {
+        setCurrentProgram(requestedProgram);
     }
+
+    Logging_trace("<<");
 }
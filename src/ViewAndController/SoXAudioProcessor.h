@@ -20,11 +20,15 @@
 #include "JuceHeaders.h"
 
 #include "SoXAudioEffect.h"
+#include "SoXLevelMeter.h"
+#include "SoXProcessingProfiler.h"
 
 /*--------------------*/
 
 using std::set;
 using SoXPlugins::Effects::SoXAudioEffect;
+using SoXPlugins::Helpers::SoXLevelMeterSnapshot;
+using SoXPlugins::Helpers::SoXProcessingStatistics;
 
 /*====================*/
 
@@ -34,8 +38,32 @@ namespace SoXPlugins::ViewAndController {
      * A <C>SoXAudioProcessor</C> object provides an audio effect
      * wrapper for a plugin responsible for the communication to the
      * enclosing plugin host.
+     *
+     * Parameter changes arriving during playback are not applied
+     * directly to the effect, but queued as timestamped events;
+     * the audio thread drains this queue and splits each block at
+     * the event positions, so that changes are sample-accurate and
+     * never race with processing.  Host automation values are
+     * converted to numeric form without locking or string
+     * operations and handed to the audio thread via wait-free
+     * slots.  Observers and host parameters are updated afterwards
+     * on the message thread.
+     *
+     * Program changes during playback (also by MIDI program change
+     * messages) crossfade from the current effect to a second
+     * instance prepared with the new program on the message thread;
+     * both instances process the input during the fade and the
+     * second one replaces the first afterwards.  A bypass parameter
+     * lets the input pass without calling the effect once its
+     * tail has decayed.  Optionally the host blocks are re-blocked
+     * to effect blocks of a fixed length, such that hosts with
+     * varying block sizes do not lead to odd sample counts in the
+     * effect kernels.  Blocks with bitwise identical channels (a
+     * mono source on a stereo track) are processed as a single
+     * channel when the effect supports it.
      */
-    struct SoXAudioProcessor : public juce::AudioProcessor {
+    struct SoXAudioProcessor : public juce::AudioProcessor,
+                               private juce::AsyncUpdater {
 
         /**
          * Creates an audio processor to be associated with an audio
@@ -76,17 +104,32 @@ namespace SoXPlugins::ViewAndController {
          * values.
          *
          * @return  information whether this processor can handle
-         *          double sample values (false)
+         *          double sample values (true)
          */
         bool supportsDoublePrecisionProcessing () const override;
 
         /*--------------------*/
 
+        /**
+         * Tells whether this processor supports the bus layout
+         * <C>layouts</C>: the main input and output must have the
+         * same channel set (like mono, stereo, 7.1.4 or ambisonics)
+         * with at most 64 channels; an optional sidechain input may
+         * be disabled or have at most 64 channels.
+         *
+         * @param[in] layouts  the bus layout requested by the host
+         * @return  information whether layout is supported
+         */
+        bool isBusesLayoutSupported (const BusesLayout& layouts)
+            const override;
+
+        /*--------------------*/
+
         /**
          * Tells whether this processor accepts MIDI data.
          *
          * @return  information whether this processor accepts MIDI
-         *          data (false)
+         *          data (true for program changes)
          */
         bool acceptsMidi () const override;
 
@@ -121,6 +164,20 @@ namespace SoXPlugins::ViewAndController {
 
         /*--------------------*/
 
+        /**
+         * Returns the parameter for bypassing this processor; while
+         * it is set, the input passes unchanged and the effect is
+         * only fed silence until its tail has decayed, switching
+         * the bypass on or off crossfades between the dry and the
+         * processed signal.
+         *
+         * @return  the bypass parameter of this processor
+         */
+        juce::AudioProcessorParameter* getBypassParameter () const
+            override;
+
+        /*--------------------*/
+
         /**
          * Returns the number of programs this effect supports
          *
@@ -210,7 +267,9 @@ namespace SoXPlugins::ViewAndController {
          * <C>value</C>.  If value has wrong kind, it is ignored;
          * if <C>recalculationIsForced</C> is set, the
          * recalculation of dependent internal settings is
-         * forced (otherwise it is suppressed).
+         * forced (otherwise it is suppressed).  During playback
+         * the change is queued and applied at the start of the
+         * next processed block.
          *
          * @param[in] parameterName              name of parameter to
          *                                       be set
@@ -236,6 +295,209 @@ namespace SoXPlugins::ViewAndController {
          */
         void setValues (IN Dictionary& dictionary);
 
+        /*--------------------*/
+
+        /**
+         * Schedules parameter named <C>parameterName</C> to be set
+         * to <C>value</C> at time <C>timePosition</C> (in seconds of
+         * the host timeline); during playback the associated block
+         * is split at the corresponding sample, otherwise the value
+         * is set immediately.  Events must be scheduled in
+         * chronological order.
+         *
+         * @param[in] parameterName  name of parameter to be set
+         * @param[in] value          new value of parameter
+         * @param[in] timePosition   time position of change
+         */
+        void scheduleValue (IN String& parameterName,
+                            IN String& value,
+                            IN Real timePosition);
+
+        /*--------------------*/
+        /* profiling          */
+        /*--------------------*/
+
+        /**
+         * Returns a snapshot of the processing time statistics of
+         * this processor; the statistics are only updated while
+         * profiling is switched on (see
+         * <C>SoXProcessingProfiler</C>).
+         *
+         * @return  processing statistics of this instance
+         */
+        SoXProcessingStatistics processingStatistics () const;
+
+        /*--------------------*/
+
+        /**
+         * Recalculates the memory footprint of the effect of this
+         * processor, publishes it in the process-wide registry (see
+         * <C>SoXAudioEffect::totalMemoryFootprint</C>) and returns
+         * it; must not be called on the audio thread.
+         *
+         * @return  memory footprint of this instance
+         */
+        SoXMemoryFootprint memoryFootprint ();
+
+        /*--------------------*/
+        /* quality governor   */
+        /*--------------------*/
+
+        /**
+         * Switches the quality governor of this processor on or off
+         * depending on <C>isEnabled</C>; when on, the quality of the
+         * effect is stepped down under deadline pressure and up
+         * again when the load has recovered (see
+         * <C>SoXQualityGovernor</C>, which also takes its initial
+         * setting from the environment).
+         *
+         * @param[in] isEnabled  information whether governor shall
+         *                       be active
+         */
+        void setQualityGovernorIsEnabled (IN Boolean isEnabled);
+
+        /*--------------------*/
+
+        /**
+         * Returns the quality level currently set by the governor
+         * (zero for full quality).
+         *
+         * @return  current quality level of effect
+         */
+        Natural qualityLevel () const;
+
+        /*--------------------*/
+        /* precision profile  */
+        /*--------------------*/
+
+        /**
+         * Sets the precision profile of the effect of this
+         * processor to <C>profile</C> (see
+         * <C>SoXPrecisionProfile</C>; the initial profile is taken
+         * from the environment variable
+         * <C>SOXPLUGINS_PRECISION_PROFILE</C> and is SoX-exact when
+         * not set); must not be called on the audio thread, which
+         * is suspended for the change.
+         *
+         * @param[in] profile  new precision profile
+         */
+        void setPrecisionProfile (IN SoXPrecisionProfile profile);
+
+        /*--------------------*/
+
+        /**
+         * Returns the precision profile of the effect.
+         *
+         * @return  current precision profile
+         */
+        SoXPrecisionProfile precisionProfile () const;
+
+        /*--------------------*/
+        /* metering           */
+        /*--------------------*/
+
+        /**
+         * Takes over the levels of the latest measurement window of
+         * the output (peak and RMS per channel and the gain
+         * reductions of the effect) into <C>snapshot</C> and tells
+         * whether there was a new window since the last call; the
+         * levels are measured on the audio thread and handed over
+         * without locks, this must only be called by a single
+         * display timer.
+         *
+         * @param[out] snapshot  the levels of the latest window
+         * @return  information whether new levels have been
+         *          acquired
+         */
+        Boolean acquireLevels (OUT SoXLevelMeterSnapshot& snapshot);
+
+        /*--------------------*/
+        /* presets            */
+        /*--------------------*/
+
+        /**
+         * Replaces the preset bank of this processor by the bank in
+         * the file named <C>fileName</C> and tells whether this has
+         * been successful; a bank for another effect is rejected.
+         * The presets are restricted to the parameters of the
+         * effect when loading, hence they are the host programs
+         * and can be switched without parsing or checking values.
+         *
+         * @param[in] fileName  the name of the bank file
+         * @return  information whether the bank has been loaded
+         */
+        Boolean loadPresetBank (IN String& fileName);
+
+        /*--------------------*/
+
+        /**
+         * Writes the preset bank of this processor to the file
+         * named <C>fileName</C> and tells whether this has been
+         * successful.
+         *
+         * @param[in] fileName  the name of the bank file
+         * @return  information whether the bank has been written
+         */
+        Boolean savePresetBank (IN String& fileName) const;
+
+        /*--------------------*/
+
+        /**
+         * Stores the current parameter values of the effect as
+         * preset named <C>presetName</C> in the preset bank
+         * (replacing a preset with the same name).
+         *
+         * @param[in] presetName  the name of the preset
+         */
+        void storePreset (IN String& presetName);
+
+        /*--------------------*/
+
+        /**
+         * Switches the effect to the preset named
+         * <C>presetName</C> in the preset bank and tells whether
+         * that preset exists.
+         *
+         * @param[in] presetName  the name of the preset
+         * @return  information whether the preset has been applied
+         */
+        Boolean selectPreset (IN String& presetName);
+
+        /*--------------------*/
+
+        /**
+         * Sets the duration of the crossfade on a program change
+         * during playback to <C>duration</C> seconds; a duration of
+         * zero switches the parameters of the running effect
+         * directly.
+         *
+         * @param[in] duration  the crossfade duration in seconds
+         */
+        void setMorphDuration (IN Real duration);
+
+        /*--------------------*/
+
+        /**
+         * Sets the re-blocking of host blocks to effect blocks of
+         * <C>blockLength</C> samples (typically 32 or 64); a length
+         * of zero passes the host blocks unchanged.  When
+         * <C>isLatencyAccepted</C> is set, the input is gathered in
+         * blocks of exactly that length and the output is delayed
+         * by one block, otherwise the host block is split into
+         * blocks of that length and a shorter remainder without any
+         * latency.  Takes effect with the next
+         * <C>prepareToPlay</C>.
+         *
+         * @param[in] blockLength        the number of samples per
+         *                               effect block (or zero)
+         * @param[in] isLatencyAccepted  information whether a
+         *                               latency of one block is
+         *                               accepted for constant
+         *                               block lengths
+         */
+        void setReblocking (IN Natural blockLength,
+                            IN Boolean isLatencyAccepted);
+
         /*--------------------*/
         /* observer mgmt      */
         /*--------------------*/
@@ -267,7 +529,15 @@ namespace SoXPlugins::ViewAndController {
         /*--------------------*/
 
         /**
-         * Informs the processor to be prepared for playback.
+         * Informs the processor to be prepared for playback; the
+         * sample buffers of the processor and all effect state
+         * (re)built during the preparation are taken from a
+         * contiguous arena of the instance.  All pages of the arena
+         * are touched afterwards, such that the audio thread causes
+         * no page faults; when the environment variable
+         * <C>SOXPLUGINS_LOCK_MEMORY</C> is set (to a nonempty value
+         * other than "0"), the arena is also locked in physical
+         * memory.
          *
          * @param[in] sampleRate                      the sample rate
          *                                            to be used for
@@ -283,7 +553,9 @@ namespace SoXPlugins::ViewAndController {
         /*--------------------*/
 
         /**
-         * Tells processor to release resources after playback.
+         * Tells processor to release resources after playback; the
+         * arena of the instance is retired and returned to the heap
+         * when no state lives in it any longer.
          */
         void releaseResources () override;
 
@@ -296,19 +568,41 @@ namespace SoXPlugins::ViewAndController {
          * @param[inout] buffer     combination of input and output
          *                          sample lists in float format
          * @param[in] midiMessages  list of midi messages to be
-         *                          processed (here ignored)
+         *                          processed (only program changes
+         *                          are handled)
          */
         void processBlock (juce::AudioBuffer<float>& buffer,
                            juce::MidiBuffer& midiMessages)
             override;
 
+        /*--------------------*/
+
+        /**
+         * Processes a block of double samples with this audio
+         * processor.
+         *
+         * @param[inout] buffer     combination of input and output
+         *                          sample lists in double format
+         * @param[in] midiMessages  list of midi messages to be
+         *                          processed (only program changes
+         *                          are handled)
+         */
+        void processBlock (juce::AudioBuffer<double>& buffer,
+                           juce::MidiBuffer& midiMessages)
+            override;
+
         /*--------------------*/
         /* persistence        */
         /*--------------------*/
 
         /**
          * Gets data from processor and stores it in serialized
-         * form in <C>destData</C>.
+         * form in <C>destData</C>; this is a compact binary form
+         * with a header and format version containing the typed
+         * parameter values by parameter identification.  The form
+         * is cached and only serialized again after a parameter has
+         * changed, hence repeated calls on an unchanged processor
+         * (e.g. for autosaves) just copy the cached bytes.
          *
          * @param[out] destData  JUCE memory block to be adapted
          *                       with serialized form
@@ -320,7 +614,12 @@ namespace SoXPlugins::ViewAndController {
 
         /**
          * Sets data for processor from serialized form in
-         * <C>data</C> with length <C>sizeInBytes</C>.
+         * <C>data</C> with length <C>sizeInBytes</C>; accepts the
+         * binary form as well as the older key-value text form.  All
+         * values are applied in bulk and dependent effect settings
+         * are recalculated only once at the end; this recalculation
+         * runs on the shared worker pool, hence restoring many
+         * instances on project load is spread across the cores.
          *
          * @param[in] data         byte list with serialized form
          *                         for processor
@@ -340,6 +639,20 @@ namespace SoXPlugins::ViewAndController {
 
             /*--------------------*/
 
+            /**
+             * Creates an audio processor to be associated with an
+             * audio effect; when <C>hasSidechain</C> is set, the
+             * processor has an additional (initially disabled)
+             * stereo input bus "Sidechain" handed to the effect
+             * without copying.
+             *
+             * @param[in] hasSidechain  information whether processor
+             *                          has a sidechain input
+             */
+            SoXAudioProcessor (IN Boolean hasSidechain);
+
+            /*--------------------*/
+
             /**
              * Tells all observers about change of kind <C>kind</C>
              * using (optional) <C>data</C>.
@@ -363,8 +676,191 @@ namespace SoXPlugins::ViewAndController {
              */
             void _setAssociatedEffect (IN SoXAudioEffect* effect);
 
+            /*--------------------*/
+
+            /**
+             * Returns a new effect of the kind associated with this
+             * processor with default parameters; it is used as the
+             * target of a crossfade on a program change.  The
+             * default implementation returns NULL, then program
+             * changes are applied to the running effect directly.
+             *
+             * @return  new effect instance (owned by the caller) or
+             *          NULL
+             */
+            virtual SoXAudioEffect* _makeEffect () const;
+
         private:
 
+            /** the listener for host parameter changes triggers the
+             * asynchronous update when no audio thread runs */
+            friend struct _EffectParameterListener;
+
+            /*--------------------*/
+
+            /**
+             * Handles the parameter changes applied by the audio
+             * thread on the message thread: notifies the observers
+             * and updates the host parameters; when not playing, it
+             * also applies the pending host parameter values.
+             */
+            void handleAsyncUpdate () override;
+
+            /*--------------------*/
+
+            /**
+             * Sets parameter named <C>parameterName</C> to
+             * <C>value</C> in the effect directly and reports this
+             * change.
+             *
+             * @param[in] parameterName          name of parameter
+             * @param[in] value                  new value of
+             *                                   parameter
+             * @param[in] recalculationIsForced  tells whether some
+             *                                   internal
+             *                                   recalculation of
+             *                                   associated effect
+             *                                   must be done
+             */
+            void _applyValue (IN String& parameterName,
+                              IN String& value,
+                              IN Boolean recalculationIsForced);
+
+            /*--------------------*/
+
+            /**
+             * Sets all parameters in <C>parameterNameList</C> to the
+             * corresponding values in <C>valueList</C> in the effect
+             * directly with processing suspended as a single
+             * parameter batch and reports those changes; the
+             * dependent effect settings are recalculated once at the
+             * end of the batch by a detached task of the worker
+             * pool.  Every later access to the effect (including
+             * <C>prepareToPlay</C> and <C>processBlock</C>) first
+             * waits for this task.
+             *
+             * @param[in] parameterNameList  list of parameter names
+             * @param[in] valueList          list of associated
+             *                               values
+             */
+            void _applyValueList (IN StringList& parameterNameList,
+                                  IN StringList& valueList);
+
+            /*--------------------*/
+
+            /**
+             * Switches to the preset with <C>presetIndex</C> in the
+             * preset bank: during playback by a crossfade to a new
+             * effect instance with that preset (when the processor
+             * can make one and a crossfade duration is set),
+             * otherwise by setting the numeric values in the running
+             * effect as a single parameter batch; so the audio
+             * thread sees the complete preset at once with the
+             * dependent settings recalculated once.
+             *
+             * @param[in] presetIndex  the index of the preset in the
+             *                         bank
+             */
+            void _applyPreset (IN Natural presetIndex);
+
+            /*--------------------*/
+
+            /**
+             * Sets all parameters to the numeric values of the
+             * preset with <C>presetIndex</C> in the running effect
+             * directly with processing suspended as a single
+             * parameter batch and reports those changes.
+             *
+             * @param[in] presetIndex  the index of the preset in the
+             *                         bank
+             */
+            void _setPresetValues (IN Natural presetIndex);
+
+            /*--------------------*/
+
+            /**
+             * Prepares <C>effect</C> with the current parameter values
+             * overridden by the preset with <C>presetIndex</C> and
+             * starts the crossfade from the running effect to it on
+             * the audio thread; the changes are reported when the
+             * crossfade is finished.
+             *
+             * @param[in] presetIndex  the index of the preset in the
+             *                         bank
+             * @param[in] effect       the new effect instance taking
+             *                         over after the crossfade
+             */
+            void _startMorph (IN Natural presetIndex,
+                              INOUT SoXAudioEffect* effect);
+
+            /*--------------------*/
+
+            /**
+             * Replaces the running effect by the target of the
+             * current crossfade (if any) and reports the changed
+             * parameters; a crossfade not yet complete ends
+             * abruptly.
+             */
+            void _finishMorph ();
+
+            /*--------------------*/
+
+            /**
+             * Reports the change of parameter named
+             * <C>parameterName</C> to <C>value</C> of kind
+             * <C>changeKind</C> to the observers and the host.
+             *
+             * @param[in] parameterName  name of changed parameter
+             * @param[in] value          new value of parameter
+             * @param[in] changeKind     kind of change reported by
+             *                           the effect
+             */
+            void _reportValueChange
+                     (IN String& parameterName,
+                      IN String& value,
+                      IN SoXParameterValueChangeKind changeKind);
+
+            /*--------------------*/
+
+            /**
+             * Reports the latency of the associated effect to the
+             * host when it has changed (e.g. by a parameter change).
+             */
+            void _updateLatency ();
+
+            /*--------------------*/
+
+            /**
+             * Builds the host parameters and their conversion data
+             * from the parameter map of the associated effect.
+             */
+            void _registerParameters ();
+
+            /*--------------------*/
+
+            /**
+             * Starts the capture of an automation trace with
+             * <C>sampleRate</C> when capturing is switched on by
+             * the environment variable
+             * <C>SOXPLUGINS_AUTOMATION_CAPTURE</C> (the trace
+             * directory).
+             *
+             * @param[in] sampleRate  sample rate of processing
+             */
+            void _startAutomationCapture (IN Real sampleRate);
+
+            /*--------------------*/
+
+            /**
+             * Writes the automation trace captured since
+             * <C>prepareToPlay</C> into a new file in the trace
+             * directory and stops the capture (when capturing is
+             * switched on).
+             */
+            void _finishAutomationCapture ();
+
+            /*--------------------*/
+
             JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SoXAudioProcessor)
 
     };
@@ -1,5 +1,10 @@
 @ECHO OFF
 REM generate SOX test files for cancellation test
+REM
+REM with option "--wav" the WAV test signals written by the conformance
+REM check of the test program ("SoX-Test X directory") are taken as
+REM sources in the current directory and the references are written
+REM as WAV files for that check
 
 REM --- sox command path ---
 SET sox=sox
@@ -10,6 +15,11 @@ SET soxFileSettings=-b 24 -r 44100
 SET durationInSecondsBy4=4
 SET durationInSeconds=16
 
+IF NOT "%1"=="--wav" GOTO ENDIF0
+    SET soxFileType=.wav
+    GOTO PERFORMTESTS
+:ENDIF0
+
 REM ==========================
 REM === prepare test files ===
 REM ==========================
@@ -37,6 +47,7 @@ REM =====================
 REM === perform tests ===
 REM =====================
 
+:PERFORMTESTS
 ECHO === performing tests ===
 
 SET soxCommands=allpass 1050 3q
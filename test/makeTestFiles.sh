@@ -1,5 +1,10 @@
 #!/bin/bash
 # generate SOX test files for cancellation test
+#
+# with option "--wav" the WAV test signals written by the conformance
+# check of the test program ("SoX-Test X directory") are taken as
+# sources in the current directory and the references are written
+# as WAV files for that check
 
 # ============================================================
 
@@ -50,14 +55,23 @@ soxFileType=".flac"
 soxFileSettings=(-b 24 -r 44100)
 durationInSecondsByFour="4"
 durationInSeconds="16"
+sourceFilesAreGiven=false
+
+if [ "$1" == "--wav" ]; then
+    soxFileType=".wav"
+    sourceFilesAreGiven=true
+fi
 
 # ==========================
 # === prepare test files ===
 # ==========================
 
-echo "=== preparing test files ==="
 soxCommandsSuffix=(fade 0.1 -0 pad 1 1)
 
+if [ ${sourceFilesAreGiven} != "true" ]; then
+
+echo "=== preparing test files ==="
+
 # -- a stereo file with noise on one channel and sine on the other
 # -- (both with two bursts)
 soxCommands=(synth ${durationInSecondsByFour} pinknoise)
@@ -77,6 +91,8 @@ targetFile="sine-500Hz${soxFileType}"
 ${sox} -n ${soxFileSettings[@]} ${targetFile} \
           ${soxCommands[@]} ${soxCommandsSuffix[@]}
 
+fi
+
 # =====================
 # === perform tests ===
 # =====================